@@ -27,11 +27,13 @@ package sun.jvm.hotspot.runtime;
 import java.util.*;
 import sun.jvm.hotspot.debugger.*;
 import sun.jvm.hotspot.types.*;
+import sun.jvm.hotspot.utilities.*;
 
 public class JNIHandles {
   private static AddressField      globalHandlesField;
   private static AddressField      weakGlobalHandlesField;
   private static OopField          deletedHandleField;
+  private static int               globalStripes;
 
   static {
     VM.registerVMInitializedObserver(new Observer() {
@@ -44,25 +46,35 @@ public class JNIHandles {
   private static synchronized void initialize(TypeDataBase db) {
     Type type = db.lookupType("JNIHandles");
 
-    globalHandlesField = type.getAddressField("_global_handles");
-    weakGlobalHandlesField = type.getAddressField("_weak_global_handles");
+    globalHandlesField = type.getAddressField("_global_handles[0]");
+    weakGlobalHandlesField = type.getAddressField("_weak_global_handles[0]");
     deletedHandleField = type.getOopField("_deleted_handle");
+    globalStripes = db.lookupIntConstant("JNIHandles::global_stripes").intValue();
 
   }
 
   public JNIHandles() {
   }
 
-  public JNIHandleBlock globalHandles() {
-    Address handleAddr  = globalHandlesField.getValue();
-    if (handleAddr == null) {
-      return null;
-    }
-    return new JNIHandleBlock(handleAddr);
+  /** Global and weak global handles are spread over this many block chains */
+  public int globalStripes() {
+    return globalStripes;
   }
 
-  public JNIHandleBlock weakGlobalHandles() {
-    Address handleAddr  = weakGlobalHandlesField.getValue();
+  public JNIHandleBlock globalHandles(int stripe) {
+    return stripeHead(globalHandlesField, stripe);
+  }
+
+  public JNIHandleBlock weakGlobalHandles(int stripe) {
+    return stripeHead(weakGlobalHandlesField, stripe);
+  }
+
+  private JNIHandleBlock stripeHead(AddressField field, int stripe) {
+    if (Assert.ASSERTS_ENABLED) {
+      Assert.that(stripe >= 0 && stripe < globalStripes, "stripe out of range");
+    }
+    Address handleAddr = field.getStaticFieldAddress()
+      .getAddressAt(stripe * VM.getVM().getAddressSize());
     if (handleAddr == null) {
       return null;
     }
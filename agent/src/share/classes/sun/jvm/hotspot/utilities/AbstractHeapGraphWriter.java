@@ -145,8 +145,11 @@ public abstract class AbstractHeapGraphWriter implements HeapGraphWriter {
 
     protected void writeGlobalJNIHandles() throws IOException {
         JNIHandles handles = VM.getVM().getJNIHandles();
-        JNIHandleBlock blk = handles.globalHandles();
-        if (blk != null) {
+        for (int i = 0; i < handles.globalStripes(); i++) {
+            JNIHandleBlock blk = handles.globalHandles(i);
+            if (blk == null) {
+                continue;
+            }
             try {
                 blk.oopsDo(new AddressVisitor() {
                           public void visitAddress(Address handleAddr) {
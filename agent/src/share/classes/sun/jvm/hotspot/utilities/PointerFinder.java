@@ -108,36 +108,38 @@ public class PointerFinder {
 
     // Check JNIHandles; both local and global
     JNIHandles handles = VM.getVM().getJNIHandles();
-    JNIHandleBlock handleBlock = handles.globalHandles();
-    if (handleBlock != null) {
-      handleBlock = handleBlock.blockContainingHandle(a);
+    for (int i = 0; i < handles.globalStripes(); i++) {
+      JNIHandleBlock handleBlock = handles.globalHandles(i);
+      if (handleBlock != null) {
+        handleBlock = handleBlock.blockContainingHandle(a);
+        if (handleBlock != null) {
+          loc.inStrongGlobalJNIHandleBlock = true;
+          loc.handleBlock = handleBlock;
+          return loc;
+        }
+      }
     }
-    if (handleBlock != null) {
-      loc.inStrongGlobalJNIHandleBlock = true;
-      loc.handleBlock = handleBlock;
-      return loc;
-    } else {
-      handleBlock = handles.weakGlobalHandles();
+    for (int i = 0; i < handles.globalStripes(); i++) {
+      JNIHandleBlock handleBlock = handles.weakGlobalHandles(i);
       if (handleBlock != null) {
         handleBlock = handleBlock.blockContainingHandle(a);
         if (handleBlock != null) {
           loc.inWeakGlobalJNIHandleBlock = true;
           loc.handleBlock = handleBlock;
           return loc;
-        } else {
-          // Look in thread-local handles
-          for (JavaThread t = VM.getVM().getThreads().first(); t != null; t = t.next()) {
-            handleBlock = t.activeHandles();
-            if (handleBlock != null) {
-              handleBlock = handleBlock.blockContainingHandle(a);
-              if (handleBlock != null) {
-                loc.inLocalJNIHandleBlock = true;
-                loc.handleBlock = handleBlock;
-                loc.handleThread = t;
-                return loc;
-              }
-            }
-          }
+        }
+      }
+    }
+    // Look in thread-local handles
+    for (JavaThread t = VM.getVM().getThreads().first(); t != null; t = t.next()) {
+      JNIHandleBlock handleBlock = t.activeHandles();
+      if (handleBlock != null) {
+        handleBlock = handleBlock.blockContainingHandle(a);
+        if (handleBlock != null) {
+          loc.inLocalJNIHandleBlock = true;
+          loc.handleBlock = handleBlock;
+          loc.handleThread = t;
+          return loc;
         }
       }
     }
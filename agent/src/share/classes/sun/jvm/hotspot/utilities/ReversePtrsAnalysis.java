@@ -107,10 +107,12 @@ public class ReversePtrsAnalysis {
 
     // Do global JNI handles
     JNIHandles handles = VM.getVM().getJNIHandles();
-    doJNIHandleBlock(handles.globalHandles(),
-                     new RootVisitor("Global JNI handle root"));
-    doJNIHandleBlock(handles.weakGlobalHandles(),
-                     new RootVisitor("Weak global JNI handle root"));
+    for (int i = 0; i < handles.globalStripes(); i++) {
+      doJNIHandleBlock(handles.globalHandles(i),
+                       new RootVisitor("Global JNI handle root"));
+      doJNIHandleBlock(handles.weakGlobalHandles(i),
+                       new RootVisitor("Weak global JNI handle root"));
+    }
 
     // Do Java-level static fields
     SystemDictionary sysDict = VM.getVM().getSystemDictionary();
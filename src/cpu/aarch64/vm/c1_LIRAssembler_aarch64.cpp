@@ -1446,6 +1446,16 @@ void LIR_Assembler::emit_typecheck_helper(LIR_OpTypeCheck *op, Label* success, L
         __ cmp(klass_RInfo, k_RInfo);
         __ br(Assembler::EQ, *success_target);
 
+        ciKlass* pk = op->profiled_klass();
+        if (pk != NULL) {
+          // the profile says objects of this klass dominate here; a
+          // match proves the subtype relation without the scan
+          assert(pk->is_subtype_of(k), "profiled klass must pass the check");
+          __ mov_metadata(rscratch1, pk->constant_encoding());
+          __ cmp(klass_RInfo, rscratch1);
+          __ br(Assembler::EQ, *success_target);
+        }
+
         __ stp(klass_RInfo, k_RInfo, Address(__ pre(sp, -2 * wordSize)));
         __ far_call(RuntimeAddress(Runtime1::entry_for(Runtime1::slow_subtype_check_id)));
         __ ldr(klass_RInfo, Address(__ post(sp, 2 * wordSize)));
@@ -1216,6 +1216,8 @@ public:
   void multiply_to_len(Register x, Register xlen, Register y, Register ylen, Register z,
                        Register zlen, Register tmp1, Register tmp2, Register tmp3,
                        Register tmp4, Register tmp5, Register tmp6, Register tmp7);
+  void mul_add(Register out, Register in, Register offset,
+               Register len, Register k);
   // ISB may be needed because of a safepoint
   void maybe_isb() { isb(); }
 
@@ -3110,17 +3110,12 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
     __ movw(temp, Coroutine::_onstack);
     __ strw(temp, Address(old_coroutine, Coroutine::state_offset()));
 
-    // rescue old handle and resource areas
-    __ ldr(temp, Address(thread, Thread::handle_area_offset()));
-    __ str(temp, Address(old_coroutine, Coroutine::handle_area_offset()));
-    __ ldr(temp, Address(thread, Thread::resource_area_offset()));
-    __ str(temp, Address(old_coroutine, Coroutine::resource_area_offset()));
+    // rescue the old handle mark and JNI handles; the handle and resource
+    // areas and the metadata handles never change while a coroutine lives
     __ ldr(temp, Address(thread, Thread::last_handle_mark_offset()));
     __ str(temp, Address(old_coroutine, Coroutine::last_handle_mark_offset()));
     __ ldr(temp, Address(thread, Thread::active_handles_offset()));
     __ str(temp, Address(old_coroutine, Coroutine::active_handles_offset()));
-    __ ldr(temp, Address(thread, Thread::metadata_handles_offset()));
-    __ str(temp, Address(old_coroutine, Coroutine::metadata_handles_offset()));
     __ ldr(temp, Address(thread, JavaThread::last_Java_pc_offset()));
     __ str(temp, Address(old_coroutine, Coroutine::last_Java_pc_offset()));
     __ ldr(temp, Address(thread, JavaThread::last_Java_sp_offset()));
@@ -3146,6 +3141,8 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
 
     __ movw(temp, Coroutine::_current);
     __ strw(temp, Address(target_coroutine, Coroutine::state_offset()));
+    __ strw(zr, Address(target_coroutine, Coroutine::roots_unchanged_offset()));
+    __ strw(zr, Address(target_coroutine, Coroutine::idle_cleanups_offset()));
     {
       Register thread = rthread;
       __ str(target_coroutine, Address(thread, JavaThread::current_coroutine_offset()));
@@ -3172,8 +3169,6 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
       __ ldrw(temp, Address(target_coroutine, Coroutine::java_call_counter_offset()));
       __ strw(temp, Address(thread, JavaThread::java_call_counter_offset()));
 #ifdef ASSERT
-      __ str(zr, Address(target_coroutine, Coroutine::handle_area_offset()));
-      __ str(zr, Address(target_coroutine, Coroutine::resource_area_offset()));
       __ str(zr, Address(target_coroutine, Coroutine::last_handle_mark_offset()));
       __ strw(zr, Address(target_coroutine, Coroutine::java_call_counter_offset()));
 #endif
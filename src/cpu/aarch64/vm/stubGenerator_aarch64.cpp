@@ -3218,6 +3218,125 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // 31^n modulo 2^32
+  static jint pow31(int n) {
+    juint p = 1;
+    for (int i = 0; i < n; i++) {
+      p *= 31;
+    }
+    return (jint)p;
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *    c_rarg0   - int h
+   *    c_rarg1   - address of the first element
+   *    c_rarg2   - int element count
+   *
+   *  Output:
+   *    r0        - int hash: for (i = 0; i < count; i++) h = 31 * h + a[i]
+   *
+   *  Four elements are hashed per iteration: the accumulator lanes are
+   *  multiplied by 31^4 and the next elements added, and the lanes are
+   *  weighted by 31^3 .. 31^0 at the end.  The initial hash is scaled by
+   *  31^(4 * iterations) separately.
+   */
+  address generate_arrayHashCode(BasicType elem_type, const char* name) {
+    assert(UseArrayHashCodeIntrinsics, "what are we doing here?");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+
+    // lane weights
+    address powers = __ pc();
+    for (int i = 3; i >= 0; i--) {
+      __ emit_int32(pow31(i));
+    }
+
+    address start = __ pc();
+
+    const Register h     = c_rarg0;
+    const Register ary   = c_rarg1;
+    const Register cnt   = c_rarg2;
+    const Register mul   = c_rarg3;   // 31^4, then 31
+    const Register power = rscratch1; // 31^(4 * iterations)
+    const Register tmp   = rscratch2;
+
+    const FloatRegister vacc  = v0;
+    const FloatRegister vnext = v1;
+    const FloatRegister vmul  = v2;
+
+    Label L_vector_loop, L_tail, L_tail_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ cmpw(cnt, 4);
+    __ br(Assembler::LT, L_tail);
+
+    __ movw(mul, pow31(4));
+    __ dup(vmul, __ T4S, mul);
+    __ eor(vacc, __ T16B, vacc, vacc);
+    __ movw(power, 1);
+
+    __ align(OptoLoopAlignment);
+    __ bind(L_vector_loop);
+    switch (elem_type) {
+    case T_BYTE:
+      __ ldrs(vnext, __ post(ary, 4));
+      __ sshll(vnext, __ T8H, vnext, __ T8B, 0);
+      __ sshll(vnext, __ T4S, vnext, __ T4H, 0);
+      break;
+    case T_CHAR:
+      __ ldrd(vnext, __ post(ary, 8));
+      __ ushll(vnext, __ T4S, vnext, __ T4H, 0);
+      break;
+    case T_INT:
+      __ ld1(vnext, __ T4S, __ post(ary, 16));
+      break;
+    default:
+      ShouldNotReachHere();
+    }
+    __ mulv(vacc, __ T4S, vacc, vmul);
+    __ addv(vacc, __ T4S, vacc, vnext);
+    __ mulw(power, power, mul);
+    __ subw(cnt, cnt, 4);
+    __ cmpw(cnt, 4);
+    __ br(Assembler::GE, L_vector_loop);
+
+    // weight the lanes and sum them up
+    __ adr(tmp, powers);
+    __ ldrq(vnext, Address(tmp));
+    __ mulv(vacc, __ T4S, vacc, vnext);
+    __ addv(vacc, __ T4S, vacc);
+    __ umov(tmp, vacc, __ S, 0);
+    __ mulw(h, h, power);
+    __ addw(h, h, tmp);
+
+    __ bind(L_tail);
+    __ cbzw(cnt, L_done);
+    __ movw(mul, 31);
+
+    __ bind(L_tail_loop);
+    switch (elem_type) {
+    case T_BYTE: __ ldrsbw(tmp, __ post(ary, 1)); break;
+    case T_CHAR: __ ldrh(tmp, __ post(ary, 2));   break;
+    case T_INT:  __ ldrw(tmp, __ post(ary, 4));   break;
+    default:     ShouldNotReachHere();
+    }
+    __ maddw(h, h, mul, tmp);
+    __ subsw(cnt, cnt, 1);
+    __ br(Assembler::NE, L_tail_loop);
+
+    __ bind(L_done);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(lr);
+
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -3258,6 +3377,210 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  address generate_squareToLen() {
+    // squareToLen algorithm for sizes 1..127 described in java code works
+    // faster than multiply_to_len on some CPUs and slower on others, but
+    // multiply_to_len shows a bit better overall results
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "squareToLen");
+    address start = __ pc();
+
+    const Register x     = r0;
+    const Register xlen  = r1;
+    const Register z     = r2;
+    const Register zlen  = r3;
+    const Register y     = r4; // == x
+    const Register ylen  = r5; // == xlen
+
+    const Register tmp1  = r10;
+    const Register tmp2  = r11;
+    const Register tmp3  = r12;
+    const Register tmp4  = r13;
+    const Register tmp5  = r14;
+    const Register tmp6  = r15;
+    const Register tmp7  = r16;
+
+    RegSet spilled_regs = RegSet::of(y, ylen);
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+    __ push(spilled_regs, sp);
+    __ mov(y, x);
+    __ mov(ylen, xlen);
+    __ multiply_to_len(x, xlen, y, ylen, z, zlen, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7);
+    __ pop(spilled_regs, sp);
+    __ leave();
+    __ ret(lr);
+    return start;
+  }
+
+  address generate_mulAdd() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "mulAdd");
+
+    address start = __ pc();
+
+    const Register out     = r0;
+    const Register in      = r1;
+    const Register offset  = r2;
+    const Register len     = r3;
+    const Register k       = r4;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter();
+    __ mul_add(out, in, offset, len, k);
+    __ leave();
+    __ ret(lr);
+
+    return start;
+  }
+
+  void ghash_multiply(FloatRegister result_lo, FloatRegister result_hi,
+                      FloatRegister a, FloatRegister b, FloatRegister a1_xor_a0,
+                      FloatRegister tmp1, FloatRegister tmp2, FloatRegister tmp3, FloatRegister tmp4) {
+    // Karatsuba multiplication performs a 128*128 -> 256-bit
+    // multiplication in three 128-bit multiplications and a few
+    // additions.
+    //
+    // (C1:C0) = A1*B1, (D1:D0) = A0*B0, (E1:E0) = (A0+A1)(B0+B1)
+    // (A1:A0)(B1:B0) = C1:(C0+C1+D1+E1):(D1+C0+D0+E0):D0
+    //
+    // Inputs:
+    //
+    // A0 in a.d[0]     (subkey)
+    // A1 in a.d[1]
+    // (A1+A0) in a1_xor_a0.d[0]
+    //
+    // B0 in b.d[0]     (state)
+    // B1 in b.d[1]
+
+    __ ext(tmp1, __ T16B, b, b, 0x08);
+    __ pmull2(result_hi, __ T1Q, b, a, __ T2D);      // A1*B1
+    __ eor(tmp1, __ T16B, tmp1, b);                   // (B1+B0)
+    __ pmull(result_lo,  __ T1Q, b, a, __ T1D);       // A0*B0
+    __ pmull(tmp2, __ T1Q, tmp1, a1_xor_a0, __ T1D);  // (A1+A0)(B1+B0)
+
+    __ ext(tmp4, __ T16B, result_lo, result_hi, 0x08);
+    __ eor(tmp3, __ T16B, result_hi, result_lo);      // A1*B1+A0*B0
+    __ eor(tmp2, __ T16B, tmp2, tmp4);
+    __ eor(tmp2, __ T16B, tmp2, tmp3);
+
+    // Register pair <result_hi:result_lo> holds the result of carry-less multiplication
+    __ ins(result_hi, __ D, tmp2, 0, 1);
+    __ ins(result_lo, __ D, tmp2, 1, 0);
+  }
+
+  void ghash_reduce(FloatRegister result, FloatRegister lo, FloatRegister hi,
+                    FloatRegister p, FloatRegister z, FloatRegister t1) {
+    const FloatRegister t0 = result;
+
+    // The GCM field polynomial f is z^128 + p(z), where p =
+    // z^7+z^2+z+1.
+    //
+    //    z^128 === -p(z)  (mod (z^128 + p(z)))
+    //
+    // so, given that the product we're reducing is
+    //    a == lo + hi * z^128
+    // substituting,
+    //      === lo - hi * p(z)  (mod (z^128 + p(z)))
+    //
+    // we reduce by multiplying hi by p(z) and subtracting the result
+    // from (i.e. XORing it with) lo.  Because p has no nonzero high
+    // bits we can do this with two 64-bit multiplications, lo*p and
+    // hi*p.
+
+    __ pmull2(t0, __ T1Q, hi, p, __ T2D);
+    __ ext(t1, __ T16B, t0, z, 8);
+    __ eor(hi, __ T16B, hi, t1);
+    __ ext(t1, __ T16B, z, t0, 8);
+    __ eor(lo, __ T16B, lo, t1);
+    __ pmull(t0, __ T1Q, hi, p, __ T1D);
+    __ eor(result, __ T16B, lo, t0);
+  }
+
+  /**
+   *  Arguments:
+   *
+   *  Input:
+   *  c_rarg0   - current state address
+   *  c_rarg1   - H key address
+   *  c_rarg2   - data address
+   *  c_rarg3   - number of blocks
+   *
+   *  Output:
+   *  Updated state at c_rarg0
+   */
+  address generate_ghash_processBlocks() {
+    // Bafflingly, GCM uses little-endian for the byte order, but
+    // big-endian for the bit order.  For example, the polynomial 1 is
+    // represented as the 16-byte string 80 00 00 00 | 12 bytes of 00.
+    //
+    // So, we must either reverse the bytes in each word and do
+    // everything big-endian or reverse the bits in each byte and do
+    // it little-endian.  On AArch64 it's more idiomatic to reverse
+    // the bits in each byte (we have an instruction, RBIT, to do
+    // that) and keep the data in little-endian bit order throught the
+    // calculation, bit-reversing the inputs and outputs.
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "ghash_processBlocks");
+    address start = __ pc();
+
+    Register state   = c_rarg0;
+    Register subkeyH = c_rarg1;
+    Register data    = c_rarg2;
+    Register blocks  = c_rarg3;
+
+    FloatRegister vzr = v30;
+    __ eor(vzr, __ T16B, vzr, vzr); // zero register
+
+    // The low-order bits of the field polynomial (i.e. p = z^7+z^2+z+1)
+    // repeated in the low and high parts of a 128-bit vector
+    __ mov(rscratch1, 0x87);
+    __ dup(v26, __ T2D, rscratch1);
+
+    __ ldrq(v0, Address(state));
+    __ ldrq(v1, Address(subkeyH));
+
+    __ rev64(v0, __ T16B, v0);          // Bit-reverse words in state and subkeyH
+    __ rbit(v0, __ T16B, v0);
+    __ rev64(v1, __ T16B, v1);
+    __ rbit(v1, __ T16B, v1);
+
+    __ ext(v16, __ T16B, v1, v1, 0x08); // long-swap subkeyH into v1
+    __ eor(v16, __ T16B, v16, v1);      // xor subkeyH into subkeyL (Karatsuba: (A1+A0))
+
+    {
+      Label L_ghash_loop, L_exit;
+      __ cbzw(blocks, L_exit);
+      __ bind(L_ghash_loop);
+
+      __ ldrq(v2, Address(__ post(data, 0x10))); // Load the data, bit
+                                                 // reversing each byte
+      __ rbit(v2, __ T16B, v2);
+      __ eor(v2, __ T16B, v0, v2);   // bit-swapped data ^ bit-swapped state
+
+      // Multiply state in v2 by subkey in v1
+      ghash_multiply(/*result_lo*/v5, /*result_hi*/v7,
+                     /*a*/v1, /*b*/v2, /*a1_xor_a0*/v16,
+                     /*temps*/v6, v20, v18, v21);
+      // Reduce v7:v5 by the field polynomial
+      ghash_reduce(v0, v5, v7, v26, vzr, v20);
+
+      __ subw(blocks, blocks, 1);
+      __ cbnzw(blocks, L_ghash_loop);
+      __ bind(L_exit);
+    }
+
+    // The bit-reversed result is at this point in v0
+    __ rev64(v1, __ T16B, v0);
+    __ rbit(v1, __ T16B, v1);
+
+    __ st1(v1, __ T16B, state);
+    __ ret(lr);
+
+    return start;
+  }
+
   // Continuation point for throwing of implicit exceptions that are
   // not handled in the current activation. Fabricates an exception
   // oop and initiates normal exception dispatching in this
@@ -4246,6 +4569,20 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_multiplyToLen = generate_multiplyToLen();
     }
 
+    if (UseSquareToLenIntrinsic) {
+      StubRoutines::_squareToLen = generate_squareToLen();
+    }
+
+    if (UseMulAddIntrinsic) {
+      StubRoutines::_mulAdd = generate_mulAdd();
+    }
+
+    if (UseArrayHashCodeIntrinsics) {
+      StubRoutines::_byteArrayHashCode = generate_arrayHashCode(T_BYTE, "byteArrayHashCode");
+      StubRoutines::_charArrayHashCode = generate_arrayHashCode(T_CHAR, "charArrayHashCode");
+      StubRoutines::_intArrayHashCode  = generate_arrayHashCode(T_INT,  "intArrayHashCode");
+    }
+
     if (UseMontgomeryMultiplyIntrinsic) {
       StubCodeMark mark(this, "StubRoutines", "montgomeryMultiply");
       MontgomeryMultiplyGenerator g(_masm, /*squaring*/false);
@@ -4267,6 +4604,10 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_cipherBlockChaining_decryptAESCrypt = generate_cipherBlockChaining_decryptAESCrypt();
     }
 
+    if (UseGHASHIntrinsics) {
+      StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
+    }
+
     if (UseSHA1Intrinsics) {
       StubRoutines::_sha1_implCompress     = generate_sha1_implCompress(false,   "sha1_implCompress");
       StubRoutines::_sha1_implCompressMB   = generate_sha1_implCompress(true,    "sha1_implCompressMB");
@@ -3475,7 +3475,8 @@ void TemplateTable::_new() {
   // (creates a new TLAB, etc.)
 
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    ObjectProfilerSampleBytes == 0;
 
   if (UseTLAB) {
     __ tlab_allocate(r0, r3, 0, noreg, r1,
@@ -3368,7 +3368,8 @@ void TemplateTable::_new() {
   // (creates a new TLAB, etc.)
 
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    ObjectProfilerSampleBytes == 0;
 
   if(UseTLAB) {
     Register RoldTopValue = RallocatedObject;
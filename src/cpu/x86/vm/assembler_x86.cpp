@@ -1658,6 +1658,12 @@ void Assembler::mfence() {
   emit_int8((unsigned char)0xF0);
 }
 
+void Assembler::sfence() {
+  emit_int8(0x0F);
+  emit_int8((unsigned char)0xAE);
+  emit_int8((unsigned char)0xF8);
+}
+
 void Assembler::mov(Register dst, Register src) {
   LP64_ONLY(movq(dst, src)) NOT_LP64(movl(dst, src));
 }
@@ -1764,6 +1770,14 @@ void Assembler::movdqu(Address dst, XMMRegister src) {
   emit_operand(src, dst);
 }
 
+void Assembler::movntdq(Address dst, XMMRegister src) {
+  NOT_LP64(assert(VM_Version::supports_sse2(), ""));
+  InstructionMark im(this);
+  simd_prefix(dst, src, VEX_SIMD_66);
+  emit_int8((unsigned char)0xE7);
+  emit_operand(src, dst);
+}
+
 // Move Unaligned 256bit Vector
 void Assembler::vmovdqu(XMMRegister dst, XMMRegister src) {
   assert(UseAVX > 0, "");
@@ -3783,6 +3797,48 @@ void Assembler::vpxor(XMMRegister dst, XMMRegister nds, Address src, bool vector
   emit_vex_arith(0xEF, dst, nds, src, VEX_SIMD_66, vector256);
 }
 
+void Assembler::vpcmpeqd(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256) {
+  assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
+  emit_vex_arith(0x76, dst, nds, src, VEX_SIMD_66, vector256);
+}
+
+void Assembler::vpcmpgtd(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256) {
+  assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
+  emit_vex_arith(0x66, dst, nds, src, VEX_SIMD_66, vector256);
+}
+
+void Assembler::vcmpps(XMMRegister dst, XMMRegister nds, XMMRegister src, int cop, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  assert(0 <= cop && cop < 32, "invalid predicate");
+  emit_vex_arith(0xC2, dst, nds, src, VEX_SIMD_NONE, vector256);
+  emit_int8((unsigned char)cop);
+}
+
+void Assembler::vcmppd(XMMRegister dst, XMMRegister nds, XMMRegister src, int cop, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  assert(0 <= cop && cop < 32, "invalid predicate");
+  emit_vex_arith(0xC2, dst, nds, src, VEX_SIMD_66, vector256);
+  emit_int8((unsigned char)cop);
+}
+
+void Assembler::vblendvps(XMMRegister dst, XMMRegister nds, XMMRegister src, XMMRegister mask, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  int encode = vex_prefix_and_encode(dst, nds, src, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x4A);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // The mask register is encoded in bits 7:4 of the immediate
+  emit_int8((unsigned char)(mask->encoding() << 4));
+}
+
+void Assembler::vblendvpd(XMMRegister dst, XMMRegister nds, XMMRegister src, XMMRegister mask, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  int encode = vex_prefix_and_encode(dst, nds, src, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x4B);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // The mask register is encoded in bits 7:4 of the immediate
+  emit_int8((unsigned char)(mask->encoding() << 4));
+}
+
 
 void Assembler::vinsertf128h(XMMRegister dst, XMMRegister nds, XMMRegister src) {
   assert(VM_Version::supports_avx(), "");
@@ -3795,6 +3851,17 @@ void Assembler::vinsertf128h(XMMRegister dst, XMMRegister nds, XMMRegister src)
   emit_int8(0x01);
 }
 
+void Assembler::vextractf128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx(), "");
+  bool vector256 = true;
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x19);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x00 - extract from lower 128 bits
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 void Assembler::vinsertf128h(XMMRegister dst, Address src) {
   assert(VM_Version::supports_avx(), "");
   InstructionMark im(this);
@@ -3833,6 +3900,17 @@ void Assembler::vinserti128h(XMMRegister dst, XMMRegister nds, XMMRegister src)
   emit_int8(0x01);
 }
 
+void Assembler::vextracti128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx2(), "");
+  bool vector256 = true;
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x39);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x00 - extract from lower 128 bits
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 void Assembler::vinserti128h(XMMRegister dst, Address src) {
   assert(VM_Version::supports_avx2(), "");
   InstructionMark im(this);
@@ -3869,6 +3947,22 @@ void Assembler::vpbroadcastd(XMMRegister dst, XMMRegister src) {
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+void Assembler::vpmovsxbd(XMMRegister dst, Address src, bool vector256) {
+  assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
+  InstructionMark im(this);
+  vex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector256);
+  emit_int8(0x21);
+  emit_operand(dst, src);
+}
+
+void Assembler::vpmovzxwd(XMMRegister dst, Address src, bool vector256) {
+  assert(VM_Version::supports_avx() && !vector256 || VM_Version::supports_avx2(), "256 bit integer vectors requires AVX2");
+  InstructionMark im(this);
+  vex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector256);
+  emit_int8(0x33);
+  emit_operand(dst, src);
+}
+
 // Carry-Less Multiplication Quadword
 void Assembler::pclmulqdq(XMMRegister dst, XMMRegister src, int mask) {
   assert(VM_Version::supports_clmul(), "");
@@ -5387,6 +5481,14 @@ void Assembler::movq(Address dst, Register src) {
   emit_operand(src, dst);
 }
 
+void Assembler::movntiq(Address dst, Register src) {
+  InstructionMark im(this);
+  prefixq(dst, src);
+  emit_int8(0x0F);
+  emit_int8((unsigned char)0xC3);
+  emit_operand(src, dst);
+}
+
 void Assembler::movsbq(Register dst, Address src) {
   InstructionMark im(this);
   prefixq(src, dst);
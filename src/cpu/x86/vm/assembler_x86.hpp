@@ -526,6 +526,13 @@ class Assembler : public AbstractAssembler  {
     VEX_OPCODE_0F_3A = 0x3
   };
 
+  // Predicates of vcmpps/vcmppd used by C2 vector compares
+  enum ComparisonPredicateFP {
+    EQ_OQ  = 0x00,   // equal, ordered
+    NGE_UQ = 0x19,   // not greater or equal, unordered is true
+    GT_OQ  = 0x1E    // greater than, ordered
+  };
+
   enum WhichOperand {
     // input to locate_operand, and format code for relocations
     imm_operand  = 0,            // embedded 32-bit|64-bit immediate operand
@@ -1310,6 +1317,8 @@ private:
 
   void mfence();
 
+  void sfence();
+
   // Moves
 
   void mov64(Register dst, int64_t imm64);
@@ -1336,6 +1345,9 @@ private:
   void movdqu(XMMRegister dst, Address src);
   void movdqu(XMMRegister dst, XMMRegister src);
 
+  // Move Double Quadword Non-Temporal (16-byte aligned dst)
+  void movntdq(Address dst, XMMRegister src);
+
   // Move Unaligned 256bit Vector
   void vmovdqu(Address dst, XMMRegister src);
   void vmovdqu(XMMRegister dst, Address src);
@@ -1360,6 +1372,9 @@ private:
   void movq(Register dst, Register src);
   void movq(Register dst, Address src);
   void movq(Address  dst, Register src);
+
+  // Store Quadword Non-Temporal
+  void movntiq(Address dst, Register src);
 #endif
 
   void movq(Address     dst, MMXRegister src );
@@ -1853,10 +1868,26 @@ private:
   void vpxor(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256);
   void vpxor(XMMRegister dst, XMMRegister nds, Address src, bool vector256);
 
+  // Compare packed integers, setting all bits of the elements which compare true
+  void vpcmpeqd(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256);
+  void vpcmpgtd(XMMRegister dst, XMMRegister nds, XMMRegister src, bool vector256);
+
+  // Compare packed floating point values using predicate cop
+  void vcmpps(XMMRegister dst, XMMRegister nds, XMMRegister src, int cop, bool vector256);
+  void vcmppd(XMMRegister dst, XMMRegister nds, XMMRegister src, int cop, bool vector256);
+
+  // Select elements of src where the sign bit of mask is set, otherwise of nds
+  void vblendvps(XMMRegister dst, XMMRegister nds, XMMRegister src, XMMRegister mask, bool vector256);
+  void vblendvpd(XMMRegister dst, XMMRegister nds, XMMRegister src, XMMRegister mask, bool vector256);
+
   // Copy low 128bit into high 128bit of YMM registers.
   void vinsertf128h(XMMRegister dst, XMMRegister nds, XMMRegister src);
   void vinserti128h(XMMRegister dst, XMMRegister nds, XMMRegister src);
 
+  // Copy high 128bit of YMM registers into low 128bit of XMM registers.
+  void vextractf128h(XMMRegister dst, XMMRegister src);
+  void vextracti128h(XMMRegister dst, XMMRegister src);
+
   // Load/store high 128bit of YMM registers which does not destroy other half.
   void vinsertf128h(XMMRegister dst, Address src);
   void vinserti128h(XMMRegister dst, Address src);
@@ -1866,6 +1897,10 @@ private:
   // duplicate 4-bytes integer data from src into 8 locations in dest
   void vpbroadcastd(XMMRegister dst, XMMRegister src);
 
+  // sign extend packed bytes and zero extend packed words to integers
+  void vpmovsxbd(XMMRegister dst, Address src, bool vector256);
+  void vpmovzxwd(XMMRegister dst, Address src, bool vector256);
+
   // Carry-Less Multiplication Quadword
   void pclmulqdq(XMMRegister dst, XMMRegister src, int mask);
   void vpclmulqdq(XMMRegister dst, XMMRegister nds, XMMRegister src, int mask);
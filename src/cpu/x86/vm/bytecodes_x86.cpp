@@ -27,7 +27,21 @@
 
 
 void Bytecodes::pd_initialize() {
-  // No i486 specific initialization
+#ifdef AMD64
+  // The format covers both iloads and the if_icmp so that the template
+  // steps over the whole sequence when the branch is not taken. The branch
+  // offset is left out of the format since field sizes can't be mixed.
+  //  bytecode                bytecode name            format     wide f.   result tp  stk traps  std code
+  def(_fast_iload2_if_icmpeq, "fast_iload2_if_icmpeq", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+  def(_fast_iload2_if_icmpne, "fast_iload2_if_icmpne", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+  def(_fast_iload2_if_icmplt, "fast_iload2_if_icmplt", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+  def(_fast_iload2_if_icmpge, "fast_iload2_if_icmpge", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+  def(_fast_iload2_if_icmpgt, "fast_iload2_if_icmpgt", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+  def(_fast_iload2_if_icmple, "fast_iload2_if_icmple", "bi_i___", NULL    , T_VOID   ,  0, false, _iload);
+
+  assert(_fast_iload2_if_icmple - _fast_iload2_if_icmpeq == _if_icmple - _if_icmpeq,
+         "superinstructions must mirror the if_icmp order");
+#endif // AMD64
 }
 
 
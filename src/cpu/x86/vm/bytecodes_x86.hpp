@@ -25,6 +25,17 @@
 #ifndef CPU_X86_VM_BYTECODES_X86_HPP
 #define CPU_X86_VM_BYTECODES_X86_HPP
 
-// No i486 specific bytecodes
+#ifdef AMD64
+// Superinstructions for "iload a; iload b; if_icmp<cond>", the most frequent
+// three-bytecode sequence in loop headers and bounds checks. Rewritten from
+// the first iload by TemplateTable::iload(); must stay in the same order as
+// _if_icmpeq.._if_icmple.
+    _fast_iload2_if_icmpeq ,
+    _fast_iload2_if_icmpne ,
+    _fast_iload2_if_icmplt ,
+    _fast_iload2_if_icmpge ,
+    _fast_iload2_if_icmpgt ,
+    _fast_iload2_if_icmple ,
+#endif // AMD64
 
 #endif // CPU_X86_VM_BYTECODES_X86_HPP
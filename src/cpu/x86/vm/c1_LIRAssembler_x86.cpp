@@ -607,6 +607,13 @@ void LIR_Assembler::return_op(LIR_Opr result) {
   AddressLiteral polling_page(os::get_polling_page() + (SafepointPollOffset % os::vm_page_size()),
                               relocInfo::poll_return_type);
 
+#ifdef _LP64
+  if (ThreadLocalSafepointPolls) {
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::poll_word_offset()));
+    __ relocate(relocInfo::poll_return_type);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     __ relocate(relocInfo::poll_return_type);
@@ -623,6 +630,15 @@ int LIR_Assembler::safepoint_poll(LIR_Opr tmp, CodeEmitInfo* info) {
                               relocInfo::poll_type);
   guarantee(info != NULL, "Shouldn't be NULL");
   int offset = __ offset();
+#ifdef _LP64
+  if (ThreadLocalSafepointPolls) {
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::poll_word_offset()));
+    offset = __ offset();
+    add_debug_info_for_branch(info);
+    __ relocate(relocInfo::poll_type);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     offset = __ offset();
@@ -1736,7 +1752,7 @@ void LIR_Assembler::emit_typecheck_helper(LIR_OpTypeCheck *op, Label* success, L
   } else if (obj == klass_RInfo) {
     klass_RInfo = dst;
   }
-  if (k->is_loaded() && !UseCompressedClassPointers) {
+  if (k->is_loaded() && !UseCompressedClassPointers && op->profiled_klass() == NULL) {
     select_different_registers(obj, dst, k_RInfo, klass_RInfo);
   } else {
     Rtmp1 = op->tmp3()->as_register();
@@ -1814,6 +1830,20 @@ void LIR_Assembler::emit_typecheck_helper(LIR_OpTypeCheck *op, Label* success, L
 #endif // _LP64
         __ jcc(Assembler::equal, *success_target);
 
+        ciKlass* pk = op->profiled_klass();
+        if (pk != NULL) {
+          // the profile says objects of this klass dominate here; a
+          // match proves the subtype relation without the scan
+          assert(pk->is_subtype_of(k), "profiled klass must pass the check");
+#ifdef _LP64
+          __ mov_metadata(Rtmp1, pk->constant_encoding());
+          __ cmpptr(klass_RInfo, Rtmp1);
+#else
+          __ cmpklass(klass_RInfo, pk->constant_encoding());
+#endif // _LP64
+          __ jcc(Assembler::equal, *success_target);
+        }
+
         __ push(klass_RInfo);
 #ifdef _LP64
         __ push(k_RInfo);
@@ -57,6 +57,13 @@ int C1_MacroAssembler::lock_object(Register hdr, Register obj, Register disp_hdr
 
   // Load object header
   movptr(hdr, Address(obj, hdr_offset));
+#ifdef _LP64
+  if (UseLightweightLocking) {
+    assert(scratch != noreg, "should have scratch register at this point");
+    lightweight_lock(obj, hdr, r15_thread, scratch, slow_case);
+    return null_check_offset;
+  }
+#endif
   // and mark it as unlocked
   orptr(hdr, markOopDesc::unlocked_value);
   // save unlocked object header into the displaced header location on the stack
@@ -105,6 +112,17 @@ void C1_MacroAssembler::unlock_object(Register hdr, Register obj, Register disp_
   assert(hdr != obj && hdr != disp_hdr && obj != disp_hdr, "registers must be different");
   Label done;
 
+#ifdef _LP64
+  if (UseLightweightLocking) {
+    // load object
+    movptr(obj, Address(disp_hdr, BasicObjectLock::obj_offset_in_bytes()));
+    verify_oop(obj);
+    // kills disp_hdr, the slow case recomputes it
+    lightweight_unlock(obj, disp_hdr, r15_thread, hdr, slow_case);
+    return;
+  }
+#endif
+
   if (UseBiasedLocking) {
     // load object
     movptr(obj, Address(disp_hdr, BasicObjectLock::obj_offset_in_bytes()));
@@ -35,6 +35,7 @@
 #include "prims/jvmtiThreadState.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/thread.inline.hpp"
 
@@ -484,7 +485,8 @@ void InterpreterMacroAssembler::dispatch_epilog(TosState state, int step) {
 
 void InterpreterMacroAssembler::dispatch_base(TosState state,
                                               address* table,
-                                              bool verifyoop) {
+                                              bool verifyoop,
+                                              bool generate_poll) {
   verify_FPU(1, state);
   if (VerifyActivationFrameSize) {
     Label L;
@@ -501,12 +503,25 @@ void InterpreterMacroAssembler::dispatch_base(TosState state,
   if (verifyoop) {
     verify_oop(rax, state);
   }
-  lea(rscratch1, ExternalAddress((address)table));
+  address* const safepoint_table = Interpreter::safept_table(state);
+  if (ThreadLocalSafepointPolls && generate_poll && table != safepoint_table) {
+    Label no_safepoint, dispatch;
+    movptr(rscratch1, Address(r15_thread, JavaThread::poll_word_offset()));
+    testb(rscratch1, SafepointSynchronize::poll_bit());
+    jccb(Assembler::zero, no_safepoint);
+    lea(rscratch1, ExternalAddress((address)safepoint_table));
+    jmpb(dispatch);
+    bind(no_safepoint);
+    lea(rscratch1, ExternalAddress((address)table));
+    bind(dispatch);
+  } else {
+    lea(rscratch1, ExternalAddress((address)table));
+  }
   jmp(Address(rscratch1, rbx, Address::times_8));
 }
 
-void InterpreterMacroAssembler::dispatch_only(TosState state) {
-  dispatch_base(state, Interpreter::dispatch_table(state));
+void InterpreterMacroAssembler::dispatch_only(TosState state, bool generate_poll) {
+  dispatch_base(state, Interpreter::dispatch_table(state), true, generate_poll);
 }
 
 void InterpreterMacroAssembler::dispatch_only_normal(TosState state) {
@@ -727,46 +742,53 @@ void InterpreterMacroAssembler::lock_object(Register lock_reg) {
       biased_locking_enter(lock_reg, obj_reg, swap_reg, rscratch1, false, done, &slow_case);
     }
 
-    // Load immediate 1 into swap_reg %rax
-    movl(swap_reg, 1);
+    if (UseLightweightLocking) {
+      // Load the mark into swap_reg %rax
+      movptr(swap_reg, Address(obj_reg, oopDesc::mark_offset_in_bytes()));
+      lightweight_lock(obj_reg, swap_reg, r15_thread, rscratch1, slow_case);
+      jmp(done);
+    } else {
+      // Load immediate 1 into swap_reg %rax
+      movl(swap_reg, 1);
 
-    // Load (object->mark() | 1) into swap_reg %rax
-    orptr(swap_reg, Address(obj_reg, 0));
+      // Load (object->mark() | 1) into swap_reg %rax
+      orptr(swap_reg, Address(obj_reg, 0));
 
-    // Save (object->mark() | 1) into BasicLock's displaced header
-    movptr(Address(lock_reg, mark_offset), swap_reg);
+      // Save (object->mark() | 1) into BasicLock's displaced header
+      movptr(Address(lock_reg, mark_offset), swap_reg);
 
-    assert(lock_offset == 0,
-           "displached header must be first word in BasicObjectLock");
+      assert(lock_offset == 0,
+             "displached header must be first word in BasicObjectLock");
 
-    if (os::is_MP()) lock();
-    cmpxchgptr(lock_reg, Address(obj_reg, 0));
-    if (PrintBiasedLockingStatistics) {
-      cond_inc32(Assembler::zero,
-                 ExternalAddress((address) BiasedLocking::fast_path_entry_count_addr()));
-    }
-    jcc(Assembler::zero, done);
-
-    // Test if the oopMark is an obvious stack pointer, i.e.,
-    //  1) (mark & 7) == 0, and
-    //  2) rsp <= mark < mark + os::pagesize()
-    //
-    // These 3 tests can be done by evaluating the following
-    // expression: ((mark - rsp) & (7 - os::vm_page_size())),
-    // assuming both stack pointer and pagesize have their
-    // least significant 3 bits clear.
-    // NOTE: the oopMark is in swap_reg %rax as the result of cmpxchg
-    subptr(swap_reg, rsp);
-    andptr(swap_reg, 7 - os::vm_page_size());
-
-    // Save the test result, for recursive case, the result is zero
-    movptr(Address(lock_reg, mark_offset), swap_reg);
-
-    if (PrintBiasedLockingStatistics) {
-      cond_inc32(Assembler::zero,
-                 ExternalAddress((address) BiasedLocking::fast_path_entry_count_addr()));
+      if (os::is_MP()) lock();
+      cmpxchgptr(lock_reg, Address(obj_reg, 0));
+      if (PrintBiasedLockingStatistics) {
+        cond_inc32(Assembler::zero,
+                   ExternalAddress((address) BiasedLocking::fast_path_entry_count_addr()));
+      }
+      jcc(Assembler::zero, done);
+
+      // Test if the oopMark is an obvious stack pointer, i.e.,
+      //  1) (mark & 7) == 0, and
+      //  2) rsp <= mark < mark + os::pagesize()
+      //
+      // These 3 tests can be done by evaluating the following
+      // expression: ((mark - rsp) & (7 - os::vm_page_size())),
+      // assuming both stack pointer and pagesize have their
+      // least significant 3 bits clear.
+      // NOTE: the oopMark is in swap_reg %rax as the result of cmpxchg
+      subptr(swap_reg, rsp);
+      andptr(swap_reg, 7 - os::vm_page_size());
+
+      // Save the test result, for recursive case, the result is zero
+      movptr(Address(lock_reg, mark_offset), swap_reg);
+
+      if (PrintBiasedLockingStatistics) {
+        cond_inc32(Assembler::zero,
+                   ExternalAddress((address) BiasedLocking::fast_path_entry_count_addr()));
+      }
+      jcc(Assembler::zero, done);
     }
-    jcc(Assembler::zero, done);
 
     bind(slow_case);
 
@@ -799,7 +821,7 @@ void InterpreterMacroAssembler::unlock_object(Register lock_reg) {
             CAST_FROM_FN_PTR(address, InterpreterRuntime::monitorexit),
             lock_reg);
   } else {
-    Label done;
+    Label done, slow_case;
 
     const Register swap_reg   = rax;  // Must use rax for cmpxchg instruction
     const Register header_reg = c_rarg2;  // Will contain the old oopMark
@@ -821,23 +843,29 @@ void InterpreterMacroAssembler::unlock_object(Register lock_reg) {
       biased_locking_exit(obj_reg, header_reg, done);
     }
 
-    // Load the old header from BasicLock structure
-    movptr(header_reg, Address(swap_reg,
-                               BasicLock::displaced_header_offset_in_bytes()));
+    if (UseLightweightLocking) {
+      lightweight_unlock(obj_reg, swap_reg, r15_thread, header_reg, slow_case);
+      jmp(done);
+    } else {
+      // Load the old header from BasicLock structure
+      movptr(header_reg, Address(swap_reg,
+                                 BasicLock::displaced_header_offset_in_bytes()));
 
-    // Test for recursion
-    testptr(header_reg, header_reg);
+      // Test for recursion
+      testptr(header_reg, header_reg);
 
-    // zero for recursive case
-    jcc(Assembler::zero, done);
+      // zero for recursive case
+      jcc(Assembler::zero, done);
 
-    // Atomic swap back the old header
-    if (os::is_MP()) lock();
-    cmpxchgptr(header_reg, Address(obj_reg, 0));
+      // Atomic swap back the old header
+      if (os::is_MP()) lock();
+      cmpxchgptr(header_reg, Address(obj_reg, 0));
 
-    // zero for recursive case
-    jcc(Assembler::zero, done);
+      // zero for recursive case
+      jcc(Assembler::zero, done);
+    }
 
+    bind(slow_case);
     // Call the runtime routine for slow case.
     movptr(Address(lock_reg, BasicObjectLock::obj_offset_in_bytes()),
          obj_reg); // restore obj
@@ -1449,7 +1477,15 @@ void InterpreterMacroAssembler::notify_method_entry() {
     Label L;
     movl(rdx, Address(r15_thread, JavaThread::interp_only_mode_offset()));
     testl(rdx, rdx);
-    jcc(Assembler::zero, L);
+    if (JvmtiSelectiveMethodTrace) {
+      // Outside interp_only_mode only the traced methods post the event
+      Label L_post;
+      jcc(Assembler::notZero, L_post);
+      check_jvmti_traced_method(rdx, L);
+      bind(L_post);
+    } else {
+      jcc(Assembler::zero, L);
+    }
     call_VM(noreg, CAST_FROM_FN_PTR(address,
                                     InterpreterRuntime::post_method_entry));
     bind(L);
@@ -1489,7 +1525,14 @@ void InterpreterMacroAssembler::notify_method_exit(
     NOT_CC_INTERP(push(state);)
     movl(rdx, Address(r15_thread, JavaThread::interp_only_mode_offset()));
     testl(rdx, rdx);
-    jcc(Assembler::zero, L);
+    if (JvmtiSelectiveMethodTrace) {
+      Label L_post;
+      jcc(Assembler::notZero, L_post);
+      check_jvmti_traced_method(rdx, L);
+      bind(L_post);
+    } else {
+      jcc(Assembler::zero, L);
+    }
     call_VM(noreg,
             CAST_FROM_FN_PTR(address, InterpreterRuntime::post_method_exit));
     bind(L);
@@ -1506,6 +1549,17 @@ void InterpreterMacroAssembler::notify_method_exit(
   }
 }
 
+void InterpreterMacroAssembler::check_jvmti_traced_method(Register tmp,
+                                                          Label& not_traced) {
+  assert(JvmtiSelectiveMethodTrace, "only used for selective method trace");
+  cmp8(ExternalAddress(JvmtiExport::get_should_post_traced_method_events_addr()), 0);
+  jcc(Assembler::equal, not_traced);
+  get_method(tmp);
+  movl(tmp, Address(tmp, Method::access_flags_offset()));
+  testl(tmp, JVM_ACC_JVMTI_TRACED);
+  jcc(Assembler::zero, not_traced);
+}
+
 // Jump if ((*counter_addr += increment) & mask) satisfies the condition.
 void InterpreterMacroAssembler::increment_mask_and_jump(Address counter_addr,
                                                         int increment, int mask,
@@ -39,7 +39,7 @@
   virtual void check_and_handle_earlyret(Register java_thread);
 
   // base routine for all dispatches
-  void dispatch_base(TosState state, address* table, bool verifyoop = true);
+  void dispatch_base(TosState state, address* table, bool verifyoop = true, bool generate_poll = false);
 #endif // CC_INTERP
 
  public:
@@ -140,8 +140,9 @@
   // Dispatching
   void dispatch_prolog(TosState state, int step = 0);
   void dispatch_epilog(TosState state, int step = 0);
-  // dispatch via ebx (assume ebx is loaded already)
-  void dispatch_only(TosState state);
+  // dispatch via ebx (assume ebx is loaded already), through the safepoint
+  // table if generate_poll and the thread local poll is armed
+  void dispatch_only(TosState state, bool generate_poll = false);
   // dispatch normal table via ebx (assume ebx is loaded already)
   void dispatch_only_normal(TosState state);
   void dispatch_only_noverify(TosState state);
@@ -238,3 +239,6 @@
   // support for jvmti/dtrace
   void notify_method_entry();
   void notify_method_exit(TosState state, NotifyMethodExitMode mode);
+  // Jumps to not_traced unless the current method is selected for
+  // JvmtiSelectiveMethodTrace and its events are enabled
+  void check_jvmti_traced_method(Register tmp, Label& not_traced);
@@ -1301,6 +1301,74 @@ void MacroAssembler::biased_locking_exit(Register obj_reg, Register temp_reg, La
   jcc(Assembler::equal, done);
 }
 
+#ifdef _LP64
+// Lightweight locking (-XX:+UseLightweightLocking)
+// Fast-lock obj by clearing the lock bits of its neutral mark and pushing
+// it on the thread's lock stack. Branches to slow if the lock stack is full
+// or the mark is not neutral.
+// hdr: must be rax, holds the mark word on entry -- KILLED
+// tmp: KILLED
+void MacroAssembler::lightweight_lock(Register obj, Register hdr, Register thread,
+                                      Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "why call this otherwise?");
+  assert(hdr == rax, "cmpxchg comparand");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  // Lock stack full?
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  cmpl(tmp, LockStack::CAPACITY);
+  jcc(Assembler::greaterEqual, slow);
+
+  // Try to swing the mark from neutral (01) to fast-locked (00)
+  andptr(hdr, ~(int32_t)markOopDesc::lock_mask_in_place);
+  movptr(tmp, hdr);
+  orptr(hdr, markOopDesc::unlocked_value);
+  if (os::is_MP()) {
+    lock();
+  }
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+
+  // Push obj
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  movptr(Address(thread, tmp, Address::times_ptr, in_bytes(JavaThread::lock_stack_base_offset())), obj);
+  incrementl(Address(thread, JavaThread::lock_stack_top_offset()));
+}
+
+// Fast-unlock obj if it is on top of the thread's lock stack and its mark
+// is still fast-locked. Branches to slow otherwise, e.g. when a contending
+// thread has inflated the object.
+// hdr: must be rax -- KILLED
+// tmp: KILLED
+void MacroAssembler::lightweight_unlock(Register obj, Register hdr, Register thread,
+                                        Register tmp, Label& slow) {
+  assert(UseLightweightLocking, "why call this otherwise?");
+  assert(hdr == rax, "cmpxchg comparand");
+  assert_different_registers(obj, hdr, thread, tmp);
+
+  // obj must be on top of the lock stack
+  movl(tmp, Address(thread, JavaThread::lock_stack_top_offset()));
+  testl(tmp, tmp);
+  jcc(Assembler::zero, slow);
+  cmpptr(obj, Address(thread, tmp, Address::times_ptr, in_bytes(JavaThread::lock_stack_base_offset()) - oopSize));
+  jcc(Assembler::notEqual, slow);
+
+  // Try to swing the mark from fast-locked (00) back to neutral (01)
+  movptr(hdr, Address(obj, oopDesc::mark_offset_in_bytes()));
+  movptr(tmp, hdr);
+  orptr(tmp, markOopDesc::unlocked_value);
+  andptr(hdr, ~(int32_t)markOopDesc::lock_mask_in_place);
+  if (os::is_MP()) {
+    lock();
+  }
+  cmpxchgptr(tmp, Address(obj, oopDesc::mark_offset_in_bytes()));
+  jcc(Assembler::notEqual, slow);
+
+  // Pop obj
+  decrementl(Address(thread, JavaThread::lock_stack_top_offset()));
+}
+#endif // _LP64
+
 #ifdef COMPILER2
 
 #if INCLUDE_RTM_OPT
@@ -1714,6 +1782,43 @@ void MacroAssembler::fast_lock(Register objReg, Register boxReg, Register tmpReg
   if (counters != NULL) {
     atomic_incl(ExternalAddress((address)counters->total_entry_count_addr()), scrReg);
   }
+#ifdef _LP64
+  if (UseLightweightLocking) {
+    // The box is not used; inflated recursion is handled inline.
+    Label IsInflated, Slow, DONE_LABEL;
+
+    movptr(tmpReg, Address(objReg, 0));          // fetch markword
+    testptr(tmpReg, markOopDesc::monitor_value);
+    jcc(Assembler::notZero, IsInflated);
+
+    lightweight_lock(objReg, tmpReg, r15_thread, scrReg, Slow);
+    xorl(tmpReg, tmpReg);                        // set ZF=1 to indicate success
+    jmp(DONE_LABEL);
+
+    bind(IsInflated);
+    // tmpReg contains pointer to ObjectMonitor* + 2(monitor_value)
+    movptr(boxReg, tmpReg);
+    xorptr(tmpReg, tmpReg);
+    if (os::is_MP()) {
+      lock();
+    }
+    cmpxchgptr(r15_thread, Address(boxReg, ObjectMonitor::owner_offset_in_bytes()-2));
+    jcc(Assembler::equal, DONE_LABEL);           // ZF=1, acquired
+
+    // Recursive enter of a monitor we own; rax holds the current owner.
+    // An anonymous owner falls to the slow path which claims the monitor.
+    cmpptr(tmpReg, r15_thread);
+    jcc(Assembler::notEqual, DONE_LABEL);        // ZF=0
+    incrementq(Address(boxReg, ObjectMonitor::recursions_offset_in_bytes()-2));
+    xorl(tmpReg, tmpReg);                        // set ZF=1 to indicate success
+    jmp(DONE_LABEL);
+
+    bind(Slow);
+    testptr(objReg, objReg);                     // obj is non-null, set ZF=0
+    bind(DONE_LABEL);
+    return;
+  }
+#endif // _LP64
   if (EmitSync & 1) {
       // set box->dhw = unused_mark (3)
       // Force all sync thru slow-path: slow_enter() and slow_exit()
@@ -2017,6 +2122,41 @@ void MacroAssembler::fast_unlock(Register objReg, Register boxReg, Register tmpR
   assert(boxReg == rax, "");
   assert_different_registers(objReg, boxReg, tmpReg);
 
+#ifdef _LP64
+  if (UseLightweightLocking) {
+    // There is no displaced header in the box to check for recursion.
+    Label IsInflated, Slow, DONE_LABEL;
+
+    movptr(tmpReg, Address(objReg, 0));          // fetch markword
+    testptr(tmpReg, markOopDesc::monitor_value);
+    jcc(Assembler::notZero, IsInflated);
+
+    lightweight_unlock(objReg, boxReg, r15_thread, tmpReg, Slow);
+    xorl(boxReg, boxReg);                        // set ZF=1 to indicate success
+    jmp(DONE_LABEL);
+
+    bind(IsInflated);
+    // Only the uncontended, non-recursive exit of a monitor we own is done
+    // inline; anonymous owners, recursion and successor selection go to
+    // the slow path.
+    movptr(boxReg, Address(tmpReg, ObjectMonitor::owner_offset_in_bytes()-2));
+    xorptr(boxReg, r15_thread);
+    orptr (boxReg, Address(tmpReg, ObjectMonitor::recursions_offset_in_bytes()-2));
+    jcc   (Assembler::notZero, DONE_LABEL);      // ZF=0
+    movptr(boxReg, Address(tmpReg, ObjectMonitor::cxq_offset_in_bytes()-2));
+    orptr (boxReg, Address(tmpReg, ObjectMonitor::EntryList_offset_in_bytes()-2));
+    jcc   (Assembler::notZero, DONE_LABEL);      // ZF=0
+    // ZF is still 1 here
+    movptr(Address(tmpReg, ObjectMonitor::owner_offset_in_bytes()-2), (int32_t)NULL_WORD);
+    jmp(DONE_LABEL);
+
+    bind(Slow);
+    testptr(objReg, objReg);                     // obj is non-null, set ZF=0
+    bind(DONE_LABEL);
+    return;
+  }
+#endif // _LP64
+
   if (EmitSync & 4) {
     // Disable - inhibit all inlining.  Force control through the slow-path
     cmpptr (rsp, 0);
@@ -5183,6 +5323,53 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   LP64_ONLY( incrementl(Address(rcx, 0)) );
 #endif //PRODUCT
 
+  Label L_unspill;
+  if (UseSecondarySupersTable) {
+    Label L_linear, L_miss;
+    Address bitmap_addr(sub_klass, in_bytes(Klass::secondary_supers_bitmap_offset()));
+    cmpptr(bitmap_addr, (int32_t)Klass::SECONDARY_SUPERS_BITMAP_FULL);
+    jcc(Assembler::equal, L_linear);
+
+    // Shift the super's bit in the bitmap up to the sign bit. A clear bit
+    // is a miss, otherwise the bits left over count the table entries up
+    // to the first one that can match, plus one.
+    movzbl(rcx, Address(rax, Klass::hash_slot_offset()));
+    xorl(rcx, BitsPerWord - 1);
+    movptr(rdi, bitmap_addr);
+    shlptr(rdi);
+    testptr(rdi, rdi);
+    jccb(Assembler::positive, L_miss);
+    LP64_ONLY(popcntq(rcx, rdi)) NOT_LP64(popcntl(rcx, rdi));
+
+    // sub_klass may have been rdi, whose value was then spilled last.
+    if (sub_klass == rdi) {
+      assert(pushed_rdi, "sub_klass is not a temp");
+      movptr(rdi, Address(rsp, 0));
+      movptr(rdi, Address(rdi, Klass::secondary_supers_table_offset()));
+    } else {
+      movptr(rdi, Address(sub_klass, Klass::secondary_supers_table_offset()));
+    }
+    // RDI = &table[index], RCX = length - index.
+    lea(rdi, Address(rdi, rcx, Address::times_ptr, Array<Klass*>::base_offset_in_bytes() - wordSize));
+    negptr(rcx);
+    addl(rcx, Address(rdi, rcx, Address::times_ptr,
+                      Array<Klass*>::length_offset_in_bytes() - Array<Klass*>::base_offset_in_bytes() + wordSize));
+    incrementl(rcx);
+
+    // Scan the rest of the table; it is sorted by hash slot, so a match,
+    // if any, comes within the first few words.
+    testptr(rax, rax); // Set Z = 0
+    repne_scan();
+    jmp(L_unspill);
+
+    bind(L_miss);
+    movptr(rdi, rax);  // keep rdi non-NULL for the AD files
+    testptr(rax, rax); // Set Z = 0
+    jmp(L_unspill);
+
+    bind(L_linear);
+  }
+
   // We will consult the secondary-super array.
   movptr(rdi, secondary_supers_addr);
   // Load the array length.  (Positive movl does right thing on LP64.)
@@ -5199,6 +5386,7 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
     testptr(rax,rax); // Set Z = 0
     repne_scan();
 
+  bind(L_unspill);
   // Unspill the temp. registers:
   if (pushed_rdi)  pop(rdi);
   if (pushed_rcx)  pop(rcx);
@@ -5215,7 +5403,11 @@ void MacroAssembler::check_klass_subtype_slow_path(Register sub_klass,
   else  jcc(Assembler::notEqual, *L_failure);
 
   // Success.  Cache the super we found and proceed in triumph.
-  movptr(super_cache_addr, super_klass);
+  // With the table the cache is not used, and not writing it keeps
+  // concurrent checks from bouncing the cache line between CPUs.
+  if (!UseSecondarySupersTable) {
+    movptr(super_cache_addr, super_klass);
+  }
 
   if (L_success != &L_fallthrough) {
     jmp(*L_success);
@@ -6292,6 +6484,28 @@ void MacroAssembler::clear_mem(Register base, Register cnt, Register tmp) {
   assert(cnt==rcx,   "cnt register must be ecx for rep stos");
 
   xorptr(tmp, tmp);
+#ifdef _LP64
+  if (NonTemporalStoreThreshold > 0) {
+    // Zero big blocks with non-temporal stores so that they do not
+    // evict the cache; the rest is left to rep stos.
+    Label L_small, L_nt_loop;
+    int nt_qwords = (int)MIN2(MAX2(NonTemporalStoreThreshold / BytesPerLong, (uintx)16),
+                              (uintx)max_jint);
+    cmpptr(cnt, nt_qwords);
+    jcc(Assembler::below, L_small);
+    align(16);
+    BIND(L_nt_loop);
+    for (int i = 0; i < 64; i += 8) {
+      movntiq(Address(base, i), tmp);
+    }
+    addptr(base, 64);
+    subptr(cnt, 8);
+    cmpptr(cnt, 8);
+    jcc(Assembler::aboveEqual, L_nt_loop);
+    sfence();
+    BIND(L_small);
+  }
+#endif
   if (UseFastStosb) {
     shlptr(cnt,3); // convert to number of bytes
     rep_stosb();
@@ -7189,6 +7403,54 @@ void MacroAssembler::generate_fill(BasicType t, bool aligned,
       assert( UseSSE >= 2, "supported cpu only" );
       Label L_fill_32_bytes_loop, L_check_fill_8_bytes, L_fill_8_bytes_loop, L_fill_8_bytes;
       movdl(xtmp, value);
+      if (NonTemporalStoreThreshold > 0) {
+        // Fill big arrays with non-temporal stores so that they do not
+        // evict the cache; the tail is filled below.
+        Label L_nt_align, L_nt_aligned, L_nt_loop, L_nt_done;
+        int nt_count = (int)MIN2(MAX2(NonTemporalStoreThreshold, (uintx)128),
+                                 (uintx)(max_jint >> 2)) >> 2 << shift;
+        pshufd(xtmp, xtmp, 0);
+        cmpl(count, nt_count);
+        jcc(Assembler::less, L_nt_done);
+        if (UseUnalignedLoadStores && !aligned && (t == T_BYTE || t == T_SHORT)) {
+          // not aligned at 4 bytes above
+          Label L_nt_skip_align1, L_nt_skip_align2;
+          if (t == T_BYTE) {
+            testptr(to, 1);
+            jccb(Assembler::zero, L_nt_skip_align1);
+            movb(Address(to, 0), value);
+            increment(to);
+            decrement(count);
+            BIND(L_nt_skip_align1);
+          }
+          testptr(to, 2);
+          jccb(Assembler::zero, L_nt_skip_align2);
+          movw(Address(to, 0), value);
+          addptr(to, 2);
+          subl(count, 1<<(shift-1));
+          BIND(L_nt_skip_align2);
+        }
+        BIND(L_nt_align);
+        testptr(to, 15);
+        jccb(Assembler::zero, L_nt_aligned);
+        movl(Address(to, 0), value);
+        addptr(to, 4);
+        subl(count, 1 << shift);
+        jmpb(L_nt_align);
+        BIND(L_nt_aligned);
+        subl(count, 16 << shift);
+        align(16);
+        BIND(L_nt_loop);
+        for (int i = 0; i < 64; i += 16) {
+          movntdq(Address(to, i), xtmp);
+        }
+        addptr(to, 64);
+        subl(count, 16 << shift);
+        jcc(Assembler::greaterEqual, L_nt_loop);
+        addl(count, 16 << shift);
+        sfence();
+        BIND(L_nt_done);
+      }
       if (UseAVX >= 2 && UseUnalignedLoadStores) {
         // Fill 64-byte chunks
         Label L_fill_64_bytes_loop, L_check_fill_32_bytes;
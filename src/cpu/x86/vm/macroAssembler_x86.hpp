@@ -659,6 +659,13 @@ class MacroAssembler: public Assembler {
                            Label& done, Label* slow_case = NULL,
                            BiasedLockingCounters* counters = NULL);
   void biased_locking_exit (Register obj_reg, Register temp_reg, Label& done);
+
+#ifdef _LP64
+  // Lock stack based fast paths for -XX:+UseLightweightLocking.
+  // hdr must be rax; lightweight_lock expects the mark word in it.
+  void lightweight_lock(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+  void lightweight_unlock(Register obj, Register hdr, Register thread, Register tmp, Label& slow);
+#endif
 #ifdef COMPILER2
   // Code used by cmpFastLock and cmpFastUnlock mach instructions in .ad file.
   // See full desription in macroAssembler_x86.cpp.
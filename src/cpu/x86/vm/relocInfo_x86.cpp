@@ -179,7 +179,8 @@ address Relocation::pd_get_address_from_code() {
 
 void poll_Relocation::fix_relocation_after_move(const CodeBuffer* src, CodeBuffer* dest) {
 #ifdef _LP64
-  if (!Assembler::is_polling_page_far()) {
+  // Thread local polls read the polling page through a register.
+  if (!ThreadLocalSafepointPolls && !Assembler::is_polling_page_far()) {
     typedef Assembler::WhichOperand WhichOperand;
     WhichOperand which = (WhichOperand) format();
     // This format is imm but it is really disp32
@@ -201,7 +202,8 @@ void poll_Relocation::fix_relocation_after_move(const CodeBuffer* src, CodeBuffe
 
 void poll_return_Relocation::fix_relocation_after_move(const CodeBuffer* src, CodeBuffer* dest) {
 #ifdef _LP64
-  if (!Assembler::is_polling_page_far()) {
+  // Thread local polls read the polling page through a register.
+  if (!ThreadLocalSafepointPolls && !Assembler::is_polling_page_far()) {
     typedef Assembler::WhichOperand WhichOperand;
     WhichOperand which = (WhichOperand) format();
     // This format is imm but it is really disp32
@@ -3657,6 +3657,8 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
     __ movptr(target_stack, Address(target_coroutine, Coroutine::stack_offset()));
 
     __ movl(Address(target_coroutine, Coroutine::state_offset()), Coroutine::_current);
+    __ movl(Address(target_coroutine, Coroutine::roots_unchanged_offset()), 0);
+    __ movl(Address(target_coroutine, Coroutine::idle_cleanups_offset()), 0);
 
     Register temp = rsi;
     Register temp2 = rdi;
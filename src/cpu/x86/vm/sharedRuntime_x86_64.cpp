@@ -45,6 +45,7 @@
 #endif
 
 #include "runtime/coroutine.hpp"
+#include "runtime/tenantCpuBudget.hpp"
 
 void coroutine_start(Coroutine* coroutine, jobject coroutineObj);
 
@@ -1769,6 +1770,11 @@ void generate_thread_fix(MacroAssembler *masm, Method *method) {
 //    transition back to thread_in_Java
 //    return to caller
 //
+// With TrivialJNINatives a JavaTrivial_ entry is preferred. It is called like
+// a critical native but without the GC_locker check and without any thread
+// state transition or safepoint check: the thread stays in_Java, so
+// safepoints simply wait for the native to return.
+//
 nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
                                                 methodHandle method,
                                                 int compile_id,
@@ -1797,7 +1803,13 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
                                        (OopMapSet*)NULL);
   }
   bool is_critical_native = true;
-  address native_func = method->critical_native_function();
+  bool is_trivial_native = false;
+  address native_func = method->trivial_native_function();
+  if (native_func != NULL) {
+    is_trivial_native = true;
+  } else {
+    native_func = method->critical_native_function();
+  }
   if (native_func == NULL) {
     native_func = method->native_function();
     is_critical_native = false;
@@ -2070,7 +2082,9 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
   const Register oop_handle_reg = r14;
 
-  if (is_critical_native) {
+  // A trivial native is called in _thread_in_Java, so no GC can move the
+  // arrays it is given and it does not need to enter a GC_locker region.
+  if (is_critical_native && !is_trivial_native) {
     check_needs_gc_for_critical_native(masm, stack_slots, total_c_args, total_in_args,
                                        oop_handle_offset, oop_maps, in_regs, in_sig_bt);
   }
@@ -2314,40 +2328,46 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       __ biased_locking_enter(lock_reg, obj_reg, swap_reg, rscratch1, false, lock_done, &slow_path_lock);
     }
 
-    // Load immediate 1 into swap_reg %rax
-    __ movl(swap_reg, 1);
+    if (UseLightweightLocking) {
+      // Load the mark into swap_reg %rax
+      __ movptr(swap_reg, Address(obj_reg, oopDesc::mark_offset_in_bytes()));
+      __ lightweight_lock(obj_reg, swap_reg, r15_thread, rscratch1, slow_path_lock);
+    } else {
+      // Load immediate 1 into swap_reg %rax
+      __ movl(swap_reg, 1);
 
-    // Load (object->mark() | 1) into swap_reg %rax
-    __ orptr(swap_reg, Address(obj_reg, 0));
+      // Load (object->mark() | 1) into swap_reg %rax
+      __ orptr(swap_reg, Address(obj_reg, 0));
 
-    // Save (object->mark() | 1) into BasicLock's displaced header
-    __ movptr(Address(lock_reg, mark_word_offset), swap_reg);
+      // Save (object->mark() | 1) into BasicLock's displaced header
+      __ movptr(Address(lock_reg, mark_word_offset), swap_reg);
 
-    if (os::is_MP()) {
-      __ lock();
-    }
+      if (os::is_MP()) {
+        __ lock();
+      }
 
-    // src -> dest iff dest == rax else rax <- dest
-    __ cmpxchgptr(lock_reg, Address(obj_reg, 0));
-    __ jcc(Assembler::equal, lock_done);
+      // src -> dest iff dest == rax else rax <- dest
+      __ cmpxchgptr(lock_reg, Address(obj_reg, 0));
+      __ jcc(Assembler::equal, lock_done);
 
-    // Hmm should this move to the slow path code area???
+      // Hmm should this move to the slow path code area???
 
-    // Test if the oopMark is an obvious stack pointer, i.e.,
-    //  1) (mark & 3) == 0, and
-    //  2) rsp <= mark < mark + os::pagesize()
-    // These 3 tests can be done by evaluating the following
-    // expression: ((mark - rsp) & (3 - os::vm_page_size())),
-    // assuming both stack pointer and pagesize have their
-    // least significant 2 bits clear.
-    // NOTE: the oopMark is in swap_reg %rax as the result of cmpxchg
+      // Test if the oopMark is an obvious stack pointer, i.e.,
+      //  1) (mark & 3) == 0, and
+      //  2) rsp <= mark < mark + os::pagesize()
+      // These 3 tests can be done by evaluating the following
+      // expression: ((mark - rsp) & (3 - os::vm_page_size())),
+      // assuming both stack pointer and pagesize have their
+      // least significant 2 bits clear.
+      // NOTE: the oopMark is in swap_reg %rax as the result of cmpxchg
 
-    __ subptr(swap_reg, rsp);
-    __ andptr(swap_reg, 3 - os::vm_page_size());
+      __ subptr(swap_reg, rsp);
+      __ andptr(swap_reg, 3 - os::vm_page_size());
 
-    // Save the test result, for recursive case, the result is zero
-    __ movptr(Address(lock_reg, mark_word_offset), swap_reg);
-    __ jcc(Assembler::notEqual, slow_path_lock);
+      // Save the test result, for recursive case, the result is zero
+      __ movptr(Address(lock_reg, mark_word_offset), swap_reg);
+      __ jcc(Assembler::notEqual, slow_path_lock);
+    }
 
     // Slow path will re-enter here
 
@@ -2363,13 +2383,15 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     __ lea(c_rarg0, Address(r15_thread, in_bytes(JavaThread::jni_environment_offset())));
   }
 
-  if (EnableCoroutine) {
+  if (EnableCoroutine && !is_trivial_native) {
     __ movptr(r11, Address(r15_thread, JavaThread::coroutine_list_offset()));
     __ incrementl(Address(r11, Coroutine::native_call_counter_offset()));
   }
 
   // Now set thread in native
-  __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  if (!is_trivial_native) {
+    __ movl(Address(r15_thread, JavaThread::thread_state_offset()), _thread_in_native);
+  }
 
   __ call(RuntimeAddress(native_func));
 
@@ -2400,6 +2422,13 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
   default       : ShouldNotReachHere();
   }
 
+  Label after_transition;
+
+  if (is_trivial_native) {
+    // The thread never left _thread_in_Java, there is no transition back.
+    __ jmp(after_transition);
+  }
+
   // Switch thread to "native transition" state before reading the synchronization state.
   // This additional state is necessary because reading and testing the synchronization
   // state is not atomic w.r.t. GC, as this scenario demonstrates:
@@ -2424,8 +2453,6 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     }
   }
 
-  Label after_transition;
-
   // check for safepoint operation in progress and/or pending suspend requests
   {
     Label Continue;
@@ -2495,28 +2522,33 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       __ biased_locking_exit(obj_reg, old_hdr, done);
     }
 
-    // Simple recursive lock?
+    // Simple recursive lock? The lock stack has no recursive entries.
 
-    __ cmpptr(Address(rsp, lock_slot_offset * VMRegImpl::stack_slot_size), (int32_t)NULL_WORD);
-    __ jcc(Assembler::equal, done);
+    if (!UseLightweightLocking) {
+      __ cmpptr(Address(rsp, lock_slot_offset * VMRegImpl::stack_slot_size), (int32_t)NULL_WORD);
+      __ jcc(Assembler::equal, done);
+    }
 
     // Must save rax if if it is live now because cmpxchg must use it
     if (ret_type != T_FLOAT && ret_type != T_DOUBLE && ret_type != T_VOID) {
       save_native_result(masm, ret_type, stack_slots);
     }
 
-
-    // get address of the stack lock
-    __ lea(rax, Address(rsp, lock_slot_offset * VMRegImpl::stack_slot_size));
-    //  get old displaced header
-    __ movptr(old_hdr, Address(rax, 0));
-
-    // Atomic swap old header if oop still contains the stack lock
-    if (os::is_MP()) {
-      __ lock();
+    if (UseLightweightLocking) {
+      __ lightweight_unlock(obj_reg, rax, r15_thread, old_hdr, slow_path_unlock);
+    } else {
+      // get address of the stack lock
+      __ lea(rax, Address(rsp, lock_slot_offset * VMRegImpl::stack_slot_size));
+      //  get old displaced header
+      __ movptr(old_hdr, Address(rax, 0));
+
+      // Atomic swap old header if oop still contains the stack lock
+      if (os::is_MP()) {
+        __ lock();
+      }
+      __ cmpxchgptr(old_hdr, Address(obj_reg, 0));
+      __ jcc(Assembler::notEqual, slow_path_unlock);
     }
-    __ cmpxchgptr(old_hdr, Address(obj_reg, 0));
-    __ jcc(Assembler::notEqual, slow_path_unlock);
 
     // slow path re-enters here
     __ bind(unlock_done);
@@ -2708,7 +2740,7 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
                                             in_ByteSize(lock_slot_offset*VMRegImpl::stack_slot_size),
                                             oop_maps);
 
-  if (is_critical_native) {
+  if (is_critical_native && !is_trivial_native) {
     nm->set_lazy_critical_native(true);
   }
 
@@ -4453,6 +4485,17 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
     __ movptr(rdx, j_rarg1);
   }
 
+  if (TenantCpuBudgeting) {
+    // charge the time since the last switch to the tenant
+    __ push(rsi);
+    __ push(rdx);
+    __ movptr(c_rarg0, Address(rsi, java_dyn_CoroutineBase::get_data_offset()));
+    __ movptr(c_rarg1, Address(rdx, java_dyn_CoroutineBase::get_data_offset()));
+    __ call_VM_leaf(CAST_FROM_FN_PTR(address, TenantCpuBudget::account_switch), c_rarg0, c_rarg1);
+    __ pop(rdx);
+    __ pop(rsi);
+  }
+
   // push the current IP and frame pointer onto the stack
   __ push(rbp);
 
@@ -4495,17 +4538,12 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
 
     __ movl(Address(old_coroutine, Coroutine::state_offset()) , Coroutine::_onstack);
 
-    // rescue old handle and resource areas
-    __ movptr(temp, Address(thread, Thread::handle_area_offset()));
-    __ movptr(Address(old_coroutine, Coroutine::handle_area_offset()), temp);
-    __ movptr(temp, Address(thread, Thread::resource_area_offset()));
-    __ movptr(Address(old_coroutine, Coroutine::resource_area_offset()), temp);
+    // rescue the old handle mark and JNI handles; the handle and resource
+    // areas and the metadata handles never change while a coroutine lives
     __ movptr(temp, Address(thread, Thread::last_handle_mark_offset()));
     __ movptr(Address(old_coroutine, Coroutine::last_handle_mark_offset()), temp);
     __ movptr(temp, Address(thread, Thread::active_handles_offset()));
     __ movptr(Address(old_coroutine, Coroutine::active_handles_offset()), temp);
-    __ movptr(temp, Address(thread, Thread::metadata_handles_offset()));
-    __ movptr(Address(old_coroutine, Coroutine::metadata_handles_offset()), temp);
     __ movptr(temp, Address(thread, JavaThread::last_Java_pc_offset()));
     __ movptr(Address(old_coroutine, Coroutine::last_Java_pc_offset()), temp);
     __ movptr(temp, Address(thread, JavaThread::last_Java_sp_offset()));
@@ -4530,6 +4568,8 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
     // valid registers: rdx = target Coroutine
 
     __ movl(Address(target_coroutine, Coroutine::state_offset()), Coroutine::_current);
+    __ movl(Address(target_coroutine, Coroutine::roots_unchanged_offset()), 0);
+    __ movl(Address(target_coroutine, Coroutine::idle_cleanups_offset()), 0);
 
     Register temp = r8;
     Register temp2 = r9;
@@ -4559,8 +4599,6 @@ void create_switchTo_contents(MacroAssembler *masm, int start, OopMapSet* oop_ma
       __ movl(temp, Address(target_coroutine, Coroutine::java_call_counter_offset()));
       __ movl(Address(thread, JavaThread::java_call_counter_offset()), temp);
 #ifdef ASSERT
-      __ movptr(Address(target_coroutine, Coroutine::handle_area_offset()), (intptr_t)NULL_WORD);
-      __ movptr(Address(target_coroutine, Coroutine::resource_area_offset()), (intptr_t)NULL_WORD);
       __ movptr(Address(target_coroutine, Coroutine::last_handle_mark_offset()), (intptr_t)NULL_WORD);
       __ movl(Address(target_coroutine, Coroutine::java_call_counter_offset()), 0);
 #endif
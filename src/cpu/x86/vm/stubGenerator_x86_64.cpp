@@ -1301,7 +1301,36 @@ class StubGenerator: public StubCodeGenerator {
                              Register qword_count, Register to,
                              Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
-    Label L_loop;
+    Label L_loop, L_entry;
+    if (UseUnalignedLoadStores && NonTemporalStoreThreshold > 0) {
+      // Big copies store with movntdq so that the destination does not
+      // evict the cache; the tail is copied by the loop below.
+      Label L_nt_aligned, L_nt_loop;
+      int nt_qwords = (int)MIN2(MAX2(NonTemporalStoreThreshold / BytesPerLong, (uintx)16),
+                                (uintx)max_jint);
+      __ BIND(L_copy_bytes);
+      __ cmpptr(qword_count, -nt_qwords);
+      __ jcc(Assembler::greater, L_entry);
+      // align the destination at 16 bytes
+      __ lea(to, Address(end_to, qword_count, Address::times_8, 8));
+      __ testptr(to, 8);
+      __ jccb(Assembler::zero, L_nt_aligned);
+      __ movq(to, Address(end_from, qword_count, Address::times_8, 8));
+      __ movq(Address(end_to, qword_count, Address::times_8, 8), to);
+      __ increment(qword_count);
+      __ BIND(L_nt_aligned);
+      __ align(OptoLoopAlignment);
+      __ BIND(L_nt_loop);
+      for (int i = 8; i < 64 + 8; i += 16) {
+        __ movdqu(xmm0, Address(end_from, qword_count, Address::times_8, i));
+        __ movntdq(Address(end_to, qword_count, Address::times_8, i), xmm0);
+      }
+      __ addptr(qword_count, 8);
+      __ cmpptr(qword_count, -8);
+      __ jcc(Assembler::lessEqual, L_nt_loop);
+      __ sfence();
+      __ jmp(L_entry);
+    }
     __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
       Label L_end;
@@ -1322,7 +1351,11 @@ class StubGenerator: public StubCodeGenerator {
         __ movdqu(xmm3, Address(end_from, qword_count, Address::times_8, - 8));
         __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
       }
-      __ BIND(L_copy_bytes);
+      if (NonTemporalStoreThreshold > 0) {
+        __ BIND(L_entry);
+      } else {
+        __ BIND(L_copy_bytes);
+      }
       __ addptr(qword_count, 8);
       __ jcc(Assembler::lessEqual, L_loop);
       __ subptr(qword_count, 4);  // sub(8) and add(4)
@@ -3861,6 +3894,297 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // 31^n modulo 2^32
+  static jint pow31(int n) {
+    juint p = 1;
+    for (int i = 0; i < n; i++) {
+      p *= 31;
+    }
+    return (jint)p;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - int h
+   *   c_rarg1   - address of the first element
+   *   c_rarg2   - int element count
+   *
+   * Ouput:
+   *       rax   - int hash: for (i = 0; i < count; i++) h = 31 * h + a[i]
+   *
+   * Eight elements are hashed per iteration: the accumulator lanes are
+   * multiplied by 31^8 and the next elements added, and the lanes are
+   * weighted by 31^7 .. 31^0 at the end.  The initial hash is scaled by
+   * 31^(8 * iterations) separately.
+   */
+  address generate_arrayHashCode(BasicType elem_type, const char* name) {
+    assert(UseArrayHashCodeIntrinsics && UseAVX >= 2, "need AVX2 instructions");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+
+    // lane weights
+    address powers = __ pc();
+    for (int i = 7; i >= 0; i--) {
+      __ emit_int32(pow31(i));
+    }
+
+    address start = __ pc();
+    // Win64: rcx, rdx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // Unix:  rdi, rsi, rdx, rcx, r8, r9 (c_rarg0, c_rarg1, ...)
+    const Register h     = c_rarg0;
+    const Register ary   = c_rarg1;
+    const Register cnt   = c_rarg2;
+    const Register power = r10;  // 31^(8 * iterations)
+    const Register tmp   = r11;
+    assert_different_registers(h, ary, cnt, power, tmp, rax);
+
+    const XMMRegister vacc  = xmm0;
+    const XMMRegister vnext = xmm1;
+    const XMMRegister vmul  = xmm2;
+    const XMMRegister vtmp  = xmm3;
+
+    const int elem_size = type2aelembytes(elem_type);
+    const jint pow8 = pow31(8);
+
+    Label L_vector_loop, L_tail, L_tail_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ movl(rax, h);
+    __ cmpl(cnt, 8);
+    __ jcc(Assembler::less, L_tail);
+
+    __ movl(tmp, pow8);
+    __ movdl(vmul, tmp);
+    __ vpbroadcastd(vmul, vmul);
+    __ vpxor(vacc, vacc, vacc, true);
+    __ movl(power, 1);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_vector_loop);
+    switch (elem_type) {
+    case T_BYTE: __ vpmovsxbd(vnext, Address(ary, 0), true); break;
+    case T_CHAR: __ vpmovzxwd(vnext, Address(ary, 0), true); break;
+    case T_INT:  __ vmovdqu(vnext, Address(ary, 0));         break;
+    default:     ShouldNotReachHere();
+    }
+    __ vpmulld(vacc, vacc, vmul, true);
+    __ vpaddd(vacc, vacc, vnext, true);
+    __ imull(power, power, pow8);
+    __ addptr(ary, 8 * elem_size);
+    __ subl(cnt, 8);
+    __ cmpl(cnt, 8);
+    __ jcc(Assembler::greaterEqual, L_vector_loop);
+
+    // weight the lanes and sum them up
+    __ lea(tmp, InternalAddress(powers));
+    __ vpmulld(vacc, vacc, Address(tmp, 0), true);
+    __ vextracti128h(vtmp, vacc);
+    __ vpaddd(vacc, vacc, vtmp, false);
+    __ pshufd(vtmp, vacc, 0x4E);
+    __ vpaddd(vacc, vacc, vtmp, false);
+    __ pshufd(vtmp, vacc, 0xB1);
+    __ vpaddd(vacc, vacc, vtmp, false);
+    __ movdl(tmp, vacc);
+    __ imull(rax, power);
+    __ addl(rax, tmp);
+
+    __ BIND(L_tail);
+    __ testl(cnt, cnt);
+    __ jcc(Assembler::zero, L_done);
+
+    __ BIND(L_tail_loop);
+    switch (elem_type) {
+    case T_BYTE: __ load_signed_byte(tmp, Address(ary, 0));    break;
+    case T_CHAR: __ load_unsigned_short(tmp, Address(ary, 0)); break;
+    case T_INT:  __ movl(tmp, Address(ary, 0));                break;
+    default:     ShouldNotReachHere();
+    }
+    __ imull(rax, rax, 31);
+    __ addl(rax, tmp);
+    __ addptr(ary, elem_size);
+    __ decrementl(cnt);
+    __ jcc(Assembler::notZero, L_tail_loop);
+
+    __ BIND(L_done);
+    __ vzeroupper();
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   * Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - address a
+   *   c_rarg1   - address b
+   *   c_rarg2   - size_t length in bytes
+   *
+   * Ouput:
+   *       rax   - index of the first differing byte, -1 if the ranges are equal
+   *
+   * Sixteen bytes are compared per iteration, then eight, then single bytes.
+   * The position of a difference within a word is found from the lowest
+   * set bit of the xor of the two words.
+   */
+  address generate_unsafeVectorizedMismatch() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "unsafeVectorizedMismatch");
+
+    address start = __ pc();
+    const Register a      = c_rarg0;
+    const Register b      = c_rarg1;
+    const Register length = c_rarg2;
+    const Register index  = rax;
+    const Register diff   = r10;
+    const Register tmp    = r11;
+    assert_different_registers(a, b, length, index, diff, tmp);
+
+    Label L_loop16, L_word, L_found_diff, L_tail, L_tail_loop, L_equal, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ xorl(index, index);
+    __ cmpq(length, 16);
+    __ jcc(Assembler::less, L_word);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_loop16);
+    __ movq(diff, Address(a, index, Address::times_1));
+    __ xorq(diff, Address(b, index, Address::times_1));
+    __ jcc(Assembler::notZero, L_found_diff);
+    __ movq(diff, Address(a, index, Address::times_1, 8));
+    __ xorq(diff, Address(b, index, Address::times_1, 8));
+    __ jcc(Assembler::notZero, L_tail);         // let the word step find it
+    __ addq(index, 16);
+    __ leaq(tmp, Address(index, 16));
+    __ cmpq(tmp, length);
+    __ jcc(Assembler::lessEqual, L_loop16);
+
+    __ BIND(L_word);
+    __ leaq(tmp, Address(index, 8));
+    __ cmpq(tmp, length);
+    __ jcc(Assembler::greater, L_tail);
+    __ movq(diff, Address(a, index, Address::times_1));
+    __ xorq(diff, Address(b, index, Address::times_1));
+    __ jcc(Assembler::notZero, L_found_diff);
+    __ addq(index, 8);
+    __ jmp(L_word);
+
+    __ BIND(L_found_diff);
+    __ bsfq(diff, diff);
+    __ shrq(diff, LogBitsPerByte);
+    __ addq(index, diff);
+    __ jmp(L_done);
+
+    __ BIND(L_tail);
+    // the second word of a 16 byte step differs, or less than 8 bytes left
+    __ cmpq(index, length);
+    __ jcc(Assembler::greaterEqual, L_equal);
+    __ BIND(L_tail_loop);
+    __ movzbl(diff, Address(a, index, Address::times_1));
+    __ movzbl(tmp, Address(b, index, Address::times_1));
+    __ cmpl(diff, tmp);
+    __ jcc(Assembler::notEqual, L_done);
+    __ incrementq(index);
+    __ cmpq(index, length);
+    __ jcc(Assembler::less, L_tail_loop);
+
+    __ BIND(L_equal);
+    __ movptr(index, -1);
+
+    __ BIND(L_done);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   * Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - address p
+   *   c_rarg1   - size_t length in bytes
+   *   c_rarg2   - seed, only the low 32 bits are used
+   *
+   * Ouput:
+   *       eax   - int hash, see unsafe_hash() in unsafe.cpp
+   */
+  address generate_unsafeHash() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "unsafeHash");
+
+    address start = __ pc();
+    const Register p      = c_rarg0;
+    const Register length = c_rarg1;
+    const Register word   = c_rarg2;  // seed on entry
+    const Register h      = rax;
+    const Register mul    = r10;
+    const Register tmp    = r11;
+    assert_different_registers(p, length, word, h, mul, tmp);
+
+    Label L_loop, L_tail, L_tail_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    // h = length * M + (juint)seed
+    __ movl(h, word);
+    __ mov64(mul, (int64_t)CONST64(0x9E3779B97F4A7C15));
+    __ movq(tmp, length);
+    __ imulq(tmp, mul);
+    __ addq(h, tmp);
+
+    __ cmpq(length, 8);
+    __ jcc(Assembler::less, L_tail);
+
+    __ align(OptoLoopAlignment);
+    __ BIND(L_loop);
+    __ xorq(h, Address(p, 0));
+    __ imulq(h, mul);
+    __ movq(tmp, h);
+    __ shrq(tmp, 29);
+    __ xorq(h, tmp);
+    __ addptr(p, 8);
+    __ subq(length, 8);
+    __ cmpq(length, 8);
+    __ jcc(Assembler::greaterEqual, L_loop);
+
+    __ BIND(L_tail);
+    __ testq(length, length);
+    __ jcc(Assembler::zero, L_done);
+    // collect the trailing bytes into a little endian word
+    __ xorl(word, word);
+    __ BIND(L_tail_loop);
+    __ shlq(word, BitsPerByte);
+    __ movzbl(tmp, Address(p, length, Address::times_1, -1));
+    __ orq(word, tmp);
+    __ decrementq(length);
+    __ jcc(Assembler::notZero, L_tail_loop);
+    __ xorq(h, word);
+    __ imulq(h, mul);
+    __ movq(tmp, h);
+    __ shrq(tmp, 29);
+    __ xorq(h, tmp);
+
+    __ BIND(L_done);
+    __ movq(tmp, h);
+    __ shrq(tmp, 32);
+    __ xorq(h, tmp);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
 
   /**
    *  Arguments:
@@ -4206,6 +4530,59 @@ class StubGenerator: public StubCodeGenerator {
     }
   }
 
+  // The compiler intrinsic stubs of a StubRoutines::LazyStubGroup
+  void generate_lazy_group(int group) {
+    switch (group) {
+    case StubRoutines::lazy_aes:
+      // don't bother generating these AES intrinsic stubs unless global flag is set
+      if (UseAESIntrinsics) {
+        StubRoutines::x86::_key_shuffle_mask_addr = generate_key_shuffle_mask();  // needed by the others
+
+        StubRoutines::_aescrypt_encryptBlock = generate_aescrypt_encryptBlock();
+        StubRoutines::_aescrypt_decryptBlock = generate_aescrypt_decryptBlock();
+        StubRoutines::_cipherBlockChaining_encryptAESCrypt = generate_cipherBlockChaining_encryptAESCrypt();
+        StubRoutines::_cipherBlockChaining_decryptAESCrypt = generate_cipherBlockChaining_decryptAESCrypt_Parallel();
+      }
+      break;
+    case StubRoutines::lazy_ghash:
+      // Generate GHASH intrinsics code
+      if (UseGHASHIntrinsics) {
+        StubRoutines::x86::_ghash_long_swap_mask_addr = generate_ghash_long_swap_mask();
+        StubRoutines::x86::_ghash_byte_swap_mask_addr = generate_ghash_byte_swap_mask();
+        StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
+      }
+      break;
+#ifdef COMPILER2
+    case StubRoutines::lazy_big_integer:
+      if (UseMultiplyToLenIntrinsic) {
+        StubRoutines::_multiplyToLen = generate_multiplyToLen();
+      }
+      if (UseSquareToLenIntrinsic) {
+        StubRoutines::_squareToLen = generate_squareToLen();
+      }
+      if (UseMulAddIntrinsic) {
+        StubRoutines::_mulAdd = generate_mulAdd();
+      }
+      break;
+    case StubRoutines::lazy_array_hash_code:
+      if (UseArrayHashCodeIntrinsics) {
+        StubRoutines::_byteArrayHashCode = generate_arrayHashCode(T_BYTE, "byteArrayHashCode");
+        StubRoutines::_charArrayHashCode = generate_arrayHashCode(T_CHAR, "charArrayHashCode");
+        StubRoutines::_intArrayHashCode  = generate_arrayHashCode(T_INT,  "intArrayHashCode");
+      }
+      break;
+    case StubRoutines::lazy_unsafe_memory:
+      if (UseUnsafeMemoryIntrinsics) {
+        StubRoutines::_unsafeVectorizedMismatch = generate_unsafeVectorizedMismatch();
+        StubRoutines::_unsafeHash               = generate_unsafeHash();
+      }
+      break;
+#endif // COMPILER2
+    default:
+      break;
+    }
+  }
+
   void generate_all() {
     // Generates all stubs and initializes the entry points
 
@@ -4249,21 +4626,11 @@ class StubGenerator: public StubCodeGenerator {
 
     generate_math_stubs();
 
-    // don't bother generating these AES intrinsic stubs unless global flag is set
-    if (UseAESIntrinsics) {
-      StubRoutines::x86::_key_shuffle_mask_addr = generate_key_shuffle_mask();  // needed by the others
-
-      StubRoutines::_aescrypt_encryptBlock = generate_aescrypt_encryptBlock();
-      StubRoutines::_aescrypt_decryptBlock = generate_aescrypt_decryptBlock();
-      StubRoutines::_cipherBlockChaining_encryptAESCrypt = generate_cipherBlockChaining_encryptAESCrypt();
-      StubRoutines::_cipherBlockChaining_decryptAESCrypt = generate_cipherBlockChaining_decryptAESCrypt_Parallel();
-    }
-
-    // Generate GHASH intrinsics code
-    if (UseGHASHIntrinsics) {
-      StubRoutines::x86::_ghash_long_swap_mask_addr = generate_ghash_long_swap_mask();
-      StubRoutines::x86::_ghash_byte_swap_mask_addr = generate_ghash_byte_swap_mask();
-      StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
+    // With LazyStubGeneration these are generated when a compiler asks for them
+    if (!LazyStubGeneration) {
+      for (int group = 0; group < StubRoutines::lazy_group_count; group++) {
+        generate_lazy_group(group);
+      }
     }
 
     // Safefetch stubs.
@@ -4274,16 +4641,6 @@ class StubGenerator: public StubCodeGenerator {
                                                        &StubRoutines::_safefetchN_fault_pc,
                                                        &StubRoutines::_safefetchN_continuation_pc);
 #ifdef COMPILER2
-    if (UseMultiplyToLenIntrinsic) {
-      StubRoutines::_multiplyToLen = generate_multiplyToLen();
-    }
-    if (UseSquareToLenIntrinsic) {
-      StubRoutines::_squareToLen = generate_squareToLen();
-    }
-    if (UseMulAddIntrinsic) {
-      StubRoutines::_mulAdd = generate_mulAdd();
-    }
-
 #ifndef _WINDOWS
     if (UseMontgomeryMultiplyIntrinsic) {
       StubRoutines::_montgomeryMultiply
@@ -4305,8 +4662,32 @@ class StubGenerator: public StubCodeGenerator {
       generate_initial();
     }
   }
+
+  StubGenerator(CodeBuffer* code, int lazy_group) : StubCodeGenerator(code) {
+    generate_lazy_group(lazy_group);
+  }
 }; // end class declaration
 
 void StubGenerator_generate(CodeBuffer* code, bool all) {
   StubGenerator g(code, all);
 }
+
+// Generates one StubRoutines::LazyStubGroup into a blob of its own; NULL if
+// the code cache is full.
+BufferBlob* StubGenerator_generate_lazily(int group) {
+  static const int code_size[StubRoutines::lazy_group_count] = {
+    StubRoutines::code_size_lazy_aes,
+    StubRoutines::code_size_lazy_ghash,
+    StubRoutines::code_size_lazy_big_integer,
+    StubRoutines::code_size_lazy_array_hash_code,
+    StubRoutines::code_size_lazy_unsafe_memory
+  };
+  BufferBlob* blob = BufferBlob::create("StubRoutines (lazy)", code_size[group]);
+  if (blob == NULL) {
+    return NULL;
+  }
+  CodeBuffer buffer(blob);
+  StubGenerator g(&buffer, group);
+  assert(buffer.insts_remaining() > 200, "increase code_size_lazy");
+  return blob;
+}
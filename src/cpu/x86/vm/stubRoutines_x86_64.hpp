@@ -33,7 +33,13 @@ static bool    returns_to_call_stub(address return_pc)   { return return_pc == _
 
 enum platform_dependent_constants {
   code_size1 = 19000,          // simply increase if too small (assembler will crash if too small)
-  code_size2 = 24000           // simply increase if too small (assembler will crash if too small)
+  code_size2 = 24000,          // simply increase if too small (assembler will crash if too small)
+  // the groups generated with LazyStubGeneration, see LazyStubGroup
+  code_size_lazy_aes             = 8000,
+  code_size_lazy_ghash           = 2000,
+  code_size_lazy_big_integer     = 6000,
+  code_size_lazy_array_hash_code = 4000,
+  code_size_lazy_unsafe_memory   = 2000
 };
 
 class x86 {
@@ -3308,7 +3308,8 @@ void TemplateTable::_new() {
   // (creates a new TLAB, etc.)
 
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    ObjectProfilerSampleBytes == 0;
 
   const Register thread = rcx;
   if (UseTLAB || allow_shared_alloc) {
@@ -32,6 +32,7 @@
 #include "oops/objArrayKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -44,7 +45,18 @@
 // Platform-dependent initialization
 
 void TemplateTable::pd_initialize() {
-  // No amd64 specific initialization
+  // For better readability
+  const int  ____ = 0;
+  const int  ubcp = 1 << Template::uses_bcp_bit;
+  const int  clvm = 1 << Template::calls_vm_bit;
+  //                                      interpr. templates
+  // amd64 specific bytecodes             ubcp|disp|clvm|iswd  in    out   generator             argument
+  def(Bytecodes::_fast_iload2_if_icmpeq , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , equal        );
+  def(Bytecodes::_fast_iload2_if_icmpne , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , not_equal    );
+  def(Bytecodes::_fast_iload2_if_icmplt , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , less         );
+  def(Bytecodes::_fast_iload2_if_icmpge , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , greater_equal);
+  def(Bytecodes::_fast_iload2_if_icmpgt , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , greater      );
+  def(Bytecodes::_fast_iload2_if_icmple , ubcp|____|clvm|____, vtos, vtos, fast_iload2_if_icmp , less_equal   );
 }
 
 // Address computation: local variables
@@ -501,9 +513,21 @@ void TemplateTable::iload() {
     __ cmpl(rbx, Bytecodes::_iload);
     __ jcc(Assembler::equal, done);
 
+    // if _fast_iload, rewrite to fast_iload2, or to the fused
+    // fast_iload2_if_icmp<cond> if the pair feeds an if_icmp<cond>
+    Label not_pair;
     __ cmpl(rbx, Bytecodes::_fast_iload);
+    __ jccb(Assembler::notEqual, not_pair);
     __ movl(bc, Bytecodes::_fast_iload2);
-    __ jccb(Assembler::equal, rewrite);
+    __ load_unsigned_byte(rbx,
+                          at_bcp(2 * Bytecodes::length_for(Bytecodes::_iload)));
+    __ subl(rbx, Bytecodes::_if_icmpeq);
+    __ cmpl(rbx, Bytecodes::_if_icmple - Bytecodes::_if_icmpeq);
+    __ jccb(Assembler::above, rewrite);  // unsigned: not an if_icmp<cond>
+    __ addl(rbx, Bytecodes::_fast_iload2_if_icmpeq);
+    __ movl(bc, rbx);
+    __ jmpb(rewrite);
+    __ bind(not_pair);
 
     // if _caload, rewrite to fast_icaload
     __ cmpl(rbx, Bytecodes::_caload);
@@ -534,6 +558,27 @@ void TemplateTable::fast_iload2() {
   __ movl(rax, iaddress(rbx));
 }
 
+// iload a; iload b; if_icmp<cond>
+void TemplateTable::fast_iload2_if_icmp(Condition cc) {
+  transition(vtos, vtos);
+  const int if_icmp_offset = 2 * Bytecodes::length_for(Bytecodes::_iload);
+  // assume branch is more often taken than not (loops use backward branches)
+  Label not_taken;
+  locals_index(rbx);
+  __ movl(rdx, iaddress(rbx));
+  locals_index(rbx, 3);
+  __ movl(rax, iaddress(rbx));
+  __ cmpl(rdx, rax);
+  __ jcc(j_not(cc), not_taken);
+  // branch() reads the offset at bcp + 1 and the MDP already refers to
+  // the if_icmp, so taking the branch only needs r13 moved to it
+  __ addptr(r13, if_icmp_offset);
+  branch(false, false);
+  __ bind(not_taken);
+  // not taken: the dispatch steps over the whole sequence
+  __ profile_not_taken_branch(rax);
+}
+
 void TemplateTable::fast_iload() {
   transition(vtos, itos);
   locals_index(rbx);
@@ -1609,7 +1654,7 @@ void TemplateTable::branch(bool is_jsr, bool is_wide) {
     __ addptr(r13, rdx);
     // jsr returns atos that is not an oop
     __ push_i(rax);
-    __ dispatch_only(vtos);
+    __ dispatch_only(vtos, true);
     return;
   }
 
@@ -1730,7 +1775,7 @@ void TemplateTable::branch(bool is_jsr, bool is_wide) {
   // eax: return bci for jsr's, unused otherwise
   // ebx: target bytecode
   // r13: target bcp
-  __ dispatch_only(vtos);
+  __ dispatch_only(vtos, true);
 
   if (UseLoopCounter) {
     if (ProfileInterpreter) {
@@ -2079,6 +2124,17 @@ void TemplateTable::_return(TosState state) {
     __ bind(skip_register_finalizer);
   }
 
+  if (ThreadLocalSafepointPolls && _desc->bytecode() != Bytecodes::_return_register_finalizer) {
+    Label no_safepoint;
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::poll_word_offset()));
+    __ testb(rscratch1, SafepointSynchronize::poll_bit());
+    __ jcc(Assembler::zero, no_safepoint);
+    __ push(state);
+    __ call_VM(noreg, CAST_FROM_FN_PTR(address, InterpreterRuntime::at_safepoint));
+    __ pop(state);
+    __ bind(no_safepoint);
+  }
+
   // Narrow result if state is itos but result type is smaller.
   // Need to narrow in the return bytecode rather than in generate_return_entry
   // since compiled code callers expect the result to already be narrowed.
@@ -3358,7 +3414,8 @@ void TemplateTable::_new() {
   // (creates a new TLAB, etc.)
 
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    ObjectProfilerSampleBytes == 0;
 
   if (UseTLAB) {
     __ movptr(rax, Address(r15_thread, in_bytes(JavaThread::tlab_top_offset())));
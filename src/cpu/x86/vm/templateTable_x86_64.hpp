@@ -35,6 +35,9 @@
                                    Register flags);
   static void volatile_barrier(Assembler::Membar_mask_bits order_constraint);
 
+  // Superinstructions
+  static void fast_iload2_if_icmp(Condition cc);
+
   // Helpers
   static void index_check(Register array, Register index);
   static void index_check_without_pop(Register array, Register index);
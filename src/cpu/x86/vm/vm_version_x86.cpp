@@ -741,6 +741,12 @@ void VM_Version::get_processor_features() {
   if (FLAG_IS_DEFAULT(UseMontgomerySquareIntrinsic)) {
     UseMontgomerySquareIntrinsic = true;
   }
+  if (UseArrayHashCodeIntrinsics && UseAVX < 2) {
+    if (!FLAG_IS_DEFAULT(UseArrayHashCodeIntrinsics)) {
+      warning("array hashCode intrinsics require AVX2 instructions (not available on this CPU)");
+    }
+    FLAG_SET_DEFAULT(UseArrayHashCodeIntrinsics, false);
+  }
 #else
   if (UseMultiplyToLenIntrinsic) {
     if (!FLAG_IS_DEFAULT(UseMultiplyToLenIntrinsic)) {
@@ -772,6 +778,18 @@ void VM_Version::get_processor_features() {
     }
     FLAG_SET_DEFAULT(UseMontgomerySquareIntrinsic, false);
   }
+  if (UseArrayHashCodeIntrinsics) {
+    if (!FLAG_IS_DEFAULT(UseArrayHashCodeIntrinsics)) {
+      warning("array hashCode intrinsics are not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseArrayHashCodeIntrinsics, false);
+  }
+  if (UseUnsafeMemoryIntrinsics) {
+    if (!FLAG_IS_DEFAULT(UseUnsafeMemoryIntrinsics)) {
+      warning("Unsafe memory intrinsics are not available in 32-bit VM");
+    }
+    FLAG_SET_DEFAULT(UseUnsafeMemoryIntrinsics, false);
+  }
 #endif
 #endif // COMPILER2
 
@@ -977,6 +995,14 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UsePopCountInstruction, false);
   }
 
+  // The secondary supers table lookup stubs index the table with POPCNT.
+  if (UseSecondarySupersTable && !UsePopCountInstruction) {
+    if (!FLAG_IS_DEFAULT(UseSecondarySupersTable)) {
+      warning("UseSecondarySupersTable requires POPCNT instruction support");
+    }
+    FLAG_SET_DEFAULT(UseSecondarySupersTable, false);
+  }
+
   // Use fast-string operations if available.
   if (supports_erms()) {
     if (FLAG_IS_DEFAULT(UseFastStosb)) {
@@ -128,6 +128,26 @@ VtableStub* VtableStubs::create_vtable_stub(int vtable_index) {
 }
 
 
+// Probe the hashed itable index at hash_area for intf_klass. Leaves the word
+// index of the matching slot in scan_temp, jumps to L_no_such_interface when
+// an empty slot is hit first. Must follow klassItable::hash_index().
+static void probe_itable_hash(MacroAssembler* masm, Register hash_area, Register intf_klass,
+                              Register scan_temp, Label& L_no_such_interface) {
+  Label L_probe, L_found;
+  const int slot_base = wordSize + itableOffsetEntry::interface_offset_in_bytes();
+  __ movl(scan_temp, intf_klass);
+  __ shrl(scan_temp, 2);
+  __ bind(L_probe);
+  __ andl(scan_temp, Address(hash_area, 0));
+  __ cmpptr(intf_klass, Address(hash_area, scan_temp, Address::times_8, slot_base));
+  __ jccb(Assembler::equal, L_found);
+  __ cmpptr(Address(hash_area, scan_temp, Address::times_8, slot_base), (int32_t)NULL_WORD);
+  __ jcc(Assembler::zero, L_no_such_interface);
+  __ addl(scan_temp, itableOffsetEntry::size());
+  __ jmpb(L_probe);
+  __ bind(L_found);
+}
+
 VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   // Note well: pd_code_size_limit is the absolute minimum we can get
   // away with.  If you add code here, bump the code stub size
@@ -171,6 +191,35 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
   address npe_addr = __ pc();
   __ load_klass(recv_klass_reg, j_rarg0);
 
+  const Register method = rbx;
+  Label L_linear_scan, L_method_loaded;
+  if (ItableHashMinInterfaces > 0) {
+    // Classes implementing many interfaces carry a hashed itable index,
+    // probe it instead of scanning the itable. Only instance klasses have
+    // the _itable_hash_offset field.
+    __ cmpl(Address(recv_klass_reg, Klass::layout_helper_offset()), Klass::_lh_neutral_value);
+    __ jcc(Assembler::lessEqual, L_linear_scan);
+    __ movl(temp_reg, Address(recv_klass_reg, InstanceKlass::itable_hash_offset_offset()));
+    __ testl(temp_reg, temp_reg);
+    __ jcc(Assembler::zero, L_linear_scan);
+    __ addptr(temp_reg, recv_klass_reg);    // temp_reg: hashed itable index
+
+    // Receiver subtype check against REFC.
+    // Destroys recv_klass_reg value.
+    probe_itable_hash(masm, temp_reg, resolved_klass_reg, recv_klass_reg, L_no_such_interface);
+
+    // Get selected method from declaring class and itable index
+    probe_itable_hash(masm, temp_reg, holder_klass_reg, method, L_no_such_interface);
+    __ movl(method, Address(temp_reg, method, Address::times_8,
+                            wordSize + itableOffsetEntry::offset_offset_in_bytes()));
+    __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
+    __ addptr(recv_klass_reg, method);
+    __ movptr(method, Address(recv_klass_reg, itable_index * itableMethodEntry::size() * wordSize +
+                                              itableMethodEntry::method_offset_in_bytes()));
+    __ jmp(L_method_loaded);
+    __ bind(L_linear_scan);
+  }
+
   // Receiver subtype check against REFC.
   // Destroys recv_klass_reg value.
   __ lookup_interface_method(// inputs: rec. class, interface
@@ -181,13 +230,13 @@ VtableStub* VtableStubs::create_itable_stub(int itable_index) {
                              /*return_method=*/false);
 
   // Get selected method from declaring class and itable index
-  const Register method = rbx;
   __ load_klass(recv_klass_reg, j_rarg0);   // restore recv_klass_reg
   __ lookup_interface_method(// inputs: rec. class, interface, itable index
                        recv_klass_reg, holder_klass_reg, itable_index,
                        // outputs: method, scan temp. reg
                        method, temp_reg,
                        L_no_such_interface);
+  __ bind(L_method_loaded);
 
   // If we take a trap while this arg is on the stack we will not
   // be able to walk the stack properly. This is not an issue except
@@ -242,7 +291,8 @@ int VtableStub::pd_code_size_limit(bool is_vtable_stub) {
   } else {
     // Itable stub size
     return (DebugVtables ? 512 : 140) + (CountCompiledCalls ? 13 : 0) +
-           (UseCompressedClassPointers ? 2 * MacroAssembler::instr_size_for_decode_klass_not_null() : 0);
+           (ItableHashMinInterfaces > 0 ? 144 : 0) +
+           (UseCompressedClassPointers ? 3 * MacroAssembler::instr_size_for_decode_klass_not_null() : 0);
   }
   // In order to tune these parameters, run the JVM with VM options
   // +PrintMiscellaneous and +WizardMode to see information about
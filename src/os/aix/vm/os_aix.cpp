@@ -2191,6 +2191,10 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
   os::Aix::commit_memory_impl(addr, size, alignment_hint, exec);
 }
 
+bool os::resident_memory_in_range(char* start, size_t bytes, size_t* resident) {
+  return false;
+}
+
 bool os::pd_uncommit_memory(char* addr, size_t size) {
 
   // Delegate to ShmBkBlock class which knows how to uncommit its memory.
@@ -2753,6 +2757,10 @@ size_t os::large_page_size() {
   return _large_page_size;
 }
 
+size_t os::transparent_huge_page_size() {
+  return 0;
+}
+
 bool os::can_commit_large_page_memory() {
   // Well, sadly we cannot commit anything at all (see comment in
   // os::commit_memory) but we claim to so we can make use of large pages
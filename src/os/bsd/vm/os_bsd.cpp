@@ -2299,6 +2299,10 @@ char *os::scan_pages(char *start, char* end, page_info* page_expected, page_info
 }
 
 
+bool os::resident_memory_in_range(char* start, size_t bytes, size_t* resident) {
+  return false;
+}
+
 bool os::pd_uncommit_memory(char* addr, size_t size) {
 #ifdef __OpenBSD__
   // XXX: Work-around mmap/MAP_FIXED bug temporarily on OpenBSD
@@ -2510,6 +2514,10 @@ size_t os::large_page_size() {
 // HugeTLBFS allows application to commit large page memory on demand;
 // with SysV SHM the entire memory region must be allocated as shared
 // memory.
+size_t os::transparent_huge_page_size() {
+  return 0;
+}
+
 bool os::can_commit_large_page_memory() {
   return UseHugeTLBFS;
 }
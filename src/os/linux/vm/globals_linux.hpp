@@ -55,7 +55,16 @@
   product(bool, PreferContainerQuotaForCPUCount, true,                  \
           "Calculate the container CPU availability based on the value" \
           " of quotas (if set), when true. Otherwise, use the CPU"      \
-          " shares value, provided it is less than quota.")
+          " shares value, provided it is less than quota.")             \
+                                                                        \
+  product(bool, UseFutexPark, false,                                    \
+          "Block parked threads (PlatformEvent, Parker) on a futex of"  \
+          " their state word instead of a mutex/condvar pair, so an"    \
+          " unpark without a waiter is a single atomic exchange")       \
+                                                                        \
+  product(intx, FutexParkSpinCount, 100,                                \
+          "Number of spins before a thread blocks on the futex with"    \
+          " UseFutexPark")
 
 //
 // Defines Linux-specific default values. The flags are available on all
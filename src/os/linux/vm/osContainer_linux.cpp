@@ -34,6 +34,7 @@
 
 bool  OSContainer::_is_initialized   = false;
 bool  OSContainer::_is_containerized = false;
+bool  OSContainer::_is_cgroup_v2     = false;
 int   OSContainer::_active_processor_count = 1;
 julong _unlimited_memory;
 
@@ -223,6 +224,34 @@ template <typename T> int subsystem_file_line_contents(CgroupSubsystem* c,
 }
 PRAGMA_DIAG_POP
 
+/* cgroup_v2_limit
+ *
+ * cgroup v2 limit files hold either a number or "max".
+ *
+ * return:
+ *    the limit,
+ *    -1 for "max" (unlimited)
+ *    OSCONTAINER_ERROR for not supported
+ */
+static jlong cgroup_v2_limit(CgroupSubsystem* c, const char* filename) {
+  char value[1024];
+  int err = subsystem_file_line_contents(c, filename, NULL, "%1023s", value);
+  if (err != 0) {
+    return OSCONTAINER_ERROR;
+  }
+  if (PrintContainerInfo) {
+    tty->print_cr("%s is: %s", filename + 1, value);
+  }
+  if (strcmp(value, "max") == 0) {
+    return -1;
+  }
+  julong limit;
+  if (sscanf(value, JULONG_FORMAT, &limit) != 1) {
+    return OSCONTAINER_ERROR;
+  }
+  return (jlong)limit;
+}
+
 #define GET_CONTAINER_INFO(return_type, subsystem, filename,              \
                            logstring, scan_fmt, variable)                 \
   return_type variable;                                                   \
@@ -315,7 +344,11 @@ void OSContainer::init() {
    *
    * Example for host:
    * 34 28 0:29 / /sys/fs/cgroup/memory rw,nosuid,nodev,noexec,relatime shared:16 - cgroup cgroup rw,memory
+   *
+   * Example for the cgroup v2 unified hierarchy:
+   * 30 23 0:26 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:4 - cgroup2 cgroup2 rw,nsdelegate
    */
+  CgroupSubsystem* unified = NULL;
   mntinfo = fopen("/proc/self/mountinfo", "r");
   if (mntinfo == NULL) {
       if (PrintContainerInfo) {
@@ -331,6 +364,13 @@ void OSContainer::init() {
     char *token;
 
     // mountinfo format is documented at https://www.kernel.org/doc/Documentation/filesystems/proc.txt
+    if (sscanf(p, "%*d %*d %*d:%*d %s %s %*[^-]- %s", tmproot, tmpmount, tmpcgroups) == 3 &&
+        strcmp(tmpcgroups, "cgroup2") == 0) {
+      if (unified == NULL) {
+        unified = new CgroupSubsystem(tmproot, tmpmount);
+      }
+      continue;
+    }
     if (sscanf(p, "%*d %*d %*d:%*d %s %s %*[^-]- cgroup %*s %s", tmproot, tmpmount, tmpcgroups) != 3) {
       continue;
     }
@@ -348,6 +388,18 @@ void OSContainer::init() {
   }
   fclose(mntinfo);
 
+  // Without a complete set of v1 controllers use the unified hierarchy,
+  // which holds all controllers in one directory.
+  if ((memory == NULL || cpuset == NULL || cpu == NULL || cpuacct == NULL) &&
+      unified != NULL) {
+    if (PrintContainerInfo) {
+      tty->print_cr("Using the cgroup v2 unified hierarchy");
+    }
+    _is_cgroup_v2 = true;
+    memory = new CgroupMemorySubsystem(unified->_root, unified->_mount_point);
+    cpuset = cpu = cpuacct = unified;
+  }
+
   if (memory == NULL) {
     if (PrintContainerInfo) {
       tty->print_cr("Required cgroup memory subsystem not found");
@@ -409,9 +461,10 @@ void OSContainer::init() {
     char *controllers;
     char *token;
     char *base;
+    char *hierarchy;
 
-    /* Skip cgroup number */
-    strsep(&p, ":");
+    /* Get cgroup number */
+    hierarchy = strsep(&p, ":");
     /* Get controllers and base */
     controllers = strsep(&p, ":");
     base = strsep(&p, "\n");
@@ -420,6 +473,15 @@ void OSContainer::init() {
       continue;
     }
 
+    /* cgroup v2: "0::/path" */
+    if (_is_cgroup_v2) {
+      if (strcmp(hierarchy, "0") == 0 && *controllers == '\0') {
+        memory->set_subsystem_path(base);
+        cpu->set_subsystem_path(base);
+      }
+      continue;
+    }
+
     while ((token = strsep(&controllers, ",")) != NULL) {
       if (strcmp(token, "memory") == 0) {
         memory->set_subsystem_path(base);
@@ -454,7 +516,7 @@ void OSContainer::init() {
 
 const char * OSContainer::container_type() {
   if (is_containerized()) {
-    return "cgroupv1";
+    return _is_cgroup_v2 ? "cgroupv2" : "cgroupv1";
   } else {
     return NULL;
   }
@@ -470,6 +532,10 @@ const char * OSContainer::container_type() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::uses_mem_hierarchy() {
+  if (_is_cgroup_v2) {
+    // cgroup v2 accounting is always hierarchical and has no such file
+    return OSCONTAINER_ERROR;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.use_hierarchy",
                     "Use Hierarchy is: " JLONG_FORMAT, JLONG_FORMAT, use_hierarchy);
   return use_hierarchy;
@@ -486,6 +552,9 @@ jlong OSContainer::uses_mem_hierarchy() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    return cgroup_v2_limit(memory, "/memory.max");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.limit_in_bytes",
                      "Memory Limit is: " JULONG_FORMAT, JULONG_FORMAT, memlimit);
 
@@ -514,6 +583,15 @@ jlong OSContainer::memory_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_and_swap_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    // memory.swap.max limits the swap alone
+    jlong swap_limit = cgroup_v2_limit(memory, "/memory.swap.max");
+    if (swap_limit < 0) {
+      return swap_limit;
+    }
+    jlong mem_limit = memory_limit_in_bytes();
+    return mem_limit < 0 ? mem_limit : mem_limit + swap_limit;
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.memsw.limit_in_bytes",
                      "Memory and Swap Limit is: " JULONG_FORMAT, JULONG_FORMAT, memswlimit);
   if (memswlimit >= _unlimited_memory) {
@@ -540,6 +618,9 @@ jlong OSContainer::memory_and_swap_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_soft_limit_in_bytes() {
+  if (_is_cgroup_v2) {
+    return cgroup_v2_limit(memory, "/memory.low");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.soft_limit_in_bytes",
                      "Memory Soft Limit is: " JULONG_FORMAT, JULONG_FORMAT, memsoftlimit);
   if (memsoftlimit >= _unlimited_memory) {
@@ -562,6 +643,11 @@ jlong OSContainer::memory_soft_limit_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(jlong, memory, "/memory.current",
+                       "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memusage);
+    return memusage;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.usage_in_bytes",
                      "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memusage);
   return memusage;
@@ -576,11 +662,35 @@ jlong OSContainer::memory_usage_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_max_usage_in_bytes() {
+  if (_is_cgroup_v2) {
+    // Not tracked by cgroup v2
+    return OSCONTAINER_ERROR;
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.max_usage_in_bytes",
                      "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memmaxusage);
   return memmaxusage;
 }
 
+/* memory_pressure
+ *
+ * Return the share of the last 10 seconds during which at least one
+ * task of this cgroup was stalled waiting for memory ("some avg10" of
+ * the pressure stall information).
+ *
+ * return:
+ *    stall percentage or
+ *    OSCONTAINER_ERROR for not supported
+ */
+double OSContainer::memory_pressure() {
+  if (!_is_cgroup_v2) {
+    // Pressure stall information is only exported by cgroup v2
+    return OSCONTAINER_ERROR;
+  }
+  GET_CONTAINER_INFO_LINE(double, memory, "/memory.pressure", "some",
+                          "Memory Pressure is: %2.2f", "%s avg10=%lf", pressure)
+  return pressure;
+}
+
 /* active_processor_count
  *
  * Calculate an appropriate number of active processors for the
@@ -702,12 +812,21 @@ char * OSContainer::cpu_cpuset_memory_nodes() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_quota() {
+  if (_is_cgroup_v2) {
+    // cpu.max holds "$MAX $PERIOD", where $MAX may be "max"
+    return (int)cgroup_v2_limit(cpu, "/cpu.max");
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_quota_us",
                      "CPU Quota is: %d", "%d", quota);
   return quota;
 }
 
 int OSContainer::cpu_period() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.max",
+                       "CPU Period is: %d", "%*s %d", period);
+    return period;
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_period_us",
                      "CPU Period is: %d", "%d", period);
   return period;
@@ -724,6 +843,17 @@ int OSContainer::cpu_period() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_shares() {
+  if (_is_cgroup_v2) {
+    GET_CONTAINER_INFO(int, cpu, "/cpu.weight",
+                       "CPU Weight is: %d", "%d", weight);
+    // Convert the default weight of 100 to no shares setup
+    if (weight == 100) return -1;
+
+    // Container runtimes map shares [2, 262144] linearly onto weights
+    // [1, 10000]; invert that and round to whole processors.
+    int shares = (int)((262142.0 * weight - 1) / 9999.0) + 2;
+    return MAX2((shares + PER_CPU_SHARES / 2) / PER_CPU_SHARES, 1) * PER_CPU_SHARES;
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.shares",
                      "CPU Shares is: %d", "%d", shares);
   // Convert 1024 to no shares setup
@@ -39,6 +39,7 @@ class OSContainer: AllStatic {
  private:
   static bool   _is_initialized;
   static bool   _is_containerized;
+  static bool   _is_cgroup_v2;
   static int    _active_processor_count;
 
  public:
@@ -52,6 +53,7 @@ class OSContainer: AllStatic {
   static jlong memory_soft_limit_in_bytes();
   static jlong memory_usage_in_bytes();
   static jlong memory_max_usage_in_bytes();
+  static double memory_pressure();
 
   static int active_processor_count();
 
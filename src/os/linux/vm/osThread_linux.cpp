@@ -38,6 +38,9 @@ void OSThread::pd_initialize() {
 
   sigemptyset(&_caller_sigmask);
 
+  _pool_stack_size = 0;
+  _pool_slot = NULL;
+
   _startThread_lock = new Monitor(Mutex::event, "startThread_lock", true);
   assert(_startThread_lock !=NULL, "check");
 }
@@ -45,12 +45,23 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  // JavaThreadPoolSize: stack size of a poolable java thread (0 if the
+  // pthread exits with its thread) and the pool slot of the pthread
+  // currently running this thread.
+  size_t _pool_stack_size;
+  void*  _pool_slot;
+
  public:
 
   // Methods to save/restore caller's signal mask
   sigset_t  caller_sigmask() const       { return _caller_sigmask; }
   void    set_caller_sigmask(sigset_t sigmask)  { _caller_sigmask = sigmask; }
 
+  size_t  pool_stack_size() const               { return _pool_stack_size; }
+  void    set_pool_stack_size(size_t size)      { _pool_stack_size = size; }
+  void*   pool_slot() const                     { return _pool_slot; }
+  void    set_pool_slot(void* slot)             { _pool_slot = slot; }
+
 #ifndef PRODUCT
   // Used for debugging, return a unique integer for each thread.
   int thread_identifier() const   { return _thread_id; }
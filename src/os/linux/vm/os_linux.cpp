@@ -102,6 +102,7 @@
 # include <stdint.h>
 # include <inttypes.h>
 # include <sys/ioctl.h>
+# include <linux/futex.h>
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -787,17 +788,160 @@ static bool _thread_safety_check(Thread* thread) {
   }
 }
 
-// Thread start routine for all newly created threads
-static void *java_start(Thread *thread) {
-  // Try to randomize the cache line index of hot stack frames.
-  // This helps when threads of the same stack traces evict each other's
-  // cache lines. The threads can be either from the same JVM instance, or
-  // from different JVM instances. The benefit is especially true for
-  // processors with hyperthreading technology.
-  static int counter = 0;
-  int pid = os::current_process_id();
-  alloca(((pid ^ counter++) & 7) * 128);
+// JavaThreadPoolSize: a pthread whose java thread has exited parks in
+// this pool for up to JavaThreadPoolKeepAlive ms, so that the next
+// os::create_thread() for a java thread of the same stack size can run
+// on it instead of paying for pthread_create(), the stack mapping and
+// the HotSpot stack guard pages again. A slot lives on the stack of its
+// pthread; no Thread exists while it is parked, so the pool uses raw
+// pthread primitives.
+class JavaThreadPoolSlot {
+ public:
+  pthread_t           _tid;
+  size_t              _stack_size;
+  Thread*             _thread;        // handed over by os::create_thread
+  char*               _guard_addr;    // HotSpot guard pages left in place
+  size_t              _guard_size;
+  JavaThreadPoolSlot* _next;
+  pthread_cond_t      _cond;
+
+  JavaThreadPoolSlot(size_t stack_size) :
+    _tid(pthread_self()), _stack_size(stack_size), _thread(NULL),
+    _guard_addr(NULL), _guard_size(0), _next(NULL) {
+    pthread_cond_init(&_cond, NULL);
+  }
+  ~JavaThreadPoolSlot() {
+    pthread_cond_destroy(&_cond);
+  }
+};
+
+class JavaThreadPool : AllStatic {
+  static pthread_mutex_t     _lock;
+  static JavaThreadPoolSlot* _parked;
+  static uintx               _count;
 
+  // Give the stack pages below the current frame back to the kernel;
+  // a reused thread faults them in again on demand.
+  static void release_stack_pages(JavaThreadPoolSlot* slot) {
+    address sp = os::current_stack_pointer();
+    address low = os::current_stack_base() - os::current_stack_size();
+    address start = (address)align_size_up((intptr_t)low + slot->_guard_size,
+                                           os::vm_page_size());
+    address end = (address)align_size_down((intptr_t)sp, os::vm_page_size()) -
+                  os::vm_page_size();
+    if (end > start) {
+      ::madvise((char*)start, end - start, MADV_DONTNEED);
+    }
+  }
+
+ public:
+  // Called by the pthread after its java thread has been deleted.
+  // Returns the next thread to run, or NULL if the pthread should exit.
+  static Thread* park(JavaThreadPoolSlot* slot) {
+    release_stack_pages(slot);
+
+    struct timespec abstime;
+    os::Linux::clock_gettime(CLOCK_REALTIME, &abstime);
+    jlong deadline = abstime.tv_nsec + (jlong)JavaThreadPoolKeepAlive * NANOSECS_PER_MILLISEC;
+    abstime.tv_sec += deadline / NANOSECS_PER_SEC;
+    abstime.tv_nsec = deadline % NANOSECS_PER_SEC;
+
+    pthread_mutex_lock(&_lock);
+    if (_count >= JavaThreadPoolSize) {
+      pthread_mutex_unlock(&_lock);
+      return NULL;
+    }
+    slot->_thread = NULL;
+    slot->_next = _parked;
+    _parked = slot;
+    _count++;
+    while (slot->_thread == NULL) {
+      int status = pthread_cond_timedwait(&slot->_cond, &_lock, &abstime);
+      if (status == ETIMEDOUT && slot->_thread == NULL) {
+        JavaThreadPoolSlot** p = &_parked;
+        while (*p != slot) {
+          p = &(*p)->_next;
+        }
+        *p = slot->_next;
+        _count--;
+        break;
+      }
+    }
+    Thread* thread = slot->_thread;
+    pthread_mutex_unlock(&_lock);
+    return thread;
+  }
+
+  // Hand 'thread' to a parked pthread with the given stack size.
+  static bool take(Thread* thread, size_t stack_size, pthread_t* tid) {
+    pthread_mutex_lock(&_lock);
+    JavaThreadPoolSlot** p = &_parked;
+    while (*p != NULL && (*p)->_stack_size != stack_size) {
+      p = &(*p)->_next;
+    }
+    JavaThreadPoolSlot* slot = *p;
+    if (slot != NULL) {
+      *p = slot->_next;
+      _count--;
+      *tid = slot->_tid;
+      slot->_thread = thread;
+      pthread_cond_signal(&slot->_cond);
+    }
+    pthread_mutex_unlock(&_lock);
+    return slot != NULL;
+  }
+
+  // The stack guard pages of the current thread may stay installed if
+  // its pthread can be pooled; the next thread re-protects the range.
+  static bool keep_guard_pages(char* addr, size_t size) {
+    Thread* thread = ThreadLocalStorage::get_thread_slow();
+    if (thread == NULL || thread->osthread() == NULL) {
+      return false;
+    }
+    JavaThreadPoolSlot* slot = (JavaThreadPoolSlot*)thread->osthread()->pool_slot();
+    if (slot == NULL) {
+      return false;
+    }
+    slot->_guard_addr = addr;
+    slot->_guard_size = size;
+    return true;
+  }
+
+  // True if the guard pages at [addr, addr + size) are still installed
+  // from the previous thread on this pthread.
+  static bool reuse_guard_pages(char* addr, size_t size) {
+    Thread* thread = ThreadLocalStorage::get_thread_slow();
+    if (thread == NULL || thread->osthread() == NULL) {
+      return false;
+    }
+    JavaThreadPoolSlot* slot = (JavaThreadPoolSlot*)thread->osthread()->pool_slot();
+    if (slot == NULL) {
+      return false;
+    }
+    if (slot->_guard_addr == addr && slot->_guard_size == size) {
+      return true;
+    }
+    release_guard_pages(slot);
+    return false;
+  }
+
+  // The pthread exits: glibc caches thread stacks, so the guard pages
+  // must not outlive it.
+  static void release_guard_pages(JavaThreadPoolSlot* slot) {
+    if (slot->_guard_addr != NULL) {
+      os::uncommit_memory(slot->_guard_addr, slot->_guard_size);
+      slot->_guard_addr = NULL;
+      slot->_guard_size = 0;
+    }
+  }
+};
+
+pthread_mutex_t     JavaThreadPool::_lock   = PTHREAD_MUTEX_INITIALIZER;
+JavaThreadPoolSlot* JavaThreadPool::_parked = NULL;
+uintx               JavaThreadPool::_count  = 0;
+
+// Runs 'thread' on the current pthread; false if it was aborted.
+static bool java_start_thread(Thread* thread) {
   ThreadLocalStorage::set_thread(thread);
 
   OSThread* osthread = thread->osthread();
@@ -809,7 +953,7 @@ static void *java_start(Thread *thread) {
     MutexLockerEx ml(sync, Mutex::_no_safepoint_check_flag);
     osthread->set_state(ZOMBIE);
     sync->notify_all();
-    return NULL;
+    return false;
   }
 
   // thread_id is kernel thread id (similar to Solaris LWP id)
@@ -844,6 +988,37 @@ static void *java_start(Thread *thread) {
   // call one more level start routine
   thread->run();
 
+  return true;
+}
+
+// Thread start routine for all newly created threads
+static void *java_start(Thread *thread) {
+  // Try to randomize the cache line index of hot stack frames.
+  // This helps when threads of the same stack traces evict each other's
+  // cache lines. The threads can be either from the same JVM instance, or
+  // from different JVM instances. The benefit is especially true for
+  // processors with hyperthreading technology.
+  static int counter = 0;
+  int pid = os::current_process_id();
+  alloca(((pid ^ counter++) & 7) * 128);
+
+  size_t pool_stack_size = thread->osthread()->pool_stack_size();
+  if (pool_stack_size == 0) {
+    java_start_thread(thread);
+    return 0;
+  }
+
+  JavaThreadPoolSlot slot(pool_stack_size);
+  do {
+    // the thread is deleted when run() returns
+    thread->osthread()->set_pool_slot(&slot);
+    if (!java_start_thread(thread)) {
+      break;
+    }
+    thread = JavaThreadPool::park(&slot);
+  } while (thread != NULL);
+
+  JavaThreadPool::release_guard_pages(&slot);
   return 0;
 }
 
@@ -906,6 +1081,12 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
   // glibc guard page
   pthread_attr_setguardsize(&attr, os::Linux::default_guard_size(thr_type));
 
+  bool poolable = JavaThreadPoolSize > 0 && thr_type == os::java_thread &&
+                  os::Linux::supports_variable_stack_size();
+  if (poolable) {
+    osthread->set_pool_stack_size(stack_size);
+  }
+
   ThreadState state;
 
   {
@@ -916,7 +1097,10 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
     }
 
     pthread_t tid;
-    int ret = pthread_create(&tid, &attr, (void* (*)(void*)) java_start, thread);
+    int ret = 0;
+    if (!poolable || !JavaThreadPool::take(thread, stack_size, &tid)) {
+      ret = pthread_create(&tid, &attr, (void* (*)(void*)) java_start, thread);
+    }
 
     pthread_attr_destroy(&attr);
 
@@ -2351,9 +2535,35 @@ void os::print_memory_info(outputStream* st) {
             ((jlong)si.totalswap * si.mem_unit) >> 10);
   st->print("(" UINT64_FORMAT "k free)",
             ((jlong)si.freeswap * si.mem_unit) >> 10);
+  if (G1TransparentHugePageCommit) {
+    st->print(", THP madvised " SIZE_FORMAT "k", Linux::thp_madvised_bytes() >> 10);
+    jlong anon_huge = Linux::anon_huge_pages_bytes();
+    if (anon_huge >= 0) {
+      st->print("(" JLONG_FORMAT "k backed)", anon_huge >> 10);
+    }
+  }
   st->cr();
 }
 
+jlong os::Linux::anon_huge_pages_bytes() {
+  // smaps_rollup sums the per-mapping AnonHugePages lines of smaps.
+  FILE* fp = fopen("/proc/self/smaps_rollup", "r");
+  if (fp == NULL) {
+    return -1;
+  }
+  jlong result = -1;
+  char line[256];
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    julong kb = 0;
+    if (sscanf(line, "AnonHugePages: " JULONG_FORMAT " kB", &kb) == 1) {
+      result = (jlong)(kb * K);
+      break;
+    }
+  }
+  fclose(fp);
+  return result;
+}
+
 void os::pd_print_cpu_info(outputStream* st) {
   st->print("\n/proc/cpuinfo:\n");
   if (!_print_ascii_file("/proc/cpuinfo", st)) {
@@ -2850,10 +3060,13 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
 }
 
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
-  if (UseTransparentHugePages && alignment_hint > (size_t)vm_page_size()) {
+  if ((UseTransparentHugePages || UseLargeCodePages || G1TransparentHugePageCommit) &&
+      alignment_hint > (size_t)vm_page_size()) {
     // We don't check the return value: madvise(MADV_HUGEPAGE) may not
     // be supported or the memory may already be backed by huge pages.
-    ::madvise(addr, bytes, MADV_HUGEPAGE);
+    if (::madvise(addr, bytes, MADV_HUGEPAGE) == 0 && G1TransparentHugePageCommit) {
+      Atomic::add_ptr((intptr_t)bytes, (volatile intptr_t*)&Linux::_thp_madvised_bytes);
+    }
   }
 }
 
@@ -2945,6 +3158,47 @@ char *os::scan_pages(char *start, char* end, page_info* page_expected, page_info
 }
 
 
+#ifndef SYS_membarrier
+  #if defined(__amd64__)
+    #define SYS_membarrier 324
+  #elif defined(__i386__)
+    #define SYS_membarrier 375
+  #elif defined(__aarch64__)
+    #define SYS_membarrier 283
+  #endif
+#endif
+
+// From linux/membarrier.h, which older build systems do not have.
+#define JVM_MEMBARRIER_CMD_QUERY                        0
+#define JVM_MEMBARRIER_CMD_PRIVATE_EXPEDITED            (1 << 3)
+#define JVM_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED   (1 << 4)
+
+void os::Linux::init_membarrier_serialization() {
+#ifdef SYS_membarrier
+  int cmds = syscall(SYS_membarrier, JVM_MEMBARRIER_CMD_QUERY, 0);
+  if (cmds != -1 && (cmds & JVM_MEMBARRIER_CMD_PRIVATE_EXPEDITED) != 0 &&
+      syscall(SYS_membarrier, JVM_MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0) == 0) {
+    _membarrier_serialization = true;
+    return;
+  }
+#endif
+  warning("UseMembarrierSerialization is disabled: membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED) "
+          "is not supported by the operating system");
+  FLAG_SET_DEFAULT(UseMembarrierSerialization, false);
+}
+
+bool os::Linux::membarrier_serialize() {
+#ifdef SYS_membarrier
+  // Every CPU running a thread of this process executes a full memory
+  // barrier before the call returns, which is what the page protection
+  // round trip of serialize_thread_states() achieves with TLB shootdowns.
+  return _membarrier_serialization &&
+         syscall(SYS_membarrier, JVM_MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0) == 0;
+#else
+  return false;
+#endif
+}
+
 int os::Linux::sched_getcpu_syscall(void) {
   unsigned int cpu = 0;
   int retval = -1;
@@ -3128,6 +3382,8 @@ int os::Linux::get_node_by_cpu(int cpu_id) {
 
 GrowableArray<int>* os::Linux::_cpu_to_node;
 GrowableArray<int>* os::Linux::_nindex_to_node;
+volatile size_t os::Linux::_thp_madvised_bytes = 0;
+bool os::Linux::_membarrier_serialization = false;
 os::Linux::sched_getcpu_func_t os::Linux::_sched_getcpu;
 os::Linux::numa_node_to_cpus_func_t os::Linux::_numa_node_to_cpus;
 os::Linux::numa_max_node_func_t os::Linux::_numa_max_node;
@@ -3149,6 +3405,33 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
   return res  != (uintptr_t) MAP_FAILED;
 }
 
+bool os::resident_memory_in_range(char* start, size_t bytes, size_t* resident) {
+  const size_t page_sz = os::vm_page_size();
+  const size_t chunk_pages = 1024;
+  unsigned char vec[chunk_pages];
+
+  char* cur = (char*)align_size_down((intptr_t)start, page_sz);
+  char* end = (char*)align_size_up((intptr_t)(start + bytes), page_sz);
+  size_t pages_resident = 0;
+  while (cur < end) {
+    size_t len = MIN2(pointer_delta(end, cur, 1), chunk_pages * page_sz);
+    int res;
+    do {
+      res = ::mincore(cur, len, vec);
+    } while (res == -1 && errno == EAGAIN);
+    // ENOMEM: part of the range is not mapped (any more), so the chunk
+    // is simply not counted.
+    if (res == 0) {
+      for (size_t i = 0; i < len / page_sz; i++) {
+        pages_resident += (vec[i] & 1);
+      }
+    }
+    cur += len;
+  }
+  *resident = pages_resident * page_sz;
+  return true;
+}
+
 static
 address get_stack_commited_bottom(address bottom, size_t size) {
   address nbot = bottom;
@@ -3245,6 +3528,11 @@ bool os::pd_create_stack_guard_pages(char* addr, size_t size) {
     }
   }
 
+  if (JavaThreadPool::reuse_guard_pages(addr, size)) {
+    // still committed from the previous thread on this pthread
+    return true;
+  }
+
   return os::commit_memory(addr, size, !ExecMem);
 }
 
@@ -3261,6 +3549,10 @@ bool os::remove_stack_guard_pages(char* addr, size_t size) {
     return ::munmap(addr, size) == 0;
   }
 
+  if (JavaThreadPool::keep_guard_pages(addr, size)) {
+    return true;
+  }
+
   return os::uncommit_memory(addr, size);
 }
 
@@ -3604,7 +3896,19 @@ void os::large_page_init() {
       !UseTransparentHugePages &&
       !UseHugeTLBFS &&
       !UseSHM) {
-    // Not using large pages.
+    // Not using large pages, except perhaps for the code cache, which
+    // asks for transparent huge pages by itself.
+    if (UseLargeCodePages) {
+      size_t code_page_size = Linux::find_large_page_size();
+      if (code_page_size > (size_t)Linux::page_size() &&
+          Linux::transparent_huge_pages_sanity_check(!FLAG_IS_DEFAULT(UseLargeCodePages), code_page_size)) {
+        if (FLAG_IS_DEFAULT(LargePageSizeInBytes)) {
+          FLAG_SET_ERGO(uintx, LargePageSizeInBytes, code_page_size);
+        }
+      } else {
+        FLAG_SET_DEFAULT(UseLargeCodePages, false);
+      }
+    }
     return;
   }
 
@@ -3965,6 +4269,41 @@ size_t os::large_page_size() {
   return _large_page_size;
 }
 
+// The size khugepaged and the page fault handler use for transparent huge
+// pages, or 0 if THP is disabled on this system.
+size_t os::transparent_huge_page_size() {
+  static size_t thp_size = (size_t)-1;
+  if (thp_size != (size_t)-1) {
+    return thp_size;
+  }
+
+  size_t result = 0;
+  char buf[64];
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp != NULL) {
+    if (fgets(buf, sizeof(buf), fp) != NULL && strstr(buf, "[never]") == NULL) {
+      result = Linux::find_large_page_size();
+    }
+    fclose(fp);
+  }
+  if (result != 0) {
+    fp = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+    if (fp != NULL) {
+      julong pmd_size = 0;
+      if (fscanf(fp, JULONG_FORMAT, &pmd_size) == 1 && pmd_size != 0 &&
+          is_power_of_2((intptr_t)pmd_size)) {
+        result = (size_t)pmd_size;
+      }
+      fclose(fp);
+    }
+  }
+  if (result != 0 && !Linux::transparent_huge_pages_sanity_check(false, result)) {
+    result = 0;
+  }
+  thp_size = result;
+  return thp_size;
+}
+
 // With SysV SHM the entire memory region must be allocated as shared
 // memory.
 // HugeTLBFS allows application to commit large page memory on demand.
@@ -3973,7 +4312,7 @@ size_t os::large_page_size() {
 // and allow other threads to steal that memory region. Because of this
 // behavior we can't commit HugeTLBFS memory.
 bool os::can_commit_large_page_memory() {
-  return UseTransparentHugePages;
+  return UseTransparentHugePages || G1TransparentHugePageCommit;
 }
 
 bool os::can_execute_large_page_memory() {
@@ -5121,11 +5460,18 @@ void os::pd_init_container_support() {
   OSContainer::init();
 }
 
+static bool futex_wait_bitset_supported();
+
 // this is called _after_ the global arguments have been parsed
 jint os::init_2(void)
 {
   Linux::fast_thread_clock_init();
 
+  if (UseFutexPark && !futex_wait_bitset_supported()) {
+    warning("UseFutexPark needs FUTEX_WAIT_BITSET and a monotonic clock; disabling it");
+    FLAG_SET_DEFAULT(UseFutexPark, false);
+  }
+
   // Allocate a single page and mark it as readable for safepoint polling
   address polling_page = (address) ::mmap(NULL, Linux::page_size(), PROT_READ, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
   guarantee( polling_page != MAP_FAILED, "os::init_2: failed to allocate polling page" );
@@ -5146,6 +5492,10 @@ jint os::init_2(void)
     if(Verbose && PrintMiscellaneous)
       tty->print("[Memory Serialize  Page address: " INTPTR_FORMAT "]\n", (intptr_t)mem_serialize_page);
 #endif
+
+    if (UseMembarrierSerialization) {
+      Linux::init_membarrier_serialization();
+    }
   }
 
   // initialize suspend/resume support - must do this before signal_sets_init()
@@ -5372,14 +5722,107 @@ void os::set_native_thread_name(const char *name) {
   }
 }
 
+// Reads an integer from /sys/devices/system/cpu/cpu<cpu>/topology/<name>,
+// -1 if not available.
+static int read_cpu_topology(int cpu, const char* name) {
+  char path[128];
+  jio_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/%s", cpu, name);
+  FILE* fp = fopen(path, "r");
+  int value = -1;
+  if (fp != NULL) {
+    if (fscanf(fp, "%d", &value) != 1) {
+      value = -1;
+    }
+    fclose(fp);
+  }
+  return value;
+}
+
+struct CpuPlacement {
+  int cpu;
+  int smt_rank;   // position among the hardware threads of its core
+  int node_rank;  // position among the cpus of its node with equal smt_rank
+  int node;
+};
+
+// A placement comes first if it is an earlier hardware thread of its core,
+// then if it is an earlier core of its node, so consecutive processes go
+// to different nodes and cores before two of them share a core.
+static bool cpu_placement_before(const CpuPlacement& a, const CpuPlacement& b) {
+  if (a.smt_rank != b.smt_rank) return a.smt_rank < b.smt_rank;
+  if (a.node_rank != b.node_rank) return a.node_rank < b.node_rank;
+  if (a.node != b.node) return a.node < b.node;
+  return a.cpu < b.cpu;
+}
+
 bool os::distribute_processes(uint length, uint* distribution) {
-  // Not yet implemented.
-  return false;
+  cpu_set_t cpus;
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) != 0) {
+    return false;
+  }
+  int count = os_cpu_count(&cpus);
+  if (count == 0) {
+    return false;
+  }
+
+  CpuPlacement* placements = NEW_C_HEAP_ARRAY(CpuPlacement, count, mtInternal);
+  int* packages = NEW_C_HEAP_ARRAY(int, count, mtInternal);
+  int* cores = NEW_C_HEAP_ARRAY(int, count, mtInternal);
+  int n = 0;
+  for (int cpu = 0; cpu < CPU_SETSIZE && n < count; cpu++) {
+    if (!CPU_ISSET(cpu, &cpus)) {
+      continue;
+    }
+    packages[n] = read_cpu_topology(cpu, "physical_package_id");
+    cores[n] = read_cpu_topology(cpu, "core_id");
+    CpuPlacement& p = placements[n];
+    p.cpu = cpu;
+    p.node = UseNUMA ? MAX2(Linux::get_node_by_cpu(cpu), 0) : 0;
+    p.smt_rank = 0;
+    for (int i = 0; i < n; i++) {
+      if (cores[n] != -1 && packages[i] == packages[n] && cores[i] == cores[n]) {
+        p.smt_rank++;
+      }
+    }
+    p.node_rank = 0;
+    for (int i = 0; i < n; i++) {
+      if (placements[i].node == p.node && placements[i].smt_rank == p.smt_rank) {
+        p.node_rank++;
+      }
+    }
+    n++;
+  }
+
+  // Insertion sort; there are at most CPU_SETSIZE entries.
+  for (int i = 1; i < n; i++) {
+    CpuPlacement p = placements[i];
+    int j = i - 1;
+    while (j >= 0 && cpu_placement_before(p, placements[j])) {
+      placements[j + 1] = placements[j];
+      j--;
+    }
+    placements[j + 1] = p;
+  }
+
+  for (uint i = 0; i < length; i++) {
+    distribution[i] = (uint)placements[i % n].cpu;
+  }
+
+  FREE_C_HEAP_ARRAY(int, cores, mtInternal);
+  FREE_C_HEAP_ARRAY(int, packages, mtInternal);
+  FREE_C_HEAP_ARRAY(CpuPlacement, placements, mtInternal);
+  return true;
 }
 
 bool os::bind_to_processor(uint processor_id) {
-  // Not yet implemented.
-  return false;
+  if (processor_id >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(processor_id, &cpus);
+  // A pid of 0 is the calling thread.
+  return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
 }
 
 ///
@@ -5994,6 +6437,43 @@ static struct timespec* compute_abstime(timespec* abstime, jlong millis) {
 }
 
 
+// UseFutexPark
+//
+// The futex variants block directly on the word that carries the state
+// (PlatformEvent::_Event, Parker::_counter), with -1 meaning "a thread is
+// or is about to be blocked". The waker only enters the kernel after it
+// swapped a -1 out of the word. A waiter that sees the word change before
+// it gets to sleep returns from futex_wait() with EAGAIN. Deadlines are
+// absolute: CLOCK_MONOTONIC for relative timeouts and CLOCK_REALTIME for
+// the absolute ones of Parker::park(), the same clocks unpackTime() and
+// compute_abstime() use for the condvars.
+
+static int futex_wait(volatile int* addr, int expected, const struct timespec* abstime, bool realtime) {
+  int op = FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG | (realtime ? FUTEX_CLOCK_REALTIME : 0);
+  return syscall(SYS_futex, (int*)addr, op, expected, abstime, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+static void futex_wake(volatile int* addr) {
+  syscall(SYS_futex, (int*)addr, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, 1, NULL, NULL, 0);
+}
+
+static bool futex_wait_bitset_supported() {
+  if (!os::Linux::supports_monotonic_clock()) {
+    return false;
+  }
+  // The word does not hold the expected value: a kernel that knows the
+  // operation fails with EAGAIN right away.
+  int word = 0;
+  struct timespec abstime = { 0, 0 };
+  return futex_wait(&word, 1, &abstime, false) == -1 && errno == EAGAIN;
+}
+
+static void futex_park_spin(volatile int* addr) {
+  for (int i = 0; i < FutexParkSpinCount && *addr < 0; i++) {
+    SpinPause();
+  }
+}
+
 // Test-and-clear _Event, always leaves _Event set to 0, returns immediately.
 // Conceptually TryPark() should be equivalent to park(0).
 
@@ -6015,7 +6495,15 @@ void os::PlatformEvent::park() {       // AKA "down()"
       if (Atomic::cmpxchg (v-1, &_Event, v) == v) break ;
   }
   guarantee (v >= 0, "invariant") ;
-  if (v == 0) {
+  if (v == 0 && UseFutexPark) {
+    futex_park_spin(&_Event);
+    while (_Event < 0) {
+      int status = futex_wait(&_Event, -1, NULL, false);
+      assert_status(status == 0 || errno == EAGAIN || errno == EINTR, errno, "futex_wait");
+    }
+    _Event = 0 ;
+    OrderAccess::fence();
+  } else if (v == 0) {
      // Do this the hard way by blocking ...
      int status = pthread_mutex_lock(_mutex);
      assert_status(status == 0, status, "mutex_lock");
@@ -6056,6 +6544,24 @@ int os::PlatformEvent::park(jlong millis) {
   struct timespec abst;
   compute_abstime(&abst, millis);
 
+  if (UseFutexPark) {
+    int ret = OS_TIMEOUT;
+    futex_park_spin(&_Event);
+    while (_Event < 0) {
+      int status = futex_wait(&_Event, -1, &abst, false);
+      assert_status(status == 0 || errno == EAGAIN || errno == EINTR ||
+                    errno == ETIMEDOUT, errno, "futex_wait");
+      if (!FilterSpuriousWakeups) break ;                 // previous semantics
+      if (status != 0 && errno == ETIMEDOUT) break ;
+    }
+    if (_Event >= 0) {
+      ret = OS_OK;
+    }
+    _Event = 0 ;
+    OrderAccess::fence();
+    return ret;
+  }
+
   int ret = OS_TIMEOUT;
   int status = pthread_mutex_lock(_mutex);
   assert_status(status == 0, status, "mutex_lock");
@@ -6122,6 +6628,11 @@ void os::PlatformEvent::unpark() {
 
   if (Atomic::xchg(1, &_Event) >= 0) return;
 
+  if (UseFutexPark) {
+    futex_wake(&_Event);
+    return;
+  }
+
   // Wait for the thread associated with the event to vacate
   int status = pthread_mutex_lock(_mutex);
   assert_status(status == 0, status, "mutex_lock");
@@ -6266,6 +6777,13 @@ void Parker::park(bool isAbsolute, jlong time) {
     unpackTime(&absTime, isAbsolute, time);
   }
 
+  if (UseFutexPark) {
+    // A permit that shows up soon saves both the state transitions and the futex
+    for (int i = 0; i < FutexParkSpinCount; i++) {
+      if (_counter > 0 && Atomic::xchg(0, &_counter) > 0) return;
+      SpinPause();
+    }
+  }
 
   // Enter safepoint region
   // Beware of deadlocks such as 6317397.
@@ -6275,6 +6793,36 @@ void Parker::park(bool isAbsolute, jlong time) {
   // the ThreadBlockInVM() CTOR and DTOR may grab Threads_lock.
   ThreadBlockInVM tbivm(jt);
 
+  if (UseFutexPark) {
+    if (Thread::is_interrupted(thread, false)) {
+      return;
+    }
+    // Announce the wait; an unpark that came first wins. Thread.interrupt
+    // sets the interrupt flag before it unparks, so it cannot be missed.
+    if (Atomic::cmpxchg(-1, &_counter, 0) != 0) {
+      Atomic::xchg(0, &_counter);
+      return;
+    }
+
+    OSThreadWaitState osts(thread->osthread(), false /* not Object.wait() */);
+    jt->set_suspend_equivalent();
+    // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+    // Spurious returns are allowed, no need to loop
+    int status = futex_wait(&_counter, -1, time == 0 ? NULL : &absTime, isAbsolute);
+    assert_status(status == 0 || errno == EAGAIN || errno == EINTR ||
+                  errno == ETIMEDOUT, errno, "futex_wait");
+
+    // Consume the permit or leave the waiting state; xchg is a full fence
+    Atomic::xchg(0, &_counter);
+
+    // If externally suspended while waiting, re-suspend
+    if (jt->handle_special_suspend_equivalent_condition()) {
+      jt->java_suspend_self();
+    }
+    return;
+  }
+
   // Don't wait if cannot get lock since interference arises from
   // unblocking.  Also. check interrupt before trying wait
   if (Thread::is_interrupted(thread, false) || pthread_mutex_trylock(_mutex) != 0) {
@@ -6339,6 +6887,14 @@ void Parker::park(bool isAbsolute, jlong time) {
 }
 
 void Parker::unpark() {
+  if (UseFutexPark) {
+    // Only a parked thread has put -1 there
+    if (Atomic::xchg(1, &_counter) < 0) {
+      futex_wake(&_counter);
+    }
+    return;
+  }
+
   int s, status ;
   status = pthread_mutex_lock(_mutex);
   assert (status == 0, "invariant") ;
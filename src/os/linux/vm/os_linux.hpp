@@ -71,6 +71,13 @@ class Linux {
   static GrowableArray<int>* _cpu_to_node;
   static GrowableArray<int>* _nindex_to_node;
 
+  // Bytes of heap successfully advised for transparent huge pages.
+  static volatile size_t _thp_madvised_bytes;
+
+  // Thread states are serialized with membarrier(2) instead of the
+  // memory serialize page.
+  static bool _membarrier_serialization;
+
  protected:
 
   static julong _physical_memory;
@@ -106,6 +113,13 @@ class Linux {
 
   static size_t find_large_page_size();
   static size_t setup_large_page_size();
+  static size_t thp_madvised_bytes()          { return _thp_madvised_bytes; }
+
+  // Make the thread state stores of all threads visible to the caller
+  // with one membarrier(2) call; false if not enabled or it failed.
+  static bool membarrier_serialize();
+  // AnonHugePages of this process in bytes, -1 if not available.
+  static jlong anon_huge_pages_bytes();
 
   static bool setup_large_page_type(size_t page_size);
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
@@ -295,6 +309,7 @@ private:
   static void set_numa_all_nodes_ptr(struct bitmask **ptr) { _numa_all_nodes_ptr = (ptr == NULL ? NULL : *ptr); }
   static void set_numa_nodes_ptr(struct bitmask **ptr) { _numa_nodes_ptr = (ptr == NULL ? NULL : *ptr); }
   static int sched_getcpu_syscall(void);
+  static void init_membarrier_serialization();
 public:
   static int sched_getcpu()  { return _sched_getcpu != NULL ? _sched_getcpu() : -1; }
   static int numa_node_to_cpus(int node, unsigned long *buffer, int bufferlen) {
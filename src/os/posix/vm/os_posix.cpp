@@ -30,6 +30,7 @@
 
 #include <signal.h>
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/utsname.h>
 #include <pthread.h>
@@ -176,6 +177,18 @@ int os::vsnprintf(char* buf, size_t len, const char* fmt, va_list args) {
   return result;
 }
 
+char* os::Posix::map_shared_memory(int fd, size_t bytes) {
+  if (::ftruncate(fd, (off_t)bytes) != 0) {
+    return NULL;
+  }
+  void* addr = ::mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  return addr == MAP_FAILED ? NULL : (char*)addr;
+}
+
+bool os::Posix::unmap_shared_memory(char* addr, size_t bytes) {
+  return ::munmap(addr, bytes) == 0;
+}
+
 void os::Posix::print_load_average(outputStream* st) {
   st->print("load average:");
   double loadavg[3];
@@ -59,6 +59,12 @@ public:
   // A POSIX conform, platform-independend siginfo print routine.
   static void print_siginfo_brief(outputStream* os, const siginfo_t* si);
 
+  // Maps 'bytes' of the file behind fd, growing the file if needed, such that
+  // stores are visible to other processes mapping the same file.
+  // Returns NULL on failure.
+  static char* map_shared_memory(int fd, size_t bytes);
+  static bool unmap_shared_memory(char* addr, size_t bytes);
+
 };
 
 /*
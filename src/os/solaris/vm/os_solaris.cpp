@@ -2877,6 +2877,10 @@ char *os::scan_pages(char *start, char* end, page_info* page_expected, page_info
   return end;
 }
 
+bool os::resident_memory_in_range(char* start, size_t bytes, size_t* resident) {
+  return false;
+}
+
 bool os::pd_uncommit_memory(char* addr, size_t bytes) {
   size_t size = bytes;
   // Map uncommitted pages PROT_NONE so we fail early if we touch an
@@ -3228,6 +3232,10 @@ size_t os::large_page_size() {
 
 // MPSS allows application to commit large page memory on demand; with ISM
 // the entire memory region must be allocated as shared memory.
+size_t os::transparent_huge_page_size() {
+  return 0;
+}
+
 bool os::can_commit_large_page_memory() {
   return true;
 }
@@ -3290,6 +3290,10 @@ size_t os::large_page_size() {
   return _large_page_size;
 }
 
+size_t os::transparent_huge_page_size() {
+  return 0;
+}
+
 bool os::can_commit_large_page_memory() {
   // Windows only uses large page memory when the entire region is reserved
   // and committed in a single VirtualAlloc() call. This may change in the
@@ -3449,6 +3453,10 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
   pd_commit_memory_or_exit(addr, size, exec, mesg);
 }
 
+bool os::resident_memory_in_range(char* start, size_t bytes, size_t* resident) {
+  return false;
+}
+
 bool os::pd_uncommit_memory(char* addr, size_t bytes) {
   if (bytes == 0) {
     // Don't bother the OS with noops.
@@ -4114,6 +4114,11 @@ bool MatchRule::is_vector() const {
     "MulVS","MulVI","MulVF","MulVD",
     "DivVF","DivVD",
     "AndV" ,"XorV" ,"OrV",
+    "VectorMaskCmp", "VectorBlend",
+    "AddReductionVI", "AddReductionVL", "AddReductionVF", "AddReductionVD",
+    "MulReductionVI", "MulReductionVF", "MulReductionVD",
+    "AndReductionVI", "AndReductionVL", "OrReductionVI", "OrReductionVL",
+    "XorReductionVI", "XorReductionVL",
     "LShiftCntV","RShiftCntV",
     "LShiftVB","LShiftVS","LShiftVI","LShiftVL",
     "RShiftVB","RShiftVS","RShiftVI","RShiftVL",
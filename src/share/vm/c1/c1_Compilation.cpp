@@ -163,7 +163,7 @@ void Compilation::build_hir() {
 
   _hir->verify();
 
-  if (UseC1Optimizations) {
+  if (UseC1Optimizations && !is_fast_mode()) {
     NEEDS_CLEANUP
     // optimization
     PhaseTraceTime timeit(_t_optimize_blocks);
@@ -186,7 +186,7 @@ void Compilation::build_hir() {
   // the control flow must not be changed from here on
   _hir->compute_code();
 
-  if (UseGlobalValueNumbering) {
+  if (UseGlobalValueNumbering && !is_fast_mode()) {
     // No resource mark here! LoopInvariantCodeMotion can allocate ValueStack objects.
     int instructions = Instruction::number_of_instructions();
     GlobalValueNumbering gvn(_hir);
@@ -202,7 +202,7 @@ void Compilation::build_hir() {
   }
 #endif
 
-  if (RangeCheckElimination) {
+  if (RangeCheckElimination && !is_fast_mode()) {
     if (_hir->osr_entry() == NULL) {
       PhaseTraceTime timeit(_t_rangeCheckElimination);
       RangeCheckElimination::eliminate(_hir);
@@ -215,7 +215,7 @@ void Compilation::build_hir() {
   }
 #endif
 
-  if (UseC1Optimizations) {
+  if (UseC1Optimizations && !is_fast_mode()) {
     // loop invariant code motion reorders instructions and range
     // check elimination adds new instructions so do null check
     // elimination after.
@@ -544,6 +544,7 @@ Compilation::Compilation(AbstractCompiler* compiler, ciEnv* env, ciMethod* metho
 , _next_block_id(0)
 , _code(buffer_blob)
 , _has_access_indexed(false)
+, _is_fast_mode(false)
 , _current_instruction(NULL)
 , _interpreter_frame_size(0)
 #ifndef PRODUCT
@@ -555,6 +556,12 @@ Compilation::Compilation(AbstractCompiler* compiler, ciEnv* env, ciMethod* metho
   _env->set_compiler_data(this);
   _exception_info_list = new ExceptionInfoList();
   _implicit_exception_table.set_size(0);
+  // Profiled code compiled in the startup phase is short-lived: the hot
+  // methods are recompiled at full optimization anyway.
+  if (C1FastCompileDuringStartup && is_profiling() && osr_bci == InvocationEntryBci &&
+      (intx)(os::elapsedTime() * 1000) < C1FastCompileStartupTime) {
+    _is_fast_mode = true;
+  }
   compile_method();
   if (bailed_out()) {
     _env->record_method_not_compilable(bailout_msg(), !TieredCompilation);
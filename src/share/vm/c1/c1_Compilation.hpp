@@ -88,6 +88,7 @@ class Compilation: public StackObj {
   CodeOffsets        _offsets;
   CodeBuffer         _code;
   bool               _has_access_indexed;
+  bool               _is_fast_mode;           // Cheap compilation of a cold method during startup
   int                _interpreter_frame_size; // Stack space needed in case of a deoptimization
 
   // compilation helpers
@@ -145,6 +146,7 @@ class Compilation: public StackObj {
   CodeOffsets* offsets()                         { return &_offsets; }
   Arena* arena()                                 { return _arena; }
   bool has_access_indexed()                      { return _has_access_indexed; }
+  bool is_fast_mode() const                      { return _is_fast_mode; }
 
   // Instruction ids
   int get_next_id()                              { return _next_id++; }
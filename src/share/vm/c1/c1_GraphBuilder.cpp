@@ -683,7 +683,7 @@ GraphBuilder::ScopeData::ScopeData(ScopeData* parent)
   } else {
     _max_inline_size = MaxInlineSize;
   }
-  if (_max_inline_size < MaxTrivialSize) {
+  if (_max_inline_size < MaxTrivialSize || Compilation::current()->is_fast_mode()) {
     _max_inline_size = MaxTrivialSize;
   }
 }
@@ -2201,6 +2201,55 @@ bool GraphBuilder::direct_compare(ciKlass* k) {
 }
 
 
+// Returns the receiver klass that dominates the type profile of the
+// checkcast/instanceof at the current bci, provided a hit on it can
+// only be established by scanning the secondary supers of the object's
+// klass. Such a klass is worth an inline compare ahead of the slow path.
+ciKlass* GraphBuilder::profiled_type_check_klass(TypeCheck* x) {
+  ciKlass* k = x->klass();
+  if (!C1ProfileGuidedTypeChecks || !k->is_loaded() || x->direct_compare()) {
+    return NULL;
+  }
+  if (k->super_check_offset() != in_bytes(Klass::secondary_super_cache_offset())) {
+    // the primary supers display answers the check without a scan
+    return NULL;
+  }
+  ciMethodData* md = method()->method_data_or_null();
+  if (md == NULL) {
+    return NULL;
+  }
+  ciProfileData* data = md->bci_to_data(bci());
+  if (data == NULL || !data->is_ReceiverTypeData()) {
+    return NULL;
+  }
+  ciReceiverTypeData* rtd = (ciReceiverTypeData*)data->as_ReceiverTypeData();
+  ciKlass* best = NULL;
+  uint best_count = 0;
+  uint total = rtd->count();
+  for (uint i = 0; i < rtd->row_limit(); i++) {
+    ciKlass* receiver = rtd->receiver(i);
+    if (receiver == NULL) {
+      continue;
+    }
+    uint count = rtd->receiver_count(i);
+    total += count;
+    if (count > best_count) {
+      best = receiver;
+      best_count = count;
+    }
+  }
+  if (best == NULL || best_count == 0 ||
+      best_count * 100 < total * (uint)C1ProfileGuidedTypeCheckRatio) {
+    return NULL;
+  }
+  if (!best->is_loaded() || !best->is_subtype_of(k)) {
+    // a dominant failing check is left to the regular path
+    return NULL;
+  }
+  return best;
+}
+
+
 void GraphBuilder::check_cast(int klass_index) {
   bool will_link;
   ciKlass* klass = stream()->get_klass(will_link);
@@ -2208,6 +2257,7 @@ void GraphBuilder::check_cast(int klass_index) {
   CheckCast* c = new CheckCast(klass, apop(), state_before);
   apush(append_split(c));
   c->set_direct_compare(direct_compare(klass));
+  c->set_profiled_klass(profiled_type_check_klass(c));
 
   if (is_profiling()) {
     // Note that we'd collect profile data in this method if we wanted it.
@@ -2229,6 +2279,7 @@ void GraphBuilder::instance_of(int klass_index) {
   InstanceOf* i = new InstanceOf(klass, apop(), state_before);
   ipush(append_split(i));
   i->set_direct_compare(direct_compare(klass));
+  i->set_profiled_klass(profiled_type_check_klass(i));
 
   if (is_profiling()) {
     // Note that we'd collect profile data in this method if we wanted it.
@@ -277,6 +277,7 @@ class GraphBuilder VALUE_OBJ_CLASS_SPEC {
   void iterate_all_blocks(bool start_in_current_block_for_inlining = false);
   Dependencies* dependency_recorder() const; // = compilation()->dependencies()
   bool direct_compare(ciKlass* k);
+  ciKlass* profiled_type_check_klass(TypeCheck* x);
 
   void kill_all();
 
@@ -1412,12 +1412,13 @@ BASE(TypeCheck, StateSplit)
 
   ciMethod* _profiled_method;
   int       _profiled_bci;
+  ciKlass*  _profiled_klass;
 
  public:
   // creation
   TypeCheck(ciKlass* klass, Value obj, ValueType* type, ValueStack* state_before)
   : StateSplit(type, state_before), _klass(klass), _obj(obj),
-    _profiled_method(NULL), _profiled_bci(0) {
+    _profiled_method(NULL), _profiled_bci(0), _profiled_klass(NULL) {
     ASSERT_VALUES
     set_direct_compare(false);
   }
@@ -1428,8 +1429,13 @@ BASE(TypeCheck, StateSplit)
   bool is_loaded() const                         { return klass() != NULL; }
   bool direct_compare() const                    { return check_flag(DirectCompareFlag); }
 
+  // dominant receiver klass from the profile, tested inline before the
+  // secondary supers scan (see C1ProfileGuidedTypeChecks)
+  ciKlass* profiled_klass() const                { return _profiled_klass; }
+
   // manipulation
   void set_direct_compare(bool flag)             { set_flag(DirectCompareFlag, flag); }
+  void set_profiled_klass(ciKlass* k)            { _profiled_klass = k; }
 
   // generic
   virtual bool can_trap() const                  { return true; }
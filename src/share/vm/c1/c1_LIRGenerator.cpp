@@ -945,7 +945,37 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// Sampled profiling: tier 3 code of a hot method run by many threads
+// contends on the cache lines of its MethodData.  With
+// C1ProfileSampleInterval = N a thread only records one in N of its
+// events, and adds N for it, which keeps the shape and scale of the
+// counts.  Returns the label to bind past the update, or NULL if every
+// event is recorded.
+LabelObj* LIRGenerator::profile_sample_begin() {
+  if (C1ProfileSampleInterval <= 1 || compilation()->env()->comp_level() != CompLevel_full_profile) {
+    return NULL;
+  }
+  LabelObj* skip = new LabelObj();
+  LIR_Address* counter = new LIR_Address(getThreadPointer(),
+                                         in_bytes(JavaThread::profile_sample_counter_offset()),
+                                         T_INT);
+  LIR_Opr left = new_register(T_INT);
+  __ load(counter, left);
+  __ sub(left, LIR_OprFact::intConst(1), left);
+  __ store(left, counter);
+  __ cmp(lir_cond_notEqual, left, LIR_OprFact::intConst(0));
+  __ branch(lir_cond_notEqual, T_INT, skip->label());
+  __ store(load_immediate(C1ProfileSampleInterval, T_INT), counter);
+  return skip;
+}
+
+void LIRGenerator::profile_sample_end(LabelObj* skip) {
+  if (skip != NULL) {
+    __ branch_destination(skip->label());
+  }
+}
+
+void LIRGenerator::profile_branch(If* if_instr, If::Condition cond, LIR_Opr left, LIR_Opr right) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != NULL, "method should be set if branch is profiled");
@@ -962,6 +992,17 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
       not_taken_count_offset = t;
     }
 
+    // The sampling test kills the condition codes, so it is only done when
+    // the caller passes the operands to compute them again.  Floating
+    // point compares may pop the FPU stack and are not repeated.
+    LabelObj* skip = NULL;
+    if (left->is_valid() && !if_instr->x()->type()->is_float_kind()) {
+      skip = profile_sample_begin();
+      if (skip != NULL) {
+        __ cmp(lir_cond(cond), left, right);
+      }
+    }
+
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
@@ -976,9 +1017,14 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment * profile_sample_scale(skip), T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (skip != NULL) {
+      profile_sample_end(skip);
+      __ cmp(lir_cond(cond), left, right);
+    }
   }
 }
 
@@ -2614,11 +2660,14 @@ void LIRGenerator::do_Goto(Goto* x) {
       assert(data->is_JumpData(), "need JumpData for branches");
       offset = md->byte_offset_of_slot(data, JumpData::taken_offset());
     }
+    LabelObj* skip = profile_sample_begin();
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
     increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)),
+                      DataLayout::counter_increment * profile_sample_scale(skip));
+    profile_sample_end(skip);
   }
 
   // emit phi-instruction move after safepoint since this simplifies
@@ -3465,22 +3514,31 @@ void LIRGenerator::increment_event_counter_impl(CodeEmitInfo* info,
   } else {
     ShouldNotReachHere();
   }
+  LabelObj* skip = profile_sample_begin();
+  int increment = InvocationCounter::count_increment * profile_sample_scale(skip);
   LIR_Address* counter = new LIR_Address(counter_holder, offset, T_INT);
   LIR_Opr result = new_register(T_INT);
   __ load(counter, result);
-  __ add(result, LIR_OprFact::intConst(InvocationCounter::count_increment), result);
+  __ add(result, LIR_OprFact::intConst(increment), result);
   __ store(result, counter);
   if (notify) {
     LIR_Opr mask = load_immediate(frequency << InvocationCounter::count_shift, T_INT);
     LIR_Opr meth = new_register(T_METADATA);
     __ metadata2reg(method->constant_encoding(), meth);
     __ logical_and(result, mask, result);
-    __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
     // The bci for info can point to cmp for if's we want the if bci
     CodeStub* overflow = new CounterOverflowStub(info, bci, meth);
-    __ branch(lir_cond_equal, T_INT, overflow);
+    if (skip == NULL) {
+      __ cmp(lir_cond_equal, result, LIR_OprFact::intConst(0));
+      __ branch(lir_cond_equal, T_INT, overflow);
+    } else {
+      // A scaled increment may step over the zero of the masked bits
+      __ cmp(lir_cond_belowEqual, result, LIR_OprFact::intConst(increment - 1));
+      __ branch(lir_cond_belowEqual, T_INT, overflow);
+    }
     __ branch_destination(overflow->continuation());
   }
+  profile_sample_end(skip);
 }
 
 void LIRGenerator::do_RuntimeCall(RuntimeCall* x) {
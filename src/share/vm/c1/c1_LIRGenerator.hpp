@@ -363,7 +363,11 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  void profile_branch(If* if_instr, If::Condition cond,
+                      LIR_Opr left = LIR_OprFact::illegalOpr, LIR_Opr right = LIR_OprFact::illegalOpr);
+  LabelObj* profile_sample_begin();
+  void profile_sample_end(LabelObj* skip);
+  int profile_sample_scale(LabelObj* skip) const { return skip != NULL ? (int)C1ProfileSampleInterval : 1; }
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, int frequency,
                                     int bci, bool backedge, bool notify);
@@ -3082,7 +3082,8 @@ void LinearScan::do_linear_scan() {
     }
   }
 
-  { TIME_LINEAR_SCAN(timer_optimize_lir);
+  if (!compilation()->is_fast_mode()) {
+    TIME_LINEAR_SCAN(timer_optimize_lir);
 
     EdgeMoveOptimizer::optimize(ir()->code());
     ControlFlowOptimizer::optimize(ir()->code());
@@ -5041,6 +5042,11 @@ int LinearScanWalker::find_optimal_split_pos(Interval* it, int min_split_pos, in
     TRACE_LINEAR_SCAN(4, tty->print_cr("      min-pos and max-pos are equal, no optimization possible"));
     optimal_split_pos = min_split_pos;
 
+  } else if (compilation()->is_fast_mode()) {
+    // no search for a block boundary, split as late as possible
+    TRACE_LINEAR_SCAN(4, tty->print_cr("      fast mode, splitting at max_split_pos"));
+    optimal_split_pos = max_split_pos;
+
   } else {
     assert(min_split_pos < max_split_pos, "must be true then");
     assert(min_split_pos > 0, "cannot access min_split_pos - 1 otherwise");
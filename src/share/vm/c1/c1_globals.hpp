@@ -134,6 +134,24 @@
   develop(bool, StressLoopInvariantCodeMotion, false,                       \
           "stress loop invariant code motion")                              \
                                                                             \
+  product(bool, C1FastCompileDuringStartup, false,                          \
+          "Compile profiled methods during startup without the C1 "         \
+          "optimization passes, with trivial inlining only and a "          \
+          "simpler register allocation")                                    \
+                                                                            \
+  product(intx, C1FastCompileStartupTime, 10000,                            \
+          "Length (in milliseconds) of the startup phase for "              \
+          "C1FastCompileDuringStartup")                                     \
+                                                                            \
+  product(bool, C1ProfileGuidedTypeChecks, false,                           \
+          "Test the dominant profiled receiver klass of a checkcast or "    \
+          "instanceof against a secondary super before the slow path"       \
+          " subtype check")                                                 \
+                                                                            \
+  product(intx, C1ProfileGuidedTypeCheckRatio, 90,                          \
+          "Percentage of profiled type checks a receiver klass must "       \
+          "account for to be used by C1ProfileGuidedTypeChecks")            \
+                                                                            \
   develop(bool, TraceRangeCheckElimination, false,                          \
           "Trace Range Check Elimination")                                  \
                                                                             \
@@ -335,6 +353,11 @@
   product(bool, C1UpdateMethodData, trueInTiered,                           \
           "Update MethodData*s in Tier1-generated code")                    \
                                                                             \
+  product(intx, C1ProfileSampleInterval, 1,                                 \
+          "Let tier 3 code update invocation and branch counts only for "   \
+          "one in this many events of a thread, scaled by the interval "    \
+          "(a power of 2 up to 1024)")                                      \
+                                                                            \
   develop(bool, PrintCFGToFile, false,                                      \
           "print control flow graph to a separate file during compilation") \
                                                                             \
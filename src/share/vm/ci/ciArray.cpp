@@ -90,6 +90,7 @@ ciConstant ciArray::element_value_impl(BasicType elembt,
 // Returns T_ILLEGAL if there is no element at the given index.
 ciConstant ciArray::element_value(int index) {
   BasicType elembt = element_basic_type();
+  CURRENT_ENV->record_runtime_constant();
   GUARDED_VM_ENTRY(
     return element_value_impl(elembt, get_arrayOop(), index);
   )
@@ -33,6 +33,9 @@
 // This class is used to determine the frequently called method
 // at some call site
 class ciCallProfile : StackObj {
+public:
+  enum { PolymorphicLimit = 8 }; // Max morphism with a wider TypeProfileWidth
+
 private:
   // Fields are initialized directly by ciMethod::call_profile_at_bci.
   friend class ciMethod;
@@ -42,9 +45,9 @@ private:
   int  _limit;                // number of receivers have been determined
   int  _morphism;             // determined call site's morphism
   int  _count;                // # times has this call been executed
-  int  _receiver_count[MorphismLimit + 1]; // # times receivers have been seen
-  ciMethod* _method[MorphismLimit + 1];    // receivers methods
-  ciKlass*  _receiver[MorphismLimit + 1];  // receivers (exact)
+  int  _receiver_count[PolymorphicLimit + 1]; // # times receivers have been seen
+  ciMethod* _method[PolymorphicLimit + 1];    // receivers methods
+  ciKlass*  _receiver[PolymorphicLimit + 1];  // receivers (exact)
 
   ciCallProfile() {
     _limit = 0;
@@ -58,6 +61,11 @@ private:
   void add_receiver(ciKlass* receiver, int receiver_count);
 
 public:
+  // Number of receivers kept: the profile rows, at least MorphismLimit
+  static int morphism_limit() {
+    return MAX2((int)MorphismLimit, MIN2((int)TypeProfileWidth, (int)PolymorphicLimit));
+  }
+
   // Note:  The following predicates return false for invalid profiles:
   bool      has_receiver(int i) const { return _limit > i; }
   int       morphism() const          { return _morphism; }
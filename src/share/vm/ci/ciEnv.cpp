@@ -34,6 +34,7 @@
 #include "ci/ciUtilities.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "code/compiledCodeCache.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileLog.hpp"
@@ -101,6 +102,7 @@ ciEnv::ciEnv(CompileTask* task, int system_dictionary_modification_counter)
   _failure_reason = NULL;
   _compilable = MethodCompilable;
   _break_at_compile = false;
+  _has_runtime_constants = false;
   _compiler_data = NULL;
 #ifndef PRODUCT
   assert(!firstEnv, "not initialized properly");
@@ -161,6 +163,7 @@ ciEnv::ciEnv(Arena* arena) : _ciEnv_arena(mtCompiler) {
   _failure_reason = NULL;
   _compilable = MethodCompilable_never;
   _break_at_compile = false;
+  _has_runtime_constants = false;
   _compiler_data = NULL;
 #ifndef PRODUCT
   assert(firstEnv, "must be first");
@@ -1049,6 +1052,13 @@ void ciEnv::register_method(ciMethod* target,
       record_failure("Jvmti state change invalidated dependencies");
     }
 
+    // Methods selected for JVMTI method tracing must stay interpreted
+    // while their events are enabled.
+    if (!failing() && target->get_Method()->is_jvmti_traced() &&
+        JvmtiExport::should_post_traced_method_events()) {
+      record_failure("Method is traced by JVMTI");
+    }
+
     // Change in DTrace flags may invalidate compilation.
     if (!failing() &&
         ( (!dtrace_extended_probes() && ExtendedDTraceProbes) ||
@@ -1113,10 +1123,18 @@ void ciEnv::register_method(ciMethod* target,
     if (nm != NULL) {
       nm->set_has_unsafe_access(has_unsafe_access);
       nm->set_has_wide_vectors(has_wide_vectors);
+      if (task() != NULL && task()->is_jwarmup_speculation()) {
+        nm->set_jwarmup_speculation(true);
+      }
 #if INCLUDE_RTM_OPT
       nm->set_rtm_state(rtm_state);
 #endif
 
+      if (CompiledCodeCache::is_enabled()) {
+        // Record the code before it is reachable and gets patched.
+        CompiledCodeCache::record(this, nm);
+      }
+
       // Record successful registration.
       // (Put nm into the task handle *before* publishing to the Java heap.)
       if (task() != NULL) {
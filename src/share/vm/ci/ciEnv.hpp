@@ -45,6 +45,7 @@ class ciEnv : StackObj {
 
   friend class CompileBroker;
   friend class Dependencies;  // for get_object, during logging
+  friend class CompiledCodeCache;  // for the metadata of a compilation
 
 private:
   Arena*           _arena;       // Alias for _ciEnv_arena except in init_shared_objects()
@@ -57,6 +58,7 @@ private:
   const char*      _failure_reason;
   int              _compilable;
   bool             _break_at_compile;
+  bool             _has_runtime_constants;
   int              _num_inlined_bytecodes;
   CompileTask*     _task;           // faster access to CompilerThread::task
   CompileLog*      _log;            // faster access to CompilerThread::log
@@ -336,6 +338,12 @@ public:
   bool break_at_compile() { return _break_at_compile; }
   void set_break_at_compile(bool z) { _break_at_compile = z; }
 
+  // The compilation folded in a value that is specific to this VM
+  // instance, an unrelocated address or a value computed at run time.
+  // Such code is kept out of the compiled code cache.
+  bool has_runtime_constants() { return _has_runtime_constants; }
+  void record_runtime_constant() { _has_runtime_constants = true; }
+
   // Cache Jvmti state
   void  cache_jvmti_state();
   bool  jvmti_state_changed() const;
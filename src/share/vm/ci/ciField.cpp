@@ -69,6 +69,7 @@
 // ciField::ciField
 ciField::ciField(ciInstanceKlass* klass, int index): _known_to_link_with_put(NULL), _known_to_link_with_get(NULL) {
   ASSERT_IN_VM;
+  _has_initial_value = false;
   CompilerThread *thread = CompilerThread::current();
 
   assert(ciObjectFactory::is_initialized(), "not a shared field");
@@ -204,6 +205,8 @@ void ciField::initialize_from(fieldDescriptor* fd) {
   _offset = fd->offset();
   _holder = CURRENT_ENV->get_instance_klass(fd->field_holder());
 
+  _has_initial_value = fd->has_initial_value();
+
   // Check to see if the field is constant.
   bool is_final = this->is_final();
   bool is_stable = FoldStableValues && this->is_stable();
@@ -301,6 +304,26 @@ void ciField::initialize_from(fieldDescriptor* fd) {
   }
 }
 
+// ------------------------------------------------------------------
+// ciField::constant_value
+ciConstant ciField::constant_value() {
+  assert(is_static() && is_constant(), "illegal call to constant_value()");
+  if (!_has_initial_value) {
+    // The value was computed by the static initializer in this VM.
+    CURRENT_ENV->record_runtime_constant();
+  }
+  return _constant_value;
+}
+
+// ------------------------------------------------------------------
+// ciField::constant_value_of
+ciConstant ciField::constant_value_of(ciObject* object) {
+  assert(!is_static() && is_constant(), "only if field is non-static constant");
+  assert(object->is_instance(), "must be instance");
+  CURRENT_ENV->record_runtime_constant();
+  return object->as_instance()->field_value(this);
+}
+
 // ------------------------------------------------------------------
 // ciField::compute_type
 //
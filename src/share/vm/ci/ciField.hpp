@@ -49,6 +49,7 @@ private:
   ciType*          _type;
   int              _offset;
   bool             _is_constant;
+  bool             _has_initial_value;  // static value from a ConstantValue attribute
   ciInstanceKlass* _known_to_link_with_put;
   ciInstanceKlass* _known_to_link_with_get;
   ciConstant       _constant_value;
@@ -129,18 +130,11 @@ public:
   bool is_constant() { return _is_constant; }
 
   // Get the constant value of this field.
-  ciConstant constant_value() {
-    assert(is_static() && is_constant(), "illegal call to constant_value()");
-    return _constant_value;
-  }
+  ciConstant constant_value();
 
   // Get the constant value of non-static final field in the given
   // object.
-  ciConstant constant_value_of(ciObject* object) {
-    assert(!is_static() && is_constant(), "only if field is non-static constant");
-    assert(object->is_instance(), "must be instance");
-    return object->as_instance()->field_value(this);
-  }
+  ciConstant constant_value_of(ciObject* object);
 
   // Check for link time errors.  Accessing a field from a
   // certain class via a certain bytecode may or may not be legal.
@@ -523,9 +523,10 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
         // or < 0 in the case of a type check failured for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
         if (morphism > 0 && morphism == result._limit) {
-           // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           // The morphism <= morphism_limit().
+           int limit = ciCallProfile::morphism_limit();
+           if ((morphism <  limit) ||
+               (morphism == limit && count == 0)) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
@@ -565,7 +566,7 @@ void ciCallProfile::add_receiver(ciKlass* receiver, int receiver_count) {
   }
   _receiver[i] = receiver;
   _receiver_count[i] = receiver_count;
-  if (_limit < MorphismLimit) _limit++;
+  if (_limit < morphism_limit()) _limit++;
 }
 
 
@@ -975,7 +976,8 @@ bool ciMethod::ensure_method_data(methodHandle h_m) {
   if (is_native() || is_abstract() || h_m()->is_accessor()) {
     return true;
   }
-  if (CompilationWarmUp && CURRENT_ENV->task()->is_jwarmup_compilation()) {
+  if (CompilationWarmUp && CURRENT_ENV->task()->is_jwarmup_compilation() &&
+      !CURRENT_ENV->task()->is_jwarmup_speculation()) {
     _method_data = CURRENT_ENV->get_empty_methodData();
     return false;
   }
@@ -1019,7 +1021,8 @@ ciMethodData* ciMethod::method_data() {
   Thread* my_thread = JavaThread::current();
   methodHandle h_m(my_thread, get_Method());
 
-  if (CompilationWarmUp && CURRENT_ENV->task()->is_jwarmup_compilation()) {
+  if (CompilationWarmUp && CURRENT_ENV->task()->is_jwarmup_compilation() &&
+      !CURRENT_ENV->task()->is_jwarmup_speculation()) {
     _method_data = CURRENT_ENV->get_empty_methodData();
   } else if (h_m()->method_data() != NULL) {
     _method_data = CURRENT_ENV->get_method_data(h_m()->method_data());
@@ -1051,6 +1054,10 @@ MethodCounters* ciMethod::ensure_method_counters() {
   VM_ENTRY_MARK;
   methodHandle mh(THREAD, get_Method());
   MethodCounters* method_counters = mh->get_method_counters(CHECK_NULL);
+  if (method_counters != NULL) {
+    // The compiled code embeds this address
+    method_counters->set_pinned();
+  }
   return method_counters;
 }
 
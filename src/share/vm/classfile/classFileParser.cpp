@@ -28,6 +28,7 @@
 #include "classfile/classLoaderData.hpp"
 #include "classfile/classLoaderData.inline.hpp"
 #include "classfile/defaultMethods.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -1073,6 +1074,19 @@ static FieldAllocationType basic_type_to_atype(bool is_static, BasicType type) {
   return result;
 }
 
+static int nonstatic_field_size(FieldAllocationType atype) {
+  switch (atype) {
+    case NONSTATIC_OOP:    return heapOopSize;
+    case NONSTATIC_BYTE:   return 1;
+    case NONSTATIC_SHORT:  return BytesPerShort;
+    case NONSTATIC_WORD:   return BytesPerInt;
+    case NONSTATIC_DOUBLE: return BytesPerLong;
+    default:
+      ShouldNotReachHere();
+      return 0;
+  }
+}
+
 class FieldAllocationCount: public ResourceObj {
  public:
   u2 count[MAX_FIELD_ALLOCATION_TYPE];
@@ -3400,7 +3414,7 @@ void ClassFileParser::layout_fields(Handle class_loader,
   // The next classes have predefined hard-coded fields offsets
   // (see in JavaClasses::compute_hard_coded_offsets()).
   // Use default fields allocation order for them.
-  if( (allocation_style != 0 || compact_fields ) && class_loader.is_null() &&
+  bool hard_coded_offsets = class_loader.is_null() &&
       (_class_name == vmSymbols::java_lang_AssertionStatusDirectives() ||
        _class_name == vmSymbols::java_lang_Class() ||
        _class_name == vmSymbols::java_lang_ClassLoader() ||
@@ -3416,11 +3430,89 @@ void ClassFileParser::layout_fields(Handle class_loader,
        _class_name == vmSymbols::java_lang_Byte() ||
        _class_name == vmSymbols::java_lang_Short() ||
        _class_name == vmSymbols::java_lang_Integer() ||
-       _class_name == vmSymbols::java_lang_Long())) {
+       _class_name == vmSymbols::java_lang_Long());
+  if( (allocation_style != 0 || compact_fields ) && hard_coded_offsets ) {
     allocation_style = 0;     // Allocate oops first
     compact_fields   = false; // Don't compact fields
   }
 
+  // Pack the fields a field layout profile found hottest into the first
+  // cache line worth of this class' fields, largest first. They are taken
+  // out of the counts the allocation styles below work with.
+  FieldLayoutProfileEntry* hot_profile = NULL;
+  if (FieldLayoutProfile::is_enabled() && !hard_coded_offsets && !is_contended_class) {
+    hot_profile = FieldLayoutProfile::lookup(_class_name);
+  }
+  if (hot_profile != NULL) {
+    int num_fields = 0;
+    for (AllFieldStream fs(_fields, _cp); !fs.done(); fs.next()) {
+      num_fields++;
+    }
+    bool* is_hot = NEW_RESOURCE_ARRAY_IN_THREAD(THREAD, bool, num_fields);
+    memset(is_hot, 0, num_fields * sizeof(bool));
+    int hot_size = 0;
+    for (int i = 0; i < hot_profile->_num_fields; i++) {
+      const char* name = hot_profile->_fields[i];
+      for (AllFieldStream fs(_fields, _cp); !fs.done(); fs.next()) {
+        if (fs.access_flags().is_static() || fs.is_contended() ||
+            !fs.name()->equals(name, (int)strlen(name))) {
+          continue;
+        }
+        int size = nonstatic_field_size((FieldAllocationType) fs.allocation_type());
+        if (hot_size + size <= DEFAULT_CACHE_LINE_SIZE) {
+          is_hot[fs.index()] = true;
+          hot_size += size;
+        }
+        break;
+      }
+    }
+
+    int offset = next_nonstatic_field_offset;
+    for (int size = BytesPerLong; size > 0; size /= 2) {
+      // oops first, so that the hot oops share one oop map
+      for (int pass = 0; pass < 2; pass++) {
+        for (AllFieldStream fs(_fields, _cp); !fs.done(); fs.next()) {
+          if (!is_hot[fs.index()]) continue;
+          FieldAllocationType atype = (FieldAllocationType) fs.allocation_type();
+          if ((atype == NONSTATIC_OOP) != (pass == 0) ||
+              nonstatic_field_size(atype) != size) continue;
+
+          offset = align_size_up(offset, size);
+          fs.set_offset(offset);
+          is_hot[fs.index()] = false;
+          switch (atype) {
+            case NONSTATIC_OOP:
+              nonstatic_oop_count -= 1;
+              if( nonstatic_oop_map_count > 0 &&
+                  nonstatic_oop_offsets[nonstatic_oop_map_count - 1] ==
+                  offset -
+                  int(nonstatic_oop_counts[nonstatic_oop_map_count - 1]) *
+                  heapOopSize ) {
+                nonstatic_oop_counts[nonstatic_oop_map_count - 1] += 1;
+              } else {
+                assert(nonstatic_oop_map_count < max_nonstatic_oop_maps, "range check");
+                nonstatic_oop_offsets[nonstatic_oop_map_count] = offset;
+                nonstatic_oop_counts [nonstatic_oop_map_count] = 1;
+                nonstatic_oop_map_count += 1;
+                if( first_nonstatic_oop_offset == 0 ) { // Undefined
+                  first_nonstatic_oop_offset = offset;
+                }
+              }
+              break;
+            case NONSTATIC_DOUBLE: nonstatic_double_count -= 1; break;
+            case NONSTATIC_WORD:   nonstatic_word_count   -= 1; break;
+            case NONSTATIC_SHORT:  nonstatic_short_count  -= 1; break;
+            case NONSTATIC_BYTE:   nonstatic_byte_count   -= 1; break;
+            default:
+              ShouldNotReachHere();
+          }
+          offset += size;
+        }
+      }
+    }
+    next_nonstatic_field_offset = offset;
+  }
+
   // Rearrange fields for a given allocation style
   if( allocation_style == 0 ) {
     // Fields order: oops, longs/doubles, ints, shorts/chars, bytes, padded fields
@@ -4372,7 +4464,8 @@ instanceKlassHandle ClassFileParser::parseClassFile(Symbol* name,
   instanceKlassHandle this_klass (THREAD, preserve_this_klass);
   debug_only(this_klass->verify();)
 
-  if (CompilationWarmUp || CompilationWarmUpRecording) {
+  if (CompilationWarmUp || CompilationWarmUpRecording || VerificationCacheFile != NULL ||
+      CompiledCodeCacheFile != NULL) {
     unsigned int crc32 = ClassLoader::crc32(0, (char*)(_stream->buffer()), _stream->length());
     unsigned int class_bytes_size = _stream->length();
     this_klass->set_crc32(crc32);
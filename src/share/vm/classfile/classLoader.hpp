@@ -158,6 +158,7 @@ class ClassLoader: AllStatic {
   };
  protected:
   friend class LazyClassPathEntry;
+  friend class SystemDictionaryShared;
 
   // Performance counters
   static PerfCounter* _perf_accumulated_time;
@@ -57,13 +57,18 @@
 #include "memory/metadataFactory.hpp"
 #include "memory/metaspaceShared.hpp"
 #include "memory/oopFactory.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/synchronizer.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/shared/classLoaderDataPurgeThread.hpp"
+#endif // INCLUDE_ALL_GCS
 
 ClassLoaderData * ClassLoaderData::_the_null_class_loader_data = NULL;
 
@@ -73,7 +78,8 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool is_anonymous, Depen
   // An anonymous class loader data doesn't have anything to keep
   // it from being unloaded during parsing of the anonymous class.
   // The null-class-loader should always be kept alive.
-  _keep_alive(is_anonymous || h_class_loader.is_null()),
+  _keep_alive((is_anonymous || h_class_loader.is_null()) ? 1 : 0),
+  _is_anonymous_chunk(false), _anonymous_count(0), _anonymous_chunk(NULL),
   _metaspace(NULL), _unloading(false), _klasses(NULL),
   _claimed(0), _jmethod_ids(NULL), _handles(), _deallocate_list(NULL),
   _next(NULL), _dependencies(dependencies),
@@ -363,10 +369,25 @@ oop ClassLoaderData::keep_alive_object() const {
 }
 
 bool ClassLoaderData::is_alive(BoolObjectClosure* is_alive_closure) const {
-  bool alive = keep_alive() // null class loader and incomplete anonymous klasses.
-      || is_alive_closure->do_object_b(keep_alive_object());
+  if (keep_alive()) {
+    return true;  // null class loader and incomplete anonymous klasses.
+  }
+  if (is_anonymous() && _klasses == NULL) {
+    return false; // every anonymous class definition into it failed.
+  }
+  // All classes of an anonymous chunk are traced together through their
+  // CLD, so the most recently added one stands for the whole chunk.
+  return is_alive_closure->do_object_b(keep_alive_object());
+}
 
-  return alive;
+void ClassLoaderData::inc_keep_alive() {
+  assert(is_anonymous() || is_the_null_class_loader_data(), "only anonymous CLDs are kept alive artificially");
+  Atomic::inc(&_keep_alive);
+}
+
+void ClassLoaderData::dec_keep_alive() {
+  assert(_keep_alive > 0, "unbalanced keep alive");
+  Atomic::dec(&_keep_alive);
 }
 
 
@@ -421,7 +442,7 @@ Metaspace* ClassLoaderData::metaspace_non_null() {
     if (this == the_null_class_loader_data()) {
       assert (class_loader() == NULL, "Must be");
       set_metaspace(new Metaspace(_metaspace_lock, Metaspace::BootMetaspaceType));
-    } else if (is_anonymous()) {
+    } else if (is_anonymous() && !is_anonymous_chunk()) {
       if (TraceClassLoaderData && Verbose && class_loader() != NULL) {
         tty->print_cr("is_anonymous: %s", class_loader()->klass()->internal_name());
       }
@@ -483,10 +504,42 @@ void ClassLoaderData::free_deallocate_list() {
   }
 }
 
-// These anonymous class loaders are to contain classes used for JSR292
+// Loaders that are never unloaded, so an open anonymous chunk cannot
+// keep one alive longer than it would live anyway.
+static bool shares_anonymous_classes(Handle loader) {
+  return loader.is_null() ||
+         loader() == SystemDictionary::java_system_loader() ||
+         SystemDictionary::is_ext_class_loader(loader);
+}
+
+// These anonymous class loaders are to contain classes used for JSR292.
+// The returned CLD is kept alive until the caller is done defining its
+// anonymous class and calls dec_keep_alive().
 ClassLoaderData* ClassLoaderData::anonymous_class_loader_data(oop loader, TRAPS) {
-  // Add a new class loader data to the graph.
-  return ClassLoaderDataGraph::add(loader, true, THREAD);
+  Handle h_loader(THREAD, loader);
+  if (AnonymousClassesPerCLD <= 1 || !shares_anonymous_classes(h_loader)) {
+    // Add a new class loader data to the graph.
+    return ClassLoaderDataGraph::add(h_loader, true, THREAD);
+  }
+
+  // Hand out the open chunk of the host loader, start a new one when it is
+  // full. An open chunk is kept alive, a full one lives as long as any of
+  // its classes does.
+  ClassLoaderData* loader_data = class_loader_data(h_loader());
+  MutexLocker ml(AnonymousCLD_lock, THREAD);
+  ClassLoaderData* chunk = loader_data->_anonymous_chunk;
+  if (chunk == NULL || chunk->_anonymous_count >= (int)AnonymousClassesPerCLD) {
+    ClassLoaderData* new_chunk = ClassLoaderDataGraph::add(h_loader, true, CHECK_NULL);
+    new_chunk->_is_anonymous_chunk = true;
+    loader_data->_anonymous_chunk = new_chunk;
+    if (chunk != NULL) {
+      chunk->dec_keep_alive();
+    }
+    chunk = new_chunk;
+  }
+  chunk->_anonymous_count++;
+  chunk->inc_keep_alive();
+  return chunk;
 }
 
 const char* ClassLoaderData::loader_name() {
@@ -822,6 +875,14 @@ void ClassLoaderDataGraph::purge() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
   ClassLoaderData* list = _unloading;
   _unloading = NULL;
+#if INCLUDE_ALL_GCS
+  if (ClassLoaderDataPurgeThread::is_active()) {
+    // Delete the dead class loader data on the purge thread instead
+    ClassLoaderDataPurgeThread::enqueue(list);
+    Metaspace::purge();
+    return;
+  }
+#endif // INCLUDE_ALL_GCS
   ClassLoaderData* next = list;
   while (next != NULL) {
     ClassLoaderData* purge_me = next;
@@ -831,6 +892,31 @@ void ClassLoaderDataGraph::purge() {
   Metaspace::purge();
 }
 
+ClassLoaderData* ClassLoaderDataGraph::detach_unloading() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint!");
+  ClassLoaderData* list = _unloading;
+  _unloading = NULL;
+  return list;
+}
+
+ClassLoaderData* ClassLoaderDataGraph::purge_first_detached(ClassLoaderData* list) {
+  assert(list != NULL, "sanity");
+  assert(list->is_unloading(), "only dead class loader data can be purged");
+  ClassLoaderData* next = list->next();
+  delete list;
+  return next;
+}
+
+ClassLoaderData* ClassLoaderDataGraph::append_detached(ClassLoaderData* list, ClassLoaderData* rest) {
+  assert(list != NULL, "sanity");
+  ClassLoaderData* last = list;
+  while (last->next() != NULL) {
+    last = last->next();
+  }
+  last->set_next(rest);
+  return list;
+}
+
 void ClassLoaderDataGraph::free_deallocate_lists() {
   for (ClassLoaderData* cld = _head; cld != NULL; cld = cld->next()) {
     // We need to keep this data until InstanceKlass::purge_previous_version has been
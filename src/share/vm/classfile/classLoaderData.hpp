@@ -75,6 +75,15 @@ class ClassLoaderDataGraph : public AllStatic {
  public:
   static ClassLoaderData* find_or_create(Handle class_loader, TRAPS);
   static void purge();
+  // G1 support for deleting dead class loader data outside of a safepoint.
+  // detach_unloading() removes the unloading list from the graph at a
+  // safepoint. purge_first_detached() then deletes the first class loader
+  // data of such a list, which nobody else can reach any more, and returns
+  // the rest of the list. Metaspace::purge() is left to the next purge().
+  static ClassLoaderData* detach_unloading();
+  static ClassLoaderData* purge_first_detached(ClassLoaderData* list);
+  // Links rest behind the last class loader data of a detached list.
+  static ClassLoaderData* append_detached(ClassLoaderData* list, ClassLoaderData* rest);
   static void clear_claimed_marks();
   // oops do
   static void oops_do(OopClosure* f, KlassClosure* klass_closure, bool must_claim);
@@ -182,8 +191,12 @@ class ClassLoaderData : public CHeapObj<mtClass> {
                            // classes in the class loader are allocated.
   Mutex* _metaspace_lock;  // Locks the metaspace for allocations and setup.
   bool _unloading;         // true if this class loader goes away
-  bool _keep_alive;        // if this CLD is kept alive without a keep_alive_object().
+  volatile jint _keep_alive; // if this CLD is kept alive without a keep_alive_object().
+                             // Counts the anonymous classes still being defined into it.
   bool _is_anonymous;      // if this CLD is for an anonymous class
+  bool _is_anonymous_chunk; // if this anonymous CLD is shared by a batch of anonymous classes
+  int _anonymous_count;    // number of anonymous classes handed this CLD as a chunk
+  ClassLoaderData* _anonymous_chunk; // open anonymous chunk for classes hosted by this loader
   volatile int _claimed;   // true if claimed, for example during GC traces.
                            // To avoid applying oop closure more than once.
                            // Has to be an int because we cas it.
@@ -222,7 +235,7 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   Mutex* metaspace_lock() const { return _metaspace_lock; }
 
   void unload();
-  bool keep_alive() const       { return _keep_alive; }
+  bool keep_alive() const       { return _keep_alive > 0; }
   void classes_do(void f(Klass*));
   void loaded_classes_do(KlassClosure* klass_closure);
   void classes_do(void f(InstanceKlass*));
@@ -285,7 +298,10 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   }
 
   // Used to make sure that this CLD is not unloaded.
-  void set_keep_alive(bool value) { _keep_alive = value; }
+  void inc_keep_alive();
+  void dec_keep_alive();
+
+  bool is_anonymous_chunk() const { return _is_anonymous_chunk; }
 
   unsigned int identity_hash() {
     return _class_loader == NULL ? 0 : _class_loader->identity_hash();
@@ -407,6 +407,15 @@ Klass* Dictionary::find_class(int index, unsigned int hash,
 // Variant of find_class for shared classes.  No locking required, as
 // that table is static.
 
+Klass* Dictionary::try_find_class(int index, unsigned int hash,
+                                  Symbol* name, ClassLoaderData* loader_data) {
+  assert (index == index_for(name, loader_data), "incorrect index?");
+
+  DictionaryEntry* entry = get_entry(index, hash, name, loader_data);
+  return (entry != NULL) ? entry->klass() : (Klass*)NULL;
+}
+
+
 Klass* Dictionary::find_shared_class(int index, unsigned int hash,
                                        Symbol* name) {
   assert (index == index_for(name, NULL), "incorrect index?");
@@ -84,7 +84,18 @@ public:
   Klass* find_class(int index, unsigned int hash,
                       Symbol* name, ClassLoaderData* loader_data);
 
+  // Like find_class, but without SystemDictionary_lock. Entries are
+  // published with a release store and only removed at a safepoint, so the
+  // result stays valid until the caller reaches a safepoint.
+  Klass* try_find_class(int index, unsigned int hash,
+                        Symbol* name, ClassLoaderData* loader_data);
+
   Klass* find_shared_class(int index, unsigned int hash, Symbol* name);
+  // Used by SystemDictionaryShared to reach the CDS data kept in the entry.
+  DictionaryEntry* find_entry(int index, unsigned int hash,
+                              Symbol* name, ClassLoaderData* loader_data) {
+    return get_entry(index, hash, name, loader_data);
+  }
 
   // Compiler support
   Klass* try_get_next_class();
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
+#include "interpreter/bytecodeStream.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/cpCache.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+
+FieldLayoutProfileEntry** FieldLayoutProfile::_table = NULL;
+
+static const char* profile_header = "# HotSpot field layout profile 1";
+
+FieldLayoutProfileEntry::FieldLayoutProfileEntry(const char* name, int num_fields) :
+  _num_fields(num_fields), _next(NULL) {
+  _name = os::strdup(name, mtClass);
+  _fields = NEW_C_HEAP_ARRAY(char*, MAX2(num_fields, 1), mtClass);
+}
+
+unsigned int FieldLayoutProfile::hash(const char* name, int len) {
+  unsigned int h = 0;
+  for (int i = 0; i < len; i++) {
+    h = 31 * h + (unsigned char)name[i];
+  }
+  return h;
+}
+
+void FieldLayoutProfile::add(FieldLayoutProfileEntry* entry) {
+  unsigned int h = hash(entry->_name, (int)strlen(entry->_name)) % table_size;
+  entry->_next = _table[h];
+  _table[h] = entry;
+}
+
+void FieldLayoutProfile::initialize() {
+  if (FieldLayoutProfileFile == NULL) {
+    return;
+  }
+  _table = NEW_C_HEAP_ARRAY(FieldLayoutProfileEntry*, table_size, mtClass);
+  for (int i = 0; i < table_size; i++) {
+    _table[i] = NULL;
+  }
+  load(FieldLayoutProfileFile);
+}
+
+void FieldLayoutProfile::load(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    warning("Cannot read field layout profile %s", path);
+    return;
+  }
+  char line[8192];
+  char a[4096];
+  FieldLayoutProfileEntry* entry = NULL;
+  int fields = 0;
+  bool ok = fgets(line, sizeof(line), file) != NULL &&
+            strncmp(line, profile_header, strlen(profile_header)) == 0;
+  while (ok && fgets(line, sizeof(line), file) != NULL) {
+    if (strchr(line, '\n') == NULL) {
+      ok = false;   // truncated or too long
+      break;
+    }
+    int n;
+    jlong count;
+    if (sscanf(line, "class %4095s %d", a, &n) == 2) {
+      if (entry != NULL || n <= 0) {
+        ok = false;
+        break;
+      }
+      entry = new FieldLayoutProfileEntry(a, n);
+      fields = 0;
+    } else if (entry != NULL &&
+               sscanf(line, "field %4095s " JLONG_FORMAT, a, &count) == 2) {
+      entry->_fields[fields++] = os::strdup(a, mtClass);
+    } else {
+      ok = false;
+      break;
+    }
+    if (entry != NULL && fields == entry->_num_fields) {
+      add(entry);
+      entry = NULL;
+    }
+  }
+  fclose(file);
+  if (!ok) {
+    warning("Field layout profile %s ignored from the first bad entry on", path);
+  }
+}
+
+FieldLayoutProfileEntry* FieldLayoutProfile::lookup(Symbol* class_name) {
+  assert(is_enabled(), "no profile");
+  int len = class_name->utf8_length();
+  unsigned int h = hash((const char*)class_name->bytes(), len) % table_size;
+  for (FieldLayoutProfileEntry* e = _table[h]; e != NULL; e = e->_next) {
+    if (class_name->equals(e->_name, (int)strlen(e->_name))) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+struct FieldAccessCount {
+  InstanceKlass* _holder;
+  int            _index;
+  jlong          _count;
+};
+
+static int compare_by_field(FieldAccessCount* a, FieldAccessCount* b) {
+  if (a->_holder != b->_holder) {
+    return (uintptr_t)a->_holder < (uintptr_t)b->_holder ? -1 : 1;
+  }
+  return a->_index - b->_index;
+}
+
+static int compare_by_count(FieldAccessCount* a, FieldAccessCount* b) {
+  if (a->_count != b->_count) {
+    return a->_count > b->_count ? -1 : 1;
+  }
+  return a->_index - b->_index;
+}
+
+// Counts every resolved getfield and putfield with the invocation and
+// backedge counters of its method.
+class FieldAccessCounter : public KlassClosure {
+  GrowableArray<FieldAccessCount>* _counts;
+ public:
+  FieldAccessCounter(GrowableArray<FieldAccessCount>* counts) : _counts(counts) { }
+
+  void do_klass(Klass* k) {
+    if (!k->oop_is_instance() || !InstanceKlass::cast(k)->is_linked()) {
+      return;   // bytecodes not rewritten, no resolved fields
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    ConstantPoolCache* cache = ik->constants()->cache();
+    if (cache == NULL) {
+      return;
+    }
+    Thread* thread = Thread::current();
+    HandleMark hm(thread);
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      Method* m = methods->at(i);
+      if (m->is_native() || m->is_abstract()) {
+        continue;
+      }
+      jlong weight = (jlong)m->invocation_count() + m->backedge_count();
+      if (weight <= 0) {
+        continue;
+      }
+      methodHandle mh(thread, m);
+      BytecodeStream bcs(mh);
+      Bytecodes::Code code;
+      while ((code = bcs.next()) >= 0) {
+        if (code != Bytecodes::_getfield && code != Bytecodes::_putfield) {
+          continue;
+        }
+        int index = ConstantPool::decode_cpcache_index(bcs.get_index_u2_cpcache(), true);
+        ConstantPoolCacheEntry* e = cache->entry_at(index);
+        if (!e->is_resolved(Bytecodes::_getfield) && !e->is_resolved(Bytecodes::_putfield)) {
+          continue;
+        }
+        FieldAccessCount c;
+        c._holder = InstanceKlass::cast(e->f1_as_klass());
+        c._index = e->field_index();
+        c._count = weight;
+        _counts->append(c);
+      }
+    }
+  }
+};
+
+static bool is_plain_name(const char* s) {
+  // The file format separates names with spaces.
+  return strchr(s, ' ') == NULL && strchr(s, '\n') == NULL && strlen(s) < 4096;
+}
+
+void FieldLayoutProfile::dump(const char* path) {
+  ResourceMark rm;
+  GrowableArray<FieldAccessCount> counts(1024);
+  FieldAccessCounter counter(&counts);
+  ClassLoaderDataGraph::loaded_classes_do(&counter);
+
+  // Sum up the access sites of each field.
+  counts.sort(compare_by_field);
+  GrowableArray<FieldAccessCount> fields(counts.length() + 1);
+  for (int i = 0; i < counts.length(); i++) {
+    FieldAccessCount* c = counts.adr_at(i);
+    if (fields.length() > 0 && compare_by_field(fields.adr_at(fields.length() - 1), c) == 0) {
+      fields.adr_at(fields.length() - 1)->_count += c->_count;
+    } else {
+      fields.append(*c);
+    }
+  }
+
+  fileStream out(path, "w");
+  if (!out.is_open()) {
+    warning("Cannot write field layout profile %s", path);
+    return;
+  }
+  out.print_cr("%s", profile_header);
+  int start = 0;
+  while (start < fields.length()) {
+    int end = start + 1;
+    while (end < fields.length() && fields.at(end)._holder == fields.at(start)._holder) {
+      end++;
+    }
+    GrowableArray<FieldAccessCount> holder_fields(end - start);
+    for (int i = start; i < end; i++) {
+      holder_fields.append(fields.at(i));
+    }
+    holder_fields.sort(compare_by_count);
+    InstanceKlass* holder = fields.at(start)._holder;
+    bool plain = is_plain_name(holder->name()->as_C_string());
+    for (int i = 0; i < holder_fields.length(); i++) {
+      plain = plain && is_plain_name(holder->field_name(holder_fields.at(i)._index)->as_C_string());
+    }
+    if (plain) {
+      out.print_cr("class %s %d", holder->name()->as_C_string(), holder_fields.length());
+      for (int i = 0; i < holder_fields.length(); i++) {
+        FieldAccessCount* c = holder_fields.adr_at(i);
+        out.print_cr("field %s " JLONG_FORMAT, holder->field_name(c->_index)->as_C_string(), c->_count);
+      }
+    }
+    start = end;
+  }
+}
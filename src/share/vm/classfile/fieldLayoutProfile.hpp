@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+#define SHARE_VM_CLASSFILE_FIELDLAYOUTPROFILE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+
+class Symbol;
+
+// The profiled instance fields of one class, hottest first.
+class FieldLayoutProfileEntry : public CHeapObj<mtClass> {
+ public:
+  char*                    _name;
+  int                      _num_fields;
+  char**                   _fields;
+  FieldLayoutProfileEntry* _next;
+
+  FieldLayoutProfileEntry(const char* name, int num_fields);
+};
+
+// Field access profile driving the instance field layout
+// (-XX:DumpFieldLayoutProfileAtExit, -XX:FieldLayoutProfileFile).
+//
+// At exit every resolved getfield and putfield is weighted with the
+// invocation and backedge counters of its method, and the accessed fields
+// of each class are written hottest first. A run reading the profile has
+// ClassFileParser::layout_fields pack a cache line worth of the hottest
+// fields right behind the header (or the super class fields), so the
+// fields the code touches together share a cache line. Classes are matched
+// by name; a stale profile only costs locality, never correctness.
+class FieldLayoutProfile : AllStatic {
+ private:
+  enum { table_size = 1031 };
+  static FieldLayoutProfileEntry** _table;
+
+  static unsigned int hash(const char* name, int len);
+  static void add(FieldLayoutProfileEntry* entry);
+  static void load(const char* path);
+
+ public:
+  static bool is_enabled() { return _table != NULL; }
+
+  // Reads -XX:FieldLayoutProfileFile before the first class is parsed.
+  // The table is not changed afterwards and needs no lock.
+  static void initialize();
+  static FieldLayoutProfileEntry* lookup(Symbol* class_name);
+
+  // Writes the profile of the classes loaded so far.
+  static void dump(const char* path);
+};
+
+#endif // SHARE_VM_CLASSFILE_FIELDLAYOUTPROFILE_HPP
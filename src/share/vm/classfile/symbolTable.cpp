@@ -51,6 +51,8 @@ SymbolTable* SymbolTable::_the_table = NULL;
 // Static arena for symbols that are not deallocated
 Arena* SymbolTable::_arena = NULL;
 bool SymbolTable::_needs_rehashing = false;
+bool SymbolTable::_needs_resizing = false;
+bool SymbolTable::_has_been_resized = false;
 
 Symbol* SymbolTable::allocate_symbol(const u1* name, int len, bool c_heap, TRAPS) {
   assert (len <= Symbol::max_length(), "should be checked by caller");
@@ -103,9 +105,9 @@ void SymbolTable::buckets_unlink(int start_idx, int end_idx, BucketUnlinkContext
     while (entry != NULL) {
       // Shared entries are normally at the end of the bucket and if we run into
       // a shared entry, then there is nothing more to remove. However, if we
-      // have rehashed the table, then the shared entries are no longer at the
-      // end of the bucket.
-      if (entry->is_shared() && !use_alternate_hashcode()) {
+      // have rehashed or resized the table, then the shared entries are no
+      // longer at the end of the bucket.
+      if (entry->is_shared() && !use_alternate_hashcode() && !_has_been_resized) {
         break;
       }
       Symbol* s = entry->literal();
@@ -185,8 +187,8 @@ void SymbolTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
-  // Create a new symbol table
-  SymbolTable* new_table = new SymbolTable();
+  // Create a new symbol table, keeping the size of a table that has grown
+  SymbolTable* new_table = new SymbolTable(the_table()->table_size());
 
   the_table()->move_to(new_table);
 
@@ -198,6 +200,42 @@ void SymbolTable::rehash_table() {
   _the_table = new_table;
 }
 
+// Create a larger table and move the existing entries into it. Lookups are
+// lock-free and inserts recompute their bucket index under SymbolTable_lock,
+// so the table can only be swapped while no thread is inside either, i.e.
+// at a safepoint.
+void SymbolTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  _needs_resizing = false;
+  // The archived table is written with the size it was created with.
+  if (DumpSharedSpaces) return;
+
+  int old_size = the_table()->table_size();
+  int new_size = MIN2(old_size * 2 + 1, (int)symbol_table_max_size);
+  if (new_size <= old_size) return;
+
+  SymbolTable* new_table = new SymbolTable(new_size);
+  the_table()->resize_to(new_table);
+
+  delete _the_table;
+  _has_been_resized = true;
+  _the_table = new_table;
+
+  if (PrintStringTableStatistics) {
+    tty->print_cr("[SymbolTable resized from %d to %d buckets, %d entries]",
+                  old_size, new_size, new_table->number_of_entries());
+  }
+}
+
+void SymbolTable::check_resize_table() {
+  assert_locked_or_safepoint(SymbolTable_lock);
+  if (SymbolTableMaxLoadFactor > 0 && !_needs_resizing && !DumpSharedSpaces &&
+      table_size() < (int)symbol_table_max_size &&
+      (uintx)number_of_entries() > (uintx)table_size() * SymbolTableMaxLoadFactor) {
+    _needs_resizing = true;
+  }
+}
+
 // Lookup a symbol in a bucket.
 
 Symbol* SymbolTable::lookup(int index, const char* name,
@@ -402,16 +440,16 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
   No_Safepoint_Verifier nsv;
 
   // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index.
+  // the hash value and index. The table may also have been resized since the
+  // caller computed the index.
   unsigned int hashValue;
   int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_symbol((const char*)name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  index = hash_to_index(hashValue);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
@@ -428,6 +466,7 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
 
   HashtableEntry<Symbol*, mtSymbol>* entry = new_entry(hashValue, sym);
   add_entry(index, entry);
+  check_resize_table();
   return sym;
 }
 
@@ -479,6 +518,7 @@ bool SymbolTable::basic_add(ClassLoaderData* loader_data, constantPoolHandle cp,
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
+  check_resize_table();
   return true;
 }
 
@@ -645,6 +685,7 @@ class StableMemoryChecker : public StackObj {
 StringTable* StringTable::_the_table = NULL;
 
 bool StringTable::_needs_rehashing = false;
+bool StringTable::_needs_resizing = false;
 
 volatile int StringTable::_parallel_claimed_idx = 0;
 
@@ -682,16 +723,16 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
   No_Safepoint_Verifier nsv;
 
   // Check if the symbol table has been rehashed, if so, need to recalculate
-  // the hash value and index before second lookup.
+  // the hash value and index before second lookup. The table may also have
+  // been resized since the caller computed the index.
   unsigned int hashValue;
   int index;
   if (use_alternate_hashcode()) {
     hashValue = hash_string(name, len);
-    index = hash_to_index(hashValue);
   } else {
     hashValue = hashValue_arg;
-    index = index_arg;
   }
+  index = hash_to_index(hashValue);
 
   // Since look-up was done lock-free, we need to check if another
   // thread beat us in the race to insert the symbol.
@@ -704,9 +745,19 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
 
   HashtableEntry<oop, mtSymbol>* entry = new_entry(hashValue, string());
   add_entry(index, entry);
+  check_resize_table();
   return string();
 }
 
+void StringTable::check_resize_table() {
+  assert_locked_or_safepoint(StringTable_lock);
+  if (StringTableMaxLoadFactor > 0 && !_needs_resizing && !DumpSharedSpaces &&
+      table_size() < (int)string_table_max_size &&
+      (uintx)number_of_entries() > (uintx)table_size() * StringTableMaxLoadFactor) {
+    _needs_resizing = true;
+  }
+}
+
 
 oop StringTable::lookup(Symbol* symbol) {
   ResourceMark rm;
@@ -1109,7 +1160,7 @@ void StringTable::rehash_table() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   // This should never happen with -Xshare:dump but it might in testing mode.
   if (DumpSharedSpaces) return;
-  StringTable* new_table = new StringTable();
+  StringTable* new_table = new StringTable(the_table()->table_size());
 
   // Rehash the table
   the_table()->move_to(new_table);
@@ -1121,3 +1172,26 @@ void StringTable::rehash_table() {
   _needs_rehashing = false;
   _the_table = new_table;
 }
+
+// Create a larger table and move the existing entries into it, see
+// SymbolTable::resize_table().
+void StringTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  _needs_resizing = false;
+  if (DumpSharedSpaces) return;
+
+  int old_size = the_table()->table_size();
+  int new_size = MIN2(old_size * 2 + 1, (int)string_table_max_size);
+  if (new_size <= old_size) return;
+
+  StringTable* new_table = new StringTable(new_size);
+  the_table()->resize_to(new_table);
+
+  delete _the_table;
+  _the_table = new_table;
+
+  if (PrintStringTableStatistics) {
+    tty->print_cr("[StringTable resized from %d to %d buckets, %d entries]",
+                  old_size, new_size, new_table->number_of_entries());
+  }
+}
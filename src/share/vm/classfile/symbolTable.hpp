@@ -85,6 +85,12 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the average bucket length exceeds SymbolTableMaxLoadFactor
+  static bool _needs_resizing;
+  // Set once entries have been moved to a table of a different size, after
+  // which shared entries are no longer at the end of their buckets
+  static bool _has_been_resized;
+
   // For statistics
   static int _symbols_removed;
   static int _symbols_counted;
@@ -109,8 +115,11 @@ private:
 
   Symbol* lookup(int index, const char* name, int len, unsigned int hash);
 
-  SymbolTable()
-    : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
+  // Called with SymbolTable_lock held after adding entries
+  void check_resize_table();
+
+  SymbolTable(int table_size = SymbolTableSize)
+    : RehashableHashtable<Symbol*, mtSymbol>(table_size, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
 
   SymbolTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
     : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>), t,
@@ -133,7 +142,9 @@ public:
   enum {
     symbol_alloc_batch_size = 8,
     // Pick initial size based on java -version size measurements
-    symbol_alloc_arena_size = 360*K
+    symbol_alloc_arena_size = 360*K,
+    // Upper bound for growing the table
+    symbol_table_max_size = 16*M
   };
 
   // The symbol table
@@ -250,6 +261,9 @@ public:
   // Rehash the symbol table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing()         { return _needs_rehashing; }
+  // Grow the symbol table if its average bucket gets too long
+  static void resize_table();
+  static bool needs_resizing()          { return _needs_resizing; }
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index()        { return _parallel_claimed_idx; }
@@ -265,6 +279,9 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the average bucket length exceeds StringTableMaxLoadFactor
+  static bool _needs_resizing;
+
   // Claimed high water mark for parallel chunked scanning
   static volatile int _parallel_claimed_idx;
 
@@ -274,6 +291,9 @@ private:
 
   oop lookup(int index, jchar* chars, int length, unsigned int hashValue);
 
+  // Called with StringTable_lock held after adding an entry
+  void check_resize_table();
+
   // Apply the give oop closure to the entries to the buckets
   // in the range [start_idx, end_idx).
   static void buckets_oops_do(OopClosure* f, int start_idx, int end_idx);
@@ -285,13 +305,18 @@ private:
   // This allows multiple threads to work on the table at once.
   static void buckets_unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* f, int start_idx, int end_idx, BucketUnlinkContext* context);
 
-  StringTable() : RehashableHashtable<oop, mtSymbol>((int)StringTableSize,
-                              sizeof (HashtableEntry<oop, mtSymbol>)) {}
+  StringTable(int table_size = (int)StringTableSize)
+    : RehashableHashtable<oop, mtSymbol>(table_size, sizeof (HashtableEntry<oop, mtSymbol>)) {}
 
   StringTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
     : RehashableHashtable<oop, mtSymbol>((int)StringTableSize, sizeof (HashtableEntry<oop, mtSymbol>), t,
                      number_of_entries) {}
 public:
+  enum {
+    // Upper bound for growing the table
+    string_table_max_size = 16*M
+  };
+
   // The string table
   static StringTable* the_table() { return _the_table; }
 
@@ -384,6 +409,9 @@ public:
   // Rehash the symbol table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
+  // Grow the string table if its average bucket gets too long
+  static void resize_table();
+  static bool needs_resizing()  { return _needs_resizing; }
 
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
@@ -714,6 +714,18 @@ Klass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
   Symbol* superclassname = NULL;
 
   {
+    // Most often another thread has loaded the class while we waited for
+    // the loader lock. Check for that without SystemDictionary_lock, which
+    // every thread loading a class goes through.
+    No_Safepoint_Verifier nosafepoint;
+    Klass* check = dictionary()->try_find_class(d_index, d_hash, name, loader_data);
+    if (check != NULL) {
+      class_has_been_loaded = true;
+      k = instanceKlassHandle(THREAD, check);
+    }
+  }
+
+  if (!class_has_been_loaded) {
     SystemDictLocker mu(SystemDictionary_lock, THREAD);
     Klass* check = find_class(d_index, d_hash, name, loader_data);
     if (check != NULL) {
@@ -1034,6 +1046,23 @@ Klass* SystemDictionary::find_instance_or_array_klass(Symbol* class_name,
   return k;
 }
 
+// Drops the reference that keeps an anonymous class loader data alive
+// while its class is being defined, unless the definition succeeded and
+// the caller takes the reference over.
+class AnonymousDefinitionMark : public StackObj {
+ private:
+  ClassLoaderData* _loader_data;
+ public:
+  AnonymousDefinitionMark() : _loader_data(NULL) {}
+  ~AnonymousDefinitionMark() {
+    if (_loader_data != NULL) {
+      _loader_data->dec_keep_alive();
+    }
+  }
+  void set_loader_data(ClassLoaderData* loader_data) { _loader_data = loader_data; }
+  void defined()                                      { _loader_data = NULL; }
+};
+
 // Note: this method is much like resolve_from_stream, but
 // updates no supplemental data structures.
 // TODO consolidate the two methods with a helper routine?
@@ -1049,13 +1078,16 @@ Klass* SystemDictionary::parse_stream(Symbol* class_name,
   EventClassLoad class_load_start_event;
 
   ClassLoaderData* loader_data;
+  AnonymousDefinitionMark anonymous_mark;
   if (host_klass.not_null()) {
     // Create a new CLD for anonymous class, that uses the same class loader
-    // as the host_klass
+    // as the host_klass. It may be shared with other anonymous classes,
+    // see AnonymousClassesPerCLD.
     assert(EnableInvokeDynamic, "");
     guarantee(host_klass->class_loader() == class_loader(), "should be the same");
     guarantee(!DumpSharedSpaces, "must not create anonymous classes when dumping");
     loader_data = ClassLoaderData::anonymous_class_loader_data(class_loader(), CHECK_NULL);
+    anonymous_mark.set_loader_data(loader_data);
     loader_data->record_dependency(host_klass(), CHECK_NULL);
   } else {
     loader_data = ClassLoaderData::class_loader_data(class_loader());
@@ -1119,6 +1151,10 @@ Klass* SystemDictionary::parse_stream(Symbol* class_name,
   assert(host_klass.not_null() || cp_patches == NULL,
          "cp_patches only found with host_klass");
 
+  if (k.not_null() && !HAS_PENDING_EXCEPTION) {
+    // The caller drops the keep alive once it holds the mirror.
+    anonymous_mark.defined();
+  }
   return k();
 }
 
@@ -1173,12 +1209,27 @@ Klass* SystemDictionary::resolve_from_stream(Symbol* class_name,
   // this call to parseClassFile
   ResourceMark rm(THREAD);
   ClassFileParser parser(st);
-  instanceKlassHandle k = parser.parseClassFile(class_name,
-                                                loader_data,
-                                                protection_domain,
-                                                parsed_name,
-                                                verify,
-                                                THREAD);
+  instanceKlassHandle k;
+  bool from_archive = false;
+#if INCLUDE_CDS
+  // A user-defined loader may be defining a class archived from the same
+  // bytes at dump time.
+  k = SystemDictionaryShared::lookup_from_stream(class_name, class_loader,
+                                                 protection_domain, st, CHECK_NULL);
+  if (k.not_null()) {
+    parsed_name = k->name();
+    parsed_name->increment_refcount();
+    from_archive = true;
+  }
+#endif
+  if (!from_archive) {
+    k = parser.parseClassFile(class_name,
+                              loader_data,
+                              protection_domain,
+                              parsed_name,
+                              verify,
+                              THREAD);
+  }
 
   const char* pkg = "java/";
   size_t pkglen = strlen(pkg);
@@ -1223,7 +1274,7 @@ Klass* SystemDictionary::resolve_from_stream(Symbol* class_name,
            "external class name format used internally");
 
 #if INCLUDE_JFR
-    {
+    if (!from_archive) {
       InstanceKlass* ik = k();
       ON_KLASS_CREATION(ik, parser, THREAD);
       k = instanceKlassHandle(ik);
@@ -1238,6 +1289,12 @@ Klass* SystemDictionary::resolve_from_stream(Symbol* class_name,
     } else {
       define_instance_class(k, THREAD);
     }
+
+#if INCLUDE_CDS
+    if (ArchiveClassesAtExit != NULL && !HAS_PENDING_EXCEPTION) {
+      SystemDictionaryShared::record_class_source(k(), st->source());
+    }
+#endif
   }
 
   // Make sure we have an entry in the SystemDictionary on success
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classFileStream.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/classLoaderData.inline.hpp"
+#include "classfile/sharedClassUtil.hpp"
+#include "classfile/systemDictionaryShared.hpp"
+#include "memory/metadataFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+GrowableArray<SystemDictionaryShared::UnregisteredClass*>*
+  SystemDictionaryShared::_unregistered_classes = NULL;
+SystemDictionaryShared::LoadedClassSource* volatile
+  SystemDictionaryShared::_loaded_class_sources = NULL;
+
+SharedDictionaryEntry* SystemDictionaryShared::find_entry(Dictionary* dict,
+                                                          Symbol* class_name,
+                                                          ClassLoaderData* loader_data) {
+  unsigned int d_hash = dict->compute_hash(class_name, loader_data);
+  int d_index = dict->hash_to_index(d_hash);
+  return (SharedDictionaryEntry*)dict->find_entry(d_index, d_hash, class_name, loader_data);
+}
+
+void SystemDictionaryShared::init_shared_dictionary_entry(Klass* k, DictionaryEntry* entry) {
+  SharedDictionaryEntry* e = (SharedDictionaryEntry*)entry;
+  e->_clsfile_size = 0;
+  e->_clsfile_crc32 = 0;
+  e->_verifier_constraints = NULL;
+  e->_claimed = 0;
+}
+
+SystemDictionaryShared::UnregisteredClass*
+SystemDictionaryShared::find_unregistered_class(Klass* k) {
+  if (_unregistered_classes == NULL) {
+    return NULL;
+  }
+  // Classes are linked right after they are loaded, so the class being
+  // verified is almost always the last one.
+  for (int i = _unregistered_classes->length() - 1; i >= 0; i--) {
+    UnregisteredClass* uc = _unregistered_classes->at(i);
+    if (uc->_klass == k) {
+      return uc;
+    }
+  }
+  return NULL;
+}
+
+Klass* SystemDictionaryShared::load_unregistered_class(Symbol* class_name,
+                                                       const char* source,
+                                                       TRAPS) {
+  assert(DumpSharedSpaces, "dump time only");
+  ResourceMark rm(THREAD);
+
+  if (!BytecodeVerificationRemote) {
+    // The archived class would skip verification when it is defined at
+    // runtime.
+    tty->print_cr("Preload Warning: Skipping %s: classes of user-defined loaders "
+                  "are only archived with -XX:+BytecodeVerificationRemote",
+                  class_name->as_C_string());
+    return NULL;
+  }
+  if (find_class(class_name, ClassLoaderData::the_null_class_loader_data()) != NULL) {
+    tty->print_cr("Preload Warning: Skipping %s from %s: a class with the same name "
+                  "is already archived", class_name->as_C_string(), source);
+    return NULL;
+  }
+
+  // Most classlists group the classes of one source together.
+  static char*           last_source = NULL;
+  static ClassPathEntry* last_entry  = NULL;
+  if (last_source == NULL || strcmp(last_source, source) != 0) {
+    struct stat st;
+    if (os::stat(source, &st) != 0) {
+      tty->print_cr("Preload Warning: Cannot find source %s", source);
+      return NULL;
+    }
+    ClassPathEntry* e = ClassLoader::create_class_path_entry(source, &st, false, false, CHECK_NULL);
+    if (e == NULL) {
+      tty->print_cr("Preload Warning: Cannot open source %s", source);
+      return NULL;
+    }
+    if (last_source != NULL) {
+      FREE_C_HEAP_ARRAY(char, last_source, mtClass);
+    }
+    last_source = NEW_C_HEAP_ARRAY(char, strlen(source) + 1, mtClass);
+    strcpy(last_source, source);
+    last_entry = e;
+  }
+
+  stringStream ss;
+  ss.print_raw(class_name->as_utf8());
+  ss.print_raw(".class");
+  const char* file_name = ss.as_string();
+  ClassFileStream* stream = last_entry->open_stream(file_name, CHECK_NULL);
+  if (stream == NULL) {
+    tty->print_cr("Preload Warning: Cannot find %s in %s", file_name, source);
+    return NULL;
+  }
+  int size = stream->length();
+  juint crc = (juint)ClassLoader::crc32(0, (const char*)stream->buffer(), size);
+
+  // Everything is loaded with the null class loader at dump time. The super
+  // class and interfaces must be boot classes or unregistered classes that
+  // appear earlier in the classlist.
+  Klass* k = SystemDictionary::resolve_from_stream(class_name, Handle(), Handle(),
+                                                   stream, true, CHECK_NULL);
+  assert(!SharedClassUtil::is_shared_boot_class(k), "must not be a boot class");
+
+  if (_unregistered_classes == NULL) {
+    _unregistered_classes = new (ResourceObj::C_HEAP, mtClass) GrowableArray<UnregisteredClass*>(100, true);
+  }
+  _unregistered_classes->append(new UnregisteredClass(InstanceKlass::cast(k), size, crc));
+  return k;
+}
+
+instanceKlassHandle SystemDictionaryShared::lookup_from_stream(Symbol* class_name,
+                                                               Handle class_loader,
+                                                               Handle protection_domain,
+                                                               ClassFileStream* st,
+                                                               TRAPS) {
+  instanceKlassHandle nh;
+#if INCLUDE_CDS
+  if (!UseSharedSpaces || shared_dictionary() == NULL ||
+      class_name == NULL || class_loader.is_null() ||
+      JvmtiExport::should_post_class_file_load_hook()) {
+    // A ClassFileLoadHook may replace the bytes we would match against.
+    return nh;
+  }
+
+  SharedDictionaryEntry* entry = find_entry(shared_dictionary(), class_name, NULL);
+  if (entry == NULL || !entry->is_unregistered() ||
+      entry->_clsfile_size != st->length() ||
+      entry->_claimed != 0) {
+    return nh;
+  }
+  juint crc = (juint)ClassLoader::crc32(0, (const char*)st->buffer(), st->length());
+  if (entry->_clsfile_crc32 != crc) {
+    return nh;
+  }
+  if (Atomic::cmpxchg(1, &entry->_claimed, 0) != 0) {
+    // Already defined by another loader.
+    return nh;
+  }
+
+  instanceKlassHandle ik(THREAD, entry->klass());
+  instanceKlassHandle k = load_shared_class(ik, class_loader, protection_domain, THREAD);
+  if (HAS_PENDING_EXCEPTION || k.is_null()) {
+    // The super class or an interface resolved to a different class through
+    // this loader. Leave the class to another loader, and parse the stream.
+    if (ik->class_loader_data() == NULL) {
+      entry->_claimed = 0;
+    }
+    return nh;
+  }
+  return k;
+#else
+  return nh;
+#endif // INCLUDE_CDS
+}
+
+void SystemDictionaryShared::record_class_source(InstanceKlass* k, const char* source) {
+  if (source == NULL || k->class_loader() == NULL || k->is_anonymous()) {
+    return;
+  }
+  // defineClass passes the code source location, e.g. file:/path/app.jar
+  const char* path = source;
+  if (strncmp(path, "file:", 5) == 0) {
+    path += 5;
+  }
+  if (*path != '/' || strchr(path, '%') != NULL) {
+    // Not a local file, or an escaped URL we would have to decode.
+    return;
+  }
+
+  LoadedClassSource* node = new LoadedClassSource();
+  node->_name = k->name();
+  node->_name->increment_refcount();
+  node->_source = os::strdup(path, mtClass);
+  LoadedClassSource* head;
+  do {
+    head = _loaded_class_sources;
+    node->_next = head;
+  } while (Atomic::cmpxchg_ptr(node, &_loaded_class_sources, head) != head);
+}
+
+class PrintBootClassesClosure : public KlassClosure {
+  outputStream* _st;
+ public:
+  PrintBootClassesClosure(outputStream* st) : _st(st) {}
+  void do_klass(Klass* k) {
+    if (k->oop_is_instance() && !InstanceKlass::cast(k)->is_anonymous()) {
+      _st->print_cr("%s", k->name()->as_C_string());
+    }
+  }
+};
+
+void SystemDictionaryShared::print_loaded_classlist(outputStream* st) {
+  ResourceMark rm;
+  // The boot classes are preloaded by name; their supers are resolved on
+  // the way, so the order does not matter.
+  PrintBootClassesClosure boot(st);
+  ClassLoaderData::the_null_class_loader_data()->classes_do(&boot);
+
+  // Classes of user-defined loaders are recorded when they are defined,
+  // which is after their super class and interfaces. Print the oldest first.
+  GrowableArray<LoadedClassSource*> sources;
+  for (LoadedClassSource* s = _loaded_class_sources; s != NULL; s = s->_next) {
+    sources.append(s);
+  }
+  for (int i = sources.length() - 1; i >= 0; i--) {
+    st->print_cr("%s source: %s", sources.at(i)->_name->as_C_string(),
+                 sources.at(i)->_source);
+  }
+}
+
+void SystemDictionaryShared::add_verification_dependency(Klass* k,
+                                                         Symbol* accessor_clsname,
+                                                         Symbol* target_clsname) {
+  assert(DumpSharedSpaces, "dump time only");
+  if (SharedClassUtil::is_shared_boot_class(k)) {
+    return;
+  }
+  UnregisteredClass* uc = find_unregistered_class(k);
+  if (uc == NULL) {
+    return;
+  }
+  if (uc->_constraints == NULL) {
+    uc->_constraints = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(8, true);
+  }
+  GrowableArray<Symbol*>* vc = uc->_constraints;
+  for (int i = 0; i < vc->length(); i += 2) {
+    if (vc->at(i) == accessor_clsname && vc->at(i + 1) == target_clsname) {
+      return;
+    }
+  }
+  accessor_clsname->increment_refcount();
+  target_clsname->increment_refcount();
+  vc->append(accessor_clsname);
+  vc->append(target_clsname);
+}
+
+void SystemDictionaryShared::finalize_verification_dependencies() {
+  if (_unregistered_classes == NULL) {
+    return;
+  }
+  Thread* THREAD = Thread::current();
+  ClassLoaderData* loader_data = ClassLoaderData::the_null_class_loader_data();
+  for (int i = 0; i < _unregistered_classes->length(); i++) {
+    UnregisteredClass* uc = _unregistered_classes->at(i);
+    SharedDictionaryEntry* entry = find_entry(dictionary(), uc->_klass->name(), loader_data);
+    if (entry == NULL || entry->klass() != uc->_klass) {
+      // Removed from the dictionary after failing verification.
+      continue;
+    }
+    entry->_clsfile_size = uc->_clsfile_size;
+    entry->_clsfile_crc32 = uc->_clsfile_crc32;
+    if (uc->_constraints != NULL) {
+      int length = uc->_constraints->length();
+      Array<Symbol*>* vc = MetadataFactory::new_array<Symbol*>(loader_data, length, THREAD);
+      guarantee(!HAS_PENDING_EXCEPTION, "cannot allocate verification constraints");
+      for (int j = 0; j < length; j++) {
+        vc->at_put(j, uc->_constraints->at(j));
+      }
+      entry->_verifier_constraints = vc;
+    }
+  }
+}
+
+bool SystemDictionaryShared::check_verification_dependencies(Klass* k,
+                                                             Handle class_loader,
+                                                             Handle protection_domain,
+                                                             char** message_buffer,
+                                                             TRAPS) {
+  if (class_loader.is_null() || shared_dictionary() == NULL) {
+    return true;
+  }
+  SharedDictionaryEntry* entry = find_entry(shared_dictionary(), k->name(), NULL);
+  if (entry == NULL || entry->klass() != k || entry->_verifier_constraints == NULL) {
+    return true;
+  }
+
+  Array<Symbol*>* vc = entry->_verifier_constraints;
+  for (int i = 0; i < vc->length(); i += 2) {
+    Symbol* accessor_clsname = vc->at(i);
+    Symbol* target_clsname = vc->at(i + 1);
+    Klass* accessor = SystemDictionary::resolve_or_fail(accessor_clsname, class_loader,
+                                                        protection_domain, true, CHECK_false);
+    Klass* target = SystemDictionary::resolve_or_fail(target_clsname, class_loader,
+                                                      protection_domain, true, CHECK_false);
+    if (!accessor->is_subclass_of(target)) {
+      const char* fmt = "Bad type on operand stack in %s: %s is not assignable to %s";
+      size_t len = strlen(fmt) + k->name()->utf8_length() +
+                   accessor_clsname->utf8_length() + target_clsname->utf8_length();
+      *message_buffer = NEW_RESOURCE_ARRAY(char, len);
+      jio_snprintf(*message_buffer, len, fmt, k->external_name(),
+                   accessor_clsname->as_klass_external_name(),
+                   target_clsname->as_klass_external_name());
+      return false;
+    }
+  }
+  return true;
+}
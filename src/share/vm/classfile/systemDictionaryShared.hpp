@@ -28,8 +28,60 @@
 
 #include "classfile/dictionary.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "utilities/growableArray.hpp"
+
+class ClassFileStream;
+
+// Classes defined by user-defined class loaders ("unregistered" classes) are
+// archived from classlist lines of the form
+//
+//    com/example/Foo source: /path/to/app.jar
+//
+// They cannot be found by name: at runtime such a class is only used when a
+// loader calls defineClass with exactly the bytes seen at dump time (same
+// size and CRC32), and when its super class and interfaces resolve to the
+// same archived classes through that loader.
+class SharedDictionaryEntry : public DictionaryEntry {
+public:
+  int             _clsfile_size;         // 0 for boot classes
+  juint           _clsfile_crc32;
+  // Pairs of <accessor, target> class names. The verifier relied on accessor
+  // being a subclass of target when the class was verified at dump time.
+  Array<Symbol*>* _verifier_constraints;
+  // An archived class can only be defined by one loader.
+  volatile jint   _claimed;
+
+  bool is_unregistered() const { return _clsfile_size > 0; }
+};
 
 class SystemDictionaryShared: public SystemDictionary {
+private:
+  class UnregisteredClass : public CHeapObj<mtClass> {
+  public:
+    InstanceKlass*        _klass;
+    int                   _clsfile_size;
+    juint                 _clsfile_crc32;
+    GrowableArray<Symbol*>* _constraints;
+    UnregisteredClass(InstanceKlass* k, int size, juint crc) :
+      _klass(k), _clsfile_size(size), _clsfile_crc32(crc), _constraints(NULL) {}
+  };
+  // Dump time only
+  static GrowableArray<UnregisteredClass*>* _unregistered_classes;
+  static UnregisteredClass* find_unregistered_class(Klass* k);
+
+  static SharedDictionaryEntry* find_entry(Dictionary* dict, Symbol* class_name,
+                                           ClassLoaderData* loader_data);
+
+  // Classes defined by user-defined loaders from a local jar file or
+  // directory, most recent first (-XX:ArchiveClassesAtExit).
+  class LoadedClassSource : public CHeapObj<mtClass> {
+  public:
+    Symbol*            _name;
+    char*              _source;
+    LoadedClassSource* _next;
+  };
+  static LoadedClassSource* volatile _loaded_class_sources;
+
 public:
   static void initialize(TRAPS) {}
   static instanceKlassHandle find_or_load_shared_class(Symbol* class_name,
@@ -45,20 +97,39 @@ public:
   }
 
   static size_t dictionary_entry_size() {
-    return sizeof(DictionaryEntry);
+    return sizeof(SharedDictionaryEntry);
   }
-  static void init_shared_dictionary_entry(Klass* k, DictionaryEntry* entry) {}
+  static void init_shared_dictionary_entry(Klass* k, DictionaryEntry* entry);
+
+  // Dump time: load class_name from the jar file or directory source on
+  // behalf of a user-defined class loader.
+  static Klass* load_unregistered_class(Symbol* class_name, const char* source, TRAPS);
+
+  // Runtime: return the archived class matching the bytes in st, already
+  // restored for class_loader, or a null handle.
+  static instanceKlassHandle lookup_from_stream(Symbol* class_name,
+                                                Handle class_loader,
+                                                Handle protection_domain,
+                                                ClassFileStream* st,
+                                                TRAPS);
+
+  // Remember where a class of a user-defined loader came from, so it can be
+  // written as a "source:" line of a classlist.
+  static void record_class_source(InstanceKlass* k, const char* source);
+  // Write the classes loaded so far in classlist format, super classes
+  // before their subclasses.
+  static void print_loaded_classlist(outputStream* st);
 
-  // The (non-application) CDS implementation supports only classes in the boot
-  // class loader, which ensures that the verification dependencies are the same
-  // during archive creation time and runtime. Thus we can do the dependency checks
-  // entirely during archive creation time.
+  // Boot classes are loaded by the same loader at archive creation time and
+  // at runtime, so their verification dependencies can be checked entirely
+  // at dump time. For unregistered classes the loader may resolve names
+  // differently, so the dependencies are recorded and checked at link time.
   static void add_verification_dependency(Klass* k, Symbol* accessor_clsname,
-                                          Symbol* target_clsname) {}
-  static void finalize_verification_dependencies() {}
+                                          Symbol* target_clsname);
+  static void finalize_verification_dependencies();
   static bool check_verification_dependencies(Klass* k, Handle class_loader,
                                               Handle protection_domain,
-                                              char** message_buffer, TRAPS) {return true;}
+                                              char** message_buffer, TRAPS);
 };
 
 #endif // SHARE_VM_CLASSFILE_SYSTEMDICTIONARYSHARED_HPP
@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/verificationCache.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/vm_version.hpp"
+#include "utilities/ostream.hpp"
+
+struct VerificationCacheSuper {
+  char*        _name;
+  unsigned int _size;
+  unsigned int _crc;
+  bool         _same_loader;
+};
+
+struct VerificationCacheAssumption {
+  char* _target;
+  char* _from;
+  bool  _from_field_is_protected;
+  bool  _result;
+};
+
+class VerificationCacheEntry : public CHeapObj<mtClass> {
+ public:
+  char*                        _name;
+  unsigned int                 _size;
+  unsigned int                 _crc;
+  int                          _num_supers;
+  VerificationCacheSuper*      _supers;
+  int                          _num_assumptions;
+  VerificationCacheAssumption* _assumptions;
+  // Cleared when the assumptions no longer hold. Entries are never freed,
+  // a lookup may still be using them.
+  volatile bool                _valid;
+  VerificationCacheEntry*      _next;
+
+  VerificationCacheEntry(const char* name, unsigned int size, unsigned int crc,
+                         int num_supers, int num_assumptions) :
+    _size(size), _crc(crc), _num_supers(num_supers), _num_assumptions(num_assumptions),
+    _valid(true), _next(NULL) {
+    _name = os::strdup(name, mtClass);
+    _supers = NEW_C_HEAP_ARRAY(VerificationCacheSuper, MAX2(num_supers, 1), mtClass);
+    _assumptions = NEW_C_HEAP_ARRAY(VerificationCacheAssumption, MAX2(num_assumptions, 1), mtClass);
+  }
+};
+
+VerificationCacheEntry** VerificationCache::_table = NULL;
+
+static const char* cache_header = "# HotSpot verification cache 1";
+
+unsigned int VerificationCache::hash(const char* name, int len) {
+  unsigned int h = 0;
+  for (int i = 0; i < len; i++) {
+    h = 31 * h + (unsigned char)name[i];
+  }
+  return h;
+}
+
+// Called with VerificationCache_lock held.
+void VerificationCache::initialize() {
+  assert_lock_strong(VerificationCache_lock);
+  if (_table != NULL) {
+    return;
+  }
+  _table = NEW_C_HEAP_ARRAY(VerificationCacheEntry*, table_size, mtClass);
+  for (int i = 0; i < table_size; i++) {
+    _table[i] = NULL;
+  }
+  load(VerificationCacheFile);
+}
+
+VerificationCacheEntry* VerificationCache::find(Symbol* name, unsigned int size, unsigned int crc) {
+  assert_lock_strong(VerificationCache_lock);
+  int len = name->utf8_length();
+  unsigned int h = hash((const char*)name->bytes(), len) % table_size;
+  for (VerificationCacheEntry* e = _table[h]; e != NULL; e = e->_next) {
+    if (e->_valid && e->_size == size && e->_crc == crc && name->equals(e->_name, (int)strlen(e->_name))) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+void VerificationCache::add(VerificationCacheEntry* entry) {
+  assert_lock_strong(VerificationCache_lock);
+  unsigned int h = hash(entry->_name, (int)strlen(entry->_name)) % table_size;
+  entry->_next = _table[h];
+  _table[h] = entry;
+}
+
+void VerificationCache::load(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == NULL) {
+    return;
+  }
+  char line[8192];
+  char a[4096], b[4096];
+  VerificationCacheEntry* entry = NULL;
+  int supers = 0;
+  int assumptions = 0;
+  bool ok = fgets(line, sizeof(line), file) != NULL &&
+            strncmp(line, cache_header, strlen(cache_header)) == 0 &&
+            fgets(line, sizeof(line), file) != NULL &&
+            strncmp(line, "vm ", 3) == 0 &&
+            strncmp(line + 3, Abstract_VM_Version::internal_vm_info_string(),
+                    strlen(Abstract_VM_Version::internal_vm_info_string())) == 0;
+  while (ok && fgets(line, sizeof(line), file) != NULL) {
+    if (strchr(line, '\n') == NULL) {
+      ok = false;   // truncated or too long
+      break;
+    }
+    unsigned int size, crc;
+    int n, m, flag, result;
+    if (sscanf(line, "class %4095s %u %u %d %d", a, &size, &crc, &n, &m) == 5) {
+      if (entry != NULL || n < 0 || m < 0) {
+        ok = false;
+        break;
+      }
+      entry = new VerificationCacheEntry(a, size, crc, n, m);
+      supers = assumptions = 0;
+    } else if (entry != NULL && supers < entry->_num_supers &&
+               sscanf(line, "super %4095s %u %u %d", a, &size, &crc, &flag) == 4) {
+      VerificationCacheSuper* s = &entry->_supers[supers++];
+      s->_name = os::strdup(a, mtClass);
+      s->_size = size;
+      s->_crc = crc;
+      s->_same_loader = flag != 0;
+    } else if (entry != NULL && assumptions < entry->_num_assumptions &&
+               sscanf(line, "assignable %4095s %4095s %d %d", a, b, &flag, &result) == 4) {
+      VerificationCacheAssumption* v = &entry->_assumptions[assumptions++];
+      v->_target = os::strdup(a, mtClass);
+      v->_from = os::strdup(b, mtClass);
+      v->_from_field_is_protected = flag != 0;
+      v->_result = result != 0;
+    } else {
+      ok = false;
+      break;
+    }
+    if (entry != NULL && supers == entry->_num_supers &&
+        assumptions == entry->_num_assumptions) {
+      add(entry);
+      entry = NULL;
+    }
+  }
+  fclose(file);
+  if (!ok && PrintVerificationCache) {
+    tty->print_cr("[Verification cache %s ignored from the first bad entry on]", path);
+  }
+}
+
+bool VerificationCache::check_supers(VerificationCacheEntry* entry, instanceKlassHandle klass) {
+  int i = 0;
+  for (Klass* s = klass->super(); s != NULL; s = s->super(), i++) {
+    if (i >= entry->_num_supers) {
+      return false;
+    }
+    VerificationCacheSuper* cs = &entry->_supers[i];
+    InstanceKlass* ik = InstanceKlass::cast(s);
+    if (!ik->name()->equals(cs->_name, (int)strlen(cs->_name)) ||
+        ik->bytes_size() != cs->_size || ik->crc32() != cs->_crc ||
+        (ik->class_loader() == klass->class_loader()) != cs->_same_loader) {
+      return false;
+    }
+  }
+  return i == entry->_num_supers;
+}
+
+// Redo the checks of VerificationType::is_reference_assignable_from that
+// depend on other classes.
+bool VerificationCache::check_assumptions(VerificationCacheEntry* entry,
+                                          instanceKlassHandle klass, TRAPS) {
+  Handle loader(THREAD, klass->class_loader());
+  Handle pd(THREAD, klass->protection_domain());
+  for (int i = 0; i < entry->_num_assumptions; i++) {
+    VerificationCacheAssumption* v = &entry->_assumptions[i];
+    TempNewSymbol target_name = SymbolTable::new_symbol(v->_target, CHECK_false);
+    Klass* target = SystemDictionary::resolve_or_fail(target_name, loader, pd, true, CHECK_false);
+    bool result;
+    if (target->is_interface() && (!v->_from_field_is_protected ||
+        strcmp(v->_from, "java/lang/Object") != 0)) {
+      result = true;
+    } else if (v->_from[0] != '[') {
+      TempNewSymbol from_name = SymbolTable::new_symbol(v->_from, CHECK_false);
+      Klass* from = SystemDictionary::resolve_or_fail(from_name, loader, pd, true, CHECK_false);
+      result = InstanceKlass::cast(from)->is_subclass_of(target);
+    } else {
+      result = false;
+    }
+    if (result != v->_result) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool VerificationCache::lookup(instanceKlassHandle klass, TRAPS) {
+  if (klass->bytes_size() == 0) {
+    return false;
+  }
+  VerificationCacheEntry* entry;
+  {
+    MutexLocker ml(VerificationCache_lock);
+    initialize();
+    entry = find(klass->name(), klass->bytes_size(), klass->crc32());
+  }
+  if (entry == NULL) {
+    return false;
+  }
+
+  bool holds = check_supers(entry, klass) && check_assumptions(entry, klass, THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    // Let the verifier run into the same problem and report it.
+    CLEAR_PENDING_EXCEPTION;
+    holds = false;
+  }
+  if (!holds) {
+    // The class is verified again and recorded with the new assumptions.
+    entry->_valid = false;
+  }
+  if (PrintVerificationCache) {
+    ResourceMark rm;
+    tty->print_cr("[Verification cache %s for %s]", holds ? "hit" : "stale",
+                  klass->external_name());
+  }
+  return holds;
+}
+
+static bool is_plain_name(const char* s) {
+  // The file format separates names with spaces.
+  return strchr(s, ' ') == NULL && strchr(s, '\n') == NULL && strlen(s) < 4096;
+}
+
+void VerificationCache::record(instanceKlassHandle klass,
+                               GrowableArray<VerificationAssumption>* assumptions) {
+  if (klass->bytes_size() == 0 || assumptions == NULL) {
+    return;
+  }
+  ResourceMark rm;
+  const char* name = klass->name()->as_C_string();
+  if (!is_plain_name(name)) {
+    return;
+  }
+  int num_supers = 0;
+  for (Klass* s = klass->super(); s != NULL; s = s->super()) {
+    num_supers++;
+  }
+  VerificationCacheEntry* entry = new VerificationCacheEntry(name, klass->bytes_size(), klass->crc32(),
+                                                             num_supers, assumptions->length());
+  int i = 0;
+  for (Klass* s = klass->super(); s != NULL; s = s->super(), i++) {
+    InstanceKlass* ik = InstanceKlass::cast(s);
+    VerificationCacheSuper* cs = &entry->_supers[i];
+    cs->_name = os::strdup(ik->name()->as_C_string(), mtClass);
+    cs->_size = ik->bytes_size();
+    cs->_crc = ik->crc32();
+    cs->_same_loader = ik->class_loader() == klass->class_loader();
+  }
+  for (i = 0; i < assumptions->length(); i++) {
+    VerificationAssumption* a = assumptions->adr_at(i);
+    VerificationCacheAssumption* v = &entry->_assumptions[i];
+    v->_target = os::strdup(a->_target->as_C_string(), mtClass);
+    v->_from = os::strdup(a->_from->as_C_string(), mtClass);
+    v->_from_field_is_protected = a->_from_field_is_protected;
+    v->_result = a->_result;
+    if (!is_plain_name(v->_target) || !is_plain_name(v->_from)) {
+      entry->_valid = false;
+    }
+  }
+
+  MutexLocker ml(VerificationCache_lock);
+  initialize();
+  VerificationCacheEntry* old = find(klass->name(), klass->bytes_size(), klass->crc32());
+  if (old != NULL) {
+    old->_valid = false;
+  }
+  if (entry->_valid) {
+    add(entry);
+  }
+}
+
+void VerificationCache::write() {
+  MutexLocker ml(VerificationCache_lock);
+  if (_table == NULL) {
+    // Nothing was verified, keep the file as it is.
+    return;
+  }
+  fileStream out(VerificationCacheFile, "w");
+  if (!out.is_open()) {
+    warning("Cannot write verification cache %s", VerificationCacheFile);
+    return;
+  }
+  out.print_cr("%s", cache_header);
+  out.print_cr("vm %s", Abstract_VM_Version::internal_vm_info_string());
+  for (int i = 0; i < table_size; i++) {
+    for (VerificationCacheEntry* e = _table[i]; e != NULL; e = e->_next) {
+      if (!e->_valid) {
+        continue;
+      }
+      out.print_cr("class %s %u %u %d %d", e->_name, e->_size, e->_crc,
+                   e->_num_supers, e->_num_assumptions);
+      for (int j = 0; j < e->_num_supers; j++) {
+        VerificationCacheSuper* s = &e->_supers[j];
+        out.print_cr("super %s %u %u %d", s->_name, s->_size, s->_crc, s->_same_loader ? 1 : 0);
+      }
+      for (int j = 0; j < e->_num_assumptions; j++) {
+        VerificationCacheAssumption* v = &e->_assumptions[j];
+        out.print_cr("assignable %s %s %d %d", v->_target, v->_from,
+                     v->_from_field_is_protected ? 1 : 0, v->_result ? 1 : 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
+#define SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/handles.hpp"
+#include "utilities/growableArray.hpp"
+
+class VerificationCacheEntry;
+
+// An assignability check the split verifier had to resolve classes for.
+class VerificationAssumption VALUE_OBJ_CLASS_SPEC {
+ public:
+  Symbol* _target;                   // checked to be assignable from _from
+  Symbol* _from;
+  bool    _from_field_is_protected;
+  bool    _result;
+};
+
+// Persistent cache of split verifier results (-XX:VerificationCacheFile).
+//
+// A class is identified by its name and the size and CRC32 of its class
+// file. The verification of identical bytes only depends on the classes
+// around it, so with each class we keep
+//  - its chain of super classes (name, class file size and CRC32, and
+//    whether it has the same loader), which decides the protected member
+//    checks, and
+//  - the outcome of each assignability check that resolved classes
+//    through the loader.
+// A later run skips the verification of the same bytes if all of these
+// still hold, and verifies the class as usual otherwise.
+class VerificationCache : AllStatic {
+ private:
+  enum { table_size = 1031 };
+  static VerificationCacheEntry** _table;
+
+  static void initialize();
+  static unsigned int hash(const char* name, int len);
+  static VerificationCacheEntry* find(Symbol* name, unsigned int size, unsigned int crc);
+  static void add(VerificationCacheEntry* entry);
+  static bool check_supers(VerificationCacheEntry* entry, instanceKlassHandle klass);
+  static bool check_assumptions(VerificationCacheEntry* entry, instanceKlassHandle klass, TRAPS);
+  static void load(const char* path);
+
+ public:
+  static bool is_enabled() { return VerificationCacheFile != NULL; }
+
+  // Returns true if the same class file passed verification in an earlier
+  // run and the assumptions it relied on still hold.
+  static bool lookup(instanceKlassHandle klass, TRAPS);
+  static void record(instanceKlassHandle klass,
+                     GrowableArray<VerificationAssumption>* assumptions);
+  // Write the cache back at VM exit.
+  static void write();
+};
+
+#endif // SHARE_VM_CLASSFILE_VERIFICATIONCACHE_HPP
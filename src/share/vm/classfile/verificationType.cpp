@@ -69,12 +69,14 @@ bool VerificationType::is_reference_assignable_from(
       // If we are not trying to access a protected field or method in
       // java.lang.Object then we treat interfaces as java.lang.Object,
       // including java.lang.Cloneable and java.io.Serializable.
+      context->record_assignability(name(), from.name(), from_field_is_protected, true);
       return true;
     } else if (from.is_object()) {
       Klass* from_class = SystemDictionary::resolve_or_fail(
           from.name(), Handle(THREAD, klass->class_loader()),
           Handle(THREAD, klass->protection_domain()), true, CHECK_false);
       bool result = InstanceKlass::cast(from_class)->is_subclass_of(this_class());
+      context->record_assignability(name(), from.name(), from_field_is_protected, result);
       if (result && DumpSharedSpaces) {
         if (klass()->is_subclass_of(from_class) && klass()->is_subclass_of(this_class())) {
           // No need to save verification dependency. At run time, <klass> will be
@@ -131,10 +131,17 @@ bool Verifier::verify(instanceKlassHandle klass, Verifier::Mode mode, bool shoul
     if (TraceClassInitialization) {
       tty->print_cr("Start class verification for: %s", klassName);
     }
-    if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
+    if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION &&
+        VerificationCache::is_enabled() && VerificationCache::lookup(klass, THREAD)) {
+      // Verified in an earlier run, and the assumptions still hold.
+    } else if (klass->major_version() >= STACKMAP_ATTRIBUTE_MAJOR_VERSION) {
       ClassVerifier split_verifier(klass, THREAD);
       split_verifier.verify_class(THREAD);
       exception_name = split_verifier.result();
+      if (exception_name == NULL && !HAS_PENDING_EXCEPTION &&
+          VerificationCache::is_enabled()) {
+        VerificationCache::record(klass, split_verifier.assumptions());
+      }
       if (can_failover && !HAS_PENDING_EXCEPTION &&
           (exception_name == vmSymbols::java_lang_VerifyError() ||
            exception_name == vmSymbols::java_lang_ClassFormatError())) {
@@ -530,6 +537,28 @@ ClassVerifier::ClassVerifier(
   _this_type = VerificationType::reference_type(klass->name());
   // Create list to hold symbols in reference area.
   _symbols = new GrowableArray<Symbol*>(100, 0, NULL);
+  _assumptions = VerificationCache::is_enabled() ?
+    new GrowableArray<VerificationAssumption>(16) : NULL;
+}
+
+void ClassVerifier::record_assignability(Symbol* target, Symbol* from,
+                                         bool from_field_is_protected, bool result) {
+  if (_assumptions == NULL) {
+    return;
+  }
+  for (int i = 0; i < _assumptions->length(); i++) {
+    VerificationAssumption* a = _assumptions->adr_at(i);
+    if (a->_target == target && a->_from == from &&
+        a->_from_field_is_protected == from_field_is_protected) {
+      return;
+    }
+  }
+  VerificationAssumption a;
+  a._target = target;
+  a._from = from;
+  a._from_field_is_protected = from_field_is_protected;
+  a._result = result;
+  _assumptions->append(a);
 }
 
 ClassVerifier::~ClassVerifier() {
@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_CLASSFILE_VERIFIER_HPP
 #define SHARE_VM_CLASSFILE_VERIFIER_HPP
 
+#include "classfile/verificationCache.hpp"
 #include "classfile/verificationType.hpp"
 #include "memory/gcLocker.hpp"
 #include "oops/klass.hpp"
@@ -253,6 +254,8 @@ class ClassVerifier : public StackObj {
  private:
   Thread* _thread;
   GrowableArray<Symbol*>* _symbols;  // keep a list of symbols created
+  // Assignability checks for the verification cache, NULL if disabled
+  GrowableArray<VerificationAssumption>* _assumptions;
 
   Symbol* _exception_type;
   char* _message;
@@ -373,6 +376,14 @@ class ClassVerifier : public StackObj {
   // destructor
   ~ClassVerifier();
 
+  void record_assignability(Symbol* target, Symbol* from,
+                            bool from_field_is_protected, bool result);
+  // What a complete verification relied on, NULL if there is nothing to
+  // record in the verification cache.
+  GrowableArray<VerificationAssumption>* assumptions() {
+    return was_recursively_verified() ? NULL : _assumptions;
+  }
+
   Thread* thread()             { return _thread; }
   methodHandle method()        { return _method; }
   instanceKlassHandle current_class() const { return _klass; }
@@ -878,7 +878,14 @@
                                                                                                                         \
   do_intrinsic(_equalsC,                  java_util_Arrays,       equals_name,    equalsC_signature,             F_S)   \
    do_signature(equalsC_signature,                               "([C[C)Z")                                             \
+  do_intrinsic(_hashCodeB,                java_util_Arrays,       hashCode_name,  hashCodeB_signature,           F_S)   \
+   do_signature(hashCodeB_signature,                             "([B)I")                                               \
+  do_intrinsic(_hashCodeC,                java_util_Arrays,       hashCode_name,  hashCodeC_signature,           F_S)   \
+   do_signature(hashCodeC_signature,                             "([C)I")                                               \
+  do_intrinsic(_hashCodeI,                java_util_Arrays,       hashCode_name,  hashCodeI_signature,           F_S)   \
+   do_signature(hashCodeI_signature,                             "([I)I")                                               \
                                                                                                                         \
+  do_intrinsic(_hashCodeString,           java_lang_String,       hashCode_name,  void_int_signature,            F_R)   \
   do_intrinsic(_compareTo,                java_lang_String,       compareTo_name, string_int_signature,          F_R)   \
    do_name(     compareTo_name,                                  "compareTo")                                           \
   do_intrinsic(_indexOf,                  java_lang_String,       indexOf_name, string_int_signature,            F_R)   \
@@ -894,6 +901,17 @@
    do_name(     encodeISOArray_name,                             "encodeISOArray")                                      \
    do_signature(encodeISOArray_signature,                        "([CI[BII)I")                                          \
                                                                                                                         \
+  do_class(sun_nio_cs_iso8859_1_Decoder,  "sun/nio/cs/ISO_8859_1$Decoder")                                              \
+  do_intrinsic(_latin1Decode,       sun_nio_cs_iso8859_1_Decoder, decode_name, charsetDecode_signature,          F_R)   \
+   do_name(     decode_name,                                     "decode")                                              \
+   do_signature(charsetDecode_signature,                         "([BII[C)I")                                           \
+  do_class(sun_nio_cs_utf_8_Decoder,      "sun/nio/cs/UTF_8$Decoder")                                                   \
+  do_intrinsic(_utf8Decode,         sun_nio_cs_utf_8_Decoder,     decode_name, charsetDecode_signature,          F_R)   \
+  do_class(sun_nio_cs_utf_8_Encoder,      "sun/nio/cs/UTF_8$Encoder")                                                   \
+  do_intrinsic(_utf8Encode,         sun_nio_cs_utf_8_Encoder,     encode_name, charsetEncode_signature,          F_R)   \
+   do_name(     encode_name,                                     "encode")                                              \
+   do_signature(charsetEncode_signature,                         "([CII[B)I")                                           \
+                                                                                                                        \
   do_class(java_math_BigInteger,                      "java/math/BigInteger")                                           \
   do_intrinsic(_multiplyToLen,      java_math_BigInteger, multiplyToLen_name, multiplyToLen_signature, F_S)             \
    do_name(     multiplyToLen_name,                             "multiplyToLen")                                        \
@@ -983,6 +1001,11 @@
   do_intrinsic(_copyMemory,               sun_misc_Unsafe,        copyMemory_name, copyMemory_signature,         F_RN)  \
    do_name(     copyMemory_name,                                 "copyMemory")                                          \
    do_signature(copyMemory_signature,         "(Ljava/lang/Object;JLjava/lang/Object;JJ)V")                             \
+  do_intrinsic(_vectorizedMismatch,       sun_misc_Unsafe,        vectorizedMismatch_name, vectorizedMismatch_signature, F_RN) \
+   do_name(     vectorizedMismatch_name,                         "vectorizedMismatch")                                  \
+   do_signature(vectorizedMismatch_signature, "(Ljava/lang/Object;JLjava/lang/Object;JJ)J")                             \
+  do_intrinsic(_unsafeHash,               sun_misc_Unsafe,        hash_name, unsafeHash_signature,               F_RN)  \
+   do_signature(unsafeHash_signature,                            "(Ljava/lang/Object;JJI)I")                            \
   do_intrinsic(_park,                     sun_misc_Unsafe,        park_name, park_signature,                     F_RN)  \
    do_name(     park_name,                                       "park")                                                \
    do_signature(park_signature,                                  "(ZJ)V")                                               \
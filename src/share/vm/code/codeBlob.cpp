@@ -143,6 +143,38 @@ CodeBlob::CodeBlob(
 }
 
 
+// Creates a CodeBlob with the layout of a CodeBlob of an earlier run. The
+// content and relocation info are copied in by the caller.
+CodeBlob::CodeBlob(
+  const char* name,
+  int         header_size,
+  int         size,
+  int         locs_size,
+  int         code_offset,
+  int         data_offset,
+  int         frame_complete,
+  int         frame_size,
+  OopMapSet*  oop_maps
+) {
+  assert(size        == round_to(size,        oopSize), "unaligned size");
+  assert(locs_size   == round_to(locs_size,   oopSize), "unaligned size");
+  assert(header_size == round_to(header_size, oopSize), "unaligned size");
+
+  _name                  = name;
+  _size                  = size;
+  _frame_complete_offset = frame_complete;
+  _header_size           = header_size;
+  _relocation_size       = locs_size;
+  _content_offset        = align_code_offset(header_size + _relocation_size);
+  _code_offset           = code_offset;
+  _data_offset           = data_offset;
+  assert(_content_offset <= _code_offset && _code_offset <= _data_offset &&
+         _data_offset <= size, "codeBlob is too small");
+  set_oop_maps(oop_maps);
+  _frame_size = frame_size;
+}
+
+
 void CodeBlob::set_oop_maps(OopMapSet* p) {
   // Danger Will Robinson! This method allocates a big
   // chunk of memory, its your job to free it.
@@ -34,8 +34,11 @@
 // Used in the CodeCache to assign CodeBlobs to different CodeHeaps
 struct CodeBlobType {
   enum {
-    All                 = 0,    // All types (No code cache segmentation)
-    NumTypes            = 1     // Number of CodeBlobTypes
+    MethodNonProfiled   = 0,    // Execution level 1 and 4 (non-profiled) nmethods (including native nmethods)
+    MethodProfiled      = 1,    // Execution level 2 and 3 (profiled) nmethods
+    NonNMethod          = 2,    // Non-nmethods like Buffers, Adapters and Runtime Stubs
+    All                 = 3,    // All types (No code cache segmentation)
+    NumTypes            = 4     // Number of CodeBlobTypes
   };
 };
 
@@ -60,6 +63,7 @@ class DeoptimizationBlob;
 class CodeBlob VALUE_OBJ_CLASS_SPEC {
 
   friend class VMStructs;
+  friend class CompiledCodeCache;
 
  private:
   const char* _name;
@@ -99,6 +103,20 @@ class CodeBlob VALUE_OBJ_CLASS_SPEC {
     OopMapSet*  oop_maps
   );
 
+  // c) CodeBlob with a recorded layout, the caller copies in code and
+  // relocation info (see CompiledCodeCache)
+  CodeBlob(
+    const char* name,
+    int         header_size,
+    int         size,
+    int         locs_size,
+    int         code_offset,
+    int         data_offset,
+    int         frame_complete,
+    int         frame_size,
+    OopMapSet*  oop_maps
+  );
+
   // Deletion
   void flush();
 
@@ -120,6 +120,10 @@ class CodeBlob_sizes {
 // CodeCache implementation
 
 CodeHeap * CodeCache::_heap = new CodeHeap();
+CodeHeap * CodeCache::_heaps[CodeBlobType::All] = { NULL };
+int CodeCache::_number_of_heaps = 0;
+address CodeCache::_low_bound = NULL;
+address CodeCache::_high_bound = NULL;
 int CodeCache::_number_of_blobs = 0;
 int CodeCache::_number_of_adapters = 0;
 int CodeCache::_number_of_nmethods = 0;
@@ -129,15 +133,82 @@ nmethod* CodeCache::_scavenge_root_nmethods = NULL;
 
 int CodeCache::_codemem_full_count = 0;
 
+CodeHeap* CodeCache::get_code_heap(int code_blob_type) {
+  if (!SegmentedCodeCache) {
+    return _heap;
+  }
+  for (int i = 0; i < _number_of_heaps; i++) {
+    if (_heaps[i]->code_blob_type() == code_blob_type) {
+      return _heaps[i];
+    }
+  }
+  return NULL;
+}
+
+bool CodeCache::heap_available(int code_blob_type) {
+  return get_code_heap(code_blob_type) != NULL;
+}
+
+int CodeCache::get_code_blob_type(int comp_level) {
+  if (!SegmentedCodeCache) {
+    return CodeBlobType::All;
+  }
+  if ((comp_level == CompLevel_limited_profile || comp_level == CompLevel_full_profile) &&
+      heap_available(CodeBlobType::MethodProfiled)) {
+    return CodeBlobType::MethodProfiled;
+  }
+  return CodeBlobType::MethodNonProfiled;
+}
+
+int CodeCache::get_code_blob_type(const CodeBlob* cb) {
+  CodeHeap* heap = get_code_heap_containing((void*)cb);
+  return heap == NULL ? CodeBlobType::All : heap->code_blob_type();
+}
+
+const char* CodeCache::code_blob_type_name(int code_blob_type) {
+  switch (code_blob_type) {
+    case CodeBlobType::MethodNonProfiled: return "CodeHeap 'non-profiled nmethods'";
+    case CodeBlobType::MethodProfiled:    return "CodeHeap 'profiled nmethods'";
+    case CodeBlobType::NonNMethod:        return "CodeHeap 'non-nmethods'";
+    default:                              return "CodeCache";
+  }
+}
+
+// Returns the first blob of the heaps from heap_index on. The nmethod
+// walks (sweeper, GC) skip the non-nmethod heap altogether.
+CodeBlob* CodeCache::first_blob_from(int heap_index, bool nmethod_heaps_only) {
+  for (int i = heap_index; i < _number_of_heaps; i++) {
+    CodeHeap* heap = _heaps[i];
+    if (nmethod_heaps_only && heap->code_blob_type() == CodeBlobType::NonNMethod) {
+      continue;
+    }
+    CodeBlob* cb = (CodeBlob*)heap->first();
+    if (cb != NULL) {
+      return cb;
+    }
+  }
+  return NULL;
+}
+
+CodeBlob* CodeCache::next_blob(CodeBlob* cb, bool nmethod_heaps_only) {
+  int i = 0;
+  while (!_heaps[i]->contains(cb)) {
+    i++;
+    assert(i < _number_of_heaps, "blob not in the code cache");
+  }
+  CodeBlob* next = (CodeBlob*)_heaps[i]->next(cb);
+  return next != NULL ? next : first_blob_from(i + 1, nmethod_heaps_only);
+}
+
 CodeBlob* CodeCache::first() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->first();
+  return first_blob_from(0, false);
 }
 
 
 CodeBlob* CodeCache::next(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->next(cb);
+  return next_blob(cb, false);
 }
 
 
@@ -156,25 +227,25 @@ nmethod* CodeCache::alive_nmethod(CodeBlob* cb) {
 
 nmethod* CodeCache::first_nmethod() {
   assert_locked_or_safepoint(CodeCache_lock);
-  CodeBlob* cb = first();
+  CodeBlob* cb = first_blob_from(0, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
 nmethod* CodeCache::next_nmethod (CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  cb = next(cb);
+  cb = next_blob(cb, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
 static size_t maxCodeCacheUsed = 0;
 
-CodeBlob* CodeCache::allocate(int size, bool is_critical) {
+CodeBlob* CodeCache::allocate(int size, bool is_critical, int code_blob_type) {
   // Do not seize the CodeCache lock here--if the caller has not
   // already done so, we are going to lose bigtime, since the code
   // cache will contain a garbage CodeBlob until the caller can
@@ -183,29 +254,40 @@ CodeBlob* CodeCache::allocate(int size, bool is_critical) {
   guarantee(size >= 0, "allocation request must be reasonable");
   assert_locked_or_safepoint(CodeCache_lock);
   CodeBlob* cb = NULL;
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  assert(heap != NULL, "no heap for this code blob type");
   _number_of_blobs++;
   while (true) {
-    cb = (CodeBlob*)_heap->allocate(size, is_critical);
+    cb = (CodeBlob*)heap->allocate(size, is_critical);
     if (cb != NULL) break;
-    if (!_heap->expand_by(CodeCacheExpansionSize)) {
-      // Expansion failed
+    if (!heap->expand_by(CodeCacheExpansionSize)) {
+      // Expansion failed. A full nmethod heap borrows from the other
+      // nmethod heap before the code cache is reported full.
+      if (SegmentedCodeCache && heap->code_blob_type() != CodeBlobType::NonNMethod) {
+        int other = heap->code_blob_type() == CodeBlobType::MethodProfiled ?
+                    CodeBlobType::MethodNonProfiled : CodeBlobType::MethodProfiled;
+        CodeHeap* other_heap = get_code_heap(other);
+        if (other_heap != NULL && other_heap != heap && other != code_blob_type) {
+          heap = other_heap;
+          continue;
+        }
+      }
       if (CodeCache_lock->owned_by_self()) {
         MutexUnlockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
-        report_codemem_full();
+        report_codemem_full(code_blob_type);
       } else {
-        report_codemem_full();
+        report_codemem_full(code_blob_type);
       }
       return NULL;
     }
     if (PrintCodeCacheExtension) {
       ResourceMark rm;
-      tty->print_cr("code cache extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
-                    (intptr_t)_heap->low_boundary(), (intptr_t)_heap->high(),
-                    (address)_heap->high() - (address)_heap->low_boundary());
+      tty->print_cr("%s extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
+                    heap->name(), (intptr_t)heap->low_boundary(), (intptr_t)heap->high(),
+                    (address)heap->high() - (address)heap->low_boundary());
     }
   }
-  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, ((address)_heap->high_boundary() -
-                          (address)_heap->low_boundary()) - unallocated_capacity());
+  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, max_capacity() - unallocated_capacity());
   verify_if_often();
   print_trace("allocation", cb, size);
   return cb;
@@ -227,7 +309,9 @@ void CodeCache::free(CodeBlob* cb) {
   }
   _number_of_blobs--;
 
-  _heap->deallocate(cb);
+  CodeHeap* heap = get_code_heap_containing(cb);
+  assert(heap != NULL, "freeing a blob outside the code cache");
+  heap->deallocate(cb);
 
   verify_if_often();
   assert(_number_of_blobs >= 0, "sanity check");
@@ -267,7 +351,7 @@ void CodeCache::flush() {
 
 bool CodeCache::contains(void *p) {
   // It should be ok to call contains without holding a lock
-  return _heap->contains(p);
+  return get_code_heap_containing(p) != NULL;
 }
 
 
@@ -585,20 +669,63 @@ void CodeCache::verify_oops() {
 
 address CodeCache::first_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->low_boundary();
+  return (address)_heaps[0]->low_boundary();
 }
 
 
 address CodeCache::last_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->high();
+  return (address)_heaps[_number_of_heaps - 1]->high();
+}
+
+size_t CodeCache::capacity() {
+  size_t cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    cap += _heaps[i]->capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::max_capacity() {
+  size_t cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    cap += _heaps[i]->max_capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::unallocated_capacity() {
+  size_t cap = 0;
+  for (int i = 0; i < _number_of_heaps; i++) {
+    cap += _heaps[i]->unallocated_capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::unallocated_capacity(int code_blob_type) {
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  return heap == NULL ? 0 : heap->unallocated_capacity();
 }
 
 /**
  * Returns the reverse free ratio. E.g., if 25% (1/4) of the code cache
- * is free, reverse_free_ratio() returns 4.
+ * is free, reverse_free_ratio() returns 4. With SegmentedCodeCache only
+ * the nmethod heaps count, since only they are reclaimed by sweeping,
+ * and the fuller one decides.
  */
 double CodeCache::reverse_free_ratio() {
+  if (SegmentedCodeCache) {
+    double ratio = 0.0;
+    for (int i = 0; i < _number_of_heaps; i++) {
+      CodeHeap* heap = _heaps[i];
+      if (heap->code_blob_type() == CodeBlobType::NonNMethod) {
+        continue;
+      }
+      double unallocated = MAX2((double)heap->unallocated_capacity() - CodeCacheMinimumFreeSpace, 1.0);
+      ratio = MAX2(ratio, (double)heap->max_capacity() / unallocated);
+    }
+    return ratio;
+  }
   double unallocated_capacity = (double)(CodeCache::unallocated_capacity() - CodeCacheMinimumFreeSpace);
   double max_capacity = (double)CodeCache::max_capacity();
   return max_capacity / unallocated_capacity;
@@ -618,11 +745,27 @@ void CodeCache::initialize() {
   CodeCacheExpansionSize = round_to(CodeCacheExpansionSize, os::vm_page_size());
   InitialCodeCacheSize = round_to(InitialCodeCacheSize, os::vm_page_size());
   ReservedCodeCacheSize = round_to(ReservedCodeCacheSize, os::vm_page_size());
-  if (!_heap->reserve(ReservedCodeCacheSize, InitialCodeCacheSize, CodeCacheSegmentSize)) {
-    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  if (SegmentedCodeCache) {
+    initialize_heaps();
+  } else {
+    size_t committed = PreTouchCodeCache ? ReservedCodeCacheSize : InitialCodeCacheSize;
+    if (!_heap->reserve(ReservedCodeCacheSize, committed, CodeCacheSegmentSize)) {
+      vm_exit_during_initialization("Could not reserve enough space for code cache");
+    }
+    _heap->set_code_blob_type(CodeBlobType::All);
+    _heaps[0] = _heap;
+    _number_of_heaps = 1;
+    _low_bound = (address)_heap->low_boundary();
+    _high_bound = (address)_heap->high_boundary();
   }
 
-  MemoryService::add_code_heap_memory_pool(_heap);
+  for (int i = 0; i < _number_of_heaps; i++) {
+    MemoryService::add_code_heap_memory_pool(_heaps[i], SegmentedCodeCache ? _heaps[i]->name() : "Code Cache");
+    // AlwaysPreTouch has touched the memory already when committing it.
+    if (PreTouchCodeCache && !AlwaysPreTouch) {
+      os::pretouch_memory(_heaps[i]->low_boundary(), _heaps[i]->high());
+    }
+  }
 
   // Initialize ICache flush mechanism
   // This service is needed for os::register_code_area
@@ -631,7 +774,86 @@ void CodeCache::initialize() {
   // Give OS a chance to register generated code area.
   // This is used on Windows 64 bit platforms to register
   // Structured Exception Handlers for our generated code.
-  os::register_code_area(_heap->low_boundary(), _heap->high_boundary());
+  os::register_code_area((char*)_low_bound, (char*)_high_bound);
+}
+
+// Splits ReservedCodeCacheSize between the heaps. Sizes not given on the
+// command line share what is left: the non-nmethod heap gets a small
+// fixed part, and the nmethod heaps split the rest evenly. Without tiered
+// compilation no code is profiled and that heap is left out.
+void CodeCache::initialize_heaps() {
+  const size_t page_size = CodeHeap::page_size_for(ReservedCodeCacheSize);
+  const size_t alignment = MAX2(page_size, (size_t)os::vm_allocation_granularity());
+  const size_t total = align_size_down(ReservedCodeCacheSize, alignment);
+  const bool has_profiled = TieredCompilation;
+
+  size_t non_nmethod = NonNMethodCodeHeapSize;
+  size_t profiled = has_profiled ? ProfiledCodeHeapSize : 0;
+  size_t non_profiled = NonProfiledCodeHeapSize;
+  if (non_nmethod == 0) {
+    non_nmethod = MAX2(MIN2(total / 16, (size_t)(8 * M)), (size_t)CodeCacheMinimumUseSpace DEBUG_ONLY(* 3));
+  }
+  non_nmethod = align_size_up(non_nmethod, alignment);
+  if (non_nmethod >= total) {
+    vm_exit_during_initialization("NonNMethodCodeHeapSize does not leave room for nmethods "
+                                  "in ReservedCodeCacheSize");
+  }
+  size_t rest = total - non_nmethod;
+  if (has_profiled) {
+    if (profiled == 0 && non_profiled == 0) {
+      profiled = rest / 2;
+    } else if (profiled == 0) {
+      profiled = rest > non_profiled ? rest - non_profiled : 0;
+    }
+    profiled = align_size_down(MIN2(profiled, rest), alignment);
+  }
+  if (non_profiled == 0 || non_profiled > rest - profiled) {
+    non_profiled = rest - profiled;
+  }
+  non_profiled = align_size_down(non_profiled, alignment);
+  if (non_profiled == 0 || (has_profiled && profiled == 0)) {
+    vm_exit_during_initialization("Code heap sizes do not fit into ReservedCodeCacheSize");
+  }
+  FLAG_SET_ERGO(uintx, NonNMethodCodeHeapSize, non_nmethod);
+  FLAG_SET_ERGO(uintx, ProfiledCodeHeapSize, profiled);
+  FLAG_SET_ERGO(uintx, NonProfiledCodeHeapSize, non_profiled);
+
+  const size_t used = non_nmethod + profiled + non_profiled;
+  const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 : alignment;
+  ReservedCodeSpace rs(used, rs_align, rs_align > 0 && !CodeHeap::uses_large_code_pages());
+  if (!rs.is_reserved()) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+  os::trace_page_sizes("code heap", InitialCodeCacheSize, used, page_size, rs.base(), rs.size());
+  _low_bound = (address)rs.base();
+  _high_bound = (address)rs.base() + rs.size();
+
+  // Initial commit is shared out in proportion to the heap sizes.
+  ReservedSpace non_nmethod_space = rs.first_part(non_nmethod);
+  ReservedSpace nmethod_space = rs.last_part(non_nmethod);
+  add_heap(non_nmethod_space, code_blob_type_name(CodeBlobType::NonNMethod),
+           InitialCodeCacheSize * (non_nmethod / M) / (used / M + 1), CodeBlobType::NonNMethod);
+  if (has_profiled) {
+    ReservedSpace profiled_space = nmethod_space.first_part(profiled);
+    nmethod_space = nmethod_space.last_part(profiled);
+    add_heap(profiled_space, code_blob_type_name(CodeBlobType::MethodProfiled),
+             InitialCodeCacheSize * (profiled / M) / (used / M + 1), CodeBlobType::MethodProfiled);
+  }
+  add_heap(nmethod_space, code_blob_type_name(CodeBlobType::MethodNonProfiled),
+           InitialCodeCacheSize * (non_profiled / M) / (used / M + 1), CodeBlobType::MethodNonProfiled);
+  _heap = _heaps[0];
+}
+
+void CodeCache::add_heap(ReservedSpace rs, const char* name, size_t initial_size, int code_blob_type) {
+  assert(_number_of_heaps < CodeBlobType::All, "too many code heaps");
+  CodeHeap* heap = new CodeHeap();
+  heap->set_name(name);
+  heap->set_code_blob_type(code_blob_type);
+  size_t committed = PreTouchCodeCache ? rs.size() : MIN2(MAX2(initial_size, (size_t)os::vm_page_size()), rs.size());
+  if (!heap->reserve(rs, committed, CodeCacheSegmentSize)) {
+    vm_exit_during_initialization("Could not reserve enough space for code heap", name);
+  }
+  _heaps[_number_of_heaps++] = heap;
 }
 
 
@@ -766,6 +988,21 @@ int CodeCache::mark_for_deoptimization(Method* dependee) {
   return number_of_marked_CodeBlobs;
 }
 
+// Marks the nmethods of methods selected for JvmtiSelectiveMethodTrace
+int CodeCache::mark_for_jvmti_trace_deoptimization() {
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  int number_of_marked_CodeBlobs = 0;
+
+  FOR_ALL_ALIVE_NMETHODS(nm) {
+    if (nm->method()->is_jvmti_traced()) {
+      nm->mark_for_deoptimization();
+      number_of_marked_CodeBlobs++;
+    }
+  }
+
+  return number_of_marked_CodeBlobs;
+}
+
 void CodeCache::make_marked_nmethods_not_entrant() {
   assert_locked_or_safepoint(CodeCache_lock);
   FOR_ALL_ALIVE_NMETHODS(nm) {
@@ -776,20 +1013,26 @@ void CodeCache::make_marked_nmethods_not_entrant() {
 }
 
 void CodeCache::verify() {
-  _heap->verify();
+  for (int i = 0; i < _number_of_heaps; i++) {
+    _heaps[i]->verify();
+  }
   FOR_ALL_ALIVE_BLOBS(p) {
     p->verify();
   }
 }
 
-void CodeCache::report_codemem_full() {
+void CodeCache::report_codemem_full(int code_blob_type) {
   _codemem_full_count++;
   EventCodeCacheFull event;
   if (event.should_commit()) {
-    event.set_codeBlobType((u1)CodeBlobType::All);
-    event.set_startAddress((u8)low_bound());
-    event.set_commitedTopAddress((u8)high());
-    event.set_reservedTopAddress((u8)high_bound());
+    CodeHeap* heap = code_blob_type == CodeBlobType::All ? NULL : get_code_heap(code_blob_type);
+    if (heap == NULL) {
+      heap = _heaps[_number_of_heaps - 1];
+    }
+    event.set_codeBlobType((u1)code_blob_type);
+    event.set_startAddress((u8)heap->low_boundary());
+    event.set_commitedTopAddress((u8)heap->high());
+    event.set_reservedTopAddress((u8)heap->high_boundary());
     event.set_entryCount(nof_blobs());
     event.set_methodCount(nof_nmethods());
     event.set_adaptorCount(nof_adapters());
@@ -806,7 +1049,9 @@ void CodeCache::report_codemem_full() {
 
 void CodeCache::verify_if_often() {
   if (VerifyCodeCacheOften) {
-    _heap->verify();
+    for (int i = 0; i < _number_of_heaps; i++) {
+      _heaps[i]->verify();
+    }
   }
 }
 
@@ -978,17 +1223,26 @@ void CodeCache::print() {
 }
 
 void CodeCache::print_summary(outputStream* st, bool detailed) {
-  size_t total = (_heap->high_boundary() - _heap->low_boundary());
+  size_t total = (_high_bound - _low_bound);
   st->print_cr("CodeCache: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
                "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
                total/K, (total - unallocated_capacity())/K,
                maxCodeCacheUsed/K, unallocated_capacity()/K);
 
   if (detailed) {
-    st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
-                 p2i(_heap->low_boundary()),
-                 p2i(_heap->high()),
-                 p2i(_heap->high_boundary()));
+    for (int i = 0; i < _number_of_heaps; i++) {
+      CodeHeap* heap = _heaps[i];
+      if (SegmentedCodeCache) {
+        size_t size = heap->high_boundary() - heap->low_boundary();
+        st->print_cr(" %s: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
+                     heap->name(), size/K, (size - heap->unallocated_capacity())/K,
+                     heap->unallocated_capacity()/K);
+      }
+      st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
+                   p2i(heap->low_boundary()),
+                   p2i(heap->high()),
+                   p2i(heap->high_boundary()));
+    }
     st->print_cr(" total_blobs=" UINT32_FORMAT " nmethods=" UINT32_FORMAT
                  " adapters=" UINT32_FORMAT,
                  nof_blobs(), nof_nmethods(), nof_adapters());
@@ -39,6 +39,10 @@
 //   - Each CodeBlob occupies one chunk of memory.
 //   - Like the offset table in oldspace the zone has at table for
 //     locating a method given a addess of an instruction.
+//   - With SegmentedCodeCache the reserved space is split into one
+//     CodeHeap per CodeBlobType (non-nmethods, profiled and non-profiled
+//     nmethods), laid out next to each other in that order. Without it
+//     there is a single heap holding everything.
 
 class OopClosure;
 class DepChange;
@@ -50,7 +54,11 @@ class CodeCache : AllStatic {
   // so that the generated assembly code is always there when it's needed.
   // This may cause memory leak, but is necessary, for now. See 4423824,
   // 4422213 or 4436291 for details.
-  static CodeHeap * _heap;
+  static CodeHeap * _heap;                      // the lowest heap; the only one when not segmented
+  static CodeHeap * _heaps[CodeBlobType::All];  // all heaps, in address order
+  static int _number_of_heaps;
+  static address _low_bound;                    // bounds of the whole reservation
+  static address _high_bound;
   static int _number_of_blobs;
   static int _number_of_adapters;
   static int _number_of_nmethods;
@@ -65,6 +73,19 @@ class CodeCache : AllStatic {
 
   static int _codemem_full_count;
 
+  // CodeHeap management
+  static void initialize_heaps();
+  static void add_heap(ReservedSpace rs, const char* name, size_t initial_size, int code_blob_type);
+  static CodeHeap* get_code_heap(int code_blob_type);
+  static CodeHeap* get_code_heap_containing(void* p) {
+    for (int i = 0; i < _number_of_heaps; i++) {
+      if (_heaps[i]->contains(p)) return _heaps[i];
+    }
+    return NULL;
+  }
+  static CodeBlob* first_blob_from(int heap_index, bool nmethod_heaps_only);
+  static CodeBlob* next_blob(CodeBlob* cb, bool nmethod_heaps_only);
+
   static void set_scavenge_root_nmethods(nmethod* nm) { _scavenge_root_nmethods = nm; }
   static void prune_scavenge_root_nmethods();
   static void unlink_scavenge_root_nmethod(nmethod* nm, nmethod* prev);
@@ -74,10 +95,12 @@ class CodeCache : AllStatic {
   // Initialization
   static void initialize();
 
-  static void report_codemem_full();
+  static void report_codemem_full(int code_blob_type = CodeBlobType::All);
+  static bool heap_available(int code_blob_type);
 
   // Allocation/administration
-  static CodeBlob* allocate(int size, bool is_critical = false); // allocates a new CodeBlob
+  static CodeBlob* allocate(int size, bool is_critical = false,   // allocates a new CodeBlob
+                            int code_blob_type = CodeBlobType::NonNMethod);
   static void commit(CodeBlob* cb);                 // called when the allocated CodeBlob has been filled
   static int alignment_unit();                      // guaranteed alignment of all CodeBlobs
   static int alignment_offset();                    // guaranteed offset of first CodeBlob byte within alignment unit (i.e., allocation header)
@@ -97,9 +120,10 @@ class CodeCache : AllStatic {
   // what you are doing)
   static CodeBlob* find_blob_unsafe(void* start) {
     // NMT can walk the stack before code cache is created
-    if (_heap == NULL) return NULL;
+    CodeHeap* heap = get_code_heap_containing(start);
+    if (heap == NULL) return NULL;
 
-    CodeBlob* result = (CodeBlob*)_heap->find_start(start);
+    CodeBlob* result = (CodeBlob*)heap->find_start(start);
     // this assert is too strong because the heap code will return the
     // heapblock containing start. That block can often be larger than
     // the codeBlob itself. If you look up an address that is within
@@ -130,6 +154,11 @@ class CodeCache : AllStatic {
   static int       nof_adapters()              { return _number_of_adapters; }
   static int       nof_nmethods()              { return _number_of_nmethods; }
 
+  // CodeBlobType of nmethods compiled at comp_level, and of a blob's heap
+  static int       get_code_blob_type(int comp_level);
+  static int       get_code_blob_type(const CodeBlob* cb);
+  static const char* code_blob_type_name(int code_blob_type);
+
   // GC support
   static void gc_epilogue();
   static void gc_prologue();
@@ -160,18 +189,22 @@ class CodeCache : AllStatic {
   static void log_state(outputStream* st);
 
   // The full limits of the codeCache
-  static address  low_bound()                    { return (address) _heap->low_boundary(); }
-  static address  high_bound()                   { return (address) _heap->high_boundary(); }
-  static address  high()                         { return (address) _heap->high(); }
+  static address  low_bound()                    { return _low_bound; }
+  static address  high_bound()                   { return _high_bound; }
+  static address  high()                         { return (address) _heaps[_number_of_heaps - 1]->high(); }
 
   // Profiling
   static address first_address();                // first address used for CodeBlobs
   static address last_address();                 // last  address used for CodeBlobs
-  static size_t  capacity()                      { return _heap->capacity(); }
-  static size_t  max_capacity()                  { return _heap->max_capacity(); }
-  static size_t  unallocated_capacity()          { return _heap->unallocated_capacity(); }
+  static size_t  capacity();
+  static size_t  max_capacity();
+  static size_t  unallocated_capacity();
+  static size_t  unallocated_capacity(int code_blob_type);
   static double  reverse_free_ratio();
 
+  static int     number_of_heaps()               { return _number_of_heaps; }
+  static CodeHeap* heap_at(int i)                { assert(i < _number_of_heaps, "oob"); return _heaps[i]; }
+
   static bool needs_cache_clean()                { return _needs_cache_clean; }
   static void set_needs_cache_clean(bool v)      { _needs_cache_clean = v;    }
   static void clear_inline_caches();             // clear all inline caches
@@ -187,6 +220,7 @@ class CodeCache : AllStatic {
 
   static void mark_all_nmethods_for_deoptimization();
   static int  mark_for_deoptimization(Method* dependee);
+  static int  mark_for_jvmti_trace_deoptimization();
   static void make_marked_nmethods_not_entrant();
 
     // tells how many nmethods have dependencies
@@ -0,0 +1,1252 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "asm/macroAssembler.hpp"
+#include "ci/ciEnv.hpp"
+#include "ci/ciMetadata.hpp"
+#include "ci/ciObjectFactory.hpp"
+#include "ci/ciUtilities.hpp"
+#include "classfile/classLoader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
+#include "code/compiledCodeCache.hpp"
+#include "code/dependencies.hpp"
+#include "code/nmethod.hpp"
+#include "code/relocInfo.hpp"
+#include "compiler/compileBroker.hpp"
+#include "compiler/oopMap.hpp"
+#include "memory/cardTableModRefBS.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/objArrayKlass.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/icache.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/stubCodeGenerator.hpp"
+#include "runtime/vm_version.hpp"
+#include "utilities/ostream.hpp"
+
+// The file is only read by the same VM build (see the header check in
+// load_file), so values are kept in native byte order.
+class CompiledCodeWriter : public StackObj {
+ private:
+  GrowableArray<u1>* _buffer;
+
+ public:
+  CompiledCodeWriter() : _buffer(new GrowableArray<u1>(4 * K)) {}
+
+  void write_bytes(const void* p, int len) {
+    for (int i = 0; i < len; i++) {
+      _buffer->append(((const u1*)p)[i]);
+    }
+  }
+  void write_u1(int v)     { _buffer->append((u1)v); }
+  void write_int(jint v)   { write_bytes(&v, sizeof(v)); }
+  void write_long(jlong v) { write_bytes(&v, sizeof(v)); }
+  void write_string(const char* s) {
+    int len = (int)strlen(s);
+    write_int(len);
+    write_bytes(s, len + 1);
+  }
+  void append(CompiledCodeWriter* other) {
+    _buffer->appendAll(other->_buffer);
+  }
+
+  int length() const { return _buffer->length(); }
+  u1* data() const   { return _buffer->adr_at(0); }
+};
+
+class CompiledCodeReader : public StackObj {
+ private:
+  const u1* _pos;
+  const u1* _end;
+  bool      _ok;
+
+ public:
+  CompiledCodeReader(const u1* data, int length) : _pos(data), _end(data + length), _ok(true) {}
+
+  // False once a read went past the end, all later reads return 0 or "".
+  bool ok() const       { return _ok; }
+  bool at_end() const   { return _pos == _end; }
+
+  const u1* read_bytes(int len) {
+    if (!_ok || len < 0 || len > _end - _pos) {
+      _ok = false;
+      return NULL;
+    }
+    const u1* p = _pos;
+    _pos += len;
+    return p;
+  }
+  int read_u1() {
+    const u1* p = read_bytes(1);
+    return p == NULL ? 0 : *p;
+  }
+  jint read_int() {
+    jint v = 0;
+    const u1* p = read_bytes(sizeof(v));
+    if (p != NULL) {
+      memcpy(&v, p, sizeof(v));
+    }
+    return v;
+  }
+  jlong read_long() {
+    jlong v = 0;
+    const u1* p = read_bytes(sizeof(v));
+    if (p != NULL) {
+      memcpy(&v, p, sizeof(v));
+    }
+    return v;
+  }
+  const char* read_string() {
+    int len = read_int();
+    const char* s = len < 0 ? NULL : (const char*)read_bytes(len + 1);
+    if (s == NULL || s[len] != '\0') {
+      _ok = false;
+      return "";
+    }
+    return s;
+  }
+};
+
+class CompiledCodeCacheEntry : public CHeapObj<mtCode> {
+ public:
+  char*                   _holder;
+  char*                   _name;
+  char*                   _signature;
+  u1*                     _data;     // see CompiledCodeRecorder
+  int                     _length;
+  // Cleared when a newer compilation of the method is recorded. Entries
+  // are never freed, a load may still be using them.
+  volatile bool           _valid;
+  CompiledCodeCacheEntry* _next;
+
+  CompiledCodeCacheEntry(const char* holder, const char* name, const char* signature,
+                         const u1* data, int length) :
+    _length(length), _valid(true), _next(NULL) {
+    _holder = os::strdup(holder, mtCode);
+    _name = os::strdup(name, mtCode);
+    _signature = os::strdup(signature, mtCode);
+    _data = NEW_C_HEAP_ARRAY(u1, MAX2(length, 1), mtCode);
+    memcpy(_data, data, length);
+  }
+};
+
+// Tags of the symbolic references in an entry
+enum {
+  // oops and metadata
+  ref_null,
+  ref_non_oop_word,
+  ref_mirror,               // class index
+  ref_primitive_mirror,     // basic type
+  ref_string,               // length and UTF-16 characters of an interned string
+  ref_klass,                // class index
+  ref_method,               // class index, name and signature
+  // relocation targets
+  target_unchanged,         // NULL or an unresolved call, nothing to bind
+  target_self,              // offset from the start of the nmethod
+  target_stub,              // StubCodeDesc group and name, and offset
+  target_blob,              // runtime stub name and offset
+  target_vm                 // offset into libjvm
+};
+
+// Loaders a class can be recorded with
+enum {
+  boot_loader,
+  ext_loader,
+  app_loader
+};
+
+// Flags of a recorded class
+enum {
+  klass_initialized = 1,
+  klass_shared      = 2
+};
+
+CompiledCodeCacheEntry** CompiledCodeCache::_table = NULL;
+unsigned int             CompiledCodeCache::_config_digest = 0;
+
+static const char* cache_header = "HotSpot compiled code cache 1";
+
+// libjvm addresses are recorded as offsets from this variable.
+static int vm_anchor = 0;
+
+static int loader_kind(oop loader) {
+  if (loader == NULL) {
+    return boot_loader;
+  }
+  oop app = SystemDictionary::java_system_loader();
+  if (loader == app) {
+    return app_loader;
+  }
+  if (app != NULL && loader == java_lang_ClassLoader::parent(app)) {
+    return ext_loader;
+  }
+  return -1;
+}
+
+static oop loader_of_kind(int kind) {
+  oop app = SystemDictionary::java_system_loader();
+  switch (kind) {
+    case app_loader: return app;
+    case ext_loader: return app == NULL ? (oop)NULL : java_lang_ClassLoader::parent(app);
+    default:         return NULL;
+  }
+}
+
+// The instance class whose class file a class depends on: the class itself
+// or the element class of an object array. NULL for primitive arrays.
+static InstanceKlass* bottom_instance_klass(Klass* k) {
+  if (k->oop_is_objArray()) {
+    k = ObjArrayKlass::cast(k)->bottom_klass();
+  }
+  return k->oop_is_instance() ? InstanceKlass::cast(k) : NULL;
+}
+
+static bool is_named_blob(CodeBlob* cb) {
+  return cb->is_runtime_stub() || cb->is_deoptimization_stub() ||
+         cb->is_uncommon_trap_stub() || cb->is_exception_stub() ||
+         cb->is_safepoint_stub();
+}
+
+// Returns the VM blob called name, NULL if there is none or more than one.
+static CodeBlob* find_named_blob(const char* name) {
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  CodeBlob* found = NULL;
+  for (CodeBlob* cb = CodeCache::first(); cb != NULL; cb = CodeCache::next(cb)) {
+    if (is_named_blob(cb) && strcmp(cb->name(), name) == 0) {
+      if (found != NULL) {
+        return NULL;
+      }
+      found = cb;
+    }
+  }
+  return found;
+}
+
+// The code may reach an address outside the code cache with a 32-bit
+// displacement if it was reachable when the code was compiled.
+static bool is_reachable_from_code_cache(address a) {
+  if (CodeCache::contains(a)) {
+    return true;
+  }
+  intptr_t low = a - CodeCache::low_bound();
+  intptr_t high = a - CodeCache::high_bound();
+  return low == (intptr_t)(int32_t)low && high == (intptr_t)(int32_t)high;
+}
+
+// Cached code is bound to the compiled state of methods, which JVMTI
+// capabilities like breakpoints or local variable access change.
+static bool is_usable() {
+  if (JvmtiExport::can_hotswap_or_post_breakpoint() ||
+      JvmtiExport::can_access_local_variables() ||
+      JvmtiExport::can_post_on_exceptions()) {
+    return false;
+  }
+#ifdef AMD64
+  // Safepoint polls are only rebound as rip relative accesses.
+  if (!ThreadLocalSafepointPolls && Assembler::is_polling_page_far()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+static bool is_relocated_call(relocInfo::relocType type) {
+  return type == relocInfo::virtual_call_type ||
+         type == relocInfo::opt_virtual_call_type ||
+         type == relocInfo::static_call_type ||
+         type == relocInfo::runtime_call_type;
+}
+
+static bool is_relocated_address(relocInfo::relocType type) {
+  return type == relocInfo::external_word_type ||
+         type == relocInfo::internal_word_type ||
+         type == relocInfo::section_word_type;
+}
+
+// Serializes an nmethod with its classes, oops, metadata and relocation
+// targets recorded symbolically. An entry consists of
+//  - the classes, with name, loader, class file CRC32 and size, and flags,
+//  - the CompiledCodeLayout,
+//  - the bytes from the relocations to the end of the stubs, and from the
+//    scopes data to the end of the nmethod,
+//  - the oops and the metadata,
+//  - the targets of the call and address relocations, in relocation order,
+//  - the oop maps.
+class CompiledCodeRecorder : public StackObj {
+ private:
+  nmethod*              _nm;
+  GrowableArray<Klass*> _klasses;
+  CompiledCodeWriter    _body;
+  const char*           _failure;
+
+  void fail(const char* reason) {
+    if (_failure == NULL) {
+      _failure = reason;
+    }
+  }
+
+  int klass_index(Klass* k) {
+    int i = _klasses.find(k);
+    if (i < 0) {
+      _klasses.append(k);
+      i = _klasses.length() - 1;
+    }
+    return i;
+  }
+
+  void record_oop(oop o);
+  void record_metadata(Metadata* m);
+  void record_target(address a);
+
+ public:
+  CompiledCodeRecorder(nmethod* nm) : _nm(nm), _failure(NULL) {}
+
+  const char* failure() const { return _failure; }
+
+  void record_klasses(GrowableArray<ciMetadata*>* objects);
+  void record_code();
+  void write_to(CompiledCodeWriter* out);
+};
+
+void CompiledCodeRecorder::record_klasses(GrowableArray<ciMetadata*>* objects) {
+  // The holder comes first, a load checks it is the method's holder.
+  klass_index(_nm->method()->method_holder());
+  // Field offsets, class hierarchy and initialization state of every
+  // class the compilation looked at went into the code.
+  for (int i = 0; i < objects->length(); i++) {
+    ciMetadata* m = objects->at(i);
+    if (m->is_klass() && m->is_loaded()) {
+      klass_index((Klass*)m->constant_encoding());
+    }
+  }
+}
+
+void CompiledCodeRecorder::record_oop(oop o) {
+  if (o == NULL) {
+    _body.write_u1(ref_null);
+  } else if (o == (oop)Universe::non_oop_word()) {
+    _body.write_u1(ref_non_oop_word);
+  } else if (java_lang_Class::is_instance(o)) {
+    if (java_lang_Class::is_primitive(o)) {
+      _body.write_u1(ref_primitive_mirror);
+      _body.write_u1(java_lang_Class::primitive_type(o));
+    } else {
+      _body.write_u1(ref_mirror);
+      _body.write_int(klass_index(java_lang_Class::as_Klass(o)));
+    }
+  } else if (java_lang_String::is_instance(o)) {
+    typeArrayOop value = java_lang_String::value(o);
+    int length = java_lang_String::length(o);
+    jchar* chars = length == 0 ? NULL : value->char_at_addr(java_lang_String::offset(o));
+    if (StringTable::lookup(chars, length) != o) {
+      fail("string that is not interned");
+      return;
+    }
+    _body.write_u1(ref_string);
+    _body.write_int(length);
+    _body.write_bytes(chars, length * (int)sizeof(jchar));
+  } else {
+    fail("object constant");
+  }
+}
+
+void CompiledCodeRecorder::record_metadata(Metadata* m) {
+  if (m == NULL) {
+    _body.write_u1(ref_null);
+  } else if (m == (Metadata*)Universe::non_oop_word()) {
+    _body.write_u1(ref_non_oop_word);
+  } else if (m->is_klass()) {
+    _body.write_u1(ref_klass);
+    _body.write_int(klass_index((Klass*)m));
+  } else if (m->is_method()) {
+    Method* method = (Method*)m;
+    _body.write_u1(ref_method);
+    _body.write_int(klass_index(method->method_holder()));
+    _body.write_string(method->name()->as_C_string());
+    _body.write_string(method->signature()->as_C_string());
+  } else {
+    fail("metadata constant");
+  }
+}
+
+void CompiledCodeRecorder::record_target(address a) {
+  if (a == NULL || a == (address)-1) {
+    _body.write_u1(target_unchanged);
+    return;
+  }
+  if (_nm->contains(a)) {
+    _body.write_u1(target_self);
+    _body.write_int((jint)(a - _nm->header_begin()));
+    return;
+  }
+  StubCodeDesc* desc = StubCodeDesc::desc_for(a);
+  if (desc != NULL) {
+    if (desc->group() == NULL || StubCodeDesc::desc_for_name(desc->group(), desc->name()) != desc) {
+      fail("ambiguous stub");
+      return;
+    }
+    _body.write_u1(target_stub);
+    _body.write_string(desc->group());
+    _body.write_string(desc->name());
+    _body.write_int((jint)(a - desc->begin()));
+    return;
+  }
+  CodeBlob* cb = CodeCache::find_blob(a);
+  if (cb != NULL) {
+    if (!is_named_blob(cb) || find_named_blob(cb->name()) != cb) {
+      fail("call into unnamed code");
+      return;
+    }
+    _body.write_u1(target_blob);
+    _body.write_string(cb->name());
+    _body.write_int((jint)(a - (address)cb));
+    return;
+  }
+  if (os::address_is_in_vm(a)) {
+    _body.write_u1(target_vm);
+    _body.write_long((jlong)(a - (address)&vm_anchor));
+    return;
+  }
+  fail("address outside the VM");
+}
+
+void CompiledCodeCache::fill_layout(nmethod* nm, CompiledCodeLayout* layout) {
+  memset(layout, 0, sizeof(*layout));
+  layout->_size                   = nm->size();
+  layout->_relocation_size        = nm->relocation_size();
+  layout->_content_offset         = nm->content_offset();
+  layout->_code_offset            = nm->_code_offset;
+  layout->_data_offset            = nm->data_offset();
+  layout->_frame_complete_offset  = nm->_frame_complete_offset;
+  layout->_frame_size             = nm->frame_size();
+  layout->_consts_offset          = nm->_consts_offset;
+  layout->_stub_offset            = nm->_stub_offset;
+  layout->_exception_offset       = nm->_exception_offset;
+  layout->_deoptimize_offset      = nm->_deoptimize_offset;
+  layout->_deoptimize_mh_offset   = nm->_deoptimize_mh_offset;
+  layout->_unwind_handler_offset  = nm->_unwind_handler_offset;
+  layout->_oops_offset            = nm->_oops_offset;
+  layout->_metadata_offset        = nm->_metadata_offset;
+  layout->_scopes_data_offset     = nm->_scopes_data_offset;
+  layout->_scopes_pcs_offset      = nm->_scopes_pcs_offset;
+  layout->_dependencies_offset    = nm->_dependencies_offset;
+  layout->_handler_table_offset   = nm->_handler_table_offset;
+  layout->_nul_chk_table_offset   = nm->_nul_chk_table_offset;
+  layout->_nmethod_end_offset     = nm->_nmethod_end_offset;
+  layout->_orig_pc_offset         = nm->_orig_pc_offset;
+  layout->_entry_offset           = (int)(nm->entry_point() - nm->code_begin());
+  layout->_verified_entry_offset  = (int)(nm->verified_entry_point() - nm->code_begin());
+  layout->_osr_entry_offset       = (int)(nm->_osr_entry_point - nm->code_begin());
+  layout->_comp_level             = nm->comp_level();
+  layout->_has_unsafe_access      = nm->has_unsafe_access();
+  layout->_has_method_handle_invokes = nm->has_method_handle_invokes();
+  layout->_has_wide_vectors       = nm->has_wide_vectors();
+}
+
+void CompiledCodeRecorder::record_code() {
+  nmethod* nm = _nm;
+  CompiledCodeLayout layout;
+  CompiledCodeCache::fill_layout(nm, &layout);
+  _body.write_bytes(&layout, sizeof(layout));
+
+  address content_begin = (address)nm->relocation_begin();
+  address content_end = nm->header_begin() + nm->data_offset();
+  _body.write_int((jint)(content_end - content_begin));
+  _body.write_bytes(content_begin, (int)(content_end - content_begin));
+  address data_end = nm->header_begin() + layout._nmethod_end_offset;
+  _body.write_int((jint)(data_end - nm->scopes_data_begin()));
+  _body.write_bytes(nm->scopes_data_begin(), (int)(data_end - nm->scopes_data_begin()));
+
+  _body.write_int((jint)(nm->oops_end() - nm->oops_begin()));
+  for (oop* p = nm->oops_begin(); p < nm->oops_end(); p++) {
+    record_oop(*p);
+  }
+  _body.write_int((jint)(nm->metadata_end() - nm->metadata_begin()));
+  for (Metadata** p = nm->metadata_begin(); p < nm->metadata_end(); p++) {
+    record_metadata(*p);
+  }
+
+  // Calls and addresses are bound to this VM, oops and metadata are
+  // refilled from the tables, polls are rebound to the polling page.
+  int targets = 0;
+  CompiledCodeWriter targets_out;
+  {
+    RelocIterator iter(nm);
+    while (iter.next()) {
+      relocInfo::relocType type = iter.type();
+      if (is_relocated_call(type) || is_relocated_address(type)) {
+        targets++;
+        continue;
+      }
+      switch (type) {
+        case relocInfo::oop_type:
+          if (iter.oop_reloc()->oop_is_immediate() && iter.oop_reloc()->oop_value() != NULL) {
+            fail("immediate oop");
+          }
+          break;
+        case relocInfo::metadata_type:
+          if (iter.metadata_reloc()->metadata_is_immediate() &&
+              iter.metadata_reloc()->metadata_value() != NULL) {
+            fail("immediate metadata");
+          }
+          break;
+        case relocInfo::static_stub_type:
+        case relocInfo::poll_type:
+        case relocInfo::poll_return_type:
+          break;
+        default:
+          fail("relocation type");
+      }
+    }
+  }
+  _body.write_int(targets);
+  RelocIterator iter(nm);
+  while (iter.next()) {
+    relocInfo::relocType type = iter.type();
+    if (is_relocated_call(type)) {
+      record_target(((CallRelocation*)iter.reloc())->destination());
+    } else if (type == relocInfo::external_word_type) {
+      record_target(iter.external_word_reloc()->target());
+    } else if (type == relocInfo::internal_word_type) {
+      record_target(iter.internal_word_reloc()->target());
+    } else if (type == relocInfo::section_word_type) {
+      record_target(iter.section_word_reloc()->target());
+    }
+  }
+
+  OopMapSet* maps = nm->oop_maps();
+  _body.write_int(maps == NULL ? -1 : maps->size());
+  for (int i = 0; maps != NULL && i < maps->size(); i++) {
+    OopMap* map = maps->at(i);
+    int count = 0;
+    for (OopMapStream oms(map); !oms.is_done(); oms.next()) {
+      count++;
+    }
+    _body.write_int(map->offset());
+    _body.write_int(count);
+    for (OopMapStream oms(map); !oms.is_done(); oms.next()) {
+      OopMapValue omv = oms.current();
+      _body.write_int(omv.type());
+      _body.write_int(omv.reg()->value());
+      _body.write_int(omv.content_reg()->value());
+    }
+  }
+}
+
+void CompiledCodeRecorder::write_to(CompiledCodeWriter* out) {
+  out->write_int(_klasses.length());
+  for (int i = 0; i < _klasses.length(); i++) {
+    Klass* k = _klasses.at(i);
+    InstanceKlass* ik = bottom_instance_klass(k);
+    int kind = loader_kind(ik == NULL ? (oop)NULL : ik->class_loader());
+    if (kind < 0 || (ik != NULL && ik->is_anonymous())) {
+      fail("class of a user-defined loader");
+      return;
+    }
+    if (ik != NULL && ik->bytes_size() == 0 && !ik->is_shared()) {
+      fail("class without class file CRC32");
+      return;
+    }
+    int flags = 0;
+    if (ik != NULL && ik->is_initialized()) {
+      flags |= klass_initialized;
+    }
+    if (ik != NULL && ik->is_shared()) {
+      flags |= klass_shared;
+    }
+    out->write_string(k->name()->as_C_string());
+    out->write_u1(kind);
+    out->write_int(ik == NULL ? 0 : ik->crc32());
+    out->write_int(ik == NULL ? 0 : ik->bytes_size());
+    out->write_u1(flags);
+  }
+  out->append(&_body);
+}
+
+// A cache entry bound to this VM: its classes, oops, metadata and
+// relocation targets are resolved.
+class CompiledCodeImage : public ResourceObj {
+ public:
+  CompiledCodeLayout        _layout;
+  const u1*                 _content;
+  int                       _content_length;
+  const u1*                 _data;
+  int                       _data_length;
+  GrowableArray<Klass*>     _klasses;
+  GrowableArray<int>        _oop_tags;
+  GrowableArray<Handle>     _oops;
+  GrowableArray<Metadata*>  _metadata;
+  GrowableArray<int>        _target_tags;
+  GrowableArray<address>    _targets;
+  OopMapSet*                _oop_maps;
+
+  CompiledCodeImage() : _content(NULL), _content_length(0), _data(NULL), _data_length(0),
+                        _oop_maps(NULL) {}
+
+  const char* bind(CompiledCodeCacheEntry* entry, methodHandle method, TRAPS);
+
+ private:
+  const char* bind_klasses(CompiledCodeReader* in, methodHandle method, TRAPS);
+  const char* bind_oops(CompiledCodeReader* in, TRAPS);
+  const char* bind_metadata(CompiledCodeReader* in);
+  const char* bind_targets(CompiledCodeReader* in);
+  const char* read_oop_maps(CompiledCodeReader* in);
+  Klass* klass_at(int index) {
+    return index >= 0 && index < _klasses.length() ? _klasses.at(index) : (Klass*)NULL;
+  }
+};
+
+const char* CompiledCodeImage::bind_klasses(CompiledCodeReader* in, methodHandle method, TRAPS) {
+  int count = in->read_int();
+  for (int i = 0; i < count && in->ok(); i++) {
+    const char* name = in->read_string();
+    int kind = in->read_u1();
+    unsigned int crc = (unsigned int)in->read_int();
+    unsigned int size = (unsigned int)in->read_int();
+    int flags = in->read_u1();
+    if (!in->ok()) {
+      break;
+    }
+    Symbol* sym = SymbolTable::probe(name, (int)strlen(name));
+    if (sym == NULL) {
+      return "class not loaded";
+    }
+    Handle loader(THREAD, loader_of_kind(kind));
+    Klass* k = SystemDictionary::find_instance_or_array_klass(sym, loader, Handle(), THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      k = NULL;
+    }
+    if (k == NULL) {
+      return "class not loaded";
+    }
+    InstanceKlass* ik = bottom_instance_klass(k);
+    unsigned int actual_crc = ik == NULL ? 0 : ik->crc32();
+    unsigned int actual_size = ik == NULL ? 0 : ik->bytes_size();
+    bool shared = ik != NULL && ik->is_shared();
+    if (actual_crc != crc || actual_size != size || shared != ((flags & klass_shared) != 0)) {
+      return "class file changed";
+    }
+    if ((flags & klass_initialized) != 0 && !ik->is_initialized()) {
+      return "class not initialized";
+    }
+    _klasses.append(k);
+  }
+  if (_klasses.length() == 0 || _klasses.at(0) != method->method_holder()) {
+    return "different holder";
+  }
+  return NULL;
+}
+
+const char* CompiledCodeImage::bind_oops(CompiledCodeReader* in, TRAPS) {
+  int count = in->read_int();
+  if (count * oopSize != _layout._metadata_offset - _layout._oops_offset) {
+    return "bad entry";
+  }
+  for (int i = 0; i < count && in->ok(); i++) {
+    int tag = in->read_u1();
+    Handle h;
+    switch (tag) {
+      case ref_null:
+      case ref_non_oop_word:
+        break;
+      case ref_mirror: {
+        Klass* k = klass_at(in->read_int());
+        if (k == NULL) {
+          return "bad entry";
+        }
+        h = Handle(THREAD, k->java_mirror());
+        break;
+      }
+      case ref_primitive_mirror: {
+        int type = in->read_u1();
+        if (type < T_BOOLEAN || type > T_VOID) {
+          return "bad entry";
+        }
+        h = Handle(THREAD, Universe::java_mirror((BasicType)type));
+        break;
+      }
+      case ref_string: {
+        int length = in->read_int();
+        const u1* bytes = in->read_bytes(length * (int)sizeof(jchar));
+        if (bytes == NULL) {
+          return "bad entry";
+        }
+        jchar* chars = NEW_RESOURCE_ARRAY(jchar, MAX2(length, 1));
+        memcpy(chars, bytes, length * sizeof(jchar));
+        Handle s = java_lang_String::create_from_unicode(chars, length, THREAD);
+        if (!HAS_PENDING_EXCEPTION) {
+          h = Handle(THREAD, StringTable::intern(s(), THREAD));
+        }
+        if (HAS_PENDING_EXCEPTION) {
+          CLEAR_PENDING_EXCEPTION;
+          return "string allocation failed";
+        }
+        break;
+      }
+      default:
+        return "bad entry";
+    }
+    _oop_tags.append(tag);
+    _oops.append(h);
+  }
+  return NULL;
+}
+
+const char* CompiledCodeImage::bind_metadata(CompiledCodeReader* in) {
+  int count = in->read_int();
+  if (count * wordSize != _layout._scopes_data_offset - _layout._metadata_offset) {
+    return "bad entry";
+  }
+  for (int i = 0; i < count && in->ok(); i++) {
+    Metadata* m = NULL;
+    switch (in->read_u1()) {
+      case ref_null:
+        break;
+      case ref_non_oop_word:
+        m = (Metadata*)Universe::non_oop_word();
+        break;
+      case ref_klass:
+        m = klass_at(in->read_int());
+        if (m == NULL) {
+          return "bad entry";
+        }
+        break;
+      case ref_method: {
+        Klass* holder = klass_at(in->read_int());
+        const char* name = in->read_string();
+        const char* signature = in->read_string();
+        if (holder == NULL || !holder->oop_is_instance()) {
+          return "bad entry";
+        }
+        Symbol* name_sym = SymbolTable::probe(name, (int)strlen(name));
+        Symbol* signature_sym = SymbolTable::probe(signature, (int)strlen(signature));
+        if (name_sym != NULL && signature_sym != NULL) {
+          m = InstanceKlass::cast(holder)->find_method(name_sym, signature_sym);
+        }
+        if (m == NULL) {
+          return "method not found";
+        }
+        break;
+      }
+      default:
+        return "bad entry";
+    }
+    _metadata.append(m);
+  }
+  return NULL;
+}
+
+const char* CompiledCodeImage::bind_targets(CompiledCodeReader* in) {
+  int count = in->read_int();
+  for (int i = 0; i < count && in->ok(); i++) {
+    int tag = in->read_u1();
+    address a = NULL;
+    switch (tag) {
+      case target_unchanged:
+        break;
+      case target_self: {
+        int offset = in->read_int();
+        if (offset < 0 || offset >= _layout._size) {
+          return "bad entry";
+        }
+        a = (address)(intptr_t)offset;
+        break;
+      }
+      case target_stub: {
+        const char* group = in->read_string();
+        const char* name = in->read_string();
+        int offset = in->read_int();
+        StubCodeDesc* desc = StubCodeDesc::desc_for_name(group, name);
+        if (desc == NULL || offset < 0 || offset > desc->size_in_bytes()) {
+          return "stub not found";
+        }
+        a = desc->begin() + offset;
+        break;
+      }
+      case target_blob: {
+        const char* name = in->read_string();
+        int offset = in->read_int();
+        CodeBlob* cb = find_named_blob(name);
+        if (cb == NULL || offset < 0 || offset >= cb->size()) {
+          return "runtime stub not found";
+        }
+        a = (address)cb + offset;
+        break;
+      }
+      case target_vm:
+        a = (address)&vm_anchor + in->read_long();
+        if (!os::address_is_in_vm(a) || !is_reachable_from_code_cache(a)) {
+          return "VM address not reachable";
+        }
+        break;
+      default:
+        return "bad entry";
+    }
+    _target_tags.append(tag);
+    _targets.append(a);
+  }
+  return NULL;
+}
+
+const char* CompiledCodeImage::read_oop_maps(CompiledCodeReader* in) {
+  int count = in->read_int();
+  if (count < 0) {
+    return NULL;
+  }
+  _oop_maps = new OopMapSet();
+  for (int i = 0; i < count && in->ok(); i++) {
+    int pc_offset = in->read_int();
+    int values = in->read_int();
+    const u1* start = in->read_bytes(values * 3 * (int)sizeof(jint));
+    if (start == NULL) {
+      return "bad entry";
+    }
+    // Size the map to the highest register or stack slot used.
+    CompiledCodeReader omv_in(start, values * 3 * (int)sizeof(jint));
+    int locs = 0;
+    for (int j = 0; j < values; j++) {
+      omv_in.read_int();
+      locs = MAX2(locs, omv_in.read_int() + 1);
+      omv_in.read_int();
+    }
+    OopMap* map = new OopMap(MAX2(locs - VMRegImpl::stack2reg(0)->value(), 0), 0);
+    CompiledCodeReader omv_values(start, values * 3 * (int)sizeof(jint));
+    for (int j = 0; j < values; j++) {
+      OopMapValue::oop_types type = (OopMapValue::oop_types)omv_values.read_int();
+      VMReg reg = VMRegImpl::as_VMReg(omv_values.read_int());
+      VMReg content_reg = VMRegImpl::as_VMReg(omv_values.read_int(), true);
+      map->set_xxx(reg, type, content_reg);
+    }
+    _oop_maps->add_gc_map(pc_offset, map);
+  }
+  return NULL;
+}
+
+const char* CompiledCodeImage::bind(CompiledCodeCacheEntry* entry, methodHandle method, TRAPS) {
+  CompiledCodeReader in(entry->_data, entry->_length);
+  const char* failure = bind_klasses(&in, method, THREAD);
+  if (failure != NULL) {
+    return failure;
+  }
+  const u1* layout = in.read_bytes(sizeof(_layout));
+  if (layout == NULL) {
+    return "bad entry";
+  }
+  memcpy(&_layout, layout, sizeof(_layout));
+  if (_layout._comp_level != CompLevel_full_optimization ||
+      _layout._content_offset != (int)CodeBlob::align_code_offset((int)sizeof(nmethod) + _layout._relocation_size) ||
+      _layout._data_offset > _layout._oops_offset ||
+      _layout._nmethod_end_offset > _layout._size) {
+    return "bad entry";
+  }
+  _content_length = in.read_int();
+  _content = in.read_bytes(_content_length);
+  _data_length = in.read_int();
+  _data = in.read_bytes(_data_length);
+  if (_content == NULL || _content_length != _layout._data_offset - (int)sizeof(nmethod) ||
+      _data == NULL || _data_length != _layout._nmethod_end_offset - _layout._scopes_data_offset) {
+    return "bad entry";
+  }
+  if ((failure = bind_oops(&in, THREAD)) != NULL ||
+      (failure = bind_metadata(&in)) != NULL ||
+      (failure = bind_targets(&in)) != NULL ||
+      (failure = read_oop_maps(&in)) != NULL) {
+    return failure;
+  }
+  if (!in.ok() || !in.at_end()) {
+    return "bad entry";
+  }
+  return NULL;
+}
+
+void CompiledCodeCache::copy_image_to(CompiledCodeImage* image, nmethod* nm) {
+  assert_locked_or_safepoint(CodeCache_lock);
+  memcpy(nm->relocation_begin(), image->_content, image->_content_length);
+  memcpy(nm->scopes_data_begin(), image->_data, image->_data_length);
+  oop* oops = nm->oops_begin();
+  for (int i = 0; i < image->_oops.length(); i++) {
+    oops[i] = image->_oop_tags.at(i) == ref_non_oop_word ? (oop)Universe::non_oop_word()
+                                                         : image->_oops.at(i)();
+  }
+  Metadata** metadata = nm->metadata_begin();
+  for (int i = 0; i < image->_metadata.length(); i++) {
+    metadata[i] = image->_metadata.at(i);
+  }
+
+  int next = 0;
+  RelocIterator iter(nm);
+  while (iter.next()) {
+    relocInfo::relocType type = iter.type();
+    if (is_relocated_call(type) || is_relocated_address(type)) {
+      assert(next < image->_targets.length(), "targets recorded in relocation order");
+      int tag = image->_target_tags.at(next);
+      address a = image->_targets.at(next);
+      next++;
+      if (tag == target_unchanged) {
+        continue;
+      }
+      if (tag == target_self) {
+        a = nm->header_begin() + (intptr_t)a;
+      }
+      if (is_relocated_call(type)) {
+        ((CallRelocation*)iter.reloc())->set_destination(a);
+      } else {
+        iter.reloc()->set_value(a);
+      }
+    }
+#ifdef AMD64
+    else if ((type == relocInfo::poll_type || type == relocInfo::poll_return_type) &&
+             !ThreadLocalSafepointPolls) {
+      // The poll reads the polling page rip relative.
+      address pc = iter.addr();
+      address disp = Assembler::locate_operand(pc, Assembler::disp32_operand);
+      address next_pc = Assembler::locate_next_instruction(pc);
+      *(int32_t*)disp = (int32_t)(os::get_polling_page() - next_pc);
+    }
+#endif
+  }
+  assert(next == image->_targets.length(), "targets recorded in relocation order");
+
+  // Patch the oops and metadata used by instructions.
+  nm->fix_oop_relocations();
+  ICache::invalidate_range(nm->code_begin(), nm->code_size());
+}
+
+unsigned int CompiledCodeCache::compute_config_digest() {
+  ResourceMark rm;
+  stringStream ss;
+  for (Flag* flag = Flag::flags; flag->_name != NULL; flag++) {
+    if ((flag->_flags & Flag::KIND_MANAGEABLE) != 0 ||
+        strcmp(flag->_name, "CompiledCodeCacheFile") == 0 ||
+        strcmp(flag->_name, "PrintCompiledCodeCache") == 0) {
+      continue;
+    }
+    ss.print("%s=", flag->_name);
+    if (flag->is_bool()) {
+      ss.print("%d", flag->get_bool() ? 1 : 0);
+    } else if (flag->is_intx()) {
+      ss.print(INTX_FORMAT, flag->get_intx());
+    } else if (flag->is_uintx()) {
+      ss.print(UINTX_FORMAT, flag->get_uintx());
+    } else if (flag->is_uint64_t()) {
+      ss.print(UINT64_FORMAT, flag->get_uint64_t());
+    } else if (flag->is_double()) {
+      ss.print(JLONG_FORMAT, jlong_cast(flag->get_double()));
+    } else if (flag->is_ccstr()) {
+      ss.print("%s", flag->get_ccstr() == NULL ? "" : flag->get_ccstr());
+    }
+    ss.print(";");
+  }
+  // Addresses that go into code without relocations.
+  CollectedHeap* heap = Universe::heap();
+  ss.print("heap=" INTPTR_FORMAT, p2i(heap->reserved_region().start()));
+  if (heap->barrier_set()->is_a(BarrierSet::CardTableModRef)) {
+    ss.print(" cards=" INTPTR_FORMAT, p2i(((CardTableModRefBS*)heap->barrier_set())->byte_map_base));
+  }
+  ss.print(" oops=" INTPTR_FORMAT " %d klasses=" INTPTR_FORMAT " %d",
+           p2i(Universe::narrow_oop_base()), Universe::narrow_oop_shift(),
+           p2i(Universe::narrow_klass_base()), Universe::narrow_klass_shift());
+#ifdef AMD64
+  ss.print(" cpu=%s", VM_Version::cpu_features());
+#endif
+  // The well known classes are not recorded with each entry.
+  for (int id = SystemDictionary::FIRST_WKID; id < SystemDictionary::WKID_LIMIT; id++) {
+    Klass* k = SystemDictionary::well_known_klass((SystemDictionary::WKID)id);
+    if (k != NULL && k->oop_is_instance()) {
+      ss.print(" %u/%u", InstanceKlass::cast(k)->crc32(), InstanceKlass::cast(k)->bytes_size());
+    }
+  }
+  return ClassLoader::crc32(0, ss.as_string(), (int)ss.size());
+}
+
+unsigned int CompiledCodeCache::hash(const char* holder, const char* name) {
+  unsigned int h = 0;
+  for (const char* p = holder; *p != '\0'; p++) {
+    h = 31 * h + (unsigned char)*p;
+  }
+  for (const char* p = name; *p != '\0'; p++) {
+    h = 31 * h + (unsigned char)*p;
+  }
+  return h;
+}
+
+// Called with CompiledCodeCache_lock held.
+void CompiledCodeCache::initialize() {
+  assert_lock_strong(CompiledCodeCache_lock);
+  if (_table != NULL) {
+    return;
+  }
+  _table = NEW_C_HEAP_ARRAY(CompiledCodeCacheEntry*, table_size, mtCode);
+  for (int i = 0; i < table_size; i++) {
+    _table[i] = NULL;
+  }
+  _config_digest = compute_config_digest();
+  load_file(CompiledCodeCacheFile);
+}
+
+CompiledCodeCacheEntry* CompiledCodeCache::find(const char* holder, const char* name,
+                                                const char* signature) {
+  assert_lock_strong(CompiledCodeCache_lock);
+  unsigned int h = hash(holder, name) % table_size;
+  for (CompiledCodeCacheEntry* e = _table[h]; e != NULL; e = e->_next) {
+    if (e->_valid && strcmp(e->_holder, holder) == 0 && strcmp(e->_name, name) == 0 &&
+        strcmp(e->_signature, signature) == 0) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+void CompiledCodeCache::add(CompiledCodeCacheEntry* entry) {
+  assert_lock_strong(CompiledCodeCache_lock);
+  unsigned int h = hash(entry->_holder, entry->_name) % table_size;
+  entry->_next = _table[h];
+  _table[h] = entry;
+}
+
+void CompiledCodeCache::load_file(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (file == NULL) {
+    return;
+  }
+  long length = -1;
+  if (fseek(file, 0, SEEK_END) == 0) {
+    length = ftell(file);
+    rewind(file);
+  }
+  if (length <= 0 || length > max_jint) {
+    fclose(file);
+    return;
+  }
+  u1* buffer = NEW_C_HEAP_ARRAY(u1, length, mtCode);
+  bool read = fread(buffer, 1, length, file) == (size_t)length;
+  fclose(file);
+
+  CompiledCodeReader in(buffer, (int)length);
+  bool ok = read &&
+            strcmp(in.read_string(), cache_header) == 0 &&
+            strcmp(in.read_string(), Abstract_VM_Version::internal_vm_info_string()) == 0 &&
+            (unsigned int)in.read_int() == _config_digest;
+  int entries = 0;
+  while (ok && in.ok() && !in.at_end()) {
+    const char* holder = in.read_string();
+    const char* name = in.read_string();
+    const char* signature = in.read_string();
+    unsigned int crc = (unsigned int)in.read_int();
+    int data_length = in.read_int();
+    const u1* data = in.read_bytes(data_length);
+    if (!in.ok() || (unsigned int)ClassLoader::crc32(0, (const char*)data, data_length) != crc) {
+      ok = false;
+      break;
+    }
+    add(new CompiledCodeCacheEntry(holder, name, signature, data, data_length));
+    entries++;
+  }
+  FREE_C_HEAP_ARRAY(u1, buffer, mtCode);
+  if (PrintCompiledCodeCache) {
+    if (ok) {
+      tty->print_cr("[Compiled code cache %s: %d methods]", path, entries);
+    } else {
+      tty->print_cr("[Compiled code cache %s ignored from the first bad entry on, "
+                    "it may be from a different VM or flags]", path);
+    }
+  }
+}
+
+void CompiledCodeCache::record(ciEnv* env, nmethod* nm) {
+  if (!nm->is_compiled_by_c2() || nm->is_osr_method() ||
+      nm->comp_level() != CompLevel_full_optimization || !is_usable()) {
+    return;
+  }
+  ResourceMark rm;
+  Method* method = nm->method();
+  const char* failure = NULL;
+  CompiledCodeWriter out;
+  if (env->has_runtime_constants()) {
+    failure = "value specific to this VM";
+  } else {
+    CompiledCodeRecorder recorder(nm);
+    recorder.record_klasses(env->_factory->get_ci_metadata());
+    recorder.record_code();
+    if (recorder.failure() == NULL) {
+      recorder.write_to(&out);
+    }
+    failure = recorder.failure();
+  }
+  if (PrintCompiledCodeCache) {
+    ttyLocker ttyl;
+    if (failure == NULL) {
+      tty->print_cr("[Compiled code cache recorded %s]", method->name_and_sig_as_C_string());
+    } else {
+      tty->print_cr("[Compiled code cache skipped %s: %s]", method->name_and_sig_as_C_string(), failure);
+    }
+  }
+
+  const char* holder = method->method_holder()->name()->as_C_string();
+  const char* name = method->name()->as_C_string();
+  const char* signature = method->signature()->as_C_string();
+  MutexLockerEx ml(CompiledCodeCache_lock, Mutex::_no_safepoint_check_flag);
+  initialize();
+  CompiledCodeCacheEntry* old = find(holder, name, signature);
+  if (old != NULL) {
+    // Replaced by this compilation, or stale if it could not be recorded.
+    old->_valid = false;
+  }
+  if (failure == NULL) {
+    add(new CompiledCodeCacheEntry(holder, name, signature, out.data(), out.length()));
+  }
+}
+
+bool CompiledCodeCache::load(ciEnv* env, CompileTask* task, AbstractCompiler* compiler) {
+  if (!compiler->is_c2() || task->osr_bci() != InvocationEntryBci ||
+      task->comp_level() != CompLevel_full_optimization) {
+    return false;
+  }
+  VM_ENTRY_MARK;
+  ResourceMark rm;
+  methodHandle method(THREAD, task->method());
+  if (!is_usable() ||
+      (method->is_jvmti_traced() && JvmtiExport::should_post_traced_method_events())) {
+    return false;
+  }
+  const char* holder = method->method_holder()->name()->as_C_string();
+  const char* name = method->name()->as_C_string();
+  const char* signature = method->signature()->as_C_string();
+  CompiledCodeCacheEntry* entry;
+  {
+    MutexLockerEx ml(CompiledCodeCache_lock, Mutex::_no_safepoint_check_flag);
+    initialize();
+    entry = find(holder, name, signature);
+  }
+  if (entry == NULL) {
+    return false;
+  }
+
+  CompiledCodeImage* image = new CompiledCodeImage();
+  const char* failure = image->bind(entry, method, THREAD);
+  nmethod* nm = NULL;
+  if (failure == NULL) {
+    // As in ciEnv::register_method
+    MutexLocker locker(MethodCompileQueue_lock, THREAD);
+    MutexLocker ml(Compile_lock);
+    No_Safepoint_Verifier nsv;
+
+    nm = nmethod::new_nmethod(method, task->compile_id(), &image->_layout, image,
+                              image->_oop_maps, compiler);
+    if (nm == NULL) {
+      failure = "code cache is full";
+    } else {
+      // The classes loaded in this VM must not break the assumptions
+      // the code was compiled with.
+      for (Dependencies::DepStream deps(nm); deps.next(); ) {
+        if (deps.check_dependency() != NULL) {
+          failure = "dependencies do not hold";
+          break;
+        }
+      }
+      if (failure != NULL) {
+        // Never installed, the sweeper flushes it.
+        nm->make_not_entrant();
+        nm = NULL;
+      } else {
+        task->set_code(nm);
+        if (TieredCompilation) {
+          nmethod* old = method->code();
+          if (old != NULL) {
+            old->make_not_entrant();
+          }
+        }
+        if (TraceNMethodInstalls) {
+          ttyLocker ttyl;
+          tty->print_cr("Installing cached method (%d) %s ", nm->comp_level(),
+                        method->name_and_sig_as_C_string());
+        }
+        method->set_code(method, nm);
+      }
+    }
+  }
+  if (nm != NULL) {
+    // JVMTI -- compiled method notification (must be done outside lock)
+    nm->post_compiled_method_load_event();
+  }
+  if (PrintCompiledCodeCache) {
+    ttyLocker ttyl;
+    if (failure == NULL) {
+      tty->print_cr("[Compiled code cache installed %s]", method->name_and_sig_as_C_string());
+    } else {
+      tty->print_cr("[Compiled code cache miss for %s: %s]", method->name_and_sig_as_C_string(), failure);
+    }
+  }
+  return nm != NULL;
+}
+
+static void write_bytes(FILE* file, const void* p, size_t len, bool* ok) {
+  if (*ok && fwrite(p, 1, len, file) != len) {
+    *ok = false;
+  }
+}
+
+void CompiledCodeCache::write() {
+  MutexLockerEx ml(CompiledCodeCache_lock, Mutex::_no_safepoint_check_flag);
+  if (_table == NULL) {
+    // Nothing was compiled, keep the file as it is.
+    return;
+  }
+  FILE* file = fopen(CompiledCodeCacheFile, "wb");
+  if (file == NULL) {
+    warning("Cannot write compiled code cache %s", CompiledCodeCacheFile);
+    return;
+  }
+  ResourceMark rm;
+  bool ok = true;
+  CompiledCodeWriter header;
+  header.write_string(cache_header);
+  header.write_string(Abstract_VM_Version::internal_vm_info_string());
+  header.write_int(_config_digest);
+  write_bytes(file, header.data(), header.length(), &ok);
+  for (int i = 0; i < table_size; i++) {
+    for (CompiledCodeCacheEntry* e = _table[i]; e != NULL; e = e->_next) {
+      if (!e->_valid) {
+        continue;
+      }
+      CompiledCodeWriter key;
+      key.write_string(e->_holder);
+      key.write_string(e->_name);
+      key.write_string(e->_signature);
+      key.write_int(ClassLoader::crc32(0, (const char*)e->_data, e->_length));
+      key.write_int(e->_length);
+      write_bytes(file, key.data(), key.length(), &ok);
+      write_bytes(file, e->_data, e->_length, &ok);
+    }
+  }
+  if (fclose(file) != 0 || !ok) {
+    warning("Cannot write compiled code cache %s", CompiledCodeCacheFile);
+  }
+}
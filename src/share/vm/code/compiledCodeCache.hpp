@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_CODE_COMPILEDCODECACHE_HPP
+#define SHARE_VM_CODE_COMPILEDCODECACHE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+
+class AbstractCompiler;
+class CompileTask;
+class CompiledCodeCacheEntry;
+class CompiledCodeImage;
+class ciEnv;
+class nmethod;
+
+// Section layout of a cached nmethod. Offsets are from the start of the
+// nmethod, entry points are offsets from its code begin.
+struct CompiledCodeLayout {
+  int _size;
+  int _relocation_size;
+  int _content_offset;
+  int _code_offset;
+  int _data_offset;
+  int _frame_complete_offset;
+  int _frame_size;
+  int _consts_offset;
+  int _stub_offset;
+  int _exception_offset;
+  int _deoptimize_offset;
+  int _deoptimize_mh_offset;
+  int _unwind_handler_offset;
+  int _oops_offset;
+  int _metadata_offset;
+  int _scopes_data_offset;
+  int _scopes_pcs_offset;
+  int _dependencies_offset;
+  int _handler_table_offset;
+  int _nul_chk_table_offset;
+  int _nmethod_end_offset;
+  int _orig_pc_offset;
+  int _entry_offset;
+  int _verified_entry_offset;
+  int _osr_entry_offset;
+  int _comp_level;
+  int _has_unsafe_access;
+  int _has_method_handle_invokes;
+  int _has_wide_vectors;
+};
+
+// Persistent cache of C2 nmethods (-XX:CompiledCodeCacheFile).
+//
+// When C2 installs a method, a copy of the nmethod is kept with every
+// address in it recorded symbolically:
+//  - oops are recorded as class mirrors or interned strings, metadata as
+//    classes or methods identified by name,
+//  - call and address relocations are recorded as a stub, a named code
+//    blob or an offset into libjvm.
+// Every class the compilation looked at is recorded with the CRC32 and
+// size of its class file and with whether it was initialized.
+//
+// A later run of the same VM build with the same flags installs the copy
+// instead of compiling the method if all these classes are loaded by the
+// same kind of loader from identical class files, and if the dependencies
+// of the nmethod still hold. Anything that can not be recorded exactly
+// keeps the method out of the cache and is compiled as usual.
+class CompiledCodeCache : AllStatic {
+  friend class nmethod;
+ private:
+  enum { table_size = 1031 };
+  static CompiledCodeCacheEntry** _table;
+  static unsigned int             _config_digest;
+
+  static unsigned int hash(const char* holder, const char* name);
+  static void initialize();
+  static unsigned int compute_config_digest();
+  static CompiledCodeCacheEntry* find(const char* holder, const char* name, const char* signature);
+  static void add(CompiledCodeCacheEntry* entry);
+  static void load_file(const char* path);
+
+  // Called by the nmethod constructor with the CodeCache_lock held to
+  // fill in the contents of a loaded nmethod.
+  static void copy_image_to(CompiledCodeImage* image, nmethod* nm);
+
+ public:
+  // Used when recording an nmethod.
+  static void fill_layout(nmethod* nm, CompiledCodeLayout* layout);
+
+ public:
+  static bool is_enabled() { return CompiledCodeCacheFile != NULL; }
+
+  // Record the nmethod just created for the compilation in env.
+  static void record(ciEnv* env, nmethod* nm);
+  // Install the nmethod for task from the cache. Returns false if there is
+  // no usable entry and the method has to be compiled.
+  static bool load(ciEnv* env, CompileTask* task, AbstractCompiler* compiler);
+  // Write the cache back at VM exit.
+  static void write();
+};
+
+#endif // SHARE_VM_CODE_COMPILEDCODECACHE_HPP
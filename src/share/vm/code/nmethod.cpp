@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "code/codeCache.hpp"
+#include "code/compiledCodeCache.hpp"
 #include "code/compiledIC.hpp"
 #include "code/dependencies.hpp"
 #include "code/nmethod.hpp"
@@ -480,6 +481,7 @@ void nmethod::init_defaults() {
   _has_method_handle_invokes  = 0;
   _lazy_critical_native       = 0;
   _has_wide_vectors           = 0;
+  _jwarmup_speculation        = 0;
   _marked_for_deoptimization  = 0;
   _lock_count                 = 0;
   _stack_traversal_mark       = 0;
@@ -525,7 +527,7 @@ nmethod* nmethod::new_native_nmethod(methodHandle method,
     CodeOffsets offsets;
     offsets.set_value(CodeOffsets::Verified_Entry, vep_offset);
     offsets.set_value(CodeOffsets::Frame_Complete, frame_complete);
-    nm = new (native_nmethod_size) nmethod(method(), native_nmethod_size,
+    nm = new (native_nmethod_size, CompLevel_simple) nmethod(method(), native_nmethod_size,
                                             compile_id, &offsets,
                                             code_buffer, frame_size,
                                             basic_lock_owner_sp_offset,
@@ -563,7 +565,7 @@ nmethod* nmethod::new_dtrace_nmethod(methodHandle method,
     offsets.set_value(CodeOffsets::Dtrace_trap, trap_offset);
     offsets.set_value(CodeOffsets::Frame_Complete, frame_complete);
 
-    nm = new (nmethod_size) nmethod(method(), nmethod_size,
+    nm = new (nmethod_size, CompLevel_simple) nmethod(method(), nmethod_size,
                                     &offsets, code_buffer, frame_size);
 
     NOT_PRODUCT(if (nm != NULL)  nmethod_stats.note_nmethod(nm));
@@ -611,7 +613,7 @@ nmethod* nmethod::new_nmethod(methodHandle method,
       + round_to(nul_chk_table->size_in_bytes(), oopSize)
       + round_to(debug_info->data_size()       , oopSize);
 
-    nm = new (nmethod_size)
+    nm = new (nmethod_size, comp_level)
     nmethod(method(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
             oop_maps,
@@ -652,7 +654,46 @@ nmethod* nmethod::new_nmethod(methodHandle method,
   }
   if (CompilationWarmUpRecording && nm != NULL && comp_level >= CompilationWarmUpRecordMinLevel) {
     int bci = nm->is_osr_method() ? nm->osr_entry_bci() : InvocationEntryBci;
-    JitWarmUp::instance()->recorder()->add_method(nm->method(), bci);
+    JitWarmUp::instance()->recorder()->add_method(nm->method(), bci, comp_level);
+  }
+  return nm;
+}
+
+
+nmethod* nmethod::new_nmethod(methodHandle method,
+  int compile_id,
+  const CompiledCodeLayout* layout,
+  CompiledCodeImage* image,
+  OopMapSet* oop_maps,
+  AbstractCompiler* compiler
+)
+{
+  // create nmethod
+  nmethod* nm = NULL;
+  { MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    nm = new (layout->_size, layout->_comp_level)
+    nmethod(method(), compile_id, layout, image, oop_maps, compiler);
+
+    if (nm != NULL) {
+      // Record the nmethod dependencies in the classes it is dependent on,
+      // as for a compiled nmethod above.
+      for (Dependencies::DepStream deps(nm); deps.next(); ) {
+        Klass* klass = deps.context_type();
+        if (klass == NULL) {
+          continue;  // ignore things like evol_method
+        }
+        InstanceKlass::cast(klass)->add_dependent_nmethod(nm);
+      }
+      NOT_PRODUCT(nmethod_stats.note_nmethod(nm));
+      if (PrintAssembly || CompilerOracle::has_option_string(method, "PrintAssembly")) {
+        Disassembler::decode(nm);
+      }
+    }
+  }
+  if (nm != NULL) {
+    // Safepoints in nmethod::verify aren't allowed because nm hasn't been installed yet.
+    DEBUG_ONLY(nm->verify();)
+    nm->log_new_nmethod();
   }
   return nm;
 }
@@ -832,9 +873,9 @@ nmethod::nmethod(
 }
 #endif // def HAVE_DTRACE_H
 
-void* nmethod::operator new(size_t size, int nmethod_size) throw() {
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw() {
   // Not critical, may return null if there is too little continuous memory
-  return CodeCache::allocate(nmethod_size);
+  return CodeCache::allocate(nmethod_size, false, CodeCache::get_code_blob_type(comp_level));
 }
 
 nmethod::nmethod(
@@ -943,6 +984,82 @@ nmethod::nmethod(
 }
 
 
+nmethod::nmethod(
+  Method* method,
+  int compile_id,
+  const CompiledCodeLayout* layout,
+  CompiledCodeImage* image,
+  OopMapSet* oop_maps,
+  AbstractCompiler* compiler
+  )
+  : CodeBlob("nmethod", sizeof(nmethod), layout->_size, layout->_relocation_size,
+             layout->_code_offset, layout->_data_offset,
+             layout->_frame_complete_offset, layout->_frame_size, oop_maps),
+  _native_receiver_sp_offset(in_ByteSize(-1)),
+  _native_basic_lock_sp_offset(in_ByteSize(-1))
+{
+  assert(content_offset() == layout->_content_offset, "layout must match this VM");
+  {
+    debug_only(No_Safepoint_Verifier nsv;)
+    assert_locked_or_safepoint(CodeCache_lock);
+
+    init_defaults();
+    _method                  = method;
+    _entry_bci               = InvocationEntryBci;
+    _compile_id              = compile_id;
+    _comp_level              = layout->_comp_level;
+    _compiler                = compiler;
+    _orig_pc_offset          = layout->_orig_pc_offset;
+    _hotness_counter         = NMethodSweeper::hotness_counter_reset_val();
+
+    _consts_offset           = layout->_consts_offset;
+    _stub_offset             = layout->_stub_offset;
+    _exception_offset        = layout->_exception_offset;
+    _deoptimize_offset       = layout->_deoptimize_offset;
+    _deoptimize_mh_offset    = layout->_deoptimize_mh_offset;
+    _unwind_handler_offset   = layout->_unwind_handler_offset;
+    _oops_offset             = layout->_oops_offset;
+    _metadata_offset         = layout->_metadata_offset;
+    _scopes_data_offset      = layout->_scopes_data_offset;
+    _scopes_pcs_offset       = layout->_scopes_pcs_offset;
+    _dependencies_offset     = layout->_dependencies_offset;
+    _handler_table_offset    = layout->_handler_table_offset;
+    _nul_chk_table_offset    = layout->_nul_chk_table_offset;
+    _nmethod_end_offset      = layout->_nmethod_end_offset;
+
+    _entry_point             = code_begin()          + layout->_entry_offset;
+    _verified_entry_point    = code_begin()          + layout->_verified_entry_offset;
+    _osr_entry_point         = code_begin()          + layout->_osr_entry_offset;
+    _exception_cache         = NULL;
+    _pc_desc_cache.reset_to(scopes_pcs_begin());
+
+    _has_unsafe_access          = layout->_has_unsafe_access;
+    _has_method_handle_invokes  = layout->_has_method_handle_invokes;
+    _has_wide_vectors           = layout->_has_wide_vectors;
+
+    // Copy code, relocations and debug info, fill in the oops and
+    // metadata and bind the relocations to this VM.
+    CompiledCodeCache::copy_image_to(image, this);
+    if (ScavengeRootsInCode) {
+      if (detect_scavenge_root_oops()) {
+        CodeCache::add_scavenge_root_nmethod(this);
+      }
+      Universe::heap()->register_nmethod(this);
+    }
+    debug_only(verify_scavenge_root_oops());
+
+    CodeCache::commit(this);
+  }
+
+  bool printnmethods = PrintNMethods
+    || CompilerOracle::should_print(_method)
+    || CompilerOracle::has_option_string(_method, "PrintNMethods");
+  if (printnmethods || PrintDebugInfo || PrintRelocations || PrintDependencies || PrintExceptionHandlers) {
+    print_nmethod(printnmethods);
+  }
+}
+
+
 // Print a short set of xml attributes to identify this nmethod.  The
 // output should be embedded in some other element.
 void nmethod::log_identity(xmlStream* log) const {
@@ -110,12 +110,15 @@ class Dependencies;
 class ExceptionHandlerTable;
 class ImplicitExceptionTable;
 class AbstractCompiler;
+class CompiledCodeImage;
+struct CompiledCodeLayout;
 class xmlStream;
 
 class nmethod : public CodeBlob {
   friend class VMStructs;
   friend class NMethodSweeper;
   friend class CodeCache;  // scavengable oops
+  friend class CompiledCodeCache;
  private:
 
   // GC support to help figure out if an nmethod has been
@@ -193,6 +196,7 @@ class nmethod : public CodeBlob {
   unsigned int _has_method_handle_invokes:1; // Has this method MethodHandle invokes?
   unsigned int _lazy_critical_native:1;      // Lazy JNI critical native
   unsigned int _has_wide_vectors:1;          // Preserve wide vectors at safepoints
+  unsigned int _jwarmup_speculation:1;       // JWarmUp compilation speculating on a restored profile
 
   // Protected by Patching_lock
   volatile unsigned char _state;             // {alive, not_entrant, zombie, unloaded}
@@ -295,8 +299,16 @@ class nmethod : public CodeBlob {
           AbstractCompiler* compiler,
           int comp_level);
 
+  // For code from the compiled code cache
+  nmethod(Method* method,
+          int compile_id,
+          const CompiledCodeLayout* layout,
+          CompiledCodeImage* image,
+          OopMapSet* oop_maps,
+          AbstractCompiler* compiler);
+
   // helper methods
-  void* operator new(size_t size, int nmethod_size) throw();
+  void* operator new(size_t size, int nmethod_size, int comp_level) throw();
 
   const char* reloc_string_for(u_char* begin, u_char* end);
   // Returns true if this thread changed the state of the nmethod or
@@ -331,6 +343,14 @@ class nmethod : public CodeBlob {
                               AbstractCompiler* compiler,
                               int comp_level);
 
+  // create nmethod from an image in the compiled code cache
+  static nmethod* new_nmethod(methodHandle method,
+                              int compile_id,
+                              const CompiledCodeLayout* layout,
+                              CompiledCodeImage* image,
+                              OopMapSet* oop_maps,
+                              AbstractCompiler* compiler);
+
   static nmethod* new_native_nmethod(methodHandle method,
                                      int compile_id,
                                      CodeBuffer *code_buffer,
@@ -496,6 +516,9 @@ class nmethod : public CodeBlob {
   bool  has_wide_vectors() const                  { return _has_wide_vectors; }
   void  set_has_wide_vectors(bool z)              { _has_wide_vectors = z; }
 
+  bool  is_jwarmup_speculation() const            { return _jwarmup_speculation; }
+  void  set_jwarmup_speculation(bool z)           { _jwarmup_speculation = z; }
+
   int   comp_level() const                        { return _comp_level; }
 
   // Support for oops in scopes and relocs:
@@ -26,6 +26,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
+#include "code/compiledCodeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileLog.hpp"
 #include "compiler/compilerOracle.hpp"
@@ -36,7 +37,9 @@
 #include "oops/method.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/nativeLookup.hpp"
+#include "runtime/activeProcessorTracker.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/codeCacheSweeperThread.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/init.hpp"
 #include "runtime/interfaceSupport.hpp"
@@ -182,11 +185,18 @@ int CompileBroker::_sum_nmethod_size             = 0;
 int CompileBroker::_sum_nmethod_code_size        = 0;
 
 long CompileBroker::_peak_compilation_time       = 0;
+size_t CompileBroker::_peak_arena_usage          = 0;
+int CompileBroker::_peak_arena_usage_id          = 0;
 
 CompileQueue* CompileBroker::_c2_compile_queue   = NULL;
 CompileQueue* CompileBroker::_c1_compile_queue   = NULL;
 
-GrowableArray<CompilerThread*>* CompileBroker::_compiler_threads = NULL;
+int CompileBroker::_c2_count = 0;
+int CompileBroker::_c1_count = 0;
+jobject* CompileBroker::_compiler2_objects = NULL;
+jobject* CompileBroker::_compiler1_objects = NULL;
+CompilerCounters** CompileBroker::_compiler2_counters = NULL;
+CompilerCounters** CompileBroker::_compiler1_counters = NULL;
 
 
 class CompilationLog : public StringEventLog {
@@ -332,6 +342,7 @@ void CompileTask::initialize(int compile_id,
   _failure_reason = NULL;
 
   _is_jwarmup_compilation = false;
+  _is_jwarmup_speculation = false;
 
   if (LogCompilation) {
     _time_queued = os::elapsed_counter();
@@ -699,7 +710,7 @@ void CompileQueue::free_all() {
 //
 // Get the next CompileTask from a CompileQueue
 CompileTask* CompileQueue::get() {
-  NMethodSweeper::possibly_sweep();
+  NMethodSweeper::notify();
 
   MutexLocker locker(lock());
   // If _first is NULL we have no more compile jobs. There are two reasons for
@@ -728,7 +739,7 @@ CompileTask* CompileQueue::get() {
       bool timeout = lock()->wait(!Mutex::_no_safepoint_check_flag, wait_time);
       if (timeout) {
         MutexUnlocker ul(lock());
-        NMethodSweeper::possibly_sweep();
+        NMethodSweeper::notify();
       }
     } else {
       // If there are no compilation tasks and we can compile new jobs
@@ -741,6 +752,13 @@ CompileTask* CompileQueue::get() {
       // is disabled forever. We use 5 seconds wait time; the exiting of compiler threads
       // is not critical and we do not want idle compiler threads to wake up too often.
       lock()->wait(!Mutex::_no_safepoint_check_flag, 5*1000);
+
+      if (UseDynamicNumberOfCompilerThreads && _first == NULL) {
+        // Still nothing to compile. Give the caller a chance to stop this thread.
+        if (CompileBroker::can_remove(CompilerThread::current(), false)) {
+          return NULL;
+        }
+      }
     }
   }
 
@@ -915,6 +933,9 @@ void CompileBroker::compilation_init() {
 
   // Start the CompilerThreads
   init_compiler_threads(c1_count, c2_count);
+  if (UseCodeCacheSweeperThread && MethodFlushing) {
+    CodeCacheSweeperThread::initialize();
+  }
   // totalTime performance counter is always created as it is required
   // by the implementation of java.lang.management.CompilationMBean.
   {
@@ -1018,16 +1039,19 @@ void CompileBroker::compilation_init() {
 }
 
 
-CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters,
-                                                    AbstractCompiler* comp, TRAPS) {
-  CompilerThread* compiler_thread = NULL;
-
+/**
+ * Create the java.lang.Thread object of a compiler thread in the system
+ * thread group. The object is kept in a global handle so that a compiler
+ * thread which is started later (or restarted) does not need to run Java
+ * code to get one.
+ */
+jobject CompileBroker::create_thread_oop(const char* name, TRAPS) {
   Klass* k =
     SystemDictionary::resolve_or_fail(vmSymbols::java_lang_Thread(),
-                                      true, CHECK_0);
+                                      true, CHECK_NULL);
   instanceKlassHandle klass (THREAD, k);
-  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_0);
-  Handle string = java_lang_String::create_from_str(name, CHECK_0);
+  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_NULL);
+  Handle string = java_lang_String::create_from_str(name, CHECK_NULL);
 
   // Initialize thread_oop to put it into the system threadGroup
   Handle thread_group (THREAD,  Universe::system_thread_group());
@@ -1038,7 +1062,16 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
                        vmSymbols::threadgroup_string_void_signature(),
                        thread_group,
                        string,
-                       CHECK_0);
+                       CHECK_NULL);
+
+  return JNIHandles::make_global(thread_oop);
+}
+
+
+CompilerThread* CompileBroker::make_compiler_thread(jobject thread_handle, CompileQueue* queue, CompilerCounters* counters,
+                                                    AbstractCompiler* comp, TRAPS) {
+  CompilerThread* compiler_thread = NULL;
+  Handle thread_oop(THREAD, JNIHandles::resolve_non_null(thread_handle));
 
   {
     MutexLocker mu(Threads_lock, THREAD);
@@ -1055,12 +1088,26 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
     // in that case. However, since this must work and we do not allow
     // exceptions anyway, check and abort if this fails.
 
+    // An additional dynamic compiler thread is optional though: if at least
+    // one thread of this compiler is running, just do without the new one.
+
     if (compiler_thread == NULL || compiler_thread->osthread() == NULL){
+      if (UseDynamicNumberOfCompilerThreads && comp->num_compiler_threads() > 0) {
+        if (compiler_thread != NULL) {
+          delete compiler_thread;
+        }
+        if (TraceCompilerThreads) {
+          tty->print_cr("Failed to start additional compiler thread (unable to create new native thread)");
+        }
+        return NULL;
+      }
       vm_exit_during_initialization("java.lang.OutOfMemoryError",
                                     "unable to create new native thread");
     }
 
     java_lang_Thread::set_thread(thread_oop(), compiler_thread);
+    // A restarted thread reuses the object of a terminated one
+    java_lang_Thread::set_thread_status(thread_oop(), java_lang_Thread::RUNNABLE);
 
     // Note that this only sets the JavaThread _priority field, which by
     // definition is limited to Java priorities and not OS priorities.
@@ -1115,26 +1162,48 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
 
   int compiler_count = c1_compiler_count + c2_compiler_count;
 
-  _compiler_threads =
-    new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<CompilerThread*>(compiler_count, true);
-
+  _c2_count = c2_compiler_count;
+  _c1_count = c1_compiler_count;
+  _compiler2_objects  = NEW_C_HEAP_ARRAY(jobject, c2_compiler_count, mtCompiler);
+  _compiler1_objects  = NEW_C_HEAP_ARRAY(jobject, c1_compiler_count, mtCompiler);
+  _compiler2_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, c2_compiler_count, mtCompiler);
+  _compiler1_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, c1_compiler_count, mtCompiler);
+
+  // With UseDynamicNumberOfCompilerThreads only the first thread of each
+  // compiler is started here; the others are started on demand by
+  // possibly_add_compiler_threads(). Their thread objects and counters are
+  // still created up front, so that starting them needs no Java code.
   char name_buffer[256];
   for (int i = 0; i < c2_compiler_count; i++) {
     // Create a name for our thread.
     sprintf(name_buffer, "C2 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
-    // Shark and C2
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c2_compile_queue, counters, _compilers[1], CHECK);
-    _compiler_threads->append(new_thread);
+    _compiler2_objects[i] = create_thread_oop(name_buffer, CHECK);
+    _compiler2_counters[i] = new CompilerCounters("compilerThread", i, CHECK);
+    if (!UseDynamicNumberOfCompilerThreads || i == 0) {
+      // Shark and C2
+      make_compiler_thread(_compiler2_objects[i], _c2_compile_queue, _compiler2_counters[i], _compilers[1], CHECK);
+    }
   }
 
-  for (int i = c2_compiler_count; i < compiler_count; i++) {
+  for (int i = 0; i < c1_compiler_count; i++) {
     // Create a name for our thread.
-    sprintf(name_buffer, "C1 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
-    // C1
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c1_compile_queue, counters, _compilers[0], CHECK);
-    _compiler_threads->append(new_thread);
+    int id = c2_compiler_count + i;
+    sprintf(name_buffer, "C1 CompilerThread%d", id);
+    _compiler1_objects[i] = create_thread_oop(name_buffer, CHECK);
+    _compiler1_counters[i] = new CompilerCounters("compilerThread", id, CHECK);
+    if (!UseDynamicNumberOfCompilerThreads || i == 0) {
+      // C1
+      make_compiler_thread(_compiler1_objects[i], _c1_compile_queue, _compiler1_counters[i], _compilers[0], CHECK);
+    }
+  }
+
+  if (UseDynamicNumberOfCompilerThreads) {
+    if (c2_compiler_count > 0) {
+      _compilers[1]->set_num_compiler_threads(1);
+    }
+    if (c1_compiler_count > 0) {
+      _compilers[0]->set_num_compiler_threads(1);
+    }
   }
 
   if (UsePerfData) {
@@ -1143,6 +1212,107 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
 }
 
 
+/**
+ * Start additional compiler threads if the compile queues are long enough.
+ * The number of threads is bounded by the available physical memory and
+ * by the free space in the code cache, since every running compilation
+ * needs both. Called by compiler threads after they took a task.
+ */
+void CompileBroker::possibly_add_compiler_threads() {
+  EXCEPTION_MARK;
+
+  julong available_memory = os::available_memory();
+  size_t available_cc = CodeCache::unallocated_capacity();
+
+  // Only attempt to start additional threads if the lock is free.
+  if (!CompileThread_lock->try_lock()) return;
+
+  if (_c2_compile_queue != NULL) {
+    int old_c2_count = _compilers[1]->num_compiler_threads();
+    int new_c2_count = MIN4(_c2_count,
+        _c2_compile_queue->size() / 2,
+        (int)(available_memory / (200*M)),
+        (int)(available_cc / (128*K)));
+    if (ActiveProcessorTracker::is_engaged()) {
+      new_c2_count = MIN2(new_c2_count, ActiveProcessorTracker::compiler_thread_limit(false));
+    }
+
+    for (int i = old_c2_count; i < new_c2_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler2_objects[i], _c2_compile_queue,
+                                                _compiler2_counters[i], _compilers[1], THREAD);
+      if (ct == NULL) break;
+      _compilers[1]->set_num_compiler_threads(i + 1);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB, available code cache: " SIZE_FORMAT "MB)",
+                      ct->get_thread_name(), available_memory / M, available_cc / M);
+      }
+    }
+  }
+
+  if (_c1_compile_queue != NULL) {
+    int old_c1_count = _compilers[0]->num_compiler_threads();
+    int new_c1_count = MIN4(_c1_count,
+        _c1_compile_queue->size() / 4,
+        (int)(available_memory / (100*M)),
+        (int)(available_cc / (128*K)));
+    if (ActiveProcessorTracker::is_engaged()) {
+      new_c1_count = MIN2(new_c1_count, ActiveProcessorTracker::compiler_thread_limit(true));
+    }
+
+    for (int i = old_c1_count; i < new_c1_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler1_objects[i], _c1_compile_queue,
+                                                _compiler1_counters[i], _compilers[0], THREAD);
+      if (ct == NULL) break;
+      _compilers[0]->set_num_compiler_threads(i + 1);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB, available code cache: " SIZE_FORMAT "MB)",
+                      ct->get_thread_name(), available_memory / M, available_cc / M);
+      }
+    }
+  }
+
+  CompileThread_lock->unlock();
+}
+
+
+/**
+ * Decide whether an idle compiler thread may exit. At least one thread of
+ * each compiler is kept, and since threads are started in index order only
+ * the thread with the highest index may go away, after a minimum idle time.
+ */
+bool CompileBroker::can_remove(CompilerThread* ct, bool do_it) {
+  assert(UseDynamicNumberOfCompilerThreads, "or shouldn't be here");
+  if (!ReduceNumberOfCompilerThreads) return false;
+
+  AbstractCompiler* compiler = ct->compiler();
+  int compiler_count = compiler->num_compiler_threads();
+  bool c1 = compiler->is_c1();
+
+  // Keep at least 1 compiler thread of each type.
+  if (compiler_count < 2) return false;
+
+  // Keep thread alive for at least some time, unless the processor
+  // count has dropped below what the running threads need.
+  bool above_limit = ActiveProcessorTracker::is_engaged() &&
+                     compiler_count > ActiveProcessorTracker::compiler_thread_limit(c1);
+  if (!above_limit && ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+
+  // We only allow the last compiler thread of each type (c1 or c2) to terminate.
+  jobject last_compiler = c1 ? _compiler1_objects[compiler_count - 1]
+                             : _compiler2_objects[compiler_count - 1];
+  if (ct->threadObj() == JNIHandles::resolve_non_null(last_compiler)) {
+    if (do_it) {
+      assert_locked_or_safepoint(CompileThread_lock); // Update must be consistent.
+      compiler->set_num_compiler_threads(compiler_count - 1);
+    }
+    return true;
+  }
+  return false;
+}
+
+
 /**
  * Set the methods on the stack as on_stack so that redefine classes doesn't
  * reclaim them. This method is executed at a safepoint.
@@ -1598,6 +1768,10 @@ CompileTask* CompileBroker::create_compile_task(CompileQueue* queue,
                        blocking);
   if (strcmp(comment, "JitWarmUp") == 0) {
     new_task->mark_jwarmup_compilation();
+    if (CompilationWarmUpSpeculation && CompilationWarmUpRecordMethodData &&
+        method->jwarmup_speculation_failures() < CompilationWarmUpSpeculationFailureLimit) {
+      new_task->mark_jwarmup_speculation();
+    }
   }
   queue->add(new_task);
   return new_task;
@@ -1796,9 +1970,31 @@ void CompileBroker::compiler_thread_loop() {
 
     CompileTask* task = queue->get();
     if (task == NULL) {
+      if (UseDynamicNumberOfCompilerThreads) {
+        // Access the compiler thread count under lock to keep it consistent.
+        MutexLocker only_one(CompileThread_lock, thread);
+        if (can_remove(thread, true)) {
+          if (TraceCompilerThreads) {
+            tty->print_cr("Removing compiler thread %s after " JLONG_FORMAT " ms idle time",
+                          thread->name(), thread->idle_time_millis());
+          }
+          // Free buffer blob, if allocated. Returning ends the thread, which
+          // also releases its resource area.
+          if (thread->get_buffer_blob() != NULL) {
+            MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+            CodeCache::free(thread->get_buffer_blob());
+            thread->set_buffer_blob(NULL);
+          }
+          return; // Stop this thread.
+        }
+      }
       continue;
     }
 
+    if (UseDynamicNumberOfCompilerThreads) {
+      possibly_add_compiler_threads();
+    }
+
     // Give compiler threads an extra quanta.  They tend to be bursty and
     // this helps the compiler to finish up the job.
     if( CompilerThreadHintNoPreempt )
@@ -1820,6 +2016,7 @@ void CompileBroker::compiler_thread_loop() {
       // Compile the method.
       if ((UseCompiler || AlwaysCompileLoopMethods) && CompileBroker::should_compile_new_jobs()) {
         invoke_compiler_on_method(task);
+        thread->idle_time_reset();
       } else {
         // After compilation is disabled, remove remaining methods from queue
         method->clear_queued_for_compilation();
@@ -2011,11 +2208,22 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     EventCompilation event;
 
     AbstractCompiler *comp = compiler(task_level);
+    thread->begin_arena_accounting();
     if (comp == NULL) {
       ci_env.record_method_not_compilable("no compiler", !TieredCompilation);
+    } else if (CompiledCodeCache::is_enabled() && CompiledCodeCache::load(&ci_env, task, comp)) {
+      // Installed the code of an earlier run.
     } else {
       comp->compile_method(&ci_env, target, osr_bci);
     }
+    thread->set_arena_limit(0);
+
+    if (ci_env.log() != NULL) {
+      ci_env.log()->elem("arena_usage peak='" SIZE_FORMAT "'", thread->arena_peak());
+    }
+    if (PrintCompilerArenaUsage) {
+      task->print_compilation(tty, err_msg_res("arena peak " SIZE_FORMAT "K", thread->arena_peak() / K));
+    }
 
     if (!ci_env.failing() && task->code() == NULL) {
       //assert(false, "compiler should always document failure");
@@ -2167,7 +2375,7 @@ void CompileBroker::handle_full_code_cache() {
       // Switch to 'vm_state'. This ensures that possibly_sweep() can be called
       // without having to consider the state in which the current thread is.
       ThreadInVMfromUnknown in_vm;
-      NMethodSweeper::possibly_sweep();
+      NMethodSweeper::notify();
     } else {
       disable_compilation_forever();
     }
@@ -2297,6 +2505,12 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
   assert(code == NULL || code->is_locked_by_vm(), "will survive the MutexLocker");
   MutexLocker locker(CompileStatistics_lock);
 
+  // Largest compiler arena footprint of a single compilation, reported by NMT
+  if (thread->arena_peak() > _peak_arena_usage) {
+    _peak_arena_usage = thread->arena_peak();
+    _peak_arena_usage_id = compile_id;
+  }
+
   // _perf variables are production performance counters which are
   // updated regardless of the setting of the CITime and CITimeEach flags
   //
@@ -66,6 +66,7 @@ class CompileTask : public CHeapObj<mtCompiler> {
   const char*  _comment;      // more info about the task
   const char*  _failure_reason;
   bool         _is_jwarmup_compilation;
+  bool         _is_jwarmup_speculation; // may speculate on the restored profile
 
  public:
   CompileTask() {
@@ -87,6 +88,8 @@ class CompileTask : public CHeapObj<mtCompiler> {
   bool         is_success() const                { return _is_success; }
   bool         is_jwarmup_compilation() const    { return _is_jwarmup_compilation; }
   void         mark_jwarmup_compilation()        { _is_jwarmup_compilation = true; }
+  bool         is_jwarmup_speculation() const    { return _is_jwarmup_speculation; }
+  void         mark_jwarmup_speculation()        { _is_jwarmup_speculation = true; }
 
   nmethodLocker* code_handle() const             { return _code_handle; }
   void         set_code_handle(nmethodLocker* l) { _code_handle = l; }
@@ -294,7 +297,13 @@ class CompileBroker: AllStatic {
   static CompileQueue* _c2_compile_queue;
   static CompileQueue* _c1_compile_queue;
 
-  static GrowableArray<CompilerThread*>* _compiler_threads;
+  // Thread objects and counters for all compiler threads that may ever be
+  // started; with UseDynamicNumberOfCompilerThreads only a prefix is running.
+  static int _c2_count, _c1_count;
+  static jobject* _compiler2_objects;
+  static jobject* _compiler1_objects;
+  static CompilerCounters** _compiler2_counters;
+  static CompilerCounters** _compiler1_counters;
 
   // performance counters
   static PerfCounter* _perf_total_compilation;
@@ -338,11 +347,15 @@ class CompileBroker: AllStatic {
   static int _sum_nmethod_size;
   static int _sum_nmethod_code_size;
   static long _peak_compilation_time;
+  static size_t _peak_arena_usage;
+  static int _peak_arena_usage_id;
 
   static volatile jint _print_compilation_warning;
 
-  static CompilerThread* make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, TRAPS);
+  static jobject create_thread_oop(const char* name, TRAPS);
+  static CompilerThread* make_compiler_thread(jobject thread_oop, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, TRAPS);
   static void init_compiler_threads(int c1_compiler_count, int c2_compiler_count);
+  static void possibly_add_compiler_threads();
   static bool compilation_is_prohibited(methodHandle method, int osr_bci, int comp_level);
   static bool is_compile_blocking      ();
   static void preload_classes          (methodHandle method, TRAPS);
@@ -408,6 +421,9 @@ class CompileBroker: AllStatic {
                                  const char* comment, Thread* thread);
 
   static void compiler_thread_loop();
+  // Can the given idle compiler thread exit? If do_it is set, the thread
+  // count of its compiler is decremented (caller holds CompileThread_lock).
+  static bool can_remove(CompilerThread* ct, bool do_it);
   static uint get_compilation_id() { return _compilation_id; }
 
   // Set _should_block.
@@ -477,6 +493,8 @@ class CompileBroker: AllStatic {
   static int get_sum_nmethod_code_size() {        return _sum_nmethod_code_size; }
   static long get_peak_compilation_time() {       return _peak_compilation_time; }
   static long get_total_compilation_time() {      return _t_total_compilation.milliseconds(); }
+  static size_t get_peak_arena_usage() {          return _peak_arena_usage; }
+  static int get_peak_arena_usage_id() {          return _peak_arena_usage_id; }
 };
 
 #endif // SHARE_VM_COMPILER_COMPILEBROKER_HPP
@@ -32,10 +32,12 @@
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/blockOffsetTable.inline.hpp"
+#include "memory/genCollectedHeap.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/space.inline.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
@@ -43,6 +45,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/copy.hpp"
+#include "utilities/workgroup.hpp"
 
 /////////////////////////////////////////////////////////////////////////
 //// CompactibleFreeListSpace
@@ -163,6 +166,12 @@ CompactibleFreeListSpace::CompactibleFreeListSpace(BlockOffsetSharedArray* bs,
   }
 
   _used_stable = 0;
+
+  _compaction_stripes = NULL;
+  _compaction_stripe_count = 0;
+  _compaction_stripe_words = 0;
+  _next_compaction_stripe = NULL;
+  _compaction_stripe_done = NULL;
 }
 
 // Like CompactibleSpace forward() but always calls cross_threshold() to
@@ -171,6 +180,9 @@ CompactibleFreeListSpace::CompactibleFreeListSpace(BlockOffsetSharedArray* bs,
 HeapWord* CompactibleFreeListSpace::forward(oop q, size_t size,
                                     CompactPoint* cp, HeapWord* compact_top) {
   // q is alive
+  if (_compaction_stripes != NULL) {
+    note_compaction_stripe((HeapWord*)q);
+  }
   // First check if we should switch compaction space
   assert(this == cp->space, "'this' should be current compaction space.");
   size_t compaction_max_size = pointer_delta(end(), compact_top);
@@ -2114,6 +2126,7 @@ bool CompactibleFreeListSpace::should_concurrent_collect() const {
 // Support for compaction
 
 void CompactibleFreeListSpace::prepare_for_compaction(CompactPoint* cp) {
+  setup_compaction_stripes();
   SCAN_AND_FORWARD(cp,end,block_is_obj,block_size);
   // prepare_for_compaction() uses the space between live objects
   // so that later phase can skip dead space quickly.  So verification
@@ -2123,6 +2136,190 @@ void CompactibleFreeListSpace::prepare_for_compaction(CompactPoint* cp) {
 #define obj_size(q) adjustObjectSize(oop(q)->size())
 #define adjust_obj_size(s) adjustObjectSize(s)
 
+class CFLSParAdjustPointersTask : public AbstractGangTask {
+  CompactibleFreeListSpace* _space;
+  volatile jint             _next_stripe;
+ public:
+  CFLSParAdjustPointersTask(CompactibleFreeListSpace* space) :
+    AbstractGangTask("CMS parallel adjust pointers"),
+    _space(space), _next_stripe(0) { }
+
+  void work(uint worker_id) {
+    jint count = (jint)_space->compaction_stripe_count();
+    jint i;
+    while ((i = Atomic::add(1, &_next_stripe) - 1) < count) {
+      _space->adjust_pointers_in_stripe((size_t)i);
+    }
+  }
+};
+
+// Stripes are claimed in address order.  Before copying its objects a
+// stripe waits for the lower stripes that overlap its destination to be
+// done, because those still have to read their objects from there.  The
+// lowest unfinished stripe never waits, so the scheme cannot deadlock.
+class CFLSParCompactTask : public AbstractGangTask {
+  CompactibleFreeListSpace* _space;
+  volatile jint             _next_stripe;
+ public:
+  CFLSParCompactTask(CompactibleFreeListSpace* space) :
+    AbstractGangTask("CMS parallel compact"),
+    _space(space), _next_stripe(0) { }
+
+  void work(uint worker_id) {
+    jint count = (jint)_space->compaction_stripe_count();
+    jint i;
+    while ((i = Atomic::add(1, &_next_stripe) - 1) < count) {
+      size_t stripe = (size_t)i;
+      for (size_t j = _space->first_overlapped_compaction_stripe(stripe); j < stripe; j++) {
+        while (!_space->is_compaction_stripe_done(j)) {
+          SpinPause();
+        }
+      }
+      _space->compact_stripe(stripe);
+      _space->set_compaction_stripe_done(stripe);
+    }
+  }
+};
+
+void CompactibleFreeListSpace::setup_compaction_stripes() {
+  release_compaction_stripes();
+  FlexibleWorkGang* workers = GenCollectedHeap::heap()->workers();
+  if (!CMSParallelFullGC || workers == NULL || workers->active_workers() <= 1) {
+    return;
+  }
+  size_t stripes = (size_t)workers->active_workers() * CompactionStripesPerThread;
+  _compaction_stripe_words = MAX2(capacity() / HeapWordSize / stripes,
+                                  (size_t)MinCompactionStripeWords);
+  // Stripe starts are at least _compaction_stripe_words apart.
+  size_t max_stripes = pointer_delta(end(), bottom()) / _compaction_stripe_words + 1;
+  _compaction_stripes = NEW_C_HEAP_ARRAY_RETURN_NULL(HeapWord*, max_stripes, mtGC);
+  _compaction_stripe_done = NEW_C_HEAP_ARRAY_RETURN_NULL(jint, max_stripes, mtGC);
+  if (_compaction_stripes == NULL || _compaction_stripe_done == NULL) {
+    // Fall back to the serial compaction.
+    release_compaction_stripes();
+    return;
+  }
+  memset((void*)_compaction_stripe_done, 0, max_stripes * sizeof(jint));
+  _compaction_stripe_count = 0;
+  _next_compaction_stripe = bottom();
+}
+
+void CompactibleFreeListSpace::release_compaction_stripes() {
+  if (_compaction_stripes != NULL) {
+    FREE_C_HEAP_ARRAY(HeapWord*, _compaction_stripes, mtGC);
+  }
+  if (_compaction_stripe_done != NULL) {
+    FREE_C_HEAP_ARRAY(jint, _compaction_stripe_done, mtGC);
+  }
+  _compaction_stripes = NULL;
+  _compaction_stripe_done = NULL;
+  _compaction_stripe_count = 0;
+  _next_compaction_stripe = NULL;
+}
+
+bool CompactibleFreeListSpace::is_compaction_stripe_done(size_t i) const {
+  return OrderAccess::load_acquire(&_compaction_stripe_done[i]) != 0;
+}
+
+void CompactibleFreeListSpace::set_compaction_stripe_done(size_t i) {
+  OrderAccess::release_store(&_compaction_stripe_done[i], 1);
+}
+
+size_t CompactibleFreeListSpace::first_overlapped_compaction_stripe(size_t i) const {
+  HeapWord* q = _compaction_stripes[i];
+  if (q < _first_dead) {
+    // Nothing below _first_dead moves, so this stripe only writes above
+    // its own start.
+    return i;
+  }
+  HeapWord* dest = (HeapWord*)oop(q)->forwardee();
+  if (dest < bottom() || dest >= end()) {
+    // Spilled into another space, which is compacted after this one.
+    return i;
+  }
+  // Binary search for the last stripe starting at or below dest.
+  size_t lo = 0;
+  size_t hi = i;
+  while (lo < hi) {
+    size_t mid = (lo + hi + 1) / 2;
+    if (_compaction_stripes[mid] <= dest) {
+      lo = mid;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return lo;
+}
+
+// The per-stripe walks below follow SCAN_AND_ADJUST_POINTERS and
+// SCAN_AND_COMPACT.  A stripe starts and ends at live objects, so it
+// either starts in the dense prefix below _first_dead, whose objects did
+// not move and whose marks were reinitialized in phase 2, or at a marked
+// object.
+void CompactibleFreeListSpace::adjust_pointers_in_stripe(size_t i) {
+  HeapWord* q = _compaction_stripes[i];
+  HeapWord* const t = compaction_stripe_end(i);
+
+  HeapWord* const dense_end = MIN2(_first_dead, t);
+  while (q < dense_end) {
+    assert(block_is_obj(q), "should be at block boundaries");
+    size_t size = oop(q)->adjust_pointers();
+    q += adjust_obj_size(size);
+  }
+  if (q == _first_dead && q < _end_of_live) {
+    q = (HeapWord*)oop(_first_dead)->mark()->decode_pointer();
+  }
+
+  const intx interval = PrefetchScanIntervalInBytes;
+  while (q < t) {
+    Prefetch::write(q, interval);
+    if (oop(q)->is_gc_marked()) {
+      size_t size = oop(q)->adjust_pointers();
+      q += adjust_obj_size(size);
+    } else {
+      // The mark of a dead block points at the next live object.
+      debug_only(HeapWord* prev_q = q);
+      q = (HeapWord*)oop(q)->mark()->decode_pointer();
+      assert(q > prev_q, "we should be moving forward through memory");
+    }
+  }
+  assert(q == t, "stripes end at a live object");
+}
+
+void CompactibleFreeListSpace::compact_stripe(size_t i) {
+  HeapWord* q = _compaction_stripes[i];
+  HeapWord* const t = compaction_stripe_end(i);
+
+  if (q < _first_dead) {
+    if (t <= _first_dead) {
+      // Entirely in the dense prefix.
+      return;
+    }
+    q = (HeapWord*)oop(_first_dead)->mark()->decode_pointer();
+  }
+
+  const intx scan_interval = PrefetchScanIntervalInBytes;
+  const intx copy_interval = PrefetchCopyIntervalInBytes;
+  while (q < t) {
+    if (!oop(q)->is_gc_marked()) {
+      debug_only(HeapWord* prev_q = q);
+      q = (HeapWord*)oop(q)->mark()->decode_pointer();
+      assert(q > prev_q, "we should be moving forward through memory");
+    } else {
+      Prefetch::read(q, scan_interval);
+      size_t size = obj_size(q);
+      HeapWord* compaction_top = (HeapWord*)oop(q)->forwardee();
+      Prefetch::write(compaction_top, copy_interval);
+      assert(q != compaction_top, "everything in this pass should be moving");
+      Copy::aligned_conjoint_words(q, compaction_top, size);
+      oop(compaction_top)->init_mark();
+      assert(oop(compaction_top)->klass() != NULL, "should have a class");
+      q += size;
+    }
+  }
+  assert(q == t, "stripes end at a live object");
+}
+
 void CompactibleFreeListSpace::adjust_pointers() {
   // In other versions of adjust_pointers(), a bail out
   // based on the amount of live data in the generation
@@ -2130,12 +2327,35 @@ void CompactibleFreeListSpace::adjust_pointers() {
   // Cannot test used() == 0 here because the free lists have already
   // been mangled by the compaction.
 
+  if (use_parallel_compaction()) {
+    CFLSParAdjustPointersTask task(this);
+    GenCollectedHeap::heap()->workers()->run_task(&task);
+    return;
+  }
+
   SCAN_AND_ADJUST_POINTERS(adjust_obj_size);
   // See note about verification in prepare_for_compaction().
 }
 
 void CompactibleFreeListSpace::compact() {
-  SCAN_AND_COMPACT(obj_size);
+  if (!use_parallel_compaction()) {
+    release_compaction_stripes();
+    SCAN_AND_COMPACT(obj_size);
+    return;
+  }
+
+  CFLSParCompactTask task(this);
+  GenCollectedHeap::heap()->workers()->run_task(&task);
+  release_compaction_stripes();
+
+  // The rest is the tail of SCAN_AND_COMPACT.
+  bool was_empty = used_region().is_empty();
+  reset_after_compaction();
+  if (used_region().is_empty()) {
+    if (!was_empty) clear(SpaceDecorator::Mangle);
+  } else {
+    if (ZapUnusedHeapArea) mangle_unused_area();
+  }
 }
 
 // fragmentation_metric = 1 - [sum of (fbs**2) / (sum of fbs)**2]
@@ -2733,6 +2953,11 @@ void CFLS_LAB::retire(int tid) {
         _global_num_blocks[i] += (_num_blocks[i] - num_retire);
         _global_num_workers[i]++;
         assert(_global_num_workers[i] <= ParallelGCThreads, "Too big");
+        // Every block obtained by get_from_global_pool() is a split birth
+        // of this size.  Accounting for them here rather than once per
+        // refill keeps the refills off the per-size locks.
+        ssize_t births = _cfls->_indexedFreeList[i].split_births() + _num_blocks[i];
+        _cfls->_indexedFreeList[i].set_split_births(births);
         if (num_retire > 0) {
           _cfls->_indexedFreeList[i].prepend(&_indexedFreeList[i]);
           // Reset this list.
@@ -2768,6 +2993,13 @@ bool CompactibleFreeListSpace:: par_get_chunk_of_blocks_IFL(size_t word_sz, size
          (cur_sz < CompactibleFreeListSpace::IndexSetSize) &&
          (CMSSplitIndexedFreeListBlocks || k <= 1);
          k++, cur_sz = k * word_sz) {
+      // Skip empty lists without taking their lock.  Most of the lists
+      // are empty when the free space sits in the dictionary, e.g. after
+      // a compaction, and probing them one lock at a time serialized the
+      // promoting threads.  A stale count only makes us miss a list.
+      if (_indexedFreeList[cur_sz].count() == 0) {
+        continue;
+      }
       AdaptiveFreeList<FreeChunk> fl_for_cur_sz;  // Empty.
       fl_for_cur_sz.set_size(cur_sz);
       {
@@ -2830,12 +3062,8 @@ bool CompactibleFreeListSpace:: par_get_chunk_of_blocks_IFL(size_t word_sz, size
             assert(fl->tail()->next() == NULL, "List invariant.");
           }
         }
-        // Update birth stats for this block size.
-        size_t num = fl->count();
-        MutexLockerEx x(_indexedFreeListParLocks[word_sz],
-                        Mutex::_no_safepoint_check_flag);
-        ssize_t births = _indexedFreeList[word_sz].split_births() + num;
-        _indexedFreeList[word_sz].set_split_births(births);
+        // The split birth stats for this block size are updated by
+        // CFLS_LAB::retire(), see there.
         return true;
       }
     }
@@ -2973,15 +3201,8 @@ void CompactibleFreeListSpace:: par_get_chunk_of_blocks_dictionary(size_t word_s
   fl->return_chunk_at_head(fc);
 
   assert((ssize_t)n > 0 && (ssize_t)n == fl->count(), "Incorrect number of blocks");
-  {
-    // Update the stats for this block size.
-    MutexLockerEx x(_indexedFreeListParLocks[word_sz],
-                    Mutex::_no_safepoint_check_flag);
-    const ssize_t births = _indexedFreeList[word_sz].split_births() + n;
-    _indexedFreeList[word_sz].set_split_births(births);
-    // ssize_t new_surplus = _indexedFreeList[word_sz].surplus() + n;
-    // _indexedFreeList[word_sz].set_surplus(new_surplus);
-  }
+  // The split birth stats for this block size are updated by
+  // CFLS_LAB::retire(), see there.
 
   // TRAP
   assert(fl->tail()->next() == NULL, "List invariant.");
@@ -155,6 +155,37 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   HeapWord* cross_threshold(HeapWord* start, HeapWord* end);
   HeapWord* forward(oop q, size_t size, CompactPoint* cp, HeapWord* compact_top);
 
+  // Support for parallel compaction (CMSParallelFullGC).  Phase 2 of the
+  // mark-compact records the start of a live object roughly every
+  // _compaction_stripe_words words.  The serial walks of phases 3 and 4
+  // visit each of these addresses, so the space can be cut into stripes
+  // there and the stripes handed out to the parallel GC threads.
+  enum CompactionStripeConstants {
+    CompactionStripesPerThread = 16,
+    MinCompactionStripeWords   = 64 * K
+  };
+  HeapWord**     _compaction_stripes;
+  size_t         _compaction_stripe_count;
+  size_t         _compaction_stripe_words;
+  HeapWord*      _next_compaction_stripe;
+  volatile jint* _compaction_stripe_done;
+
+  void setup_compaction_stripes();
+  void release_compaction_stripes();
+  void note_compaction_stripe(HeapWord* q) {
+    if (q >= _next_compaction_stripe && q < end()) {
+      _compaction_stripes[_compaction_stripe_count++] = q;
+      _next_compaction_stripe = q + _compaction_stripe_words;
+    }
+  }
+  bool use_parallel_compaction() const { return _compaction_stripe_count > 1; }
+  HeapWord* compaction_stripe_end(size_t i) const {
+    return i + 1 < _compaction_stripe_count ? _compaction_stripes[i + 1] : _end_of_live;
+  }
+  // The first stripe whose objects must be moved out of the way before
+  // the objects of stripe i can be copied to their new location.
+  size_t first_overlapped_compaction_stripe(size_t i) const;
+
   // Initialization helpers.
   void initializeIndexedFreeListArray();
 
@@ -510,6 +541,12 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   void prepare_for_compaction(CompactPoint* cp);
   void adjust_pointers();
   void compact();
+  // Work units of the parallel versions of adjust_pointers() and compact().
+  void adjust_pointers_in_stripe(size_t i);
+  void compact_stripe(size_t i);
+  bool is_compaction_stripe_done(size_t i) const;
+  void set_compaction_stripe_done(size_t i);
+  size_t compaction_stripe_count() const { return _compaction_stripe_count; }
   // reset the space to reflect the fact that a compaction of the
   // space has been done.
   virtual void reset_after_compaction();
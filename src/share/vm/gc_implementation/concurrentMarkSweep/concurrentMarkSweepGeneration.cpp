@@ -581,6 +581,9 @@ CMSCollector::CMSCollector(ConcurrentMarkSweepGeneration* cmsGen,
   _survivor_chunk_array(NULL), // -- ditto --
   _survivor_chunk_capacity(0), // -- ditto --
   _survivor_chunk_index(0),    // -- ditto --
+  _eden_top_at_initial_mark(NULL),
+  _collections_at_initial_mark(0),
+  _young_rescan_dirty_only(false),
   _ser_pmc_preclean_ovflw(0),
   _ser_kac_preclean_ovflw(0),
   _ser_pmc_remark_ovflw(0),
@@ -3636,6 +3639,7 @@ class CMSParMarkTask : public AbstractGangTask {
   void do_young_space_rescan(uint worker_id, OopsInGenClosure* cl,
                              ContiguousSpace* space,
                              HeapWord** chunk_array, size_t chunk_top);
+  void do_young_dirty_objects(OopsInGenClosure* cl, MemRegion mr);
   void work_on_young_gen_roots(uint worker_id, OopsInGenClosure* cl);
 };
 
@@ -3725,7 +3729,18 @@ void CMSCollector::checkpointRootsInitialWork(bool asynch) {
   verify_work_stacks_empty();
   verify_overflow_empty();
 
-  gch->ensure_parsability(false);  // fill TLABs, but no need to retire them
+  if (CMSRemarkYoungDirtyCardsOnly) {
+    // The cards must be cleared before ensure_parsability() flushes the
+    // deferred card marks of the threads, and the TLABs are retired so
+    // that everything allocated from now on lies above the current top
+    // of eden.
+    clear_young_cards_for_remark();
+    gch->ensure_parsability(true);
+    _eden_top_at_initial_mark = _young_gen->as_DefNewGeneration()->eden()->top();
+    _collections_at_initial_mark = gch->total_collections();
+  } else {
+    gch->ensure_parsability(false);  // fill TLABs, but no need to retire them
+  }
   // Update the saved marks which may affect the root scans.
   gch->save_marks();
 
@@ -5216,7 +5231,12 @@ void CMSCollector::checkpointRootsFinalWork(bool asynch,
       // concurrent precleaning.
       if (CMSParallelRemarkEnabled && CollectedHeap::use_parallel_gc_threads()) {
         GCTraceTime t("Rescan (parallel) ", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+        // A young collection since the initial mark moved the young
+        // objects without carrying their cards along.
+        _young_rescan_dirty_only = _eden_top_at_initial_mark != NULL &&
+                                   _collections_at_initial_mark == gch->total_collections();
         do_remark_parallel();
+        _young_rescan_dirty_only = false;
       } else {
         GCTraceTime t("Rescan (non-parallel) ", PrintGCDetails, false,
                     _gc_timer_cm, _gc_tracer_cm->gc_id());
@@ -5228,6 +5248,7 @@ void CMSCollector::checkpointRootsFinalWork(bool asynch,
     // The initial mark was stop-world, so there's no rescanning to
     // do; go straight on to the next step below.
   }
+  _eden_top_at_initial_mark = NULL;
   verify_work_stacks_empty();
   verify_overflow_empty();
 
@@ -5621,12 +5642,62 @@ CMSParMarkTask::do_young_space_rescan(uint worker_id,
       // Verify that "start" is an object boundary
       assert(mr.is_empty() || oop(mr.start())->is_oop(),
              "Should be an oop");
+      HeapWord* dirty_limit = _collector->young_dirty_rescan_limit(space);
+      if (dirty_limit > mr.start()) {
+        HeapWord* split = MIN2(dirty_limit, mr.end());
+        do_young_dirty_objects(cl, MemRegion(mr.start(), split));
+        mr = MemRegion(split, mr.end());
+      }
       space->par_oop_iterate(mr, cl);
     }
     pst->all_tasks_completed();
   }
 }
 
+// Rescan the objects of mr that have a dirty card.  Walking the headers
+// is much cheaper than iterating over the fields of every object.
+void
+CMSParMarkTask::do_young_dirty_objects(OopsInGenClosure* cl, MemRegion mr) {
+  CardTableModRefBS* ct = _collector->_ct->ct_bs();
+  HeapWord* p = mr.start();
+  while (p < mr.end()) {
+    oop obj = oop(p);
+    assert(obj->is_oop(), "Should be an oop");
+    size_t size = obj->size();
+    size_t last = ct->index_for(p + size - 1);
+    for (size_t i = ct->index_for(p); i <= last; i++) {
+      if (!ct->is_card_clean(i)) {
+        obj->oop_iterate(cl);
+        break;
+      }
+    }
+    p += size;
+  }
+  assert(p == mr.end(), "Should end at an object boundary");
+}
+
+void CMSCollector::clear_young_cards_for_remark() {
+  DefNewGeneration* dng = _young_gen->as_DefNewGeneration();
+  CardTableModRefBS* ct = _ct->ct_bs();
+  ct->clear(dng->eden()->used_region());
+  ct->clear(dng->from()->used_region());
+}
+
+HeapWord* CMSCollector::young_dirty_rescan_limit(ContiguousSpace* space) const {
+  if (!_young_rescan_dirty_only) {
+    return NULL;
+  }
+  DefNewGeneration* dng = _young_gen->as_DefNewGeneration();
+  if (space == dng->eden()) {
+    return _eden_top_at_initial_mark;
+  }
+  if (space == dng->from()) {
+    // Nothing is allocated in the survivor space between collections.
+    return space->top();
+  }
+  return NULL;
+}
+
 void
 CMSParRemarkTask::do_dirty_card_rescan_tasks(
   CompactibleFreeListSpace* sp, int i,
@@ -761,6 +761,21 @@ class CMSCollector: public CHeapObj<mtGC> {
   size_t*    _cursor;
   ChunkArray* _survivor_plab_array;
 
+  // Support for rescanning only the dirtied part of the young objects that
+  // were already there at the initial mark (CMSRemarkYoungDirtyCardsOnly).
+  // The initial mark scanned those objects and cleared their cards; as
+  // long as no young collection moved them, remark only needs to rescan
+  // the ones on cards dirtied since.  Everything allocated after the
+  // initial mark lies above _eden_top_at_initial_mark and is rescanned
+  // in full.
+  HeapWord*    _eden_top_at_initial_mark;
+  unsigned int _collections_at_initial_mark;
+  bool         _young_rescan_dirty_only;   // set for the duration of remark
+  void clear_young_cards_for_remark();
+  // Objects of "space" below the returned address are rescanned only if
+  // they are on a dirty card; NULL if all of "space" is to be rescanned.
+  HeapWord* young_dirty_rescan_limit(ContiguousSpace* space) const;
+
   // A bounded minimum size of PLABs, should not return too small values since
   // this will affect the size of the data structures used for parallel young gen rescan
   size_t plab_sample_minimum_size();
@@ -122,6 +122,16 @@ void CollectionSetChooser::verify() {
 }
 #endif // !PRODUCT
 
+void CollectionSetChooser::remove_at_and_move_to_next(uint offset, HeapRegion* hr) {
+  assert(offset < remaining_regions(), "pre-condition");
+  assert(regions_at(_curr_index + offset) == hr, "pre-condition");
+  for (uint i = _curr_index + offset; i > _curr_index; i--) {
+    regions_at_put(i, regions_at(i - 1));
+  }
+  regions_at_put(_curr_index, hr);
+  remove_and_move_to_next(hr);
+}
+
 void CollectionSetChooser::sort_regions() {
   // First trim any unused portion of the top in the parallel case.
   if (_first_par_unreserved_idx > 0) {
@@ -146,6 +156,22 @@ void CollectionSetChooser::sort_regions() {
   verify();
 }
 
+void CollectionSetChooser::iterate(HeapRegionClosure* cl) {
+  for (uint i = _curr_index; i < _length; i++) {
+    if (cl->doHeapRegion(regions_at(i))) {
+      cl->incomplete();
+      break;
+    }
+  }
+}
+
+void CollectionSetChooser::update_gc_efficiency() {
+  assert(_curr_index == 0, "no candidate should have been removed yet");
+  for (uint i = 0; i < _length; i++) {
+    regions_at(i)->calc_gc_efficiency();
+  }
+  sort_regions();
+}
 
 void CollectionSetChooser::add_region(HeapRegion* hr) {
   assert(!hr->isHumongous(),
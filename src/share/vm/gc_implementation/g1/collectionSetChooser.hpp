@@ -98,10 +98,37 @@ public:
     _curr_index += 1;
   }
 
+  // Return the candidate region offset candidates after the current one,
+  // NULL if there are not that many candidates left.
+  HeapRegion* peek_at(uint offset) {
+    if (offset >= remaining_regions()) {
+      return NULL;
+    }
+    HeapRegion* res = regions_at(_curr_index + offset);
+    assert(res != NULL,
+           err_msg("Unexpected NULL hr in _regions at index %u",
+                   _curr_index + offset));
+    return res;
+  }
+
+  // Remove the given region, which is offset candidates after the current
+  // one, and move to the next one. The skipped candidates are shifted by
+  // one so that they stay sorted.
+  void remove_at_and_move_to_next(uint offset, HeapRegion* hr);
+
   CollectionSetChooser();
 
   void sort_regions();
 
+  // Apply the closure to the candidate regions that have not been
+  // added to a CSet yet.
+  void iterate(HeapRegionClosure* cl);
+
+  // Recalculate the GC efficiency of all candidate regions and sort them
+  // again, e.g. after their remembered sets have been rebuilt. Must be
+  // called before any candidate has been added to a CSet.
+  void update_gc_efficiency();
+
   // Determine whether to add the given region to the CSet chooser or
   // not. Currently, we skip humongous regions (we never add them to
   // the CSet, we only reclaim them during cleanup) and regions whose
@@ -28,9 +28,11 @@
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1HotCardCache.hpp"
 #include "runtime/java.hpp"
+#include "runtime/os.hpp"
 
 ConcurrentG1Refine::ConcurrentG1Refine(G1CollectedHeap* g1h, CardTableEntryClosure* refine_closure) :
-  _threads(NULL), _n_threads(0),
+  _threads(NULL), _n_threads(0), _max_active_workers(0),
+  _buffer_update_ms(AdaptiveSizePolicyWeight),
   _hot_card_cache(g1h)
 {
   // Ergomonically select initial concurrent refinement parameters
@@ -53,6 +55,7 @@ ConcurrentG1Refine::ConcurrentG1Refine(G1CollectedHeap* g1h, CardTableEntryClosu
   // We need one extra thread to do the young gen rset size sampling.
   _n_threads = _n_worker_threads + 1;
 
+  update_max_active_workers();
   reset_threshold_step();
 
   _threads = NEW_C_HEAP_ARRAY(ConcurrentG1RefineThread*, _n_threads, mtGC);
@@ -75,12 +78,45 @@ ConcurrentG1Refine::ConcurrentG1Refine(G1CollectedHeap* g1h, CardTableEntryClosu
 
 void ConcurrentG1Refine::reset_threshold_step() {
   if (FLAG_IS_DEFAULT(G1ConcRefinementThresholdStep)) {
-    _thread_threshold_step = (yellow_zone() - green_zone()) / (worker_thread_num() + 1);
+    _thread_threshold_step = (yellow_zone() - green_zone()) / (max_active_workers() + 1);
   } else {
     _thread_threshold_step = G1ConcRefinementThresholdStep;
   }
 }
 
+void ConcurrentG1Refine::update_max_active_workers() {
+  uint max_active = worker_thread_num();
+  if (G1ConcRefinementMaxCPUPercent < 100) {
+    uint cpus = (uint)(os::active_processor_count() * G1ConcRefinementMaxCPUPercent / 100);
+    max_active = MIN2(max_active, MAX2(cpus, 1u));
+  }
+  if (max_active != _max_active_workers) {
+    if (G1TraceConcRefinement) {
+      gclog_or_tty->print_cr("G1-Refine-max-active-workers %u -> %u", _max_active_workers, max_active);
+    }
+    _max_active_workers = max_active;
+  }
+}
+
+int ConcurrentG1Refine::green_zone_for_goal(double update_rs_time_ms,
+                                            double processed_buffers,
+                                            double goal_ms) {
+  if (processed_buffers > 0.0) {
+    _buffer_update_ms.sample((float)(update_rs_time_ms / processed_buffers));
+  }
+  int g = green_zone();
+  if (_buffer_update_ms.average() > 0.0) {
+    // The red zone is six times the green zone and must not overflow.
+    double target = MIN2(goal_ms / _buffer_update_ms.average(), (double)(max_jint / 6));
+    g = (int)((g + target) / 2.0);
+    if (G1TraceConcRefinement) {
+      gclog_or_tty->print_cr("G1-Refine-green-zone %d, target %.1f, %.3f ms per buffer",
+                             g, target, _buffer_update_ms.average());
+    }
+  }
+  return g;
+}
+
 void ConcurrentG1Refine::init(G1RegionToSpaceMapper* card_counts_storage) {
   _hot_card_cache.initialize(card_counts_storage);
 }
@@ -94,6 +130,7 @@ void ConcurrentG1Refine::stop() {
 }
 
 void ConcurrentG1Refine::reinitialize_threads() {
+  update_max_active_workers();
   reset_threshold_step();
   if (_threads != NULL) {
     for (uint i = 0; i < _n_threads; i++) {
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_CONCURRENTG1REFINE_HPP
 
 #include "gc_implementation/g1/g1HotCardCache.hpp"
+#include "gc_implementation/shared/gcUtil.hpp"
 #include "memory/allocation.hpp"
 #include "runtime/thread.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -65,6 +66,14 @@ class ConcurrentG1Refine: public CHeapObj<mtGC> {
 
   int _thread_threshold_step;
 
+  // Number of worker threads that may run at the same time, bounded by
+  // G1ConcRefinementMaxCPUPercent of the processors available to the VM.
+  volatile uint _max_active_workers;
+
+  // Update RS time per buffer processed in a pause, for sizing the green
+  // zone with G1ConcRefinementTargetUpdateRSTime.
+  AdaptiveWeightedAverage _buffer_update_ms;
+
   // We delay the refinement of 'hot' cards using the hot card cache.
   G1HotCardCache _hot_card_cache;
 
@@ -106,6 +115,17 @@ class ConcurrentG1Refine: public CHeapObj<mtGC> {
 
   int thread_threshold_step() const { return _thread_threshold_step; }
 
+  uint max_active_workers() const { return _max_active_workers; }
+
+  // Recompute max_active_workers() from the current number of available
+  // processors, which follows changes of the container CPU quota.
+  void update_max_active_workers();
+
+  // Green zone after a pause that spent update_rs_time_ms on processed_buffers
+  // buffers, approaching the number of buffers that can be processed in
+  // goal_ms. It moves halfway per pause so the thread thresholds ramp smoothly.
+  int green_zone_for_goal(double update_rs_time_ms, double processed_buffers, double goal_ms);
+
   G1HotCardCache* hot_card_cache() { return &_hot_card_cache; }
 };
 
@@ -103,6 +103,7 @@ void ConcurrentG1RefineThread::run_young_rs_sampling() {
   _vtime_start = os::elapsedVTime();
   while(!_should_terminate) {
     sample_young_list_rs_lengths();
+    cg1r()->update_max_active_workers();
 
     if (os::supports_vtime()) {
       _vtime_accum = (os::elapsedVTime() - _vtime_start);
@@ -194,16 +195,19 @@ void ConcurrentG1RefineThread::run() {
           dcqs.set_completed_queue_padding(0);
         }
 
-        if (_worker_id > 0 && curr_buffer_num <= _deactivation_threshold) {
+        if (_worker_id > 0 && (curr_buffer_num <= _deactivation_threshold ||
+                               _worker_id >= cg1r()->max_active_workers())) {
           // If the number of the buffer has fallen below our threshold
           // we should deactivate. The predecessor will reactivate this
           // thread should the number of the buffers cross the threshold again.
+          // Also deactivate if the CPU bound no longer allows this thread.
           deactivate();
           break;
         }
 
         // Check if we need to activate the next thread.
-        if (_next != NULL && !_next->is_active() && curr_buffer_num > _next->_threshold) {
+        if (_next != NULL && !_next->is_active() && curr_buffer_num > _next->_threshold &&
+            _next->_worker_id < cg1r()->max_active_workers()) {
           _next->activate();
         }
       } while (dcqs.apply_closure_to_completed_buffer(_refine_closure, _worker_id + _worker_id_offset, cg1r()->green_zone()));
@@ -47,6 +47,7 @@
 #include "memory/referencePolicy.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/activeProcessorTracker.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -219,203 +220,170 @@ MemRegion CMBitMap::getAndClearMarkedRegion(HeapWord* addr,
   return mr;
 }
 
+const int CMMarkStack::EntriesPerChunk;
+
 CMMarkStack::CMMarkStack(ConcurrentMark* cm) :
-  _base(NULL), _cm(cm)
-#ifdef ASSERT
-  , _drain_in_progress(false)
-  , _drain_in_progress_yields(false)
-#endif
+  _cm(cm), _base(NULL),
+  _max_chunks(0), _segment_chunks(0), _committed_chunks(0), _hwm(0),
+  _chunk_list(0), _free_list(0), _chunks_in_list(0),
+  _saved_chunk_list(0), _gc_in_progress(false),
+  _overflow(false)
 {}
 
-bool CMMarkStack::allocate(size_t capacity) {
-  // allocate a stack of the requisite depth
-  ReservedSpace rs(ReservedSpace::allocation_align_size_up(capacity * sizeof(oop)));
+bool CMMarkStack::allocate(size_t initial_capacity, size_t max_capacity) {
+  assert(initial_capacity <= max_capacity, "sanity");
+  size_t max_chunks = align_size_up(max_capacity, (size_t) EntriesPerChunk) / EntriesPerChunk;
+  max_chunks = MIN2(max_chunks, (size_t) max_jint);
+  size_t initial_chunks = align_size_up(initial_capacity, (size_t) EntriesPerChunk) / EntriesPerChunk;
+  initial_chunks = MIN2(initial_chunks, max_chunks);
+
+  // reserve space for the largest stack, commit the initial segment
+  ReservedSpace rs(ReservedSpace::allocation_align_size_up(max_chunks * sizeof(OopChunk)));
   if (!rs.is_reserved()) {
     warning("ConcurrentMark MarkStack allocation failure");
     return false;
   }
   MemTracker::record_virtual_memory_type((address)rs.base(), mtGC);
-  if (!_virtual_space.initialize(rs, rs.size())) {
+  size_t initial_bytes = align_size_up(initial_chunks * sizeof(OopChunk), os::vm_page_size());
+  if (!_virtual_space.initialize(rs, MIN2(initial_bytes, rs.size()))) {
     warning("ConcurrentMark MarkStack backing store failure");
     // Release the virtual memory reserved for the marking stack
     rs.release();
     return false;
   }
-  assert(_virtual_space.committed_size() == rs.size(),
-         "Didn't reserve backing store for all of ConcurrentMark stack?");
-  _base = (oop*) _virtual_space.low();
+  _base = (OopChunk*) _virtual_space.low();
+  _max_chunks = (jint) (rs.size() / sizeof(OopChunk));
+  _segment_chunks = MAX2((jint) initial_chunks, 1);
+  _committed_chunks = (jint) (_virtual_space.committed_size() / sizeof(OopChunk));
   setEmpty();
-  _capacity = (jint) capacity;
-  _saved_index = -1;
-  _should_expand = false;
-  NOT_PRODUCT(_max_depth = 0);
   return true;
 }
 
-void CMMarkStack::expand() {
-  // Called, during remark, if we've overflown the marking stack during marking.
-  assert(isEmpty(), "stack should been emptied while handling overflow");
-  assert(_capacity <= (jint) MarkStackSizeMax, "stack bigger than permitted");
-  // Clear expansion flag
-  _should_expand = false;
-  if (_capacity == (jint) MarkStackSizeMax) {
-    if (PrintGCDetails && Verbose) {
-      gclog_or_tty->print_cr(" (benign) Can't expand marking stack capacity, at max size limit");
-    }
-    return;
-  }
-  // Double capacity if possible
-  jint new_capacity = MIN2(_capacity*2, (jint) MarkStackSizeMax);
-  // Do not give up existing stack until we have managed to
-  // get the double capacity that we desired.
-  ReservedSpace rs(ReservedSpace::allocation_align_size_up(new_capacity *
-                                                           sizeof(oop)));
-  if (rs.is_reserved()) {
-    // Release the backing store associated with old stack
+CMMarkStack::~CMMarkStack() {
+  if (_base != NULL) {
+    _base = NULL;
     _virtual_space.release();
-    // Reinitialize virtual space for new stack
-    if (!_virtual_space.initialize(rs, rs.size())) {
-      fatal("Not enough swap for expanded marking stack capacity");
-    }
-    _base = (oop*)(_virtual_space.low());
-    _index = 0;
-    _capacity = new_capacity;
-  } else {
-    if (PrintGCDetails && Verbose) {
-      // Failed to double capacity, continue;
-      gclog_or_tty->print(" (benign) Failed to expand marking stack capacity from "
-                          SIZE_FORMAT "K to " SIZE_FORMAT "K",
-                          _capacity / K, new_capacity / K);
-    }
   }
 }
 
-void CMMarkStack::set_should_expand() {
-  // If we're resetting the marking state because of an
-  // marking stack overflow, record that we should, if
-  // possible, expand the stack.
-  _should_expand = _cm->has_overflown();
+bool CMMarkStack::commit_chunks(jint needed) {
+  // Concurrent marking only comes here when the committed chunks are
+  // used up, so the lock is rarely contended.
+  MutexLockerEx x(ParGCRareEvent_lock, Mutex::_no_safepoint_check_flag);
+  while (_committed_chunks < needed) {
+    jint new_chunks = MIN2(_committed_chunks + _segment_chunks, _max_chunks);
+    size_t new_bytes = align_size_up(new_chunks * sizeof(OopChunk), os::vm_page_size());
+    new_bytes = MIN2(new_bytes, _virtual_space.reserved_size());
+    if (new_bytes <= _virtual_space.committed_size() ||
+        !_virtual_space.expand_by(new_bytes - _virtual_space.committed_size())) {
+      if (PrintGCDetails && Verbose) {
+        gclog_or_tty->print_cr(" (benign) Can't expand marking stack capacity beyond "
+                               SIZE_FORMAT "K entries", maxElems() / K);
+      }
+      return false;
+    }
+    OrderAccess::release_store(&_committed_chunks,
+                               (jint) (_virtual_space.committed_size() / sizeof(OopChunk)));
+  }
+  return true;
 }
 
-CMMarkStack::~CMMarkStack() {
-  if (_base != NULL) {
-    _base = NULL;
-    _virtual_space.release();
+CMMarkStack::OopChunk* CMMarkStack::allocate_new_chunk() {
+  // Avoid wrapping _hwm with repeated failed allocations
+  if (_hwm >= _max_chunks) {
+    return NULL;
   }
+  jint index = Atomic::add(1, &_hwm) - 1;
+  if (index >= _max_chunks) {
+    return NULL;
+  }
+  if (index >= OrderAccess::load_acquire(&_committed_chunks) && !commit_chunks(index + 1)) {
+    return NULL;
+  }
+  return chunk_at(index);
 }
 
-void CMMarkStack::par_push(oop ptr) {
+void CMMarkStack::add_chunk_to_list(volatile jlong* list, jint index) {
+  OopChunk* chunk = chunk_at(index);
   while (true) {
-    if (isFull()) {
-      _overflow = true;
-      return;
-    }
-    // Otherwise...
-    jint index = _index;
-    jint next_index = index+1;
-    jint res = Atomic::cmpxchg(next_index, &_index, index);
-    if (res == index) {
-      _base[index] = ptr;
-      // Note that we don't maintain this atomically.  We could, but it
-      // doesn't seem necessary.
-      NOT_PRODUCT(_max_depth = MAX2(_max_depth, next_index));
+    jlong head = Atomic::load(list);
+    chunk->_next = list_index(head);
+    jlong new_head = ((list_tag(head) + 1) << 32) | (jlong) (index + 1);
+    if (Atomic::cmpxchg(new_head, list, head) == head) {
       return;
     }
-    // Otherwise, we need to try again.
   }
 }
 
-void CMMarkStack::par_adjoin_arr(oop* ptr_arr, int n) {
+CMMarkStack::OopChunk* CMMarkStack::remove_chunk_from_list(volatile jlong* list) {
   while (true) {
-    if (isFull()) {
-      _overflow = true;
-      return;
+    jlong head = Atomic::load(list);
+    jint first = list_index(head);
+    if (first == 0) {
+      return NULL;
     }
-    // Otherwise...
-    jint index = _index;
-    jint next_index = index + n;
-    if (next_index > _capacity) {
-      _overflow = true;
-      return;
+    OopChunk* chunk = chunk_at(first - 1);
+    // The chunk may have been taken and relinked by another thread in
+    // the meantime; then the tag has changed and the CAS below fails.
+    jint next = chunk->_next;
+    jlong new_head = ((list_tag(head) + 1) << 32) | (jlong) next;
+    if (Atomic::cmpxchg(new_head, list, head) == head) {
+      return chunk;
     }
-    jint res = Atomic::cmpxchg(next_index, &_index, index);
-    if (res == index) {
-      for (int i = 0; i < n; i++) {
-        int  ind = index + i;
-        assert(ind < _capacity, "By overflow test above.");
-        _base[ind] = ptr_arr[i];
-      }
-      NOT_PRODUCT(_max_depth = MAX2(_max_depth, next_index));
-      return;
-    }
-    // Otherwise, we need to try again.
   }
 }
 
 void CMMarkStack::par_push_arr(oop* ptr_arr, int n) {
-  MutexLockerEx x(ParGCRareEvent_lock, Mutex::_no_safepoint_check_flag);
-  jint start = _index;
-  jint next_index = start + n;
-  if (next_index > _capacity) {
-    _overflow = true;
-    return;
+  assert(0 < n && n <= EntriesPerChunk, "one chunk at a time");
+  OopChunk* chunk = remove_chunk_from_list(&_free_list);
+  if (chunk == NULL) {
+    chunk = allocate_new_chunk();
+    if (chunk == NULL) {
+      _overflow = true;
+      return;
+    }
   }
-  // Otherwise.
-  _index = next_index;
   for (int i = 0; i < n; i++) {
-    int ind = start + i;
-    assert(ind < _capacity, "By overflow test above.");
-    _base[ind] = ptr_arr[i];
+    chunk->_data[i] = ptr_arr[i];
   }
-  NOT_PRODUCT(_max_depth = MAX2(_max_depth, next_index));
+  if (n < EntriesPerChunk) {
+    chunk->_data[n] = NULL;
+  }
+  add_chunk_to_list(&_chunk_list, (jint) (chunk - _base));
+  Atomic::inc(&_chunks_in_list);
 }
 
 bool CMMarkStack::par_pop_arr(oop* ptr_arr, int max, int* n) {
-  MutexLockerEx x(ParGCRareEvent_lock, Mutex::_no_safepoint_check_flag);
-  jint index = _index;
-  if (index == 0) {
+  assert(max >= EntriesPerChunk, "must be able to take a whole chunk");
+  OopChunk* chunk = remove_chunk_from_list(&_chunk_list);
+  if (chunk == NULL) {
     *n = 0;
     return false;
-  } else {
-    int k = MIN2(max, index);
-    jint  new_ind = index - k;
-    for (int j = 0; j < k; j++) {
-      ptr_arr[j] = _base[new_ind + j];
-    }
-    _index = new_ind;
-    *n = k;
-    return true;
   }
+  Atomic::dec(&_chunks_in_list);
+  int k = 0;
+  while (k < EntriesPerChunk && chunk->_data[k] != NULL) {
+    ptr_arr[k] = chunk->_data[k];
+    k++;
+  }
+  add_chunk_to_list(&_free_list, (jint) (chunk - _base));
+  *n = k;
+  return true;
 }
 
-template<class OopClosureClass>
-bool CMMarkStack::drain(OopClosureClass* cl, CMBitMap* bm, bool yield_after) {
-  assert(!_drain_in_progress || !_drain_in_progress_yields || yield_after
-         || SafepointSynchronize::is_at_safepoint(),
-         "Drain recursion must be yield-safe.");
-  bool res = true;
-  debug_only(_drain_in_progress = true);
-  debug_only(_drain_in_progress_yields = yield_after);
-  while (!isEmpty()) {
-    oop newOop = pop();
-    assert(G1CollectedHeap::heap()->is_in_reserved(newOop), "Bad pop");
-    assert(newOop->is_oop(), "Expected an oop");
-    assert(bm == NULL || bm->isMarked((HeapWord*)newOop),
-           "only grey objects on this stack");
-    newOop->oop_iterate(cl);
-    if (yield_after && _cm->do_yield_check()) {
-      res = false;
-      break;
-    }
-  }
-  debug_only(_drain_in_progress = false);
-  return res;
+void CMMarkStack::setEmpty() {
+  _chunk_list = 0;
+  _free_list = 0;
+  _chunks_in_list = 0;
+  _hwm = 0;
+  clear_overflow();
 }
 
 void CMMarkStack::note_start_of_gc() {
-  assert(_saved_index == -1,
+  assert(!_gc_in_progress,
          "note_start_of_gc()/end_of_gc() bracketed incorrectly");
-  _saved_index = _index;
+  _gc_in_progress = true;
+  _saved_chunk_list = _chunk_list;
 }
 
 void CMMarkStack::note_end_of_gc() {
@@ -424,16 +392,21 @@ void CMMarkStack::note_end_of_gc() {
   // will be a correctness issue so it's better if we crash. we'll
   // only check this once per GC anyway, so it won't be a performance
   // issue in any way.
-  guarantee(_saved_index == _index,
-            err_msg("saved index: %d index: %d", _saved_index, _index));
-  _saved_index = -1;
+  guarantee(_saved_chunk_list == _chunk_list,
+            err_msg("saved chunk list: " UINT64_FORMAT_X " chunk list: " UINT64_FORMAT_X,
+                    (uint64_t) _saved_chunk_list, (uint64_t) _chunk_list));
+  _gc_in_progress = false;
 }
 
 void CMMarkStack::oops_do(OopClosure* f) {
-  assert(_saved_index == _index,
-         err_msg("saved index: %d index: %d", _saved_index, _index));
-  for (int i = 0; i < _index; i += 1) {
-    f->do_oop(&_base[i]);
+  assert(_gc_in_progress && _saved_chunk_list == _chunk_list,
+         "should only be called between note_start_of_gc()/end_of_gc()");
+  for (jint next = list_index(_chunk_list); next != 0; ) {
+    OopChunk* chunk = chunk_at(next - 1);
+    for (int i = 0; i < EntriesPerChunk && chunk->_data[i] != NULL; i++) {
+      f->do_oop(&chunk->_data[i]);
+    }
+    next = chunk->_next;
   }
 }
 
@@ -534,6 +507,8 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   _cleanup_sleep_factor(0.0),
   _cleanup_task_overhead(1.0),
   _cleanup_list("Cleanup List"),
+  _rebuild_regions(NULL),
+  _num_rebuild_regions(0),
   _region_bm((BitMap::idx_t)(g1h->max_regions()), false /* in_resource_area*/),
   _card_bm((g1h->reserved_region().byte_size() + CardTableModRefBS::card_size - 1) >>
             CardTableModRefBS::card_shift,
@@ -557,6 +532,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   _aborted_gc_id(GCId::undefined()),
   _restart_for_overflow(false),
   _concurrent_marking_in_progress(false),
+  _unloaded_class_loader_data(NULL),
 
   // _verbose_level set below
 
@@ -714,7 +690,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
     }
   }
 
-  if (!_markStack.allocate(MarkStackSize)) {
+  if (!_markStack.allocate(MarkStackSize, MarkStackSizeMax)) {
     warning("Failed to allocate CM marking stack");
     return;
   }
@@ -795,7 +771,6 @@ void ConcurrentMark::reset() {
 
 
 void ConcurrentMark::reset_marking_state(bool clear_overflow) {
-  _markStack.set_should_expand();
   _markStack.setEmpty();        // Also clears the _markStack overflow flag
   if (clear_overflow) {
     clear_has_overflown();
@@ -1181,6 +1156,7 @@ uint ConcurrentMark::calc_parallel_marking_threads() {
       // Don't scale down "n_conc_workers" by scale_parallel_threads() because
       // that scaling has already gone into "_max_parallel_marking_threads".
     }
+    n_conc_workers = ActiveProcessorTracker::limit_conc_workers(n_conc_workers);
     assert(n_conc_workers > 0, "Always need at least 1");
     return n_conc_workers;
   }
@@ -1366,11 +1342,6 @@ void ConcurrentMark::checkpointRootsFinal(bool clear_all_soft_refs) {
     set_non_marking_state();
   }
 
-  // Expand the marking stack, if we have to and if we can.
-  if (_markStack.should_expand()) {
-    _markStack.expand();
-  }
-
   // Statistics
   double now = os::elapsedTime();
   _remark_mark_times.add((mark_work_end - start) * 1000.0);
@@ -2136,6 +2107,14 @@ void ConcurrentMark::cleanup() {
   // and sort the regions.
   g1h->g1_policy()->record_concurrent_mark_cleanup_end((int)n_workers);
 
+  if (TenantHeapIsolation) {
+    G1TenantAllocationContexts::recalculate_used(true /* after_marking */);
+  }
+
+  if (G1RebuildRemSetsConcurrently) {
+    select_regions_for_rem_set_rebuild();
+  }
+
   // Statistics.
   double end = os::elapsedTime();
   _cleanup_times.add((end - start) * 1000.0);
@@ -2167,7 +2146,14 @@ void ConcurrentMark::cleanup() {
 
   // Clean out dead classes and update Metaspace sizes.
   if (ClassUnloadingWithConcurrentMark) {
-    ClassLoaderDataGraph::purge();
+    if (G1PurgeClassLoaderDataConcurrently) {
+      // Only unhook the dead class loader data here, deleting them and
+      // their metaspaces is left to the concurrent mark thread.
+      assert(_unloaded_class_loader_data == NULL, "should have been purged");
+      _unloaded_class_loader_data = ClassLoaderDataGraph::detach_unloading();
+    } else {
+      ClassLoaderDataGraph::purge();
+    }
   }
   MetaspaceGC::compute_new_size();
 
@@ -2179,6 +2165,27 @@ void ConcurrentMark::cleanup() {
   g1h->trace_heap_after_concurrent_cycle();
 }
 
+void ConcurrentMark::purge_class_loader_data() {
+  assert(Thread::current()->is_ConcurrentGC_thread(), "should be the concurrent mark thread");
+  SuspendibleThreadSetJoiner sts;
+  uint purged = 0;
+  while (_unloaded_class_loader_data != NULL) {
+    _unloaded_class_loader_data =
+      ClassLoaderDataGraph::purge_first_detached(_unloaded_class_loader_data);
+    purged++;
+    if (sts.should_yield()) {
+      sts.yield();
+    }
+  }
+  // The virtual space nodes emptied by the deletion are released by the
+  // Metaspace::purge() part of the next purge at a safepoint.
+  ClassLoaderDataGraph::set_should_purge(true);
+
+  if (G1Log::finer()) {
+    gclog_or_tty->print_cr("[GC concurrent-class-unloading, purged %u class loader data]", purged);
+  }
+}
+
 void ConcurrentMark::completeCleanup() {
   if (has_aborted()) return;
 
@@ -2233,6 +2240,283 @@ void ConcurrentMark::completeCleanup() {
   assert(tmp_free_list.is_empty(), "post-condition");
 }
 
+// Picks the regions whose remembered sets are kept (the collection set
+// candidates) and the regions that have to be scanned to rebuild them.
+class G1SelectRemSetRebuildRegionsClosure : public HeapRegionClosure {
+  BitMap* _candidates;
+  HeapRegion** _sources;
+  uint _num_sources;
+  uint _num_updating;
+  uint _num_untracked;
+
+public:
+  G1SelectRemSetRebuildRegionsClosure(BitMap* candidates, HeapRegion** sources) :
+    _candidates(candidates), _sources(sources),
+    _num_sources(0), _num_updating(0), _num_untracked(0) { }
+
+  bool doHeapRegion(HeapRegion* r) {
+    if (r->is_free() || r->is_young() || r->continuesHumongous()) {
+      return false;
+    }
+    HeapRegionRemSet* hrrs = r->rem_set();
+    if (r->is_old()) {
+      if (_candidates->at(r->hrm_index())) {
+        if (!hrrs->is_tracked()) {
+          hrrs->set_state_updating();
+          _num_updating++;
+        }
+      } else {
+        // The strong code roots are kept; they are maintained eagerly
+        // and are cheap compared to the card set.
+        hrrs->clear(true /* only_cardset */);
+        hrrs->set_state_untracked();
+        _num_untracked++;
+      }
+    }
+    // Humongous regions keep their remembered sets for eager reclaim.
+    if (r->top() > r->bottom()) {
+      r->set_top_at_rebuild_start(r->top());
+      _sources[_num_sources++] = r;
+    }
+    return false;
+  }
+
+  uint num_sources() const   { return _num_sources; }
+  uint num_updating() const  { return _num_updating; }
+  uint num_untracked() const { return _num_untracked; }
+};
+
+class G1MarkCandidateClosure : public HeapRegionClosure {
+  BitMap* _candidates;
+public:
+  G1MarkCandidateClosure(BitMap* candidates) : _candidates(candidates) { }
+
+  bool doHeapRegion(HeapRegion* r) {
+    _candidates->set_bit(r->hrm_index());
+    return false;
+  }
+};
+
+void ConcurrentMark::select_regions_for_rem_set_rebuild() {
+  assert(SafepointSynchronize::is_at_safepoint(), "world should be stopped");
+  assert(G1RebuildRemSetsConcurrently, "only used for the concurrent rebuild");
+
+  if (_rebuild_regions != NULL) {
+    // An aborted cycle never got to the rebuild.
+    FREE_C_HEAP_ARRAY(HeapRegion*, _rebuild_regions, mtGC);
+    _rebuild_regions = NULL;
+    _num_rebuild_regions = 0;
+  }
+
+  ResourceMark rm;
+  BitMap candidates(_g1h->max_regions(), true /* in_resource_area */);
+  candidates.clear();
+  G1MarkCandidateClosure mark_cl(&candidates);
+  _g1h->g1_policy()->cset_chooser()->iterate(&mark_cl);
+
+  HeapRegion** sources = NEW_C_HEAP_ARRAY(HeapRegion*, _g1h->max_regions(), mtGC);
+  G1SelectRemSetRebuildRegionsClosure cl(&candidates, sources);
+  _g1h->heap_region_iterate(&cl);
+
+  if (G1Log::finer()) {
+    gclog_or_tty->print_cr("   [Remembered Set Rebuild: %u regions to rebuild, "
+                           "%u regions untracked, %u regions to scan]",
+                           cl.num_updating(), cl.num_untracked(), cl.num_sources());
+  }
+
+  if (cl.num_updating() == 0) {
+    // All candidates already have complete remembered sets.
+    for (uint i = 0; i < cl.num_sources(); i++) {
+      sources[i]->set_top_at_rebuild_start(NULL);
+    }
+    FREE_C_HEAP_ARRAY(HeapRegion*, sources, mtGC);
+    return;
+  }
+  _rebuild_regions = sources;
+  _num_rebuild_regions = cl.num_sources();
+}
+
+// Adds the references of a scanned object to the remembered sets that
+// are being rebuilt. References to regions with complete remembered sets
+// are already recorded, and untracked ones drop them anyway.
+class G1RebuildRemSetOopClosure : public ExtendedOopClosure {
+  G1CollectedHeap* _g1h;
+  HeapRegion* _from;
+  uint _par_id;
+
+  template <class T> void do_oop_work(T* p) {
+    T heap_oop = oopDesc::load_heap_oop(p);
+    if (oopDesc::is_null(heap_oop)) {
+      return;
+    }
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    HeapRegion* to = _g1h->heap_region_containing(obj);
+    if (to != _from && to->rem_set()->is_updating()) {
+      to->rem_set()->add_reference(p, _par_id);
+    }
+  }
+
+public:
+  G1RebuildRemSetOopClosure(G1CollectedHeap* g1h, uint par_id) :
+    _g1h(g1h), _from(NULL), _par_id(par_id) { }
+
+  void set_from(HeapRegion* from) { _from = from; }
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class G1RebuildRemSetTask : public AbstractGangTask {
+  // Amount of work, in heap words scanned, between yield checks.
+  static const size_t ChunkWords = 256 * K / HeapWordSize;
+
+  ConcurrentMark* _cm;
+  HeapRegion** _regions;
+  uint _num_regions;
+  volatile jint _next_region;
+
+  // Returns true if the rebuild should stop scanning the region after a
+  // yield: either the marking cycle got aborted by a Full GC, or the
+  // region (a humongous one) has been eagerly reclaimed in the meantime.
+  bool yield_and_check_abort(HeapRegion* hr, uint worker_id) {
+    if (_cm->do_yield_check(worker_id)) {
+      return _cm->has_aborted() || hr->top_at_rebuild_start() == NULL;
+    }
+    return false;
+  }
+
+  void scan_humongous(HeapRegion* hr, HeapWord* tars,
+                      G1RebuildRemSetOopClosure* cl, uint worker_id) {
+    oop obj = oop(hr->bottom());
+    if (obj->is_typeArray()) {
+      return;
+    }
+    // Scan large objects in chunks so that we can yield in between.
+    HeapWord* cur = hr->bottom();
+    while (cur < tars) {
+      HeapWord* chunk_end = MIN2(cur + ChunkWords, tars);
+      obj->oop_iterate(cl, MemRegion(cur, chunk_end));
+      cur = chunk_end;
+      if (yield_and_check_abort(hr, worker_id)) {
+        return;
+      }
+    }
+  }
+
+  // Objects below the prev TAMS are only scanned if they were marked live,
+  // the ones above were allocated during marking and are all live.
+  void scan_old(HeapRegion* hr, HeapWord* tars,
+                G1RebuildRemSetOopClosure* cl, uint worker_id) {
+    const CMBitMapRO* bitmap = _cm->prevMarkBitMap();
+    HeapWord* const ptams = hr->prev_top_at_mark_start();
+    assert(ptams <= tars, "marking should have finished before the rebuild");
+
+    HeapWord* cur = hr->bottom();
+    size_t scanned = 0;
+    while (cur < tars) {
+      if (cur < ptams && !bitmap->isMarked(cur)) {
+        cur = bitmap->getNextMarkedWordAddress(cur, ptams);
+        continue;
+      }
+      oop obj = oop(cur);
+      size_t size = (size_t) obj->oop_iterate(cl);
+      cur += size;
+      scanned += size;
+      if (scanned >= ChunkWords) {
+        scanned = 0;
+        if (yield_and_check_abort(hr, worker_id)) {
+          return;
+        }
+      }
+    }
+  }
+
+public:
+  G1RebuildRemSetTask(ConcurrentMark* cm, HeapRegion** regions, uint num_regions) :
+    AbstractGangTask("Rebuild Remembered Sets"), _cm(cm),
+    _regions(regions), _num_regions(num_regions), _next_region(0) { }
+
+  void work(uint worker_id) {
+    assert(Thread::current()->is_ConcurrentGC_thread(),
+           "this should only be done by a conc GC thread");
+    SuspendibleThreadSetJoiner sts;
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    G1RebuildRemSetOopClosure cl(g1h, HeapRegionRemSet::rebuild_par_id_base() + worker_id);
+
+    while (!_cm->has_aborted()) {
+      uint i = (uint) Atomic::add(1, &_next_region) - 1;
+      if (i >= _num_regions) {
+        break;
+      }
+      HeapRegion* hr = _regions[i];
+      // Joined to the suspendible thread set, so no pause can free the
+      // region while we look at it.
+      HeapWord* tars = hr->top_at_rebuild_start();
+      if (tars == NULL) {
+        continue;
+      }
+      cl.set_from(hr);
+      if (hr->startsHumongous()) {
+        scan_humongous(hr, tars, &cl, worker_id);
+      } else {
+        assert(hr->is_old(), "only old and humongous regions are scanned");
+        scan_old(hr, tars, &cl, worker_id);
+      }
+      hr->set_top_at_rebuild_start(NULL);
+      _cm->do_yield_check(worker_id);
+    }
+  }
+};
+
+class G1CompleteRemSetRebuildClosure : public HeapRegionClosure {
+public:
+  bool doHeapRegion(HeapRegion* r) {
+    if (r->rem_set()->is_updating()) {
+      r->rem_set()->set_state_complete();
+    }
+    return false;
+  }
+};
+
+void ConcurrentMark::rebuild_rem_sets() {
+  if (_rebuild_regions == NULL) {
+    return;
+  }
+
+  _parallel_marking_threads = calc_parallel_marking_threads();
+  assert(parallel_marking_threads() <= max_parallel_marking_threads(),
+         "Maximum number of marking threads exceeded");
+  uint active_workers = MAX2(1U, parallel_marking_threads());
+
+  G1RebuildRemSetTask task(this, _rebuild_regions, _num_rebuild_regions);
+  if (use_parallel_marking_threads()) {
+    _parallel_workers->set_active_workers((int) active_workers);
+    _parallel_workers->run_task(&task);
+  } else {
+    task.work(0);
+  }
+
+  {
+    SuspendibleThreadSetJoiner sts;
+    if (!has_aborted()) {
+      // The candidates can be collected now; their GC efficiency has been
+      // estimated with the remembered sets still (partially) missing.
+      CollectionSetChooser* chooser = _g1h->g1_policy()->cset_chooser();
+      G1CompleteRemSetRebuildClosure cl;
+      chooser->iterate(&cl);
+      chooser->update_gc_efficiency();
+    }
+    // Regions skipped because of an abort may still have their tars set.
+    for (uint i = 0; i < _num_rebuild_regions; i++) {
+      _rebuild_regions[i]->set_top_at_rebuild_start(NULL);
+    }
+  }
+
+  FREE_C_HEAP_ARRAY(HeapRegion*, _rebuild_regions, mtGC);
+  _rebuild_regions = NULL;
+  _num_rebuild_regions = 0;
+}
+
 // Supporting Object and Oop closures for reference discovery
 // and processing in during marking
 
@@ -2464,6 +2748,23 @@ void G1CMRefProcTaskExecutor::execute(EnqueueTask& enq_task) {
   _g1h->set_par_threads(0);
 }
 
+// Drops the allocation samples of regions whose dominant klass has been
+// unloaded, so that no dangling Klass* is reported for them.
+class G1ClearUnloadedAllocationSamplesClosure : public HeapRegionClosure {
+  BoolObjectClosure* _is_alive;
+public:
+  G1ClearUnloadedAllocationSamplesClosure(BoolObjectClosure* is_alive) :
+    _is_alive(is_alive) { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    Klass* k = hr->sampled_klass();
+    if (k != NULL && !k->is_loader_alive(_is_alive)) {
+      hr->reset_allocation_samples();
+    }
+    return false;
+  }
+};
+
 void ConcurrentMark::weakRefsWorkParallelPart(BoolObjectClosure* is_alive, bool purged_classes) {
   G1CollectedHeap::heap()->parallel_cleaning(is_alive, true, true, purged_classes);
 }
@@ -2615,6 +2916,11 @@ void ConcurrentMark::weakRefsWork(bool clear_all_soft_refs) {
         purged_classes = SystemDictionary::do_unloading(&g1_is_alive, false /* Defer klass cleaning */);
       }
 
+      if (purged_classes && G1RegionAllocationSampleInterval > 0) {
+        G1ClearUnloadedAllocationSamplesClosure cl(&g1_is_alive);
+        g1h->heap_region_iterate(&cl);
+      }
+
       {
         G1RemarkGCTraceTime trace("Parallel Unloading", G1Log::finest());
         weakRefsWorkParallelPart(&g1_is_alive, purged_classes);
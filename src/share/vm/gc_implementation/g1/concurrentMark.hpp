@@ -32,6 +32,7 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "utilities/taskqueue.hpp"
 
+class ClassLoaderData;
 class G1CollectedHeap;
 class CMBitMap;
 class CMTask;
@@ -168,111 +169,99 @@ class CMBitMap : public CMBitMapRO {
 };
 
 // Represents a marking stack used by ConcurrentMarking in the G1 collector.
+//
+// The stack is a list of chunks, each holding up to EntriesPerChunk
+// oops. Chunks live in a virtual space reserved for MarkStackSizeMax
+// entries outside the Java heap. Only MarkStackSize entries are
+// committed up front; further segments are committed when the chunks
+// run out, so an overflow now only happens once MarkStackSizeMax has
+// been reached. Pushing and popping a chunk is lock-free. The list heads
+// hold a chunk index together with a version tag that is bumped on every
+// update, so that a chunk which is popped and pushed again in between
+// does not fool a CAS (ABA).
 class CMMarkStack VALUE_OBJ_CLASS_SPEC {
-  VirtualSpace _virtual_space;   // Underlying backing store for actual stack
+ public:
+  // So that a chunk together with its link fills 1024 words.
+  static const int EntriesPerChunk = 1024 - (int) (sizeof(jlong) / sizeof(oop));
+
+ private:
+  struct OopChunk {
+    jint _next;                   // 1 + index of the next chunk, 0 ends the list
+    jint _pad;
+    oop  _data[EntriesPerChunk];  // NULL terminated if not full
+  };
+
+  VirtualSpace    _virtual_space; // Underlying backing store for the chunks
   ConcurrentMark* _cm;
-  oop* _base;        // bottom of stack
-  jint _index;       // one more than last occupied index
-  jint _capacity;    // max #elements
-  jint _saved_index; // value of _index saved at start of GC
-  NOT_PRODUCT(jint _max_depth;)   // max depth plumbed during run
+  OopChunk*       _base;          // first chunk
 
-  bool  _overflow;
-  bool  _should_expand;
-  DEBUG_ONLY(bool _drain_in_progress;)
-  DEBUG_ONLY(bool _drain_in_progress_yields;)
+  jint            _max_chunks;    // chunks in the reserved space
+  jint            _segment_chunks;// chunks committed at a time
+  volatile jint   _committed_chunks;
+  volatile jint   _hwm;           // chunks handed out since the last reset
 
- public:
-  CMMarkStack(ConcurrentMark* cm);
-  ~CMMarkStack();
+  // List heads: (tag << 32) | (1 + chunk index), 0 index for empty.
+  volatile jlong  _chunk_list;    // chunks holding grey objects
+  volatile jlong  _free_list;     // chunks available for reuse
+  volatile jint   _chunks_in_list;
 
-#ifndef PRODUCT
-  jint max_depth() const {
-    return _max_depth;
-  }
-#endif
+  jlong           _saved_chunk_list;
+  bool            _gc_in_progress;
 
-  bool allocate(size_t capacity);
+  bool            _overflow;
 
-  oop pop() {
-    if (!isEmpty()) {
-      return _base[--_index] ;
-    }
-    return NULL;
+  OopChunk* chunk_at(jint index) const {
+    assert(0 <= index && index < _committed_chunks, "out of bounds");
+    return _base + index;
   }
 
-  // If overflow happens, don't do the push, and record the overflow.
-  // *Requires* that "ptr" is already marked.
-  void push(oop ptr) {
-    if (isFull()) {
-      // Record overflow.
-      _overflow = true;
-      return;
-    } else {
-      _base[_index++] = ptr;
-      NOT_PRODUCT(_max_depth = MAX2(_max_depth, _index));
-    }
-  }
-  // Non-block impl.  Note: concurrency is allowed only with other
-  // "par_push" operations, not with "pop" or "drain".  We would need
-  // parallel versions of them if such concurrency was desired.
-  void par_push(oop ptr);
-
-  // Pushes the first "n" elements of "ptr_arr" on the stack.
-  // Non-block impl.  Note: concurrency is allowed only with other
-  // "par_adjoin_arr" or "push" operations, not with "pop" or "drain".
-  void par_adjoin_arr(oop* ptr_arr, int n);
-
-  // Pushes the first "n" elements of "ptr_arr" on the stack.
-  // Locking impl: concurrency is allowed only with
-  // "par_push_arr" and/or "par_pop_arr" operations, which use the same
-  // locking strategy.
+  static jint  list_index(jlong head) { return (jint) (head & 0xFFFFFFFF); }
+  static jlong list_tag(jlong head)   { return head >> 32; }
+
+  void      add_chunk_to_list(volatile jlong* list, jint index);
+  OopChunk* remove_chunk_from_list(volatile jlong* list);
+  OopChunk* allocate_new_chunk();
+  bool      commit_chunks(jint needed);
+
+ public:
+  CMMarkStack(ConcurrentMark* cm);
+  ~CMMarkStack();
+
+  // Reserves space for max_capacity entries and commits initial_capacity.
+  bool allocate(size_t initial_capacity, size_t max_capacity);
+
+  // Pushes the first "n" (at most EntriesPerChunk) elements of "ptr_arr"
+  // as one chunk. If no chunk can be had, records the overflow. Safe to
+  // use concurrently with other pushes and pops.
   void par_push_arr(oop* ptr_arr, int n);
 
-  // If returns false, the array was empty.  Otherwise, removes up to "max"
-  // elements from the stack, and transfers them to "ptr_arr" in an
-  // unspecified order.  The actual number transferred is given in "n" ("n
-  // == 0" is deliberately redundant with the return value.)  Locking impl:
-  // concurrency is allowed only with "par_push_arr" and/or "par_pop_arr"
-  // operations, which use the same locking strategy.
+  // If returns false, the stack was empty.  Otherwise, removes the
+  // elements of one chunk and transfers them to "ptr_arr", which must
+  // have room for "max" >= EntriesPerChunk elements. The actual number
+  // transferred is given in "n" ("n == 0" is deliberately redundant with
+  // the return value.)
   bool par_pop_arr(oop* ptr_arr, int max, int* n);
 
-  // Drain the mark stack, applying the given closure to all fields of
-  // objects on the stack.  (That is, continue until the stack is empty,
-  // even if closure applications add entries to the stack.)  The "bm"
-  // argument, if non-null, may be used to verify that only marked objects
-  // are on the mark stack.  If "yield_after" is "true", then the
-  // concurrent marker performing the drain offers to yield after
-  // processing each object.  If a yield occurs, stops the drain operation
-  // and returns false.  Otherwise, returns true.
-  template<class OopClosureClass>
-  bool drain(OopClosureClass* cl, CMBitMap* bm, bool yield_after = false);
-
-  bool isEmpty()    { return _index == 0; }
-  bool isFull()     { return _index == _capacity; }
-  int  maxElems()   { return _capacity; }
+  bool isEmpty()    { return list_index(Atomic::load(&_chunk_list)) == 0; }
+  size_t maxElems() { return (size_t) _committed_chunks * EntriesPerChunk; }
 
   bool overflow() { return _overflow; }
   void clear_overflow() { _overflow = false; }
 
-  bool should_expand() const { return _should_expand; }
-  void set_should_expand();
+  // Approximate, counting only full chunks.
+  size_t size() { return (size_t) _chunks_in_list * EntriesPerChunk; }
 
-  // Expand the stack, typically in response to an overflow condition
-  void expand();
+  // Committed segments are kept for the next marking cycle.
+  void setEmpty();
 
-  int  size() { return _index; }
-
-  void setEmpty()   { _index = 0; clear_overflow(); }
-
-  // Record the current index.
+  // Record the current state of the stack.
   void note_start_of_gc();
 
   // Make sure that we have not added any entries to the stack during GC.
   void note_end_of_gc();
 
-  // iterate over the oops in the mark stack, up to the bound recorded via
-  // the call above.
+  // iterate over the oops in the mark stack; only called at a safepoint
+  // between the calls above.
   void oops_do(OopClosure* f);
 };
 
@@ -402,6 +391,11 @@ protected:
 
   FreeRegionList        _cleanup_list;
 
+  // Regions to scan during the concurrent remembered set rebuild, selected
+  // in the cleanup pause (G1RebuildRemSetsConcurrently).
+  HeapRegion**          _rebuild_regions;
+  uint                  _num_rebuild_regions;
+
   // Concurrent marking support structures
   CMBitMap                _markBitMap1;
   CMBitMap                _markBitMap2;
@@ -462,6 +456,11 @@ protected:
   // time of remark.
   volatile bool           _concurrent_marking_in_progress;
 
+  // Class loader data found dead by the last remark, detached from the
+  // graph in the cleanup pause and deleted in a concurrent phase when
+  // G1PurgeClassLoaderDataConcurrently is set.
+  ClassLoaderData*        _unloaded_class_loader_data;
+
   // verbose level
   CMVerboseLevel          _verbose_level;
 
@@ -626,20 +625,8 @@ protected:
   bool _completed_initialization;
 
 public:
-  // Manipulation of the global mark stack.
-  // Notice that the first mark_stack_push is CAS-based, whereas the
-  // two below are Mutex-based. This is OK since the first one is only
-  // called during evacuation pauses and doesn't compete with the
-  // other two (which are called by the marking tasks during
-  // concurrent marking or remark).
-  bool mark_stack_push(oop p) {
-    _markStack.par_push(p);
-    if (_markStack.overflow()) {
-      set_has_overflown();
-      return false;
-    }
-    return true;
-  }
+  // Manipulation of the global mark stack. All of these are lock-free
+  // and may be used concurrently by the marking tasks.
   bool mark_stack_push(oop* arr, int n) {
     _markStack.par_push_arr(arr, n);
     if (_markStack.overflow()) {
@@ -773,6 +760,23 @@ public:
   void cleanup();
   void completeCleanup();
 
+  // Drop the remembered sets of the old regions that are not collection
+  // set candidates and prepare the rebuild of those of the candidates.
+  // Called in the cleanup pause.
+  void select_regions_for_rem_set_rebuild();
+  // Concurrently add the references from the live objects of all old and
+  // humongous regions into the candidates' remembered sets. The candidates
+  // may only be collected once this has completed.
+  void rebuild_rem_sets();
+
+  bool has_unloaded_class_loader_data() const {
+    return _unloaded_class_loader_data != NULL;
+  }
+  // Concurrently delete the class loader data detached in the cleanup
+  // pause, yielding to safepoints in between. Called by the concurrent
+  // mark thread after the concurrent cleanup.
+  void purge_class_loader_data();
+
   // Mark in the previous bitmap.  NB: this is usually read-only, so use
   // this carefully!
   inline void markPrev(oop p);
@@ -945,8 +949,8 @@ private:
     // references reaches this limit
     refs_reached_period           = 1024,
     // how many entries will be transferred between global stack and
-    // local queues
-    global_stack_transfer_size    = 16
+    // local queues: one chunk of the global stack
+    global_stack_transfer_size    = CMMarkStack::EntriesPerChunk
   };
 
   G1CMObjArrayProcessor       _objArray_processor;
@@ -26,12 +26,16 @@
 #include "gc_implementation/g1/concurrentMarkThread.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
+#include "gc_implementation/g1/g1ErgoVerbose.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1MMUTracker.hpp"
 #include "gc_implementation/g1/vm_operations_g1.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/vmThread.hpp"
+#ifdef LINUX
+#include "osContainer_linux.hpp"
+#endif
 
 // ======= Concurrent Mark Thread ========
 
@@ -45,7 +49,13 @@ ConcurrentMarkThread::ConcurrentMarkThread(ConcurrentMark* cm) :
   _cm(cm),
   _state(Idle),
   _vtime_accum(0.0),
-  _vtime_mark_accum(0.0) {
+  _vtime_mark_accum(0.0),
+  _last_periodic_uncommit_gc_count(0),
+  _next_periodic_uncommit_ms(0),
+  _next_memory_pressure_poll_ms(0) {
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  _next_periodic_uncommit_ms = now_ms + G1PeriodicUncommitInterval;
+  _next_memory_pressure_poll_ms = now_ms + G1MemoryPressurePollInterval;
   create_and_start();
 }
 
@@ -234,6 +244,53 @@ void ConcurrentMarkThread::run() {
       guarantee(cm()->cleanup_list_is_empty(),
                 "at this point there should be no regions on the cleanup list");
 
+      // Delete the class loader data unloaded by the remark pause and
+      // detached from the graph by the cleanup pause.
+      if (cm()->has_unloaded_class_loader_data()) {
+        double purge_start_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-class-unloading-start]");
+        }
+
+        _cm->purge_class_loader_data();
+
+        double purge_end_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-class-unloading-end, %1.7lf secs]",
+                                 purge_end_sec - purge_start_sec);
+        }
+      }
+
+      // Hand the regions freed by this cycle back to the OS if the heap
+      // is above its soft maximum size.
+      if (g1h->soft_max_heap_size() != 0 && !cm()->has_aborted() &&
+          g1h->capacity() > g1h->soft_max_heap_size()) {
+        VM_G1UncommitHeap op("concurrent cycle end");
+        VMThread::execute(&op);
+      }
+
+      // The next young GC may only start the mixed GCs once the remembered
+      // sets of the collection set candidates are complete, so rebuild
+      // them before recording that the cleanup has completed.
+      if (G1RebuildRemSetsConcurrently && !cm()->has_aborted()) {
+        double rebuild_start_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-rebuild-remset-start]");
+        }
+
+        _cm->rebuild_rem_sets();
+
+        double rebuild_end_sec = os::elapsedTime();
+        if (G1Log::fine()) {
+          gclog_or_tty->gclog_stamp(cm()->concurrent_gc_id());
+          gclog_or_tty->print_cr("[GC concurrent-rebuild-remset-end, %1.7lf secs]",
+                                 rebuild_end_sec - rebuild_start_sec);
+        }
+      }
+
       // There is a tricky race before recording that the concurrent
       // cleanup has completed and a potential Full GC starting around
       // the same time. We want to make sure that the Full GC calls
@@ -335,7 +392,14 @@ void ConcurrentMarkThread::sleepBeforeNextCycle() {
 
   MutexLockerEx x(CGC_lock, Mutex::_no_safepoint_check_flag);
   while (!started() && !_should_terminate) {
-    CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    jlong wait_ms = time_to_next_periodic_check();
+    if (wait_ms < 0) {
+      CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    } else if ((wait_ms == 0 || CGC_lock->wait(Mutex::_no_safepoint_check_flag, wait_ms)) &&
+               !started() && !_should_terminate) {
+      MutexUnlockerEx ul(CGC_lock, Mutex::_no_safepoint_check_flag);
+      do_periodic_checks();
+    }
   }
 
   if (started()) {
@@ -343,6 +407,121 @@ void ConcurrentMarkThread::sleepBeforeNextCycle() {
   }
 }
 
+void ConcurrentMarkThread::check_for_periodic_uncommit() {
+  assert(G1PeriodicUncommitInterval != 0, "should not be called otherwise");
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  // The heap counts as idle if no GC happened during the last interval.
+  uint gc_count = g1h->total_collections();
+  bool idle = gc_count == _last_periodic_uncommit_gc_count;
+  _last_periodic_uncommit_gc_count = gc_count;
+
+  if (idle && g1h->capacity() > g1h->soft_max_heap_size()) {
+    VM_G1UncommitHeap op("periodic uncommit");
+    VMThread::execute(&op);
+  }
+}
+
+jlong ConcurrentMarkThread::time_to_next_periodic_check() const {
+  jlong next_ms = max_jlong;
+  if (G1PeriodicUncommitInterval != 0) {
+    next_ms = MIN2(next_ms, _next_periodic_uncommit_ms);
+  }
+  if (G1MemoryPressurePollInterval != 0) {
+    next_ms = MIN2(next_ms, _next_memory_pressure_poll_ms);
+  }
+  if (next_ms == max_jlong) {
+    return -1;
+  }
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  return MAX2(next_ms - now_ms, (jlong) 0);
+}
+
+void ConcurrentMarkThread::do_periodic_checks() {
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  if (G1PeriodicUncommitInterval != 0 && now_ms >= _next_periodic_uncommit_ms) {
+    _next_periodic_uncommit_ms = now_ms + G1PeriodicUncommitInterval;
+    check_for_periodic_uncommit();
+  }
+  if (G1MemoryPressurePollInterval != 0 && now_ms >= _next_memory_pressure_poll_ms) {
+    _next_memory_pressure_poll_ms = now_ms + G1MemoryPressurePollInterval;
+    check_memory_pressure();
+  }
+}
+
+void ConcurrentMarkThread::check_memory_pressure() {
+  assert(G1MemoryPressurePollInterval != 0, "should not be called otherwise");
+#ifdef LINUX
+  if (!OSContainer::is_containerized()) {
+    return;
+  }
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+  // Under pressure when less than 10% of the container memory limit is
+  // left or tasks stalled on memory for longer than the threshold; the
+  // pressure is gone once more than 20% is left and the stalls dropped
+  // below half the threshold. Pressure stall information is only
+  // available with cgroup v2, memory usage works with both versions.
+  jlong limit = OSContainer::memory_limit_in_bytes();
+  jlong usage = OSContainer::memory_usage_in_bytes();
+  double stall_perc = OSContainer::memory_pressure();
+  bool has_usage = limit > 0 && usage > 0;
+  bool has_stalls = stall_perc >= 0.0;
+  if (!has_usage && !has_stalls) {
+    return;
+  }
+
+  bool under_pressure =
+    (has_usage && usage > limit - limit / 10) ||
+    (has_stalls && stall_perc >= (double) G1MemoryPressureThreshold);
+  bool relieved =
+    (!has_usage || usage < limit - limit / 5) &&
+    (!has_stalls || stall_perc < (double) G1MemoryPressureThreshold / 2.0);
+
+  const size_t max_soft_bytes = G1SoftMaxHeapSize != 0 ? (size_t) G1SoftMaxHeapSize
+                                                       : g1h->max_capacity();
+  const size_t min_soft_bytes = align_size_up(g1h->g1_policy()->min_heap_byte_size(),
+                                              HeapRegion::GrainBytes);
+  const size_t step_bytes = align_size_up(max_soft_bytes / 8, HeapRegion::GrainBytes);
+
+  size_t soft_bytes = g1h->soft_max_heap_size();
+  if (soft_bytes == 0) {
+    soft_bytes = max_soft_bytes;
+  }
+  size_t new_soft_bytes = soft_bytes;
+  if (under_pressure) {
+    // Step down from what is committed, so the uncommit below always
+    // gives memory back while the pressure lasts.
+    size_t current_bytes = MIN2(soft_bytes, g1h->capacity());
+    new_soft_bytes = current_bytes > min_soft_bytes + step_bytes ?
+                     current_bytes - step_bytes : min_soft_bytes;
+  } else if (relieved) {
+    new_soft_bytes = MIN2(soft_bytes + step_bytes, max_soft_bytes);
+  }
+  if (new_soft_bytes == soft_bytes) {
+    return;
+  }
+
+  ergo_verbose6(ErgoHeapSizing,
+                "change soft max heap size",
+                ergo_format_str("reason")
+                ergo_format_byte("memory usage")
+                ergo_format_byte("memory limit")
+                ergo_format_perc("memory stalls")
+                ergo_format_byte("soft max heap size")
+                ergo_format_byte("new soft max heap size"),
+                under_pressure ? "container under memory pressure"
+                               : "container memory pressure relieved",
+                (size_t) MAX2(usage, (jlong) 0), (size_t) MAX2(limit, (jlong) 0),
+                MAX2(stall_perc, 0.0), soft_bytes, new_soft_bytes);
+  g1h->set_soft_max_heap_size(new_soft_bytes);
+
+  if (g1h->capacity() > new_soft_bytes) {
+    VM_G1UncommitHeap op("memory pressure");
+    VMThread::execute(&op);
+  }
+#endif // LINUX
+}
+
 // Note: As is the case with CMS - this method, although exported
 // by the ConcurrentMarkThread, which is a non-JavaThread, can only
 // be called by a JavaThread. Currently this is done at vm creation
@@ -41,6 +41,14 @@ class ConcurrentMarkThread: public ConcurrentGCThread {
 
   double _vtime_mark_accum;
 
+  // Collection count seen by the last periodic uncommit check.
+  uint   _last_periodic_uncommit_gc_count;
+
+  // Times (in ms) at which the next periodic uncommit and memory
+  // pressure checks are due.
+  jlong  _next_periodic_uncommit_ms;
+  jlong  _next_memory_pressure_poll_ms;
+
  public:
   virtual void run();
 
@@ -56,6 +64,17 @@ class ConcurrentMarkThread: public ConcurrentGCThread {
   volatile State _state;
 
   void sleepBeforeNextCycle();
+  // Uncommit down to G1SoftMaxHeapSize if no GC happened since the
+  // previous check.
+  void check_for_periodic_uncommit();
+  // Lower the soft max heap size and uncommit while the container is
+  // close to its memory limit or stalls on memory, raise it again once
+  // the pressure is gone.
+  void check_memory_pressure();
+  // Milliseconds until the next periodic check is due, -1 if none is
+  // enabled.
+  jlong time_to_next_periodic_check() const;
+  void do_periodic_checks();
 
   static SurrogateLockerThread*         _slt;
 
@@ -45,12 +45,82 @@ bool DirtyCardQueue::apply_closure(CardTableEntryClosure* cl,
   return res;
 }
 
+// The cards seen so far are remembered in a small direct-mapped table, so
+// a repeat is only detected while its slot has not been taken by another
+// card. This misses some duplicates but never drops a card that is not.
+void DirtyCardQueue::deduplicate() {
+  if (_buf == NULL) {
+    return;
+  }
+
+  const size_t table_size = 256;
+  jbyte* seen[table_size];
+  memset(seen, 0, sizeof(seen));
+
+  size_t i = _sz;
+  size_t new_index = _sz;
+  while (i > _index) {
+    i -= oopSize;
+    void** p = &_buf[byte_index_to_index((int) i)];
+    jbyte* card_ptr = (jbyte*) *p;
+    *p = NULL;
+    if (card_ptr == NULL) {
+      continue;
+    }
+    size_t slot = ((uintptr_t) card_ptr ^ ((uintptr_t) card_ptr >> 8)) & (table_size - 1);
+    if (seen[slot] == card_ptr) {
+      continue;
+    }
+    seen[slot] = card_ptr;
+    new_index -= oopSize;
+    assert(new_index >= i, "we always compact 'up'");
+    _buf[byte_index_to_index((int) new_index)] = card_ptr;
+  }
+  _index = new_index;
+}
+
+bool DirtyCardQueue::should_enqueue_buffer() {
+  assert(_lock == NULL || _lock->owned_by_self(),
+         "we should have taken the lock before calling this");
+  assert(_index == 0, "pre-condition");
+  assert(_buf != NULL, "pre-condition");
+
+  if (!G1DeduplicateUpdateBuffers) {
+    return true;
+  }
+
+  deduplicate();
+
+  // Keep the buffer only if at least half of it was freed, so that a
+  // buffer with few repeats is not deduplicated again after a handful of
+  // further enqueues.
+  size_t retained_entries = (_sz - _index) / oopSize;
+  size_t all_entries = _sz / oopSize;
+  return retained_entries * 2 > all_entries;
+}
+
+bool CardTableEntryClosure::do_card_buffer(jbyte** cards, size_t num,
+                                           uint worker_i) {
+  for (size_t i = 0; i < num; i++) {
+    jbyte* card_ptr = cards[i];
+    if (card_ptr != NULL) {
+      cards[i] = NULL;
+      if (!do_card_ptr(card_ptr, worker_i)) return false;
+    }
+  }
+  return true;
+}
+
 bool DirtyCardQueue::apply_closure_to_buffer(CardTableEntryClosure* cl,
                                              void** buf,
                                              size_t index, size_t sz,
                                              bool consume,
                                              uint worker_i) {
   if (cl == NULL) return true;
+  if (consume) {
+    jbyte** cards = (jbyte**)&buf[byte_index_to_index((int)index)];
+    return cl->do_card_buffer(cards, (sz - index) / oopSize, worker_i);
+  }
   for (size_t i = index; i < sz; i += oopSize) {
     int ind = byte_index_to_index((int)i);
     jbyte* card_ptr = (jbyte*)buf[ind];
@@ -37,6 +37,12 @@ public:
   // Process the card whose card table entry is "card_ptr".  If returns
   // "false", terminate the iteration early.
   virtual bool do_card_ptr(jbyte* card_ptr, uint worker_i = 0) = 0;
+
+  // Process the non-NULL cards in "cards[0, num)", setting each processed
+  // entry to NULL. Closures may process the entries in any order. If
+  // returns "false", terminate early; the remaining entries are processed
+  // when the buffer is considered again.
+  virtual bool do_card_buffer(jbyte** cards, size_t num, uint worker_i);
 };
 
 // A ptrQueue whose elements are "oops", pointers to object heads.
@@ -54,6 +60,15 @@ public:
   // Process queue entries and release resources.
   void flush() { flush_impl(); }
 
+  // Removes repeated cards from the buffer, compacting the remaining
+  // entries toward its top. Only the first entry of a card is kept, so
+  // no card is lost: the buffer has not been handed to refinement yet.
+  void deduplicate();
+
+  // With G1DeduplicateUpdateBuffers, deduplicates a full buffer and keeps
+  // using it if that freed enough of it.
+  virtual bool should_enqueue_buffer();
+
   // Apply the closure to all elements, and reset the index to make the
   // buffer empty.  If a closure application returns "false", return
   // "false" immediately, halting the iteration.  If "consume" is true,
@@ -20,10 +20,13 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
 #include "gc_implementation/g1/elasticHeap.hpp"
 #include "gc_implementation/g1/concurrentMarkThread.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/activeProcessorTracker.hpp"
 #include "runtime/init.hpp"
 #include "runtime/javaCalls.hpp"
 
@@ -283,8 +286,10 @@ public:
 };
 
 void ElasticHeapConcThread::par_work_on_regions(FreeRegionList* list, HeapRegionClosure* cl) {
-  _parallel_workers->set_active_workers((int)_parallel_worker_threads);
-  ElasticHeapParTask task(list, cl, _parallel_worker_threads);
+  // The workers are sized like the concurrent GC workers
+  uint n_workers = ActiveProcessorTracker::limit_conc_workers(_parallel_worker_threads);
+  _parallel_workers->set_active_workers((int)n_workers);
+  ElasticHeapParTask task(list, cl, n_workers);
   _parallel_workers->run_task(&task);
 }
 
@@ -394,7 +399,9 @@ ElasticHeapGCStats::ElasticHeapGCStats(ElasticHeap* elas, G1CollectedHeap* g1h)
     _need_mixed_gc(false),
     _last_initial_mark_interval_s(0.0),
     _last_initial_mark_non_young_bytes(0),
-    _last_normalized_eden_consumed_length(0) {
+    _last_normalized_eden_consumed_length(0),
+    _recent_alloc_rate_ms(new TruncatedSeq(GC_INTERVAL_SEQ_LENGTH)),
+    _alloc_spike(false) {
 }
 
 void ElasticHeapGCStats::track_gc_start(bool full_gc) {
@@ -446,6 +453,17 @@ void ElasticHeapGCStats::track_gc_start(bool full_gc) {
     _recent_ygc_normalized_interval_ms->add(normalized_interval * MILLIUNITS);
     _last_normalized_eden_consumed_length = available_young_length;
   }
+
+  _alloc_spike = false;
+  if (!full_gc && eden_consumed_length != 0 && gc_interval_s > 0.0) {
+    double alloc_rate_ms = (double)eden_consumed_length / (gc_interval_s * MILLIUNITS);
+    // Compare with the average of the intervals before this one
+    if (_recent_alloc_rate_ms->num() >= GC_INTERVAL_SEQ_LENGTH / 2) {
+      _alloc_spike = alloc_rate_ms >
+                     _recent_alloc_rate_ms->avg() * (100 + ElasticHeapAllocSpikePercent) / 100;
+    }
+    _recent_alloc_rate_ms->add(alloc_rate_ms);
+  }
 }
 
 bool ElasticHeapGCStats::check_mixed_gc_finished() {
@@ -595,12 +613,23 @@ ElasticHeap::ElasticHeap(G1CollectedHeap* g1h) : _g1h(g1h),
     _in_conc_cycle(false),
     _conc_thread(NULL),
     _configure_setting_lock(0),
-    _heap_capacity_changed(false) {
+    _heap_capacity_changed(false),
+    _standby_list("Elastic Heap standby list", new MasterFreeRegionListMtSafeChecker()),
+    _refilling_standby(false),
+    _regions_per_chunk(1),
+    _region_numa_node(NULL),
+    _numa_node_ids(NULL),
+    _num_numa_nodes(0) {
 
   _orig_max_desired_young_length = _g1h->g1_policy()->_young_gen_sizer->max_desired_young_length();
   _orig_min_desired_young_length = _g1h->g1_policy()->_young_gen_sizer->min_desired_young_length();
   _orig_ihop = InitiatingHeapOccupancyPercent;
 
+  if (ElasticHeapUncommitAlignment > HeapRegion::GrainBytes) {
+    _regions_per_chunk = (uint)(ElasticHeapUncommitAlignment / HeapRegion::GrainBytes);
+  }
+  initialize_numa();
+
   _conc_thread = new ElasticHeapConcThread(this);
   _conc_thread->start();
 
@@ -608,11 +637,102 @@ ElasticHeap::ElasticHeap(G1CollectedHeap* g1h) : _g1h(g1h),
   _setting = new ElasticHeapSetting(this, g1h);
 
   _evaluators[InactiveMode] = new RecoverEvaluator(this);
-  _evaluators[PeriodicUncommitMode] = new PeriodicEvaluator(this);
+  if (ElasticHeapPeriodicPredictive) {
+    _evaluators[PeriodicUncommitMode] = new PredictiveEvaluator(this);
+  } else {
+    _evaluators[PeriodicUncommitMode] = new PeriodicEvaluator(this);
+  }
   _evaluators[GenerationLimitMode] = new GenerationLimitEvaluator(this);
   _evaluators[SoftmxMode] = new SoftmxEvaluator(this);
 }
 
+void ElasticHeap::initialize_numa() {
+  if (!UseNUMA || !ElasticHeapNUMAAware) {
+    return;
+  }
+  size_t num_nodes = os::numa_get_groups_num();
+  if (num_nodes <= 1) {
+    return;
+  }
+  _numa_node_ids = NEW_C_HEAP_ARRAY(int, num_nodes, mtGC);
+  _num_numa_nodes = (uint)os::numa_get_leaf_groups(_numa_node_ids, num_nodes);
+  if (_num_numa_nodes <= 1) {
+    FREE_C_HEAP_ARRAY(int, _numa_node_ids, mtGC);
+    _numa_node_ids = NULL;
+    _num_numa_nodes = 0;
+    return;
+  }
+  _region_numa_node = NEW_C_HEAP_ARRAY(int, _g1h->max_regions(), mtGC);
+  for (uint i = 0; i < _g1h->max_regions(); i++) {
+    // Interleave the chunks until the regions are recommitted
+    _region_numa_node[i] = _numa_node_ids[(i / _regions_per_chunk) % _num_numa_nodes];
+  }
+}
+
+int ElasticHeap::numa_node_index(int lgrp_id) const {
+  for (uint i = 0; i < _num_numa_nodes; i++) {
+    if (_numa_node_ids[i] == lgrp_id) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+void ElasticHeap::assign_numa_nodes(FreeRegionList* list) {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  if (!numa_aware() || list->is_empty()) {
+    return;
+  }
+
+  ResourceMark rm;
+  uint* threads_per_node = NEW_RESOURCE_ARRAY(uint, _num_numa_nodes);
+  uint total_threads = 0;
+  for (uint i = 0; i < _num_numa_nodes; i++) {
+    threads_per_node[i] = 0;
+  }
+  for (JavaThread* t = Threads::first(); t != NULL; t = t->next()) {
+    int index = numa_node_index(t->lgrp_id());
+    if (index >= 0) {
+      threads_per_node[index]++;
+      total_threads++;
+    }
+  }
+  if (total_threads == 0) {
+    // No placement information, spread chunks evenly
+    for (uint i = 0; i < _num_numa_nodes; i++) {
+      threads_per_node[i] = 1;
+    }
+    total_threads = _num_numa_nodes;
+  }
+
+  // Chunk k of n goes to the node whose share of Java threads covers the
+  // position (k + 0.5) / n, so nodes get chunks in proportion to their threads.
+  uint num_chunks = (list->length() + _regions_per_chunk - 1) / _regions_per_chunk;
+  uint chunk = 0;
+  uint last_chunk_index = (uint)-1;
+  int node = _numa_node_ids[0];
+  FreeRegionListIterator iter(list);
+  while (iter.more_available()) {
+    HeapRegion* hr = iter.get_next();
+    uint chunk_index = hr->hrm_index() / _regions_per_chunk;
+    if (chunk_index != last_chunk_index) {
+      double position = ((double)chunk + 0.5) * total_threads / num_chunks;
+      uint covered = 0;
+      for (uint i = 0; i < _num_numa_nodes; i++) {
+        covered += threads_per_node[i];
+        if (position < covered) {
+          node = _numa_node_ids[i];
+          break;
+        }
+      }
+      last_chunk_index = chunk_index;
+      chunk = MIN2(chunk + 1, num_chunks - 1);
+    }
+    _region_numa_node[hr->hrm_index()] = node;
+  }
+}
+
 void ElasticHeap::destroy() {
   _conc_thread->stop();
   ElasticHeapTimer::stop();
@@ -671,7 +791,8 @@ void ElasticHeap::check_to_trigger_ygc() {
 
 uint ElasticHeap::num_unavailable_regions() {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
-  return _g1h->_hrm.num_uncommitted_regions() + _conc_thread->total_unavaiable_regions();
+  return _g1h->_hrm.num_uncommitted_regions() + _conc_thread->total_unavaiable_regions() +
+         _standby_list.length();
 }
 
 int ElasticHeap::young_commit_percent() const {
@@ -679,8 +800,7 @@ int ElasticHeap::young_commit_percent() const {
     // Specify by jcmd/mxbean
     return _setting->young_percent();
   } else {
-    uint uncommitted_young_length = _g1h->_hrm.num_uncommitted_regions() + _conc_thread->uncommit_list()->length();
-    return (max_young_length() - uncommitted_young_length) * 100 / max_young_length();
+    return (max_young_length() - unavailable_young_length()) * 100 / max_young_length();
   }
 }
 
@@ -734,6 +854,12 @@ void ElasticHeap::uncommit_region_memory(HeapRegion* hr) {
 
 void ElasticHeap::commit_region_memory(HeapRegion* hr, bool pretouch) {
   _g1h->_hrm.commit_region_memory(hr->hrm_index());
+  if (numa_aware()) {
+    // Bind the memory before it is touched, otherwise the pages would be
+    // placed on the node of the elastic heap worker doing the pretouch
+    os::numa_make_local((char*)hr->bottom(), HeapRegion::GrainBytes,
+                        _region_numa_node[hr->hrm_index()]);
+  }
   if (pretouch) {
     os::pretouch_memory((char*)hr->bottom(), (char*)hr->bottom() + HeapRegion::GrainBytes);
   }
@@ -801,9 +927,15 @@ void ElasticHeap::move_regions_back_to_hrm() {
   }
 
   if (!_conc_thread->commit_list()->is_empty()) {
-    _g1h->_hrm.move_to_free_list(_conc_thread->commit_list());
-    need_update_expanded_size = true;
+    if (_refilling_standby) {
+      // Committed and pretouched in the background, keep them out of the young gen
+      _standby_list.add_ordered(_conc_thread->commit_list());
+    } else {
+      _g1h->_hrm.move_to_free_list(_conc_thread->commit_list());
+      need_update_expanded_size = true;
+    }
   }
+  _refilling_standby = false;
 
   if (!_conc_thread->to_free_list()->is_empty()) {
     _g1h->_hrm.move_to_free_list(_conc_thread->to_free_list());
@@ -858,6 +990,7 @@ void ElasticHeap::wait_to_recover() {
   assert(_g1h->full_collection(), "Precondition");
 
   wait_for_conc_cycle_end();
+  drain_standby_regions();
 
   _g1h->_hrm.recover_uncommitted_regions();
 
@@ -890,7 +1023,7 @@ void ElasticHeap::update_expanded_heap_size() {
     assert(committed_num == _g1h->num_regions(), "sanity");
     change_heap_capacity(committed_num);
   } else {
-    update_desired_young_length(_g1h->_hrm.num_uncommitted_regions());
+    update_desired_young_length(unavailable_young_length());
   }
 }
 
@@ -899,6 +1032,17 @@ void ElasticHeap::perform_after_young_collection() {
   assert_at_safepoint(true /* should_be_vm_thread */);
   _setting->set_need_gc(false);
 
+  if (_stats->alloc_spike() && !_standby_list.is_empty()) {
+    // Grow the young gen at once instead of waiting for a commit,
+    // the pool is refilled by ElasticHeapConcThread afterwards
+    if (PrintGCDetails && PrintElasticHeapDetails) {
+      gclog_or_tty->print("(Elastic Heap detects allocation spike)");
+    }
+    drain_standby_regions();
+  }
+
+  step_tenant_heap_limits();
+
   if (!in_conc_cycle()) {
     // Do evaluation whether to resize or not, to start the new conc cycle
     evaluate_elastic_work();
@@ -913,7 +1057,9 @@ void ElasticHeap::perform_after_full_collection() {
   _setting->set_need_gc(false);
 
   assert(!in_conc_cycle(), "sanity");
+  step_tenant_heap_limits();
   if (evaluation_mode() == SoftmxMode || evaluation_mode() == InactiveMode) {
+    drain_standby_regions();
     _evaluators[evaluation_mode()]->evaluate();
     _conc_thread->do_memory_job_after_full_collection();
     move_regions_back_to_hrm();
@@ -922,21 +1068,36 @@ void ElasticHeap::perform_after_full_collection() {
   record_gc_end();
 }
 
+void ElasticHeap::step_tenant_heap_limits() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  if (!TenantHeapThrottling) {
+    return;
+  }
+  uint stepped = G1TenantAllocationContexts::step_heap_size_limits();
+  if (stepped != 0 && PrintGCDetails && PrintElasticHeapDetails) {
+    gclog_or_tty->print("(Elastic Heap lowers heap limits of %u tenants)", stepped);
+  }
+}
 
 void ElasticHeap::evaluate_elastic_work() {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
+  if (evaluation_mode() != PeriodicUncommitMode) {
+    // Only periodic uncommit keeps standby regions
+    drain_standby_regions();
+  }
+
   _evaluators[evaluation_mode()]->evaluate();
 
+  try_refilling_standby();
   try_starting_conc_cycle();
 }
 
 void ElasticHeap::update_desired_young_length(uint unavailable_young_length) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
-  assert(unavailable_young_length ==
-         (_g1h->_hrm.num_uncommitted_regions() + _conc_thread->uncommit_list()->length()),
-         "sanity");
+  assert(unavailable_young_length == this->unavailable_young_length(), "sanity");
 
   uint max_young_length = _orig_max_desired_young_length - unavailable_young_length;
   _g1h->g1_policy()->_young_gen_sizer->resize_max_desired_young_length(max_young_length);
@@ -947,6 +1108,75 @@ void ElasticHeap::update_desired_young_length(uint unavailable_young_length) {
   }
 }
 
+uint ElasticHeap::unavailable_young_length() const {
+  uint length = _g1h->_hrm.num_uncommitted_regions() + _conc_thread->uncommit_list()->length() +
+                _standby_list.length();
+  if (_refilling_standby) {
+    length += _conc_thread->commit_list()->length();
+  }
+  return length;
+}
+
+uint ElasticHeap::standby_target_length() const {
+  return (uint)(max_young_length() * ElasticHeapStandbyPercent / 100);
+}
+
+uint ElasticHeap::release_standby_regions(uint num) {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  num = MIN2(num, _standby_list.length());
+  if (num == 0) {
+    return 0;
+  }
+  FreeRegionList list("Elastic Heap standby release list");
+  for (uint i = 0; i < num; i++) {
+    list.add_ordered(_standby_list.remove_region(true /* from_head */));
+  }
+  // Already committed, so they are available right away
+  _g1h->_hrm.move_to_free_list(&list);
+  update_desired_young_length(unavailable_young_length());
+
+  if (PrintGCDetails && PrintElasticHeapDetails) {
+    gclog_or_tty->print("(Elastic Heap grows young gen by %u standby regions)", num);
+  }
+  return num;
+}
+
+void ElasticHeap::keep_standby_regions() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  if (evaluation_mode() != PeriodicUncommitMode ||
+      _standby_list.length() >= standby_target_length()) {
+    return;
+  }
+  // The uncommit list is ordered and made of whole chunks, so taking
+  // whole chunks from its head keeps huge pages intact
+  FreeRegionList* uncommit_list = _conc_thread->uncommit_list();
+  uint num = (uint)align_size_down(standby_target_length() - _standby_list.length(), _regions_per_chunk);
+  num = MIN2(num, uncommit_list->length());
+  for (uint i = 0; i < num; i++) {
+    _standby_list.add_ordered(uncommit_list->remove_region(true /* from_head */));
+  }
+}
+
+void ElasticHeap::try_refilling_standby() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  if (evaluation_mode() != PeriodicUncommitMode ||
+      _conc_thread->total_unavaiable_regions() != 0) {
+    // Not periodic uncommit, or the evaluation already started a memory job
+    return;
+  }
+  uint target = standby_target_length();
+  uint uncommitted = _g1h->_hrm.num_uncommitted_regions();
+  if (_standby_list.length() >= target || uncommitted == 0) {
+    return;
+  }
+  if (commit_regions(MIN2(target - _standby_list.length(), uncommitted)) != 0) {
+    _refilling_standby = true;
+  }
+}
+
 void ElasticHeap::set_heap_capacity_changed(uint num) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
@@ -1045,8 +1275,9 @@ void ElasticHeap::resize_young_length(uint target_length) {
   assert(Universe::heap()->is_gc_active(), "should only be called during gc");
   assert_at_safepoint(true /* should_be_vm_thread */);
 
+  // Standby regions count as uncommitted here, they are just quicker to get back
   uint target_uncommitted_length = max_young_length() - target_length;
-  uint old_num_uncommitted = _g1h->_hrm.num_uncommitted_regions();
+  uint old_num_uncommitted = unavailable_young_length();
 
   if (old_num_uncommitted == target_uncommitted_length) {
     // No more regions need to be commit/uncommit
@@ -1061,35 +1292,46 @@ void ElasticHeap::resize_young_length(uint target_length) {
 
     if (!enough_free_regions_to_uncommit(new_uncommitted_length)) {
       if (_setting->young_percent_set()) {
-        _setting->set_young_percent((max_young_length() - _g1h->_hrm.num_uncommitted_regions()) * 100 / max_young_length());
+        _setting->set_young_percent((max_young_length() - old_num_uncommitted) * 100 / max_young_length());
       }
       return;
     }
     // Move regions out of free list
-    uncommit_regions(new_uncommitted_length);
-    update_desired_young_length(target_uncommitted_length);
+    uint uncommitted = uncommit_regions(new_uncommitted_length);
+    if (uncommitted == 0) {
+      return;
+    }
+    keep_standby_regions();
+    update_desired_young_length(unavailable_young_length());
   } else {
     // Expand young gen
     assert(old_num_uncommitted > target_uncommitted_length, "sanity");
-    // Move regions out of uncommitted young list
-    commit_regions(old_num_uncommitted - target_uncommitted_length);
+    uint num = old_num_uncommitted - target_uncommitted_length;
+    // Standby regions first, they need no commit
+    num -= release_standby_regions(num);
+    if (num > 0) {
+      // Move regions out of uncommitted young list
+      commit_regions(num);
+    }
   }
 }
 
-void ElasticHeap::uncommit_regions(uint num) {
+uint ElasticHeap::uncommit_regions(uint num) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
   guarantee(_conc_thread->uncommit_list()->is_empty() && _conc_thread->commit_list()->is_empty(), "sanity");
 
-  _g1h->_hrm.prepare_uncommit_regions(_conc_thread->uncommit_list(), num);
+  return _g1h->_hrm.prepare_uncommit_regions(_conc_thread->uncommit_list(), num, _regions_per_chunk);
 }
 
-void ElasticHeap::commit_regions(uint num) {
+uint ElasticHeap::commit_regions(uint num) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
   guarantee(_conc_thread->uncommit_list()->is_empty() && _conc_thread->commit_list()->is_empty(), "sanity");
 
-  _g1h->_hrm.prepare_commit_regions(_conc_thread->commit_list(), num);
+  uint committed = _g1h->_hrm.prepare_commit_regions(_conc_thread->commit_list(), num, _regions_per_chunk);
+  assign_numa_nodes(_conc_thread->commit_list());
+  return committed;
 }
 
 uint ElasticHeap::max_available_survivor_regions() {
@@ -1206,6 +1448,58 @@ ElasticHeap::ErrorType ElasticHeap::configure_setting(uint young_percent, uint u
   return NoError;
 }
 
+class TenantHeapLimitClosure : public G1TenantAllocationContextClosure {
+private:
+  jlong   _tenant_id;
+  size_t  _new_limit;   // TENANT_HEAP_NO_LIMIT to only query the limit
+  size_t  _limit;
+  bool    _found;
+public:
+  TenantHeapLimitClosure(jlong tenant_id, size_t new_limit) :
+    _tenant_id(tenant_id), _new_limit(new_limit), _limit(TENANT_HEAP_NO_LIMIT), _found(false) { }
+
+  virtual void do_tenant_allocation_context(G1TenantAllocationContext* tac) {
+    if (_found || com_alibaba_tenant_TenantContainer::get_tenant_id(tac->tenant_container()) != _tenant_id) {
+      return;
+    }
+    if (_new_limit != TENANT_HEAP_NO_LIMIT) {
+      tac->set_heap_size_target(_new_limit);
+    }
+    _limit = tac->heap_size_target();
+    _found = true;
+  }
+
+  size_t limit() const { return _limit; }
+  bool found() const   { return _found; }
+};
+
+ElasticHeap::ErrorType ElasticHeap::configure_tenant_heap_limit(jlong tenant_id, size_t limit) {
+  // Called from Java thread or listener thread
+  assert(!Thread::current()->is_VM_thread(), "Should not be called in VM thread, either called from JCMD or MXBean");
+  assert(TenantHeapThrottling, "Precondition");
+  assert(limit != TENANT_HEAP_NO_LIMIT, "sanity");
+
+  // No GC is needed: the limit shrinks at once if the tenant's usage allows,
+  // otherwise in steps after the following GCs
+  MutexLocker ml(Heap_lock);
+  TenantHeapLimitClosure cl(tenant_id, limit);
+  G1TenantAllocationContexts::iterate(&cl);
+  return cl.found() ? NoError : IllegalTenant;
+}
+
+ElasticHeap::ErrorType ElasticHeap::tenant_heap_limit(jlong tenant_id, size_t* limit) {
+  assert(TenantHeapThrottling, "Precondition");
+
+  MutexLocker ml(Heap_lock);
+  TenantHeapLimitClosure cl(tenant_id, TENANT_HEAP_NO_LIMIT);
+  G1TenantAllocationContexts::iterate(&cl);
+  if (!cl.found()) {
+    return IllegalTenant;
+  }
+  *limit = cl.limit();
+  return NoError;
+}
+
 bool ElasticHeap::ready_to_uncommit_after_mixed_gc() {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
@@ -1379,7 +1673,51 @@ void PeriodicEvaluator::evaluate_young() {
   target_max_young_list_length = MAX2(target_max_young_list_length, min_young_list_length);
   target_max_young_list_length = MIN2(target_max_young_list_length, _elas->max_young_length());
 
-  _elas->resize_young_length(target_max_young_list_length);
+  resize_young(target_max_young_list_length);
+}
+
+void PeriodicEvaluator::resize_young(uint target_length) {
+  _elas->resize_young_length(target_length);
+}
+
+double PredictiveEvaluator::predict_alloc_rate_ms() {
+  // Decaying prediction, or the linear trend of recent samples if the
+  // allocation rate is rising faster than the decaying average follows
+  TruncatedSeq* seq = _g1_policy->_alloc_rate_ms_seq;
+  return MAX2(_g1_policy->predict_alloc_rate_ms(), seq->predict_next());
+}
+
+void PredictiveEvaluator::evaluate_young() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+
+  _predicted_young_length = 0;
+  if (ElasticHeapPeriodicYGCIntervalMillis == 0 ||
+      _g1_policy->_alloc_rate_ms_seq->num() < GC_INTERVAL_SEQ_LENGTH) {
+    PeriodicEvaluator::evaluate_young();
+    return;
+  }
+
+  // Eden regions to be consumed in ElasticHeapPeriodicYGCIntervalMillis
+  // at the forecast rate, plus the survivors after this gc
+  double alloc_rate_ms = predict_alloc_rate_ms();
+  double predicted = ceil(alloc_rate_ms * ElasticHeapPeriodicYGCIntervalMillis) +
+                     _g1h->young_list()->length();
+  _predicted_young_length = (uint)MIN2(predicted, (double)_elas->max_young_length());
+
+  if (_predicted_young_length > _elas->calculate_young_list_desired_max_length()) {
+    if (PrintGCDetails && PrintElasticHeapDetails) {
+      gclog_or_tty->print("(Elastic Heap predicts %.3f regions/ms allocation rate)", alloc_rate_ms);
+    }
+    _elas->resize_young_length(_predicted_young_length);
+    return;
+  }
+
+  PeriodicEvaluator::evaluate_young();
+}
+
+void PredictiveEvaluator::resize_young(uint target_length) {
+  // Never shrink below what the forecast allocation rate needs
+  PeriodicEvaluator::resize_young(MAX2(target_length, _predicted_young_length));
 }
 
 bool PeriodicEvaluator::ready_to_initial_mark() {
@@ -1457,8 +1795,11 @@ void SoftmxEvaluator::evaluate() {
     uint regions_to_uncommit = _g1h->num_regions() - target_heap_regions;
     assert(_g1h->num_free_regions() >= regions_to_uncommit, "sanity");
 
-    _elas->uncommit_regions(regions_to_uncommit);
-    _elas->change_heap_capacity(target_heap_regions);
+    // Fewer regions may be uncommitted if free regions don't cover whole chunks
+    if (_elas->uncommit_regions(regions_to_uncommit) == 0) {
+      return;
+    }
+    _elas->change_heap_capacity(_g1h->num_regions());
   }
 }
 
@@ -163,6 +163,25 @@ public:
   virtual void        evaluate_young();
   virtual void        evaluate_old()          { evaluate_old_common(); }
   virtual bool        ready_to_initial_mark();
+protected:
+  virtual void        resize_young(uint target_length);
+};
+
+// PredictiveEvaluator:
+// Periodic uncommit which forecasts the allocation rate from the decaying
+// history in G1CollectorPolicy, so young regions are committed before the
+// rate rises instead of after the young gc interval has dropped
+class PredictiveEvaluator : public PeriodicEvaluator {
+private:
+  // Young length needed by the forecast allocation rate in last evaluation
+  uint                _predicted_young_length;
+  double              predict_alloc_rate_ms();
+public:
+  PredictiveEvaluator(ElasticHeap* eh)
+    : PeriodicEvaluator(eh), _predicted_young_length(0) {}
+  virtual void        evaluate_young();
+protected:
+  virtual void        resize_young(uint target_length);
 };
 
 class GenerationLimitEvaluator : public ElasticHeapEvaluator {
@@ -229,6 +248,10 @@ public:
   void                track_gc_start(bool full_gc);
 
   bool                check_mixed_gc_finished();
+
+  // The allocation rate of the last gc interval rose more than
+  // ElasticHeapAllocSpikePercent over the recent average
+  bool                alloc_spike() const            { return _alloc_spike; }
 private:
   ElasticHeap*        _elas;
   G1CollectedHeap*    _g1h;
@@ -252,6 +275,9 @@ private:
   size_t              _last_initial_mark_non_young_bytes;
   // Number of eden regions consumed in last gc interval(normalized)
   uint                _last_normalized_eden_consumed_length;
+  // Eden regions consumed per ms in recent gc intervals
+  TruncatedSeq*       _recent_alloc_rate_ms;
+  bool                _alloc_spike;
 };
 
 class ElasticHeapSetting;
@@ -262,6 +288,7 @@ class ElasticHeap : public CHeapObj<mtGC> {
 friend class ElasticHeapEvaluator;
 friend class RecoverEvaluator;
 friend class PeriodicEvaluator;
+friend class PredictiveEvaluator;
 friend class GenerationLimitEvaluator;
 friend class SoftmxEvaluator;
 public:
@@ -274,7 +301,8 @@ public:
     GCTooFrequent,
     IllegalYoungPercent,
     IllegalMode,
-    GCFailure
+    GCFailure,
+    IllegalTenant
   };
 
   // Modes when elastic heap is activated
@@ -336,6 +364,46 @@ private:
 
   // Update min/max desired young length after change young length
   void                update_desired_young_length(uint unavailable_young_length);
+  // Number of regions the young gen cannot use: uncommitted, being
+  // uncommitted, or held in (or being committed into) the standby pool
+  uint                unavailable_young_length() const;
+
+  // Regions kept committed and pretouched but out of the free list while
+  // PeriodicUncommitMode has shrunk the young gen (ElasticHeapStandbyPercent).
+  // An allocation spike hands them to the young gen in the same pause,
+  // and ElasticHeapConcThread refills the pool in the background.
+  FreeRegionList      _standby_list;
+  // The commit list of ElasticHeapConcThread refills _standby_list
+  // instead of growing the young gen
+  bool                _refilling_standby;
+
+  uint                standby_target_length() const;
+  // Move up to num standby regions into the free list of _hrm and grow
+  // the young gen by them. Return the number of regions moved
+  uint                release_standby_regions(uint num);
+  void                drain_standby_regions()       { release_standby_regions(_standby_list.length()); }
+  // Keep regions just taken for uncommit committed in the standby pool
+  void                keep_standby_regions();
+  // Let ElasticHeapConcThread commit and pretouch regions for the pool
+  void                try_refilling_standby();
+
+  // Number of regions committed/uncommitted together so that a transparent
+  // huge page is never split by elastic heap (see ElasticHeapUncommitAlignment)
+  uint                _regions_per_chunk;
+
+  // NUMA node which the memory of each region is bound to on recommit.
+  // Only maintained with UseNUMA and ElasticHeapNUMAAware
+  int*                _region_numa_node;
+  // Ids of the NUMA leaf groups
+  int*                _numa_node_ids;
+  uint                _num_numa_nodes;
+
+  void                initialize_numa();
+  bool                numa_aware() const            { return _region_numa_node != NULL; }
+  int                 numa_node_index(int lgrp_id) const;
+  // Pick the NUMA node for the regions to commit in proportion to the
+  // number of Java threads running on each node
+  void                assign_numa_nodes(FreeRegionList* list);
 
 public:
   void                uncommit_region_memory(HeapRegion* hr);
@@ -353,9 +421,12 @@ public:
   // Main entry in GC pause for elastic heap
   void                perform_after_young_collection();
   void                perform_after_full_collection();
-  // Commit/uncommit regions
-  void                uncommit_regions(uint num);
-  void                commit_regions(uint num);
+  // Lower the limits of shrinking tenants as the GC frees their memory
+  void                step_tenant_heap_limits();
+  // Commit/uncommit regions, return the actual number of regions
+  // moved into the list of ElasticHeapConcThread
+  uint                uncommit_regions(uint num);
+  uint                commit_regions(uint num);
 
   void                resize_young_length(uint target_length);
   void                change_heap_capacity(uint target_heap_regions);
@@ -371,6 +442,10 @@ public:
   // Main entry for processing elastic heap via JCMD/MXBean
   ErrorType           configure_setting(uint young_percent, uint uncommit_ihop, uint softmx_percent, bool fullgc = false);
 
+  // Per-tenant heap limits via JCMD/MXBean, see G1TenantAllocationContext::set_heap_size_target
+  ErrorType           configure_tenant_heap_limit(jlong tenant_id, size_t limit);
+  ErrorType           tenant_heap_limit(jlong tenant_id, size_t* limit);
+
   // Get the commit percent and freed bytes
   int                 young_commit_percent() const;
   jlong               young_uncommitted_bytes() const;
@@ -410,6 +485,7 @@ public:
       case IllegalYoungPercent: return "illegal percent";
       case IllegalMode: return "not in correct mode";
       case GCFailure: return "cannot invoke GC";
+      case IllegalTenant: return "no such tenant";
       default: ShouldNotReachHere(); return NULL;
     }
   }
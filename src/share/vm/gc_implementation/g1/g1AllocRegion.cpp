@@ -238,7 +238,8 @@ G1AllocRegion::G1AllocRegion(const char* name,
                              bool bot_updates)
   : _name(name), _bot_updates(bot_updates),
     _alloc_region(NULL), _count(0), _used_bytes_before(0),
-    _allocation_context(AllocationContext::system()) { }
+    _allocation_context(AllocationContext::system()),
+    _node_index(G1NUMA::AnyNodeIndex) { }
 
 
 HeapRegion* MutatorAllocRegion::allocate_new_region(size_t word_size,
@@ -249,7 +250,7 @@ HeapRegion* MutatorAllocRegion::allocate_new_region(size_t word_size,
     return NULL;
   }
 
-  return _g1h->new_mutator_alloc_region(word_size, force);
+  return _g1h->new_mutator_alloc_region(word_size, force, node_index());
 }
 
 void MutatorAllocRegion::retire_region(HeapRegion* alloc_region,
@@ -265,7 +266,10 @@ void MutatorAllocRegion::retire_region(HeapRegion* alloc_region,
 HeapRegion* SurvivorGCAllocRegion::allocate_new_region(size_t word_size,
                                                        bool force) {
   assert(!force, "not supported for GC alloc regions");
-  return _g1h->new_gc_alloc_region(word_size, count(), InCSetState::Young);
+  // The survivor regions of all NUMA nodes share the survivor budget.
+  uint survivor_count = node_index() == G1NUMA::AnyNodeIndex ?
+                        count() : _g1h->allocator()->survivor_gc_alloc_regions_count();
+  return _g1h->new_gc_alloc_region(word_size, survivor_count, InCSetState::Young, node_index());
 }
 
 void SurvivorGCAllocRegion::retire_region(HeapRegion* alloc_region,
@@ -281,7 +285,7 @@ void SurvivorGCAllocRegion::retire_region(HeapRegion* alloc_region,
 HeapRegion* OldGCAllocRegion::allocate_new_region(size_t word_size,
                                                   bool force) {
   assert(!force, "not supported for GC alloc regions");
-  return _g1h->new_gc_alloc_region(word_size, count(), InCSetState::Old);
+  return _g1h->new_gc_alloc_region(word_size, count(), InCSetState::Old, G1NUMA::AnyNodeIndex);
 }
 
 void OldGCAllocRegion::retire_region(HeapRegion* alloc_region,
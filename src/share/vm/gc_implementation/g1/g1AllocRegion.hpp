@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1ALLOCREGION_HPP
 #define SHARE_VM_GC_IMPLEMENTATION_G1_G1ALLOCREGION_HPP
 
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/heapRegion.hpp"
 
 class G1CollectedHeap;
@@ -60,6 +61,10 @@ private:
   // Allocation context associated with this alloc region.
   AllocationContext_t _allocation_context;
 
+  // The NUMA node new regions are preferably taken from, or
+  // G1NUMA::AnyNodeIndex.
+  uint _node_index;
+
   // It keeps track of the distinct number of regions that are used
   // for allocation in the active interval of this object, i.e.,
   // between a call to init() and a call to release(). The count
@@ -152,6 +157,9 @@ public:
     return _allocation_context;
   }
 
+  void set_node_index(uint node_index) { _node_index = node_index; }
+  uint node_index() const { return _node_index; }
+
   const G1TenantAllocationContext* tenant_allocation_context() const {
     assert(TenantHeapIsolation, "pre-condition");
     return allocation_context().tenant_allocation_context();
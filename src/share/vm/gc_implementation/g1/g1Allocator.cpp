@@ -29,13 +29,33 @@
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
 
+G1DefaultAllocator::G1DefaultAllocator(G1CollectedHeap* heap) :
+  G1Allocator(heap),
+  _num_alloc_regions(G1NUMA::numa()->num_active_nodes()),
+  _mutator_alloc_regions(NULL),
+  _survivor_gc_alloc_regions(NULL),
+  _retained_old_gc_alloc_region(NULL) {
+  _mutator_alloc_regions = NEW_C_HEAP_ARRAY(MutatorAllocRegion, _num_alloc_regions, mtGC);
+  _survivor_gc_alloc_regions = NEW_C_HEAP_ARRAY(SurvivorGCAllocRegion, _num_alloc_regions, mtGC);
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    ::new ((void*)&_mutator_alloc_regions[i]) MutatorAllocRegion();
+    ::new ((void*)&_survivor_gc_alloc_regions[i]) SurvivorGCAllocRegion();
+    if (G1NUMA::numa()->is_enabled()) {
+      _mutator_alloc_regions[i].set_node_index(i);
+      _survivor_gc_alloc_regions[i].set_node_index(i);
+    }
+  }
+}
+
 void G1DefaultAllocator::init_mutator_alloc_region() {
   if (TenantHeapIsolation) {
     G1TenantAllocationContexts::init_mutator_alloc_regions();
   }
 
-  assert(_mutator_alloc_region.get() == NULL, "pre-condition");
-  _mutator_alloc_region.init();
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    assert(_mutator_alloc_regions[i].get() == NULL, "pre-condition");
+    _mutator_alloc_regions[i].init();
+  }
 }
 
 void G1DefaultAllocator::release_mutator_alloc_region() {
@@ -43,8 +63,10 @@ void G1DefaultAllocator::release_mutator_alloc_region() {
     G1TenantAllocationContexts::release_mutator_alloc_regions();
   }
 
-  _mutator_alloc_region.release();
-  assert(_mutator_alloc_region.get() == NULL, "post-condition");
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    _mutator_alloc_regions[i].release();
+    assert(_mutator_alloc_regions[i].get() == NULL, "post-condition");
+  }
 }
 
 MutatorAllocRegion* G1DefaultAllocator::mutator_alloc_region(AllocationContext_t context) {
@@ -53,7 +75,7 @@ MutatorAllocRegion* G1DefaultAllocator::mutator_alloc_region(AllocationContext_t
     assert(NULL != tac, "Tenant alloc context cannot be NULL");
     return tac->mutator_alloc_region();
   }
-  return &_mutator_alloc_region;
+  return &_mutator_alloc_regions[current_node_index()];
 }
 
 SurvivorGCAllocRegion* G1DefaultAllocator::survivor_gc_alloc_region(AllocationContext_t context) {
@@ -62,7 +84,7 @@ SurvivorGCAllocRegion* G1DefaultAllocator::survivor_gc_alloc_region(AllocationCo
     assert(NULL != tac, "Tenant alloc context cannot be NULL");
     return tac->survivor_gc_alloc_region();
   }
-  return &_survivor_gc_alloc_region;
+  return &_survivor_gc_alloc_regions[current_node_index()];
 }
 
 OldGCAllocRegion* G1DefaultAllocator::old_gc_alloc_region(AllocationContext_t context) {
@@ -79,23 +101,29 @@ size_t G1DefaultAllocator::used() {
          "Should be owned on this thread's behalf.");
   size_t result = _summary_bytes_used;
 
-  if (TenantHeapIsolation) {
-    // root tenant's
-    HeapRegion* hr = mutator_alloc_region(AllocationContext::system())->get();
-    if (NULL != hr) { result += hr->used(); }
-
-    result += G1TenantAllocationContexts::total_used();
-  } else {
-    // TenantHeapIsolation disabled mode
+  // root tenant's, or all of them if TenantHeapIsolation is disabled
+  for (uint i = 0; i < _num_alloc_regions; i++) {
     // Read only once in case it is set to NULL concurrently
-    HeapRegion* hr = mutator_alloc_region(AllocationContext::current())->get();
+    HeapRegion* hr = _mutator_alloc_regions[i].get();
     if (hr != NULL) {
       result += hr->used();
     }
   }
+
+  if (TenantHeapIsolation) {
+    result += G1TenantAllocationContexts::total_used();
+  }
   return result;
 }
 
+uint G1DefaultAllocator::survivor_gc_alloc_regions_count() {
+  uint count = 0;
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    count += _survivor_gc_alloc_regions[i].count();
+  }
+  return count;
+}
+
 void G1Allocator::reuse_retained_old_region(EvacuationInfo& evacuation_info,
                                             OldGCAllocRegion* old,
                                             HeapRegion** retained_old) {
@@ -146,7 +174,9 @@ void G1Allocator::reuse_retained_old_region(EvacuationInfo& evacuation_info,
 void G1DefaultAllocator::init_gc_alloc_regions(EvacuationInfo& evacuation_info) {
   assert_at_safepoint(true /* should_be_vm_thread */);
 
-  _survivor_gc_alloc_region.init();
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    _survivor_gc_alloc_regions[i].init();
+  }
   _old_gc_alloc_region.init();
   reuse_retained_old_region(evacuation_info,
                             &_old_gc_alloc_region,
@@ -167,9 +197,11 @@ void G1DefaultAllocator::release_gc_alloc_regions(uint no_of_gc_workers, Evacuat
     context = AllocationContext::system();
   }
 
-  evacuation_info.set_allocation_regions(survivor_gc_alloc_region(context)->count() +
+  evacuation_info.set_allocation_regions(survivor_gc_alloc_regions_count() +
                                          old_gc_alloc_region(context)->count());
-  survivor_gc_alloc_region(context)->release();
+  for (uint i = 0; i < _num_alloc_regions; i++) {
+    _survivor_gc_alloc_regions[i].release();
+  }
   // If we have an old GC alloc region to release, we'll save it in
   // _retained_old_gc_alloc_region. If we don't
   // _retained_old_gc_alloc_region will become NULL. This is what we
@@ -196,13 +228,14 @@ void G1DefaultAllocator::abandon_gc_alloc_regions() {
     // in non-tenant mode, system() == current(), AllocationContext::current() just works.
     // but in tenant mode, we are trying to release all gc alloc regions from all tenants,
     // thus explicitly overwrite the first operand context to system() like below.
-    assert(survivor_gc_alloc_region(AllocationContext::system())->get() == NULL, "pre-condition");
     assert(old_gc_alloc_region(AllocationContext::system())->get() == NULL, "pre-condition");
   } else {
     // original logic, untouched
-    assert(survivor_gc_alloc_region(AllocationContext::current())->get() == NULL, "pre-condition");
     assert(old_gc_alloc_region(AllocationContext::current())->get() == NULL, "pre-condition");
   });
+  DEBUG_ONLY(for (uint i = 0; i < _num_alloc_regions; i++) {
+    assert(_survivor_gc_alloc_regions[i].get() == NULL, "pre-condition");
+  });
 
   _retained_old_gc_alloc_region = NULL;
 
@@ -279,6 +312,10 @@ G1DefaultParGCAllocator::G1DefaultParGCAllocator(G1CollectedHeap* g1h) :
   _alloc_buffers[InCSetState::Young] = &_surviving_alloc_buffer;
   _alloc_buffers[InCSetState::Old]  = &_tenured_alloc_buffer;
 
+  for (uint i = 0; i < TenantBufferCacheSize; i++) {
+    _tenant_buffer_cache[i] = NULL;
+  }
+
   if (TenantHeapIsolation) {
     _tenant_par_alloc_buffers = new TenantBufferMap(G1TenantAllocationContexts::active_context_count());
   }
@@ -287,11 +324,20 @@ G1DefaultParGCAllocator::G1DefaultParGCAllocator(G1CollectedHeap* g1h) :
 G1TenantParGCAllocBuffer* G1DefaultParGCAllocator::tenant_par_alloc_buffer_of(AllocationContext_t ac) {
   assert(TenantHeapIsolation, "pre-condition");
 
+  uint index = tenant_buffer_cache_index(ac);
+  G1TenantParGCAllocBuffer* tbuf = _tenant_buffer_cache[index];
+  if (NULL != tbuf && tbuf->allocation_context() == ac) {
+    return tbuf;
+  }
+
   // slow path to traverse over all tenant buffers
   assert(NULL != _tenant_par_alloc_buffers, "just checking");
-  if (_tenant_par_alloc_buffers->contains(ac)) {
-    assert(NULL != _tenant_par_alloc_buffers->get(ac), "pre-condition");
-    return _tenant_par_alloc_buffers->get(ac)->value();
+  TenantBufferMap::Entry* entry = _tenant_par_alloc_buffers->get(ac);
+  if (NULL != entry) {
+    tbuf = entry->value();
+    assert(NULL != tbuf, "pre-condition");
+    _tenant_buffer_cache[index] = tbuf;
+    return tbuf;
   }
 
   return NULL;
@@ -351,6 +397,7 @@ G1ParGCAllocBuffer* G1DefaultParGCAllocator::alloc_buffer(InCSetState dest, Allo
     if (NULL == tbuf) {
       tbuf = new G1TenantParGCAllocBuffer(_g1h, context);
       _tenant_par_alloc_buffers->put(context, tbuf);
+      _tenant_buffer_cache[tenant_buffer_cache_index(context)] = tbuf;
     }
 
     assert(NULL != tbuf
@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1AllocationContext.hpp"
 #include "gc_implementation/g1/g1AllocRegion.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.hpp"
 #include "utilities/hashtable.hpp"
 #include "utilities/hashtable.inline.hpp"
@@ -60,6 +61,9 @@ public:
    virtual OldGCAllocRegion*      old_gc_alloc_region(AllocationContext_t context) = 0;
    virtual size_t                 used() = 0;
    virtual bool                   is_retained_old_region(HeapRegion* hr) = 0;
+   // Number of regions allocated for survivors in this GC by the
+   // default alloc regions of all NUMA nodes together.
+   virtual uint                   survivor_gc_alloc_regions_count() = 0;
 
    void                           reuse_retained_old_region(EvacuationInfo& evacuation_info,
                                                             OldGCAllocRegion* old,
@@ -94,20 +98,29 @@ public:
 // The default allocator for G1.
 class G1DefaultAllocator : public G1Allocator {
 protected:
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  // Number of mutator and survivor alloc regions, one per NUMA node.
+  uint _num_alloc_regions;
 
-  // Alloc region used to satisfy allocation requests by the GC for
-  // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  // Alloc regions used to satisfy mutator allocation requests, indexed
+  // by the NUMA node of the allocating thread.
+  MutatorAllocRegion* _mutator_alloc_regions;
+
+  // Alloc regions used to satisfy allocation requests by the GC for
+  // survivor objects, indexed by the NUMA node of the copying worker.
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
   OldGCAllocRegion _old_gc_alloc_region;
 
   HeapRegion* _retained_old_gc_alloc_region;
+
+  // Index into the alloc region arrays for the calling thread.
+  uint current_node_index() const {
+    return _num_alloc_regions == 1 ? 0 : G1NUMA::numa()->index_of_current_thread();
+  }
 public:
-  G1DefaultAllocator(G1CollectedHeap* heap) : G1Allocator(heap), _retained_old_gc_alloc_region(NULL) { }
+  G1DefaultAllocator(G1CollectedHeap* heap);
 
   virtual void init_mutator_alloc_region();
   virtual void release_mutator_alloc_region();
@@ -125,6 +138,8 @@ public:
   virtual OldGCAllocRegion* old_gc_alloc_region(AllocationContext_t context);
 
   virtual size_t used();
+
+  virtual uint survivor_gc_alloc_regions_count();
 };
 
 class G1ParGCAllocBuffer: public ParGCAllocBuffer {
@@ -275,6 +290,17 @@ private:
   typedef HashMap<AllocationContext_t, G1TenantParGCAllocBuffer*, mtTenant> TenantBufferMap;
   TenantBufferMap*    _tenant_par_alloc_buffers;
 
+  // Direct-mapped cache in front of _tenant_par_alloc_buffers, so copying
+  // objects of recently seen tenants does not go through the hash map
+  enum { TenantBufferCacheSize = 8 };
+  G1TenantParGCAllocBuffer* _tenant_buffer_cache[TenantBufferCacheSize];
+
+  static uint tenant_buffer_cache_index(AllocationContext_t ac) {
+    // low bits of the context address are mostly alignment
+    uint hash = ac.hash_code();
+    return (hash ^ (hash >> 3)) & (TenantBufferCacheSize - 1);
+  }
+
 protected:
   // returns tenant alloc buffer of target allocation context, NULL if not exist
   G1TenantParGCAllocBuffer* tenant_par_alloc_buffer_of(AllocationContext_t ac);
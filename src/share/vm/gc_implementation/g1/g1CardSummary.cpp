@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1CardSummary.hpp"
+#include "runtime/safepoint.hpp"
+
+G1CardSummary::G1CardSummary(MemRegion reserved) :
+  _heap_start(reserved.start()),
+  _log_block_size(exact_log2(G1CardSummaryBlockSize)),
+  _blocks_per_region(HeapRegion::GrainBytes >> _log_block_size),
+  _num_regions((uint) (reserved.byte_size() >> HeapRegion::LogOfHRGrainBytes)),
+  _blocks(reserved.byte_size() >> _log_block_size, false /* in_resource_area */),
+  _regions(NULL) {
+  _regions = NEW_C_HEAP_ARRAY(jbyte, _num_regions, mtGC);
+  memset(_regions, 0, _num_regions);
+}
+
+G1CardSummary::~G1CardSummary() {
+  FREE_C_HEAP_ARRAY(jbyte, _regions, mtGC);
+}
+
+void G1CardSummary::clear() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  for (uint i = 0; i < _num_regions; i++) {
+    if (_regions[i] != 0) {
+      _blocks.clear_range(i * _blocks_per_region, (i + 1) * _blocks_per_region);
+      _regions[i] = 0;
+    }
+  }
+}
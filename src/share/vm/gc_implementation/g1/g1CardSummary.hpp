@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1CARDSUMMARY_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1CARDSUMMARY_HPP
+
+#include "gc_implementation/g1/heapRegion.hpp"
+#include "memory/allocation.hpp"
+#include "memory/memRegion.hpp"
+#include "utilities/bitMap.inline.hpp"
+
+// A two-level summary of the cards refined since the last evacuation
+// pause: one bit per block of G1CardSummaryBlockSize bytes and one byte
+// per heap region, set together with any of the region's blocks.
+//
+// Every reference into a young region is created after the pause that
+// preceded the region's allocation, and the card holding it is refined
+// (concurrently or during updateRS) before the remembered sets are
+// scanned. Blocks without a refined card can thus be skipped when
+// scanning the remembered set of a young region, which mostly helps with
+// coarsened remembered set entries that name every card of a region.
+class G1CardSummary : public CHeapObj<mtGC> {
+  HeapWord* _heap_start;
+  size_t    _log_block_size;
+  size_t    _blocks_per_region;
+  uint      _num_regions;
+
+  BitMap    _blocks;
+  jbyte*    _regions;
+
+  size_t region_index(HeapWord* addr) const {
+    return pointer_delta(addr, _heap_start, 1) >> HeapRegion::LogOfHRGrainBytes;
+  }
+
+  size_t block_index(HeapWord* addr) const {
+    return pointer_delta(addr, _heap_start, 1) >> _log_block_size;
+  }
+
+ public:
+  G1CardSummary(MemRegion reserved);
+  ~G1CardSummary();
+
+  // Called during refinement, possibly by several threads at once.
+  void mark_card(HeapWord* card_start) {
+    size_t block = block_index(card_start);
+    if (!_blocks.at(block)) {
+      _blocks.par_set_bit(block);
+    }
+    size_t region = region_index(card_start);
+    if (_regions[region] == 0) {
+      _regions[region] = 1;
+    }
+  }
+
+  bool is_marked(HeapWord* card_start) const {
+    return _regions[region_index(card_start)] != 0 &&
+           _blocks.at(block_index(card_start));
+  }
+
+  // Clears the blocks of the regions marked since the last call. Only
+  // called at the end of an evacuation pause.
+  void clear();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1CARDSUMMARY_HPP
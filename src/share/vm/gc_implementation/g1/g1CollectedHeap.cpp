@@ -48,6 +48,7 @@
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
+#include "gc_implementation/g1/heapRegionTracer.hpp"
 #include "gc_implementation/g1/vm_operations_g1.hpp"
 #include "gc_implementation/shared/gcHeapSummary.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
@@ -61,6 +62,7 @@
 #include "memory/referenceProcessor.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.pcgc.inline.hpp"
+#include "runtime/coroutine.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "gc_implementation/g1/elasticHeap.hpp"
@@ -106,6 +108,13 @@ public:
     return true;
   }
 
+  bool do_card_buffer(jbyte** cards, size_t num, uint worker_i) {
+    if (!G1RefineCardsBatched || SafepointSynchronize::is_at_safepoint()) {
+      return CardTableEntryClosure::do_card_buffer(cards, num, worker_i);
+    }
+    return G1CollectedHeap::heap()->g1_rem_set()->refine_cards(cards, num, worker_i, _concurrent);
+  }
+
   void set_concurrent(bool b) { _concurrent = b; }
 };
 
@@ -545,7 +554,8 @@ G1CollectedHeap::new_region_try_secondary_free_list(bool is_old) {
   return NULL;
 }
 
-HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand) {
+HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_expand,
+                                        uint node_index) {
   assert(!isHumongous(word_size) || word_size <= HeapRegion::GrainWords,
          "the only time we use this to allocate a humongous region is "
          "when we are allocating a single humongous region");
@@ -564,7 +574,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
     }
   }
 
-  res = _hrm.allocate_free_region(is_old);
+  res = _hrm.allocate_free_region(is_old, node_index);
 
   if (res == NULL) {
     if (G1ConcRegionFreeingVerbose) {
@@ -590,7 +600,7 @@ HeapRegion* G1CollectedHeap::new_region(size_t word_size, bool is_old, bool do_e
       // always expand the heap by an amount aligned to the heap
       // region size, the free list should in theory not be empty.
       // In either case allocate_free_region() will check for NULL.
-      res = _hrm.allocate_free_region(is_old);
+      res = _hrm.allocate_free_region(is_old, node_index);
     } else {
       _expand_heap_after_alloc_failure = false;
     }
@@ -729,6 +739,9 @@ G1CollectedHeap::humongous_obj_allocate_initialize_regions(uint first,
 
   assert(first_hr->used() == word_size * HeapWordSize, "invariant");
   _allocator->increase_used(first_hr->used());
+  if (TenantHeapIsolation && !context.is_system()) {
+    context->increase_used(first_hr->used());
+  }
   _humongous_set.add(first_hr);
 
   return new_obj;
@@ -821,6 +834,11 @@ HeapWord* G1CollectedHeap::humongous_obj_allocate(size_t word_size, AllocationCo
     // information of the old generation so we need to recalculate the
     // sizes and update the jstat counters here.
     g1mm()->update_sizes();
+
+    size_t wasted_words = (size_t)obj_regions * HeapRegion::GrainWords - word_size;
+    HeapRegionTracer::send_humongous_allocation(first, obj_regions,
+                                                word_size * HeapWordSize,
+                                                wasted_words * HeapWordSize);
   }
 
   verify_region_sets_optional();
@@ -926,22 +944,25 @@ HeapWord* G1CollectedHeap::attempt_allocation_slow(size_t word_size,
 
     {
       MutexLockerEx x(Heap_lock);
-      result = _allocator->mutator_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                                                    false /* bot_updates */);
+      // Look the alloc region up once, the thread may move to another
+      // NUMA node in the meantime.
+      MutatorAllocRegion* mutator_alloc_region = _allocator->mutator_alloc_region(context);
+      result = mutator_alloc_region->attempt_allocation_locked(word_size,
+                                                               false /* bot_updates */);
       if (result != NULL) {
         return result;
       }
 
       // If we reach here, attempt_allocation_locked() above failed to
       // allocate a new region. So the mutator alloc region should be NULL.
-      assert(_allocator->mutator_alloc_region(context)->get() == NULL, "only way to get here");
+      assert(mutator_alloc_region->get() == NULL, "only way to get here");
 
       if (GC_locker::is_active_and_needs_gc()) {
         if (g1_policy()->can_expand_young_list()) {
           // No need for an ergo verbose message here,
           // can_expand_young_list() does this when it returns true.
-          result = _allocator->mutator_alloc_region(context)->attempt_allocation_force(word_size,
-                                                                                       false /* bot_updates */);
+          result = mutator_alloc_region->attempt_allocation_force(word_size,
+                                                                  false /* bot_updates */);
           if (result != NULL) {
             return result;
           }
@@ -1141,13 +1162,14 @@ HeapWord* G1CollectedHeap::attempt_allocation_at_safepoint(size_t word_size,
                                                            AllocationContext_t context,
                                                            bool expect_null_mutator_alloc_region) {
   assert_at_safepoint(true /* should_be_vm_thread */);
-  assert(_allocator->mutator_alloc_region(context)->get() == NULL ||
+  MutatorAllocRegion* mutator_alloc_region = _allocator->mutator_alloc_region(context);
+  assert(mutator_alloc_region->get() == NULL ||
                                              !expect_null_mutator_alloc_region,
          "the current alloc region was unexpectedly found to be non-NULL");
 
   if (!isHumongous(word_size)) {
-    return _allocator->mutator_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                      false /* bot_updates */);
+    return mutator_alloc_region->attempt_allocation_locked(word_size,
+                                                           false /* bot_updates */);
   } else {
     HeapWord* result = humongous_obj_allocate(word_size, context);
     if (result != NULL && g1_policy()->need_to_start_conc_mark("STW humongous allocation")) {
@@ -1685,6 +1707,47 @@ resize_if_necessary_after_full_collection(size_t word_size) {
   }
 }
 
+void G1CollectedHeap::shrink_to_soft_max_heap_size(const char* reason) {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+  const size_t soft_max_bytes = soft_max_heap_size();
+  assert(soft_max_bytes != 0, "should not be called otherwise");
+
+  // Regions freed by a concurrent cleanup may still be on the way to
+  // the free list; only count them once they got there.
+  if (free_regions_coming()) {
+    return;
+  }
+  append_secondary_free_list_if_not_empty_with_lock();
+
+  const size_t capacity_bytes = capacity();
+  const size_t used_bytes = used();
+
+  // Keep the same amount of free space a Full GC would leave at least.
+  const double maximum_used_percentage = 1.0 - (double) MinHeapFreeRatio / 100.0;
+  double minimum_desired_capacity_d = (double) used_bytes / maximum_used_percentage;
+  minimum_desired_capacity_d = MIN2(minimum_desired_capacity_d, (double) max_capacity());
+  size_t target_capacity = MAX2(soft_max_bytes,
+                                (size_t) minimum_desired_capacity_d);
+  target_capacity = align_size_up(target_capacity, HeapRegion::GrainBytes);
+
+  if (capacity_bytes <= target_capacity) {
+    return;
+  }
+
+  size_t shrink_bytes = capacity_bytes - target_capacity;
+  ergo_verbose5(ErgoHeapSizing,
+                "attempt heap shrinking",
+                ergo_format_reason("capacity higher than soft max heap size")
+                ergo_format_str("trigger")
+                ergo_format_byte("capacity")
+                ergo_format_byte("occupancy")
+                ergo_format_byte("soft max heap size")
+                ergo_format_byte("target capacity"),
+                reason, capacity_bytes, used_bytes,
+                soft_max_bytes, target_capacity);
+  shrink(shrink_bytes);
+}
+
 
 HeapWord*
 G1CollectedHeap::satisfy_failed_allocation(size_t word_size,
@@ -1893,7 +1956,6 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _ref_processor_cm(NULL),
   _ref_processor_stw(NULL),
   _bot_shared(NULL),
-  _evac_failure_scan_stack(NULL),
   _mark_in_progress(false),
   _cg1r(NULL),
   _g1mm(NULL),
@@ -1916,10 +1978,12 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _old_marking_cycles_completed(0),
   _concurrent_cycle_started(false),
   _heap_summary_sent(false),
+  _soft_max_heap_size(G1SoftMaxHeapSize),
   _in_cset_fast_test(),
   _dirty_cards_region_list(NULL),
   _worker_cset_start_region(NULL),
   _worker_cset_start_region_time_stamp(NULL),
+  _optional_refs_array(NULL),
   _gc_timer_stw(new (ResourceObj::C_HEAP, mtGC) STWGCTimer()),
   _gc_timer_cm(new (ResourceObj::C_HEAP, mtGC) ConcurrentGCTimer()),
   _gc_tracer_stw(new (ResourceObj::C_HEAP, mtGC) G1NewTracer()),
@@ -1927,6 +1991,8 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
 
   _g1h = this;
 
+  // The allocator keeps alloc regions per NUMA node.
+  _numa = G1NUMA::create();
   _allocator = G1Allocator::create_allocator(_g1h);
   _humongous_object_threshold_in_words = HeapRegion::GrainWords / 2;
 
@@ -1939,15 +2005,26 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _worker_cset_start_region = NEW_C_HEAP_ARRAY(HeapRegion*, n_queues, mtGC);
   _worker_cset_start_region_time_stamp = NEW_C_HEAP_ARRAY(uint, n_queues, mtGC);
   _evacuation_failed_info_array = NEW_C_HEAP_ARRAY(EvacuationFailedInfo, n_queues, mtGC);
+  _objs_with_preserved_marks = NEW_C_HEAP_ARRAY(PreservedOopStack, n_queues, mtGC);
+  _preserved_marks_of_objs = NEW_C_HEAP_ARRAY(PreservedMarkStack, n_queues, mtGC);
 
   for (int i = 0; i < n_queues; i++) {
     RefToScanQueue* q = new RefToScanQueue();
     q->initialize();
     _task_queues->register_queue(i, q);
     ::new (&_evacuation_failed_info_array[i]) EvacuationFailedInfo();
+    ::new (&_objs_with_preserved_marks[i]) PreservedOopStack();
+    ::new (&_preserved_marks_of_objs[i]) PreservedMarkStack();
   }
   clear_cset_start_regions();
 
+  if (G1UseOptionalCSetIncrements) {
+    _optional_refs_array = NEW_C_HEAP_ARRAY(G1OptionalRefs, n_queues, mtGC);
+    for (int i = 0; i < n_queues; i++) {
+      ::new (&_optional_refs_array[i]) G1OptionalRefs();
+    }
+  }
+
   // Initialize the G1EvacuationFailureALot counters and flags.
   NOT_PRODUCT(reset_evacuation_should_fail();)
 
@@ -1974,6 +2051,15 @@ G1RegionToSpaceMapper* G1CollectedHeap::create_aux_memory_mapper(const char* des
   return result;
 }
 
+size_t G1CollectedHeap::heap_page_size() {
+  if (UseLargePages) {
+    return os::large_page_size();
+  } else if (G1TransparentHugePageCommit) {
+    return os::transparent_huge_page_size();
+  }
+  return os::vm_page_size();
+}
+
 jint G1CollectedHeap::initialize() {
   CollectedHeap::pre_initialize();
   os::enable_vtime();
@@ -2005,7 +2091,7 @@ jint G1CollectedHeap::initialize() {
   size_t heap_alignment = collector_policy()->heap_alignment();
 
   if (G1ElasticHeap) {
-    size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+    size_t page_size = heap_page_size();
     if (HeapRegion::GrainBytes < page_size || (HeapRegion::GrainBytes % page_size) != 0) {
       vm_exit_during_initialization(err_msg("G1ElasticHeap requires G1HeapRegionSize("
                                             SIZE_FORMAT
@@ -2066,11 +2152,12 @@ jint G1CollectedHeap::initialize() {
   G1RegionToSpaceMapper* heap_storage =
     G1RegionToSpaceMapper::create_mapper(g1_rs,
                                          g1_rs.size(),
-                                         UseLargePages ? os::large_page_size() : os::vm_page_size(),
+                                         heap_page_size(),
                                          HeapRegion::GrainBytes,
                                          1,
                                          mtJavaHeap);
   heap_storage->set_mapping_changed_listener(&_listener);
+  _numa->set_region_info(HeapRegion::GrainBytes, heap_page_size());
 
   // Create storage for the BOT, card table, card counts table (hot card cache) and the bitmaps.
   G1RegionToSpaceMapper* bot_storage =
@@ -2687,6 +2774,23 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+class G1ParallelObjectIterator : public ParallelObjectIterator {
+  G1CollectedHeap* _g1h;
+  volatile jint    _next_region;
+
+ public:
+  G1ParallelObjectIterator(G1CollectedHeap* g1h) : _g1h(g1h), _next_region(0) { }
+
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) {
+    IterateObjectClosureRegionClosure blk(cl);
+    _g1h->heap_region_par_iterate_claimed(&blk, &_next_region);
+  }
+};
+
+ParallelObjectIterator* G1CollectedHeap::parallel_object_iterator(uint thread_num) {
+  return new G1ParallelObjectIterator(this);
+}
+
 // Calls a SpaceClosure on a HeapRegion.
 
 class SpaceClosureRegionClosure: public HeapRegionClosure {
@@ -2708,6 +2812,11 @@ void G1CollectedHeap::heap_region_iterate(HeapRegionClosure* cl) const {
   _hrm.iterate(cl);
 }
 
+void G1CollectedHeap::heap_region_par_iterate_claimed(HeapRegionClosure* cl,
+                                                      volatile jint* next_index) const {
+  _hrm.par_iterate_claimed(cl, next_index);
+}
+
 void
 G1CollectedHeap::heap_region_par_iterate_chunked(HeapRegionClosure* cl,
                                                  uint worker_id,
@@ -2935,7 +3044,8 @@ void G1CollectedHeap::collection_set_iterate_from(HeapRegion* r,
 
 HeapRegion* G1CollectedHeap::next_compaction_region(const HeapRegion* from) const {
   HeapRegion* result = _hrm.next_region_in_heap(from);
-  while (result != NULL && result->isHumongous()) {
+  // Neither humongous nor pinned regions are compacted into.
+  while (result != NULL && (result->isHumongous() || result->is_pinned())) {
     result = _hrm.next_region_in_heap(result);
   }
   return result;
@@ -2960,6 +3070,17 @@ bool G1CollectedHeap::block_is_obj(const HeapWord* addr) const {
   return sp->block_is_obj(addr);
 }
 
+void G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "only with region pinning");
+  assert(thread->thread_state() == _thread_in_vm, "no safepoint while pinning");
+  heap_region_containing(obj)->increment_pinned_object_count();
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(G1UseRegionPinning, "only with region pinning");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 bool G1CollectedHeap::supports_tlab_allocation() const {
   return true;
 }
@@ -3796,6 +3917,10 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     return oop(region->bottom())->is_typeArray();
   }
 
+  bool is_objArray_region(HeapRegion* region) const {
+    return oop(region->bottom())->is_objArray();
+  }
+
   bool humongous_region_is_candidate(G1CollectedHeap* heap, HeapRegion* region) const {
     assert(region->startsHumongous(), "Must start a humongous object");
 
@@ -3820,10 +3945,16 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
     // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // set entries on other regions.  With G1EagerReclaimHumongousObjArrays
+    // we also nominate is_objArray() objects, but only while no
+    // concurrent cycle is in progress, so that neither marking nor the
+    // concurrent remembered set rebuild can hold on to the object.  The
+    // remembered set entries it induced are left stale: scanning cards
+    // of a region is bounded by its allocated part, and cards of young
+    // regions are filtered, so a reused region is never misparsed.
+    // Objects referenced from the reclaimed array survive this GC since
+    // its cards were already scanned, and die at the next one.
     //
     // We also treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
@@ -3834,8 +3965,19 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // Frequent allocation and drop of large binary blobs is an
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
+    //
+    // Objects accessed by JNI critical sections are pinned and never
+    // candidates.
 
-    return is_typeArray_region(region) && is_remset_small(region);
+    if (!is_remset_small(region) || region->is_pinned()) {
+      return false;
+    }
+    if (is_typeArray_region(region)) {
+      return true;
+    }
+    return G1EagerReclaimHumongousObjArrays &&
+           is_objArray_region(region) &&
+           !heap->concurrent_mark()->cmThread()->during_cycle();
   }
 
  public:
@@ -4318,6 +4460,10 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
           _allocator->increase_used(g1_policy()->bytes_copied_during_gc());
         }
 
+        if (TenantHeapIsolation) {
+          G1TenantAllocationContexts::recalculate_used(false /* after_marking */);
+        }
+
         if (g1_policy()->during_initial_mark_pause()) {
           // We have to do this before we notify the CM threads that
           // they can start working to make sure that all the
@@ -4367,6 +4513,10 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
         double pause_time_ms = (sample_end_time_sec - sample_start_time_sec) * MILLIUNITS;
         g1_policy()->record_collection_pause_end(pause_time_ms, evacuation_info);
 
+        if (TenantHeapIsolation) {
+          G1TenantAllocationContexts::record_pause(pause_time_ms, _gc_tracer_stw);
+        }
+
         MemoryService::track_memory_usage();
 
         // In prepare_for_verify() below we'll need to scan the deferred
@@ -4468,20 +4618,26 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
   return true;
 }
 
-void G1CollectedHeap::init_for_evac_failure(OopsInHeapRegionClosure* cl) {
-  _drain_in_progress = false;
-  set_evac_failure_closure(cl);
-  _evac_failure_scan_stack = new (ResourceObj::C_HEAP, mtGC) GrowableArray<oop>(40, true);
-}
+class G1RestorePreservedMarksTask : public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+  volatile jint    _next_stack;
 
-void G1CollectedHeap::finalize_for_evac_failure() {
-  assert(_evac_failure_scan_stack != NULL &&
-         _evac_failure_scan_stack->length() == 0,
-         "Postcondition");
-  assert(!_drain_in_progress, "Postcondition");
-  delete _evac_failure_scan_stack;
-  _evac_failure_scan_stack = NULL;
-}
+public:
+  G1RestorePreservedMarksTask(G1CollectedHeap* g1h) :
+    AbstractGangTask("G1 Restore Preserved Marks"),
+    _g1h(g1h), _next_stack(0) { }
+
+  void work(uint worker_id) {
+    // The stacks are filled by whichever workers hit evacuation failures,
+    // so claim them one at a time rather than by worker id.
+    uint n_stacks = (uint) MAX2((int) ParallelGCThreads, 1);
+    uint i = (uint) Atomic::add(1, &_next_stack) - 1;
+    while (i < n_stacks) {
+      _g1h->restore_preserved_marks(i);
+      i = (uint) Atomic::add(1, &_next_stack) - 1;
+    }
+  }
+};
 
 void G1CollectedHeap::remove_self_forwarding_pointers() {
   assert(check_cset_heap_region_claim_values(HeapRegion::InitialClaimValue), "sanity");
@@ -4506,33 +4662,18 @@ void G1CollectedHeap::remove_self_forwarding_pointers() {
   assert(check_cset_heap_region_claim_values(HeapRegion::InitialClaimValue), "sanity");
 
   // Now restore saved marks, if any.
-  assert(_objs_with_preserved_marks.size() ==
-            _preserved_marks_of_objs.size(), "Both or none.");
-  while (!_objs_with_preserved_marks.is_empty()) {
-    oop obj = _objs_with_preserved_marks.pop();
-    markOop m = _preserved_marks_of_objs.pop();
-    obj->set_mark(m);
+  G1RestorePreservedMarksTask restore_task(this);
+  if (G1CollectedHeap::use_parallel_gc_threads()) {
+    set_par_threads();
+    workers()->run_task(&restore_task);
+    set_par_threads(0);
+  } else {
+    restore_task.work(0);
   }
-  _objs_with_preserved_marks.clear(true);
-  _preserved_marks_of_objs.clear(true);
 
   g1_policy()->phase_times()->record_evac_fail_remove_self_forwards((os::elapsedTime() - remove_self_forwards_start) * 1000.0);
 }
 
-void G1CollectedHeap::push_on_evac_failure_scan_stack(oop obj) {
-  _evac_failure_scan_stack->push(obj);
-}
-
-void G1CollectedHeap::drain_evac_failure_scan_stack() {
-  assert(_evac_failure_scan_stack != NULL, "precondition");
-
-  while (_evac_failure_scan_stack->length() > 0) {
-     oop obj = _evac_failure_scan_stack->pop();
-     _evac_failure_closure->set_region(heap_region_containing(obj));
-     obj->oop_iterate_backwards(_evac_failure_closure);
-  }
-}
-
 oop
 G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state,
                                                oop old) {
@@ -4542,29 +4683,27 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
   markOop m = old->mark();
   oop forward_ptr = old->forward_to_atomic(old, memory_order_relaxed);
   if (forward_ptr == NULL) {
-    // Forward-to-self succeeded.
+    // Forward-to-self succeeded. We are the only thread that will do
+    // this for "old", so all the bookkeeping below goes into per worker
+    // structures and needs no locking.
     assert(_par_scan_state != NULL, "par scan state");
-    OopsInHeapRegionClosure* cl = _par_scan_state->evac_failure_closure();
     uint queue_num = _par_scan_state->queue_num();
 
     _evacuation_failed = true;
     _evacuation_failed_info_array[queue_num].register_copy_failure(old->size());
-    if (_evac_failure_closure != cl) {
-      MutexLockerEx x(EvacFailureStack_lock, Mutex::_no_safepoint_check_flag);
-      assert(!_drain_in_progress,
-             "Should only be true while someone holds the lock.");
-      // Set the global evac-failure closure to the current thread's.
-      assert(_evac_failure_closure == NULL, "Or locking has failed.");
-      set_evac_failure_closure(cl);
-      // Now do the common part.
-      handle_evacuation_failure_common(old, m);
-      // Reset to NULL.
-      set_evac_failure_closure(NULL);
-    } else {
-      // The lock is already held, and this is recursive.
-      assert(_drain_in_progress, "This should only be the recursive case.");
-      handle_evacuation_failure_common(old, m);
+    preserve_mark_if_necessary(queue_num, old, m);
+
+    HeapRegion* r = heap_region_containing(old);
+    if (!r->evacuation_failed()) {
+      // Racing workers may both get here; setting the flag twice is benign.
+      r->set_evacuation_failed(true);
+      _hr_printer.evac_failure(r);
     }
+
+    // Scan the object with the worker's regular scanner. References into
+    // the collection set are pushed onto the worker's own queue instead of
+    // being evacuated recursively.
+    _par_scan_state->scan_evacuation_failed_object(r, old);
     return old;
   } else {
     // Forward-to-self failed. Either someone else managed to allocate
@@ -4578,35 +4717,29 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
   }
 }
 
-void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m) {
-  preserve_mark_if_necessary(old, m);
-
-  HeapRegion* r = heap_region_containing(old);
-  if (!r->evacuation_failed()) {
-    r->set_evacuation_failed(true);
-    _hr_printer.evac_failure(r);
-  }
-
-  push_on_evac_failure_scan_stack(old);
-
-  if (!_drain_in_progress) {
-    // prevent recursion in copy_to_survivor_space()
-    _drain_in_progress = true;
-    drain_evac_failure_scan_stack();
-    _drain_in_progress = false;
-  }
-}
-
-void G1CollectedHeap::preserve_mark_if_necessary(oop obj, markOop m) {
+void G1CollectedHeap::preserve_mark_if_necessary(uint queue_num, oop obj, markOop m) {
   assert(evacuation_failed(), "Oversaving!");
   // We want to call the "for_promotion_failure" version only in the
   // case of a promotion failure.
   if (m->must_be_preserved_for_promotion_failure(obj)) {
-    _objs_with_preserved_marks.push(obj);
-    _preserved_marks_of_objs.push(m);
+    _objs_with_preserved_marks[queue_num].push(obj);
+    _preserved_marks_of_objs[queue_num].push(m);
   }
 }
 
+void G1CollectedHeap::restore_preserved_marks(uint queue_num) {
+  PreservedOopStack* objs = &_objs_with_preserved_marks[queue_num];
+  PreservedMarkStack* marks = &_preserved_marks_of_objs[queue_num];
+  assert(objs->size() == marks->size(), "Both or none.");
+  while (!objs->is_empty()) {
+    oop obj = objs->pop();
+    markOop m = marks->pop();
+    obj->set_mark(m);
+  }
+  objs->clear(true);
+  marks->clear(true);
+}
+
 void G1ParCopyHelper::mark_object(oop obj) {
   assert(!_g1->heap_region_containing(obj)->in_collection_set(), "should not mark objects in the CSet");
 
@@ -4672,6 +4805,14 @@ void G1ParCopyClosure<barrier, do_mark_object>::do_oop_work(T* p) {
   } else {
     if (state.is_humongous()) {
       _g1->set_humongous_is_live(obj);
+    } else if (state.is_optional()) {
+      // The location is updated by the increment evacuating the region.
+      _par_scan_state->remember_root_into_optional_region(p);
+      if (barrier == G1BarrierKlass) {
+        // Where the object goes is not known yet, conservatively
+        // assume it becomes young.
+        _scanned_klass->record_modified_oops();
+      }
     }
     // The object is not in collection set. If we're a root scanning
     // closure during an initial mark pause then attempt to mark the object.
@@ -4680,14 +4821,8 @@ void G1ParCopyClosure<barrier, do_mark_object>::do_oop_work(T* p) {
     }
   }
 
-  if (barrier == G1BarrierEvac) {
-    _par_scan_state->update_rs(_from, p, _worker_id);
-  }
 }
 
-template void G1ParCopyClosure<G1BarrierEvac, G1MarkNone>::do_oop_work(oop* p);
-template void G1ParCopyClosure<G1BarrierEvac, G1MarkNone>::do_oop_work(narrowOop* p);
-
 class G1ParEvacuateFollowersClosure : public VoidClosure {
 protected:
   G1CollectedHeap*              _g1h;
@@ -4831,9 +4966,6 @@ public:
       ReferenceProcessor*             rp = _g1h->ref_processor_stw();
 
       G1ParScanThreadState            pss(_g1h, worker_id, rp);
-      G1ParScanHeapEvacFailureClosure evac_failure_cl(_g1h, &pss, rp);
-
-      pss.set_evac_failure_closure(&evac_failure_cl);
 
       bool only_young = _g1h->g1_policy()->gcs_are_young();
 
@@ -4923,6 +5055,110 @@ public:
   }
 };
 
+// Evacuates an increment of optional regions once G1ParTask is done. Every
+// worker first updates the locations into the increment it remembered
+// itself, then scans the remembered sets and strong code roots of the
+// increment and finally drains the work queues.
+class G1EvacuateOptionalRegionsTask : public AbstractGangTask {
+  G1CollectedHeap*   _g1h;
+  RefToScanQueueSet* _queues;
+  G1RootProcessor*   _root_processor;
+  HeapRegion**       _regions;
+  uint               _num_regions;
+  TaskTerminator     _terminator;
+  uint               _n_workers;
+
+  template <class T>
+  void process_heap_ref(G1ParScanThreadState* pss, T* p) {
+    HeapRegion* from = _g1h->heap_region_containing_raw(p);
+    if (from->in_collection_set() && !from->evacuation_failed()) {
+      // The location is in a from-space object. Its copy, or the object
+      // itself should its evacuation fail, is scanned anyway.
+      return;
+    }
+    pss->push_on_queue(p);
+  }
+
+  void process_optional_refs(G1ParScanThreadState* pss, OopClosure* root_cl, uint worker_id) {
+    G1OptionalRefs* refs = _g1h->optional_refs(worker_id);
+
+    Stack<StarTask, mtGC>* heap_refs = refs->heap_refs_to_process();
+    while (!heap_refs->is_empty()) {
+      StarTask ref = heap_refs->pop();
+      if (ref.is_narrow()) {
+        process_heap_ref(pss, (narrowOop*)ref);
+      } else {
+        process_heap_ref(pss, (oop*)ref);
+      }
+    }
+
+    Stack<StarTask, mtGC>* root_refs = refs->root_refs_to_process();
+    while (!root_refs->is_empty()) {
+      StarTask ref = root_refs->pop();
+      if (ref.is_narrow()) {
+        root_cl->do_oop((narrowOop*)ref);
+      } else {
+        root_cl->do_oop((oop*)ref);
+      }
+    }
+  }
+
+public:
+  G1EvacuateOptionalRegionsTask(G1CollectedHeap* g1h,
+                                RefToScanQueueSet* task_queues,
+                                G1RootProcessor* root_processor,
+                                HeapRegion** regions,
+                                uint num_regions)
+    : AbstractGangTask("G1 optional collection"),
+      _g1h(g1h),
+      _queues(task_queues),
+      _root_processor(root_processor),
+      _regions(regions),
+      _num_regions(num_regions),
+      _terminator(0, _queues),
+      _n_workers(0)
+  {}
+
+  virtual void set_for_termination(int active_workers) {
+    _terminator.terminator()->reset_for_reuse(active_workers);
+    _n_workers = active_workers;
+  }
+
+  void work(uint worker_id) {
+    if (worker_id >= _n_workers) return;  // no work needed this round
+
+    double start_sec = os::elapsedTime();
+    {
+      ResourceMark rm;
+      HandleMark   hm;
+
+      ReferenceProcessor*             rp = _g1h->ref_processor_stw();
+
+      G1ParScanThreadState            pss(_g1h, worker_id, rp);
+
+      // Optional increments are never part of an initial mark pause.
+      G1ParScanExtRootClosure root_cl(_g1h, &pss, rp);
+
+      process_optional_refs(&pss, &root_cl, worker_id);
+
+      G1ParPushHeapRSClosure push_heap_rs_cl(_g1h, &pss);
+      _root_processor->scan_optional_remembered_sets(&push_heap_rs_cl,
+                                                     &root_cl,
+                                                     _regions,
+                                                     _num_regions,
+                                                     worker_id);
+
+      G1ParEvacuateFollowersClosure evac(_g1h, &pss, _queues, _terminator.terminator());
+      evac.do_void();
+
+      _g1h->g1_policy()->record_thread_age_table(pss.age_table());
+
+      assert(pss.queue_is_empty(), "should be empty");
+    }
+    _g1h->g1_policy()->phase_times()->add_time_secs(G1GCPhaseTimes::OptObjCopy, worker_id, os::elapsedTime() - start_sec);
+  }
+};
+
 class G1StringSymbolTableUnlinkTask : public AbstractGangTask {
 private:
   BoolObjectClosure* _is_alive;
@@ -5556,9 +5792,6 @@ public:
     G1STWIsAliveClosure is_alive(_g1h);
 
     G1ParScanThreadState            pss(_g1h, worker_id, NULL);
-    G1ParScanHeapEvacFailureClosure evac_failure_cl(_g1h, &pss, NULL);
-
-    pss.set_evac_failure_closure(&evac_failure_cl);
 
     G1ParScanExtRootClosure        only_copy_non_heap_cl(_g1h, &pss, NULL);
 
@@ -5642,7 +5875,7 @@ class G1ParPreserveCMReferentsTask: public AbstractGangTask {
 protected:
   G1CollectedHeap* _g1h;
   RefToScanQueueSet      *_queues;
-  ParallelTaskTerminator _terminator;
+  TaskTerminator         _terminator;
   uint _n_workers;
 
 public:
@@ -5659,9 +5892,6 @@ public:
     HandleMark   hm;
 
     G1ParScanThreadState            pss(_g1h, worker_id, NULL);
-    G1ParScanHeapEvacFailureClosure evac_failure_cl(_g1h, &pss, NULL);
-
-    pss.set_evac_failure_closure(&evac_failure_cl);
 
     assert(pss.queue_is_empty(), "both queue and overflow should be empty");
 
@@ -5714,7 +5944,7 @@ public:
     }
 
     // Drain the queue - which may cause stealing
-    G1ParEvacuateFollowersClosure drain_queue(_g1h, &pss, _queues, &_terminator);
+    G1ParEvacuateFollowersClosure drain_queue(_g1h, &pss, _queues, _terminator.terminator());
     drain_queue.do_void();
     // Allocation buffers were retired at the end of G1ParEvacuateFollowersClosure
     assert(pss.queue_is_empty(), "should be");
@@ -5777,15 +6007,11 @@ void G1CollectedHeap::process_discovered_references(uint no_of_gc_workers) {
   // Use only a single queue for this PSS.
   G1ParScanThreadState            pss(this, 0, NULL);
 
+  assert(pss.queue_is_empty(), "pre-condition");
+
   // We do not embed a reference processor in the copying/scanning
   // closures while we're actually processing the discovered
   // reference objects.
-  G1ParScanHeapEvacFailureClosure evac_failure_cl(this, &pss, NULL);
-
-  pss.set_evac_failure_closure(&evac_failure_cl);
-
-  assert(pss.queue_is_empty(), "pre-condition");
-
   G1ParScanExtRootClosure        only_copy_non_heap_cl(this, &pss, NULL);
 
   G1ParScanAndMarkExtRootClosure copy_mark_non_heap_cl(this, &pss, NULL);
@@ -5874,6 +6100,66 @@ void G1CollectedHeap::enqueue_discovered_references(uint no_of_gc_workers) {
   g1_policy()->phase_times()->record_ref_enq_time(ref_enq_time * 1000.0);
 }
 
+// References into old regions stay valid across young-only pauses; young
+// and humongous objects may move or be eagerly reclaimed.
+class G1IsStableRefClosure : public BoolObjectClosure {
+  G1CollectedHeap* _g1;
+public:
+  G1IsStableRefClosure(G1CollectedHeap* g1) : _g1(g1) { }
+  bool do_object_b(oop obj) { return _g1->heap_region_containing(obj)->is_old(); }
+};
+
+void G1CollectedHeap::evacuate_optional_collection_set(uint n_workers, EvacuationInfo& evacuation_info) {
+  G1CollectorPolicy* policy = g1_policy();
+  G1GCPhaseTimes* phase_times = policy->phase_times();
+  uint n_queues = MAX2((int)ParallelGCThreads, 1);
+
+  ResourceMark rm;
+  HeapRegion** regions = NEW_RESOURCE_ARRAY(HeapRegion*, policy->optional_cset_region_length());
+
+  while (policy->optional_cset_region_length() > 0) {
+    double predicted_time_ms = 0.0;
+    uint num_regions = policy->add_optional_cset_increment(regions, &predicted_time_ms);
+    if (num_regions == 0) {
+      // The next optional region does not fit into the pause time goal.
+      break;
+    }
+
+    if (_hr_printer.is_active()) {
+      for (uint i = 0; i < num_regions; i++) {
+        _hr_printer.cset(regions[i]);
+      }
+    }
+
+    for (uint i = 0; i < n_queues; i++) {
+      optional_refs(i)->flip();
+    }
+    phase_times->note_optional_evacuation_start();
+
+    double start_sec = os::elapsedTime();
+    {
+      G1RootProcessor root_processor(this);
+      G1EvacuateOptionalRegionsTask task(this, _task_queues, &root_processor, regions, num_regions);
+      if (G1CollectedHeap::use_parallel_gc_threads()) {
+        workers()->run_task(&task);
+      } else {
+        task.set_for_termination(n_workers);
+        task.work(0);
+      }
+    }
+    phase_times->record_optional_evacuation(num_regions, predicted_time_ms,
+                                            (os::elapsedTime() - start_sec) * 1000.0);
+  }
+
+  // The references into the remaining optional regions are left as they
+  // are, the regions stay old and are not part of this collection set.
+  policy->clear_optional_cset_regions();
+  for (uint i = 0; i < n_queues; i++) {
+    optional_refs(i)->clear();
+  }
+  evacuation_info.set_collectionset_regions(policy->cset_region_length());
+}
+
 void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
   _expand_heap_after_alloc_failure = true;
   _evacuation_failed = false;
@@ -5894,14 +6180,21 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
            "If not dynamic should be using all the  workers");
     set_par_threads(n_workers);
 
-  init_for_evac_failure(NULL);
-
   rem_set()->prepare_for_younger_refs_iterate(true);
 
   assert(dirty_card_queue_set().completed_buffers_num() == 0, "Should be empty");
   double start_par_time_sec = os::elapsedTime();
   double end_par_time_sec;
 
+  G1IsStableRefClosure is_stable_ref(this);
+  if (EnableCoroutine && CoroutineIncrementalRootScan) {
+    // Only a young pause without marking may rely on what the previous
+    // pause recorded; the others scan all coroutines and record afresh.
+    bool can_skip = g1_policy()->gcs_are_young() && !g1_policy()->during_initial_mark_pause();
+    Coroutine::set_roots_scan_mode(can_skip ? Coroutine::_skip_unchanged : Coroutine::_scan_and_record,
+                                   &is_stable_ref);
+  }
+
   {
     G1RootProcessor root_processor(this);
     G1ParTask g1_par_task(this, _task_queues, &root_processor);
@@ -5931,6 +6224,10 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
     // reported parallel time.
   }
 
+  if (EnableCoroutine && CoroutineIncrementalRootScan) {
+    Coroutine::set_roots_scan_mode(Coroutine::_scan_all);
+  }
+
   G1GCPhaseTimes* phase_times = g1_policy()->phase_times();
 
   double par_time_ms = (end_par_time_sec - start_par_time_sec) * 1000.0;
@@ -5940,6 +6237,10 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
         (os::elapsedTime() - end_par_time_sec) * 1000.0;
   phase_times->record_code_root_fixup_time(code_root_fixup_time_ms);
 
+  if (g1_policy()->optional_cset_region_length() > 0) {
+    evacuate_optional_collection_set(n_workers, evacuation_info);
+  }
+
   set_par_threads(0);
 
   // Process any discovered reference objects - we have
@@ -5954,7 +6255,7 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
 
     G1STWIsAliveClosure is_alive(this);
     G1KeepAliveClosure keep_alive(this);
-    G1StringDedup::unlink_or_oops_do(&is_alive, &keep_alive, true, phase_times);
+    G1StringDedup::unlink_or_oops_do(&is_alive, &keep_alive, phase_times);
 
     double fixup_time_ms = (os::elapsedTime() - fixup_start) * 1000.0;
     phase_times->record_string_dedup_fixup_time(fixup_time_ms);
@@ -5976,8 +6277,6 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
     reset_heap_region_claim_values();
   }
 
-  finalize_for_evac_failure();
-
   if (evacuation_failed()) {
     remove_self_forwarding_pointers();
 
@@ -6484,10 +6783,10 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays are only considered with G1EagerReclaimHumongousObjArrays
+    // and outside of a concurrent cycle. The remembered set entries they
+    // induced on other regions are not cleaned up; see the candidate
+    // selection in RegisterHumongousWithInCSetFastTestClosure.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -6509,9 +6808,10 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              err_msg("Only eagerly reclaiming type arrays is supported, but the object "
-                      PTR_FORMAT " is not.",
+    guarantee(obj->is_typeArray() ||
+              (G1EagerReclaimHumongousObjArrays && obj->is_objArray()),
+              err_msg("Only eagerly reclaiming type arrays and object arrays is supported, "
+                      "but the object " PTR_FORMAT " is neither.",
                       p2i(r->bottom())));
 
     if (G1TraceEagerReclaimHumongousObjects) {
@@ -6797,6 +7097,9 @@ void G1CollectedHeap::rebuild_region_sets(bool free_list_only) {
 
   if (!free_list_only) {
     _allocator->set_used(cl.total_used());
+    if (TenantHeapIsolation) {
+      G1TenantAllocationContexts::recalculate_used(false /* after_marking */);
+    }
   }
   assert(_allocator->used_unlocked() == recalculate_used(),
          err_msg("inconsistent _allocator->used_unlocked(), "
@@ -6816,7 +7119,8 @@ bool G1CollectedHeap::is_in_closed_subset(const void* p) const {
 // Methods for the mutator alloc region
 
 HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
-                                                      bool force) {
+                                                      bool force,
+                                                      uint node_index) {
   assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
   assert(!force || g1_policy()->can_expand_young_list(),
          "if force is true we should be able to expand the young list");
@@ -6824,7 +7128,8 @@ HeapRegion* G1CollectedHeap::new_mutator_alloc_region(size_t word_size,
   if (force || !young_list_full) {
     HeapRegion* new_alloc_region = new_region(word_size,
                                               false /* is_old */,
-                                              false /* do_expand */);
+                                              false /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       set_region_short_lived_locked(new_alloc_region);
       _hr_printer.alloc(new_alloc_region, G1HRPrinter::Eden, young_list_full);
@@ -6842,6 +7147,9 @@ void G1CollectedHeap::retire_mutator_alloc_region(HeapRegion* alloc_region,
 
   g1_policy()->add_region_to_incremental_cset_lhs(alloc_region);
   _allocator->increase_used(allocated_bytes);
+  if (TenantHeapIsolation && !alloc_region->allocation_context().is_system()) {
+    alloc_region->allocation_context()->increase_used(allocated_bytes);
+  }
   _hr_printer.retire(alloc_region);
   // We update the eden sizes here, when the region is retired,
   // instead of when it's allocated, since this is the point that its
@@ -6869,14 +7177,16 @@ void G1CollectedHeap::set_par_threads() {
 
 HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size,
                                                  uint count,
-                                                 InCSetState dest) {
+                                                 InCSetState dest,
+                                                 uint node_index) {
   assert(FreeList_lock->owned_by_self(), "pre-condition");
 
   if (count < g1_policy()->max_regions(dest)) {
     const bool is_survivor = (dest.is_young());
     HeapRegion* new_alloc_region = new_region(word_size,
                                               !is_survivor,
-                                              true /* do_expand */);
+                                              true /* do_expand */,
+                                              node_index);
     if (new_alloc_region != NULL) {
       // We really only need to do this for old regions given that we
       // should never scan survivors. But it doesn't hurt to do it
@@ -6888,6 +7198,11 @@ HeapRegion* G1CollectedHeap::new_gc_alloc_region(size_t word_size,
         check_bitmaps("Survivor Region Allocation", new_alloc_region);
       } else {
         new_alloc_region->set_old();
+        if (G1RebuildRemSetsConcurrently) {
+          // Only collection set candidates get their remembered set
+          // rebuilt after the next marking.
+          new_alloc_region->rem_set()->set_state_untracked();
+        }
         _hr_printer.alloc(new_alloc_region, G1HRPrinter::Old);
         check_bitmaps("Old Region Allocation", new_alloc_region);
       }
@@ -84,6 +84,38 @@ class ElasticHeap;
 typedef OverflowTaskQueue<StarTask, mtGC>         RefToScanQueue;
 typedef GenericTaskQueueSet<RefToScanQueue, mtGC> RefToScanQueueSet;
 
+// Locations found during an evacuation pause that point into optional
+// regions of the collection set (see InCSetState::Optional). Every GC worker
+// remembers them into its own instance, so that a later evacuation increment
+// can update them once their regions have been added to the collection set.
+// Heap and root locations are kept apart as they need different closures.
+// An increment drains the previous buffers while newly found locations go to
+// the current ones.
+class G1OptionalRefs : public CHeapObj<mtGC> {
+  Stack<StarTask, mtGC> _heap_refs[2];
+  Stack<StarTask, mtGC> _root_refs[2];
+  uint _cur;
+
+ public:
+  G1OptionalRefs() : _cur(0) { }
+
+  template <class T> void remember_heap_ref(T* p) { _heap_refs[_cur].push(StarTask(p)); }
+  template <class T> void remember_root_ref(T* p) { _root_refs[_cur].push(StarTask(p)); }
+
+  // Makes the current buffers the ones drained by the next increment.
+  void flip() { _cur ^= 1; }
+
+  Stack<StarTask, mtGC>* heap_refs_to_process() { return &_heap_refs[_cur ^ 1]; }
+  Stack<StarTask, mtGC>* root_refs_to_process() { return &_root_refs[_cur ^ 1]; }
+
+  void clear() {
+    for (uint i = 0; i < 2; i++) {
+      _heap_refs[i].clear(true);
+      _root_refs[i].clear(true);
+    }
+  }
+};
+
 typedef int RegionIdx_t;   // needs to hold [ 0..max_regions() )
 typedef int CardIdx_t;     // needs to hold [ 0..CardsPerRegion )
 
@@ -214,6 +246,7 @@ class G1CollectedHeap : public SharedHeap {
   friend class CountRCClosure;
   friend class EvacPopObjClosure;
   friend class G1ParCleanupCTTask;
+  friend class G1RestorePreservedMarksTask;
 
   friend class G1FreeHumongousRegionClosure;
   // Other related classes.
@@ -272,6 +305,9 @@ private:
   // Class that handles the different kinds of allocations.
   G1Allocator* _allocator;
 
+  // Maps regions and threads to NUMA nodes.
+  G1NUMA* _numa;
+
   // Statistics for each allocation context
   AllocationContextStats _allocation_context_stats;
 
@@ -361,6 +397,11 @@ private:
   bool _concurrent_cycle_started;
   bool _heap_summary_sent;
 
+  // Capacity the heap is uncommitted down to. Starts at
+  // G1SoftMaxHeapSize and is lowered and raised again by the memory
+  // pressure polling (G1MemoryPressurePollInterval). 0 if unset.
+  volatile size_t _soft_max_heap_size;
+
   // This is a non-product method that is helpful for testing. It is
   // called at the end of a GC and artificially expands the heap by
   // allocating a number of dead regions. This way we can induce very
@@ -382,6 +423,9 @@ private:
                                                          size_t size,
                                                          size_t translation_factor);
 
+  // The page size the Java heap is committed and uncommitted in.
+  static size_t heap_page_size();
+
   void trace_heap(GCWhen::Type when, GCTracer* tracer);
 
   double verify(bool guard, const char* msg);
@@ -472,8 +516,10 @@ protected:
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
-  // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // humongous object, set is_old to true. If not, to false. With
+  // G1NUMAAware a region on the NUMA node node_index is preferred.
+  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -587,13 +633,14 @@ protected:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force,
+                                       uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   HeapRegion* new_gc_alloc_region(size_t word_size, uint count,
-                                  InCSetState dest);
+                                  InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -645,6 +692,8 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const { return _numa; }
+
   G1MonitoringSupport* g1mm() {
     assert(_g1mm != NULL, "should have been initialized");
     return _g1mm;
@@ -656,6 +705,14 @@ public:
   // (Rounds up to a HeapRegion boundary.)
   bool expand(size_t expand_bytes);
 
+  // Uncommit free regions until the capacity is down to
+  // soft_max_heap_size(), keeping at least MinHeapFreeRatio percent of
+  // the heap free. Called at a safepoint outside of a collection.
+  void shrink_to_soft_max_heap_size(const char* reason);
+
+  size_t soft_max_heap_size() const { return _soft_max_heap_size; }
+  void set_soft_max_heap_size(size_t size) { _soft_max_heap_size = size; }
+
   // Returns the PLAB statistics for a given destination.
   inline PLABStats* alloc_buffer_stats(InCSetState dest);
 
@@ -690,6 +747,12 @@ public:
   void register_old_region_with_in_cset_fast_test(HeapRegion* r) {
     _in_cset_fast_test.set_in_old(r->hrm_index());
   }
+  void register_optional_region_with_in_cset_fast_test(HeapRegion* r) {
+    _in_cset_fast_test.set_optional(r->hrm_index());
+  }
+  void clear_optional_region_in_cset_fast_test(HeapRegion* r) {
+    _in_cset_fast_test.clear_optional(r->hrm_index());
+  }
 
   // This is a fast test on whether a reference points into the
   // collection set or not. Assume that the reference
@@ -791,6 +854,10 @@ protected:
   // Actually do the work of evacuating the collection set.
   void evacuate_collection_set(EvacuationInfo& evacuation_info);
 
+  // Evacuate the optional regions of the collection set in increments,
+  // as long as they are predicted to fit into the remaining pause time.
+  void evacuate_optional_collection_set(uint n_workers, EvacuationInfo& evacuation_info);
+
   // The g1 remembered set of the heap.
   G1RemSet* _g1_rem_set;
 
@@ -834,48 +901,31 @@ protected:
 
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
+  // Per worker locations pointing into optional regions of the collection
+  // set, only allocated with G1UseOptionalCSetIncrements.
+  G1OptionalRefs* _optional_refs_array;
+
   // Failed evacuations cause some logical from-space objects to have
   // forwarding pointers to themselves.  Reset them.
   void remove_self_forwarding_pointers();
 
-  // Together, these store an object with a preserved mark, and its mark value.
-  Stack<oop, mtGC>     _objs_with_preserved_marks;
-  Stack<markOop, mtGC> _preserved_marks_of_objs;
+  typedef Stack<oop, mtGC>     PreservedOopStack;
+  typedef Stack<markOop, mtGC> PreservedMarkStack;
+
+  // Together, these store the objects with a preserved mark, and their mark
+  // values. There is one pair of stacks per worker so that evacuation
+  // failures can be recorded without synchronization.
+  PreservedOopStack*  _objs_with_preserved_marks;
+  PreservedMarkStack* _preserved_marks_of_objs;
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_if_necessary(oop obj, markOop m);
-
-  // The stack of evac-failure objects left to be scanned.
-  GrowableArray<oop>*    _evac_failure_scan_stack;
-  // The closure to apply to evac-failure objects.
-
-  OopsInHeapRegionClosure* _evac_failure_closure;
-  // Set the field above.
-  void
-  set_evac_failure_closure(OopsInHeapRegionClosure* evac_failure_closure) {
-    _evac_failure_closure = evac_failure_closure;
-  }
-
-  // Push "obj" on the scan stack.
-  void push_on_evac_failure_scan_stack(oop obj);
-  // Process scan stack entries until the stack is empty.
-  void drain_evac_failure_scan_stack();
-  // True iff an invocation of "drain_scan_stack" is in progress; to
-  // prevent unnecessary recursion.
-  bool _drain_in_progress;
-
-  // Do any necessary initialization for evacuation-failure handling.
-  // "cl" is the closure that will be used to process evac-failure
-  // objects.
-  void init_for_evac_failure(OopsInHeapRegionClosure* cl);
-  // Do any necessary cleanup for evacuation-failure handling data
-  // structures.
-  void finalize_for_evac_failure();
+  void preserve_mark_if_necessary(uint queue_num, oop obj, markOop m);
+  // Restore the marks recorded by worker "queue_num" and empty its stacks.
+  void restore_preserved_marks(uint queue_num);
 
   // An attempt to evacuate "obj" has failed; take necessary steps.
   oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj);
-  void handle_evacuation_failure_common(oop obj, markOop m);
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -1012,6 +1062,11 @@ public:
 
   RefToScanQueue *task_queue(int i) const;
 
+  G1OptionalRefs* optional_refs(uint worker_i) const {
+    assert(_optional_refs_array != NULL, "only with optional collection set increments");
+    return &_optional_refs_array[worker_i];
+  }
+
   // A set of cards where updates happened during the GC
   DirtyCardQueueSet& dirty_card_queue_set() { return _dirty_card_queue_set; }
 
@@ -1092,6 +1147,7 @@ public:
 
   ConcurrentGCTimer* gc_timer_cm() const { return _gc_timer_cm; }
   G1OldTracer* gc_tracer_cm() const { return _gc_tracer_cm; }
+  G1NewTracer* gc_tracer_stw() const { return _gc_tracer_stw; }
 
   virtual size_t capacity() const;
   virtual size_t used() const;
@@ -1294,6 +1350,9 @@ public:
     object_iterate(cl);
   }
 
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num);
+  virtual FlexibleWorkGang* safepoint_workers() { return _workers; }
+
   // Iterate over all spaces in use in the heap, in ascending address order.
   virtual void space_iterate(SpaceClosure* cl);
 
@@ -1301,6 +1360,11 @@ public:
   // iteration early if the "doHeapRegion" method returns "true".
   void heap_region_iterate(HeapRegionClosure* blk) const;
 
+  // Iterate over the heap regions claimed one by one through the shared
+  // "next_index", see HeapRegionManager::par_iterate_claimed().
+  void heap_region_par_iterate_claimed(HeapRegionClosure* blk,
+                                       volatile jint* next_index) const;
+
   // Return the region with the given index. It assumes the index is valid.
   inline HeapRegion* region_at(uint index) const;
 
@@ -1399,6 +1463,12 @@ public:
   // Does this heap support heap inspection? (+PrintClassHistogram)
   virtual bool supports_heap_inspection() const { return true; }
 
+  // JNI critical sections pin the region of their object, so that they do
+  // not need to block garbage collections.
+  virtual bool supports_object_pinning() const { return G1UseRegionPinning; }
+  virtual void pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Section on thread-local allocation buffers (TLABs)
   // See CollectedHeap for semantics.
 
@@ -158,12 +158,15 @@ inline HeapWord* G1CollectedHeap::survivor_attempt_allocation(size_t word_size,
   assert(!isHumongous(word_size),
          "we should not be seeing humongous-size allocations in this path");
 
-  HeapWord* result = _allocator->survivor_gc_alloc_region(context)->attempt_allocation(word_size,
-                                                                                       false /* bot_updates */);
+  // Look the alloc region up once, the worker may move to another NUMA
+  // node in the meantime.
+  SurvivorGCAllocRegion* survivor_gc_alloc_region = _allocator->survivor_gc_alloc_region(context);
+  HeapWord* result = survivor_gc_alloc_region->attempt_allocation(word_size,
+                                                                  false /* bot_updates */);
   if (result == NULL) {
     MutexLockerEx x(FreeList_lock, Mutex::_no_safepoint_check_flag);
-    result = _allocator->survivor_gc_alloc_region(context)->attempt_allocation_locked(word_size,
-                                                                                      false /* bot_updates */);
+    result = survivor_gc_alloc_region->attempt_allocation_locked(word_size,
+                                                                 false /* bot_updates */);
   }
   if (result != NULL) {
     dirty_young_block(result, word_size);
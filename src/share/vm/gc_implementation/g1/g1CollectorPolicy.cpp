@@ -33,6 +33,7 @@
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "gc_implementation/shared/gcPolicyCounters.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -89,6 +90,12 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _concurrent_mark_remark_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
   _concurrent_mark_cleanup_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
 
+  _marking_to_mixed_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
+  _old_gen_growth_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
+  _initial_mark_end_sec(0.0),
+  _prev_old_gen_sample_sec(0.0),
+  _prev_old_gen_used_bytes(0),
+
   _alloc_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _prev_collection_pause_end_ms(0.0),
   _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -135,6 +142,7 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _eden_cset_region_length(0),
   _survivor_cset_region_length(0),
   _old_cset_region_length(0),
+  _optional_cset_region_length(0),
 
   _collection_set(NULL),
   _collection_set_bytes_used_before(0),
@@ -817,6 +825,7 @@ void G1CollectorPolicy::record_full_collection_end() {
   _last_young_gc = false;
   clear_initiate_conc_mark_if_possible();
   clear_during_initial_mark_pause();
+  _initial_mark_end_sec = 0.0;
   _in_marking_window = false;
   _in_marking_window_im = false;
 
@@ -906,13 +915,43 @@ void G1CollectorPolicy::record_concurrent_pause() {
   }
 }
 
+size_t G1CollectorPolicy::ihop_capacity() {
+  size_t capacity = _g1->capacity();
+  size_t soft_max = _g1->soft_max_heap_size();
+  if (G1MemoryPressurePollInterval != 0 && soft_max != 0) {
+    capacity = MIN2(capacity, soft_max);
+  }
+  return capacity;
+}
+
+size_t G1CollectorPolicy::ihop_target_occupancy() {
+  return (size_t) ((double) ihop_capacity() * (100.0 - (double) G1ReservePercent) / 100.0);
+}
+
+size_t G1CollectorPolicy::conc_mark_start_threshold() {
+  if (!G1UseAdaptiveIHOP || !adaptive_ihop_prediction_active()) {
+    return (ihop_capacity() / 100) * InitiatingHeapOccupancyPercent;
+  }
+  // Start marking early enough that the old generation growth predicted
+  // for the marking cycle, plus room for the young generation, still
+  // fits below the target occupancy when mixed GCs can start.
+  size_t target_occupancy = ihop_target_occupancy();
+  size_t growth_during_marking =
+    (size_t) (predict_old_gen_growth_rate_ms() * predict_marking_to_mixed_time_ms());
+  size_t young_size = (size_t) _young_list_target_length * HeapRegion::GrainBytes;
+  size_t needed = growth_during_marking + young_size;
+  return needed < target_occupancy ? target_occupancy - needed : 0;
+}
+
 bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc_word_size) {
   if (_g1->concurrent_mark()->cmThread()->during_cycle()) {
     return false;
   }
 
-  size_t marking_initiating_used_threshold =
-    (_g1->capacity() / 100) * InitiatingHeapOccupancyPercent;
+  size_t marking_initiating_used_threshold = conc_mark_start_threshold();
+  double threshold_perc = G1UseAdaptiveIHOP ?
+    (double) marking_initiating_used_threshold * 100.0 / (double) ihop_capacity() :
+    (double) InitiatingHeapOccupancyPercent;
   size_t cur_used_bytes = _g1->non_young_capacity_bytes();
   size_t alloc_byte_size = alloc_word_size * HeapWordSize;
 
@@ -928,7 +967,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_perc,
         source);
       return true;
     } else {
@@ -942,7 +981,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_perc,
         source);
     }
   }
@@ -953,6 +992,53 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
 // Anything below that is considered to be zero
 #define MIN_TIMER_GRANULARITY 0.0000001
 
+void G1CollectorPolicy::update_adaptive_ihop(double end_time_sec, bool initial_mark_pause) {
+  size_t old_gen_used_bytes = _g1->non_young_capacity_bytes();
+  // Mixed GCs, cleanup and eager reclaim shrink the old generation; such
+  // intervals say nothing about the growth rate and are not sampled.
+  if (_prev_old_gen_sample_sec > 0.0 && old_gen_used_bytes >= _prev_old_gen_used_bytes) {
+    double interval_ms = (end_time_sec - _prev_old_gen_sample_sec) * 1000.0;
+    if (interval_ms > MIN_TIMER_GRANULARITY) {
+      _old_gen_growth_rate_ms_seq->add((double) (old_gen_used_bytes - _prev_old_gen_used_bytes) / interval_ms);
+    }
+  }
+  _prev_old_gen_sample_sec = end_time_sec;
+  _prev_old_gen_used_bytes = old_gen_used_bytes;
+
+  if (initial_mark_pause) {
+    _initial_mark_end_sec = end_time_sec;
+  }
+
+  bool prediction_active = adaptive_ihop_prediction_active();
+  size_t threshold = conc_mark_start_threshold();
+  size_t target_occupancy = ihop_target_occupancy();
+  double growth_rate_ms = prediction_active ? predict_old_gen_growth_rate_ms() : 0.0;
+  double marking_time_ms = prediction_active ? predict_marking_to_mixed_time_ms() : 0.0;
+  size_t young_size = (size_t) _young_list_target_length * HeapRegion::GrainBytes;
+
+  ergo_verbose6(ErgoConcCycles,
+                "update adaptive IHOP threshold",
+                ergo_format_byte_perc("threshold")
+                ergo_format_byte("target occupancy")
+                ergo_format_double("predicted old gen growth (bytes/ms)")
+                ergo_format_ms("predicted marking duration")
+                ergo_format_str("prediction active"),
+                threshold,
+                (double) threshold * 100.0 / (double) _g1->capacity(),
+                target_occupancy,
+                growth_rate_ms,
+                marking_time_ms,
+                prediction_active ? "true" : "false");
+
+  _g1->gc_tracer_stw()->report_adaptive_ihop_statistics(threshold,
+                                                        target_occupancy,
+                                                        old_gen_used_bytes,
+                                                        young_size,
+                                                        growth_rate_ms * 1000.0,
+                                                        marking_time_ms / 1000.0,
+                                                        prediction_active);
+}
+
 void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, EvacuationInfo& evacuation_info) {
   double end_time_sec = os::elapsedTime();
   assert(_cur_collection_pause_used_regions_at_start >= cset_region_length(),
@@ -973,6 +1059,9 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
 #endif // PRODUCT
 
   last_pause_included_initial_mark = during_initial_mark_pause();
+  if (G1UseAdaptiveIHOP) {
+    update_adaptive_ihop(end_time_sec, last_pause_included_initial_mark);
+  }
   if (last_pause_included_initial_mark) {
     record_concurrent_mark_init_end(0.0);
   } else if (need_to_start_conc_mark("end of GC")) {
@@ -1053,6 +1142,11 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
     // doing mixed GCs. Here we decide whether to start mixed GCs or not.
 
     if (!last_pause_included_initial_mark) {
+      if (_initial_mark_end_sec > 0.0) {
+        // Mixed GCs can start from the next pause on.
+        _marking_to_mixed_times_ms->add((end_time_sec - _initial_mark_end_sec) * 1000.0);
+        _initial_mark_end_sec = 0.0;
+      }
       if (next_gc_should_be_mixed("start mixed GCs",
                                   "do not start mixed GCs")) {
         set_gcs_are_young(false);
@@ -1130,7 +1224,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
 
     if (_collection_set_bytes_used_before > freed_bytes) {
       size_t copied_bytes = _collection_set_bytes_used_before - freed_bytes;
-      double average_copy_time = phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy);
+      double average_copy_time = phase_times()->average_obj_copy_time_ms();
       double cost_per_byte_ms = average_copy_time / (double) copied_bytes;
       if (_in_marking_window) {
         _cost_per_byte_ms_during_cm_seq->add(cost_per_byte_ms);
@@ -1141,7 +1235,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
 
     double all_other_time_ms = pause_time_ms -
       (phase_times()->average_time_ms(G1GCPhaseTimes::UpdateRS) + phase_times()->average_time_ms(G1GCPhaseTimes::ScanRS) +
-          phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy) + phase_times()->average_time_ms(G1GCPhaseTimes::Termination));
+          phase_times()->average_obj_copy_time_ms() + phase_times()->average_time_ms(G1GCPhaseTimes::Termination));
 
     double young_other_time_ms = 0.0;
     if (young_cset_region_length() > 0) {
@@ -1261,7 +1355,9 @@ void G1CollectorPolicy::adjust_concurrent_refinement(double update_rs_time,
     const double inc_k = 1.1, dec_k = 0.9;
 
     int g = cg1r->green_zone();
-    if (update_rs_time > goal_ms) {
+    if (G1ConcRefinementTargetUpdateRSTime) {
+      g = cg1r->green_zone_for_goal(update_rs_time, update_rs_processed_buffers, goal_ms);
+    } else if (update_rs_time > goal_ms) {
       g = (int)(g * dec_k);  // Can become 0, that's OK. That would mean a mutator-only processing.
     } else {
       if (update_rs_time < goal_ms && update_rs_processed_buffers > g) {
@@ -1377,6 +1473,18 @@ size_t G1CollectorPolicy::expansion_amount() {
   double recent_gc_overhead = recent_avg_pause_time_ratio() * 100.0;
   double threshold = _gc_overhead_perc;
   if (recent_gc_overhead > threshold) {
+    if (G1MemoryPressurePollInterval != 0 && _g1->soft_max_heap_size() != 0 &&
+        _g1->capacity() >= _g1->soft_max_heap_size()) {
+      // The soft max heap size was lowered because the container is
+      // short of memory, so do not grow on GC overhead.
+      ergo_verbose2(ErgoHeapSizing,
+                    "do not expand heap",
+                    ergo_format_reason("capacity at soft max heap size")
+                    ergo_format_byte("capacity")
+                    ergo_format_byte("soft max heap size"),
+                    _g1->capacity(), _g1->soft_max_heap_size());
+      return 0;
+    }
     // We will double the existing space, or take
     // G1ExpandByPercentOfAvailable % of the available expansion
     // space, whichever is smaller, bounded below by a minimum
@@ -1666,10 +1774,11 @@ G1CollectorPolicy::record_concurrent_mark_cleanup_end(int no_of_gc_threads) {
 
 // Add the heap region at the head of the non-incremental collection set
 void G1CollectorPolicy::add_old_region_to_cset(HeapRegion* hr) {
-  assert(_inc_cset_build_state == Active, "Precondition");
+  assert(_inc_cset_build_state == Active || _optional_cset_region_length > 0, "Precondition");
   assert(hr->is_old(), "the region should be old");
 
   assert(!hr->in_collection_set(), "should not already be in the CSet");
+  assert(hr->rem_set()->is_complete(), "the region should have a complete remembered set");
   hr->set_in_collection_set(true);
   hr->set_next_in_collection_set(_collection_set);
   _collection_set = hr;
@@ -1680,6 +1789,49 @@ void G1CollectorPolicy::add_old_region_to_cset(HeapRegion* hr) {
   _old_cset_region_length += 1;
 }
 
+uint G1CollectorPolicy::add_optional_cset_increment(HeapRegion** regions,
+                                                    double* predicted_time_ms) {
+  double pause_time_ms = (os::elapsedTime() - phase_times()->cur_collection_start_sec()) * 1000.0;
+  double time_remaining_ms = MAX2(max_pause_time_ms() - pause_time_ms, 0.0);
+
+  uint num_regions = 0;
+  double predicted_increment_time_ms = 0.0;
+  while (_optional_cset_region_length > 0) {
+    HeapRegion* hr = _collectionSetChooser->peek();
+    double region_time_ms = predict_region_elapsed_time_ms(hr, false /* for_young_gc */);
+    if (predicted_increment_time_ms + region_time_ms > time_remaining_ms) {
+      break;
+    }
+    predicted_increment_time_ms += region_time_ms;
+
+    _g1->clear_optional_region_in_cset_fast_test(hr);
+    _collectionSetChooser->remove_and_move_to_next(hr);
+    _g1->old_set_remove(hr);
+    add_old_region_to_cset(hr);
+    _optional_cset_region_length--;
+    regions[num_regions++] = hr;
+  }
+
+  ergo_verbose4(ErgoCSetConstruction,
+                "add optional increment to CSet",
+                ergo_format_region("increment")
+                ergo_format_region("optional")
+                ergo_format_ms("predicted increment time")
+                ergo_format_ms("remaining time"),
+                num_regions, _optional_cset_region_length,
+                predicted_increment_time_ms, time_remaining_ms);
+
+  *predicted_time_ms = predicted_increment_time_ms;
+  return num_regions;
+}
+
+void G1CollectorPolicy::clear_optional_cset_regions() {
+  for (uint i = 0; i < _optional_cset_region_length; i++) {
+    _g1->clear_optional_region_in_cset_fast_test(_collectionSetChooser->peek_at(i));
+  }
+  _optional_cset_region_length = 0;
+}
+
 // Initialize the per-collection-set information
 void G1CollectorPolicy::start_incremental_cset_building() {
   assert(_inc_cset_build_state == Inactive, "Precondition");
@@ -1949,6 +2101,88 @@ uint G1CollectorPolicy::calc_max_old_cset_length() {
 }
 
 
+// Shares the time budget for the old regions of a mixed GC among the
+// tenants which have candidate regions, in proportion to their heap
+// limits (see TenantFairCollectionSet).
+class G1TenantCSetBudget : public ResourceObj {
+private:
+  struct TenantShare {
+    AllocationContext_t context;
+    double              share_ms;
+    double              used_ms;
+    bool                skipped;  // the tenant's next candidate did not fit
+  };
+  GrowableArray<TenantShare> _shares;
+
+  TenantShare* share_of(AllocationContext_t context) {
+    for (int i = 0; i < _shares.length(); i++) {
+      if (_shares.at(i).context == context) {
+        return _shares.adr_at(i);
+      }
+    }
+    return NULL;
+  }
+
+  static size_t heap_limit_of(AllocationContext_t context) {
+    size_t limit = TENANT_HEAP_NO_LIMIT;
+    if (!context.is_system()) {
+      limit = context.tenant_allocation_context()->heap_size_limit();
+    }
+    // The root tenant and tenants without limit may use the whole heap
+    return limit == TENANT_HEAP_NO_LIMIT ? G1CollectedHeap::heap()->max_capacity() : limit;
+  }
+
+public:
+  G1TenantCSetBudget(CollectionSetChooser* chooser, double budget_ms) : _shares(8) {
+    assert(TenantFairCollectionSet, "pre-condition");
+    double total_limit = 0.0;
+    for (uint i = 0; i < chooser->remaining_regions(); i++) {
+      AllocationContext_t context = chooser->peek_at(i)->allocation_context();
+      if (share_of(context) == NULL) {
+        TenantShare share;
+        share.context = context;
+        share.share_ms = (double)heap_limit_of(context);
+        share.used_ms = 0.0;
+        share.skipped = false;
+        _shares.append(share);
+        total_limit += share.share_ms;
+      }
+    }
+    for (int i = 0; i < _shares.length(); i++) {
+      TenantShare* share = _shares.adr_at(i);
+      share->share_ms = budget_ms * share->share_ms / total_limit;
+    }
+  }
+
+  // Offset in the chooser of the best candidate whose tenant still has
+  // enough of its share left, 0 if no tenant has.
+  uint next_candidate_offset(G1CollectorPolicy* policy, CollectionSetChooser* chooser) {
+    for (int i = 0; i < _shares.length(); i++) {
+      _shares.adr_at(i)->skipped = false;
+    }
+    for (uint offset = 0; offset < chooser->remaining_regions(); offset++) {
+      HeapRegion* hr = chooser->peek_at(offset);
+      TenantShare* share = share_of(hr->allocation_context());
+      assert(share != NULL, "every candidate tenant has a share");
+      if (share->skipped) {
+        continue;
+      }
+      double predicted_time_ms = policy->predict_region_elapsed_time_ms(hr, false /* for_young_gc */);
+      if (share->used_ms + predicted_time_ms <= share->share_ms) {
+        return offset;
+      }
+      share->skipped = true;
+    }
+    return 0;
+  }
+
+  void charge(HeapRegion* hr, double predicted_time_ms) {
+    TenantShare* share = share_of(hr->allocation_context());
+    assert(share != NULL, "every candidate tenant has a share");
+    share->used_ms += predicted_time_ms;
+  }
+};
+
 void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInfo& evacuation_info) {
   double young_start_time_sec = os::elapsedTime();
 
@@ -2034,8 +2268,37 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
     uint expensive_region_num = 0;
     bool check_time_remaining = adaptive_young_list_length();
 
-    HeapRegion* hr = cset_chooser->peek();
+    ResourceMark rm;
+    G1TenantCSetBudget* tenant_budget = NULL;
+    if (TenantFairCollectionSet) {
+      tenant_budget = new G1TenantCSetBudget(cset_chooser, time_remaining_ms);
+    }
+
+    // Offset of hr from the current candidate, only non-zero when a
+    // tenant-fair pick skips regions of tenants which used up their share
+    uint offset = 0;
+    if (tenant_budget != NULL) {
+      offset = tenant_budget->next_candidate_offset(this, cset_chooser);
+    }
+    HeapRegion* hr = cset_chooser->peek_at(offset);
     while (hr != NULL) {
+      if (hr->is_pinned()) {
+        // The objects of regions accessed by JNI critical sections must
+        // not move. Drop the region from the candidates, the next marking
+        // cycle reconsiders it.
+        ergo_verbose1(ErgoCSetConstruction,
+                      "skip pinned old region",
+                      ergo_format_size("index"),
+                      (size_t) hr->hrm_index());
+        cset_chooser->remove_at_and_move_to_next(offset, hr);
+        offset = 0;
+        if (tenant_budget != NULL) {
+          offset = tenant_budget->next_candidate_offset(this, cset_chooser);
+        }
+        hr = cset_chooser->peek_at(offset);
+        continue;
+      }
+
       if (old_cset_region_length() >= max_old_cset_length) {
         // Added maximum number of old regions to the CSet.
         ergo_verbose2(ErgoCSetConstruction,
@@ -2112,11 +2375,21 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
       // We will add this region to the CSet.
       time_remaining_ms = MAX2(time_remaining_ms - predicted_time_ms, 0.0);
       predicted_pause_time_ms += predicted_time_ms;
-      cset_chooser->remove_and_move_to_next(hr);
+      if (TenantHeapIsolation) {
+        phase_times()->record_tenant_reclaimable_bytes(hr->allocation_context(), hr->reclaimable_bytes());
+      }
+      if (tenant_budget != NULL) {
+        tenant_budget->charge(hr, predicted_time_ms);
+      }
+      cset_chooser->remove_at_and_move_to_next(offset, hr);
       _g1->old_set_remove(hr);
       add_old_region_to_cset(hr);
 
-      hr = cset_chooser->peek();
+      offset = 0;
+      if (tenant_budget != NULL) {
+        offset = tenant_budget->next_candidate_offset(this, cset_chooser);
+      }
+      hr = cset_chooser->peek_at(offset);
     }
     if (hr == NULL) {
       ergo_verbose0(ErgoCSetConstruction,
@@ -2141,6 +2414,33 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
                     time_remaining_ms);
     }
 
+    assert(_optional_cset_region_length == 0, "optional regions of the last pause should have been cleared");
+    if (G1UseOptionalCSetIncrements && check_time_remaining &&
+        tenant_budget == NULL && !during_initial_mark_pause()) {
+      // Rather than leaving the candidates that did not fit into the
+      // predicted pause time to later mixed collections, register them as
+      // optional. They are evacuated in increments after the rest of the
+      // CSet, for as long as the actual pause time permits.
+      size_t reclaimable_bytes = cset_chooser->remaining_reclaimable_bytes();
+      HeapRegion* optional_hr = cset_chooser->peek_at(0);
+      while (optional_hr != NULL &&
+             old_cset_region_length() + _optional_cset_region_length < max_old_cset_length &&
+             reclaimable_bytes_perc(reclaimable_bytes) > (double) G1HeapWastePercent) {
+        _g1->register_optional_region_with_in_cset_fast_test(optional_hr);
+        reclaimable_bytes -= optional_hr->reclaimable_bytes();
+        _optional_cset_region_length += 1;
+        optional_hr = cset_chooser->peek_at(_optional_cset_region_length);
+      }
+      if (_optional_cset_region_length > 0) {
+        ergo_verbose2(ErgoCSetConstruction,
+                      "register optional old regions",
+                      ergo_format_region("old")
+                      ergo_format_region("optional"),
+                      old_cset_region_length(),
+                      _optional_cset_region_length);
+      }
+    }
+
     cset_chooser->verify();
   }
 
@@ -173,6 +173,7 @@ public:
 class G1CollectorPolicy: public CollectorPolicy {
   friend class ElasticHeap;
   friend class ElasticHeapEvaluator;
+  friend class PredictiveEvaluator;
 private:
   // either equal to the number of parallel threads, if ParallelGCThreads
   // has been set, or 1 otherwise
@@ -201,6 +202,15 @@ private:
   TruncatedSeq* _concurrent_mark_remark_times_ms;
   TruncatedSeq* _concurrent_mark_cleanup_times_ms;
 
+  // Adaptive IHOP (G1UseAdaptiveIHOP) samples: the time from the end
+  // of an initial-mark pause until mixed GCs can start, and the rate
+  // (in bytes per ms) at which the old generation grows between pauses.
+  TruncatedSeq* _marking_to_mixed_times_ms;
+  TruncatedSeq* _old_gen_growth_rate_ms_seq;
+  double        _initial_mark_end_sec;
+  double        _prev_old_gen_sample_sec;
+  size_t        _prev_old_gen_used_bytes;
+
   TraceGen0TimeData _trace_gen0_time_data;
   TraceGen1TimeData _trace_gen1_time_data;
 
@@ -236,7 +246,9 @@ private:
   }
 
   enum PredictionConstants {
-    TruncatedSeqLength = 10
+    TruncatedSeqLength = 10,
+    // Samples needed before the adaptive IHOP replaces the static one.
+    AdaptiveIHOPNumInitialSamples = 3
   };
 
   TruncatedSeq* _alloc_rate_ms_seq;
@@ -264,6 +276,11 @@ private:
   uint _survivor_cset_region_length;
   uint _old_cset_region_length;
 
+  // Number of old regions at the head of the collection set chooser that
+  // are registered as optional for the current pause, see
+  // G1UseOptionalCSetIncrements.
+  uint _optional_cset_region_length;
+
   void init_cset_region_lengths(uint eden_cset_region_length,
                                 uint survivor_cset_region_length);
 
@@ -451,6 +468,10 @@ public:
     return _mmu_tracker;
   }
 
+  CollectionSetChooser* cset_chooser() {
+    return _collectionSetChooser;
+  }
+
   double max_pause_time_ms() {
     return _mmu_tracker->max_gc_time() * 1000.0;
   }
@@ -463,6 +484,34 @@ public:
     return get_new_prediction(_concurrent_mark_cleanup_times_ms);
   }
 
+  bool adaptive_ihop_prediction_active() {
+    return _marking_to_mixed_times_ms->num() >= AdaptiveIHOPNumInitialSamples &&
+           _old_gen_growth_rate_ms_seq->num() >= AdaptiveIHOPNumInitialSamples;
+  }
+
+  double predict_marking_to_mixed_time_ms() {
+    return get_new_prediction(_marking_to_mixed_times_ms);
+  }
+
+  double predict_old_gen_growth_rate_ms() {
+    return get_new_prediction(_old_gen_growth_rate_ms_seq);
+  }
+
+  // The heap size the concurrent cycle thresholds relate to: the
+  // committed capacity, capped by the soft max heap size while the
+  // memory pressure polling lowered it so cycles start early enough
+  // for the heap to shrink.
+  size_t ihop_capacity();
+
+  // The old generation occupancy that the heap may reach by the time
+  // mixed GCs start without eating into the G1ReservePercent reserve.
+  size_t ihop_target_occupancy();
+
+  // The old generation occupancy at which a concurrent cycle should be
+  // requested, either given by InitiatingHeapOccupancyPercent or, with
+  // G1UseAdaptiveIHOP, derived from the predictions above.
+  size_t conc_mark_start_threshold();
+
   // Returns an estimate of the survival rate of the region at yg-age
   // "yg_age".
   double predict_yg_surv_rate(int age, SurvRateGroup* surv_rate_group) {
@@ -684,6 +733,10 @@ public:
 
   bool need_to_start_conc_mark(const char* source, size_t alloc_word_size = 0);
 
+  // Sample the old generation growth and the marking cycle duration at
+  // the end of a pause and report the resulting adaptive IHOP threshold.
+  void update_adaptive_ihop(double end_time_sec, bool initial_mark_pause);
+
   // Record the start and end of an evacuation pause.
   void record_collection_pause_start(double start_time_sec, GCTracer &tracer);
   void record_collection_pause_end(double pause_time_ms, EvacuationInfo& evacuation_info);
@@ -746,6 +799,18 @@ public:
   // Add old region "hr" to the CSet.
   void add_old_region_to_cset(HeapRegion* hr);
 
+  uint optional_cset_region_length() { return _optional_cset_region_length; }
+
+  // Add the next optional regions that are predicted to fit into the
+  // remaining pause time to the CSet, as one evacuation increment. Returns
+  // the number of regions added; they and their predicted evacuation time
+  // are returned in "regions" and "predicted_time_ms".
+  uint add_optional_cset_increment(HeapRegion** regions, double* predicted_time_ms);
+
+  // Unregister the optional regions not evacuated by the current pause. They
+  // remain candidates for the next mixed collections.
+  void clear_optional_cset_regions();
+
   // Incremental CSet Support
 
   // The head of the incrementally built collection set.
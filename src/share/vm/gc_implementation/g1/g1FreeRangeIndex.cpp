@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1FreeRangeIndex.hpp"
+#include "gc_implementation/g1/heapRegion.hpp"
+
+G1FreeRangeIndex::G1FreeRangeIndex(uint max_regions) : _max_regions(max_regions) {
+  _num_leaves = 1;
+  while (_num_leaves < max_regions) {
+    _num_leaves <<= 1;
+  }
+  _free = NEW_C_HEAP_ARRAY(bool, max_regions, mtGC);
+  _available = NEW_C_HEAP_ARRAY(bool, max_regions, mtGC);
+  for (uint i = 0; i < max_regions; i++) {
+    _free[i] = false;
+    _available[i] = false;
+  }
+
+  // No region is free yet and every region is uncommitted
+  for (int k = 0; k < kinds; k++) {
+    Node* nodes = NEW_C_HEAP_ARRAY(Node, 2 * _num_leaves, mtGC);
+    for (uint i = 0; i < _num_leaves; i++) {
+      uint candidate = (k == free_or_unavailable && i < max_regions) ? 1 : 0;
+      Node& leaf = nodes[_num_leaves + i];
+      leaf._prefix = leaf._suffix = leaf._longest = candidate;
+    }
+    uint len = 1;
+    for (uint first = _num_leaves / 2; first >= 1; first /= 2, len *= 2) {
+      for (uint n = first; n < 2 * first; n++) {
+        const Node& l = nodes[2 * n];
+        const Node& r = nodes[2 * n + 1];
+        nodes[n]._prefix  = l._prefix == len ? len + r._prefix : l._prefix;
+        nodes[n]._suffix  = r._suffix == len ? len + l._suffix : r._suffix;
+        nodes[n]._longest = MAX3(l._longest, r._longest, l._suffix + r._prefix);
+      }
+    }
+    _nodes[k] = nodes;
+  }
+}
+
+G1FreeRangeIndex::~G1FreeRangeIndex() {
+  for (int k = 0; k < kinds; k++) {
+    FREE_C_HEAP_ARRAY(Node, _nodes[k], mtGC);
+  }
+  FREE_C_HEAP_ARRAY(bool, _free, mtGC);
+  FREE_C_HEAP_ARRAY(bool, _available, mtGC);
+}
+
+void G1FreeRangeIndex::update(Kind kind, uint index, bool candidate) {
+  Node* nodes = _nodes[kind];
+  uint n = _num_leaves + index;
+  if ((nodes[n]._longest != 0) == candidate) {
+    return;
+  }
+  nodes[n]._prefix = nodes[n]._suffix = nodes[n]._longest = candidate ? 1 : 0;
+  uint len = 1;
+  for (n /= 2; n >= 1; n /= 2, len *= 2) {
+    const Node& l = nodes[2 * n];
+    const Node& r = nodes[2 * n + 1];
+    nodes[n]._prefix  = l._prefix == len ? len + r._prefix : l._prefix;
+    nodes[n]._suffix  = r._suffix == len ? len + l._suffix : r._suffix;
+    nodes[n]._longest = MAX3(l._longest, r._longest, l._suffix + r._prefix);
+  }
+}
+
+void G1FreeRangeIndex::set_free(uint index, bool free) {
+  assert(index < _max_regions, "index out of bounds");
+  _free[index] = free;
+  update(free_only, index, free);
+  update(free_or_unavailable, index, free || !_available[index]);
+}
+
+void G1FreeRangeIndex::set_available(uint index, bool available) {
+  assert(index < _max_regions, "index out of bounds");
+  _available[index] = available;
+  update(free_or_unavailable, index, _free[index] || !available);
+}
+
+uint G1FreeRangeIndex::find_contiguous(uint num, Kind kind) const {
+  const Node* nodes = _nodes[kind];
+  if (num == 0 || nodes[1]._longest < num) {
+    return G1_NO_HRM_INDEX;
+  }
+  // Descend towards the lowest run: into the left half if it holds one,
+  // else take the run across the middle if long enough, else go right.
+  uint n = 1;
+  uint start = 0;
+  uint len = _num_leaves;
+  while (len > 1) {
+    len /= 2;
+    const Node& l = nodes[2 * n];
+    const Node& r = nodes[2 * n + 1];
+    if (l._longest >= num) {
+      n = 2 * n;
+    } else if (l._suffix + r._prefix >= num) {
+      return start + len - l._suffix;
+    } else {
+      n = 2 * n + 1;
+      start += len;
+    }
+  }
+  return start;
+}
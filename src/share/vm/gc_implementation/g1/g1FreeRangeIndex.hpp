@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1FREERANGEINDEX_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1FREERANGEINDEX_HPP
+
+#include "memory/allocation.hpp"
+
+// Index over the region indices of the heap that finds the lowest run of
+// at least n contiguous candidate regions in O(log n), for the humongous
+// allocations that HeapRegionManager::find_contiguous would otherwise
+// serve by scanning all regions. It is a segment tree whose nodes keep
+// the length of the candidate run at the start and at the end of their
+// range and the longest run within it.
+//
+// Two kinds of candidates are tracked: regions on the master free list,
+// and regions that are on it or not available (uncommitted). The master
+// free list reports its membership changes and HeapRegionManager the
+// availability changes, both under the MT safety protocol of the master
+// free list, which also covers the lookups.
+class G1FreeRangeIndex : public CHeapObj<mtGC> {
+ public:
+  enum Kind {
+    free_only,            // on the master free list
+    free_or_unavailable,  // on the master free list or uncommitted
+    kinds
+  };
+
+ private:
+  struct Node {
+    uint _prefix;   // candidates at the start of the range
+    uint _suffix;   // candidates at the end of the range
+    uint _longest;  // longest run of candidates in the range
+  };
+
+  uint  _max_regions;
+  uint  _num_leaves;      // power of two >= _max_regions
+  Node* _nodes[kinds];    // nodes[1] is the root, leaves start at _num_leaves
+  bool* _free;
+  bool* _available;
+
+  void update(Kind kind, uint index, bool candidate);
+
+ public:
+  G1FreeRangeIndex(uint max_regions);
+  ~G1FreeRangeIndex();
+
+  void set_free(uint index, bool free);
+  void set_available(uint index, bool available);
+
+  // First region of the lowest run of num candidate regions of the given
+  // kind, or G1_NO_HRM_INDEX.
+  uint find_contiguous(uint num, Kind kind) const;
+
+  bool is_free(uint index) const      { return _free[index]; }
+  bool is_available(uint index) const { return _available[index]; }
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1FREERANGEINDEX_HPP
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1FullGCMarker.hpp"
+#include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/shared/markSweep.inline.hpp"
+#include "oops/objArrayOop.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/stack.inline.hpp"
+
+G1FullGCMarker**                  G1FullGCMarker::_markers         = NULL;
+G1FullGCMarker::OopQueueSet*      G1FullGCMarker::_oop_queues      = NULL;
+G1FullGCMarker::ObjArrayQueueSet* G1FullGCMarker::_objarray_queues = NULL;
+
+template <class T> inline void G1FullGCMarkAndPushClosure::do_oop_work(T* p) {
+  _marker->mark_and_push(p);
+}
+
+void G1FullGCMarkAndPushClosure::do_oop(oop* p)       { do_oop_work(p); }
+void G1FullGCMarkAndPushClosure::do_oop(narrowOop* p) { do_oop_work(p); }
+
+G1FullGCMarker::G1FullGCMarker(uint worker_id, ReferenceProcessor* rp) :
+  _worker_id(worker_id),
+  _mark_and_push(this, rp),
+  _cld_closure(&_mark_and_push) {
+  _oop_queue.initialize();
+  _objarray_queue.initialize();
+}
+
+void G1FullGCMarker::initialize(ReferenceProcessor* rp) {
+  if (_markers != NULL) {
+    return;
+  }
+  const uint n = (uint)ParallelGCThreads;
+  _oop_queues = new OopQueueSet(n);
+  _objarray_queues = new ObjArrayQueueSet(n);
+  _markers = NEW_C_HEAP_ARRAY(G1FullGCMarker*, n, mtGC);
+  for (uint i = 0; i < n; i++) {
+    _markers[i] = new G1FullGCMarker(i, rp);
+    _oop_queues->register_queue(i, &_markers[i]->_oop_queue);
+    _objarray_queues->register_queue(i, &_markers[i]->_objarray_queue);
+  }
+}
+
+bool G1FullGCMarker::par_mark(oop obj) {
+  markOop mark = obj->mark();
+  if (mark->is_marked()) {
+    return false;
+  }
+#if INCLUDE_ALL_GCS
+  if (G1StringDedup::is_enabled()) {
+    // The candidate check reads the age, so it has to happen before the
+    // header is replaced. Losing the race below only costs a duplicate.
+    G1StringDedup::enqueue_from_mark(obj, _worker_id);
+  }
+#endif
+  // Only GC workers change headers at this point, a failed CAS means
+  // another worker marked the object.
+  if (obj->cas_set_mark(markOopDesc::prototype()->set_marked(), mark) != mark) {
+    return false;
+  }
+  if (mark->must_be_preserved(obj)) {
+    _preserved_oops.push(obj);
+    _preserved_marks.push(mark);
+  }
+  return true;
+}
+
+template <class T> inline void G1FullGCMarker::mark_and_push(T* p) {
+  T heap_oop = oopDesc::load_heap_oop(p);
+  if (!oopDesc::is_null(heap_oop)) {
+    oop obj = oopDesc::decode_heap_oop_not_null(heap_oop);
+    if (par_mark(obj)) {
+      _oop_queue.push(obj);
+    }
+  }
+}
+
+void G1FullGCMarker::follow_object(oop obj) {
+  assert(obj->is_gc_marked(), "must be marked");
+  if (obj->is_objArray()) {
+    // Scanned in chunks so that the other workers can help with large arrays.
+    follow_array_chunk(objArrayOop(obj), 0);
+  } else {
+    obj->oop_iterate(&_mark_and_push);
+  }
+}
+
+void G1FullGCMarker::follow_array_chunk(objArrayOop array, int index) {
+  const int len = array->length();
+  const int end = MIN2(len, index + (int)ObjArrayMarkingStride);
+  if (end < len) {
+    _objarray_queue.push(ObjArrayTask(array, end));
+  }
+  array->oop_iterate_range(&_mark_and_push, index, end);
+}
+
+void G1FullGCMarker::drain_stacks() {
+  do {
+    oop obj;
+    // Drain the overflow stack first, to allow stealing from the queue.
+    while (_oop_queue.pop_overflow(obj)) {
+      follow_object(obj);
+    }
+    while (_oop_queue.pop_local(obj)) {
+      follow_object(obj);
+    }
+    ObjArrayTask task;
+    if (_objarray_queue.pop_overflow(task) || _objarray_queue.pop_local(task)) {
+      follow_array_chunk(objArrayOop(task.obj()), (int)task.index());
+    }
+  } while (!_oop_queue.is_empty() || !_objarray_queue.is_empty());
+}
+
+void G1FullGCMarker::complete_marking(ParallelTaskTerminator* terminator) {
+  oop obj;
+  ObjArrayTask task;
+  do {
+    drain_stacks();
+    while (_objarray_queues->steal(_worker_id, task)) {
+      follow_array_chunk(objArrayOop(task.obj()), (int)task.index());
+      drain_stacks();
+    }
+    while (_oop_queues->steal(_worker_id, obj)) {
+      follow_object(obj);
+      drain_stacks();
+    }
+  } while (!terminator->offer_termination());
+  assert(_oop_queue.is_empty() && _objarray_queue.is_empty(), "must be drained");
+}
+
+void G1FullGCMarker::adjust_preserved_marks() {
+  StackIterator<oop, mtGC> iter(_preserved_oops);
+  while (!iter.is_empty()) {
+    MarkSweep::adjust_pointer(iter.next_addr());
+  }
+}
+
+void G1FullGCMarker::restore_preserved_marks() {
+  while (!_preserved_oops.is_empty()) {
+    oop obj = _preserved_oops.pop();
+    obj->set_mark(_preserved_marks.pop());
+  }
+}
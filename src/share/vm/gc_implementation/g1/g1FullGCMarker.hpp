@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1FULLGCMARKER_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1FULLGCMARKER_HPP
+
+#include "memory/iterator.hpp"
+#include "oops/markOop.hpp"
+#include "utilities/stack.hpp"
+#include "utilities/taskqueue.hpp"
+
+class G1FullGCMarker;
+class ReferenceProcessor;
+
+class G1FullGCMarkAndPushClosure : public MetadataAwareOopClosure {
+  G1FullGCMarker* _marker;
+
+  template <class T> inline void do_oop_work(T* p);
+
+ public:
+  G1FullGCMarkAndPushClosure(G1FullGCMarker* marker, ReferenceProcessor* rp) :
+    MetadataAwareOopClosure(rp), _marker(marker) { }
+
+  virtual void do_oop(oop* p);
+  virtual void do_oop(narrowOop* p);
+};
+
+//
+// Marking state of one worker of the parallel G1 full GC. Objects are
+// marked by installing the marked pattern in the header with a CAS, the
+// displaced headers that must survive are preserved per worker. Work is
+// balanced by stealing from the other workers' queues.
+//
+class G1FullGCMarker : public CHeapObj<mtGC> {
+ public:
+  typedef OverflowTaskQueue<oop, mtGC>                  OopQueue;
+  typedef GenericTaskQueueSet<OopQueue, mtGC>           OopQueueSet;
+  typedef OverflowTaskQueue<ObjArrayTask, mtGC>         ObjArrayQueue;
+  typedef GenericTaskQueueSet<ObjArrayQueue, mtGC>      ObjArrayQueueSet;
+
+ private:
+  uint                       _worker_id;
+  OopQueue                   _oop_queue;
+  ObjArrayQueue              _objarray_queue;
+  Stack<oop, mtGC>           _preserved_oops;
+  Stack<markOop, mtGC>       _preserved_marks;
+  G1FullGCMarkAndPushClosure _mark_and_push;
+  CLDToOopClosure            _cld_closure;
+
+  static G1FullGCMarker**    _markers;
+  static OopQueueSet*        _oop_queues;
+  static ObjArrayQueueSet*   _objarray_queues;
+
+  bool par_mark(oop obj);
+  void follow_object(oop obj);
+  void follow_array_chunk(objArrayOop array, int index);
+
+ public:
+  G1FullGCMarker(uint worker_id, ReferenceProcessor* rp);
+
+  // Creates the markers of all workers on first use.
+  static void initialize(ReferenceProcessor* rp);
+  static G1FullGCMarker* marker(uint worker_id) { return _markers[worker_id]; }
+  static OopQueueSet* oop_queues()             { return _oop_queues; }
+
+  OopClosure* mark_and_push_closure() { return &_mark_and_push; }
+  CLDClosure* cld_closure()           { return &_cld_closure; }
+
+  template <class T> inline void mark_and_push(T* p);
+
+  // Empties the local queues.
+  void drain_stacks();
+  // Drains, then steals from the other workers until all are idle.
+  void complete_marking(ParallelTaskTerminator* terminator);
+
+  void adjust_preserved_marks();
+  void restore_preserved_marks();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1FULLGCMARKER_HPP
@@ -27,6 +27,7 @@
 #include "gc_implementation/g1/g1GCPhaseTimes.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/shared/gcEventLog.hpp"
 #include "gc_implementation/shared/workerDataArray.inline.hpp"
 #include "memory/allocation.hpp"
 #include "runtime/os.hpp"
@@ -41,6 +42,7 @@ G1GCPhaseTimes::G1GCPhaseTimes(uint max_gc_threads) :
 
   // Root scanning phases
   _gc_par_phases[ThreadRoots] = new WorkerDataArray<double>(max_gc_threads, "Thread Roots (ms)", true, G1Log::LevelFinest, 3);
+  _gc_par_phases[CoroutineRoots] = new WorkerDataArray<double>(max_gc_threads, "Coroutine Roots (ms)", true, G1Log::LevelFinest, 3);
   _gc_par_phases[StringTableRoots] = new WorkerDataArray<double>(max_gc_threads, "StringTable Roots (ms)", true, G1Log::LevelFinest, 3);
   _gc_par_phases[UniverseRoots] = new WorkerDataArray<double>(max_gc_threads, "Universe Roots (ms)", true, G1Log::LevelFinest, 3);
   _gc_par_phases[JNIRoots] = new WorkerDataArray<double>(max_gc_threads, "JNI Handles Roots (ms)", true, G1Log::LevelFinest, 3);
@@ -78,8 +80,15 @@ G1GCPhaseTimes::G1GCPhaseTimes(uint max_gc_threads) :
   _redirtied_cards = new WorkerDataArray<size_t>(max_gc_threads, "Redirtied Cards", true, G1Log::LevelFinest, 3);
   _gc_par_phases[RedirtyCards]->link_thread_work_items(_redirtied_cards);
 
+  _gc_par_phases[OptObjCopy] = new WorkerDataArray<double>(max_gc_threads, "Optional Object Copy (ms)", true, G1Log::LevelFiner, 2);
+
   // Cannot guard below line with TenantHeapIsolation since we do not have conditional compilation for tenant mode
   _gc_par_phases[TenantAllocationContextRoots] = new WorkerDataArray<double>(max_gc_threads, "G1TenantAllocationContext Roots (ms)", true, G1Log::LevelFinest, 3);
+
+  _tenant_reclaimable = NULL;
+  if (TenantHeapIsolation) {
+    _tenant_reclaimable = new (ResourceObj::C_HEAP, mtGC) GrowableArray<TenantReclaimable>(8, true, mtGC);
+  }
 }
 
 void G1GCPhaseTimes::note_gc_start(uint active_gc_threads, bool mark_in_progress) {
@@ -95,6 +104,18 @@ void G1GCPhaseTimes::note_gc_start(uint active_gc_threads, bool mark_in_progress
   _gc_par_phases[StringDedupTableFixup]->set_enabled(G1StringDedup::is_enabled());
 
   _gc_par_phases[TenantAllocationContextRoots]->set_enabled(TenantHeapIsolation);
+  _gc_par_phases[CoroutineRoots]->set_enabled(EnableCoroutine);
+
+  // Only enabled once a pause evacuates an optional increment.
+  _gc_par_phases[OptObjCopy]->set_enabled(false);
+  _cur_optional_evac_increments = 0;
+  _cur_optional_evac_regions = 0;
+  _cur_optional_evac_predicted_time_ms = 0.0;
+  _cur_optional_evac_time_ms = 0.0;
+
+  if (_tenant_reclaimable != NULL) {
+    _tenant_reclaimable->clear();
+  }
 }
 
 void G1GCPhaseTimes::note_gc_end() {
@@ -120,17 +141,63 @@ void G1GCPhaseTimes::note_gc_end() {
 }
 
 void G1GCPhaseTimes::print_stats(int level, const char* str, double value) {
+  if (GCEventLog::is_active()) {
+    GCEventLog::log_time(level, str, value);
+    return;
+  }
   LineBuffer(level).append_and_print_cr("[%s: %.1lf ms]", str, value);
 }
 
 void G1GCPhaseTimes::print_stats(int level, const char* str, size_t value) {
+  if (GCEventLog::is_active()) {
+    GCEventLog::log_count(level, str, value);
+    return;
+  }
   LineBuffer(level).append_and_print_cr("[%s: " SIZE_FORMAT "]", str, value);
 }
 
 void G1GCPhaseTimes::print_stats(int level, const char* str, double value, uint workers) {
+  if (GCEventLog::is_active()) {
+    GCEventLog::log_time(level, str, value, workers);
+    return;
+  }
   LineBuffer(level).append_and_print_cr("[%s: %.1lf ms, GC Workers: %u]", str, value, workers);
 }
 
+void G1GCPhaseTimes::record_tenant_reclaimable_bytes(AllocationContext_t context, size_t bytes) {
+  assert(TenantHeapIsolation && _tenant_reclaimable != NULL, "pre-condition");
+  for (int i = 0; i < _tenant_reclaimable->length(); i++) {
+    if (_tenant_reclaimable->at(i).context == context) {
+      _tenant_reclaimable->adr_at(i)->bytes += bytes;
+      return;
+    }
+  }
+  TenantReclaimable entry;
+  entry.context = context;
+  entry.bytes = bytes;
+  _tenant_reclaimable->append(entry);
+}
+
+void G1GCPhaseTimes::print_tenant_reclaimable() {
+  size_t total = 0;
+  for (int i = 0; i < _tenant_reclaimable->length(); i++) {
+    total += _tenant_reclaimable->at(i).bytes;
+  }
+  LineBuffer(2).append_and_print_cr("[Tenant Reclaimable: " SIZE_FORMAT "K]", total / K);
+  if (G1Log::finest()) {
+    for (int i = 0; i < _tenant_reclaimable->length(); i++) {
+      TenantReclaimable* entry = _tenant_reclaimable->adr_at(i);
+      if (entry->context.is_system()) {
+        LineBuffer(3).append_and_print_cr("[root: " SIZE_FORMAT "K]", entry->bytes / K);
+      } else {
+        LineBuffer(3).append_and_print_cr("[" PTR_FORMAT ": " SIZE_FORMAT "K]",
+                                          p2i(entry->context.tenant_allocation_context()),
+                                          entry->bytes / K);
+      }
+    }
+  }
+}
+
 double G1GCPhaseTimes::accounted_time_ms() {
     // Subtract the root region scanning wait time. It's initialized to
     // zero at the start of the pause.
@@ -153,9 +220,29 @@ double G1GCPhaseTimes::accounted_time_ms() {
     // current value of "other time"
     misc_time_ms += _cur_clear_ct_time_ms;
 
+    // Optional collection set increments
+    misc_time_ms += _cur_optional_evac_time_ms;
+
     return misc_time_ms;
 }
 
+void G1GCPhaseTimes::note_optional_evacuation_start() {
+  if (_cur_optional_evac_increments == 0) {
+    _gc_par_phases[OptObjCopy]->set_enabled(true);
+    for (uint i = 0; i < _active_gc_threads; i++) {
+      record_time_secs(OptObjCopy, i, 0.0);
+    }
+  }
+}
+
+double G1GCPhaseTimes::average_obj_copy_time_ms() {
+  double obj_copy_time_ms = average_time_ms(ObjCopy);
+  if (_cur_optional_evac_increments > 0) {
+    obj_copy_time_ms += average_time_ms(OptObjCopy);
+  }
+  return obj_copy_time_ms;
+}
+
 // record the time a phase took in seconds
 void G1GCPhaseTimes::record_time_secs(GCParPhases phase, uint worker_i, double secs) {
   _gc_par_phases[phase]->set(worker_i, secs);
@@ -239,6 +326,14 @@ class G1GCParPhasePrinter : public StackObj {
 
   void print_single_length(G1GCPhaseTimes::GCParPhases phase_id, WorkerDataArray<double>* phase) {
     // No need for min, max, average and sum for only one worker
+    if (GCEventLog::is_active()) {
+      GCEventLog::log_single_time(phase->_indent_level, phase->_title, _phase_times->get_time_ms(phase_id, 0));
+      if (phase->_thread_work_items != NULL) {
+        GCEventLog::log_single_count(phase->_thread_work_items->_indent_level, phase->_thread_work_items->_title,
+                                     _phase_times->sum_thread_work_items(phase_id));
+      }
+      return;
+    }
     LineBuffer buf(phase->_indent_level);
     buf.append_and_print_cr("[%s:  %.1lf]", phase->_title, _phase_times->get_time_ms(phase_id, 0));
 
@@ -265,6 +360,13 @@ class G1GCParPhasePrinter : public StackObj {
   }
 
   void print_thread_work_items(G1GCPhaseTimes::GCParPhases phase_id, WorkerDataArray<size_t>* thread_work_items) {
+    // Per worker values are only printed at finest, and are not recorded.
+    if (GCEventLog::is_active() && !G1Log::finest()) {
+      GCEventLog::log_count_summary(thread_work_items->_indent_level, thread_work_items->_title,
+          _phase_times->min_thread_work_items(phase_id), _phase_times->average_thread_work_items(phase_id),
+          _phase_times->max_thread_work_items(phase_id), _phase_times->sum_thread_work_items(phase_id));
+      return;
+    }
     LineBuffer buf(thread_work_items->_indent_level);
     buf.append("[%s:", thread_work_items->_title);
 
@@ -280,6 +382,15 @@ class G1GCParPhasePrinter : public StackObj {
   }
 
   void print_multi_length(G1GCPhaseTimes::GCParPhases phase_id, WorkerDataArray<double>* phase) {
+    if (GCEventLog::is_active() && !G1Log::finest()) {
+      GCEventLog::log_time_summary(phase->_indent_level, phase->_title,
+          _phase_times->min_time_ms(phase_id), _phase_times->average_time_ms(phase_id),
+          _phase_times->max_time_ms(phase_id), _phase_times->sum_time_ms(phase_id), phase->_print_sum);
+      if (phase->_thread_work_items != NULL) {
+        print_thread_work_items(phase_id, phase->_thread_work_items);
+      }
+      return;
+    }
     LineBuffer buf(phase->_indent_level);
     buf.append("[%s:", phase->_title);
 
@@ -317,6 +428,14 @@ void G1GCPhaseTimes::print(double pause_time_sec) {
     par_phase_printer.print((GCParPhases) i);
   }
 
+  if (_cur_optional_evac_increments > 0) {
+    print_stats(1, "Optional Evacuation", _cur_optional_evac_time_ms, _active_gc_threads);
+    par_phase_printer.print(OptObjCopy);
+    print_stats(2, "Increments", (size_t) _cur_optional_evac_increments);
+    print_stats(2, "Regions", (size_t) _cur_optional_evac_regions);
+    print_stats(2, "Predicted", _cur_optional_evac_predicted_time_ms);
+    print_stats(2, "Prediction Error", optional_evacuation_prediction_error_ms());
+  }
   print_stats(1, "Code Root Fixup", _cur_collection_code_root_fixup_time_ms);
   print_stats(1, "Code Root Purge", _cur_strong_code_root_purge_time_ms);
   if (G1StringDedup::is_enabled()) {
@@ -344,6 +463,9 @@ void G1GCPhaseTimes::print(double pause_time_sec) {
   print_stats(2, "Choose CSet",
     (_recorded_young_cset_choice_time_ms +
     _recorded_non_young_cset_choice_time_ms));
+  if (_tenant_reclaimable != NULL && _tenant_reclaimable->is_nonempty()) {
+    print_tenant_reclaimable();
+  }
   print_stats(2, "Ref Proc", _cur_ref_proc_time_ms);
   print_stats(2, "Ref Enq", _cur_ref_enq_time_ms);
   print_stats(2, "Redirty Cards", _recorded_redirty_logged_cards_time_ms);
@@ -26,7 +26,9 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_G1GCPHASETIMESLOG_HPP
 
 #include "memory/allocation.hpp"
+#include "gc_implementation/g1/g1AllocationContext.hpp"
 #include "gc_implementation/shared/workerDataArray.hpp"
+#include "utilities/growableArray.hpp"
 
 class LineBuffer;
 
@@ -43,6 +45,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     GCWorkerStart,
     ExtRootScan,
     ThreadRoots,
+    CoroutineRoots,
     TenantAllocationContextRoots,
     StringTableRoots,
     UniverseRoots,
@@ -69,6 +72,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     StringDedupQueueFixup,
     StringDedupTableFixup,
     RedirtyCards,
+    OptObjCopy,
     GCParPhasesSentinel
   };
 
@@ -117,6 +121,23 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   double _cur_verify_before_time_ms;
   double _cur_verify_after_time_ms;
 
+  // Optional collection set increments evacuated by this pause, with their
+  // total predicted and actual time.
+  uint   _cur_optional_evac_increments;
+  uint   _cur_optional_evac_regions;
+  double _cur_optional_evac_predicted_time_ms;
+  double _cur_optional_evac_time_ms;
+
+  // Reclaimable bytes of the old regions added to the CSet, per tenant.
+  // Only recorded with TenantHeapIsolation
+  struct TenantReclaimable {
+    AllocationContext_t context;
+    size_t              bytes;
+  };
+  GrowableArray<TenantReclaimable>* _tenant_reclaimable;
+
+  void print_tenant_reclaimable();
+
   // Helper methods for detailed logging
   void print_stats(int level, const char* str, double value);
   void print_stats(int level, const char* str, size_t value);
@@ -240,6 +261,21 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _cur_verify_after_time_ms = time_ms;
   }
 
+  void record_tenant_reclaimable_bytes(AllocationContext_t context, size_t bytes);
+
+  // Must be called before the first optional increment is evacuated.
+  void note_optional_evacuation_start();
+
+  void record_optional_evacuation(uint regions, double predicted_time_ms, double time_ms) {
+    _cur_optional_evac_increments++;
+    _cur_optional_evac_regions += regions;
+    _cur_optional_evac_predicted_time_ms += predicted_time_ms;
+    _cur_optional_evac_time_ms += time_ms;
+  }
+
+  // Object copy time of the pause, including the optional increments.
+  double average_obj_copy_time_ms();
+
   double accounted_time_ms();
 
   double cur_collection_start_sec() {
@@ -277,6 +313,15 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   double fast_reclaim_humongous_time_ms() {
     return _cur_fast_reclaim_humongous_time_ms;
   }
+
+  double optional_evacuation_time_ms() {
+    return _cur_optional_evac_time_ms;
+  }
+
+  // How much longer the optional increments took than predicted.
+  double optional_evacuation_prediction_error_ms() {
+    return _cur_optional_evac_time_ms - _cur_optional_evac_predicted_time_ms;
+  }
 };
 
 class G1GCParPhaseTimesTracker : public StackObj {
@@ -47,3 +47,25 @@ void G1HeapRegionEventSender::send_events() {
 
   G1CollectedHeap::heap()->heap_region_iterate(&c);
 }
+
+class DumpAllocationSampleClosure : public HeapRegionClosure {
+public:
+  bool doHeapRegion(HeapRegion* r) {
+    if (r->allocation_samples() > 0) {
+      EventG1HeapRegionAllocationSample evt;
+      evt.set_index(r->hrm_index());
+      evt.set_used(r->used());
+      evt.set_samples(r->allocation_samples());
+      evt.set_dominantClass(r->sampled_klass());
+      evt.set_dominantClassVotes(r->sampled_klass_votes());
+      evt.commit();
+    }
+    return false;
+  }
+};
+
+void G1HeapRegionEventSender::send_allocation_sample_events() {
+  DumpAllocationSampleClosure c;
+
+  G1CollectedHeap::heap()->heap_region_iterate(&c);
+}
@@ -30,6 +30,8 @@
 class G1HeapRegionEventSender : public AllStatic {
 public:
   static void send_events();
+  // Sends the dominant sampled klass of the regions with allocation samples.
+  static void send_allocation_sample_events();
 };
 
 #endif // SHARE_VM_GC_G1_G1HEAPREGIONEVENTSENDER_HPP
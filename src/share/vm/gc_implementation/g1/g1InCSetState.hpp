@@ -55,10 +55,11 @@ struct InCSetState {
     // (x86*) can be encoded slightly more efficently than a normal comparison
     // against zero.
     // The same situation occurs when checking whether the region is humongous
-    // or not, which is encoded by values < 0.
+    // or optional, which are encoded by values < 0.
     // The other values are simply encoded in increasing generation order, which
     // makes getting the next generation fast by a simple increment.
-    Humongous    = -1,    // The region is humongous - note that actually any value < 0 would be possible here.
+    Optional     = -2,    // The region is an optional old region of the collection set, to be evacuated in a later increment.
+    Humongous    = -1,    // The region is humongous.
     NotInCSet    =  0,    // The region is not in the collection set.
     Young        =  1,    // The region is in the collection set and a young region.
     Old          =  2,    // The region is in the collection set and an old region.
@@ -75,19 +76,21 @@ struct InCSetState {
 
   bool is_in_cset_or_humongous() const { return _value != NotInCSet; }
   bool is_in_cset() const              { return _value > NotInCSet; }
-  bool is_humongous() const            { return _value < NotInCSet; }
+  bool is_humongous() const            { return _value == Humongous; }
+  bool is_optional() const             { return _value == Optional; }
   bool is_young() const                { return _value == Young; }
   bool is_old() const                  { return _value == Old; }
 
 #ifdef ASSERT
   bool is_default() const              { return !is_in_cset_or_humongous(); }
-  bool is_valid() const                { return (_value >= Humongous) && (_value < Num); }
+  bool is_valid() const                { return (_value >= Optional) && (_value < Num); }
   bool is_valid_gen() const            { return (_value >= Young && _value <= Old); }
 #endif
 };
 
 // Instances of this class are used for quick tests on whether a reference points
-// into the collection set and into which generation or is a humongous object
+// into the collection set and into which generation, into an optional region or
+// is a humongous object
 //
 // Each of the array's elements indicates whether the corresponding region is in
 // the collection set and if so in which generation, or a humongous region.
@@ -111,6 +114,18 @@ class G1InCSetStateFastTestBiasedMappedArray : public G1BiasedMappedArray<InCSet
     set_by_index(index, InCSetState::NotInCSet);
   }
 
+  void set_optional(uintptr_t index) {
+    assert(get_by_index(index).is_default(),
+           err_msg("State at index " INTPTR_FORMAT " should be default but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
+    set_by_index(index, InCSetState::Optional);
+  }
+
+  void clear_optional(uintptr_t index) {
+    assert(get_by_index(index).is_optional(),
+           err_msg("State at index " INTPTR_FORMAT " should be optional but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
+    set_by_index(index, InCSetState::NotInCSet);
+  }
+
   void set_in_young(uintptr_t index) {
     assert(get_by_index(index).is_default(),
            err_msg("State at index " INTPTR_FORMAT " should be default but is " CSETSTATE_FORMAT, index, get_by_index(index).value()));
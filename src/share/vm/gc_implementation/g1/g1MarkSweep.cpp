@@ -29,18 +29,22 @@
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
 #include "code/icBuffer.hpp"
+#include "gc_implementation/g1/g1FullGCMarker.hpp"
 #include "gc_implementation/g1/g1Log.hpp"
 #include "gc_implementation/g1/g1MarkSweep.hpp"
 #include "gc_implementation/g1/g1RootProcessor.hpp"
 #include "gc_implementation/g1/g1StringDedup.hpp"
+#include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_implementation/shared/gcHeapSummary.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/markSweep.inline.hpp"
 #include "memory/gcLocker.hpp"
 #include "memory/genCollectedHeap.hpp"
 #include "memory/modRefBarrierSet.hpp"
 #include "memory/referencePolicy.hpp"
+#include "memory/referenceProcessor.hpp"
 #include "memory/space.hpp"
 #include "oops/instanceRefKlass.hpp"
 #include "oops/oop.inline.hpp"
@@ -58,6 +62,11 @@
 
 class HeapRegion;
 
+uint G1MarkSweep::_active_workers = 1;
+
+// Regions in the order each worker prepared them in phase 2.
+static GrowableArray<HeapRegion*>** _compaction_queues = NULL;
+
 void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
                                       bool clear_all_softrefs) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
@@ -83,6 +92,8 @@ void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
 
   bool marked_for_unloading = false;
 
+  _active_workers = parallel_workers();
+
   allocate_stacks();
 
   // We should save the marks of the currently locked biased monitors.
@@ -101,6 +112,11 @@ void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
   mark_sweep_phase4();
 
   GenMarkSweep::restore_marks();
+  if (_active_workers > 1) {
+    for (uint i = 0; i < ParallelGCThreads; i++) {
+      G1FullGCMarker::marker(i)->restore_preserved_marks();
+    }
+  }
   BiasedLocking::restore_marks();
   GenMarkSweep::deallocate_stacks();
 
@@ -118,6 +134,30 @@ void G1MarkSweep::invoke_at_safepoint(ReferenceProcessor* rp,
 }
 
 
+uint G1MarkSweep::parallel_workers() {
+  if (!G1ParallelFullGC || ParallelGCThreads <= 1) {
+    return 1;
+  }
+  FlexibleWorkGang* workers = G1CollectedHeap::heap()->workers();
+  uint n_workers =
+    AdaptiveSizePolicy::calc_active_workers(workers->total_workers(),
+                                            workers->active_workers(),
+                                            Threads::number_of_non_daemon_threads());
+  workers->set_active_workers(n_workers);
+  if (n_workers <= 1) {
+    return 1;
+  }
+
+  G1FullGCMarker::initialize(G1CollectedHeap::heap()->ref_processor_stw());
+  if (_compaction_queues == NULL) {
+    _compaction_queues = NEW_C_HEAP_ARRAY(GrowableArray<HeapRegion*>*, ParallelGCThreads, mtGC);
+    for (uint i = 0; i < ParallelGCThreads; i++) {
+      _compaction_queues[i] = new (ResourceObj::C_HEAP, mtGC) GrowableArray<HeapRegion*>(64, true, mtGC);
+    }
+  }
+  return n_workers;
+}
+
 void G1MarkSweep::allocate_stacks() {
   GenMarkSweep::_preserved_count_max = 0;
   GenMarkSweep::_preserved_marks = NULL;
@@ -135,8 +175,10 @@ void G1MarkSweep::mark_sweep_phase1(bool& marked_for_unloading,
   // Need cleared claim bits for the roots processing
   ClassLoaderDataGraph::clear_claimed_marks();
 
-  MarkingCodeBlobClosure follow_code_closure(&GenMarkSweep::follow_root_closure, !CodeBlobToOopClosure::FixRelocations);
-  {
+  if (_active_workers > 1) {
+    mark_from_roots_par();
+  } else {
+    MarkingCodeBlobClosure follow_code_closure(&GenMarkSweep::follow_root_closure, !CodeBlobToOopClosure::FixRelocations);
     G1RootProcessor root_processor(g1h);
     if (ClassUnloading) {
       root_processor.process_strong_roots(&GenMarkSweep::follow_root_closure,
@@ -232,6 +274,8 @@ class G1AdjustPointersClosure: public HeapRegionClosure {
         // point all the oops to the new location
         obj->adjust_pointers();
       }
+    } else if (r->is_pinned()) {
+      r->adjust_pointers_in_place();
     } else {
       // This really ought to be "as_CompactibleSpace"...
       r->adjust_pointers();
@@ -250,8 +294,11 @@ void G1MarkSweep::mark_sweep_phase3() {
   // Need cleared claim bits for the roots processing
   ClassLoaderDataGraph::clear_claimed_marks();
 
-  CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure, CodeBlobToOopClosure::FixRelocations);
-  {
+  if (_active_workers > 1) {
+    // roots, preserved marks of the workers and regions
+    adjust_pointers_par();
+  } else {
+    CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure, CodeBlobToOopClosure::FixRelocations);
     G1RootProcessor root_processor(g1h);
     root_processor.process_all_roots(&GenMarkSweep::adjust_pointer_closure,
                                      &GenMarkSweep::adjust_cld_closure,
@@ -272,26 +319,35 @@ void G1MarkSweep::mark_sweep_phase3() {
 
   GenMarkSweep::adjust_marks();
 
-  G1AdjustPointersClosure blk;
-  g1h->heap_region_iterate(&blk);
+  if (_active_workers == 1) {
+    G1AdjustPointersClosure blk;
+    g1h->heap_region_iterate(&blk);
+  }
+}
+
+static void compact_humongous(HeapRegion* hr) {
+  if (hr->startsHumongous()) {
+    oop obj = oop(hr->bottom());
+    if (obj->is_gc_marked()) {
+      obj->init_mark();
+    } else {
+      assert(hr->is_empty(), "Should have been cleared in phase 2.");
+    }
+    hr->reset_during_compaction();
+  }
 }
 
 class G1SpaceCompactClosure: public HeapRegionClosure {
+  bool _humongous_only;
 public:
-  G1SpaceCompactClosure() {}
+  G1SpaceCompactClosure(bool humongous_only = false) : _humongous_only(humongous_only) {}
 
   bool doHeapRegion(HeapRegion* hr) {
     if (hr->isHumongous()) {
-      if (hr->startsHumongous()) {
-        oop obj = oop(hr->bottom());
-        if (obj->is_gc_marked()) {
-          obj->init_mark();
-        } else {
-          assert(hr->is_empty(), "Should have been cleared in phase 2.");
-        }
-        hr->reset_during_compaction();
-      }
-    } else {
+      compact_humongous(hr);
+    } else if (hr->is_pinned()) {
+      hr->compact_in_place();
+    } else if (!_humongous_only) {
       hr->compact();
     }
     return false;
@@ -310,9 +366,232 @@ void G1MarkSweep::mark_sweep_phase4() {
   GCTraceTime tm("phase 4", G1Log::fine() && Verbose, true, gc_timer(), gc_tracer()->gc_id());
   GenMarkSweep::trace("4");
 
-  G1SpaceCompactClosure blk;
+  if (_active_workers > 1) {
+    compact_par();
+  }
+  G1SpaceCompactClosure blk(_active_workers > 1 /* humongous_only */);
   g1h->heap_region_iterate(&blk);
+}
+
+class G1ParMarkTask : public AbstractGangTask {
+  G1RootProcessor* _root_processor;
+  TaskTerminator _terminator;
+
+ public:
+  G1ParMarkTask(G1RootProcessor* root_processor, uint n_workers) :
+    AbstractGangTask("G1 Full GC Mark"),
+    _root_processor(root_processor),
+    _terminator(n_workers, G1FullGCMarker::oop_queues()) { }
+
+  void work(uint worker_id) {
+    G1FullGCMarker* marker = G1FullGCMarker::marker(worker_id);
+    MarkingCodeBlobClosure follow_code_closure(marker->mark_and_push_closure(), !CodeBlobToOopClosure::FixRelocations);
+    if (ClassUnloading) {
+      _root_processor->process_strong_roots(marker->mark_and_push_closure(),
+                                            marker->cld_closure(),
+                                            &follow_code_closure);
+    } else {
+      _root_processor->process_all_roots_no_string_table(marker->mark_and_push_closure(),
+                                                         marker->cld_closure(),
+                                                         &follow_code_closure);
+    }
+    marker->complete_marking(_terminator.terminator());
+  }
+};
+
+void G1MarkSweep::mark_from_roots_par() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  // Discovery was made serial for the full GC, the workers discover into
+  // their own lists.
+  ReferenceProcessorMTDiscoveryMutator rp_disc_mt(GenMarkSweep::ref_processor(), true);
+
+  g1h->set_par_threads(_active_workers);
+  G1RootProcessor root_processor(g1h);
+  root_processor.set_num_workers(_active_workers);
+  G1ParMarkTask task(&root_processor, _active_workers);
+  g1h->workers()->run_task(&task);
+  g1h->set_par_threads(0);
+}
+
+// Dead humongous objects are freed before the parallel part of phase 2 so
+// that their regions are compacted into like any other free region.
+class G1FreeDeadHumongousClosure : public HeapRegionClosure {
+  G1CollectedHeap* _g1h;
+  HeapRegionSetCount _humongous_regions_removed;
+
+ public:
+  G1FreeDeadHumongousClosure() : _g1h(G1CollectedHeap::heap()), _humongous_regions_removed() { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->startsHumongous()) {
+      oop obj = oop(hr->bottom());
+      if (obj->is_gc_marked()) {
+        obj->forward_to(obj);
+      } else {
+        FreeRegionList dummy_free_list("Dummy Free List for G1MarkSweep");
+        hr->set_containing_set(NULL);
+        _humongous_regions_removed.increment(1u, hr->capacity());
+        _g1h->free_humongous_region(hr, &dummy_free_list, false /* par */);
+        dummy_free_list.remove_all();
+      }
+    }
+    return false;
+  }
+
+  void update_sets() {
+    HeapRegionSetCount empty_set;
+    _g1h->remove_from_old_sets(empty_set, _humongous_regions_removed);
+  }
+};
+
+// Forwards the objects of the claimed regions into the regions this
+// worker claimed before, keeping one chain per allocation context so
+// that tenant regions are only compacted into each other.
+class G1ParPrepareCompactClosure : public HeapRegionClosure {
+  class Chain VALUE_OBJ_CLASS_SPEC {
+   public:
+    AllocationContext_t _context;
+    CompactPoint _cp;
+    HeapRegion* _last;
+
+    Chain() : _context(), _cp(), _last(NULL) { }
+    Chain(AllocationContext_t context) : _context(context), _cp(), _last(NULL) { }
+  };
+
+  ModRefBarrierSet* _mrbs;
+  GrowableArray<HeapRegion*>* _queue;
+  GrowableArray<Chain> _chains;
+
+  Chain* chain_for(AllocationContext_t context) {
+    for (int i = 0; i < _chains.length(); i++) {
+      if (_chains.adr_at(i)->_context == context) {
+        return _chains.adr_at(i);
+      }
+    }
+    _chains.append(Chain(context));
+    return _chains.adr_at(_chains.length() - 1);
+  }
+
+ public:
+  G1ParPrepareCompactClosure(GrowableArray<HeapRegion*>* queue) :
+    _mrbs(G1CollectedHeap::heap()->g1_barrier_set()),
+    _queue(queue),
+    _chains(4) { }
+
+  bool doHeapRegion(HeapRegion* hr) {
+    if (hr->isHumongous()) {
+      // live humongous objects stay in place
+      return false;
+    }
+    if (hr->is_pinned()) {
+      // as do the objects of regions pinned by JNI critical sections
+      hr->prepare_for_compaction_in_place();
+      return false;
+    }
+    Chain* chain = chain_for(hr->allocation_context());
+    if (chain->_last == NULL) {
+      chain->_cp.space = hr;
+      chain->_cp.threshold = hr->initialize_threshold();
+    } else {
+      chain->_last->set_next_compaction_region(hr);
+    }
+    hr->set_next_compaction_region(NULL);
+    chain->_last = hr;
+
+    hr->prepare_for_compaction(&chain->_cp);
+    // Also clear the part of the card table that will be unused after
+    // compaction.
+    _mrbs->clear(MemRegion(hr->compaction_top(), hr->end()));
+    _queue->append(hr);
+    return false;
+  }
+};
+
+class G1ParPrepareCompactTask : public AbstractGangTask {
+  uint _n_workers;
+
+ public:
+  G1ParPrepareCompactTask(uint n_workers) :
+    AbstractGangTask("G1 Full GC Prepare Compaction"), _n_workers(n_workers) { }
+
+  void work(uint worker_id) {
+    ResourceMark rm;
+    G1ParPrepareCompactClosure blk(_compaction_queues[worker_id]);
+    G1CollectedHeap::heap()->heap_region_par_iterate_chunked(&blk, worker_id, _n_workers,
+                                                             HeapRegion::FullGCPrepareClaimValue);
+  }
+};
+
+void G1MarkSweep::prepare_compaction_par() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+
+  G1FreeDeadHumongousClosure free_humongous;
+  g1h->heap_region_iterate(&free_humongous);
+  free_humongous.update_sets();
+
+  for (uint i = 0; i < ParallelGCThreads; i++) {
+    _compaction_queues[i]->clear();
+  }
+  G1ParPrepareCompactTask task(_active_workers);
+  g1h->workers()->run_task(&task);
+  g1h->reset_heap_region_claim_values();
+}
+
+class G1ParAdjustTask : public AbstractGangTask {
+  G1RootProcessor* _root_processor;
+  uint _n_workers;
+
+ public:
+  G1ParAdjustTask(G1RootProcessor* root_processor, uint n_workers) :
+    AbstractGangTask("G1 Full GC Adjust Pointers"),
+    _root_processor(root_processor),
+    _n_workers(n_workers) { }
+
+  void work(uint worker_id) {
+    CodeBlobToOopClosure adjust_code_closure(&GenMarkSweep::adjust_pointer_closure, CodeBlobToOopClosure::FixRelocations);
+    _root_processor->process_all_roots(&GenMarkSweep::adjust_pointer_closure,
+                                       &GenMarkSweep::adjust_cld_closure,
+                                       &adjust_code_closure);
+    G1FullGCMarker::marker(worker_id)->adjust_preserved_marks();
+
+    G1AdjustPointersClosure blk;
+    G1CollectedHeap::heap()->heap_region_par_iterate_chunked(&blk, worker_id, _n_workers,
+                                                             HeapRegion::FullGCAdjustClaimValue);
+  }
+};
+
+void G1MarkSweep::adjust_pointers_par() {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  g1h->set_par_threads(_active_workers);
+  {
+    G1RootProcessor root_processor(g1h);
+    root_processor.set_num_workers(_active_workers);
+    G1ParAdjustTask task(&root_processor, _active_workers);
+    g1h->workers()->run_task(&task);
+  }
+  g1h->set_par_threads(0);
+  g1h->reset_heap_region_claim_values();
+}
+
+class G1ParCompactTask : public AbstractGangTask {
+ public:
+  G1ParCompactTask() : AbstractGangTask("G1 Full GC Compact") { }
+
+  void work(uint worker_id) {
+    // Objects only move into regions earlier in the same queue, so
+    // compacting in queue order never overwrites live data.
+    GrowableArray<HeapRegion*>* queue = _compaction_queues[worker_id];
+    for (int i = 0; i < queue->length(); i++) {
+      HeapRegion* hr = queue->at(i);
+      hr->compact();
+      hr->set_next_compaction_region(NULL);
+    }
+  }
+};
 
+void G1MarkSweep::compact_par() {
+  G1ParCompactTask task;
+  G1CollectedHeap::heap()->workers()->run_task(&task);
 }
 
 void G1MarkSweep::prepare_compaction_work(G1PrepareCompactClosure* blk) {
@@ -427,6 +706,9 @@ bool G1PrepareCompactClosure::doHeapRegion(HeapRegion* hr) {
     } else {
       assert(hr->continuesHumongous(), "Invalid humongous.");
     }
+  } else if (hr->is_pinned()) {
+    // Objects accessed by JNI critical sections must not move.
+    hr->prepare_for_compaction_in_place();
   } else {
     prepare_for_compaction(hr, hr->end());
   }
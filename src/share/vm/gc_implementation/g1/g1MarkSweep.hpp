@@ -72,6 +72,17 @@ class G1MarkSweep : AllStatic {
   static void allocate_stacks();
   static void prepare_compaction();
   static void prepare_compaction_work(G1PrepareCompactClosure* blk);
+
+  // Number of workers the phases run on, 1 unless -XX:+G1ParallelFullGC.
+  static uint _active_workers;
+  static uint parallel_workers();
+
+  // Parallel parts of the phases. Each worker compacts the regions it
+  // claimed in phase 2 into each other, in claim order.
+  static void mark_from_roots_par();
+  static void prepare_compaction_par();
+  static void adjust_pointers_par();
+  static void compact_par();
 };
 
 class G1PrepareCompactClosure : public HeapRegionClosure {
@@ -31,6 +31,11 @@ void G1MarkSweep::prepare_compaction() {
     G1TenantAllocationContexts::prepare_for_compaction();
   }
 
+  if (_active_workers > 1) {
+    prepare_compaction_par();
+    return;
+  }
+
   G1PrepareCompactClosure blk;
   G1MarkSweep::prepare_compaction_work(&blk);
 }
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
+#include "memory/allocation.inline.hpp"
+#include "runtime/globals.hpp"
+
+G1NUMA* G1NUMA::_inst = NULL;
+
+G1NUMA* G1NUMA::create() {
+  guarantee(_inst == NULL, "Should be called once.");
+  _inst = new G1NUMA();
+  _inst->initialize(UseNUMA && G1NUMAAware);
+  return _inst;
+}
+
+G1NUMA::G1NUMA() :
+  _node_ids(NULL), _num_active_nodes(0),
+  _region_size(0), _page_size(0) {
+}
+
+G1NUMA::~G1NUMA() {
+  FREE_C_HEAP_ARRAY(int, _node_ids, mtGC);
+}
+
+void G1NUMA::initialize(bool use_numa) {
+  if (use_numa) {
+    size_t num_node_ids = os::numa_get_groups_num();
+    _node_ids = NEW_C_HEAP_ARRAY(int, num_node_ids, mtGC);
+    _num_active_nodes = (uint)os::numa_get_leaf_groups(_node_ids, num_node_ids);
+  }
+  if (_num_active_nodes <= 1) {
+    // Treat the machine as a single node so that the callers do not
+    // need to distinguish the cases.
+    FREE_C_HEAP_ARRAY(int, _node_ids, mtGC);
+    _node_ids = NEW_C_HEAP_ARRAY(int, 1, mtGC);
+    _node_ids[0] = 0;
+    _num_active_nodes = 1;
+  }
+}
+
+void G1NUMA::set_region_info(size_t region_size, size_t page_size) {
+  _region_size = region_size;
+  _page_size = page_size;
+}
+
+size_t G1NUMA::regions_per_page() const {
+  assert(_region_size > 0, "region info must have been set");
+  return MAX2(_page_size / _region_size, (size_t)1);
+}
+
+uint G1NUMA::index_of_node_id(int node_id) const {
+  for (uint i = 0; i < _num_active_nodes; i++) {
+    if (_node_ids[i] == node_id) {
+      return i;
+    }
+  }
+  return AnyNodeIndex;
+}
+
+uint G1NUMA::index_of_current_thread() const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  uint node_index = index_of_node_id(os::numa_get_group_id());
+  // Threads on nodes without memory use the first node.
+  return node_index == AnyNodeIndex ? 0 : node_index;
+}
+
+uint G1NUMA::preferred_node_index_for_index(uint region_index) const {
+  if (!is_enabled()) {
+    return 0;
+  }
+  // All regions within a page have to share its node.
+  return (uint)((region_index / regions_per_page()) % _num_active_nodes);
+}
+
+void G1NUMA::request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index) {
+  if (!is_enabled() || size_in_bytes == 0) {
+    return;
+  }
+  assert(is_ptr_aligned(aligned_address, _page_size),
+         err_msg("address " PTR_FORMAT " should be page aligned", p2i(aligned_address)));
+  assert(is_size_aligned(size_in_bytes, _page_size),
+         err_msg("size " SIZE_FORMAT " should be page aligned", size_in_bytes));
+
+  uint node_index = preferred_node_index_for_index(region_index);
+  os::numa_make_local((char*)aligned_address, size_in_bytes, _node_ids[node_index]);
+}
+
+uint G1NUMA::max_search_depth() const {
+  // Regions of the same node are num_active_nodes apart in a list
+  // ordered by index, so a few strides find one if there is any nearby.
+  return 3 * (uint)regions_per_page() * _num_active_nodes;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+
+// Assigns heap regions to NUMA nodes and tells on which node the current
+// thread runs. Each region has a preferred node that only depends on its
+// index: regions are striped across the active nodes in units of whole
+// pages, and their memory is bound to that node when it is committed.
+// Nodes are identified by a dense node index in [0, num_active_nodes()).
+//
+// If G1NUMAAware is off, or the machine has a single node, there is one
+// node with index 0 and all requests are no-ops.
+class G1NUMA : public CHeapObj<mtGC> {
+  // os lgrp ids of the active nodes, indexed by node index.
+  int*   _node_ids;
+  uint   _num_active_nodes;
+
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+
+  // Number of regions one page covers, at least 1.
+  size_t regions_per_page() const;
+
+public:
+  static const uint AnyNodeIndex = (uint)-1;
+
+  static G1NUMA* create();
+  static G1NUMA* numa() { return _inst; }
+
+  ~G1NUMA();
+
+  bool is_enabled() const { return _num_active_nodes > 1; }
+  uint num_active_nodes() const { return _num_active_nodes; }
+
+  // Must be called before any region is committed.
+  void set_region_info(size_t region_size, size_t page_size);
+
+  // Node index of the node the calling thread currently runs on.
+  uint index_of_current_thread() const;
+  // Node index of the given os lgrp id, or AnyNodeIndex if not active.
+  uint index_of_node_id(int node_id) const;
+
+  // The node the memory of the given region is bound to.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Bind the given committed but untouched page aligned range, which
+  // starts at the given region, to the preferred node of that region.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // How many free regions to look at for one with a matching node
+  // before falling back to any free region.
+  uint max_search_depth() const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
@@ -89,6 +89,8 @@ inline void G1ParScanClosure::do_oop_nv(T* p) {
     } else {
       if (state.is_humongous()) {
         _g1->set_humongous_is_live(obj);
+      } else if (state.is_optional()) {
+        _par_scan_state->remember_into_optional_region(p);
       }
       _par_scan_state->update_rs(_from, p, _worker_id);
     }
@@ -23,9 +23,11 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/g1/g1PageBasedVirtualSpace.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/init.hpp"
 #include "services/memTracker.hpp"
 #ifdef TARGET_OS_FAMILY_linux
 # include "os_linux.inline.hpp"
@@ -193,14 +195,62 @@ char* G1PageBasedVirtualSpace::bounded_end_addr(size_t end_page) const {
   return MIN2(_high_boundary, page_start(end_page));
 }
 
+// Pre-touches a range of memory with the G1 worker threads, each worker
+// claiming one chunk at a time.
+class G1PretouchTask : public AbstractGangTask {
+  char* volatile _cur;
+  char* const _end;
+  size_t const _chunk_size;
+
+public:
+  G1PretouchTask(char* start, char* end, size_t chunk_size) :
+    AbstractGangTask("G1 PreTouch"), _cur(start), _end(end), _chunk_size(chunk_size) { }
+
+  virtual void work(uint worker_id) {
+    while (true) {
+      char* touch_addr = (char*)Atomic::add_ptr((intptr_t)_chunk_size, (volatile void*)&_cur) - _chunk_size;
+      if (touch_addr >= _end) {
+        break;
+      }
+      // Touch every small page: the kernel may still back a chunk with
+      // small pages if no huge page is available at fault time.
+      os::pretouch_memory(touch_addr, MIN2(touch_addr + _chunk_size, _end));
+    }
+  }
+};
+
 void G1PageBasedVirtualSpace::pretouch_internal(size_t start_page, size_t end_page) {
   guarantee(start_page < end_page,
             err_msg("Given start page " SIZE_FORMAT " is larger or equal to end page " SIZE_FORMAT, start_page, end_page));
 
-  os::pretouch_memory(page_start(start_page), bounded_end_addr(end_page));
+  char* start = page_start(start_page);
+  char* end = bounded_end_addr(end_page);
+
+  // Chunks are whole commit pages, and whole transparent huge pages if the
+  // memory is advised for them, so no huge page is faulted in by two workers.
+  size_t chunk_size = align_size_up(MAX2((size_t)PreTouchParallelChunkSize, _page_size), _page_size);
+  if (UseTransparentHugePages || G1TransparentHugePageCommit) {
+    size_t thp_size = os::transparent_huge_page_size();
+    if (thp_size > 0) {
+      chunk_size = align_size_up(chunk_size, thp_size);
+    }
+  }
+
+  FlexibleWorkGang* workers = G1CollectedHeap::heap() != NULL ? G1CollectedHeap::heap()->workers() : NULL;
+  // The workers are idle during initialization and when the VM thread
+  // expands the heap at a safepoint. NUMA placement is not affected by
+  // which worker touches a page, as regions are bound to their node
+  // before being pre-touched.
+  if (workers != NULL && pointer_delta(end, start, sizeof(char)) > chunk_size &&
+      (!is_init_completed() || Thread::current()->is_VM_thread())) {
+    G1PretouchTask task(start, end, chunk_size);
+    workers->run_task(&task);
+  } else {
+    os::pretouch_memory(start, end);
+  }
 }
 
-bool G1PageBasedVirtualSpace::commit(size_t start_page, size_t size_in_pages) {
+bool G1PageBasedVirtualSpace::commit(size_t start_page, size_t size_in_pages, bool allow_pretouch) {
   // We need to make sure to commit all pages covered by the given area.
   guarantee(is_area_uncommitted(start_page, size_in_pages), "Specified area is not uncommitted");
 
@@ -218,12 +268,19 @@ bool G1PageBasedVirtualSpace::commit(size_t start_page, size_t size_in_pages) {
   }
   _committed.set_range(start_page, end_page);
 
-  if (AlwaysPreTouch) {
+  if (AlwaysPreTouch && allow_pretouch) {
     pretouch_internal(start_page, end_page);
   }
   return zero_filled;
 }
 
+void G1PageBasedVirtualSpace::pretouch(size_t start_page, size_t size_in_pages) {
+  guarantee(is_area_committed(start_page, size_in_pages), "Specified area is not committed");
+  if (AlwaysPreTouch) {
+    pretouch_internal(start_page, start_page + size_in_pages);
+  }
+}
+
 void G1PageBasedVirtualSpace::par_commit(size_t start_page, size_t size_in_pages, bool allow_pretouch) {
   // We need to make sure to commit all pages covered by the given area.
   guarantee(is_area_uncommitted(start_page, size_in_pages), "Specified area is not uncommitted");
@@ -115,7 +115,10 @@ class G1PageBasedVirtualSpace VALUE_OBJ_CLASS_SPEC {
 
   // Commit the given area of pages starting at start being size_in_pages large.
   // Returns true if the given area is zero filled upon completion.
-  bool commit(size_t start_page, size_t size_in_pages);
+  bool commit(size_t start_page, size_t size_in_pages, bool allow_pretouch = true);
+
+  // Pretouch the given committed area of pages if AlwaysPreTouch is set.
+  void pretouch(size_t start_page, size_t size_in_pages);
 
   // Uncommit the given area of pages starting at start being size_in_pages large.
   void uncommit(size_t start_page, size_t size_in_pages);
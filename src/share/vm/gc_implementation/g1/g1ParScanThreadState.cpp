@@ -29,6 +29,7 @@
 #include "oops/oop.inline.hpp"
 #include "oops/oop.pcgc.inline.hpp"
 #include "runtime/prefetch.inline.hpp"
+#include "utilities/stack.inline.hpp"
 
 G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h, uint queue_num, ReferenceProcessor* rp)
   : _g1h(g1h),
@@ -40,7 +41,10 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h, uint queue_num,
     _term_attempts(0),
     _tenuring_threshold(g1h->g1_policy()->tenuring_threshold()),
     _age_table(false), _scanner(g1h, rp),
-    _strong_roots_time(0), _term_time(0) {
+    _strong_roots_time(0), _term_time(0),
+    _allocation_sample_buffer_top(0),
+    _copies_until_allocation_sample(G1RegionAllocationSampleInterval),
+    _tenant_copy_stats_top(0) {
   _scanner.set_par_scan_thread_state(this);
   // we allocate G1YoungSurvRateNumRegions plus one entries, since
   // we "sacrifice" entry 0 to keep track of surviving bytes for
@@ -70,11 +74,65 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h, uint queue_num,
 }
 
 G1ParScanThreadState::~G1ParScanThreadState() {
+  flush_allocation_samples();
+  flush_tenant_copy_stats();
   _g1_par_allocator->retire_alloc_buffers();
   delete _g1_par_allocator;
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base, mtGC);
 }
 
+void G1ParScanThreadState::flush_allocation_samples() {
+  if (_allocation_sample_buffer_top == 0) {
+    return;
+  }
+  MutexLockerEx x(ParGCRareEvent_lock, Mutex::_no_safepoint_check_flag);
+  for (uint i = 0; i < _allocation_sample_buffer_top; i++) {
+    AllocationSample* sample = &_allocation_sample_buffer[i];
+    sample->_region->record_allocation_sample(sample->_klass);
+  }
+  _allocation_sample_buffer_top = 0;
+}
+
+inline void G1ParScanThreadState::sample_old_allocation(HeapWord* obj_ptr, Klass* k) {
+  if (--_copies_until_allocation_sample > 0) {
+    return;
+  }
+  _copies_until_allocation_sample = G1RegionAllocationSampleInterval;
+  AllocationSample* sample = &_allocation_sample_buffer[_allocation_sample_buffer_top++];
+  sample->_region = _g1h->heap_region_containing_raw(obj_ptr);
+  sample->_klass = k;
+  if (_allocation_sample_buffer_top == AllocationSampleBufferSize) {
+    flush_allocation_samples();
+  }
+}
+
+void G1ParScanThreadState::flush_tenant_copy_stats() {
+  for (uint i = 0; i < _tenant_copy_stats_top; i++) {
+    TenantCopyStats* stats = &_tenant_copy_stats[i];
+    G1TenantAllocationContexts::gc_stats_of(stats->_context)->record_copy(stats->_words * HeapWordSize,
+                                                                         stats->_objects);
+  }
+  _tenant_copy_stats_top = 0;
+}
+
+inline void G1ParScanThreadState::record_tenant_copy(AllocationContext_t context, size_t word_sz) {
+  for (uint i = 0; i < _tenant_copy_stats_top; i++) {
+    TenantCopyStats* stats = &_tenant_copy_stats[i];
+    if (stats->_context == context) {
+      stats->_words += word_sz;
+      stats->_objects++;
+      return;
+    }
+  }
+  if (_tenant_copy_stats_top == TenantCopyStatsSize) {
+    flush_tenant_copy_stats();
+  }
+  TenantCopyStats* stats = &_tenant_copy_stats[_tenant_copy_stats_top++];
+  stats->_context = context;
+  stats->_words = word_sz;
+  stats->_objects = 1;
+}
+
 void
 G1ParScanThreadState::print_termination_stats_hdr(outputStream* const st)
 {
@@ -141,9 +199,23 @@ bool G1ParScanThreadState::verify_task(StarTask ref) const {
 }
 #endif // ASSERT
 
-void G1ParScanThreadState::trim_queue() {
-  assert(_evac_failure_cl != NULL, "not set");
+void G1ParScanThreadState::remember_into_optional_region(oop* p) {
+  _g1h->optional_refs(queue_num())->remember_heap_ref(p);
+}
+
+void G1ParScanThreadState::remember_into_optional_region(narrowOop* p) {
+  _g1h->optional_refs(queue_num())->remember_heap_ref(p);
+}
 
+void G1ParScanThreadState::remember_root_into_optional_region(oop* p) {
+  _g1h->optional_refs(queue_num())->remember_root_ref(p);
+}
+
+void G1ParScanThreadState::remember_root_into_optional_region(narrowOop* p) {
+  _g1h->optional_refs(queue_num())->remember_root_ref(p);
+}
+
+void G1ParScanThreadState::trim_queue() {
   StarTask ref;
   do {
     // Drain the overflow stack first, so other threads can steal.
@@ -153,12 +225,41 @@ void G1ParScanThreadState::trim_queue() {
       }
     }
 
-    while (_refs->pop_local(ref)) {
-      dispatch_reference(ref);
+    if (G1EvacPrefetchBatchSize > 1) {
+      drain_local_queue_in_batches();
+    } else {
+      while (_refs->pop_local(ref)) {
+        dispatch_reference(ref);
+      }
     }
   } while (!_refs->is_empty());
 }
 
+void G1ParScanThreadState::drain_local_queue_in_batches() {
+  // Objects reached through wide object graphs are rarely in the cache, and
+  // copying them one at a time stalls on every header load. Popping several
+  // entries and prefetching all of their objects first overlaps these misses.
+  // A batch is bounded by the number of entries in the queue, so a shallow
+  // queue is processed without delay and stays available for stealing.
+  StarTask batch[MaxEvacPrefetchBatchSize];
+  size_t const batch_size = (size_t)G1EvacPrefetchBatchSize;
+
+  for (;;) {
+    size_t n = 0;
+    while (n < batch_size && _refs->pop_local(batch[n])) {
+      assert(verify_task(batch[n]), "sanity");
+      prefetch_reference(batch[n]);
+      n++;
+    }
+    if (n == 0) {
+      return;
+    }
+    for (size_t i = 0; i < n; i++) {
+      dispatch_reference(batch[i]);
+    }
+  }
+}
+
 HeapWord* G1ParScanThreadState::allocate_in_next_plab(InCSetState const state,
                                                       InCSetState* dest,
                                                       size_t word_sz,
@@ -218,6 +319,12 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
                                                  markOop const old_mark) {
   const size_t word_sz = old->size();
   HeapRegion* const from_region = _g1h->heap_region_containing_raw(old);
+  if (from_region->is_pinned()) {
+    // A JNI critical section accesses an object of this region, so the
+    // objects stay in place and the region is retained like after an
+    // evacuation failure.
+    return _g1h->handle_evacuation_failure_par(this, old);
+  }
   // +1 to make the -1 indexes valid...
   const int young_index = from_region->young_index_in_cset()+1;
   assert( (from_region->is_young() && young_index >  0) ||
@@ -282,6 +389,9 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
       age_table()->add(age, word_sz);
     } else {
       obj->set_mark(old_mark);
+      if (G1RegionAllocationSampleInterval > 0) {
+        sample_old_allocation(obj_ptr, obj->klass());
+      }
     }
 
     if (G1StringDedup::is_enabled()) {
@@ -300,6 +410,10 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
     size_t* const surv_young_words = surviving_young_words();
     surv_young_words[young_index] += word_sz;
 
+    if (TenantHeapIsolation) {
+      record_tenant_copy(context, word_sz);
+    }
+
     if (obj->is_objArray() && arrayOop(obj)->length() >= ParGCArrayScanChunk) {
       // We keep track of the next start index in the length field of
       // the to-space object. The actual length can be found in the
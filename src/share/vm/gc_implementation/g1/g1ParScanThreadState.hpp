@@ -57,8 +57,6 @@ class G1ParScanThreadState : public StackObj {
   size_t            _alloc_buffer_waste;
   size_t            _undo_waste;
 
-  OopsInHeapRegionClosure*      _evac_failure_cl;
-
   uint _queue_num;
 
   size_t _term_attempts;
@@ -77,6 +75,36 @@ class G1ParScanThreadState : public StackObj {
 
 #define PADDING_ELEM_NUM (DEFAULT_CACHE_LINE_SIZE / sizeof(size_t))
 
+  // Klasses of objects copied into old regions, sampled every
+  // G1RegionAllocationSampleInterval copies and handed to the regions in
+  // batches to keep the lock out of the copying path.
+  struct AllocationSample {
+    HeapRegion* _region;
+    Klass*      _klass;
+  };
+  static const uint AllocationSampleBufferSize = 64;
+  AllocationSample _allocation_sample_buffer[AllocationSampleBufferSize];
+  uint  _allocation_sample_buffer_top;
+  uintx _copies_until_allocation_sample;
+
+  inline void sample_old_allocation(HeapWord* obj_ptr, Klass* k);
+  void flush_allocation_samples();
+
+  // Bytes and objects evacuated per tenant (-XX:+TenantHeapIsolation),
+  // added up here and handed to the tenants when the table is full and
+  // when the thread is done.
+  struct TenantCopyStats {
+    AllocationContext_t _context;
+    size_t              _words;
+    size_t              _objects;
+  };
+  static const uint TenantCopyStatsSize = 8;
+  TenantCopyStats _tenant_copy_stats[TenantCopyStatsSize];
+  uint _tenant_copy_stats_top;
+
+  inline void record_tenant_copy(AllocationContext_t context, size_t word_sz);
+  void flush_tenant_copy_stats();
+
   void   add_to_alloc_buffer_waste(size_t waste) { _alloc_buffer_waste += waste; }
   void   add_to_undo_waste(size_t waste)         { _undo_waste += waste; }
 
@@ -122,12 +150,21 @@ class G1ParScanThreadState : public StackObj {
    }
   }
 
-  void set_evac_failure_closure(OopsInHeapRegionClosure* evac_failure_cl) {
-    _evac_failure_cl = evac_failure_cl;
+  // Remember a location pointing into an optional region of the collection
+  // set, to be updated when the region is evacuated by a later increment.
+  void remember_into_optional_region(oop* p);
+  void remember_into_optional_region(narrowOop* p);
+  void remember_root_into_optional_region(oop* p);
+  void remember_root_into_optional_region(narrowOop* p);
+
+  // Scan the fields of "obj", which failed evacuation and is now
+  // self-forwarded in "r", pushing references into the collection set
+  // onto this thread's queue.
+  void scan_evacuation_failed_object(HeapRegion* r, oop obj) {
+    _scanner.set_region(r);
+    obj->oop_iterate_backwards(&_scanner);
   }
 
-  OopsInHeapRegionClosure* evac_failure_closure() { return _evac_failure_cl; }
-
   uint queue_num() { return _queue_num; }
 
   size_t term_attempts() const  { return _term_attempts; }
@@ -201,6 +238,15 @@ class G1ParScanThreadState : public StackObj {
 
   inline void dispatch_reference(StarTask ref);
 
+  // Prefetches the object a task queue entry refers to, so that its header
+  // is in the cache when the entry is dispatched.
+  template <class T> inline void prefetch_reference(T* ref_to_scan);
+  inline void prefetch_reference(StarTask ref);
+
+  // Drains the local task queue in batches of G1EvacPrefetchBatchSize
+  // entries, prefetching all objects of a batch before copying any of them.
+  void drain_local_queue_in_batches();
+
   // Tries to allocate word_sz in the PLAB of the next "generation" after trying to
   // allocate into dest. State is the original (source) cset state for the object
   // that is allocated for.
@@ -219,6 +265,9 @@ class G1ParScanThreadState : public StackObj {
 
   oop copy_to_survivor_space(InCSetState const state, oop const obj, markOop const old_mark);
 
+  // Upper bound for G1EvacPrefetchBatchSize.
+  static const uintx MaxEvacPrefetchBatchSize = 32;
+
   void trim_queue();
 
   inline void steal_and_trim_queue(RefToScanQueueSet *task_queues);
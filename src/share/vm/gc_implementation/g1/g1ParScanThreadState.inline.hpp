@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1ParScanThreadState.hpp"
 #include "gc_implementation/g1/g1RemSet.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 template <class T> void G1ParScanThreadState::do_oop_evac(T* p, HeapRegion* from) {
   assert(!oopDesc::is_null(oopDesc::load_decode_heap_oop(p)),
@@ -50,6 +51,8 @@ template <class T> void G1ParScanThreadState::do_oop_evac(T* p, HeapRegion* from
     oopDesc::encode_store_heap_oop(p, forwardee);
   } else if (in_cset_state.is_humongous()) {
     _g1h->set_humongous_is_live(obj);
+  } else if (in_cset_state.is_optional()) {
+    remember_into_optional_region(p);
   } else {
     assert(!in_cset_state.is_in_cset_or_humongous(),
            err_msg("In_cset_state must be NotInCSet here, but is " CSETSTATE_FORMAT, in_cset_state.value()));
@@ -129,6 +132,24 @@ inline void G1ParScanThreadState::dispatch_reference(StarTask ref) {
   }
 }
 
+template <class T> inline void G1ParScanThreadState::prefetch_reference(T* ref_to_scan) {
+  if (!has_partial_array_mask(ref_to_scan)) {
+    T heap_oop = oopDesc::load_heap_oop(ref_to_scan);
+    if (!oopDesc::is_null(heap_oop)) {
+      // The mark word is written when the object is forwarded.
+      Prefetch::write(oopDesc::decode_heap_oop_not_null(heap_oop), 0);
+    }
+  }
+}
+
+inline void G1ParScanThreadState::prefetch_reference(StarTask ref) {
+  if (ref.is_narrow()) {
+    prefetch_reference((narrowOop*)ref);
+  } else {
+    prefetch_reference((oop*)ref);
+  }
+}
+
 void G1ParScanThreadState::steal_and_trim_queue(RefToScanQueueSet *task_queues) {
   StarTask stolen_task;
   while (task_queues->steal(queue_num(), stolen_task)) {
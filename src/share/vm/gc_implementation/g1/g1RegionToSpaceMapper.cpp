@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/virtualspace.hpp"
@@ -38,13 +39,23 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _storage(rs, used_size, page_size),
   _region_granularity(region_granularity),
   _listener(NULL),
-  _commit_map() {
+  _commit_map(),
+  _memory_type(type) {
   guarantee(is_power_of_2(page_size), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
 
   MemTracker::record_virtual_memory_type((address)rs.base(), type);
 }
 
+bool G1RegionToSpaceMapper::numa_binds_memory() const {
+  return _memory_type == mtJavaHeap && G1NUMA::numa()->is_enabled();
+}
+
+void G1RegionToSpaceMapper::numa_request_on_node(char* address, size_t size_in_bytes, uint region_index) {
+  assert(numa_binds_memory(), "should not be called otherwise");
+  G1NUMA::numa()->request_memory_on_node(address, size_in_bytes, region_index);
+}
+
 // G1RegionToSpaceMapper implementation where the region granularity is larger than
 // or the same as the commit granularity.
 // Basically, the space corresponding to one region region spans several OS pages.
@@ -67,7 +78,17 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   }
 
   virtual void commit_regions(uint start_idx, size_t num_regions) {
-    bool zero_filled = _storage.commit((size_t)start_idx * _pages_per_region, num_regions * _pages_per_region);
+    size_t start_page = (size_t)start_idx * _pages_per_region;
+    size_t size_in_pages = num_regions * _pages_per_region;
+    bool numa = numa_binds_memory();
+    bool zero_filled = _storage.commit(start_page, size_in_pages, !numa /* allow_pretouch */);
+    if (numa) {
+      for (uint i = start_idx; i < start_idx + num_regions; i++) {
+        numa_request_on_node((char*)_storage.reserved().start() + (size_t)i * _region_granularity,
+                             _region_granularity, i);
+      }
+      _storage.pretouch(start_page, size_in_pages);
+    }
     _commit_map.set_range(start_idx, start_idx + num_regions);
     fire_on_commit(start_idx, num_regions, zero_filled);
   }
@@ -133,7 +154,14 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
       uint old_refcount = _refcounts.get_by_index(idx);
       bool zero_filled = false;
       if (old_refcount == 0) {
-        zero_filled = _storage.commit(idx, 1);
+        bool numa = numa_binds_memory();
+        zero_filled = _storage.commit(idx, 1, !numa /* allow_pretouch */);
+        if (numa) {
+          size_t page_size_in_bytes = _regions_per_page * _region_granularity;
+          numa_request_on_node((char*)_storage.reserved().start() + idx * page_size_in_bytes,
+                               page_size_in_bytes, i);
+          _storage.pretouch(idx, 1);
+        }
       }
       _refcounts.set_by_index(idx, old_refcount + 1);
       _commit_map.set_bit(i);
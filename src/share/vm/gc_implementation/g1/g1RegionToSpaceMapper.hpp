@@ -52,9 +52,18 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   BitMap _commit_map;
 
+  MemoryType _memory_type;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t used_size, size_t page_size, size_t region_granularity, MemoryType type);
 
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
+
+  // Whether committed Java heap memory is bound to NUMA nodes. If so the
+  // pages are only pretouched after numa_request_on_node().
+  bool numa_binds_memory() const;
+  // Bind the given committed range, starting at the given region, to the
+  // NUMA node of that region.
+  void numa_request_on_node(char* address, size_t size_in_bytes, uint region_index);
  public:
   MemRegion reserved() { return _storage.reserved(); }
 
@@ -26,6 +26,7 @@
 #include "gc_implementation/g1/concurrentG1Refine.hpp"
 #include "gc_implementation/g1/concurrentG1RefineThread.hpp"
 #include "gc_implementation/g1/g1BlockOffsetTable.inline.hpp"
+#include "gc_implementation/g1/g1CardSummary.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy.hpp"
 #include "gc_implementation/g1/g1HotCardCache.hpp"
@@ -37,6 +38,7 @@
 #include "memory/iterator.hpp"
 #include "oops/oop.inline.hpp"
 #include "utilities/intHisto.hpp"
+#include "utilities/quickSort.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -76,6 +78,7 @@ G1RemSet::G1RemSet(G1CollectedHeap* g1, CardTableModRefBS* ct_bs)
     _cg1r(g1->concurrent_g1_refine()),
     _cset_rs_update_cl(NULL),
     _cards_scanned(NULL), _total_cards_scanned(0),
+    _card_summary(NULL),
     _prev_period_summary()
 {
   guarantee(n_workers() > 0, "There should be some workers");
@@ -86,6 +89,9 @@ G1RemSet::G1RemSet(G1CollectedHeap* g1, CardTableModRefBS* ct_bs)
   if (G1SummarizeRSetStats) {
     _prev_period_summary.initialize(this);
   }
+  if (G1UseCardSummary) {
+    _card_summary = new G1CardSummary(_g1->reserved_region());
+  }
 }
 
 G1RemSet::~G1RemSet() {
@@ -93,6 +99,9 @@ G1RemSet::~G1RemSet() {
     assert(_cset_rs_update_cl[i] == NULL, "it should be");
   }
   FREE_C_HEAP_ARRAY(G1ParPushHeapRSClosure*, _cset_rs_update_cl, mtGC);
+  if (_card_summary != NULL) {
+    delete _card_summary;
+  }
 }
 
 void CountNonCleanMemRegionClosure::do_MemRegion(MemRegion mr) {
@@ -111,6 +120,7 @@ class ScanRSClosure : public HeapRegionClosure {
 
   G1BlockOffsetSharedArray* _bot_shared;
   G1SATBCardTableModRefBS *_ct_bs;
+  G1CardSummary* _card_summary;
 
   double _strong_code_root_scan_time_sec;
   uint   _worker_i;
@@ -132,6 +142,7 @@ public:
     _g1h = G1CollectedHeap::heap();
     _bot_shared = _g1h->bot_shared();
     _ct_bs = _g1h->g1_barrier_set();
+    _card_summary = _g1h->g1_rem_set()->card_summary();
     _block_size = MAX2<int>(G1RSetScanBlockSize, 1);
   }
 
@@ -191,6 +202,10 @@ public:
     HeapRegionRemSetIterator iter(hrrs);
     size_t card_index;
 
+    // References into a young region only come from cards refined since
+    // the last pause, see G1CardSummary.
+    G1CardSummary* card_summary = r->is_young() ? _card_summary : NULL;
+
     // We claim cards in block so as to recude the contention. The block size is determined by
     // the G1RSetScanBlockSize parameter.
     size_t jump_to_card = hrrs->iter_claimed_next(_block_size);
@@ -204,6 +219,9 @@ public:
       gclog_or_tty->print("Rem set iteration yielded card [" PTR_FORMAT ", " PTR_FORMAT ").\n",
                           card_start, card_start + CardTableModRefBS::card_size_in_words);
 #endif
+      if (card_summary != NULL && !card_summary->is_marked(card_start)) {
+        continue;
+      }
 
       HeapRegion* card_region = _g1h->heap_region_containing(card_start);
       _cards++;
@@ -257,6 +275,30 @@ void G1RemSet::scanRS(G1ParPushHeapRSClosure* oc,
   _g1p->phase_times()->record_time_secs(G1GCPhaseTimes::CodeRoots, worker_i, scanRScl.strong_code_root_scan_time_sec());
 }
 
+void G1RemSet::scan_rem_set_for_regions(G1ParPushHeapRSClosure* oc,
+                                        CodeBlobClosure* code_root_cl,
+                                        HeapRegion** regions,
+                                        uint num_regions,
+                                        uint worker_i) {
+  if (num_regions == 0) {
+    return;
+  }
+  ScanRSClosure scanRScl(oc, code_root_cl, worker_i);
+
+  // Start at a different region for each worker, as scanRS() does.
+  uint start = worker_i % num_regions;
+  for (uint i = 0; i < num_regions; i++) {
+    scanRScl.doHeapRegion(regions[(start + i) % num_regions]);
+  }
+  scanRScl.set_try_claimed();
+  for (uint i = 0; i < num_regions; i++) {
+    scanRScl.doHeapRegion(regions[(start + i) % num_regions]);
+  }
+
+  assert(_cards_scanned != NULL, "invariant");
+  _cards_scanned[worker_i] += scanRScl.cards_done();
+}
+
 // Closure used for updating RSets and recording references that
 // point into the collection set. Only called during an
 // evacuation pause.
@@ -359,6 +401,9 @@ void G1RemSet::cleanup_after_oops_into_collection_set_do() {
   _g1->set_refine_cte_cl_concurrency(true);
   // Set all cards back to clean.
   _g1->cleanUpCardTable();
+  if (_card_summary != NULL) {
+    _card_summary->clear();
+  }
 
   DirtyCardQueueSet& into_cset_dcqs = _g1->into_cset_dirty_card_queue_set();
   int into_cset_n_buffers = into_cset_dcqs.completed_buffers_num();
@@ -489,6 +534,10 @@ bool G1RemSet::refine_card(jbyte* card_ptr, uint worker_i,
     return false;
   }
 
+  if (_card_summary != NULL) {
+    _card_summary->mark_card(start);
+  }
+
   // The result from the hot card cache insert call is either:
   //   * pointer to the current card
   //     (implying that the current card is not 'hot'),
@@ -608,6 +657,108 @@ bool G1RemSet::refine_card(jbyte* card_ptr, uint worker_i,
   return has_refs_into_cset;
 }
 
+// Orders card pointers by address, with the NULL entries last.
+static int compare_cards(jbyte* a, jbyte* b) {
+  if (a == b) {
+    return 0;
+  } else if (a == NULL) {
+    return 1;
+  } else if (b == NULL) {
+    return -1;
+  }
+  return a < b ? -1 : 1;
+}
+
+bool G1RemSet::refine_cards(jbyte** cards, size_t num, uint worker_i,
+                            bool may_yield) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "only for concurrent refinement");
+  const jbyte dirty = CardTableModRefBS::dirty_card_val();
+
+  // Filter the cards and pass them through the hot card cache as
+  // refine_card() does, before reordering them.
+  G1HotCardCache* hot_card_cache = _cg1r->hot_card_cache();
+  for (size_t i = 0; i < num; i++) {
+    jbyte* card_ptr = cards[i];
+    if (card_ptr == NULL) {
+      continue;
+    }
+    if (*card_ptr != dirty) {
+      cards[i] = NULL;
+      continue;
+    }
+    HeapRegion* r = _g1->heap_region_containing(_ct_bs->addr_for(card_ptr));
+    if (r->is_young() || r->in_collection_set()) {
+      cards[i] = NULL;
+      continue;
+    }
+    if (_card_summary != NULL) {
+      _card_summary->mark_card(_ct_bs->addr_for(card_ptr));
+    }
+    if (hot_card_cache->use_cache()) {
+      cards[i] = hot_card_cache->insert(card_ptr);
+    }
+  }
+
+  QuickSort::sort<jbyte*>(cards, (int) num, compare_cards, false);
+
+  G1UpdateRSOrPushRefOopClosure update_rs_oop_cl(_g1,
+                                                 this,
+                                                 NULL,
+                                                 false /* record_refs_into_cset */,
+                                                 worker_i);
+  size_t i = 0;
+  while (i < num && cards[i] != NULL) {
+    jbyte* const first = cards[i];
+    HeapWord* const start = _ct_bs->addr_for(first);
+    HeapRegion* r = _g1->heap_region_containing(start);
+
+    // Extend the run over duplicates and adjacent cards of the same
+    // region, so that the region lookup and the search for the first
+    // object are only done once.
+    jbyte* last = first;
+    size_t j = i + 1;
+    while (j < num && cards[j] != NULL &&
+           (cards[j] == last || cards[j] == last + 1) &&
+           _ct_bs->addr_for(cards[j]) < r->end()) {
+      last = cards[j];
+      j++;
+    }
+
+    HeapWord* const end = _ct_bs->addr_for(last) + CardTableModRefBS::card_size_in_words;
+    MemRegion dirty_region(start, end);
+    update_rs_oop_cl.set_from(r);
+    FilterOutOfRegionClosure filter_then_update_rs_oop_cl(r, &update_rs_oop_cl);
+
+    bool cards_processed =
+      r->oops_on_card_seq_iterate_careful(dirty_region,
+                                          &filter_then_update_rs_oop_cl,
+                                          first);
+    if (!cards_processed) {
+      // As in refine_card(), redirty and re-enqueue the cleaned cards.
+      MutexLockerEx x(Shared_DirtyCardQ_lock,
+                      Mutex::_no_safepoint_check_flag);
+      DirtyCardQueue* sdcq =
+        JavaThread::dirty_card_queue_set().shared_dirty_card_queue();
+      for (jbyte* c = first; c <= last; c++) {
+        if (*c != dirty) {
+          *c = dirty;
+          sdcq->enqueue(c);
+        }
+      }
+    } else {
+      _conc_refine_cards += pointer_delta(last, first, sizeof(jbyte)) + 1;
+    }
+
+    for (; i < j; i++) {
+      cards[i] = NULL;
+    }
+    if (may_yield && SuspendibleThreadSet::should_yield()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void G1RemSet::print_periodic_summary_info(const char* header) {
   G1RemSetSummary current;
   current.initialize(this);
@@ -30,6 +30,7 @@
 // A G1RemSet provides ways of iterating over pointers into a selected
 // collection set.
 
+class G1CardSummary;
 class G1CollectedHeap;
 class CardTableModRefBarrierSet;
 class ConcurrentG1Refine;
@@ -70,6 +71,10 @@ protected:
   // references into the collection set.
   G1ParPushHeapRSClosure** _cset_rs_update_cl;
 
+  // Summary of the cards refined since the last pause, or NULL
+  // without G1UseCardSummary.
+  G1CardSummary*         _card_summary;
+
   // Print the given summary info
   virtual void print_summary_info(G1RemSetSummary * summary, const char * header = NULL);
 public:
@@ -81,6 +86,8 @@ public:
   G1RemSet(G1CollectedHeap* g1, CardTableModRefBS* ct_bs);
   ~G1RemSet();
 
+  G1CardSummary* card_summary() const { return _card_summary; }
+
   // Invoke "blk->do_oop" on all pointers into the collection set
   // from objects in regions outside the collection set (having
   // invoked "blk->set_region" to set the "from" region correctly
@@ -111,6 +118,15 @@ public:
               CodeBlobClosure* code_root_cl,
               uint worker_i);
 
+  // Like scanRS(), but only scans the remembered sets and strong code roots
+  // of the given regions, which have been added to the collection set by an
+  // optional evacuation increment.
+  void scan_rem_set_for_regions(G1ParPushHeapRSClosure* oc,
+                                CodeBlobClosure* code_root_cl,
+                                HeapRegion** regions,
+                                uint num_regions,
+                                uint worker_i);
+
   void updateRS(DirtyCardQueue* into_cset_dcq, uint worker_i);
 
   CardTableModRefBS* ct_bs() { return _ct_bs; }
@@ -141,6 +157,13 @@ public:
                            uint worker_i,
                            bool check_for_refs_into_cset);
 
+  // Concurrently refine the non-NULL cards in "cards[0, num)", setting the
+  // processed entries to NULL. The cards are sorted by address so that
+  // runs of adjacent cards in a region are scanned together. Returns
+  // false if may_yield is set and the caller should yield before the
+  // remaining entries are processed.
+  bool refine_cards(jbyte** cards, size_t num, uint worker_i, bool may_yield);
+
   // Print accumulated summary info from the start of the VM.
   virtual void print_summary_info();
 
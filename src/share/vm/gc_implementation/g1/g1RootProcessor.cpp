@@ -271,7 +271,12 @@ void G1RootProcessor::process_java_roots(OopClosure* strong_roots,
 
   {
     G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::ThreadRoots, worker_i);
-    Threads::possibly_parallel_oops_do(strong_roots, thread_stack_clds, strong_code);
+    Threads::possibly_parallel_oops_do(strong_roots, thread_stack_clds, strong_code, false /* all_coroutines */);
+  }
+
+  {
+    G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::CoroutineRoots, worker_i);
+    Threads::possibly_parallel_coroutines_oops_do(strong_roots, thread_stack_clds, strong_code);
   }
 }
 
@@ -288,9 +293,7 @@ void G1RootProcessor::process_vm_roots(OopClosure* strong_roots,
 
   {
     G1GCParPhaseTimesTracker x(phase_times, G1GCPhaseTimes::JNIRoots, worker_i);
-    if (!_process_strong_tasks.is_task_claimed(G1RP_PS_JNIHandles_oops_do)) {
-      JNIHandles::oops_do(strong_roots);
-    }
+    JNIHandles::possibly_parallel_oops_do(strong_roots);
   }
 
   {
@@ -367,6 +370,17 @@ void G1RootProcessor::scan_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
   _g1h->g1_rem_set()->oops_into_collection_set_do(scan_rs, &scavenge_cs_nmethods, worker_i);
 }
 
+void G1RootProcessor::scan_optional_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
+                                                    OopClosure* scan_non_heap_weak_roots,
+                                                    HeapRegion** regions,
+                                                    uint num_regions,
+                                                    uint worker_i) {
+  G1CodeBlobClosure scavenge_cs_nmethods(scan_non_heap_weak_roots);
+
+  _g1h->g1_rem_set()->scan_rem_set_for_regions(scan_rs, &scavenge_cs_nmethods,
+                                               regions, num_regions, worker_i);
+}
+
 void G1RootProcessor::set_num_workers(int active_workers) {
   _process_strong_tasks.set_n_threads(active_workers);
 }
@@ -35,6 +35,7 @@ class G1CollectedHeap;
 class G1GCPhaseTimes;
 class G1ParPushHeapRSClosure;
 class G1RootClosures;
+class HeapRegion;
 class Monitor;
 class OopClosure;
 class SubTasksDone;
@@ -55,7 +56,6 @@ class G1RootProcessor : public StackObj {
 
   enum G1H_process_roots_tasks {
     G1RP_PS_Universe_oops_do,
-    G1RP_PS_JNIHandles_oops_do,
     G1RP_PS_ObjectSynchronizer_oops_do,
     G1RP_PS_FlatProfiler_oops_do,
     G1RP_PS_Management_oops_do,
@@ -129,6 +129,15 @@ public:
                             OopClosure* scan_non_heap_weak_roots,
                             uint worker_i);
 
+  // Apply scan_rs to the remembered sets of the given optional regions that
+  // have just been added to the collection set, and scan_non_heap_weak_roots
+  // to their strong code roots.
+  void scan_optional_remembered_sets(G1ParPushHeapRSClosure* scan_rs,
+                                     OopClosure* scan_non_heap_weak_roots,
+                                     HeapRegion** regions,
+                                     uint num_regions,
+                                     uint worker_i);
+
   // Apply oops, clds and blobs to strongly and weakly reachable roots in the system,
   // the only thing different from process_all_roots is that we skip the string table
   // to avoid keeping every string live when doing class unloading.
@@ -27,7 +27,9 @@
 
 G1StringDedupStat::G1StringDedupStat() :
   _inspected(0),
+  _unsampled(0),
   _skipped(0),
+  _filtered(0),
   _hashed(0),
   _known(0),
   _new(0),
@@ -47,9 +49,19 @@ G1StringDedupStat::G1StringDedupStat() :
   _block_elapsed(0.0) {
 }
 
+double G1StringDedupStat::deduped_percent_of_looked_up() const {
+  if (looked_up() == 0) {
+    // Avoid division by zero
+    return 0.0;
+  }
+  return (double)_deduped / (double)looked_up() * 100.0;
+}
+
 void G1StringDedupStat::add(const G1StringDedupStat& stat) {
   _inspected           += stat._inspected;
+  _unsampled           += stat._unsampled;
   _skipped             += stat._skipped;
+  _filtered            += stat._filtered;
   _hashed              += stat._hashed;
   _known               += stat._known;
   _new                 += stat._new;
@@ -92,7 +104,9 @@ void G1StringDedupStat::print_summary(outputStream* st, const G1StringDedupStat&
 void G1StringDedupStat::print_statistics(outputStream* st, const G1StringDedupStat& stat, bool total) {
   double young_percent               = 0.0;
   double old_percent                 = 0.0;
+  double unsampled_percent           = 0.0;
   double skipped_percent             = 0.0;
+  double filtered_percent            = 0.0;
   double hashed_percent              = 0.0;
   double known_percent               = 0.0;
   double new_percent                 = 0.0;
@@ -105,8 +119,10 @@ void G1StringDedupStat::print_statistics(outputStream* st, const G1StringDedupSt
 
   if (stat._inspected > 0) {
     // Avoid division by zero
+    unsampled_percent = (double)stat._unsampled / (double)stat._inspected * 100.0;
     skipped_percent = (double)stat._skipped / (double)stat._inspected * 100.0;
     hashed_percent  = (double)stat._hashed / (double)stat._inspected * 100.0;
+    filtered_percent = (double)stat._filtered / (double)stat._inspected * 100.0;
     known_percent   = (double)stat._known / (double)stat._inspected * 100.0;
     new_percent     = (double)stat._new / (double)stat._inspected * 100.0;
   }
@@ -144,16 +160,20 @@ void G1StringDedupStat::print_statistics(outputStream* st, const G1StringDedupSt
   }
   st->print_cr(
     "      [Inspected:    " G1_STRDEDUP_OBJECTS_FORMAT "]\n"
+    "         [Unsampled: " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [Skipped:   " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [Hashed:    " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
+    "         [Filtered:  " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [Known:     " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [New:       " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "]\n"
     "      [Deduplicated: " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [Young:     " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]\n"
     "         [Old:       " G1_STRDEDUP_OBJECTS_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ") " G1_STRDEDUP_BYTES_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT ")]",
     stat._inspected,
+    stat._unsampled, unsampled_percent,
     stat._skipped, skipped_percent,
     stat._hashed, hashed_percent,
+    stat._filtered, filtered_percent,
     stat._known, known_percent,
     stat._new, new_percent, G1_STRDEDUP_BYTES_PARAM(stat._new_bytes),
     stat._deduped, deduped_percent, G1_STRDEDUP_BYTES_PARAM(stat._deduped_bytes), deduped_bytes_percent,
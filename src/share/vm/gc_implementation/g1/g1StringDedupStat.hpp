@@ -44,7 +44,9 @@ class G1StringDedupStat : public StackObj {
 private:
   // Counters
   uintx  _inspected;
+  uintx  _unsampled;
   uintx  _skipped;
+  uintx  _filtered;
   uintx  _hashed;
   uintx  _known;
   uintx  _new;
@@ -72,10 +74,19 @@ public:
     _inspected++;
   }
 
+  void inc_unsampled() {
+    _inspected++;
+    _unsampled++;
+  }
+
   void inc_skipped() {
     _skipped++;
   }
 
+  void inc_filtered() {
+    _filtered++;
+  }
+
   void inc_hashed() {
     _hashed++;
   }
@@ -133,6 +144,14 @@ public:
     _exec_elapsed += now - _start;
   }
 
+  // Percentage of the strings looked up in the table, including the
+  // ones stopped by the Bloom filter, that were deduplicated.
+  double deduped_percent_of_looked_up() const;
+
+  uintx looked_up() const {
+    return _new + _filtered;
+  }
+
   void add(const G1StringDedupStat& stat);
 
   static void print_summary(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
@@ -33,6 +33,7 @@
 #include "memory/padded.inline.hpp"
 #include "oops/typeArrayOop.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "utilities/bitMap.inline.hpp"
 
 //
 // List of deduplication table entries. Links table
@@ -151,6 +152,7 @@ void G1StringDedupEntryCache::free(G1StringDedupEntry* entry, uint worker_id) {
 
   entry->set_obj(NULL);
   entry->set_hash(0);
+  entry->set_length(0);
 
   if (_cached[worker_id].length() < _max_list_length) {
     // Cache is not full
@@ -199,8 +201,85 @@ void G1StringDedupEntryCache::delete_overflowed() {
   }
 }
 
-G1StringDedupTable*      G1StringDedupTable::_table = NULL;
-G1StringDedupEntryCache* G1StringDedupTable::_entry_cache = NULL;
+//
+// Bloom filter over the hashes of the character arrays looked up by the
+// deduplication thread. On high-churn workloads most strings are unique,
+// and looking them up and adding them to the table is wasted effort. With
+// StringDeduplicationBloomFilter a character array is only looked up in the
+// table once its hash has been seen before, so values seen a single time
+// never enter the table. The filter is cleared when it has filled up, and
+// when a table rehash completes since the hash values then change. Access is
+// protected by the StringDedupTable_lock.
+//
+class G1StringDedupBloomFilter : public CHeapObj<mtGC> {
+private:
+  static const size_t _size_in_bits_log = 20; // 128K bytes
+  static const size_t _size_in_bits = (size_t)1 << _size_in_bits_log;
+
+  BitMap _bits;
+  size_t _set_bits;
+  uintx  _clear_count;
+
+  static size_t index1(unsigned int hash) {
+    return (size_t)((hash * 0x9E3779B1U) >> (32 - _size_in_bits_log));
+  }
+
+  static size_t index2(unsigned int hash) {
+    return (size_t)(((hash ^ (hash >> 16)) * 0x85EBCA6BU) >> (32 - _size_in_bits_log));
+  }
+
+  bool test_and_set_bit(size_t index) {
+    if (_bits.at(index)) {
+      return true;
+    }
+    _bits.set_bit(index);
+    _set_bits++;
+    return false;
+  }
+
+public:
+  G1StringDedupBloomFilter() :
+    _bits(_size_in_bits, false /* in_resource_area */),
+    _set_bits(0),
+    _clear_count(0) {
+  }
+
+  // Records the hash. Returns true if the hash might have been recorded
+  // before, false if it definitely has not.
+  bool test_and_set(unsigned int hash) {
+    // Keep the false positive rate with two probes below about 6%.
+    if (_set_bits > _size_in_bits / 4) {
+      clear();
+    }
+    bool seen1 = test_and_set_bit(index1(hash));
+    bool seen2 = test_and_set_bit(index2(hash));
+    return seen1 && seen2;
+  }
+
+  void clear() {
+    _bits.clear_large();
+    _set_bits = 0;
+    _clear_count++;
+  }
+
+  size_t size_in_bytes() const {
+    return _size_in_bits / BitsPerByte;
+  }
+
+  size_t set_bits() const {
+    return _set_bits;
+  }
+
+  uintx clear_count() const {
+    return _clear_count;
+  }
+};
+
+G1StringDedupTable*       G1StringDedupTable::_table = NULL;
+G1StringDedupTable*       G1StringDedupTable::_resized_table = NULL;
+size_t                    G1StringDedupTable::_resize_next_bucket = 0;
+G1StringDedupEntryCache*  G1StringDedupTable::_entry_cache = NULL;
+G1StringDedupBloomFilter* G1StringDedupTable::_bloom_filter = NULL;
 
 const size_t             G1StringDedupTable::_min_size = (1 << 10);   // 1024
 const size_t             G1StringDedupTable::_max_size = (1 << 24);   // 16777216
@@ -209,6 +288,7 @@ const double             G1StringDedupTable::_shrink_load_factor = _grow_load_fa
 const double             G1StringDedupTable::_max_cache_factor = 0.1; // Cache a maximum of 10% of the table size
 const uintx              G1StringDedupTable::_rehash_multiple = 60;   // Hash bucket has 60 times more collisions than expected
 const uintx              G1StringDedupTable::_rehash_threshold = (uintx)(_rehash_multiple * _grow_load_factor);
+const size_t             G1StringDedupTable::_resize_step_buckets = (1 << 12); // Buckets transferred per resize step
 
 uintx                    G1StringDedupTable::_entries_added = 0;
 uintx                    G1StringDedupTable::_entries_removed = 0;
@@ -235,12 +315,16 @@ void G1StringDedupTable::create() {
   assert(_table == NULL, "One string deduplication table allowed");
   _entry_cache = new G1StringDedupEntryCache((size_t)(_min_size * _max_cache_factor));
   _table = new G1StringDedupTable(_min_size);
+  if (StringDeduplicationBloomFilter) {
+    _bloom_filter = new G1StringDedupBloomFilter();
+  }
 }
 
 void G1StringDedupTable::add(typeArrayOop value, unsigned int hash, G1StringDedupEntry** list) {
   G1StringDedupEntry* entry = _entry_cache->alloc();
   entry->set_obj(value);
   entry->set_hash(hash);
+  entry->set_length(value->length());
   entry->set_next(*list);
   *list = entry;
   _entries++;
@@ -256,10 +340,16 @@ void G1StringDedupTable::transfer(G1StringDedupEntry** pentry, G1StringDedupTabl
   G1StringDedupEntry* entry = *pentry;
   *pentry = entry->next();
   unsigned int hash = entry->hash();
+  if (dest->_hash_seed != _hash_seed) {
+    hash = hash_code(entry->obj(), dest->_hash_seed);
+    entry->set_hash(hash);
+  }
   size_t index = dest->hash_to_index(hash);
   G1StringDedupEntry** list = dest->bucket(index);
   entry->set_next(*list);
   *list = entry;
+  _entries--;
+  dest->_entries++;
 }
 
 bool G1StringDedupTable::equals(typeArrayOop value1, typeArrayOop value2) {
@@ -272,8 +362,9 @@ bool G1StringDedupTable::equals(typeArrayOop value1, typeArrayOop value2) {
 
 typeArrayOop G1StringDedupTable::lookup(typeArrayOop value, unsigned int hash,
                                         G1StringDedupEntry** list, uintx &count) {
+  int length = value->length();
   for (G1StringDedupEntry* entry = *list; entry != NULL; entry = entry->next()) {
-    if (entry->hash() == hash) {
+    if (entry->hash() == hash && entry->length() == length) {
       typeArrayOop existing_value = entry->obj();
       if (equals(value, existing_value)) {
         // Match found
@@ -311,20 +402,65 @@ typeArrayOop G1StringDedupTable::lookup_or_add_inner(typeArrayOop value, unsigne
   return existing_value;
 }
 
-unsigned int G1StringDedupTable::hash_code(typeArrayOop value) {
+typeArrayOop G1StringDedupTable::lookup_or_add(oop java_string, typeArrayOop value,
+                                               G1StringDedupStat& stat,
+                                               bool use_bloom_filter, bool& filtered) {
+  // Protect the table from concurrent access. Also note that this lock
+  // acts as a fence for _table, which could have been replaced by a new
+  // instance if the table was resized or rehashed.
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+
+  unsigned int hash = 0;
+
+  if (use_java_hash()) {
+    // Get hash code from cache
+    hash = java_lang_String::hash(java_string);
+  }
+
+  if (hash == 0) {
+    // Compute hash
+    hash = hash_code(value, _table->_hash_seed);
+    stat.inc_hashed();
+  }
+
+  if (use_java_hash() && hash != 0) {
+    // Store hash code in cache
+    java_lang_String::set_hash(java_string, hash);
+  }
+
+  if (use_bloom_filter && _bloom_filter != NULL && !_bloom_filter->test_and_set(hash)) {
+    // First time this hash is seen, don't look up or add the value
+    filtered = true;
+    return NULL;
+  }
+  filtered = false;
+
+  if (_resized_table != NULL && _table->hash_to_index(hash) < _resize_next_bucket) {
+    // The bucket has already been transferred to the resized table
+    if (_resized_table->_hash_seed != _table->_hash_seed) {
+      hash = hash_code(value, _resized_table->_hash_seed);
+    }
+    return _resized_table->lookup_or_add_inner(value, hash);
+  }
+
+  return _table->lookup_or_add_inner(value, hash);
+}
+
+unsigned int G1StringDedupTable::hash_code(typeArrayOop value, uint64_t hash_seed) {
   unsigned int hash;
   int length = value->length();
   const jchar* data = (jchar*)value->base(T_CHAR);
 
-  if (use_java_hash()) {
+  if (hash_seed == 0) {
     hash = java_lang_String::hash_code(data, length);
   } else {
-    hash = AltHashing::halfsiphash_32(_table->_hash_seed, (const uint16_t*)data, length);
+    hash = AltHashing::halfsiphash_32(hash_seed, (const uint16_t*)data, length);
   }
   return hash;
 }
 
-void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
+void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat,
+                                     bool use_bloom_filter) {
   assert(java_lang_String::is_instance(java_string), "Must be a string");
   No_Safepoint_Verifier nsv;
 
@@ -337,25 +473,14 @@ void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
     return;
   }
 
-  unsigned int hash = 0;
-
-  if (use_java_hash()) {
-    // Get hash code from cache
-    hash = java_lang_String::hash(java_string);
-  }
-
-  if (hash == 0) {
-    // Compute hash
-    hash = hash_code(value);
-    stat.inc_hashed();
-  }
-
-  if (use_java_hash() && hash != 0) {
-    // Store hash code in cache
-    java_lang_String::set_hash(java_string, hash);
+  bool filtered;
+  typeArrayOop existing_value = lookup_or_add(java_string, value, stat, use_bloom_filter, filtered);
+  if (filtered) {
+    // Value not seen before, not added to the table
+    stat.inc_filtered();
+    return;
   }
 
-  typeArrayOop existing_value = lookup_or_add(value, hash);
   if (existing_value == value) {
     // Same value, already known
     stat.inc_known();
@@ -418,98 +543,153 @@ G1StringDedupTable* G1StringDedupTable::prepare_resize() {
   // Update max cache size
   _entry_cache->set_max_size((size_t)(size * _max_cache_factor));
 
-  // Allocate the new table. The new table will be populated by workers
-  // calling unlink_or_oops_do() and finally installed by finish_resize().
+  // Allocate the new table. The new table will be populated by the
+  // deduplication thread calling resize_or_rehash_step().
   return new G1StringDedupTable(size, _table->_hash_seed);
 }
 
-void G1StringDedupTable::finish_resize(G1StringDedupTable* resized_table) {
-  assert(resized_table != NULL, "Invalid table");
+G1StringDedupTable* G1StringDedupTable::prepare_rehash() {
+  if (!_table->_rehash_needed && !StringDeduplicationRehashALot) {
+    // Rehash not needed
+    return NULL;
+  }
+
+  // Update statistics
+  _rehash_count++;
+
+  // Allocate the new table, same size and a new hash seed. Entries
+  // are rehashed as they are transferred into the new table.
+  return new G1StringDedupTable(_table->_size, AltHashing::compute_seed());
+}
 
-  resized_table->_entries = _table->_entries;
+bool G1StringDedupTable::start_resize_or_rehash() {
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+  assert(_resized_table == NULL, "Resize or rehash already in progress");
+
+  // If both resize and rehash is needed, only do resize. Rehash of
+  // the table will eventually happen if the situation persists.
+  G1StringDedupTable* resized_table = prepare_resize();
+  if (resized_table == NULL) {
+    resized_table = prepare_rehash();
+    if (resized_table == NULL) {
+      return false;
+    }
+  }
+
+  _resize_next_bucket = 0;
+  _resized_table = resized_table;
+  return true;
+}
+
+bool G1StringDedupTable::resize_or_rehash_step() {
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+  assert(_resized_table != NULL, "No resize or rehash in progress");
+
+  size_t end = MIN2(_resize_next_bucket + _resize_step_buckets, _table->_size);
+  for (size_t bucket = _resize_next_bucket; bucket < end; bucket++) {
+    G1StringDedupEntry** entry = _table->bucket(bucket);
+    while (*entry != NULL) {
+      _table->transfer(entry, _resized_table);
+    }
+  }
+  _resize_next_bucket = end;
+
+  if (_resize_next_bucket < _table->_size) {
+    return false;
+  }
+
+  finish_resize_or_rehash();
+  return true;
+}
+
+void G1StringDedupTable::finish_resize_or_rehash() {
+  assert(_table->_entries == 0, "All entries should have been transferred");
+
+  if (_bloom_filter != NULL && _resized_table->_hash_seed != _table->_hash_seed) {
+    // The recorded hashes were computed with the previous hash function
+    _bloom_filter->clear();
+  }
 
-  // Free old table
+  // Free old table. Nobody else can be using it since all accesses
+  // outside of safepoints hold the StringDedupTable_lock.
   delete _table;
 
   // Install new table
-  _table = resized_table;
+  _table = _resized_table;
+  _resized_table = NULL;
+  _resize_next_bucket = 0;
 }
 
 void G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl, uint worker_id) {
   // The table is divided into partitions to allow lock-less parallel processing by
   // multiple worker threads. A worker thread first claims a partition, which ensures
-  // exclusive access to that part of the table, then continues to process it. To allow
-  // shrinking of the table in parallel we also need to make sure that the same worker
-  // thread processes all partitions where entries will hash to the same destination
-  // partition. Since the table size is always a power of two and we always shrink by
-  // dividing the table in half, we know that for a given partition there is only one
-  // other partition whoes entries will hash to the same destination partition. That
-  // other partition is always the sibling partition in the second half of the table.
-  // For example, if the table is divided into 8 partitions, the sibling of partition 0
-  // is partition 4, the sibling of partition 1 is partition 5, etc.
-  size_t table_half = _table->_size / 2;
-
-  // Let each partition be one page worth of buckets
-  size_t partition_size = MIN2(table_half, os::vm_page_size() / sizeof(G1StringDedupEntry*));
-  assert(table_half % partition_size == 0, "Invalid partition size");
+  // exclusive access to that part of the table, then continues to process it. When a
+  // resize or rehash is in progress, the partitions of the resized table follow the
+  // partitions of the active table. Entries are never moved between tables here.
+  size_t table_size = _table->_size;
+  size_t total_size = table_size;
+  size_t partition_size = MIN2(table_size, os::vm_page_size() / sizeof(G1StringDedupEntry*));
+  if (_resized_table != NULL) {
+    total_size += _resized_table->_size;
+    partition_size = MIN2(partition_size, _resized_table->_size);
+  }
+  assert(table_size % partition_size == 0, "Invalid partition size");
 
   // Number of entries removed during the scan
   uintx removed = 0;
+  uintx removed_resized = 0;
 
   for (;;) {
     // Grab next partition to scan
     size_t partition_begin = cl->claim_table_partition(partition_size);
     size_t partition_end = partition_begin + partition_size;
-    if (partition_begin >= table_half) {
+    if (partition_begin >= total_size) {
       // End of table
       break;
     }
 
-    // Scan the partition followed by the sibling partition in the second half of the table
-    removed += unlink_or_oops_do(cl, partition_begin, partition_end, worker_id);
-    removed += unlink_or_oops_do(cl, table_half + partition_begin, table_half + partition_end, worker_id);
+    if (partition_begin < table_size) {
+      if (_resized_table != NULL && partition_end <= _resize_next_bucket) {
+        // Already transferred, nothing left in this partition
+        continue;
+      }
+      removed += unlink_or_oops_do(cl, _table, partition_begin, partition_end, worker_id);
+    } else {
+      removed_resized += unlink_or_oops_do(cl, _resized_table,
+                                           partition_begin - table_size,
+                                           partition_end - table_size,
+                                           worker_id);
+    }
   }
 
   // Delayed update to avoid contention on the table lock
-  if (removed > 0) {
+  if (removed > 0 || removed_resized > 0) {
     MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
     _table->_entries -= removed;
-    _entries_removed += removed;
+    if (removed_resized > 0) {
+      _resized_table->_entries -= removed_resized;
+    }
+    _entries_removed += removed + removed_resized;
   }
 }
 
 uintx G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                            G1StringDedupTable* table,
                                             size_t partition_begin,
                                             size_t partition_end,
                                             uint worker_id) {
   uintx removed = 0;
   for (size_t bucket = partition_begin; bucket < partition_end; bucket++) {
-    G1StringDedupEntry** entry = _table->bucket(bucket);
+    G1StringDedupEntry** entry = table->bucket(bucket);
     while (*entry != NULL) {
       oop* p = (oop*)(*entry)->obj_addr();
       if (cl->is_alive(*p)) {
         cl->keep_alive(p);
-        if (cl->is_resizing()) {
-          // We are resizing the table, transfer entry to the new table
-          _table->transfer(entry, cl->resized_table());
-        } else {
-          if (cl->is_rehashing()) {
-            // We are rehashing the table, rehash the entry but keep it
-            // in the table. We can't transfer entries into the new table
-            // at this point since we don't have exclusive access to all
-            // destination partitions. finish_rehash() will do a single
-            // threaded transfer of all entries.
-            typeArrayOop value = (typeArrayOop)*p;
-            unsigned int hash = hash_code(value);
-            (*entry)->set_hash(hash);
-          }
-
-          // Move to next entry
-          entry = (*entry)->next_addr();
-        }
+        // Move to next entry
+        entry = (*entry)->next_addr();
       } else {
         // Not alive, remove entry from table
-        _table->remove(entry, worker_id);
+        table->remove(entry, worker_id);
         removed++;
       }
     }
@@ -518,55 +698,30 @@ uintx G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure*
   return removed;
 }
 
-G1StringDedupTable* G1StringDedupTable::prepare_rehash() {
-  if (!_table->_rehash_needed && !StringDeduplicationRehashALot) {
-    // Rehash not needed
-    return NULL;
-  }
-
-  // Update statistics
-  _rehash_count++;
-
-  // Compute new hash seed
-  _table->_hash_seed = AltHashing::compute_seed();
-
-  // Allocate the new table, same size and hash seed
-  return new G1StringDedupTable(_table->_size, _table->_hash_seed);
-}
-
-void G1StringDedupTable::finish_rehash(G1StringDedupTable* rehashed_table) {
-  assert(rehashed_table != NULL, "Invalid table");
-
-  // Move all newly rehashed entries into the correct buckets in the new table
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
-    G1StringDedupEntry** entry = _table->bucket(bucket);
-    while (*entry != NULL) {
-      _table->transfer(entry, rehashed_table);
-    }
+void G1StringDedupTable::verify() {
+  if (_resized_table != NULL) {
+    // Buckets below _resize_next_bucket have been transferred and are empty
+    verify(_table, _resize_next_bucket);
+    verify(_resized_table, 0);
+  } else {
+    verify(_table, 0);
   }
-
-  rehashed_table->_entries = _table->_entries;
-
-  // Free old table
-  delete _table;
-
-  // Install new table
-  _table = rehashed_table;
 }
 
-void G1StringDedupTable::verify() {
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
+void G1StringDedupTable::verify(G1StringDedupTable* table, size_t bucket_begin) {
+  for (size_t bucket = bucket_begin; bucket < table->_size; bucket++) {
     // Verify entries
-    G1StringDedupEntry** entry = _table->bucket(bucket);
+    G1StringDedupEntry** entry = table->bucket(bucket);
     while (*entry != NULL) {
       typeArrayOop value = (*entry)->obj();
       guarantee(value != NULL, "Object must not be NULL");
       guarantee(Universe::heap()->is_in_reserved(value), "Object must be on the heap");
       guarantee(!value->is_forwarded(), "Object must not be forwarded");
       guarantee(value->is_typeArray(), "Object must be a typeArrayOop");
-      unsigned int hash = hash_code(value);
+      unsigned int hash = hash_code(value, table->_hash_seed);
       guarantee((*entry)->hash() == hash, "Table entry has inorrect hash");
-      guarantee(_table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
+      guarantee((*entry)->length() == value->length(), "Table entry has incorrect length");
+      guarantee(table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
       entry = (*entry)->next_addr();
     }
 
@@ -574,7 +729,7 @@ void G1StringDedupTable::verify() {
     // We only need to compare entries in the same bucket. If the same oop or an
     // identical array has been inserted more than once into different/incorrect
     // buckets the verification step above will catch that.
-    G1StringDedupEntry** entry1 = _table->bucket(bucket);
+    G1StringDedupEntry** entry1 = table->bucket(bucket);
     while (*entry1 != NULL) {
       typeArrayOop value1 = (*entry1)->obj();
       G1StringDedupEntry** entry2 = (*entry1)->next_addr();
@@ -607,4 +762,11 @@ void G1StringDedupTable::print_statistics(outputStream* st) {
     _resize_count, _table->_shrink_threshold, _shrink_load_factor * 100.0, _table->_grow_threshold, _grow_load_factor * 100.0,
     _rehash_count, _rehash_threshold, _table->_hash_seed,
     StringDeduplicationAgeThreshold);
+
+  if (_bloom_filter != NULL) {
+    st->print_cr(
+      "      [Bloom Filter: " G1_STRDEDUP_BYTES_FORMAT_NS ", Set Bits: " SIZE_FORMAT ", Clear Count: " UINTX_FORMAT "]",
+      G1_STRDEDUP_BYTES_PARAM(_bloom_filter->size_in_bytes()),
+      _bloom_filter->set_bits(), _bloom_filter->clear_count());
+  }
 }
@@ -28,23 +28,28 @@
 #include "gc_implementation/g1/g1StringDedupStat.hpp"
 #include "runtime/mutexLocker.hpp"
 
+class G1StringDedupBloomFilter;
 class G1StringDedupEntryCache;
 
 //
 // Table entry in the deduplication hashtable. Points weakly to the
 // character array. Can be chained in a linked list in case of hash
-// collisions or when placed in a freelist in the entry cache.
+// collisions or when placed in a freelist in the entry cache. The
+// length of the character array is kept in the entry, so that entries
+// with a colliding hash can be rejected without touching the array.
 //
 class G1StringDedupEntry : public CHeapObj<mtGC> {
 private:
   G1StringDedupEntry* _next;
   unsigned int        _hash;
+  int                 _length;
   typeArrayOop        _obj;
 
 public:
   G1StringDedupEntry() :
     _next(NULL),
     _hash(0),
+    _length(0),
     _obj(NULL) {
   }
 
@@ -68,6 +73,14 @@ public:
     _hash = hash;
   }
 
+  int length() {
+    return _length;
+  }
+
+  void set_length(int length) {
+    _length = length;
+  }
+
   typeArrayOop obj() {
     return _obj;
   }
@@ -94,6 +107,13 @@ public:
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
 // unbalanced, i.e., a hash chain is significantly longer than average.
 //
+// Resizing and rehashing are done concurrently by the deduplication thread, which
+// transfers the buckets of the active table into the new table a few at a time and
+// yields to safepoints in between. While such a transfer is in progress both tables
+// are in use: a value whose bucket in the active table has already been transferred
+// lives in the new table, any other value in the active table. GC workers process
+// the entries of both tables, but never move entries between tables.
+//
 // All access to the table is protected by the StringDedupTable_lock, except under
 // safepoints in which case GC workers are allowed to access a table partitions they
 // have claimed without first acquiring the lock. Note however, that this applies only
@@ -106,9 +126,18 @@ private:
   // the table is resizes or rehashed.
   static G1StringDedupTable*      _table;
 
+  // The table being populated by an ongoing resize or rehash, or NULL.
+  // Buckets of _table below _resize_next_bucket have been transferred.
+  static G1StringDedupTable*      _resized_table;
+  static size_t                   _resize_next_bucket;
+
   // Cache for reuse and fast alloc/free of table entries.
   static G1StringDedupEntryCache* _entry_cache;
 
+  // Hashes of the values looked up by the deduplication thread, used
+  // with StringDeduplicationBloomFilter.
+  static G1StringDedupBloomFilter* _bloom_filter;
+
   G1StringDedupEntry**            _buckets;
   size_t                          _size;
   uintx                           _entries;
@@ -130,6 +159,7 @@ private:
   static const uintx              _rehash_multiple;
   static const uintx              _rehash_threshold;
   static const double             _max_cache_factor;
+  static const size_t             _resize_step_buckets;
 
   // Table statistics, only used for logging.
   static uintx                    _entries_added;
@@ -156,7 +186,8 @@ private:
   // Removes the given table entry from the table.
   void remove(G1StringDedupEntry** pentry, uint worker_id);
 
-  // Transfers a table entry from the current table to the destination table.
+  // Transfers a table entry from the current table to the destination table,
+  // rehashing it if the destination table uses a different hash seed.
   void transfer(G1StringDedupEntry** pentry, G1StringDedupTable* dest);
 
   // Returns an existing character array in the given hash bucket, or NULL
@@ -168,14 +199,14 @@ private:
   // table entry if no matching character array exists.
   typeArrayOop lookup_or_add_inner(typeArrayOop value, unsigned int hash);
 
-  // Thread safe lookup or add of table entry
-  static typeArrayOop lookup_or_add(typeArrayOop value, unsigned int hash) {
-    // Protect the table from concurrent access. Also note that this lock
-    // acts as a fence for _table, which could have been replaced by a new
-    // instance if the table was resized or rehashed.
-    MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
-    return _table->lookup_or_add_inner(value, hash);
-  }
+  // Thread safe hashing and lookup or add of table entry. The hash code is
+  // computed under the lock since the table, and with it the hash function,
+  // can be replaced concurrently. If use_bloom_filter is true and the hash
+  // has not been seen before, the hash is only recorded in the Bloom filter,
+  // the table is left untouched and filtered is set.
+  static typeArrayOop lookup_or_add(oop java_string, typeArrayOop value,
+                                    G1StringDedupStat& stat,
+                                    bool use_bloom_filter, bool& filtered);
 
   // Returns true if the hashtable is currently using a Java compatible
   // hash function.
@@ -185,38 +216,50 @@ private:
 
   static bool equals(typeArrayOop value1, typeArrayOop value2);
 
-  // Computes the hash code for the given character array, using the
-  // currently active hash function and hash seed.
-  static unsigned int hash_code(typeArrayOop value);
+  // Computes the hash code for the given character array, using the hash
+  // function and hash seed of a table. A zero hash seed selects the Java
+  // compatible hash function.
+  static unsigned int hash_code(typeArrayOop value, uint64_t hash_seed);
+
+  // If a table resize is needed, returns a newly allocated empty
+  // hashtable of the proper size.
+  static G1StringDedupTable* prepare_resize();
+
+  // If a table rehash is needed, returns a newly allocated empty
+  // hashtable with a new hash seed.
+  static G1StringDedupTable* prepare_rehash();
+
+  // Installs the fully populated resized table as the currently active
+  // table and deletes the previously active table.
+  static void finish_resize_or_rehash();
 
   static uintx unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                 G1StringDedupTable* table,
                                  size_t partition_begin,
                                  size_t partition_end,
                                  uint worker_id);
 
+  static void verify(G1StringDedupTable* table, size_t bucket_begin);
+
 public:
   static void create();
 
   // Deduplicates the given String object, or adds its backing
-  // character array to the deduplication hashtable.
-  static void deduplicate(oop java_string, G1StringDedupStat& stat);
-
-  // If a table resize is needed, returns a newly allocated empty
-  // hashtable of the proper size.
-  static G1StringDedupTable* prepare_resize();
-
-  // Installs a newly resized table as the currently active table
-  // and deletes the previously active table.
-  static void finish_resize(G1StringDedupTable* resized_table);
-
-  // If a table rehash is needed, returns a newly allocated empty
-  // hashtable and updates the hash seed.
-  static G1StringDedupTable* prepare_rehash();
-
-  // Transfers rehashed entries from the currently active table into
-  // the new table. Installs the new table as the currently active table
-  // and deletes the previously active table.
-  static void finish_rehash(G1StringDedupTable* rehashed_table);
+  // character array to the deduplication hashtable. With use_bloom_filter
+  // a character array is only added once its hash has been seen before.
+  static void deduplicate(oop java_string, G1StringDedupStat& stat,
+                          bool use_bloom_filter = false);
+
+  // Starts a resize or rehash of the table if one is needed. Returns true
+  // if the deduplication thread should call resize_or_rehash_step() until
+  // it returns true. Called by the deduplication thread only.
+  static bool start_resize_or_rehash();
+
+  // Transfers a bounded number of buckets into the resized table. Returns
+  // true when all buckets have been transferred and the resized table has
+  // been installed. Called by the deduplication thread only, which may
+  // yield to safepoints in between steps.
+  static bool resize_or_rehash_step();
 
   // If the table entry cache has grown too large, delete overflowed entries.
   static void clean_entry_cache();
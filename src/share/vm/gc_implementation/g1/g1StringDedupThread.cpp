@@ -31,8 +31,13 @@
 
 G1StringDedupThread* G1StringDedupThread::_thread = NULL;
 
+const uintx G1StringDedupThread::_max_sampling_interval = 64;
+const uintx G1StringDedupThread::_min_sampling_looked_up = 1000; // Don't adapt to small batches
+
 G1StringDedupThread::G1StringDedupThread() :
-  ConcurrentGCThread() {
+  ConcurrentGCThread(),
+  _sampling_interval(1),
+  _sampling_count(0) {
   set_name("String Deduplication Thread");
   create_and_start();
 }
@@ -59,6 +64,39 @@ void G1StringDedupThread::print_on(outputStream* st) const {
   st->cr();
 }
 
+bool G1StringDedupThread::should_sample() {
+  if (_sampling_interval == 1) {
+    return true;
+  }
+  _sampling_count++;
+  if (_sampling_count < _sampling_interval) {
+    return false;
+  }
+  _sampling_count = 0;
+  return true;
+}
+
+void G1StringDedupThread::update_sampling_interval(const G1StringDedupStat& last_stat) {
+  if (StringDeduplicationMinHitPercent == 0 ||
+      last_stat.looked_up() < _min_sampling_looked_up) {
+    return;
+  }
+
+  double hit_percent = last_stat.deduped_percent_of_looked_up();
+  if (hit_percent < (double)StringDeduplicationMinHitPercent) {
+    // Mostly unique strings, back off
+    _sampling_interval = MIN2(_sampling_interval * 2, _max_sampling_interval);
+  } else {
+    _sampling_interval = MAX2(_sampling_interval / 2, (uintx)1);
+  }
+
+  if (PrintStringDeduplicationStatistics) {
+    gclog_or_tty->print_cr("[GC concurrent-string-deduplication, hit ratio " G1_STRDEDUP_PERCENT_FORMAT_NS
+                           ", sampling interval " UINTX_FORMAT "]",
+                           hit_percent, _sampling_interval);
+  }
+}
+
 void G1StringDedupThread::run() {
   G1StringDedupStat total_stat;
 
@@ -90,7 +128,11 @@ void G1StringDedupThread::run() {
           break;
         }
 
-        G1StringDedupTable::deduplicate(java_string, stat);
+        if (should_sample()) {
+          G1StringDedupTable::deduplicate(java_string, stat, StringDeduplicationBloomFilter);
+        } else {
+          stat.inc_unsampled();
+        }
 
         // Safepoint this thread if needed
         if (sts.should_yield()) {
@@ -100,11 +142,23 @@ void G1StringDedupThread::run() {
         }
       }
 
+      // Resize or rehash the table in steps, outside of any GC pause
+      if (G1StringDedupTable::start_resize_or_rehash()) {
+        while (!G1StringDedupTable::resize_or_rehash_step()) {
+          if (sts.should_yield()) {
+            stat.mark_block();
+            sts.yield();
+            stat.mark_unblock();
+          }
+        }
+      }
+
       stat.mark_done();
 
       // Print statistics
       total_stat.add(stat);
       print(gclog_or_tty, stat, total_stat);
+      update_sampling_interval(stat);
     }
 
     G1StringDedupTable::clean_entry_cache();
@@ -36,13 +36,31 @@
 // concurrently with the Java application but participates in safepoints to allow
 // the GC to adjust and unlink oops from the deduplication queue and table.
 //
+// With StringDeduplicationMinHitPercent the thread only deduplicates every
+// n-th candidate while few of the candidates turn out to be duplicates. The
+// sampling interval n doubles after each batch with a hit ratio below the
+// limit, and halves again once the hit ratio recovers.
+//
 class G1StringDedupThread: public ConcurrentGCThread {
 private:
   static G1StringDedupThread* _thread;
 
+  // Constants governing the adaptive sampling.
+  static const uintx _max_sampling_interval;
+  static const uintx _min_sampling_looked_up;
+
+  uintx _sampling_interval;
+  uintx _sampling_count;
+
   G1StringDedupThread();
   ~G1StringDedupThread();
 
+  // Returns true if the next candidate should be deduplicated.
+  bool should_sample();
+
+  // Adjusts the sampling interval to the hit ratio of the last batch.
+  void update_sampling_interval(const G1StringDedupStat& last_stat);
+
   void print(outputStream* st, const G1StringDedupStat& last_stat, const G1StringDedupStat& total_stat);
 
 public:
@@ -28,14 +28,19 @@
 #include "memory/iterator.hpp"
 #include "gc_implementation/g1/g1TenantAllocationContext.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
 
 //----------------------- G1TenantAllocationContext ---------------------------
 
 G1TenantAllocationContext::G1TenantAllocationContext(G1CollectedHeap* g1h)
         : _g1h(g1h),
           _occupied_heap_region_count(0),
+          _used_bytes(0),
+          _live_bytes(0),
+          _allocated_since_mark(0),
           _heap_size_limit(TENANT_HEAP_NO_LIMIT),
           _heap_region_limit(0),
+          _heap_size_target(TENANT_HEAP_NO_LIMIT),
           _tenant_container(NULL),
           _retained_old_gc_alloc_region(NULL) {
 
@@ -150,6 +155,12 @@ bool G1TenantAllocationContext::can_allocate(size_t attempt_word_size) {
     return true;
   }
 
+  if (TenantHeapByteAccounting) {
+    // The mutator alloc region may still fill up beyond the limit, so a
+    // tenant can exceed its limit by at most one region.
+    return used_bytes() + attempt_word_size * HeapWordSize <= heap_size_limit();
+  }
+
   size_t occupied_regions = occupied_heap_region_count();
   if (_g1h->isHumongous(attempt_word_size)) {
     // reach here only from G1CollectedHeap::humongous_obj_allocate
@@ -175,6 +186,36 @@ void G1TenantAllocationContext::dec_occupied_heap_region_count() {
   assert(occupied_heap_region_count() >= 0, "post-condition");
 }
 
+void G1TenantAllocationContext::increase_used(size_t bytes) {
+  assert(TenantHeapIsolation, "pre-condition");
+  assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
+  Atomic::add_ptr(bytes, &_used_bytes);
+  Atomic::add_ptr(bytes, &_allocated_since_mark);
+}
+
+size_t G1TenantAllocationContext::used_bytes() {
+  assert(TenantHeapIsolation, "pre-condition");
+  size_t result = _used_bytes;
+  HeapRegion* hr = _mutator_alloc_region.get();
+  if (hr != NULL) {
+    result += hr->used();
+  }
+  return result;
+}
+
+size_t G1TenantAllocationContext::occupied_bytes() {
+  assert(TenantHeapIsolation, "pre-condition");
+  if (TenantHeapByteAccounting) {
+    return used_bytes();
+  }
+  return occupied_heap_region_count() * HeapRegion::GrainBytes;
+}
+
+size_t G1TenantAllocationContext::live_bytes_estimate() {
+  assert(TenantHeapIsolation, "pre-condition");
+  return MIN2(_live_bytes + _allocated_since_mark, used_bytes());
+}
+
 G1TenantAllocationContext* G1TenantAllocationContext::current() {
   assert(TenantHeapIsolation, "pre-condition");
 
@@ -191,6 +232,48 @@ void G1TenantAllocationContext::set_heap_size_limit(size_t new_size) {
   _heap_region_limit = heap_bytes_to_region_num(_heap_size_limit);
 }
 
+void G1TenantAllocationContext::set_heap_size_target(size_t new_size) {
+  assert(TenantHeapThrottling, "pre-condition");
+  assert(new_size != TENANT_HEAP_NO_LIMIT, "sanity");
+  assert_heap_locked_or_at_safepoint(true /* should_be_vm_thread */);
+
+  if (new_size >= heap_size_limit() ||
+      new_size >= occupied_bytes() + HeapRegion::GrainBytes) {
+    set_heap_size_limit(new_size);
+    _heap_size_target = TENANT_HEAP_NO_LIMIT;
+  } else {
+    // wait for GCs to free up the memory above the new limit
+    _heap_size_target = new_size;
+  }
+}
+
+bool G1TenantAllocationContext::step_heap_size_limit() {
+  assert(TenantHeapThrottling, "pre-condition");
+  assert_at_safepoint(true /* in vm thread */);
+
+  if (_heap_size_target == TENANT_HEAP_NO_LIMIT) {
+    return false;
+  }
+
+  size_t occupied = occupied_bytes();
+  if (occupied + HeapRegion::GrainBytes <= _heap_size_target) {
+    set_heap_size_limit(_heap_size_target);
+    _heap_size_target = TENANT_HEAP_NO_LIMIT;
+    return true;
+  }
+
+  // give up half of the headroom above the usage in each step
+  size_t limit = heap_size_limit();
+  size_t headroom = limit > occupied ? (limit - occupied) / 2 : 0;
+  size_t new_limit = occupied + MAX2(headroom, (size_t)HeapRegion::GrainBytes);
+  assert(new_limit > _heap_size_target, "sanity");
+  if (new_limit >= limit) {
+    return false;
+  }
+  set_heap_size_limit(new_limit);
+  return true;
+}
+
 size_t G1TenantAllocationContext::heap_bytes_to_region_num(size_t size_in_bytes) {
   return heap_words_to_region_num(size_in_bytes >> LogBytesPerWord);
 }
@@ -205,6 +288,8 @@ G1TenantAllocationContexts::G1TenantACList* G1TenantAllocationContexts::_context
 
 Mutex* G1TenantAllocationContexts::_list_lock = NULL;
 
+G1TenantGCStats G1TenantAllocationContexts::_root_gc_stats;
+
 void G1TenantAllocationContexts::add(G1TenantAllocationContext* tac) {
   assert(TenantHeapIsolation, "pre-condition");
   if (NULL != tac) {
@@ -311,6 +396,66 @@ size_t G1TenantAllocationContexts::total_used() {
   return res;
 }
 
+uint G1TenantAllocationContexts::step_heap_size_limits() {
+  assert(TenantHeapThrottling, "pre-condition");
+  assert_at_safepoint(true /* in vm thread */);
+
+  // no locking needed
+  uint stepped = 0;
+  for (G1TenantACListIterator itr = _contexts->begin();
+       itr != _contexts->end(); ++itr) {
+    assert(NULL != (*itr), "pre-condition");
+    if ((*itr)->step_heap_size_limit()) {
+      stepped++;
+    }
+  }
+  return stepped;
+}
+
+class RecalculateTenantUsedClosure : public HeapRegionClosure {
+private:
+  bool _after_marking;
+public:
+  RecalculateTenantUsedClosure(bool after_marking) : _after_marking(after_marking) { }
+
+  virtual bool doHeapRegion(HeapRegion* hr) {
+    // the starts humongous region accounts for the whole humongous object
+    if (hr->continuesHumongous() || hr->allocation_context().is_system()) {
+      return false;
+    }
+    G1TenantAllocationContext* tac = hr->allocation_context().tenant_allocation_context();
+    if (hr == tac->_mutator_alloc_region.get()) {
+      // still being allocated into, see used_bytes()
+      return false;
+    }
+    tac->_used_bytes += hr->used();
+    if (_after_marking) {
+      tac->_live_bytes += hr->live_bytes();
+    }
+    return false;
+  }
+};
+
+void G1TenantAllocationContexts::recalculate_used(bool after_marking) {
+  assert(TenantHeapIsolation, "pre-condition");
+  assert_at_safepoint(true /* in vm thread */);
+
+  // no locking needed
+  for (G1TenantACListIterator itr = _contexts->begin();
+       itr != _contexts->end(); ++itr) {
+    G1TenantAllocationContext* tac = (*itr);
+    assert(NULL != tac, "pre-condition");
+    tac->_used_bytes = 0;
+    if (after_marking) {
+      tac->_live_bytes = 0;
+      tac->_allocated_since_mark = 0;
+    }
+  }
+
+  RecalculateTenantUsedClosure cl(after_marking);
+  G1CollectedHeap::heap()->heap_region_iterate(&cl);
+}
+
 void G1TenantAllocationContexts::init_gc_alloc_regions(G1Allocator* allocator, EvacuationInfo& ei) {
   assert(TenantHeapIsolation, "pre-condition");
   assert_at_safepoint(true /* in vm thread */);
@@ -374,3 +519,48 @@ G1TenantAllocationContext* G1TenantAllocationContexts::system_context() {
   assert(TenantHeapIsolation, "pre-condition");
   return AllocationContext::system().tenant_allocation_context();
 }
+
+G1TenantGCStats* G1TenantAllocationContexts::gc_stats_of(AllocationContext_t context) {
+  assert(TenantHeapIsolation, "pre-condition");
+  return context.is_system() ? &_root_gc_stats : context->gc_stats();
+}
+
+void G1TenantAllocationContexts::record_pause_share(G1TenantGCStats* stats, jlong tenant_id,
+                                                    double pause_time_ms, size_t total_bytes,
+                                                    G1NewTracer* tracer) {
+  size_t bytes = stats->_pause_copied_bytes;
+  size_t objects = stats->_pause_copied_objects;
+  if (bytes == 0) {
+    return;
+  }
+  double share_ms = pause_time_ms * bytes / total_bytes;
+  stats->_copied_bytes += bytes;
+  stats->_copied_objects += objects;
+  stats->_pause_time_ms += share_ms;
+  stats->_pause_copied_bytes = 0;
+  stats->_pause_copied_objects = 0;
+  tracer->report_tenant_evacuation_statistics(tenant_id, bytes, objects, share_ms);
+}
+
+void G1TenantAllocationContexts::record_pause(double pause_time_ms, G1NewTracer* tracer) {
+  assert(TenantHeapIsolation, "pre-condition");
+  assert_at_safepoint(true /* in vm thread */);
+
+  // no locking needed
+  size_t total_bytes = _root_gc_stats._pause_copied_bytes;
+  for (G1TenantACListIterator itr = _contexts->begin();
+       itr != _contexts->end(); ++itr) {
+    total_bytes += (*itr)->_gc_stats._pause_copied_bytes;
+  }
+  if (total_bytes == 0) {
+    return;
+  }
+
+  record_pause_share(&_root_gc_stats, 0, pause_time_ms, total_bytes, tracer);
+  for (G1TenantACListIterator itr = _contexts->begin();
+       itr != _contexts->end(); ++itr) {
+    G1TenantAllocationContext* tac = (*itr);
+    jlong tenant_id = com_alibaba_tenant_TenantContainer::get_tenant_id(tac->tenant_container());
+    record_pause_share(&tac->_gc_stats, tenant_id, pause_time_ms, total_bytes, tracer);
+  }
+}
@@ -32,6 +32,7 @@
 #include "runtime/handles.hpp"
 #include "runtime/vm_operations.hpp"
 
+class G1NewTracer;
 class OopClosure;
 class G1TenantAllocationContext;
 class G1TenantAllocationContexts;
@@ -44,6 +45,33 @@ public:
   virtual void do_tenant_allocation_context(G1TenantAllocationContext*) = 0;
 };
 
+/*
+ * GC cost attributed to one tenant: the bytes and objects evacuated from its
+ * regions, and the share of the evacuation pauses in proportion to them.
+ */
+class G1TenantGCStats VALUE_OBJ_CLASS_SPEC {
+  friend class G1TenantAllocationContexts;
+private:
+  volatile size_t                   _pause_copied_bytes;            // in the current pause
+  volatile size_t                   _pause_copied_objects;          // in the current pause
+  size_t                            _copied_bytes;                  // in all pauses
+  size_t                            _copied_objects;                // in all pauses
+  double                            _pause_time_ms;                 // share of all pauses
+
+public:
+  G1TenantGCStats() : _pause_copied_bytes(0), _pause_copied_objects(0),
+                      _copied_bytes(0), _copied_objects(0), _pause_time_ms(0.0) { }
+
+  void record_copy(size_t bytes, size_t objects) {
+    Atomic::add_ptr(bytes, &_pause_copied_bytes);
+    Atomic::add_ptr(objects, &_pause_copied_objects);
+  }
+
+  size_t copied_bytes() const                         { return _copied_bytes;                 }
+  size_t copied_objects() const                       { return _copied_objects;               }
+  double pause_time_ms() const                        { return _pause_time_ms;                }
+};
+
 // By default, no limit on newly created G1TenantAllocationContext
 #define TENANT_HEAP_NO_LIMIT  0
 
@@ -57,6 +85,7 @@ public:
 class G1TenantAllocationContext : public CHeapObj<mtTenant> {
   friend class VMStructs;
   friend class G1TenantAllocationContexts;
+  friend class RecalculateTenantUsedClosure;
 private:
   G1CollectedHeap*                  _g1h;                           // The only g1 heap instance
 
@@ -70,6 +99,12 @@ private:
   size_t                            _heap_size_limit;               // user-defined max heap space for this tenant, in bytes
   size_t                            _heap_region_limit;             // user-defined max heap space for this tenant, in heap regions
   size_t                            _occupied_heap_region_count;    // number of regions occupied by this tenant
+  size_t                            _heap_size_target;              // limit being shrunk to at GCs, in bytes, or TENANT_HEAP_NO_LIMIT
+
+  // Byte accurate usage, see used_bytes() and live_bytes_estimate()
+  volatile size_t                   _used_bytes;                    // used bytes, excluding the mutator alloc region
+  size_t                            _live_bytes;                    // live bytes found by the last marking
+  volatile size_t                   _allocated_since_mark;          // bytes allocated since the last marking
 
   // Tenant alloc context list is now part of root set since each node
   // keeps a strong reference to TenantContainer object for containerOf() API
@@ -77,6 +112,8 @@ private:
 
   CachedCompactPoint                _ccp;                           // cached CompactPoint during full GC compaction
 
+  G1TenantGCStats                   _gc_stats;                      // GC cost attributed to this tenant
+
 public:
   // Newly allocated G1TenantAllocationContext will be put at the head of tenant alloc context list
   G1TenantAllocationContext(G1CollectedHeap* g1h);
@@ -96,6 +133,20 @@ public:
   size_t heap_size_limit() const                      { return _heap_size_limit;              }
   void set_heap_size_limit(size_t new_size);
 
+  // Elastic heap size limit. Growing the limit, or shrinking it while one
+  // region above the current usage still fits, takes effect at once.
+  // Otherwise the current limit is kept and lowered step by step after GCs,
+  // see step_heap_size_limit(). Must be called with Heap_lock held.
+  void set_heap_size_target(size_t new_size);
+  size_t heap_size_target() const {
+    return _heap_size_target == TENANT_HEAP_NO_LIMIT ? _heap_size_limit : _heap_size_target;
+  }
+
+  // Lower the limit towards the target after a GC, keeping at least one
+  // region above the usage so that the tenant is not pushed into a full GC.
+  // Returns true if the limit changed. Must be called at safepoint.
+  bool step_heap_size_limit();
+
   // get heap region limit, the size is calculated automatically
   size_t heap_region_limit() const                    { return _heap_region_limit;            }
 
@@ -103,6 +154,23 @@ public:
   void inc_occupied_heap_region_count();
   void dec_occupied_heap_region_count();
   size_t occupied_heap_region_count()                 { return _occupied_heap_region_count;   }
+
+  // Bytes used by this tenant. Mutator allocations are added when the
+  // mutator alloc region or a humongous object is allocated, and the
+  // value is recalculated from the regions after every GC pause. The
+  // bytes of the current mutator alloc region are included.
+  void increase_used(size_t bytes);
+  size_t used_bytes();
+
+  // Usage the heap size limit is checked against: used_bytes() with
+  // TenantHeapByteAccounting, the occupied regions otherwise.
+  size_t occupied_bytes();
+
+  // Estimate of the live bytes of this tenant: the live bytes found by
+  // the last concurrent marking plus what was allocated since, but no
+  // more than used_bytes().
+  size_t live_bytes_estimate();
+
   //
   // Check if next allocation request can be satisfied
   // Called only before trying to allocate new regions, including:
@@ -123,6 +191,8 @@ public:
   //
   bool can_allocate(size_t attempt_word_size);
 
+  G1TenantGCStats* gc_stats()                         { return &_gc_stats;                    }
+
   // record the compact dest
   const CachedCompactPoint& cached_compact_point() const { return _ccp;                       }
   void set_cached_compact_point(CompactPoint cp)      { _ccp = cp;                            }
@@ -151,6 +221,10 @@ private:
   //       dies.
   static G1TenantACList           *_contexts;     // Tenant contexts are organized into doubly-linked list
   static Mutex                    *_list_lock;
+  static G1TenantGCStats           _root_gc_stats; // GC cost attributed to the root tenant
+
+  static void record_pause_share(G1TenantGCStats* stats, jlong tenant_id, double pause_time_ms,
+                                 size_t total_bytes, G1NewTracer* tracer);
 
 public:
   static void add(G1TenantAllocationContext*);
@@ -176,12 +250,27 @@ public:
 
   static size_t total_used();
 
+  // Step the heap size limits of shrinking tenants after a GC, returns
+  // the number of tenants whose limit was lowered. Must be called at safepoint.
+  static uint step_heap_size_limits();
+
+  // Recalculate the used bytes of all tenants from their regions, and
+  // their live bytes too after marking. Must be called at safepoint.
+  static void recalculate_used(bool after_marking);
+
   static void init_gc_alloc_regions(G1Allocator* allocator, EvacuationInfo& ei);
   static void release_gc_alloc_regions(EvacuationInfo& ei);
 
   static void abandon_gc_alloc_regions();
 
   static G1TenantAllocationContext* system_context();
+
+  // GC cost attributed to the tenant of the given context
+  static G1TenantGCStats* gc_stats_of(AllocationContext_t context);
+
+  // Share the time of an evacuation pause among the tenants in proportion
+  // to the bytes evacuated from their regions, and report it.
+  static void record_pause(double pause_time_ms, G1NewTracer* tracer);
 };
 
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_TENANT_CONTEXT_HPP
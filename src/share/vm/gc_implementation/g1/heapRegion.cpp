@@ -36,6 +36,7 @@
 #include "memory/iterator.hpp"
 #include "memory/space.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "gc_implementation/g1/heapRegionTracer.hpp"
 
@@ -126,6 +127,22 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
     region_size = HeapRegionBounds::max_size();
   }
 
+  if (G1TransparentHugePageCommit) {
+    size_t thp_size = os::transparent_huge_page_size();
+    if (UseLargePages) {
+      warning("G1TransparentHugePageCommit is ignored with UseLargePages");
+      FLAG_SET_DEFAULT(G1TransparentHugePageCommit, false);
+    } else if (thp_size == 0 || thp_size > HeapRegionBounds::max_size()) {
+      warning("G1TransparentHugePageCommit is disabled: transparent huge pages "
+              "are not available or larger than the maximum region size");
+      FLAG_SET_DEFAULT(G1TransparentHugePageCommit, false);
+    } else {
+      // Every region must span whole huge pages so that regions are
+      // committed and uncommitted without splitting a huge page.
+      region_size = MAX2(region_size, (uintx)thp_size);
+    }
+  }
+
   // And recalculate the log.
   region_size_log = log2_long((jlong) region_size);
 
@@ -155,6 +172,82 @@ void HeapRegion::reset_after_compaction() {
   // treat all objects as being inside the unmarked area.
   zero_marked_bytes();
   init_top_at_mark_start();
+  reset_allocation_samples();
+}
+
+void HeapRegion::record_allocation_sample(Klass* k) {
+  _allocation_samples++;
+  if (_sampled_klass == k) {
+    _sampled_klass_votes++;
+  } else if (_sampled_klass_votes == 0) {
+    _sampled_klass = k;
+    _sampled_klass_votes = 1;
+  } else {
+    _sampled_klass_votes--;
+  }
+}
+
+void HeapRegion::prepare_for_compaction_in_place() {
+  assert(!isHumongous(), "humongous objects never move");
+  HeapWord* dead_start = NULL;
+  HeapWord* p = bottom();
+  while (p < top()) {
+    oop obj = oop(p);
+    size_t size = obj->size();
+    if (obj->is_gc_marked()) {
+      if (dead_start != NULL) {
+        CollectedHeap::fill_with_objects(dead_start, pointer_delta(p, dead_start));
+        dead_start = NULL;
+      }
+      obj->forward_to(obj);
+    } else if (dead_start == NULL) {
+      dead_start = p;
+    }
+    p += size;
+  }
+  if (dead_start != NULL) {
+    CollectedHeap::fill_with_objects(dead_start, pointer_delta(top(), dead_start));
+  }
+  set_compaction_top(top());
+
+  // The filler objects cover the block starts of the dead objects, so
+  // record the new blocks in the block offset table.
+  HeapWord* threshold = initialize_threshold();
+  p = bottom();
+  while (p < top()) {
+    HeapWord* next = p + oop(p)->size();
+    if (next > threshold) {
+      threshold = cross_threshold(p, next);
+    }
+    p = next;
+  }
+}
+
+void HeapRegion::adjust_pointers_in_place() {
+  HeapWord* p = bottom();
+  while (p < top()) {
+    oop obj = oop(p);
+    size_t size = obj->size();
+    if (obj->is_gc_marked()) {
+      obj->adjust_pointers();
+    }
+    p += size;
+  }
+}
+
+void HeapRegion::compact_in_place() {
+  HeapWord* p = bottom();
+  while (p < top()) {
+    oop obj = oop(p);
+    if (obj->is_gc_marked()) {
+      obj->init_mark();
+    }
+    p += obj->size();
+  }
+  // The mark bitmap is invalid after a full GC, as for compacted regions.
+  zero_marked_bytes();
+  init_top_at_mark_start();
+  reset_allocation_samples();
 }
 
 void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
@@ -170,6 +263,7 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
   uninstall_surv_rate_group();
   set_free();
   reset_pre_dummy_top();
+  reset_allocation_samples();
 
   if (!par) {
     // If this is parallel, this will be done later.
@@ -185,6 +279,7 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
 
   _offsets.resize(HeapRegion::GrainWords);
   init_top_at_mark_start();
+  _top_at_rebuild_start = NULL;
   if (clear_space) clear(SpaceDecorator::Mangle);
 }
 
@@ -237,6 +332,15 @@ void HeapRegion::set_old() {
   _type.set_old();
 }
 
+void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count);
+}
+
+void HeapRegion::decrement_pinned_object_count() {
+  assert(is_pinned(), "unbalanced unpin");
+  Atomic::dec(&_pinned_object_count);
+}
+
 void HeapRegion::set_startsHumongous(HeapWord* new_top, HeapWord* new_end) {
   assert(!isHumongous(), "sanity / pre-condition");
   assert(end() == _orig_end,
@@ -304,15 +408,18 @@ HeapRegion::HeapRegion(uint hrm_index,
     _in_collection_set(false),
     _next_in_special_set(NULL), _orig_end(NULL),
     _claimed(InitialClaimValue), _evacuation_failed(false),
+    _pinned_object_count(0),
     _prev_marked_bytes(0), _next_marked_bytes(0), _gc_efficiency(0.0),
     _next_young_region(NULL),
-    _next_dirty_cards_region(NULL), _next(NULL), _prev(NULL),
+    _next_dirty_cards_region(NULL), _next_compaction_region(NULL),
+    _next(NULL), _prev(NULL),
 #ifdef ASSERT
     _containing_set(NULL),
 #endif // ASSERT
      _young_index_in_cset(-1), _surv_rate_group(NULL), _age_index(-1),
     _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
-    _predicted_bytes_to_copy(0)
+    _predicted_bytes_to_copy(0),
+    _sampled_klass(NULL), _sampled_klass_votes(0), _allocation_samples(0)
 {
   _rem_set = new HeapRegionRemSet(sharedOffsetArray, this);
   assert(HeapRegionRemSet::num_par_rem_sets() > 0, "Invariant.");
@@ -340,6 +447,10 @@ void HeapRegion::report_region_type_change(G1HeapRegionTraceType::Type to) {
 }
 
 CompactibleSpace* HeapRegion::next_compaction_space() const {
+  if (_next_compaction_region != NULL) {
+    // chained by a parallel full GC worker, already per allocation context
+    return _next_compaction_region;
+  }
   if (TenantHeapIsolation) {
     assert_at_safepoint(true /* in vm thread */);
 
@@ -474,6 +585,7 @@ bool HeapRegion::oops_on_card_seq_iterate_careful(MemRegion mr,
                                                   jbyte* card_ptr) {
   assert(card_ptr != NULL, "pre-condition");
   G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  HeapWord* const cards_start = mr.start();
 
   // If we're within a stop-world GC, then we might look at a card in a
   // GC alloc region that extends onto a GC LAB, which may not be
@@ -498,8 +610,15 @@ bool HeapRegion::oops_on_card_seq_iterate_careful(MemRegion mr,
   }
 
   // We can only clean the card here, after we make the decision that
-  // the card is not young.
-  *card_ptr = CardTableModRefBS::clean_card_val();
+  // the card is not young. With batched refinement mr may span several
+  // cards; clean those that overlap the allocated part of the region.
+  jbyte* const first_card = card_ptr +
+    pointer_delta(mr.start(), cards_start) / CardTableModRefBS::card_size_in_words;
+  jbyte* const last_card = card_ptr +
+    pointer_delta(mr.last(), cards_start) / CardTableModRefBS::card_size_in_words;
+  for (jbyte* c = first_card; c <= last_card; c++) {
+    *c = CardTableModRefBS::clean_card_val();
+  }
   // We must complete this write before we do any of the reads below.
   OrderAccess::storeload();
 
@@ -864,6 +983,7 @@ public:
         const jbyte dirty = CardTableModRefBS::dirty_card_val();
 
         bool is_bad = !(from->is_young()
+                        || !to->rem_set()->is_complete()
                         || to->rem_set()->contains_reference(p)
                         || !G1HRRSFlushLogBuffersOnVerify && // buffers were not flushed
                             (_containing_obj->is_objArray() ?
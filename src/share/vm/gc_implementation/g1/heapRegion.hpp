@@ -233,6 +233,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of objects in the region currently accessed by JNI critical
+  // sections, only maintained with G1UseRegionPinning.
+  volatile jint _pinned_object_count;
+
   // A heap region may be a member one of a number of special subsets, each
   // represented as linked lists through the field below.  Currently, there
   // is only one set:
@@ -245,6 +249,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // Next region whose cards need cleaning
   HeapRegion* _next_dirty_cards_region;
 
+  // Next region the same parallel full GC worker compacts into, or NULL
+  // when regions are compacted in heap order.
+  HeapRegion* _next_compaction_region;
+
   // Fields used by the HeapRegionSetBase class and subclasses.
   HeapRegion* _next;
   HeapRegion* _prev;
@@ -275,6 +283,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // "next" is the top at the start of the in-progress marking (if any.)
   HeapWord* _prev_top_at_mark_start;
   HeapWord* _next_top_at_mark_start;
+  // The top of the region when the concurrent remembered set rebuild
+  // started, or NULL if the region does not need to be scanned by it.
+  HeapWord* _top_at_rebuild_start;
   // If a collection pause is in progress, this is the top at the start
   // of that pause.
 
@@ -301,6 +312,12 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // the total value for the collection set.
   size_t _predicted_bytes_to_copy;
 
+  // Majority vote over the klasses of the objects sampled while being
+  // copied into the region, see G1RegionAllocationSampleInterval.
+  Klass* _sampled_klass;
+  uint   _sampled_klass_votes;
+  uint   _allocation_samples;
+
  public:
   HeapRegion(uint hrm_index,
              G1BlockOffsetSharedArray* sharedOffsetArray,
@@ -344,7 +361,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
     ParEvacFailureClaimValue   = 6,
     AggregateCountClaimValue   = 7,
     VerifyCountClaimValue      = 8,
-    ParMarkRootClaimValue      = 9
+    ParMarkRootClaimValue      = 9,
+    FullGCPrepareClaimValue    = 10,
+    FullGCAdjustClaimValue     = 11
   };
 
   // All allocated blocks are occupied by objects in a HeapRegion
@@ -577,6 +596,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
   HeapWord* prev_top_at_mark_start() const { return _prev_top_at_mark_start; }
   HeapWord* next_top_at_mark_start() const { return _next_top_at_mark_start; }
 
+  HeapWord* top_at_rebuild_start() const { return _top_at_rebuild_start; }
+  void set_top_at_rebuild_start(HeapWord* tars) { _top_at_rebuild_start = tars; }
+
   // Note the start or end of marking. This tells the heap region
   // that the collector is about to start or has finished (concurrently)
   // marking the heap.
@@ -621,6 +643,15 @@ class HeapRegion: public G1OffsetTableContigSpace {
     init_top_at_mark_start();
   }
 
+  // Full GC support for pinned regions, whose live objects stay in place.
+  // Forwards the live objects to themselves and replaces the dead ones
+  // with filler objects.
+  void prepare_for_compaction_in_place();
+  // Adjusts the references of the live objects.
+  void adjust_pointers_in_place();
+  // Reinitializes the mark words of the live objects.
+  void compact_in_place();
+
   void calc_gc_efficiency(void);
   double gc_efficiency() { return _gc_efficiency;}
 
@@ -702,6 +733,14 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // Returns the "evacuation_failed" property of the region.
   bool evacuation_failed() { return _evacuation_failed; }
 
+  // A pinned region must not have its objects moved: young collections
+  // keep them in place as if their evacuation failed, mixed collections
+  // leave the region out of the collection set and full collections do
+  // not compact it.
+  bool is_pinned() const { return _pinned_object_count > 0; }
+  void increment_pinned_object_count();
+  void decrement_pinned_object_count();
+
   // Sets the "evacuation_failed" property of the region.
   void set_evacuation_failed(bool b) {
     _evacuation_failed = b;
@@ -724,9 +763,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
 
   // Iterate over the card in the card designated by card_ptr,
   // applying cl to all references in the region.
-  // mr: the memory region covered by the card.
+  // mr: the memory region covered by the card, or by a run of adjacent
+  // cards starting with card_ptr.
   // card_ptr: if we decide that the card is not young and we iterate
-  // over it, we'll clean the card before we start the iteration.
+  // over it, we'll clean the card(s) before we start the iteration.
   // Returns true if the card was successfully processed, false if an
   // unparsable part of the heap was encountered, which should only
   // happen when invoked concurrently with the mutator.
@@ -750,8 +790,22 @@ class HeapRegion: public G1OffsetTableContigSpace {
     _predicted_bytes_to_copy = bytes;
   }
 
+  // The klass holding the majority among the sampled objects copied into
+  // the region, if any klass does, and the votes left for it.
+  Klass* sampled_klass() const       { return _sampled_klass; }
+  uint sampled_klass_votes() const   { return _sampled_klass_votes; }
+  uint allocation_samples() const    { return _allocation_samples; }
+  void record_allocation_sample(Klass* k);
+  void reset_allocation_samples() {
+    _sampled_klass = NULL;
+    _sampled_klass_votes = 0;
+    _allocation_samples = 0;
+  }
+
   virtual CompactibleSpace* next_compaction_space() const;
 
+  void set_next_compaction_region(HeapRegion* hr) { _next_compaction_region = hr; }
+
   virtual void reset_after_compaction();
 
   // Routines for managing a list of code roots (attached to the
@@ -798,6 +852,7 @@ class HeapRegion: public G1OffsetTableContigSpace {
 class HeapRegionClosure : public StackObj {
   friend class HeapRegionManager;
   friend class G1CollectedHeap;
+  friend class CollectionSetChooser;
 
   bool _complete;
   void incomplete() { _complete = false; }
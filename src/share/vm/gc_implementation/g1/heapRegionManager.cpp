@@ -23,12 +23,15 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_implementation/g1/g1FreeRangeIndex.hpp"
 #include "gc_implementation/g1/heapRegion.hpp"
 #include "gc_implementation/g1/heapRegionManager.inline.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/concurrentG1Refine.hpp"
 #include "memory/allocation.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/os.hpp"
 #include "gc_implementation/g1/elasticHeap.hpp"
 
@@ -55,6 +58,11 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
 
   _available_map.resize(_regions.length(), false);
   _available_map.clear();
+
+  if (UseG1FreeRangeIndex) {
+    _free_range_index = new G1FreeRangeIndex(max_length());
+    _free_list.set_range_index(_free_range_index);
+  }
 }
 
 bool HeapRegionManager::is_available(uint region) const {
@@ -140,6 +148,11 @@ void HeapRegionManager::uncommit_regions(uint start, size_t num_regions) {
   _num_committed -= (uint)num_regions;
 
   _available_map.par_clear_range(start, start + num_regions, BitMap::unknown_range);
+  if (_free_range_index != NULL) {
+    for (uint i = start; i < start + num_regions; i++) {
+      _free_range_index->set_available(i, false);
+    }
+  }
   _heap_mapper->uncommit_regions(start, num_regions);
 
   // Also uncommit auxiliary data
@@ -165,6 +178,11 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions) {
   }
 
   _available_map.par_set_range(start, start + num_regions, BitMap::unknown_range);
+  if (_free_range_index != NULL) {
+    for (uint i = start; i < start + num_regions; i++) {
+      _free_range_index->set_available(i, true);
+    }
+  }
 
   for (uint i = start; i < start + num_regions; i++) {
     assert(is_available(i), err_msg("Just made region %u available but is apparently not.", i));
@@ -235,6 +253,20 @@ uint HeapRegionManager::find_contiguous(size_t num, bool empty_only) {
   size_t length_found = 0;
   uint cur = 0;
 
+  if (_free_range_index != NULL) {
+    // Only regions on the free list are taken as empty. Uncommitted
+    // regions of the elastic heap are not candidates, as in the scan below.
+    G1FreeRangeIndex::Kind kind = (empty_only || G1ElasticHeap) ?
+                                  G1FreeRangeIndex::free_only :
+                                  G1FreeRangeIndex::free_or_unavailable;
+    found = num > max_length() ? G1_NO_HRM_INDEX :
+                                 _free_range_index->find_contiguous((uint)num, kind);
+    if (found != G1_NO_HRM_INDEX) {
+      length_found = num;
+    }
+    cur = max_length();
+  }
+
   while (length_found < num && cur < max_length()) {
     HeapRegion* hr = _regions.get_by_index(cur);
     if ((!empty_only && !is_available(cur) && !G1ElasticHeap) || (is_available(cur) && hr != NULL && hr->is_empty())) {
@@ -290,6 +322,23 @@ void HeapRegionManager::iterate(HeapRegionClosure* blk) const {
   }
 }
 
+void HeapRegionManager::par_iterate_claimed(HeapRegionClosure* blk, volatile jint* next_index) const {
+  uint len = max_length();
+
+  for (uint i = (uint) Atomic::add(1, next_index) - 1; i < len;
+       i = (uint) Atomic::add(1, next_index) - 1) {
+    if (!is_available(i)) {
+      continue;
+    }
+    guarantee(at(i) != NULL, err_msg("Tried to access region %u that has a NULL HeapRegion*", i));
+    bool res = blk->doHeapRegion(at(i));
+    if (res) {
+      blk->incomplete();
+      return;
+    }
+  }
+}
+
 uint HeapRegionManager::find_unavailable_from_idx(uint start_idx, uint* res_idx) const {
   guarantee(res_idx != NULL, "checking");
   guarantee(start_idx <= (max_length() + 1), "checking");
@@ -419,6 +468,9 @@ void HeapRegionManager::set_region_available(FreeRegionList* list) {
   while (iter.more_available()) {
     HeapRegion* hr = iter.get_next();
     _available_map.par_set_range(hr->hrm_index(), hr->hrm_index() + 1, BitMap::unknown_range);
+    if (_free_range_index != NULL) {
+      _free_range_index->set_available(hr->hrm_index(), true);
+    }
   }
   _num_committed += list->length();
 }
@@ -429,6 +481,9 @@ void HeapRegionManager::set_region_unavailable(FreeRegionList* list) {
   while (iter.more_available()) {
     HeapRegion* hr = iter.get_next();
     _available_map.par_clear_range(hr->hrm_index(), hr->hrm_index() + 1, BitMap::unknown_range);
+    if (_free_range_index != NULL) {
+      _free_range_index->set_available(hr->hrm_index(), false);
+    }
   }
   assert(_num_committed > list->length(), "sanity");
   _num_committed -= list->length();
@@ -463,32 +518,77 @@ void HeapRegionManager::move_to_free_list(FreeRegionList* list) {
   _free_list.add_ordered(list);
 }
 
-void HeapRegionManager::prepare_uncommit_regions(FreeRegionList* list, uint num) {
+uint HeapRegionManager::prepare_uncommit_regions(FreeRegionList* list, uint num, uint regions_per_chunk) {
   assert(G1ElasticHeap, "Precondition");
   assert(num <= _free_list.length(), "sanity");
   assert_at_safepoint(true /* should_be_vm_thread */);
   assert(list->is_empty(), "sanity");
+  assert(regions_per_chunk > 0 && is_power_of_2(regions_per_chunk), "sanity");
 
-  G1CollectedHeap* g1h = G1CollectedHeap::heap();
-  for (uint i = 0; i < num; i++) {
-    HeapRegion* hr = _free_list.remove_region(false /* from_head */);
-    list->add_ordered(hr);
+  if (regions_per_chunk == 1) {
+    for (uint i = 0; i < num; i++) {
+      HeapRegion* hr = _free_list.remove_region(false /* from_head */);
+      list->add_ordered(hr);
+    }
+  } else {
+    ResourceMark rm;
+    BitMap free_map(max_length(), true /* in_resource_area */);
+    free_map.clear();
+    FreeRegionListIterator iter(&_free_list);
+    while (iter.more_available()) {
+      free_map.set_bit(iter.get_next()->hrm_index());
+    }
+
+    // Search from the top of the heap like the regions taken from the tail
+    // of _free_list, only taking chunks whose regions are all free
+    BitMap take_map(max_length(), true /* in_resource_area */);
+    take_map.clear();
+    uint target = (uint)align_size_down(num, regions_per_chunk);
+    uint taken = 0;
+    uint chunk_end = (uint)align_size_down(max_length(), regions_per_chunk);
+    while (taken < target && chunk_end >= regions_per_chunk) {
+      uint chunk_start = chunk_end - regions_per_chunk;
+      if (free_map.get_next_zero_offset(chunk_start, chunk_end) == chunk_end) {
+        take_map.set_range(chunk_start, chunk_end);
+        taken += regions_per_chunk;
+      }
+      chunk_end = chunk_start;
+    }
+
+    FreeRegionList keep_list("Elastic Heap Keep List");
+    while (!_free_list.is_empty()) {
+      HeapRegion* hr = _free_list.remove_region(true /* from_head */);
+      if (take_map.at(hr->hrm_index())) {
+        list->add_ordered(hr);
+      } else {
+        keep_list.add_ordered(hr);
+      }
+    }
+    _free_list.add_ordered(&keep_list);
   }
-  set_region_unavailable(list);
+
+  if (!list->is_empty()) {
+    set_region_unavailable(list);
+  }
+  return list->length();
 }
 
-void HeapRegionManager::prepare_commit_regions(FreeRegionList* list, uint num) {
+uint HeapRegionManager::prepare_commit_regions(FreeRegionList* list, uint num, uint regions_per_chunk) {
   assert(G1ElasticHeap, "Precondition");
   assert(num <= _uncommitted_list.length(), "sanity");
   assert_at_safepoint(true /* should_be_vm_thread */);
   assert(list->is_empty(), "sanity");
+  assert(regions_per_chunk > 0 && is_power_of_2(regions_per_chunk), "sanity");
 
-  G1CollectedHeap* g1h = G1CollectedHeap::heap();
+  // Regions are uncommitted in whole chunks and _uncommitted_list is ordered,
+  // so taking whole chunks from the head keeps huge pages intact.
+  num = MIN2((uint)align_size_up(num, regions_per_chunk), _uncommitted_list.length());
   for (uint i = 0; i < num; i++) {
     HeapRegion* hr = _uncommitted_list.remove_region(true /* from_head */);
     assert(!is_available(hr->hrm_index()), "sanity");
     list->add_ordered(hr);
   }
+  return num;
 }
 
 void HeapRegionManager::prepare_old_region_list_to_free(FreeRegionList* to_free_list,
@@ -623,6 +723,19 @@ void HeapRegionManager::verify() {
   }
 
   guarantee(num_committed == _num_committed, err_msg("Found %u committed regions, but should be %u", num_committed, _num_committed));
+  if (_free_range_index != NULL) {
+    uint num_free = 0;
+    for (uint i = 0; i < max_length(); i++) {
+      guarantee(_free_range_index->is_available(i) == is_available(i),
+                err_msg("Free range index is out of date for region %u", i));
+      if (_free_range_index->is_free(i)) {
+        num_free++;
+      }
+    }
+    guarantee(num_free == _free_list.length(),
+              err_msg("Free range index has %u free regions, but the free list %u",
+                      num_free, _free_list.length()));
+  }
   _free_list.verify();
 }
 
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONMANAGER_HPP
 
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "gc_implementation/g1/heapRegionSet.hpp"
 #include "services/memoryUsage.hpp"
@@ -33,6 +34,7 @@
 class HeapRegion;
 class HeapRegionClosure;
 class FreeRegionList;
+class G1FreeRangeIndex;
 
 class G1HeapRegionTable : public G1BiasedMappedArray<HeapRegion*> {
  protected:
@@ -79,6 +81,11 @@ class HeapRegionManager: public CHeapObj<mtGC> {
 
   FreeRegionList _free_list;
 
+  // Runs of free and of uncommitted regions for find_contiguous(), kept
+  // up to date by _free_list and the changes of _available_map.
+  // NULL unless UseG1FreeRangeIndex is set.
+  G1FreeRangeIndex* _free_range_index;
+
   FreeRegionList _uncommitted_list;
   // Each bit in this bitmap indicates that the corresponding region is available
   // for allocation.
@@ -133,6 +140,7 @@ public:
                     _next_bitmap_mapper(NULL), _prev_bitmap_mapper(NULL), _bot_mapper(NULL),
                     _allocated_heapregions_length(0), _available_map(),
                     _free_list("Free list", new MasterFreeRegionListMtSafeChecker()),
+                    _free_range_index(NULL),
                     _uncommitted_list("Free list of uncommitted regions", new MasterFreeRegionListMtSafeChecker())
   { }
 
@@ -165,8 +173,17 @@ public:
     _free_list.add_ordered(list);
   }
 
-  HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
+  // Old regions are taken from the head of the free list, others from
+  // the tail. If node_index names a NUMA node, a free region whose memory
+  // is bound to that node is preferred.
+  HeapRegion* allocate_free_region(bool is_old, uint node_index = G1NUMA::AnyNodeIndex) {
+    HeapRegion* hr = NULL;
+    if (node_index != G1NUMA::AnyNodeIndex && G1NUMA::numa()->is_enabled()) {
+      hr = _free_list.remove_region_with_node_index(is_old, node_index);
+    }
+    if (hr == NULL) {
+      hr = _free_list.remove_region(is_old);
+    }
 
     if (hr != NULL) {
       assert(hr->next() == NULL, "Single region should not have next");
@@ -230,6 +247,12 @@ public:
 
   void par_iterate(HeapRegionClosure* blk, uint worker_id, uint no_of_par_workers, jint claim_value) const;
 
+  // Apply blk->doHeapRegion() on the committed regions claimed one at a
+  // time through "next_index", which all participating threads share and
+  // which starts at 0. Unlike par_iterate() this leaves the claim values
+  // of the regions alone.
+  void par_iterate_claimed(HeapRegionClosure* blk, volatile jint* next_index) const;
+
   // Uncommit up to num_regions_to_remove regions that are completely free.
   // Return the actual number of uncommitted regions.
   uint shrink_by(uint num_regions_to_remove);
@@ -244,10 +267,15 @@ public:
   // Move regions back into free list
   void move_to_free_list(FreeRegionList* list);
 
-  // Remove regions from free list for uncommitment
-  void prepare_uncommit_regions(FreeRegionList* list, uint num);
-  // Remove regions from uncommitted list for commitment
-  void prepare_commit_regions(FreeRegionList* list, uint num);
+  // Remove regions from free list for uncommitment.
+  // With regions_per_chunk > 1 only aligned chunks of regions that are entirely
+  // free are taken, so the memory backing a huge page is released as a whole.
+  // Return the actual number of regions moved into list.
+  uint prepare_uncommit_regions(FreeRegionList* list, uint num, uint regions_per_chunk = 1);
+  // Remove regions from uncommitted list for commitment.
+  // num is rounded up to whole chunks of regions_per_chunk regions if possible.
+  // Return the actual number of regions moved into list.
+  uint prepare_commit_regions(FreeRegionList* list, uint num, uint regions_per_chunk = 1);
   // Remove old regions to free
   void prepare_old_region_list_to_free(FreeRegionList* to_free_list,
                                        uint reserve_regions,
@@ -858,14 +858,22 @@ OtherRegionsTable::do_cleanup_work(HRRSCleanupTask* hrrs_cleanup_task) {
 // This can be done by either mutator threads together with the
 // concurrent refinement threads or GC threads.
 uint HeapRegionRemSet::num_par_rem_sets() {
-  return MAX2(DirtyCardQueueSet::num_par_ids() + ConcurrentG1Refine::thread_num(), (uint)ParallelGCThreads);
+  return MAX2(rebuild_par_id_base() + (G1RebuildRemSetsConcurrently ? (uint)ParallelGCThreads : 0),
+              (uint)ParallelGCThreads);
+}
+
+// The concurrent remembered set rebuild workers add references while the
+// mutator and the refinement threads do, so they get their own ids.
+uint HeapRegionRemSet::rebuild_par_id_base() {
+  return DirtyCardQueueSet::num_par_ids() + ConcurrentG1Refine::thread_num();
 }
 
 HeapRegionRemSet::HeapRegionRemSet(G1BlockOffsetSharedArray* bosa,
                                    HeapRegion* hr)
   : _bosa(bosa),
     _m(Mutex::leaf, FormatBuffer<128>("HeapRegionRemSet lock #%u", hr->hrm_index()), true),
-    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0) {
+    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0),
+    _state(Tracked_Complete) {
   reset_for_par_iteration();
 }
 
@@ -923,13 +931,16 @@ void HeapRegionRemSet::cleanup() {
   SparsePRT::cleanup_all();
 }
 
-void HeapRegionRemSet::clear() {
+void HeapRegionRemSet::clear(bool only_cardset) {
   MutexLockerEx x(&_m, Mutex::_no_safepoint_check_flag);
-  clear_locked();
+  clear_locked(only_cardset);
 }
 
-void HeapRegionRemSet::clear_locked() {
-  _code_roots.clear();
+void HeapRegionRemSet::clear_locked(bool only_cardset) {
+  if (!only_cardset) {
+    _code_roots.clear();
+    set_state_complete();
+  }
   _other_regions.clear();
   assert(occupied_locked() == 0, "Should be clear.");
   reset_for_par_iteration();
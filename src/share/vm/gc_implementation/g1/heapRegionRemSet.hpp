@@ -251,6 +251,11 @@ private:
   volatile ParIterState _iter_state;
   volatile jlong _iter_claimed;
 
+  // Whether references into the owning region are recorded. Only used
+  // with G1RebuildRemSetsConcurrently; otherwise always Tracked_Complete.
+  enum TrackingState { Untracked, Tracked_Updating, Tracked_Complete };
+  volatile TrackingState _state;
+
   // Unused unless G1RecordHRRSOops is true.
 
   static const int MaxRecorded = 1000000;
@@ -270,6 +275,7 @@ public:
   HeapRegionRemSet(G1BlockOffsetSharedArray* bosa, HeapRegion* hr);
 
   static uint num_par_rem_sets();
+  static uint rebuild_par_id_base();
   static void setup_remset_size();
 
   HeapRegion* hr() const {
@@ -305,22 +311,46 @@ public:
 
   // Used in the sequential case.
   void add_reference(OopOrNarrowOopStar from) {
-    _other_regions.add_reference(from, 0);
+    add_reference(from, 0);
   }
 
   // Used in the parallel case.
   void add_reference(OopOrNarrowOopStar from, int tid) {
+    if (!is_tracked()) {
+      return;
+    }
     _other_regions.add_reference(from, tid);
   }
 
+  // An untracked remembered set drops all new references; an updating
+  // one records them but may still miss older ones until the concurrent
+  // rebuild has finished. Only a complete remembered set can be used to
+  // evacuate the region.
+  bool is_tracked() const  { return _state != Untracked; }
+  bool is_updating() const { return _state == Tracked_Updating; }
+  bool is_complete() const { return _state == Tracked_Complete; }
+
+  void set_state_untracked() {
+    _state = Untracked;
+  }
+  void set_state_updating() {
+    assert(_state == Untracked, "only start tracking untracked remembered sets");
+    _state = Tracked_Updating;
+  }
+  void set_state_complete() {
+    _state = Tracked_Complete;
+  }
+
   // Removes any entries shown by the given bitmaps to contain only dead
   // objects.
   void scrub(CardTableModRefBS* ctbs, BitMap* region_bm, BitMap* card_bm);
 
   // The region is being reclaimed; clear its remset, and any mention of
-  // entries for this region in other remsets.
-  void clear();
-  void clear_locked();
+  // entries for this region in other remsets. Unless only_cardset is set
+  // the strong code roots are cleared too and the remembered set becomes
+  // complete again.
+  void clear(bool only_cardset = false);
+  void clear_locked(bool only_cardset = false);
 
   // Attempt to claim the region.  Returns true iff this call caused an
   // atomic transition from Unclaimed to Claimed.
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
 
@@ -121,6 +122,7 @@ void FreeRegionList::remove_all() {
     curr->set_next(NULL);
     curr->set_prev(NULL);
     curr->set_containing_set(NULL);
+    range_index_set_free(curr, false);
     curr = next;
   }
   clear();
@@ -151,6 +153,12 @@ void FreeRegionList::add_ordered(FreeRegionList* from_list) {
   }
   #endif // ASSERT
 
+  if (_range_index != NULL) {
+    for (HeapRegion* hr = from_list->_head; hr != NULL; hr = hr->next()) {
+      _range_index->set_free(hr->hrm_index(), true);
+    }
+  }
+
   if (is_empty()) {
     assert(length() == 0 && _tail == NULL, hrs_ext_msg(this, "invariant"));
     _head = from_list->_head;
@@ -238,6 +246,7 @@ void FreeRegionList::remove_starting_at(HeapRegion* first, uint num_regions) {
     curr->set_next(NULL);
     curr->set_prev(NULL);
     remove(curr);
+    range_index_set_free(curr, false);
 
     count++;
     curr = next;
@@ -254,6 +263,25 @@ void FreeRegionList::remove_starting_at(HeapRegion* first, uint num_regions) {
   verify_optional();
 }
 
+HeapRegion* FreeRegionList::remove_region_with_node_index(bool from_head,
+                                                          uint requested_node_index) {
+  assert(UseNUMA && G1NUMAAware, "Invariant");
+  G1NUMA* numa = G1NUMA::numa();
+  const uint max_search_depth = numa->max_search_depth();
+
+  // Find the region to use, searching from _head or _tail as requested.
+  HeapRegion* cur = from_head ? _head : _tail;
+  uint cur_depth = 0;
+  while (cur != NULL && cur_depth < max_search_depth) {
+    if (numa->preferred_node_index_for_index(cur->hrm_index()) == requested_node_index) {
+      return remove_region(cur);
+    }
+    cur = from_head ? cur->next() : cur->prev();
+    cur_depth++;
+  }
+  return NULL;
+}
+
 void FreeRegionList::verify() {
   // See comment in HeapRegionSetBase::verify() about MT safety and
   // verification.
@@ -185,6 +185,7 @@ public:
 // add / remove one region at a time or concatenate two lists.
 
 class FreeRegionListIterator;
+class G1FreeRangeIndex;
 
 class FreeRegionList : public HeapRegionSetBase {
   friend class FreeRegionListIterator;
@@ -197,8 +198,14 @@ private:
   // time. It helps to improve performance when adding several ordered items in a row.
   HeapRegion* _last;
 
+  // Index of the runs of regions on this list, if any; told about every
+  // region added to or removed from the list.
+  G1FreeRangeIndex* _range_index;
+
   static uint _unrealistically_long_length;
 
+  inline void range_index_set_free(HeapRegion* hr, bool free);
+
   inline HeapRegion* remove_from_head_impl();
   inline HeapRegion* remove_from_tail_impl();
 
@@ -213,7 +220,8 @@ protected:
 
 public:
   FreeRegionList(const char* name, HRSMtSafeChecker* mt_safety_checker = NULL):
-    HeapRegionSetBase(name, false /* humongous */, true /* empty */, mt_safety_checker) {
+    HeapRegionSetBase(name, false /* humongous */, true /* empty */, mt_safety_checker),
+    _range_index(NULL) {
     clear();
   }
 
@@ -227,6 +235,12 @@ public:
 
   static void set_unrealistically_long_length(uint len);
 
+  // Should be set while the list is still empty.
+  void set_range_index(G1FreeRangeIndex* range_index) {
+    assert(is_empty(), hrs_ext_msg(this, "the index must see all regions"));
+    _range_index = range_index;
+  }
+
   // Add hr to the list. The region should not be a member of another set.
   // Assumes that the list is ordered and will preserve that order. The order
   // is determined by hrm_index.
@@ -235,6 +249,11 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region from head or tail whose memory is bound to
+  // the given NUMA node. Only looks at a few regions and returns NULL if
+  // none of them matches.
+  HeapRegion* remove_region_with_node_index(bool from_head, uint requested_node_index);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -25,6 +25,7 @@
 #ifndef SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONSET_INLINE_HPP
 #define SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONSET_INLINE_HPP
 
+#include "gc_implementation/g1/g1FreeRangeIndex.hpp"
 #include "gc_implementation/g1/heapRegionSet.hpp"
 
 inline void HeapRegionSetBase::add(HeapRegion* hr) {
@@ -49,12 +50,19 @@ inline void HeapRegionSetBase::remove(HeapRegion* hr) {
   _count.decrement(1u, hr->capacity());
 }
 
+inline void FreeRegionList::range_index_set_free(HeapRegion* hr, bool free) {
+  if (_range_index != NULL) {
+    _range_index->set_free(hr->hrm_index(), free);
+  }
+}
+
 inline void FreeRegionList::add_ordered(HeapRegion* hr) {
   assert((length() == 0 && _head == NULL && _tail == NULL && _last == NULL) ||
          (length() >  0 && _head != NULL && _tail != NULL),
          hrs_ext_msg(this, "invariant"));
   // add() will verify the region and check mt safety.
   add(hr);
+  range_index_set_free(hr, true);
 
   // Now link the region
   if (_head != NULL) {
@@ -145,6 +153,7 @@ inline HeapRegion* FreeRegionList::remove_region(bool from_head) {
 
   // remove() will verify the region and check mt safety.
   remove(hr);
+  range_index_set_free(hr, false);
   return hr;
 }
 
@@ -180,6 +189,7 @@ inline HeapRegion* FreeRegionList::remove_region(HeapRegion* hr) {
 
   // remove() will verify the region and check mt safety.
   remove(hr);
+  range_index_set_free(hr, false);
   return hr;
 }
 
@@ -41,3 +41,17 @@ void HeapRegionTracer::send_region_type_change(uint index,
     e.commit();
   }
 }
+
+void HeapRegionTracer::send_humongous_allocation(uint start_region,
+                                                 uint num_regions,
+                                                 size_t object_size,
+                                                 size_t wasted) {
+  EventG1HumongousAllocation e;
+  if (e.should_commit()) {
+    e.set_startRegion(start_region);
+    e.set_regions(num_regions);
+    e.set_objectSize(object_size);
+    e.set_wasted(wasted);
+    e.commit();
+  }
+}
@@ -35,6 +35,11 @@ class HeapRegionTracer : AllStatic {
                                         G1HeapRegionTraceType::Type to,
                                         uintptr_t start,
                                         size_t used);
+
+    static void send_humongous_allocation(uint start_region,
+                                          uint num_regions,
+                                          size_t object_size,
+                                          size_t wasted);
 };
 
 #endif // SHARE_GC_G1_HEAPREGIONTRACER_HPP
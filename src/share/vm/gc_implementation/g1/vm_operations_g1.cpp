@@ -263,3 +263,16 @@ void VM_CGC_Operation::doit_epilogue() {
     release_and_notify_pending_list_lock();
   }
 }
+
+void VM_G1UncommitHeap::doit() {
+  G1CollectedHeap::heap()->shrink_to_soft_max_heap_size(_reason);
+}
+
+bool VM_G1UncommitHeap::doit_prologue() {
+  Heap_lock->lock();
+  return true;
+}
+
+void VM_G1UncommitHeap::doit_epilogue() {
+  Heap_lock->unlock();
+}
@@ -35,6 +35,8 @@
 //   - VM_G1OperationWithAllocRequest
 //     - VM_G1CollectForAllocation
 //     - VM_G1IncCollectionPause
+// VM_Operation:
+//   - VM_G1UncommitHeap
 
 class VM_G1OperationWithAllocRequest : public VM_CollectForAllocation {
 protected:
@@ -126,4 +128,21 @@ public:
   }
 };
 
+// Uncommits the free regions above the soft max heap size. Issued by the
+// concurrent mark thread after a marking cycle, when the heap is idle and
+// when the container is under memory pressure.
+class VM_G1UncommitHeap: public VM_Operation {
+  const char* _reason;
+
+public:
+  VM_G1UncommitHeap(const char* reason) : _reason(reason) { }
+  virtual VMOp_Type type() const { return VMOp_G1UncommitHeap; }
+  virtual void doit();
+  virtual bool doit_prologue();
+  virtual void doit_epilogue();
+  virtual const char* name() const {
+    return "garbage-first heap uncommit";
+  }
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_VM_OPERATIONS_G1_HPP
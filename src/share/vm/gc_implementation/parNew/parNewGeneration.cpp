@@ -123,25 +123,42 @@ void ParScanThreadState::scan_partial_array_and_push_remainder(oop old) {
   assert(!old_gen()->is_in(old), "must be in young generation.");
 
   objArrayOop obj = objArrayOop(old->forwardee());
-  // Process ParGCArrayScanChunk elements now
-  // and push the remainder back onto queue
-  int start     = arrayOop(old)->length();
-  int end       = obj->length();
-  int remainder = end - start;
-  assert(start <= end, "just checking");
-  if (remainder > 2 * ParGCArrayScanChunk) {
-    // Test above combines last partial chunk with a full chunk
-    end = start + ParGCArrayScanChunk;
-    arrayOop(old)->set_length(end);
+  // The length field of the from-space copy is the index of the next
+  // chunk to scan.  Several queue entries may refer to the same array,
+  // so each chunk is claimed atomically.  The last claim leaves the
+  // real length behind, so that it can be used if there is a promotion
+  // failure and forwarding pointers must be removed.
+  volatile jint* next_addr =
+    (volatile jint*)((address)(oopDesc*)old + arrayOopDesc::length_offset_in_bytes());
+  int end = obj->length();
+  int start;
+  int stop;
+  do {
+    start = *next_addr;
+    if (start >= end) {
+      // The rest was claimed through another entry.
+      return;
+    }
+    // Combine the last partial chunk with a full chunk.
+    stop = (end - start > 2 * ParGCArrayScanChunk) ? start + (int)ParGCArrayScanChunk : end;
+  } while (Atomic::cmpxchg(stop, next_addr, start) != start);
+
+  if (stop < end) {
     // Push remainder.
     bool ok = work_queue()->push(old);
     assert(ok, "just popped, push must be okay");
-  } else {
-    // Restore length so that it can be used if there
-    // is a promotion failure and forwarding pointers
-    // must be removed.
-    arrayOop(old)->set_length(end);
+    if (start == 0) {
+      // Handing the remainder on one chunk at a time lets only one thread
+      // at a time work on a huge array.  Push a few more entries for it,
+      // so that other threads can steal them and claim chunks in parallel.
+      uint chunks = (uint)((end - stop) / ParGCArrayScanChunk);
+      uint workers = GenCollectedHeap::heap()->workers()->active_workers();
+      uint extra = MIN2(chunks, workers) - 1;
+      for (uint i = 0; i < extra && work_queue()->push(old); i++) {
+      }
+    }
   }
+  end = stop;
 
   // process our set of indices (include header in first chunk)
   // should make sure end is even (aligned to HeapWord in case of compressed oops)
@@ -26,6 +26,7 @@
 #include "gc_implementation/parallelScavenge/cardTableExtension.hpp"
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
+#include "gc_implementation/parallelScavenge/psPromotionManager.inline.hpp"
 #include "gc_implementation/parallelScavenge/psTasks.hpp"
 #include "gc_implementation/parallelScavenge/psYoungGen.hpp"
 #include "oops/oop.inline.hpp"
@@ -129,14 +130,39 @@ class CheckForPreciseMarks : public OopClosure {
 // when the space is empty, fix the calculation of
 // end_card to allow sp_top == sp->bottom().
 
+// Expected number of non-clean cards per stripe when the stripe size is
+// chosen adaptively.
+static const size_t dirty_cards_per_stripe = 64;
+
+uint CardTableExtension::scavenge_stripe_size(MutableSpace* sp,
+                                              HeapWord* space_top,
+                                              uint stripe_total) {
+  uint ssize = default_stripe_size;
+  size_t used_cards = pointer_delta(space_top, sp->bottom()) / card_size_in_words;
+  if (PSAdaptiveCardStripeSize && _last_scanned_cards > 0 && used_cards > 0) {
+    // Scanning clean cards is cheap; the work is in the objects under
+    // non-clean cards.  Size the stripes so that each is expected to hold
+    // about the same number of non-clean cards, as seen by the previous
+    // scavenge, but keep enough slices for every worker to balance over.
+    double dirty_fraction = (double)_last_dirty_cards / (double)_last_scanned_cards;
+    size_t size = dirty_fraction > 0.0 ?
+                  (size_t)(dirty_cards_per_stripe / dirty_fraction) : used_cards;
+    size_t max_size = MAX2(used_cards / ((size_t)stripe_total * 4), (size_t)default_stripe_size);
+    ssize = (uint)MIN2(MAX2(size, (size_t)default_stripe_size), max_size);
+  }
+  _last_scanned_cards = used_cards;
+  _last_dirty_cards = 0;
+  return ssize;
+}
+
 void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_array,
                                                     MutableSpace* sp,
                                                     HeapWord* space_top,
                                                     PSPromotionManager* pm,
                                                     uint stripe_number,
-                                                    uint stripe_total) {
-  int ssize = 128; // Naked constant!  Work unit = 64k.
-  int dirty_card_count = 0;
+                                                    uint stripe_total,
+                                                    uint ssize) {
+  size_t dirty_card_count = 0;
 
   // It is a waste to get here if empty.
   assert(sp->bottom() < sp->top(), "Should not be called if empty");
@@ -151,7 +177,7 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
   for (jbyte* slice = start_card; slice < end_card; slice += slice_width) {
     jbyte* worker_start_card = slice + stripe_number * ssize;
     if (worker_start_card >= end_card)
-      return; // We're done.
+      break; // We're done.
 
     jbyte* worker_end_card = worker_start_card + ssize;
     if (worker_end_card > end_card)
@@ -160,7 +186,9 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     // We do not want to scan objects more than once. In order to accomplish
     // this, we assert that any object with an object head inside our 'slice'
     // belongs to us. We may need to extend the range of scanned cards if the
-    // last object continues into the next 'slice'.
+    // last object continues into the next 'slice'.  Object arrays are the
+    // exception: each slice scans the part of an array that lies within it,
+    // so that a large array is spread over the workers.
     //
     // Note! ending cards are exclusive!
     HeapWord* slice_start = addr_for(worker_start_card);
@@ -176,14 +204,17 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     }
 #endif
 
-    // If there are not objects starting within the chunk, skip it.
-    if (!start_array->object_starts_in_range(slice_start, slice_end)) {
-      continue;
-    }
     // Update our beginning addr
     HeapWord* first_object = start_array->object_start(slice_start);
+    bool starts_in_array = first_object < slice_start && oop(first_object)->is_objArray();
+    // If there are not objects starting within the chunk, skip it (unless
+    // it is covered by an array).
+    if (!starts_in_array &&
+        !start_array->object_starts_in_range(slice_start, slice_end)) {
+      continue;
+    }
     debug_only(oop* first_object_within_slice = (oop*) first_object;)
-    if (first_object < slice_start) {
+    if (first_object < slice_start && !starts_in_array) {
       last_scanned = (oop*)(first_object + oop(first_object)->size());
       debug_only(first_object_within_slice = last_scanned;)
       worker_start_card = byte_for(last_scanned);
@@ -193,13 +224,15 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     if (slice_end < (HeapWord*)sp_top) {
       // The subtraction is important! An object may start precisely at slice_end.
       HeapWord* last_object = start_array->object_start(slice_end - 1);
-      slice_end = last_object + oop(last_object)->size();
-      // worker_end_card is exclusive, so bump it one past the end of last_object's
-      // covered span.
-      worker_end_card = byte_for(slice_end) + 1;
-
-      if (worker_end_card > end_card)
-        worker_end_card = end_card;
+      if (!oop(last_object)->is_objArray()) {
+        slice_end = last_object + oop(last_object)->size();
+        // worker_end_card is exclusive, so bump it one past the end of last_object's
+        // covered span.
+        worker_end_card = byte_for(slice_end) + 1;
+
+        if (worker_end_card > end_card)
+          worker_end_card = end_card;
+      }
     }
 
     assert(slice_end <= (HeapWord*)sp_top, "Last object in slice crosses space boundary");
@@ -229,40 +262,29 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
           // an object has more than one dirty card, separated by a clean card,
           // we will attempt to scan it twice. The test against "last_scanned"
           // prevents the redundant object scan, but it does not prevent newly
-          // marked cards from being cleaned.
+          // marked cards from being cleaned.  Object arrays are only scanned
+          // under their non-clean cards, so the run is not extended for them.
           HeapWord* last_object_in_dirty_region = start_array->object_start(addr_for(current_card)-1);
-          size_t size_of_last_object = oop(last_object_in_dirty_region)->size();
-          HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
-          jbyte* ending_card_of_last_object = byte_for(end_of_last_object);
-          assert(ending_card_of_last_object <= worker_end_card, "ending_card_of_last_object is greater than worker_end_card");
-          if (ending_card_of_last_object > current_card) {
-            // This means the object spans the next complete card.
-            // We need to bump the current_card to ending_card_of_last_object
-            current_card = ending_card_of_last_object;
+          if (!oop(last_object_in_dirty_region)->is_objArray()) {
+            size_t size_of_last_object = oop(last_object_in_dirty_region)->size();
+            HeapWord* end_of_last_object = last_object_in_dirty_region + size_of_last_object;
+            jbyte* ending_card_of_last_object = byte_for(end_of_last_object);
+            assert(ending_card_of_last_object <= worker_end_card, "ending_card_of_last_object is greater than worker_end_card");
+            if (ending_card_of_last_object > current_card) {
+              // This means the object spans the next complete card.
+              // We need to bump the current_card to ending_card_of_last_object
+              current_card = ending_card_of_last_object;
+            }
           }
         }
       }
       jbyte* following_clean_card = current_card;
 
       if (first_unclean_card < worker_end_card) {
-        oop* p = (oop*) start_array->object_start(addr_for(first_unclean_card));
-        assert((HeapWord*)p <= addr_for(first_unclean_card), "checking");
-        // "p" should always be >= "last_scanned" because newly GC dirtied
-        // cards are no longer scanned again (see comment at end
-        // of loop on the increment of "current_card").  Test that
-        // hypothesis before removing this code.
-        // If this code is removed, deal with the first time through
-        // the loop when the last_scanned is the object starting in
-        // the previous slice.
-        assert((p >= last_scanned) ||
-               (last_scanned == first_object_within_slice),
-               "Should no longer be possible");
-        if (p < last_scanned) {
-          // Avoid scanning more than once; this can happen because
-          // newgen cards set by GC may a different set than the
-          // originally dirty set
-          p = last_scanned;
-        }
+        dirty_card_count += following_clean_card - first_unclean_card;
+        HeapWord* run_start = addr_for(first_unclean_card);
+        oop* p = (oop*) start_array->object_start(run_start);
+        assert((HeapWord*)p <= run_start, "checking");
         oop* to = (oop*)addr_for(following_clean_card);
 
         // Test slice_end first!
@@ -272,6 +294,34 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
           to = sp_top;
         }
 
+        if ((HeapWord*)p < run_start && oop(p)->is_objArray()) {
+          // Scan only the part of the array under the unclean cards.
+          HeapWord* from = MAX2(run_start, (HeapWord*)last_scanned);
+          HeapWord* obj_end = (HeapWord*)p + oop(p)->size();
+          HeapWord* bound = MIN2(obj_end, (HeapWord*)to);
+          if (from < bound) {
+            pm->push_contents_bounded(objArrayOop(p), from, bound);
+          }
+          p = (oop*)MAX2(from, bound);
+        } else {
+          // "p" should always be >= "last_scanned" because newly GC dirtied
+          // cards are no longer scanned again (see comment at end
+          // of loop on the increment of "current_card").  Test that
+          // hypothesis before removing this code.
+          // If this code is removed, deal with the first time through
+          // the loop when the last_scanned is the object starting in
+          // the previous slice.
+          assert((p >= last_scanned) ||
+                 (last_scanned == first_object_within_slice),
+                 "Should no longer be possible");
+          if (p < last_scanned) {
+            // Avoid scanning more than once; this can happen because
+            // newgen cards set by GC may a different set than the
+            // originally dirty set
+            p = last_scanned;
+          }
+        }
+
         // we know which cards to scan, now clear them
         if (first_unclean_card <= worker_start_card+1)
           first_unclean_card = worker_start_card+1;
@@ -284,24 +334,23 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
 
         const int interval = PrefetchScanIntervalInBytes;
         // scan all objects in the range
-        if (interval != 0) {
-          while (p < to) {
+        while (p < to) {
+          if (interval != 0) {
             Prefetch::write(p, interval);
-            oop m = oop(p);
-            assert(m->is_oop_or_null(), "check for header");
-            m->push_contents(pm);
-            p += m->size();
           }
-          pm->drain_stacks_cond_depth();
-        } else {
-          while (p < to) {
-            oop m = oop(p);
-            assert(m->is_oop_or_null(), "check for header");
-            m->push_contents(pm);
-            p += m->size();
+          oop m = oop(p);
+          assert(m->is_oop_or_null(), "check for header");
+          oop* obj_end = p + m->size();
+          if (obj_end > to && m->is_objArray()) {
+            // The rest of the array is scanned with its own unclean cards.
+            pm->push_contents_bounded(objArrayOop(m), (HeapWord*)p, (HeapWord*)to);
+            p = to;
+            break;
           }
-          pm->drain_stacks_cond_depth();
+          m->push_contents(pm);
+          p = obj_end;
         }
+        pm->drain_stacks_cond_depth();
         last_scanned = p;
       }
       // "current_card" is still the "following_clean_card" or
@@ -318,6 +367,10 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
       current_card++;
     }
   }
+
+  if (PSAdaptiveCardStripeSize) {
+    Atomic::add_ptr((intptr_t)dirty_card_count, (volatile intptr_t*)&_last_dirty_cards);
+  }
 }
 
 // This should be called before a scavenge.
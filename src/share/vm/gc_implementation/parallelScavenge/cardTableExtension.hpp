@@ -47,14 +47,23 @@ class CardTableExtension : public CardTableModRefBS {
 
   static void verify_all_young_refs_precise_helper(MemRegion mr);
 
+  // Non-clean cards found by the last scavenge, and the number of cards
+  // in the old gen it scanned (PSAdaptiveCardStripeSize).
+  volatile size_t _last_dirty_cards;
+  size_t _last_scanned_cards;
+
  public:
+  // Stripe size, in cards, used unless PSAdaptiveCardStripeSize is set.
+  static const uint default_stripe_size = 128; // Work unit = 64k.
+
   enum ExtendedCardValue {
     youngergen_card   = CardTableModRefBS::CT_MR_BS_last_reserved + 1,
     verify_card       = CardTableModRefBS::CT_MR_BS_last_reserved + 5
   };
 
   CardTableExtension(MemRegion whole_heap, int max_covered_regions) :
-    CardTableModRefBS(whole_heap, max_covered_regions) { }
+    CardTableModRefBS(whole_heap, max_covered_regions),
+    _last_dirty_cards(0), _last_scanned_cards(0) { }
 
   // Too risky for the 4/10/02 putback
   // BarrierSet::Name kind() { return BarrierSet::CardTableExtension; }
@@ -65,7 +74,14 @@ class CardTableExtension : public CardTableModRefBS {
                                   HeapWord* space_top,
                                   PSPromotionManager* pm,
                                   uint stripe_number,
-                                  uint stripe_total);
+                                  uint stripe_total,
+                                  uint ssize);
+
+  // Choose the stripe size, in cards, for the coming scavenge of the space
+  // up to space_top.  Called once per scavenge, before the stripes are
+  // scanned.
+  uint scavenge_stripe_size(MutableSpace* sp, HeapWord* space_top,
+                            uint stripe_total);
 
   // Verification
   static void verify_all_young_refs_imprecise();
@@ -28,9 +28,11 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -407,6 +409,21 @@ void GCTaskManager::initialize() {
   _noop_task = NoopGCTask::create_on_c_heap();
   _idle_inactive_task = WaitForBarrierGCTask::create_on_c_heap();
   _resource_flag = NEW_C_HEAP_ARRAY(bool, workers(), mtGC);
+  _local_queues = NULL;
+  _local_tasks = 0;
+  _next_local_queue = 0;
+  if (UseGCTaskStealing) {
+    // Each per-worker queue has its own lock, ranked below monitor()
+    // so that distribute_tasks() can fill it while holding monitor().
+    _local_queues = NEW_C_HEAP_ARRAY(SynchronizedGCTaskQueue*, workers(), mtGC);
+    for (uint w = 0; w < workers(); w += 1) {
+      Monitor* lock = new Monitor(Mutex::leaf,                  // rank
+                                  "GCTaskManager local queue",  // name
+                                  Mutex::_allow_vm_block_flag); // allow_vm_block
+      _local_queues[w] =
+        SynchronizedGCTaskQueue::create(GCTaskQueue::create_on_c_heap(), lock);
+    }
+  }
   {
     // Set up worker threads.
     //     Distribute the workers among the available processors,
@@ -465,6 +482,18 @@ GCTaskManager::~GCTaskManager() {
     FREE_C_HEAP_ARRAY(bool, _resource_flag, mtGC);
     _resource_flag = NULL;
   }
+  if (_local_queues != NULL) {
+    assert(local_tasks() == 0, "still have local work");
+    for (uint w = 0; w < workers(); w += 1) {
+      SynchronizedGCTaskQueue* q = local_queue(w);
+      Monitor* lock = q->lock();
+      GCTaskQueue::destroy(q->unsynchronized_queue());
+      SynchronizedGCTaskQueue::destroy(q);
+      delete lock;
+    }
+    FREE_C_HEAP_ARRAY(SynchronizedGCTaskQueue*, _local_queues, mtGC);
+    _local_queues = NULL;
+  }
   if (queue() != NULL) {
     GCTaskQueue* unsynchronized_queue = queue()->unsynchronized_queue();
     GCTaskQueue::destroy(unsynchronized_queue);
@@ -506,8 +535,9 @@ void GCTaskManager::task_idle_workers() {
       // Stop any idle tasks from exiting their IdleGCTask's
       // and get the count for additional IdleGCTask's under
       // the GCTaskManager's monitor so that the "more_inactive_workers"
-      // count is correct.
-      MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
+      // count is correct.  With UseGCTaskStealing the idle workers park
+      // on the idle task's own monitor instead.
+      MutexLockerEx ml(idle_monitor(), Mutex::_no_safepoint_check_flag);
       _idle_inactive_task->set_should_wait(true);
       // active_workers are a number being requested.  idle_workers
       // are the number currently idle.  If all the workers are being
@@ -549,10 +579,10 @@ void GCTaskManager::task_idle_workers() {
 
 void  GCTaskManager::release_idle_workers() {
   {
-    MutexLockerEx ml(monitor(),
+    MutexLockerEx ml(idle_monitor(),
       Mutex::_no_safepoint_check_flag);
     _idle_inactive_task->set_should_wait(false);
-    monitor()->notify_all();
+    idle_monitor()->notify_all();
   // Release monitor
   }
 }
@@ -600,6 +630,9 @@ void GCTaskManager::add_task(GCTask* task) {
                   task, GCTask::Kind::to_string(task->kind()));
   }
   queue()->enqueue(task);
+  if (UseGCTaskStealing) {
+    distribute_tasks();
+  }
   // Notify with the lock held to avoid missed notifies.
   if (TraceGCTaskManager) {
     tty->print_cr("    GCTaskManager::add_task (%s)->notify_all",
@@ -616,6 +649,9 @@ void GCTaskManager::add_list(GCTaskQueue* list) {
     tty->print_cr("GCTaskManager::add_list(%u)", list->length());
   }
   queue()->enqueue(list);
+  if (UseGCTaskStealing) {
+    distribute_tasks();
+  }
   // Notify with the lock held to avoid missed notifies.
   if (TraceGCTaskManager) {
     tty->print_cr("    GCTaskManager::add_list (%s)->notify_all",
@@ -634,12 +670,20 @@ void GCTaskManager::add_list(GCTaskQueue* list) {
 
 GCTask* GCTaskManager::get_task(uint which) {
   GCTask* result = NULL;
+  if (UseGCTaskStealing) {
+    // Take local or stolen work without touching the monitor.
+    result = get_local_task(which);
+    if (result != NULL) {
+      return result;
+    }
+  }
   // Grab the queue lock.
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   // Wait while the queue is block or
   // there is nothing to do, except maybe release resources.
   while (is_blocked() ||
-         (queue()->is_empty() && !should_release_resources(which))) {
+         (queue()->is_empty() && local_tasks() == 0 &&
+          !should_release_resources(which))) {
     if (TraceGCTaskManager) {
       tty->print_cr("GCTaskManager::get_task(%u)"
                     "  blocked: %s"
@@ -655,6 +699,17 @@ GCTask* GCTaskManager::get_task(uint which) {
     monitor()->wait(Mutex::_no_safepoint_check_flag, 0);
   }
   // We've reacquired the queue lock here.
+  if (UseGCTaskStealing) {
+    // Everything ahead of the next barrier in queue() has been moved to
+    // the per-worker queues and has to be handed out first.  Nobody can
+    // add to them while we hold the monitor, so this terminates.
+    while (local_tasks() > 0) {
+      result = get_local_task(which);
+      if (result != NULL) {
+        return result;
+      }
+    }
+  }
   // Figure out which condition caused us to exit the loop above.
   if (!queue()->is_empty()) {
     if (UseGCTaskAffinity) {
@@ -689,6 +744,16 @@ GCTask* GCTaskManager::get_task(uint which) {
 }
 
 void GCTaskManager::note_completion(uint which) {
+  if (UseGCTaskStealing) {
+    // Barrier tasks poll busy_workers(), so the monitor is only needed
+    // to unblock the queue or to note that all the work is done.  Only
+    // this worker can have made itself the blocker.
+    increment_completed_tasks();
+    uint active = decrement_busy_workers();
+    if (blocking_worker() != which && active != 0) {
+      return;
+    }
+  }
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   if (TraceGCTaskManager) {
     tty->print_cr("GCTaskManager::note_completion(%u)", which);
@@ -699,10 +764,19 @@ void GCTaskManager::note_completion(uint which) {
            "blocker shouldn't be bogus");
     increment_barriers();
     set_unblocked();
+    if (UseGCTaskStealing) {
+      // Hand out the tasks that were held back behind the barrier.
+      distribute_tasks();
+    }
+  }
+  uint active;
+  if (UseGCTaskStealing) {
+    active = busy_workers();
+  } else {
+    increment_completed_tasks();
+    active = decrement_busy_workers();
   }
-  increment_completed_tasks();
-  uint active = decrement_busy_workers();
-  if ((active == 0) && (queue()->is_empty())) {
+  if ((active == 0) && (queue()->is_empty()) && (local_tasks() == 0)) {
     increment_emptied_queue();
     if (TraceGCTaskManager) {
       tty->print_cr("    GCTaskManager::note_completion(%u) done", which);
@@ -739,18 +813,118 @@ void GCTaskManager::note_completion(uint which) {
 }
 
 uint GCTaskManager::increment_busy_workers() {
+  if (UseGCTaskStealing) {
+    return (uint) Atomic::add(1, (volatile jint*) &_busy_workers);
+  }
   assert(queue()->own_lock(), "don't own the lock");
   _busy_workers += 1;
   return _busy_workers;
 }
 
 uint GCTaskManager::decrement_busy_workers() {
-  assert(queue()->own_lock(), "don't own the lock");
   assert(_busy_workers > 0, "About to make a mistake");
+  if (UseGCTaskStealing) {
+    return (uint) Atomic::add(-1, (volatile jint*) &_busy_workers);
+  }
+  assert(queue()->own_lock(), "don't own the lock");
   _busy_workers -= 1;
   return _busy_workers;
 }
 
+void GCTaskManager::increment_delivered_tasks() {
+  if (UseGCTaskStealing) {
+    Atomic::inc((volatile jint*) &_delivered_tasks);
+  } else {
+    _delivered_tasks += 1;
+  }
+}
+
+void GCTaskManager::increment_completed_tasks() {
+  if (UseGCTaskStealing) {
+    Atomic::inc((volatile jint*) &_completed_tasks);
+  } else {
+    _completed_tasks += 1;
+  }
+}
+
+void GCTaskManager::increment_idle_workers() {
+  Atomic::inc((volatile jint*) &_idle_workers);
+}
+
+void GCTaskManager::decrement_idle_workers() {
+  Atomic::dec((volatile jint*) &_idle_workers);
+}
+
+Monitor* GCTaskManager::idle_monitor() const {
+  return UseGCTaskStealing ? _idle_inactive_task->monitor() : monitor();
+}
+
+void GCTaskManager::distribute_tasks() {
+  assert(UseGCTaskStealing, "only with per-worker queues");
+  assert(monitor()->owned_by_self(), "don't own the lock");
+  if (is_blocked()) {
+    // The tasks behind a running barrier are distributed when it completes.
+    return;
+  }
+  GCTaskQueue* shared = queue()->unsynchronized_queue();
+  while (!shared->is_empty() && !shared->peek()->is_barrier_task()) {
+    GCTask* task = shared->dequeue();
+    uint which;
+    if (UseGCTaskAffinity && task->affinity() < workers()) {
+      which = task->affinity();
+    } else {
+      which = _next_local_queue;
+      _next_local_queue = (which + 1) % workers();
+    }
+    // Count the task before it can be taken, so local_tasks() never
+    // underflows.
+    Atomic::inc((volatile jint*) &_local_tasks);
+    MutexLockerEx ml(local_queue(which)->lock(),
+                     Mutex::_no_safepoint_check_flag);
+    local_queue(which)->enqueue(task);
+  }
+}
+
+GCTask* GCTaskManager::get_local_task(uint which) {
+  assert(UseGCTaskStealing, "only with per-worker queues");
+  if (local_tasks() == 0 || is_blocked()) {
+    return NULL;
+  }
+  // Own queue first, then the others, starting with the next worker.
+  for (uint i = 0; i < workers(); i += 1) {
+    uint victim = (which + i) % workers();
+    SynchronizedGCTaskQueue* q = local_queue(victim);
+    if (q->unsynchronized_queue()->length() == 0) {
+      // Racy peek; an empty queue is not worth its lock.
+      continue;
+    }
+    GCTask* result = NULL;
+    {
+      MutexLockerEx ml(q->lock(), Mutex::_no_safepoint_check_flag);
+      if (q->is_empty()) {
+        continue;
+      }
+      result = q->dequeue();
+    }
+    if (!result->is_idle_task()) {
+      increment_busy_workers();
+      increment_delivered_tasks();
+    }
+    // Count the worker busy before the local queues can be seen to be
+    // empty: a barrier is only handed out once local_tasks() is zero,
+    // and then waits for busy_workers() to drain.
+    Atomic::dec((volatile jint*) &_local_tasks);
+    if (TraceGCTaskManager) {
+      tty->print_cr("GCTaskManager::get_local_task(%u) => " INTPTR_FORMAT
+                    " [%s] from %u",
+                    which, result, GCTask::Kind::to_string(result->kind()),
+                    victim);
+    }
+    return result;
+  }
+  return NULL;
+}
+
 void GCTaskManager::release_all_resources() {
   // If you want this to be done atomically, do it in a BarrierGCTask.
   for (uint i = 0; i < workers(); i += 1) {
@@ -865,21 +1039,24 @@ void IdleGCTask::do_it(GCTaskManager* manager, uint which) {
       "  should_wait: %s",
       this, wait_for_task->should_wait() ? "true" : "false");
   }
-  MutexLockerEx ml(manager->monitor(), Mutex::_no_safepoint_check_flag);
+  Monitor* idle_monitor = manager->idle_monitor();
+  MutexLockerEx ml(idle_monitor, Mutex::_no_safepoint_check_flag);
   if (TraceDynamicGCThreads) {
     gclog_or_tty->print_cr("--- idle %d", which);
   }
   // Increment has to be done when the idle tasks are created.
   // manager->increment_idle_workers();
-  manager->monitor()->notify_all();
+  if (!UseGCTaskStealing) {
+    manager->monitor()->notify_all();
+  }
   while (wait_for_task->should_wait()) {
     if (TraceGCTaskManager) {
       tty->print_cr("[" INTPTR_FORMAT "]"
                     " IdleGCTask::do_it()"
         "  [" INTPTR_FORMAT "] (%s)->wait()",
-        this, manager->monitor(), manager->monitor()->name());
+        this, idle_monitor, idle_monitor->name());
     }
-    manager->monitor()->wait(Mutex::_no_safepoint_check_flag, 0);
+    idle_monitor->wait(Mutex::_no_safepoint_check_flag, 0);
   }
   manager->decrement_idle_workers();
   if (TraceDynamicGCThreads) {
@@ -919,6 +1096,10 @@ void BarrierGCTask::do_it(GCTaskManager* manager, uint which) {
   //     whose constructor would grab the lock and come to the barrier,
   //     and whose destructor would release the lock,
   //     but that seems like too much mechanism for two lines of code.
+  if (UseGCTaskStealing) {
+    do_it_internal(manager, which);
+    return;
+  }
   MutexLockerEx ml(manager->lock(), Mutex::_no_safepoint_check_flag);
   do_it_internal(manager, which);
   // Release manager->lock().
@@ -926,8 +1107,22 @@ void BarrierGCTask::do_it(GCTaskManager* manager, uint which) {
 
 void BarrierGCTask::do_it_internal(GCTaskManager* manager, uint which) {
   // Wait for this to be the only busy worker.
-  assert(manager->monitor()->owned_by_self(), "don't own the lock");
   assert(manager->is_blocked(), "manager isn't blocked");
+  if (UseGCTaskStealing) {
+    // Workers complete without notifying the monitor, so poll the
+    // counter, backing off from spinning to yielding to sleeping.
+    for (uint spins = 0; manager->busy_workers() > 1; spins += 1) {
+      if (spins < 64) {
+        SpinPause();
+      } else if (spins < 1024) {
+        os::naked_yield();
+      } else {
+        os::naked_short_sleep(1);
+      }
+    }
+    return;
+  }
+  assert(manager->monitor()->owned_by_self(), "don't own the lock");
   while (manager->busy_workers() > 1) {
     if (TraceGCTaskManager) {
       tty->print_cr("BarrierGCTask::do_it(%u) waiting on %u workers",
@@ -1045,8 +1240,10 @@ void WaitForBarrierGCTask::do_it(GCTaskManager* manager, uint which) {
                   "  monitor: " INTPTR_FORMAT,
                   this, monitor());
   }
-  {
-    // First, wait for the barrier to arrive.
+  // First, wait for the barrier to arrive.
+  if (UseGCTaskStealing) {
+    do_it_internal(manager, which);
+  } else {
     MutexLockerEx ml(manager->lock(), Mutex::_no_safepoint_check_flag);
     do_it_internal(manager, which);
     // Release manager->lock().
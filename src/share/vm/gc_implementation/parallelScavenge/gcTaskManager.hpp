@@ -164,6 +164,10 @@ public:
   uint length() const {
     return _length;
   }
+  //     The task that dequeue() would return, or NULL.
+  GCTask* peek() const {
+    return remove_end();
+  }
   // Methods.
   //     Enqueue one task.
   void enqueue(GCTask* task);
@@ -371,7 +375,7 @@ private:
   SynchronizedGCTaskQueue*  _queue;             // Queue of tasks.
   GCTaskThread**            _thread;            // Array of worker threads.
   uint                      _active_workers;    // Number of active workers.
-  uint                      _busy_workers;      // Number of busy workers.
+  volatile uint             _busy_workers;      // Number of busy workers.
   uint                      _blocking_worker;   // The worker that's blocking.
   bool*                     _resource_flag;     // Array of flag per threads.
   uint                      _delivered_tasks;   // Count of delivered tasks.
@@ -382,6 +386,12 @@ private:
   uint                      _noop_tasks;        // Count of noop tasks.
   WaitForBarrierGCTask*     _idle_inactive_task;// Task for inactive workers
   volatile uint             _idle_workers;      // Number of idled workers
+  // With UseGCTaskStealing, tasks up to the next barrier are moved from
+  // _queue into per-worker queues.  A worker pops its own queue first and
+  // then steals from the others, without taking _monitor.
+  SynchronizedGCTaskQueue** _local_queues;      // Per-worker queues.
+  volatile uint             _local_tasks;       // Tasks in _local_queues.
+  uint                      _next_local_queue;  // Round-robin cursor.
 public:
   // Factory create and destroy methods.
   static GCTaskManager* create(uint workers) {
@@ -412,6 +422,8 @@ public:
   WaitForBarrierGCTask* idle_inactive_task() {
     return _idle_inactive_task;
   }
+  //     The monitor that idle workers wait on.
+  Monitor* idle_monitor() const;
   // Methods.
   //     Add the argument task to be run.
   void add_task(GCTask* task);
@@ -483,6 +495,19 @@ protected:
   void set_thread(uint which, GCTaskThread* value);
   bool resource_flag(uint which);
   void set_resource_flag(uint which, bool value);
+  SynchronizedGCTaskQueue* local_queue(uint which) const {
+    assert(which < workers(), "index out of bounds");
+    return _local_queues[which];
+  }
+  uint local_tasks() const {
+    return _local_tasks;
+  }
+  //     Move the tasks ahead of the next barrier in queue()
+  //     to the per-worker queues.  Called with monitor() held.
+  void distribute_tasks();
+  //     Pop a task from the worker's own queue, or steal one from
+  //     another worker.  Returns NULL if there is nothing to take.
+  GCTask* get_local_task(uint which);
   // Modifier methods with some semantics.
   //     Is any worker blocking handing out new tasks?
   uint blocking_worker() const {
@@ -504,9 +529,7 @@ protected:
   uint delivered_tasks() const {
     return _delivered_tasks;
   }
-  void increment_delivered_tasks() {
-    _delivered_tasks += 1;
-  }
+  void increment_delivered_tasks();
   void reset_delivered_tasks() {
     _delivered_tasks = 0;
   }
@@ -514,9 +537,7 @@ protected:
   uint completed_tasks() const {
     return _completed_tasks;
   }
-  void increment_completed_tasks() {
-    _completed_tasks += 1;
-  }
+  void increment_completed_tasks();
   void reset_completed_tasks() {
     _completed_tasks = 0;
   }
@@ -551,12 +572,9 @@ protected:
   void reset_noop_tasks() {
     _noop_tasks = 0;
   }
-  void increment_idle_workers() {
-    _idle_workers++;
-  }
-  void decrement_idle_workers() {
-    _idle_workers--;
-  }
+  //     Count of idle workers, updated without holding monitor().
+  void increment_idle_workers();
+  void decrement_idle_workers();
   // Other methods.
   void initialize();
 
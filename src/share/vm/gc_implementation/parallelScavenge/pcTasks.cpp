@@ -287,6 +287,11 @@ void StealRegionCompactionTask::do_it(GCTaskManager* manager, uint which) {
     if (ParCompactionManager::steal(which, region_index)) {
       PSParallelCompact::fill_and_update_region(cm, region_index);
       cm->drain_region_stacks();
+    } else if (UseParallelOldGCShadowRegions &&
+               PSParallelCompact::steal_unavailable_region(cm, region_index)) {
+      // Fill a region that is not available yet in a shadow region.
+      PSParallelCompact::fill_and_update_shadow_region(cm, region_index);
+      cm->drain_region_stacks();
     } else {
       if (terminator()->offer_termination()) {
         break;
@@ -34,6 +34,8 @@
 #include "oops/objArrayKlass.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/oop.pcgc.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/growableArray.hpp"
 #include "utilities/stack.inline.hpp"
 
 PSOldGen*            ParCompactionManager::_old_gen = NULL;
@@ -52,10 +54,15 @@ uint*                 ParCompactionManager::_recycled_stack_index = NULL;
 int                   ParCompactionManager::_recycled_top = -1;
 int                   ParCompactionManager::_recycled_bottom = -1;
 
+GrowableArray<size_t>* ParCompactionManager::_shadow_region_array = NULL;
+Monitor*              ParCompactionManager::_shadow_region_monitor = NULL;
+
 ParCompactionManager::ParCompactionManager() :
     _action(CopyAndUpdate),
     _region_stack(NULL),
-    _region_stack_index((uint)max_uintx) {
+    _region_stack_index((uint)max_uintx),
+    _next_shadow_region(0),
+    _shadow_region_stride(1) {
 
   ParallelScavengeHeap* heap = (ParallelScavengeHeap*)Universe::heap();
   assert(heap->kind() == CollectedHeap::ParallelScavengeHeap, "Sanity");
@@ -119,6 +126,9 @@ void ParCompactionManager::initialize(ParMarkBitMap* mbm) {
     "Could not create ParCompactionManager");
   assert(PSParallelCompact::gc_task_manager()->workers() != 0,
     "Not initialized?");
+
+  _shadow_region_array = new (ResourceObj::C_HEAP, mtGC) GrowableArray<size_t>(10, true, mtGC);
+  _shadow_region_monitor = new Monitor(Mutex::leaf, "ParCompactionManager shadow region lock", true);
 }
 
 int ParCompactionManager::pop_recycled_stack_index() {
@@ -209,3 +219,33 @@ void ParCompactionManager::drain_region_stacks() {
     }
   } while (!region_stack()->is_empty());
 }
+
+size_t ParCompactionManager::pop_shadow_region_mt_safe(size_t region_idx) {
+  const PSParallelCompact::RegionData* const region_ptr =
+    PSParallelCompact::summary_data().region(region_idx);
+  MonitorLockerEx ml(_shadow_region_monitor, Mutex::_no_safepoint_check_flag);
+  while (true) {
+    if (!_shadow_region_array->is_empty()) {
+      return _shadow_region_array->pop();
+    }
+    // If the region has become available no shadow region is needed.
+    if (region_ptr->claimed()) {
+      return InvalidShadow;
+    }
+    ml.wait(Mutex::_no_safepoint_check_flag, 1);
+  }
+}
+
+void ParCompactionManager::push_shadow_region_mt_safe(size_t shadow_region) {
+  MonitorLockerEx ml(_shadow_region_monitor, Mutex::_no_safepoint_check_flag);
+  _shadow_region_array->push(shadow_region);
+  ml.notify();
+}
+
+void ParCompactionManager::push_shadow_region(size_t shadow_region) {
+  _shadow_region_array->push(shadow_region);
+}
+
+void ParCompactionManager::remove_all_shadow_regions() {
+  _shadow_region_array->clear();
+}
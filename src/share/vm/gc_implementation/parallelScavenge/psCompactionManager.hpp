@@ -40,6 +40,8 @@ class ParCompactionManager;
 class ObjectStartArray;
 class ParallelCompactData;
 class ParMarkBitMap;
+class Monitor;
+template <class E> class GrowableArray;
 
 class ParCompactionManager : public CHeapObj<mtGC> {
   friend class ParallelTaskTerminator;
@@ -112,6 +114,15 @@ private:
 
   static ParMarkBitMap* _mark_bitmap;
 
+  // Empty regions available as shadow regions, and the lock protecting them.
+  static GrowableArray<size_t>* _shadow_region_array;
+  static Monitor*               _shadow_region_monitor;
+
+  // Next old gen region this thread tries to fill in a shadow region, and
+  // the distance between the regions it tries.
+  size_t _next_shadow_region;
+  size_t _shadow_region_stride;
+
   Action _action;
 
   static PSOldGen* old_gen()             { return _old_gen; }
@@ -196,6 +207,26 @@ private:
   // Process tasks remaining on any stack
   void drain_region_stacks();
 
+  // Shadow region support (see PSParallelCompact::initialize_shadow_regions).
+  static const size_t InvalidShadow = ~(size_t)0;
+
+  // Take a shadow region for the region at region_idx, waiting for one if
+  // necessary.  Return InvalidShadow if the region becomes claimed in the
+  // meantime.
+  static size_t pop_shadow_region_mt_safe(size_t region_idx);
+  static void push_shadow_region_mt_safe(size_t shadow_region);
+  static void push_shadow_region(size_t shadow_region);
+  static void remove_all_shadow_regions();
+
+  size_t next_shadow_region() const            { return _next_shadow_region; }
+  void set_next_shadow_region(size_t region)   { _next_shadow_region = region; }
+  size_t shadow_region_stride() const          { return _shadow_region_stride; }
+  void set_shadow_region_stride(size_t stride) { _shadow_region_stride = stride; }
+  size_t move_next_shadow_region_by(size_t n) {
+    _next_shadow_region += n;
+    return _next_shadow_region;
+  }
+
 };
 
 inline ParCompactionManager* ParCompactionManager::manager_array(int index) {
@@ -28,10 +28,12 @@
 #include "gc_implementation/parallelScavenge/psMarkSweepDecorator.hpp"
 #include "gc_implementation/parallelScavenge/psOldGen.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
+#include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/cardTableModRefBS.hpp"
 #include "memory/gcLocker.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -43,7 +45,8 @@ PSOldGen::PSOldGen(ReservedSpace rs, size_t alignment,
                    size_t initial_size, size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _numa_chunks(NULL), _numa_chunk_count(0),
+  _numa_chunk_words(0), _numa_page_size(0)
 {
   initialize(rs, alignment, perf_data_name, level);
 }
@@ -52,7 +55,8 @@ PSOldGen::PSOldGen(size_t initial_size,
                    size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _numa_chunks(NULL), _numa_chunk_count(0),
+  _numa_chunk_words(0), _numa_page_size(0)
 {}
 
 void PSOldGen::initialize(ReservedSpace rs, size_t alignment,
@@ -145,6 +149,30 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
 
   // Update the start_array
   start_array()->set_covered_region(cmr);
+
+  if (UseNUMA && UseNUMAOldGen) {
+    initialize_numa_chunks();
+  }
+}
+
+void PSOldGen::initialize_numa_chunks() {
+  int lgrp_limit = (int)os::numa_get_groups_num();
+  int* lgrp_ids = NEW_C_HEAP_ARRAY(int, lgrp_limit, mtGC);
+  int lgrp_num = (int)os::numa_get_leaf_groups(lgrp_ids, lgrp_limit);
+  assert(lgrp_num > 0, "There should be at least one locality group");
+
+  _numa_page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+  _numa_chunk_words = align_size_up(MAX2(NUMAOldGenChunkSize, 4 * OldPLABSize * HeapWordSize),
+                                    _numa_page_size) / HeapWordSize;
+  _numa_chunks = NEW_C_HEAP_ARRAY(NUMAChunk, lgrp_num, mtGC);
+  for (int i = 0; i < lgrp_num; i++) {
+    _numa_chunks[i].lgrp_id = lgrp_ids[i];
+    _numa_chunks[i].lock = new Mutex(Mutex::leaf, "PSOldGen NUMA chunk lock", true);
+    _numa_chunks[i].top = NULL;
+    _numa_chunks[i].end = NULL;
+  }
+  _numa_chunk_count = lgrp_num;
+  FREE_C_HEAP_ARRAY(int, lgrp_ids, mtGC);
 }
 
 void PSOldGen::initialize_performance_counters(const char* perf_data_name, int level) {
@@ -206,6 +234,86 @@ HeapWord* PSOldGen::allocate(size_t word_size) {
   return res;
 }
 
+HeapWord* PSOldGen::cas_allocate_lab(size_t word_size) {
+  if (_numa_chunks != NULL) {
+    NUMAChunk* chunk = numa_chunk_for_current_thread();
+    if (chunk != NULL) {
+      HeapWord* res = numa_cas_allocate_lab(chunk, word_size);
+      if (res != NULL) {
+        return res;
+      }
+    }
+  }
+  // No NUMA chunk, or no room for a new one without expanding.
+  return cas_allocate(word_size);
+}
+
+PSOldGen::NUMAChunk* PSOldGen::numa_chunk_for_current_thread() {
+  Thread* thr = Thread::current();
+  int lgrp_id = thr->lgrp_id();
+  if (lgrp_id == -1 || !os::numa_has_group_homing()) {
+    lgrp_id = os::numa_get_group_id();
+    thr->set_lgrp_id(lgrp_id);
+  }
+  for (int i = 0; i < _numa_chunk_count; i++) {
+    if (_numa_chunks[i].lgrp_id == lgrp_id) {
+      return &_numa_chunks[i];
+    }
+  }
+  // A CPU may have been hotplugged since the chunks were set up.
+  return NULL;
+}
+
+HeapWord* PSOldGen::numa_cas_allocate_lab(NUMAChunk* chunk, size_t word_size) {
+  MutexLockerEx ml(chunk->lock, Mutex::_no_safepoint_check_flag);
+  size_t remaining = pointer_delta(chunk->end, chunk->top);
+  // Never leave a tail too small to be filled.
+  if (remaining != word_size &&
+      remaining < word_size + CollectedHeap::min_fill_size()) {
+    retire_numa_chunk(chunk);
+    // Expanding is left to the caller, which does not hold the chunk lock.
+    HeapWord* base = cas_allocate_noexpand(_numa_chunk_words);
+    if (base == NULL) {
+      return NULL;
+    }
+    // The chunk lies above top, so its pages hold no objects and can be
+    // released and rebound to the worker's node; they are faulted in there
+    // when the promoted objects are copied.
+    char* start = (char*)round_to((intptr_t)base, _numa_page_size);
+    char* end = (char*)round_down((intptr_t)(base + _numa_chunk_words), _numa_page_size);
+    if (end > start) {
+      os::realign_memory(start, end - start, _numa_page_size);
+      os::free_memory(start, end - start, _numa_page_size);
+      os::numa_make_local(start, end - start, chunk->lgrp_id);
+    }
+    chunk->top = base;
+    chunk->end = base + _numa_chunk_words;
+  }
+  HeapWord* res = chunk->top;
+  chunk->top += word_size;
+  return res;
+}
+
+void PSOldGen::retire_numa_chunk(NUMAChunk* chunk) {
+  if (chunk->top < chunk->end) {
+    HeapWord* addr = chunk->top;
+    CollectedHeap::fill_with_objects(addr, pointer_delta(chunk->end, addr));
+    do {
+      _start_array.allocate_block(addr);
+      addr += oop(addr)->size();
+    } while (addr < chunk->end);
+  }
+  chunk->top = NULL;
+  chunk->end = NULL;
+}
+
+void PSOldGen::retire_numa_chunks() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must only be called at safepoint");
+  for (int i = 0; i < _numa_chunk_count; i++) {
+    retire_numa_chunk(&_numa_chunks[i]);
+  }
+}
+
 HeapWord* PSOldGen::expand_and_allocate(size_t word_size) {
   expand(word_size*HeapWordSize);
   if (GCExpandToAllocateDelayMillis > 0) {
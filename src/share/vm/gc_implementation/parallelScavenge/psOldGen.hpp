@@ -57,6 +57,25 @@ class PSOldGen : public CHeapObj<mtGC> {
   const size_t _min_gen_size;
   const size_t _max_gen_size;
 
+  // UseNUMAOldGen: each locality group has a chunk of the old gen, bound to
+  // its memory, that the promotion LABs of GC workers running there are
+  // carved from.  The chunks only exist during a scavenge.
+  struct NUMAChunk {
+    int       lgrp_id;
+    Mutex*    lock;
+    HeapWord* top;
+    HeapWord* end;
+  };
+  NUMAChunk* _numa_chunks;
+  int        _numa_chunk_count;
+  size_t     _numa_chunk_words;
+  size_t     _numa_page_size;
+
+  void initialize_numa_chunks();
+  NUMAChunk* numa_chunk_for_current_thread();
+  HeapWord* numa_cas_allocate_lab(NUMAChunk* chunk, size_t word_size);
+  void retire_numa_chunk(NUMAChunk* chunk);
+
   // Used when initializing the _name field.
   static inline const char* select_name();
 
@@ -88,6 +107,10 @@ class PSOldGen : public CHeapObj<mtGC> {
     return (res == NULL) ? expand_and_cas_allocate(word_size) : res;
   }
 
+  // Allocate a promotion LAB, from the calling worker's NUMA chunk if
+  // UseNUMAOldGen is in effect.
+  HeapWord* cas_allocate_lab(size_t word_size);
+
   HeapWord* expand_and_allocate(size_t word_size);
   HeapWord* expand_and_cas_allocate(size_t word_size);
   void expand(size_t bytes);
@@ -162,6 +185,10 @@ class PSOldGen : public CHeapObj<mtGC> {
   // Calculating new sizes
   void resize(size_t desired_free_space);
 
+  // Fill the unused parts of the NUMA chunks and drop them.  Called at the
+  // end of a scavenge.
+  void retire_numa_chunks();
+
   // Allocation. We report all successful allocations to the size policy
   // Note that the perm gen does not use this method, and should not!
   HeapWord* allocate(size_t word_size);
@@ -2526,6 +2526,8 @@ void PSParallelCompact::enqueue_region_draining_tasks(GCTaskQueue* q,
 
     for (size_t cur = end_region - 1; cur + 1 > beg_region; --cur) {
       if (sd.region(cur)->claim_unsafe()) {
+        bool normal = sd.region(cur)->mark_normal();
+        assert(normal, "no shadow regions before compaction starts");
         ParCompactionManager::region_list_push(which, cur);
 
         if (TraceParallelOldGCCompactionPhase && Verbose) {
@@ -2698,6 +2700,10 @@ void PSParallelCompact::compact() {
   TaskQueueSetSuper* qset = ParCompactionManager::region_array();
   TaskTerminator terminator(active_gc_threads, qset);
 
+  if (UseParallelOldGCShadowRegions) {
+    initialize_shadow_regions(parallel_gc_threads, active_gc_threads);
+  }
+
   GCTaskQueue* q = GCTaskQueue::create();
   enqueue_region_draining_tasks(q, active_gc_threads);
   enqueue_dense_prefix_tasks(q, active_gc_threads);
@@ -2707,6 +2713,7 @@ void PSParallelCompact::compact() {
     GCTraceTime tm_pc("par compact", print_phases(), true, &_gc_timer, _gc_tracer.gc_id());
 
     gc_task_manager()->execute_and_wait(q);
+    ParCompactionManager::remove_all_shadow_regions();
 
 #ifdef  ASSERT
     // Verify that all regions have been processed before the deferred updates.
@@ -3002,7 +3009,17 @@ void PSParallelCompact::decrement_destination_counts(ParCompactionManager* cm,
     assert(cur->data_size() > 0, "region must have live data");
     cur->decrement_destination_count();
     if (cur < enqueue_end && cur->available() && cur->claim()) {
-      cm->push_region(sd.region(cur));
+      if (cur->mark_normal()) {
+        cm->push_region(sd.region(cur));
+      } else if (cur->mark_copied()) {
+        // The region was filled in a shadow region, which can be copied
+        // back now.  If the shadow region is still being filled, the thread
+        // filling it copies it back (see
+        // MoveAndUpdateShadowClosure::complete_region()).
+        copy_back(sd.region_to_addr(cur->shadow_region()), sd.region_to_addr(cur));
+        ParCompactionManager::push_shadow_region_mt_safe(cur->shadow_region());
+        cur->set_completed();
+      }
     }
   }
 }
@@ -3080,28 +3097,23 @@ size_t PSParallelCompact::next_src_region(MoveAndUpdateClosure& closure,
   return 0;
 }
 
-void PSParallelCompact::fill_region(ParCompactionManager* cm, size_t region_idx)
+void PSParallelCompact::fill_region(ParCompactionManager* cm,
+                                    MoveAndUpdateClosure& closure,
+                                    size_t region_idx)
 {
   typedef ParMarkBitMap::IterationStatus IterationStatus;
-  const size_t RegionSize = ParallelCompactData::RegionSize;
   ParMarkBitMap* const bitmap = mark_bitmap();
   ParallelCompactData& sd = summary_data();
   RegionData* const region_ptr = sd.region(region_idx);
 
-  // Get the items needed to construct the closure.
   HeapWord* dest_addr = sd.region_to_addr(region_idx);
-  SpaceId dest_space_id = space_id(dest_addr);
-  ObjectStartArray* start_array = _space_info[dest_space_id].start_array();
-  HeapWord* new_top = _space_info[dest_space_id].new_top();
-  assert(dest_addr < new_top, "sanity");
-  const size_t words = MIN2(pointer_delta(new_top, dest_addr), RegionSize);
+  assert(closure.destination() == dest_addr, "closure set up for another region");
 
   // Get the source region and related info.
   size_t src_region_idx = region_ptr->source_region();
   SpaceId src_space_id = space_id(sd.region_to_addr(src_region_idx));
   HeapWord* src_space_top = _space_info[src_space_id].space()->top();
 
-  MoveAndUpdateClosure closure(bitmap, cm, start_array, dest_addr, words);
   closure.set_source(first_src_addr(dest_addr, src_space_id, src_region_idx));
 
   // Adjust src_region_idx to prepare for decrementing destination counts (the
@@ -3120,7 +3132,7 @@ void PSParallelCompact::fill_region(ParCompactionManager* cm, size_t region_idx)
       decrement_destination_counts(cm, src_space_id, src_region_idx,
                                    closure.source());
       region_ptr->set_deferred_obj_addr(NULL);
-      region_ptr->set_completed();
+      closure.complete_region(cm, dest_addr, region_ptr);
       return;
     }
 
@@ -3169,7 +3181,7 @@ void PSParallelCompact::fill_region(ParCompactionManager* cm, size_t region_idx)
 
       decrement_destination_counts(cm, src_space_id, src_region_idx,
                                    closure.source());
-      region_ptr->set_completed();
+      closure.complete_region(cm, dest_addr, region_ptr);
       return;
     }
 
@@ -3177,7 +3189,7 @@ void PSParallelCompact::fill_region(ParCompactionManager* cm, size_t region_idx)
       decrement_destination_counts(cm, src_space_id, src_region_idx,
                                    closure.source());
       region_ptr->set_deferred_obj_addr(NULL);
-      region_ptr->set_completed();
+      closure.complete_region(cm, dest_addr, region_ptr);
       return;
     }
 
@@ -3190,6 +3202,112 @@ void PSParallelCompact::fill_region(ParCompactionManager* cm, size_t region_idx)
   } while (true);
 }
 
+void PSParallelCompact::fill_and_update_region(ParCompactionManager* cm,
+                                               size_t region_idx)
+{
+  ParallelCompactData& sd = summary_data();
+  HeapWord* dest_addr = sd.region_to_addr(region_idx);
+  SpaceId dest_space_id = space_id(dest_addr);
+  ObjectStartArray* start_array = _space_info[dest_space_id].start_array();
+  HeapWord* new_top = _space_info[dest_space_id].new_top();
+  assert(dest_addr < new_top, "sanity");
+  const size_t words = MIN2(pointer_delta(new_top, dest_addr),
+                            ParallelCompactData::RegionSize);
+
+  MoveAndUpdateClosure closure(mark_bitmap(), cm, start_array, dest_addr, words);
+  fill_region(cm, closure, region_idx);
+}
+
+void PSParallelCompact::fill_and_update_shadow_region(ParCompactionManager* cm,
+                                                      size_t region_idx)
+{
+  ParallelCompactData& sd = summary_data();
+  RegionData* const region_ptr = sd.region(region_idx);
+  HeapWord* dest_addr = sd.region_to_addr(region_idx);
+  SpaceId dest_space_id = space_id(dest_addr);
+  ObjectStartArray* start_array = _space_info[dest_space_id].start_array();
+  HeapWord* new_top = _space_info[dest_space_id].new_top();
+  assert(dest_addr < new_top, "sanity");
+  const size_t words = MIN2(pointer_delta(new_top, dest_addr),
+                            ParallelCompactData::RegionSize);
+
+  size_t shadow = ParCompactionManager::pop_shadow_region_mt_safe(region_idx);
+  if (shadow == ParCompactionManager::InvalidShadow) {
+    // The region became available while waiting for a shadow region and has
+    // been claimed; nobody else will fill it, so fill it in place.
+    region_ptr->shadow_to_normal();
+    MoveAndUpdateClosure closure(mark_bitmap(), cm, start_array, dest_addr, words);
+    fill_region(cm, closure, region_idx);
+  } else {
+    MoveAndUpdateShadowClosure closure(mark_bitmap(), cm, start_array, dest_addr,
+                                       words, shadow);
+    fill_region(cm, closure, region_idx);
+  }
+}
+
+void PSParallelCompact::copy_back(HeapWord* shadow_addr, HeapWord* region_addr)
+{
+  Copy::aligned_conjoint_words(shadow_addr, region_addr,
+                               ParallelCompactData::RegionSize);
+}
+
+bool PSParallelCompact::steal_unavailable_region(ParCompactionManager* cm,
+                                                 size_t& region_idx)
+{
+  ParallelCompactData& sd = summary_data();
+  const size_t end_region =
+    sd.addr_to_region_idx(sd.region_align_up(_space_info[old_space_id].new_top()));
+
+  size_t next = cm->next_shadow_region();
+  while (next < end_region) {
+    if (sd.region(next)->mark_shadow()) {
+      cm->move_next_shadow_region_by(cm->shadow_region_stride());
+      region_idx = next;
+      return true;
+    }
+    next = cm->move_next_shadow_region_by(cm->shadow_region_stride());
+  }
+  return false;
+}
+
+// Shadow regions resolve the dependencies between regions during
+// compaction.  A region can normally be filled only when all of its live
+// data has been copied out (its destination count is zero), so at the end
+// of compaction most threads idle while a few chains of dependent regions
+// are worked off.  An idle thread instead claims an unavailable old gen
+// region and fills an empty "shadow" region with the data destined for it;
+// the shadow is copied back when the region becomes available.  Shadow
+// regions are the empty regions above new_top (and top) of each space.
+void PSParallelCompact::initialize_shadow_regions(uint parallel_gc_threads,
+                                                  uint active_gc_threads)
+{
+  const ParallelCompactData& sd = summary_data();
+
+  for (unsigned int id = old_space_id; id < last_space_id; ++id) {
+    SpaceInfo* const space_info = _space_info + id;
+    MutableSpace* const space = space_info->space();
+
+    const size_t beg_region = sd.addr_to_region_idx(
+      sd.region_align_up(MAX2(space_info->new_top(), space->top())));
+    const size_t end_region =
+      sd.addr_to_region_idx(sd.region_align_down(space->end()));
+
+    for (size_t cur = beg_region; cur < end_region; ++cur) {
+      ParCompactionManager::push_shadow_region(cur);
+    }
+  }
+
+  // Each thread walks the unavailable old gen regions from the dense prefix
+  // up, interleaved with the other threads.
+  const size_t beg_region =
+    sd.addr_to_region_idx(_space_info[old_space_id].dense_prefix());
+  for (uint i = 0; i < parallel_gc_threads; i++) {
+    ParCompactionManager* cm = ParCompactionManager::manager_array(i);
+    cm->set_next_shadow_region(beg_region + i % active_gc_threads);
+    cm->set_shadow_region_stride(active_gc_threads);
+  }
+}
+
 void PSParallelCompact::fill_blocks(size_t region_idx)
 {
   // Fill in the block table elements for the specified region.  Each block
@@ -3302,9 +3420,9 @@ void PSParallelCompact::reset_millis_since_last_gc() {
 
 ParMarkBitMap::IterationStatus MoveAndUpdateClosure::copy_until_full()
 {
-  if (source() != destination()) {
+  if (source() != copy_destination()) {
     DEBUG_ONLY(PSParallelCompact::check_new_location(source(), destination());)
-    Copy::aligned_conjoint_words(source(), destination(), words_remaining());
+    Copy::aligned_conjoint_words(source(), copy_destination(), words_remaining());
   }
   update_state(words_remaining());
   assert(is_full(), "sanity");
@@ -3323,13 +3441,42 @@ void MoveAndUpdateClosure::copy_partial_obj()
 
   // This test is necessary; if omitted, the pointer updates to a partial object
   // that crosses the dense prefix boundary could be overwritten.
-  if (source() != destination()) {
+  if (source() != copy_destination()) {
     DEBUG_ONLY(PSParallelCompact::check_new_location(source(), destination());)
-    Copy::aligned_conjoint_words(source(), destination(), words);
+    Copy::aligned_conjoint_words(source(), copy_destination(), words);
   }
   update_state(words);
 }
 
+void MoveAndUpdateClosure::complete_region(ParCompactionManager* cm,
+                                           HeapWord* dest_addr,
+                                           PSParallelCompact::RegionData* region_ptr)
+{
+  assert(region_ptr->shadow_state() == ParallelCompactData::RegionData::NormalRegion,
+         "region must be filled in place");
+  region_ptr->set_completed();
+}
+
+void MoveAndUpdateShadowClosure::complete_region(ParCompactionManager* cm,
+                                                 HeapWord* dest_addr,
+                                                 PSParallelCompact::RegionData* region_ptr)
+{
+  assert(region_ptr->shadow_state() == ParallelCompactData::RegionData::ShadowRegion,
+         "region must be filled in a shadow region");
+  region_ptr->set_shadow_region(_shadow);
+  region_ptr->mark_filled();
+  // Copy the shadow region back if the region is available now; otherwise
+  // the thread that makes it available does (see
+  // PSParallelCompact::decrement_destination_counts()).
+  if (((region_ptr->available() && region_ptr->claim()) || region_ptr->claimed()) &&
+      region_ptr->mark_copied()) {
+    region_ptr->set_completed();
+    PSParallelCompact::copy_back(
+      PSParallelCompact::summary_data().region_to_addr(_shadow), dest_addr);
+    ParCompactionManager::push_shadow_region_mt_safe(_shadow);
+  }
+}
+
 ParMarkBitMapClosure::IterationStatus
 MoveAndUpdateClosure::do_addr(HeapWord* addr, size_t words) {
   assert(destination() != NULL, "sanity");
@@ -3348,17 +3495,17 @@ MoveAndUpdateClosure::do_addr(HeapWord* addr, size_t words) {
     _start_array->allocate_block(destination());
   }
 
-  if (destination() != source()) {
+  if (copy_destination() != source()) {
     DEBUG_ONLY(PSParallelCompact::check_new_location(source(), destination());)
-    Copy::aligned_conjoint_words(source(), destination(), words);
+    Copy::aligned_conjoint_words(source(), copy_destination(), words);
   }
 
-  oop moved_oop = (oop) destination();
+  oop moved_oop = (oop) copy_destination();
   moved_oop->update_contents(compaction_manager());
   assert(moved_oop->is_oop_or_null(), "Object should be whole at this point");
 
   update_state(words);
-  assert(destination() == (HeapWord*)moved_oop + moved_oop->size(), "sanity");
+  assert(copy_destination() == (HeapWord*)moved_oop + moved_oop->size(), "sanity");
   return is_full() ? ParMarkBitMap::full : ParMarkBitMap::incomplete;
 }
 
@@ -329,6 +329,31 @@ public:
     inline void decrement_destination_count();
     inline bool claim();
 
+    // Shadow region states (see PSParallelCompact::initialize_shadow_regions).
+    // A region is filled either in place or through a shadow region:
+    //
+    //   UnusedRegion -> mark_normal() -> NormalRegion
+    //   UnusedRegion -> mark_shadow() -> ShadowRegion -> mark_filled() ->
+    //     FilledShadow -> mark_copied() -> CopiedShadow
+    static const int UnusedRegion = 0; // Not yet claimed for filling.
+    static const int ShadowRegion = 1; // Being filled in a shadow region.
+    static const int FilledShadow = 2; // Shadow filled, awaiting copy back.
+    static const int CopiedShadow = 3; // Shadow copied back to the region.
+    static const int NormalRegion = 4; // Filled in place.
+
+    int shadow_state() const                   { return _shadow_state; }
+    size_t shadow_region() const               { return _shadow_region; }
+    void set_shadow_region(size_t region)      { _shadow_region = region; }
+
+    // These are atomic.
+    inline bool mark_normal();
+    inline bool mark_shadow();
+    inline void mark_filled();
+    inline bool mark_copied();
+    // The region became available before a shadow region could be obtained
+    // for it; it is filled in place after all.
+    inline void shadow_to_normal();
+
   private:
     // The type used to represent object sizes within a region.
     typedef uint region_sz_t;
@@ -349,6 +374,8 @@ public:
     region_sz_t          _partial_obj_size;
     region_sz_t volatile _dc_and_los;
     bool        volatile _blocks_filled;
+    int         volatile _shadow_state;
+    size_t               _shadow_region;
 
 #ifdef ASSERT
     size_t               _blocks_filled_count;   // Number of block table fills.
@@ -600,6 +627,34 @@ inline bool ParallelCompactData::RegionData::claim()
   return old == los;
 }
 
+inline bool ParallelCompactData::RegionData::mark_normal()
+{
+  return Atomic::cmpxchg(NormalRegion, &_shadow_state, UnusedRegion) == UnusedRegion;
+}
+
+inline bool ParallelCompactData::RegionData::mark_shadow()
+{
+  if (_shadow_state != UnusedRegion) return false;
+  return Atomic::cmpxchg(ShadowRegion, &_shadow_state, UnusedRegion) == UnusedRegion;
+}
+
+inline void ParallelCompactData::RegionData::mark_filled()
+{
+  int old = Atomic::cmpxchg(FilledShadow, &_shadow_state, ShadowRegion);
+  assert(old == ShadowRegion, "region must be a shadow region");
+}
+
+inline bool ParallelCompactData::RegionData::mark_copied()
+{
+  return Atomic::cmpxchg(CopiedShadow, &_shadow_state, FilledShadow) == FilledShadow;
+}
+
+inline void ParallelCompactData::RegionData::shadow_to_normal()
+{
+  int old = Atomic::cmpxchg(NormalRegion, &_shadow_state, ShadowRegion);
+  assert(old == ShadowRegion, "region must be a shadow region");
+}
+
 inline ParallelCompactData::RegionData*
 ParallelCompactData::region(size_t region_idx) const
 {
@@ -1275,11 +1330,32 @@ class PSParallelCompact : AllStatic {
                                            size_t beg_region,
                                            HeapWord* end_addr);
 
-  // Fill a region, copying objects from one or more source regions.
-  static void fill_region(ParCompactionManager* cm, size_t region_idx);
-  static void fill_and_update_region(ParCompactionManager* cm, size_t region) {
-    fill_region(cm, region);
-  }
+  // Fill a region, copying objects from one or more source regions.  The
+  // closure determines whether the data is written to the region itself or
+  // to a shadow region.
+  static void fill_region(ParCompactionManager* cm,
+                          MoveAndUpdateClosure& closure,
+                          size_t region_idx);
+  static void fill_and_update_region(ParCompactionManager* cm, size_t region);
+
+  // Fill a region that is not yet available (its destination count is not
+  // zero) in a shadow region, which is copied back once the region becomes
+  // available.
+  static void fill_and_update_shadow_region(ParCompactionManager* cm,
+                                            size_t region);
+
+  // Claim, for shadow filling, an old gen region that is not yet available.
+  // Return false if there are none left for this thread.
+  static bool steal_unavailable_region(ParCompactionManager* cm,
+                                       size_t& region_idx);
+
+  // Record the empty regions that can serve as shadow regions and set up
+  // each thread's cursor for steal_unavailable_region().
+  static void initialize_shadow_regions(uint parallel_gc_threads,
+                                       uint active_gc_threads);
+
+  // Copy a filled shadow region back to the region it stands in for.
+  static void copy_back(HeapWord* shadow_addr, HeapWord* region_addr);
 
   // Fill in the block table for the specified region.
   static void fill_blocks(size_t region_idx);
@@ -1470,6 +1546,10 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
   // Accessors.
   HeapWord* destination() const         { return _destination; }
 
+  // Where the data for destination() is actually written; differs from
+  // destination() when a shadow region is being filled.
+  HeapWord* copy_destination() const    { return _destination + _offset; }
+
   // If the object will fit (size <= words_remaining()), copy it to the current
   // destination, update the interior oops and the start array and return either
   // full (if the closure is full) or incomplete.  If the object will not fit,
@@ -1485,6 +1565,10 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
   // array are not updated.
   void copy_partial_obj();
 
+  // Mark the region as completed after it has been filled.
+  virtual void complete_region(ParCompactionManager* cm, HeapWord* dest_addr,
+                               PSParallelCompact::RegionData* region_ptr);
+
  protected:
   // Update variables to indicate that word_count words were processed.
   inline void update_state(size_t word_count);
@@ -1492,6 +1576,7 @@ class MoveAndUpdateClosure: public ParMarkBitMapClosure {
  protected:
   ObjectStartArray* const _start_array;
   HeapWord*               _destination;         // Next addr to be written.
+  size_t                  _offset;              // Shadow region offset.
 };
 
 inline
@@ -1500,7 +1585,8 @@ MoveAndUpdateClosure::MoveAndUpdateClosure(ParMarkBitMap* bitmap,
                                            ObjectStartArray* start_array,
                                            HeapWord* destination,
                                            size_t words) :
-  ParMarkBitMapClosure(bitmap, cm, words), _start_array(start_array)
+  ParMarkBitMapClosure(bitmap, cm, words), _start_array(start_array),
+  _offset(0)
 {
   _destination = destination;
 }
@@ -1512,6 +1598,39 @@ inline void MoveAndUpdateClosure::update_state(size_t words)
   _destination += words;
 }
 
+// Fills a shadow region in place of the region at destination().  Object
+// start and interior pointers are computed for the real destination; only
+// the copies go to the shadow region.
+class MoveAndUpdateShadowClosure: public MoveAndUpdateClosure {
+ public:
+  inline MoveAndUpdateShadowClosure(ParMarkBitMap* bitmap,
+                                    ParCompactionManager* cm,
+                                    ObjectStartArray* start_array,
+                                    HeapWord* destination, size_t words,
+                                    size_t shadow);
+
+  virtual void complete_region(ParCompactionManager* cm, HeapWord* dest_addr,
+                               PSParallelCompact::RegionData* region_ptr);
+
+ private:
+  size_t _shadow;
+};
+
+inline
+MoveAndUpdateShadowClosure::MoveAndUpdateShadowClosure(ParMarkBitMap* bitmap,
+                                                       ParCompactionManager* cm,
+                                                       ObjectStartArray* start_array,
+                                                       HeapWord* destination,
+                                                       size_t words,
+                                                       size_t shadow) :
+  MoveAndUpdateClosure(bitmap, cm, start_array, destination, words),
+  _shadow(shadow)
+{
+  // Unsigned wrap-around makes this work for shadows below the destination.
+  HeapWord* shadow_addr = PSParallelCompact::summary_data().region_to_addr(shadow);
+  _offset = (size_t)(shadow_addr - destination);
+}
+
 class UpdateOnlyClosure: public ParMarkBitMapClosure {
  private:
   const PSParallelCompact::SpaceId _space_id;
@@ -101,6 +101,7 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
     }
     manager->flush_labs();
   }
+  old_gen()->retire_numa_chunks();
   return promotion_failure_occurred;
 }
 
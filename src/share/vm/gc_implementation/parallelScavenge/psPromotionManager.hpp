@@ -206,6 +206,10 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
 
   template <class T> inline void claim_or_forward_depth(T* p);
 
+  // Push the elements of the object array that lie in [left, right).
+  inline void push_contents_bounded(objArrayOop obj, HeapWord* left, HeapWord* right);
+  template <class T> inline void push_array_range_depth(T* beg, T* end);
+
   TASKQUEUE_STATS_ONLY(inline void record_steal(StarTask& p);)
 };
 
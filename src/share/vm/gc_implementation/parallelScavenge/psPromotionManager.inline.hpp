@@ -29,6 +29,7 @@
 #include "gc_implementation/parallelScavenge/psPromotionManager.hpp"
 #include "gc_implementation/parallelScavenge/psPromotionLAB.inline.hpp"
 #include "gc_implementation/parallelScavenge/psScavenge.hpp"
+#include "oops/objArrayOop.hpp"
 #include "oops/oop.psgc.inline.hpp"
 
 inline PSPromotionManager* PSPromotionManager::manager_array(int index) {
@@ -64,6 +65,31 @@ inline void PSPromotionManager::claim_or_forward_depth(T* p) {
   claim_or_forward_internal_depth(p);
 }
 
+template <class T>
+inline void PSPromotionManager::push_array_range_depth(T* beg, T* end) {
+  for (T* p = beg; p < end; p++) {
+    if (PSScavenge::should_scavenge(p)) {
+      claim_or_forward_depth(p);
+    }
+  }
+}
+
+inline void PSPromotionManager::push_contents_bounded(objArrayOop obj,
+                                                      HeapWord* left,
+                                                      HeapWord* right) {
+  if (UseCompressedOops) {
+    narrowOop* const base = (narrowOop*)obj->base();
+    narrowOop* const beg = MAX2((narrowOop*)left, base);
+    narrowOop* const end = MIN2((narrowOop*)right, base + obj->length());
+    push_array_range_depth(beg, end);
+  } else {
+    oop* const base = (oop*)obj->base();
+    oop* const beg = MAX2((oop*)left, base);
+    oop* const end = MIN2((oop*)right, base + obj->length());
+    push_array_range_depth(beg, end);
+  }
+}
+
 inline void PSPromotionManager::promotion_trace_event(oop new_obj, oop old_obj,
                                                       size_t obj_size,
                                                       uint age, bool tenured,
@@ -166,7 +192,7 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
             // Flush and fill
             _old_lab.flush();
 
-            HeapWord* lab_base = old_gen()->cas_allocate(OldPLABSize);
+            HeapWord* lab_base = old_gen()->cas_allocate_lab(OldPLABSize);
             if(lab_base != NULL) {
 #ifdef ASSERT
               // Delay the initialization of the promotion lab (plab).
@@ -405,8 +405,10 @@ bool PSScavenge::invoke_no_policy() {
         // There are only old-to-young pointers if there are objects
         // in the old gen.
         uint stripe_total = active_workers;
+        uint stripe_size = card_table()->scavenge_stripe_size(old_gen->object_space(),
+                                                              old_top, stripe_total);
         for(uint i=0; i < stripe_total; i++) {
-          q->enqueue(new OldToYoungRootsTask(old_gen, old_top, i, stripe_total));
+          q->enqueue(new OldToYoungRootsTask(old_gen, old_top, i, stripe_total, stripe_size));
         }
       }
 
@@ -190,7 +190,8 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
                                            _gen_top,
                                            pm,
                                            _stripe_number,
-                                           _stripe_total);
+                                           _stripe_total,
+                                           _stripe_size);
 
     // Do the real work
     pm->drain_stacks(false);
@@ -153,7 +153,8 @@ class StealTask : public GCTask {
 // of tasks created.  In scavenge_contents_parallel the distance
 // to the next stripe is calculated based on the number of tasks.
 // If the stripe width is ssize, a task's next stripe is at
-// ssize * number_of_tasks (= slice_stride).  In this case after
+// ssize * number_of_tasks (= slice_stride).  ssize is the same for all
+// tasks of a scavenge (see CardTableExtension::scavenge_stripe_size()).  In this case after
 // finishing stripe 0 in slice 0, the thread finds the stripe 0 in slice1
 // by adding slice_stride to the start of stripe 0 in slice 0 to get
 // to the start of stride 0 in slice 1.
@@ -164,16 +165,19 @@ class OldToYoungRootsTask : public GCTask {
   HeapWord* _gen_top;
   uint _stripe_number;
   uint _stripe_total;
+  uint _stripe_size;
 
  public:
   OldToYoungRootsTask(PSOldGen *gen,
                       HeapWord* gen_top,
                       uint stripe_number,
-                      uint stripe_total) :
+                      uint stripe_total,
+                      uint stripe_size) :
     _gen(gen),
     _gen_top(gen_top),
     _stripe_number(stripe_number),
-    _stripe_total(stripe_total) { }
+    _stripe_total(stripe_total),
+    _stripe_size(stripe_size) { }
 
   char* name() { return (char *)"old-to-young-roots-task"; }
 
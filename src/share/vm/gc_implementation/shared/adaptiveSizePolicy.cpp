@@ -26,6 +26,7 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_interface/gcCause.hpp"
 #include "memory/collectorPolicy.hpp"
+#include "runtime/activeProcessorTracker.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/workgroup.hpp"
@@ -199,6 +200,7 @@ int AdaptiveSizePolicy::calc_active_workers(uintx total_workers,
                                                      active_workers,
                                                      application_workers);
   }
+  new_active_workers = ActiveProcessorTracker::limit_parallel_workers(new_active_workers);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
@@ -208,14 +210,14 @@ int AdaptiveSizePolicy::calc_active_conc_workers(uintx total_workers,
                                                  uintx application_workers) {
   if (!UseDynamicNumberOfGCThreads ||
      (!FLAG_IS_DEFAULT(ConcGCThreads) && !ForceDynamicNumberOfGCThreads)) {
-    return ConcGCThreads;
+    return ActiveProcessorTracker::limit_conc_workers(ConcGCThreads);
   } else {
     int no_of_gc_threads = calc_default_active_workers(
                              total_workers,
                              1, /* Minimum number of workers */
                              active_workers,
                              application_workers);
-    return no_of_gc_threads;
+    return ActiveProcessorTracker::limit_conc_workers(no_of_gc_threads);
   }
 }
 
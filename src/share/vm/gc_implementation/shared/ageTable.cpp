@@ -37,6 +37,13 @@
 ageTable::ageTable(bool global) {
 
   clear();
+  for (int age = 0; age < table_size; age++) {
+    _prev_sizes[age] = 0;
+    _survival_rates[age] = -1.0;
+  }
+  _prev_threshold = 0;
+  _prev_collections = 0;
+  _has_prev_sizes = false;
 
   if (UsePerfData && global) {
 
@@ -79,7 +86,71 @@ void ageTable::merge_par(ageTable* subTable) {
   }
 }
 
-uint ageTable::compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tracer) {
+// The objects of age a-1 left in the survivor space by the previous young
+// collection were either copied again with age a or died, unless a-1 had
+// reached the threshold and they were promoted.
+void ageTable::sample_survival_rates() {
+  unsigned int collections = SharedHeap::heap()->total_collections();
+  if (_has_prev_sizes && collections == _prev_collections + 1) {
+    const double weight = AdaptiveSizePolicyWeight / 100.0;
+    for (uint age = 2; age < table_size && age <= _prev_threshold; age++) {
+      if (_prev_sizes[age - 1] == 0) {
+        continue;
+      }
+      double sample = MIN2(1.0, (double)sizes[age] / (double)_prev_sizes[age - 1]);
+      if (_survival_rates[age] < 0.0) {
+        _survival_rates[age] = sample;
+      } else {
+        _survival_rates[age] = (1.0 - weight) * _survival_rates[age] + weight * sample;
+      }
+    }
+  }
+  for (int age = 0; age < table_size; age++) {
+    _prev_sizes[age] = sizes[age];
+  }
+  _prev_collections = collections;
+  _has_prev_sizes = true;
+}
+
+// With threshold t the objects are copied t times, and the ones that
+// survive once more are promoted.  In a steady state the volume that
+// reaches age k is V(k) = V(k-1) * rate(k), V(1) being sizes[1], so a
+// young collection costs
+//   V(1) + ... + V(t) + TenuringPromotionCost * V(t+1)
+// and t is chosen to minimize that.  Raising the threshold pays off as
+// long as more than 1/TenuringPromotionCost of the objects die before
+// their next collection.
+uint ageTable::cost_optimal_tenuring_threshold(uint max_threshold) const {
+  if (sizes[1] == 0) {
+    return max_threshold;
+  }
+  double volume = (double)sizes[1];
+  double copied = 0.0;
+  double best_cost = 0.0;
+  uint best = max_threshold;
+  for (uint t = 1; t <= max_threshold; t++) {
+    copied += volume;
+    if (t + 1 >= table_size || _survival_rates[t + 1] < 0.0) {
+      // No estimate beyond t.  If raising the threshold was still paying
+      // off, leave it to the survivor space size.
+      if (t == 1 || best == t - 1) {
+        best = max_threshold;
+      }
+      break;
+    }
+    double next = volume * _survival_rates[t + 1];
+    double cost = copied + TenuringPromotionCost * next;
+    if (t == 1 || cost < best_cost) {
+      best_cost = cost;
+      best = t;
+    }
+    volume = next;
+  }
+  return best;
+}
+
+uint ageTable::compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tracer,
+                                          bool use_survival_rates) {
   size_t desired_survivor_size = (size_t)((((double) survivor_capacity)*TargetSurvivorRatio)/100);
   size_t total = 0;
   uint age = 1;
@@ -92,6 +163,12 @@ uint ageTable::compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tr
     age++;
   }
   uint result = age < MaxTenuringThreshold ? age : MaxTenuringThreshold;
+  uint survivor_limit = result;
+  if (use_survival_rates) {
+    sample_survival_rates();
+    result = MAX2(1u, MIN2(result, cost_optimal_tenuring_threshold(result)));
+    _prev_threshold = result;
+  }
 
   if (PrintTenuringDistribution || UsePerfData || AgeTableTracer::is_tenuring_distribution_event_enabled()) {
 
@@ -99,6 +176,15 @@ uint ageTable::compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tr
       gclog_or_tty->cr();
       gclog_or_tty->print_cr("Desired survivor size " SIZE_FORMAT " bytes, new threshold %u (max %u)",
         desired_survivor_size*oopSize, result, (int) MaxTenuringThreshold);
+      if (use_survival_rates) {
+        gclog_or_tty->print("Survivor size limits the threshold to %u, survival rates:", survivor_limit);
+        for (uint a = 2; a < table_size; a++) {
+          if (_survival_rates[a] >= 0.0) {
+            gclog_or_tty->print(" %u:%.2f", a, _survival_rates[a]);
+          }
+        }
+        gclog_or_tty->cr();
+      }
     }
 
     total = 0;
@@ -69,11 +69,27 @@ class ageTable VALUE_OBJ_CLASS_SPEC {
   void merge(ageTable* subTable);
   void merge_par(ageTable* subTable);
 
-  // calculate new tenuring threshold based on age information
-  uint compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tracer);
+  // calculate new tenuring threshold based on age information.  With
+  // "use_survival_rates" the threshold may be lowered further to the one
+  // that minimizes the estimated cost of copying and promotion.
+  uint compute_tenuring_threshold(size_t survivor_capacity, GCTracer &tracer,
+                                  bool use_survival_rates = false);
 
  private:
   PerfVariable* _perf_sizes[table_size];
+
+  // Support for the promotion-aware tenuring policy (UseAdaptiveTenuring).
+  // Sizes of the previous young collection and, per age, the smoothed
+  // fraction of the objects of age-1 that survived to age; negative if
+  // no sample was taken yet.
+  size_t       _prev_sizes[table_size];
+  double       _survival_rates[table_size];
+  uint         _prev_threshold;
+  unsigned int _prev_collections;
+  bool         _has_prev_sizes;
+
+  void sample_survival_rates();
+  uint cost_optimal_tenuring_threshold(uint max_threshold) const;
 };
 
 #endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_AGETABLE_HPP
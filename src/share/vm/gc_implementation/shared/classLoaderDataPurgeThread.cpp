@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "gc_implementation/shared/classLoaderDataPurgeThread.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+
+ClassLoaderDataPurgeThread* ClassLoaderDataPurgeThread::_thread = NULL;
+
+ClassLoaderDataPurgeThread::ClassLoaderDataPurgeThread() :
+  ConcurrentGCThread(),
+  _monitor(new Monitor(Mutex::leaf, "ClassLoaderDataPurge_lock", true)),
+  _pending(NULL) {
+  set_name("Class Loader Data Purge Thread");
+  create_and_start();
+}
+
+ClassLoaderDataPurgeThread::~ClassLoaderDataPurgeThread() {
+  ShouldNotReachHere();
+}
+
+bool ClassLoaderDataPurgeThread::is_enabled() {
+  // G1 has its own concurrent phase, see G1PurgeClassLoaderDataConcurrently
+  return PurgeClassLoaderDataConcurrently && !UseG1GC && ClassUnloading;
+}
+
+void ClassLoaderDataPurgeThread::create() {
+  assert(is_enabled(), "concurrent class loader data purge not enabled");
+  assert(_thread == NULL, "one class loader data purge thread allowed");
+  _thread = new ClassLoaderDataPurgeThread();
+}
+
+void ClassLoaderDataPurgeThread::enqueue(ClassLoaderData* list) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(_thread != NULL, "class loader data purge thread not created");
+  if (list == NULL) {
+    return;
+  }
+  MonitorLockerEx ml(_thread->_monitor, Mutex::_no_safepoint_check_flag);
+  // The order of deletion does not matter
+  _thread->_pending = ClassLoaderDataGraph::append_detached(list, _thread->_pending);
+  ml.notify();
+}
+
+ClassLoaderData* ClassLoaderDataPurgeThread::wait_for_work() {
+  MonitorLockerEx ml(_monitor, Mutex::_no_safepoint_check_flag);
+  while (_pending == NULL) {
+    ml.wait(Mutex::_no_safepoint_check_flag);
+  }
+  ClassLoaderData* list = _pending;
+  _pending = NULL;
+  return list;
+}
+
+uint ClassLoaderDataPurgeThread::purge(ClassLoaderData* list) {
+  // Include thread in safepoints
+  SuspendibleThreadSetJoiner sts;
+  uint purged = 0;
+  while (list != NULL) {
+    list = ClassLoaderDataGraph::purge_first_detached(list);
+    purged++;
+    if (sts.should_yield()) {
+      sts.yield();
+    }
+  }
+  // The virtual space nodes emptied by the deletion are released by the
+  // Metaspace::purge() part of the next purge at a safepoint.
+  ClassLoaderDataGraph::set_should_purge(true);
+  return purged;
+}
+
+void ClassLoaderDataPurgeThread::run() {
+  initialize_in_thread();
+  wait_for_universe_init();
+
+  for (;;) {
+    ClassLoaderData* list = wait_for_work();
+    double start = os::elapsedTime();
+    uint purged = purge(list);
+    if (PrintGCDetails) {
+      gclog_or_tty->date_stamp(PrintGCDateStamps);
+      gclog_or_tty->stamp(PrintGCTimeStamps);
+      gclog_or_tty->print_cr("[concurrent-class-unloading, purged %u class loader data, %1.7lf secs]",
+                             purged, os::elapsedTime() - start);
+    }
+  }
+}
+
+void ClassLoaderDataPurgeThread::print_on(outputStream* st) const {
+  st->print("\"%s\" ", name());
+  Thread::print_on(st);
+  st->cr();
+}
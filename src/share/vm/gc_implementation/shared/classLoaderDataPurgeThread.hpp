@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_CLASSLOADERDATAPURGETHREAD_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_CLASSLOADERDATAPURGETHREAD_HPP
+
+#include "gc_implementation/shared/concurrentGCThread.hpp"
+
+class ClassLoaderData;
+
+//
+// With PurgeClassLoaderDataConcurrently, the Serial, Parallel and CMS
+// collectors no longer delete the class loader data they unloaded in
+// ClassLoaderDataGraph::purge() at a safepoint. purge() hands the detached
+// unloading list to this thread, which deletes the loaders one by one -
+// the C heap structures of their classes, their jmethodIDs, MethodData and
+// metaspace chunks - while the application runs. The thread is in the
+// suspendible thread set and yields to safepoints between two loaders.
+// Virtual space nodes emptied by the deletion are released by the
+// Metaspace::purge() of the next purge at a safepoint.
+//
+class ClassLoaderDataPurgeThread: public ConcurrentGCThread {
+ private:
+  static ClassLoaderDataPurgeThread* _thread;
+
+  Monitor*          _monitor;   // protects _pending
+  ClassLoaderData*  _pending;   // detached lists waiting to be deleted
+
+  ClassLoaderDataPurgeThread();
+  ~ClassLoaderDataPurgeThread();
+
+  ClassLoaderData* wait_for_work();
+  uint purge(ClassLoaderData* list);
+
+ public:
+  static bool is_enabled();
+  static void create();
+  // Until the thread is created during startup, purge() deletes the
+  // class loader data itself.
+  static bool is_active() { return _thread != NULL; }
+
+  // Called at a safepoint with the unloading list detached from the graph.
+  static void enqueue(ClassLoaderData* list);
+
+  virtual void run();
+  virtual void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_CLASSLOADERDATAPURGETHREAD_HPP
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/shared/gcEventLog.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/ostream.hpp"
+
+// Matches the indentation of LineBuffer.
+static const int INDENT_CHARS = 3;
+
+bool GCEventLog::is_active() {
+  return GCBinaryEventLog && AsyncGCLogWriter::is_running();
+}
+
+void GCEventLog::log(const Record& r) {
+  if (!AsyncGCLogWriter::enqueue_record(&GCEventLog::format, &r, sizeof(r))) {
+    // The writer stopped after is_active() was checked; print directly.
+    format(&r, gclog_or_tty);
+  }
+}
+
+void GCEventLog::format(const void* record, outputStream* st) {
+  Record r;
+  memcpy(&r, record, sizeof(r));
+  st->sp(r._indent * INDENT_CHARS);
+  switch (r._kind) {
+    case Time:
+      st->print_cr("[%s: %.1lf ms]", r._title, r._value[0]);
+      break;
+    case TimeWorkers:
+      st->print_cr("[%s: %.1lf ms, GC Workers: %u]", r._title, r._value[0], (uint)r._count[0]);
+      break;
+    case Count:
+      st->print_cr("[%s: " SIZE_FORMAT "]", r._title, r._count[0]);
+      break;
+    case SingleTime:
+      st->print_cr("[%s:  %.1lf]", r._title, r._value[0]);
+      break;
+    case SingleCount:
+      st->print_cr("[%s:  " SIZE_FORMAT "]", r._title, r._count[0]);
+      break;
+    case TimeSummary:
+      st->print("[%s: Min: %.1lf, Avg: %.1lf, Max: %.1lf, Diff: %.1lf",
+                r._title, r._value[0], r._value[1], r._value[2], r._value[2] - r._value[0]);
+      if (r._print_sum) {
+        st->print(", Sum: %.1lf", r._value[3]);
+      }
+      st->print_cr("]");
+      break;
+    case CountSummary:
+      st->print_cr("[%s: Min: " SIZE_FORMAT ", Avg: %.1lf, Max: " SIZE_FORMAT
+                   ", Diff: " SIZE_FORMAT ", Sum: " SIZE_FORMAT "]",
+                   r._title, r._count[0], r._value[1], r._count[1],
+                   r._count[1] - r._count[0], r._count[2]);
+      break;
+    default:
+      ShouldNotReachHere();
+  }
+}
+
+void GCEventLog::log_time(int indent, const char* title, double ms) {
+  Record r(Time, indent, title);
+  r._value[0] = ms;
+  log(r);
+}
+
+void GCEventLog::log_time(int indent, const char* title, double ms, uint workers) {
+  Record r(TimeWorkers, indent, title);
+  r._value[0] = ms;
+  r._count[0] = workers;
+  log(r);
+}
+
+void GCEventLog::log_count(int indent, const char* title, size_t count) {
+  Record r(Count, indent, title);
+  r._count[0] = count;
+  log(r);
+}
+
+void GCEventLog::log_single_time(int indent, const char* title, double ms) {
+  Record r(SingleTime, indent, title);
+  r._value[0] = ms;
+  log(r);
+}
+
+void GCEventLog::log_single_count(int indent, const char* title, size_t count) {
+  Record r(SingleCount, indent, title);
+  r._count[0] = count;
+  log(r);
+}
+
+void GCEventLog::log_time_summary(int indent, const char* title, double min,
+                                  double avg, double max, double sum, bool print_sum) {
+  Record r(TimeSummary, indent, title);
+  r._value[0] = min;
+  r._value[1] = avg;
+  r._value[2] = max;
+  r._value[3] = sum;
+  r._print_sum = print_sum ? 1 : 0;
+  log(r);
+}
+
+void GCEventLog::log_count_summary(int indent, const char* title, size_t min,
+                                   double avg, size_t max, size_t sum) {
+  Record r(CountSummary, indent, title);
+  r._count[0] = min;
+  r._value[1] = avg;
+  r._count[1] = max;
+  r._count[2] = sum;
+  log(r);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_GCEVENTLOG_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_GCEVENTLOG_HPP
+
+#include "memory/allocation.hpp"
+
+class outputStream;
+
+// GCEventLog keeps the formatting of the phase timing lines that
+// PrintGCDetails prints inside a pause out of the pause. With
+// GCBinaryEventLog, each line is queued as a fixed-layout record behind the
+// text in the AsyncGCLog buffer, and the writer thread formats it into the
+// same text that would have been printed. The pause only copies a few
+// numbers. Log rotation is unaffected: the writer formats everything
+// buffered before a rotation into the file being rotated out.
+//
+// Titles must be string literals; only the pointer is recorded.
+class GCEventLog : AllStatic {
+ public:
+  enum Kind {
+    Time,           // [title: v ms]
+    TimeWorkers,    // [title: v ms, GC Workers: n]
+    Count,          // [title: n]
+    SingleTime,     // [title:  v]
+    SingleCount,    // [title:  n]
+    TimeSummary,    // [title: Min: v, Avg: v, Max: v, Diff: v(, Sum: v)]
+    CountSummary    // [title: Min: n, Avg: v, Max: n, Diff: n, Sum: n]
+  };
+
+ private:
+  struct Record {
+    const char* _title;
+    double      _value[4];    // value, or min, avg, max and sum
+    size_t      _count[3];    // count, or min, max and sum
+    u1          _kind;
+    u1          _indent;
+    u1          _print_sum;
+
+    Record() { }
+    Record(Kind kind, int indent, const char* title) {
+      memset(this, 0, sizeof(*this));
+      _title = title;
+      _kind = (u1)kind;
+      _indent = (u1)indent;
+    }
+  };
+
+  static void log(const Record& r);
+  static void format(const void* record, outputStream* st);
+
+ public:
+  // True if lines can be recorded instead of printed.
+  static bool is_active();
+
+  static void log_time(int indent, const char* title, double ms);
+  static void log_time(int indent, const char* title, double ms, uint workers);
+  static void log_count(int indent, const char* title, size_t count);
+  static void log_single_time(int indent, const char* title, double ms);
+  static void log_single_count(int indent, const char* title, size_t count);
+  static void log_time_summary(int indent, const char* title, double min,
+                               double avg, double max, double sum, bool print_sum);
+  static void log_count_summary(int indent, const char* title, size_t min,
+                                double avg, size_t max, size_t sum);
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_GCEVENTLOG_HPP
@@ -24,6 +24,8 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/universe.hpp"
 #include "utilities/growableArray.hpp"
 #include "utilities/ticks.hpp"
 
@@ -139,6 +141,11 @@ void TimePartitions::update_statistics(GCPhase* phase) {
     const Tickspan pause = phase->end() - phase->start();
     _sum_of_pauses += pause;
     _longest_pause = MAX2(pause, _longest_pause);
+
+    CollectedHeap* heap = Universe::heap();
+    if (heap != NULL && heap->perf_gc_pause_histogram() != NULL) {
+      heap->perf_gc_pause_histogram()->record((jlong)pause.microseconds());
+    }
   }
 }
 
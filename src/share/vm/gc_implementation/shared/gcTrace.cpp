@@ -83,10 +83,14 @@ void GCTracer::report_gc_end(const Ticks& timestamp, TimePartitions* time_partit
 void GCTracer::report_gc_reference_stats(const ReferenceProcessorStats& rps) const {
   assert_set_gc_id();
 
-  send_reference_stats_event(REF_SOFT, rps.soft_count());
-  send_reference_stats_event(REF_WEAK, rps.weak_count());
-  send_reference_stats_event(REF_FINAL, rps.final_count());
-  send_reference_stats_event(REF_PHANTOM, rps.phantom_count());
+  send_reference_stats_event(REF_SOFT, rps.soft_count(),
+                             rps.time(REF_SOFT), rps.workers(REF_SOFT));
+  send_reference_stats_event(REF_WEAK, rps.weak_count(),
+                             rps.time(REF_WEAK), rps.workers(REF_WEAK));
+  send_reference_stats_event(REF_FINAL, rps.final_count(),
+                             rps.time(REF_FINAL), rps.workers(REF_FINAL));
+  send_reference_stats_event(REF_PHANTOM, rps.phantom_count(),
+                             rps.time(REF_PHANTOM), rps.workers(REF_PHANTOM));
 }
 
 #if INCLUDE_SERVICES
@@ -254,4 +258,29 @@ void G1NewTracer::report_evacuation_failed(EvacuationFailedInfo& ef_info) {
   send_evacuation_failed_event(ef_info);
   ef_info.reset();
 }
+
+void G1NewTracer::report_tenant_evacuation_statistics(jlong tenant_id,
+                                                      size_t bytes_copied,
+                                                      size_t objects_copied,
+                                                      double pause_time_share_ms) {
+  assert_set_gc_id();
+
+  send_tenant_evacuation_statistics(tenant_id, bytes_copied, objects_copied, pause_time_share_ms);
+}
+
+void G1NewTracer::report_adaptive_ihop_statistics(size_t threshold,
+                                                  size_t internal_target_occupancy,
+                                                  size_t current_occupancy,
+                                                  size_t additional_buffer_size,
+                                                  double predicted_allocation_rate,
+                                                  double predicted_marking_length,
+                                                  bool prediction_active) {
+  send_adaptive_ihop_statistics(threshold,
+                                internal_target_occupancy,
+                                current_occupancy,
+                                additional_buffer_size,
+                                predicted_allocation_rate,
+                                predicted_marking_length,
+                                prediction_active);
+}
 #endif
@@ -140,7 +140,8 @@ class GCTracer : public ResourceObj {
   void send_gc_heap_summary_event(GCWhen::Type when, const GCHeapSummary& heap_summary) const;
   void send_meta_space_summary_event(GCWhen::Type when, const MetaspaceSummary& meta_space_summary) const;
   void send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype, const MetaspaceChunkFreeListSummary& summary) const;
-  void send_reference_stats_event(ReferenceType type, size_t count) const;
+  void send_reference_stats_event(ReferenceType type, size_t count,
+                                  const Tickspan& time, uint workers) const;
   void send_phase_events(TimePartitions* time_partitions) const;
 };
 
@@ -256,11 +257,33 @@ class G1NewTracer : public YoungGCTracer {
   void report_gc_end_impl(const Ticks& timestamp, TimePartitions* time_partitions);
   void report_evacuation_info(EvacuationInfo* info);
   void report_evacuation_failed(EvacuationFailedInfo& ef_info);
+  void report_tenant_evacuation_statistics(jlong tenant_id,
+                                           size_t bytes_copied,
+                                           size_t objects_copied,
+                                           double pause_time_share_ms);
+  void report_adaptive_ihop_statistics(size_t threshold,
+                                       size_t internal_target_occupancy,
+                                       size_t current_occupancy,
+                                       size_t additional_buffer_size,
+                                       double predicted_allocation_rate,
+                                       double predicted_marking_length,
+                                       bool prediction_active);
 
  private:
   void send_g1_young_gc_event();
   void send_evacuation_info_event(EvacuationInfo* info);
   void send_evacuation_failed_event(const EvacuationFailedInfo& ef_info) const;
+  void send_tenant_evacuation_statistics(jlong tenant_id,
+                                         size_t bytes_copied,
+                                         size_t objects_copied,
+                                         double pause_time_share_ms);
+  void send_adaptive_ihop_statistics(size_t threshold,
+                                     size_t internal_target_occupancy,
+                                     size_t current_occupancy,
+                                     size_t additional_buffer_size,
+                                     double predicted_allocation_rate,
+                                     double predicted_marking_length,
+                                     bool prediction_active);
 };
 #endif
 
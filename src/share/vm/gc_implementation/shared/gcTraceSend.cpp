@@ -53,12 +53,15 @@ void GCTracer::send_garbage_collection_event() const {
   }
 }
 
-void GCTracer::send_reference_stats_event(ReferenceType type, size_t count) const {
+void GCTracer::send_reference_stats_event(ReferenceType type, size_t count,
+                                          const Tickspan& time, uint workers) const {
   EventGCReferenceStatistics e;
   if (e.should_commit()) {
       e.set_gcId(_shared_gc_info.gc_id().id());
       e.set_type((u1)type);
       e.set_count(count);
+      e.set_processingTime(time);
+      e.set_workers(workers);
       e.commit();
   }
 }
@@ -224,6 +227,21 @@ void G1NewTracer::send_evacuation_info_event(EvacuationInfo* info) {
   }
 }
 
+void G1NewTracer::send_tenant_evacuation_statistics(jlong tenant_id,
+                                                    size_t bytes_copied,
+                                                    size_t objects_copied,
+                                                    double pause_time_share_ms) {
+  EventTenantEvacuationStatistics e;
+  if (e.should_commit()) {
+    e.set_gcId(_shared_gc_info.gc_id().id());
+    e.set_tenantId(tenant_id);
+    e.set_bytesCopied(bytes_copied);
+    e.set_objectsCopied(objects_copied);
+    e.set_pauseTimeShare((s8)(pause_time_share_ms * NANOSECS_PER_MILLISEC));
+    e.commit();
+  }
+}
+
 void G1NewTracer::send_evacuation_failed_event(const EvacuationFailedInfo& ef_info) const {
   EventEvacuationFailed e;
   if (e.should_commit()) {
@@ -233,6 +251,28 @@ void G1NewTracer::send_evacuation_failed_event(const EvacuationFailedInfo& ef_in
   }
 }
 
+void G1NewTracer::send_adaptive_ihop_statistics(size_t threshold,
+                                                size_t internal_target_occupancy,
+                                                size_t current_occupancy,
+                                                size_t additional_buffer_size,
+                                                double predicted_allocation_rate,
+                                                double predicted_marking_length,
+                                                bool prediction_active) {
+  EventG1AdaptiveIHOP evt;
+  if (evt.should_commit()) {
+    evt.set_gcId(_shared_gc_info.gc_id().id());
+    evt.set_threshold(threshold);
+    evt.set_thresholdPercentage(internal_target_occupancy > 0 ? ((double)threshold / internal_target_occupancy) : 0.0);
+    evt.set_ihopTargetOccupancy(internal_target_occupancy);
+    evt.set_currentOccupancy(current_occupancy);
+    evt.set_additionalBufferSize(additional_buffer_size);
+    evt.set_predictedAllocationRate(predicted_allocation_rate);
+    evt.set_predictedMarkingDuration(predicted_marking_length * MILLIUNITS);
+    evt.set_predictionActive(prediction_active);
+    evt.commit();
+  }
+}
+
 #endif // INCLUDE_ALL_GCS
 
 static JfrStructVirtualSpace to_struct(const VirtualSpaceSummary& summary) {
@@ -184,6 +184,7 @@ void VM_GC_HeapInspection::doit() {
   }
   HeapInspection inspect(_csv_format, _print_help, _print_class_stats,
                          _columns);
+  inspect.set_retained_size(_retained_size, _retained_timeout);
   inspect.heap_inspection(_out);
 }
 
@@ -136,6 +136,8 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   bool _print_help;
   bool _print_class_stats;
   const char* _columns;
+  bool _retained_size;
+  jlong _retained_timeout;
  public:
   VM_GC_HeapInspection(outputStream* out, bool request_full_gc) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
@@ -148,6 +150,8 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
     _print_help = false;
     _print_class_stats = false;
     _columns = NULL;
+    _retained_size = false;
+    _retained_timeout = 0;
   }
 
   ~VM_GC_HeapInspection() {}
@@ -159,6 +163,10 @@ class VM_GC_HeapInspection: public VM_GC_Operation {
   void set_print_help(bool value) {_print_help = value;}
   void set_print_class_stats(bool value) {_print_class_stats = value;}
   void set_columns(const char* value) {_columns = value;}
+  void set_retained_size(bool value, jlong timeout_ms) {
+    _retained_size = value;
+    _retained_timeout = timeout_ms;
+  }
  protected:
   bool collect();
 };
@@ -24,20 +24,24 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/shared/gcId.hpp"
-#include "gc_interface/allocTracer.hpp"
+#include "gc_interface/allocTracer.inline.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "runtime/handles.hpp"
 #include "utilities/globalDefinitions.hpp"
 #if INCLUDE_JFR
 #include "jfr/support/jfrAllocationTracer.hpp"
+#include "jfr/support/jfrContext.hpp"
 #endif
 
 void AllocTracer::send_allocation_outside_tlab_event(KlassHandle klass, HeapWord* obj, size_t alloc_size, Thread* thread) {
   JFR_ONLY(JfrAllocationTracer tracer(obj, alloc_size, thread);)
   EventObjectAllocationOutsideTLAB event;
-  if (event.should_commit()) {
+  u8 weight = 1;
+  if (should_commit_sampled(event, &weight)) {
     event.set_objectClass(klass());
     event.set_allocationSize(alloc_size);
+    event.set_weight(weight);
+    JFR_ONLY(JfrContext::set_context(&event, thread);)
     event.commit();
   }
   if (alloc_size >= HugeObjectAllocationThreshold) {
@@ -53,10 +57,13 @@ void AllocTracer::send_allocation_outside_tlab_event(KlassHandle klass, HeapWord
 void AllocTracer::send_allocation_in_new_tlab_event(KlassHandle klass, HeapWord* obj, size_t tlab_size, size_t alloc_size, Thread* thread) {
   JFR_ONLY(JfrAllocationTracer tracer(obj, alloc_size, thread);)
   EventObjectAllocationInNewTLAB event;
-  if (event.should_commit()) {
+  u8 weight = 1;
+  if (should_commit_sampled(event, &weight)) {
     event.set_objectClass(klass());
     event.set_allocationSize(alloc_size);
     event.set_tlabSize(tlab_size);
+    event.set_weight(weight);
+    JFR_ONLY(JfrContext::set_context(&event, thread);)
     event.commit();
   }
 }
@@ -31,8 +31,13 @@
 
 class AllocTracer : AllStatic {
   private:
-    static void send_opto_array_allocation_event(KlassHandle klass, oop obj,size_t alloc_size, Thread* thread);
-    static void send_opto_instance_allocation_event(KlassHandle klass, oop obj, Thread* thread);
+    static void send_opto_array_allocation_event(KlassHandle klass, oop obj,size_t alloc_size, u8 sampled_bytes, Thread* thread);
+    static void send_opto_instance_allocation_event(KlassHandle klass, oop obj, u8 sampled_bytes, Thread* thread);
+    // sampling by allocated bytes (-XX:ObjectProfilerSampleBytes)
+    static void send_sampled_allocation_event(KlassHandle klass, oop obj, size_t alloc_size, Thread* thread);
+    // should_commit() and accepted by the throttler of the event type
+    template <typename EVENT>
+    static bool should_commit_sampled(EVENT& event, u8* weight);
 
   public:
     static void send_allocation_outside_tlab_event(KlassHandle klass, HeapWord* obj, size_t alloc_size, Thread* thread);
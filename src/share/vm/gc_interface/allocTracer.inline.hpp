@@ -25,16 +25,31 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "runtime/handles.hpp"
+#include "runtime/thread.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "gc_interface/allocTracer.hpp"
 #if INCLUDE_JFR
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/objectprofiler/objectProfiler.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
 #endif // INCLUDE_JFR
 
+template <typename EVENT>
+inline bool AllocTracer::should_commit_sampled(EVENT& event, u8* weight) {
+  if (!event.should_commit()) {
+    return false;
+  }
+#if INCLUDE_JFR
+  return JfrEventThrottler::accept(EVENT::eventId, weight);
+#else
+  return true;
+#endif // INCLUDE_JFR
+}
+
 inline void AllocTracer::opto_slow_allocation_enter(bool is_array, Thread* thread) {
 #if INCLUDE_JFR
   if (JfrOptionSet::sample_object_allocations() &&
+      ObjectProfilerSampleBytes == 0 &&
       ObjectProfiler::enabled()) {
     assert(thread != NULL, "Invariant");
     assert(thread->is_Java_thread(), "Invariant");
@@ -51,7 +66,7 @@ inline void AllocTracer::opto_slow_allocation_enter(bool is_array, Thread* threa
 inline void AllocTracer::opto_slow_allocation_leave(bool is_array, Thread* thread) {
 #if INCLUDE_JFR
 #ifndef PRODUCT
-  if (JfrOptionSet::sample_object_allocations()) {
+  if (JfrOptionSet::sample_object_allocations() && ObjectProfilerSampleBytes == 0) {
     JfrThreadLocal* jfr_thread_local = thread->jfr_thread_local();
     assert(!jfr_thread_local->has_cached_event_id(), "Invariant");
     assert(jfr_thread_local->alloc_count_until_sample() >= jfr_thread_local->alloc_count(), "Invariant");
@@ -60,31 +75,76 @@ inline void AllocTracer::opto_slow_allocation_leave(bool is_array, Thread* threa
 #endif // INCLUDE_JFR
 }
 
-inline void AllocTracer::send_opto_array_allocation_event(KlassHandle klass, oop obj, size_t alloc_size, Thread* thread) {
+inline void AllocTracer::send_opto_array_allocation_event(KlassHandle klass, oop obj, size_t alloc_size, u8 sampled_bytes, Thread* thread) {
   EventOptoArrayObjectAllocation event;
-  if (event.should_commit()) {
+  u8 weight = 1;
+  if (should_commit_sampled(event, &weight)) {
     event.set_objectClass(klass());
     event.set_address(cast_from_oop<u8>(obj));
     event.set_allocationSize(alloc_size);
+    if (sampled_bytes == 0) {
+      event.set_weight(weight JFR_ONLY(* JfrOptionSet::object_allocations_sampling_interval()));
+    } else {
+      event.set_weight(weight);
+    }
+    event.set_sampledBytes(weight * sampled_bytes);
     event.commit();
   }
 }
 
-inline void AllocTracer::send_opto_instance_allocation_event(KlassHandle klass, oop obj, Thread* thread) {
+inline void AllocTracer::send_opto_instance_allocation_event(KlassHandle klass, oop obj, u8 sampled_bytes, Thread* thread) {
   EventOptoInstanceObjectAllocation event;
-  if (event.should_commit()) {
+  u8 weight = 1;
+  if (should_commit_sampled(event, &weight)) {
     event.set_objectClass(klass());
     event.set_address(cast_from_oop<u8>(obj));
+    if (sampled_bytes == 0) {
+      event.set_weight(weight JFR_ONLY(* JfrOptionSet::object_allocations_sampling_interval()));
+    } else {
+      event.set_weight(weight);
+    }
+    event.set_sampledBytes(weight * sampled_bytes);
     event.commit();
   }
 }
 
+// Called for every allocation that reaches the runtime. The fast paths
+// stop at the TLAB sample point, so the allocation that crosses the
+// sampling interval always gets here, and the sample stands for all
+// bytes the thread allocated since the previous one.
+inline void AllocTracer::send_sampled_allocation_event(KlassHandle klass, oop obj, size_t alloc_size, Thread* thread) {
+#if INCLUDE_JFR
+  if (!thread->is_Java_thread() || !ObjectProfiler::enabled()) {
+    return;
+  }
+  JfrThreadLocal* jfr_thread_local = thread->jfr_thread_local();
+  jlong allocated_bytes = thread->cooked_allocated_bytes();
+  jlong interval = (jlong)ObjectProfilerSampleBytes;
+  if (jfr_thread_local->alloc_bytes_until_sample() == 0) {
+    jfr_thread_local->set_next_alloc_bytes_sample(allocated_bytes, interval);
+  } else if (allocated_bytes >= jfr_thread_local->alloc_bytes_until_sample()) {
+    u8 sampled_bytes = (u8)(allocated_bytes - jfr_thread_local->alloc_bytes_at_last_sample());
+    if (klass()->oop_is_array()) {
+      send_opto_array_allocation_event(klass, obj, alloc_size, sampled_bytes, thread);
+    } else {
+      send_opto_instance_allocation_event(klass, obj, sampled_bytes, thread);
+    }
+    jfr_thread_local->set_next_alloc_bytes_sample(allocated_bytes, interval);
+  }
+  if (UseTLAB) {
+    thread->tlab().set_sample_end((size_t)(jfr_thread_local->alloc_bytes_until_sample() - allocated_bytes));
+  }
+#endif // INCLUDE_JFR
+}
+
 inline void AllocTracer::send_slow_allocation_event(KlassHandle klass, oop obj, size_t alloc_size, Thread* thread) {
 #if INCLUDE_JFR
   if (JfrOptionSet::sample_object_allocations()) {
     assert(thread != NULL, "Illegal parameter: thread is NULL");
     assert(thread == Thread::current(), "Invariant");
-    if (thread->jfr_thread_local()->has_cached_event_id()) {
+    if (ObjectProfilerSampleBytes > 0) {
+      send_sampled_allocation_event(klass, obj, alloc_size, thread);
+    } else if (thread->jfr_thread_local()->has_cached_event_id()) {
       assert(thread->is_Java_thread(), "Only allow to be called from java thread");
       jlong alloc_count = thread->jfr_thread_local()->alloc_count();
       jlong alloc_count_until_sample = thread->jfr_thread_local()->alloc_count_until_sample();
@@ -92,9 +152,9 @@ inline void AllocTracer::send_slow_allocation_event(KlassHandle klass, oop obj,
       if (alloc_count == alloc_count_until_sample) {
         JfrEventId event_id = thread->jfr_thread_local()->cached_event_id();
         if (event_id ==JfrOptoArrayObjectAllocationEvent) {
-          send_opto_array_allocation_event(klass, obj, alloc_size, thread);
+          send_opto_array_allocation_event(klass, obj, alloc_size, 0, thread);
         } else if(event_id == JfrOptoInstanceObjectAllocationEvent) {
-          send_opto_instance_allocation_event(klass, obj, thread);
+          send_opto_instance_allocation_event(klass, obj, 0, thread);
         } else {
             ShouldNotReachHere();
         }
@@ -116,9 +176,9 @@ inline void AllocTracer::send_opto_fast_allocation_event(KlassHandle klass, oop
 
   Klass* k = klass();
   if (k->oop_is_array()) {
-    send_opto_array_allocation_event(klass, obj, alloc_size, thread);
+    send_opto_array_allocation_event(klass, obj, alloc_size, 0, thread);
   } else {
-    send_opto_instance_allocation_event(klass, obj, thread);
+    send_opto_instance_allocation_event(klass, obj, 0, thread);
   }
   jlong interval = JfrOptionSet::object_allocations_sampling_interval();
   thread->jfr_thread_local()->incr_alloc_count_until_sample(interval);
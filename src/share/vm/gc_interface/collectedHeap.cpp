@@ -163,6 +163,8 @@ CollectedHeap::CollectedHeap() : _n_par_threads(0)
   _is_gc_active = false;
   _total_collections = _total_full_collections = 0;
   _gc_cause = _gc_lastcause = GCCause::_no_gc;
+  _perf_gc_pause_histogram = NULL;
+  _perf_alloc_stall_histogram = NULL;
   NOT_PRODUCT(_promotion_failure_alot_count = 0;)
   NOT_PRODUCT(_promotion_failure_alot_gc_number = 0;)
 
@@ -176,6 +178,14 @@ CollectedHeap::CollectedHeap() : _n_par_threads(0)
     _perf_gc_lastcause =
                 PerfDataManager::create_string_variable(SUN_GC, "lastCause",
                              80, GCCause::to_string(_gc_lastcause), CHECK);
+
+    if (PerfDataHistograms) {
+      _perf_gc_pause_histogram =
+                PerfDataManager::create_histogram(SUN_GC, "pauseHistogram", CHECK);
+
+      _perf_alloc_stall_histogram =
+                PerfDataManager::create_histogram(SUN_GC, "allocationStallHistogram", CHECK);
+    }
   }
   _defer_initial_card_mark = false; // strengthened by subclass in pre_initialize() below.
   // Create the ring log
@@ -264,6 +274,16 @@ void CollectedHeap::check_for_valid_allocation_state() {
 
 HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thread, size_t size) {
 
+  // The fast path may only have stopped at an allocation sample point;
+  // the sample is taken when the allocation is reported.
+  if (thread->tlab().reached_sample_point()) {
+    thread->tlab().set_back_allocation_end();
+    HeapWord* obj = thread->tlab().allocate(size);
+    if (obj != NULL) {
+      return obj;
+    }
+  }
+
   // Retain tlab and allocate object in shared space if
   // the amount free in the tlab is too large to discard.
   if (thread->tlab().free() > thread->tlab().refill_waste_limit()) {
@@ -282,7 +302,11 @@ HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thre
   }
 
   // Allocate a new TLAB...
-  HeapWord* obj = Universe::heap()->allocate_new_tlab(new_tlab_size);
+  HeapWord* obj;
+  {
+    PerfTraceHistogram pth(Universe::heap()->perf_alloc_stall_histogram());
+    obj = Universe::heap()->allocate_new_tlab(new_tlab_size);
+  }
   if (obj == NULL) {
     return NULL;
   }
@@ -327,6 +351,14 @@ void CollectedHeap::flush_deferred_store_barrier(JavaThread* thread) {
   assert(thread->deferred_card_mark().is_empty(), "invariant");
 }
 
+void CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  ShouldNotReachHere();
+}
+
+void CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  ShouldNotReachHere();
+}
+
 size_t CollectedHeap::max_tlab_size() const {
   // TLABs can't be bigger than we can fill with a int[Integer.MAX_VALUE].
   // This restriction could be removed by enabling filling with multiple arrays.
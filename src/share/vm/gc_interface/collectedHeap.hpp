@@ -43,6 +43,7 @@
 class AdaptiveSizePolicy;
 class BarrierSet;
 class CollectorPolicy;
+class FlexibleWorkGang;
 class GCHeapSummary;
 class GCTimer;
 class GCTracer;
@@ -82,6 +83,15 @@ class GCHeapLog : public EventLogBase<GCMessage> {
 //     G1CollectedHeap
 //   ParallelScavengeHeap
 //
+// An iteration over the objects of the heap by several workers at a
+// safepoint. Each worker calls object_iterate() with its id, and each
+// object is visited by exactly one of them.
+class ParallelObjectIterator : public CHeapObj<mtGC> {
+ public:
+  virtual void object_iterate(ObjectClosure* cl, uint worker_id) = 0;
+  virtual ~ParallelObjectIterator() {}
+};
+
 class CollectedHeap : public CHeapObj<mtInternal> {
   friend class VMStructs;
   friend class IsGCActiveMark; // Block structured external access to _is_gc_active
@@ -116,6 +126,10 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   PerfStringVariable* _perf_gc_cause;
   PerfStringVariable* _perf_gc_lastcause;
 
+  // Latency histograms, only created with PerfDataHistograms.
+  PerfHistogram* _perf_gc_pause_histogram;
+  PerfHistogram* _perf_alloc_stall_histogram;
+
   // Constructor
   CollectedHeap();
 
@@ -310,6 +324,10 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   }
   GCCause::Cause gc_cause() { return _gc_cause; }
 
+  // NULL unless PerfDataHistograms is enabled.
+  PerfHistogram* perf_gc_pause_histogram()    { return _perf_gc_pause_histogram; }
+  PerfHistogram* perf_alloc_stall_histogram() { return _perf_alloc_stall_histogram; }
+
   // Number of threads currently working on GC tasks.
   uint n_par_threads() { return _n_par_threads; }
 
@@ -470,6 +488,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Does this heap support heap inspection (+PrintClassHistogram?)
   virtual bool supports_heap_inspection() const = 0;
 
+  // Can JNI critical sections pin their objects instead of locking out
+  // garbage collection with the GC_locker?
+  virtual bool supports_object_pinning() const { return false; }
+  // Keep "obj" in place until it is unpinned.
+  virtual void pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Perform a collection of the heap; intended for use in implementing
   // "System.gc".  This probably implies as full a collection as the
   // "CollectedHeap" supports.
@@ -526,6 +551,16 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // over live objects.
   virtual void safe_object_iterate(ObjectClosure* cl) = 0;
 
+  // Returns a new iterator for "thread_num" workers to visit all objects
+  // in parallel, or NULL if the heap only supports serial iteration.
+  virtual ParallelObjectIterator* parallel_object_iterator(uint thread_num) {
+    return NULL;
+  }
+
+  // The work gang that may run parallel tasks at safepoints besides
+  // garbage collections, or NULL if there is none.
+  virtual FlexibleWorkGang* safepoint_workers() { return NULL; }
+
   // NOTE! There is no requirement that a collector implement these
   // functions.
   //
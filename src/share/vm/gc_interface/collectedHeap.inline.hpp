@@ -144,8 +144,11 @@ HeapWord* CollectedHeap::common_mem_allocate_noinit(KlassHandle klass, size_t si
     }
   }
   bool gc_overhead_limit_was_exceeded = false;
-  result = Universe::heap()->mem_allocate(size,
-                                          &gc_overhead_limit_was_exceeded);
+  {
+    PerfTraceHistogram pth(Universe::heap()->perf_alloc_stall_histogram());
+    result = Universe::heap()->mem_allocate(size,
+                                            &gc_overhead_limit_was_exceeded);
+  }
   if (result != NULL) {
     NOT_PRODUCT(Universe::heap()->
       check_for_non_bad_heap_word_value(result, size));
@@ -557,8 +557,6 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_get_put(JavaThread* thread, Bytecode
   // resolve field
   fieldDescriptor info;
   constantPoolHandle pool(thread, method(thread)->constants());
-  bool is_put    = (bytecode == Bytecodes::_putfield  || bytecode == Bytecodes::_putstatic);
-  bool is_static = (bytecode == Bytecodes::_getstatic || bytecode == Bytecodes::_putstatic);
 
   {
     JvmtiHideSingleStepping jhss(thread);
@@ -569,6 +567,14 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_get_put(JavaThread* thread, Bytecode
   // check if link resolution caused cpCache to be updated
   if (already_resolved(thread)) return;
 
+  update_field_entry(cache_entry(thread), info, bytecode, pool);
+IRT_END
+
+void InterpreterRuntime::update_field_entry(ConstantPoolCacheEntry* entry, fieldDescriptor& info,
+                                            Bytecodes::Code bytecode, constantPoolHandle pool) {
+  bool is_put    = (bytecode == Bytecodes::_putfield  || bytecode == Bytecodes::_putstatic);
+  bool is_static = (bytecode == Bytecodes::_getstatic || bytecode == Bytecodes::_putstatic);
+
   // compute auxiliary field attributes
   TosState state  = as_TosState(info.field_type());
 
@@ -595,7 +601,7 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_get_put(JavaThread* thread, Bytecode
     }
   }
 
-  cache_entry(thread)->set_field(
+  entry->set_field(
     get_code,
     put_code,
     info.field_holder(),
@@ -606,7 +612,7 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_get_put(JavaThread* thread, Bytecode
     info.access_flags().is_volatile(),
     pool->pool_holder()
   );
-IRT_END
+}
 
 
 //------------------------------------------------------------------------------------------------------------------------
@@ -797,6 +803,12 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_invoke(JavaThread* thread, Bytecodes
            info.call_kind() == CallInfo::vtable_call, "");
   }
 #endif
+  update_invoke_entry(cache_entry(thread), info, bytecode, pool);
+}
+IRT_END
+
+void InterpreterRuntime::update_invoke_entry(ConstantPoolCacheEntry* entry, CallInfo& info,
+                                             Bytecodes::Code bytecode, constantPoolHandle pool) {
   // Get sender or sender's host_klass, and only set cpCache entry to resolved if
   // it is not an interface.  The receiver for invokespecial calls within interface
   // methods must be checked for every call.
@@ -805,19 +817,19 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_invoke(JavaThread* thread, Bytecodes
 
   switch (info.call_kind()) {
   case CallInfo::direct_call:
-    cache_entry(thread)->set_direct_call(
+    entry->set_direct_call(
       bytecode,
       info.resolved_method(),
       sender->is_interface());
     break;
   case CallInfo::vtable_call:
-    cache_entry(thread)->set_vtable_call(
+    entry->set_vtable_call(
       bytecode,
       info.resolved_method(),
       info.vtable_index());
     break;
   case CallInfo::itable_call:
-    cache_entry(thread)->set_itable_call(
+    entry->set_itable_call(
       bytecode,
       info.resolved_klass(),
       info.resolved_method(),
@@ -826,7 +838,6 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_invoke(JavaThread* thread, Bytecodes
   default:  ShouldNotReachHere();
   }
 }
-IRT_END
 
 
 // First time execution:  Resolve symbols, create a permanent MethodType object.
@@ -872,6 +883,87 @@ IRT_ENTRY(void, InterpreterRuntime::resolve_invokedynamic(JavaThread* thread)) {
 }
 IRT_END
 
+// Resolve a cpCache entry without an interpreter frame, for JWarmUp to replay
+// the resolutions of a recording run before the entries are first executed.
+// Nothing is resolved that would run a class initializer out of order, and
+// virtual and interface calls, which need a receiver, are only linked.
+void InterpreterRuntime::resolve_cache_entry_eagerly(constantPoolHandle pool, int cache_index,
+                                                     Bytecodes::Code bytecode, TRAPS) {
+  ConstantPoolCacheEntry* entry = pool->cache()->entry_at(cache_index);
+  if (entry->is_resolved(bytecode)) {
+    return;
+  }
+  int index = cache_index + ConstantPool::CPCACHE_INDEX_TAG;
+  constantTag tag = pool->tag_at(entry->constant_pool_index());
+  KlassHandle current_klass(THREAD, pool->pool_holder());
+  switch (bytecode) {
+  case Bytecodes::_getstatic:
+  case Bytecodes::_putstatic:
+  case Bytecodes::_getfield:
+  case Bytecodes::_putfield: {
+    if (!tag.is_field()) return;
+    KlassHandle resolved_klass(THREAD, pool->klass_ref_at(index, CHECK));
+    fieldDescriptor info;
+    LinkResolver::resolve_field(info, resolved_klass, pool->name_ref_at(index),
+                                pool->signature_ref_at(index), current_klass,
+                                bytecode, true, false, CHECK);
+    if (entry->is_resolved(bytecode)) return;
+    // a static field of an uninitialized class is left for the first access
+    update_field_entry(entry, info, bytecode, pool);
+    break;
+  }
+  case Bytecodes::_invokestatic: {
+    if (!tag.is_method() && !tag.is_interface_method()) return;
+    KlassHandle resolved_klass(THREAD, pool->klass_ref_at(index, CHECK));
+    CallInfo info;
+    LinkResolver::resolve_static_call(info, resolved_klass, pool->name_ref_at(index),
+                                      pool->signature_ref_at(index), current_klass,
+                                      true, false, CHECK);
+    // the entry of an uninitialized class must stay unresolved so that the
+    // first call runs the class initializer
+    if (entry->is_resolved(bytecode) ||
+        !info.resolved_method()->method_holder()->is_initialized()) {
+      return;
+    }
+    update_invoke_entry(entry, info, bytecode, pool);
+    break;
+  }
+  case Bytecodes::_invokespecial: {
+    if (!tag.is_method() && !tag.is_interface_method()) return;
+    CallInfo info;
+    LinkResolver::resolve_invoke(info, Handle(), pool, index, bytecode, CHECK);
+    if (entry->is_resolved(bytecode)) return;
+    update_invoke_entry(entry, info, bytecode, pool);
+    break;
+  }
+  case Bytecodes::_invokevirtual:
+  case Bytecodes::_invokeinterface: {
+    if (!tag.is_method() && !tag.is_interface_method()) return;
+    methodHandle m;
+    KlassHandle resolved_klass;
+    LinkResolver::resolve_method_statically(m, resolved_klass, bytecode, pool, index, CHECK);
+    break;
+  }
+  case Bytecodes::_invokehandle: {
+    if (!EnableInvokeDynamic || !tag.is_method()) return;
+    CallInfo info;
+    LinkResolver::resolve_invoke(info, Handle(), pool, index, bytecode, CHECK);
+    entry->set_method_handle(pool, info);
+    break;
+  }
+  case Bytecodes::_invokedynamic: {
+    if (!EnableInvokeDynamic || !tag.is_invoke_dynamic()) return;
+    CallInfo info;
+    int indy_index = ConstantPool::encode_invokedynamic_index(cache_index);
+    LinkResolver::resolve_invoke(info, Handle(), pool, indy_index, bytecode, CHECK);
+    entry->set_dynamic_call(pool, info);
+    break;
+  }
+  default:
+    break;
+  }
+}
+
 
 //------------------------------------------------------------------------------------------------------------------------
 // Miscellaneous
@@ -949,6 +1041,35 @@ IRT_LEAF(jint, InterpreterRuntime::bcp_to_di(Method* method, address cur_bcp))
   return mdo->bci_to_di(bci);
 IRT_END
 
+#ifdef TIERED
+// With InterpreterProfileMinRate the MethodData is only built for methods
+// that reach InterpreterProfileLimit fast enough. The rate fields of
+// MethodCounters are unused without TieredCompilation, so prev_time()
+// remembers when the method was last sent back. The first time a method
+// gets here only starts the clock. A method that is too slow has its
+// counters halved, which keeps the interpreter from calling in again
+// until it has run another half of the profile limit.
+static bool profile_rate_reached(Method* method) {
+  MethodCounters* mcs = method->method_counters();
+  if (InterpreterProfileMinRate == 0 || TieredCompilation || mcs == NULL) {
+    return true;
+  }
+  jlong now = os::javaTimeMillis();
+  jlong start = mcs->prev_time();
+  if (start != 0) {
+    jlong events = mcs->invocation_counter()->count() + mcs->backedge_counter()->count();
+    jlong elapsed = MAX2(now - start, (jlong)1);
+    if (events * 1000 / elapsed >= (jlong)InterpreterProfileMinRate) {
+      return true;
+    }
+  }
+  mcs->set_prev_time(now);
+  mcs->invocation_counter()->decay();
+  mcs->backedge_counter()->decay();
+  return false;
+}
+#endif
+
 IRT_ENTRY(void, InterpreterRuntime::profile_method(JavaThread* thread))
   // use UnlockFlagSaver to clear and restore the _do_not_unlock_if_synchronized
   // flag, in case this method triggers classloading which will call into Java.
@@ -958,6 +1079,11 @@ IRT_ENTRY(void, InterpreterRuntime::profile_method(JavaThread* thread))
   frame fr = thread->last_frame();
   assert(fr.is_interpreted_frame(), "must come from interpreter");
   methodHandle method(thread, fr.interpreter_frame_method());
+#ifdef TIERED
+  if (!profile_rate_reached(method())) {
+    return;
+  }
+#endif
   Method::build_interpreter_method_data(method, THREAD);
   if (HAS_PENDING_EXCEPTION) {
     assert((PENDING_EXCEPTION->is_a(SystemDictionary::OutOfMemoryError_klass())), "we expect only an OOM error here");
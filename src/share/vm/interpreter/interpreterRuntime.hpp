@@ -66,6 +66,10 @@ class InterpreterRuntime: AllStatic {
 
   static ConstantPoolCacheEntry* cache_entry_at(JavaThread *thread, int i)  { return method(thread)->constants()->cache()->entry_at(i); }
   static ConstantPoolCacheEntry* cache_entry(JavaThread *thread)            { return cache_entry_at(thread, Bytes::get_native_u2(bcp(thread) + 1)); }
+  static void      update_field_entry(ConstantPoolCacheEntry* entry, fieldDescriptor& info,
+                                      Bytecodes::Code bytecode, constantPoolHandle pool);
+  static void      update_invoke_entry(ConstantPoolCacheEntry* entry, CallInfo& info,
+                                       Bytecodes::Code bytecode, constantPoolHandle pool);
   static void      note_trap_inner(JavaThread* thread, int reason,
                                    methodHandle trap_method, int trap_bci, TRAPS);
   static void      note_trap(JavaThread *thread, int reason, TRAPS);
@@ -131,6 +135,9 @@ class InterpreterRuntime: AllStatic {
   static void    resolve_invoke       (JavaThread* thread, Bytecodes::Code bytecode);
   static void    resolve_invokehandle (JavaThread* thread);
   static void    resolve_invokedynamic(JavaThread* thread);
+  // resolve a cpCache entry outside of the interpreter, see JWarmUp
+  static void    resolve_cache_entry_eagerly(constantPoolHandle pool, int cache_index,
+                                             Bytecodes::Code bytecode, TRAPS);
 
   // Breakpoints
   static void _breakpoint(JavaThread* thread, Method* method, address bcp);
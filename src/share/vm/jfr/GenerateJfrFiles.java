@@ -509,6 +509,7 @@ public class GenerateJfrFiles {
             out.write("  EVENT_METADATA,");
             out.write("  EVENT_CHECKPOINT,");
             out.write("  EVENT_BUFFERLOST,");
+            out.write("  EVENT_COMPRESSEDBLOCK,");
             out.write("  NUM_RESERVED_EVENTS = TYPES_END");
             out.write("};");
             out.write("");
@@ -30,6 +30,7 @@
 #include "jfr/recorder/checkpoint/jfrCheckpointManager.hpp"
 #include "jfr/recorder/repository/jfrEmergencyDump.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/support/jfrMonitorContention.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "runtime/java.hpp"
 #include "utilities/defaultStream.hpp"
@@ -68,6 +69,7 @@ void Jfr::on_unloading_classes() {
   if (JfrRecorder::is_created()) {
     JfrCheckpointManager::write_type_set_for_unloaded_classes();
   }
+  JfrMonitorContention::on_unloading_classes();
 }
 
 void Jfr::on_thread_start(Thread* t) {
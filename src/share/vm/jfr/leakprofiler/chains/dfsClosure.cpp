@@ -34,7 +34,11 @@
 #include "memory/iterator.inline.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "utilities/align.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/workgroup.hpp"
 
 // max dfs depth should not exceed size of stack
 static const size_t max_dfs_depth = 5000;
@@ -44,6 +48,8 @@ BitSet* DFSClosure::_mark_bits = NULL;
 const Edge* DFSClosure::_start_edge = NULL;
 size_t DFSClosure::_max_depth = max_dfs_depth;
 bool DFSClosure::_ignore_root_set = false;
+bool DFSClosure::_parallel = false;
+GrowableArray<const oop*>* DFSClosure::_roots = NULL;
 
 DFSClosure::DFSClosure() :
   _parent(NULL),
@@ -98,6 +104,72 @@ void DFSClosure::find_leaks_from_root_set(EdgeStore* edge_store,
   rs.process();
 }
 
+class DFSRootTask : public AbstractGangTask {
+ private:
+  GrowableArray<const oop*>* const _roots;
+  volatile jint _claimed;
+ public:
+  DFSRootTask(GrowableArray<const oop*>* roots) :
+    AbstractGangTask("Leak profiler root chains"), _roots(roots), _claimed(0) {}
+
+  void work(uint worker_id) {
+    while (!GranularTimer::is_finished()) {
+      const jint index = Atomic::add(1, &_claimed) - 1;
+      if (index >= _roots->length()) {
+        return;
+      }
+      DFSClosure::find_leaks_from_root(_roots->at(index));
+    }
+  }
+};
+
+void DFSClosure::find_leaks_from_root_set(EdgeStore* edge_store,
+                                          BitSet* mark_bits,
+                                          FlexibleWorkGang* workers) {
+  assert(edge_store != NULL, "invariant");
+  assert(mark_bits != NULL, "invariant");
+  assert(workers != NULL, "invariant");
+
+  _edge_store = edge_store;
+  _mark_bits = mark_bits;
+  _start_edge = NULL;
+
+  // Mark and collect the root set, to avoid going sideways
+  _roots = new (ResourceObj::C_HEAP, mtTracing) GrowableArray<const oop*>(1024, true, mtTracing);
+  _max_depth = 1;
+  _ignore_root_set = false;
+  DFSClosure dfs;
+  RootSetClosure<DFSClosure> rs(&dfs);
+  rs.process();
+
+  // Depth-first search, one root at a time per worker
+  _max_depth = max_dfs_depth;
+  _ignore_root_set = true;
+  _parallel = true;
+  DFSRootTask task(_roots);
+  workers->run_task(&task);
+  _parallel = false;
+  delete _roots;
+  _roots = NULL;
+}
+
+void DFSClosure::find_leaks_from_root(const oop* root) {
+  assert(_parallel, "invariant");
+  DFSClosure dfs;
+  dfs.do_root(root);
+}
+
+bool DFSClosure::mark(const oop pointee) {
+  if (_parallel) {
+    return _mark_bits->par_mark_obj(pointee);
+  }
+  if (_mark_bits->is_marked(pointee)) {
+    return false;
+  }
+  _mark_bits->mark_obj(pointee);
+  return true;
+}
+
 void DFSClosure::closure_impl(const oop* reference, const oop pointee) {
   assert(pointee != NULL, "invariant");
   assert(reference != NULL, "invariant");
@@ -110,13 +182,15 @@ void DFSClosure::closure_impl(const oop* reference, const oop pointee) {
     // to continue, so skip is_marked check.
     assert(_mark_bits->is_marked(pointee), "invariant");
   } else {
-    if (_mark_bits->is_marked(pointee)) {
+    if (!mark(pointee)) {
       return;
     }
+    if (_depth == 0 && _roots != NULL) {
+      _roots->append(reference);
+    }
   }
 
   _reference = reference;
-  _mark_bits->mark_obj(pointee);
   assert(_mark_bits->is_marked(pointee), "invariant");
 
   // is the pointee a sample object?
@@ -154,6 +228,7 @@ void DFSClosure::add_chain() {
   } else {
     chain[idx - 1] = Edge(NULL, chain[idx - 1].reference());
   }
+  MutexLockerEx ml(_parallel ? ParGCRareEvent_lock : NULL, Mutex::_no_safepoint_check_flag);
   _edge_store->put_chain(chain, idx + (_start_edge != NULL ? _start_edge->distance_to_root() : 0));
 }
 
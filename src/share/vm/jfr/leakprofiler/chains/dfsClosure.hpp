@@ -31,6 +31,8 @@ class BitSet;
 class Edge;
 class EdgeStore;
 class EdgeQueue;
+class FlexibleWorkGang;
+template <typename E> class GrowableArray;
 
 // Class responsible for iterating the heap depth-first
 class DFSClosure : public ExtendedOopClosure { // XXX BasicOopIterateClosure
@@ -40,10 +42,13 @@ class DFSClosure : public ExtendedOopClosure { // XXX BasicOopIterateClosure
   static const Edge*_start_edge;
   static size_t _max_depth;
   static bool _ignore_root_set;
+  static bool _parallel;
+  static GrowableArray<const oop*>* _roots;
   DFSClosure* _parent;
   const oop* _reference;
   size_t _depth;
 
+  static bool mark(const oop pointee);
   void add_chain();
   void closure_impl(const oop* reference, const oop pointee);
 
@@ -56,6 +61,9 @@ class DFSClosure : public ExtendedOopClosure { // XXX BasicOopIterateClosure
  public:
   static void find_leaks_from_edge(EdgeStore* edge_store, BitSet* mark_bits, const Edge* start_edge);
   static void find_leaks_from_root_set(EdgeStore* edge_store, BitSet* mark_bits);
+  // the roots are marked serially, then searched from by the workers
+  static void find_leaks_from_root_set(EdgeStore* edge_store, BitSet* mark_bits, FlexibleWorkGang* workers);
+  static void find_leaks_from_root(const oop* root);
   void do_root(const oop* ref);
 
   virtual void do_oop(oop* ref);
@@ -41,9 +41,12 @@
 #include "jfr/leakprofiler/sampling/objectSample.hpp"
 #include "jfr/leakprofiler/sampling/objectSampler.hpp"
 #include "jfr/leakprofiler/utilities/granularTimer.hpp"
+#include "jfr/utilities/jfrTimeConverter.hpp"
+#include "memory/sharedHeap.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
+#include "utilities/workgroup.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 PathToGcRootsOperation::PathToGcRootsOperation(ObjectSampler* sampler, EdgeStore* edge_store, int64_t cutoff, bool emit_all) :
@@ -52,11 +55,13 @@ PathToGcRootsOperation::PathToGcRootsOperation(ObjectSampler* sampler, EdgeStore
 /* The EdgeQueue is backed by directly managed virtual memory.
  * We will attempt to dimension an initial reservation
  * in proportion to the size of the heap (represented by heap_region).
- * Initial memory reservation: 5% of the heap OR at least 32 Mb
+ * Initial memory reservation: 5% of the heap OR at least 32 Mb,
+ * but no more than LeakProfilerEdgeQueueMaxSize
  * Commit ratio: 1 : 10 (subject to allocation granularties)
  */
 static size_t edge_queue_memory_reservation(const MemRegion& heap_region) {
-  const size_t memory_reservation_bytes = MAX2(heap_region.byte_size() / 20, 32*M);
+  const size_t memory_reservation_bytes = MIN2(MAX2(heap_region.byte_size() / 20, 32*M),
+                                               MAX2((size_t)LeakProfilerEdgeQueueMaxSize, 32*M));
   assert(memory_reservation_bytes >= (size_t)32*M, "invariant");
   return memory_reservation_bytes;
 }
@@ -77,6 +82,27 @@ static void log_edge_queue_summary(const EdgeQueue& edge_queue) {
   }
 }
 
+// The GC worker gang, when the search is to be parallel and there is one
+static FlexibleWorkGang* chain_workers() {
+  if (!LeakProfilerParallelChains) {
+    return NULL;
+  }
+  SharedHeap* const sh = SharedHeap::heap();
+  if (sh == NULL || sh != Universe::heap()) {
+    return NULL;
+  }
+  FlexibleWorkGang* const workers = sh->workers();
+  return workers != NULL && workers->active_workers() > 1 ? workers : NULL;
+}
+
+static int64_t chain_search_ticks(int64_t cutoff_ticks) {
+  if (LeakProfilerChainTimeout == 0) {
+    return cutoff_ticks;
+  }
+  const jlong timeout_ticks = JfrTimeConverter::nanos_to_countertime((jlong)LeakProfilerChainTimeout * NANOSECS_PER_MILLISEC);
+  return MIN2<int64_t>(cutoff_ticks, MAX2<jlong>(timeout_ticks, 1));
+}
+
 void PathToGcRootsOperation::doit() {
   assert(SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(_cutoff_ticks > 0, "invariant");
@@ -92,7 +118,8 @@ void PathToGcRootsOperation::doit() {
   // The initialize() routines will attempt to reserve and allocate backing storage memory.
   // Failure to accommodate will render root chain processing impossible.
   // As a fallback on failure, just write out the existing samples, flat, without chains.
-  if (!(mark_bits.initialize() && edge_queue.initialize())) {
+  FlexibleWorkGang* const workers = chain_workers();
+  if (!(mark_bits.initialize() && (workers != NULL || edge_queue.initialize()))) {
     if (LogJFR) tty->print_cr("Unable to allocate memory for root chain processing");
     return;
   }
@@ -111,7 +138,16 @@ void PathToGcRootsOperation::doit() {
   BFSClosure bfs(&edge_queue, _edge_store, &mark_bits);
   RootSetClosure<BFSClosure> roots(&bfs);
 
-  GranularTimer::start(_cutoff_ticks, 1000000);
+  GranularTimer::start(chain_search_ticks(_cutoff_ticks), 1000000);
+  if (workers != NULL) {
+    // Depth-first from the roots on all workers; chains are not
+    // necessarily the shortest ones, but no edge queue is needed.
+    DFSClosure::find_leaks_from_root_set(_edge_store, &mark_bits, workers);
+    GranularTimer::stop();
+    EventEmitter emitter(GranularTimer::start_time(), GranularTimer::end_time());
+    emitter.write_events(_sampler, _edge_store, _emit_all);
+    return;
+  }
   roots.process();
   if (edge_queue.is_full()) {
     // Pathological case where roots don't fit in queue
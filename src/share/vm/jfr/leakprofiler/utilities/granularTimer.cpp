@@ -57,7 +57,8 @@ const JfrTicks& GranularTimer::end_time() {
 
 bool GranularTimer::is_finished() {
   assert(_granularity != 0, "GranularTimer::is_finished must be called after GranularTimer::start");
-  if (--_counter == 0) {
+  // the parallel chain search races on the counter, so it may overshoot
+  if (--_counter <= 0) {
     if (_finished) {
       // reset so we decrease to zero at next iteration
       _counter = 1;
@@ -26,6 +26,7 @@
 #include "jvm.h"
 #include "classfile/classLoaderStats.hpp"
 #include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "gc_implementation/g1/g1HeapRegionEventSender.hpp"
@@ -35,10 +36,12 @@
 #include "gc_implementation/shared/vmGCOperations.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/periodic/jfrOSInterface.hpp"
+#include "jfr/periodic/jfrTenantCPULoadEvent.hpp"
 #include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
 #include "jfr/periodic/jfrThreadDumpEvent.hpp"
 #include "jfr/periodic/jfrNetworkUtilization.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/support/jfrMonitorContention.hpp"
 #include "jfr/support/jfrThreadId.hpp"
 #include "jfr/utilities/jfrThreadIterator.hpp"
 #include "jfr/utilities/jfrTime.hpp"
@@ -47,6 +50,7 @@
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/coroutine.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
 #include "runtime/os_perf.hpp"
@@ -168,6 +172,14 @@ TRACE_REQUEST_FUNC(ThreadCPULoad) {
   JfrThreadCPULoadEvent::send_events();
 }
 
+TRACE_REQUEST_FUNC(TenantCPULoad) {
+  JfrTenantCPULoadEvent::send_events();
+}
+
+TRACE_REQUEST_FUNC(JavaMonitorContention) {
+  JfrMonitorContention::send_events();
+}
+
 TRACE_REQUEST_FUNC(NetworkUtilization) {
   JfrNetworkUtilization::send_events();
 }
@@ -314,6 +326,54 @@ TRACE_REQUEST_FUNC(G1HeapRegionInformation) {
   }
 }
 
+class VM_G1SendHeapRegionAllocationSampleEvents : public VM_Operation {
+  virtual void doit() {
+    G1HeapRegionEventSender::send_allocation_sample_events();
+  }
+  virtual VMOp_Type type() const { return VMOp_HeapIterateOperation; }
+};
+
+TRACE_REQUEST_FUNC(G1HeapRegionAllocationSample) {
+  if (UseG1GC && G1RegionAllocationSampleInterval > 0) {
+    VM_G1SendHeapRegionAllocationSampleEvents op;
+    VMThread::execute(&op);
+  }
+}
+
+class VM_SendCoroutineStatisticsEvents : public VM_Operation {
+  virtual void doit() {
+    CoroutineStateCounts counts;
+    for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+      counts.add_thread(thread);
+    }
+    EventWispCoroutineStatistics event;
+    event.set_running(counts.running());
+    event.set_parked(counts.parked());
+    event.set_cached(counts.cached());
+    event.commit();
+    for (uint i = 0; i < counts.num_groups(); i++) {
+      const CoroutineStateCounts::ParkGroup* group = counts.group_at(i);
+      EventWispParkedCoroutines group_event;
+      group_event.set_jvmParkStatus(group->_jvm_park_status);
+      group_event.set_jdkParkStatus(group->_jdk_park_status);
+      group_event.set_count(group->_count);
+      group_event.commit();
+    }
+  }
+  virtual VMOp_Type type() const { return VMOp_CoroutineStatistics; }
+};
+
+TRACE_REQUEST_FUNC(WispCoroutineStatistics) {
+  if (EnableCoroutine) {
+    VM_SendCoroutineStatisticsEvents op;
+    VMThread::execute(&op);
+  }
+}
+
+// Sent together with WispCoroutineStatistics
+TRACE_REQUEST_FUNC(WispParkedCoroutines) {
+}
+
 // Java Mission Control (JMC) uses (Java) Long.MIN_VALUE to describe that a
 // long value is undefined.
 static jlong jmc_undefined_long = min_jlong;
@@ -454,6 +514,30 @@ TRACE_REQUEST_FUNC(ClassLoadingStatistics) {
   event.commit();
 }
 
+// The tables are only swapped at safepoints, which cannot start while this
+// thread is in the VM.
+TRACE_REQUEST_FUNC(SymbolTableStatistics) {
+  SymbolTable* table = SymbolTable::the_table();
+  const int buckets = table->table_size();
+  const int entries = table->number_of_entries();
+  EventSymbolTableStatistics event;
+  event.set_bucketCount(buckets);
+  event.set_entryCount(entries);
+  event.set_averageBucketLength((float)entries / buckets);
+  event.commit();
+}
+
+TRACE_REQUEST_FUNC(StringTableStatistics) {
+  StringTable* table = StringTable::the_table();
+  const int buckets = table->table_size();
+  const int entries = table->number_of_entries();
+  EventStringTableStatistics event;
+  event.set_bucketCount(buckets);
+  event.set_entryCount(entries);
+  event.set_averageBucketLength((float)entries / buckets);
+  event.commit();
+}
+
 class JfrClassLoaderStatsClosure : public ClassLoaderStatsClosure {
 public:
   JfrClassLoaderStatsClosure() : ClassLoaderStatsClosure(NULL) {}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/jfrTenantCPULoadEvent.hpp"
+#include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
+#include "jfr/support/jfrContext.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "utilities/growableArray.hpp"
+
+jlong JfrTenantCPULoadEvent::_last_wallclock_time = 0;
+
+class TenantCPUTime VALUE_OBJ_CLASS_SPEC {
+ public:
+  jlong _tenant_id;
+  int _threads;
+  jlong _cpu_time;
+
+  TenantCPUTime() : _tenant_id(0), _threads(0), _cpu_time(0) {}
+  TenantCPUTime(jlong tenant_id) : _tenant_id(tenant_id), _threads(0), _cpu_time(0) {}
+};
+
+static TenantCPUTime* find_or_add(GrowableArray<TenantCPUTime>* tenants, jlong tenant_id) {
+  for (int i = 0; i < tenants->length(); i++) {
+    if (tenants->adr_at(i)->_tenant_id == tenant_id) {
+      return tenants->adr_at(i);
+    }
+  }
+  tenants->append(TenantCPUTime(tenant_id));
+  return tenants->adr_at(tenants->length() - 1);
+}
+
+void JfrTenantCPULoadEvent::send_events() {
+  if (!MultiTenant || !TenantCpuAccounting) {
+    return;
+  }
+  ResourceMark rm;
+  GrowableArray<TenantCPUTime>* const tenants = new GrowableArray<TenantCPUTime>(8);
+  const JfrTicks event_time = JfrTicks::now();
+  const jlong wallclock_time = JfrThreadCPULoadEvent::get_wallclock_time();
+  const int processor_count = os::active_processor_count();
+  {
+    MutexLockerEx ml(Threads_lock);
+    for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+      JfrThreadLocal* const tl = jt->jfr_thread_local();
+      const jlong cpu_time = os::thread_cpu_time(jt, true);
+      if (cpu_time < 0) {
+        continue;
+      }
+      TenantCPUTime* const tenant = find_or_add(tenants, JfrContext::tenant_id(jt));
+      tenant->_threads++;
+      tenant->_cpu_time += MAX2<jlong>(cpu_time - tl->get_tenant_cpu_time(), 0);
+      tl->set_tenant_cpu_time(cpu_time);
+    }
+  }
+  const jlong elapsed = _last_wallclock_time == 0 ? 0 : wallclock_time - _last_wallclock_time;
+  _last_wallclock_time = wallclock_time;
+  const jlong available = elapsed * processor_count;
+  for (int i = 0; i < tenants->length(); i++) {
+    const TenantCPUTime* const tenant = tenants->adr_at(i);
+    EventTenantCPULoad event(UNTIMED);
+    event.set_starttime(event_time);
+    event.set_tenantId(tenant->_tenant_id);
+    event.set_threads(tenant->_threads);
+    event.set_cpuTime(tenant->_cpu_time);
+    event.set_cpuLoad(available > 0 ? MIN2(1.0f, (float)((double)tenant->_cpu_time / available)) : 0.0f);
+    event.commit();
+  }
+}
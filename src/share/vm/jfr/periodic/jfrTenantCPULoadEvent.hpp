@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_PERIODIC_JFRTENANTCPULOADEVENT_HPP
+#define SHARE_VM_JFR_PERIODIC_JFRTENANTCPULOADEVENT_HPP
+
+#include "jni.h"
+#include "memory/allocation.hpp"
+
+//
+// Sums the CPU time the Java threads used since the previous sample per
+// tenant they are attached to now. Only active with -XX:+MultiTenant and
+// -XX:+TenantCpuAccounting.
+//
+class JfrTenantCPULoadEvent : public AllStatic {
+  static jlong _last_wallclock_time;
+ public:
+  static void send_events();
+};
+
+#endif // SHARE_VM_JFR_PERIODIC_JFRTENANTCPULOADEVENT_HPP
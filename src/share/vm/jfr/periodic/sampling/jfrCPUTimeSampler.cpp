@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "code/codeBlob.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "interpreter/interpreter.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeSampler.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadLocalStorage.hpp"
+#include "utilities/ostream.hpp"
+
+#if defined(LINUX) && (defined(AMD64) || defined(AARCH64))
+#define CPU_TIME_SAMPLER_SUPPORTED
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+static const int SAMPLE_SLOTS = 1024;      // power of two
+static const int MAX_SAMPLE_FRAMES = 64;
+static const int SLOT_CLAIM_ATTEMPTS = 4;
+static const long DRAIN_INTERVAL_MS = 20;
+static const jint NOT_JAVA_THREAD = -1;
+
+enum {
+  SLOT_FREE,
+  SLOT_WRITING,
+  SLOT_READY
+};
+
+// Filled in by the signal handler; a NULL pc separates the native frames
+// from the frames walked from the last Java frame anchor.
+struct JfrCPUSample {
+  volatile jint _state;
+  jint _nr_of_frames;
+  jint _thread_state;
+  bool _truncated;
+  traceid _thread_id;
+  JfrTicks _time;
+  address _pcs[MAX_SAMPLE_FRAMES];
+};
+
+static JfrCPUSample* _samples = NULL;
+static volatile jint _cursor = 0;
+static volatile jint _dropped = 0;
+static uintx _interval_ms = 0;
+static bool _armed = false;
+
+static JfrCPUSample* claim_slot() {
+  for (int attempt = 0; attempt < SLOT_CLAIM_ATTEMPTS; attempt++) {
+    const jint index = Atomic::add(1, &_cursor) & (SAMPLE_SLOTS - 1);
+    JfrCPUSample* const sample = &_samples[index];
+    if (Atomic::cmpxchg((jint)SLOT_WRITING, &sample->_state, (jint)SLOT_FREE) == SLOT_FREE) {
+      return sample;
+    }
+  }
+  // the recorder thread is behind
+  Atomic::inc(&_dropped);
+  return NULL;
+}
+
+#ifdef CPU_TIME_SAMPLER_SUPPORTED
+
+static bool is_walkable_fp(const Thread* thread, intptr_t* fp, intptr_t* sp) {
+  return fp != NULL &&
+         ((uintptr_t)fp & (sizeof(intptr_t) - 1)) == 0 &&
+         fp >= sp &&
+         thread->on_local_stack((address)fp) &&
+         thread->on_local_stack((address)(fp + 1));
+}
+
+// Follows the saved frame pointer / return address pairs. Stops at the
+// first frame that does not keep a frame pointer.
+static void walk_frames(const Thread* thread, JfrCPUSample* sample, address pc, intptr_t* fp, intptr_t* sp) {
+  int n = sample->_nr_of_frames;
+  if (pc != NULL && n < MAX_SAMPLE_FRAMES) {
+    sample->_pcs[n++] = pc;
+  }
+  while (n < MAX_SAMPLE_FRAMES && is_walkable_fp(thread, fp, sp)) {
+    address const ret = (address)fp[1];
+    intptr_t* const sender_fp = (intptr_t*)fp[0];
+    if (ret == NULL) {
+      break;
+    }
+    sample->_pcs[n++] = ret;
+    if (sender_fp <= fp) {
+      break;
+    }
+    sp = fp + 2;
+    fp = sender_fp;
+  }
+  sample->_truncated = n == MAX_SAMPLE_FRAMES;
+  sample->_nr_of_frames = n;
+}
+
+static void record_sample(Thread* thread, void* ucontext) {
+  JfrCPUSample* const sample = claim_slot();
+  if (sample == NULL) {
+    return;
+  }
+  sample->_time = JfrTicks::now();
+  sample->_thread_id = JFR_THREAD_ID(thread);
+  sample->_nr_of_frames = 0;
+  sample->_truncated = false;
+  sample->_thread_state = NOT_JAVA_THREAD;
+
+  intptr_t* sp = NULL;
+  intptr_t* fp = NULL;
+  const ExtendedPC epc = os::fetch_frame_from_context(ucontext, &sp, &fp);
+  walk_frames(thread, sample, epc.pc(), fp, sp);
+
+  if (thread->is_Java_thread()) {
+    JavaThread* const jt = (JavaThread*)thread;
+    sample->_thread_state = (jint)jt->thread_state();
+    // In native or VM code the native walk usually dies in a frame built
+    // without a frame pointer; continue from the anchor of the Java frames.
+    intptr_t* const last_sp = jt->last_Java_sp();
+    if (last_sp != NULL && last_sp > sp && !sample->_truncated &&
+        sample->_nr_of_frames < MAX_SAMPLE_FRAMES - 1) {
+      address last_pc = jt->last_Java_pc();
+      if (last_pc == NULL && jt->on_local_stack((address)(last_sp - 1))) {
+        last_pc = (address)last_sp[-1];
+      }
+      sample->_pcs[sample->_nr_of_frames++] = NULL;
+      walk_frames(thread, sample, last_pc, jt->last_Java_fp(), last_sp);
+    }
+  }
+  OrderAccess::release_store(&sample->_state, (jint)SLOT_READY);
+}
+
+static struct sigaction _previous_action;
+
+static void cpu_time_sample_handler(int sig, siginfo_t* info, void* ucontext) {
+  const int saved_errno = errno;
+  Thread* const thread = ThreadLocalStorage::get_thread_slow();
+  if (thread != NULL) {
+    record_sample(thread, ucontext);
+  }
+  errno = saved_errno;
+}
+
+static bool install_handler() {
+  struct sigaction current;
+  if (sigaction(SIGPROF, NULL, &current) != 0 ||
+      (current.sa_handler != SIG_DFL && current.sa_handler != SIG_IGN)) {
+    // some agent profiles with SIGPROF already
+    return false;
+  }
+  struct sigaction action;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  action.sa_sigaction = cpu_time_sample_handler;
+  return sigaction(SIGPROF, &action, &_previous_action) == 0;
+}
+
+static void set_timer(uintx interval_ms) {
+  struct itimerval timer;
+  timer.it_interval.tv_sec = interval_ms / 1000;
+  timer.it_interval.tv_usec = (interval_ms % 1000) * 1000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, NULL);
+}
+
+#endif // CPU_TIME_SAMPLER_SUPPORTED
+
+bool JfrCPUTimeSampler::is_created() {
+  return _samples != NULL;
+}
+
+bool JfrCPUTimeSampler::create(uintx interval_ms) {
+  assert(!is_created(), "invariant");
+  if (interval_ms == 0) {
+    return true;
+  }
+#ifdef CPU_TIME_SAMPLER_SUPPORTED
+  _samples = NEW_C_HEAP_ARRAY_RETURN_NULL(JfrCPUSample, SAMPLE_SLOTS, mtTracing);
+  if (_samples == NULL) {
+    return false;
+  }
+  memset(_samples, 0, sizeof(JfrCPUSample) * SAMPLE_SLOTS);
+  if (!install_handler()) {
+    warning("SIGPROF is in use, FlightRecorderCPUSampleInterval is ignored");
+    FREE_C_HEAP_ARRAY(JfrCPUSample, _samples, mtTracing);
+    _samples = NULL;
+    return true;
+  }
+  _interval_ms = interval_ms;
+  if (LogJFR) tty->print_cr("CPU time sampler installed, interval " UINTX_FORMAT " ms", interval_ms);
+#else
+  warning("FlightRecorderCPUSampleInterval is not supported on this platform");
+#endif
+  return true;
+}
+
+void JfrCPUTimeSampler::destroy() {
+  if (!is_created()) {
+    return;
+  }
+#ifdef CPU_TIME_SAMPLER_SUPPORTED
+  set_timer(0);
+  _armed = false;
+  sigaction(SIGPROF, &_previous_action, NULL);
+#endif
+  // A late signal may still be writing into a slot, so the slots stay.
+}
+
+long JfrCPUTimeSampler::drain_interval_ms() {
+  return is_created() ? DRAIN_INTERVAL_MS : 0;
+}
+
+static const char* thread_state_name(jint state) {
+  switch (state) {
+    case NOT_JAVA_THREAD:
+      return "Non-Java";
+    case _thread_in_Java:
+    case _thread_in_Java_trans:
+      return "Java";
+    case _thread_in_vm:
+    case _thread_in_vm_trans:
+      return "VM";
+    case _thread_in_native:
+    case _thread_in_native_trans:
+      return "Native";
+    case _thread_blocked:
+    case _thread_blocked_trans:
+      return "Blocked";
+    default:
+      return "New";
+  }
+}
+
+// Describes pcs in the code cache. The blob found may already be a
+// different one than the sampled one; the sample is lazy by design.
+static bool describe_code(address pc, outputStream* st) {
+  MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  CodeBlob* const cb = CodeCache::find_blob_unsafe(pc);
+  if (cb == NULL) {
+    return false;
+  }
+  if (Interpreter::contains(pc)) {
+    st->print_cr("[interpreter]");
+  } else if (cb->is_nmethod()) {
+    nmethod* const nm = (nmethod*)cb;
+    if (!nm->is_alive() || nm->method() == NULL) {
+      st->print_cr("[unloaded nmethod]");
+    } else {
+      char buf[256];
+      st->print_cr("%s [%s]", nm->method()->name_and_sig_as_C_string(buf, sizeof(buf)),
+                   nm->is_native_method() ? "native wrapper" : (nm->is_compiled_by_c1() ? "c1" : "c2"));
+    }
+  } else {
+    st->print_cr("[stub] %s", cb->name());
+  }
+  return true;
+}
+
+static void describe_pc(address pc, outputStream* st) {
+  if (pc == NULL) {
+    st->print_cr("--- last Java frame ---");
+    return;
+  }
+  if (describe_code(pc, st)) {
+    return;
+  }
+  char buf[256];
+  int offset = 0;
+  if (os::dll_address_to_function_name(pc, buf, sizeof(buf), &offset)) {
+    st->print_cr("%s+0x%x", buf, offset);
+  } else {
+    st->print_cr(PTR_FORMAT, p2i(pc));
+  }
+}
+
+void JfrCPUTimeSampler::drain() {
+  if (!is_created()) {
+    return;
+  }
+  const bool enabled = EventMixedExecutionSample::is_enabled();
+#ifdef CPU_TIME_SAMPLER_SUPPORTED
+  if (enabled != _armed) {
+    set_timer(enabled ? _interval_ms : 0);
+    _armed = enabled;
+  }
+#endif
+  for (int i = 0; i < SAMPLE_SLOTS; i++) {
+    JfrCPUSample* const sample = &_samples[i];
+    if (OrderAccess::load_acquire(&sample->_state) != SLOT_READY) {
+      continue;
+    }
+    if (enabled) {
+      ResourceMark rm;
+      stringStream frames;
+      for (int j = 0; j < sample->_nr_of_frames; j++) {
+        describe_pc(sample->_pcs[j], &frames);
+      }
+      EventMixedExecutionSample event(UNTIMED);
+      event.set_starttime(sample->_time);
+      event.set_endtime(sample->_time);
+      event.set_sampledThread(sample->_thread_id);
+      event.set_threadState(thread_state_name(sample->_thread_state));
+      event.set_frames(frames.as_string());
+      event.set_truncated(sample->_truncated);
+      event.commit();
+    }
+    OrderAccess::release_store(&sample->_state, (jint)SLOT_FREE);
+  }
+  const jint dropped = _dropped;
+  if (dropped > 0) {
+    Atomic::add(-dropped, &_dropped);
+    if (LogJFR) tty->print_cr("CPU time sampler dropped %d samples", dropped);
+  }
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMESAMPLER_HPP
+#define SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMESAMPLER_HPP
+
+#include "memory/allocation.hpp"
+
+//
+// SIGPROF driven sampler. The profiling interval timer delivers a signal to
+// whichever thread is burning CPU; the handler walks the frame pointer
+// chain of the interrupted context, crossing into the last Java frame of
+// a thread in native or VM code, and stores the raw pcs in a preallocated
+// slot. Nothing is resolved in the handler: the recorder thread drains the
+// slots, names every pc (nmethod, stub, interpreter or native symbol) and
+// writes a MixedExecutionSample event per sample.
+//
+// Enabled with -XX:FlightRecorderCPUSampleInterval=<ms>, Linux only.
+//
+class JfrCPUTimeSampler : AllStatic {
+ public:
+  // install the handler, false if the interval cannot be honoured
+  static bool create(uintx interval_ms);
+  static void destroy();
+  static bool is_created();
+
+  // how long the recorder thread may wait before draining, 0 for forever
+  static long drain_interval_ms();
+  // called by the recorder thread
+  static void drain();
+};
+
+#endif // SHARE_VM_JFR_PERIODIC_SAMPLING_JFRCPUTIMESAMPLER_HPP
@@ -29,6 +29,7 @@
 #include "jfr/periodic/sampling/jfrThreadSampler.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
+#include "jfr/support/jfrContext.hpp"
 #include "jfr/support/jfrThreadId.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "jfr/utilities/jfrTime.hpp"
@@ -189,6 +190,7 @@ void OSThreadSampler::protected_task(const os::SuspendedThreadTaskContext& conte
       ev->set_endtime(_suspend_time); // fake to not take an end time
       ev->set_sampledThread(JFR_THREAD_ID(jth));
       ev->set_state(java_lang_Thread::get_thread_status(jth->threadObj()));
+      JfrContext::set_context(ev, jth);
     }
   }
 }
@@ -218,6 +220,7 @@ static void write_native_event(JfrThreadSampleClosure& closure, JavaThread* jt)
   ev->set_starttime(JfrTicks::now());
   ev->set_sampledThread(JFR_THREAD_ID(jt));
   ev->set_state(java_lang_Thread::get_thread_status(jt->threadObj()));
+  JfrContext::set_context(ev, jt);
 }
 
 void JfrNativeSamplerCallback::call() {
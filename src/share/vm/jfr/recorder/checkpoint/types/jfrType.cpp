@@ -291,8 +291,10 @@ void CompilerPhaseTypeConstant::serialize(JfrCheckpointWriter& writer) {
 void CodeBlobTypeConstant::serialize(JfrCheckpointWriter& writer) {
   static const u4 nof_entries = CodeBlobType::NumTypes;
   writer.write_count(nof_entries);
-  writer.write_key((u4)CodeBlobType::All);
-  writer.write("CodeCache");
+  for (u4 i = 0; i < nof_entries; ++i) {
+    writer.write_key(i);
+    writer.write(CodeCache::code_blob_type_name(i));
+  }
 };
 
 void VMOperationTypeConstant::serialize(JfrCheckpointWriter& writer) {
@@ -27,6 +27,7 @@
 #include "jfr/instrumentation/jfrJvmtiAgent.hpp"
 #include "jfr/jni/jfrJavaSupport.hpp"
 #include "jfr/periodic/jfrOSInterface.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeSampler.hpp"
 #include "jfr/periodic/sampling/jfrThreadSampler.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/recorder/checkpoint/jfrCheckpointManager.hpp"
@@ -38,6 +39,7 @@
 #include "jfr/recorder/storage/jfrStorage.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/recorder/stringpool/jfrStringPool.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
 #include "jfr/utilities/jfrTime.hpp"
 #include "jfr/writers/jfrJavaEventWriter.hpp"
 #include "memory/resourceArea.hpp"
@@ -271,6 +273,9 @@ bool JfrRecorder::create_components() {
   if (!create_thread_sampling()) {
     return false;
   }
+  if (!create_event_throttlers()) {
+    return false;
+  }
   return true;
 }
 
@@ -338,14 +343,19 @@ bool JfrRecorder::create_stringpool() {
   return _stringpool != NULL && _stringpool->initialize();
 }
 
+bool JfrRecorder::create_event_throttlers() {
+  return JfrEventThrottler::configure(FlightRecorderEventRates);
+}
+
 bool JfrRecorder::create_thread_sampling() {
   assert(_thread_sampling == NULL, "invariant");
   _thread_sampling = JfrThreadSampling::create();
-  return _thread_sampling != NULL;
+  return _thread_sampling != NULL && JfrCPUTimeSampler::create(FlightRecorderCPUSampleInterval);
 }
 
 void JfrRecorder::destroy_components() {
   JfrJvmtiAgent::destroy();
+  JfrEventThrottler::destroy();
   if (_post_box != NULL) {
     JfrPostBox::destroy();
     _post_box = NULL;
@@ -374,6 +384,7 @@ void JfrRecorder::destroy_components() {
     JfrOSInterface::destroy();
     _os_interface = NULL;
   }
+  JfrCPUTimeSampler::destroy();
   if (_thread_sampling != NULL) {
     JfrThreadSampling::destroy();
     _thread_sampling = NULL;
@@ -28,6 +28,7 @@
 #include "jfr/utilities/jfrTime.hpp"
 #include "jfr/utilities/jfrTimeConverter.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/os.hpp"
 
 static const char* const MAGIC = "FLR";
@@ -100,6 +101,9 @@ u2 JfrChunk::flags() const {
   if (_final) {
     flags |= 1 << 1;
   }
+  if (FlightRecorderCompressChunks) {
+    flags |= 1 << 2;
+  }
   return flags;
 }
 
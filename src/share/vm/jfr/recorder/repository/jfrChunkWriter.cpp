@@ -25,7 +25,10 @@
 #include "precompiled.hpp"
 #include "jfr/recorder/repository/jfrChunk.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
+#include "jfr/recorder/repository/jfrStreamRing.hpp"
+#include "jfr/utilities/jfrLZ4.hpp"
 #include "jfr/utilities/jfrTime.hpp"
+#include "runtime/globals.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 
@@ -43,6 +46,7 @@ static const int64_t CPU_FREQUENCY_OFFSET = START_TICKS_OFFSET + SLOT_SIZE;
 static const int64_t GENERATION_OFFSET = CPU_FREQUENCY_OFFSET + SLOT_SIZE;
 static const int64_t FLAG_OFFSET = GENERATION_OFFSET + 2;
 static const int64_t HEADER_SIZE = FLAG_OFFSET + 2;
+static const size_t MIN_COMPRESSED_BLOCK = 4 * K;
 
 static fio_fd open_chunk(const char* path) {
   assert(JfrStream_lock->owned_by_self(), "invariant");
@@ -226,11 +230,59 @@ int64_t JfrChunkWriter::flush_chunk(bool flushpoint) {
   return sz_written;
 }
 
-JfrChunkWriter::JfrChunkWriter() : JfrChunkWriterBase(NULL), _chunk(new JfrChunk()) {}
+JfrChunkWriter::JfrChunkWriter() : JfrChunkWriterBase(NULL), _chunk(new JfrChunk()), _ring(NULL),
+  _compressed(NULL), _compressed_capacity(0), _compression_table(NULL) {
+  if (FlightRecorderRingFile != NULL) {
+    _ring = JfrStreamRing::create(FlightRecorderRingFile, FlightRecorderRingSize);
+    set_ring(_ring);
+  }
+}
 
 JfrChunkWriter::~JfrChunkWriter() {
   assert(_chunk != NULL, "invariant");
   delete _chunk;
+  if (_ring != NULL) {
+    set_ring(NULL);
+    JfrStreamRing::destroy(_ring);
+    _ring = NULL;
+  }
+  if (_compressed != NULL) {
+    JfrCHeapObj::free(_compressed, _compressed_capacity);
+    JfrCHeapObj::free(_compression_table, JfrLZ4::table_size * sizeof(u4));
+  }
+}
+
+//
+// A compressed block is a pseudo event of reserved type EVENT_COMPRESSEDBLOCK
+// holding the uncompressed size and an LZ4 block of whole events. Readers not
+// aware of it skip it by its size; checkpoints and metadata are never
+// compressed and remain at the offsets recorded in the chunk header.
+//
+void JfrChunkWriter::write_events(const u1* data, size_t size) {
+  if (!FlightRecorderCompressChunks || size < MIN_COMPRESSED_BLOCK || size > max_jint) {
+    write_unbuffered(data, size);
+    return;
+  }
+  const size_t bound = JfrLZ4::bound(size);
+  if (bound > _compressed_capacity) {
+    if (_compressed != NULL) {
+      JfrCHeapObj::free(_compressed, _compressed_capacity);
+    } else {
+      _compression_table = JfrCHeapObj::new_array<u4>(JfrLZ4::table_size);
+    }
+    _compressed_capacity = MAX2(bound, (size_t)M);
+    _compressed = JfrCHeapObj::new_array<u1>(_compressed_capacity);
+  }
+  const size_t compressed_size = JfrLZ4::compress(data, size, _compressed, _compression_table);
+  if (compressed_size + 3 * sizeof(u8) >= size) {
+    write_unbuffered(data, size);
+    return;
+  }
+  const int64_t block_offset = reserve(sizeof(u4));
+  write<u8>(EVENT_COMPRESSEDBLOCK);
+  write<u4>((u4)size);
+  write_unbuffered(_compressed, compressed_size);
+  write_padded_at_offset<u4>((u4)(current_offset() - block_offset), block_offset);
 }
 
 void JfrChunkWriter::set_path(const char* path) {
@@ -278,6 +330,9 @@ bool JfrChunkWriter::open() {
   const bool is_open = this->has_valid_fd();
   if (is_open) {
     assert(0 == this->current_offset(), "invariant");
+    if (_ring != NULL) {
+      _ring->begin_chunk();
+    }
     _chunk->reset();
     JfrChunkHeadWriter head(this, HEADER_SIZE);
   }
@@ -35,12 +35,17 @@ typedef WriterHost<BigEndianEncoder, CompressedIntegerEncoder, JfrBufferedChunkW
 
 class JfrChunk;
 class JfrChunkHeadWriter;
+class JfrStreamRing;
 
 class JfrChunkWriter : public JfrChunkWriterBase {
   friend class JfrChunkHeadWriter;
   friend class JfrRepository;
  private:
   JfrChunk* _chunk;
+  JfrStreamRing* _ring;
+  u1* _compressed;
+  size_t _compressed_capacity;
+  u4* _compression_table;
   void set_path(const char* path);
   int64_t flush_chunk(bool flushpoint);
   bool open();
@@ -60,6 +65,8 @@ class JfrChunkWriter : public JfrChunkWriterBase {
   bool has_metadata() const;
   void set_time_stamp();
   void mark_chunk_final();
+  // event storage, written as an LZ4 block when compression is enabled
+  void write_events(const u1* data, size_t size);
 };
 
 #endif // SHARE_VM_JFR_RECORDER_REPOSITORY_JFRCHUNKWRITER_HPP
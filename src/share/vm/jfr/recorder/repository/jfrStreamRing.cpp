@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#include "precompiled.hpp"
+#include "jfr/recorder/repository/jfrStreamRing.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/debug.hpp"
+
+static const char ring_magic[8] = { 'J', 'F', 'R', 'R', 'I', 'N', 'G', '\0' };
+static const u4 ring_version = 1;
+
+JfrStreamRing::JfrStreamRing(JfrStreamRingHeader* header, size_t capacity, size_t mapped_size) :
+  _header(header),
+  _data((u1*)header + sizeof(JfrStreamRingHeader)),
+  _capacity(capacity),
+  _mapped_size(mapped_size) {
+  memset(_header, 0, sizeof(JfrStreamRingHeader));
+  _header->version = ring_version;
+  _header->header_size = (u4)sizeof(JfrStreamRingHeader);
+  _header->capacity = (u8)capacity;
+  OrderAccess::storestore();
+  // the magic goes last, readers ignore the file until it is there
+  memcpy(_header->magic, ring_magic, sizeof(ring_magic));
+}
+
+JfrStreamRing::~JfrStreamRing() {
+#ifndef _WINDOWS
+  os::Posix::unmap_shared_memory((char*)_header, _mapped_size);
+#endif
+}
+
+JfrStreamRing* JfrStreamRing::create(const char* path, size_t capacity) {
+  assert(path != NULL, "invariant");
+#ifdef _WINDOWS
+  warning("FlightRecorderRingFile is not supported on this platform");
+  return NULL;
+#else
+  capacity = align_size_up(MAX2(capacity, (size_t)os::vm_page_size()), os::vm_page_size());
+  const size_t mapped_size = sizeof(JfrStreamRingHeader) + capacity;
+  const int fd = os::open(path, O_CREAT | O_RDWR | O_TRUNC, S_IREAD | S_IWRITE);
+  if (fd < 0) {
+    warning("Could not open FlightRecorderRingFile %s", path);
+    return NULL;
+  }
+  char* base = os::Posix::map_shared_memory(fd, mapped_size);
+  os::close(fd);
+  if (base == NULL) {
+    warning("Could not map FlightRecorderRingFile %s", path);
+    return NULL;
+  }
+  return new JfrStreamRing((JfrStreamRingHeader*)base, capacity, mapped_size);
+#endif
+}
+
+void JfrStreamRing::destroy(JfrStreamRing* ring) {
+  delete ring;
+}
+
+void JfrStreamRing::begin_update() {
+  OrderAccess::release_store((volatile jlong*)&_header->sequence, (jlong)(_header->sequence + 1));
+  OrderAccess::fence();
+}
+
+void JfrStreamRing::end_update() {
+  OrderAccess::release_store((volatile jlong*)&_header->sequence, (jlong)(_header->sequence + 1));
+}
+
+void JfrStreamRing::begin_chunk() {
+  begin_update();
+  memset(_header->chunk_header, 0, sizeof(_header->chunk_header));
+  _header->position = 0;
+  _header->generation++;
+  end_update();
+}
+
+// Called with JfrStream_lock held, the chunk writer is the only writer.
+void JfrStreamRing::write(int64_t offset, const void* buf, size_t len) {
+  assert(offset >= 0, "invariant");
+  if (len == 0) {
+    return;
+  }
+  const u1* src = (const u1*)buf;
+  const u8 begin = (u8)offset;
+  const u8 end = begin + len;
+  begin_update();
+  if (begin < sizeof(_header->chunk_header)) {
+    const size_t n = MIN2((size_t)(sizeof(_header->chunk_header) - begin), len);
+    memcpy(_header->chunk_header + begin, src, n);
+  }
+  // only the last 'capacity' bytes of the stream are kept
+  const u8 position = MAX2(_header->position, end);
+  const u8 window_start = position > _capacity ? position - _capacity : 0;
+  u8 from = MAX2(begin, window_start);
+  while (from < end) {
+    const size_t index = (size_t)(from % _capacity);
+    const size_t n = (size_t)MIN2(end - from, (u8)(_capacity - index));
+    memcpy(_data + index, src + (from - begin), n);
+    from += n;
+  }
+  _header->position = position;
+  end_update();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef SHARE_VM_JFR_RECORDER_REPOSITORY_JFRSTREAMRING_HPP
+#define SHARE_VM_JFR_RECORDER_REPOSITORY_JFRSTREAMRING_HPP
+
+#include "jfr/utilities/jfrAllocation.hpp"
+
+//
+// Mirrors the byte stream of the chunk being written into a memory-mapped
+// file (-XX:FlightRecorderRingFile), so that an external process can decode
+// events, metadata and checkpoints without waiting for a chunk rotation.
+//
+// File layout: a JfrStreamRingHeader followed by 'capacity' data bytes. The
+// chunk byte at offset o is kept at data[o % capacity] for as long as
+// o >= position - capacity. Bytes rewritten in place after a seek (the chunk
+// header) are also kept in the header's chunk_header copy.
+//
+// Readers sample 'sequence', copy what they need and sample it again; the
+// copy is consistent if both samples are equal and even. 'generation' is
+// bumped for every new chunk, which restarts 'position' at zero.
+//
+struct JfrStreamRingHeader {
+  char magic[8];
+  u4 version;
+  u4 header_size;
+  u8 capacity;
+  volatile u8 sequence;
+  volatile u8 generation;
+  volatile u8 position;
+  u1 chunk_header[128];
+};
+
+class JfrStreamRing : public JfrCHeapObj {
+ private:
+  JfrStreamRingHeader* _header;
+  u1* _data;
+  size_t _capacity;
+  size_t _mapped_size;
+
+  JfrStreamRing(JfrStreamRingHeader* header, size_t capacity, size_t mapped_size);
+  ~JfrStreamRing();
+
+  void begin_update();
+  void end_update();
+
+ public:
+  static JfrStreamRing* create(const char* path, size_t capacity);
+  static void destroy(JfrStreamRing* ring);
+
+  // a new chunk is started, its stream begins at offset 0
+  void begin_chunk();
+  // bytes written to the chunk at the given stream offset
+  void write(int64_t offset, const void* buf, size_t len);
+};
+
+#endif // SHARE_VM_JFR_RECORDER_REPOSITORY_JFRSTREAMRING_HPP
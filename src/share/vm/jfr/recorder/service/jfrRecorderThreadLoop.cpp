@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "jfr/periodic/sampling/jfrCPUTimeSampler.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
 #include "jfr/recorder/service/jfrPostBox.hpp"
 #include "jfr/recorder/service/jfrRecorderService.hpp"
@@ -55,10 +56,11 @@ void recorderthread_entry(JavaThread* thread, Thread* unused) {
     // JFR MESSAGE LOOP PROCESSING - BEGIN
     while (!done) {
       if (post_box.is_empty()) {
-        JfrMsg_lock->wait(false);
+        JfrMsg_lock->wait(false, JfrCPUTimeSampler::drain_interval_ms());
       }
       msgs = post_box.collect();
       JfrMsg_lock->unlock();
+      JfrCPUTimeSampler::drain();
       if (PROCESS_FULL_BUFFERS) {
         service.process_full_buffers();
       }
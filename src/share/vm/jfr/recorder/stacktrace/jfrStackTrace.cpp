@@ -101,6 +101,47 @@ bool JfrStackFrame::equals(const JfrStackFrame& rhs) const {
   return _methodid == rhs._methodid && _bci == rhs._bci && _type == rhs._type;
 }
 
+JfrStackTraceCache::JfrStackTraceCache() {
+  memset(_entries, 0, sizeof(_entries));
+}
+
+bool JfrStackTraceCache::matches(const Entry& entry, const JfrStackTrace& trace, u4 generation) const {
+  if (entry._id == 0 || entry._generation != generation || entry._hash != trace._hash ||
+      entry._nr_of_frames != trace._nr_of_frames || entry._reached_root != trace._reached_root) {
+    return false;
+  }
+  const u4 key_frames = MIN2(trace._nr_of_frames, KEY_FRAMES);
+  for (u4 i = 0; i < key_frames; ++i) {
+    const JfrStackFrame& frame = trace._frames[i];
+    if (entry._methodids[i] != frame._methodid || entry._bcis[i] != frame._bci || entry._types[i] != frame._type) {
+      return false;
+    }
+  }
+  return true;
+}
+
+traceid JfrStackTraceCache::lookup(const JfrStackTrace& trace, u4 generation) const {
+  const Entry& entry = _entries[trace._hash % CACHE_SIZE];
+  return matches(entry, trace, generation) ? entry._id : 0;
+}
+
+void JfrStackTraceCache::insert(const JfrStackTrace& trace, traceid id, u4 generation) {
+  assert(id != 0, "invariant");
+  Entry& entry = _entries[trace._hash % CACHE_SIZE];
+  entry._id = id;
+  entry._generation = generation;
+  entry._hash = trace._hash;
+  entry._nr_of_frames = trace._nr_of_frames;
+  entry._reached_root = trace._reached_root;
+  const u4 key_frames = MIN2(trace._nr_of_frames, KEY_FRAMES);
+  for (u4 i = 0; i < key_frames; ++i) {
+    const JfrStackFrame& frame = trace._frames[i];
+    entry._methodids[i] = frame._methodid;
+    entry._bcis[i] = frame._bci;
+    entry._types[i] = frame._type;
+  }
+}
+
 bool JfrStackTrace::equals(const JfrStackTrace& rhs) const {
   if (_reached_root != rhs._reached_root || _nr_of_frames != rhs._nr_of_frames || _hash != rhs._hash) {
     return false;
@@ -44,6 +44,7 @@ enum StackWalkMode {
 };
 
 class JfrStackFrame {
+  friend class JfrStackTraceCache;
   friend class ObjectSampleCheckpoint;
  private:
   const Method* _method;
@@ -72,6 +73,7 @@ class JfrStackFrame {
 
 class JfrStackTrace : public JfrCHeapObj {
   friend class JfrNativeSamplerCallback;
+  friend class JfrStackTraceCache;
   friend class JfrStackTraceRepository;
   friend class ObjectSampleCheckpoint;
   friend class ObjectSampler;
@@ -118,4 +120,33 @@ class JfrStackTrace : public JfrCHeapObj {
   traceid id() const { return _id; }
 };
 
+// A small direct-mapped cache of the traces a thread recorded last, so that
+// a hot site is resolved to its trace id without the repository lock.
+// Entries are tagged with the repository generation, which changes whenever
+// the repository is cleared.
+class JfrStackTraceCache : public JfrCHeapObj {
+ private:
+  static const u4 CACHE_SIZE = 16;
+  static const u4 KEY_FRAMES = 4;
+  struct Entry {
+    traceid _id;
+    u4 _generation;
+    unsigned int _hash;
+    u4 _nr_of_frames;
+    bool _reached_root;
+    traceid _methodids[KEY_FRAMES];
+    int _bcis[KEY_FRAMES];
+    u1 _types[KEY_FRAMES];
+  };
+  Entry _entries[CACHE_SIZE];
+
+  bool matches(const Entry& entry, const JfrStackTrace& trace, u4 generation) const;
+
+ public:
+  JfrStackTraceCache();
+  // id of an equal trace recorded in this generation, or 0
+  traceid lookup(const JfrStackTrace& trace, u4 generation) const;
+  void insert(const JfrStackTrace& trace, traceid id, u4 generation);
+};
+
 #endif // SHARE_JFR_RECORDER_STACKTRACE_JFRSTACKTRACE_HPP
@@ -28,10 +28,14 @@
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
 
 static JfrStackTraceRepository* _instance = NULL;
 
+volatile u4 JfrStackTraceRepository::_generation = 0;
+
 JfrStackTraceRepository::JfrStackTraceRepository() : _next_id(0), _entries(0) {
   memset(_table, 0, sizeof(_table));
 }
@@ -101,6 +105,7 @@ size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
   if (clear) {
     memset(_table, 0, sizeof(_table));
     _entries = 0;
+    Atomic::inc((volatile jint*)&_generation);
   }
   last_id = _next_id;
   return count;
@@ -120,6 +125,7 @@ size_t JfrStackTraceRepository::clear() {
     }
   }
   memset(_table, 0, sizeof(_table));
+  Atomic::inc((volatile jint*)&_generation);
   const size_t processed = _entries;
   _entries = 0;
   return processed;
@@ -147,7 +153,23 @@ traceid JfrStackTraceRepository::record(Thread* thread, int skip, StackWalkMode
 
 traceid JfrStackTraceRepository::record_for(JavaThread* thread, int skip, StackWalkMode mode, JfrStackFrame *frames, u4 max_frames) {
   JfrStackTrace stacktrace(frames, max_frames);
-  return stacktrace.record_safe(thread, skip, mode) ? add(stacktrace) : 0;
+  return stacktrace.record_safe(thread, skip, mode) ? add_cached(thread->jfr_thread_local(), stacktrace) : 0;
+}
+
+traceid JfrStackTraceRepository::add_cached(JfrThreadLocal* tl, const JfrStackTrace& stacktrace) {
+  JfrStackTraceCache* const cache = tl->stack_trace_cache();
+  if (cache == NULL) {
+    return add(stacktrace);
+  }
+  // read before adding, so an id from a table cleared meanwhile is never reused
+  const u4 generation = (u4)OrderAccess::load_acquire((volatile jint*)&_generation);
+  traceid tid = cache->lookup(stacktrace, generation);
+  if (tid != 0) {
+    return tid;
+  }
+  tid = add(stacktrace);
+  cache->insert(stacktrace, tid, generation);
+  return tid;
 }
 
 traceid JfrStackTraceRepository::add(const JfrStackTrace& stacktrace) {
@@ -32,6 +32,7 @@
 class JavaThread;
 class JfrCheckpointWriter;
 class JfrChunkWriter;
+class JfrThreadLocal;
 class vframeStream;
 
 class JfrStackTraceRepository : public JfrCHeapObj {
@@ -48,6 +49,8 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   JfrStackTrace* _table[TABLE_SIZE];
   traceid _next_id;
   u4 _entries;
+  // bumped whenever the table is cleared, invalidates the thread caches
+  static volatile u4 _generation;
 
   JfrStackTraceRepository();
   static JfrStackTraceRepository& instance();
@@ -63,6 +66,7 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
   traceid add_trace(const JfrStackTrace& stacktrace);
   static traceid add(const JfrStackTrace& stacktrace);
+  static traceid add_cached(JfrThreadLocal* tl, const JfrStackTrace& stacktrace);
   traceid record_for(JavaThread* thread, int skip, StackWalkMode mode, JfrStackFrame* frames, u4 max_frames);
 
  public:
@@ -593,7 +593,7 @@ BufferPtr JfrStorage::provision_large(BufferPtr cur, const u1* const cur_pos, si
   return store_buffer_to_thread_local(buffer, t->jfr_thread_local(), native);
 }
 
-typedef UnBufferedWriteToChunk<JfrBuffer> WriteOperation;
+typedef CompressedWriteToChunk<JfrBuffer> WriteOperation;
 typedef MutexedWriteOp<WriteOperation> MutexedWriteOperation;
 typedef ConcurrentWriteOp<WriteOperation> ConcurrentWriteOperation;
 
@@ -81,6 +81,21 @@ class UnBufferedWriteToChunk {
   size_t size() const { return _size; }
 };
 
+// event data, compressed by the chunk writer when enabled
+template <typename T>
+class CompressedWriteToChunk {
+ private:
+  JfrChunkWriter& _writer;
+  size_t _elements;
+  size_t _size;
+ public:
+  typedef T Type;
+  CompressedWriteToChunk(JfrChunkWriter& writer) : _writer(writer), _elements(0), _size(0) {}
+  bool write(Type* t, const u1* data, size_t size);
+  size_t elements() const { return _elements; }
+  size_t size() const { return _size; }
+};
+
 template <typename T>
 class DefaultDiscarder {
  private:
@@ -36,6 +36,14 @@ inline bool UnBufferedWriteToChunk<T>::write(T* t, const u1* data, size_t size)
   return true;
 }
 
+template <typename T>
+inline bool CompressedWriteToChunk<T>::write(T* t, const u1* data, size_t size) {
+  _writer.write_events(data, size);
+  ++_elements;
+  _size += size;
+  return true;
+}
+
 template <typename T>
 inline bool DefaultDiscarder<T>::discard(T* t, const u1* data, size_t size) {
   ++_elements;
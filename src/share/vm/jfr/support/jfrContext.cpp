@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "jfr/support/jfrContext.hpp"
+#include "runtime/coroutine.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/thread.inline.hpp"
+
+static JavaThread* carrier(Thread* thread) {
+  if (thread == NULL) {
+    return NULL;
+  }
+  if (thread->is_Wisp_thread()) {
+    return ((WispThread*)thread)->thread();
+  }
+  return thread->is_Java_thread() ? (JavaThread*)thread : NULL;
+}
+
+int JfrContext::wisp_task_id(Thread* thread) {
+  if (!EnableCoroutine) {
+    return Coroutine::WISP_ID_NOT_SET;
+  }
+  Coroutine* coroutine = NULL;
+  if (thread != NULL && thread->is_Wisp_thread()) {
+    coroutine = ((WispThread*)thread)->coroutine();
+  } else {
+    JavaThread* const jt = carrier(thread);
+    coroutine = jt != NULL ? jt->current_coroutine() : NULL;
+  }
+  return coroutine != NULL ? coroutine->wisp_task_id() : (int)Coroutine::WISP_ID_NOT_SET;
+}
+
+jlong JfrContext::tenant_id(Thread* thread) {
+#if INCLUDE_ALL_GCS
+  if (MultiTenant) {
+    JavaThread* const jt = carrier(thread);
+    if (jt != NULL && jt->tenantObj() != NULL) {
+      return com_alibaba_tenant_TenantContainer::get_tenant_id(jt->tenantObj());
+    }
+  }
+#endif
+  return 0;
+}
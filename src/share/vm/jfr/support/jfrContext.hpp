@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_SUPPORT_JFRCONTEXT_HPP
+#define SHARE_VM_JFR_SUPPORT_JFRCONTEXT_HPP
+
+#include "memory/allocation.hpp"
+
+class Thread;
+
+//
+// What an event runs on behalf of, beyond the carrier thread: the Wisp
+// task scheduled on it and the tenant it is attached to.
+//
+class JfrContext : AllStatic {
+ public:
+  // id of the Wisp task running on the thread, -1 outside Wisp tasks
+  static int wisp_task_id(Thread* thread);
+  // id of the tenant the thread is attached to, 0 for the root tenant
+  static jlong tenant_id(Thread* thread);
+
+  template <typename Event>
+  static void set_context(Event* event, Thread* thread) {
+    event->set_wispTaskId(wisp_task_id(thread));
+    event->set_tenantId(tenant_id(thread));
+  }
+};
+
+#endif // SHARE_VM_JFR_SUPPORT_JFRCONTEXT_HPP
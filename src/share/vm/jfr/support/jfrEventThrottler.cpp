@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "jfr/support/jfrEventThrottler.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/debug.hpp"
+
+static const jlong window_millis = 100;
+
+// event types that can be throttled, they all have a weight field
+static const struct {
+  const char* name;
+  JfrEventId id;
+} throttled_events[] = {
+  { "ObjectAllocationInNewTLAB",    JfrObjectAllocationInNewTLABEvent },
+  { "ObjectAllocationOutsideTLAB",  JfrObjectAllocationOutsideTLABEvent },
+  { "OptoInstanceObjectAllocation", JfrOptoInstanceObjectAllocationEvent },
+  { "OptoArrayObjectAllocation",    JfrOptoArrayObjectAllocationEvent }
+};
+
+JfrEventThrottler* JfrEventThrottler::_throttlers[MaxJfrEventId] = { NULL };
+
+static jlong window_ticks() {
+  return os::elapsed_frequency() * window_millis / 1000;
+}
+
+JfrEventThrottler::JfrEventThrottler(jlong rate) :
+  _budget(MAX2(rate * window_millis / 1000, (jlong)1)),
+  _window_end(os::elapsed_counter() + window_ticks()),
+  _seen(0),
+  _accepted(0),
+  _interval(1),
+  _average(0) {
+}
+
+void JfrEventThrottler::rotate(jlong now) {
+  const jlong end = _window_end;
+  if (now < end || Atomic::cmpxchg(now + window_ticks(), &_window_end, end) != end) {
+    // not yet due, or another thread rotates
+    return;
+  }
+  // an idle stretch spans several windows
+  const jlong windows = (now - end) / window_ticks() + 1;
+  const jint seen = (jint)(_seen / windows);
+  _average = (_average + seen) / 2;
+  const jint interval = (jint)MAX2((jlong)1, (_average + _budget - 1) / _budget);
+  _interval = interval;
+  _accepted = 0;
+  _seen = 0;
+}
+
+bool JfrEventThrottler::sample(u8* weight) {
+  const jlong now = os::elapsed_counter();
+  if (now >= _window_end) {
+    rotate(now);
+  }
+  const jint interval = _interval;
+  const jint n = Atomic::add(1, &_seen);
+  if (n % interval != 0) {
+    return false;
+  }
+  if (Atomic::add(1, &_accepted) > _budget) {
+    return false;
+  }
+  *weight = (u8)interval;
+  return true;
+}
+
+// Only called while the recorder is being created, before any event of the
+// type can be committed.
+void JfrEventThrottler::set_rate(JfrEventId event_id, jlong rate) {
+  assert(event_id < MaxJfrEventId, "invariant");
+  if (_throttlers[event_id] != NULL) {
+    delete _throttlers[event_id];
+  }
+  _throttlers[event_id] = rate > 0 ? new JfrEventThrottler(rate) : NULL;
+}
+
+bool JfrEventThrottler::configure(const char* rates) {
+  if (rates == NULL) {
+    return true;
+  }
+  const char* p = rates;
+  while (*p != '\0') {
+    const char* eq = strchr(p, '=');
+    if (eq == NULL) {
+      break;
+    }
+    const size_t name_len = eq - p;
+    char* end = NULL;
+    const jlong rate = (jlong)strtol(eq + 1, &end, 10);
+    if (end == eq + 1 || (*end != ',' && *end != '\0') || rate < 0) {
+      break;
+    }
+    bool found = false;
+    for (size_t i = 0; i < ARRAY_SIZE(throttled_events); i++) {
+      if (strlen(throttled_events[i].name) == name_len &&
+          strncmp(throttled_events[i].name, p, name_len) == 0) {
+        set_rate(throttled_events[i].id, rate);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      warning("FlightRecorderEventRates: event %.*s can not be throttled", (int)name_len, p);
+    }
+    p = *end == ',' ? end + 1 : end;
+  }
+  if (*p != '\0') {
+    warning("FlightRecorderEventRates: malformed specification at %s", p);
+    return false;
+  }
+  return true;
+}
+
+void JfrEventThrottler::destroy() {
+  for (int i = 0; i < MaxJfrEventId; i++) {
+    if (_throttlers[i] != NULL) {
+      delete _throttlers[i];
+      _throttlers[i] = NULL;
+    }
+  }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
+#define SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
+
+#include "jfr/utilities/jfrAllocation.hpp"
+#include "jfr/utilities/jfrTypes.hpp"
+
+//
+// Caps the number of events of a type written per second. Within each
+// window every interval-th event is accepted, up to the window budget; the
+// interval adapts to the rate seen in the previous windows. Accepted events
+// carry the interval as their weight, so totals can be scaled back up.
+//
+// Rates are set with -XX:FlightRecorderEventRates=<event>=<per second>,...
+// for the event types listed in jfrEventThrottler.cpp.
+//
+class JfrEventThrottler : public JfrCHeapObj {
+ private:
+  static JfrEventThrottler* _throttlers[MaxJfrEventId];
+
+  const jlong _budget;               // events accepted per window
+  volatile jlong _window_end;        // in os::elapsed_counter() ticks
+  volatile jint _seen;               // events offered in the current window
+  volatile jint _accepted;           // events accepted in the current window
+  volatile jint _interval;           // accept every _interval-th event
+  jint _average;                     // smoothed events offered per window
+
+  JfrEventThrottler(jlong rate);
+  void rotate(jlong now);
+  bool sample(u8* weight);
+
+ public:
+  // parse the rates, false for a malformed specification
+  static bool configure(const char* rates);
+  static void destroy();
+  // rate in events per second, 0 for no throttling
+  static void set_rate(JfrEventId event_id, jlong rate);
+
+  // whether an event of the type is to be committed, and what it weighs
+  static bool accept(JfrEventId event_id, u8* weight) {
+    JfrEventThrottler* const throttler = _throttlers[event_id];
+    if (throttler == NULL) {
+      *weight = 1;
+      return true;
+    }
+    return throttler->sample(weight);
+  }
+};
+
+#endif // SHARE_VM_JFR_SUPPORT_JFREVENTTHROTTLER_HPP
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrMonitorContention.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "jfr/utilities/jfrSpinlockHelper.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.hpp"
+#include "oops/method.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/objectMonitor.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
+#include "utilities/growableArray.hpp"
+
+class JfrMonitorContentionEntry VALUE_OBJ_CLASS_SPEC {
+ public:
+  const Klass* _klass;
+  const Method* _method;
+  const Method* _owner_method;
+  int _bci;
+  int _owner_bci;
+  u8 _count;
+  jlong _total_nanos;
+  jlong _max_nanos;
+
+  bool is_empty() const {
+    return _klass == NULL;
+  }
+
+  void clear() {
+    _klass = NULL;
+  }
+
+  bool same_key(const JfrMonitorContentionEntry& other) const {
+    return _klass == other._klass && _method == other._method && _bci == other._bci &&
+           _owner_method == other._owner_method && _owner_bci == other._owner_bci;
+  }
+
+  void merge(const JfrMonitorContentionEntry& other) {
+    _count += other._count;
+    _total_nanos += other._total_nanos;
+    _max_nanos = MAX2(_max_nanos, other._max_nanos);
+  }
+
+  uintptr_t hash() const {
+    uintptr_t h = (uintptr_t)_klass >> 3;
+    h = h * 31 + ((uintptr_t)_method >> 3);
+    h = h * 31 + (uintptr_t)_bci;
+    h = h * 31 + ((uintptr_t)_owner_method >> 3);
+    h = h * 31 + (uintptr_t)_owner_bci;
+    return h ^ (h >> 16);
+  }
+
+  bool is_unloading() const {
+    return _klass->class_loader_data()->is_unloading() ||
+           (_method != NULL && _method->method_holder()->class_loader_data()->is_unloading()) ||
+           (_owner_method != NULL && _owner_method->method_holder()->class_loader_data()->is_unloading());
+  }
+};
+
+//
+// Direct mapped, a colliding key evicts the resident entry to the
+// global table.
+//
+class JfrMonitorContentionTable : public CHeapObj<mtTracing> {
+ public:
+  enum { size = 16 };
+  JfrMonitorContentionEntry _entries[size];
+  volatile int _lock;
+
+  JfrMonitorContentionTable() : _lock(0) {
+    for (int i = 0; i < size; ++i) {
+      _entries[i].clear();
+    }
+  }
+};
+
+// global, open addressing
+static const int global_size = 1024;
+static const int global_limit = global_size * 3 / 4;
+static JfrMonitorContentionEntry* _global = NULL;
+static int _global_count = 0;
+static u8 _global_dropped = 0;
+static volatile int _global_lock = 0;
+
+// requires _global_lock
+static void merge_global(const JfrMonitorContentionEntry& entry) {
+  assert(!entry.is_empty(), "invariant");
+  if (_global == NULL) {
+    _global = NEW_C_HEAP_ARRAY(JfrMonitorContentionEntry, global_size, mtTracing);
+    for (int i = 0; i < global_size; ++i) {
+      _global[i].clear();
+    }
+  }
+  for (uintptr_t index = entry.hash();; ++index) {
+    JfrMonitorContentionEntry* const slot = &_global[index % global_size];
+    if (slot->is_empty()) {
+      if (_global_count == global_limit) {
+        _global_dropped += entry._count;
+        return;
+      }
+      *slot = entry;
+      ++_global_count;
+      return;
+    }
+    if (slot->same_key(entry)) {
+      slot->merge(entry);
+      return;
+    }
+  }
+}
+
+// requires _global_lock
+static void merge_thread(JfrMonitorContentionTable* table) {
+  JfrSpinlockHelper lock(&table->_lock);
+  for (int i = 0; i < JfrMonitorContentionTable::size; ++i) {
+    if (!table->_entries[i].is_empty()) {
+      merge_global(table->_entries[i]);
+      table->_entries[i].clear();
+    }
+  }
+}
+
+void JfrMonitorContention::top_frame(Thread* t, const Method** method, int* bci) {
+  assert(t == Thread::current(), "invariant");
+  *method = NULL;
+  *bci = 0;
+  if (!t->is_Java_thread() || !((JavaThread*)t)->has_last_Java_frame()) {
+    return;
+  }
+  ResourceMark rm(t);
+  vframeStream vfst((JavaThread*)t);
+  if (!vfst.at_end()) {
+    *method = vfst.method();
+    *bci = vfst.bci();
+  }
+}
+
+void JfrMonitorContention::record(Thread* t, const Klass* monitor_class,
+                                  const Method* owner_method, int owner_bci,
+                                  jlong blocked_nanos) {
+  assert(FlightRecorderMonitorContention, "invariant");
+  assert(monitor_class != NULL, "invariant");
+  JfrMonitorContentionEntry entry;
+  entry._klass = monitor_class;
+  top_frame(t, &entry._method, &entry._bci);
+  entry._owner_method = owner_method;
+  entry._owner_bci = owner_bci;
+  entry._count = 1;
+  entry._total_nanos = MAX2<jlong>(blocked_nanos, 0);
+  entry._max_nanos = entry._total_nanos;
+
+  JfrThreadLocal* const tl = t->jfr_thread_local();
+  JfrMonitorContentionTable* table = tl->monitor_contention();
+  if (table == NULL) {
+    table = new JfrMonitorContentionTable();
+    tl->set_monitor_contention(table);
+  }
+  JfrMonitorContentionEntry evicted;
+  evicted.clear();
+  {
+    JfrSpinlockHelper lock(&table->_lock);
+    JfrMonitorContentionEntry* const slot = &table->_entries[entry.hash() % JfrMonitorContentionTable::size];
+    if (slot->is_empty()) {
+      *slot = entry;
+    } else if (slot->same_key(entry)) {
+      slot->merge(entry);
+    } else {
+      evicted = *slot;
+      *slot = entry;
+    }
+  }
+  if (!evicted.is_empty()) {
+    // the global lock is never taken while holding a thread table lock
+    JfrSpinlockHelper lock(&_global_lock);
+    merge_global(evicted);
+  }
+}
+
+void JfrMonitorContention::release(JfrThreadLocal* tl) {
+  JfrMonitorContentionTable* const table = tl->monitor_contention();
+  if (table == NULL) {
+    return;
+  }
+  {
+    JfrSpinlockHelper lock(&_global_lock);
+    merge_thread(table);
+    tl->set_monitor_contention(NULL);
+  }
+  delete table;
+}
+
+void JfrMonitorContention::send_events() {
+  if (!FlightRecorderMonitorContention) {
+    return;
+  }
+  ResourceMark rm;
+  GrowableArray<JfrMonitorContentionEntry>* const entries = new GrowableArray<JfrMonitorContentionEntry>(64);
+  u8 dropped = 0;
+  {
+    MutexLockerEx ml(Threads_lock);
+    JfrSpinlockHelper lock(&_global_lock);
+    for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+      JfrMonitorContentionTable* const table = jt->jfr_thread_local()->monitor_contention();
+      if (table != NULL) {
+        merge_thread(table);
+      }
+    }
+    if (_global != NULL) {
+      for (int i = 0; i < global_size; ++i) {
+        if (!_global[i].is_empty()) {
+          entries->append(_global[i]);
+          _global[i].clear();
+        }
+      }
+    }
+    _global_count = 0;
+    dropped = _global_dropped;
+    _global_dropped = 0;
+  }
+  if (dropped > 0 && LogJFR) {
+    tty->print_cr("Monitor contention table full, " UINT64_FORMAT " contended enters not attributed", dropped);
+  }
+  // no safepoint, hence no class unloading, until the entries are written
+  for (int i = 0; i < entries->length(); ++i) {
+    const JfrMonitorContentionEntry& entry = entries->at(i);
+    EventJavaMonitorContention event;
+    event.set_monitorClass(entry._klass);
+    event.set_method(entry._method);
+    event.set_lineNumber(entry._method != NULL ? entry._method->line_number_from_bci(entry._bci) : -1);
+    event.set_ownerMethod(entry._owner_method);
+    event.set_ownerLineNumber(entry._owner_method != NULL ? entry._owner_method->line_number_from_bci(entry._owner_bci) : -1);
+    event.set_count(entry._count);
+    event.set_totalTime(entry._total_nanos);
+    event.set_maxTime(entry._max_nanos);
+    event.commit();
+  }
+}
+
+class PurgeUnloadingOwnerSites : public MonitorClosure {
+ public:
+  void do_monitor(ObjectMonitor* monitor) {
+    const Method* const method = monitor->previous_owner_method();
+    if (method != NULL && method->method_holder()->class_loader_data()->is_unloading()) {
+      monitor->set_previous_owner_site(NULL, 0);
+    }
+  }
+};
+
+static void purge_unloading(JfrMonitorContentionEntry* entries, int size) {
+  for (int i = 0; i < size; ++i) {
+    if (!entries[i].is_empty() && entries[i].is_unloading()) {
+      entries[i].clear();
+    }
+  }
+}
+
+void JfrMonitorContention::on_unloading_classes() {
+  assert(SafepointSynchronize::is_at_safepoint(), "invariant");
+  if (!FlightRecorderMonitorContention) {
+    return;
+  }
+  for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+    JfrMonitorContentionTable* const table = jt->jfr_thread_local()->monitor_contention();
+    if (table != NULL) {
+      purge_unloading(table->_entries, JfrMonitorContentionTable::size);
+    }
+  }
+  if (_global != NULL) {
+    // open addressing cannot leave holes in a probe sequence, so rehash
+    ResourceMark rm;
+    GrowableArray<JfrMonitorContentionEntry>* const live = new GrowableArray<JfrMonitorContentionEntry>(MAX2(_global_count, 1));
+    for (int i = 0; i < global_size; ++i) {
+      if (!_global[i].is_empty() && !_global[i].is_unloading()) {
+        live->append(_global[i]);
+      }
+      _global[i].clear();
+    }
+    _global_count = 0;
+    for (int i = 0; i < live->length(); ++i) {
+      merge_global(live->at(i));
+    }
+  }
+  PurgeUnloadingOwnerSites purge;
+  ObjectSynchronizer::monitors_iterate(&purge);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_SUPPORT_JFRMONITORCONTENTION_HPP
+#define SHARE_VM_JFR_SUPPORT_JFRMONITORCONTENTION_HPP
+
+#include "memory/allocation.hpp"
+
+class JfrMonitorContentionTable;
+class JfrThreadLocal;
+class Klass;
+class Method;
+class Thread;
+
+//
+// Aggregated ObjectMonitor contention, keyed by monitor class, the frame
+// the thread blocked in and the frame the previous owner released the
+// monitor in. Threads accumulate into a small table of their own; the
+// tables are merged and emitted as JavaMonitorContention events by the
+// periodic task (-XX:+FlightRecorderMonitorContention).
+//
+class JfrMonitorContention : AllStatic {
+ public:
+  // top Java frame of the current thread, method is NULL if there is none
+  static void top_frame(Thread* t, const Method** method, int* bci);
+  // called by the new owner once a contended enter completed
+  static void record(Thread* t, const Klass* monitor_class,
+                     const Method* owner_method, int owner_bci,
+                     jlong blocked_nanos);
+  static void send_events();
+  // flushes and frees the table of an exiting thread
+  static void release(JfrThreadLocal* tl);
+  // at a safepoint, drops entries referring to unloading classes
+  static void on_unloading_classes();
+};
+
+#endif // SHARE_VM_JFR_SUPPORT_JFRMONITORCONTENTION_HPP
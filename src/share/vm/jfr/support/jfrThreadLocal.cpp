@@ -31,7 +31,9 @@
 #include "jfr/recorder/checkpoint/jfrCheckpointManager.hpp"
 #include "jfr/recorder/checkpoint/types/traceid/jfrTraceId.inline.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTrace.hpp"
 #include "jfr/recorder/storage/jfrStorage.hpp"
+#include "jfr/support/jfrMonitorContention.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/os.hpp"
@@ -45,6 +47,8 @@ JfrThreadLocal::JfrThreadLocal() :
   _native_buffer(NULL),
   _shelved_buffer(NULL),
   _stackframes(NULL),
+  _stack_trace_cache(NULL),
+  _monitor_contention(NULL),
   _trace_id(JfrTraceId::assign_thread_id()),
   _thread(),
   _data_lost(0),
@@ -52,6 +56,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _user_time(0),
   _cpu_time(0),
   _wallclock_time(os::javaTimeNanos()),
+  _tenant_cpu_time(0),
   _stack_trace_hash(0),
   _stackdepth(0),
   _entering_suspend_flag(0),
@@ -60,6 +65,8 @@ JfrThreadLocal::JfrThreadLocal() :
   _cached_top_frame_bci(max_jint),
   _alloc_count(0),
   _alloc_count_until_sample(1),
+  _alloc_bytes_at_last_sample(0),
+  _alloc_bytes_until_sample(0),
   _cached_event_id(MaxJfrEventId) {
 
   Thread* thread = ThreadLocalStorage::thread();
@@ -138,6 +145,13 @@ void JfrThreadLocal::release(Thread* t) {
     FREE_C_HEAP_ARRAY(JfrStackFrame, _stackframes, mtTracing);
     _stackframes = NULL;
   }
+  if (_stack_trace_cache != NULL) {
+    delete _stack_trace_cache;
+    _stack_trace_cache = NULL;
+  }
+  if (_monitor_contention != NULL) {
+    JfrMonitorContention::release(this);
+  }
 }
 
 void JfrThreadLocal::release(JfrThreadLocal* tl, Thread* t) {
@@ -191,6 +205,12 @@ JfrStackFrame* JfrThreadLocal::install_stackframes() const {
   return _stackframes;
 }
 
+JfrStackTraceCache* JfrThreadLocal::install_stack_trace_cache() const {
+  assert(_stack_trace_cache == NULL, "invariant");
+  _stack_trace_cache = new JfrStackTraceCache();
+  return _stack_trace_cache;
+}
+
 ByteSize JfrThreadLocal::trace_id_offset() {
   return in_ByteSize(offset_of(JfrThreadLocal, _trace_id));
 }
@@ -30,7 +30,9 @@
 
 class JavaThread;
 class JfrBuffer;
+class JfrMonitorContentionTable;
 class JfrStackFrame;
+class JfrStackTraceCache;
 class Thread;
 
 class JfrThreadLocal {
@@ -40,6 +42,8 @@ class JfrThreadLocal {
   mutable JfrBuffer* _native_buffer;
   JfrBuffer* _shelved_buffer;
   mutable JfrStackFrame* _stackframes;
+  mutable JfrStackTraceCache* _stack_trace_cache;
+  JfrMonitorContentionTable* _monitor_contention;
   mutable traceid _trace_id;
   JfrBlobHandle _thread;
   u8 _data_lost;
@@ -47,6 +51,7 @@ class JfrThreadLocal {
   jlong _user_time;
   jlong _cpu_time;
   jlong _wallclock_time;
+  jlong _tenant_cpu_time;
   unsigned int _stack_trace_hash;
   mutable u4 _stackdepth;
   volatile jint _entering_suspend_flag;
@@ -67,6 +72,12 @@ class JfrThreadLocal {
   jint _cached_top_frame_bci;
   jlong _alloc_count;
   jlong _alloc_count_until_sample;
+  // With -XX:ObjectProfilerSampleBytes, allocations are sampled by the
+  // thread's allocated bytes instead: the allocated bytes at the last
+  // sample and the allocated bytes at which the next sample is due
+  // (0 until the first sample point is set).
+  jlong _alloc_bytes_at_last_sample;
+  jlong _alloc_bytes_until_sample;
   // This field is used to help to distinguish the object allocation request source.
   // For example, for object allocation slow path, we trace it in CollectedHeap::obj_allocate.
   // But in CollectedHeap::obj_allocate, it is impossible to determine where the allocation request
@@ -78,6 +89,7 @@ class JfrThreadLocal {
   JfrBuffer* install_native_buffer() const;
   JfrBuffer* install_java_buffer() const;
   JfrStackFrame* install_stackframes() const;
+  JfrStackTraceCache* install_stack_trace_cache() const;
   void release(Thread* t);
   static void release(JfrThreadLocal* tl, Thread* t);
 
@@ -136,6 +148,18 @@ class JfrThreadLocal {
     _stackframes = frames;
   }
 
+  JfrStackTraceCache* stack_trace_cache() const {
+    return _stack_trace_cache != NULL ? _stack_trace_cache : install_stack_trace_cache();
+  }
+
+  JfrMonitorContentionTable* monitor_contention() const {
+    return _monitor_contention;
+  }
+
+  void set_monitor_contention(JfrMonitorContentionTable* table) {
+    _monitor_contention = table;
+  }
+
   u4 stackdepth() const;
 
   void set_stackdepth(u4 depth) {
@@ -218,6 +242,14 @@ class JfrThreadLocal {
     _wallclock_time = wallclock_time;
   }
 
+  jlong get_tenant_cpu_time() const {
+    return _tenant_cpu_time;
+  }
+
+  void set_tenant_cpu_time(jlong cpu_time) {
+    _tenant_cpu_time = cpu_time;
+  }
+
   traceid trace_id() const {
     return _trace_id;
   }
@@ -270,6 +302,19 @@ class JfrThreadLocal {
     _alloc_count_until_sample += delta;
   }
 
+  jlong alloc_bytes_at_last_sample() const {
+    return _alloc_bytes_at_last_sample;
+  }
+
+  jlong alloc_bytes_until_sample() const {
+    return _alloc_bytes_until_sample;
+  }
+
+  void set_next_alloc_bytes_sample(jlong allocated_bytes, jlong interval) {
+    _alloc_bytes_at_last_sample = allocated_bytes;
+    _alloc_bytes_until_sample = allocated_bytes + interval;
+  }
+
   void set_cached_event_id(JfrEventId event_id) {
     _cached_event_id = event_id;
   }
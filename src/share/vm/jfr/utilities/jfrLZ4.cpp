@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "precompiled.hpp"
+#include "jfr/utilities/jfrLZ4.hpp"
+
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;   // the block always ends with literals
+static const size_t MF_LIMIT = 12;       // no match starts this close to the end
+static const size_t MAX_DISTANCE = 65535;
+
+static inline u4 read_u4(const u1* p) {
+  u4 value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline u4 hash(u4 sequence) {
+  return (sequence * 2654435761U) >> (32 - JfrLZ4::hash_log);
+}
+
+static inline u1* write_length(u1* op, size_t len) {
+  while (len >= 255) {
+    *op++ = 255;
+    len -= 255;
+  }
+  *op++ = (u1)len;
+  return op;
+}
+
+static u1* write_sequence(u1* op, const u1* literals, size_t literal_len, size_t offset, size_t match_len) {
+  u1* const token = op++;
+  *token = (u1)((literal_len >= 15 ? 15 : literal_len) << 4);
+  if (literal_len >= 15) {
+    op = write_length(op, literal_len - 15);
+  }
+  memcpy(op, literals, literal_len);
+  op += literal_len;
+  if (offset == 0) {
+    // last sequence, literals only
+    return op;
+  }
+  *op++ = (u1)(offset & 0xff);
+  *op++ = (u1)(offset >> 8);
+  const size_t len = match_len - MIN_MATCH;
+  *token |= (u1)(len >= 15 ? 15 : len);
+  if (len >= 15) {
+    op = write_length(op, len - 15);
+  }
+  return op;
+}
+
+size_t JfrLZ4::compress(const u1* src, size_t len, u1* dst, u4* table) {
+  assert(src != NULL && dst != NULL && table != NULL, "invariant");
+  assert(len <= max_juint, "invariant");
+  const u1* const end = src + len;
+  const u1* anchor = src;
+  u1* op = dst;
+  if (len > MF_LIMIT) {
+    memset(table, 0, table_size * sizeof(u4));
+    const u1* const mf_limit = end - MF_LIMIT;
+    const u1* const match_limit = end - LAST_LITERALS;
+    const u1* ip = src + 1;
+    while (ip < mf_limit) {
+      const u4 sequence = read_u4(ip);
+      const u4 h = hash(sequence);
+      const u1* ref = src + table[h];
+      table[h] = (u4)(ip - src);
+      if ((size_t)(ip - ref) > MAX_DISTANCE || read_u4(ref) != sequence) {
+        ++ip;
+        continue;
+      }
+      const u1* mp = ip + MIN_MATCH;
+      const u1* rp = ref + MIN_MATCH;
+      while (mp < match_limit && *mp == *rp) {
+        ++mp;
+        ++rp;
+      }
+      op = write_sequence(op, anchor, ip - anchor, ip - ref, mp - ip);
+      ip = mp;
+      anchor = ip;
+    }
+  }
+  op = write_sequence(op, anchor, end - anchor, 0, 0);
+  assert((size_t)(op - dst) <= bound(len), "invariant");
+  return op - dst;
+}
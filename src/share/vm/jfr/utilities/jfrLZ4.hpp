@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef SHARE_VM_JFR_UTILITIES_JFRLZ4_HPP
+#define SHARE_VM_JFR_UTILITIES_JFRLZ4_HPP
+
+#include "memory/allocation.hpp"
+
+//
+// Greedy encoder for the LZ4 block format, so compressed chunk blocks can
+// be inflated with any stock LZ4 decoder (LZ4_decompress_safe).
+//
+class JfrLZ4 : AllStatic {
+ public:
+  static const int hash_log = 12;
+  static const size_t table_size = (size_t)1 << hash_log; // in u4 entries
+
+  // worst case output size for len input bytes
+  static size_t bound(size_t len) {
+    return len + len / 255 + 16;
+  }
+  // table is scratch space of table_size entries; returns the number of
+  // bytes written to dst, which must hold bound(len) bytes
+  static size_t compress(const u1* src, size_t len, u1* dst, u4* table);
+};
+
+#endif // SHARE_VM_JFR_UTILITIES_JFRLZ4_HPP
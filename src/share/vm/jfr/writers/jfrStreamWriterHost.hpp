@@ -28,6 +28,8 @@
 #include "jfr/utilities/jfrTypes.hpp"
 #include "jfr/writers/jfrMemoryWriterHost.inline.hpp"
 
+class JfrStreamRing;
+
 template <typename Adapter, typename AP> // Adapter and AllocationPolicy
 class StreamWriterHost : public MemoryWriterHost<Adapter, AP> {
  public:
@@ -35,7 +37,9 @@ class StreamWriterHost : public MemoryWriterHost<Adapter, AP> {
  private:
   int64_t _stream_pos;
   fio_fd _fd;
+  JfrStreamRing* _ring;
   int64_t current_stream_position() const;
+  void write_to_fd(const void* buf, size_t len);
 
  protected:
   StreamWriterHost(StorageType* storage, Thread* thread);
@@ -54,6 +58,8 @@ class StreamWriterHost : public MemoryWriterHost<Adapter, AP> {
   bool is_valid() const;
   void close_fd();
   void reset(fio_fd fd);
+  // mirror everything written to the fd into ring, NULL to stop
+  void set_ring(JfrStreamRing* ring) { _ring = ring; }
 };
 
 #endif // SHARE_VM_JFR_WRITERS_JFRSTREAMWRITERHOST_HPP
@@ -25,22 +25,23 @@
 #ifndef SHARE_VM_JFR_WRITERS_JFRSTREAMWRITERHOST_INLINE_HPP
 #define SHARE_VM_JFR_WRITERS_JFRSTREAMWRITERHOST_INLINE_HPP
 
+#include "jfr/recorder/repository/jfrStreamRing.hpp"
 #include "jfr/writers/jfrStreamWriterHost.hpp"
 #include "runtime/os.hpp"
 
 template <typename Adapter, typename AP>
 StreamWriterHost<Adapter, AP>::StreamWriterHost(typename Adapter::StorageType* storage, Thread* thread) :
-  MemoryWriterHost<Adapter, AP>(storage, thread), _stream_pos(0), _fd(invalid_fd) {
+  MemoryWriterHost<Adapter, AP>(storage, thread), _stream_pos(0), _fd(invalid_fd), _ring(NULL) {
 }
 
 template <typename Adapter, typename AP>
 StreamWriterHost<Adapter, AP>::StreamWriterHost(typename Adapter::StorageType* storage, size_t size) :
-  MemoryWriterHost<Adapter, AP>(storage, size), _stream_pos(0), _fd(invalid_fd) {
+  MemoryWriterHost<Adapter, AP>(storage, size), _stream_pos(0), _fd(invalid_fd), _ring(NULL) {
 }
 
 template <typename Adapter, typename AP>
 StreamWriterHost<Adapter, AP>::StreamWriterHost(Thread* thread) :
-  MemoryWriterHost<Adapter, AP>(thread), _stream_pos(0), _fd(invalid_fd) {
+  MemoryWriterHost<Adapter, AP>(thread), _stream_pos(0), _fd(invalid_fd), _ring(NULL) {
 }
 
 template <typename Adapter, typename AP>
@@ -69,11 +70,20 @@ inline void StreamWriterHost<Adapter, AP>::bytes(void* dest, const void* buf, si
   MemoryWriterHost<Adapter, AP>::bytes(dest, buf, len);
 }
 
+template <typename Adapter, typename AP>
+inline void StreamWriterHost<Adapter, AP>::write_to_fd(const void* buf, size_t len) {
+  const size_t written = os::write(_fd, buf, (unsigned int)len);
+  if (_ring != NULL && written <= len) {
+    _ring->write(_stream_pos, buf, written);
+  }
+  _stream_pos += written;
+}
+
 template <typename Adapter, typename AP>
 inline void StreamWriterHost<Adapter, AP>::flush(size_t size) {
   assert(size > 0, "invariant");
   assert(this->is_valid(), "invariant");
-  _stream_pos += os::write(_fd, this->start_pos(), (unsigned int)size);
+  write_to_fd(this->start_pos(), size);
   StorageHost<Adapter, AP>::reset();
   assert(0 == this->used_offset(), "invariant");
 }
@@ -111,7 +121,8 @@ void StreamWriterHost<Adapter, AP>::write_unbuffered(const void* buf, size_t len
   assert(0 == this->used_offset(), "can only seek from beginning");
   while (len > 0) {
     const unsigned int n = MIN2((unsigned int)len, (unsigned int)INT_MAX);
-    _stream_pos += os::write(_fd, buf, n);
+    write_to_fd(buf, n);
+    buf = (const u1*)buf + n;
     len -= n;
   }
 }
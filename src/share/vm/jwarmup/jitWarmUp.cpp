@@ -26,14 +26,20 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "compiler/compileBroker.hpp"
+#include "interpreter/interpreterRuntime.hpp"
+#include "interpreter/invocationCounter.hpp"
 #include "jwarmup/jitWarmUp.hpp"
 #include "jwarmup/jitWarmUpThread.hpp"
+#include "memory/sharedHeap.hpp"
+#include "oops/cpCache.hpp"
 #include "oops/method.hpp"
 #include "oops/typeArrayKlass.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/fieldType.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
@@ -41,10 +47,11 @@
 #include "utilities/hashtable.inline.hpp"
 #include "utilities/stack.hpp"
 #include "utilities/stack.inline.hpp"
+#include "utilities/workgroup.hpp"
 #include "runtime/atomic.hpp"
 #include "jwarmup/jitWarmUpLog.hpp"  // must be last one to use customized jwarmup log
 
-#define JITWARMUP_VERSION  0x2
+#define JITWARMUP_VERSION  0x6
 
 JitWarmUp*                JitWarmUp::_instance         = NULL;
 
@@ -132,9 +139,7 @@ JitWarmUp::JitWarmUpState JitWarmUp::flush_logfile() {
   return _state;
 }
 
-bool JitWarmUp::commit_compilation(methodHandle m, int bci, TRAPS) {
-  // use C2 compiler
-  int comp_level = CompLevel_full_optimization;
+bool JitWarmUp::commit_compilation(methodHandle m, int bci, int comp_level, TRAPS) {
   if (CompilationPolicy::can_be_compiled(m, comp_level)) {
     // Force compilation
     CompileBroker::compile_method(m, bci, comp_level,
@@ -167,7 +172,9 @@ ProfileRecorder::ProfileRecorder()
     _class_init_order_count(-1),
     _flushed(false),
     _logfile_name(NULL),
-    _max_symbol_length(0) {
+    _max_symbol_length(0),
+    _symbols(NULL),
+    _symbol_index(NULL) {
 }
 
 ProfileRecorder::~ProfileRecorder() {
@@ -241,10 +248,10 @@ int ProfileRecorder::assign_class_init_order(InstanceKlass* klass) {
   MutexLockerEx mu(ProfileRecorder_lock);
   if (_init_list_tail_node == NULL) {
     // add head node
-    _class_init_list->add(ClassSymbolEntry(name, loader_name, path));
+    _class_init_list->add(ClassSymbolEntry(name, loader_name, path, klass));
     _init_list_tail_node = _class_init_list->head();
   } else {
-    _class_init_list->insert_after(ClassSymbolEntry(name, loader_name, path),
+    _class_init_list->insert_after(ClassSymbolEntry(name, loader_name, path, klass),
                                    _init_list_tail_node);
     _init_list_tail_node = _init_list_tail_node->next();
   }
@@ -255,7 +262,7 @@ int ProfileRecorder::assign_class_init_order(InstanceKlass* klass) {
   return _class_init_order_count;
 }
 
-void ProfileRecorder::add_method(Method* m, int bci) {
+void ProfileRecorder::add_method(Method* m, int bci, int comp_level) {
   MutexLockerEx mu(ProfileRecorder_lock, Mutex::_no_safepoint_check_flag);
   // if is flushed, stop adding method
   if (flushed()) {
@@ -267,7 +274,7 @@ void ProfileRecorder::add_method(Method* m, int bci) {
   }
   assert(is_valid(), "JitWarmUp state must be OK");
   unsigned int hash = compute_hash(m);
-  dict()->add_method(hash, m, bci);
+  dict()->add_method(hash, m, bci, comp_level);
 }
 
 // NYI
@@ -297,18 +304,22 @@ ProfileRecorderEntry* ProfileRecordDictionary::new_entry(unsigned int hash, Meth
   return entry;
 }
 
-ProfileRecorderEntry* ProfileRecordDictionary::add_method(unsigned int hash, Method* method, int bci) {
+ProfileRecorderEntry* ProfileRecordDictionary::add_method(unsigned int hash, Method* method, int bci, int comp_level) {
   // this method should be called after a compilation task done
   assert_lock_strong(ProfileRecorder_lock);
   int index = hash_to_index(hash);
   ProfileRecorderEntry* entry = find_entry(hash, method);
   if (entry != NULL) {
+    if (comp_level > entry->comp_level()) {
+      entry->set_comp_level(comp_level);
+    }
     return entry;
   }
   // not existed
   entry = new_entry(hash, method);
   entry->set_bci(bci);
   entry->set_order(count());
+  entry->set_comp_level(comp_level);
   add_entry(index, entry);
   _count++;
   return entry;
@@ -357,6 +368,14 @@ void ProfileRecordDictionary::free_entry(ProfileRecorderEntry* entry) {
 #define FILE_DEFAULT_NUMBER             0
 #define CRC32_DEFAULT_NUMBER            0
 
+// Log file layout: header, class init section, method index section,
+// method records, symbol section, and the u4 offset of the symbol section.
+// Strings are stored once in the symbol section and referred to by index.
+#define SYMBOL_SECTION_OFFSET_WIDTH     4
+#define NULL_LOADER_SYMBOL_INDEX        0
+#define DEFINE_CLASS_PATH_SYMBOL_INDEX  1
+#define FIRST_RECORDED_SYMBOL_INDEX     2
+
 
 static char record_buf[12];
 void ProfileRecorder::write_u1(u1 value) {
@@ -425,7 +444,7 @@ int ProfileRecorder::compute_crc32(randomAccessFileStream* fs) {
 
 // buffer used in write_header()
 static char header_buf[HEADER_SIZE];
-void ProfileRecorder::write_header() {
+void ProfileRecorder::write_header(unsigned int record_count) {
   assert(_logfile->is_open(), "");
   // header info
   size_t offset = 0;
@@ -457,7 +476,7 @@ void ProfileRecorder::write_header() {
   offset += MAX_SYMBOL_LENGTH_WIDTH;
 
   // record counts
-  *(unsigned int*)((char*)header_buf + offset) = recorded_count();
+  *(unsigned int*)((char*)header_buf + offset) = record_count;
   _pos += RECORD_COUNTS_WIDTH;
   offset += RECORD_COUNTS_WIDTH;
   // record time
@@ -468,10 +487,23 @@ void ProfileRecorder::write_header() {
   _logfile->write(header_buf, offset);
 }
 
+u4 ProfileRecorder::symbol_index(Symbol* s, u4 null_index) {
+  if (s == NULL) {
+    return null_index;
+  }
+  u4* index = _symbol_index->get(s);
+  if (index != NULL) {
+    return *index;
+  }
+  u4 new_index = (u4)(FIRST_RECORDED_SYMBOL_INDEX + _symbols->length());
+  _symbols->append(s);
+  _symbol_index->put(s, new_index);
+  return new_index;
+}
+
 // write class initialize order section
 void ProfileRecorder::write_inited_class() {
   assert(_logfile->is_open(), "log file must be opened");
-  ResourceMark rm;
   unsigned int begin_pos = _pos;
   unsigned int size_anchor = begin_pos;
   // size place holder
@@ -482,22 +514,10 @@ void ProfileRecorder::write_inited_class() {
   const LinkedListNode<ClassSymbolEntry>* node = class_init_list()->head();
   while (node != NULL) {
     const ClassSymbolEntry* entry = node->peek();
-    char* class_name = entry->class_name()->as_C_string();
-    const char* class_loader_name = NULL;
-    if (entry->class_loader_name() == NULL) {
-      class_loader_name = "NULL";
-    } else {
-      class_loader_name = entry->class_loader_name()->as_C_string();
-    }
-    const char* path = NULL;
-    if (entry->path() == NULL) {
-      path = JVM_DEFINE_CLASS_PATH;
-    } else {
-      path = entry->path()->as_C_string();
-    }
-    write_string(class_name, strlen(class_name));
-    write_string(class_loader_name, strlen(class_loader_name));
-    write_string(path, strlen(path));
+    write_u4(symbol_index(entry->class_name(), NULL_LOADER_SYMBOL_INDEX));
+    write_u4(symbol_index(entry->class_loader_name(), NULL_LOADER_SYMBOL_INDEX));
+    write_u4(symbol_index(entry->path(), DEFINE_CLASS_PATH_SYMBOL_INDEX));
+    write_resolved_entries(entry->klass());
     node = node->next();
     cnt++;
   }
@@ -507,11 +527,53 @@ void ProfileRecorder::write_inited_class() {
   overwrite_u4(section_size, size_anchor);
 }
 
+// write the cpCache entries of klass resolved so far, appended to its class init entry:
+//   u4 class size, u4 class crc32, u4 count, u4 (bytecode << 16 | cache index) per entry
+void ProfileRecorder::write_resolved_entries(InstanceKlass* klass) {
+  ConstantPoolCache* cache = klass != NULL ? klass->constants()->cache() : NULL;
+  if (cache == NULL) {
+    write_u4((u4)0);
+    write_u4((u4)0);
+    write_u4((u4)0);
+    return;
+  }
+  write_u4((u4)klass->bytes_size());
+  write_u4((u4)klass->crc32());
+  unsigned int count_anchor = _pos;
+  write_u4((u4)0);
+  u4 count = 0;
+  for (int i = 0; i < cache->length(); i++) {
+    ConstantPoolCacheEntry* e = cache->entry_at(i);
+    Bytecodes::Code codes[2] = { e->bytecode_1(), e->bytecode_2() };
+    for (int j = 0; j < 2; j++) {
+      if (codes[j] != 0) {
+        write_u4(((u4)codes[j] << 16) | (u4)i);
+        count++;
+      }
+    }
+  }
+  overwrite_u4(count, count_anchor);
+}
+
+// write method index section, offsets are filled in after the records
+void ProfileRecorder::write_method_index(u4* offsets, int count, unsigned int index_pos) {
+  if (offsets == NULL) {
+    // place holder
+    unsigned int begin_pos = _pos;
+    write_u4((u4)(2 * sizeof(u4) + count * sizeof(u4)));
+    write_u4((u4)count);
+    for (int i = 0; i < count; i++) {
+      write_u4(0);
+    }
+    assert(_pos - begin_pos == 2 * sizeof(u4) + count * sizeof(u4), "sanity");
+  } else {
+    _logfile->write((const char*)offsets, count * sizeof(u4), index_pos + 2 * sizeof(u4));
+  }
+}
+
 // write profile information
-void ProfileRecorder::write_record(Method* method, int bci, int order) {
-  ResourceMark rm;
+void ProfileRecorder::write_record(Method* method, int bci, int order, int comp_level) {
   unsigned int begin_pos = _pos;
-  unsigned int total_size = 0;
   ConstMethod* cm = method->constMethod();
   MethodCounters* mc = method->method_counters();
   InstanceKlass* klass = cm->constants()->pool_holder();
@@ -524,12 +586,11 @@ void ProfileRecorder::write_record(Method* method, int bci, int order) {
   // write compilation type
   u1 compilation_type = bci == -1 ? 0 : 1;
   write_u1(compilation_type);
+  write_u1((u1)comp_level);
 
   // write method info
-  char* method_name = method->name()->as_C_string();
-  write_string(method_name, strlen(method_name));
-  char* method_sig = method->signature()->as_C_string();
-  write_string(method_sig, strlen(method_sig));
+  write_u4(symbol_index(method->name(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(method->signature(), NULL_LOADER_SYMBOL_INDEX));
   // first invoke init order
   write_u4((u4)method->first_invoke_init_order());
   // bytecode size
@@ -539,24 +600,11 @@ void ProfileRecorder::write_record(Method* method, int bci, int order) {
   write_u4((u4)bci);
 
   // write class info
-  char* class_name = klass->name()->as_C_string();
-  Symbol* path_sym = klass->source_file_path();
-  const char* path = NULL;
-  if (path_sym != NULL) {
-    path = path_sym->as_C_string();
-  } else {
-    path = JVM_DEFINE_CLASS_PATH;
-  }
   oop class_loader = klass->class_loader();
-  const char* loader_name = NULL;
-  if (class_loader != NULL) {
-    loader_name = class_loader->klass()->name()->as_C_string();
-  } else {
-    loader_name = "NULL";
-  }
-  write_string(class_name, strlen(class_name));
-  write_string(loader_name, strlen(loader_name));
-  write_string(path, strlen(path));
+  Symbol* loader_name = class_loader != NULL ? class_loader->klass()->name() : NULL;
+  write_u4(symbol_index(klass->name(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(loader_name, NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(klass->source_file_path(), DEFINE_CLASS_PATH_SYMBOL_INDEX));
   write_u4((u4)klass->bytes_size());
   write_u4((u4)klass->crc32());
   write_u4((u4)0x00); // class hash field is reserved, not used yet
@@ -568,20 +616,136 @@ void ProfileRecorder::write_record(Method* method, int bci, int order) {
     write_u4((u4)mc->invocation_counter()->raw_counter());
     write_u4((u4)mc->backedge_counter()->raw_counter());
   } else {
+    ResourceMark rm;
     log_warning(warmup)("[JitWarmUp] WARNING : method counter is NULL for method %s::%s %s",
-                        class_name, method_name, method_sig);
+                        klass->name()->as_C_string(), method->name()->as_C_string(),
+                        method->signature()->as_C_string());
     write_u4((u4)0);
     write_u4((u4)0);
     write_u4((u4)0);
     write_u4((u4)0);
   }
+  // number of instances, more than one in merged logs
+  write_u4((u4)1);
+
+  write_method_data(method);
 
   unsigned int end_pos = _pos;
   unsigned int section_size = end_pos - begin_pos;
   overwrite_u4(section_size, size_anchor);
 }
 
+// write the profile data of method, appended to the method record:
+//   u4 count, then per ProfileData
+//   u4 bci, u1 tag, u1 flags, u4 count, u4 not_taken,
+//   u1 receiver rows, (u4 receiver name, u4 receiver count) per row
+void ProfileRecorder::write_method_data(Method* method) {
+  MethodData* mdo = method->method_data();
+  unsigned int count_anchor = _pos;
+  write_u4((u4)0);
+  if (!CompilationWarmUpRecordMethodData || mdo == NULL) {
+    return;
+  }
+  u4 count = 0;
+  for (ProfileData* data = mdo->first_data(); mdo->is_valid(data); data = mdo->next_data(data)) {
+    if (!data->is_BitData() && !data->is_CounterData() && !data->is_JumpData()) {
+      continue;
+    }
+    write_u4((u4)data->bci());
+    write_u1(data->data()->tag());
+    write_u1(data->data()->flags());
+    u4 taken = 0;
+    u4 not_taken = 0;
+    if (data->is_CounterData()) {
+      taken = (u4)data->as_CounterData()->count();
+    } else if (data->is_JumpData()) {
+      taken = (u4)data->as_JumpData()->taken();
+      if (data->is_BranchData()) {
+        not_taken = (u4)data->as_BranchData()->not_taken();
+      }
+    }
+    write_u4(taken);
+    write_u4(not_taken);
+    Klass* receivers[MDRecordInfo::MaxReceiverRows];
+    u4 receiver_counts[MDRecordInfo::MaxReceiverRows];
+    u1 rows = 0;
+    if (data->is_ReceiverTypeData()) {
+      ReceiverTypeData* rtd = data->as_ReceiverTypeData();
+      uint limit = MIN2(ReceiverTypeData::row_limit(), (uint)MDRecordInfo::MaxReceiverRows);
+      for (uint row = 0; row < limit; row++) {
+        Klass* receiver = rtd->receiver(row);
+        if (receiver != NULL) {
+          receivers[rows] = receiver;
+          receiver_counts[rows] = (u4)rtd->receiver_count(row);
+          rows++;
+        }
+      }
+    }
+    write_u1(rows);
+    for (u1 row = 0; row < rows; row++) {
+      write_u4(symbol_index(receivers[row]->name(), NULL_LOADER_SYMBOL_INDEX));
+      write_u4(receiver_counts[row]);
+    }
+    count++;
+  }
+  overwrite_u4(count, count_anchor);
+}
+
+// write symbol section
 void ProfileRecorder::write_footer() {
+  unsigned int begin_pos = _pos;
+  unsigned int size_anchor = begin_pos;
+  // size place holder
+  write_u4((u4)MAGIC_NUMBER);
+  write_u4((u4)(FIRST_RECORDED_SYMBOL_INDEX + _symbols->length()));
+  write_string("NULL");
+  write_string(JVM_DEFINE_CLASS_PATH);
+  for (int i = 0; i < _symbols->length(); i++) {
+    ResourceMark rm;
+    Symbol* s = _symbols->at(i);
+    write_string(s->as_C_string(), s->utf8_length());
+  }
+  unsigned int section_size = _pos - begin_pos;
+  overwrite_u4(section_size, size_anchor);
+  // the symbol section is located through the last u4 of the file
+  write_u4((u4)begin_pos);
+}
+
+bool ProfileRecorder::open_logfile(const char* path) {
+  // open randomAccessFileStream
+  _logfile = new (ResourceObj::C_HEAP, mtInternal) randomAccessFileStream(path, "wb+");
+  if (_logfile == NULL || !_logfile->is_open()) {
+    log_error(warmup)("[JitWarmUp] ERROR : open log file error! path is %s", path);
+    return false;
+  }
+  _pos = 0;
+  _max_symbol_length = 0;
+  _symbols = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Symbol*>(1024, true, mtInternal);
+  _symbol_index = new (ResourceObj::C_HEAP, mtInternal) SymbolIndexTable();
+  return true;
+}
+
+// write the symbol section and complete the header
+void ProfileRecorder::close_logfile() {
+  // foot section
+  write_footer();
+
+  // set file size
+  overwrite_u4((u4)_pos, FILE_SIZE_OFFSET);
+  // set max symbol length
+  overwrite_u4((u4)_max_symbol_length, MAX_SYMBOL_LENGTH_OFFSET);
+  // compute and set file's crc32
+  int crc32 = ProfileRecorder::compute_crc32(_logfile);
+  overwrite_u4((u4)crc32, CRC32_OFFSET);
+
+  _logfile->flush();
+  // close fd
+  delete _logfile;
+  _logfile = NULL;
+  delete _symbol_index;
+  _symbol_index = NULL;
+  delete _symbols;
+  _symbols = NULL;
 }
 
 void ProfileRecorder::flush() {
@@ -591,45 +755,170 @@ void ProfileRecorder::flush() {
   }
   set_flushed(true);
 
-  // open randomAccessFileStream
-  _logfile = new (ResourceObj::C_HEAP, mtInternal) randomAccessFileStream(logfile_name(), "wb+");
-  if (_logfile == NULL || !_logfile->is_open()) {
-    log_error(warmup)("[JitWarmUp] ERROR : open log file error! path is %s", logfile_name());
+  if (!open_logfile(logfile_name())) {
     _state = IS_ERR;
     return;
   }
 
+  int record_count = (int)recorded_count();
   // head section
-  write_header();
+  write_header(record_count);
   // write class init section
   write_inited_class();
-  // write method profile info
+  // write method index section
+  unsigned int index_pos = _pos;
+  write_method_index(NULL, record_count, index_pos);
+  // write method profile info in compilation order, so that the log
+  // does not depend on where the methods are in memory
+  ProfileRecorderEntry** entries = NEW_C_HEAP_ARRAY(ProfileRecorderEntry*, MAX2(record_count, 1), mtInternal);
   for (int index = 0; index < dict()->table_size(); index++) {
     for (ProfileRecorderEntry* entry = dict()->bucket(index);
                                entry != NULL;
                                entry = entry->next()) {
-      write_record(entry->literal(), entry->bci(), entry->order());
+      assert(entry->order() < record_count, "orders are assigned by count");
+      entries[entry->order()] = entry;
     }
   }
-  // foot section
-  write_footer();
-
-  // set file size
-  overwrite_u4((u4)_pos, FILE_SIZE_OFFSET);
-  // set max symbol length
-  overwrite_u4((u4)_max_symbol_length, MAX_SYMBOL_LENGTH_OFFSET);
-  // compute and set file's crc32
-  int crc32 = ProfileRecorder::compute_crc32(_logfile);
-  overwrite_u4((u4)crc32, CRC32_OFFSET);
+  u4* offsets = NEW_C_HEAP_ARRAY(u4, MAX2(record_count, 1), mtInternal);
+  for (int i = 0; i < record_count; i++) {
+    ProfileRecorderEntry* entry = entries[i];
+    offsets[i] = (u4)_pos;
+    write_record(entry->literal(), entry->bci(), entry->order(), entry->comp_level());
+  }
+  write_method_index(offsets, record_count, index_pos);
+  FREE_C_HEAP_ARRAY(u4, offsets, mtInternal);
+  FREE_C_HEAP_ARRAY(ProfileRecorderEntry*, entries, mtInternal);
 
-  _logfile->flush();
-  // close fd
-  delete _logfile;
-  _logfile = NULL;
+  close_logfile();
 
   log_info(warmup)("[JitWarmUp] output profile info has done, file is %s", logfile_name());
 }
 
+// write the classes of the merged chain as class init section
+void ProfileRecorder::write_merged_classes(PreloadClassChain* chain) {
+  unsigned int begin_pos = _pos;
+  unsigned int size_anchor = begin_pos;
+  // size place holder
+  write_u4((u4)MAGIC_NUMBER);
+  write_u4((u4)chain->length());
+  for (int i = 0; i < chain->length(); i++) {
+    PreloadClassChain::PreloadClassChainEntry* entry = chain->at(i);
+    write_u4(symbol_index(entry->class_name(), NULL_LOADER_SYMBOL_INDEX));
+    write_u4(symbol_index(entry->loader_name(), NULL_LOADER_SYMBOL_INDEX));
+    write_u4(symbol_index(entry->path(), DEFINE_CLASS_PATH_SYMBOL_INDEX));
+    GrowableArray<u4>* resolved = entry->resolved_entries();
+    write_u4(entry->klass_size());
+    write_u4(entry->klass_crc32());
+    write_u4(resolved != NULL ? (u4)resolved->length() : 0);
+    for (int j = 0; resolved != NULL && j < resolved->length(); j++) {
+      write_u4(resolved->at(j));
+    }
+  }
+  unsigned int section_size = _pos - begin_pos;
+  overwrite_u4(section_size, size_anchor);
+}
+
+// write a parsed method record, see write_record and write_method_data
+void ProfileRecorder::write_merged_record(PreloadClassHolder* klass, PreloadMethodHolder* mh) {
+  unsigned int begin_pos = _pos;
+  unsigned int size_anchor = begin_pos;
+  // size place holder
+  write_u4((u4)MAGIC_NUMBER);
+  write_u4((u4)mh->order());
+
+  write_u1(mh->bci() == InvocationEntryBci ? 0 : 1);
+  write_u1((u1)mh->comp_level());
+
+  write_u4(symbol_index(mh->name(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(mh->signature(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4((u4)INVALID_FIRST_INVOKE_INIT_ORDER);
+  write_u4((u4)mh->size());
+  write_u4((u4)mh->hash());
+  write_u4((u4)mh->bci());
+
+  write_u4(symbol_index(klass->class_name(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(klass->class_loader_name(), NULL_LOADER_SYMBOL_INDEX));
+  write_u4(symbol_index(klass->path(), DEFINE_CLASS_PATH_SYMBOL_INDEX));
+  write_u4((u4)klass->size());
+  write_u4((u4)klass->crc32());
+  write_u4((u4)klass->hash());
+
+  write_u4((u4)mh->intp_invocation_count());
+  write_u4((u4)mh->intp_throwout_count());
+  write_u4((u4)mh->invocation_count());
+  write_u4((u4)mh->backage_count());
+  write_u4((u4)mh->instances());
+
+  GrowableArray<MDRecordInfo*>* md_list = mh->md_list();
+  write_u4((u4)md_list->length());
+  for (int i = 0; i < md_list->length(); i++) {
+    MDRecordInfo* info = md_list->at(i);
+    write_u4((u4)info->bci());
+    write_u1(info->tag());
+    write_u1(info->flags());
+    write_u4(info->count());
+    write_u4(info->not_taken());
+    write_u1((u1)info->receiver_rows());
+    for (int row = 0; row < info->receiver_rows(); row++) {
+      write_u4(symbol_index(info->receiver_at(row), NULL_LOADER_SYMBOL_INDEX));
+      write_u4(info->receiver_count_at(row));
+    }
+  }
+
+  unsigned int section_size = _pos - begin_pos;
+  overwrite_u4(section_size, size_anchor);
+}
+
+static int compare_chain_offset(PreloadClassEntry** a, PreloadClassEntry** b) {
+  return (*a)->chain_offset() - (*b)->chain_offset();
+}
+
+bool ProfileRecorder::write_merged(PreloadJitInfo* info, const char* path) {
+  // classes with recorded methods, in class initialization order
+  GrowableArray<PreloadClassEntry*>* classes =
+    new (ResourceObj::C_HEAP, mtInternal) GrowableArray<PreloadClassEntry*>(1024, true, mtInternal);
+  int record_count = 0;
+  PreloadClassDictionary* dict = info->dict();
+  for (int index = 0; index < dict->table_size(); index++) {
+    for (PreloadClassEntry* entry = dict->bucket(index); entry != NULL; entry = entry->next()) {
+      if (entry->head_holder() != NULL) {
+        classes->append(entry);
+        for (PreloadClassHolder* h = entry->head_holder(); h != NULL; h = h->next()) {
+          record_count += h->methods_count();
+        }
+      }
+    }
+  }
+  classes->sort(compare_chain_offset);
+
+  if (!open_logfile(path)) {
+    delete classes;
+    return false;
+  }
+  write_header(record_count);
+  write_merged_classes(info->chain());
+  unsigned int index_pos = _pos;
+  write_method_index(NULL, record_count, index_pos);
+  u4* offsets = NEW_C_HEAP_ARRAY(u4, MAX2(record_count, 1), mtInternal);
+  int recorded = 0;
+  for (int i = 0; i < classes->length(); i++) {
+    for (PreloadClassHolder* h = classes->at(i)->head_holder(); h != NULL; h = h->next()) {
+      GrowableArray<PreloadMethodHolder*>* methods = h->method_list();
+      for (int j = 0; j < methods->length(); j++) {
+        offsets[recorded++] = (u4)_pos;
+        write_merged_record(h, methods->at(j));
+      }
+    }
+  }
+  assert(recorded == record_count, "sanity");
+  write_method_index(offsets, record_count, index_pos);
+  FREE_C_HEAP_ARRAY(u4, offsets, mtInternal);
+  delete classes;
+
+  close_logfile();
+  return true;
+}
+
 // =========================== Preload Class Module ========================== //
 
 PreloadClassDictionary::PreloadClassDictionary(int size)
@@ -749,6 +1038,9 @@ PreloadMethodHolder::PreloadMethodHolder(Symbol* name, Symbol* signature)
     _intp_throwout_count(0),
     _invocation_count(0),
     _backage_count(0),
+    _order(0),
+    _comp_level(CompLevel_none),
+    _instances(1),
     _mounted_offset(-1),
     _owns_md_list(true),
     _is_deopted(false),
@@ -768,6 +1060,9 @@ PreloadMethodHolder::PreloadMethodHolder(PreloadMethodHolder& rhs)
     _intp_throwout_count(rhs._intp_throwout_count),
     _invocation_count(rhs._invocation_count),
     _backage_count(rhs._backage_count),
+    _order(rhs._order),
+    _comp_level(rhs._comp_level),
+    _instances(rhs._instances),
     _mounted_offset(rhs._mounted_offset),
     _owns_md_list(false),
     _is_deopted(false),
@@ -778,10 +1073,198 @@ PreloadMethodHolder::PreloadMethodHolder(PreloadMethodHolder& rhs)
 
 PreloadMethodHolder::~PreloadMethodHolder() {
   if (_owns_md_list) {
+    for (int i = 0; i < _md_list->length(); i++) {
+      delete _md_list->at(i);
+    }
     delete _md_list;
   }
 }
 
+unsigned int PreloadMethodHolder::hotness() const {
+  julong count = (julong)(_invocation_count >> InvocationCounter::count_shift) +
+                 (julong)(_backage_count >> InvocationCounter::count_shift) +
+                 (julong)_intp_invocation_count;
+  return (unsigned int)MIN2(count, (julong)max_juint);
+}
+
+static unsigned int saturating_add(unsigned int a, unsigned int b) {
+  return (unsigned int)MIN2((julong)a + (julong)b, (julong)max_juint);
+}
+
+// invocation and backedge counters are recorded raw, with the state bits
+static unsigned int add_raw_counters(unsigned int a, unsigned int b) {
+  julong count = (julong)(a >> InvocationCounter::count_shift) +
+                 (julong)(b >> InvocationCounter::count_shift);
+  count = MIN2(count, (julong)(max_juint >> InvocationCounter::count_shift));
+  return (unsigned int)(count << InvocationCounter::count_shift);
+}
+
+// Counts are summed, so that methods are weighted by the number of
+// instances which ran them; the profile records of the first instance
+// are kept.
+void PreloadMethodHolder::merge(PreloadMethodHolder* other) {
+  assert(other->size() == size() && other->hash() == hash(), "same class file, same method");
+  _intp_invocation_count = saturating_add(_intp_invocation_count, other->_intp_invocation_count);
+  _intp_throwout_count = saturating_add(_intp_throwout_count, other->_intp_throwout_count);
+  _invocation_count = add_raw_counters(_invocation_count, other->_invocation_count);
+  _backage_count = add_raw_counters(_backage_count, other->_backage_count);
+  _order = MIN2(_order, other->_order);
+  _comp_level = MAX2(_comp_level, other->_comp_level);
+  _instances = saturating_add(_instances, other->_instances);
+}
+
+void PreloadMethodHolder::add_md_records(GrowableArray<MDRecordInfo*>* records) {
+  assert(_owns_md_list, "only the parsed holder owns the profile records");
+  _md_list->appendAll(records);
+}
+
+void PreloadMethodHolder::restore_method_data(methodHandle m, TRAPS) {
+  if (_md_list->is_empty()) {
+    return;
+  }
+  if (m->method_data() == NULL) {
+    Method::build_interpreter_method_data(m, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      return;
+    }
+  }
+  MethodData* mdo = m->method_data();
+  if (mdo == NULL) {
+    return;
+  }
+  Handle loader(THREAD, m->method_holder()->class_loader());
+  Handle protection_domain(THREAD, m->method_holder()->protection_domain());
+  int restored = 0;
+  for (int i = 0; i < _md_list->length(); i++) {
+    MDRecordInfo* info = _md_list->at(i);
+    ProfileData* data = mdo->bci_to_data(info->bci());
+    // bytecodes are matched by size/hash, so a mismatch here means stale data
+    if (data == NULL || data->data()->tag() != info->tag()) {
+      continue;
+    }
+    if (data->is_BitData() &&
+        (info->flags() & BitData::null_seen_byte_constant()) != 0) {
+      data->as_BitData()->set_null_seen();
+    }
+    if (data->is_CounterData()) {
+      CounterData* cd = data->as_CounterData();
+      cd->set_count(MAX2(cd->count(), (uint)info->count()));
+    } else if (data->is_JumpData()) {
+      JumpData* jd = data->as_JumpData();
+      jd->set_taken(MAX2(jd->taken(), (uint)info->count()));
+      if (data->is_BranchData()) {
+        BranchData* bd = data->as_BranchData();
+        bd->set_not_taken(MAX2(bd->not_taken(), (uint)info->not_taken()));
+      }
+    }
+    if (data->is_ReceiverTypeData() && info->receiver_rows() > 0) {
+      ReceiverTypeData* rtd = data->as_ReceiverTypeData();
+      for (int r = 0; r < info->receiver_rows(); r++) {
+        // only receivers already loaded by the holder's loader are filled in,
+        // warmup must not trigger class loading here
+        Klass* k = SystemDictionary::find(info->receiver_at(r), loader, protection_domain, THREAD);
+        if (HAS_PENDING_EXCEPTION) {
+          CLEAR_PENDING_EXCEPTION;
+          continue;
+        }
+        if (k == NULL) {
+          continue;
+        }
+        uint empty_row = ReceiverTypeData::row_limit();
+        bool present = false;
+        for (uint row = 0; row < ReceiverTypeData::row_limit(); row++) {
+          Klass* receiver = rtd->receiver(row);
+          if (receiver == k) {
+            present = true;
+            break;
+          }
+          if (receiver == NULL && empty_row == ReceiverTypeData::row_limit()) {
+            empty_row = row;
+          }
+        }
+        if (!present && empty_row < ReceiverTypeData::row_limit()) {
+          rtd->set_receiver_count(empty_row, info->receiver_count_at(r));
+          rtd->set_receiver(empty_row, k);
+        }
+      }
+    }
+    restored++;
+  }
+  if (PrintCompilationWarmUpDetail) {
+    ResourceMark rm;
+    tty->print_cr("[JitWarmUp] restored %d profile entries for %s",
+                  restored, m->name_and_sig_as_C_string());
+  }
+}
+
+static bool is_recorded_receiver(MDRecordInfo* info, Symbol* name) {
+  for (int r = 0; r < info->receiver_rows(); r++) {
+    if (info->receiver_at(r) == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// A trap for a reason the warmup compilation speculated on means the recorded
+// profile was wrong for this run. Otherwise the drift is the largest shift of
+// a branch probability, or the largest share of receivers the recording run
+// never saw, between the recorded and the live MethodData.
+int PreloadMethodHolder::profile_drift(Method* m) const {
+  if (m->jwarmup_speculation_failures() > 0) {
+    return 100;
+  }
+  MethodData* mdo = m->method_data();
+  if (mdo == NULL) {
+    return 0;
+  }
+  for (uint reason = 0; reason < MethodData::trap_reason_limit() &&
+                        reason < (uint)Deoptimization::Reason_LIMIT; reason++) {
+    if (Deoptimization::is_jwarmup_speculation_reason((Deoptimization::DeoptReason)reason) &&
+        mdo->trap_count(reason) > 0) {
+      return 100;
+    }
+  }
+  int drift = 0;
+  for (int i = 0; i < _md_list->length(); i++) {
+    MDRecordInfo* info = _md_list->at(i);
+    ProfileData* data = mdo->bci_to_data(info->bci());
+    if (data == NULL || data->data()->tag() != info->tag()) {
+      continue;
+    }
+    if (data->is_BranchData()) {
+      BranchData* bd = data->as_BranchData();
+      julong recorded_total = (julong)info->count() + info->not_taken();
+      julong live_total = (julong)bd->taken() + bd->not_taken();
+      if (recorded_total == 0 || live_total == 0) {
+        continue;
+      }
+      int recorded = (int)((julong)info->count() * 100 / recorded_total);
+      int live = (int)((julong)bd->taken() * 100 / live_total);
+      drift = MAX2(drift, recorded > live ? recorded - live : live - recorded);
+    } else if (data->is_ReceiverTypeData() && info->receiver_rows() > 0) {
+      ReceiverTypeData* rtd = data->as_ReceiverTypeData();
+      julong total = 0;
+      julong unrecorded = 0;
+      for (uint row = 0; row < ReceiverTypeData::row_limit(); row++) {
+        Klass* receiver = rtd->receiver(row);
+        if (receiver == NULL) {
+          continue;
+        }
+        total += rtd->receiver_count(row);
+        if (!is_recorded_receiver(info, receiver->name())) {
+          unrecorded += rtd->receiver_count(row);
+        }
+      }
+      if (total > 0) {
+        drift = MAX2(drift, (int)(unrecorded * 100 / total));
+      }
+    }
+  }
+  return drift;
+}
+
 bool PreloadMethodHolder::check_matching(Method* method) {
   // NYI size and hash not used yet
   if (name()->fast_compare(method->name()) == 0
@@ -1062,6 +1545,9 @@ void PreloadClassChain::warmup_impl() {
     return;
   }
 
+  // methods held back for the throttled submission
+  Stack<PreloadMethodHolder*, mtInternal> pending;
+
   /* iterate all PreloadClassChainEntry to submit warmup compilation*/
   bool cancel_warmup = false;
   for ( int index = 0; index < length(); index++ ) {
@@ -1135,11 +1621,143 @@ void PreloadClassChain::warmup_impl() {
       }
     }
     // compile methods in compile_queue
-    compile_methodholders_queue(compile_queue);
+    if (CompilationWarmUpThrottle) {
+      while (!compile_queue.is_empty()) {
+        pending.push(compile_queue.pop());
+      }
+    } else {
+      compile_methodholders_queue(compile_queue);
+    }
+  }
+  if (CompilationWarmUpThrottle) {
+    compile_methodholders_throttled(pending);
+  }
+}
+
+// Paces warmup compilations: waits while the compile queues are deeper than
+// CompilationWarmUpThrottleQueueSize or the process uses more than
+// CompilationWarmUpThrottleCPUPercent of the available processors.
+class JitWarmUpThrottle : public StackObj {
+  enum {
+    SampleIntervalSecs = 1,   // unit of CPU usage sampling below
+    MaxWaitRounds      = 50   // never hold back a submission forever
+  };
+  double _last_real;
+  double _last_cpu;
+  bool   _cpu_busy;
+
+  bool sample_cpu(double* real, double* cpu) {
+    double user, sys;
+    if (!os::getTimesSecs(real, &user, &sys)) {
+      return false;
+    }
+    *cpu = user + sys;
+    return true;
+  }
+
+  void update_cpu_busy() {
+    double real, cpu;
+    if (CompilationWarmUpThrottleCPUPercent >= 100 || !sample_cpu(&real, &cpu)) {
+      _cpu_busy = false;
+      return;
+    }
+    double elapsed = real - _last_real;
+    if (elapsed < (double)SampleIntervalSecs / 10) {
+      // too short to tell, keep the last verdict
+      return;
+    }
+    double usage = (cpu - _last_cpu) * 100 / (elapsed * os::active_processor_count());
+    _cpu_busy = usage >= (double)CompilationWarmUpThrottleCPUPercent;
+    _last_real = real;
+    _last_cpu = cpu;
+  }
+
+  bool queues_busy() {
+    int queued = CompileBroker::queue_size(CompLevel_full_optimization);
+    if (TieredCompilation) {
+      queued += CompileBroker::queue_size(CompLevel_full_profile);
+    }
+    return queued >= (int)CompilationWarmUpThrottleQueueSize;
+  }
+
+public:
+  JitWarmUpThrottle() : _last_real(0), _last_cpu(0), _cpu_busy(false) {
+    if (!sample_cpu(&_last_real, &_last_cpu)) {
+      _last_real = 0;
+      _last_cpu = 0;
+    }
+  }
+
+  void wait_until_idle(JavaThread* jt) {
+    for (int round = 0; round < MaxWaitRounds; round++) {
+      update_cpu_busy();
+      if (!_cpu_busy && !queues_busy()) {
+        return;
+      }
+      ThreadBlockInVM tbivm(jt);
+      os::naked_short_sleep(MIN2(MAX2(CompilationWarmUpThrottleInterval, (uintx)1), (uintx)999));
+    }
+  }
+};
+
+// hotter methods first, ties broken by recorded compilation order
+static int compare_by_warmup_priority(PreloadMethodHolder** a, PreloadMethodHolder** b) {
+  unsigned int ha = (*a)->hotness();
+  unsigned int hb = (*b)->hotness();
+  if (ha != hb) {
+    return ha > hb ? -1 : 1;
+  }
+  if ((*a)->order() != (*b)->order()) {
+    return (*a)->order() < (*b)->order() ? -1 : 1;
+  }
+  return 0;
+}
+
+void PreloadClassChain::compile_methodholders_throttled(Stack<PreloadMethodHolder*, mtInternal>& pending) {
+  Thread* THREAD = Thread::current();
+  assert(THREAD->is_Java_thread(), "sanity check");
+  GrowableArray<PreloadMethodHolder*>* queue = new (ResourceObj::C_HEAP, mtClass)
+    GrowableArray<PreloadMethodHolder*>((int)pending.size() + 1, true, mtClass);
+  while (!pending.is_empty()) {
+    queue->append(pending.pop());
+  }
+  queue->sort(compare_by_warmup_priority);
+  JitWarmUpThrottle throttle;
+  for (int i = 0; i < queue->length(); i++) {
+    throttle.wait_until_idle((JavaThread*)THREAD);
+    PreloadMethodHolder* pmh = queue->at(i);
+    compile_methodholder(pmh);
+    if (HAS_PENDING_EXCEPTION) {
+      ResourceMark rm;
+      log_warning(warmup)("[JitWarmUp] WARNING: Exceptions happened in compiling %s",
+                          pmh->name()->as_C_string());
+      // ignore exception occurs during compilation
+      CLEAR_PENDING_EXCEPTION;
+    }
+  }
+  delete queue;
+}
+
+// Level to replay a method at: with tiered compilation, methods that stayed
+// in C1 in the recording run get profiled C1 code and are left to the tiered
+// policy for promotion; only methods that reached C2 are compiled by C2.
+int PreloadClassChain::replay_level(int recorded_level) {
+  if (!TieredCompilation || !CompilationWarmUpTieredReplay ||
+      recorded_level == CompLevel_none ||
+      recorded_level == CompLevel_full_optimization) {
+    return CompLevel_full_optimization;
   }
+  if (recorded_level == CompLevel_simple) {
+    // trivial methods do not need profiles
+    return MIN2((int)CompLevel_simple, (int)TieredStopAtLevel);
+  }
+  return MIN2((int)CompLevel_full_profile, (int)TieredStopAtLevel);
 }
 
 bool PreloadClassChain::compile_methodholder(PreloadMethodHolder* mh) {
+  if (mh->instances() < CompilationWarmUpMinInstances) {
+    return false;
+  }
   Thread* t = Thread::current();
   methodHandle m(t, mh->resolved_method());
   if (m() == NULL || m->compiled_by_jwarmup() || m->has_compiled_code()) {
@@ -1152,13 +1770,17 @@ bool PreloadClassChain::compile_methodholder(PreloadMethodHolder* mh) {
   }
 
   m->set_compiled_by_jwarmup(true);
+  if (CompilationWarmUpRecordMethodData) {
+    mh->restore_method_data(m, t);
+  }
   // not deal with osr compilation
   int bci = InvocationEntryBci;
-  bool ret = JitWarmUp::commit_compilation(m, bci, t);
+  int comp_level = replay_level(mh->comp_level());
+  bool ret = JitWarmUp::commit_compilation(m, bci, comp_level, t);
   if (ret) {
     ResourceMark rm;
-    log_info(warmup)("[JitWarmUp] preload method %s success compiled",
-                     m->name_and_sig_as_C_string());
+    log_info(warmup)("[JitWarmUp] preload method %s success compiled at level %d",
+                     m->name_and_sig_as_C_string(), comp_level);
   }
   return ret;
 }
@@ -1283,10 +1905,31 @@ void PreloadClassChain::invoke_deoptimize_vmop() {
   VMThread::execute(&op);
 }
 
+// With CompilationWarmUpAdaptiveDeopt the recompilations caused by one
+// iteration must fit into what the compile queues can take right now.
+int PreloadClassChain::deopt_budget() {
+  int budget = (int)CompilationWarmUpDeoptNumOfMethodsPerIter;
+  if (!CompilationWarmUpAdaptiveDeopt) {
+    return budget;
+  }
+  int queued = CompileBroker::queue_size(CompLevel_full_optimization);
+  if (TieredCompilation) {
+    queued += CompileBroker::queue_size(CompLevel_full_profile);
+  }
+  return MAX2(budget - queued, 0);
+}
+
 void PreloadClassChain::deoptimize_methods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be in safepoint");
   deopt_prologue();
 
+  int budget = deopt_budget();
+  if (budget == 0) {
+    // compile queues are busy, try again in the next interval
+    _last_timestamp.update();
+    return;
+  }
+
   Method* dummy_method = JitWarmUp::instance()->dummy_method();
   assert( dummy_method != NULL && dummy_method->code() != NULL, "dummy method must be compiled");
   int dummy_compile_id = dummy_method->code()->compile_id();
@@ -1312,6 +1955,17 @@ void PreloadClassChain::deoptimize_methods() {
       iter.next();
       continue;
     }
+    if (CompilationWarmUpAdaptiveDeopt && m->code() != NULL) {
+      int drift = pmh->profile_drift(m());
+      if (drift < (int)CompilationWarmUpDeoptProfileDrift) {
+        // the live profile still matches the recorded one, keep the code
+        ResourceMark rm;
+        log_info(warmup)("[JitWarmUp] keep warmup method %s, profile drift %d%%",
+                         m->name_and_sig_as_C_string(), drift);
+        iter.next();
+        continue;
+      }
+    }
     int result = 0;
     if (m->code() != NULL) {
       m->code()->mark_for_deoptimization();
@@ -1325,7 +1979,7 @@ void PreloadClassChain::deoptimize_methods() {
       num++;
     }
     iter.next();
-    if (num == (int)CompilationWarmUpDeoptNumOfMethodsPerIter) {
+    if (num == budget) {
       break;
     }
   }
@@ -1404,16 +2058,25 @@ PreloadMethodHolder* PreloadClassChain::resolve_method_info(Method* method, Prel
   }
 }
 
-// JitWarmUp log parser
-class JitWarmUpLogParser : CHeapObj<mtInternal> {
+// JitWarmUp log parser, reads the log file mapped into memory
+class JitWarmUpLogParser : public CHeapObj<mtInternal> {
+  friend class JitWarmUpInternSymbolsTask;
 public:
-  JitWarmUpLogParser(randomAccessFileStream* fs, PreloadJitInfo* holder);
+  JitWarmUpLogParser(const char* base, long file_size, PreloadJitInfo* holder);
   virtual ~JitWarmUpLogParser();
 
   bool valid();
 
   bool parse_header();
+  bool parse_symbol_section();
   bool parse_class_init_section();
+  bool parse_method_index_section();
+
+  // number of classes in the class init section, 0 if illegal
+  u4 class_count();
+
+  // intern the symbols of the symbol section, with the GC workers if possible
+  void intern_symbols();
 
   bool should_ignore_this_class(Symbol* s);
 
@@ -1430,7 +2093,6 @@ public:
   int total_methods()  { return _total_methods; }
 
   long file_size()              { return _file_size; }
-  void set_file_size(long size) { _file_size = size; }
 
   int max_symbol_length() { return _max_symbol_length; }
 
@@ -1450,10 +2112,16 @@ private:
   // method count recorded in log file
   int                     _total_methods;
   long                    _file_size;
-  randomAccessFileStream* _fs;
+  const char*             _base;
 
   int                     _max_symbol_length;
-  char*                   _parse_str_buf;
+
+  // symbol section: offset of each string and its symbol once interned
+  int                     _symbol_count;
+  u4*                     _symbol_offsets;
+  Symbol**                _symbols;
+  // method index section: offset of each method record
+  u4*                     _method_offsets;
 
   PreloadJitInfo*         _holder;
   Arena*                  _arena;
@@ -1461,69 +2129,142 @@ private:
   u1                      read_u1();
   u4                      read_u4();
   u8                      read_u8();
-  char*                   read_string();
+  // symbol referred to by the next u4, NULL for an illegal index
+  Symbol*                 read_symbol();
+
+  Symbol*                 symbol_at(u4 index);
+  void                    intern_symbol_at(int index, TRAPS);
+
+  // profile data of the method record ending at end_pos, NULL if illegal
+  GrowableArray<MDRecordInfo*>* parse_method_data(int end_pos);
 };
 
-JitWarmUpLogParser::JitWarmUpLogParser(randomAccessFileStream* fs, PreloadJitInfo* holder)
+JitWarmUpLogParser::JitWarmUpLogParser(const char* base, long file_size, PreloadJitInfo* holder)
   : _is_valid(false),
     _has_parsed_header(false),
     _position(0),
     _parsed_methods(0),
     _total_methods(0),
-    _file_size(0),
-    _fs(fs),
+    _file_size(file_size),
+    _base(base),
     _max_symbol_length(0),
-    _parse_str_buf(NULL),
+    _symbol_count(0),
+    _symbol_offsets(NULL),
+    _symbols(NULL),
+    _method_offsets(NULL),
     _holder(holder),
     _arena(new (mtInternal) Arena(mtInternal, 128)) {
 }
 
 JitWarmUpLogParser::~JitWarmUpLogParser() {
-  // fileStream lifecycle is not managed by this class
+  // the mapping lifecycle is not managed by this class
   delete _arena;
 }
 
-char parse_int_buf[8];
+// Reads past the end of the file return 0 and move _position beyond
+// _file_size, so that the bound checks below fail.
 u1 JitWarmUpLogParser::read_u1() {
-  _fs->read(parse_int_buf, 1, 1);
+  if (_position + 1 > _file_size) {
+    _position = (int)_file_size + 1;
+    return 0;
+  }
+  u1 value = *(u1*)(_base + _position);
   _position += 1;
-  return *(u1*)parse_int_buf;
+  return value;
 }
 
 u4 JitWarmUpLogParser::read_u4() {
-  _fs->read(parse_int_buf, 4, 1);
+  if (_position + 4 > _file_size) {
+    _position = (int)_file_size + 1;
+    return 0;
+  }
+  u4 value;
+  ::memcpy(&value, _base + _position, sizeof(value));
   _position += 4;
-  return *(u4*)parse_int_buf;
+  return value;
 }
 
 u8 JitWarmUpLogParser::read_u8() {
-  _fs->read(parse_int_buf, 8, 1);
+  if (_position + 8 > _file_size) {
+    _position = (int)_file_size + 1;
+    return 0;
+  }
+  u8 value;
+  ::memcpy(&value, _base + _position, sizeof(value));
   _position += 8;
-  return *(u8*)parse_int_buf;
+  return value;
 }
 
-char* JitWarmUpLogParser::read_string() {
-  int index = 0;
-  do {
-    _fs->read(_parse_str_buf + index, 1, 1);
-    index++;
-  } while (*(_parse_str_buf + index - 1) != '\0'
-          && index <= _max_symbol_length + 1);
+void JitWarmUpLogParser::intern_symbol_at(int index, TRAPS) {
+  const char* str = _base + _symbol_offsets[index];
+  _symbols[index] = SymbolTable::new_symbol(str, (int)::strlen(str), THREAD);
+}
 
-  _position += index;
-  int len = index - 1;
-  if (len == 0) {
+Symbol* JitWarmUpLogParser::symbol_at(u4 index) {
+  if (index >= (u4)_symbol_count) {
+    log_error(warmup)("[JitWarmUp] ERROR : Symbol index %u out of bound", index);
     return NULL;
-  } else if (len > max_symbol_length()) {
-    log_error(warmup)("[JitWarmUp] ERROR : Parsed symbol length is longer than %d\n", max_symbol_length());
+  }
+  if (_symbols[index] == NULL) {
+    intern_symbol_at((int)index, Thread::current());
+  }
+  return _symbols[index];
+}
+
+Symbol* JitWarmUpLogParser::read_symbol() {
+  u4 index = read_u4();
+  if (_position > _file_size) {
     return NULL;
-  } else {
-    char* str = NEW_RESOURCE_ARRAY(char, len + 1);
-    ::memcpy(str, _parse_str_buf, len + 1);
-    return str;
   }
+  return symbol_at(index);
 }
 
+// Interns the symbol section in chunks claimed by the GC worker threads,
+// which are idle while the VM is being initialized.
+class JitWarmUpInternSymbolsTask : public AbstractGangTask {
+  JitWarmUpLogParser* _parser;
+  volatile jint       _next_chunk;
+  enum { ChunkSize = 256 };
+public:
+  JitWarmUpInternSymbolsTask(JitWarmUpLogParser* parser) :
+    AbstractGangTask("JitWarmUp intern symbols"), _parser(parser), _next_chunk(0) { }
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    int count = _parser->_symbol_count;
+    while (true) {
+      int start = (Atomic::add(1, &_next_chunk) - 1) * ChunkSize;
+      if (start >= count) {
+        return;
+      }
+      int end = MIN2(start + (int)ChunkSize, count);
+      for (int i = start; i < end; i++) {
+        _parser->intern_symbol_at(i, thread);
+      }
+    }
+  }
+};
+
+#define PARALLEL_INTERN_MIN_SYMBOLS 4096
+
+void JitWarmUpLogParser::intern_symbols() {
+  if (!CompilationWarmUpParallelLoad || _symbol_count < PARALLEL_INTERN_MIN_SYMBOLS) {
+    // interned lazily on first use
+    return;
+  }
+  FlexibleWorkGang* workers = NULL;
+  if (UseG1GC || UseConcMarkSweepGC || UseParNewGC) {
+    workers = SharedHeap::heap()->workers();
+  }
+  if (workers == NULL || workers->active_workers() <= 1) {
+    return;
+  }
+  JitWarmUpInternSymbolsTask task(this);
+  workers->run_task(&task);
+}
+
+#undef PARALLEL_INTERN_MIN_SYMBOLS
+
 #define MAX_COUNT_VALUE (1024 * 1024 * 128)
 
 #define LOGPARSER_ILLEGAL_STRING_CHECK(s, ret_value)                 \
@@ -1551,6 +2292,13 @@ char* JitWarmUpLogParser::read_string() {
     return ret_value;                                                \
   }
 
+#define LOGPARSER_ILLEGAL_SECTION_CHECK(begin_pos, section_size, ret_value) \
+  if ((long)begin_pos + (long)section_size > _file_size) {           \
+    log_error(warmup)("[JitWarmUp] ERROR : section out of bound, "   \
+                      "file format error");                          \
+    return ret_value;                                                \
+  }
+
 bool JitWarmUpLogParser::should_ignore_this_class(Symbol* s) {
   // FIXME deal with spring auto-generated
   ResourceMark rm;
@@ -1572,6 +2320,11 @@ bool JitWarmUpLogParser::should_ignore_this_class(Symbol* s) {
 bool JitWarmUpLogParser::parse_header() {
   int begin_pos = _position;
   int end_pos = begin_pos + HEADER_SIZE;
+  if (_file_size < HEADER_SIZE + SYMBOL_SECTION_OFFSET_WIDTH) {
+    _is_valid = false;
+    log_error(warmup)("[JitWarmUp] ERROR : illegal header");
+    return false;
+  }
   u4 version_number = read_u4();
   u4 magic_number = read_u4();
   u4 file_size = read_u4();
@@ -1597,7 +2350,7 @@ bool JitWarmUpLogParser::parse_header() {
     return false;
   }
   // valid crc32
-  int crc32_actual = ProfileRecorder::compute_crc32(_fs);
+  int crc32_actual = ClassLoader::crc32(0, _base + HEADER_SIZE, (int)(_file_size - HEADER_SIZE));
   if (crc32_recorded != crc32_actual) {
     _is_valid = false;
     log_error(warmup)("[JitWarmUp] ERROR : log file crc32 check failure");
@@ -1606,7 +2359,6 @@ bool JitWarmUpLogParser::parse_header() {
 
   u4 max_symbol_length = read_u4();
   LOGPARSER_ILLEGAL_COUNT_CHECK(max_symbol_length, false);
-  _parse_str_buf = (char*)_arena->Amalloc(max_symbol_length + 2);
   _max_symbol_length = (int)max_symbol_length;
 
   u4 record_count = read_u4();
@@ -1617,35 +2369,108 @@ bool JitWarmUpLogParser::parse_header() {
   return true;
 }
 
-#define CREATE_SYMBOL(char_name)      \
-  SymbolTable::new_symbol(char_name, (int)strlen(char_name), Thread::current())
+// Only records the string offsets, strings become symbols in
+// intern_symbols() or on first use.
+bool JitWarmUpLogParser::parse_symbol_section() {
+  int saved_position = _position;
+  _position = (int)(_file_size - SYMBOL_SECTION_OFFSET_WIDTH);
+  int begin_pos = (int)read_u4();
+  long section_end_limit = _file_size - SYMBOL_SECTION_OFFSET_WIDTH;
+  if (begin_pos < HEADER_SIZE || begin_pos >= section_end_limit) {
+    log_error(warmup)("[JitWarmUp] ERROR : illegal symbol section offset");
+    return false;
+  }
+  _position = begin_pos;
+  u4 section_size = read_u4();
+  if ((long)begin_pos + (long)section_size != section_end_limit) {
+    log_error(warmup)("[JitWarmUp] ERROR : log file symbol section parse error.");
+    return false;
+  }
+  int end_pos = begin_pos + (int)section_size;
+  u4 cnt = read_u4();
+  LOGPARSER_ILLEGAL_COUNT_CHECK(cnt, false);
+
+  _symbol_count = (int)cnt;
+  _symbol_offsets = (u4*)_arena->Amalloc(MAX2(cnt, (u4)1) * sizeof(u4));
+  _symbols = (Symbol**)_arena->Amalloc(MAX2(cnt, (u4)1) * sizeof(Symbol*));
+  for (int i = 0; i < (int)cnt; i++) {
+    const char* str = _base + _position;
+    const char* nul = (const char*)::memchr(str, '\0', end_pos - _position);
+    if (nul == NULL || nul == str || nul - str > _max_symbol_length) {
+      log_error(warmup)("[JitWarmUp] ERROR : illegal string in log file");
+      return false;
+    }
+    _symbol_offsets[i] = (u4)_position;
+    _symbols[i] = NULL;
+    _position += (int)(nul - str) + 1;
+  }
+  if (_position != end_pos) {
+    log_error(warmup)("[JitWarmUp] ERROR : log file symbol section parse error.");
+    return false;
+  }
+  _position = saved_position;
+  return true;
+}
 
 bool JitWarmUpLogParser::parse_class_init_section() {
   ResourceMark rm;
   int begin_pos = _position;
   u4 section_size = read_u4();
+  LOGPARSER_ILLEGAL_SECTION_CHECK(begin_pos, section_size, false);
   int end_pos = begin_pos + (int)section_size;
   u4 cnt = read_u4();
   LOGPARSER_ILLEGAL_COUNT_CHECK(cnt, false);
 
-  PreloadClassChain* chain = new PreloadClassChain(cnt);
-  info_holder()->set_chain(chain);
-  chain->set_holder(this->info_holder());
-
-  for (int i = 0; i < (int)cnt; i++) {
-    char* name_char = read_string();
-    LOGPARSER_ILLEGAL_STRING_CHECK(name_char, false);
-    char* loader_char = read_string();
-    LOGPARSER_ILLEGAL_STRING_CHECK(loader_char, false);
-    char* path_char = read_string();
-    LOGPARSER_ILLEGAL_STRING_CHECK(path_char, false);
-    Symbol* name = CREATE_SYMBOL(name_char);
-    Symbol* loader_name = CREATE_SYMBOL(loader_char);
-    Symbol* path = CREATE_SYMBOL(path_char);
+  // when merging, the chain was sized for all logs and the classes which
+  // were not seen in a previous log are appended
+  PreloadClassChain* chain = info_holder()->chain();
+  bool merging = info_holder()->merging();
+  if (!merging) {
+    chain = new PreloadClassChain(cnt);
+    info_holder()->set_chain(chain);
+    chain->set_holder(this->info_holder());
+  }
+
+  for (int j = 0; j < (int)cnt; j++) {
+    Symbol* name = read_symbol();
+    LOGPARSER_ILLEGAL_STRING_CHECK(name, false);
+    Symbol* loader_name = read_symbol();
+    LOGPARSER_ILLEGAL_STRING_CHECK(loader_name, false);
+    Symbol* path = read_symbol();
+    LOGPARSER_ILLEGAL_STRING_CHECK(path, false);
     loader_name = PreloadJitInfo::remove_meaningless_suffix(loader_name);
+    u4 klass_size = read_u4();
+    u4 klass_crc32 = read_u4();
+    u4 resolved_cnt = read_u4();
+    if (_position > end_pos || resolved_cnt > (u4)(end_pos - _position) / sizeof(u4)) {
+      log_error(warmup)("[JitWarmUp] ERROR : illegal resolved entry count");
+      return false;
+    }
+    int resolved_pos = _position;
+    _position += (int)(resolved_cnt * sizeof(u4));
+    int i = j;
+    if (merging) {
+      i = chain->length();
+      PreloadClassEntry* known = info_holder()->dict()->find_entry(name->identity_hash(), name, loader_name, path);
+      if (known != NULL) {
+        continue;
+      }
+      chain->set_length(i + 1);
+    }
     chain->at(i)->set_class_name(name);
     chain->at(i)->set_loader_name(loader_name);
     chain->at(i)->set_path(path);
+    if (resolved_cnt > 0) {
+      GrowableArray<u4>* resolved = new (ResourceObj::C_HEAP, mtClass)
+        GrowableArray<u4>((int)resolved_cnt, true, mtClass);
+      int pos = _position;
+      _position = resolved_pos;
+      for (int k = 0; k < (int)resolved_cnt; k++) {
+        resolved->append(read_u4());
+      }
+      _position = pos;
+      chain->at(i)->set_resolved_entries(klass_size, klass_crc32, resolved);
+    }
     // add to preload class dictionary
     unsigned int hash_value = name->identity_hash();
 
@@ -1678,6 +2503,37 @@ bool JitWarmUpLogParser::parse_class_init_section() {
   return true;
 }
 
+bool JitWarmUpLogParser::parse_method_index_section() {
+  int begin_pos = _position;
+  u4 section_size = read_u4();
+  LOGPARSER_ILLEGAL_SECTION_CHECK(begin_pos, section_size, false);
+  int end_pos = begin_pos + (int)section_size;
+  u4 cnt = read_u4();
+  LOGPARSER_ILLEGAL_COUNT_CHECK(cnt, false);
+  if (cnt != (u4)_total_methods || section_size != 2 * sizeof(u4) + cnt * sizeof(u4)) {
+    log_error(warmup)("[JitWarmUp] ERROR : log file method index section parse error.");
+    return false;
+  }
+  _method_offsets = (u4*)_arena->Amalloc(MAX2(cnt, (u4)1) * sizeof(u4));
+  for (int i = 0; i < (int)cnt; i++) {
+    _method_offsets[i] = read_u4();
+    if (_method_offsets[i] < (u4)end_pos || (long)_method_offsets[i] >= _file_size) {
+      log_error(warmup)("[JitWarmUp] ERROR : illegal method record offset");
+      return false;
+    }
+  }
+  return true;
+}
+
+u4 JitWarmUpLogParser::class_count() {
+  int saved_position = _position;
+  // the class init section follows the header, after its size
+  _position = HEADER_SIZE + 4;
+  u4 cnt = read_u4();
+  _position = saved_position;
+  return cnt > MAX_COUNT_VALUE ? 0 : cnt;
+}
+
 bool JitWarmUpLogParser::valid() {
   if(!_has_parsed_header) {
     parse_header();
@@ -1685,15 +2541,57 @@ bool JitWarmUpLogParser::valid() {
   return _is_valid;
 }
 
+// parse the profile data appended to a method record, see
+// ProfileRecorder::write_method_data; an empty list if there is none
+GrowableArray<MDRecordInfo*>* JitWarmUpLogParser::parse_method_data(int end_pos) {
+  GrowableArray<MDRecordInfo*>* md_list = new (ResourceObj::C_HEAP, mtClass)
+    GrowableArray<MDRecordInfo*>(4, true, mtClass);
+  if (_position == end_pos) {
+    return md_list;
+  }
+  u4 count = read_u4();
+  for (u4 i = 0; i < count && _position <= end_pos; i++) {
+    int bci = (int)read_u4();
+    u1 tag = read_u1();
+    u1 flags = read_u1();
+    u4 taken = read_u4();
+    u4 not_taken = read_u4();
+    u1 rows = read_u1();
+    if (_position > end_pos || rows > MDRecordInfo::MaxReceiverRows) {
+      break;
+    }
+    MDRecordInfo* info = new MDRecordInfo(bci, tag, flags, taken, not_taken);
+    md_list->append(info);
+    for (u1 row = 0; row < rows; row++) {
+      Symbol* receiver = read_symbol();
+      u4 receiver_count = read_u4();
+      if (receiver == NULL || _position > end_pos) {
+        break;
+      }
+      info->add_receiver(receiver, receiver_count);
+    }
+  }
+  if (_position != end_pos) {
+    log_error(warmup)("[JitWarmUp] ERROR : illegal method data in log file");
+    for (int i = 0; i < md_list->length(); i++) {
+      delete md_list->at(i);
+    }
+    delete md_list;
+    return NULL;
+  }
+  return md_list;
+}
+
 bool JitWarmUpLogParser::has_next() {
-  return _parsed_methods < _total_methods && _position < _file_size;
+  return _parsed_methods < _total_methods;
 }
 
 PreloadMethodHolder* JitWarmUpLogParser::next() {
   ResourceMark rm;
-  _fs->fseek(_position, SEEK_SET);
+  _position = (int)_method_offsets[_parsed_methods];
   int begin_pos = _position;
   u4 section_size = read_u4();
+  LOGPARSER_ILLEGAL_SECTION_CHECK(begin_pos, section_size, NULL);
   int end_pos = begin_pos + section_size;
 
   u4 comp_order = read_u4();
@@ -1705,13 +2603,17 @@ PreloadMethodHolder* JitWarmUpLogParser::next() {
     _position = end_pos;
     return NULL;
   }
+  u1 comp_level = read_u1();
+  if (comp_level > CompLevel_full_optimization) {
+    log_error(warmup)("[JitWarmUp] ERROR : illegal compilation level in log file");
+    _position = end_pos;
+    return NULL;
+  }
   // method info
-  char* method_name_char = read_string();
-  LOGPARSER_ILLEGAL_STRING_CHECK(method_name_char, NULL);
-  Symbol* method_name = CREATE_SYMBOL(method_name_char);
-  char* method_sig_char = read_string();
-  LOGPARSER_ILLEGAL_STRING_CHECK(method_sig_char, NULL);
-  Symbol* method_sig = CREATE_SYMBOL(method_sig_char);
+  Symbol* method_name = read_symbol();
+  LOGPARSER_ILLEGAL_STRING_CHECK(method_name, NULL);
+  Symbol* method_sig = read_symbol();
+  LOGPARSER_ILLEGAL_STRING_CHECK(method_sig, NULL);
   u4 first_invoke_init_order = read_u4();
   // INVALID_FIRST_INVOKE_INIT_ORDER means no first_invoke_init_order record in log file,
   // so put this method at last entry of class init chain
@@ -1726,27 +2628,24 @@ PreloadMethodHolder* JitWarmUpLogParser::next() {
   }
 
   // class info
-  char* class_name_char = read_string();
-  LOGPARSER_ILLEGAL_STRING_CHECK(class_name_char, NULL);
-  Symbol* class_name = CREATE_SYMBOL(class_name_char);
+  Symbol* class_name = read_symbol();
+  LOGPARSER_ILLEGAL_STRING_CHECK(class_name, NULL);
   // ignore
   if (should_ignore_this_class(class_name)) {
     _position = end_pos;
     return NULL;
   }
-  char* class_loader_char = read_string();
-  LOGPARSER_ILLEGAL_STRING_CHECK(class_loader_char, NULL);
-  Symbol* class_loader = CREATE_SYMBOL(class_loader_char);
+  Symbol* class_loader = read_symbol();
+  LOGPARSER_ILLEGAL_STRING_CHECK(class_loader, NULL);
   class_loader = PreloadJitInfo::remove_meaningless_suffix(class_loader);
-  char* path_char = read_string();
-  LOGPARSER_ILLEGAL_STRING_CHECK(path_char, NULL);
-  Symbol* path = CREATE_SYMBOL(path_char);
+  Symbol* path = read_symbol();
+  LOGPARSER_ILLEGAL_STRING_CHECK(path, NULL);
 
   PreloadClassDictionary* dict = this->info_holder()->dict();
   unsigned int dict_hash = class_name->identity_hash();
   PreloadClassEntry* entry = dict->find_head_entry(dict_hash, class_name);
   if (entry == NULL) {
-    log_warning(warmup)("[JitWarmUp] WARNING : class %s is missed in init section", class_name_char);
+    log_warning(warmup)("[JitWarmUp] WARNING : class %s is missed in init section", class_name->as_C_string());
     _position = end_pos;
     return NULL;
   }
@@ -1759,6 +2658,16 @@ PreloadMethodHolder* JitWarmUpLogParser::next() {
   u4 intp_throwout_count = read_u4();
   u4 invocation_count = read_u4();
   u4 backedge_count = read_u4();
+  u4 instances = read_u4();
+  if (_position > end_pos) {
+    log_error(warmup)("[JitWarmUp] ERROR : read out of bound, file format error");
+    return NULL;
+  }
+  GrowableArray<MDRecordInfo*>* md_list = parse_method_data(end_pos);
+  if (md_list == NULL) {
+    _position = end_pos;
+    return NULL;
+  }
 
   int class_chain_offset = entry->chain_offset();
   PreloadClassHolder* holder = entry->find_holder_in_entry(class_size, class_crc32);
@@ -1772,9 +2681,29 @@ PreloadMethodHolder* JitWarmUpLogParser::next() {
   mh->set_invocation_count(invocation_count);
   mh->set_backage_count(backedge_count);
   mh->set_bci((int)bci);
+  mh->set_order(comp_order);
+  mh->set_comp_level((int)comp_level);
 
   mh->set_hash(method_hash);
   mh->set_size(method_size);
+  mh->set_instances(MAX2(instances, (u4)1));
+  mh->add_md_records(md_list);
+  delete md_list;
+
+  if (info_holder()->merging()) {
+    GrowableArray<PreloadMethodHolder*>* methods = holder->method_list();
+    for (int i = 0; i < methods->length(); i++) {
+      PreloadMethodHolder* known = methods->at(i);
+      if (known->bci() == mh->bci() &&
+          known->name()->fast_compare(mh->name()) == 0 &&
+          known->signature()->fast_compare(mh->signature()) == 0) {
+        // recorded by a previous instance
+        known->merge(mh);
+        delete mh;
+        return NULL;
+      }
+    }
+  }
 
   // add class init chain relation
   /*
@@ -1792,8 +2721,7 @@ PreloadMethodHolder* JitWarmUpLogParser::next() {
 #undef MAX_COUNT_VALUE
 #undef LOGPARSER_ILLEGAL_STRING_CHECK
 #undef LOGPARSER_ILLEGAL_COUNT_CHECK
-
-#undef CREATE_SYMBOL
+#undef LOGPARSER_ILLEGAL_SECTION_CHECK
 
 #define INIT_PRECLASS_INIT_SIZE 4*1024*1024
 #define PRELOAD_CLASS_HS_SIZE   10240
@@ -1804,7 +2732,8 @@ PreloadJitInfo::PreloadJitInfo()
     _loaded_count(0),
     _state(NOT_INIT),
     _holder(NULL),
-    _jvm_booted_is_done(false) {
+    _jvm_booted_is_done(false),
+    _merging(false) {
 }
 
 PreloadJitInfo::~PreloadJitInfo() {
@@ -1887,6 +2816,65 @@ void PreloadClassChain::eager_load_class_in_constantpool() {
   } // end of while
 }
 
+void PreloadClassChain::eager_resolve_cpcache_entries() {
+  Thread* THREAD = Thread::current();
+  int index = 0;
+  int klass_index = 0;
+  int resolved = 0;
+  while (true) {
+    InstanceKlass* current_k = NULL;
+    GrowableArray<u4>* entries = NULL;
+    HandleMark hm(THREAD);
+    Handle keep_alive;
+    {
+      MutexLockerEx mu(PreloadClassChain_lock);
+      if (index == length()) {
+        break;
+      }
+      PreloadClassChain::PreloadClassChainEntry* e = this->at(index);
+      GrowableArray<InstanceKlass*>* array = e->resolved_klasses();
+      if (e->is_skipped() || e->is_not_loaded() || e->resolved_entries() == NULL ||
+          klass_index >= array->length()) {
+        index++;
+        klass_index = 0;
+        continue;
+      }
+      current_k = array->at(klass_index);
+      entries = e->resolved_entries();
+      // the entries are only valid for the very class file they were recorded for
+      if (current_k != NULL && ((u4)current_k->bytes_size() != e->klass_size() ||
+                                (u4)current_k->crc32() != e->klass_crc32())) {
+        current_k = NULL;
+      }
+      if (current_k != NULL) {
+        keep_alive = Handle(THREAD, current_k->klass_holder());
+      }
+    } // end of Mutex guard
+    klass_index++;
+
+    if (current_k == NULL || current_k->constants()->cache() == NULL) {
+      continue;
+    }
+    constantPoolHandle pool(THREAD, current_k->constants());
+    for (int i = 0; i < entries->length(); i++) {
+      u4 value = entries->at(i);
+      int cache_index = (int)(value & 0xFFFF);
+      Bytecodes::Code code = (Bytecodes::Code)(value >> 16);
+      if (cache_index >= pool->cache()->length()) {
+        continue;
+      }
+      InterpreterRuntime::resolve_cache_entry_eagerly(pool, cache_index, code, THREAD);
+      if (HAS_PENDING_EXCEPTION) {
+        // left for the first execution to resolve and report
+        CLEAR_PENDING_EXCEPTION;
+        continue;
+      }
+      resolved++;
+    }
+  } // end of while
+  log_info(warmup)("JitWarmUp [INFO]: %d constant pool cache entries resolved eagerly", resolved);
+}
+
 void PreloadJitInfo::notify_application_startup_is_done() {
   PreloadClassChain *chain = this->chain();
   assert(chain != NULL, "PreloadClassChain is NULL");
@@ -1896,6 +2884,11 @@ void PreloadJitInfo::notify_application_startup_is_done() {
   log_info(warmup)("JitWarmUp [INFO]: start eager loading classes from constant pool");
   chain->eager_load_class_in_constantpool();
 
+  if (CompilationWarmUpResolveCPCacheEagerly) {
+    log_info(warmup)("JitWarmUp [INFO]: start eager resolution of constant pool cache entries");
+    chain->eager_resolve_cpcache_entries();
+  }
+
   // 2nd, warmup compilation
   log_info(warmup)("JitWarmUp [INFO]: start warmup compilation");
   chain->warmup_impl();
@@ -1910,7 +2903,7 @@ void PreloadJitInfo::notify_application_startup_is_done() {
   Method *dm = jwp->dummy_method();
   guarantee(dm->code() == NULL, "dummy method has been compiled unexceptedly!");
   methodHandle mh(THREAD, dm);
-  JitWarmUp::commit_compilation(mh, InvocationEntryBci, THREAD);
+  JitWarmUp::commit_compilation(mh, InvocationEntryBci, CompLevel_full_optimization, THREAD);
   if (!chain->state_trans_to(PreloadClassChain::WARMUP_DONE)) {
     // warmup has been marked as WARMUP_DONE, but compilation requests are still on
     // going. warmup is really done when dummy method is compiled, check the dummy
@@ -1965,21 +2958,6 @@ bool PreloadJitInfo::resolve_loaded_klass(InstanceKlass* k) {
   return true;
 }
 
-class RandomFileStreamGuard : StackObj {
-public:
-  RandomFileStreamGuard(randomAccessFileStream* fs)
-    : _fs(fs) {
-  }
-
-  ~RandomFileStreamGuard() { delete _fs; }
-
-  randomAccessFileStream* operator ->() const { return _fs; }
-  randomAccessFileStream* operator ()() const { return _fs; }
-
-private:
-  randomAccessFileStream*  _fs;
-};
-
 void PreloadJitInfo::init() {
   if (CompilationWarmUpRecording) {
     log_error(warmup)("[JitWarmUp] ERROR: you can not set both CompilationWarmUp and CompilationWarmUpRecording");
@@ -2001,28 +2979,51 @@ void PreloadJitInfo::init() {
     _state = IS_ERR;
     return;
   }
+  if (CompilationWarmUpMergeLogfiles != NULL) {
+    merge_logfiles(CompilationWarmUpMergeLogfiles);
+  } else {
+    parse_logfile(CompilationWarmUpLogfile);
+  }
+}
 
-  RandomFileStreamGuard fsg(new (ResourceObj::C_HEAP, mtInternal) randomAccessFileStream(
-                                 CompilationWarmUpLogfile, "rb+"));
-  JitWarmUpLogParser parser(fsg(), this);
-  if (!fsg->is_open()) {
-    log_error(warmup)("[JitWarmUp] ERROR : log file %s doesn't exist", CompilationWarmUpLogfile);
-    _state = IS_ERR;
-    return;
+static char* map_logfile(const char* path, long* file_size) {
+  int fd = os::open(path, O_RDONLY, 0);
+  if (fd < 0) {
+    log_error(warmup)("[JitWarmUp] ERROR : log file %s doesn't exist", path);
+    return NULL;
+  }
+  *file_size = (long)os::lseek(fd, 0, SEEK_END);
+  char* base = NULL;
+  if (*file_size > 0) {
+    base = os::map_memory(fd, path, 0, NULL, (size_t)*file_size,
+                          true /* read_only */, false /* allow_exec */);
+  }
+  ::close(fd);
+  if (base == NULL) {
+    log_error(warmup)("[JitWarmUp] ERROR : can not map log file %s", path);
   }
-  parser.set_file_size(fsg->fileSize());
-  // parse header section
-  if (!parser.parse_header()) {
-    // not valid log file format
+  return base;
+}
+
+void PreloadJitInfo::parse_logfile(const char* path) {
+  long file_size = 0;
+  char* base = map_logfile(path, &file_size);
+  if (base == NULL) {
     _state = IS_ERR;
     return;
   }
-  // parse class init section
-  if (!parser.parse_class_init_section()) {
+  JitWarmUpLogParser parser(base, file_size, this);
+  // parse header, symbol, class init and method index sections
+  if (!parser.parse_header() ||
+      !parser.parse_symbol_section() ||
+      !parser.parse_class_init_section() ||
+      !parser.parse_method_index_section()) {
     // invalid log file format
+    os::unmap_memory(base, (size_t)file_size);
     _state = IS_ERR;
     return;
   }
+  parser.intern_symbols();
   while (parser.has_next()) {
     PreloadMethodHolder* holder = parser.next();
     if (holder != NULL) {
@@ -2031,4 +3032,98 @@ void PreloadJitInfo::init() {
     }
     parser.inc_parsed_number();
   }
+  os::unmap_memory(base, (size_t)file_size);
+}
+
+// Merges the logs recorded by several instances into one dictionary and
+// chain, which are used for warmup and written to CompilationWarmUpLogfile.
+// The class init sections of all logs are parsed before the method records,
+// so that the dictionary does not change once records are attached to it.
+void PreloadJitInfo::merge_logfiles(const char* paths) {
+  _merging = true;
+  GrowableArray<char*>* names = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<char*>(8, true, mtInternal);
+  GrowableArray<char*>* bases = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<char*>(8, true, mtInternal);
+  GrowableArray<long>* sizes = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<long>(8, true, mtInternal);
+  GrowableArray<JitWarmUpLogParser*>* parsers =
+    new (ResourceObj::C_HEAP, mtInternal) GrowableArray<JitWarmUpLogParser*>(8, true, mtInternal);
+  char* copy = os::strdup(paths, mtInternal);
+  for (char* name = copy; name != NULL; ) {
+    char* comma = ::strchr(name, ',');
+    if (comma != NULL) {
+      *comma = '\0';
+    }
+    if (*name != '\0') {
+      names->append(name);
+    }
+    name = comma != NULL ? comma + 1 : NULL;
+  }
+
+  u4 capacity = 0;
+  for (int i = 0; i < names->length() && _state == IS_OK; i++) {
+    long file_size = 0;
+    char* base = map_logfile(names->at(i), &file_size);
+    if (base == NULL) {
+      _state = IS_ERR;
+      break;
+    }
+    JitWarmUpLogParser* parser = new JitWarmUpLogParser(base, file_size, this);
+    bases->append(base);
+    sizes->append(file_size);
+    parsers->append(parser);
+    if (!parser->parse_header() || !parser->parse_symbol_section()) {
+      log_error(warmup)("[JitWarmUp] ERROR : can not merge log file %s", names->at(i));
+      _state = IS_ERR;
+      break;
+    }
+    capacity += parser->class_count();
+  }
+  if (_state == IS_OK) {
+    _chain = new PreloadClassChain(MAX2(capacity, (u4)1));
+    _chain->set_holder(this);
+    _chain->set_length(0);
+    for (int i = 0; i < parsers->length(); i++) {
+      if (!parsers->at(i)->parse_class_init_section() ||
+          !parsers->at(i)->parse_method_index_section()) {
+        log_error(warmup)("[JitWarmUp] ERROR : can not merge log file %s", names->at(i));
+        _state = IS_ERR;
+        break;
+      }
+    }
+  }
+  if (_state == IS_OK) {
+    for (int i = 0; i < parsers->length(); i++) {
+      JitWarmUpLogParser* parser = parsers->at(i);
+      parser->intern_symbols();
+      while (parser->has_next()) {
+        if (parser->next() != NULL) {
+          ++_loaded_count;
+        }
+        parser->inc_parsed_number();
+      }
+    }
+  }
+
+  int merged = parsers->length();
+  for (int i = 0; i < parsers->length(); i++) {
+    delete parsers->at(i);
+    os::unmap_memory(bases->at(i), (size_t)sizes->at(i));
+  }
+  delete parsers;
+  delete sizes;
+  delete bases;
+  delete names;
+  os::free(copy);
+  if (_state != IS_OK) {
+    return;
+  }
+
+  ProfileRecorder writer;
+  writer.set_holder(holder());
+  if (!writer.write_merged(this, CompilationWarmUpLogfile)) {
+    _state = IS_ERR;
+    return;
+  }
+  log_info(warmup)("[JitWarmUp] merged %d log files into %s, " UINT64_FORMAT " methods",
+                   merged, CompilationWarmUpLogfile, _loaded_count);
 }
+
@@ -38,11 +38,15 @@
 #include "utilities/hashtable.hpp"
 #include "utilities/linkedlist.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
 #include "utilities/symbolMatcher.hpp"
 
 // forward
 class ProfileRecorder;
 class PreloadJitInfo;
+class PreloadClassChain;
+class PreloadClassHolder;
+class PreloadMethodHolder;
 
 #define INVALID_FIRST_INVOKE_INIT_ORDER -1
 
@@ -83,7 +87,7 @@ public:
   JitWarmUpState flush_logfile();
 
   // commit a compilation task
-  static bool commit_compilation(methodHandle m, int bci, TRAPS);
+  static bool commit_compilation(methodHandle m, int bci, int comp_level, TRAPS);
 
   // get loader name through ClassLoaderData, if ClassLoader is
   // bootstrap classloader, return "NULL"
@@ -115,6 +119,7 @@ public:
   void init() {
     _is_deopted = false;
     _bci = InvocationEntryBci;
+    _comp_level = CompLevel_none;
   }
 
   void set_bci(int bci) { _bci = bci; }
@@ -123,6 +128,10 @@ public:
   void set_order(int order) { _order = order; }
   int  order()              { return _order; }
 
+  // highest tier the method reached in the recording run
+  void set_comp_level(int level) { _comp_level = level; }
+  int  comp_level()              { return _comp_level; }
+
   ProfileRecorderEntry* next() {
     return (ProfileRecorderEntry*)HashtableEntry<Method*, mtInternal>::next();
   }
@@ -133,6 +142,7 @@ private:
                       // InvocationEntryBci means standard compilation
                       // other means OSR compilation
   int    _order;      // compilation order
+  int    _comp_level; // highest compilation level
 };
 
 // a hash table stores compiled method
@@ -145,7 +155,7 @@ public:
 
   // add method into dictionary
   // return entry that holds this method
-  ProfileRecorderEntry* add_method(unsigned int hash, Method* method, int bci);
+  ProfileRecorderEntry* add_method(unsigned int hash, Method* method, int bci, int comp_level);
   // find a method in the dictionary
   // if not found, return NULL
   ProfileRecorderEntry* find_entry(unsigned int hash, Method* method);
@@ -174,11 +184,14 @@ private:
   Symbol* _class_name;
   Symbol* _class_loader_name;
   Symbol* _path;
+  // classes are not unloaded while recording
+  InstanceKlass* _klass;
 public:
-  ClassSymbolEntry(Symbol* class_name, Symbol* class_loader_name, Symbol* path)
+  ClassSymbolEntry(Symbol* class_name, Symbol* class_loader_name, Symbol* path, InstanceKlass* klass)
     : _class_name(class_name),
       _class_loader_name(class_loader_name),
-      _path(path) {
+      _path(path),
+      _klass(klass) {
     if (_class_name != NULL) _class_name->increment_refcount();
     if (_class_loader_name != NULL) _class_loader_name->increment_refcount();
     if (_path != NULL) _path->increment_refcount();
@@ -187,7 +200,8 @@ public:
   ClassSymbolEntry()
     : _class_name(NULL),
       _class_loader_name(NULL),
-      _path(NULL) {
+      _path(NULL),
+      _klass(NULL) {
   }
 
   ~ClassSymbolEntry() {
@@ -199,6 +213,7 @@ public:
   Symbol* class_name() const { return _class_name; }
   Symbol* class_loader_name() const { return _class_loader_name; }
   Symbol* path() const { return _path; }
+  InstanceKlass* klass() const { return _klass; }
 
   // Necessary for LinkedList
   bool equals(const ClassSymbolEntry& rhs) const {
@@ -206,6 +221,11 @@ public:
   }
 };
 
+// Strings are written once into the symbol section of the log file and
+// referred to by their index, see ProfileRecorder::symbol_index()
+typedef ResourceHashtable<Symbol*, u4, primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          4096, ResourceObj::C_HEAP, mtInternal> SymbolIndexTable;
+
 // Profiling data collection
 // record compiled method in a hash table(class ProfileRecorder)
 // record java class initialization order in a linkedlist(class LinkedListImpl<Entry>)
@@ -233,13 +253,17 @@ public:
   int class_init_count()                   { return _class_init_order_count + 1; }
 
   // add a method into recorder
-  void add_method(Method* method, int bci);
+  void add_method(Method* method, int bci, int comp_level);
   // remove a method from recorder
   void remove_method(Method* method);
 
   // flush collected information into log file
   void flush();
 
+  // write the profile merged from several log files into path, in the
+  // format of flush(); uses no other state of this recorder
+  bool write_merged(PreloadJitInfo* info, const char* path);
+
   // increment class initialize count
   // class recorded and increase order number, returns the increased number.
   // this function is thread safe
@@ -282,14 +306,30 @@ private:
   const char*                                  _logfile_name;
   // record max symbol length in log file
   int                                          _max_symbol_length;
+  // symbols in the order they are written into the symbol section
+  GrowableArray<Symbol*>*                      _symbols;
+  SymbolIndexTable*                            _symbol_index;
 
 private:
+  bool open_logfile(const char* path);
+  void close_logfile();
+
   // flush section
-  void write_header();
+  void write_header(unsigned int record_count);
   void write_inited_class();
-  void write_record(Method* method, int bci, int order);
+  void write_resolved_entries(InstanceKlass* klass);
+  void write_method_index(u4* offsets, int count, unsigned int index_pos);
+  void write_record(Method* method, int bci, int order, int comp_level);
+  void write_method_data(Method* method);
   void write_footer();
 
+  // merged profile sections
+  void write_merged_classes(PreloadClassChain* chain);
+  void write_merged_record(PreloadClassHolder* klass, PreloadMethodHolder* mh);
+
+  // index of s in the symbol section, null_index if s is NULL
+  u4 symbol_index(Symbol* s, u4 null_index);
+
   void write_u1(u1 value);
   void write_u4(u4 value);
   void write_u8(u8 value);
@@ -310,12 +350,41 @@ class ProfileRecorder;
 class PreloadClassHolder;
 
 // a MDRecordInfo corresponds a ProfileData per bci (see oops/methodData.hpp)
-// NYI about details
+// only the flags, branch/call counts and receiver rows are recorded
 class MDRecordInfo : public CHeapObj<mtInternal> {
 public:
-  // empty class
-  MDRecordInfo() {  }
+  enum { MaxReceiverRows = 8 };
+
+  MDRecordInfo(int bci, u1 tag, u1 flags, u4 count, u4 not_taken)
+    : _bci(bci), _tag(tag), _flags(flags), _count(count),
+      _not_taken(not_taken), _receiver_rows(0) { }
   ~MDRecordInfo() {  }
+
+  int  bci()       const { return _bci; }
+  u1   tag()       const { return _tag; }
+  u1   flags()     const { return _flags; }
+  u4   count()     const { return _count; }
+  u4   not_taken() const { return _not_taken; }
+
+  int     receiver_rows()           const { return _receiver_rows; }
+  Symbol* receiver_at(int row)      const { return _receivers[row]; }
+  u4      receiver_count_at(int row) const { return _receiver_counts[row]; }
+  void    add_receiver(Symbol* name, u4 count) {
+    assert(_receiver_rows < MaxReceiverRows, "oob");
+    _receivers[_receiver_rows] = name;
+    _receiver_counts[_receiver_rows] = count;
+    _receiver_rows++;
+  }
+
+private:
+  int     _bci;
+  u1      _tag;
+  u1      _flags;
+  u4      _count;
+  u4      _not_taken;
+  int     _receiver_rows;
+  Symbol* _receivers[MaxReceiverRows];
+  u4      _receiver_counts[MaxReceiverRows];
 };
 
 // a method holder corresponds a method and its profile information
@@ -339,6 +408,21 @@ public:
   void set_invocation_count(unsigned int value)      { _invocation_count = value; }
   void set_backage_count(unsigned int value)         { _backage_count = value; }
 
+  unsigned int order()           const { return _order; }
+  int          comp_level()      const { return _comp_level; }
+  void set_comp_level(int value)             { _comp_level = value; }
+  void set_order(unsigned int value)         { _order = value; }
+
+  // number of recording instances which compiled the method
+  unsigned int instances()       const { return _instances; }
+  void set_instances(unsigned int value)     { _instances = value; }
+
+  // fold the record of the same method from another instance into this
+  void merge(PreloadMethodHolder* other);
+
+  // recorded invocation and backedge counts, used to order warmup compilations
+  unsigned int hotness() const;
+
   unsigned int hash()            const { return _hash; }
   unsigned int size()            const { return _size; }
   int          bci()             const { return _bci; }
@@ -366,6 +450,13 @@ public:
 
   PreloadMethodHolder* clone_and_add();
 
+  // take over the profile records parsed for this method
+  void add_md_records(GrowableArray<MDRecordInfo*>* records);
+  // fill the MethodData of the resolved method with the recorded profile
+  void restore_method_data(methodHandle m, TRAPS);
+  // distance in percent between the live profile of m and the recorded one
+  int profile_drift(Method* m) const;
+
   // whether the resolved method is alive
   bool is_alive(BoolObjectClosure* is_alive_closure) const;
 
@@ -377,6 +468,11 @@ private:
   unsigned int _size;
   unsigned int _hash;
   int          _bci;
+  // compilation order in the recording run
+  unsigned int _order;
+  // highest compilation level in the recording run, CompLevel_none if unknown
+  int          _comp_level;
+  unsigned int _instances;
 
   unsigned int _intp_invocation_count;
   unsigned int _intp_throwout_count;
@@ -642,7 +738,10 @@ public:
         _state(_not_loaded),
         _method_holder(NULL),
         _resolved_klasses(new (ResourceObj::C_HEAP, mtClass)
-                          GrowableArray<InstanceKlass*>(1, true, mtClass)) {  }
+                          GrowableArray<InstanceKlass*>(1, true, mtClass)),
+        _klass_size(0),
+        _klass_crc32(0),
+        _resolved_entries(NULL) {  }
 
     PreloadClassChainEntry(Symbol* class_name, Symbol* loader_name, Symbol* path)
       : _class_name(class_name),
@@ -651,7 +750,10 @@ public:
         _state(_not_loaded),
         _method_holder(NULL),
         _resolved_klasses(new (ResourceObj::C_HEAP, mtClass)
-                          GrowableArray<InstanceKlass*>(1, true, mtClass)) {  }
+                          GrowableArray<InstanceKlass*>(1, true, mtClass)),
+        _klass_size(0),
+        _klass_crc32(0),
+        _resolved_entries(NULL) {  }
 
     virtual ~PreloadClassChainEntry() {  }
 
@@ -665,6 +767,17 @@ public:
     GrowableArray<InstanceKlass*>* resolved_klasses()
                    { return _resolved_klasses; }
 
+    // cpCache entries resolved in the recording run, (bytecode << 16 | cache index),
+    // valid for a loaded class of the same size and crc32
+    u4             klass_size()                  const { return _klass_size; }
+    u4             klass_crc32()                 const { return _klass_crc32; }
+    GrowableArray<u4>* resolved_entries()        const { return _resolved_entries; }
+    void set_resolved_entries(u4 size, u4 crc32, GrowableArray<u4>* entries) {
+      _klass_size = size;
+      _klass_crc32 = crc32;
+      _resolved_entries = entries;
+    }
+
     // entry state
     bool           is_not_loaded()        const { return _state == _not_loaded; }
     bool           is_skipped()           const { return _state == _is_skipped; }
@@ -698,6 +811,9 @@ public:
     int                                  _state;
     PreloadMethodHolder*                 _method_holder;
     GrowableArray<InstanceKlass*>*       _resolved_klasses;
+    u4                                   _klass_size;
+    u4                                   _klass_crc32;
+    GrowableArray<u4>*                   _resolved_entries;
   };
 
   PreloadClassChain(unsigned int size);
@@ -769,6 +885,10 @@ public:
 
   // a PreloadMethodHolder represents a java method
   bool compile_methodholder(PreloadMethodHolder* mh);
+  // compilation level used in replay for a recorded level
+  static int replay_level(int recorded_level);
+  // submit hottest methods first, pacing by compile queue depth and CPU usage
+  void compile_methodholders_throttled(Stack<PreloadMethodHolder*, mtInternal>& pending);
 
   // fix InstanceKlass* and Method* pointer during metaspace gc
   void do_unloading(BoolObjectClosure* is_alive);
@@ -779,7 +899,11 @@ public:
 
   bool should_deoptimize_methods();
 
-  // deoptimize CompilationWarmUpDeoptNumOfMethodsPerIter number methods per invocation
+  // number of methods one deoptimization iteration may deoptimize
+  int deopt_budget();
+
+  // deoptimize up to deopt_budget() methods per invocation, with
+  // CompilationWarmUpAdaptiveDeopt only those whose profile has drifted
   void deoptimize_methods();
 
   // invoke a VM_Deoptimize operation
@@ -788,6 +912,9 @@ public:
   // load class eagerly that occurs in JitWarmUp log file through constant-pool traversal
   void eager_load_class_in_constantpool();
 
+  // resolve the cpCache entries and invokedynamic call sites recorded in JitWarmUp log file
+  void eager_resolve_cpcache_entries();
+
   // for debug
   void print_not_loaded_before(int index);
   void print_method_mount_before(int index);
@@ -841,6 +968,9 @@ public:
   bool is_valid() { return _state == IS_OK; }
   void init();
 
+  // whether several logs are being merged, see CompilationWarmUpMergeLogfiles
+  bool merging() const { return _merging; }
+
   bool should_load_class_eagerly(Symbol* s);
 
   PreloadClassDictionary* dict() { return _dict; }
@@ -871,6 +1001,10 @@ private:
   PreloadInfoState         _state;
   JitWarmUp*               _holder;
   bool                     _jvm_booted_is_done;
+  bool                     _merging;
+
+  void parse_logfile(const char* path);
+  void merge_logfiles(const char* paths);
 };
 
 #endif //SHARED_VM_JWARMUP_JITWARMUP_HPP
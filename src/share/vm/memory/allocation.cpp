@@ -32,6 +32,7 @@
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.inline.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
@@ -236,6 +237,7 @@ class ChunkPool: public CHeapObj<mtInternal> {
   size_t       _num_chunks;   // number of unused chunks in pool
   size_t       _num_used;     // number of chunks currently checked out
   const size_t _size;         // size of each chunk (must be uniform)
+  const size_t _max_chunks;   // max number of unused chunks kept (0: unlimited)
 
   // Our four static pools
   static ChunkPool* _large_pool;
@@ -255,7 +257,9 @@ class ChunkPool: public CHeapObj<mtInternal> {
 
  public:
   // All chunks in a ChunkPool has the same size
-   ChunkPool(size_t size) : _size(size) { _first = NULL; _num_chunks = _num_used = 0; }
+   ChunkPool(size_t size) : _size(size), _max_chunks(ChunkPoolLimit == 0 ? 0 : MAX2(ChunkPoolLimit / size, (size_t)1)) {
+     _first = NULL; _num_chunks = _num_used = 0;
+   }
 
   // Allocate a new chunk from the pool (might expand the pool)
   _NOINLINE_ void* allocate(size_t bytes, AllocFailType alloc_failmode) {
@@ -274,16 +278,23 @@ class ChunkPool: public CHeapObj<mtInternal> {
     return p;
   }
 
-  // Return a chunk to the pool
+  // Return a chunk to the pool, or to the OS if the pool is full
   void free(Chunk* chunk) {
     assert(chunk->length() + Chunk::aligned_overhead_size() == _size, "bad size");
-    ThreadCritical tc;
-    _num_used--;
-
-    // Add chunk to list
-    chunk->set_next(_first);
-    _first = chunk;
-    _num_chunks++;
+    {
+      ThreadCritical tc;
+      _num_used--;
+
+      if (_max_chunks == 0 || _num_chunks < _max_chunks) {
+        // Add chunk to list
+        chunk->set_next(_first);
+        _first = chunk;
+        _num_chunks++;
+        return;
+      }
+    }
+    // Free outside of ThreadCritical to avoid deadlock with NMT
+    os::free(chunk, mtChunk);
   }
 
   // Prune the pool
@@ -532,6 +543,13 @@ void Arena::set_size_in_bytes(size_t size) {
     ssize_t delta = size - size_in_bytes();
     _size_in_bytes = size;
     MemTracker::record_arena_size_change(delta, _flags);
+    if (_flags == mtCompiler && ThreadLocalStorage::is_initialized()) {
+      // Per-compilation accounting of the compiler arenas
+      Thread* thread = ThreadLocalStorage::thread();
+      if (thread != NULL && thread->is_Compiler_thread()) {
+        ((CompilerThread*)thread)->arena_size_changed(delta);
+      }
+    }
   }
 }
 
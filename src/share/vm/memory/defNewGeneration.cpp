@@ -554,7 +554,8 @@ HeapWord* DefNewGeneration::expand_and_allocate(size_t size,
 void DefNewGeneration::adjust_desired_tenuring_threshold(GCTracer &tracer) {
   // Set the desired survivor size to half the real survivor space
   _tenuring_threshold =
-    age_table()->compute_tenuring_threshold(to()->capacity()/HeapWordSize, tracer);
+    age_table()->compute_tenuring_threshold(to()->capacity()/HeapWordSize, tracer,
+                                            UseAdaptiveTenuring && !AlwaysTenure && !NeverTenure);
 }
 
 void DefNewGeneration::collect(bool   full,
@@ -69,7 +69,6 @@ NOT_PRODUCT(size_t GenCollectedHeap::_skip_header_HeapWords = 0;)
 // The set of potentially parallel tasks in root scanning.
 enum GCH_strong_roots_tasks {
   GCH_PS_Universe_oops_do,
-  GCH_PS_JNIHandles_oops_do,
   GCH_PS_ObjectSynchronizer_oops_do,
   GCH_PS_FlatProfiler_oops_do,
   GCH_PS_Management_oops_do,
@@ -665,9 +664,7 @@ void GenCollectedHeap::process_roots(bool activate_scope,
   // Global (strong) JNI handles
   {
     GenGCParPhaseTimesTracker x(phase_times, GenGCPhaseTimes::JNIRoots, worker_id);
-    if (!_process_strong_tasks->is_task_claimed(GCH_PS_JNIHandles_oops_do)) {
-      JNIHandles::oops_do(strong_roots);
-    }
+    JNIHandles::possibly_parallel_oops_do(strong_roots);
   }
 
   // ObjectSynchronizerRoots
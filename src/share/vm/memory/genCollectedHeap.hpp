@@ -216,6 +216,9 @@ public:
   void safe_object_iterate(ObjectClosure* cl);
   Space* space_containing(const void* addr) const;
 
+  // The ParNew workers, if any, are idle at non-GC safepoints.
+  virtual FlexibleWorkGang* safepoint_workers() { return workers(); }
+
   // A CollectedHeap is divided into a dense sequence of "blocks"; that is,
   // each address in the (reserved) heap is a member of exactly
   // one block.  The defining characteristic of a block is that it is
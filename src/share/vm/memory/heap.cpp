@@ -43,6 +43,8 @@ CodeHeap::CodeHeap() {
   _next_segment                 = 0;
   _freelist                     = NULL;
   _freelist_segments            = 0;
+  _name                         = "CodeCache";
+  _code_blob_type               = 0;
 }
 
 
@@ -84,23 +86,47 @@ void CodeHeap::on_code_mapping(char* base, size_t size) {
   extern void linux_wrap_code(char* base, size_t size);
   linux_wrap_code(base, size);
 #endif
+  if (uses_large_code_pages()) {
+    // The advice does not survive a fresh commit, so every newly
+    // committed range asks for large pages again.
+    os::realign_memory(base, size, page_size_for(size));
+  }
+}
+
+
+bool CodeHeap::uses_large_code_pages() {
+  return UseLargeCodePages && !os::can_execute_large_page_memory();
+}
+
+
+// With UseLargeCodePages only the code cache is backed by large pages: it
+// is aligned to the large page size and the OS is advised to back it with
+// transparent huge pages, while the rest of the VM keeps small pages.
+size_t CodeHeap::page_size_for(size_t reserved_size) {
+  if (os::can_execute_large_page_memory()) {
+    return os::page_size_for_region_unaligned(reserved_size, 8);
+  }
+  if (UseLargeCodePages) {
+    return LargePageSizeInBytes > (uintx)os::vm_page_size() ? LargePageSizeInBytes : 2 * M;
+  }
+  return os::vm_page_size();
+}
+
+
+size_t CodeHeap::align_to_code_page_size(size_t size, size_t limit) {
+  if (!uses_large_code_pages()) {
+    return size;
+  }
+  return MIN2((size_t)align_size_up(size, page_size_for(limit)), limit);
 }
 
 
 bool CodeHeap::reserve(size_t reserved_size, size_t committed_size,
                        size_t segment_size) {
   assert(reserved_size >= committed_size, "reserved < committed");
-  assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
-  assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
-
-  _segment_size      = segment_size;
-  _log2_segment_size = exact_log2(segment_size);
 
   // Reserve and initialize space for _memory.
-  size_t page_size = os::vm_page_size();
-  if (os::can_execute_large_page_memory()) {
-    page_size = os::page_size_for_region_unaligned(reserved_size, 8);
-  }
+  const size_t page_size = page_size_for(reserved_size);
 
   const size_t granularity = os::vm_allocation_granularity();
   const size_t r_align = MAX2(page_size, granularity);
@@ -109,10 +135,26 @@ bool CodeHeap::reserve(size_t reserved_size, size_t committed_size,
 
   const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 :
     MAX2(page_size, granularity);
-  ReservedCodeSpace rs(r_size, rs_align, rs_align > 0);
+  ReservedCodeSpace rs(r_size, rs_align, rs_align > 0 && !uses_large_code_pages());
   os::trace_page_sizes("code heap", committed_size, reserved_size, page_size,
                        rs.base(), rs.size());
-  if (!_memory.initialize(rs, c_size)) {
+  return reserve(rs, c_size, segment_size);
+}
+
+
+// Initializes the heap on an already reserved space; used for the
+// segments of the code cache, which all live in one reservation.
+bool CodeHeap::reserve(ReservedSpace rs, size_t committed_size,
+                       size_t segment_size) {
+  assert(rs.size() >= committed_size, "reserved < committed");
+  assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
+  assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
+
+  _segment_size      = segment_size;
+  _log2_segment_size = exact_log2(segment_size);
+
+  const size_t granularity = os::vm_allocation_granularity();
+  if (!_memory.initialize(rs, align_to_code_page_size(align_to_page_size(committed_size), rs.size()))) {
     return false;
   }
 
@@ -148,7 +190,8 @@ void CodeHeap::release() {
 
 bool CodeHeap::expand_by(size_t size) {
   // expand _memory space
-  size_t dm = align_to_page_size(_memory.committed_size() + size) - _memory.committed_size();
+  size_t dm = align_to_code_page_size(align_to_page_size(_memory.committed_size() + size),
+                                      _memory.reserved_size()) - _memory.committed_size();
   if (dm > 0) {
     char* base = _memory.low() + _memory.committed_size();
     if (!_memory.expand_by(dm)) return false;
@@ -93,6 +93,9 @@ class CodeHeap : public CHeapObj<mtCode> {
   FreeBlock*   _freelist;
   size_t       _freelist_segments;               // No. of segments in freelist
 
+  const char*  _name;                            // for printing and the memory pool
+  int          _code_blob_type;                  // CodeBlobType of the blobs it holds
+
   // Helper functions
   size_t   size_to_segments(size_t size) const { return (size + _segment_size - 1) >> _log2_segment_size; }
   size_t   segments_to_size(size_t number_of_segments) const { return number_of_segments << _log2_segment_size; }
@@ -121,11 +124,17 @@ class CodeHeap : public CHeapObj<mtCode> {
   // to perform additional actions on creation of executable code
   void on_code_mapping(char* base, size_t size);
 
+  // Rounds a commit size up to whole large pages with UseLargeCodePages
+  static size_t align_to_code_page_size(size_t size, size_t limit);
+
  public:
   CodeHeap();
 
   // Heap extents
   bool  reserve(size_t reserved_size, size_t committed_size, size_t segment_size);
+  bool  reserve(ReservedSpace rs, size_t committed_size, size_t segment_size);
+  static size_t page_size_for(size_t reserved_size);  // page size backing a code heap of that size
+  static bool   uses_large_code_pages();         // UseLargeCodePages without large pages for all memory
   void  release();                               // releases all allocated memory
   bool  expand_by(size_t size);                  // expands commited memory by size
   void  shrink_by(size_t size);                  // shrinks commited memory by size
@@ -136,6 +145,10 @@ class CodeHeap : public CHeapObj<mtCode> {
   void  deallocate(void* p);                     // deallocates a block
 
   // Attributes
+  const char* name() const                       { return _name; }
+  void set_name(const char* name)                { _name = name; }
+  int  code_blob_type() const                    { return _code_blob_type; }
+  void set_code_blob_type(int t)                 { _code_blob_type = t; }
   char* low_boundary() const                     { return _memory.low_boundary (); }
   char* high() const                             { return _memory.high(); }
   char* high_boundary() const                    { return _memory.high_boundary(); }
@@ -24,12 +24,22 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderData.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
 #include "gc_interface/collectedHeap.hpp"
 #include "memory/genCollectedHeap.hpp"
 #include "memory/generation.hpp"
 #include "memory/heapInspection.hpp"
+#include "memory/iterator.hpp"
 #include "memory/resourceArea.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/jniHandles.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
+#include "runtime/thread.hpp"
+#include "services/management.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_ALL_GCS
@@ -62,6 +72,15 @@ int KlassInfoEntry::compare(KlassInfoEntry* e1, KlassInfoEntry* e2) {
   }
 }
 
+int KlassInfoEntry::compare_retained(KlassInfoEntry* e1, KlassInfoEntry* e2) {
+  if (e1->_retained_words > e2->_retained_words) {
+    return -1;
+  } else if (e1->_retained_words < e2->_retained_words) {
+    return 1;
+  }
+  return compare(e1, e2);
+}
+
 const char* KlassInfoEntry::name() const {
   const char* name;
   if (_klass->name() != NULL) {
@@ -80,14 +99,22 @@ const char* KlassInfoEntry::name() const {
   return name;
 }
 
-void KlassInfoEntry::print_on(outputStream* st) const {
+void KlassInfoEntry::print_on(outputStream* st, bool print_retained) const {
   ResourceMark rm;
 
   // simplify the formatting (ILP32 vs LP64) - always cast the numbers to 64-bit
-  st->print_cr(INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13) "  %s",
-               (jlong)  _instance_count,
-               (julong) _instance_words * HeapWordSize,
-               name());
+  if (print_retained) {
+    st->print_cr(INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13) "  %s",
+                 (jlong)  _instance_count,
+                 (julong) _instance_words * HeapWordSize,
+                 (julong) _retained_words * HeapWordSize,
+                 name());
+  } else {
+    st->print_cr(INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13) "  %s",
+                 (jlong)  _instance_count,
+                 (julong) _instance_words * HeapWordSize,
+                 name());
+  }
 }
 
 KlassInfoEntry* KlassInfoBucket::lookup(Klass* const k) {
@@ -201,13 +228,56 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass* k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  // elt may be NULL if it's a new klass for which we
+  // could not allocate space for a new entry in the hashtable.
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    elt->set_retained_words(elt->retained_words() + cie->retained_words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  size_t _missed_count;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* table) : _dest(table), _missed_count(0) {}
+
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (!_dest->merge_entry(cie)) {
+      _missed_count += cie->count();
+    }
+  }
+
+  size_t missed_count() const { return _missed_count; }
+};
+
+size_t KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.missed_count();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
 
-KlassInfoHisto::KlassInfoHisto(KlassInfoTable* cit, const char* title) :
+int KlassInfoHisto::sort_retained_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
+  return (*e1)->compare_retained(*e1, *e2);
+}
+
+KlassInfoHisto::KlassInfoHisto(KlassInfoTable* cit, const char* title,
+                               bool print_retained) :
   _cit(cit),
-  _title(title) {
+  _title(title),
+  _print_retained(print_retained) {
   _elements = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<KlassInfoEntry*>(_histo_initial_size, true);
 }
 
@@ -220,7 +290,11 @@ void KlassInfoHisto::add(KlassInfoEntry* cie) {
 }
 
 void KlassInfoHisto::sort() {
-  elements()->sort(KlassInfoHisto::sort_helper);
+  if (_print_retained) {
+    elements()->sort(KlassInfoHisto::sort_retained_helper);
+  } else {
+    elements()->sort(KlassInfoHisto::sort_helper);
+  }
 }
 
 void KlassInfoHisto::print_elements(outputStream* st) const {
@@ -229,10 +303,11 @@ void KlassInfoHisto::print_elements(outputStream* st) const {
   julong totalw = 0;
   for(int i=0; i < elements()->length(); i++) {
     st->print("%4d: ", i+1);
-    elements()->at(i)->print_on(st);
+    elements()->at(i)->print_on(st, _print_retained);
     total += elements()->at(i)->count();
     totalw += elements()->at(i)->words();
   }
+  // Retained sizes overlap between classes, so they have no total.
   st->print_cr("Total " INT64_FORMAT_W(13) "  " UINT64_FORMAT_W(13),
                total, totalw * HeapWordSize);
 }
@@ -484,9 +559,221 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
-size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
+void ParHeapInspectTask::work(uint worker_id) {
+  KlassInfoTable cit(false);
+  if (cit.allocation_failed()) {
+    // Still visit the objects claimed by this worker, but record them in
+    // the shared table directly.
+    MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+    RecordInstanceClosure ric(_shared_cit, _filter);
+    _poi->object_iterate(&ric, worker_id);
+    _missed_count += ric.missed_count();
+    return;
+  }
+
+  RecordInstanceClosure ric(&cit, _filter);
+  _poi->object_iterate(&ric, worker_id);
+
+  MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+  _missed_count += ric.missed_count() + _shared_cit->merge(&cit);
+}
+
+class RetainedRootsClosure : public OopClosure {
+ private:
+  GrowableArray<oop>* _roots;
+
+  template <class T> void do_oop_work(T* p) {
+    oop obj = oopDesc::load_decode_heap_oop(p);
+    if (obj != NULL && Universe::heap()->is_in_reserved(obj)) {
+      _roots->append(obj);
+    }
+  }
+
+ public:
+  RetainedRootsClosure(GrowableArray<oop>* roots) : _roots(roots) {}
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+
+  void collect() {
+    CLDToOopClosure cld_closure(this);
+    ClassLoaderDataGraph::always_strong_cld_do(&cld_closure);
+    CodeBlobToOopClosure blobs(this, false);
+    Threads::oops_do(this, NULL, &blobs);
+    ObjectSynchronizer::oops_do(this);
+    Universe::oops_do(this);
+    JNIHandles::oops_do(this);
+    JvmtiExport::oops_do(this);
+    SystemDictionary::oops_do(this);
+    Management::oops_do(this);
+    StringTable::oops_do(this);
+  }
+};
+
+// Queues the unmarked referents of an object for a visit.
+class RetainedChildrenClosure : public ExtendedOopClosure {
+ private:
+  RetainedSizeTask* _task;
+  GrowableArray<RetainedSizeTask::Pending>* _pending;
+  int _parent;
+
+  template <class T> void do_oop_work(T* p) {
+    oop obj = oopDesc::load_decode_heap_oop(p);
+    if (obj != NULL && !_task->is_marked(obj)) {
+      _pending->push(RetainedSizeTask::Pending(obj, _parent));
+    }
+  }
+
+ public:
+  RetainedChildrenClosure(RetainedSizeTask* task,
+                          GrowableArray<RetainedSizeTask::Pending>* pending,
+                          int parent) :
+    _task(task), _pending(pending), _parent(parent) {}
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+RetainedSizeTask::RetainedSizeTask(GrowableArray<oop>* roots,
+                                   KlassInfoTable* shared_cit,
+                                   jlong timeout_ms) :
+    AbstractGangTask("Estimating retained sizes"),
+    _roots(roots),
+    _next_root(0),
+    _bottom((HeapWord*)Universe::heap()->reserved_region().start()),
+    _mark_bits(Universe::heap()->reserved_region().word_size() >> LogMinObjAlignment,
+               false /* in_resource_area */),
+    _shared_cit(shared_cit),
+    _deadline(os::javaTimeNanos() + timeout_ms * NANOSECS_PER_MILLISEC),
+    _timed_out(0),
+    _missed_count(0),
+    _mutex(Mutex::leaf, "Retained size estimate merge lock", true) { }
+
+RetainedSizeTask::~RetainedSizeTask() {
+  _mark_bits.resize(0, false /* in_resource_area */);
+}
+
+bool RetainedSizeTask::check_deadline() {
+  if (!timed_out() && os::javaTimeNanos() > _deadline) {
+    Atomic::store(1, &_timed_out);
+  }
+  return timed_out();
+}
+
+// Finishes the visit of the innermost frame, crediting its subtree to its
+// klass unless an enclosing instance of the same klass already covers it,
+// and to the frame it was reached from.
+void RetainedSizeTask::pop_frame(GrowableArray<Frame>* frames) {
+  Frame f = frames->pop();
+  if (f._entry != NULL) {
+    f._entry->set_nesting(f._entry->nesting() - 1);
+    if (f._entry->nesting() == 0) {
+      f._entry->set_retained_words(f._entry->retained_words() + f._words);
+    }
+  }
+  if (frames->is_nonempty()) {
+    frames->at(frames->length() - 1)._words += f._words;
+  }
+}
+
+// Marks and records everything first reached from "root", in depth-first
+// order so that the frames on the stack are always the path to the object
+// being visited. Returns the number of objects that could not be recorded.
+size_t RetainedSizeTask::mark_from(oop root, KlassInfoTable* cit,
+                                   GrowableArray<Pending>* pending,
+                                   GrowableArray<Frame>* frames) {
+  size_t missed = 0;
+  size_t visited = 0;
+  pending->push(Pending(root, -1));
+  while (pending->is_nonempty()) {
+    Pending p = pending->pop();
+    // Every frame above the parent has had all its children visited.
+    while (frames->length() > p._parent + 1) {
+      pop_frame(frames);
+    }
+    oop obj = p._obj;
+    if (!_mark_bits.par_set_bit(bit_for(obj))) {
+      continue;
+    }
+    if ((++visited % 1024) == 0 && check_deadline()) {
+      break;
+    }
+    KlassInfoEntry* entry = NULL;
+    if (cit->record_instance(obj)) {
+      entry = cit->lookup(obj->klass());
+      entry->set_nesting(entry->nesting() + 1);
+    } else {
+      missed++;
+    }
+    frames->push(Frame(entry, (size_t)obj->size()));
+    RetainedChildrenClosure children(this, pending, frames->length() - 1);
+    obj->oop_iterate(&children);
+  }
+  pending->clear();
+  while (frames->is_nonempty()) {
+    pop_frame(frames);
+  }
+  return missed;
+}
+
+void RetainedSizeTask::work(uint worker_id) {
+  KlassInfoTable local_cit(false);
+  bool use_local = !local_cit.allocation_failed();
+  KlassInfoTable* cit = use_local ? &local_cit : _shared_cit;
+  GrowableArray<Pending> pending(1024, true);
+  GrowableArray<Frame> frames(256, true);
+  size_t missed = 0;
+
+  while (!timed_out()) {
+    jint i = Atomic::add(1, &_next_root) - 1;
+    if (i >= _roots->length()) {
+      break;
+    }
+    if (use_local) {
+      missed += mark_from(_roots->at(i), cit, &pending, &frames);
+    } else {
+      // Out of C-heap for a table of its own, the worker records into the
+      // shared table under the lock.
+      MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+      missed += mark_from(_roots->at(i), cit, &pending, &frames);
+    }
+  }
+
+  MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+  _missed_count += missed;
+  if (use_local) {
+    _missed_count += _shared_cit->merge(&local_cit);
+  }
+}
+
+size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter,
+                                      uint parallel_thread_num) {
   ResourceMark rm;
 
+  if (parallel_thread_num > 1 && !(PrintYoungGenHistoAfterParNewGC && UseParNewGC)) {
+    FlexibleWorkGang* gang = Universe::heap()->safepoint_workers();
+    ParallelObjectIterator* poi = NULL;
+    if (gang != NULL) {
+      // Without UseDynamicNumberOfGCThreads the gang always runs all workers.
+      parallel_thread_num = UseDynamicNumberOfGCThreads ?
+        MIN2(parallel_thread_num, gang->total_workers()) : gang->total_workers();
+      poi = Universe::heap()->parallel_object_iterator(parallel_thread_num);
+    }
+    if (poi != NULL) {
+      uint saved_active_workers = gang->active_workers();
+      if (UseDynamicNumberOfGCThreads) {
+        gang->set_active_workers(parallel_thread_num);
+      }
+      ParHeapInspectTask task(poi, cit, filter);
+      gang->run_task(&task);
+      if (UseDynamicNumberOfGCThreads) {
+        gang->set_active_workers(saved_active_workers);
+      }
+      delete poi;
+      return task.missed_count();
+    }
+  }
+
   RecordInstanceClosure ric(cit, filter);
   if (PrintYoungGenHistoAfterParNewGC && UseParNewGC) {
     assert(GenCollectedHeap::heap()->n_gens() == 2, "When using ParNew GC, there are only two generations");
@@ -498,6 +785,34 @@ size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *fi
   }
 }
 
+bool HeapInspection::populate_retained_table(KlassInfoTable* cit, size_t* missed_count,
+                                             uint parallel_thread_num) {
+  ResourceMark rm;
+
+  GrowableArray<oop>* roots = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<oop>(1024, true);
+  RetainedRootsClosure roots_closure(roots);
+  roots_closure.collect();
+
+  RetainedSizeTask task(roots, cit, _retained_timeout);
+  FlexibleWorkGang* gang = Universe::heap()->safepoint_workers();
+  if (parallel_thread_num > 1 && gang != NULL) {
+    uint saved_active_workers = gang->active_workers();
+    if (UseDynamicNumberOfGCThreads) {
+      gang->set_active_workers(MIN2(parallel_thread_num, gang->total_workers()));
+    }
+    gang->run_task(&task);
+    if (UseDynamicNumberOfGCThreads) {
+      gang->set_active_workers(saved_active_workers);
+    }
+  } else {
+    task.work(0);
+  }
+  delete roots;
+
+  *missed_count = task.missed_count();
+  return !task.timed_out();
+}
+
 void HeapInspection::heap_inspection(outputStream* st) {
   ResourceMark rm;
 
@@ -521,7 +836,16 @@ void HeapInspection::heap_inspection(outputStream* st) {
 
   KlassInfoTable cit(_print_class_stats);
   if (!cit.allocation_failed()) {
-    size_t missed_count = populate_table(&cit);
+    size_t missed_count = 0;
+    if (_retained_size) {
+      if (!populate_retained_table(&cit, &missed_count, (uint) ParallelGCThreads)) {
+        st->print_cr("WARNING: Marking stopped after " JLONG_FORMAT
+                     " ms; instances and retained sizes below are partial",
+                     _retained_timeout);
+      }
+    } else {
+      missed_count = populate_table(&cit, NULL, (uint) ParallelGCThreads);
+    }
     if (missed_count != 0) {
       st->print_cr("WARNING: Ran out of C-heap; undercounted " SIZE_FORMAT
                    " total instances in data below",
@@ -529,10 +853,14 @@ void HeapInspection::heap_inspection(outputStream* st) {
     }
 
     // Sort and print klass instance info
-    const char *title = "\n"
+    const char *title = _retained_size ?
+              "\n"
+              " num     #instances         #bytes      #retained  class name\n"
+              "-------------------------------------------------------------" :
+              "\n"
               " num     #instances         #bytes  class name\n"
               "----------------------------------------------";
-    KlassInfoHisto histo(&cit, title);
+    KlassInfoHisto histo(&cit, title, _retained_size);
     HistoClosure hc(&histo);
 
     cit.iterate(&hc);
@@ -28,7 +28,9 @@
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/annotations.hpp"
+#include "utilities/bitMap.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 
 #if INCLUDE_SERVICES
 
@@ -187,11 +189,16 @@ class KlassInfoEntry: public CHeapObj<mtInternal> {
   Klass*          _klass;
   long            _instance_count;
   size_t          _instance_words;
+  size_t          _retained_words;
   long            _index;
+  // Instances of this klass on the marking stack of a retained size
+  // estimate; only the outermost one is credited with its subtree.
+  long            _nesting;
 
  public:
   KlassInfoEntry(Klass* k, KlassInfoEntry* next) :
-    _klass(k), _instance_count(0), _instance_words(0), _next(next), _index(-1)
+    _klass(k), _instance_count(0), _instance_words(0), _retained_words(0),
+    _next(next), _index(-1), _nesting(0)
   {}
   KlassInfoEntry* next() const   { return _next; }
   bool is_equal(const Klass* k)  { return k == _klass; }
@@ -200,10 +207,15 @@ class KlassInfoEntry: public CHeapObj<mtInternal> {
   void set_count(long ct)    { _instance_count = ct; }
   size_t words()  const      { return _instance_words; }
   void set_words(size_t wds) { _instance_words = wds; }
+  size_t retained_words() const         { return _retained_words; }
+  void set_retained_words(size_t wds)   { _retained_words = wds; }
+  long nesting()  const      { return _nesting; }
+  void set_nesting(long n)   { _nesting = n; }
   void set_index(long index) { _index = index; }
   long index()    const      { return _index; }
   int compare(KlassInfoEntry* e1, KlassInfoEntry* e2);
-  void print_on(outputStream* st) const;
+  int compare_retained(KlassInfoEntry* e1, KlassInfoEntry* e2);
+  void print_on(outputStream* st, bool print_retained = false) const;
   const char* name() const;
 };
 
@@ -254,8 +266,14 @@ class KlassInfoTable: public StackObj {
   void iterate(KlassInfoClosure* cic);
   bool allocation_failed() { return _buckets == NULL; }
   size_t size_of_instances_in_words() const;
+  // Adds the counts of "cie" to the entry of its klass.
+  bool merge_entry(const KlassInfoEntry* cie);
+  // Adds the counts of all entries of "table", returning the number of
+  // instances that could not be merged for lack of C-heap.
+  size_t merge(KlassInfoTable* table);
 
   friend class KlassInfoHisto;
+  friend class RetainedSizeTask;
 };
 
 class KlassInfoHisto : public StackObj {
@@ -266,7 +284,9 @@ class KlassInfoHisto : public StackObj {
   GrowableArray<KlassInfoEntry*>* elements() const { return _elements; }
   const char* _title;
   const char* title() const { return _title; }
+  bool _print_retained;
   static int sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2);
+  static int sort_retained_helper(KlassInfoEntry** e1, KlassInfoEntry** e2);
   void print_elements(outputStream* st) const;
   void print_class_stats(outputStream* st, bool csv_format, const char *columns);
   julong annotations_bytes(Array<AnnotationArray*>* p) const;
@@ -342,13 +362,101 @@ PRAGMA_DIAG_POP
   }
 
  public:
-  KlassInfoHisto(KlassInfoTable* cit, const char* title);
+  KlassInfoHisto(KlassInfoTable* cit, const char* title,
+                 bool print_retained = false);
   ~KlassInfoHisto();
   void add(KlassInfoEntry* cie);
   void print_histo_on(outputStream* st, bool print_class_stats, bool csv_format, const char *columns);
   void sort();
 };
 
+class ParallelObjectIterator;
+
+// Populates the KlassInfoTable of a heap inspection with several workers,
+// each recording the objects it iterates in a table of its own, which is
+// merged into the shared one at the end.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  KlassInfoTable* _shared_cit;
+  BoolObjectClosure* _filter;
+  size_t _missed_count;
+  Mutex _mutex;
+
+ public:
+  ParHeapInspectTask(ParallelObjectIterator* poi,
+                     KlassInfoTable* shared_cit,
+                     BoolObjectClosure* filter) :
+      AbstractGangTask("Iterating heap"),
+      _poi(poi),
+      _shared_cit(shared_cit),
+      _filter(filter),
+      _missed_count(0),
+      _mutex(Mutex::leaf, "Parallel heap inspection merge lock", true) { }
+
+  size_t missed_count() const { return _missed_count; }
+
+  virtual void work(uint worker_id);
+};
+
+// Estimates the retained size of each class with one marking pass from the
+// roots. Every object is attributed to the object it was first reached
+// from, so the marking builds a spanning tree of the object graph that
+// stands in for its dominator tree: an object retains the objects marked
+// below it, and a class retains the subtrees of its outermost instances.
+// Objects reachable along several paths are charged to whichever path
+// marked them first. Workers claim roots one at a time and record into
+// tables of their own, merged into the shared one at the end.
+class RetainedSizeTask : public AbstractGangTask {
+ public:
+  // An object still to be visited, with the index of the frame it was
+  // reached from (-1 for a root).
+  struct Pending {
+    oop _obj;
+    int _parent;
+    Pending() : _obj(NULL), _parent(-1) { }
+    Pending(oop obj, int parent) : _obj(obj), _parent(parent) { }
+  };
+
+  // An object being visited, accumulating the words of its subtree.
+  struct Frame {
+    KlassInfoEntry* _entry;
+    size_t _words;
+    Frame() : _entry(NULL), _words(0) { }
+    Frame(KlassInfoEntry* entry, size_t words) : _entry(entry), _words(words) { }
+  };
+
+ private:
+  GrowableArray<oop>* _roots;
+  volatile jint _next_root;
+  HeapWord* _bottom;
+  BitMap _mark_bits;
+  KlassInfoTable* _shared_cit;
+  jlong _deadline;
+  volatile jint _timed_out;
+  size_t _missed_count;
+  Mutex _mutex;
+
+  BitMap::idx_t bit_for(oop obj) const {
+    return pointer_delta((HeapWord*)obj, _bottom) >> LogMinObjAlignment;
+  }
+  bool check_deadline();
+  void pop_frame(GrowableArray<Frame>* frames);
+  size_t mark_from(oop root, KlassInfoTable* cit,
+                   GrowableArray<Pending>* pending, GrowableArray<Frame>* frames);
+
+ public:
+  RetainedSizeTask(GrowableArray<oop>* roots, KlassInfoTable* shared_cit,
+                   jlong timeout_ms);
+  ~RetainedSizeTask();
+
+  bool is_marked(oop obj) const { return _mark_bits.at(bit_for(obj)); }
+  bool timed_out() const        { return _timed_out != 0; }
+  size_t missed_count() const   { return _missed_count; }
+
+  virtual void work(uint worker_id);
+};
+
 #endif // INCLUDE_SERVICES
 
 // These declarations are needed since teh declaration of KlassInfoTable and
@@ -361,13 +469,25 @@ class HeapInspection : public StackObj {
   bool _print_help;
   bool _print_class_stats;
   const char* _columns;
+  bool _retained_size;      // estimate retained sizes by marking from the roots
+  jlong _retained_timeout;  // milliseconds the marking may take
  public:
   HeapInspection(bool csv_format, bool print_help,
                  bool print_class_stats, const char *columns) :
       _csv_format(csv_format), _print_help(print_help),
-      _print_class_stats(print_class_stats), _columns(columns) {}
+      _print_class_stats(print_class_stats), _columns(columns),
+      _retained_size(false), _retained_timeout(0) {}
+  void set_retained_size(bool value, jlong timeout_ms) {
+    _retained_size = value;
+    _retained_timeout = timeout_ms;
+  }
   void heap_inspection(outputStream* st) NOT_SERVICES_RETURN;
-  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL) NOT_SERVICES_RETURN_(0);
+  size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL,
+                        uint parallel_thread_num = 1) NOT_SERVICES_RETURN_(0);
+  // Records the reachable objects and their retained sizes in "cit".
+  // Returns false if the marking ran out of time and the sizes are partial.
+  bool populate_retained_table(KlassInfoTable* cit, size_t* missed_count,
+                               uint parallel_thread_num = 1) NOT_SERVICES_RETURN_(false);
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
  private:
   void iterate_over_heap(KlassInfoTable* cit, BoolObjectClosure* filter = NULL);
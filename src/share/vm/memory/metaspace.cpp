@@ -166,6 +166,9 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // of type index.
   void return_chunks(ChunkIndex index, Metachunk* chunks);
 
+  // Give the unused pages of a chunk that was just freed back to the OS.
+  void release_free_pages(Metachunk* chunk);
+
   // Total of the space in the free chunks list
   size_t free_chunks_total_words();
   size_t free_chunks_total_bytes();
@@ -620,6 +623,9 @@ class SpaceManager : public CHeapObj<mtClass> {
   // Type of metadata allocated.
   Metaspace::MetadataType _mdtype;
 
+  // Type of the metaspace, which depends on the kind of class loader.
+  Metaspace::MetaspaceType _space_type;
+
   // List of chunks in use by this SpaceManager.  Allocations
   // are done from the current chunk.  The list is used for deallocating
   // chunks when the SpaceManager is freed.
@@ -684,6 +690,7 @@ class SpaceManager : public CHeapObj<mtClass> {
 
  public:
   SpaceManager(Metaspace::MetadataType mdtype,
+               Metaspace::MetaspaceType space_type,
                Mutex* lock);
   ~SpaceManager();
 
@@ -699,6 +706,7 @@ class SpaceManager : public CHeapObj<mtClass> {
 
   // Accessors
   bool is_class() const { return _mdtype == Metaspace::ClassType; }
+  Metaspace::MetaspaceType space_type() const { return _space_type; }
 
   size_t specialized_chunk_size() const { return specialized_chunk_size(is_class()); }
   size_t small_chunk_size()       const { return small_chunk_size(is_class()); }
@@ -2092,8 +2100,24 @@ size_t SpaceManager::calc_chunk_size(size_t word_size) {
   // _small_chunk_limit small chunks can be allocated but
   // once a medium chunk has been allocated, no more small
   // chunks will be allocated.
+  //
+  // With MetaspaceAdaptiveChunkSizing the next chunk is instead about as
+  // large as all chunks so far, rounded down to a fixed chunk size, so a
+  // loader that defines few classes stays in specialized or small chunks and
+  // at most about half of its capacity is unused.
   size_t chunk_word_size;
-  if (chunks_in_use(MediumIndex) == NULL &&
+  if (MetaspaceAdaptiveChunkSizing && space_type() != Metaspace::BootMetaspaceType) {
+    if (allocated_chunks_words() >= medium_chunk_size()) {
+      chunk_word_size = medium_chunk_size();
+    } else if (allocated_chunks_words() >= small_chunk_size()) {
+      chunk_word_size = small_chunk_size();
+    } else {
+      chunk_word_size = specialized_chunk_size();
+    }
+    if (word_size + Metachunk::overhead() > chunk_word_size) {
+      chunk_word_size = adjust_initial_chunk_size(word_size + Metachunk::overhead());
+    }
+  } else if (chunks_in_use(MediumIndex) == NULL &&
       sum_count_in_chunks_in_use(SmallIndex) < _small_chunk_limit) {
     chunk_word_size = (size_t) small_chunk_size();
     if (word_size + Metachunk::overhead() > small_chunk_size()) {
@@ -2201,8 +2225,10 @@ void SpaceManager::print_on(outputStream* st) const {
 }
 
 SpaceManager::SpaceManager(Metaspace::MetadataType mdtype,
+                           Metaspace::MetaspaceType space_type,
                            Mutex* lock) :
   _mdtype(mdtype),
+  _space_type(space_type),
   _allocated_blocks_words(0),
   _allocated_chunks_words(0),
   _allocated_chunks_count(0),
@@ -2273,10 +2299,35 @@ void ChunkManager::return_chunks(ChunkIndex index, Metachunk* chunks) {
     Metachunk* next = cur->next();
     DEBUG_ONLY(cur->set_is_tagged_free(true);)
     list->return_chunk_at_head(cur);
+    release_free_pages(cur);
     cur = next;
   }
 }
 
+// The pages stay mapped and read as zero when the chunk is handed out
+// again, so nothing has to be recommitted. Only the pages holding the chunk
+// header and the free list links (a TreeList for humongous chunks) are kept.
+// Specialized and small chunks are smaller than a page and are not affected.
+void ChunkManager::release_free_pages(Metachunk* chunk) {
+  assert_lock_strong(SpaceManager::expand_lock());
+  if (!MetaspaceReleaseFreeChunks || UseLargePagesInMetaspace) {
+    return;
+  }
+  const size_t page_size = os::vm_page_size();
+  const size_t header_bytes = MAX2(Metachunk::overhead() * BytesPerWord,
+                                   sizeof(TreeList<Metachunk, FreeList<Metachunk> >));
+  char* start = (char*)align_ptr_up((char*)chunk->bottom() + header_bytes, page_size);
+  char* end = (char*)align_ptr_down((char*)chunk->end(), page_size);
+  if (start < end) {
+    os::free_memory(start, end - start, page_size);
+    if (TraceMetadataChunkAllocation) {
+      gclog_or_tty->print_cr("ChunkManager::release_free_pages: chunk " PTR_FORMAT
+                             " size " SIZE_FORMAT " released " SIZE_FORMAT " bytes",
+                             p2i(chunk), chunk->word_size(), (size_t)(end - start));
+    }
+  }
+}
+
 SpaceManager::~SpaceManager() {
   // This call this->_lock which can't be done while holding expand_lock()
   assert(sum_capacity_in_chunks_in_use() == allocated_chunks_words(),
@@ -2359,6 +2410,7 @@ SpaceManager::~SpaceManager() {
     Metachunk* next_humongous_chunks = humongous_chunks->next();
     humongous_chunks->container()->dec_container_count();
     chunk_manager()->humongous_dictionary()->return_chunk(humongous_chunks);
+    chunk_manager()->release_free_pages(humongous_chunks);
     humongous_chunks = next_humongous_chunks;
   }
   if (TraceMetadataChunkAllocation && Verbose) {
@@ -3070,17 +3122,28 @@ void Metaspace::allocate_metaspace_compressed_klass_ptrs(char* requested_addr, a
   // Don't use large pages for the class space.
   bool large_pages = false;
 
-#ifndef AARCH64
-  ReservedSpace metaspace_rs = ReservedSpace(compressed_class_space_size(),
-                                             _reserve_alignment,
-                                             large_pages,
-                                             requested_addr, 0);
-#else // AARCH64
   ReservedSpace metaspace_rs;
 
+  // Above the heap the class space would need a narrow klass base; look
+  // for room further down first.
+  uint64_t klass_encoding_max = UnscaledClassSpaceMax << LogKlassAlignmentInBytes;
+  if (UseZeroBasedCompressedClassSpace && !UseSharedSpaces &&
+      (uint64_t)requested_addr + compressed_class_space_size() > klass_encoding_max) {
+    metaspace_rs = reserve_zero_based_class_space(large_pages);
+  }
+
+#ifndef AARCH64
+  if (!metaspace_rs.is_reserved()) {
+    metaspace_rs = ReservedSpace(compressed_class_space_size(),
+                                 _reserve_alignment,
+                                 large_pages,
+                                 requested_addr, 0);
+  }
+#else // AARCH64
   // Our compressed klass pointers may fit nicely into the lower 32
   // bits.
-  if ((uint64_t)requested_addr + compressed_class_space_size() < 4*G)
+  if (!metaspace_rs.is_reserved() &&
+      (uint64_t)requested_addr + compressed_class_space_size() < 4*G)
     metaspace_rs = ReservedSpace(compressed_class_space_size(),
                                              _reserve_alignment,
                                              large_pages,
@@ -3166,6 +3229,35 @@ void Metaspace::allocate_metaspace_compressed_klass_ptrs(char* requested_addr, a
   }
 }
 
+// Probe downwards from the top of the unscaled (4G) and then the zero
+// based (32G) encoding range.  The probes never replace existing mappings,
+// so the heap, the libraries and the C heap are simply skipped over.
+ReservedSpace Metaspace::reserve_zero_based_class_space(bool large_pages) {
+  const size_t size = compressed_class_space_size();
+  const size_t increment = align_size_up(256*M, _reserve_alignment);
+  const uint64_t lowest = align_size_up(HeapBaseMinAddress, _reserve_alignment);
+  const uint64_t limits[] = { UnscaledClassSpaceMax,
+                              UnscaledClassSpaceMax << LogKlassAlignmentInBytes };
+
+  for (size_t i = 0; i < ARRAY_SIZE(limits); i++) {
+    if (limits[i] < lowest + size) {
+      continue;
+    }
+    uint64_t addr = align_size_down(limits[i] - size, _reserve_alignment);
+    while (addr >= lowest) {
+      ReservedSpace rs(size, _reserve_alignment, large_pages, (char*)addr, 0);
+      if (rs.is_reserved()) {
+        return rs;
+      }
+      if (addr < lowest + increment) {
+        break;
+      }
+      addr -= increment;
+    }
+  }
+  return ReservedSpace();
+}
+
 void Metaspace::print_compressed_class_space(outputStream* st, const char* requested_addr) {
   st->print_cr("Narrow klass base: " PTR_FORMAT ", Narrow klass shift: %d",
                p2i(Universe::narrow_klass_base()), Universe::narrow_klass_shift());
@@ -3193,6 +3285,22 @@ void Metaspace::initialize_class_space(ReservedSpace rs) {
   if (!_class_space_list->initialization_succeeded()) {
     vm_exit_during_initialization("Failed to setup compressed class space virtual space list.");
   }
+
+  if (PreTouchCompressedClassSpace) {
+    // Commit the whole class space up front. ergo_initialize() has raised
+    // MetaspaceSize by the same amount, so this does not bring the next
+    // metadata GC closer.
+    MutexLockerEx cl(SpaceManager::expand_lock(), Mutex::_no_safepoint_check_flag);
+    VirtualSpaceNode* node = _class_space_list->current_virtual_space();
+    size_t words = node->reserved_words() - node->committed_words();
+    if (words > 0 && !_class_space_list->expand_node_by(node, words, words)) {
+      vm_exit_during_initialization("Failed to commit the compressed class space.");
+    }
+    // AlwaysPreTouch has touched the memory already when committing it.
+    if (!AlwaysPreTouch) {
+      os::pretouch_memory(node->low(), node->high());
+    }
+  }
 }
 
 #endif
@@ -3256,6 +3364,12 @@ void Metaspace::ergo_initialize() {
                   min_metaspace_sz);
   }
 
+  if (PreTouchCompressedClassSpace && UseCompressedClassPointers && !DumpSharedSpaces) {
+    // The class space is committed in full at startup; leave MetaspaceSize
+    // of room for metadata on top of it before the first metadata GC.
+    FLAG_SET_ERGO(uintx, MetaspaceSize,
+                  MIN2(MetaspaceSize + CompressedClassSpaceSize, MaxMetaspaceSize));
+  }
 }
 
 void Metaspace::global_initialize() {
@@ -3430,11 +3544,11 @@ void Metaspace::initialize(Mutex* lock, MetaspaceType type) {
   verify_global_initialization();
 
   // Allocate SpaceManager for metadata objects.
-  _vsm = new SpaceManager(NonClassType, lock);
+  _vsm = new SpaceManager(NonClassType, type, lock);
 
   if (using_class_space()) {
     // Allocate SpaceManager for classes.
-    _class_vsm = new SpaceManager(ClassType, lock);
+    _class_vsm = new SpaceManager(ClassType, type, lock);
   } else {
     _class_vsm = NULL;
   }
@@ -3534,6 +3648,41 @@ size_t Metaspace::capacity_words_slow(MetadataType mdtype) const {
   }
 }
 
+Metaspace::MetaspaceType Metaspace::space_type() const {
+  return vsm()->space_type();
+}
+
+size_t Metaspace::allocated_chunks_count(MetadataType mdtype) const {
+  if (mdtype == ClassType) {
+    return using_class_space() ? class_vsm()->allocated_chunks_count() : 0;
+  } else {
+    return vsm()->allocated_chunks_count();
+  }
+}
+
+size_t Metaspace::allocated_blocks_bytes(MetadataType mdtype) const {
+  if (mdtype == ClassType) {
+    return using_class_space() ? class_vsm()->allocated_blocks_bytes() : 0;
+  } else {
+    return vsm()->allocated_blocks_bytes();
+  }
+}
+
+size_t Metaspace::allocated_chunks_bytes(MetadataType mdtype) const {
+  if (mdtype == ClassType) {
+    return using_class_space() ? class_vsm()->allocated_chunks_bytes() : 0;
+  } else {
+    return vsm()->allocated_chunks_bytes();
+  }
+}
+
+// Size of the chunk the next small allocation that does not fit in the
+// current chunk would get.
+size_t Metaspace::next_chunk_word_size(MetadataType mdtype) {
+  assert(mdtype != ClassType || using_class_space(), "Has to use class space");
+  return get_space_manager(mdtype)->calc_chunk_size(0);
+}
+
 size_t Metaspace::used_bytes_slow(MetadataType mdtype) const {
   return used_words_slow(mdtype) * BytesPerWord;
 }
@@ -194,6 +194,9 @@ class Metaspace : public CHeapObj<mtClass> {
 
   static void allocate_metaspace_compressed_klass_ptrs(char* requested_addr, address cds_base);
 
+  // Try to reserve the class space low enough for a zero narrow klass base.
+  static ReservedSpace reserve_zero_based_class_space(bool large_pages);
+
   static void initialize_class_space(ReservedSpace rs);
 #endif
 
@@ -237,6 +240,12 @@ class Metaspace : public CHeapObj<mtClass> {
   size_t used_bytes_slow(MetadataType mdtype) const;
   size_t capacity_bytes_slow(MetadataType mdtype) const;
 
+  MetaspaceType space_type() const;
+  size_t allocated_chunks_count(MetadataType mdtype) const;
+  size_t allocated_blocks_bytes(MetadataType mdtype) const;
+  size_t allocated_chunks_bytes(MetadataType mdtype) const;
+  size_t next_chunk_word_size(MetadataType mdtype);
+
   size_t allocated_blocks_bytes() const;
   size_t allocated_chunks_bytes() const;
 
@@ -50,6 +50,7 @@
 #include "utilities/dumpUtil.hpp"
 #include "classfile/classLoader.hpp"
 #include "memory/metaspaceDumper.hpp"
+#include "memory/metaspaceSnapshot.hpp"
 
 #define INDENT_SPACE_COUNT 2
 // outputStream has the length limit of output string,
@@ -132,8 +133,30 @@ static uint dump_file_seq = 0;
 static const char* dump_file_name = "java_pid";
 static const char* dump_file_ext = ".mprof";
 
+static char binary_base_path[JVM_MAXPATHLEN] = {'\0'};
+static uint binary_dump_file_seq = 0;
+static const char* binary_dump_file_ext = ".mbin";
+
+bool MetaspaceDumper::dump_binary(const char* log_path, DumpReason reason, bool diff) {
+  if (!MetaspaceSnapshot::dump(log_path, (u1)reason, diff)) {
+    warning("MetaspaceDumper: Cannot open log file: %s", log_path);
+    return false;
+  }
+  return true;
+}
+
 void MetaspaceDumper::dump(DumpReason reason, OOMEMetaspaceArea oome_area,
                            ClassLoaderData* oome_loader_data) {
+  if (MetaspaceDumpBinary) {
+    DumpAux aux(binary_base_path, &binary_dump_file_seq, dump_file_name,
+                binary_dump_file_ext, MetaspaceDumpPath);
+    DumpPathBuilder path_builder(aux);
+    const char* path = path_builder.build();
+    if (path != NULL) {
+      dump_binary(path, reason, false);
+    }
+    return;
+  }
   DumpAux aux(base_path, &dump_file_seq, dump_file_name, dump_file_ext, MetaspaceDumpPath);
   DumpPathBuilder path_builder(aux);
   const char* path = path_builder.build();
@@ -203,6 +226,7 @@ void MetaspaceDumper::do_dump() {
    * [Class Loader Data]
    * ClassLoaderData : loader = 0x0000000000000000, loader_klass = 0x0000000000000000, loader_klass_name = <bootloader>, label = No Label
    *   Class Used Chunks :
+   *     Chunk Sizing : type = Boot, chunks = 3, capacity = 1048576 B, used = 1021312 B, next chunk = 32768 B
    *     * Chunk : [0x00000007c23a8400, 0x00000007c23a8678, 0x00000007c23a8800)
    *   NonClass Used Chunks :
    *     * Chunk : [0x00007efcc92fa800, 0x00007efcc92fa978, 0x00007efcc92fb800)
@@ -495,6 +519,18 @@ void MetaspaceDumper::dump_used_chunks(Metaspace *metaspace) {
   dump_used_chunks(metaspace, Metaspace::NonClassType);
 }
 
+static const char* space_type_name(Metaspace::MetaspaceType type) {
+  switch (type) {
+    case Metaspace::StandardMetaspaceType:   return "Standard";
+    case Metaspace::BootMetaspaceType:       return "Boot";
+    case Metaspace::ROMetaspaceType:         return "ReadOnly";
+    case Metaspace::ReadWriteMetaspaceType:  return "ReadWrite";
+    case Metaspace::AnonymousMetaspaceType:  return "Anonymous";
+    case Metaspace::ReflectionMetaspaceType: return "Reflection";
+    default:                                 return "Unknown";
+  }
+}
+
 void MetaspaceDumper::dump_used_chunks(Metaspace *metaspace, Metaspace::MetadataType metadataType) {
   assert(metaspace != NULL, "must not be null");
   InUsedChunkDumpClosure in_used_chunk_dump_closure(*this);
@@ -502,6 +538,14 @@ void MetaspaceDumper::dump_used_chunks(Metaspace *metaspace, Metaspace::Metadata
   PRINT_INDENT;
   PRINT_CR(metadataType == Metaspace::ClassType ? "Class Used Chunks :" : "NonClass Used Chunks :");
   IndentHelper indent(*this);
+  PRINT_INDENT;
+  PRINT_CR("Chunk Sizing : type = %s, chunks = " SIZE_FORMAT ", capacity = " SIZE_FORMAT
+           " B, used = " SIZE_FORMAT " B, next chunk = " SIZE_FORMAT " B",
+           space_type_name(metaspace->space_type()),
+           metaspace->allocated_chunks_count(metadataType),
+           metaspace->allocated_chunks_bytes(metadataType),
+           metaspace->allocated_blocks_bytes(metadataType),
+           metaspace->next_chunk_word_size(metadataType) * BytesPerWord);
   metaspace->in_used_chunks_do(metadataType, &in_used_chunk_dump_closure);
   metaspace->free_blocks_do(metadataType, &free_block_dump_closure);
 }
@@ -84,6 +84,9 @@ class MetaspaceDumper : public StackObj {
                      ClassLoaderData* oome_loader_data = NULL);
     static void dump(DumpReason reason, OOMEMetaspaceArea oome_area = None,
                      ClassLoaderData* oome_loader_data = NULL);
+    // Compact binary dump, see MetaspaceSnapshot. A diff dump only contains
+    // what changed since the previous binary dump requested by a Java thread.
+    static bool dump_binary(const char* log_path, DumpReason reason, bool diff);
 
     fileStream* dump_file() const             { return _dump_file; }
 
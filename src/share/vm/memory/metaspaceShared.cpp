@@ -38,6 +38,8 @@
 #include "memory/metaspaceShared.hpp"
 #include "oops/objArrayOop.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/os.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/vm_operations.hpp"
 #include "runtime/vmThread.hpp"
@@ -789,7 +791,7 @@ int MetaspaceShared::preload_and_dump(const char * class_list_path,
                                       GrowableArray<Klass*>* class_promote_order,
                                       TRAPS) {
   FILE* file = fopen(class_list_path, "r");
-  char class_name[256];
+  char class_name[JVM_MAXPATHLEN + 256];
   int class_count = 0;
 
   if (file != NULL) {
@@ -803,11 +805,28 @@ int MetaspaceShared::preload_and_dump(const char * class_list_path,
         class_name[name_len-1] = '\0';
       }
 
+      // A class of a user-defined class loader is given as
+      // "<name> source: <jar file or directory>".
+      char* source = strstr(class_name, " source:");
+      if (source != NULL) {
+        *source = '\0';
+        source += strlen(" source:");
+        while (*source == ' ') {
+          source++;
+        }
+      }
+
       // Got a class name - load it.
       TempNewSymbol class_name_symbol = SymbolTable::new_permanent_symbol(class_name, THREAD);
       guarantee(!HAS_PENDING_EXCEPTION, "Exception creating a symbol.");
-      Klass* klass = SystemDictionary::resolve_or_null(class_name_symbol,
-                                                         THREAD);
+      Klass* klass;
+      if (source != NULL) {
+        klass = SystemDictionaryShared::load_unregistered_class(class_name_symbol,
+                                                                source, THREAD);
+      } else {
+        klass = SystemDictionary::resolve_or_null(class_name_symbol,
+                                                  THREAD);
+      }
       CLEAR_PENDING_EXCEPTION;
       if (klass != NULL) {
         if (PrintSharedSpaces && Verbose && WizardMode) {
@@ -873,6 +892,44 @@ bool MetaspaceShared::try_link_class(InstanceKlass* ik, TRAPS) {
   }
 }
 
+bool MetaspaceShared::dump_loaded_classes(const char* archive, outputStream* st) {
+  ResourceMark rm;
+  stringStream list_name;
+  list_name.print("%s.classlist", archive);
+  {
+    fileStream list(list_name.as_string());
+    if (!list.is_open()) {
+      st->print_cr("Cannot write class list %s", list_name.as_string());
+      return false;
+    }
+    SystemDictionaryShared::print_loaded_classlist(&list);
+  }
+
+  // The archive is created by a fresh VM: dumping needs the boot sequence
+  // of a VM that has not run any Java code, and the options the archive
+  // is validated against at runtime must match this VM.
+  stringStream cmd;
+  cmd.print("\"%s%sbin%sjava\" -Xshare:dump -XX:+UnlockDiagnosticVMOptions "
+            "-XX:SharedClassListFile=\"%s\" -XX:SharedArchiveFile=\"%s\" "
+            "-XX:ObjectAlignmentInBytes=%d",
+            Arguments::get_java_home(), os::file_separator(), os::file_separator(),
+            list_name.as_string(), archive, ObjectAlignmentInBytes);
+#ifdef _LP64
+  cmd.print(" -XX:%cUseCompressedOops -XX:%cUseCompressedClassPointers",
+            UseCompressedOops ? '+' : '-', UseCompressedClassPointers ? '+' : '-');
+#endif
+  if (PrintSharedSpaces) {
+    st->print_cr("Dumping shared archive: %s", cmd.as_string());
+  }
+  int status = os::fork_and_exec(cmd.as_string());
+  if (status != 0) {
+    st->print_cr("Dumping shared archive %s failed (%d)", archive, status);
+    return false;
+  }
+  st->print_cr("Dumped shared archive %s from %s", archive, list_name.as_string());
+  return true;
+}
+
 // Closure for serializing initialization data in from a data area
 // (ptr_array) read from the shared file.
 
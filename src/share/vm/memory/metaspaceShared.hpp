@@ -137,6 +137,10 @@ class MetaspaceShared : AllStatic {
   static void link_and_cleanup_shared_classes(TRAPS);
 
   static int count_class(const char* classlist_file);
+
+  // Write the classes loaded by this VM to <archive>.classlist and run
+  // -Xshare:dump on it in a child VM.
+  static bool dump_loaded_classes(const char* archive, outputStream* st) NOT_CDS_RETURN_(false);
   static void estimate_regions_size() NOT_CDS_RETURN;
 };
 #endif // SHARE_VM_MEMORY_METASPACE_SHARED_HPP
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
+#include "memory/metaspaceSnapshot.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.hpp"
+#include "oops/symbol.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/vmThread.hpp"
+#include "runtime/vm_operations.hpp"
+#include "utilities/ostream.hpp"
+
+MetaspaceSnapshot* MetaspaceSnapshot::_previous = NULL;
+
+MetaspaceSnapshot::MetaspaceSnapshot() : _time_millis(0), _snapshot_millis(0) {
+  _loaders = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<LoaderEntry>(64, true, mtInternal);
+  _klasses = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<KlassEntry>(1024, true, mtInternal);
+  memset(_space_info, 0, sizeof(_space_info));
+}
+
+MetaspaceSnapshot::~MetaspaceSnapshot() {
+  for (int i = 0; i < _loaders->length(); i++) {
+    Symbol* name = _loaders->at(i)._loader_name;
+    if (name != NULL) {
+      name->decrement_refcount();
+    }
+  }
+  for (int i = 0; i < _klasses->length(); i++) {
+    _klasses->at(i)._name->decrement_refcount();
+  }
+  delete _loaders;
+  delete _klasses;
+}
+
+class SnapshotKlassClosure : public KlassClosure {
+  GrowableArray<MetaspaceSnapshot::KlassEntry>* _klasses;
+  ClassLoaderData* _cld;
+  u4 _count;
+ public:
+  SnapshotKlassClosure(GrowableArray<MetaspaceSnapshot::KlassEntry>* klasses, ClassLoaderData* cld)
+    : _klasses(klasses), _cld(cld), _count(0) {}
+
+  void do_klass(Klass* k) {
+    MetaspaceSnapshot::KlassEntry e;
+    e._klass = k;
+    e._cld = _cld;
+    e._size = (u4)(k->size() * HeapWordSize);
+    e._name = k->name();
+    e._name->increment_refcount();
+    _klasses->append(e);
+    _count++;
+  }
+
+  u4 count() const { return _count; }
+};
+
+class SnapshotCLDClosure : public CLDClosure {
+  GrowableArray<MetaspaceSnapshot::LoaderEntry>* _loaders;
+  GrowableArray<MetaspaceSnapshot::KlassEntry>*  _klasses;
+ public:
+  SnapshotCLDClosure(GrowableArray<MetaspaceSnapshot::LoaderEntry>* loaders,
+                     GrowableArray<MetaspaceSnapshot::KlassEntry>* klasses)
+    : _loaders(loaders), _klasses(klasses) {}
+
+  void do_cld(ClassLoaderData* cld) {
+    Metaspace* ms = cld->metaspace_or_null();
+    if (ms == NULL) {
+      return;
+    }
+    MetaspaceSnapshot::LoaderEntry e;
+    e._cld = cld;
+    oop loader = cld->class_loader();
+    e._loader = (address)loader;
+    e._loader_name = NULL;
+    if (loader != NULL) {
+      e._loader_name = loader->klass()->name();
+      e._loader_name->increment_refcount();
+    }
+    e._space_type = (u1)ms->space_type();
+    e._bytes[0] = Metaspace::using_class_space() ? ms->allocated_chunks_bytes(Metaspace::ClassType) : 0;
+    e._bytes[1] = Metaspace::using_class_space() ? ms->allocated_blocks_bytes(Metaspace::ClassType) : 0;
+    e._bytes[2] = ms->allocated_chunks_bytes(Metaspace::NonClassType);
+    e._bytes[3] = ms->allocated_blocks_bytes(Metaspace::NonClassType);
+    SnapshotKlassClosure kc(_klasses, cld);
+    cld->classes_do(&kc);
+    e._classes = kc.count();
+    _loaders->append(e);
+  }
+};
+
+static int compare_loaders(MetaspaceSnapshot::LoaderEntry* a, MetaspaceSnapshot::LoaderEntry* b) {
+  return a->_cld < b->_cld ? -1 : (a->_cld == b->_cld ? 0 : 1);
+}
+
+static int compare_klasses(MetaspaceSnapshot::KlassEntry* a, MetaspaceSnapshot::KlassEntry* b) {
+  return a->_klass < b->_klass ? -1 : (a->_klass == b->_klass ? 0 : 1);
+}
+
+// Only collects addresses, sizes and names; everything else is done by
+// write() after the safepoint.
+void MetaspaceSnapshot::take() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  jlong start = os::javaTimeMillis();
+  _time_millis = start;
+  for (int i = 0; i < Metaspace::MetadataTypeCount; i++) {
+    Metaspace::MetadataType mdtype = (Metaspace::MetadataType)i;
+    _space_info[i][0] = MetaspaceAux::used_bytes(mdtype);
+    _space_info[i][1] = MetaspaceAux::capacity_bytes(mdtype);
+    _space_info[i][2] = MetaspaceAux::committed_bytes(mdtype);
+    _space_info[i][3] = MetaspaceAux::reserved_bytes(mdtype);
+  }
+  SnapshotCLDClosure cl(_loaders, _klasses);
+  ClassLoaderDataGraph::cld_do(&cl);
+  _loaders->sort(compare_loaders);
+  _klasses->sort(compare_klasses);
+  _snapshot_millis = os::javaTimeMillis() - start;
+}
+
+class MetaspaceSnapshotWriter : public StackObj {
+  fileStream* _out;
+  u1 _buf[64];
+  int _pos;
+
+  void flush_if_full(int needed) {
+    if (_pos + needed > (int)sizeof(_buf)) {
+      flush();
+    }
+  }
+ public:
+  MetaspaceSnapshotWriter(fileStream* out) : _out(out), _pos(0) {}
+  ~MetaspaceSnapshotWriter() { flush(); }
+
+  void flush() {
+    if (_pos > 0) {
+      _out->write((const char*)_buf, _pos);
+      _pos = 0;
+    }
+  }
+
+  void u1_(u1 v) { flush_if_full(1); _buf[_pos++] = v; }
+  void u2_(u2 v) { u1_((u1)(v >> 8)); u1_((u1)v); }
+  void u4_(u4 v) { u2_((u2)(v >> 16)); u2_((u2)v); }
+  void u8_(u8 v) { u4_((u4)(v >> 32)); u4_((u4)v); }
+  void address_(const void* p) { u8_((u8)(uintptr_t)p); }
+
+  void bytes(const char* s, int len) {
+    flush();
+    _out->write(s, len);
+  }
+
+  void name(Symbol* sym) {
+    if (sym == NULL) {
+      u2_(0);
+      return;
+    }
+    int len = MIN2(sym->utf8_length(), (int)max_jushort);
+    u2_((u2)len);
+    bytes((const char*)sym->bytes(), len);
+  }
+};
+
+static void write_loader(MetaspaceSnapshotWriter& w, MetaspaceSnapshot::LoaderEntry* e, u1 change) {
+  w.u1_(MetaspaceSnapshot::TAG_LOADER);
+  w.u1_(change);
+  w.address_(e->_cld);
+  w.address_(e->_loader);
+  w.u1_(e->_space_type);
+  w.u4_(e->_classes);
+  for (int i = 0; i < 4; i++) {
+    w.u8_(e->_bytes[i]);
+  }
+  w.name(e->_loader_name);
+}
+
+static void write_klass(MetaspaceSnapshotWriter& w, MetaspaceSnapshot::KlassEntry* e, u1 change) {
+  w.u1_(MetaspaceSnapshot::TAG_KLASS);
+  w.u1_(change);
+  w.address_(e->_klass);
+  w.address_(e->_cld);
+  w.u4_(e->_size);
+  w.name(e->_name);
+}
+
+static bool same_loader(MetaspaceSnapshot::LoaderEntry* a, MetaspaceSnapshot::LoaderEntry* b) {
+  return a->_classes == b->_classes && memcmp(a->_bytes, b->_bytes, sizeof(a->_bytes)) == 0;
+}
+
+// Both sides are sorted by address, so a diff is a single merge pass.
+void MetaspaceSnapshot::write(fileStream* out, u1 reason, MetaspaceSnapshot* base) {
+  MetaspaceSnapshotWriter w(out);
+  w.bytes("MSPDUMP", 8);  // includes the terminating '\0'
+  w.u4_(version);
+  w.u1_(reason);
+  w.u1_(base != NULL ? 1 : 0);
+  w.u8_((u8)_time_millis);
+
+  for (int i = 0; i < Metaspace::MetadataTypeCount; i++) {
+    w.u1_(TAG_SPACE);
+    w.u1_((u1)i);
+    for (int j = 0; j < 4; j++) {
+      w.u8_(_space_info[i][j]);
+    }
+  }
+
+  int nloaders = 0;
+  int nklasses = 0;
+  if (base == NULL) {
+    for (int i = 0; i < _loaders->length(); i++) {
+      write_loader(w, _loaders->adr_at(i), CHANGE_NONE);
+    }
+    for (int i = 0; i < _klasses->length(); i++) {
+      write_klass(w, _klasses->adr_at(i), CHANGE_NONE);
+    }
+    nloaders = _loaders->length();
+    nklasses = _klasses->length();
+  } else {
+    int i = 0, j = 0;
+    while (i < _loaders->length() || j < base->_loaders->length()) {
+      LoaderEntry* cur = i < _loaders->length() ? _loaders->adr_at(i) : NULL;
+      LoaderEntry* old = j < base->_loaders->length() ? base->_loaders->adr_at(j) : NULL;
+      if (old == NULL || (cur != NULL && cur->_cld < old->_cld)) {
+        write_loader(w, cur, CHANGE_ADDED);
+        nloaders++;
+        i++;
+      } else if (cur == NULL || old->_cld < cur->_cld) {
+        write_loader(w, old, CHANGE_REMOVED);
+        nloaders++;
+        j++;
+      } else {
+        if (!same_loader(cur, old)) {
+          write_loader(w, cur, CHANGE_RESIZED);
+          nloaders++;
+        }
+        i++;
+        j++;
+      }
+    }
+    i = 0;
+    j = 0;
+    while (i < _klasses->length() || j < base->_klasses->length()) {
+      KlassEntry* cur = i < _klasses->length() ? _klasses->adr_at(i) : NULL;
+      KlassEntry* old = j < base->_klasses->length() ? base->_klasses->adr_at(j) : NULL;
+      if (old == NULL || (cur != NULL && cur->_klass < old->_klass)) {
+        write_klass(w, cur, CHANGE_ADDED);
+        nklasses++;
+        i++;
+      } else if (cur == NULL || old->_klass < cur->_klass) {
+        write_klass(w, old, CHANGE_REMOVED);
+        nklasses++;
+        j++;
+      } else {
+        if (cur->_name != old->_name) {
+          // The klass was unloaded and its address reused
+          write_klass(w, old, CHANGE_REMOVED);
+          write_klass(w, cur, CHANGE_ADDED);
+          nklasses += 2;
+        } else if (cur->_size != old->_size) {
+          write_klass(w, cur, CHANGE_RESIZED);
+          nklasses++;
+        }
+        i++;
+        j++;
+      }
+    }
+  }
+
+  w.u1_(TAG_END);
+  w.u4_((u4)nloaders);
+  w.u4_((u4)nklasses);
+  w.u8_((u8)_snapshot_millis);
+}
+
+class VM_MetaspaceSnapshot : public VM_Operation {
+  MetaspaceSnapshot* _snapshot;
+ public:
+  VM_MetaspaceSnapshot(MetaspaceSnapshot* snapshot) : _snapshot(snapshot) {}
+  VMOp_Type type() const { return VMOp_MetaspaceDump; }
+  void doit() { _snapshot->take(); }
+};
+
+bool MetaspaceSnapshot::dump(const char* path, u1 reason, bool diff) {
+  fileStream out(path, "wb");
+  if (!out.is_open()) {
+    return false;
+  }
+
+  MetaspaceSnapshot* snapshot = new MetaspaceSnapshot();
+  if (Thread::current()->is_VM_thread()) {
+    // Dumps requested inside a pause, e.g. before a full GC, are written
+    // right away and never become the base of a diff, which is owned by
+    // the threads holding MetaspaceDump_lock.
+    snapshot->take();
+    snapshot->write(&out, reason, NULL);
+    delete snapshot;
+    return true;
+  }
+
+  MutexLocker ml(MetaspaceDump_lock);
+  VM_MetaspaceSnapshot op(snapshot);
+  VMThread::execute(&op);
+  snapshot->write(&out, reason, diff ? _previous : NULL);
+  if (_previous != NULL) {
+    delete _previous;
+  }
+  _previous = snapshot;
+  return true;
+}
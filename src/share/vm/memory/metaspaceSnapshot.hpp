@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_MEMORY_METASPACESNAPSHOT_HPP
+#define SHARE_VM_MEMORY_METASPACESNAPSHOT_HPP
+
+#include "memory/allocation.hpp"
+#include "memory/metaspace.hpp"
+#include "utilities/growableArray.hpp"
+
+class ClassLoaderData;
+class Klass;
+class Symbol;
+
+// A compact binary alternative to the text dump of MetaspaceDumper.
+//
+// Only a snapshot of the class loader data and klasses is taken at the
+// safepoint: addresses, sizes and names, with the names kept alive by their
+// refcount. Formatting and file I/O happen after the safepoint, record by
+// record. A snapshot is kept until the next binary dump so that the next
+// dump can be written as a diff against it.
+//
+// File format, all integers big-endian:
+//   header  : "MSPDUMP\0" u4 version u1 reason u1 is_diff u8 time_millis
+//   space   : u1 TAG_SPACE u1 mdtype u8 used u8 capacity u8 committed u8 reserved
+//   loader  : u1 TAG_LOADER u1 change u8 cld u8 loader u1 space_type u4 classes
+//             u8 class_chunks u8 class_blocks u8 nonclass_chunks u8 nonclass_blocks
+//             name(loader klass)
+//   klass   : u1 TAG_KLASS u1 change u8 klass u8 cld u4 size name(klass)
+//   end     : u1 TAG_END u4 loaders u4 klasses u8 snapshot_millis
+//   name    : u2 length, followed by the modified UTF-8 bytes
+//
+// In a full dump every record has change CHANGE_NONE. In a diff dump only
+// loaders and klasses that were added, removed or resized since the previous
+// binary dump are written. Entries are matched by address.
+class MetaspaceSnapshot : public CHeapObj<mtInternal> {
+ public:
+  enum {
+    version = 1
+  };
+
+  enum Tag {
+    TAG_SPACE  = 0x01,
+    TAG_LOADER = 0x02,
+    TAG_KLASS  = 0x03,
+    TAG_END    = 0xFF
+  };
+
+  enum Change {
+    CHANGE_NONE    = 0,
+    CHANGE_ADDED   = 1,
+    CHANGE_REMOVED = 2,
+    CHANGE_RESIZED = 3
+  };
+
+  struct LoaderEntry {
+    ClassLoaderData* _cld;
+    address          _loader;
+    Symbol*          _loader_name;
+    u1               _space_type;
+    u4               _classes;
+    u8               _bytes[4];  // class chunks, class blocks, nonclass chunks, nonclass blocks
+  };
+
+  struct KlassEntry {
+    Klass*           _klass;
+    ClassLoaderData* _cld;
+    u4               _size;
+    Symbol*          _name;
+  };
+
+ private:
+  GrowableArray<LoaderEntry>* _loaders;
+  GrowableArray<KlassEntry>*  _klasses;
+  u8                          _space_info[Metaspace::MetadataTypeCount][4];
+  jlong                       _time_millis;
+  jlong                       _snapshot_millis;
+
+  // The snapshot of the previous binary dump, the base of the next diff.
+  static MetaspaceSnapshot* _previous;
+
+  void take();
+  void write(fileStream* out, u1 reason, MetaspaceSnapshot* base);
+
+  friend class VM_MetaspaceSnapshot;
+
+ public:
+  MetaspaceSnapshot();
+  ~MetaspaceSnapshot();
+
+  // Take a snapshot at a safepoint and write it to path. Returns false if
+  // the file could not be created.
+  static bool dump(const char* path, u1 reason, bool diff);
+};
+
+#endif // SHARE_VM_MEMORY_METASPACESNAPSHOT_HPP
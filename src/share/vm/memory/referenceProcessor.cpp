@@ -34,6 +34,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/jniHandles.hpp"
+#include "utilities/ticks.hpp"
 #if INCLUDE_JFR
 #include "jfr/jfr.hpp"
 #endif // INCLUDE_JFR
@@ -216,47 +217,70 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Soft references
   size_t soft_count = 0;
+  Tickspan soft_time;
+  uint soft_workers = 0;
   {
     GCTraceTime tt("SoftReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     soft_count =
       process_discovered_reflist(_discoveredSoftRefs, _current_soft_ref_policy, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &soft_workers);
+    soft_time = Ticks::now() - start;
   }
 
   update_soft_ref_master_clock();
 
   // Weak references
   size_t weak_count = 0;
+  Tickspan weak_time;
+  uint weak_workers = 0;
   {
     GCTraceTime tt("WeakReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     weak_count =
       process_discovered_reflist(_discoveredWeakRefs, NULL, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &weak_workers);
+    weak_time = Ticks::now() - start;
   }
 
   // Final references
   size_t final_count = 0;
+  Tickspan final_time;
+  uint final_workers = 0;
   {
     GCTraceTime tt("FinalReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     final_count =
       process_discovered_reflist(_discoveredFinalRefs, NULL, false,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &final_workers);
+    final_time = Ticks::now() - start;
   }
 
   // Phantom references
   size_t phantom_count = 0;
+  Tickspan phantom_time;
+  uint phantom_workers = 0;
   {
     GCTraceTime tt("PhantomReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
+    uint cleaner_workers = 0;
     phantom_count =
       process_discovered_reflist(_discoveredPhantomRefs, NULL, false,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &phantom_workers);
 
     // Process cleaners, but include them in phantom statistics.  We expect
     // Cleaner references to be temporary, and don't want to deal with
     // possible incompatibilities arising from making it more visible.
     phantom_count +=
       process_discovered_reflist(_discoveredCleanerRefs, NULL, true,
-                                 is_alive, keep_alive, complete_gc, task_executor);
+                                 is_alive, keep_alive, complete_gc, task_executor,
+                                 &cleaner_workers);
+    phantom_time = Ticks::now() - start;
+    phantom_workers = MAX2(phantom_workers, cleaner_workers);
   }
 
   // Weak global JNI references. It would make more sense (semantically) to
@@ -272,7 +296,12 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     process_phaseJNI(is_alive, keep_alive, complete_gc);
   }
 
-  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count);
+  ReferenceProcessorStats stats(soft_count, weak_count, final_count, phantom_count);
+  stats.set_phase(REF_SOFT, soft_time, soft_workers);
+  stats.set_phase(REF_WEAK, weak_time, weak_workers);
+  stats.set_phase(REF_FINAL, final_time, final_workers);
+  stats.set_phase(REF_PHANTOM, phantom_time, phantom_workers);
+  return stats;
 }
 
 #ifndef PRODUCT
@@ -892,6 +921,26 @@ void ReferenceProcessor::balance_all_queues() {
   balance_queues(_discoveredCleanerRefs);
 }
 
+uint ReferenceProcessor::ergo_proc_thread_count(size_t ref_count) const {
+  if (ReferencesPerThread == 0) {
+    return _num_q;
+  }
+  size_t thread_count = ref_count / ReferencesPerThread + 1;
+  return (uint)MIN2(thread_count, (size_t)_num_q);
+}
+
+size_t ReferenceProcessor::adjust_mt_degree(DiscoveredList ref_lists[]) {
+  size_t ref_count = total_count(ref_lists);
+  uint degree = ergo_proc_thread_count(ref_count);
+  // Without balancing the references stay where discovery put them,
+  // and every queue up to _num_q may still hold some.
+  if (ref_count > 0 && degree < _num_q && ParallelRefProcBalancingEnabled) {
+    _num_q = degree;
+    balance_queues(ref_lists);
+  }
+  return ref_count;
+}
+
 size_t
 ReferenceProcessor::process_discovered_reflist(
   DiscoveredList               refs_lists[],
@@ -900,7 +949,8 @@ ReferenceProcessor::process_discovered_reflist(
   BoolObjectClosure*           is_alive,
   OopClosure*                  keep_alive,
   VoidClosure*                 complete_gc,
-  AbstractRefProcTaskExecutor* task_executor)
+  AbstractRefProcTaskExecutor* task_executor,
+  uint*                        workers)
 {
   bool mt_processing = task_executor != NULL && _processing_is_mt;
   // If discovery used MT and a dynamic number of GC threads, then
@@ -922,6 +972,17 @@ ReferenceProcessor::process_discovered_reflist(
     gclog_or_tty->print(", %u refs", total_list_count);
   }
 
+  *workers = 0;
+  if (total_list_count == 0) {
+    // Nothing was discovered: skip the phases and do not wake the workers.
+    return 0;
+  }
+
+  // Each parallel phase below is sized by the references it still has
+  // to look at, and is skipped when there are none left.  The active
+  // degree is restored after every phase.
+  const uint saved_num_q = _num_q;
+
   // Phase 1 (soft refs only):
   // . Traverse the list and remove any SoftReferences whose
   //   referents are not alive, but that should be kept alive for
@@ -929,8 +990,11 @@ ReferenceProcessor::process_discovered_reflist(
   //   such referents.
   if (policy != NULL) {
     if (mt_processing) {
+      adjust_mt_degree(refs_lists);
+      *workers = MAX2(*workers, _num_q);
       RefProcPhase1Task phase1(*this, refs_lists, policy, true /*marks_oops_alive*/);
       task_executor->execute(phase1);
+      _num_q = saved_num_q;
     } else {
       for (uint i = 0; i < _max_num_q; i++) {
         process_phase1(refs_lists[i], policy,
@@ -945,8 +1009,12 @@ ReferenceProcessor::process_discovered_reflist(
   // Phase 2:
   // . Traverse the list and remove any refs whose referents are alive.
   if (mt_processing) {
-    RefProcPhase2Task phase2(*this, refs_lists, !discovery_is_atomic() /*marks_oops_alive*/);
-    task_executor->execute(phase2);
+    if (adjust_mt_degree(refs_lists) > 0) {
+      *workers = MAX2(*workers, _num_q);
+      RefProcPhase2Task phase2(*this, refs_lists, !discovery_is_atomic() /*marks_oops_alive*/);
+      task_executor->execute(phase2);
+    }
+    _num_q = saved_num_q;
   } else {
     for (uint i = 0; i < _max_num_q; i++) {
       process_phase2(refs_lists[i], is_alive, keep_alive, complete_gc);
@@ -956,8 +1024,12 @@ ReferenceProcessor::process_discovered_reflist(
   // Phase 3:
   // . Traverse the list and process referents as appropriate.
   if (mt_processing) {
-    RefProcPhase3Task phase3(*this, refs_lists, clear_referent, true /*marks_oops_alive*/);
-    task_executor->execute(phase3);
+    if (adjust_mt_degree(refs_lists) > 0) {
+      *workers = MAX2(*workers, _num_q);
+      RefProcPhase3Task phase3(*this, refs_lists, clear_referent, true /*marks_oops_alive*/);
+      task_executor->execute(phase3);
+    }
+    _num_q = saved_num_q;
   } else {
     for (uint i = 0; i < _max_num_q; i++) {
       process_phase3(refs_lists[i], clear_referent,
@@ -965,6 +1037,10 @@ ReferenceProcessor::process_discovered_reflist(
     }
   }
 
+  if (PrintReferenceGC && PrintGCDetails && mt_processing) {
+    gclog_or_tty->print(", %u workers", *workers);
+  }
+
   return total_list_count;
 }
 
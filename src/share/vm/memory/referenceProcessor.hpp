@@ -289,7 +289,8 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                                     BoolObjectClosure*           is_alive,
                                     OopClosure*                  keep_alive,
                                     VoidClosure*                 complete_gc,
-                                    AbstractRefProcTaskExecutor* task_executor);
+                                    AbstractRefProcTaskExecutor* task_executor,
+                                    uint*                        workers);
 
   void process_phaseJNI(BoolObjectClosure* is_alive,
                         OopClosure*        keep_alive,
@@ -405,6 +406,15 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
   // Balances reference queues.
   void balance_queues(DiscoveredList ref_lists[]);
 
+  // Number of queues a parallel phase over ref_count references is
+  // given, at most _num_q.
+  uint ergo_proc_thread_count(size_t ref_count) const;
+
+  // Narrows _num_q for the next parallel phase to what the references
+  // left in ref_lists warrant and balances them into those queues.
+  // Returns the number of references left.
+  size_t adjust_mt_degree(DiscoveredList ref_lists[]);
+
   // Update (advance) the soft ref master clock field.
   void update_soft_ref_master_clock();
 
@@ -25,24 +25,41 @@
 #ifndef SHARE_VM_MEMORY_REFERENCEPROCESSORSTATS_HPP
 #define SHARE_VM_MEMORY_REFERENCEPROCESSORSTATS_HPP
 
+#include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/ticks.hpp"
 
 class ReferenceProcessor;
 
 // ReferenceProcessorStats contains statistics about how many references that
-// have been traversed when processing references during garbage collection.
+// have been traversed when processing references during garbage collection,
+// how long each reference type took and how many workers it was given.
 class ReferenceProcessorStats {
   size_t _soft_count;
   size_t _weak_count;
   size_t _final_count;
   size_t _phantom_count;
 
+  Tickspan _soft_time;
+  Tickspan _weak_time;
+  Tickspan _final_time;
+  Tickspan _phantom_time;
+
+  uint _soft_workers;
+  uint _weak_workers;
+  uint _final_workers;
+  uint _phantom_workers;
+
  public:
   ReferenceProcessorStats() :
     _soft_count(0),
     _weak_count(0),
     _final_count(0),
-    _phantom_count(0) {}
+    _phantom_count(0),
+    _soft_workers(0),
+    _weak_workers(0),
+    _final_workers(0),
+    _phantom_workers(0) {}
 
   ReferenceProcessorStats(size_t soft_count,
                           size_t weak_count,
@@ -51,9 +68,25 @@ class ReferenceProcessorStats {
     _soft_count(soft_count),
     _weak_count(weak_count),
     _final_count(final_count),
-    _phantom_count(phantom_count)
+    _phantom_count(phantom_count),
+    _soft_workers(0),
+    _weak_workers(0),
+    _final_workers(0),
+    _phantom_workers(0)
   {}
 
+  // Records the time spent on, and the largest number of workers used
+  // for, one reference type.
+  void set_phase(ReferenceType type, const Tickspan& time, uint workers) {
+    switch (type) {
+      case REF_SOFT:    _soft_time = time;    _soft_workers = workers;    break;
+      case REF_WEAK:    _weak_time = time;    _weak_workers = workers;    break;
+      case REF_FINAL:   _final_time = time;   _final_workers = workers;   break;
+      case REF_PHANTOM: _phantom_time = time; _phantom_workers = workers; break;
+      default: ShouldNotReachHere();
+    }
+  }
+
   size_t soft_count() const {
     return _soft_count;
   }
@@ -69,5 +102,25 @@ class ReferenceProcessorStats {
   size_t phantom_count() const {
     return _phantom_count;
   }
+
+  Tickspan time(ReferenceType type) const {
+    switch (type) {
+      case REF_SOFT:    return _soft_time;
+      case REF_WEAK:    return _weak_time;
+      case REF_FINAL:   return _final_time;
+      case REF_PHANTOM: return _phantom_time;
+      default: ShouldNotReachHere(); return Tickspan();
+    }
+  }
+
+  uint workers(ReferenceType type) const {
+    switch (type) {
+      case REF_SOFT:    return _soft_workers;
+      case REF_WEAK:    return _weak_workers;
+      case REF_FINAL:   return _final_workers;
+      case REF_PHANTOM: return _phantom_workers;
+      default: ShouldNotReachHere(); return 0;
+    }
+  }
 };
 #endif
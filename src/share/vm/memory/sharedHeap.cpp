@@ -32,6 +32,7 @@
 #include "runtime/atomic.inline.hpp"
 #include "runtime/fprofiler.hpp"
 #include "runtime/java.hpp"
+#include "runtime/jniHandles.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/workgroup.hpp"
 
@@ -90,6 +91,7 @@ SharedHeap::StrongRootsScope::StrongRootsScope(SharedHeap* heap, bool activate)
 {
   if (_active) {
     _sh->change_strong_roots_parity();
+    JNIHandles::change_claim_epoch();
     // Zero the claimed high water mark in the StringTable
     StringTable::clear_parallel_claimed_index();
   }
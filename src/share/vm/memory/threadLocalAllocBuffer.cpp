@@ -30,6 +30,10 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/copy.hpp"
+#if INCLUDE_JFR
+#include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#endif
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -76,6 +80,24 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
     print_stats("gc");
   }
 
+#if INCLUDE_JFR
+  if (_number_of_refills > 0) {
+    EventThreadTLABStatistics event;
+    if (event.should_commit()) {
+      event.set_thread(JFR_THREAD_ID(thread));
+      event.set_refills(_number_of_refills);
+      event.set_fastResizes(_fast_resizes);
+      event.set_desiredSize(desired_size() * HeapWordSize);
+      event.set_allocated(allocated_since_last_gc);
+      event.set_gcWaste(_gc_waste * HeapWordSize);
+      event.set_slowRefillWaste(_slow_refill_waste * HeapWordSize);
+      event.set_fastRefillWaste(_fast_refill_waste * HeapWordSize);
+      event.set_slowAllocations(_slow_allocations);
+      event.commit();
+    }
+  }
+#endif
+
   if (_number_of_refills > 0) {
     // Update allocation history if a reasonable amount of eden was allocated.
     bool update_allocation_history = used > 0.5 * capacity;
@@ -126,10 +148,11 @@ void ThreadLocalAllocBuffer::make_parsable(bool retire) {
       set_top(NULL);
       set_pf_top(NULL);
       set_end(NULL);
+      set_allocation_end(NULL);
     }
   }
   assert(!(retire || ZeroTLAB)  ||
-         (start() == NULL && end() == NULL && top() == NULL),
+         (start() == NULL && end() == NULL && allocation_end() == NULL && top() == NULL),
          "TLAB must be reset");
 }
 
@@ -162,12 +185,56 @@ void ThreadLocalAllocBuffer::resize() {
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+// Refills between two checks of the refill rate.
+static const unsigned refill_rate_check_interval = 4;
+
+void ThreadLocalAllocBuffer::resize_from_refill_rate() {
+  assert(TLABFastResize && ResizeTLAB, "Should not call this otherwise");
+  if (_number_of_refills - _refills_at_last_rate_check < refill_rate_check_interval) {
+    return;
+  }
+  _refills_at_last_rate_check = _number_of_refills;
+
+  Thread* thread = myThread();
+  size_t capacity = Universe::heap()->tlab_capacity(thread);
+  if (capacity == 0) {
+    return;
+  }
+  // A thread whose desired size matches its share of the allocation
+  // refills target_refills() times per filled eden, so about
+  // target_refills() * used / capacity times by now. Grow the TLAB of a
+  // thread that refills at more than twice that rate.
+  size_t used = Universe::heap()->tlab_used(thread);
+  double expected_refills = (double) _target_refills * used / capacity;
+  if (_number_of_refills <= 2.0 * expected_refills + refill_rate_check_interval) {
+    return;
+  }
+  // Never beyond the size resize() would pick if the thread did all the
+  // allocation.
+  size_t limit = MIN2(max_size(), align_object_size(capacity / HeapWordSize / _target_refills));
+  size_t new_size = align_object_size(MIN2(desired_size() * 2, limit));
+  if (new_size <= desired_size()) {
+    return;
+  }
+
+  if (PrintTLAB && Verbose) {
+    gclog_or_tty->print("TLAB fast resize: thread: " INTPTR_FORMAT " [id: %2d]"
+                        " refills %d  expected: %4.1f desired_size: " SIZE_FORMAT " -> " SIZE_FORMAT "\n",
+                        thread, thread->osthread()->thread_id(),
+                        _number_of_refills, expected_refills, desired_size(), new_size);
+  }
+  _fast_resizes++;
+  set_desired_size(new_size);
+}
+
 void ThreadLocalAllocBuffer::initialize_statistics() {
     _number_of_refills = 0;
     _fast_refill_waste = 0;
     _slow_refill_waste = 0;
     _gc_waste          = 0;
     _slow_allocations  = 0;
+    _fast_resizes      = 0;
+    _refills_at_last_rate_check = 0;
 }
 
 void ThreadLocalAllocBuffer::fill(HeapWord* start,
@@ -177,6 +244,9 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
   if (PrintTLAB && Verbose) {
     print_stats("fill");
   }
+  if (TLABFastResize && ResizeTLAB) {
+    resize_from_refill_rate();
+  }
   assert(top <= start + new_size - alignment_reserve(), "size too small");
   initialize(start, top, start + new_size - alignment_reserve());
 
@@ -191,6 +261,19 @@ void ThreadLocalAllocBuffer::initialize(HeapWord* start,
   set_top(top);
   set_pf_top(top);
   set_end(end);
+  set_allocation_end(end);
+  invariants();
+}
+
+void ThreadLocalAllocBuffer::set_sample_end(size_t bytes_until_sample) {
+  set_back_allocation_end();
+  if (top() == NULL) {
+    return;
+  }
+  size_t words_until_sample = bytes_until_sample / HeapWordSize;
+  if (free() > words_until_sample) {
+    set_end(top() + words_until_sample);
+  }
   invariants();
 }
 
@@ -270,7 +353,7 @@ void ThreadLocalAllocBuffer::print_stats(const char* tag) {
                       " desired_size: " SIZE_FORMAT "KB"
                       " slow allocs: %d  refill waste: " SIZE_FORMAT "B"
                       " alloc:%8.5f %8.0fKB refills: %d waste %4.1f%% gc: %dB"
-                      " slow: %dB fast: %dB\n",
+                      " slow: %dB fast: %dB fast resizes: %d\n",
                       tag, thrd, thrd->osthread()->thread_id(),
                       _desired_size / (K / HeapWordSize),
                       _slow_allocations, _refill_waste_limit * HeapWordSize,
@@ -279,7 +362,8 @@ void ThreadLocalAllocBuffer::print_stats(const char* tag) {
                       _number_of_refills, waste_percent,
                       _gc_waste * HeapWordSize,
                       _slow_refill_waste * HeapWordSize,
-                      _fast_refill_waste * HeapWordSize);
+                      _fast_refill_waste * HeapWordSize,
+                      _fast_resizes);
 }
 
 void ThreadLocalAllocBuffer::verify() {
@@ -46,7 +46,8 @@ private:
   HeapWord* _start;                              // address of TLAB
   HeapWord* _top;                                // address after last allocation
   HeapWord* _pf_top;                             // allocation prefetch watermark
-  HeapWord* _end;                                // allocation end (excluding alignment_reserve)
+  HeapWord* _end;                                // allocation end (excluding alignment_reserve), may be a sample point
+  HeapWord* _allocation_end;                     // end of the TLAB for allocations (excluding alignment_reserve)
   size_t    _desired_size;                       // desired size   (including alignment_reserve)
   size_t    _refill_waste_limit;                 // hold onto tlab if free() is larger than this
   size_t    _allocated_before_last_gc;           // total bytes allocated up until the last gc
@@ -59,6 +60,8 @@ private:
   unsigned  _slow_refill_waste;
   unsigned  _gc_waste;
   unsigned  _slow_allocations;
+  unsigned  _fast_resizes;                       // desired size increases since the last GC
+  unsigned  _refills_at_last_rate_check;         // _number_of_refills at the last refill rate check
 
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
 
@@ -67,6 +70,7 @@ private:
 
   void set_start(HeapWord* start)                { _start = start; }
   void set_end(HeapWord* end)                    { _end = end; }
+  void set_allocation_end(HeapWord* end)         { _allocation_end = end; }
   void set_top(HeapWord* top)                    { _top = top; }
   void set_pf_top(HeapWord* pf_top)              { _pf_top = pf_top; }
   void set_desired_size(size_t desired_size)     { _desired_size = desired_size; }
@@ -85,7 +89,11 @@ private:
   // Resize based on amount of allocation, etc.
   void resize();
 
-  void invariants() const { assert(top() >= start() && top() <= end(), "invalid tlab"); }
+  // Grow the desired size between GCs if the thread refills faster than
+  // the eden consumed since the last GC predicts (TLABFastResize).
+  void resize_from_refill_rate();
+
+  void invariants() const { assert(top() >= start() && top() <= end() && end() <= allocation_end(), "invalid tlab"); }
 
   void initialize(HeapWord* start, HeapWord* top, HeapWord* end);
 
@@ -100,6 +108,7 @@ private:
   int slow_refill_waste() const { return _slow_refill_waste; }
   int gc_waste() const          { return _gc_waste; }
   int slow_allocations() const  { return _slow_allocations; }
+  int fast_resizes() const      { return _fast_resizes; }
 
   static GlobalTLABStats* _global_stats;
   static GlobalTLABStats* global_stats() { return _global_stats; }
@@ -122,13 +131,14 @@ public:
 
   HeapWord* start() const                        { return _start; }
   HeapWord* end() const                          { return _end; }
-  HeapWord* hard_end() const                     { return _end + alignment_reserve(); }
+  HeapWord* allocation_end() const               { return _allocation_end; }
+  HeapWord* hard_end() const                     { return _allocation_end + alignment_reserve(); }
   HeapWord* top() const                          { return _top; }
   HeapWord* pf_top() const                       { return _pf_top; }
   size_t desired_size() const                    { return _desired_size; }
   size_t used() const                            { return pointer_delta(top(), start()); }
   size_t used_bytes() const                      { return pointer_delta(top(), start(), 1); }
-  size_t free() const                            { return pointer_delta(end(), top()); }
+  size_t free() const                            { return pointer_delta(allocation_end(), top()); }
   // Don't discard tlab if remaining space is larger than this.
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
   size_t hard_size_bytes() const                 { return pointer_delta(hard_end(), start(), 1); }
@@ -169,6 +179,13 @@ public:
   static void resize_all_tlabs();
 
   void fill(HeapWord* start, HeapWord* top, size_t new_size);
+
+  // Allocation sampling: end() is lowered to a sample point inside the
+  // TLAB so that the allocation crossing it fails the inlined fast paths
+  // and reaches the runtime, where the sample is taken.
+  bool reached_sample_point() const              { return end() < allocation_end(); }
+  void set_sample_end(size_t bytes_until_sample);
+  void set_back_allocation_end()                 { set_end(allocation_end()); }
   void initialize();
 
   static size_t refill_waste_limit_increment()   { return TLABWasteIncrement; }
@@ -1222,6 +1222,13 @@ void Universe::flush_dependents_on(instanceKlassHandle dependee) {
   // Compute the dependent nmethods
   if (CodeCache::mark_for_deoptimization(changes) > 0) {
     // At least one nmethod has been marked for deoptimization
+    if (BatchDependentDeoptimization) {
+      // The marked code stays correct until an instance of dependee can
+      // exist, i.e. until dependee gets initialized. Leave it to the next
+      // safepoint or InstanceKlass::initialize, whichever comes first.
+      Deoptimization::set_pending_dependents();
+      return;
+    }
     VM_Deoptimize op;
     VMThread::execute(&op);
   }
@@ -37,6 +37,7 @@
 #include "oops/constantPool.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/objArrayKlass.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/fieldType.hpp"
 #include "runtime/init.hpp"
 #include "runtime/javaCalls.hpp"
@@ -243,6 +244,18 @@ int ConstantPool::cp_to_object_index(int cp_index) {
   return (i < 0) ? _no_index_sentinel : i;
 }
 
+void ConstantPool::klass_at_put_if_unresolved(int which, CPSlot unresolved, Klass* k) {
+  assert(k != NULL, "resolved class shouldn't be null");
+  assert(is_within_bounds(which), "index out of bounds");
+  assert(unresolved.is_unresolved(), "must be the unresolved entry");
+  if (Atomic::cmpxchg_ptr((intptr_t)k, obj_at_addr_raw(which), unresolved.value()) == unresolved.value()) {
+    // The interpreter assumes when the tag is stored, the klass is resolved
+    // and the Klass* is a klass rather than a Symbol*, so the cmpxchg
+    // orders the slot before the tag.
+    release_tag_at_put(which, JVM_CONSTANT_Class);
+  }
+}
+
 Klass* ConstantPool::klass_at_impl(constantPoolHandle this_oop, int which, TRAPS) {
   // A resolved constantPool entry will contain a Klass*, otherwise a Symbol*.
   // It is not safe to rely on the tag bit's here, since we don't have a lock, and the entry and
@@ -255,8 +268,8 @@ Klass* ConstantPool::klass_at_impl(constantPoolHandle this_oop, int which, TRAPS
     return entry.get_klass();
   }
 
-  // Acquire lock on constant oop while doing update. After we get the lock, we check if another object
-  // already has updated the object
+  // Resolve without holding the cp lock and publish the result with a CAS on
+  // the slot. Only recording a resolution error takes the lock.
   assert(THREAD->is_Java_thread(), "must be a Java thread");
   bool do_resolve = false;
   bool in_error = false;
@@ -265,20 +278,18 @@ Klass* ConstantPool::klass_at_impl(constantPoolHandle this_oop, int which, TRAPS
   // until the loader_data is registered.
   Handle mirror_handle;
 
+  // The slot read above still holds the name. The tag only moves from
+  // unresolved to in-error (under the lock) or to resolved (after the slot),
+  // so it can be read without the lock.
   Symbol* name = NULL;
   Handle       loader;
-  {  MonitorLockerEx ml(this_oop->lock());
-
-    if (this_oop->tag_at(which).is_unresolved_klass()) {
-      if (this_oop->tag_at(which).is_unresolved_klass_in_error()) {
-        in_error = true;
-      } else {
-        do_resolve = true;
-        name   = this_oop->unresolved_klass_at(which);
-        loader = Handle(THREAD, this_oop->pool_holder()->class_loader());
-      }
-    }
-  } // unlocking constantPool
+  if (this_oop->tag_at(which).is_unresolved_klass_in_error()) {
+    in_error = true;
+  } else {
+    do_resolve = true;
+    name   = entry.get_symbol();
+    loader = Handle(THREAD, this_oop->pool_holder()->class_loader());
+  }
 
 
   // The original attempt to resolve this constant pool entry failed so find the
@@ -312,7 +323,7 @@ Klass* ConstantPool::klass_at_impl(constantPoolHandle this_oop, int which, TRAPS
         MonitorLockerEx ml(this_oop->lock());
 
         // some other thread has beaten us and has resolved the class.
-        if (this_oop->tag_at(which).is_klass()) {
+        if (this_oop->slot_at(which).is_resolved()) {
           CLEAR_PENDING_EXCEPTION;
           entry = this_oop->resolved_klass_at(which);
           return entry.get_klass();
@@ -354,12 +365,9 @@ Klass* ConstantPool::klass_at_impl(constantPoolHandle this_oop, int which, TRAPS
       }
       return k();
     } else {
-      MonitorLockerEx ml(this_oop->lock());
-      // Only updated constant pool - if it is resolved.
-      do_resolve = this_oop->tag_at(which).is_unresolved_klass();
-      if (do_resolve) {
-        this_oop->klass_at_put(which, k());
-      }
+      // Only update the constant pool if it is still unresolved. Racing
+      // threads resolved the same class, so whoever wins the CAS is fine.
+      this_oop->klass_at_put_if_unresolved(which, entry, k());
     }
   }
 
@@ -671,7 +679,8 @@ void ConstantPool::save_and_throw_exception(constantPoolHandle this_oop, int whi
   } else if (this_oop->tag_at(which).value() != error_tag) {
     Symbol* message = exception_message(this_oop, which, tag, PENDING_EXCEPTION);
     SystemDictionary::add_resolution_error(this_oop, which, error, message);
-    this_oop->tag_at_put(which, error_tag);
+    // Readers check the tag without the lock, after the error is recorded
+    this_oop->release_tag_at_put(which, error_tag);
   } else {
     // some other thread put this in error state
     throw_resolution_error(this_oop, which, CHECK);
@@ -817,20 +826,17 @@ oop ConstantPool::resolve_constant_at_impl(constantPoolHandle this_oop, int inde
 
   if (cache_index >= 0) {
     // Cache the oop here also.
-    Handle result_handle(THREAD, result_oop);
-    MonitorLockerEx ml(this_oop->lock());  // don't know if we really need this
-    oop result = this_oop->resolved_references()->obj_at(cache_index);
-    // Benign race condition:  resolved_references may already be filled in while we were trying to lock.
-    // The important thing here is that all threads pick up the same result.
-    // It doesn't matter which racing thread wins, as long as only one
-    // result is used by all threads, and all future queries.
-    // That result may be either a resolved constant or a failure exception.
+    // Benign race condition:  resolved_references may already be filled in by
+    // another thread. The important thing here is that all threads pick up the
+    // same result. It doesn't matter which racing thread wins, as long as only one
+    // result is used by all threads, and all future queries. The winner is
+    // published with a CAS, so racing threads never block each other here.
+    oop result = this_oop->resolved_references()->atomic_compare_exchange_oop(cache_index, result_oop, NULL);
     if (result == NULL) {
-      this_oop->resolved_references()->obj_at_put(cache_index, result_handle());
-      return result_handle();
+      return result_oop;
     } else {
       // Return the winning thread's result.  This can be different than
-      // result_handle() for MethodHandles.
+      // result_oop for MethodHandles.
       return result;
     }
   } else {
@@ -890,9 +896,10 @@ oop ConstantPool::string_at_impl(constantPoolHandle this_oop, int which, int obj
   if (str != NULL) return str;
   Symbol* sym = this_oop->unresolved_string_at(which);
   str = StringTable::intern(sym, CHECK_(NULL));
-  this_oop->string_at_put(which, obj_index, str);
   assert(java_lang_String::is_instance(str), "must be string");
-  return str;
+  // Racing threads intern the same string; the first one publishes it
+  oop old = this_oop->resolved_references()->atomic_compare_exchange_oop(obj_index, str, NULL);
+  return old != NULL ? old : str;
 }
 
 
@@ -273,6 +273,10 @@ class ConstantPool : public Metadata {
     release_tag_at_put(which, JVM_CONSTANT_Class);
   }
 
+  // Publishes k if the slot still holds the unresolved entry; used by
+  // klass_at_impl so that racing resolvers do not need the cp lock
+  void klass_at_put_if_unresolved(int which, CPSlot unresolved, Klass* k);
+
   // For temporary use while constructing constant pool
   void klass_index_at_put(int which, int name_index) {
     tag_at_put(which, JVM_CONSTANT_ClassIndex);
@@ -55,6 +55,7 @@
 #include "prims/jvmtiThreadState.hpp"
 #include "prims/methodComparator.hpp"
 #include "runtime/coroutine.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/fieldDescriptor.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
@@ -272,6 +273,7 @@ InstanceKlass::InstanceKlass(int vtable_len,
 
   set_vtable_length(vtable_len);
   set_itable_length(itable_len);
+  set_itable_hash_offset(0);
   set_static_field_size(static_field_size);
   set_nonstatic_oop_map_size(nonstatic_oop_map_size);
   set_access_flags(access_flags);
@@ -444,6 +446,13 @@ void InstanceKlass::deallocate_contents(ClassLoaderData* loader_data) {
       !secondary_supers()->is_shared()) {
     MetadataFactory::free_array<Klass*>(loader_data, secondary_supers());
   }
+  if (secondary_supers_table() != NULL &&
+      secondary_supers_table() != secondary_supers() &&
+      !secondary_supers_table()->is_shared()) {
+    MetadataFactory::free_array<Klass*>(loader_data, secondary_supers_table());
+  }
+  _secondary_supers_table = NULL;
+  _secondary_supers_bitmap = SECONDARY_SUPERS_BITMAP_FULL;
   set_secondary_supers(NULL);
 
   deallocate_interfaces(loader_data, super(), local_interfaces(), transitive_interfaces());
@@ -508,6 +517,9 @@ void InstanceKlass::eager_initialize(Thread *thread) {
     // abort if the super class should be initialized
     if (!InstanceKlass::cast(super)->is_initialized()) return;
 
+    // abort if invalidated code still waits for deoptimization, initialize() flushes it
+    if (Deoptimization::has_pending_dependents()) return;
+
     // call body to expose the this pointer
     instanceKlassHandle this_oop(thread, this);
     eager_initialize_impl(this_oop);
@@ -586,6 +598,9 @@ void InstanceKlass::eager_initialize_impl(instanceKlassHandle this_oop) {
 // Note: implementation moved to static method to expose the this pointer.
 void InstanceKlass::initialize(TRAPS) {
   if (this->should_be_initialized()) {
+    // Code invalidated by class loads must be gone before the first
+    // instance of any of the new classes is created
+    Deoptimization::flush_pending_dependents();
     HandleMark hm(THREAD);
     instanceKlassHandle this_oop(THREAD, this);
     initialize_impl(this_oop, CHECK);
@@ -261,6 +261,7 @@ class InstanceKlass: public Klass {
   Thread*         _init_thread;          // Pointer to current thread doing initialization (to handle recursive initialization)
   int             _vtable_len;           // length of Java vtable (in words)
   int             _itable_len;           // length of Java itable (in words)
+  int             _itable_hash_offset;   // byte offset from the klass to the hashed itable index, 0 if none
   OopMapCache*    volatile _oop_map_cache;   // OopMapCache for all methods in the klass (allocated lazily)
   MemberNameTable* _member_names;        // Member names
   JNIid*          _jni_ids;              // First JNI identifier for static fields in this class
@@ -366,6 +367,9 @@ class InstanceKlass: public Klass {
   // Java itable
   int  itable_length() const               { return _itable_len; }
   void set_itable_length(int len)          { _itable_len = len; }
+  int  itable_hash_offset() const          { return _itable_hash_offset; }
+  void set_itable_hash_offset(int offset)  { _itable_hash_offset = offset; }
+  static ByteSize itable_hash_offset_offset() { return in_ByteSize(offset_of(InstanceKlass, _itable_hash_offset)); }
 
   // array klasses
   Klass* array_klasses() const             { return _array_klasses; }
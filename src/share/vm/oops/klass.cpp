@@ -66,6 +66,9 @@ void Klass::set_is_cloneable() {
 void Klass::set_name(Symbol* n) {
   _name = n;
   if (_name != NULL) _name->increment_refcount();
+  // The slot must be stable before any subtype hashes this klass into its
+  // secondary supers table, and every klass is named before it has subtypes.
+  _hash_slot = (_name == NULL) ? 0 : (u1)(_name->identity_hash() & (secondary_supers_table_size - 1));
 }
 
 bool Klass::is_subclass_of(const Klass* k) const {
@@ -88,6 +91,13 @@ bool Klass::search_secondary_supers(Klass* k) const {
   // This is necessary, since I am never in my own secondary_super list.
   if (this == k)
     return true;
+  if (UseSecondarySupersTable) {
+    if (_secondary_supers_bitmap != SECONDARY_SUPERS_BITMAP_FULL) {
+      return lookup_secondary_supers_table(k);
+    }
+    // No table; scan, but leave the shared cache line alone.
+    return secondary_supers()->contains(k);
+  }
   // Scan the array-of-objects for a match
   int cnt = secondary_supers()->length();
   for (int i = 0; i < cnt; i++) {
@@ -99,6 +109,65 @@ bool Klass::search_secondary_supers(Klass* k) const {
   return false;
 }
 
+// The table is sorted by hash slot, so the entries for slot s cannot
+// start before index (number of bitmap bits at or below s) - 1: every
+// occupied lower slot holds at least one entry. A clear bit answers a
+// negative query without touching the table.
+bool Klass::lookup_secondary_supers_table(Klass* k) const {
+  int slot = k->hash_slot();
+  uintx bits = _secondary_supers_bitmap << (secondary_supers_table_size - 1 - slot);
+  if ((intx)bits >= 0) {
+    return false;
+  }
+  int index = -1;
+  for (; bits != 0; bits &= bits - 1) {
+    index++;
+  }
+  Array<Klass*>* table = _secondary_supers_table;
+  for (int i = index; i < table->length(); i++) {
+    Klass* s = table->at(i);
+    if (s == k) {
+      return true;
+    }
+    if (s->hash_slot() > slot) {
+      break;
+    }
+  }
+  return false;
+}
+
+void Klass::initialize_secondary_supers_table(TRAPS) {
+  if (!UseSecondarySupersTable) {
+    return;
+  }
+  Array<Klass*>* supers = secondary_supers();
+  int length = supers->length();
+  for (int i = 0; i < length; i++) {
+    if (supers->at(i) == NULL) {
+      // Bootstrap placeholder (see Universe::genesis); keep scanning.
+      return;
+    }
+  }
+  Array<Klass*>* table = supers;
+  uintx bitmap = 0;
+  if (length > 0) {
+    table = MetadataFactory::new_array<Klass*>(class_loader_data(), length, CHECK);
+    // Insertion sort by hash slot; classes rarely have many interfaces.
+    for (int i = 0; i < length; i++) {
+      Klass* s = supers->at(i);
+      int j = i;
+      while (j > 0 && table->at(j - 1)->hash_slot() > s->hash_slot()) {
+        table->at_put(j, table->at(j - 1));
+        j--;
+      }
+      table->at_put(j, s);
+      bitmap |= (uintx)1 << s->hash_slot();
+    }
+  }
+  _secondary_supers_table = table;
+  _secondary_supers_bitmap = bitmap;
+}
+
 // Return self, except for abstract classes with exactly 1
 // implementor.  Then return the 1 concrete implementation.
 Klass *Klass::up_cast_abstract() {
@@ -181,6 +250,8 @@ Klass::Klass() {
   }
   set_secondary_supers(NULL);
   set_secondary_super_cache(NULL);
+  _secondary_supers_bitmap = SECONDARY_SUPERS_BITMAP_FULL;
+  _secondary_supers_table = NULL;
   _primary_supers[0] = k;
   set_super_check_offset(in_bytes(primary_supers_offset()));
 
@@ -202,6 +273,7 @@ Klass::Klass() {
 
   set_prototype_header(markOopDesc::prototype());
   set_biased_lock_revocation_count(0);
+  set_biased_lock_bulk_rebias_count(0);
   set_last_biased_lock_bulk_revocation_time(0);
 
   // The klass doesn't have any references at this point.
@@ -311,6 +383,7 @@ void Klass::initialize_supers(Klass* k, TRAPS) {
     GrowableArray<Klass*>* secondaries = compute_secondary_supers(extras);
     if (secondaries == NULL) {
       // secondary_supers set by compute_secondary_supers
+      this_kh->initialize_secondary_supers_table(CHECK);
       return;
     }
 
@@ -355,6 +428,7 @@ void Klass::initialize_supers(Klass* k, TRAPS) {
   #endif
 
     this_kh->set_secondary_supers(s2);
+    this_kh->initialize_secondary_supers_table(CHECK);
   }
 }
 
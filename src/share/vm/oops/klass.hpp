@@ -80,6 +80,7 @@
 //    [last_biased_lock_bulk_revocation_time] (64 bits)
 //    [prototype_header]
 //    [biased_lock_revocation_count]
+//    [biased_lock_bulk_rebias_count]
 //    [_modified_oops]
 //    [_accumulated_modified_oops]
 //    [trace_id]
@@ -137,6 +138,10 @@ class Klass : public Metadata {
   // secondary supers, else is &_primary_supers[depth()].
   juint       _super_check_offset;
 
+  // Slot of this klass in the secondary supers bitmap of its subtypes,
+  // derived from the identity hash of its name.
+  u1          _hash_slot;
+
   // Class name.  Instance classes: java/lang/String, etc.  Array classes: [I,
   // [Ljava/lang/String;, etc.  Set to zero for all other kinds of classes.
   Symbol*     _name;
@@ -145,6 +150,12 @@ class Klass : public Metadata {
   Klass*      _secondary_super_cache;
   // Array of all secondary supertypes
   Array<Klass*>* _secondary_supers;
+  // Hashed view of _secondary_supers for UseSecondarySupersTable: bit i
+  // of the bitmap is set iff some secondary super has hash slot i, and
+  // the table holds the secondary supers sorted by hash slot. A full
+  // bitmap means there is no table and the array must be scanned.
+  uintx          _secondary_supers_bitmap;
+  Array<Klass*>* _secondary_supers_table;
   // Ordered list of all primary supertypes
   Klass*      _primary_supers[_primary_super_limit];
   // java/lang/Class instance mirroring this class
@@ -171,6 +182,7 @@ class Klass : public Metadata {
   jlong    _last_biased_lock_bulk_revocation_time;
   markOop  _prototype_header;   // Used when biased locking is both enabled and disabled for this type
   jint     _biased_lock_revocation_count;
+  jint     _biased_lock_bulk_rebias_count; // Recent bulk rebiases, scales down the bulk thresholds
 
   JFR_ONLY(DEFINE_TRACE_ID_FIELD;)
 
@@ -225,6 +237,16 @@ protected:
   Array<Klass*>* secondary_supers() const { return _secondary_supers; }
   void set_secondary_supers(Array<Klass*>* k) { _secondary_supers = k; }
 
+  enum { secondary_supers_table_size = BitsPerWord };
+  static const uintx SECONDARY_SUPERS_BITMAP_FULL = ~(uintx)0;
+
+  uintx secondary_supers_bitmap() const          { return _secondary_supers_bitmap; }
+  Array<Klass*>* secondary_supers_table() const  { return _secondary_supers_table; }
+  int hash_slot() const                          { return _hash_slot; }
+
+  // builds the hashed view of secondary_supers() when UseSecondarySupersTable
+  void initialize_secondary_supers_table(TRAPS);
+
   // Return the element of the _super chain of the given depth.
   // If there is no such element, return either NULL or this.
   Klass* primary_super_of_depth(juint i) const {
@@ -320,6 +342,9 @@ protected:
   static ByteSize primary_supers_offset()        { return in_ByteSize(offset_of(Klass, _primary_supers)); }
   static ByteSize secondary_super_cache_offset() { return in_ByteSize(offset_of(Klass, _secondary_super_cache)); }
   static ByteSize secondary_supers_offset()      { return in_ByteSize(offset_of(Klass, _secondary_supers)); }
+  static ByteSize secondary_supers_bitmap_offset() { return in_ByteSize(offset_of(Klass, _secondary_supers_bitmap)); }
+  static ByteSize secondary_supers_table_offset()  { return in_ByteSize(offset_of(Klass, _secondary_supers_table)); }
+  static ByteSize hash_slot_offset()             { return in_ByteSize(offset_of(Klass, _hash_slot)); }
   static ByteSize java_mirror_offset()           { return in_ByteSize(offset_of(Klass, _java_mirror)); }
   static ByteSize modifier_flags_offset()        { return in_ByteSize(offset_of(Klass, _modifier_flags)); }
   static ByteSize layout_helper_offset()         { return in_ByteSize(offset_of(Klass, _layout_helper)); }
@@ -446,6 +471,7 @@ protected:
     }
   }
   bool search_secondary_supers(Klass* k) const;
+  bool lookup_secondary_supers_table(Klass* k) const;
 
   // Find LCA in class hierarchy
   Klass *LCA( Klass *k );
@@ -612,6 +638,8 @@ protected:
   // Atomically increments biased_lock_revocation_count and returns updated value
   int atomic_incr_biased_lock_revocation_count();
   void set_biased_lock_revocation_count(int val) { _biased_lock_revocation_count = (jint) val; }
+  int  biased_lock_bulk_rebias_count() const { return (int) _biased_lock_bulk_rebias_count; }
+  void set_biased_lock_bulk_rebias_count(int val) { _biased_lock_bulk_rebias_count = (jint) val; }
   jlong last_biased_lock_bulk_revocation_time() { return _last_biased_lock_bulk_revocation_time; }
   void  set_last_biased_lock_bulk_revocation_time(jlong cur_time) { _last_biased_lock_bulk_revocation_time = cur_time; }
 
@@ -160,6 +160,35 @@ int klassVtable::initialize_from_super(KlassHandle super) {
   }
 }
 
+unsigned int VtableNameSigIndex::hash(Symbol* name, Symbol* signature) {
+  return (unsigned int)name->identity_hash() * 31 + (unsigned int)signature->identity_hash();
+}
+
+VtableNameSigIndex::VtableNameSigIndex(klassVtable* vtable, int length) {
+  int buckets = 1;
+  while (buckets < length) {
+    buckets <<= 1;
+  }
+  _mask = buckets - 1;
+  _buckets = NEW_RESOURCE_ARRAY(int, buckets);
+  _next = NEW_RESOURCE_ARRAY(int, MAX2(length, 1));
+  for (int b = 0; b < buckets; b++) {
+    _buckets[b] = -1;
+  }
+  // Insert from the end so that each bucket lists its entries in ascending
+  // order, the order in which update_inherited_vtable used to visit them
+  for (int i = length - 1; i >= 0; i--) {
+    Method* m = vtable->unchecked_method_at(i);
+    if (m == NULL) {
+      _next[i] = -1;
+      continue;
+    }
+    unsigned int b = hash(m->name(), m->signature()) & _mask;
+    _next[i] = _buckets[b];
+    _buckets[b] = i;
+  }
+}
+
 //
 // Revised lookup semantics   introduced 1.3 (Kestrel beta)
 void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
@@ -198,6 +227,13 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
     int len = methods->length();
     int initialized = super_vtable_len;
 
+    // Overrides only replace entries with the same name and signature, so
+    // the index over the inherited entries stays valid while they change.
+    // A shared class reads its inherited entries from the super's vtable.
+    ResourceMark rm(THREAD);
+    klassVtable* super_entries = is_preinitialized_vtable() && super_vtable_len > 0 ? super->vtable() : this;
+    VtableNameSigIndex* super_index = new VtableNameSigIndex(super_entries, super_vtable_len);
+
     // Check each of this class's methods against super;
     // if override, replace in copy of super vtable, otherwise append to end
     for (int i = 0; i < len; i++) {
@@ -206,7 +242,7 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
       assert(methods->at(i)->is_method(), "must be a Method*");
       methodHandle mh(THREAD, methods->at(i));
 
-      bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, -1, checkconstraints, CHECK);
+      bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, -1, super_index, checkconstraints, CHECK);
 
       if (needs_new_entry) {
         put_method_at(mh(), initialized);
@@ -232,7 +268,7 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
           assert(default_methods->at(i)->is_method(), "must be a Method*");
           methodHandle mh(THREAD, default_methods->at(i));
 
-          bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, i, checkconstraints, CHECK);
+          bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, i, super_index, checkconstraints, CHECK);
 
           // needs new entry
           if (needs_new_entry) {
@@ -340,6 +376,7 @@ InstanceKlass* klassVtable::find_transitive_override(InstanceKlass* initialsuper
 // If that changed, could not use _klass as handle for klass
 bool klassVtable::update_inherited_vtable(InstanceKlass* klass, methodHandle target_method,
                                           int super_vtable_len, int default_index,
+                                          const VtableNameSigIndex* super_index,
                                           bool checkconstraints, TRAPS) {
   ResourceMark rm;
   bool allocate_new = true;
@@ -420,7 +457,7 @@ bool klassVtable::update_inherited_vtable(InstanceKlass* klass, methodHandle tar
   Handle target_loader(THREAD, target_klass->class_loader());
 
   Symbol* target_classname = target_klass->name();
-  for(int i = 0; i < super_vtable_len; i++) {
+  for (int i = super_index->first(name, signature); i != -1; i = super_index->next(i)) {
     Method* super_method;
     if (is_preinitialized_vtable()) {
       // If this is a shared class, the vtable is already in the final state (fully
@@ -1085,7 +1122,9 @@ klassItable::klassItable(instanceKlassHandle klass) {
     if (offset_entry  != NULL && offset_entry->interface_klass() != NULL) { // Check that itable is initialized
       // First offset entry points to the first method_entry
       intptr_t* method_entry  = (intptr_t *)(((address)klass()) + offset_entry->offset());
-      intptr_t* end         = klass->end_of_itable();
+      intptr_t* end         = klass->itable_hash_offset() != 0 ?
+                              (intptr_t*)(((address)klass()) + klass->itable_hash_offset()) :
+                              klass->end_of_itable();
 
       _table_offset      = (intptr_t*)offset_entry - (intptr_t*)klass();
       _size_offset_table = (method_entry - ((intptr_t*)offset_entry)) / itableOffsetEntry::size();
@@ -1461,7 +1500,8 @@ int klassItable::compute_itable_size(Array<Klass*>* transitive_interfaces) {
   visit_all_interfaces(transitive_interfaces, &cic);
 
   // There's alway an extra itable entry so we can null-terminate it.
-  int itable_size = calc_itable_size(cic.nof_interfaces() + 1, cic.nof_methods());
+  int itable_size = calc_itable_size(cic.nof_interfaces() + 1, cic.nof_methods()) +
+                    calc_itable_hash_size(cic.nof_interfaces());
 
   // Statistics
   update_stats(itable_size * HeapWordSize);
@@ -1484,14 +1524,15 @@ void klassItable::setup_itable_offset_table(instanceKlassHandle klass) {
   // Add one extra entry so we can null-terminate the table
   nof_interfaces++;
 
+  int hash_size = calc_itable_hash_size(nof_interfaces - 1);
   assert(compute_itable_size(klass->transitive_interfaces()) ==
-         calc_itable_size(nof_interfaces, nof_methods),
+         calc_itable_size(nof_interfaces, nof_methods) + hash_size,
          "mismatch calculation of itable size");
 
   // Fill-out offset table
   itableOffsetEntry* ioe = (itableOffsetEntry*)klass->start_of_itable();
   itableMethodEntry* ime = (itableMethodEntry*)(ioe + nof_interfaces);
-  intptr_t* end               = klass->end_of_itable();
+  intptr_t* end               = klass->end_of_itable() - hash_size;
   assert((oop*)(ime + nof_methods) <= (oop*)klass->start_of_nonstatic_oop_maps(), "wrong offset calculation (1)");
   assert((oop*)(end) == (oop*)(ime + nof_methods),                      "wrong offset calculation (2)");
 
@@ -1501,9 +1542,50 @@ void klassItable::setup_itable_offset_table(instanceKlassHandle klass) {
 
 #ifdef ASSERT
   ime  = sic.method_entry();
-  oop* v = (oop*) klass->end_of_itable();
+  oop* v = (oop*) end;
   assert( (oop*)(ime) == v, "wrong offset calculation (2)");
 #endif
+
+  if (hash_size > 0) {
+    // Fill-out the hashed index behind the method table. It has at least
+    // twice as many slots as interfaces, so a probe always hits either
+    // the interface or an empty slot.
+    intptr_t* area = end;
+    int slots = (hash_size - 1) / itableOffsetEntry::size();
+    intptr_t mask = (intptr_t)(slots - 1) * itableOffsetEntry::size();
+    area[0] = mask;
+    itableOffsetEntry* first_slot = (itableOffsetEntry*)(area + 1);
+    for (int i = 0; i < slots; i++) {
+      first_slot[i].initialize(NULL, 0);
+    }
+    for (int i = 0; i < nof_interfaces - 1; i++) {
+      Klass* intf = ioe[i].interface_klass();
+      int index = hash_index(intf, mask);
+      while (((itableOffsetEntry*)(area + 1 + index))->interface_klass() != NULL) {
+        index = (int)((index + itableOffsetEntry::size()) & mask);
+      }
+      ((itableOffsetEntry*)(area + 1 + index))->initialize(intf, ioe[i].offset());
+    }
+    klass->set_itable_hash_offset((int)((address)area - (address)klass()));
+  }
+}
+
+// Size in words of the hashed itable index for a class implementing
+// num_interfaces interfaces, 0 if the class does not get one.
+int klassItable::calc_itable_hash_size(int num_interfaces) {
+#ifdef AMD64
+  if (ItableHashMinInterfaces == 0 || num_interfaces < (int)ItableHashMinInterfaces) {
+    return 0;
+  }
+  int slots = 1;
+  while (slots < 2 * num_interfaces) {
+    slots <<= 1;
+  }
+  return 1 + slots * itableOffsetEntry::size();
+#else
+  // Only the x86_64 itable stubs probe the hashed index.
+  return 0;
+#endif
 }
 
 
@@ -41,6 +41,28 @@
 
 class vtableEntry;
 
+// Hashed index from name and signature to the entries of a vtable prefix.
+// Built once per initialize_vtable over the entries inherited from the
+// super class, so that each method of the class only visits the super
+// entries it may override instead of scanning the whole super vtable.
+// Lives in the resource area for the duration of the vtable setup.
+class VtableNameSigIndex : public ResourceObj {
+  int  _mask;       // number of buckets - 1
+  int* _buckets;    // first entry per bucket, -1 if empty
+  int* _next;       // next entry in the same bucket, ascending; -1 at the end
+
+  static unsigned int hash(Symbol* name, Symbol* signature);
+ public:
+  VtableNameSigIndex(klassVtable* vtable, int length);
+
+  // Entries whose name and signature may match, in ascending order; the
+  // caller still compares name and signature
+  int first(Symbol* name, Symbol* signature) const {
+    return _buckets[hash(name, signature) & _mask];
+  }
+  int next(int index) const { return _next[index]; }
+};
+
 class klassVtable : public ResourceObj {
   KlassHandle  _klass;            // my klass
   int          _tableOffset;      // offset of start of vtable data within klass
@@ -118,7 +140,8 @@ class klassVtable : public ResourceObj {
   void put_method_at(Method* m, int index);
   static bool needs_new_vtable_entry(methodHandle m, Klass* super, Handle classloader, Symbol* classname, AccessFlags access_flags, TRAPS);
 
-  bool update_inherited_vtable(InstanceKlass* klass, methodHandle target_method, int super_vtable_len, int default_index, bool checkconstraints, TRAPS);
+  bool update_inherited_vtable(InstanceKlass* klass, methodHandle target_method, int super_vtable_len, int default_index,
+                               const VtableNameSigIndex* super_index, bool checkconstraints, TRAPS);
  InstanceKlass* find_transitive_override(InstanceKlass* initialsuper, methodHandle target_method, int vtable_index,
                                          Handle target_loader, Symbol* target_classname, Thread* THREAD);
 
@@ -267,6 +290,14 @@ class itableMethodEntry VALUE_OBJ_CLASS_SPEC {
 //    compiler entry point                / method table entry
 //    -- vtable for interface 2 ---
 //    ...
+//    ---- hashed index (optional) ---
+//    probe mask (in words)
+//    Klass* of interface               \
+//    offset to vtable from start of oop  / hash slot, open addressing
+//    ...
+//
+// The hashed index is only present on classes implementing at least
+// ItableHashMinInterfaces interfaces, see InstanceKlass::itable_hash_offset().
 //
 class klassItable : public ResourceObj {
  private:
@@ -314,6 +345,10 @@ class klassItable : public ResourceObj {
   // Resolving of method to index
   static Method* method_for_itable_index(Klass* klass, int itable_index);
 
+  // Hashed itable index: first probe (in words from the first slot) of an
+  // interface. Must match the probe sequence of the itable stubs.
+  static int hash_index(Klass* intf, intptr_t mask) { return (int)(((uintptr_t)intf >> 2) & mask); }
+
   // Debugging/Statistics
   static void print_statistics() PRODUCT_RETURN;
  private:
@@ -322,6 +357,7 @@ class klassItable : public ResourceObj {
 
   // Helper methods
   static int  calc_itable_size(int num_interfaces, int num_methods) { return (num_interfaces * itableOffsetEntry::size()) + (num_methods * itableMethodEntry::size()); }
+  static int  calc_itable_hash_size(int num_interfaces);
 
   // Statistics
   NOT_PRODUCT(static int  _total_classes;)   // Total no. of classes with itables
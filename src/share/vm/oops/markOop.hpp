@@ -270,6 +270,14 @@ class markOopDesc: public oopDesc {
     assert(has_locker(), "check");
     return (BasicLock*) value();
   }
+  // Lightweight locking (UseLightweightLocking): the owner is found on the
+  // lock stacks instead of through locker().
+  bool is_fast_locked() const {
+    return ((value() & lock_mask_in_place) == locked_value);
+  }
+  markOop set_fast_locked() const {
+    return markOop(value() & ~lock_mask_in_place);
+  }
   bool has_monitor() const {
     return ((value() & monitor_value) != 0);
   }
@@ -278,7 +286,12 @@ class markOopDesc: public oopDesc {
     // Use xor instead of &~ to provide one extra tag-bit check.
     return (ObjectMonitor*) (value() ^ monitor_value);
   }
+  // With UseLightweightLocking a fast-locked mark (locked_value) still
+  // holds the object's header bits; only inflated marks are displaced.
   bool has_displaced_mark_helper() const {
+    if (UseLightweightLocking) {
+      return ((value() & lock_mask_in_place) == monitor_value);
+    }
     return ((value() & unlocked_value) == 0);
   }
   markOop displaced_mark_helper() const {
@@ -26,6 +26,7 @@
 #include "classfile/metadataOnStackMark.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/debugInfoRec.hpp"
+#include "compiler/compilerOracle.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "interpreter/bytecodeStream.hpp"
 #include "interpreter/bytecodeTracer.hpp"
@@ -99,6 +100,7 @@ Method::Method(ConstMethod* xconst, AccessFlags access_flags, int size) {
 
   set_first_invoke_init_order(INVALID_FIRST_INVOKE_INIT_ORDER);
   set_compiled_by_jwarmup(false);
+  _jwarmup_speculation_failures = 0;
 
 #ifndef PRODUCT
   set_deopted_by_jwarmup(false);
@@ -740,6 +742,11 @@ address Method::critical_native_function() {
   return NativeLookup::lookup_critical_entry(mh);
 }
 
+address Method::trivial_native_function() {
+  methodHandle mh(this);
+  return NativeLookup::lookup_trivial_entry(mh);
+}
+
 
 void Method::set_signature_handler(address handler) {
   address* signature_handler =  signature_handler_addr();
@@ -905,6 +912,14 @@ void Method::link_method(methodHandle h_method, TRAPS) {
   assert(_adapter == NULL, "init'd to NULL" );
   assert( _code == NULL, "nothing compiled yet" );
 
+  // Methods selected for JVMTI method tracing are never inlined, so that
+  // deoptimizing their own nmethods sends every call to the interpreter.
+  if (JvmtiSelectiveMethodTrace &&
+      CompilerOracle::has_option_string(h_method, "JvmtiTrace")) {
+    set_is_jvmti_traced();
+    set_dont_inline(true);
+  }
+
   // Setup interpreter entrypoint
   assert(this == h_method(), "wrong h_method()" );
   address entry = Interpreter::entry_for_method(h_method);
@@ -142,6 +142,7 @@ class Method : public Metadata {
 
   int _first_invoke_init_order;  // record class initialize order when this method first been invoked
   bool _compiled_by_jwarmup;
+  u1   _jwarmup_speculation_failures; // failed speculations of JWarmUP compiled code
 #ifndef PRODUCT
   bool _deopted_by_jwarmup;
 #endif
@@ -218,6 +219,15 @@ class Method : public Metadata {
   bool compiled_by_jwarmup()                      { return _compiled_by_jwarmup; }
   void set_compiled_by_jwarmup(bool value)        { _compiled_by_jwarmup = value; }
 
+  uint jwarmup_speculation_failures()             { return _jwarmup_speculation_failures; }
+  uint inc_jwarmup_speculation_failures() {
+    // saturating, updated racily from uncommon traps like the trap counts
+    if (_jwarmup_speculation_failures < max_jubyte) {
+      _jwarmup_speculation_failures++;
+    }
+    return _jwarmup_speculation_failures;
+  }
+
 #ifndef PRODUCT
   bool deopted_by_jwarmup()                        { return _deopted_by_jwarmup; }
   void set_deopted_by_jwarmup(bool value)          { _deopted_by_jwarmup = value; }
@@ -517,6 +527,7 @@ class Method : public Metadata {
   };
   address native_function() const                { return *(native_function_addr()); }
   address critical_native_function();
+  address trivial_native_function();
 
   // Must specify a real function (not NULL).
   // Use clear_native_function() to unregister.
@@ -765,6 +776,10 @@ class Method : public Metadata {
   bool is_prefixed_native() const                   { return access_flags().is_prefixed_native(); }
   void set_is_prefixed_native()                     { _access_flags.set_is_prefixed_native(); }
 
+  // JVMTI selective method tracing (JvmtiSelectiveMethodTrace)
+  bool is_jvmti_traced() const                      { return access_flags().is_jvmti_traced(); }
+  void set_is_jvmti_traced()                        { _access_flags.set_is_jvmti_traced(); }
+
   // Rewriting support
   static methodHandle clone_with_new_data(methodHandle m, u_char* new_code, int new_code_length,
                                           u_char* new_compressed_linenumber_table, int new_compressed_linenumber_size, TRAPS);
@@ -38,21 +38,23 @@ class MethodCounters: public MetaspaceObj {
   InvocationCounter _backedge_counter;           // Incremented before each backedge taken - used to trigger frequencey-based optimizations
 
 #ifdef TIERED
+  jlong             _prev_time;                   // Previous time the rate was acquired
   float             _rate;                        // Events (invocation and backedge counter increments) per millisecond
   u1                _highest_comp_level;          // Highest compile level this method has ever seen.
   u1                _highest_osr_comp_level;      // Same for OSR level
-  jlong             _prev_time;                   // Previous time the rate was acquired
 #endif
+  u1                _pinned;                      // Address is embedded in compiled code, never reclaim
 
   MethodCounters() : _interpreter_invocation_count(0),
                      _interpreter_throwout_count(0),
                      _number_of_breakpoints(0)
 #ifdef TIERED
-                   , _rate(0),
+                   , _prev_time(0),
+                     _rate(0),
                      _highest_comp_level(0),
-                     _highest_osr_comp_level(0),
-                     _prev_time(0)
+                     _highest_osr_comp_level(0)
 #endif
+                   , _pinned(false)
   {
     invocation_counter()->init();
     backedge_counter()->init();
@@ -97,6 +99,11 @@ class MethodCounters: public MetaspaceObj {
   void decr_number_of_breakpoints()    { --_number_of_breakpoints; }
   void clear_number_of_breakpoints()   { _number_of_breakpoints = 0; }
 
+  // Set once compiled code may refer to these counters directly; pinned
+  // counters are never freed by the cold counter reclamation.
+  bool is_pinned() const                         { return _pinned != 0; }
+  void set_pinned()                              { _pinned = true; }
+
 #ifdef TIERED
   jlong prev_time() const                        { return _prev_time; }
   void set_prev_time(jlong time)                 { _prev_time = time; }
@@ -284,6 +284,7 @@ class ProfileData : public ResourceObj {
   friend class TypeStackSlotEntries;
   friend class ProfileRecorder;
   friend class PreloadJitInfo;
+  friend class PreloadMethodHolder;
 private:
 #ifndef PRODUCT
   enum {
@@ -95,6 +95,11 @@ private:
       oop_store(obj_at_addr<oop>(index), value);
     }
   }
+
+  // Stores exchange_value at index if the element is compare_value, with
+  // the GC barriers; returns the previous element
+  oop atomic_compare_exchange_oop(int index, oop exchange_value, oop compare_value);
+
   // Sizing
   static int header_size()    { return arrayOopDesc::header_size(T_OBJECT); }
   int object_size()           { return object_size(length()); }
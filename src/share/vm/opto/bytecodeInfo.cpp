@@ -55,6 +55,7 @@ InlineTree::InlineTree(Compile* c,
   _count_inlines = 0;
   _forced_inline = false;
 #endif
+  _hot_inline = false;
   if (_caller_jvms != NULL) {
     // Keep a private copy of the caller_jvms:
     _caller_jvms = new (C) JVMState(caller_jvms->method(), caller_tree->caller_jvms());
@@ -158,6 +159,8 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
   assert(invoke_count != 0, "require invocation count greater than zero");
   int freq = call_site_count / invoke_count;
 
+  bool very_hot = is_very_hot_site(callee_method, caller_bci);
+
   // bump the max size if the call is frequent
   if ((freq >= InlineFrequencyRatio) ||
       (call_site_count >= InlineFrequencyCount) ||
@@ -176,12 +179,18 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
     // Not hot.  Check for medium-sized pre-existing nmethod at cold sites.
     if (callee_method->has_compiled_code() &&
         callee_method->instructions_size() > inline_small_code_size) {
-      set_msg("already compiled into a medium method");
-      return false;
+      if (!very_hot) {
+        set_msg("already compiled into a medium method");
+        return false;
+      }
+      _hot_inline = true;
     }
   }
   if (size > max_inline_size) {
-    if (max_inline_size > default_max_inline_size) {
+    if (very_hot && size <= HotInlineSize) {
+      // Very hot site: spend some of the hot inlining budget on it.
+      _hot_inline = true;
+    } else if (max_inline_size > default_max_inline_size) {
       set_msg("hot method too big");
     } else {
       set_msg("too big");
@@ -265,8 +274,11 @@ bool InlineTree::should_not_inline(ciMethod *callee_method,
 
   if (callee_method->has_compiled_code() &&
       callee_method->instructions_size() > InlineSmallCode) {
-    set_msg("already compiled into a big method");
-    return true;
+    if (!is_very_hot_site(callee_method, jvms->bci())) {
+      set_msg("already compiled into a big method");
+      return true;
+    }
+    _hot_inline = true;
   }
 
   // don't inline exception code unless the top method belongs to an
@@ -326,6 +338,7 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
   }
 
   _forced_inline = false; // Reset
+  _hot_inline = false;    // Reset
   if (!should_inline(callee_method, caller_method, caller_bci, profile,
                      wci_result)) {
     return false;
@@ -431,6 +444,12 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
     }
   }
 
+  if (hot_inline()) {
+    // Charge the bytecodes inlined beyond the regular limits
+    C->set_hot_inline_budget(C->hot_inline_budget() - size);
+    set_msg("inline (very hot)");
+  }
+
   // ok, inline this method
   return true;
 }
@@ -619,6 +638,29 @@ float InlineTree::compute_callee_frequency( int caller_bci ) const {
   return freq;
 }
 
+//------------------------------is_very_hot_site-------------------------------
+// With UseHotnessInlining, a call site whose callee runs at least
+// HotInlineFrequencyRatio times per invocation of the root method may
+// inline methods beyond the regular size limits, and methods that are
+// already compiled into big nmethods, while the per-compilation
+// HotInlineBudget lasts.  The hottest sites are reached first along the
+// hot paths the parser inlines, so they get the budget first.
+bool InlineTree::is_very_hot_site(ciMethod* callee_method, int caller_bci) const {
+  if (C->hot_inline_budget() <= 0 || !UseInterpreter || CompileTheWorld) {
+    return false;
+  }
+  ciMethodData* md = method()->method_data_or_null();
+  if (md == NULL || !md->is_mature() ||
+      method()->interpreter_invocation_count() == 0) {
+    return false;
+  }
+  if (callee_method->code_size_for_inlining() > C->hot_inline_budget()) {
+    return false;
+  }
+  float hotness = _site_invoke_ratio * compute_callee_frequency(caller_bci);
+  return hotness >= (float)HotInlineFrequencyRatio;
+}
+
 //------------------------------build_inline_tree_for_callee-------------------
 InlineTree *InlineTree::build_inline_tree_for_callee( ciMethod* callee_method, JVMState* caller_jvms, int caller_bci) {
   float recur_frequency = _site_invoke_ratio * compute_callee_frequency(caller_bci);
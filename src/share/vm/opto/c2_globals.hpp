@@ -211,9 +211,18 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(uintx, LoopStripMiningIter, 0,                                    \
+          "Number of iterations of the inner loop between safepoint "       \
+          "polls of a strip mined counted loop (0 or 1 disables strip "     \
+          "mining). Implies UseCountedLoopSafepoints")                      \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
+  product(bool, UseNonCountedLoopPredicate, false,                          \
+          "Hoist range checks out of non-counted and long-bounded loops "   \
+          "whose index never decreases and whose exit test bounds it")      \
+                                                                            \
   develop(bool, TraceLoopPredicate, false,                                  \
           "Trace generation of loop predicates")                            \
                                                                             \
@@ -327,6 +336,13 @@
   develop(bool, SuperWordRTDepCheck, false,                                 \
           "Enable runtime dependency checks.")                              \
                                                                             \
+  product(bool, SuperWordReductions, false,                                 \
+          "Enable reductions support in superword.")                        \
+                                                                            \
+  product(bool, UseVectorCmov, false,                                       \
+          "If-convert diamonds in counted loops and vectorize the "         \
+          "resulting conditional moves in superword")                       \
+                                                                            \
   notproduct(bool, TraceSuperWord, false,                                   \
           "Trace superword transforms")                                     \
                                                                             \
@@ -369,6 +385,14 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, false,                              \
+          "Profiling based guarded inlining for more than two "             \
+          "receivers, with a virtual call for the remaining ones")          \
+                                                                            \
+  product(intx, PolymorphicInlineLimit, 4,                                  \
+          "Maximum number of receivers inlined at a call site with "        \
+          "UsePolymorphicInlining")                                         \
+                                                                            \
   product(bool, InsertMemBarAfterArraycopy, true,                           \
           "Insert memory barrier after arraycopy call")                     \
                                                                             \
@@ -395,6 +419,23 @@
   develop(bool, InlineWarmCalls, false,                                     \
           "Use a heat-based priority queue to govern inlining")             \
                                                                             \
+  product(bool, UseHotnessInlining, false,                                  \
+          "Let very hot call sites inline methods beyond the regular "      \
+          "size limits, including methods already compiled into big "       \
+          "nmethods")                                                       \
+                                                                            \
+  product(intx, HotInlineFrequencyRatio, 100,                               \
+          "Calls per invocation of the compiled method above which a "      \
+          "call site is very hot, with UseHotnessInlining")                 \
+                                                                            \
+  product(intx, HotInlineSize, 1000,                                        \
+          "Maximum bytecode size of a method inlined at a very hot "        \
+          "call site, with UseHotnessInlining")                             \
+                                                                            \
+  product(intx, HotInlineBudget, 3000,                                      \
+          "Bytecodes per compilation that may be spent on inlining "        \
+          "beyond the regular limits at very hot call sites")               \
+                                                                            \
   develop(intx, HotCallCountThreshold, 999999,                              \
           "large numbers of calls (per method invocation) force hotness")   \
                                                                             \
@@ -425,6 +466,11 @@
   product(intx, NodeLimitFudgeFactor, 2000,                                 \
           "Fudge Factor for certain optimizations")                         \
                                                                             \
+  product(uintx, CompileMemoryLimit, 0,                                     \
+          "Bail out of a C2 compilation whose arena memory grows beyond "   \
+          "this many bytes and do not compile the method with C2 again; "   \
+          "0 means no limit")                                               \
+                                                                            \
   product(bool, UseJumpTables, true,                                        \
           "Use JumpTables instead of a binary search tree for switches")    \
                                                                             \
@@ -485,15 +531,36 @@
   notproduct(bool, PrintEscapeAnalysis, false,                              \
           "Print the results of escape analysis")                           \
                                                                             \
+  product(bool, PartialEscapeAnalysis, false,                               \
+          "Replace cold calls through which allocations escape with "       \
+          "uncommon traps so that the allocations can be scalar "           \
+          "replaced and are materialized only on deoptimization")           \
+                                                                            \
+  product(intx, PartialEscapeColdCallRatio, 1000,                           \
+          "A call site is cold for PartialEscapeAnalysis if it is "         \
+          "executed less than once per this many method invocations "       \
+          "and loop iterations")                                            \
+                                                                            \
   product(bool, EliminateAllocations, true,                                 \
           "Use escape analysis to eliminate allocations")                   \
                                                                             \
+  product(bool, ReduceAllocationMerges, true,                               \
+          "Split field loads through phis merging newly allocated "         \
+          "objects so that the allocations can be scalar replaced")         \
+                                                                            \
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
   product(intx, EliminateAllocationArraySizeLimit, 64,                      \
           "Array size (number of elements) limit for scalar replacement")   \
                                                                             \
+  product(bool, MergeTLABAllocations, false,                                \
+          "Allocate adjacent fixed-size instances with a single TLAB "      \
+          "bump and limit check")                                           \
+                                                                            \
+  product(intx, MergeTLABAllocationsLimit, 4,                               \
+          "Maximum number of allocations sharing one TLAB bump")            \
+                                                                            \
   product(bool, OptimizePtrCompare, true,                                   \
           "Use escape analysis to optimize pointers compare")               \
                                                                             \
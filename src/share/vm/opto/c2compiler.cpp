@@ -113,6 +113,8 @@ void C2Compiler::compile_method(ciEnv* env, ciMethod* target, int entry_bci) {
   bool subsume_loads = SubsumeLoads;
   bool do_escape_analysis = DoEscapeAnalysis && !env->should_retain_local_variables();
   bool eliminate_boxing = EliminateAutoBox;
+  // Arena memory of all attempts counts against the limit
+  CompilerThread::current()->set_arena_limit(CompileMemoryLimit);
   while (!env->failing()) {
     // Attempt to compile while subsuming loads into machine instructions.
     Compile C(env, this, target, entry_bci, subsume_loads, do_escape_analysis, eliminate_boxing);
@@ -1112,6 +1112,7 @@ void Compile::Init(int aliaslevel) {
   set_do_inlining(Inline);
   set_max_inline_size(MaxInlineSize);
   set_freq_inline_size(FreqInlineSize);
+  set_hot_inline_budget(UseHotnessInlining ? HotInlineBudget : 0);
   set_do_scheduling(OptoScheduling);
   set_do_count_invocations(false);
   set_do_method_data_update(false);
@@ -2193,6 +2194,11 @@ void Compile::Optimize() {
 
   // Perform escape analysis
   if (_do_escape_analysis && ConnectionGraph::has_candidates(this)) {
+    if (PartialEscapeAnalysis && ConnectionGraph::trap_cold_escapes(this, &igvn)) {
+      // Remove the paths after cold calls replaced with uncommon traps.
+      igvn.optimize();
+      if (failing())  return;
+    }
     if (has_loops()) {
       // Cleanup graph (remove dead nodes).
       TracePhase t2("idealLoop", &_t_idealLoop, true);
@@ -223,6 +223,70 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           speculative_receiver_type = NULL;
         }
       }
+      if (receiver_method == NULL && UsePolymorphicInlining &&
+          morphism != 1 && morphism != 2 && profile.has_receiver(2)) {
+        // More than two hot receivers: guard and inline each of the most
+        // frequent ones, then trap or make a virtual call for the rest.
+        const int limit = MIN2((int)PolymorphicInlineLimit, (int)ciCallProfile::PolymorphicLimit);
+        CallGenerator* hit_cgs[ciCallProfile::PolymorphicLimit];
+        ciMethod* hit_methods[ciCallProfile::PolymorphicLimit];
+        // All receivers seen at the site are in the profile and inlined
+        bool all_receivers = (morphism > 0 && morphism <= limit);
+        int n = 0;
+        int inlined = 0;
+        for (; n < limit && profile.has_receiver(n); n++) {
+          hit_methods[n] = callee->resolve_invoke(jvms->method()->holder(),
+                                                  profile.receiver(n));
+          hit_cgs[n] = NULL;
+          if (hit_methods[n] != NULL) {
+            hit_cgs[n] = this->call_generator(hit_methods[n],
+                                vtable_index, !call_does_dispatch, jvms,
+                                allow_inline, prof_factor);
+          }
+          if (hit_cgs[n] != NULL && !hit_cgs[n]->is_inline()) {
+            // Don't guard calls we can't inline
+            hit_cgs[n] = NULL;
+          }
+          if (hit_cgs[n] == NULL) {
+            all_receivers = false;
+          } else {
+            inlined++;
+          }
+        }
+        if (inlined > 1) {
+          CallGenerator* miss_cg;
+          bool trap = all_receivers &&
+                      !too_many_traps(caller, bci, Deoptimization::Reason_class_check);
+          if (trap) {
+            miss_cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_class_check,
+                        Deoptimization::Action_maybe_recompile);
+          } else {
+            miss_cg = CallGenerator::for_virtual_call(callee, vtable_index);
+          }
+          // Count of calls reaching the type check of each receiver
+          int remaining[ciCallProfile::PolymorphicLimit];
+          int left = site_count;
+          for (int i = 0; i < n; i++) {
+            remaining[i] = MAX2(left, 1);
+            left -= profile.receiver_count(i);
+          }
+          bool last = true;
+          for (int i = n - 1; i >= 0 && miss_cg != NULL; i--) {
+            if (hit_cgs[i] == NULL) {
+              continue;
+            }
+            float hit_prob = (float)profile.receiver_count(i) / (float)remaining[i];
+            if (last && trap) {
+              hit_prob = PROB_MAX;
+            }
+            hit_prob = MAX2(PROB_MIN, MIN2(PROB_MAX, hit_prob));
+            last = false;
+            trace_type_profile(C, jvms->method(), jvms->depth() - 1, jvms->bci(), hit_methods[i], profile.receiver(i), site_count, profile.receiver_count(i));
+            miss_cg = CallGenerator::for_predicted_call(profile.receiver(i), miss_cg, hit_cgs[i], hit_prob);
+          }
+          if (miss_cg != NULL)  return miss_cg;
+        }
+      }
       if (receiver_method == NULL &&
           (have_major_receiver || morphism == 1 ||
            (morphism == 2 && UseBimorphicInlining))) {
@@ -34,6 +34,9 @@
 #include "opto/escape.hpp"
 #include "opto/phaseX.hpp"
 #include "opto/rootnode.hpp"
+#include "opto/runtime.hpp"
+#include "runtime/deoptimization.hpp"
+#include "runtime/sharedRuntime.hpp"
 
 ConnectionGraph::ConnectionGraph(Compile * C, PhaseIterGVN *igvn) :
   _nodes(C->comp_arena(), C->unique(), C->unique(), NULL),
@@ -41,6 +44,7 @@ ConnectionGraph::ConnectionGraph(Compile * C, PhaseIterGVN *igvn) :
   _next_pidx(0),
   _collecting(true),
   _verify(false),
+  _cold_calls(NULL),
   _compile(C),
   _igvn(igvn),
   _node_map(C->comp_arena()) {
@@ -103,6 +107,225 @@ void ConnectionGraph::do_analysis(Compile *C, PhaseIterGVN *igvn) {
     igvn->hash_delete(noop_null);
 }
 
+// Partial escape analysis (PartialEscapeAnalysis).
+//
+// The analysis is flow-insensitive: an allocation passed to a call which
+// is not inlined escapes even if the call is almost never executed (error
+// reporting, logging, slow paths). Redo the analysis as if such cold calls
+// were uncommon traps and replace the cold calls through which otherwise
+// scalar replaceable allocations escape with real uncommon traps. The
+// allocations are then scalar replaced and materialized by deoptimization
+// only when a cold call is reached; the interpreter reexecutes the invoke.
+
+// Check if an argument of the call is a newly allocated object.
+static bool passes_allocation(PhaseGVN* igvn, CallJavaNode* call) {
+  uint cnt = call->tf()->domain()->cnt();
+  for (uint i = TypeFunc::Parms; i < cnt; i++) {
+    Node* arg = call->in(i);
+    if (arg != NULL && AllocateNode::Ideal_allocation(arg, igvn) != NULL) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Check the profile of the call site: it is cold if it was executed
+// less than once per PartialEscapeColdCallRatio method invocations
+// and loop iterations.
+static bool is_cold_call(Compile* C, CallJavaNode* call) {
+  ciMethod* callee = call->method();
+  if (callee == NULL || call->is_method_handle_invoke() ||
+      (call->is_CallStaticJava() && call->as_CallStaticJava()->is_boxing_method())) {
+    return false;
+  }
+  JVMState* jvms = call->jvms();
+  if (jvms == NULL || !jvms->has_method() || jvms->should_reexecute() ||
+      jvms->stk_size() != (int)jvms->sp() || call->req() != jvms->endoff()) {
+    return false;
+  }
+  // The uncommon trap puts the arguments back on the expression stack
+  // to reexecute the invoke.
+  uint nargs = call->tf()->domain()->cnt() - TypeFunc::Parms;
+  if (nargs != (uint)callee->arg_size()) {
+    return false;
+  }
+  ciMethod* method = jvms->method();
+  int bci = jvms->bci();
+  switch (method->java_code_at_bci(bci)) {
+  case Bytecodes::_invokevirtual:
+  case Bytecodes::_invokespecial:
+  case Bytecodes::_invokestatic:
+  case Bytecodes::_invokeinterface:
+    break;
+  default:
+    return false;
+  }
+  if (C->too_many_traps(method, bci, Deoptimization::Reason_intrinsic)) {
+    return false; // The cold call was reached in a previous compilation
+  }
+  ciMethodData* md = method->method_data_or_null();
+  if (md == NULL || !md->is_mature()) {
+    return false;
+  }
+  ciCallProfile profile = method->call_profile_at_bci(bci);
+  int invoke_count = method->interpreter_invocation_count();
+  if (profile.count() < 0 || invoke_count <= 0) {
+    return false;
+  }
+  jlong executions = (jlong)invoke_count + method->scale_count(md->backedge_count());
+  return (jlong)method->scale_count(profile.count()) * PartialEscapeColdCallRatio < executions;
+}
+
+static bool is_scalar_replaceable_allocation(PointsToNode* ptn) {
+  return ptn->is_JavaObject() && ptn->ideal_node()->is_Allocate() &&
+         ptn->escape_state() == PointsToNode::NoEscape &&
+         ptn->scalar_replaceable();
+}
+
+bool ConnectionGraph::is_scalar_replaceable_without_cold_calls(CallNode* call) {
+  uint cnt = call->tf()->domain()->cnt();
+  for (uint i = TypeFunc::Parms; i < cnt; i++) {
+    Node* arg = call->in(i);
+    PointsToNode* arg_ptn = (arg != NULL) ? ptnode_adr(arg->_idx) : NULL;
+    if (arg_ptn == NULL) {
+      continue;
+    }
+    if (arg_ptn->is_JavaObject()) {
+      if (is_scalar_replaceable_allocation(arg_ptn)) {
+        return true;
+      }
+      continue;
+    }
+    for (EdgeIterator e(arg_ptn); e.has_next(); e.next()) {
+      if (is_scalar_replaceable_allocation(e.get())) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ConnectionGraph::replace_call_with_uncommon_trap(Compile* C, PhaseIterGVN* igvn, CallJavaNode* call) {
+  JVMState* jvms = call->jvms();
+  uint old_dbg_start = call->tf()->domain()->cnt();
+  uint nargs = old_dbg_start - TypeFunc::Parms;
+
+  address call_addr = SharedRuntime::uncommon_trap_blob()->entry_point();
+  const TypeFunc* call_type = OptoRuntime::uncommon_trap_Type();
+  const TypePtr* no_memory_effects = NULL;
+  CallStaticJavaNode* trap = new (C) CallStaticJavaNode(call_type, call_addr, "uncommon_trap",
+                                                        jvms->bci(), no_memory_effects);
+  for (int e = 0; e < TypeFunc::Parms; e++) {
+    trap->init_req(e, call->in(e));
+  }
+  // Record the failure per bci so that the call is not speculated
+  // to be cold again after recompilation.
+  int trap_request = Deoptimization::make_trap_request(Deoptimization::Reason_intrinsic,
+                                                       Deoptimization::Action_make_not_entrant);
+  trap->init_req(TypeFunc::Parms, igvn->intcon(trap_request));
+  uint new_dbg_start = trap->req();
+  assert(new_dbg_start == call_type->domain()->cnt(), "argument count mismatch");
+
+  // Copy the debug info of the call and push the arguments on the
+  // expression stack of the youngest frame for reexecution.
+  for (uint i = old_dbg_start; i < jvms->monoff(); i++) {
+    trap->add_req(call->in(i));
+  }
+  for (uint i = 0; i < nargs; i++) {
+    trap->add_req(call->in(TypeFunc::Parms + i));
+  }
+  for (uint i = jvms->monoff(); i < call->req(); i++) {
+    trap->add_req(call->in(i));
+  }
+  JVMState* trap_jvms = jvms->clone_deep(C);
+  trap_jvms->adapt_position(new_dbg_start - old_dbg_start);
+  trap_jvms->set_sp(trap_jvms->sp() + nargs);
+  trap_jvms->set_monoff(trap_jvms->monoff() + nargs);
+  trap_jvms->set_scloff(trap_jvms->scloff() + nargs);
+  trap_jvms->set_endoff(trap_jvms->endoff() + nargs);
+  trap_jvms->set_map_deep(trap);
+  trap->set_jvms(trap_jvms);
+  assert(trap->req() == trap_jvms->endoff(), "debug info mismatch");
+  igvn->register_new_node_with_optimizer(trap);
+
+  Node* ctrl = new (C) ProjNode(trap, TypeFunc::Control);
+  igvn->register_new_node_with_optimizer(ctrl);
+  Node* halt = new (C) HaltNode(ctrl, call->in(TypeFunc::FramePtr));
+  igvn->register_new_node_with_optimizer(halt);
+  igvn->rehash_node_delayed(C->root());
+  C->root()->add_req(halt);
+
+  // All paths after the call are dead now.
+  igvn->replace_input_of(call, TypeFunc::Control, C->top());
+}
+
+bool ConnectionGraph::trap_cold_escapes(Compile *C, PhaseIterGVN *igvn) {
+  if (!EliminateAllocations) {
+    return false;
+  }
+  Compile::TracePhase t2("escapeAnalysis", &Phase::_t_escapeAnalysis, true);
+  ResourceMark rm;
+
+  // Collect cold calls which are passed newly allocated objects.
+  Unique_Node_List wq;
+  GrowableArray<CallJavaNode*> cold_calls;
+  VectorSet cold_set(Thread::current()->resource_area());
+  wq.push(C->root());
+  for (uint next = 0; next < wq.size(); next++) {
+    Node* n = wq.at(next);
+    for (uint i = 0; i < n->req(); i++) {
+      Node* m = n->in(i);
+      if (m != NULL) {
+        wq.push(m);
+      }
+    }
+    if (n->is_CallJava() &&
+        passes_allocation(igvn, n->as_CallJava()) &&
+        is_cold_call(C, n->as_CallJava())) {
+      cold_calls.append(n->as_CallJava());
+      cold_set.set(n->_idx);
+    }
+  }
+  if (cold_calls.length() == 0) {
+    return false;
+  }
+
+  // Add ConP#NULL and ConN#NULL nodes before ConnectionGraph construction
+  // to create space for them in ConnectionGraph::_nodes[].
+  Node* oop_null = igvn->zerocon(T_OBJECT);
+  Node* noop_null = igvn->zerocon(T_NARROWOOP);
+  ConnectionGraph* congraph = new(C->comp_arena()) ConnectionGraph(C, igvn);
+  congraph->_cold_calls = &cold_set;
+  int trapped = 0;
+  if (congraph->compute_escape() && !C->failing()) {
+    for (int i = 0; i < cold_calls.length(); i++) {
+      CallJavaNode* call = cold_calls.at(i);
+      if (!congraph->is_scalar_replaceable_without_cold_calls(call)) {
+        continue;
+      }
+      CompileLog* log = C->log();
+      if (log != NULL) {
+        log->elem("cold_escape_trap bci='%d' method='%d'",
+                  call->jvms()->bci(), log->identify(call->jvms()->method()));
+      }
+#ifndef PRODUCT
+      if (PrintEscapeAnalysis) {
+        tty->print("=== Replace cold call with uncommon trap: ");
+        call->dump();
+      }
+#endif
+      replace_call_with_uncommon_trap(C, igvn, call);
+      trapped++;
+    }
+  }
+  // Cleanup.
+  if (oop_null->outcnt() == 0)
+    igvn->hash_delete(oop_null);
+  if (noop_null->outcnt() == 0)
+    igvn->hash_delete(noop_null);
+  return (trapped > 0);
+}
+
 bool ConnectionGraph::compute_escape() {
   Compile* C = _compile;
   PhaseGVN* igvn = _igvn;
@@ -228,11 +451,13 @@ bool ConnectionGraph::compute_escape() {
     JavaObjectNode* ptn = non_escaped_worklist.at(next);
     bool noescape = (ptn->escape_state() == PointsToNode::NoEscape);
     Node* n = ptn->ideal_node();
-    if (n->is_Allocate()) {
-      n->as_Allocate()->_is_non_escaping = noescape;
-    }
-    if (n->is_CallStaticJava()) {
-      n->as_CallStaticJava()->_is_non_escaping = noescape;
+    if (_cold_calls == NULL) {
+      if (n->is_Allocate()) {
+        n->as_Allocate()->_is_non_escaping = noescape;
+      }
+      if (n->is_CallStaticJava()) {
+        n->as_CallStaticJava()->_is_non_escaping = noescape;
+      }
     }
     if (noescape && ptn->scalar_replaceable()) {
       adjust_scalar_replaceable_state(ptn);
@@ -257,6 +482,12 @@ bool ConnectionGraph::compute_escape() {
 
   _collecting = false;
 
+  if (_cold_calls != NULL) {
+    // Speculative analysis only computes escape states,
+    // the graph is not changed.
+    return (alloc_worklist.length() > 0);
+  }
+
   } // TracePhase t3("connectionGraph")
 
   // 4. Optimize ideal graph based on EA information.
@@ -354,6 +585,14 @@ void ConnectionGraph::add_node_to_connection_graph(Node *n, Unique_Node_List *de
         if (name != NULL && strcmp(name, "uncommon_trap") == 0)
           return; // Skip uncommon traps
       }
+      if (_cold_calls != NULL && _cold_calls->test(n_idx)) {
+        // Speculatively treat the cold call as an uncommon trap.
+        // Its result, if any, is an unknown object.
+        if (n->as_Call()->returns_pointer()) {
+          map_ideal_node(n, phantom_obj);
+        }
+        return;
+      }
       // Don't mark as processed since call's arguments have to be processed.
       delayed_worklist->push(n);
       // Check if a call returns an object.
@@ -948,6 +1187,9 @@ void ConnectionGraph::process_call_arguments(CallNode *call) {
                  (strcmp(call->as_CallLeaf()->_name, "g1_wb_pre")  == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "g1_wb_post") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "updateBytesCRC32") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "byteArrayHashCode") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "charArrayHashCode") == 0 ||
+                  strcmp(call->as_CallLeaf()->_name, "intArrayHashCode") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "aescrypt_encryptBlock") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "aescrypt_decryptBlock") == 0 ||
                   strcmp(call->as_CallLeaf()->_name, "cipherBlockChaining_encryptAESCrypt") == 0 ||
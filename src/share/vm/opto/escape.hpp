@@ -333,6 +333,10 @@ private:
 
   bool               _verify;  // verify graph
 
+  VectorSet*     _cold_calls;  // Calls which are treated as uncommon traps
+                               // by the speculative analysis done for
+                               // PartialEscapeAnalysis, NULL otherwise.
+
   JavaObjectNode* phantom_obj; // Unknown object
   JavaObjectNode*    null_obj;
   Node*             _pcmp_neq; // ConI(#CC_GT)
@@ -582,6 +586,13 @@ private:
   // Compute the escape information
   bool compute_escape();
 
+  // Check if a cold call passes an allocation which is scalar replaceable
+  // when the cold calls are not taken into account.
+  bool is_scalar_replaceable_without_cold_calls(CallNode* call);
+
+  // Replace a call with an uncommon trap which reexecutes its invoke.
+  static void replace_call_with_uncommon_trap(Compile* C, PhaseIterGVN* igvn, CallJavaNode* call);
+
 public:
   ConnectionGraph(Compile *C, PhaseIterGVN *igvn);
 
@@ -591,6 +602,11 @@ public:
   // Perform escape analysis
   static void do_analysis(Compile *C, PhaseIterGVN *igvn);
 
+  // Replace cold calls which are the only escape of otherwise scalar
+  // replaceable allocations with uncommon traps (PartialEscapeAnalysis).
+  // Returns true if the graph was changed.
+  static bool trap_cold_escapes(Compile *C, PhaseIterGVN *igvn);
+
   bool not_global_escape(Node *n);
 
 #ifndef PRODUCT
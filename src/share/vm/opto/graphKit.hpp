@@ -789,8 +789,12 @@ class GraphKit : public Phase {
                              Node* val,
                              BasicType bt,
                              bool use_precise);
-  // Helper function for g1
+  // Helper functions for g1
   private:
+  bool g1_can_remove_pre_barrier(PhaseTransform* phase, Node* adr, BasicType bt, uint adr_idx);
+
+  bool g1_can_remove_post_barrier(PhaseTransform* phase, Node* store, Node* adr);
+
   void g1_mark_card(IdealKit& ideal, Node* card_adr, Node* store, uint oop_alias_idx,
                     Node* index, Node* index_adr,
                     Node* buffer, const TypeFunc* tf);
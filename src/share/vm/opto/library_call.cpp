@@ -236,6 +236,10 @@ class LibraryCallKit : public GraphKit {
   static bool klass_needs_init_guard(Node* kls);
   bool inline_unsafe_allocate();
   bool inline_unsafe_copyMemory();
+  bool inline_unsafe_copyMemory_small(Node* src, Node* dst, jlong size);
+  void unsafe_length_guard(Node* length);
+  bool inline_unsafe_vectorizedMismatch();
+  bool inline_unsafe_hash();
   bool inline_native_currentThread();
 #ifdef JFR_HAVE_INTRINSICS
   bool inline_native_classID();
@@ -322,9 +326,13 @@ class LibraryCallKit : public GraphKit {
   Node* get_state_from_sha5_object(Node *sha_object);
   Node* inline_digestBase_implCompressMB_predicate(int predicate);
   bool inline_encodeISOArray();
+  bool inline_charset_array_coder(vmIntrinsics::ID id);
   bool inline_updateCRC32();
   bool inline_updateBytesCRC32();
   bool inline_updateByteBufferCRC32();
+  Node* make_array_hashCode_call(BasicType elem_type, Node* h, Node* start, Node* cnt);
+  bool inline_string_hashCode();
+  bool inline_array_hashCode(BasicType elem_type);
   bool inline_multiplyToLen();
   bool inline_squareToLen();
   bool inline_mulAdd();
@@ -418,6 +426,14 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (StubRoutines::unsafe_arraycopy() == NULL)  return NULL;
     if (!InlineArrayCopy)  return NULL;
     break;
+  case vmIntrinsics::_vectorizedMismatch:
+    if (!UseUnsafeMemoryIntrinsics) return NULL;
+    if (StubRoutines::unsafeVectorizedMismatch() == NULL) return NULL;
+    break;
+  case vmIntrinsics::_unsafeHash:
+    if (!UseUnsafeMemoryIntrinsics) return NULL;
+    if (StubRoutines::unsafeHash() == NULL) return NULL;
+    break;
   case vmIntrinsics::_hashCode:
     if (!InlineObjectHash)  return NULL;
     does_virtual_dispatch = true;
@@ -434,6 +450,12 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!SpecialEncodeISOArray)  return NULL;
     if (!Matcher::match_rule_supported(Op_EncodeISOArray))  return NULL;
     break;
+  case vmIntrinsics::_utf8Decode:
+  case vmIntrinsics::_utf8Encode:
+  case vmIntrinsics::_latin1Decode:
+    if (!UseCharsetArrayCoderIntrinsics)  return NULL;
+    if (CCallingConventionRequiresIntsAsLongs)  return NULL;
+    break;
   case vmIntrinsics::_checkIndex:
     // We do not intrinsify this.  The optimizer does fine with it.
     return NULL;
@@ -582,6 +604,23 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!UseCRC32Intrinsics) return NULL;
     break;
 
+  case vmIntrinsics::_hashCodeString:
+    if (!UseArrayHashCodeIntrinsics) return NULL;
+    if (StubRoutines::charArrayHashCode() == NULL) return NULL;
+    break;
+  case vmIntrinsics::_hashCodeB:
+    if (!UseArrayHashCodeIntrinsics) return NULL;
+    if (StubRoutines::byteArrayHashCode() == NULL) return NULL;
+    break;
+  case vmIntrinsics::_hashCodeC:
+    if (!UseArrayHashCodeIntrinsics) return NULL;
+    if (StubRoutines::charArrayHashCode() == NULL) return NULL;
+    break;
+  case vmIntrinsics::_hashCodeI:
+    if (!UseArrayHashCodeIntrinsics) return NULL;
+    if (StubRoutines::intArrayHashCode() == NULL) return NULL;
+    break;
+
   case vmIntrinsics::_incrementExactI:
   case vmIntrinsics::_addExactI:
     if (!Matcher::match_rule_supported(Op_OverflowAddI) || !UseMathExactIntrinsics) return NULL;
@@ -894,6 +933,8 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_nanoTime:                 return inline_native_time_funcs(CAST_FROM_FN_PTR(address, os::javaTimeNanos), "nanoTime");
   case vmIntrinsics::_allocateInstance:         return inline_unsafe_allocate();
   case vmIntrinsics::_copyMemory:               return inline_unsafe_copyMemory();
+  case vmIntrinsics::_vectorizedMismatch:       return inline_unsafe_vectorizedMismatch();
+  case vmIntrinsics::_unsafeHash:               return inline_unsafe_hash();
   case vmIntrinsics::_newArray:                 return inline_native_newArray();
   case vmIntrinsics::_getLength:                return inline_native_getLength();
   case vmIntrinsics::_copyOf:                   return inline_array_copyOf(false);
@@ -968,6 +1009,10 @@ bool LibraryCallKit::try_to_inline(int predicate) {
 
   case vmIntrinsics::_encodeISOArray:
     return inline_encodeISOArray();
+  case vmIntrinsics::_utf8Decode:
+  case vmIntrinsics::_utf8Encode:
+  case vmIntrinsics::_latin1Decode:
+    return inline_charset_array_coder(intrinsic_id());
 
   case vmIntrinsics::_updateCRC32:
     return inline_updateCRC32();
@@ -976,6 +1021,15 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_updateByteBufferCRC32:
     return inline_updateByteBufferCRC32();
 
+  case vmIntrinsics::_hashCodeString:
+    return inline_string_hashCode();
+  case vmIntrinsics::_hashCodeB:
+    return inline_array_hashCode(T_BYTE);
+  case vmIntrinsics::_hashCodeC:
+    return inline_array_hashCode(T_CHAR);
+  case vmIntrinsics::_hashCodeI:
+    return inline_array_hashCode(T_INT);
+
   case vmIntrinsics::_profileBoolean:
     return inline_profileBoolean();
 
@@ -4475,6 +4529,18 @@ bool LibraryCallKit::inline_unsafe_copyMemory() {
   Node* src = make_unsafe_address(src_ptr, src_off);
   Node* dst = make_unsafe_address(dst_ptr, dst_off);
 
+#ifdef AMD64
+  // Small off-heap copies of a constant size are done inline.
+  const TypeLong* size_type = _gvn.type(argument(7))->isa_long();
+  if (UseUnsafeMemoryIntrinsics &&
+      size_type != NULL && size_type->is_con() &&
+      _gvn.type(src_ptr) == TypePtr::NULL_PTR &&
+      _gvn.type(dst_ptr) == TypePtr::NULL_PTR &&
+      inline_unsafe_copyMemory_small(src, dst, size_type->get_con())) {
+    return true;
+  }
+#endif // AMD64
+
   // Conservatively insert a memory barrier on all memory slices.
   // Do not let writes of the copy source or destination float below the copy.
   insert_mem_bar(Op_MemBarCPUOrder);
@@ -4493,6 +4559,128 @@ bool LibraryCallKit::inline_unsafe_copyMemory() {
   return true;
 }
 
+// Copy 'size' bytes between raw addresses with word moves, largest first.
+// All loads are done before the first store so that overlapping ranges are
+// copied correctly. Each move covers naturally aligned units of its own
+// size and smaller, which keeps the atomicity copyMemory promises.
+bool LibraryCallKit::inline_unsafe_copyMemory_small(Node* src, Node* dst, jlong size) {
+  const jlong max_inline_size = 8 * BytesPerLong;
+  if (size <= 0 || size > max_inline_size) {
+    return false;
+  }
+
+  const int max_moves = 8 + 3;
+  Node*     values[max_moves];
+  BasicType types[max_moves];
+  jlong     offsets[max_moves];
+  int moves = 0;
+  for (jlong off = 0; off < size; moves++) {
+    jlong left = size - off;
+    BasicType bt = left >= BytesPerLong  ? T_LONG  :
+                   left >= BytesPerInt   ? T_INT   :
+                   left >= BytesPerShort ? T_SHORT : T_BYTE;
+    Node* adr = basic_plus_adr(top(), src, off);
+    values[moves]  = make_load(control(), adr, Type::get_const_basic_type(bt), bt,
+                               Compile::AliasIdxRaw, MemNode::unordered,
+                               LoadNode::DependsOnlyOnTest, false, true, true);
+    types[moves]   = bt;
+    offsets[moves] = off;
+    off += type2aelembytes(bt);
+  }
+  assert(moves <= max_moves, "too many moves");
+
+  insert_mem_bar(Op_MemBarCPUOrder);
+  for (int i = 0; i < moves; i++) {
+    Node* adr = basic_plus_adr(top(), dst, offsets[i]);
+    store_to_memory(control(), adr, values[i], types[i], Compile::AliasIdxRaw,
+                    MemNode::unordered, false, true, true);
+  }
+  insert_mem_bar(Op_MemBarCPUOrder);
+  return true;
+}
+
+// The natives of the Unsafe bulk memory methods throw
+// IllegalArgumentException for a negative length, deoptimize for it.
+void LibraryCallKit::unsafe_length_guard(Node* length) {
+  Node* cmp = _gvn.transform(new (C) CmpLNode(length, longcon(0)));
+  Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ge));
+  { BuildCutout unless(this, bol, PROB_MAX);
+    uncommon_trap(Deoptimization::Reason_intrinsic,
+                  Deoptimization::Action_maybe_recompile);
+  }
+}
+
+//----------------------inline_unsafe_vectorizedMismatch-------------------
+// public native long sun.misc.Unsafe.vectorizedMismatch(Object aBase, long aOffset, Object bBase, long bOffset, long bytes);
+bool LibraryCallKit::inline_unsafe_vectorizedMismatch() {
+  if (callee()->is_static())  return false;  // caller must have the capability!
+  if (too_many_traps(Deoptimization::Reason_intrinsic))  return false;
+  null_check_receiver();  // null-check receiver
+  if (stopped())  return true;
+
+  C->set_has_unsafe_access(true);  // Mark eventual nmethod as "unsafe".
+
+  Node* a_ptr  =         argument(1);   // type: oop
+  Node* a_off  = ConvL2X(argument(2));  // type: long
+  Node* b_ptr  =         argument(4);   // type: oop
+  Node* b_off  = ConvL2X(argument(5));  // type: long
+  Node* length =         argument(7);   // type: long
+
+  unsafe_length_guard(length);
+  if (stopped())  return true;
+
+  Node* a = make_unsafe_address(a_ptr, a_off);
+  Node* b = make_unsafe_address(b_ptr, b_off);
+
+  // Do not let writes of the compared memory float below the call.
+  insert_mem_bar(Op_MemBarCPUOrder);
+
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+                                 OptoRuntime::unsafeVectorizedMismatch_Type(),
+                                 StubRoutines::unsafeVectorizedMismatch(),
+                                 "unsafeVectorizedMismatch",
+                                 TypePtr::BOTTOM,
+                                 a, b, ConvL2X(length) XTOP);
+  Node* result = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
+//----------------------inline_unsafe_hash---------------------------------
+// public native int sun.misc.Unsafe.hash(Object base, long offset, long bytes, int seed);
+bool LibraryCallKit::inline_unsafe_hash() {
+  if (callee()->is_static())  return false;  // caller must have the capability!
+  if (too_many_traps(Deoptimization::Reason_intrinsic))  return false;
+  null_check_receiver();  // null-check receiver
+  if (stopped())  return true;
+
+  C->set_has_unsafe_access(true);  // Mark eventual nmethod as "unsafe".
+
+  Node* ptr    =         argument(1);   // type: oop
+  Node* off    = ConvL2X(argument(2));  // type: long
+  Node* length =         argument(4);   // type: long
+  Node* seed   =         argument(6);   // type: int
+
+  unsafe_length_guard(length);
+  if (stopped())  return true;
+
+  Node* p = make_unsafe_address(ptr, off);
+
+  // Do not let writes of the hashed memory float below the call.
+  insert_mem_bar(Op_MemBarCPUOrder);
+
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP,
+                                 OptoRuntime::unsafeHash_Type(),
+                                 StubRoutines::unsafeHash(),
+                                 "unsafeHash",
+                                 TypePtr::BOTTOM,
+                                 p, ConvL2X(length) XTOP,
+                                 ConvI2L(seed), top());
+  Node* result = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+  set_result(result);
+  return true;
+}
+
 //------------------------clone_coping-----------------------------------
 // Helper function for inline_native_clone.
 void LibraryCallKit::copy_to_clone(Node* obj, Node* alloc_obj, Node* obj_size, bool is_array, bool card_mark) {
@@ -5842,6 +6030,160 @@ bool LibraryCallKit::inline_encodeISOArray() {
   return true;
 }
 
+//-------------inline_charset_array_coder------------------------------
+// int sun.nio.cs.UTF_8$Decoder.decode(byte[] sa, int sp, int len, char[] da)
+// int sun.nio.cs.UTF_8$Encoder.encode(char[] sa, int sp, int len, byte[] da)
+// int sun.nio.cs.ISO_8859_1$Decoder.decode(byte[] sa, int sp, int len, char[] da)
+//
+// The leaf stub converts input which is well-formed and fits into 'da'.
+// Everything else (bad arguments, malformed input which has to be
+// replaced or reported, 'da' too short) goes to the Java method, which
+// starts over from 'sp'.
+bool LibraryCallKit::inline_charset_array_coder(vmIntrinsics::ID id) {
+  address stubAddr;
+  const char* stubName;
+  BasicType src_elem;
+  BasicType dst_elem;
+  switch (id) {
+  case vmIntrinsics::_utf8Decode:
+    stubAddr = StubRoutines::utf8Decode();
+    stubName = "utf8Decode";
+    src_elem = T_BYTE;
+    dst_elem = T_CHAR;
+    break;
+  case vmIntrinsics::_utf8Encode:
+    stubAddr = StubRoutines::utf8Encode();
+    stubName = "utf8Encode";
+    src_elem = T_CHAR;
+    dst_elem = T_BYTE;
+    break;
+  case vmIntrinsics::_latin1Decode:
+    stubAddr = StubRoutines::latin1Decode();
+    stubName = "latin1Decode";
+    src_elem = T_BYTE;
+    dst_elem = T_CHAR;
+    break;
+  default:
+    fatal_unexpected_iid(id);
+    return false;
+  }
+  if (stubAddr == NULL) {
+    return false; // Intrinsic's stub is not implemented on this platform
+  }
+
+  assert(callee()->signature()->size() == 4, "charset array coders have 4 parameters");
+  Node* src = argument(1);
+  Node* sp  = argument(2);
+  Node* len = argument(3);
+  Node* dst = argument(4);
+
+  const TypeAryPtr* top_src = src->Value(&_gvn)->isa_aryptr();
+  const TypeAryPtr* top_dst = dst->Value(&_gvn)->isa_aryptr();
+  if (top_src == NULL || top_src->klass() == NULL ||
+      top_dst == NULL || top_dst->klass() == NULL) {
+    // failed array check
+    return false;
+  }
+  if (top_src->klass()->as_array_klass()->element_type()->basic_type() != src_elem ||
+      top_dst->klass()->as_array_klass()->element_type()->basic_type() != dst_elem) {
+    return false;
+  }
+
+  null_check_receiver();
+  if (stopped())  return true;
+
+  // Arguments the stub cannot take go straight to the Java method.
+  RegionNode* bad_args = new (C) RegionNode(1);
+  record_for_igvn(bad_args);
+
+  Node* null_ctl = top();
+  src = null_check_oop(src, &null_ctl);
+  if (null_ctl != top())  bad_args->add_req(null_ctl);
+  null_ctl = top();
+  dst = null_check_oop(dst, &null_ctl);
+  if (null_ctl != top())  bad_args->add_req(null_ctl);
+
+  generate_negative_guard(sp, bad_args);
+  generate_negative_guard(len, bad_args);
+  if (!stopped()) {
+    generate_limit_guard(sp, len, load_array_length(src), bad_args);
+  }
+
+  Node* pre_mem = reset_memory();
+  set_all_memory(pre_mem);
+
+  enum { _stub_path = 1, _bad_args_path, STUB_LIMIT };
+
+  RegionNode* stub_reg = new (C) RegionNode(STUB_LIMIT);
+  PhiNode*    stub_val = new (C) PhiNode(stub_reg, TypeInt::INT);
+  PhiNode*    stub_mem = new (C) PhiNode(stub_reg, Type::MEMORY, TypePtr::BOTTOM);
+
+  if (!stopped()) {
+    Node* src_start = array_element_address(src, sp, src_elem);
+    Node* dst_start = array_element_address(dst, intcon(0), dst_elem);
+    Node* dst_len   = load_array_length(dst);
+    Node* call = make_runtime_call(RC_LEAF,
+                                   OptoRuntime::charsetArrayCoder_Type(),
+                                   stubAddr, stubName, TypePtr::BOTTOM,
+                                   src_start, len, dst_start, dst_len);
+    Node* res = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+    stub_reg->init_req(_stub_path, control());
+    stub_val->init_req(_stub_path, res);
+    stub_mem->init_req(_stub_path, reset_memory());
+  } else {
+    stub_reg->init_req(_stub_path, top());
+    stub_val->init_req(_stub_path, top());
+    stub_mem->init_req(_stub_path, top());
+  }
+  stub_reg->init_req(_bad_args_path, _gvn.transform(bad_args));
+  stub_val->init_req(_bad_args_path, intcon(-1));
+  stub_mem->init_req(_bad_args_path, pre_mem);
+
+  set_control(_gvn.transform(stub_reg));
+  set_all_memory(_gvn.transform(stub_mem));
+  Node* stub_res = _gvn.transform(stub_val);
+
+  enum { _slow_path = 1, _fast_path, PATH_LIMIT };
+
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::INT);
+  PhiNode*    result_io  = new (C) PhiNode(result_reg, Type::ABIO);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+
+  // A negative result means the Java method has to do the work.
+  RegionNode* slow_region = new (C) RegionNode(1);
+  record_for_igvn(slow_region);
+  Node* cmp_res = _gvn.transform(new (C) CmpINode(stub_res, intcon(0)));
+  Node* bol_res = _gvn.transform(new (C) BoolNode(cmp_res, BoolTest::lt));
+  generate_slow_guard(bol_res, slow_region);
+
+  Node* fast_mem = reset_memory();
+  result_reg->init_req(_fast_path, control());
+  result_val->init_req(_fast_path, stub_res);
+  result_io ->init_req(_fast_path, i_o());
+  result_mem->init_req(_fast_path, fast_mem);
+
+  set_control(_gvn.transform(slow_region));
+  if (!stopped()) {
+    // No need for PreserveJVMState, because we're using up the present state.
+    set_all_memory(fast_mem);
+    CallJavaNode* slow_call = generate_method_call(id, /*!virtual*/ false, /*!static*/ false);
+    Node* slow_result = set_results_for_java_call(slow_call);
+    // this->control() comes from set_results_for_java_call
+    result_reg->init_req(_slow_path, control());
+    result_val->init_req(_slow_path, slow_result);
+    result_io ->init_req(_slow_path, i_o());
+    result_mem->init_req(_slow_path, reset_memory());
+  }
+
+  // Return the combined state.
+  set_i_o(        _gvn.transform(result_io)  );
+  set_all_memory( _gvn.transform(result_mem));
+
+  set_result(result_reg, result_val);
+  return true;
+}
+
 //-------------inline_multiplyToLen-----------------------------------
 bool LibraryCallKit::inline_multiplyToLen() {
   assert(UseMultiplyToLenIntrinsic, "not implementated on this platform");
@@ -6198,6 +6540,7 @@ bool LibraryCallKit::inline_updateCRC32() {
   Node* result = _gvn.transform(new (C) XorINode(crc, b));
   result = _gvn.transform(new (C) AndINode(result, intcon(0xFF)));
 
+  C->env()->record_runtime_constant();
   Node* base = makecon(TypeRawPtr::make(StubRoutines::crc_table_addr()));
   Node* offset = _gvn.transform(new (C) LShiftINode(result, intcon(0x2)));
   Node* adr = basic_plus_adr(top(), base, ConvI2X(offset));
@@ -6298,6 +6641,141 @@ bool LibraryCallKit::inline_updateByteBufferCRC32() {
   return true;
 }
 
+/**
+ * Call the polynomial hash stub for 'cnt' elements of type 'elem_type'
+ * starting at 'start':  for (i = 0; i < cnt; i++) h = 31 * h + a[i];
+ */
+Node* LibraryCallKit::make_array_hashCode_call(BasicType elem_type, Node* h, Node* start, Node* cnt) {
+  address stubAddr = NULL;
+  const char* stubName = NULL;
+  const TypePtr* adr_type = NULL;
+  switch (elem_type) {
+  case T_BYTE:
+    stubAddr = StubRoutines::byteArrayHashCode();
+    stubName = "byteArrayHashCode";
+    adr_type = TypeAryPtr::BYTES;
+    break;
+  case T_CHAR:
+    stubAddr = StubRoutines::charArrayHashCode();
+    stubName = "charArrayHashCode";
+    adr_type = TypeAryPtr::CHARS;
+    break;
+  case T_INT:
+    stubAddr = StubRoutines::intArrayHashCode();
+    stubName = "intArrayHashCode";
+    adr_type = TypeAryPtr::INTS;
+    break;
+  default:
+    ShouldNotReachHere();
+  }
+  assert(stubAddr != NULL, "checked in make_vm_intrinsic");
+
+  Node* call;
+  if (CCallingConventionRequiresIntsAsLongs) {
+    call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::arrayHashCode_Type(),
+                             stubAddr, stubName, adr_type,
+                             h XTOP, start, cnt XTOP);
+  } else {
+    call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::arrayHashCode_Type(),
+                             stubAddr, stubName, adr_type,
+                             h, start, cnt);
+  }
+  return _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+}
+
+/**
+ * Calculate the hash code of a String and cache it.
+ * int java.lang.String.hashCode()
+ */
+bool LibraryCallKit::inline_string_hashCode() {
+  if (!java_lang_String::has_hash_field()) {
+    return false;
+  }
+  Node* receiver = null_check_receiver();
+  if (stopped()) {
+    return true;
+  }
+
+  // paths (plus control) merge
+  RegionNode* region = new (C) RegionNode(3);
+  Node* phi = new (C) PhiNode(region, TypeInt::INT);
+
+  int hash_offset = java_lang_String::hash_offset_in_bytes();
+  const TypeInstPtr* string_type = TypeInstPtr::make(TypePtr::NotNull, C->env()->String_klass(),
+                                                     false, NULL, 0);
+  const TypePtr* hash_field_type = string_type->add_offset(hash_offset);
+  int hash_field_idx = C->get_alias_index(hash_field_type);
+  Node* hash_adr = basic_plus_adr(receiver, receiver, hash_offset);
+  Node* hash = make_load(control(), hash_adr, TypeInt::INT, T_INT, hash_field_idx, MemNode::unordered);
+
+  // is the hash code already cached?
+  Node* cmp = _gvn.transform(new (C) CmpINode(hash, intcon(0)));
+  Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ne));
+  Node* if_cached = generate_guard(bol, NULL, PROB_LIKELY_MAG(1));
+  if (if_cached != NULL) {
+    phi->init_req(2, hash);
+    region->init_req(2, if_cached);
+  }
+
+  if (!stopped()) {
+    Node* no_ctrl = NULL;
+    Node* value  = load_String_value(no_ctrl, receiver);
+    Node* offset = load_String_offset(no_ctrl, receiver);
+    Node* start  = array_element_address(value, offset, T_CHAR);
+    Node* cnt    = load_String_length(no_ctrl, receiver);
+
+    Node* h = make_array_hashCode_call(T_CHAR, intcon(0), start, cnt);
+    // Storing 0 for an empty string is benign: it is the value already there.
+    store_to_memory(control(), hash_adr, h, T_INT, hash_field_idx, MemNode::unordered);
+    phi->init_req(1, h);
+    region->init_req(1, control());
+  }
+
+  // post merge
+  set_control(_gvn.transform(region));
+  record_for_igvn(region);
+
+  set_result(_gvn.transform(phi));
+  return true;
+}
+
+/**
+ * Calculate the hash code of a primitive array.
+ * int java.util.Arrays.hashCode(byte[] a)
+ * int java.util.Arrays.hashCode(char[] a)
+ * int java.util.Arrays.hashCode(int[] a)
+ */
+bool LibraryCallKit::inline_array_hashCode(BasicType elem_type) {
+  Node* ary = argument(0);
+
+  // paths (plus control) merge
+  RegionNode* region = new (C) RegionNode(3);
+  Node* phi = new (C) PhiNode(region, TypeInt::INT);
+
+  // hashCode(null) is 0
+  Node* null_ctl = top();
+  ary = null_check_oop(ary, &null_ctl);
+  if (null_ctl != top()) {
+    phi->init_req(2, intcon(0));
+    region->init_req(2, null_ctl);
+  }
+
+  if (!stopped()) {
+    Node* start = array_element_address(ary, intcon(0), elem_type);
+    Node* cnt   = load_array_length(ary);
+    Node* h = make_array_hashCode_call(elem_type, intcon(1), start, cnt);
+    phi->init_req(1, h);
+    region->init_req(1, control());
+  }
+
+  // post merge
+  set_control(_gvn.transform(region));
+  record_for_igvn(region);
+
+  set_result(_gvn.transform(phi));
+  return true;
+}
+
 //----------------------------inline_reference_get----------------------------
 // public T java.lang.ref.Reference.get();
 bool LibraryCallKit::inline_reference_get() {
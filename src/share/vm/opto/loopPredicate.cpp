@@ -601,6 +601,73 @@ bool IdealLoopTree::is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invari
   return true;
 }
 
+//------------------------------is_monotonic_range_check_if---------------------
+// Returns true if the predicate of iff is in "iv + offset u< range" format,
+// where iv is the induction variable of a non-counted loop (see
+// is_monotonic_loop_exit). For a long iv the index is "(int)iv + offset" and
+// offset must not be negative, so that the predicates also prove the
+// conversion to int exact.
+bool IdealLoopTree::is_monotonic_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar,
+                                                Node* iv, Node** p_offset) const {
+  if (!is_loop_exit(iff)) {
+    return false;
+  }
+  if (!iff->in(1)->is_Bool()) {
+    return false;
+  }
+  const BoolNode *bol = iff->in(1)->as_Bool();
+  if (bol->_test._test != BoolTest::lt) {
+    return false;
+  }
+  if (!bol->in(1)->is_Cmp()) {
+    return false;
+  }
+  const CmpNode *cmp = bol->in(1)->as_Cmp();
+  if (cmp->Opcode() != Op_CmpU) {
+    return false;
+  }
+  Node* range = cmp->in(2);
+  if (range->Opcode() != Op_LoadRange) {
+    const TypeInt* tint = phase->_igvn.type(range)->isa_int();
+    if (tint == NULL || tint->empty() || tint->_lo < 0) {
+      return false;
+    }
+  }
+  if (!invar.is_invariant(range)) {
+    return false;
+  }
+  Node* idx    = cmp->in(1);
+  Node* offset = NULL;
+  if (idx->Opcode() == Op_AddI) {
+    if (invar.is_invariant(idx->in(2))) {
+      offset = idx->in(2);
+      idx    = idx->in(1);
+    } else if (invar.is_invariant(idx->in(1))) {
+      offset = idx->in(1);
+      idx    = idx->in(2);
+    } else {
+      return false;
+    }
+  }
+  if (phase->_igvn.type(iv)->isa_long() != NULL) {
+    if (idx->Opcode() != Op_ConvL2I) {
+      return false;
+    }
+    idx = idx->in(1);
+    if (offset != NULL) {
+      const TypeInt* toff = phase->_igvn.type(offset)->isa_int();
+      if (toff == NULL || toff->empty() || toff->_lo < 0) {
+        return false;
+      }
+    }
+  }
+  if (idx != iv) {
+    return false;
+  }
+  *p_offset = offset;
+  return true;
+}
+
 //------------------------------rc_predicate-----------------------------------
 // Create a range check predicate
 //
@@ -775,6 +842,189 @@ BoolNode* PhaseIdealLoop::rc_predicate(IdealLoopTree *loop, Node* ctrl,
   return bol;
 }
 
+//------------------------------is_monotonic_loop_exit-------------------------
+// Non-counted loops (variable stride, long limit or long induction variable)
+// get no range check predicates from the counted loop machinery. Some of
+// them still have an index with provable bounds:
+//
+// for (iv = init; iv < limit; iv += stride) {   // or iv <= limit
+//    a[iv + offset]
+// }
+//
+// stride is any loop variant value that is known to be non-negative, so iv
+// never decreases (with no overflow, see monotonic_rc_predicates). proj is
+// the projection of the exit test that stays in the loop; it must dominate
+// the loop tail, so every iteration passed it before iv is incremented.
+bool PhaseIdealLoop::is_monotonic_loop_exit(IdealLoopTree* loop, ProjNode* proj, Invariance& invar,
+                                            Node** p_iv, Node** p_stride, Node** p_limit, bool* p_inclusive) {
+  IfNode* iff = proj->in(0)->as_If();
+  if (!loop->is_loop_exit(iff) || !iff->in(1)->is_Bool()) {
+    return false;
+  }
+  BoolNode* bol = iff->in(1)->as_Bool();
+  Node* cmp = bol->in(1);
+  if (cmp->Opcode() != Op_CmpI && cmp->Opcode() != Op_CmpL) {
+    return false;
+  }
+  // The condition under which execution stays in the loop
+  BoolTest::mask bt = bol->_test._test;
+  if (proj->_con == 0) {
+    bt = BoolTest(bt).negate();
+  }
+  Node* x     = cmp->in(1);
+  Node* limit = cmp->in(2);
+  if (invar.is_invariant(x)) {
+    x     = cmp->in(2);
+    limit = cmp->in(1);
+    bt    = BoolTest(bt).commute();
+  }
+  if ((bt != BoolTest::lt && bt != BoolTest::le) ||
+      invar.is_invariant(x) || !invar.is_invariant(limit)) {
+    return false;
+  }
+  Node* iv = (x->Opcode() == Op_ConvI2L) ? x->in(1) : x;
+  if (!iv->is_Phi() || iv->in(0) != loop->_head || iv->req() != LoopNode::LoopBackControl + 1) {
+    return false;
+  }
+  bool long_iv = _igvn.type(iv)->isa_long() != NULL;
+  // "CmpI iv limit", "CmpL iv limit" for a long iv or "CmpL (ConvI2L iv) limit"
+  if ((cmp->Opcode() == Op_CmpL) != (long_iv || x != iv)) {
+    return false;
+  }
+  Node* incr = iv->in(LoopNode::LoopBackControl);
+  if (incr == NULL || incr->Opcode() != (long_iv ? Op_AddL : Op_AddI)) {
+    return false;
+  }
+  Node* stride = NULL;
+  if (incr->in(1) == iv) {
+    stride = incr->in(2);
+  } else if (incr->in(2) == iv) {
+    stride = incr->in(1);
+  } else {
+    return false;
+  }
+  if (long_iv) {
+    // A long iv is bounded by an array length, a stride up to max_jint
+    // cannot overflow it.
+    const TypeLong* tstride = _igvn.type(stride)->isa_long();
+    if (tstride == NULL || tstride->empty() || tstride->_lo < 0 || tstride->_hi > max_jint) {
+      return false;
+    }
+  } else {
+    const TypeInt* tstride = _igvn.type(stride)->isa_int();
+    if (tstride == NULL || tstride->empty() || tstride->_lo < 0) {
+      return false;
+    }
+  }
+  *p_iv        = iv;
+  *p_stride    = stride;
+  *p_limit     = limit;
+  *p_inclusive = (bt == BoolTest::le);
+  return true;
+}
+
+Node* PhaseIdealLoop::long_value(Node* n, Node* ctrl) {
+  if (_igvn.type(n)->isa_long() != NULL) {
+    return n;
+  }
+  Node* l = new (C) ConvI2LNode(n);
+  register_new_node(l, ctrl);
+  return l;
+}
+
+void PhaseIdealLoop::set_long_predicate(ProjNode* proj, Node* ctrl, Node* a, BoolTest::mask test, Node* b) {
+  CmpNode* cmp = new (C) CmpLNode(a, b);
+  register_new_node(cmp, ctrl);
+  BoolNode* bol = new (C) BoolNode(cmp, test);
+  register_new_node(bol, ctrl);
+  IfNode* iff = proj->in(0)->as_If();
+  _igvn.hash_delete(iff);
+  iff->set_req(1, bol);
+}
+
+//------------------------------monotonic_rc_predicates-------------------------
+// Create the predicates for a range check "iv + offset u< range" on the
+// induction variable iv matched by is_monotonic_loop_exit, all computed with
+// longs so that they cannot overflow themselves. With max = limit - 1 (or
+// limit for "iv <= limit"), iv stays in [init, max] and is accessed as
+// index if
+//
+//   init + offset >= 0,
+//   max + offset < range,
+//   max + max(stride) <= max_jint   (int iv only: iv += stride cannot wrap)
+//
+// The last test is omitted if the types already prove it. Returns the
+// projection of the last predicate.
+ProjNode* PhaseIdealLoop::monotonic_rc_predicates(ProjNode* predicate_proj, Invariance& invar,
+                                                  Node* iv, Node* stride, Node* limit, bool inclusive,
+                                                  Node* range, Node* offset) {
+  bool long_iv = _igvn.type(iv)->isa_long() != NULL;
+  const TypeLong* tlimit = _igvn.type(limit)->isa_long();
+  jlong max_hi = (tlimit != NULL) ? tlimit->_hi : (jlong)_igvn.type(limit)->is_int()->_hi;
+  if (!inclusive) {
+    max_hi -= 1;
+  }
+  jlong stride_hi = long_iv ? _igvn.type(stride)->is_long()->_hi : (jlong)_igvn.type(stride)->is_int()->_hi;
+  bool check_overflow = !long_iv && max_hi > (jlong)max_jint - stride_hi;
+
+  // As for counted loops, the first predicate dominates the others and all
+  // new nodes are controlled by the predicate above it.
+  ProjNode* lower_proj    = create_new_if_for_predicate(predicate_proj, NULL, Deoptimization::Reason_predicate);
+  ProjNode* upper_proj    = create_new_if_for_predicate(predicate_proj, NULL, Deoptimization::Reason_predicate);
+  ProjNode* overflow_proj = check_overflow ? create_new_if_for_predicate(predicate_proj, NULL, Deoptimization::Reason_predicate) : NULL;
+  Node* ctrl = lower_proj->in(0)->as_If()->in(0);
+
+  range = long_value(invar.clone(range, ctrl), ctrl);
+  limit = long_value(invar.clone(limit, ctrl), ctrl);
+  if (offset != NULL) {
+    offset = long_value(invar.clone(offset, ctrl), ctrl);
+  }
+  Node* init = long_value(iv->in(LoopNode::EntryControl), ctrl);
+
+  ConLNode* zero = _igvn.longcon(0);
+  set_ctrl(zero, C->root());
+
+  // init + offset >= 0
+  Node* lo = init;
+  if (offset != NULL) {
+    lo = new (C) AddLNode(lo, offset);
+    register_new_node(lo, ctrl);
+  }
+  set_long_predicate(lower_proj, ctrl, lo, BoolTest::ge, zero);
+
+  // max + offset < range
+  Node* max = limit;
+  if (!inclusive) {
+    ConLNode* minus_one = _igvn.longcon(-1);
+    set_ctrl(minus_one, C->root());
+    max = new (C) AddLNode(limit, minus_one);
+    register_new_node(max, ctrl);
+  }
+  Node* hi = max;
+  if (offset != NULL) {
+    hi = new (C) AddLNode(hi, offset);
+    register_new_node(hi, ctrl);
+  }
+  set_long_predicate(upper_proj, ctrl, hi, BoolTest::lt, range);
+
+  // max + max(stride) <= max_jint
+  if (overflow_proj != NULL) {
+    ConLNode* con_stride = _igvn.longcon(stride_hi);
+    set_ctrl(con_stride, C->root());
+    ConLNode* con_max = _igvn.longcon(max_jint);
+    set_ctrl(con_max, C->root());
+    Node* next = new (C) AddLNode(max, con_stride);
+    register_new_node(next, ctrl);
+    set_long_predicate(overflow_proj, ctrl, next, BoolTest::le, con_max);
+  }
+
+  if (TraceLoopPredicate) {
+    tty->print_cr("monotonic rc predicates: %d %d%s", lower_proj->in(0)->_idx, upper_proj->in(0)->_idx,
+                  overflow_proj != NULL ? " +overflow" : "");
+  }
+  return overflow_proj != NULL ? overflow_proj : upper_proj;
+}
+
 //------------------------------ loop_predication_impl--------------------------
 // Insert loop predicates for null checks and range checks
 bool PhaseIdealLoop::loop_predication_impl(IdealLoopTree *loop) {
@@ -841,6 +1091,12 @@ bool PhaseIdealLoop::loop_predication_impl(IdealLoopTree *loop) {
     current_proj = idom(current_proj);
   }
 
+  // Induction variable of a non-counted loop, once its exit test was seen
+  Node* mono_iv        = NULL;
+  Node* mono_stride    = NULL;
+  Node* mono_limit     = NULL;
+  bool  mono_inclusive = false;
+
   bool hoisted = false; // true if at least one proj is promoted
   while (if_proj_list.size() > 0) {
     // Following are changed to nonnull when a predicate can be hoisted
@@ -851,6 +1107,13 @@ bool PhaseIdealLoop::loop_predication_impl(IdealLoopTree *loop) {
 
     if (!proj->is_uncommon_trap_if_pattern(Deoptimization::Reason_none)) {
       if (loop->is_loop_exit(iff)) {
+        if (UseNonCountedLoopPredicate && cl == NULL && mono_iv == NULL &&
+            is_monotonic_loop_exit(loop, proj, invar, &mono_iv, &mono_stride, &mono_limit, &mono_inclusive)) {
+          // The exit test bounds the induction variable for the range checks
+          // it dominates. Those still depend on it, so only range checks are
+          // promoted from here on.
+          continue;
+        }
         // stop processing the remaining projs in the list because the execution of them
         // depends on the condition of "iff" (iff->in(1)).
         break;
@@ -871,7 +1134,8 @@ bool PhaseIdealLoop::loop_predication_impl(IdealLoopTree *loop) {
       continue;
     }
     BoolNode* bol = test->as_Bool();
-    if (invar.is_invariant(bol)) {
+    Node* mono_offset = NULL;
+    if (invar.is_invariant(bol) && mono_iv == NULL) {
       // Invariant test
       new_predicate_proj = create_new_if_for_predicate(predicate_proj, NULL,
                                                        Deoptimization::Reason_predicate);
@@ -961,6 +1225,19 @@ bool PhaseIdealLoop::loop_predication_impl(IdealLoopTree *loop) {
         tty->print("Predicate RC ");
         loop->dump_head();
       }
+#endif
+    } else if ((mono_iv != NULL) && (proj->_con == predicate_proj->_con) &&
+               loop->is_monotonic_range_check_if(iff, this, invar, mono_iv, &mono_offset)) {
+
+      // Range check on the monotonic induction variable of a non-counted loop
+      Node* rng = bol->in(1)->in(2);
+      new_predicate_proj = monotonic_rc_predicates(predicate_proj, invar, mono_iv, mono_stride,
+                                                   mono_limit, mono_inclusive, rng, mono_offset);
+#ifndef PRODUCT
+      if (TraceLoopOpts && !TraceLoopPredicate) {
+        tty->print("Predicate RC (non-counted) ");
+        loop->dump_head();
+      }
 #endif
     } else {
       // Loop variant check (for example, range check in non-counted loop)
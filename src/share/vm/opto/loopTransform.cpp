@@ -34,6 +34,7 @@
 #include "opto/rootnode.hpp"
 #include "opto/runtime.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 
 //------------------------------is_loop_exit-----------------------------------
 // Given an IfNode, return the loop-exiting projection or NULL if both
@@ -895,6 +896,106 @@ bool PhaseIdealLoop::cast_incr_before_loop(Node* incr, Node* ctrl, Node* loop) {
   return false;
 }
 
+//------------------------------strip_mine_loop--------------------------------
+// Move the backedge safepoint of a loop to a new outer loop and bound the
+// number of iterations between two polls by LoopStripMiningIter:
+//
+//   do {                          do {
+//     body;                         inner_limit = min(limit, i + N*stride);
+//     i += stride;                  do {
+//     safepoint;          ==>         body;
+//   } while (i < limit);              i += stride;
+//                                   } while (i < inner_limit);
+//                                   safepoint;
+//                                 } while (i < limit);
+//
+// The inner loop has no safepoint and becomes a counted loop in the next
+// round of loop opts where it is unrolled and vectorized as usual. The
+// safepoint's jvm state is still valid on the outer backedge: it only
+// depends on values computed in the last inner iteration. The limit and
+// the test are the canonical ones computed by is_counted_loop().
+void PhaseIdealLoop::strip_mine_loop( IdealLoopTree *loop, Node *x, Node *sfpt, PhiNode *phi, Node *stride,
+                                      Node *limit, BoolTest::mask bt, float cl_prob, float cnt ) {
+  assert(bt == BoolTest::lt || bt == BoolTest::gt, "canonical loop test");
+  assert(x->in(LoopNode::LoopBackControl) == sfpt, "safepoint on the backedge");
+  Node* init_control = x->in(LoopNode::EntryControl);
+  Node* iftrue = sfpt->in(TypeFunc::Control);
+  IfNode* iff = iftrue->in(0)->as_If();
+  int stride_con = stride->get_int();
+  PhaseGVN *gvn = &_igvn;
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("StripMine  ");
+    loop->dump_head();
+  }
+#endif
+
+  // New outer loop head. The loop tree is rebuilt in the next round.
+  RegionNode* outer = new (C) RegionNode(3);
+  outer->init_req(LoopNode::EntryControl, init_control);
+  outer->init_req(LoopNode::LoopBackControl, sfpt);
+  _igvn.register_new_node_with_optimizer(outer);
+
+  // Every value carried by the inner loop is carried by the outer loop too.
+  Node_List phis;
+  for (DUIterator_Fast imax, i = x->fast_outs(imax); i < imax; i++) {
+    Node* p = x->fast_out(i);
+    if (p->is_Phi() && p->in(0) == x) {
+      phis.push(p);
+    }
+  }
+  Node* outer_iv = NULL;
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* p = phis.at(i);
+    Node* outer_phi = p->clone();
+    outer_phi->set_req(0, outer);
+    _igvn.register_new_node_with_optimizer(outer_phi);
+    _igvn.replace_input_of(p, LoopNode::EntryControl, outer_phi);
+    if (p == phi) {
+      outer_iv = outer_phi;
+    }
+  }
+  assert(outer_iv != NULL, "no trip counter");
+
+  // inner_limit = min(limit, outer_iv + N*stride) computed in long to
+  // avoid overflow. The inner loop always runs at least one iteration.
+  jlong span = (jlong)LoopStripMiningIter * stride_con;
+  Node* cap_l = gvn->transform(new (C) AddLNode(gvn->transform(new (C) ConvI2LNode(outer_iv)),
+                                                 gvn->longcon(span)));
+  Node* limit_l = gvn->transform(new (C) ConvI2LNode(limit));
+  Node* cmp_cap = gvn->transform(new (C) CmpLNode(cap_l, limit_l));
+  Node* bol_cap = gvn->transform(new (C) BoolNode(cmp_cap, bt));
+  Node* cap = gvn->transform(new (C) ConvL2INode(cap_l));
+  Node* inner_limit = gvn->transform(CMoveNode::make(C, NULL, bol_cap, limit, cap, TypeInt::INT));
+  // The inner limit is not beyond the limit which was checked against
+  // overflow by the loop limit check predicate or by its type.
+  const TypeInt* limit_t = (stride_con > 0) ? TypeInt::make(min_jint, max_jint - stride_con + 1, Type::WidenMax)
+                                            : TypeInt::make(min_jint - stride_con - 1, max_jint, Type::WidenMax);
+  Node* cast = new (C) CastIINode(inner_limit, limit_t, true /* carry_dependency */);
+  cast->set_req(0, outer);
+  inner_limit = gvn->transform(cast);
+
+  // Inner loop exit test. Its exit path goes to the original loop test
+  // which is the test of the outer loop now.
+  Node* incr = gvn->transform(new (C) AddINode(phi, stride));
+  Node* cmp = gvn->transform(new (C) CmpINode(incr, inner_limit));
+  Node* bol = gvn->transform(new (C) BoolNode(cmp, bt));
+  IfNode* inner_iff = new (C) IfNode(iff->in(0), bol, cl_prob, cnt);
+  _igvn.register_new_node_with_optimizer(inner_iff);
+  Node* inner_true = new (C) IfTrueNode(inner_iff);
+  _igvn.register_new_node_with_optimizer(inner_true);
+  Node* inner_false = new (C) IfFalseNode(inner_iff);
+  _igvn.register_new_node_with_optimizer(inner_false);
+
+  _igvn.replace_input_of(iff, 0, inner_false);
+  _igvn.replace_input_of(x, LoopNode::EntryControl, outer);
+  _igvn.replace_input_of(x, LoopNode::LoopBackControl, inner_true);
+
+  _loops_strip_mined = true;
+  C->set_major_progress();
+}
+
 //------------------------------insert_pre_post_loops--------------------------
 // Insert pre and post loops.  If peel_only is set, the pre-loop can not have
 // more iterations added.  It acts as a 'peel' only, no lower-bound RCE, no
@@ -1215,6 +1316,12 @@ void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool ad
   // if rounds of unroll,optimize are making progress
   loop_head->set_node_count_before_unroll(loop->_body.size());
 
+  // Reductions are marked before the first unrolling, so that the
+  // unrolled copies of the reduction operations are marked too.
+  if (UseSuperWord && SuperWordReductions && loop_head->is_main_loop()) {
+    mark_reductions(loop);
+  }
+
   Node *ctrl  = loop_head->in(LoopNode::EntryControl);
   Node *limit = loop_head->limit();
   Node *init  = loop_head->init_trip();
@@ -1521,6 +1628,70 @@ void PhaseIdealLoop::do_maximally_unroll( IdealLoopTree *loop, Node_List &old_ne
   }
 }
 
+//------------------------------mark_reductions--------------------------------
+// Mark the arithmetic nodes which only accumulate a value across iterations:
+// they take the loop phi as input, feed it over the backedge and have no
+// other use in the loop. SuperWord may turn them into vector reductions.
+void PhaseIdealLoop::mark_reductions(IdealLoopTree *loop) {
+  CountedLoopNode* loop_head = loop->_head->as_CountedLoop();
+  if (loop_head->unrolled_count() > 1) {
+    return;
+  }
+
+  Node* trip_phi = loop_head->phi();
+  for (DUIterator_Fast imax, i = loop_head->fast_outs(imax); i < imax; i++) {
+    Node* phi = loop_head->fast_out(i);
+    if (phi->is_Phi() && phi->outcnt() > 0 && phi != trip_phi) {
+      // For definitions which are loop inclusive and not tripcounts.
+      Node* def_node = phi->in(LoopNode::LoopBackControl);
+
+      if (def_node != NULL) {
+        Node* n_ctrl = get_ctrl(def_node);
+        if (n_ctrl != NULL && loop->is_member(get_loop(n_ctrl))) {
+          // Now test it to see if it fits the standard pattern for a reduction operator.
+          int opc = def_node->Opcode();
+          if (opc != ReductionNode::opcode(opc, def_node->bottom_type()->basic_type())) {
+            if (!def_node->is_reduction()) { // Not marked yet
+              // To be a reduction, the arithmetic node must have the phi as input and provide a def to it
+              bool ok = false;
+              for (uint j = 1; j < def_node->req(); j++) {
+                Node* in = def_node->in(j);
+                if (in == phi) {
+                  ok = true;
+                  break;
+                }
+              }
+
+              // do nothing if we did not match the initial criteria
+              if (!ok) {
+                continue;
+              }
+
+              // The result of the reduction must not be used in the loop
+              for (DUIterator_Fast jmax, j = def_node->fast_outs(jmax); j < jmax && ok; j++) {
+                Node* u = def_node->fast_out(j);
+                if (!loop->is_member(get_loop(ctrl_or_self(u)))) {
+                  continue;
+                }
+                if (u == phi) {
+                  continue;
+                }
+                ok = false;
+              }
+
+              // iff the uses conform
+              if (ok) {
+                def_node->add_flag(Node::Flag_is_reduction);
+                loop_head->mark_has_reductions();
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 //------------------------------dominates_backedge---------------------------------
 // Returns true if ctrl is executed on every complete iteration
 bool IdealLoopTree::dominates_backedge(Node* ctrl) {
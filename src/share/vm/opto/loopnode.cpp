@@ -278,13 +278,19 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
     return false;
 
   // Allow funny placement of Safepoint
+  Node* strip_mine_sfpt = NULL;
   if (back_control->Opcode() == Op_SafePoint) {
     if (UseCountedLoopSafepoints) {
-      // Leaving the safepoint on the backedge and creating a
-      // CountedLoop will confuse optimizations. We can't move the
-      // safepoint around because its jvm state wouldn't match a new
-      // location. Give up on that loop.
-      return false;
+      if (LoopStripMiningIter <= 1 || !LoopLimitCheck) {
+        // Leaving the safepoint on the backedge and creating a
+        // CountedLoop will confuse optimizations. We can't move the
+        // safepoint around because its jvm state wouldn't match a new
+        // location. Give up on that loop.
+        return false;
+      }
+      // The safepoint stays on the backedge of an outer loop
+      // around the new counted loop (see strip_mine_loop()).
+      strip_mine_sfpt = back_control;
     }
     back_control = back_control->in(TypeFunc::Control);
   }
@@ -430,6 +436,9 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
       (bt == BoolTest::ge || bt == BoolTest::gt) && stride_con > 0) {
     return false; // Bail out
   }
+  if (strip_mine_sfpt != NULL && bt == BoolTest::ne) {
+    return false; // Can't bound the inner loop with an exclusive test
+  }
 
   const TypeInt* init_t = gvn->type(init_trip)->is_int();
   const TypeInt* limit_t = gvn->type(limit)->is_int();
@@ -596,6 +605,15 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   }
   set_subtree_ctrl( limit );
 
+  if (strip_mine_sfpt != NULL) {
+    // The limit is checked for overflow and the test is canonical now.
+    // The inner loop becomes a counted loop in the next round.
+    strip_mine_loop(loop, x, strip_mine_sfpt, phi, stride, limit, bt,
+                    cl_prob, iff->as_If()->_fcnt);
+    _igvn.remove_dead_node(hook);
+    return false;
+  }
+
   } else { // LoopLimitCheck
 
   // If compare points to incr, we are ok.  Otherwise the compare
@@ -2290,9 +2308,18 @@ void PhaseIdealLoop::build_and_optimize(bool do_split_ifs, bool skip_loop_opts)
 
   // Given early legal placement, try finding counted loops.  This placement
   // is good enough to discover most loop invariants.
+  _loops_strip_mined = false;
   if( !_verify_me && !_verify_only )
     _ltree_root->counted_loop( this );
 
+  if (_loops_strip_mined) {
+    // New outer loops are not in the loop tree. Build it again
+    // in the next round of loop opts.
+    assert(C->major_progress(), "strip mining is major progress");
+    _igvn.optimize();
+    return;
+  }
+
   // Find latest loop placement.  Find ideal loop placement.
   visited.Clear();
   init_dom_lca_tags();
@@ -62,7 +62,8 @@ protected:
          HasExactTripCount=8,
          InnerLoop=16,
          PartialPeelLoop=32,
-         PartialPeelFailed=64 };
+         PartialPeelFailed=64,
+         HasReductions=128 };
   char _unswitch_count;
   enum { _unswitch_max=3 };
 
@@ -77,6 +78,8 @@ public:
   void set_partial_peel_loop() { _loop_flags |= PartialPeelLoop; }
   int partial_peel_has_failed() const { return _loop_flags & PartialPeelFailed; }
   void mark_partial_peel_failed() { _loop_flags |= PartialPeelFailed; }
+  int has_reductions() const { return _loop_flags & HasReductions; }
+  void mark_has_reductions() { _loop_flags |= HasReductions; }
 
   int unswitch_max() { return _unswitch_max; }
   int unswitch_count() { return _unswitch_count; }
@@ -474,6 +477,10 @@ public:
 
   // Return TRUE if "iff" is a range check.
   bool is_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar) const;
+  // Return TRUE if "iff" is a range check "iv + offset u< range" on the
+  // monotonic induction variable "iv" of a non-counted loop.
+  bool is_monotonic_range_check_if(IfNode *iff, PhaseIdealLoop *phase, Invariance& invar,
+                                   Node* iv, Node** p_offset) const;
 
   // Compute loop exact trip count if possible
   void compute_exact_trip_count( PhaseIdealLoop *phase );
@@ -528,6 +535,9 @@ class PhaseIdealLoop : public PhaseTransform {
   const PhaseIdealLoop* _verify_me;
   bool _verify_only;
 
+  // Set when a loop was strip mined; the loop tree is stale then.
+  bool _loops_strip_mined;
+
   // Allocate _preorders[] array
   void allocate_preorders() {
     _max_preorder = C->unique()+8;
@@ -830,6 +840,12 @@ public:
 
   bool is_counted_loop( Node *x, IdealLoopTree *loop );
 
+  // Split a loop with a safepoint on its backedge into an outer loop
+  // which keeps the safepoint and an inner loop without safepoint which
+  // runs at most LoopStripMiningIter iterations.
+  void strip_mine_loop( IdealLoopTree *loop, Node *x, Node *sfpt, PhiNode *phi, Node *stride,
+                        Node *limit, BoolTest::mask bt, float cl_prob, float cnt );
+
   Node* exact_limit( IdealLoopTree *loop );
 
   // Return a post-walked LoopNode
@@ -887,6 +903,9 @@ public:
   // Unroll the loop body one step - make each trip do 2 iterations.
   void do_unroll( IdealLoopTree *loop, Node_List &old_new, bool adjust_min_trip );
 
+  // Mark vector reduction candidates before loop unrolling
+  void mark_reductions( IdealLoopTree *loop );
+
   // Return true if exp is a constant times an induction var
   bool is_scaled_iv(Node* exp, Node* iv, int* p_scale);
 
@@ -922,6 +941,17 @@ public:
                          Node* init, Node* limit, jint stride,
                          Node* range, bool upper, bool &overflow);
 
+  // Match an exit test "iv < limit" (or "iv <= limit") of a non-counted
+  // loop whose induction variable "iv" never decreases
+  bool is_monotonic_loop_exit(IdealLoopTree* loop, ProjNode* proj, Invariance& invar,
+                              Node** p_iv, Node** p_stride, Node** p_limit, bool* p_inclusive);
+  // Construct the predicates for a range check on such an induction variable
+  ProjNode* monotonic_rc_predicates(ProjNode* predicate_proj, Invariance& invar,
+                                    Node* iv, Node* stride, Node* limit, bool inclusive,
+                                    Node* range, Node* offset);
+  Node* long_value(Node* n, Node* ctrl);
+  void set_long_predicate(ProjNode* proj, Node* ctrl, Node* a, BoolTest::mask test, Node* b);
+
   // Implementation of the loop predication to promote checks outside the loop
   bool loop_predication_impl(IdealLoopTree *loop);
 
@@ -509,6 +509,24 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   // Always convert to CMOVE if all results are used only outside this loop.
   bool used_inside_loop = (r_loop == _ltree_root);
 
+  Node* bol = iff->in(1);
+  assert(bol->Opcode() == Op_Bool, "");
+  int cmp_op = bol->in(1)->Opcode();
+
+  // A diamond selecting int, float or double values in an innermost counted
+  // loop is converted regardless of the branch profile, so that superword
+  // can turn the CMOVs into vector blends.
+  bool vector_cmove = UseVectorCmov && UseSuperWord &&
+                      r_loop->is_inner() && r_loop->is_counted() &&
+                      (cmp_op == Op_CmpI || cmp_op == Op_CmpF || cmp_op == Op_CmpD);
+  for (DUIterator_Fast imax, i = region->fast_outs(imax); vector_cmove && i < imax; i++) {
+    Node *out = region->fast_out(i);
+    if (out->is_Phi()) {
+      BasicType bt = out->as_Phi()->type()->basic_type();
+      vector_cmove = (bt == T_INT || bt == T_FLOAT || bt == T_DOUBLE);
+    }
+  }
+
   // Check profitability
   int cost = 0;
   int phis = 0;
@@ -521,6 +539,10 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
     switch (bt) {
     case T_FLOAT:
     case T_DOUBLE: {
+      if (vector_cmove) {
+        cost++;                 // Blended like any other vector element
+        break;
+      }
       cost += Matcher::float_cmove_cost(); // Could be very expensive
       break;
     }
@@ -581,9 +603,6 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
       }
     }
   }
-  Node* bol = iff->in(1);
-  assert(bol->Opcode() == Op_Bool, "");
-  int cmp_op = bol->in(1)->Opcode();
   // It is expensive to generate flags from a float compare.
   // Avoid duplicated float compare.
   if (phis > 1 && (cmp_op == Op_CmpF || cmp_op == Op_CmpD)) return NULL;
@@ -602,8 +621,9 @@ Node *PhaseIdealLoop::conditional_move( Node *region ) {
   }
   // Check for highly predictable branch.  No point in CMOV'ing if
   // we are going to predict accurately all the time.
-  if (iff->_prob < infrequent_prob ||
-      iff->_prob > (1.0f - infrequent_prob))
+  if (!vector_cmove &&
+      (iff->_prob < infrequent_prob ||
+       iff->_prob > (1.0f - infrequent_prob)))
     return NULL;
 
   // --------------
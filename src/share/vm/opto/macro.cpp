@@ -1084,6 +1084,7 @@ void PhaseMacroExpand::set_eden_pointers(Node* &eden_top_adr, Node* &eden_end_ad
     CollectedHeap* ch = Universe::heap();
     address top_adr = (address)ch->top_addr();
     address end_adr = (address)ch->end_addr();
+    C->env()->record_runtime_constant();
     eden_top_adr = makecon(TypeRawPtr::make(top_adr));
     eden_end_adr = basic_plus_adr(eden_top_adr, end_adr - top_adr);
   }
@@ -1170,7 +1171,10 @@ void PhaseMacroExpand::expand_allocate_common(
             AllocateNode* alloc, // allocation node to be expanded
             Node* length,  // array length for an array allocation
             const TypeFunc* slow_call_type, // Type of slow call
-            address slow_call_address  // Address of slow call
+            address slow_call_address,  // Address of slow call
+            Node* reserved_oop,    // space reserved by an earlier allocation of the group
+            intptr_t reserve_bytes, // space to reserve for the rest of the group
+            Node** next_oop        // where the next allocation of the group starts
     )
 {
 
@@ -1189,6 +1193,10 @@ void PhaseMacroExpand::expand_allocate_common(
   Node *result_phi_rawmem = NULL;
   Node *result_phi_rawoop = NULL;
   Node *result_phi_i_o = NULL;
+  Node *result_phi_next = NULL;
+  if (next_oop != NULL) {
+    *next_oop = NULL;
+  }
 
   // The initial slow comparison is a size check, the comparison
   // we want to do is a BoolTest::gt
@@ -1209,6 +1217,20 @@ void PhaseMacroExpand::expand_allocate_common(
     initial_slow_test = NULL;
   }
 
+  assert(reserved_oop == NULL || (UseTLAB && !always_slow && initial_slow_test == NULL),
+         "merged allocations have a plain TLAB fast path");
+  // If an earlier allocation of the group went the fast path, it already
+  // bumped the TLAB top past this object: take it without a limit check.
+  Node* reserved_true = NULL;
+  if (reserved_oop != NULL) {
+    Node* reserved_cmp = transform_later(new (C) CmpPNode(reserved_oop, makecon(TypeRawPtr::NULL_PTR)));
+    Node* reserved_bol = transform_later(new (C) BoolNode(reserved_cmp, BoolTest::ne));
+    IfNode* reserved_iff = new (C) IfNode(ctrl, reserved_bol, PROB_LIKELY_MAG(4), COUNT_UNKNOWN);
+    transform_later(reserved_iff);
+    reserved_true = transform_later(new (C) IfTrueNode(reserved_iff));
+    ctrl = transform_later(new (C) IfFalseNode(reserved_iff));
+  }
+
 
   enum { too_big_or_final_path = 1, need_gc_path = 2 };
   Node *slow_region = NULL;
@@ -1294,6 +1316,10 @@ void PhaseMacroExpand::expand_allocate_common(
     // Add to heap top to get a new heap top
     Node *new_eden_top = new (C) AddPNode(top(), old_eden_top, size_in_bytes);
     transform_later(new_eden_top);
+    if (reserve_bytes > 0) {
+      // Check for and bump past the rest of the group as well
+      new_eden_top = basic_plus_adr(top(), new_eden_top, MakeConX(reserve_bytes));
+    }
     // Check for needing a GC; compare against heap end
     Node *needgc_cmp = new (C) CmpPNode(new_eden_top, eden_end);
     transform_later(needgc_cmp);
@@ -1382,6 +1408,26 @@ void PhaseMacroExpand::expand_allocate_common(
                                    0, new_alloc_bytes, T_LONG);
     }
 
+    if (reserved_true != NULL) {
+      // Join the path that found the object already reserved
+      RegionNode* reserved_region = new (C) RegionNode(3);
+      PhiNode* reserved_phi_rawoop = new (C) PhiNode(reserved_region, TypeRawPtr::BOTTOM);
+      PhiNode* reserved_phi_rawmem = new (C) PhiNode(reserved_region, Type::MEMORY, TypeRawPtr::BOTTOM);
+      PhiNode* reserved_phi_i_o    = new (C) PhiNode(reserved_region, Type::ABIO);
+      reserved_region    ->init_req(1, fast_oop_ctrl);
+      reserved_region    ->init_req(2, reserved_true);
+      reserved_phi_rawoop->init_req(1, fast_oop);
+      reserved_phi_rawoop->init_req(2, reserved_oop);
+      reserved_phi_rawmem->init_req(1, fast_oop_rawmem);
+      reserved_phi_rawmem->init_req(2, mem);
+      reserved_phi_i_o   ->init_req(1, i_o);
+      reserved_phi_i_o   ->init_req(2, alloc->in(TypeFunc::I_O));
+      fast_oop_ctrl   = transform_later(reserved_region);
+      fast_oop        = transform_later(reserved_phi_rawoop);
+      fast_oop_rawmem = transform_later(reserved_phi_rawmem);
+      i_o             = transform_later(reserved_phi_i_o);
+    }
+
     InitializeNode* init = alloc->initialization();
     fast_oop_rawmem = initialize_object(alloc,
                                         fast_oop_ctrl, fast_oop_rawmem, fast_oop,
@@ -1448,7 +1494,7 @@ void PhaseMacroExpand::expand_allocate_common(
     }
 
 #if INCLUDE_JFR
-    if (JfrOptionSet::sample_object_allocations()) {
+    if (JfrOptionSet::sample_object_allocations() && ObjectProfilerSampleBytes == 0) {
       jfr_sample_fast_object_allocation(alloc, fast_oop, fast_oop_ctrl, fast_oop_rawmem);
     }
 #endif // INCLUDE_JFR
@@ -1479,6 +1525,11 @@ void PhaseMacroExpand::expand_allocate_common(
       transform_later(fast_oop_rawmem);
     }
 
+    if (next_oop != NULL) {
+      result_phi_next = new (C) PhiNode(result_region, TypeRawPtr::BOTTOM);
+      result_phi_next->init_req(fast_result_path, basic_plus_adr(top(), fast_oop, size_in_bytes));
+    }
+
     // Plug in the successful fast-path into the result merge point
     result_region    ->init_req(fast_result_path, fast_oop_ctrl);
     result_phi_rawoop->init_req(fast_result_path, fast_oop);
@@ -1636,6 +1687,13 @@ void PhaseMacroExpand::expand_allocate_common(
   transform_later(result_phi_rawmem);
   transform_later(result_phi_i_o);
   // This completes all paths into the result merge point
+
+  if (result_phi_next != NULL) {
+    // After the slow path the rest of the group allocates on its own
+    result_phi_next->init_req(slow_result_path, makecon(TypeRawPtr::NULL_PTR));
+    transform_later(result_phi_next);
+    *next_oop = result_phi_next;
+  }
 }
 
 #if INCLUDE_JFR
@@ -1669,6 +1727,7 @@ void PhaseMacroExpand::jfr_sample_fast_object_allocation(
     Node*& fast_oop_ctrl, Node*& fast_oop_rawmem) {
   Node* tls = transform_later(new (C) ThreadLocalNode());
 
+  C->env()->record_runtime_constant();
   Node* alloc_sample_enabled_addr = transform_later(ConPNode::make(C, (address) ObjectProfiler::enabled_flag_address()));
   Node* alloc_sample_enabled = make_load_acquire(fast_oop_ctrl, fast_oop_rawmem, alloc_sample_enabled_addr, 0, TypeInt::INT, T_INT);
   Node* alloc_sample_enabled_cmp = transform_later(new (C) CmpINode(alloc_sample_enabled, intcon(1)));
@@ -1971,7 +2030,117 @@ Node* PhaseMacroExpand::prefetch_allocation(Node* i_o, Node*& needgc_false,
 }
 
 
+//---------------------------can_merge_allocation------------------------------
+// Fixed-size instance allocations that always try the TLAB first can share
+// a single TLAB bump and limit check.
+bool PhaseMacroExpand::can_merge_allocation(AllocateNode* alloc) {
+  if (!UseTLAB || alloc->is_AllocateArray() ||
+      C->env()->dtrace_alloc_probes() || C->env()->dtrace_extended_probes()) {
+    return false;
+  }
+#if INCLUDE_JFR
+  if (JfrOptionSet::sample_object_allocations() && ObjectProfilerSampleBytes == 0) {
+    return false;
+  }
+#endif // INCLUDE_JFR
+  if (_igvn.type(alloc) == Type::TOP || alloc->in(0)->is_top()) {
+    return false;
+  }
+  return _igvn.find_int_con(alloc->in(AllocateNode::InitialTest), -1) == 0 &&
+         _igvn.find_intptr_t_con(alloc->in(AllocateNode::AllocSize), -1) > 0;
+}
+
+//--------------------------prev_merged_allocation-----------------------------
+// The allocation whose initialization 'alloc' directly follows, with no
+// control (and so no safepoint) in between, or NULL.  Nothing may observe
+// the TLAB between the bump and the initialization of the later objects.
+AllocateNode* PhaseMacroExpand::prev_merged_allocation(AllocateNode* alloc) {
+  if (!can_merge_allocation(alloc)) {
+    return NULL;
+  }
+  Node* ctrl = alloc->in(TypeFunc::Control);
+  if (!ctrl->is_Proj() || ctrl->as_Proj()->_con != TypeFunc::Control ||
+      !ctrl->in(0)->is_Initialize()) {
+    return NULL;
+  }
+  InitializeNode* init = ctrl->in(0)->as_Initialize();
+  AllocateNode* prev = init->allocation();
+  if (prev == NULL || prev == alloc || !can_merge_allocation(prev)) {
+    return NULL;
+  }
+  // The initialization must sit right on the fall-through of 'prev'
+  Node* c = init->in(TypeFunc::Control);
+  if (!c->is_CatchProj() || c->as_CatchProj()->_con != CatchProjNode::fall_through_index ||
+      !c->in(0)->is_Catch() || !c->in(0)->in(0)->is_Proj() ||
+      c->in(0)->in(0)->in(0) != prev) {
+    return NULL;
+  }
+  return prev;
+}
+
+//--------------------------next_merged_allocation-----------------------------
+AllocateNode* PhaseMacroExpand::next_merged_allocation(AllocateNode* alloc) {
+  InitializeNode* init = alloc->initialization();
+  if (init == NULL) {
+    return NULL;
+  }
+  Node* ctrl = init->proj_out(TypeFunc::Control);
+  if (ctrl == NULL) {
+    return NULL;
+  }
+  for (DUIterator_Fast imax, i = ctrl->fast_outs(imax); i < imax; i++) {
+    Node* u = ctrl->fast_out(i);
+    if (u->is_Allocate() && prev_merged_allocation(u->as_Allocate()) == alloc) {
+      return u->as_Allocate();
+    }
+  }
+  return NULL;
+}
+
+//--------------------------expand_allocate_group------------------------------
+// Expand the chain of directly following allocations 'alloc' belongs to.
+// The first one checks for and bumps the TLAB top past the whole chain;
+// every later one finds its object already carved out, unless an earlier
+// one had to take the slow path, in which case it allocates (and reserves
+// for the rest of the chain) on its own.  A single prefetch covers the
+// chain.
+void PhaseMacroExpand::expand_allocate_group(AllocateNode* alloc) {
+  int limit = MAX2((int)MergeTLABAllocationsLimit, 1);
+  AllocateNode* head = alloc;
+  for (int i = 1; i < limit; i++) {
+    AllocateNode* prev = prev_merged_allocation(head);
+    if (prev == NULL) {
+      break;
+    }
+    head = prev;
+  }
+  Node_List group;
+  intptr_t group_bytes = 0;
+  for (AllocateNode* a = head; a != NULL && (int)group.size() < limit; a = next_merged_allocation(a)) {
+    group.push(a);
+    group_bytes += _igvn.find_intptr_t_con(a->in(AllocateNode::AllocSize), 0);
+  }
+  assert(group.size() > 0, "allocation is part of its group");
+
+  Node* reserved_oop = NULL;
+  for (uint i = 0; i < group.size(); i++) {
+    AllocateNode* a = group.at(i)->as_Allocate();
+    group_bytes -= _igvn.find_intptr_t_con(a->in(AllocateNode::AllocSize), 0);
+    Node* next_oop = NULL;
+    expand_allocate_common(a, NULL,
+                           OptoRuntime::new_instance_Type(),
+                           OptoRuntime::new_instance_Java(),
+                           reserved_oop, group_bytes,
+                           (group_bytes > 0) ? &next_oop : NULL);
+    reserved_oop = next_oop;
+  }
+}
+
 void PhaseMacroExpand::expand_allocate(AllocateNode *alloc) {
+  if (MergeTLABAllocations && can_merge_allocation(alloc)) {
+    expand_allocate_group(alloc);
+    return;
+  }
   expand_allocate_common(alloc, NULL,
                          OptoRuntime::new_instance_Type(),
                          OptoRuntime::new_instance_Java());
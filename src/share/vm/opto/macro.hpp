@@ -88,7 +88,14 @@ private:
   void expand_allocate_common(AllocateNode* alloc,
                               Node* length,
                               const TypeFunc* slow_call_type,
-                              address slow_call_address);
+                              address slow_call_address,
+                              Node* reserved_oop = NULL,
+                              intptr_t reserve_bytes = 0,
+                              Node** next_oop = NULL);
+  bool can_merge_allocation(AllocateNode* alloc);
+  AllocateNode* prev_merged_allocation(AllocateNode* alloc);
+  AllocateNode* next_merged_allocation(AllocateNode* alloc);
+  void expand_allocate_group(AllocateNode* alloc);
   Node *value_from_mem(Node *mem, BasicType ft, const Type *ftype, const TypeOopPtr *adr_t, Node *alloc);
   Node *value_from_mem_phi(Node *mem, BasicType ft, const Type *ftype, const TypeOopPtr *adr_t, Node *alloc, Node_Stack *value_phis, int level);
 
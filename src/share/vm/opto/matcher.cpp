@@ -2294,6 +2294,16 @@ void Matcher::find_shared( Node *n ) {
         n->del_req(3);
         break;
       }
+      case Op_VectorMaskCmp:
+      case Op_VectorBlend: {
+        // Restructure into a binary tree: the compared or blended vectors
+        // are paired and the condition or mask stays a direct input.
+        Node *pair1 = new (C) BinaryNode(n->in(1),n->in(2));
+        n->set_req(1,pair1);
+        n->set_req(2,n->in(3));
+        n->del_req(3);
+        break;
+      }
       case Op_LoopLimit: {
         Node *pair1 = new (C) BinaryNode(n->in(1),n->in(2));
         n->set_req(1,pair1);
@@ -1324,16 +1324,32 @@ static bool stable_phi(PhiNode* phi, PhaseGVN *phase) {
   }
   return true;
 }
+// Check if the Phi merges only newly allocated objects. Splitting field
+// loads through such a Phi may leave the allocations unmerged so that
+// escape analysis can scalar replace them.
+static bool is_allocation_merge(Node* phi, PhaseGVN* phase) {
+  if (!ReduceAllocationMerges || !EliminateAllocations ||
+      !phase->C->do_escape_analysis() || phi->in(0) == NULL || phi->in(0)->is_Loop()) {
+    return false;
+  }
+  for (uint i = 1; i < phi->req(); i++) {
+    Node* in = phi->in(i);
+    if (in == NULL || AllocateNode::Ideal_allocation(in, phase) == NULL) {
+      return false;
+    }
+  }
+  return true;
+}
+
 //------------------------------split_through_phi------------------------------
 // Split instance or boxed field load through Phi.
+// Also split field loads through Phis of allocations (ReduceAllocationMerges).
 Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   Node* mem     = in(Memory);
   Node* address = in(Address);
   const TypeOopPtr *t_oop = phase->type(address)->isa_oopptr();
 
-  assert((t_oop != NULL) &&
-         (t_oop->is_known_instance_field() ||
-          t_oop->is_ptr_to_boxed_value()), "invalide conditions");
+  assert(t_oop != NULL, "invalide conditions");
 
   Compile* C = phase->C;
   intptr_t ignore = 0;
@@ -1342,9 +1358,12 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   bool load_boxed_values = t_oop->is_ptr_to_boxed_value() && C->aggressive_unboxing() &&
                            (base != NULL) && (base == address->in(AddPNode::Base)) &&
                            phase->type(base)->higher_equal(TypePtr::NOTNULL);
+  bool load_alloc_merge = base_is_phi && !t_oop->is_known_instance_field() &&
+                          (base == address->in(AddPNode::Base)) &&
+                          is_allocation_merge(base, phase);
 
   if (!((mem->is_Phi() || base_is_phi) &&
-        (load_boxed_values || t_oop->is_known_instance_field()))) {
+        (load_boxed_values || load_alloc_merge || t_oop->is_known_instance_field()))) {
     return NULL; // memory is not Phi
   }
 
@@ -1430,8 +1449,8 @@ Node *LoadNode::split_through_phi(PhaseGVN *phase) {
   int this_index  = C->get_alias_index(t_oop);
   int this_offset = t_oop->offset();
   int this_iid    = t_oop->instance_id();
-  if (!t_oop->is_known_instance() && load_boxed_values) {
-    // Use _idx of address base for boxed values.
+  if (!t_oop->is_known_instance() && (load_boxed_values || load_alloc_merge)) {
+    // Use _idx of address base for boxed values and merged allocations.
     this_iid = base->_idx;
   }
   PhaseIterGVN* igvn = phase->is_IterGVN();
@@ -1562,7 +1581,9 @@ Node *LoadNode::Ideal(PhaseGVN *phase, bool can_reshape) {
     const TypeOopPtr *t_oop = addr_t->isa_oopptr();
     if ((t_oop != NULL) &&
         (t_oop->is_known_instance_field() ||
-         t_oop->is_ptr_to_boxed_value())) {
+         t_oop->is_ptr_to_boxed_value() ||
+         (address->is_AddP() && address->in(AddPNode::Base)->is_Phi() &&
+          is_allocation_merge(address->in(AddPNode::Base), phase)))) {
       PhaseIterGVN *igvn = phase->is_IterGVN();
       if (igvn != NULL && igvn->_worklist.member(opt_mem)) {
         // Delay this transformation until memory Phi is processed.
@@ -703,7 +703,8 @@ public:
     Flag_avoid_back_to_back_after    = Flag_avoid_back_to_back_before << 1,
     Flag_has_call                    = Flag_avoid_back_to_back_after << 1,
     Flag_is_expensive                = Flag_has_call << 1,
-    _max_flags = (Flag_is_expensive << 1) - 1 // allow flags combination
+    Flag_is_reduction                = Flag_is_expensive << 1,
+    _max_flags = (Flag_is_reduction << 1) - 1 // allow flags combination
   };
 
 private:
@@ -728,6 +729,8 @@ protected:
 public:
   const jushort class_id() const { return _class_id; }
 
+  void add_flag(jushort fl) { init_flags(fl); }
+
   const jushort flags() const { return _flags; }
 
   // Return a dense integer opcode number
@@ -881,6 +884,10 @@ public:
   // The node is expensive: the best control is set during loop opts
   bool is_expensive() const { return (_flags & Flag_is_expensive) != 0 && in(0) != NULL; }
 
+  // An arithmetic node which accumulates a data value in a loop.
+  // It must have the loop's phi as input and provide a def to the phi.
+  bool is_reduction() const { return (_flags & Flag_is_reduction) != 0; }
+
 //----------------- Optimization
 
   // Get the worst-case Type output for this Node.
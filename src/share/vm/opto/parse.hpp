@@ -54,6 +54,7 @@ class InlineTree : public ResourceObj {
   const float _site_invoke_ratio;
   const int   _max_inline_level;  // the maximum inline level for this sub-tree (may be adjusted)
   float compute_callee_frequency( int caller_bci ) const;
+  bool  is_very_hot_site(ciMethod* callee_method, int caller_bci) const;
 
   GrowableArray<InlineTree*> _subtrees;
 
@@ -144,6 +145,8 @@ public:
 
   bool        _forced_inline;     // Inlining was forced by CompilerOracle, ciReplay or annotation
   bool        forced_inline()     const { return _forced_inline; }
+  bool        _hot_inline;        // Inlining exceeds the regular limits because the site is very hot
+  bool        hot_inline()        const { return _hot_inline; }
   // Count number of nodes in this subtree
   int         count() const;
   // Dump inlining replay data to the stream.
@@ -2221,8 +2221,18 @@ void Parse::add_safepoint() {
 
   // Create a node for the polling address
   if( add_poll_param ) {
-    Node *polladr = ConPNode::make(C, (address)os::get_polling_page());
-    sfpnt->init_req(TypeFunc::Parms+0, _gvn.transform(polladr));
+    Node *polladr;
+    if (ThreadLocalSafepointPolls) {
+      // Pinned, the poll word changes without any store in this method.
+      Node *thread = _gvn.transform(new (C) ThreadLocalNode());
+      Node *poll_word_adr = basic_plus_adr(top(), thread, in_bytes(JavaThread::poll_word_offset()));
+      polladr = make_load(control(), poll_word_adr, TypeRawPtr::BOTTOM, T_ADDRESS,
+                          Compile::AliasIdxRaw, MemNode::unordered, LoadNode::Pinned);
+    } else {
+      C->env()->record_runtime_constant();
+      polladr = _gvn.transform(ConPNode::make(C, (address)os::get_polling_page()));
+    }
+    sfpnt->init_req(TypeFunc::Parms+0, polladr);
   }
 
   // Fix up the JVM State edges
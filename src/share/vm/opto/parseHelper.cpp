@@ -384,6 +384,7 @@ void Parse::increment_and_test_invocation_counter(int limit) {
   }
 
   Node* ctrl = control();
+  C->env()->record_runtime_constant();
   const TypePtr* adr_type = TypeRawPtr::make((address) counters_adr);
   Node *counters_node = makecon(adr_type);
   Node* adr_iic_node = basic_plus_adr(counters_node, counters_node,
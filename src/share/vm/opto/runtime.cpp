@@ -926,6 +926,90 @@ const TypeFunc* OptoRuntime::updateBytesCRC32_Type() {
   return TypeFunc::make(domain, range);
 }
 
+/**
+ * int arrayHashCode(int h, T* a, int len)
+ */
+const TypeFunc* OptoRuntime::arrayHashCode_Type() {
+  // create input type (domain)
+  int num_args = 3;
+  int argcnt = num_args;
+  if (CCallingConventionRequiresIntsAsLongs) {
+    argcnt += 2;
+  }
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  if (CCallingConventionRequiresIntsAsLongs) {
+    fields[argp++] = TypeLong::LONG;   // h
+    fields[argp++] = Type::HALF;
+    fields[argp++] = TypePtr::NOTNULL; // a
+    fields[argp++] = TypeLong::LONG;   // len
+    fields[argp++] = Type::HALF;
+  } else {
+    fields[argp++] = TypeInt::INT;     // h
+    fields[argp++] = TypePtr::NOTNULL; // a
+    fields[argp++] = TypeInt::INT;     // len
+  }
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = TypeInt::INT; // hash result
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+1, fields);
+  return TypeFunc::make(domain, range);
+}
+
+/**
+ * long unsafeVectorizedMismatch(address a, address b, size_t length)
+ */
+const TypeFunc* OptoRuntime::unsafeVectorizedMismatch_Type() {
+  // create input type (domain)
+  int num_args = 3;
+  int argcnt = num_args;
+  LP64_ONLY(argcnt += 1); // halfword for length
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // a
+  fields[argp++] = TypePtr::NOTNULL;    // b
+  fields[argp++] = TypeX_X;             // length in bytes
+  LP64_ONLY(fields[argp++] = Type::HALF);
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(2);
+  fields[TypeFunc::Parms+0] = TypeLong::LONG; // index of the first mismatch or -1
+  fields[TypeFunc::Parms+1] = Type::HALF;
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+2, fields);
+  return TypeFunc::make(domain, range);
+}
+
+/**
+ * int unsafeHash(address p, size_t length, long seed)
+ */
+const TypeFunc* OptoRuntime::unsafeHash_Type() {
+  // create input type (domain)
+  int num_args = 3;
+  int argcnt = num_args;
+  LP64_ONLY(argcnt += 1); // halfword for length
+  argcnt += 1;            // halfword for seed
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // p
+  fields[argp++] = TypeX_X;             // length in bytes
+  LP64_ONLY(fields[argp++] = Type::HALF);
+  fields[argp++] = TypeLong::LONG;      // seed, only the low 32 bits are used
+  fields[argp++] = Type::HALF;
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = TypeInt::INT; // hash result
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+1, fields);
+  return TypeFunc::make(domain, range);
+}
+
 // for cipherBlockChaining calls of aescrypt encrypt/decrypt, four pointers and a length, returning int
 const TypeFunc* OptoRuntime::cipherBlockChaining_aescrypt_Type() {
   // create input type (domain)
@@ -1137,6 +1221,27 @@ const TypeFunc* OptoRuntime::montgomerySquare_Type() {
   return TypeFunc::make(domain, range);
 }
 
+// for StubRoutines::utf8Decode, utf8Encode and latin1Decode
+const TypeFunc* OptoRuntime::charsetArrayCoder_Type() {
+  // create input type (domain)
+  int num_args      = 4;
+  int argcnt = num_args;
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // src
+  fields[argp++] = TypeInt::INT;        // len
+  fields[argp++] = TypePtr::NOTNULL;    // dst
+  fields[argp++] = TypeInt::INT;        // dst_len
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // returning the number of chars or bytes written, or -1
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = TypeInt::INT;
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+1, fields);
+  return TypeFunc::make(domain, range);
+}
+
 
 //------------- Interpreter state access for on stack replacement
 const TypeFunc* OptoRuntime::osr_end_Type() {
@@ -319,7 +319,12 @@ private:
 
   static const TypeFunc* ghash_processBlocks_Type();
 
+  static const TypeFunc* charsetArrayCoder_Type();
+
   static const TypeFunc* updateBytesCRC32_Type();
+  static const TypeFunc* arrayHashCode_Type();
+  static const TypeFunc* unsafeVectorizedMismatch_Type();
+  static const TypeFunc* unsafeHash_Type();
 
   // leaf on stack replacement interpreter accessor types
   static const TypeFunc* osr_end_Type();
@@ -27,6 +27,7 @@
 #include "memory/allocation.inline.hpp"
 #include "opto/addnode.hpp"
 #include "opto/callnode.hpp"
+#include "opto/connode.hpp"
 #include "opto/divnode.hpp"
 #include "opto/matcher.hpp"
 #include "opto/memnode.hpp"
@@ -680,7 +681,7 @@ bool SuperWord::stmts_can_pack(Node* s1, Node* s2, int align) {
   }
 
   if (isomorphic(s1, s2)) {
-    if (independent(s1, s2)) {
+    if (independent(s1, s2) || reduction(s1, s2)) {
       if (!exists_at(s1, 0) && !exists_at(s2, 1)) {
         if (!s1->is_Mem() || are_adjacent_refs(s1, s2)) {
           int s1_align = alignment(s1);
@@ -779,6 +780,24 @@ bool SuperWord::independent_path(Node* shallow, Node* deep, uint dp) {
   return true;
 }
 
+//------------------------------reduction---------------------------
+// Is there a data path between s1 and s2 and the nodes reductions?
+bool SuperWord::reduction(Node* s1, Node* s2) {
+  if (!s1->is_reduction() || !s2->is_reduction()) {
+    return false;
+  }
+  if (depth(s1) + 1 != depth(s2)) {
+    return false;
+  }
+  // This is an ordered set, so s1 should define s2
+  for (DUIterator_Fast imax, i = s1->fast_outs(imax); i < imax; i++) {
+    if (s1->fast_out(i) == s2) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //------------------------------set_alignment---------------------------
 void SuperWord::set_alignment(Node* s1, Node* s2, int align) {
   set_alignment(s1, align);
@@ -899,6 +918,20 @@ bool SuperWord::follow_def_uses(Node_List* p) {
 //---------------------------opnd_positions_match-------------------------
 // Is the use of d1 in u1 at the same operand position as d2 in u2?
 bool SuperWord::opnd_positions_match(Node* d1, Node* u1, Node* d2, Node* u2) {
+  // Reductions keep the accumulated value, the loop phi or the previous
+  // reduction, in their first operand and the vectorized value in the second.
+  if (u1->is_reduction() && u2->is_reduction()) {
+    Node* first = u1->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u1->swap_edges(1, 2);
+    }
+    first = u2->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u2->swap_edges(1, 2);
+    }
+    return u1->in(2) == d1 && u2->in(2) == d2;
+  }
+
   uint ct = u1->req();
   if (ct != u2->req()) return false;
   uint i1 = 0;
@@ -1108,6 +1141,25 @@ void SuperWord::filter_packs() {
 // Can code be generated for pack p?
 bool SuperWord::implemented(Node_List* p) {
   Node* p0 = p->at(0);
+  if (p0->is_reduction()) {
+    BasicType bt = p0->bottom_type()->basic_type();
+    if (velt_basic_type(p0) != bt) {
+      return false;
+    }
+    // Length 2 reductions of INT/LONG do not offer performance benefits
+    if ((bt == T_INT || bt == T_LONG) && p->size() == 2) {
+      return false;
+    }
+    return ReductionNode::implemented(p0->Opcode(), p->size(), bt);
+  }
+  if (VectorNode::is_cmove(p0)) {
+    // The condition is computed by a vector compare feeding a blend
+    Node* cmp = cmove_compare(p0);
+    if (!UseVectorCmov || cmp == NULL ||
+        !VectorMaskCmpNode::implemented(cmp->Opcode(), p->size())) {
+      return false;
+    }
+  }
   return VectorNode::implemented(p0->Opcode(), p->size(), velt_basic_type(p0));
 }
 
@@ -1142,6 +1194,25 @@ bool SuperWord::profitable(Node_List* p) {
     if (!is_vector_use(p0, i))
       return false;
   }
+  if (VectorNode::is_cmove(p0) && !is_vector_cmove_condition(p)) {
+    return false;
+  }
+  if (p0->is_reduction()) {
+    // The members must accumulate into each other in pack order, and the
+    // vectorized operand must come from a pack of the same size.
+    for (uint i = 1; i < p->size(); i++) {
+      if (p->at(i)->in(1) != p->at(i - 1)) {
+        return false;
+      }
+    }
+    Node_List* second_pk = my_pack(p0->in(2));
+    if (second_pk == NULL || second_pk->size() != p->size()) {
+      return false;
+    }
+    // The scalar result replaces the last member, so its uses need not
+    // be vector uses.
+    return true;
+  }
   if (VectorNode::is_shift(p0)) {
     // For now, return false if shift count is vector or not scalar promotion
     // case (different shift counts) because it is not supported yet.
@@ -1445,6 +1516,50 @@ void SuperWord::output() {
         const TypePtr* atyp = n->adr_type();
         vn = StoreVectorNode::make(C, opc, ctl, mem, adr, atyp, val, vlen);
         vlen_in_bytes = vn->as_StoreVector()->memory_size();
+      } else if (n->is_reduction()) {
+        // The accumulated value of the first reduction is retained and
+        // the vectorized operand is reduced into it.
+        Node* in1 = low_adr->in(1);
+        Node* in2 = vector_opd(p, 2);
+        vn = ReductionNode::make(C, opc, NULL, in1, in2, n->bottom_type()->basic_type());
+        if (in2->is_LoadVector()) {
+          vlen_in_bytes = in2->as_LoadVector()->memory_size();
+        } else {
+          vlen_in_bytes = in2->as_Vector()->length_in_bytes();
+        }
+      } else if (VectorNode::is_cmove(n)) {
+        // Compare the operands of the conditions into a lane mask and blend
+        // the cmove inputs with it. Conditions other than eq, lt and gt are
+        // negated, which swaps the blended inputs.
+        BoolTest::mask test = n->in(CMoveNode::Condition)->as_Bool()->_test._test;
+        Node_List cmp_pk;
+        for (uint j = 0; j < vlen; j++) {
+          cmp_pk.push(cmove_compare(p->at(j)));
+        }
+        Node* cmp_in1 = vector_opd(&cmp_pk, 1);
+        Node* cmp_in2 = vector_opd(&cmp_pk, 2);
+        Node* src1 = vector_opd(p, CMoveNode::IfFalse);
+        Node* src2 = vector_opd(p, CMoveNode::IfTrue);
+        if (test == BoolTest::ne || test == BoolTest::le || test == BoolTest::ge) {
+          test = BoolTest(test).negate();
+          Node* tmp = src1;
+          src1 = src2;
+          src2 = tmp;
+        }
+        BasicType cmp_bt = VectorMaskCmpNode::compare_type(cmp_pk.at(0)->Opcode());
+        Node* mask = VectorMaskCmpNode::make(C, cmp_in1, cmp_in2, _igvn.intcon(test), vlen, cmp_bt);
+        _igvn.register_new_node_with_optimizer(mask);
+        _phase->set_ctrl(mask, _phase->get_ctrl(p->at(0)));
+        // The scalar conditions now consume vectors, remove them before
+        // IGVN gets a chance to look at them.
+        for (uint j = 0; j < vlen; j++) {
+          Node* pm = p->at(j);
+          Node* bol = pm->in(CMoveNode::Condition);
+          _igvn.replace_input_of(pm, CMoveNode::Condition, C->top());
+          _igvn.remove_dead_node(bol);
+        }
+        vn = new (C) VectorBlendNode(src1, src2, mask);
+        vlen_in_bytes = vn->as_Vector()->length_in_bytes();
       } else if (n->req() == 3) {
         // Promote operands to vector
         Node* in1 = vector_opd(p, 1);
@@ -1527,8 +1642,11 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
     assert(!opd->is_StoreVector(), "such vector is not expected here");
     // Convert scalar input to vector with the same number of elements as
     // p0's vector. Use p0's type because size of operand's container in
-    // vector should match p0's size regardless operand's size.
-    const Type* p0_t = velt_type(p0);
+    // vector should match p0's size regardless operand's size. Compares
+    // of a cmove condition produce flags, use the compared type instead.
+    const Type* p0_t = p0->is_Cmp() ?
+      Type::get_const_basic_type(VectorMaskCmpNode::compare_type(p0->Opcode())) :
+      velt_type(p0);
     VectorNode* vn = VectorNode::scalar2vector(_phase->C, opd, vlen, p0_t);
 
     _igvn.register_new_node_with_optimizer(vn);
@@ -1570,6 +1688,8 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
 // use with an extract operation.
 void SuperWord::insert_extracts(Node_List* p) {
   if (p->at(0)->is_Store()) return;
+  // A reduction produces a scalar, which directly replaces its uses.
+  if (p->at(0)->is_reduction()) return;
   assert(_n_idx_list.is_empty(), "empty (node,index) list");
 
   // Inspect each use of each pack member.  For each use that is
@@ -1614,8 +1734,23 @@ void SuperWord::insert_extracts(Node_List* p) {
 //------------------------------is_vector_use---------------------------
 // Is use->in(u_idx) a vector use?
 bool SuperWord::is_vector_use(Node* use, int u_idx) {
+  if (use->is_Cmp() && use->outcnt() == 1) {
+    // A compare private to the condition of a packed cmove is vectorized
+    // along with the cmove.
+    Node* bol = use->raw_out(0);
+    if (bol->is_Bool() && bol->outcnt() == 1) {
+      Node* cmove = bol->raw_out(0);
+      Node_List* c_pk = my_pack(cmove);
+      if (c_pk != NULL && VectorNode::is_cmove(cmove) &&
+          cmove_compare(cmove) == use) {
+        return is_vector_cmove_condition(c_pk);
+      }
+    }
+  }
   Node_List* u_pk = my_pack(use);
   if (u_pk == NULL) return false;
+  // The accumulated operand of a reduction stays scalar.
+  if (use->is_reduction() && u_idx == 1) return true;
   Node* def = use->in(u_idx);
   Node_List* d_pk = my_pack(def);
   if (d_pk == NULL) {
@@ -1637,6 +1772,71 @@ bool SuperWord::is_vector_use(Node* use, int u_idx) {
   return true;
 }
 
+//------------------------------cmove_compare---------------------------
+// Return the compare controlling cmove n if it is private to n and in the
+// block, else NULL.
+Node* SuperWord::cmove_compare(Node* n) {
+  Node* bol = n->in(CMoveNode::Condition);
+  if (!bol->is_Bool() || bol->outcnt() != 1 || !in_bb(bol)) {
+    return NULL;
+  }
+  Node* cmp = bol->in(1);
+  if (!cmp->is_Cmp() || cmp->outcnt() != 1 || !in_bb(cmp)) {
+    return NULL;
+  }
+  return cmp;
+}
+
+//------------------------------is_vector_cmove_condition---------------------------
+// Can the conditions of cmove pack p be computed by one vector compare?
+// The compares must match and each of their operands must either be the
+// same scalar in all lanes or come from a pack aligned with p.
+bool SuperWord::is_vector_cmove_condition(Node_List* p) {
+  Node* p0 = p->at(0);
+  Node* cmp0 = cmove_compare(p0);
+  if (cmp0 == NULL) {
+    return false;
+  }
+  BasicType bt = VectorMaskCmpNode::compare_type(cmp0->Opcode());
+  if (bt == T_ILLEGAL || type2aelembytes(bt) != data_size(p0)) {
+    return false;
+  }
+  BoolTest::mask test = p0->in(CMoveNode::Condition)->as_Bool()->_test._test;
+  switch (test) {
+  case BoolTest::eq: case BoolTest::ne:
+  case BoolTest::lt: case BoolTest::le:
+  case BoolTest::gt: case BoolTest::ge:
+    break;
+  default:
+    return false; // overflow checks
+  }
+  for (uint i = 1; i < p->size(); i++) {
+    Node* cmp = cmove_compare(p->at(i));
+    if (cmp == NULL || cmp->Opcode() != cmp0->Opcode() ||
+        p->at(i)->in(CMoveNode::Condition)->as_Bool()->_test._test != test) {
+      return false;
+    }
+  }
+  for (uint k = 1; k <= 2; k++) {
+    Node* opd0 = cmp0->in(k);
+    Node_List* d_pk = my_pack(opd0);
+    if (d_pk != NULL && d_pk->size() != p->size()) {
+      return false;
+    }
+    for (uint i = 0; i < p->size(); i++) {
+      Node* pi = p->at(i);
+      Node* opd = cmove_compare(pi)->in(k);
+      if (d_pk == NULL) {
+        if (opd != opd0) return false; // only scalar promotion
+      } else if (d_pk->at(i) != opd || alignment(opd) != alignment(pi) ||
+                 velt_basic_type(opd) != bt) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 //------------------------------construct_bb---------------------------
 // Construct reverse postorder list of block members
 bool SuperWord::construct_bb() {
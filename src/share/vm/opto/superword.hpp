@@ -365,6 +365,8 @@ class SuperWord : public ResourceObj {
   bool independent(Node* s1, Node* s2);
   // Helper for independent
   bool independent_path(Node* shallow, Node* deep, uint dp=0);
+  // Are s1 and s2 consecutive reduction operations, s1 defining s2?
+  bool reduction(Node* s1, Node* s2);
   void set_alignment(Node* s1, Node* s2, int align);
   int data_size(Node* s);
   // Extend packset by following use->def and def->use links from pack members.
@@ -404,6 +406,10 @@ class SuperWord : public ResourceObj {
   void insert_extracts(Node_List* p);
   // Is use->in(u_idx) a vector use?
   bool is_vector_use(Node* use, int u_idx);
+  // The compare controlling cmove n, if it can be vectorized with n
+  Node* cmove_compare(Node* n);
+  // Can the conditions of cmove pack p be computed by a vector compare?
+  bool is_vector_cmove_condition(Node_List* p);
   // Construct reverse postorder list of block members
   bool construct_bb();
   // Initialize per node info
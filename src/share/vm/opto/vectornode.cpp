@@ -139,6 +139,11 @@ int VectorNode::opcode(int sopc, BasicType bt) {
   case Op_XorL:
     return Op_XorV;
 
+  case Op_CMoveI:
+  case Op_CMoveF:
+  case Op_CMoveD:
+    return Op_VectorBlend;
+
   case Op_LoadB:
   case Op_LoadUB:
   case Op_LoadUS:
@@ -185,6 +190,17 @@ bool VectorNode::is_shift(Node* n) {
   return false;
 }
 
+// Conditional moves which can be vectorized as a blend of their inputs.
+bool VectorNode::is_cmove(Node* n) {
+  switch (n->Opcode()) {
+  case Op_CMoveI:
+  case Op_CMoveF:
+  case Op_CMoveD:
+    return true;
+  }
+  return false;
+}
+
 // Check if input is loop invariant vector.
 bool VectorNode::is_invariant_vector(Node* n) {
   // Only Replicate vector nodes are loop invariant for now.
@@ -341,6 +357,31 @@ VectorNode* VectorNode::shift_count(Compile* C, Node* shift, Node* cnt, uint vle
   return NULL;
 }
 
+// Return the vector compare of in1 and in2 under condition cond.
+VectorMaskCmpNode* VectorMaskCmpNode::make(Compile* C, Node* in1, Node* in2, ConINode* cond, uint vlen, BasicType bt) {
+  BoolTest::mask test = (BoolTest::mask)cond->get_int();
+  guarantee(test == BoolTest::eq || test == BoolTest::lt || test == BoolTest::gt,
+            err_msg_res("Unexpected vector compare condition %d", test));
+  const TypeVect* vt = TypeVect::make(bt, vlen);
+  return new (C) VectorMaskCmpNode(in1, in2, cond, vt);
+}
+
+BasicType VectorMaskCmpNode::compare_type(int cmp_opc) {
+  switch (cmp_opc) {
+  case Op_CmpI: return T_INT;
+  case Op_CmpF: return T_FLOAT;
+  case Op_CmpD: return T_DOUBLE;
+  }
+  return T_ILLEGAL;
+}
+
+bool VectorMaskCmpNode::implemented(int cmp_opc, uint vlen) {
+  BasicType bt = compare_type(cmp_opc);
+  return bt != T_ILLEGAL && (vlen > 1) && is_power_of_2(vlen) &&
+         Matcher::vector_size_supported(bt, vlen) &&
+         Matcher::match_rule_supported(Op_VectorMaskCmp);
+}
+
 // Return initial Pack node. Additional operands added with add_opd() calls.
 PackNode* PackNode::make(Compile* C, Node* s, uint vlen, BasicType bt) {
   const TypeVect* vt = TypeVect::make(bt, vlen);
@@ -416,6 +457,105 @@ StoreVectorNode* StoreVectorNode::make(Compile* C, int opc, Node* ctl, Node* mem
   return new (C) StoreVectorNode(ctl, mem, adr, atyp, val);
 }
 
+// Return the vector version of a scalar reduction operation.
+int ReductionNode::opcode(int opc, BasicType bt) {
+  int vopc = opc;
+  switch (opc) {
+  case Op_AddI:
+    assert(bt == T_INT, "must be");
+    vopc = Op_AddReductionVI;
+    break;
+  case Op_AddL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_AddReductionVL;
+    break;
+  case Op_AddF:
+    assert(bt == T_FLOAT, "must be");
+    vopc = Op_AddReductionVF;
+    break;
+  case Op_AddD:
+    assert(bt == T_DOUBLE, "must be");
+    vopc = Op_AddReductionVD;
+    break;
+  case Op_MulI:
+    assert(bt == T_INT, "must be");
+    vopc = Op_MulReductionVI;
+    break;
+  case Op_MulF:
+    assert(bt == T_FLOAT, "must be");
+    vopc = Op_MulReductionVF;
+    break;
+  case Op_MulD:
+    assert(bt == T_DOUBLE, "must be");
+    vopc = Op_MulReductionVD;
+    break;
+  case Op_AndI:
+    assert(bt == T_INT, "must be");
+    vopc = Op_AndReductionVI;
+    break;
+  case Op_AndL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_AndReductionVL;
+    break;
+  case Op_OrI:
+    assert(bt == T_INT, "must be");
+    vopc = Op_OrReductionVI;
+    break;
+  case Op_OrL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_OrReductionVL;
+    break;
+  case Op_XorI:
+    assert(bt == T_INT, "must be");
+    vopc = Op_XorReductionVI;
+    break;
+  case Op_XorL:
+    assert(bt == T_LONG, "must be");
+    vopc = Op_XorReductionVL;
+    break;
+  }
+  return vopc;
+}
+
+// Return the appropriate reduction node.
+ReductionNode* ReductionNode::make(Compile* C, int opc, Node *ctrl, Node* n1, Node* n2, BasicType bt) {
+
+  int vopc = opcode(opc, bt);
+
+  // This method should not be called for unimplemented vectors.
+  guarantee(vopc != opc, err_msg_res("Vector for '%s' is not implemented", NodeClassNames[opc]));
+
+  switch (vopc) {
+  case Op_AddReductionVI: return new (C) AddReductionVINode(ctrl, n1, n2);
+  case Op_AddReductionVL: return new (C) AddReductionVLNode(ctrl, n1, n2);
+  case Op_AddReductionVF: return new (C) AddReductionVFNode(ctrl, n1, n2);
+  case Op_AddReductionVD: return new (C) AddReductionVDNode(ctrl, n1, n2);
+  case Op_MulReductionVI: return new (C) MulReductionVINode(ctrl, n1, n2);
+  case Op_MulReductionVF: return new (C) MulReductionVFNode(ctrl, n1, n2);
+  case Op_MulReductionVD: return new (C) MulReductionVDNode(ctrl, n1, n2);
+  case Op_AndReductionVI: return new (C) AndReductionVINode(ctrl, n1, n2);
+  case Op_AndReductionVL: return new (C) AndReductionVLNode(ctrl, n1, n2);
+  case Op_OrReductionVI: return new (C) OrReductionVINode(ctrl, n1, n2);
+  case Op_OrReductionVL: return new (C) OrReductionVLNode(ctrl, n1, n2);
+  case Op_XorReductionVI: return new (C) XorReductionVINode(ctrl, n1, n2);
+  case Op_XorReductionVL: return new (C) XorReductionVLNode(ctrl, n1, n2);
+  }
+  fatal(err_msg_res("Missed vector creation for '%s'", NodeClassNames[vopc]));
+  return NULL;
+}
+
+// Also used to check if the code generator
+// supports the reduction operation.
+bool ReductionNode::implemented(int opc, uint vlen, BasicType bt) {
+  if (is_java_primitive(bt) &&
+      (vlen > 1) && is_power_of_2(vlen) &&
+      Matcher::vector_size_supported(bt, vlen)) {
+    int vopc = ReductionNode::opcode(opc, bt);
+    return vopc != opc && Matcher::match_rule_supported(vopc);
+  }
+  return false;
+}
+
 // Extract a scalar element of vector.
 Node* ExtractNode::make(Compile* C, Node* v, uint position, BasicType bt) {
   assert((int)position < Matcher::max_vector_size(bt), "pos in range");
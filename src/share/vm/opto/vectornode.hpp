@@ -28,6 +28,7 @@
 #include "opto/memnode.hpp"
 #include "opto/node.hpp"
 #include "opto/opcodes.hpp"
+#include "opto/subnode.hpp"
 
 //------------------------------VectorNode-------------------------------------
 // Vector Operation
@@ -43,6 +44,12 @@ class VectorNode : public TypeNode {
     init_req(1, n1);
     init_req(2, n2);
   }
+  VectorNode(Node* n1, Node* n2, Node* n3, const TypeVect* vt) : TypeNode(vt, 4) {
+    init_class_id(Class_Vector);
+    init_req(1, n1);
+    init_req(2, n2);
+    init_req(3, n3);
+  }
 
   const TypeVect* vect_type() const { return type()->is_vect(); }
   uint length() const { return vect_type()->length(); } // Vector length
@@ -59,6 +66,7 @@ class VectorNode : public TypeNode {
   static int  opcode(int opc, BasicType bt);
   static bool implemented(int opc, uint vlen, BasicType bt);
   static bool is_shift(Node* n);
+  static bool is_cmove(Node* n);
   static bool is_invariant_vector(Node* n);
   // [Start, end) half-open range defining which operands are vectors
   static void vector_operands(Node* n, uint* start, uint* end);
@@ -349,6 +357,178 @@ class XorVNode : public VectorNode {
   virtual int Opcode() const;
 };
 
+//=========================Vector=Conditional=Move=============================
+
+//------------------------------VectorMaskCmpNode------------------------------
+// Vector compare producing an all ones (true) or all zeros (false) lane mask
+// per element. Only eq, lt and gt conditions are generated; the remaining
+// ones are expressed by swapping the inputs of the consuming blend.
+class VectorMaskCmpNode : public VectorNode {
+ public:
+  VectorMaskCmpNode(Node* in1, Node* in2, ConINode* cond, const TypeVect* vt) :
+    VectorNode(in1, in2, (Node*)cond, vt) {}
+  virtual int Opcode() const;
+  BoolTest::mask cond() const { return (BoolTest::mask)in(3)->get_int(); }
+
+  static VectorMaskCmpNode* make(Compile* C, Node* in1, Node* in2, ConINode* cond, uint vlen, BasicType bt);
+  // Element type of the operands of a scalar compare, T_ILLEGAL if the
+  // compare can not be vectorized.
+  static BasicType compare_type(int cmp_opc);
+  static bool implemented(int cmp_opc, uint vlen);
+};
+
+//------------------------------VectorBlendNode--------------------------------
+// Select elements from in2 where the mask lane is set, otherwise from in1
+class VectorBlendNode : public VectorNode {
+ public:
+  VectorBlendNode(Node* in1, Node* in2, Node* mask) :
+    VectorNode(in1, in2, mask, in1->bottom_type()->is_vect()) {}
+  virtual int Opcode() const;
+};
+
+//=========================Vector=Reductions===================================
+
+//------------------------------ReductionNode------------------------------------
+// Perform reduction of a vector
+class ReductionNode : public Node {
+ public:
+  ReductionNode(Node *ctrl, Node* in1, Node* in2) : Node(ctrl, in1, in2) {}
+
+  static ReductionNode* make(Compile* C, int opc, Node *ctrl, Node* in1, Node* in2, BasicType bt);
+  static int  opcode(int opc, BasicType bt);
+  static bool implemented(int opc, uint vlen, BasicType bt);
+};
+
+//------------------------------AddReductionVINode------------------------------
+// Vector add int as a reduction
+class AddReductionVINode : public ReductionNode {
+public:
+  AddReductionVINode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------AddReductionVLNode------------------------------
+// Vector add long as a reduction
+class AddReductionVLNode : public ReductionNode {
+public:
+  AddReductionVLNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
+//------------------------------AddReductionVFNode------------------------------
+// Vector add float as a reduction
+class AddReductionVFNode : public ReductionNode {
+public:
+  AddReductionVFNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::FLOAT; }
+  virtual uint ideal_reg() const { return Op_RegF; }
+};
+
+//------------------------------AddReductionVDNode------------------------------
+// Vector add double as a reduction
+class AddReductionVDNode : public ReductionNode {
+public:
+  AddReductionVDNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::DOUBLE; }
+  virtual uint ideal_reg() const { return Op_RegD; }
+};
+
+//------------------------------MulReductionVINode------------------------------
+// Vector multiply int as a reduction
+class MulReductionVINode : public ReductionNode {
+public:
+  MulReductionVINode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------MulReductionVFNode------------------------------
+// Vector multiply float as a reduction
+class MulReductionVFNode : public ReductionNode {
+public:
+  MulReductionVFNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::FLOAT; }
+  virtual uint ideal_reg() const { return Op_RegF; }
+};
+
+//------------------------------MulReductionVDNode------------------------------
+// Vector multiply double as a reduction
+class MulReductionVDNode : public ReductionNode {
+public:
+  MulReductionVDNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return Type::DOUBLE; }
+  virtual uint ideal_reg() const { return Op_RegD; }
+};
+
+//------------------------------AndReductionVINode------------------------------
+// Vector and int as a reduction
+class AndReductionVINode : public ReductionNode {
+public:
+  AndReductionVINode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------AndReductionVLNode------------------------------
+// Vector and long as a reduction
+class AndReductionVLNode : public ReductionNode {
+public:
+  AndReductionVLNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
+//------------------------------OrReductionVINode-------------------------------
+// Vector or int as a reduction
+class OrReductionVINode : public ReductionNode {
+public:
+  OrReductionVINode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------OrReductionVLNode-------------------------------
+// Vector or long as a reduction
+class OrReductionVLNode : public ReductionNode {
+public:
+  OrReductionVLNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
+//------------------------------XorReductionVINode------------------------------
+// Vector xor int as a reduction
+class XorReductionVINode : public ReductionNode {
+public:
+  XorReductionVINode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeInt::INT; }
+  virtual uint ideal_reg() const { return Op_RegI; }
+};
+
+//------------------------------XorReductionVLNode------------------------------
+// Vector xor long as a reduction
+class XorReductionVLNode : public ReductionNode {
+public:
+  XorReductionVLNode(Node * ctrl, Node* in1, Node* in2) : ReductionNode(ctrl, in1, in2) {}
+  virtual int Opcode() const;
+  virtual const Type* bottom_type() const { return TypeLong::LONG; }
+  virtual uint ideal_reg() const { return Op_RegL; }
+};
+
 //================================= M E M O R Y ===============================
 
 //------------------------------LoadVectorNode---------------------------------
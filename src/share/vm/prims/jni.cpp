@@ -4252,6 +4252,24 @@ JNI_ENTRY(void, jni_GetStringUTFRegion(JNIEnv *env, jstring string, jsize start,
 JNI_END
 
 
+// With a heap that supports object pinning, JNI critical sections pin
+// their object instead of locking out garbage collections.
+static void lock_gc_or_pin_object(JavaThread* thread, oop obj) {
+  if (Universe::heap()->supports_object_pinning()) {
+    Universe::heap()->pin_object(thread, obj);
+  } else {
+    GC_locker::lock_critical(thread);
+  }
+}
+
+static void unlock_gc_or_unpin_object(JavaThread* thread, oop obj) {
+  if (Universe::heap()->supports_object_pinning()) {
+    Universe::heap()->unpin_object(thread, obj);
+  } else {
+    GC_locker::unlock_critical(thread);
+  }
+}
+
 JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy))
   JNIWrapper("GetPrimitiveArrayCritical");
 #ifndef USDT2
@@ -4260,11 +4278,11 @@ JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboole
  HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_ENTRY(
                                              env, array, (uintptr_t *) isCopy);
 #endif /* USDT2 */
-  GC_locker::lock_critical(thread);
+  oop a = JNIHandles::resolve_non_null(array);
+  lock_gc_or_pin_object(thread, a);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
-  oop a = JNIHandles::resolve_non_null(array);
   assert(a->is_array(), "just checking");
   BasicType type;
   if (a->is_objArray()) {
@@ -4291,8 +4309,8 @@ JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, voi
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(
                                                   env, array, carray, mode);
 #endif /* USDT2 */
-  // The array, carray and mode arguments are ignored
-  GC_locker::unlock_critical(thread);
+  // The carray and mode arguments are ignored
+  unlock_gc_or_unpin_object(thread, JNIHandles::resolve_non_null(array));
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleasePrimitiveArrayCritical__return);
 #else /* USDT2 */
@@ -4310,13 +4328,13 @@ JNI_ENTRY(const jchar*, jni_GetStringCritical(JNIEnv *env, jstring string, jbool
   HOTSPOT_JNI_GETSTRINGCRITICAL_ENTRY(
                                       env, string, (uintptr_t *) isCopy);
 #endif /* USDT2 */
-  GC_locker::lock_critical(thread);
-  if (isCopy != NULL) {
-    *isCopy = JNI_FALSE;
-  }
   oop s = JNIHandles::resolve_non_null(string);
   int s_len = java_lang_String::length(s);
   typeArrayOop s_value = java_lang_String::value(s);
+  lock_gc_or_pin_object(thread, s_value);
+  if (isCopy != NULL) {
+    *isCopy = JNI_FALSE;
+  }
   int s_offset = java_lang_String::offset(s);
   const jchar* ret;
   if (s_len > 0) {
@@ -4342,8 +4360,18 @@ JNI_ENTRY(void, jni_ReleaseStringCritical(JNIEnv *env, jstring str, const jchar
   HOTSPOT_JNI_RELEASESTRINGCRITICAL_ENTRY(
                                           env, str, (uint16_t *) chars);
 #endif /* USDT2 */
-  // The str and chars arguments are ignored
-  GC_locker::unlock_critical(thread);
+  if (Universe::heap()->supports_object_pinning()) {
+    // Unpin the array "chars" points into; the String may refer to another
+    // value array by now if it has been deduplicated meanwhile.
+    oop s = JNIHandles::resolve_non_null(str);
+    int s_offset = java_lang_String::length(s) > 0 ? java_lang_String::offset(s) : 0;
+    address base = (address) (chars - s_offset);
+    oop s_value = (oop) (base - arrayOopDesc::base_offset_in_bytes(T_CHAR));
+    Universe::heap()->unpin_object(thread, s_value);
+  } else {
+    // The str and chars arguments are ignored
+    GC_locker::unlock_critical(thread);
+  }
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleaseStringCritical__return);
 #else /* USDT2 */
@@ -5626,7 +5654,8 @@ jint JNICALL jni_GetEnv(JavaVM *vm, void **penv, jint version) {
       ret = JNI_OK;
       return ret;
 
-    } else if (TENANT_ENV_VERSION_1_0 == version) { //get the tenant environment for java thread.
+    } else if (TENANT_ENV_VERSION_1_0 == version ||
+               TENANT_ENV_VERSION_1_1 == version) { //get the tenant environment for java thread.
       *(TenantEnv**)penv = ((JavaThread*) thread)->tenant_environment();
       ret = JNI_OK;
       return ret;
@@ -4033,7 +4033,24 @@ JVM_ENTRY(jlong, JVM_GetTenantOccupiedMemory(JNIEnv* env, jobject ignored, jlong
   G1TenantAllocationContext* alloc_context = (G1TenantAllocationContext*)context;
   assert(alloc_context != NULL, "Bad allocation context!");
   assert(alloc_context->tenant_container() != NULL, "NULL tenant container");
-  return (alloc_context->occupied_heap_region_count() * HeapRegion::GrainBytes);
+  return alloc_context->occupied_bytes();
+JVM_END
+
+// Fills stats with the bytes and objects evacuated from the regions of the
+// tenant and its share of the evacuation pause time in nanoseconds
+JVM_ENTRY(void, JVM_GetTenantGCStatistics(JNIEnv* env, jobject ignored, jlong context, jlongArray stats))
+  JVMWrapper("JVM_GetTenantGCStatistics");
+  assert(UseG1GC && TenantHeapIsolation, "pre-condition");
+  typeArrayOop a = typeArrayOop(JNIHandles::resolve_non_null(stats));
+  if (a->length() < 3) {
+    THROW(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  G1TenantAllocationContext* alloc_context = (G1TenantAllocationContext*)context;
+  G1TenantGCStats* gc_stats = (alloc_context == NULL) ?
+      G1TenantAllocationContexts::gc_stats_of(AllocationContext::system()) : alloc_context->gc_stats();
+  a->long_at_put(0, (jlong)gc_stats->copied_bytes());
+  a->long_at_put(1, (jlong)gc_stats->copied_objects());
+  a->long_at_put(2, (jlong)(gc_stats->pause_time_ms() * NANOSECS_PER_MILLISEC));
 JVM_END
 
 // Array ///////////////////////////////////////////////////////////////////////////////////////////
@@ -5043,6 +5060,37 @@ JVM_ENTRY(jlong, JVM_ElasticHeapGetTotalUncommittedBytes(JNIEnv *env, jclass kla
   return G1CollectedHeap::heap()->elastic_heap()->uncommitted_bytes();
 JVM_END
 
+JVM_ENTRY(void, JVM_ElasticHeapSetTenantHeapLimit(JNIEnv *env, jclass klass, jlong tenantId, jlong limit))
+  JVMWrapper("JVM_ElasticHeapSetTenantHeapLimit");
+  assert(G1ElasticHeap, "Precondition");
+
+  if (!TenantHeapThrottling) {
+    THROW_MSG(vmSymbols::java_lang_IllegalStateException(), "-XX:+TenantHeapThrottling is not enabled");
+  }
+  if (limit <= 0) {
+    THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(), "limit should be positive");
+  }
+  ElasticHeap::ErrorType error = G1CollectedHeap::heap()->elastic_heap()->configure_tenant_heap_limit(tenantId, (size_t)limit);
+  if (error == ElasticHeap::IllegalTenant) {
+    THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(), ElasticHeap::to_string(error));
+  }
+JVM_END
+
+JVM_ENTRY(jlong, JVM_ElasticHeapGetTenantHeapLimit(JNIEnv *env, jclass klass, jlong tenantId))
+  JVMWrapper("JVM_ElasticHeapGetTenantHeapLimit");
+  assert(G1ElasticHeap, "Precondition");
+
+  if (!TenantHeapThrottling) {
+    THROW_MSG_0(vmSymbols::java_lang_IllegalStateException(), "-XX:+TenantHeapThrottling is not enabled");
+  }
+  size_t limit = 0;
+  ElasticHeap::ErrorType error = G1CollectedHeap::heap()->elastic_heap()->tenant_heap_limit(tenantId, &limit);
+  if (error == ElasticHeap::IllegalTenant) {
+    THROW_MSG_0(vmSymbols::java_lang_IllegalArgumentException(), ElasticHeap::to_string(error));
+  }
+  return (jlong)limit;
+JVM_END
+
 JVM_ENTRY(void, JVM_SetWispTask(JNIEnv* env, jclass klass, jlong coroutinePtr, jint task_id, jobject task, jobject engine))
   JVMWrapper("JVM_SetWispTask");
   Coroutine* coro = (Coroutine*)coroutinePtr;
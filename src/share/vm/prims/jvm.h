@@ -387,6 +387,9 @@ JVM_TenantContainerOf(JNIEnv *env, jclass tenantContainerClass, jobject obj);
 JNIEXPORT jlong JNICALL
 JVM_GetTenantOccupiedMemory(JNIEnv *env, jobject ignored, jlong context);
 
+JNIEXPORT void JNICALL
+JVM_GetTenantGCStatistics(JNIEnv *env, jobject ignored, jlong context, jlongArray stats);
+
 /*
  * java.lang.reflect.Array
  */
@@ -1765,6 +1768,10 @@ JNIEXPORT jint JNICALL
 JVM_ElasticHeapGetSoftmxPercent(JNIEnv *env, jclass clazz);
 JNIEXPORT jlong JNICALL
 JVM_ElasticHeapGetTotalUncommittedBytes(JNIEnv *env, jclass clazz);
+JNIEXPORT void JNICALL
+JVM_ElasticHeapSetTenantHeapLimit(JNIEnv *env, jclass clazz, jlong tenantId, jlong limit);
+JNIEXPORT jlong JNICALL
+JVM_ElasticHeapGetTenantHeapLimit(JNIEnv *env, jclass clazz, jlong tenantId);
 
 JNIEXPORT void JNICALL
 JVM_SetWispTask(JNIEnv* env, jclass clz, jlong coroutinePtr, jint task_id, jobject task, jobject engine);
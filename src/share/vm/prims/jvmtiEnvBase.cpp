@@ -968,13 +968,17 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
     }
 
     address owner = NULL;
+    bool fast_locked = false;
     {
       markOop mark = hobj()->mark();
 
       if (!mark->has_monitor()) {
         // this object has a lightweight monitor
 
-        if (mark->has_locker()) {
+        if (UseLightweightLocking) {
+          // the owner is only recorded on its lock stack
+          fast_locked = mark->is_fast_locked();
+        } else if (mark->has_locker()) {
           owner = (address)mark->locker(); // save the address of the Lock word
         }
         // implied else: no owner
@@ -989,15 +993,19 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
         // can change the owner field from the Lock word to the
         // JavaThread * and it may not have done that yet.
         owner = (address)mon->owner();
+        fast_locked = UseLightweightLocking && mon->is_owner_anonymous();
       }
     }
 
-    if (owner != NULL) {
+    if (owner != NULL || fast_locked) {
       // This monitor is owned so we have to find the owning JavaThread.
       // Since owning_thread_from_monitor_owner() grabs a lock, GC can
       // move our object at this point. However, our owner value is safe
       // since it is either the Lock word on a stack or a JavaThread *.
-      owning_thread = Threads::owning_thread_from_monitor_owner(owner, !at_safepoint);
+      // The lock stacks are GC roots, so hobj stays valid to search them.
+      owning_thread = fast_locked ?
+        Threads::owning_thread_from_object(hobj(), !at_safepoint) :
+        Threads::owning_thread_from_monitor_owner(owner, !at_safepoint);
       // Cannot assume (owning_thread != NULL) here because this function
       // may not have been called at a safepoint and the owning_thread
       // might not be suspended.
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "code/codeCache.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jvmtifiles/jvmtiEnv.hpp"
 #include "memory/resourceArea.hpp"
@@ -94,6 +95,7 @@ static const jlong  MONITOR_BITS = MONITOR_CONTENDED_ENTER_BIT | MONITOR_CONTEND
 static const jlong  EXCEPTION_BITS = EXCEPTION_THROW_BIT | EXCEPTION_CATCH_BIT;
 static const jlong  INTERP_EVENT_BITS =  SINGLE_STEP_BIT | METHOD_ENTRY_BIT | METHOD_EXIT_BIT |
                                 FRAME_POP_BIT | FIELD_ACCESS_BIT | FIELD_MODIFICATION_BIT;
+static const jlong  METHOD_TRACE_BITS = METHOD_ENTRY_BIT | METHOD_EXIT_BIT;
 static const jlong  THREAD_FILTERED_EVENT_BITS = INTERP_EVENT_BITS | EXCEPTION_BITS | MONITOR_BITS |
                                         BREAKPOINT_BIT | CLASS_LOAD_BIT | CLASS_PREPARE_BIT | THREAD_END_BIT;
 static const jlong  NEED_THREAD_LIFE_EVENTS = THREAD_FILTERED_EVENT_BITS | THREAD_START_BIT;
@@ -266,6 +268,37 @@ VM_ChangeSingleStep::VM_ChangeSingleStep(bool on)
 }
 
 
+///////////////////////////////////////////////////////////////
+//
+// VM_ChangeTracedMethodEvents
+//
+
+class VM_ChangeTracedMethodEvents : public VM_Operation {
+private:
+  bool _on;
+
+public:
+  VM_ChangeTracedMethodEvents(bool on) : _on(on) {}
+  VMOp_Type type() const                         { return VMOp_ChangeTracedMethodEvents; }
+  bool allow_nested_vm_operations() const        { return true; }
+  void doit();
+};
+
+void VM_ChangeTracedMethodEvents::doit() {
+  JvmtiExport::set_should_post_traced_method_events(_on);
+  if (_on) {
+    // Methods selected for tracing are never inlined, see Method::link_method.
+    // Throwing away their own nmethods sends them back to the interpreter,
+    // which posts the events; compilation policy keeps them there until
+    // the events are disabled again.
+    if (CodeCache::mark_for_jvmti_trace_deoptimization() > 0) {
+      VM_Deoptimize op;
+      VMThread::execute(&op);
+    }
+  }
+}
+
+
 
 
 ///////////////////////////////////////////////////////////////
@@ -520,8 +553,11 @@ JvmtiEventControllerPrivate::recompute_thread_enabled(JvmtiThreadState *state) {
     // mark if event is truly enabled on this thread in any environment
     state->thread_event_enable()->_event_enabled.set_bits(any_env_enabled);
 
-    // compute interp_only mode
-    bool should_be_interp = (any_env_enabled & INTERP_EVENT_BITS) != 0;
+    // compute interp_only mode; with JvmtiSelectiveMethodTrace method entry
+    // and exit are posted by the selected methods without it
+    jlong interp_event_bits = JvmtiSelectiveMethodTrace ?
+                              (INTERP_EVENT_BITS & ~METHOD_TRACE_BITS) : INTERP_EVENT_BITS;
+    bool should_be_interp = (any_env_enabled & interp_event_bits) != 0;
     bool is_now_interp = state->is_interp_only_mode();
 
     if (should_be_interp != is_now_interp) {
@@ -638,6 +674,29 @@ JvmtiEventControllerPrivate::recompute_enabled() {
       }
     }
 
+    // If method tracing of the selected methods is turned on or off,
+    // execute the VM op that moves them out of compiled code.
+    if (JvmtiSelectiveMethodTrace && (delta & METHOD_TRACE_BITS) != 0) {
+      bool on = (any_env_thread_enabled & METHOD_TRACE_BITS) != 0;
+      if (on != JvmtiExport::should_post_traced_method_events()) {
+        switch (JvmtiEnv::get_phase()) {
+        case JVMTI_PHASE_DEAD:
+          // If the VM is dying we can't execute VM ops
+          break;
+        case JVMTI_PHASE_START:
+        case JVMTI_PHASE_LIVE: {
+          VM_ChangeTracedMethodEvents op(on);
+          VMThread::execute(&op);
+          break;
+        }
+        default:
+          // no VM thread and nothing compiled yet
+          JvmtiExport::set_should_post_traced_method_events(on);
+          break;
+        }
+      }
+    }
+
     // set global truly enabled, that is, any thread in any environment
     JvmtiEventController::_universal_global_event_enabled.set_bits(any_env_thread_enabled);
 
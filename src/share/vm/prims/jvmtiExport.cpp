@@ -327,6 +327,16 @@ address JvmtiExport::get_field_access_count_addr() {
   return (address)(&_field_access_count);
 }
 
+//
+// selective method trace management
+//
+
+// interpreter generator needs the address of the flag; it is only
+// changed at a safepoint
+address JvmtiExport::get_should_post_traced_method_events_addr() {
+  return (address)(&_should_post_traced_method_events);
+}
+
 //
 // field modification management
 //
@@ -861,6 +871,7 @@ bool              JvmtiExport::_should_post_object_free                   = fals
 bool              JvmtiExport::_should_post_resource_exhausted            = false;
 bool              JvmtiExport::_should_post_vm_object_alloc               = false;
 bool              JvmtiExport::_should_post_on_exceptions                 = false;
+bool              JvmtiExport::_should_post_traced_method_events          = false;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -1121,12 +1132,19 @@ void JvmtiExport::post_method_entry(JavaThread *thread, Method* method, frame cu
                      (mh() == NULL) ? "NULL" : mh()->name()->as_C_string() ));
 
   JvmtiThreadState* state = thread->jvmti_thread_state();
-  if (state == NULL || !state->is_interp_only_mode()) {
-    // for any thread that actually wants method entry, interp_only_mode is set
+  if (state == NULL) {
+    return;
+  }
+  bool interp_only = state->is_interp_only_mode();
+  if (!interp_only && !(should_post_traced_method_events() && mh->is_jvmti_traced())) {
+    // for any thread that actually wants method entry, interp_only_mode is set,
+    // unless the method is selected for JvmtiSelectiveMethodTrace
     return;
   }
 
-  state->incr_cur_stack_depth();
+  if (interp_only) {
+    state->incr_cur_stack_depth();
+  }
 
   if (state->is_enabled(JVMTI_EVENT_METHOD_ENTRY)) {
     JvmtiEnvThreadStateIterator it(state);
@@ -1159,8 +1177,13 @@ void JvmtiExport::post_method_exit(JavaThread *thread, Method* method, frame cur
                      (mh() == NULL) ? "NULL" : mh()->name()->as_C_string() ));
 
   JvmtiThreadState *state = thread->jvmti_thread_state();
-  if (state == NULL || !state->is_interp_only_mode()) {
-    // for any thread that actually wants method exit, interp_only_mode is set
+  if (state == NULL) {
+    return;
+  }
+  bool interp_only = state->is_interp_only_mode();
+  if (!interp_only && !(should_post_traced_method_events() && mh->is_jvmti_traced())) {
+    // for any thread that actually wants method exit, interp_only_mode is set,
+    // unless the method is selected for JvmtiSelectiveMethodTrace
     return;
   }
 
@@ -1209,6 +1232,12 @@ void JvmtiExport::post_method_exit(JavaThread *thread, Method* method, frame cur
     }
   }
 
+  if (!interp_only) {
+    // frame pops and the cached stack depth are only maintained in
+    // interp_only_mode
+    return;
+  }
+
   if (state->is_enabled(JVMTI_EVENT_FRAME_POP)) {
     JvmtiEnvThreadStateIterator it(state);
     for (JvmtiEnvThreadState* ets = it.first(); ets != NULL; ets = it.next(ets)) {
@@ -1392,9 +1421,11 @@ void JvmtiExport::notice_unwind_due_to_exception(JavaThread *thread, Method* met
     state->invalidate_cur_stack_depth();
     if (!in_handler_frame) {
       // Not in exception handler.
-      if(state->is_interp_only_mode()) {
+      if(state->is_interp_only_mode() ||
+         (should_post_traced_method_events() && mh->is_jvmti_traced())) {
         // method exit and frame pop events are posted only in interp mode.
         // When these events are enabled code should be in running in interp mode.
+        // Methods selected for JvmtiSelectiveMethodTrace always run interpreted.
         JvmtiExport::post_method_exit(thread, method, thread->last_frame());
         // The cached cur_stack_depth might have changed from the
         // operations of frame pop or method exit. We are not 100% sure
@@ -110,6 +110,9 @@ class JvmtiExport : public AllStatic {
   JVMTI_SUPPORT_FLAG(should_post_garbage_collection_start)
   JVMTI_SUPPORT_FLAG(should_post_garbage_collection_finish)
   JVMTI_SUPPORT_FLAG(should_post_on_exceptions)
+  // JvmtiSelectiveMethodTrace: MethodEntry or MethodExit is enabled and
+  // the methods selected for tracing post them from the interpreter
+  JVMTI_SUPPORT_FLAG(should_post_traced_method_events)
 
   // ------ the below maybe don't have to be (but are for now)
   // fixed conditions here ------------
@@ -250,6 +253,9 @@ class JvmtiExport : public AllStatic {
   // field modification management
   static address  get_field_modification_count_addr() NOT_JVMTI_RETURN_(0);
 
+  // selective method trace management
+  static address  get_should_post_traced_method_events_addr() NOT_JVMTI_RETURN_(0);
+
   // -----------------
 
   static bool is_jvmti_version(jint version)                      {
@@ -193,10 +193,10 @@ char* NativeLookup::pure_jni_name(methodHandle method) {
 }
 
 
-char* NativeLookup::critical_jni_name(methodHandle method) {
+char* NativeLookup::critical_jni_name(methodHandle method, const char* prefix) {
   stringStream st;
   // Prefix
-  st.print("JavaCritical_");
+  st.print("%s", prefix);
   // Klass name
   if (!map_escaped_name_on(&st, method->klass_name())) {
     return NULL;
@@ -393,11 +393,23 @@ address NativeLookup::lookup_entry(methodHandle method, bool& in_base_library, T
   return entry; // NULL indicates not found
 }
 
-// Check all the formats of native implementation name to see if there is one
-// for the specified method.
 address NativeLookup::lookup_critical_entry(methodHandle method) {
   if (!CriticalJNINatives) return NULL;
+  return lookup_critical_entry(method, "JavaCritical_");
+}
 
+// Trivial natives are critical natives the wrapper calls while the thread stays
+// _thread_in_Java, see SharedRuntime::generate_native_wrapper. They get the same
+// link time checks: static, not synchronized, primitive and primitive array
+// arguments only.
+address NativeLookup::lookup_trivial_entry(methodHandle method) {
+  if (!CriticalJNINatives || !TrivialJNINatives) return NULL;
+  return lookup_critical_entry(method, "JavaTrivial_");
+}
+
+// Check all the formats of native implementation name to see if there is one
+// for the specified method.
+address NativeLookup::lookup_critical_entry(methodHandle method, const char* prefix) {
   if (method->is_synchronized() ||
       !method->is_static()) {
     // Only static non-synchronized methods are allowed
@@ -416,7 +428,7 @@ address NativeLookup::lookup_critical_entry(methodHandle method) {
   }
 
   // Compute critical name
-  char* critical_name = critical_jni_name(method);
+  char* critical_name = critical_jni_name(method, prefix);
   if (critical_name == NULL) {
     // JNI name mapping rejected this method so return
     // NULL to indicate UnsatisfiedLinkError should be thrown.
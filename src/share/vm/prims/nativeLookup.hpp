@@ -36,7 +36,7 @@ class NativeLookup : AllStatic {
   // JNI name computation
   static char* pure_jni_name(methodHandle method);
   static char* long_jni_name(methodHandle method);
-  static char* critical_jni_name(methodHandle method);
+  static char* critical_jni_name(methodHandle method, const char* prefix);
 
   // Style specific lookup
   static address lookup_style(methodHandle method, char* pure_name, const char* long_name, int args_size, bool os_style, bool& in_base_library, TRAPS);
@@ -44,10 +44,13 @@ class NativeLookup : AllStatic {
   static address lookup_base (methodHandle method, bool& in_base_library, TRAPS);
   static address lookup_entry(methodHandle method, bool& in_base_library, TRAPS);
   static address lookup_entry_prefixed(methodHandle method, bool& in_base_library, TRAPS);
+  static address lookup_critical_entry(methodHandle method, const char* prefix);
  public:
   // Lookup native function. May throw UnsatisfiedLinkError.
   static address lookup(methodHandle method, bool& in_base_library, TRAPS);
   static address lookup_critical_entry(methodHandle method);
+  // Lookup a critical native that is called without any thread state transition.
+  static address lookup_trivial_entry(methodHandle method);
 
   // Lookup native functions in base library.
   static address base_library_lookup(const char* class_name, const char* method_name, const char* signature);
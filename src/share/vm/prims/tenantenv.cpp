@@ -22,6 +22,7 @@
 #include "precompiled.hpp"
 #include "prims/tenantenv.h"
 #include "runtime/globals.hpp"
+#include "runtime/tenantCpuBudget.hpp"
 
 /**
  * Be careful: any change to the following constant defintions, you MUST
@@ -34,11 +35,18 @@
 #define TENANT_FLAG_DATA_ISOLATION_ENABLED           (0x8)    // bit 3 to indicate if data isolation(e.g static vairable isolation) feature is enabled.
 #define TENANT_FLAG_CPU_ACCOUNTING_ENABLED          (0x40)    // bit 6 to indicate if cpu accounting feature is enabled.
 #define TENANT_FLAG_HEAP_ISOLATION_ENABLED          (0x80)    // bit 7 to indicate if heap isolation feature is enabled.
+#define TENANT_FLAG_CPU_BUDGETING_ENABLED          (0x100)    // bit 8 to indicate if coroutine cpu budgeting feature is enabled.
 
 static jint tenant_GetTenantFlags(TenantEnv *env, jclass cls);
+static jlong tenant_GetTenantCpuTime(TenantEnv *env, jlong id);
+static void tenant_SetTenantCpuLimit(TenantEnv *env, jlong id, jint percent);
+static jboolean tenant_IsTenantOverBudget(TenantEnv *env, jlong id);
 
 static struct TenantNativeInterface_ tenantNativeInterface = {
-  tenant_GetTenantFlags
+  tenant_GetTenantFlags,
+  tenant_GetTenantCpuTime,
+  tenant_SetTenantCpuLimit,
+  tenant_IsTenantOverBudget
 };
 
 struct TenantNativeInterface_* tenant_functions()
@@ -75,5 +83,29 @@ tenant_GetTenantFlags(TenantEnv *env, jclass cls)
     result |= TENANT_FLAG_DATA_ISOLATION_ENABLED;
   }
 
+  if (TenantCpuBudgeting) {
+    result |= TENANT_FLAG_CPU_BUDGETING_ENABLED;
+  }
+
   return result;
 }
+
+static jlong
+tenant_GetTenantCpuTime(TenantEnv *env, jlong id)
+{
+  return TenantCpuBudgeting ? TenantCpuBudget::cpu_time(id) : 0;
+}
+
+static void
+tenant_SetTenantCpuLimit(TenantEnv *env, jlong id, jint percent)
+{
+  if (TenantCpuBudgeting) {
+    TenantCpuBudget::set_limit(id, percent);
+  }
+}
+
+static jboolean
+tenant_IsTenantOverBudget(TenantEnv *env, jlong id)
+{
+  return TenantCpuBudgeting && TenantCpuBudget::is_over_budget(id) ? JNI_TRUE : JNI_FALSE;
+}
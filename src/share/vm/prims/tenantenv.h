@@ -26,6 +26,8 @@
 
 // 0x00200000 represents tenant module and the last 10 represents version 1.0
 #define TENANT_ENV_VERSION_1_0  0x00200010
+// version 1.1 adds the per-tenant CPU budgets of -XX:+TenantCpuBudgeting
+#define TENANT_ENV_VERSION_1_1  0x00200011
 
 /*
  * Tenant Native Method Interface.
@@ -48,6 +50,9 @@ typedef const struct TenantNativeInterface_* TenantEnv;
  */
 struct TenantNativeInterface_ {
   jint (JNICALL *GetTenantFlags)(TenantEnv *env, jclass cls);
+  jlong (JNICALL *GetTenantCpuTime)(TenantEnv *env, jlong id);
+  void (JNICALL *SetTenantCpuLimit)(TenantEnv *env, jlong id, jint percent);
+  jboolean (JNICALL *IsTenantOverBudget)(TenantEnv *env, jlong id);
 };
 
 struct TenantEnv_ {
@@ -56,6 +61,15 @@ struct TenantEnv_ {
   jint GetTenantFlags(jclass cls) {
     return functions->GetTenantFlags(this, cls);
   }
+  jlong GetTenantCpuTime(jlong id) {
+    return functions->GetTenantCpuTime(this, id);
+  }
+  void SetTenantCpuLimit(jlong id, jint percent) {
+    functions->SetTenantCpuLimit(this, id, percent);
+  }
+  jboolean IsTenantOverBudget(jlong id) {
+    return functions->IsTenantOverBudget(this, id);
+  }
 #endif
 };
 
@@ -43,6 +43,9 @@
 #include "services/threadService.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/dtrace.hpp"
+#if INCLUDE_JFR
+#include "jfr/support/jfrContext.hpp"
+#endif
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -709,6 +712,81 @@ UNSAFE_ENTRY(void, Unsafe_CopyMemory2(JNIEnv *env, jobject unsafe, jobject srcOb
 UNSAFE_END
 
 
+////// Bulk compare and hash
+
+// These define the results of Unsafe.vectorizedMismatch and Unsafe.hash,
+// the stubs behind their compiler intrinsics must compute the same.
+
+// Index of the first byte that differs, -1 if the ranges are equal.
+static jlong unsafe_vectorized_mismatch(address a, address b, size_t length) {
+  size_t i = 0;
+  for (; i + BytesPerLong <= length; i += BytesPerLong) {
+    julong wa, wb;
+    memcpy(&wa, a + i, sizeof(wa));
+    memcpy(&wb, b + i, sizeof(wb));
+    if (wa != wb) {
+      break;
+    }
+  }
+  for (; i < length; i++) {
+    if (a[i] != b[i]) {
+      return (jlong)i;
+    }
+  }
+  return -1;
+}
+
+static const julong unsafe_hash_multiplier = CONST64(0x9E3779B97F4A7C15);
+
+static inline julong unsafe_hash_mix(julong h, julong word) {
+  h = (h ^ word) * unsafe_hash_multiplier;
+  return h ^ (h >> 29);
+}
+
+// Mixes the range word by word in native byte order, the trailing bytes
+// form one more little endian word.
+static jint unsafe_hash(address p, size_t length, jint seed) {
+  julong h = (julong)length * unsafe_hash_multiplier + (juint)seed;
+  size_t i = 0;
+  for (; i + BytesPerLong <= length; i += BytesPerLong) {
+    julong word;
+    memcpy(&word, p + i, sizeof(word));
+    h = unsafe_hash_mix(h, word);
+  }
+  if (i < length) {
+    julong word = 0;
+    for (size_t j = length; j > i; j--) {
+      word = (word << BitsPerByte) | p[j - 1];
+    }
+    h = unsafe_hash_mix(h, word);
+  }
+  return (jint)(h ^ (h >> 32));
+}
+
+UNSAFE_ENTRY(jlong, Unsafe_VectorizedMismatch(JNIEnv *env, jobject unsafe, jobject aObj, jlong aOffset, jobject bObj, jlong bOffset, jlong length))
+  UnsafeWrapper("Unsafe_VectorizedMismatch");
+  size_t sz = (size_t)length;
+  if (sz != (julong)length || length < 0) {
+    THROW_0(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  oop ap = JNIHandles::resolve(aObj);
+  oop bp = JNIHandles::resolve(bObj);
+  address a = (address)index_oop_from_field_offset_long(ap, aOffset);
+  address b = (address)index_oop_from_field_offset_long(bp, bOffset);
+  return unsafe_vectorized_mismatch(a, b, sz);
+UNSAFE_END
+
+UNSAFE_ENTRY(jint, Unsafe_Hash(JNIEnv *env, jobject unsafe, jobject obj, jlong offset, jlong length, jint seed))
+  UnsafeWrapper("Unsafe_Hash");
+  size_t sz = (size_t)length;
+  if (sz != (julong)length || length < 0) {
+    THROW_0(vmSymbols::java_lang_IllegalArgumentException());
+  }
+  oop p = JNIHandles::resolve(obj);
+  return unsafe_hash((address)index_oop_from_field_offset_long(p, offset), sz, seed);
+UNSAFE_END
+
+
 ////// Random queries
 
 // See comment at file start about UNSAFE_LEAF
@@ -1141,7 +1219,7 @@ UNSAFE_ENTRY(jclass, Unsafe_DefineAnonymousClass(JNIEnv *env, jobject unsafe, jc
   // this point.   The mirror and any instances of this class have to keep
   // it alive afterwards.
   if (anon_klass() != NULL) {
-    anon_klass->class_loader_data()->set_keep_alive(false);
+    anon_klass->class_loader_data()->dec_keep_alive();
   }
 
   // let caller initialize it as needed...
@@ -1245,6 +1323,7 @@ static void post_thread_park_event(EventThreadPark* event, const oop obj, jlong
   event->set_timeout(timeout_nanos);
   event->set_until(until_epoch_millis);
   event->set_address((obj != NULL) ? (u8)cast_from_oop<uintptr_t>(obj) : 0);
+  JFR_ONLY(JfrContext::set_context(event, Thread::current());)
   event->commit();
 }
 
@@ -1482,8 +1561,12 @@ JVM_ENTRY(jboolean, CoroutineSupport_stealCoroutine(JNIEnv* env, jclass klass, j
   // so we must finish the steal operation as soon as possible.
   Coroutine* coro = (Coroutine*) coroPtr;
   if (coro == NULL || coro->enable_steal_count() != coro->java_call_counter()|| coro->is_yielding()) {
+      if (Coroutine::_perf_failed_steals != NULL) {
+        Coroutine::_perf_failed_steals->inc();
+      }
       return false;       // an Exception throws and the coroutine being stealed is exited
   }
+  jlong start = Coroutine::_perf_steal_time != NULL ? os::elapsed_counter() : 0;
   assert(coro->thread() != thread, "steal from self");
   assert(coro->state() != Coroutine::_current, "running");
   coro->remove_from_list(coro->thread()->coroutine_list());
@@ -1500,6 +1583,10 @@ JVM_ENTRY(jboolean, CoroutineSupport_stealCoroutine(JNIEnv* env, jclass klass, j
       coro->set_wisp_engine(thread->current_coroutine()->wisp_engine());
     }
   }
+  if (Coroutine::_perf_steal_time != NULL) {
+    Coroutine::_perf_steals->inc();
+    Coroutine::_perf_steal_time->inc(os::elapsed_counter() - start);
+  }
   return true;
 JVM_END
 
@@ -1845,6 +1932,11 @@ JNINativeMethod memcopy_methods_15[] = {
     {CC "copyMemory",         CC "(" ADR ADR "J)V",          FN_PTR(Unsafe_CopyMemory)}
 };
 
+JNINativeMethod memaccess_methods[] = {
+    {CC "vectorizedMismatch", CC "(" OBJ "J" OBJ "JJ)J",       FN_PTR(Unsafe_VectorizedMismatch)},
+    {CC "hash",               CC "(" OBJ "JJI)I",            FN_PTR(Unsafe_Hash)}
+};
+
 JNINativeMethod anonk_methods[] = {
     {CC "defineAnonymousClass", CC "(" DAC_Args ")" CLS,      FN_PTR(Unsafe_DefineAnonymousClass)},
 };
@@ -1973,6 +2065,9 @@ JVM_ENTRY(void, JVM_RegisterUnsafeMethods(JNIEnv *env, jclass unsafecls))
       }
     }
 
+    // Bulk compare and hash methods, only present in JDKs that declare them
+    register_natives("bulk compare and hash methods", env, unsafecls, memaccess_methods, sizeof(memaccess_methods)/sizeof(JNINativeMethod));
+
     // Unsafe.defineAnonymousClass
     if (EnableInvokeDynamic) {
       register_natives("1.7 define anonymous class method", env, unsafecls, anonk_methods, sizeof(anonk_methods)/sizeof(JNINativeMethod));
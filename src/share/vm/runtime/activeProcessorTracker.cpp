@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/activeProcessorTracker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
+#include "utilities/ostream.hpp"
+
+volatile int ActiveProcessorTracker::_count = 0;
+
+class ActiveProcessorTrackerTask : public PeriodicTask {
+ public:
+  ActiveProcessorTrackerTask(size_t interval_time) : PeriodicTask(interval_time) { }
+  void task() { ActiveProcessorTracker::update(); }
+};
+
+void ActiveProcessorTracker::engage() {
+  if (ActiveProcessorCountPollInterval == 0) {
+    return;
+  }
+  _count = os::initial_active_processor_count();
+  size_t interval = align_size_up(MIN2(MAX2(ActiveProcessorCountPollInterval, (uintx)PeriodicTask::min_interval),
+                                       (uintx)PeriodicTask::max_interval),
+                                  (uintx)PeriodicTask::interval_gran);
+  ActiveProcessorTrackerTask* task = new ActiveProcessorTrackerTask(interval);
+  task->enroll();
+}
+
+// Runs on the watcher thread. os::active_processor_count() goes back to
+// the cgroup files once its container cache has expired.
+void ActiveProcessorTracker::update() {
+  int count = MAX2(os::active_processor_count(), 1);
+  if (count != _count) {
+    if (TraceDynamicGCThreads || TraceCompilerThreads) {
+      tty->print_cr("Active processor count changed from %d to %d", _count, count);
+    }
+    _count = count;
+  }
+}
+
+uint ActiveProcessorTracker::parallel_worker_limit() {
+  // The same curve as Abstract_VM_Version::calc_parallel_worker_threads()
+  const uint switch_pt = 8;
+  uint ncpus = (uint)count();
+  return (ncpus <= switch_pt) ? ncpus : switch_pt + ((ncpus - switch_pt) * 5) / 8;
+}
+
+uint ActiveProcessorTracker::conc_worker_limit() {
+  // About a quarter of the parallel workers, as G1 and CMS derive
+  // ConcGCThreads from ParallelGCThreads
+  return MAX2((parallel_worker_limit() + 2) / 4, 1U);
+}
+
+int ActiveProcessorTracker::compiler_thread_limit(bool c1) {
+  // The tiered ergonomics of AdvancedThresholdPolicy::initialize()
+  int log_cpu = log2_int(count());
+  int loglog_cpu = log2_int(MAX2(log_cpu, 1));
+  int total = MAX2(log_cpu * loglog_cpu, 1) * 3 / 2;
+  int c1_limit = MAX2(total / 3, 1);
+  return c1 ? c1_limit : MAX2(total - c1_limit, 1);
+}
+
+// Fewer active than total workers requires UseDynamicNumberOfGCThreads,
+// which engaging the tracker turns on unless it was switched off.
+uint ActiveProcessorTracker::limit_parallel_workers(uint workers) {
+  if (!is_engaged() || !UseDynamicNumberOfGCThreads) {
+    return workers;
+  }
+  return MAX2(MIN2(workers, parallel_worker_limit()), 1U);
+}
+
+uint ActiveProcessorTracker::limit_conc_workers(uint workers) {
+  if (!is_engaged() || !UseDynamicNumberOfGCThreads) {
+    return workers;
+  }
+  return MAX2(MIN2(workers, conc_worker_limit()), 1U);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_ACTIVEPROCESSORTRACKER_HPP
+#define SHARE_VM_RUNTIME_ACTIVEPROCESSORTRACKER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+
+// ActiveProcessorTracker re-reads the number of processors the process
+// may use (the cgroup cpu quota and shares in a container) every
+// ActiveProcessorCountPollInterval ms, so that GC worker, concurrent
+// GC and compiler thread counts follow quota changes made while the VM
+// runs. Thread pools are still created at startup; the limits below only
+// cap how many of their threads are used, so a pool can grow back up
+// to its startup size but not beyond it.
+class ActiveProcessorTracker : AllStatic {
+  friend class ActiveProcessorTrackerTask;
+ private:
+  static volatile int _count;                    // 0 until engaged
+
+  static void update();
+
+ public:
+  static void engage();
+  static bool is_engaged()           { return _count > 0; }
+
+  // Processor count as of the last poll
+  static int count()                 { return _count; }
+
+  // Number of parallel GC workers, concurrent GC workers and compiler
+  // threads of one compiler ergonomics would choose for count()
+  // processors.
+  static uint parallel_worker_limit();
+  static uint conc_worker_limit();
+  static int  compiler_thread_limit(bool c1);
+
+  // Clamp an active worker count to the limits above, if engaged
+  static uint limit_parallel_workers(uint workers);
+  static uint limit_conc_workers(uint workers);
+};
+
+#endif // SHARE_VM_RUNTIME_ACTIVEPROCESSORTRACKER_HPP
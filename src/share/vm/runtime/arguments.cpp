@@ -65,6 +65,7 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/compactibleFreeListSpace.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1ParScanThreadState.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
 
@@ -2323,6 +2324,13 @@ bool Arguments::check_vm_args_consistency() {
     status = status && verify_interval(ElasticHeapPeriodicMinYoungCommitPercent, ElasticHeapMinYoungCommitPercent, 100, "ElasticHeapMinYoungCommitPercentAuto");
     PropertyList_unique_add(&_system_properties, "com.alibaba.jvm.gc.ElasticHeapEnabled", (char*)"true");
     status = status && verify_interval(ElasticHeapOldGenReservePercent, 1, 100, "ElasticHeapOldGenReservePercent");
+    status = status && verify_interval(ElasticHeapStandbyPercent, 0, 100, "ElasticHeapStandbyPercent");
+    if (ElasticHeapUncommitAlignment != 0 && !is_power_of_2(ElasticHeapUncommitAlignment)) {
+      jio_fprintf(defaultStream::error_stream(),
+                  "ElasticHeapUncommitAlignment (" UINTX_FORMAT ") must be a power of 2\n",
+                  ElasticHeapUncommitAlignment);
+      status = false;
+    }
 
     if (InitialHeapSize != MaxHeapSize) {
       jio_fprintf(defaultStream::error_stream(),
@@ -2342,6 +2350,62 @@ bool Arguments::check_vm_args_consistency() {
     }
   }
 
+  if (G1SoftMaxHeapSize != 0) {
+    if (!UseG1GC) {
+      vm_exit_during_initialization("G1SoftMaxHeapSize only works with UseG1GC");
+    }
+    if (G1ElasticHeap) {
+      vm_exit_during_initialization("G1SoftMaxHeapSize cannot be used with G1ElasticHeap");
+    }
+    if (G1SoftMaxHeapSize > MaxHeapSize) {
+      jio_fprintf(defaultStream::error_stream(),
+                  "G1SoftMaxHeapSize (" UINTX_FORMAT ") must not be larger than "
+                  "MaxHeapSize (" UINTX_FORMAT ")\n",
+                  G1SoftMaxHeapSize, MaxHeapSize);
+      status = false;
+    }
+  }
+
+  if (G1PeriodicUncommitInterval != 0 && G1SoftMaxHeapSize == 0) {
+    vm_exit_during_initialization("G1PeriodicUncommitInterval only works with G1SoftMaxHeapSize");
+  }
+
+  if (G1MemoryPressurePollInterval != 0) {
+    if (!UseG1GC) {
+      vm_exit_during_initialization("G1MemoryPressurePollInterval only works with UseG1GC");
+    }
+    if (G1ElasticHeap) {
+      vm_exit_during_initialization("G1MemoryPressurePollInterval cannot be used with G1ElasticHeap");
+    }
+  }
+  status = status && verify_interval(G1MemoryPressureThreshold, 1, 100,
+                                     "G1MemoryPressureThreshold");
+  status = status && verify_min_value((intx)AsyncGCLogBufferSize, 4 * K,
+                                      "AsyncGCLogBufferSize");
+  if (GCBinaryEventLog && !AsyncGCLog) {
+    warning("GCBinaryEventLog has no effect without AsyncGCLog");
+  }
+  status = status && verify_interval(JavaThreadPoolKeepAlive, 0, max_jint,
+                                     "JavaThreadPoolKeepAlive");
+
+  if (G1NUMAAware && G1ElasticHeap) {
+    vm_exit_during_initialization("G1NUMAAware cannot be used with G1ElasticHeap, use ElasticHeapNUMAAware");
+  }
+
+  if (G1UseAdaptiveIHOP && G1ElasticHeap) {
+    vm_exit_during_initialization("G1UseAdaptiveIHOP cannot be used with G1ElasticHeap");
+  }
+
+  if (G1UseCardSummary) {
+    status = status && verify_interval(G1CardSummaryBlockSize, 512, 2048, "G1CardSummaryBlockSize");
+    if (!is_power_of_2(G1CardSummaryBlockSize)) {
+      jio_fprintf(defaultStream::error_stream(),
+                  "G1CardSummaryBlockSize (" UINTX_FORMAT ") must be a power of 2\n",
+                  G1CardSummaryBlockSize);
+      status = false;
+    }
+  }
+
   // Allow both -XX:-UseStackBanging and -XX:-UseBoundThreads in non-product
   // builds so the cost of stack banging can be measured.
 #if (defined(PRODUCT) && defined(SOLARIS))
@@ -2507,6 +2571,12 @@ bool Arguments::check_vm_args_consistency() {
                                        "G1ConcRSLogCacheSize");
     status = status && verify_interval(StringDeduplicationAgeThreshold, 1, markOopDesc::max_age,
                                        "StringDeduplicationAgeThreshold");
+    status = status && verify_interval(StringDeduplicationMinHitPercent, 0, 100,
+                                       "StringDeduplicationMinHitPercent");
+    status = status && verify_interval(G1EvacPrefetchBatchSize, 0, G1ParScanThreadState::MaxEvacPrefetchBatchSize,
+                                       "G1EvacPrefetchBatchSize");
+    status = status && verify_interval(G1ConcRefinementMaxCPUPercent, 1, 100,
+                                       "G1ConcRefinementMaxCPUPercent");
   }
   if (UseConcMarkSweepGC) {
     status = status && verify_min_value(CMSOldPLABNumRefills, 1, "CMSOldPLABNumRefills");
@@ -2611,6 +2681,13 @@ bool Arguments::check_vm_args_consistency() {
   status = status && verify_min_value(MarkSweepAlwaysCompactCount, 1, "MarkSweepAlwaysCompactCount");
 #ifdef COMPILER1
   status = status && verify_min_value(ValueMapInitialSize, 1, "ValueMapInitialSize");
+  status = status && verify_interval(C1ProfileSampleInterval, 1, 1024, "C1ProfileSampleInterval");
+  if (!is_power_of_2(C1ProfileSampleInterval)) {
+    jio_fprintf(defaultStream::error_stream(),
+                "C1ProfileSampleInterval (" INTX_FORMAT ") must be a power of 2\n",
+                C1ProfileSampleInterval);
+    status = false;
+  }
 #endif
 
   if (PrintNMTStatistics) {
@@ -3747,6 +3824,16 @@ jint Arguments::finalize_vm_init_args(SysClassPath* scp_p, bool scp_assembly_req
     }
   }
 
+  // Keep reflective calls on the VM invoker: never inflate them into a
+  // generated accessor class, unless the user asked for inflation.
+  if (UseVMReflectionInvoker &&
+      Arguments::get_property("sun.reflect.noInflation") == NULL &&
+      Arguments::get_property("sun.reflect.inflationThreshold") == NULL) {
+    if (!add_property("sun.reflect.inflationThreshold=2147483647")) {
+      return JNI_ENOMEM;
+    }
+  }
+
   if (!check_vm_args_consistency()) {
     return JNI_ERR;
   }
@@ -4134,12 +4221,113 @@ jint Arguments::parse(const JavaVMInitArgs* args) {
     }
   }
 
+  if (WispMonitorHandoff && !UseWispMonitor) {
+    if (FLAG_IS_CMDLINE(WispMonitorHandoff)) {
+      warning("WispMonitorHandoff requires -XX:+UseWispMonitor; disabling it");
+    }
+    FLAG_SET_DEFAULT(WispMonitorHandoff, false);
+  }
+
+  if (EnableCoroutine && CoroutineRootsChunkSize == 0) {
+    warning("CoroutineRootsChunkSize must be greater than 0; setting it to 1");
+    FLAG_SET_DEFAULT(CoroutineRootsChunkSize, 1);
+  }
+
 #if !(defined(LINUX) && (defined(AMD64) || (defined(AARCH64))))
   if (EnableCoroutine || UseWispMonitor) {
     vm_exit_during_initialization("Wisp only works on Linux x64 platform for now");
   }
 #endif
 
+#if !defined(X86) || !defined(_LP64) || defined(CC_INTERP)
+  if (JvmtiSelectiveMethodTrace) {
+    warning("JvmtiSelectiveMethodTrace is only supported on x86_64; disabling it");
+    FLAG_SET_DEFAULT(JvmtiSelectiveMethodTrace, false);
+  }
+#endif
+
+  if (UseLightweightLocking) {
+#if !defined(X86) || !defined(_LP64) || defined(CC_INTERP)
+    warning("UseLightweightLocking is only supported on x86_64; disabling it");
+    FLAG_SET_DEFAULT(UseLightweightLocking, false);
+#else
+    if (EnableCoroutine || UseWispMonitor) {
+      // Coroutines switch on a carrier thread but the lock stack belongs
+      // to the JavaThread.
+      warning("UseLightweightLocking is not supported with Wisp; disabling it");
+      FLAG_SET_DEFAULT(UseLightweightLocking, false);
+    } else {
+      if (UseBiasedLocking) {
+        if (FLAG_IS_CMDLINE(UseBiasedLocking)) {
+          warning("Biased locking is not supported with UseLightweightLocking"
+                  "; ignoring UseBiasedLocking flag." );
+        }
+        FLAG_SET_DEFAULT(UseBiasedLocking, false);
+      }
+#if INCLUDE_RTM_OPT
+      if (UseRTMLocking) {
+        warning("RTM locking is not supported with UseLightweightLocking; disabling it");
+        FLAG_SET_DEFAULT(UseRTMLocking, false);
+      }
+#endif
+    }
+#endif
+  }
+
+  if (InterpreterProfileMinRate > 0) {
+#ifdef TIERED
+    if (TieredCompilation) {
+      // The tiered policy decides on MethodData creation itself
+      warning("InterpreterProfileMinRate has no effect with TieredCompilation");
+    }
+#else
+    warning("InterpreterProfileMinRate is not supported in this VM; disabling it");
+    FLAG_SET_DEFAULT(InterpreterProfileMinRate, 0);
+#endif
+  }
+
+  if (AsyncDeflateIdleMonitors) {
+    if (EnableCoroutine || UseWispMonitor) {
+      warning("AsyncDeflateIdleMonitors is not supported with Wisp; disabling it");
+      FLAG_SET_DEFAULT(AsyncDeflateIdleMonitors, false);
+    } else if (MonitorInUseLists) {
+      // The async deflater keeps its own global in-use list
+      if (FLAG_IS_CMDLINE(MonitorInUseLists)) {
+        warning("MonitorInUseLists is ignored with AsyncDeflateIdleMonitors");
+      }
+      FLAG_SET_DEFAULT(MonitorInUseLists, false);
+    }
+  }
+
+#if !defined(AMD64) || !defined(COMPILER2)
+  if (CompiledCodeCacheFile != NULL) {
+    // Relocations are only bound to a new VM for x86_64 code
+    warning("CompiledCodeCacheFile is only supported on x86_64 with C2; ignoring it");
+    FLAG_SET_DEFAULT(CompiledCodeCacheFile, NULL);
+  }
+#endif
+
+#ifndef AMD64
+  if (ThreadLocalSafepointPolls) {
+    warning("ThreadLocalSafepointPolls is only supported on x86_64; disabling it");
+    FLAG_SET_DEFAULT(ThreadLocalSafepointPolls, false);
+  }
+#endif
+
+#ifndef LINUX
+  if (UseLargeCodePages) {
+    warning("UseLargeCodePages is only supported on Linux; disabling it");
+    FLAG_SET_DEFAULT(UseLargeCodePages, false);
+  }
+#endif
+
+#if !(defined(AMD64) || defined(IA32))
+  if (UseSecondarySupersTable) {
+    warning("UseSecondarySupersTable is only supported on x86; disabling it");
+    FLAG_SET_DEFAULT(UseSecondarySupersTable, false);
+  }
+#endif
+
   // Set object alignment values.
   set_object_alignment();
 
@@ -4259,6 +4447,15 @@ jint Arguments::apply_ergo() {
     // nothing to use the profiling, turn if off
     FLAG_SET_DEFAULT(TypeProfileLevel, 0);
   }
+  if (UsePolymorphicInlining && FLAG_IS_DEFAULT(TypeProfileWidth) &&
+      TypeProfileWidth < PolymorphicInlineLimit) {
+    // record enough receiver rows to find all the receivers to inline
+    FLAG_SET_DEFAULT(TypeProfileWidth, PolymorphicInlineLimit);
+  }
+  if (LoopStripMiningIter > 1 && FLAG_IS_DEFAULT(UseCountedLoopSafepoints)) {
+    // strip mined loops keep their safepoint in the outer loop
+    FLAG_SET_DEFAULT(UseCountedLoopSafepoints, true);
+  }
 #endif
 
   if (PrintAssembly && FLAG_IS_DEFAULT(DebugNonSafepoints)) {
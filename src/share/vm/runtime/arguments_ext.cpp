@@ -27,12 +27,22 @@
 void ArgumentsExt::set_tenant_flags() {
   // order is critical here, please be careful
 #if !(defined(LINUX) && defined(AMD64))
-  if (TenantCpuThrottling || TenantCpuAccounting
-      || TenantHeapIsolation || TenantHeapThrottling || MultiTenant) {
+  if (TenantCpuThrottling || TenantCpuAccounting || TenantFairCollectionSet
+      || TenantHeapIsolation || TenantHeapThrottling || TenantCpuBudgeting || MultiTenant) {
     vm_exit_during_initialization("MultiTenant only works on Linux x64 platform");
   }
 #endif
 
+  // TenantHeapByteAccounting changes how TenantHeapThrottling measures usage
+  if (TenantHeapByteAccounting && !TenantHeapThrottling) {
+    vm_exit_during_initialization("-XX:+TenantHeapByteAccounting only works with -XX:+TenantHeapThrottling");
+  }
+
+  // TenantFairCollectionSet depends on TenantHeapThrottling for the heap limits
+  if (TenantFairCollectionSet && !TenantHeapThrottling) {
+    vm_exit_during_initialization("-XX:+TenantFairCollectionSet only works with -XX:+TenantHeapThrottling");
+  }
+
   // TenantHeapThrottling directly depends on TenantHeapIsolation
   if (TenantHeapThrottling) {
     if (FLAG_IS_DEFAULT(TenantHeapIsolation)) {
@@ -62,6 +72,16 @@ void ArgumentsExt::set_tenant_flags() {
     }
   }
 
+  // TenantCpuBudgeting accounts at Wisp coroutine switches
+  if (TenantCpuBudgeting) {
+    if (!MultiTenant || !EnableCoroutine) {
+      vm_exit_during_initialization("-XX:+TenantCpuBudgeting only works with -XX:+MultiTenant and -XX:+EnableCoroutine");
+    }
+    if (TenantCpuBudgetPeriod == 0) {
+      vm_exit_during_initialization("TenantCpuBudgetPeriod must be positive");
+    }
+  }
+
   // UsePerTenantTLAB depends on TenantHeapIsolation and UseTLAB
   if (UsePerTenantTLAB) {
     if (!TenantHeapIsolation || !UseTLAB) {
@@ -69,3 +89,43 @@ void ArgumentsExt::set_tenant_flags() {
     }
   }
 }
+
+void ArgumentsExt::set_object_profiler_flags() {
+#ifdef COMPILER1
+  // C1's inline TLAB refill retires the TLAB at end(), which may be an
+  // allocation sample point short of the real end of the buffer.
+  if (ObjectProfilerSampleBytes > 0) {
+    FastTLABRefill = false;
+  }
+#endif
+}
+
+void ArgumentsExt::set_active_processor_tracking_flags() {
+  if (ActiveProcessorCountPollInterval == 0) {
+    return;
+  }
+  // Thread pools are sized at startup; following the processor count
+  // means running fewer of their threads than were created.
+  if (FLAG_IS_DEFAULT(UseDynamicNumberOfGCThreads)) {
+    FLAG_SET_ERGO(bool, UseDynamicNumberOfGCThreads, true);
+  }
+  if (FLAG_IS_DEFAULT(UseDynamicNumberOfCompilerThreads)) {
+    FLAG_SET_ERGO(bool, UseDynamicNumberOfCompilerThreads, true);
+  }
+}
+
+void ArgumentsExt::set_tlab_flags() {
+  if (!TLABFastResize) {
+    return;
+  }
+  if (!ResizeTLAB) {
+    warning("TLABFastResize has no effect without ResizeTLAB");
+    FLAG_SET_DEFAULT(TLABFastResize, false);
+    return;
+  }
+#ifdef COMPILER1
+  // C1's inline TLAB refill bypasses ThreadLocalAllocBuffer::fill(),
+  // where the refill rate is checked.
+  FastTLABRefill = false;
+#endif
+}
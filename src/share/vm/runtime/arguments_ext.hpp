@@ -31,6 +31,9 @@
 class ArgumentsExt: AllStatic {
 private:
   static        void set_tenant_flags();
+  static        void set_object_profiler_flags();
+  static        void set_active_processor_tracking_flags();
+  static        void set_tlab_flags();
 public:
   static inline void set_gc_specific_flags();
   static        void process_options(const JavaVMInitArgs* args) {}
@@ -40,6 +43,9 @@ void ArgumentsExt::set_gc_specific_flags() {
   Arguments::set_gc_specific_flags();
 
   set_tenant_flags();
+  set_object_profiler_flags();
+  set_active_processor_tracking_flags();
+  set_tlab_flags();
 }
 
 #endif // SHARE_VM_RUNTIME_ARGUMENTS_EXT_HPP
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
+#include "runtime/java.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+AsyncGCLogWriter* AsyncGCLogWriter::_instance = NULL;
+
+AsyncGCLogWriter::AsyncGCLogWriter(gcLogFileStream* stream) :
+  _stream(stream),
+  _pos(0),
+  _text_entry(NoTextEntry),
+  _dropped(0),
+  _should_terminate(false) {
+  set_name("Async GC Log Writer");
+  // Ranked below the leaf locks threads may hold while they log.
+  _buffer_lock = new Monitor(Mutex::leaf - 1, "AsyncGCLogBuffer_lock", true);
+  // Held while taking the log file lock, which is a leaf lock.
+  _io_lock = new Mutex(Mutex::leaf + 1, "AsyncGCLogIO_lock", true);
+  _buffer = NEW_C_HEAP_ARRAY(char, AsyncGCLogBufferSize, mtInternal);
+  _io_buffer = NEW_C_HEAP_ARRAY(char, AsyncGCLogBufferSize, mtInternal);
+}
+
+void AsyncGCLogWriter::initialize() {
+  if (!AsyncGCLog || Arguments::gc_log_filename() == NULL ||
+      !gclog_or_tty->is_open()) {
+    return;
+  }
+  AsyncGCLogWriter* writer = new AsyncGCLogWriter((gcLogFileStream*)gclog_or_tty);
+  if (!os::create_thread(writer, os::os_thread)) {
+    // Keep writing synchronously.
+    warning("Cannot create the asynchronous GC log writer thread");
+    return;
+  }
+  _instance = writer;
+  os::start_thread(writer);
+}
+
+void AsyncGCLogWriter::run() {
+  this->record_stack_base_and_size();
+  this->initialize_thread_local_storage();
+  this->set_native_thread_name(this->name());
+  while (true) {
+    {
+      MonitorLockerEx ml(_buffer_lock, Mutex::_no_safepoint_check_flag);
+      while (_pos == 0 && _dropped == 0 && !_should_terminate) {
+        ml.wait(Mutex::_no_safepoint_check_flag);
+      }
+      if (_should_terminate) {
+        break;
+      }
+    }
+    write_pending();
+  }
+}
+
+void AsyncGCLogWriter::write_pending() {
+  MutexLockerEx iol(_io_lock, Mutex::_no_safepoint_check_flag);
+  size_t len;
+  size_t dropped;
+  {
+    MutexLockerEx ml(_buffer_lock, Mutex::_no_safepoint_check_flag);
+    char* tmp = _buffer;
+    _buffer = _io_buffer;
+    _io_buffer = tmp;
+    len = _pos;
+    dropped = _dropped;
+    _pos = 0;
+    _text_entry = NoTextEntry;
+    _dropped = 0;
+  }
+  ResourceMark rm;
+  stringStream records;
+  size_t pos = 0;
+  while (pos < len) {
+    EntryHeader header;
+    memcpy(&header, _io_buffer + pos, sizeof(header));
+    pos += sizeof(header);
+    if (header.formatter != NULL) {
+      header.formatter(_io_buffer + pos, &records);
+    } else {
+      if (records.size() > 0) {
+        _stream->write_formatted(records.base(), records.size());
+        records.reset();
+      }
+      _stream->write_blocking(_io_buffer + pos, header.len);
+    }
+    pos += header.len;
+  }
+  if (records.size() > 0) {
+    _stream->write_formatted(records.base(), records.size());
+  }
+  if (dropped > 0) {
+    char msg[128];
+    jio_snprintf(msg, sizeof(msg), "[" SIZE_FORMAT " bytes of GC log dropped: "
+                 "AsyncGCLogBufferSize is too small]\n", dropped);
+    _stream->write_blocking(msg, strlen(msg));
+  }
+}
+
+bool AsyncGCLogWriter::enqueue(const char* s, size_t len) {
+  AsyncGCLogWriter* writer = _instance;
+  if (writer == NULL || writer->_should_terminate) {
+    return false;
+  }
+  MonitorLockerEx ml(writer->_buffer_lock, Mutex::_no_safepoint_check_flag);
+  if (writer->_should_terminate) {
+    return false;
+  }
+  // Consecutive text goes into one entry.
+  bool new_entry = writer->_text_entry == NoTextEntry;
+  size_t needed = len + (new_entry ? sizeof(EntryHeader) : 0);
+  if (writer->_pos + needed > AsyncGCLogBufferSize) {
+    writer->_dropped += len;
+  } else {
+    if (writer->_pos == 0) {
+      ml.notify();
+    }
+    EntryHeader header;
+    if (new_entry) {
+      writer->_text_entry = writer->_pos;
+      writer->_pos += sizeof(header);
+      header.len = 0;
+      header.formatter = NULL;
+    } else {
+      memcpy(&header, writer->_buffer + writer->_text_entry, sizeof(header));
+    }
+    memcpy(writer->_buffer + writer->_pos, s, len);
+    writer->_pos += len;
+    header.len += len;
+    memcpy(writer->_buffer + writer->_text_entry, &header, sizeof(header));
+  }
+  return true;
+}
+
+bool AsyncGCLogWriter::enqueue_record(RecordFormatter formatter, const void* record, size_t len) {
+  assert(formatter != NULL, "text is enqueued with enqueue()");
+  AsyncGCLogWriter* writer = _instance;
+  if (writer == NULL || writer->_should_terminate) {
+    return false;
+  }
+  MonitorLockerEx ml(writer->_buffer_lock, Mutex::_no_safepoint_check_flag);
+  if (writer->_should_terminate) {
+    return false;
+  }
+  EntryHeader header;
+  if (writer->_pos + sizeof(header) + len > AsyncGCLogBufferSize) {
+    writer->_dropped += len;
+  } else {
+    if (writer->_pos == 0) {
+      ml.notify();
+    }
+    header.len = len;
+    header.formatter = formatter;
+    memcpy(writer->_buffer + writer->_pos, &header, sizeof(header));
+    memcpy(writer->_buffer + writer->_pos + sizeof(header), record, len);
+    writer->_pos += sizeof(header) + len;
+    writer->_text_entry = NoTextEntry;
+  }
+  return true;
+}
+
+void AsyncGCLogWriter::flush() {
+  if (_instance != NULL) {
+    _instance->write_pending();
+  }
+}
+
+void AsyncGCLogWriter::stop() {
+  AsyncGCLogWriter* writer = _instance;
+  if (writer == NULL) {
+    return;
+  }
+  {
+    MonitorLockerEx ml(writer->_buffer_lock, Mutex::_no_safepoint_check_flag);
+    writer->_should_terminate = true;
+    ml.notify();
+  }
+  // Later writes go straight to the file; write out the rest before them.
+  writer->write_pending();
+}
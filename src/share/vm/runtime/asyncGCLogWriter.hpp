@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
+#define SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
+
+#include "runtime/thread.hpp"
+
+class gcLogFileStream;
+class outputStream;
+
+// AsyncGCLogWriter takes the -Xloggc file I/O off the threads that log.
+// With AsyncGCLog, gcLogFileStream::write() only copies the text into an
+// in-memory buffer of AsyncGCLogBufferSize bytes; this thread writes the
+// buffer to the file. A thread that logs holds the buffer lock just for the
+// copy, so a slow disk can no longer stall a safepoint. Text that does not
+// fit into a full buffer is dropped and the number of dropped bytes is
+// written to the log once there is room again.
+//
+// Besides text, the buffer holds fixed-layout records (see GCEventLog) that
+// this thread formats when it writes them out, in the order they were
+// logged relative to the text.
+class AsyncGCLogWriter : public NamedThread {
+ public:
+  // Appends the text of a record to st.
+  typedef void (*RecordFormatter)(const void* record, outputStream* st);
+
+ private:
+  static AsyncGCLogWriter* _instance;
+
+  // The buffer is a sequence of entries, each an EntryHeader followed by
+  // len bytes of text or record. Headers are not aligned.
+  struct EntryHeader {
+    size_t          len;
+    RecordFormatter formatter;  // NULL for text
+  };
+  static const size_t NoTextEntry = (size_t)-1;
+
+  gcLogFileStream* const _stream;
+  Monitor* _buffer_lock;      // protects the buffer being filled
+  Mutex*   _io_lock;          // serializes writing out the other buffer
+  char*    _buffer;           // being filled by logging threads
+  char*    _io_buffer;        // being written out
+  size_t   _pos;
+  size_t   _text_entry;       // offset of the last entry if it is text
+  size_t   _dropped;
+  volatile bool _should_terminate;
+
+  AsyncGCLogWriter(gcLogFileStream* stream);
+
+  // Swap the buffers and write out what was logged so far.
+  void write_pending();
+
+ public:
+  virtual void run();
+
+  // Start the writer thread if AsyncGCLog is set and -Xloggc is used.
+  static void initialize();
+  // Write out what is buffered and go back to synchronous writes.
+  static void stop();
+
+  // Buffer the text; false if the writer is not running and the caller
+  // has to write the text itself.
+  static bool enqueue(const char* s, size_t len);
+  // Buffer a record of len bytes that the writer formats with formatter;
+  // false if the writer is not running.
+  static bool enqueue_record(RecordFormatter formatter, const void* record, size_t len);
+  // Write out what is buffered on the calling thread.
+  static void flush();
+
+  static bool is_running() {
+    return _instance != NULL && !_instance->_should_terminate;
+  }
+};
+
+#endif // SHARE_VM_RUNTIME_ASYNCGCLOGWRITER_HPP
@@ -61,8 +61,11 @@ void BasicLock::move_to(oop obj, BasicLock* dest) {
   // There are some subtle concurrency issues, however, and since the benefit is
   // is small (given the support for inflated fast-path locking in the fast_lock, etc)
   // we'll leave that optimization for another time.
+  //
+  // With UseLightweightLocking the lock lives on the thread's lock stack
+  // and the BasicLock holds nothing, so it moves without inflating.
 
-  if (displaced_header()->is_neutral()) {
+  if (!UseLightweightLocking && displaced_header()->is_neutral()) {
     ObjectSynchronizer::inflate_helper(obj);
     // WARNING: We can not put check here, because the inflation
     // will not update the displaced header. Once BasicLock is inflated,
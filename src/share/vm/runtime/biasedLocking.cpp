@@ -27,6 +27,7 @@
 #include "oops/markOop.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -275,6 +276,23 @@ enum HeuristicsResult {
 };
 
 
+// Bulk thresholds of k. With BiasedLockingAdaptiveThresholds both are
+// halved per recent bulk rebias of k, keeping revoke above rebias.
+static int bulk_rebias_threshold(Klass* k) {
+  if (!BiasedLockingAdaptiveThresholds) {
+    return BiasedLockingBulkRebiasThreshold;
+  }
+  return (int)(BiasedLockingBulkRebiasThreshold >> MIN2(k->biased_lock_bulk_rebias_count(), BitsPerInt - 1));
+}
+
+static int bulk_revoke_threshold(Klass* k) {
+  if (!BiasedLockingAdaptiveThresholds) {
+    return BiasedLockingBulkRevokeThreshold;
+  }
+  int threshold = (int)(BiasedLockingBulkRevokeThreshold >> MIN2(k->biased_lock_bulk_rebias_count(), BitsPerInt - 1));
+  return MAX2(threshold, bulk_rebias_threshold(k) + 1);
+}
+
 static HeuristicsResult update_heuristics(oop o, bool allow_rebias) {
   markOop mark = o->mark();
   if (!mark->has_bias_pattern()) {
@@ -291,9 +309,27 @@ static HeuristicsResult update_heuristics(oop o, bool allow_rebias) {
   Klass* k = o->klass();
   jlong cur_time = os::javaTimeMillis();
   jlong last_bulk_revocation_time = k->last_biased_lock_bulk_revocation_time();
+
+  if (BiasedLockingAdaptiveThresholds && k->biased_lock_bulk_rebias_count() > 0 &&
+      last_bulk_revocation_time != 0) {
+    // The class has been quiet for a while: give back one halving of the
+    // thresholds per decay period. Moving the timestamp along keeps racing
+    // threads from applying the same periods twice.
+    jlong period = 4 * (jlong)BiasedLockingDecayTime;
+    jlong periods = (cur_time - last_bulk_revocation_time) / period;
+    if (periods > 0) {
+      int count = k->biased_lock_bulk_rebias_count();
+      k->set_biased_lock_bulk_rebias_count((int)MAX2((jlong)0, count - periods));
+      last_bulk_revocation_time += periods * period;
+      k->set_last_biased_lock_bulk_revocation_time(last_bulk_revocation_time);
+    }
+  }
+
+  int rebias_threshold = bulk_rebias_threshold(k);
+  int revoke_threshold = bulk_revoke_threshold(k);
   int revocation_count = k->biased_lock_revocation_count();
-  if ((revocation_count >= BiasedLockingBulkRebiasThreshold) &&
-      (revocation_count <  BiasedLockingBulkRevokeThreshold) &&
+  if ((revocation_count >= rebias_threshold) &&
+      (revocation_count <  revoke_threshold) &&
       (last_bulk_revocation_time != 0) &&
       (cur_time - last_bulk_revocation_time >= BiasedLockingDecayTime)) {
     // This is the first revocation we've seen in a while of an
@@ -311,16 +347,21 @@ static HeuristicsResult update_heuristics(oop o, bool allow_rebias) {
     revocation_count = 0;
   }
 
-  // Make revocation count saturate just beyond BiasedLockingBulkRevokeThreshold
-  if (revocation_count <= BiasedLockingBulkRevokeThreshold) {
+  // Make revocation count saturate just beyond the bulk revoke threshold
+  if (revocation_count <= revoke_threshold) {
     revocation_count = k->atomic_incr_biased_lock_revocation_count();
   }
 
-  if (revocation_count == BiasedLockingBulkRevokeThreshold) {
+  if (revocation_count == revoke_threshold) {
     return HR_BULK_REVOKE;
   }
 
-  if (revocation_count == BiasedLockingBulkRebiasThreshold) {
+  if (revocation_count == rebias_threshold) {
+    if (BiasedLockingAdaptiveThresholds &&
+        (BiasedLockingBulkRebiasThreshold >> MIN2(k->biased_lock_bulk_rebias_count() + 1, BitsPerInt - 1)) == 0) {
+      // Rebiasing has not helped this class, stop biasing it
+      return HR_BULK_REVOKE;
+    }
     return HR_BULK_REBIAS;
   }
 
@@ -344,6 +385,15 @@ static BiasedLocking::Condition bulk_revoke_or_rebias_at_safepoint(oop o,
   jlong cur_time = os::javaTimeMillis();
   o->klass()->set_last_biased_lock_bulk_revocation_time(cur_time);
 
+  if (bulk_rebias && BiasedLockingAdaptiveThresholds) {
+    // Lower the thresholds of the class and restart its count at the new
+    // rebias threshold, so the next bulk revoke comes after fewer
+    // revocations than the previous one
+    Klass* k = o->klass();
+    k->set_biased_lock_bulk_rebias_count(k->biased_lock_bulk_rebias_count() + 1);
+    k->set_biased_lock_revocation_count(bulk_rebias_threshold(k));
+  }
+
 
   Klass* k_o = o->klass();
   Klass* klass = k_o;
@@ -551,6 +601,68 @@ public:
 };
 
 
+// Revokes the bias of a single object while only the thread toward
+// which it is biased is stopped. Only the biased locker's stack is
+// walked, so no other thread has to reach a safepoint.
+class RevokeOneBias : public HandshakeClosure {
+private:
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  markOop _expected_mark;
+  bool _executed;
+  BiasedLocking::Condition _status_code;
+  traceid _biased_locker_id;
+
+public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, markOop expected_mark)
+    : HandshakeClosure("RevokeOneBias")
+    , _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _expected_mark(expected_mark)
+    , _executed(false)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _biased_locker_id(0) {}
+
+  void do_thread(Thread* target) {
+    oop o = _obj();
+    markOop mark = o->mark();
+    markOop prototype_header = o->klass()->prototype_header();
+    // The bias may have been revoked or expired since it was sampled;
+    // leave those cases to the safepoint operation.
+    if (mark != _expected_mark ||
+        !prototype_header->has_bias_pattern() ||
+        prototype_header->bias_epoch() != mark->bias_epoch()) {
+      return;
+    }
+    assert(mark->biased_locker() == target, "handshaking with the wrong thread");
+
+    if (TraceBiasedLocking) {
+      tty->print_cr("Revoking bias with handshake:");
+    }
+    ResourceMark rm;
+    JavaThread* biased_locker = NULL;
+    _status_code = revoke_bias(o, false, false, _requesting_thread, &biased_locker);
+#if INCLUDE_JFR
+    if (biased_locker != NULL) {
+      _biased_locker_id = JFR_THREAD_ID(biased_locker);
+    }
+#endif // INCLUDE_JFR
+    ((JavaThread*) target)->set_cached_monitor_info(NULL);
+    _executed = true;
+  }
+
+  bool executed() const { return _executed; }
+
+  BiasedLocking::Condition status_code() const {
+    return _status_code;
+  }
+
+  traceid biased_locker() const {
+    return _biased_locker_id;
+  }
+};
+
+
 BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attempt_rebias, TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "must not be called while at safepoint");
 
@@ -640,11 +752,26 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       assert(cond == BIAS_REVOKED, "why not?");
       if (event.should_commit()) {
         event.set_lockClass(k);
+        event.set_revocationCount(k->biased_lock_revocation_count());
         event.commit();
       }
       return cond;
     } else {
       EventBiasedLockRevocation event;
+      JavaThread* biased_locker = mark->biased_locker();
+      if (ThreadLocalHandshakes && biased_locker != NULL &&
+          prototype_header->bias_epoch() == mark->bias_epoch()) {
+        RevokeOneBias revoke(obj, (JavaThread*) THREAD, mark);
+        if (Handshake::try_execute(&revoke, biased_locker) && revoke.executed()) {
+          if (event.should_commit() && (revoke.status_code() != NOT_BIASED)) {
+            event.set_lockClass(k);
+            event.set_previousOwner(revoke.biased_locker());
+            event.set_revocationCount(k->biased_lock_revocation_count());
+            event.commit();
+          }
+          return revoke.status_code();
+        }
+      }
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       if (event.should_commit() && (revoke.status_code() != NOT_BIASED)) {
@@ -652,6 +779,7 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
         // Subtract 1 to match the id of events committed inside the safepoint
         event.set_safepointId(SafepointSynchronize::safepoint_counter() - 1);
         event.set_previousOwner(revoke.biased_locker());
+        event.set_revocationCount(k->biased_lock_revocation_count());
         event.commit();
       }
       return revoke.status_code();
@@ -668,6 +796,7 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
   if (event.should_commit()) {
     event.set_revokedClass(obj->klass());
     event.set_disableBiasing((heuristics != HR_BULK_REBIAS));
+    event.set_bulkRebiasCount(obj->klass()->biased_lock_bulk_rebias_count());
     // Subtract 1 to match the id of events committed inside the safepoint
     event.set_safepointId(SafepointSynchronize::safepoint_counter() - 1);
     event.commit();
@@ -717,6 +846,32 @@ void BiasedLocking::revoke_at_safepoint(GrowableArray<Handle>* objs) {
 }
 
 
+void BiasedLocking::revoke_at_handshake(GrowableArray<Handle>* objs, JavaThread* target) {
+  assert(target->has_handshake_pending(), "must only be called during a handshake");
+  int len = objs->length();
+  for (int i = 0; i < len; i++) {
+    oop obj = (objs->at(i))();
+    markOop mark = obj->mark();
+    if (!mark->has_bias_pattern()) {
+      continue;
+    }
+    markOop prototype_header = obj->klass()->prototype_header();
+    if (mark->biased_locker() == target &&
+        prototype_header->has_bias_pattern() &&
+        prototype_header->bias_epoch() == mark->bias_epoch()) {
+      // Only target can change a valid bias toward it, and it is stopped.
+      revoke_bias(obj, false, false, NULL, NULL);
+    } else {
+      // Anonymous or expired bias, which other threads may race for
+      // with a CAS; clear it with a CAS as revoke_and_rebias does.
+      markOop unbiased_prototype = markOopDesc::prototype()->set_age(mark->age());
+      Atomic::cmpxchg_ptr(unbiased_prototype, obj->mark_addr(), mark);
+    }
+  }
+  target->set_cached_monitor_info(NULL);
+}
+
+
 void BiasedLocking::preserve_marks() {
   if (!UseBiasedLocking)
     return;
@@ -181,6 +181,9 @@ public:
   static void revoke(GrowableArray<Handle>* objs);
   static void revoke_at_safepoint(Handle obj);
   static void revoke_at_safepoint(GrowableArray<Handle>* objs);
+  // Revokes the biases of objects locked by target while it is stopped
+  // for a handshake
+  static void revoke_at_handshake(GrowableArray<Handle>* objs, JavaThread* target);
 
   static void print_counters() { _counters.print(); }
   static BiasedLockingCounters* counters() { return &_counters; }
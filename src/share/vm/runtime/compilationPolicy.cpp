@@ -23,14 +23,17 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderData.hpp"
 #include "code/compiledIC.hpp"
 #include "code/nmethod.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/interpreter.hpp"
+#include "memory/metadataFactory.hpp"
 #include "oops/methodData.hpp"
 #include "oops/method.hpp"
 #include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
 #include "prims/nativeLookup.hpp"
 #include "runtime/advancedThresholdPolicy.hpp"
 #include "runtime/compilationPolicy.hpp"
@@ -114,6 +117,8 @@ bool CompilationPolicy::can_be_compiled(methodHandle m, int comp_level) {
 
   if (m->is_abstract()) return false;
   if (DontCompileHugeMethods && m->code_size() > HugeMethodLimit) return false;
+  // Methods selected for JVMTI method tracing run interpreted while traced
+  if (m->is_jvmti_traced() && JvmtiExport::should_post_traced_method_events()) return false;
 
   // Math intrinsics should never be compiled as this can lead to
   // monotonicity problems because the interpreter will prefer the
@@ -290,6 +295,93 @@ void CounterDecay::decay() {
   }
 }
 
+//
+// ColdCounterReclaim
+//
+// Frees the MethodCounters of classes none of whose methods got warm. The
+// interpreter reloads Method::_method_counters on every use and allocates
+// them again on the next invocation, and the freed blocks go back to the
+// loader's metaspace free list where the next MethodCounters of that loader
+// are carved from. Counters that compiled code may refer to are pinned
+// (see ciMethod::ensure_method_counters) and keep the whole class alive.
+//
+class ColdCounterReclaim : public AllStatic {
+  static jlong _last_timestamp;
+  static int   _freed;
+
+  static bool is_cold(Method* m) {
+    MethodCounters* mcs = m->method_counters();
+    if (mcs == NULL) {
+      return true;
+    }
+    if (mcs->is_pinned() || mcs->number_of_breakpoints() != 0 ||
+        m->method_data() != NULL || m->code() != NULL ||
+        mcs->highest_comp_level() != CompLevel_none ||
+        mcs->highest_osr_comp_level() != CompLevel_none) {
+      return false;
+    }
+    uint count = mcs->invocation_counter()->count() + mcs->backedge_counter()->count();
+    return count < ColdMethodCountersThreshold;
+  }
+
+  static void do_klass(Klass* k) {
+    if (!k->oop_is_instance()) {
+      return;
+    }
+    InstanceKlass* ik = InstanceKlass::cast(k);
+    if (!ik->is_linked() || ik->osr_nmethods_head() != NULL) {
+      return;
+    }
+    Array<Method*>* methods = ik->methods();
+    for (int i = 0; i < methods->length(); i++) {
+      if (!is_cold(methods->at(i))) {
+        return;
+      }
+    }
+    ClassLoaderData* loader_data = ik->class_loader_data();
+    for (int i = 0; i < methods->length(); i++) {
+      Method* m = methods->at(i);
+      MethodCounters* mcs = m->method_counters();
+      if (mcs != NULL) {
+        m->clear_method_counters();
+        MetadataFactory::free_metadata(loader_data, mcs);
+        _freed++;
+      }
+    }
+  }
+
+public:
+  static bool is_reclaim_needed() {
+    return ReclaimColdMethodCountersInterval > 0 &&
+           (os::javaTimeMillis() - _last_timestamp) > (jlong)ReclaimColdMethodCountersInterval;
+  }
+  static void reclaim();
+};
+
+jlong ColdCounterReclaim::_last_timestamp = 0;
+int   ColdCounterReclaim::_freed = 0;
+
+void ColdCounterReclaim::reclaim() {
+  assert(SafepointSynchronize::is_at_safepoint(), "can only be executed at a safepoint");
+  if (_last_timestamp == 0) {
+    // The first interval starts with the VM, classes are not cold yet
+    _last_timestamp = os::javaTimeMillis();
+    return;
+  }
+  _freed = 0;
+  ClassLoaderDataGraph::classes_do(do_klass);
+  _last_timestamp = os::javaTimeMillis();
+  if (PrintCompilation && Verbose && _freed > 0) {
+    tty->print_cr("Freed %d cold MethodCounters", _freed);
+  }
+}
+
+void CompilationPolicy::reclaim_cold_method_counters() {
+  if (ColdCounterReclaim::is_reclaim_needed()) {
+    ColdCounterReclaim::reclaim();
+  }
+}
+
 // Called at the end of the safepoint
 void NonTieredCompPolicy::do_safepoint_work() {
   if(UseCounterDecay && CounterDecay::is_decay_needed()) {
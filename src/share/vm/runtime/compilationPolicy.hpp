@@ -57,6 +57,9 @@ public:
   static bool is_compilation_enabled();
   static void set_policy(CompilationPolicy* policy) { _policy = policy; }
   static CompilationPolicy* policy()                { return _policy; }
+  // Free the MethodCounters of classes that stayed cold, at most once
+  // every ReclaimColdMethodCountersInterval ms (safepoint only)
+  static void reclaim_cold_method_counters();
 
   // Profiling
   elapsedTimer* accumulated_time() { return &_accumulated_time; }
@@ -77,9 +77,14 @@ void Coroutine::run(jobject coroutine) {
 
   // do not call JavaThread::current() here!
 
-  _thread->set_resource_area(new (mtThread) ResourceArea(32));
-  _thread->set_handle_area(new (mtThread) HandleArea(NULL, 32));
-  _thread->set_metadata_handles(new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, true));
+  // The areas stay with the coroutine for its lifetime, so the switch stub
+  // only needs to install them in the thread when switching to it.
+  _resource_area = new (mtThread) ResourceArea(32);
+  _handle_area = new (mtThread) HandleArea(NULL, 32);
+  _metadata_handles = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(30, true);
+  _thread->set_resource_area(_resource_area);
+  _thread->set_handle_area(_handle_area);
+  _thread->set_metadata_handles(_metadata_handles);
 
   {
     HandleMark hm(_thread);
@@ -105,15 +110,18 @@ Coroutine* Coroutine::create_thread_coroutine(JavaThread* thread, CoroutineStack
   coro->_is_thread_coroutine = true;
   coro->_thread = thread;
   coro->_stack = stack;
-  coro->_resource_area = NULL;
-  coro->_handle_area = NULL;
+  coro->_resource_area = thread->resource_area();
+  coro->_handle_area = thread->handle_area();
   coro->_last_handle_mark = NULL;
   coro->_active_handles = thread->active_handles();
-  coro->_metadata_handles = NULL;
+  coro->_metadata_handles = thread->metadata_handles();
   coro->_thread_status = java_lang_Thread::RUNNABLE;
   coro->_java_call_counter = 0;
   coro->_last_native_call_counter = 0;
   coro->_native_call_counter = 0;
+  coro->_oops_do_parity = 0;
+  coro->_roots_unchanged = 0;
+  coro->_idle_cleanups = 0;
 #if defined(_WINDOWS)
   coro->_last_SEH = NULL;
 #endif
@@ -122,6 +130,7 @@ Coroutine* Coroutine::create_thread_coroutine(JavaThread* thread, CoroutineStack
   coro->_wisp_engine  = NULL;
   coro->_wisp_task    = NULL;
   coro->_wisp_task_id = WISP_ID_NOT_SET;
+  coro->_switched_in_at = 0;
   coro->_coroutine    = NULL;
   coro->_enable_steal_count = 1;
   coro->_clinit_call_counter = 0;
@@ -163,6 +172,9 @@ Coroutine* Coroutine::create_coroutine(JavaThread* thread, CoroutineStack* stack
   coro->_java_call_counter = 0;
   coro->_last_native_call_counter = 0;
   coro->_native_call_counter = 0;
+  coro->_oops_do_parity = 0;
+  coro->_roots_unchanged = 0;
+  coro->_idle_cleanups = 0;
 #if defined(_WINDOWS)
   coro->_last_SEH = NULL;
 #endif
@@ -171,6 +183,7 @@ Coroutine* Coroutine::create_coroutine(JavaThread* thread, CoroutineStack* stack
   coro->_wisp_engine  = NULL;
   coro->_wisp_task    = NULL;
   coro->_wisp_task_id = WISP_ID_NOT_SET;
+  coro->_switched_in_at = 0;
   // oop address may change during JNIHandles::make_global due to lock contention
   coro->_coroutine = JNIHandles::resolve_non_null(obj);
   // if coro->_enable_steal_count == coro->_java_call_counter is true, we can do work steal.
@@ -295,7 +308,69 @@ public:
   void frames_do(frame* fr, RegisterMap* map) { fr->oops_do(_f, _cld_f, _cf, map); }
 };
 
-void Coroutine::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
+Coroutine::RootsScanMode Coroutine::_roots_scan_mode = Coroutine::_scan_all;
+BoolObjectClosure* Coroutine::_stable_ref_filter = NULL;
+
+PerfCounter* Coroutine::_perf_steals         = NULL;
+PerfCounter* Coroutine::_perf_failed_steals  = NULL;
+PerfCounter* Coroutine::_perf_steal_handles  = NULL;
+PerfCounter* Coroutine::_perf_steal_time     = NULL;
+PerfCounter* Coroutine::_perf_wisp_parks     = NULL;
+PerfCounter* Coroutine::_perf_wisp_unparks   = NULL;
+PerfCounter* Coroutine::_perf_proxy_unparks  = NULL;
+PerfCounter* Coroutine::_perf_roots_scanned  = NULL;
+PerfCounter* Coroutine::_perf_roots_skipped  = NULL;
+PerfCounter* Coroutine::_perf_roots_time     = NULL;
+
+void Coroutine::initialize_perf_counters() {
+  assert(EnableCoroutine, "Coroutine is disabled");
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    #define NEWPERFCOUNTER(n, name, u)  {n = PerfDataManager::create_counter(SUN_RT, name, u, CHECK); }
+    NEWPERFCOUNTER(_perf_steals,        "coroutine.steals",        PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_failed_steals, "coroutine.failedSteals",  PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_steal_handles, "coroutine.stealHandles",  PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_steal_time,    "coroutine.stealTime",     PerfData::U_Ticks);
+    NEWPERFCOUNTER(_perf_wisp_parks,    "coroutine.wispParks",     PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_wisp_unparks,  "coroutine.wispUnparks",   PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_proxy_unparks, "coroutine.proxyUnparks",  PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_roots_scanned, "coroutine.rootsScanned",  PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_roots_skipped, "coroutine.rootsSkipped",  PerfData::U_Events);
+    NEWPERFCOUNTER(_perf_roots_time,    "coroutine.rootsScanTime", PerfData::U_Ticks);
+    #undef NEWPERFCOUNTER
+  }
+}
+
+void Coroutine::set_roots_scan_mode(RootsScanMode mode, BoolObjectClosure* is_stable) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  assert(mode == _scan_all || is_stable != NULL, "need a filter to record");
+  _roots_scan_mode = mode;
+  _stable_ref_filter = is_stable;
+}
+
+// Applies f and notes whether every updated reference is stable.
+class RecordStableRootsClosure: public OopClosure {
+private:
+  OopClosure*        _f;
+  BoolObjectClosure* _is_stable;
+  bool               _all_stable;
+
+  template <class T> void do_oop_work(T* p) {
+    _f->do_oop(p);
+    T heap_oop = oopDesc::load_heap_oop(p);
+    if (_all_stable && !oopDesc::is_null(heap_oop)) {
+      _all_stable = _is_stable->do_object_b(oopDesc::decode_heap_oop_not_null(heap_oop));
+    }
+  }
+public:
+  RecordStableRootsClosure(OopClosure* f, BoolObjectClosure* is_stable) :
+    _f(f), _is_stable(is_stable), _all_stable(true) { }
+  void do_oop(oop* p)       { do_oop_work(p); }
+  void do_oop(narrowOop* p) { do_oop_work(p); }
+  bool all_stable() const   { return _all_stable; }
+};
+
+void Coroutine::stack_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   oops_do_Closure fc(f, cld_f, cf);
   frames_do(&fc);
   if (_state == _onstack) {
@@ -307,6 +382,26 @@ void Coroutine::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
       _privileged_stack_top->oops_do(f);
     }
   }
+}
+
+void Coroutine::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
+  if (_perf_roots_scanned != NULL) {
+    _perf_roots_scanned->inc();
+  }
+  if (_roots_scan_mode == _scan_all) {
+    _roots_unchanged = 0;
+    stack_oops_do(f, cld_f, cf);
+  } else if (_roots_scan_mode == _skip_unchanged && _roots_unchanged != 0 && _state == _onstack) {
+    // Not run since the previous pause and only referring to objects which
+    // this pause neither moves nor frees: the stack needs no visit.
+    if (_perf_roots_skipped != NULL) {
+      _perf_roots_skipped->inc();
+    }
+  } else {
+    RecordStableRootsClosure record_cl(f, _stable_ref_filter);
+    stack_oops_do(&record_cl, cld_f, cf);
+    _roots_unchanged = (record_cl.all_stable() && _state == _onstack) ? 1 : 0;
+  }
   if (_wisp_task != NULL) {
     f->do_oop((oop*) &_wisp_engine);
     f->do_oop((oop*) &_wisp_task);
@@ -316,6 +411,40 @@ void Coroutine::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   }
 }
 
+void Coroutine::possibly_parallel_oops_do_chunks(JavaThread* thread, OopClosure* f, CLDClosure* cld_f,
+                                                 CodeBlobClosure* cf, bool is_par, int parity) {
+  jlong start = _perf_roots_time != NULL ? os::elapsed_counter() : 0;
+  Coroutine* head = thread->coroutine_list();
+  Coroutine* current = head;
+  uintx index = 0;
+  // the first chunk has been visited together with the thread
+  do {
+    current = current->next();
+    index++;
+  } while (index < CoroutineRootsChunkSize && current != head);
+
+  while (current != head) {
+    // current starts a chunk
+    jint old_parity = current->_oops_do_parity;
+    bool claimed = !is_par ||
+      (old_parity != parity &&
+       Atomic::cmpxchg(parity, &current->_oops_do_parity, old_parity) == old_parity);
+    uintx chunk_end = index + CoroutineRootsChunkSize;
+    do {
+      if (claimed) {
+        current->_oops_do_parity = parity;
+        current->oops_do(f, cld_f, cf);
+      }
+      current = current->next();
+      index++;
+    } while (index < chunk_end && current != head);
+  }
+  // updated once per thread, races between workers only lose samples
+  if (_perf_roots_time != NULL) {
+    _perf_roots_time->inc(os::elapsed_counter() - start);
+  }
+}
+
 class nmethods_do_Closure: public FrameClosure {
 private:
   CodeBlobClosure* _cf;
@@ -359,6 +488,29 @@ void Coroutine::frames_do(void f(frame*, const RegisterMap* map)) {
   frames_do(&fc);
 }
 
+void Coroutine::trim_idle_stacks() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  jint threshold = (jint)MIN2(CoroutineStackTrimIdleCleanups, (uintx)max_jint - 1);
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    Coroutine* head = thread->coroutine_list();
+    if (head == NULL) {
+      continue;
+    }
+    Coroutine* current = head;
+    do {
+      // _idle_cleanups stops at threshold + 1 once the stack is trimmed,
+      // the switch stub resets it when the coroutine runs again
+      if (current->_state == _onstack && !current->_is_thread_coroutine &&
+          current->_idle_cleanups <= threshold &&
+          ++current->_idle_cleanups == threshold) {
+        current->_stack->discard_pages_below_sp();
+        current->_idle_cleanups++;
+      }
+      current = current->next();
+    } while (current != head);
+  }
+}
+
 bool Coroutine::is_disposable() {
   // _handle_area == NULL indicates this coroutine has not been initialized,
   // we should delete it directly.
@@ -384,6 +536,59 @@ CoroutineStack* CoroutineStack::create_thread_stack(JavaThread* thread) {
   return stack;
 }
 
+CoroutineStack* CoroutineStack::_global_cache[CoroutineStack::GlobalCacheBuckets] = { NULL };
+uintx CoroutineStack::_global_cache_size = 0;
+
+uint CoroutineStack::global_cache_bucket(size_t reserved_size) {
+  uint bucket = log2_intptr(reserved_size / os::vm_allocation_granularity());
+  return MIN2(bucket, (uint)GlobalCacheBuckets - 1);
+}
+
+CoroutineStack* CoroutineStack::take_from_cache(CoroutineStack*& list, size_t reserved_size) {
+  CoroutineStack** prev = &list;
+  for (CoroutineStack* stack = list; stack != NULL; stack = stack->_cache_next) {
+    if (stack->_reserved_space.size() == reserved_size) {
+      *prev = stack->_cache_next;
+      stack->_cache_next = NULL;
+      return stack;
+    }
+    prev = &stack->_cache_next;
+  }
+  return NULL;
+}
+
+void CoroutineStack::discard_cold_pages() {
+  size_t guard_size = (StackYellowPages + StackRedPages) * os::vm_page_size();
+  size_t hot_size = HotPages * os::vm_page_size();
+  if ((size_t)_stack_size <= guard_size + hot_size) {
+    return;
+  }
+  char* cold_start = (char*)(_stack_base - _stack_size) + guard_size;
+  size_t cold_size = _stack_size - guard_size - hot_size;
+  os::free_memory(cold_start, cold_size, os::vm_page_size());
+}
+
+void CoroutineStack::discard_pages_below_sp() {
+  assert(SafepointSynchronize::is_at_safepoint(), "stack could be in use");
+  assert(_last_sp != NULL, "not parked");
+  size_t page_size = os::vm_page_size();
+  size_t guard_size = (StackYellowPages + StackRedPages) * page_size;
+  char* start = (char*)(_stack_base - _stack_size) + guard_size;
+  // keep the page holding _last_sp and the one below for the switch stub
+  char* end = (char*)align_ptr_down(_last_sp, page_size) - page_size;
+  if (end > start) {
+    os::free_memory(start, end - start, page_size);
+  }
+}
+
+void CoroutineStack::release(CoroutineStack* stack) {
+  if (stack->_reserved_space.size() > 0) {
+    stack->_virtual_space.release();
+    stack->_reserved_space.release();
+  }
+  delete stack;
+}
+
 CoroutineStack* CoroutineStack::create_stack(JavaThread* thread, intptr_t size/* = -1*/) {
   bool default_size = false;
   if (size <= 0) {
@@ -395,7 +600,26 @@ CoroutineStack* CoroutineStack::create_stack(JavaThread* thread, intptr_t size/*
   uintx real_stack_size = size + (reserved_pages * os::vm_page_size());
   uintx reserved_size = align_size_up(real_stack_size, os::vm_allocation_granularity());
 
-  CoroutineStack* stack = new CoroutineStack(reserved_size);
+  CoroutineStack* stack = take_from_cache(thread->coroutine_stack_cache(), reserved_size);
+  if (stack != NULL) {
+    thread->coroutine_stack_cache_size()--;
+  } else if (CoroutineStackGlobalCacheSize > 0) {
+    MutexLockerEx ml(CoroutineStackCache_lock, Mutex::_no_safepoint_check_flag);
+    stack = take_from_cache(_global_cache[global_cache_bucket(reserved_size)], reserved_size);
+    if (stack != NULL) {
+      _global_cache_size--;
+    }
+  }
+  if (stack != NULL) {
+    // The reserved space and guard pages are kept as they were
+    assert(stack->_virtual_space.committed_size() == real_stack_size, "same size");
+    stack->_thread = thread;
+    stack->_last_sp = NULL;
+    stack->_default_size = default_size;
+    return stack;
+  }
+
+  stack = new CoroutineStack(reserved_size);
   if (stack == NULL)
     return NULL;
   if (!stack->_virtual_space.initialize(stack->_reserved_space, real_stack_size)) {
@@ -437,11 +661,46 @@ void CoroutineStack::free_stack(CoroutineStack* stack, JavaThread* thread) {
     return;
   }
 
-  if (stack->_reserved_space.size() > 0) {
-    stack->_virtual_space.release();
-    stack->_reserved_space.release();
+  if (thread->coroutine_stack_cache_size() < CoroutineStackCacheSize) {
+    stack->_cache_next = thread->coroutine_stack_cache();
+    thread->coroutine_stack_cache() = stack;
+    thread->coroutine_stack_cache_size()++;
+    return;
   }
-  delete stack;
+
+  if (!add_to_global_cache(stack)) {
+    release(stack);
+  }
+}
+
+bool CoroutineStack::add_to_global_cache(CoroutineStack* stack) {
+  if (_global_cache_size >= CoroutineStackGlobalCacheSize) {
+    return false;
+  }
+  stack->discard_cold_pages();
+  stack->_thread = NULL;
+  MutexLockerEx ml(CoroutineStackCache_lock, Mutex::_no_safepoint_check_flag);
+  if (_global_cache_size >= CoroutineStackGlobalCacheSize) {
+    return false;
+  }
+  uint bucket = global_cache_bucket(stack->_reserved_space.size());
+  stack->_cache_next = _global_cache[bucket];
+  _global_cache[bucket] = stack;
+  _global_cache_size++;
+  return true;
+}
+
+void CoroutineStack::flush_thread_cache(JavaThread* thread) {
+  while (thread->coroutine_stack_cache() != NULL) {
+    CoroutineStack* stack = thread->coroutine_stack_cache();
+    thread->coroutine_stack_cache() = stack->_cache_next;
+    thread->coroutine_stack_cache_size()--;
+    stack->_cache_next = NULL;
+    if (!add_to_global_cache(stack)) {
+      release(stack);
+    }
+  }
+  assert(thread->coroutine_stack_cache_size() == 0, "sanity");
 }
 
 void CoroutineStack::frames_do(FrameClosure* fc) {
@@ -582,6 +841,63 @@ void Coroutine::print_stack_on(outputStream* st) {
 }
 
 
+void CoroutineStateCounts::add_thread(JavaThread* thread) {
+  Coroutine* head = thread->coroutine_list();
+  if (head == NULL) {
+    return;
+  }
+  Coroutine* c = head;
+  do {
+    if (!c->is_thread_coroutine()) {
+      if (c == thread->current_coroutine()) {
+        _running++;
+      } else if (c->state() == Coroutine::_onstack) {
+        oop task = c->wisp_task();
+        if (task == NULL || com_alibaba_wisp_engine_WispTask::get_threadWrapper(task) == NULL) {
+          _cached++;
+        } else {
+          _parked++;
+          int jvm_park = com_alibaba_wisp_engine_WispTask::get_jvmParkStatus(task);
+          int jdk_park = com_alibaba_wisp_engine_WispTask::get_jdkParkStatus(task);
+          uint i = 0;
+          while (i < _num_groups &&
+                 (_groups[i]._jvm_park_status != jvm_park || _groups[i]._jdk_park_status != jdk_park)) {
+            i++;
+          }
+          if (i == _num_groups && _num_groups < MaxParkGroups) {
+            _groups[i]._jvm_park_status = jvm_park;
+            _groups[i]._jdk_park_status = jdk_park;
+            _groups[i]._count = 0;
+            _num_groups++;
+          }
+          if (i < _num_groups) {
+            _groups[i]._count++;
+          } else {
+            _ungrouped++;
+          }
+        }
+      }
+    }
+    c = c->next();
+  } while (c != head);
+}
+
+void CoroutineStateCounts::print_on(outputStream* st) const {
+  st->print("Coroutines: %u running, %u parked", _running, _parked);
+  if (_parked > 0) {
+    st->print(" (");
+    for (uint i = 0; i < _num_groups; i++) {
+      st->print("%spark=%d/%d: %u", i == 0 ? "" : ", ",
+                _groups[i]._jvm_park_status, _groups[i]._jdk_park_status, _groups[i]._count);
+    }
+    if (_ungrouped > 0) {
+      st->print(", other: %u", _ungrouped);
+    }
+    st->print(")");
+  }
+  st->print_cr(", %u cached", _cached);
+}
+
 //  ---------- lock support -----------
 bool WispThread::_wisp_booted = false;
 Method* WispThread::parkMethod = NULL;
@@ -753,6 +1069,9 @@ void WispThread::park(long millis, const ObjectWaiter* ow) {
     // thread steal support
     WispPostStealHandleUpdateMark w(jt);   // special one, because park() is inside an EnableStealMark, so the _enable_steal_count counter has been added one.
     wisp_thread->_unpark_status = _wisp_parking;
+    if (Coroutine::_perf_wisp_parks != NULL) {
+      Coroutine::_perf_wisp_parks->inc();
+    }
     JavaCalls::call(&result, methodHandle(parkMethod), &args, jt);
 
     // the runtime can not handle the exception on monitorenter bci
@@ -813,12 +1132,22 @@ void WispThread::unpark(int task_id, bool using_wisp_park, bool proxy_unpark, Pa
     MutexLockerEx mu(Wisp_lock, Monitor::_no_safepoint_check_flag);
     wisp_thread->_unpark_status = WispThread::_proxy_unpark_begin;
     _proxy_unpark->append(task_id);
-    Wisp_lock->notify(); // only one consumer
+    if (Coroutine::_perf_proxy_unparks != NULL) {
+      Coroutine::_perf_proxy_unparks->inc();
+    }
+    if (_proxy_unpark->length() == 1) {
+      // only one consumer, which drains all pending unparks at once and only
+      // waits when the list is empty, so a burst of unparks needs one wakeup
+      Wisp_lock->notify();
+    }
     wisp_thread->_unpark_status = WispThread::_proxy_unpark_done;
     return;
   }
 
   wisp_thread->_unpark_status = WispThread::_wisp_unpark_begin;
+  if (Coroutine::_perf_wisp_unparks != NULL) {
+    Coroutine::_perf_wisp_unparks->inc();
+  }
   JavaValue result(T_VOID);
   JavaCallArguments args;
   args.push_int(task_id);
@@ -1090,6 +1419,9 @@ void WispResourceArea::wisp_post_steal_handles_do(JavaThread *real_thread) {
     handles_visited += chunk_wisp_post_steal_handles_do(k, k->top(), real_thread);
     k = k->next();
   }
+  if (Coroutine::_perf_steal_handles != NULL) {
+    Coroutine::_perf_steal_handles->inc(handles_visited);
+  }
 }
 
 class WispPostStealHandle : public StackObj {
@@ -31,6 +31,7 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/monitorChunk.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/thread.hpp"
 
 // number of heap words that prepareSwitch will add as a safety measure to the CoroutineData size
@@ -103,6 +104,7 @@ private:
   CoroutineStack* _stack;
 
   int             _wisp_task_id;
+  jlong           _switched_in_at;    // javaTimeNanos, for TenantCpuBudget
   oop             _wisp_engine;
   oop             _wisp_task;
   oop             _coroutine;
@@ -122,6 +124,15 @@ private:
   int             _clinit_call_counter;
   volatile int    _native_call_counter;
 
+  // claims a chunk of coroutines during parallel root scanning
+  volatile jint   _oops_do_parity;
+  // set by an evacuation pause which found only stable references in the
+  // frames and handles, cleared whenever the coroutine is switched to
+  jint            _roots_unchanged;
+  // safepoint cleanups since the coroutine was parked, cleared whenever it
+  // is switched to (see CoroutineStackTrimIdleCleanups)
+  jint            _idle_cleanups;
+
   // work steal pool
   WispResourceArea*       _wisp_post_steal_resource_area;
   bool            _is_yielding;
@@ -134,6 +145,7 @@ private:
   Coroutine() { }
 
   void frames_do(FrameClosure* fc);
+  void stack_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
   bool is_coroutine_frame(javaVFrame* jvf);
   bool in_critical(JavaThread* thread);
   static void set_coroutine_base(intptr_t **&base, JavaThread* thread, jobject obj, Coroutine *coro, oop coroutineObj, address coroutine_start);
@@ -147,6 +159,20 @@ public:
   static Coroutine* create_coroutine(JavaThread* thread, CoroutineStack* stack, oop coroutineObj);
   static void after_safepoint(JavaThread* thread);
 
+  // PerfData counters for the coroutine runtime, NULL unless UsePerfData;
+  // switches themselves are intrinsified and are not counted here
+  static PerfCounter* _perf_steals;           // coroutines moved to another carrier
+  static PerfCounter* _perf_failed_steals;    // steal attempts refused by the VM
+  static PerfCounter* _perf_steal_handles;    // thread/JNIEnv slots rewritten after steals
+  static PerfCounter* _perf_steal_time;       // ticks spent in stealCoroutine
+  static PerfCounter* _perf_wisp_parks;       // monitor parks done by a wisp park
+  static PerfCounter* _perf_wisp_unparks;     // monitor unparks done by a wisp unpark
+  static PerfCounter* _perf_proxy_unparks;    // unparks dispatched by the proxy thread
+  static PerfCounter* _perf_roots_scanned;    // coroutines visited by the GC
+  static PerfCounter* _perf_roots_skipped;    // ...of which the stack was skipped
+  static PerfCounter* _perf_roots_time;       // ticks scanning past the first chunk
+  static void initialize_perf_counters();
+
   CoroutineState state() const      { return _state; }
   void set_state(CoroutineState x)  { _state = x; }
 
@@ -161,6 +187,9 @@ public:
   int wisp_task_id() const          { return _wisp_task_id; }
   void set_wisp_task_id(int x)      { _wisp_task_id = x; }
 
+  jlong switched_in_at() const      { return _switched_in_at; }
+  void set_switched_in_at(jlong x)  { _switched_in_at = x; }
+
   oop wisp_engine() const           { return _wisp_engine; }
   void set_wisp_engine(oop x);
 
@@ -213,14 +242,36 @@ public:
   void print_stack_on(outputStream* st);
 
   // GC support
+  enum RootsScanMode {
+    _scan_all,          // visit everything and forget _roots_unchanged
+    _scan_and_record,   // visit everything and recompute _roots_unchanged
+    _skip_unchanged     // like _scan_and_record, but skip unchanged parked coroutines
+  };
+  // Set by the collector around its root scanning; is_stable tells which
+  // objects are known not to move or die until the next _skip_unchanged scan.
+  static void set_roots_scan_mode(RootsScanMode mode, BoolObjectClosure* is_stable = NULL);
+
   void oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
   void nmethods_do(CodeBlobClosure* cf);
   void metadata_do(void f(Metadata*));
   void frames_do(void f(frame*, const RegisterMap* map));
 
+  // Called at safepoint cleanup: release the unused stack pages of the
+  // coroutines parked for CoroutineStackTrimIdleCleanups cleanups
+  static void trim_idle_stacks();
+
+  void set_oops_do_parity(int parity)     { _oops_do_parity = parity; }
+  // Scan the coroutines of thread following its first CoroutineRootsChunkSize
+  // ones, which are scanned together with the thread itself. Chunks are
+  // claimed through the parity of their first coroutine.
+  static void possibly_parallel_oops_do_chunks(JavaThread* thread, OopClosure* f, CLDClosure* cld_f,
+                                               CodeBlobClosure* cf, bool is_par, int parity);
+
   static ByteSize thread_offset()             { return byte_offset_of(Coroutine, _thread); }
 
   static ByteSize state_offset()              { return byte_offset_of(Coroutine, _state); }
+  static ByteSize roots_unchanged_offset()    { return byte_offset_of(Coroutine, _roots_unchanged); }
+  static ByteSize idle_cleanups_offset()      { return byte_offset_of(Coroutine, _idle_cleanups); }
   static ByteSize stack_offset()              { return byte_offset_of(Coroutine, _stack); }
 
   static ByteSize resource_area_offset()      { return byte_offset_of(Coroutine, _resource_area); }
@@ -249,6 +300,10 @@ public:
   static ByteSize last_SEH_offset()           { return byte_offset_of(Coroutine, _last_SEH); }
 #endif
   static ByteSize wisp_thread_offset()        { return byte_offset_of(Coroutine, _wisp_thread); }
+
+private:
+  static RootsScanMode      _roots_scan_mode;
+  static BoolObjectClosure* _stable_ref_filter;
 };
 
 class CoroutineStack: public CHeapObj<mtCoroutine>, public DoublyLinkedList<CoroutineStack> {
@@ -265,16 +320,42 @@ private:
 
   address         _last_sp;
 
+  // Free stacks are cached per thread (JavaThread::coroutine_stack_cache())
+  // and globally in buckets of reserved size, so short-lived coroutines
+  // don't pay for mmap/mprotect/munmap. Guard pages stay protected.
+  CoroutineStack* _cache_next;
+
+  enum {
+    GlobalCacheBuckets = 16,
+    // pages below the stack base that are likely to be touched again,
+    // the others are discarded when moving a stack into the global cache
+    HotPages = 8
+  };
+  static CoroutineStack* _global_cache[GlobalCacheBuckets];
+  static uintx           _global_cache_size;
+
   // objects of this type can only be created via static functions
-  CoroutineStack(intptr_t size) : _reserved_space(size) { }
+  CoroutineStack(intptr_t size) : _reserved_space(size), _cache_next(NULL) { }
   virtual ~CoroutineStack() { }
 
   static Register get_fp_reg();
 
+  static uint global_cache_bucket(size_t reserved_size);
+  // Unlink and return a stack of reserved_size from list, NULL if none
+  static CoroutineStack* take_from_cache(CoroutineStack*& list, size_t reserved_size);
+  static void release(CoroutineStack* stack);
+  static bool add_to_global_cache(CoroutineStack* stack);
+  void discard_cold_pages();
+  // Release the pages between the guard zone and the parked stack pointer
+  void discard_pages_below_sp();
+  friend class Coroutine;
+
 public:
   static CoroutineStack* create_thread_stack(JavaThread* thread);
   static CoroutineStack* create_stack(JavaThread* thread, intptr_t size = -1);
   static void free_stack(CoroutineStack* stack, JavaThread* THREAD);
+  // Move the stacks cached by a terminating thread to the global cache
+  static void flush_thread_cache(JavaThread* thread);
 
   static intptr_t get_start_method();
 
@@ -298,6 +379,43 @@ public:
   static ByteSize last_sp_offset()            { return byte_offset_of(CoroutineStack, _last_sp); }
 };
 
+// Coroutines counted by state for thread dumps and JFR, filled at a
+// safepoint. Parked coroutines are grouped by the park=jvm/jdk status of
+// their WispTask, as printed in the coroutine header of a thread dump.
+class CoroutineStateCounts VALUE_OBJ_CLASS_SPEC {
+public:
+  enum { MaxParkGroups = 8 };
+
+  struct ParkGroup {
+    int  _jvm_park_status;
+    int  _jdk_park_status;
+    uint _count;
+  };
+
+private:
+  uint      _running;       // current coroutine of a carrier thread
+  uint      _parked;        // switched out, bound to a task
+  uint      _cached;        // switched out, no task bound
+  ParkGroup _groups[MaxParkGroups];
+  uint      _num_groups;
+  uint      _ungrouped;     // parked ones which did not fit in _groups
+
+public:
+  CoroutineStateCounts() : _running(0), _parked(0), _cached(0), _num_groups(0), _ungrouped(0) { }
+
+  // add all coroutines of thread, except its thread coroutine
+  void add_thread(JavaThread* thread);
+
+  uint running() const                      { return _running; }
+  uint parked() const                       { return _parked; }
+  uint cached() const                       { return _cached; }
+  uint num_groups() const                   { return _num_groups; }
+  const ParkGroup* group_at(uint i) const   { return &_groups[i]; }
+  uint ungrouped() const                    { return _ungrouped; }
+
+  void print_on(outputStream* st) const;
+};
+
 template<class T> void DoublyLinkedList<T>::remove_from_list(pointer& list) {
   if (list == this) {
     if (list->_next == list)
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "code/codeCache.hpp"
 #include "code/debugInfoRec.hpp"
 #include "code/nmethod.hpp"
 #include "code/pcDesc.hpp"
@@ -40,6 +41,7 @@
 #include "runtime/biasedLocking.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/deoptimization.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
@@ -48,6 +50,8 @@
 #include "runtime/vframe.hpp"
 #include "runtime/vframeArray.hpp"
 #include "runtime/vframe_hp.hpp"
+#include "runtime/vmThread.hpp"
+#include "runtime/vm_operations.hpp"
 #include "utilities/events.hpp"
 #include "utilities/xmlstream.hpp"
 #ifdef TARGET_ARCH_x86
@@ -751,6 +755,29 @@ int Deoptimization::deoptimize_dependents() {
   return 0;
 }
 
+volatile bool Deoptimization::_has_pending_dependents = false;
+
+void Deoptimization::deoptimize_pending_dependents() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  assert(Thread::current()->is_VM_thread(), "should be the VM thread");
+  if (!has_pending_dependents()) {
+    return;
+  }
+  // Marking happens in the VM state, so nothing gets marked until we are done
+  clear_pending_dependents();
+  ResourceMark rm;
+  DeoptimizationMarker dm;
+  deoptimize_dependents();
+  CodeCache::make_marked_nmethods_not_entrant();
+}
+
+void Deoptimization::flush_pending_dependents() {
+  if (has_pending_dependents()) {
+    VM_Deoptimize op;
+    VMThread::execute(&op);
+  }
+}
+
 
 #ifdef COMPILER2
 bool Deoptimization::realloc_objects(JavaThread* thread, frame* fr, GrowableArray<ScopeValue*>* objects, TRAPS) {
@@ -1169,6 +1196,8 @@ void Deoptimization::revoke_biases_of_monitors(JavaThread* thread, frame fr, Reg
 
   if (SafepointSynchronize::is_at_safepoint()) {
     BiasedLocking::revoke_at_safepoint(objects_to_revoke);
+  } else if (thread != JavaThread::current()) {
+    BiasedLocking::revoke_at_handshake(objects_to_revoke, thread);
   } else {
     BiasedLocking::revoke(objects_to_revoke);
   }
@@ -1233,8 +1262,9 @@ void Deoptimization::deoptimize(JavaThread* thread, frame fr, RegisterMap *map)
 
 
 void Deoptimization::deoptimize_frame_internal(JavaThread* thread, intptr_t* id) {
-  assert(thread == Thread::current() || SafepointSynchronize::is_at_safepoint(),
-         "can only deoptimize other thread at a safepoint");
+  assert(thread == Thread::current() || SafepointSynchronize::is_at_safepoint() ||
+         thread->has_handshake_pending(),
+         "can only deoptimize other thread at a safepoint or handshake");
   // Compute frame and register map based on thread and sp.
   RegisterMap reg_map(thread, UseBiasedLocking);
   frame fr = thread->last_frame();
@@ -1245,12 +1275,27 @@ void Deoptimization::deoptimize_frame_internal(JavaThread* thread, intptr_t* id)
 }
 
 
+class DeoptimizeFrameClosure : public HandshakeClosure {
+ private:
+  intptr_t* _id;
+ public:
+  DeoptimizeFrameClosure(intptr_t* id) : HandshakeClosure("DeoptimizeFrame"), _id(id) {}
+  void do_thread(Thread* thread) {
+    Deoptimization::deoptimize_frame_internal((JavaThread*) thread, _id);
+  }
+};
+
 void Deoptimization::deoptimize_frame(JavaThread* thread, intptr_t* id) {
   if (thread == Thread::current()) {
     Deoptimization::deoptimize_frame_internal(thread, id);
   } else {
-    VM_DeoptimizeFrame deopt(thread, id);
-    VMThread::execute(&deopt);
+    // Register window patching (NeedsDeoptSuspend) still needs the
+    // safepoint to resolve its race with a thread in native.
+    DeoptimizeFrameClosure cl(id);
+    if (NeedsDeoptSuspend || !Handshake::try_execute(&cl, thread)) {
+      VM_DeoptimizeFrame deopt(thread, id);
+      VMThread::execute(&deopt);
+    }
   }
 }
 
@@ -1316,6 +1361,21 @@ void Deoptimization::load_class_by_index(constantPoolHandle constant_pool, int i
   }
 }
 
+// Reasons for which a JWarmUp compilation may have trusted the restored profile.
+bool Deoptimization::is_jwarmup_speculation_reason(DeoptReason reason) {
+  switch (reason) {
+  case Deoptimization::Reason_null_check:
+  case Deoptimization::Reason_null_assert:
+  case Deoptimization::Reason_class_check:
+  case Deoptimization::Reason_speculate_class_check:
+  case Deoptimization::Reason_bimorphic:
+  case Deoptimization::Reason_unstable_if:
+    return true;
+  default:
+    return false;
+  }
+}
+
 JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint trap_request)) {
   HandleMark hm;
 
@@ -1631,6 +1691,21 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
 
     }
 
+    // A JWarmUp compilation speculated on the profile of a previous run.
+    // Give up on it once the current run keeps contradicting that profile.
+    if (nm->is_jwarmup_speculation() && is_jwarmup_speculation_reason(reason)) {
+      uint failures = nm->method()->inc_jwarmup_speculation_failures();
+      if (PrintCompilationWarmUpDetail) {
+        ResourceMark rm;
+        tty->print_cr("[JitWarmUp] speculation failed (%s) in %s, %u/" UINTX_FORMAT,
+                      trap_reason_name(reason), nm->method()->name_and_sig_as_C_string(),
+                      failures, CompilationWarmUpSpeculationFailureLimit);
+      }
+      if (failures >= CompilationWarmUpSpeculationFailureLimit) {
+        make_not_entrant = true;
+      }
+    }
+
     // Take requested actions on the method:
 
     // Recompile
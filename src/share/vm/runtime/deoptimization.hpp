@@ -101,6 +101,21 @@ class Deoptimization : AllStatic {
   // corresponding activations are deoptimized.
   static int deoptimize_dependents();
 
+  // Class hierarchy invalidation with BatchDependentDeoptimization. Class
+  // loading only marks the dependent nmethods; they are deoptimized in one
+  // go at the next safepoint, or before any class is initialized since no
+  // instance of a new class can exist earlier.
+ private:
+  static volatile bool _has_pending_dependents;
+ public:
+  static bool has_pending_dependents()    { return _has_pending_dependents; }
+  static void set_pending_dependents()    { _has_pending_dependents = true; }
+  static void clear_pending_dependents()  { _has_pending_dependents = false; }
+  // Deoptimizes the marked nmethods now (at a safepoint, VM thread only)
+  static void deoptimize_pending_dependents();
+  // Runs a VM_Deoptimize if nmethods are still marked (from a JavaThread)
+  static void flush_pending_dependents();
+
   // Deoptimizes a frame lazily. nmethod gets patched deopt happens on return to the frame
   static void deoptimize(JavaThread* thread, frame fr, RegisterMap *reg_map);
 
@@ -310,6 +325,9 @@ class Deoptimization : AllStatic {
     return reason > Reason_none && reason <= Reason_RECORDED_LIMIT;
   }
 
+  // reasons that contradict the profile a JWarmUp compilation speculated on
+  static bool is_jwarmup_speculation_reason(DeoptReason reason);
+
   static DeoptReason reason_recorded_per_bytecode_if_any(DeoptReason reason) {
     if (reason_is_recorded_per_bytecode(reason))
       return reason;
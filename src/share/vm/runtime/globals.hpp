@@ -1402,8 +1402,8 @@ class CommandLineFlags {
   notproduct(bool, TraceZapDeadLocals, false,                               \
           "Trace zapping dead locals")                                      \
                                                                             \
-  develop(bool, TraceStartupTime, false,                                    \
-          "Trace setup time")                                               \
+  product(bool, TraceStartupTime, false,                                    \
+          "Print the time taken by the phases of VM startup")               \
                                                                             \
   develop(bool, TraceProtectionDomainVerification, false,                   \
           "Trace protection domain verification")                           \
@@ -4028,6 +4028,10 @@ class CommandLineFlags {
   lp64_product(ccstr, CompilationWarmUpLogfile, NULL,                       \
           "Log file name for JWarmUP")                                      \
                                                                             \
+  lp64_product(bool, CompilationWarmUpParallelLoad, true,                   \
+          "Intern the symbols of a large JWarmUP log file with the GC "     \
+          "worker threads")                                                 \
+                                                                            \
   lp64_product(uintx, CompilationWarmUpRecordTime, 0,                       \
           "Sleep time (in seconds) before flushing profling "               \
           "information to log file ")                                       \
@@ -4052,15 +4056,72 @@ class CommandLineFlags {
           "The max number of methods marked for "                           \
           "deoptimization per iteration")                                   \
                                                                             \
+  lp64_product(bool, CompilationWarmUpAdaptiveDeopt, false,                 \
+          "Pace the deoptimization of JWarmUP methods by the compile "      \
+          "queue length and keep the methods whose live profile still "     \
+          "matches the recorded one")                                       \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpDeoptProfileDrift, 20,               \
+          "Distance (in percent) between the live and the recorded "        \
+          "profile of a JWarmUP method from which it is deoptimized "       \
+          "with CompilationWarmUpAdaptiveDeopt")                            \
+                                                                            \
   diagnostic(bool, CompilationWarmUpResolveClassEagerly, true,              \
           "resolve class from constant pool eagerly")                       \
                                                                             \
+  diagnostic(bool, CompilationWarmUpResolveCPCacheEagerly, true,            \
+          "resolve the constant pool cache entries and invokedynamic "      \
+          "call sites recorded in the JWarmUP log eagerly")                 \
+                                                                            \
   lp64_product(bool, DeoptimizeBeforeWarmUp, false,                         \
           "Deoptimize recorded methods before JWarmUP compilation")         \
                                                                             \
   lp64_product(intx, CompilationWarmUpRecordMinLevel, 3,                    \
           "Minimal compilation level recorded in JWarmUP recording phase")  \
                                                                             \
+  lp64_product(bool, CompilationWarmUpTieredReplay, true,                   \
+          "With TieredCompilation, replay JWarmUP methods at the level "    \
+          "they reached when recorded instead of always with C2")           \
+                                                                            \
+  lp64_product(bool, CompilationWarmUpThrottle, false,                      \
+          "Submit JWarmUP compilations hottest first and back off while "   \
+          "the compile queues or the CPUs are busy")                        \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpThrottleQueueSize, 16,               \
+          "Compile queue length at which throttled JWarmUP submission "     \
+          "backs off")                                                      \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpThrottleCPUPercent, 80,              \
+          "Process CPU usage (percent of the available processors) at "     \
+          "which throttled JWarmUP submission backs off")                   \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpThrottleInterval, 20,                \
+          "Back-off time (in milliseconds) of throttled JWarmUP "           \
+          "submission")                                                     \
+                                                                            \
+  lp64_product(bool, CompilationWarmUpRecordMethodData, true,               \
+          "Record type profiles and branch counts of the methods in "       \
+          "the JWarmUP log and restore them before warmup compilation")     \
+                                                                            \
+  lp64_product(bool, CompilationWarmUpSpeculation, false,                   \
+          "Let JWarmUP compilations speculate on receiver types and "       \
+          "null checks using the restored profile instead of compiling "    \
+          "them without profile")                                           \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpSpeculationFailureLimit, 3,          \
+          "Number of failed speculations in JWarmUP compiled code after "   \
+          "which the code is discarded and the method is no longer "        \
+          "compiled speculatively by JWarmUP")                              \
+                                                                            \
+  lp64_product(ccstr, CompilationWarmUpMergeLogfiles, NULL,                 \
+          "Comma separated JWarmUP logs recorded by several instances "     \
+          "of an application. With CompilationWarmUp they are merged "      \
+          "into CompilationWarmUpLogfile, which the warmup then uses")      \
+                                                                            \
+  lp64_product(uintx, CompilationWarmUpMinInstances, 1,                     \
+          "Number of recording instances a method of a merged JWarmUP "     \
+          "log must have been compiled in to be warmed up")                 \
+                                                                            \
   JFR_ONLY(product(bool, FlightRecorder, false,                             \
           "Enable Flight Recorder"))                                        \
                                                                             \
@@ -4070,6 +4131,42 @@ class CommandLineFlags {
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
+  JFR_ONLY(product(ccstr, FlightRecorderEventRates, NULL,                   \
+          "Comma separated <event>=<events per second> limits for "         \
+          "throttled Flight Recorder allocation events"))                   \
+                                                                            \
+  JFR_ONLY(product(uintx, FlightRecorderCPUSampleInterval, 0,               \
+          "CPU time in milliseconds between SIGPROF samples of the mixed "  \
+          "Java and native stack, 0 to disable (Linux only)"))              \
+                                                                            \
+  JFR_ONLY(product(bool, LeakProfilerParallelChains, false,                 \
+          "Search the paths from GC roots to old object samples "           \
+          "depth-first with the GC workers of G1, CMS or ParNew"))          \
+                                                                            \
+  JFR_ONLY(product(uintx, LeakProfilerEdgeQueueMaxSize, 1*G,                \
+          "Upper bound in bytes of the breadth-first edge queue; when "     \
+          "it is full the search continues depth-first"))                   \
+                                                                            \
+  JFR_ONLY(product(uintx, LeakProfilerChainTimeout, 0,                      \
+          "Upper bound in milliseconds of the path to GC roots search in "  \
+          "the safepoint, 0 for the cutoff of the recording only"))         \
+                                                                            \
+  JFR_ONLY(product(bool, FlightRecorderCompressChunks, false,               \
+          "Write Flight Recorder event data as LZ4 blocks; checkpoints "    \
+          "and metadata stay uncompressed"))                                \
+                                                                            \
+  JFR_ONLY(product(ccstr, FlightRecorderRingFile, NULL,                     \
+          "Also publish the chunk being recorded through this "             \
+          "memory-mapped ring file for live readers"))                      \
+                                                                            \
+  JFR_ONLY(product(uintx, FlightRecorderRingSize, 64*M,                     \
+          "Size in bytes of the data area of FlightRecorderRingFile"))      \
+                                                                            \
+  JFR_ONLY(product(bool, FlightRecorderMonitorContention, false,            \
+          "Aggregate contended monitor enters per monitor class, "          \
+          "blocking frame and releasing frame, emitted as "                 \
+          "JavaMonitorContention events"))                                  \
+                                                                            \
   JFR_ONLY(product(bool, UnlockCommercialFeatures, false,                   \
           "This flag is ignored. Left for compatibility"))                  \
                                                                             \
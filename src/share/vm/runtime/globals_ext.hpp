@@ -79,6 +79,10 @@
           "Floor percent of the young gc interval less than "               \
           "ElasticHeapPeriodicYGCIntervalMillis")                           \
                                                                             \
+  product(bool, ElasticHeapPeriodicPredictive, false,                       \
+          "Commit young regions ahead of a forecast rise of allocation "    \
+          "rate in periodic gc mode")                                       \
+                                                                            \
   manageable(uintx, ElasticHeapEagerMixedGCIntervalMillis, 15000,           \
           "Mixed GC will be triggered if desired mixed gc doesn't happen "  \
           "after the interval in milliseconds")                             \
@@ -95,6 +99,112 @@
           "Number of parallel worker threads for memory "                   \
           "commit/uncommit. 0 be same as ConcGCThreads")                    \
                                                                             \
+  product(uintx, ElasticHeapUncommitAlignment, 0,                           \
+          "Commit/uncommit heap memory in aligned chunks of this size "     \
+          "so that transparent huge pages are not split, e.g. 2M when "     \
+          "THP is enabled system wide. 0 means region granularity")         \
+                                                                            \
+  product(bool, ElasticHeapNUMAAware, true,                                 \
+          "Bind the memory of recommitted regions to the NUMA nodes "       \
+          "where Java threads run (effective only with UseNUMA)")           \
+                                                                            \
+  manageable(uintx, ElasticHeapStandbyPercent, 0,                           \
+          "Percent of the max young generation that G1ElasticHeap keeps "   \
+          "committed and pretouched but unused while the young "            \
+          "generation is shrunk, so it can grow back without waiting "      \
+          "for a commit. 0 disables the standby pool")                      \
+                                                                            \
+  manageable(uintx, ElasticHeapAllocSpikePercent, 50,                       \
+          "Rise of the allocation rate over its recent average, in "        \
+          "percent, at which G1ElasticHeap hands the standby regions to "   \
+          "the young generation at once")                                   \
+                                                                            \
+  product(bool, G1ParallelFullGC, false,                                    \
+          "Run the phases of the G1 full GC on the parallel GC worker "     \
+          "threads")                                                        \
+                                                                            \
+  product(bool, G1RebuildRemSetsConcurrently, false,                        \
+          "Only keep remembered sets of old regions that are collection "   \
+          "set candidates and rebuild them concurrently after marking")     \
+                                                                            \
+  product(bool, G1RefineCardsBatched, false,                                \
+          "Concurrent refinement sorts each dirty card buffer and scans "   \
+          "runs of adjacent cards of a region together")                    \
+                                                                            \
+  product(bool, G1UseOptionalCSetIncrements, false,                         \
+          "Mixed collections evacuate the old regions beyond the "          \
+          "predicted pause time budget in increments, and stop once the "   \
+          "pause time goal has been used up")                               \
+                                                                            \
+  product(uintx, G1SoftMaxHeapSize, 0,                                      \
+          "Uncommit free regions down to this heap size after each "        \
+          "concurrent cycle and when the heap is idle, without "            \
+          "G1ElasticHeap. 0 disables the uncommit")                         \
+                                                                            \
+  product(uintx, G1PeriodicUncommitInterval, 0,                             \
+          "Milliseconds without a GC after which the heap counts as idle "  \
+          "and is shrunk to G1SoftMaxHeapSize. 0 disables the timer")       \
+                                                                            \
+  product(bool, G1NUMAAware, false,                                         \
+          "Bind heap regions to NUMA nodes and allocate eden and survivor " \
+          "regions on the node of the allocating thread "                   \
+          "(effective only with UseNUMA)")                                  \
+                                                                            \
+  product(bool, G1EagerReclaimHumongousObjArrays, false,                    \
+          "Also eagerly reclaim humongous object arrays with few "          \
+          "remembered set entries at young GCs outside of a concurrent "    \
+          "cycle (needs G1EagerReclaimHumongousObjects)")                   \
+                                                                            \
+  product(uintx, G1EvacPrefetchBatchSize, 0,                                \
+          "Evacuation pops up to this many references from the local "      \
+          "task queue at once and prefetches their objects before copying " \
+          "them. 0 or 1 disables the batching")                             \
+                                                                            \
+  product(bool, G1PurgeClassLoaderDataConcurrently, false,                  \
+          "With ClassUnloadingWithConcurrentMark, delete the class loader " \
+          "data and metaspaces unloaded by the remark pause in a "          \
+          "concurrent phase instead of the cleanup pause")                  \
+                                                                            \
+  product(bool, G1UseAdaptiveIHOP, false,                                   \
+          "Adaptively set the concurrent marking start threshold from the " \
+          "predicted old generation allocation rate and marking cycle "     \
+          "duration instead of using InitiatingHeapOccupancyPercent, "      \
+          "aiming to complete marking before eating into G1ReservePercent") \
+                                                                            \
+  product(bool, G1UseCardSummary, false,                                    \
+          "Summarize the cards refined since the last pause per block and " \
+          "region, and skip unrefined blocks when scanning the remembered " \
+          "sets of young regions")                                          \
+                                                                            \
+  product(uintx, G1CardSummaryBlockSize, 2048,                              \
+          "Size in bytes of the heap blocks summarized by "                 \
+          "G1UseCardSummary. Must be a power of 2 between 512 and 2048")    \
+                                                                            \
+  product(bool, G1UseRegionPinning, false,                                  \
+          "Pin the regions of the objects accessed in JNI critical "        \
+          "sections instead of locking out garbage collections with the "   \
+          "GC locker")                                                      \
+                                                                            \
+  product(uintx, G1RegionAllocationSampleInterval, 0,                       \
+          "Sample the klass of every Nth object copied into an old region " \
+          "to tag the regions with their dominant klass for the "           \
+          "G1HeapRegionAllocationSample event. 0 disables sampling")        \
+                                                                            \
+  product(bool, G1DeduplicateUpdateBuffers, false,                          \
+          "Remove repeated cards from a full update buffer before handing " \
+          "it to concurrent refinement, and keep using the buffer if at "   \
+          "least half of it was freed")                                     \
+                                                                            \
+  product(bool, StringDeduplicationBloomFilter, false,                      \
+          "Only look up a String value in the deduplication table once a "  \
+          "Bloom filter has seen its hash before, so that values seen "     \
+          "only once never enter the table")                                \
+                                                                            \
+  product(uintx, StringDeduplicationMinHitPercent, 0,                       \
+          "Sample fewer deduplication candidates while less than this "     \
+          "percentage of the looked up strings is deduplicated. "           \
+          "0 disables the sampling")                                        \
+                                                                            \
   product(bool, MultiTenant, false,                                         \
           "Enable the multi-tenant feature.")                               \
                                                                             \
@@ -107,6 +217,10 @@
   product(bool, TenantHeapThrottling, false,                                \
           "Enable heap throttling per tenant")                              \
                                                                             \
+  product(bool, TenantFairCollectionSet, false,                             \
+          "Share the old region time budget of mixed GCs among tenants "    \
+          "in proportion to their heap limits")                             \
+                                                                            \
   product(bool, TenantCpuThrottling, false,                                 \
           "Enable cpu throttling per tenant")                               \
                                                                             \
@@ -122,9 +236,33 @@
   product(uintx, DefaultCoroutineStackSize, 128*K,                          \
           "Default size of stack that is associated with new coroutine")    \
                                                                             \
+  product(uintx, CoroutineStackCacheSize, 32,                               \
+          "Number of free coroutine stacks each thread keeps for reuse")    \
+                                                                            \
+  product(uintx, CoroutineStackGlobalCacheSize, 1024,                       \
+          "Number of free coroutine stacks kept for reuse by all threads")  \
+                                                                            \
+  product(uintx, CoroutineRootsChunkSize, 64,                               \
+          "Number of coroutines claimed at once by a parallel GC worker "   \
+          "scanning coroutine stacks")                                      \
+                                                                            \
+  product(bool, CoroutineIncrementalRootScan, false,                        \
+          "In G1 young pauses, skip parked coroutines which have not run "  \
+          "and only referred to old objects since the last pause")          \
+                                                                            \
+  product(uintx, CoroutineStackTrimIdleCleanups, 0,                         \
+          "Release the pages below the stack pointer of a coroutine "       \
+          "which stayed parked for this many safepoint cleanups. "          \
+          "0 disables it")                                                  \
+                                                                            \
   experimental(bool, UseWispMonitor, false,                                 \
           "yields to next coroutine when ObjectMonitor is contended")       \
                                                                             \
+  experimental(bool, WispMonitorHandoff, false,                             \
+          "With UseWispMonitor, hand a contended monitor directly to a "    \
+          "queued coroutine of the same carrier thread on exit instead "    \
+          "of releasing it and waking the coroutine to compete for it")     \
+                                                                            \
   experimental(bool, UseWisp2, false,                                       \
           "Enable Wisp2")                                                   \
                                                                             \
@@ -153,8 +291,436 @@
           "metaspace dump file (defaults to java_pid<pid>.mprof "           \
           "in the working directory)")                                      \
                                                                             \
+  manageable(bool, MetaspaceDumpBinary, false,                              \
+          "Write the dumps triggered by MetaspaceDumpBeforeFullGC, "        \
+          "MetaspaceDumpAfterFullGC and MetaspaceDumpOnOutOfMemoryError "   \
+          "in the compact binary format (java_pid<pid>.mbin)")              \
+                                                                            \
   diagnostic(ccstr, ClassLoaderModuleFieldName, "moduleName",               \
           "For distinguishing the instances of class loader")               \
+                                                                            \
+  product(bool, UseArrayHashCodeIntrinsics, false,                          \
+          "Use vectorized stubs for String.hashCode and "                   \
+          "Arrays.hashCode of byte, char and int arrays")                   \
+                                                                            \
+  product(bool, UseDynamicNumberOfCompilerThreads, false,                   \
+          "Start compiler threads on demand, bounded by the compile "       \
+          "queue length, free memory and free code cache, up to the "       \
+          "configured compiler thread count")                               \
+                                                                            \
+  product(bool, ReduceNumberOfCompilerThreads, true,                        \
+          "Let idle compiler threads exit and release their memory "        \
+          "when UseDynamicNumberOfCompilerThreads is on")                   \
+                                                                            \
+  diagnostic(bool, TraceCompilerThreads, false,                             \
+          "Trace dynamic starting and stopping of compiler threads")        \
+                                                                            \
+  product(uintx, ChunkPoolLimit, 0,                                         \
+          "Maximum number of bytes of free arena chunks kept in each "      \
+          "chunk pool; chunks freed beyond it go back to the OS right "     \
+          "away. 0 means no limit")                                         \
+                                                                            \
+  product(bool, UseSecondarySupersTable, false,                             \
+          "Look up secondary supers through a per-klass hash bitmap and "   \
+          "slot-ordered table instead of scanning the secondary supers "    \
+          "array, and stop updating the secondary super cache")             \
+                                                                            \
+  product(bool, UseCodeCacheSweeperThread, false,                           \
+          "Sweep the code cache on a dedicated thread instead of on the "   \
+          "compiler threads. The thread sweeps one fraction per wake-up, "  \
+          "or the whole cache when compilation is stopped")                 \
+                                                                            \
+  product(bool, ThreadLocalHandshakes, false,                               \
+          "Execute per-thread VM operations (single bias revocation, "      \
+          "single-thread stack trace, frame deoptimization) by stopping "   \
+          "only the target thread when it is blocked or in native, "        \
+          "instead of bringing all threads to a safepoint")                 \
+                                                                            \
+  product(bool, AsyncDeflateIdleMonitors, false,                            \
+          "Deflate idle monitors on the service thread while Java "         \
+          "threads run instead of at every safepoint; safepoints only "     \
+          "return the deflated monitors to the free list")                  \
+                                                                            \
+  product(uintx, AsyncDeflationInterval, 250,                               \
+          "Minimum time in ms between two passes of the async monitor "     \
+          "deflater (AsyncDeflateIdleMonitors)")                            \
+                                                                            \
+  product(bool, ParallelSafepointCleanup, false,                            \
+          "Run the safepoint cleanup tasks (monitor deflation, inline "     \
+          "cache update, nmethod marking, table rehashing) on the GC "      \
+          "worker threads when the collector provides them")                \
+                                                                            \
+  product(bool, UseLargeCodePages, false,                                   \
+          "Back the code cache with large pages (transparent huge pages "   \
+          "on Linux) even when the Java heap uses small pages. Commits "    \
+          "of the code cache are rounded up to whole large pages")          \
+                                                                            \
+  product(bool, SegmentedCodeCache, false,                                  \
+          "Split the code cache into separate heaps for non-nmethods, "     \
+          "profiled nmethods and non-profiled nmethods")                    \
+                                                                            \
+  product(uintx, NonNMethodCodeHeapSize, 0,                                 \
+          "Size of the code heap for non-nmethods with "                    \
+          "SegmentedCodeCache (0 = chosen ergonomically)")                  \
+                                                                            \
+  product(uintx, ProfiledCodeHeapSize, 0,                                   \
+          "Size of the code heap for profiled nmethods with "               \
+          "SegmentedCodeCache (0 = chosen ergonomically)")                  \
+                                                                            \
+  product(uintx, NonProfiledCodeHeapSize, 0,                                \
+          "Size of the code heap for non-profiled nmethods with "           \
+          "SegmentedCodeCache (0 = chosen ergonomically)")                  \
+                                                                            \
+  diagnostic(bool, PrintCompilerArenaUsage, false,                          \
+          "Print the peak arena memory used by each compilation")           \
+                                                                            \
+  product(bool, UseLightweightLocking, false,                               \
+          "Lock uncontended objects by pushing them onto a per-thread "     \
+          "lock stack instead of stack-locking with displaced headers; "    \
+          "disables biased locking. Only supported on x86_64 without Wisp") \
+                                                                            \
+  product(uintx, InterpreterProfileMinRate, 0,                              \
+          "Minimum rate, in invocations plus backedges per second, at "     \
+          "which a method must reach InterpreterProfileLimit to get a "     \
+          "MethodData with -XX:-TieredCompilation. Slower methods have "    \
+          "their counters halved instead (0 = no rate check)")              \
+                                                                            \
+  product(uintx, ReclaimColdMethodCountersInterval, 0,                      \
+          "Minimum time in ms between two passes that free the "            \
+          "MethodCounters of classes whose methods all stayed cold "        \
+          "(0 = never free MethodCounters)")                                \
+                                                                            \
+  product(uintx, ColdMethodCountersThreshold, 64,                           \
+          "A method whose invocation and backedge counts sum to less "      \
+          "than this is cold for ReclaimColdMethodCountersInterval")        \
+                                                                            \
+  product(bool, BatchDependentDeoptimization, false,                        \
+          "Only mark the code invalidated by a newly loaded class and "     \
+          "deoptimize it at the next safepoint or before the next class "   \
+          "initialization, so a burst of class loads needs at most one "    \
+          "VM_Deoptimize")                                                  \
+                                                                            \
+  product(bool, BiasedLockingAdaptiveThresholds, false,                     \
+          "Halve the bulk rebias and bulk revoke thresholds of a class "    \
+          "each time it is bulk rebiased, so classes that keep being "      \
+          "revoked stop being biased early. One halving is undone per "     \
+          "4 * BiasedLockingDecayTime ms without bulk operations")          \
+                                                                            \
+  product(ccstr, ArchiveClassesAtExit, NULL,                                \
+          "At VM exit, write the classes loaded by this run to "            \
+          "<file>.classlist and dump a shared archive <file> from it. "     \
+          "Classes of user-defined loaders are included when they were "    \
+          "defined from a local jar file or directory")                     \
+                                                                            \
+  product(ccstr, VerificationCacheFile, NULL,                               \
+          "Skip the split verifier for classes whose class file and "       \
+          "verification assumptions match a result recorded in this file " \
+          "by an earlier run. The file is updated at VM exit")              \
+                                                                            \
+  product(bool, PrintVerificationCache, false,                              \
+          "Print verification cache hits and stale entries")                \
+                                                                            \
+  product(uintx, SymbolTableMaxLoadFactor, 4,                               \
+          "Grow the symbol table at the next safepoint once the average "   \
+          "number of entries per bucket exceeds this value. 0 keeps the "   \
+          "table at SymbolTableSize")                                       \
+                                                                            \
+  product(uintx, StringTableMaxLoadFactor, 4,                               \
+          "Grow the string table at the next safepoint once the average "   \
+          "number of entries per bucket exceeds this value. 0 keeps the "   \
+          "table at StringTableSize")                                       \
+                                                                            \
+  product(bool, MetaspaceReleaseFreeChunks, true,                           \
+          "Return the pages of metaspace chunks freed by class unloading "  \
+          "to the operating system")                                        \
+                                                                            \
+  product(bool, MetaspaceAdaptiveChunkSizing, true,                         \
+          "Size each new metaspace chunk of a class loader after the "      \
+          "chunks it already uses, instead of switching from small to "     \
+          "medium chunks after a fixed number of small chunks")             \
+                                                                            \
+  product(bool, CMSParallelFullGC, false,                                   \
+          "Adjust pointers and compact the CMS generation with the "        \
+          "parallel GC threads when CMS falls back to a compacting "        \
+          "full collection")                                                \
+                                                                            \
+  product(bool, CMSRemarkYoungDirtyCardsOnly, false,                        \
+          "At the CMS remark, rescan only the young objects from before "   \
+          "the initial mark that are on cards dirtied since, provided no "  \
+          "young collection ran in between. Needs "                         \
+          "CMSParallelRemarkEnabled")                                       \
+                                                                            \
+  product(bool, UseAdaptiveTenuring, false,                                 \
+          "Lower the tenuring threshold of the serial and ParNew young "    \
+          "collectors to the one that minimizes the estimated cost of "     \
+          "copying between survivor spaces plus promotion, based on the "   \
+          "survival rate of each age in previous collections")              \
+                                                                            \
+  product(uintx, TenuringPromotionCost, 4,                                  \
+          "Cost of promoting a word relative to copying it once more "      \
+          "within the young generation, used by UseAdaptiveTenuring")       \
+                                                                            \
+  product(bool, UseParallelOldGCShadowRegions, false,                       \
+          "During parallel old gen compaction, let idle threads fill "      \
+          "regions that are not yet available in empty shadow regions "     \
+          "and copy them back once the regions become available")           \
+                                                                            \
+  product(bool, UseNUMAOldGen, false,                                       \
+          "With UseNUMA and the parallel collector, promote objects into "  \
+          "chunks of the old generation bound to the memory of the node "   \
+          "the promoting GC worker runs on")                                \
+                                                                            \
+  product(uintx, NUMAOldGenChunkSize, 4*M,                                  \
+          "Size in bytes of the per-node old generation chunks used by "    \
+          "UseNUMAOldGen")                                                  \
+                                                                            \
+  product(bool, PSAdaptiveCardStripeSize, false,                            \
+          "Size the old gen card stripes scanned by each parallel "         \
+          "scavenge worker from the old gen occupancy and the density "     \
+          "of non-clean cards seen by the previous scavenge")               \
+                                                                            \
+  product(bool, UseNUMATaskStealing, false,                                 \
+          "With UseNUMA, let GC worker threads steal from the task queues " \
+          "of workers on the same node before trying any queue")            \
+                                                                            \
+  product(uintx, ReferencesPerThread, 0,                                    \
+          "Number of discovered references per worker thread that a "       \
+          "parallel reference processing phase is sized by; 0 uses all "    \
+          "active workers for every phase")                                 \
+                                                                            \
+  manageable(uintx, HeapDumpParallelThreads, 0,                             \
+          "Number of worker threads that write the objects of a heap dump " \
+          "into segment files of their own, merged at the end of the "      \
+          "dump; 0 or 1 dumps the heap with the VM thread only")            \
+                                                                            \
+  manageable(uintx, HeapDumpGzipLevel, 0,                                   \
+          "When positive, compress heap dumps with gzip at this level "     \
+          "(1-9) while the parts of the dump are merged")                   \
+                                                                            \
+  manageable(bool, HeapDumpDeferredMerge, false,                            \
+          "Merge and compress the parts of a heap dump in the requesting "  \
+          "thread after the safepoint instead of during it")                \
+                                                                            \
+  manageable(bool, HeapDumpFork, false,                                     \
+          "On Linux, write heap dumps requested by Java threads from a "    \
+          "forked copy of the VM, so that the application resumes as "      \
+          "soon as the fork returns")                                       \
+                                                                            \
+  product(uintx, NMTDetailSampleBytes, 0,                                   \
+          "In NativeMemoryTracking=detail mode, walk and record the call "  \
+          "stacks of a sample of one malloc per this many bytes, weighted " \
+          "by the interval; 0 records every malloc")                        \
+                                                                            \
+  product(uintx, NMTResidentSampleInterval, 0,                              \
+          "With NativeMemoryTracking, measure every this many "             \
+          "milliseconds how much of the committed virtual memory of "       \
+          "each region is resident, and report it; 0 disables")             \
+                                                                            \
+  product(uintx, PerfThreadTableSize, 0,                                    \
+          "Export the allocated bytes, CPU time and state of up to this "   \
+          "many Java threads as a table in the PerfData memory; "           \
+          "0 disables")                                                     \
+                                                                            \
+  product(uintx, PerfThreadTableInterval, 1000,                             \
+          "Milliseconds between refreshes of the PerfThreadTableSize "      \
+          "table")                                                          \
+                                                                            \
+  product(bool, PerfDataHistograms, false,                                  \
+          "Record GC pause, safepoint and allocation stall latency "        \
+          "histograms in the PerfData memory (requires UsePerfData)")       \
+                                                                            \
+  product(uintx, ParallelThreadDumpThreshold, 0,                            \
+          "Walk the thread stacks of a thread dump in parallel with the "   \
+          "safepoint workers when it covers at least this many threads; "   \
+          "0 disables")                                                     \
+                                                                            \
+  product(uintx, ObjectProfilerSampleBytes, 0,                              \
+          "Sample object allocations once per this many bytes allocated "   \
+          "by a thread, using TLAB sample points instead of per-"           \
+          "allocation checks in compiled code; 0 samples by count")         \
+                                                                            \
+  product(uintx, ActiveProcessorCountPollInterval, 0,                       \
+          "Re-read the active processor count (cgroup cpu quota and "       \
+          "shares) every this many milliseconds and cap GC worker and "     \
+          "compiler thread counts accordingly; 0 disables")                 \
+                                                                            \
+  product(uintx, G1MemoryPressurePollInterval, 0,                           \
+          "Milliseconds between reads of the cgroup memory usage and "      \
+          "memory pressure; under pressure the soft max heap size is "      \
+          "lowered and free regions are uncommitted (Linux containers "     \
+          "only). 0 disables the polling")                                  \
+                                                                            \
+  product(uintx, G1MemoryPressureThreshold, 10,                             \
+          "Percentage of time stalled on memory (avg10 of the cgroup "      \
+          "memory.pressure) above which the heap is shrunk")                \
+                                                                            \
+  product(bool, TLABFastResize, false,                                      \
+          "Grow the TLAB of a thread between GCs when it refills more "     \
+          "often than the eden consumed so far predicts, instead of only "  \
+          "resizing at GC time (needs ResizeTLAB)")                         \
+                                                                            \
+  product(bool, G1TransparentHugePageCommit, false,                         \
+          "Commit, pre-touch and uncommit the G1 heap in units of the "     \
+          "transparent huge page size and madvise it for huge pages, "      \
+          "without requiring UseTransparentHugePages")                      \
+                                                                            \
+  product(uintx, PreTouchParallelChunkSize, 4 * M,                          \
+          "Size of the chunks the G1 heap is pre-touched in by each "       \
+          "worker thread when AlwaysPreTouch is set")                       \
+                                                                            \
+  product(bool, PreTouchCodeCache, false,                                   \
+          "Commit and pre-touch the whole code cache at startup")           \
+                                                                            \
+  product(bool, PreTouchCompressedClassSpace, false,                        \
+          "Commit and pre-touch the whole compressed class space at "       \
+          "startup")                                                        \
+                                                                            \
+  product(bool, AsyncGCLog, false,                                          \
+          "Write the -Xloggc file on a background thread so that no "       \
+          "GC or VM thread waits for disk I/O")                             \
+                                                                            \
+  product(uintx, AsyncGCLogBufferSize, 2 * M,                               \
+          "Size of the buffer of AsyncGCLog; text that does not fit "       \
+          "into a full buffer is dropped")                                  \
+                                                                            \
+  product(bool, UseMembarrierSerialization, false,                          \
+          "Linux only: without UseMembar, serialize thread states for "     \
+          "safepoints with membarrier(2) instead of changing the "          \
+          "protection of the memory serialize page")                        \
+                                                                            \
+  product(uintx, JavaThreadPoolSize, 0,                                     \
+          "Linux only: number of pthreads of exited java threads kept "     \
+          "to run newly started java threads (0 = disabled)")               \
+                                                                            \
+  product(uintx, JavaThreadPoolKeepAlive, 60000,                            \
+          "Milliseconds a pooled pthread waits for a new java thread "      \
+          "before it exits")                                                \
+                                                                            \
+  product(uintx, NonTemporalStoreThreshold, 0,                              \
+          "x86 only: C2 ClearArray, the fill stubs and the disjoint "       \
+          "arraycopy stubs use non-temporal stores for blocks of at least " \
+          "this many bytes (0 = never)")                                    \
+                                                                            \
+  product(bool, UseCharsetArrayCoderIntrinsics, false,                      \
+          "Intrinsify the UTF-8 and ISO-8859-1 array decoders and the "     \
+          "UTF-8 array encoder with a word-at-a-time ASCII fast path")      \
+                                                                            \
+  product(bool, UseZeroBasedCompressedClassSpace, false,                    \
+          "Without CDS, reserve the compressed class space below 32G "      \
+          "when the heap is too high for a zero narrow klass base")         \
+                                                                            \
+  product(ccstr, FieldLayoutProfileFile, NULL,                              \
+          "Lay out the hottest instance fields recorded in this field "     \
+          "layout profile first, next to the object header")                \
+                                                                            \
+  product(ccstr, DumpFieldLayoutProfileAtExit, NULL,                        \
+          "Write a field layout profile of the loaded classes to this "     \
+          "file at exit")                                                   \
+                                                                            \
+  product(bool, TenantCpuBudgeting, false,                                  \
+          "Account the CPU time of Wisp coroutines to their tenants at "    \
+          "every coroutine switch and track per-tenant CPU limits for "     \
+          "the Wisp scheduler")                                             \
+                                                                            \
+  product(uintx, TenantCpuBudgetPeriod, 100,                                \
+          "Length in milliseconds of the periods per-tenant CPU limits "    \
+          "apply to")                                                       \
+                                                                            \
+  product(bool, TenantHeapByteAccounting, false,                            \
+          "Throttle tenant heap usage by the bytes the tenant uses "        \
+          "instead of the number of regions it occupies")                   \
+                                                                            \
+  product(bool, TrivialJNINatives, false,                                   \
+          "Call the JavaTrivial_ entry of a critical native without the "   \
+          "transition to native, safepoints wait for it to return. "        \
+          "Only for very short natives; x86_64 only")                       \
+                                                                            \
+  product(bool, JvmtiSelectiveMethodTrace, false,                           \
+          "Post JVMTI MethodEntry and MethodExit only for the methods "     \
+          "selected with -XX:CompileCommand=option,<method>,JvmtiTrace, "   \
+          "without interpreter-only mode. Selected methods run "            \
+          "interpreted while the events are enabled, other code stays "     \
+          "compiled; x86_64 only")                                          \
+                                                                            \
+  product(uintx, ItableHashMinInterfaces, 8,                                \
+          "Append a hashed interface index to the itable of classes that "  \
+          "implement at least this many interfaces, so that megamorphic "   \
+          "interface calls do not scan the itable linearly; 0 disables. "   \
+          "x86_64 only")                                                    \
+                                                                            \
+  product(uintx, AnonymousClassesPerCLD, 1,                                 \
+          "Number of anonymous classes (lambda forms, lambda proxies) of "  \
+          "the boot, extension and system loaders that share one class "    \
+          "loader data. A shared one is unloaded only once all its "        \
+          "classes are unreachable; 1 gives every class its own")           \
+                                                                            \
+  product(bool, UseVMReflectionInvoker, false,                              \
+          "Keep Method.invoke and Constructor.newInstance on the VM "       \
+          "invoker instead of generating an accessor class per method "     \
+          "after sun.reflect.inflationThreshold calls, and select "         \
+          "interface targets through the itable")                           \
+                                                                            \
+  product(bool, UseUnsafeMemoryIntrinsics, false,                           \
+          "Use stubs for Unsafe.vectorizedMismatch and Unsafe.hash and "    \
+          "inline off-heap Unsafe.copyMemory of a small constant size; "    \
+          "x86_64 only")                                                    \
+                                                                            \
+  product(bool, GCBinaryEventLog, false,                                    \
+          "With AsyncGCLog, record the G1 pause phase times as binary "     \
+          "records that the writer thread formats, instead of "             \
+          "formatting them inside the pause")                               \
+                                                                            \
+  product(bool, ParallelVMInit, false,                                      \
+          "Generate the second phase of the StubRoutines on a helper "      \
+          "thread while create_vm loads and links the core classes; "       \
+          "ignored with JVMTI agents or PrintStubCode")                     \
+                                                                            \
+  product(bool, LazyStubGeneration, false,                                  \
+          "Generate the AES, GHASH, BigInteger, array hash code and "       \
+          "Unsafe memory intrinsic stubs when a compiler first uses "       \
+          "them instead of at startup; x86_64 only")                        \
+                                                                            \
+  product(bool, PurgeClassLoaderDataConcurrently, false,                    \
+          "With the Serial, Parallel and CMS collectors, delete the "       \
+          "class loader data and metaspaces unloaded by a collection "      \
+          "on a background thread instead of in the safepoint")             \
+                                                                            \
+  product(bool, UseG1FreeRangeIndex, false,                                 \
+          "Keep an index of the runs of free and uncommitted G1 regions "   \
+          "so that humongous allocations find contiguous regions in "       \
+          "logarithmic time instead of scanning all regions")               \
+                                                                            \
+  product(bool, G1ConcRefinementTargetUpdateRSTime, false,                  \
+          "With G1UseAdaptiveConcRefinement, size the green zone from "     \
+          "the measured update RS time per buffer so that the buffers "     \
+          "left for a pause take G1RSetUpdatingPauseTimePercent of the "    \
+          "pause time goal, moving halfway to that size per pause")         \
+                                                                            \
+  product(uintx, G1ConcRefinementMaxCPUPercent, 100,                        \
+          "Upper bound on the concurrent refinement threads running at "    \
+          "the same time, as a percentage of the processors available to "  \
+          "the VM including the container CPU quota. At least one thread "  \
+          "may run. 100 means no bound")                                    \
+                                                                            \
+  product(ccstr, CompiledCodeCacheFile, NULL,                               \
+          "Install C2 code recorded in this file by an earlier run of the " \
+          "same VM with the same flags instead of compiling a method, if "  \
+          "the classes it was compiled against are unchanged. The file is " \
+          "updated at VM exit. Only supported on x86_64")                   \
+                                                                            \
+  product(bool, PrintCompiledCodeCache, false,                              \
+          "Print methods installed from and recorded in the compiled "      \
+          "code cache")                                                     \
+                                                                            \
+  product(bool, ThreadLocalSafepointPolls, false,                           \
+          "Poll for safepoints through a poll word of the current thread "  \
+          "that is armed per thread, instead of a global polling page "     \
+          "that is protected for every safepoint (x86_64 only)")            \
+                                                                            \
+  product(bool, UseGCTaskStealing, false,                                   \
+          "Parallel GC: give each GC worker its own task queue, filled by " \
+          "affinity or round-robin, and let idle workers steal from the "   \
+          "queues of other workers")                                        \
 
   //add new AJVM specific flags here
 
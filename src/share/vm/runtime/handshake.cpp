@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+
+// Number of times the requester re-publishes the request when it catches
+// the target in a transition state before giving up.
+static const int handshake_attempts = 3;
+
+// A target that is blocked or in native with a walkable stack cannot
+// leave that state without seeing the pending request.
+static bool is_handshake_safe(JavaThread* target) {
+  JavaThreadState state = target->thread_state();
+  if (state != _thread_blocked && state != _thread_in_native) {
+    return false;
+  }
+  return !target->has_last_Java_frame() || target->frame_anchor()->walkable();
+}
+
+bool Handshake::try_execute(HandshakeClosure* cl, JavaThread* target) {
+  if (!ThreadLocalHandshakes) {
+    return false;
+  }
+  Thread* self = Thread::current();
+  if (target == self) {
+    cl->do_thread(target);
+    return true;
+  }
+  // Wisp coroutines may switch the stack of a blocked carrier thread.
+  if (EnableCoroutine) {
+    return false;
+  }
+  assert(!SafepointSynchronize::is_at_safepoint(), "use the safepoint operation instead");
+
+  // Holding Threads_lock keeps the target alive and keeps safepoints
+  // from starting while the target is stopped.
+  MutexLocker ml(Threads_lock);
+  if (!Threads::includes(target) || target->is_exiting()) {
+    return false;
+  }
+
+  bool executed = false;
+  for (int i = 0; i < handshake_attempts && !executed; i++) {
+    target->set_handshake_pending();
+    // Make the request visible before reading the target's state; pairs
+    // with the fence or serialization page write in the state transitions.
+    if (os::is_MP()) {
+      if (UseMembar) {
+        OrderAccess::fence();
+      } else {
+        os::serialize_thread_states();
+      }
+    }
+    if (is_handshake_safe(target)) {
+      if (TraceSafepoint) {
+        ResourceMark rm;
+        tty->print_cr("Handshake \"%s\" on thread " INTPTR_FORMAT " (%s)",
+                      cl->name(), p2i(target), target->get_thread_name());
+      }
+      cl->do_thread(target);
+      executed = true;
+    }
+    target->clear_handshake_pending();
+  }
+  return executed;
+}
+
+void Handshake::block(JavaThread* thread) {
+  assert((thread->thread_state() & 1) == 1, "must be in a transition state");
+  int spins = 0;
+  while (thread->has_handshake_pending()) {
+    if (++spins < 1000) {
+      SpinPause();
+    } else {
+      os::NakedYield();
+    }
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_HANDSHAKE_HPP
+#define SHARE_VM_RUNTIME_HANDSHAKE_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/thread.hpp"
+
+// A handshake is a per-thread operation executed while only the target
+// JavaThread is held still, instead of stopping all threads at a safepoint.
+//
+// The requesting thread publishes a handshake request in the target's
+// suspend flags and then checks the target's thread state. A target that
+// is blocked or in native with a walkable stack cannot touch its own
+// frames or oops until it transitions back, and the transition code spins
+// in Handshake::block() while the request is pending, so the closure can
+// run on the requesting thread. A target running Java code or in the VM
+// only polls for safepoints; in that case try_execute() fails and the
+// caller falls back to its VM operation. With ThreadLocalSafepointPolls
+// the poll of a single thread can be armed (SafepointSynchronize::arm_poll),
+// which is where stopping such a target would start.
+//
+// Threads_lock is held for the duration of the handshake, which keeps the
+// target from exiting and keeps safepoints from starting. The closure must
+// therefore not block, check for safepoints or allocate Java objects.
+class HandshakeClosure : public ThreadClosure {
+ private:
+  const char* _name;
+ public:
+  HandshakeClosure(const char* name) : _name(name) {}
+  const char* name() const { return _name; }
+  // Called with the target thread stopped.
+  virtual void do_thread(Thread* thread) = 0;
+};
+
+class Handshake : public AllStatic {
+ public:
+  // Execute cl on target if it can be stopped without a safepoint.
+  // Returns false if the handshake was not performed.
+  static bool try_execute(HandshakeClosure* cl, JavaThread* target);
+
+  // Called by a thread leaving the blocked or native state that finds a
+  // handshake request pending on itself.
+  static void block(JavaThread* thread);
+};
+
+#endif // SHARE_VM_RUNTIME_HANDSHAKE_HPP
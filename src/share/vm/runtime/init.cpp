@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/icBuffer.hpp"
 #include "gc_interface/collectedHeap.hpp"
@@ -35,6 +36,7 @@
 #include "runtime/init.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/timer.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/macros.hpp"
 
@@ -76,6 +78,7 @@ void compileBroker_init();
 bool universe_post_init();  // must happen after compiler_init
 void javaClasses_init();  // must happen after vtable initialization
 void stubRoutines_init2(); // note: StubRoutines need 2-phase init
+void stubRoutines_init2_in_background(); // with ParallelVMInit
 
 // Do not disable thread-local-storage, as it is important for some
 // JNI/JVM/JVMTI functions and signal handlers to work properly
@@ -98,16 +101,23 @@ jint init_globals() {
   management_init();
   bytecodes_init();
   classLoader_init();
+  FieldLayoutProfile::initialize();  // before any classes are parsed
   codeCache_init();
   VM_Version_init();
   os_init_globals();
   stubRoutines_init1();
-  jint status = universe_init();  // dependent on codeCache_init and
-                                  // stubRoutines_init1 and metaspace_init.
+  jint status;
+  {
+    TraceTime timer("Universe initialization", TraceStartupTime);
+    status = universe_init();  // dependent on codeCache_init and
+                               // stubRoutines_init1 and metaspace_init.
+  }
   if (status != JNI_OK)
     return status;
+  stubRoutines_init2_in_background(); // joined by stubRoutines_init2
 
   if (CompilationWarmUpRecording) {
+    TraceTime timer("JWarmUp initialization", TraceStartupTime);
     JitWarmUp* jwp = JitWarmUp::create_instance();
     jwp->init_for_recording();
     if (!jwp->is_valid()) {
@@ -123,6 +133,7 @@ jint init_globals() {
   InterfaceSupport_init();
   SharedRuntime::generate_stubs();
   if (CompilationWarmUp) {
+    TraceTime timer("JWarmUp initialization", TraceStartupTime);
     JitWarmUp* jwp = JitWarmUp::create_instance();
       jwp->init_for_warmup();
     if (!jwp->is_valid()) {
@@ -130,7 +141,10 @@ jint init_globals() {
       vm_exit(-1);
     }
   }
-  universe2_init();  // dependent on codeCache_init and stubRoutines_init1
+  {
+    TraceTime timer("Universe2 initialization", TraceStartupTime);
+    universe2_init();  // dependent on codeCache_init and stubRoutines_init1
+  }
   referenceProcessor_init();
   jni_handles_init();
 #if INCLUDE_VM_STRUCTS
@@ -141,11 +155,17 @@ jint init_globals() {
   InlineCacheBuffer_init();
   compilerOracle_init();
   compilationPolicy_init();
-  compileBroker_init();
+  {
+    TraceTime timer("Compiler initialization", TraceStartupTime);
+    compileBroker_init();
+  }
   VMRegImpl::set_regName();
 
-  if (!universe_post_init()) {
-    return JNI_ERR;
+  {
+    TraceTime timer("Universe post initialization", TraceStartupTime);
+    if (!universe_post_init()) {
+      return JNI_ERR;
+    }
   }
   javaClasses_init();   // must happen after vtable initialization
   stubRoutines_init2(); // note: StubRoutines need 2-phase init
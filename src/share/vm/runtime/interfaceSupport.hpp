@@ -27,6 +27,7 @@
 
 #include "memory/gcLocker.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/coroutine.hpp"
 #include "runtime/orderAccess.hpp"
@@ -156,6 +157,9 @@ class ThreadStateTransition : public StackObj {
     if (SafepointSynchronize::do_call_back()) {
       SafepointSynchronize::block(thread);
     }
+    if (thread->has_handshake_pending()) {
+      Handshake::block(thread);
+    }
     thread->set_thread_state(to);
 
     CHECK_UNHANDLED_OOPS_ONLY(thread->clear_unhandled_oops();)
@@ -190,6 +194,9 @@ class ThreadStateTransition : public StackObj {
     if (SafepointSynchronize::do_call_back()) {
       SafepointSynchronize::block(thread);
     }
+    if (thread->has_handshake_pending()) {
+      Handshake::block(thread);
+    }
     thread->set_thread_state(to);
 
     CHECK_UNHANDLED_OOPS_ONLY(thread->clear_unhandled_oops();)
@@ -24,15 +24,19 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/fieldLayoutProfile.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "classfile/verificationCache.hpp"
 #include "code/codeCache.hpp"
+#include "code/compiledCodeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/support/jfrThreadId.hpp"
 #include "memory/genCollectedHeap.hpp"
+#include "memory/metaspaceShared.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/universe.hpp"
 #include "oops/constantPool.hpp"
@@ -45,6 +49,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/deoptimization.hpp"
@@ -494,6 +499,24 @@ void before_exit(JavaThread * thread) {
     os::infinite_sleep();
   }
 
+#if INCLUDE_CDS
+  if (ArchiveClassesAtExit != NULL) {
+    MetaspaceShared::dump_loaded_classes(ArchiveClassesAtExit, tty);
+  }
+#endif
+
+  if (VerificationCache::is_enabled()) {
+    VerificationCache::write();
+  }
+
+  if (CompiledCodeCache::is_enabled()) {
+    CompiledCodeCache::write();
+  }
+
+  if (DumpFieldLayoutProfileAtExit != NULL) {
+    FieldLayoutProfile::dump(DumpFieldLayoutProfileAtExit);
+  }
+
   // Terminate watcher thread - must before disenrolling any periodic task
   if (PeriodicTask::num_tasks() > 0)
     WatcherThread::stop();
@@ -520,6 +543,9 @@ void before_exit(JavaThread * thread) {
     }
   }
 
+  // Write out the buffered GC log; later writes are synchronous.
+  AsyncGCLogWriter::stop();
+
   if (PrintBytecodeHistogram) {
     BytecodeHistogram::print();
   }
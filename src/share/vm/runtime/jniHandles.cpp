@@ -25,8 +25,10 @@
 #include "precompiled.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "memory/iterator.hpp"
+#include "memory/sharedHeap.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
@@ -36,11 +38,21 @@
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
-JNIHandleBlock* JNIHandles::_global_handles       = NULL;
-JNIHandleBlock* JNIHandles::_weak_global_handles  = NULL;
+JNIHandleBlock* JNIHandles::_global_handles[JNIHandles::global_stripes]      = { NULL };
+JNIHandleBlock* JNIHandles::_weak_global_handles[JNIHandles::global_stripes] = { NULL };
+Mutex*          JNIHandles::_global_locks[JNIHandles::global_stripes]        = { NULL };
+volatile jint   JNIHandles::_stripe_claims[JNIHandles::global_stripes]       = { 0 };
+jint            JNIHandles::_scan_epoch           = 0;
 oop             JNIHandles::_deleted_handle       = NULL;
 
 
+inline uint JNIHandles::stripe_for(Thread* thread) {
+  // Fibonacci hashing of the thread address; the top bits are well mixed.
+  juint h = (juint)((uintptr_t)thread >> LogBytesPerWord) * 0x9E3779B1u;
+  return h >> (BitsPerInt - global_stripe_bits);
+}
+
+
 jobject JNIHandles::make_local(oop obj) {
   if (obj == NULL) {
     return NULL;                // ignore null handles
@@ -80,9 +92,10 @@ jobject JNIHandles::make_global(Handle obj) {
   jobject res = NULL;
   if (!obj.is_null()) {
     // ignore null handles
-    MutexLocker ml(JNIGlobalHandle_lock);
+    uint stripe = stripe_for(Thread::current());
+    MutexLocker ml(_global_locks[stripe]);
     assert(Universe::heap()->is_in_reserved(obj()), "sanity check");
-    res = _global_handles->allocate_handle(obj());
+    res = _global_handles[stripe]->allocate_handle(obj());
   } else {
     CHECK_UNHANDLED_OOPS_ONLY(Thread::current()->clear_unhandled_oops());
   }
@@ -96,9 +109,10 @@ jobject JNIHandles::make_weak_global(Handle obj) {
   if (!obj.is_null()) {
     // ignore null handles
     {
-      MutexLocker ml(JNIGlobalHandle_lock);
+      uint stripe = stripe_for(Thread::current());
+      MutexLocker ml(_global_locks[stripe]);
       assert(Universe::heap()->is_in_reserved(obj()), "sanity check");
-      res = _weak_global_handles->allocate_handle(obj());
+      res = _weak_global_handles[stripe]->allocate_handle(obj());
     }
     // Add weak tag.
     assert(is_ptr_aligned(res, weak_tag_alignment), "invariant");
@@ -142,12 +156,42 @@ void JNIHandles::destroy_weak_global(jobject handle) {
 
 void JNIHandles::oops_do(OopClosure* f) {
   f->do_oop(&_deleted_handle);
-  _global_handles->oops_do(f);
+  for (int i = 0; i < global_stripes; i++) {
+    _global_handles[i]->oops_do(f);
+  }
+}
+
+
+void JNIHandles::possibly_parallel_oops_do(OopClosure* f) {
+  if (SharedHeap::heap()->n_par_threads() == 0) {
+    oops_do(f);
+    return;
+  }
+  jint epoch = _scan_epoch;
+  for (int i = 0; i < global_stripes; i++) {
+    jint claim = _stripe_claims[i];
+    if (claim != epoch &&
+        Atomic::cmpxchg(epoch, &_stripe_claims[i], claim) == claim) {
+      if (i == 0) {
+        f->do_oop(&_deleted_handle);
+      }
+      _global_handles[i]->oops_do(f);
+    }
+  }
+}
+
+
+void JNIHandles::change_claim_epoch() {
+  // Epochs only need to differ from the previous one; skip 0, which is the
+  // initial value of every claim.
+  _scan_epoch = (_scan_epoch == max_jint) ? 1 : _scan_epoch + 1;
 }
 
 
 void JNIHandles::weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f) {
-  _weak_global_handles->weak_oops_do(is_alive, f);
+  for (int i = 0; i < global_stripes; i++) {
+    _weak_global_handles[i]->weak_oops_do(is_alive, f);
+  }
 }
 
 
@@ -158,8 +202,11 @@ void JNIHandles::weak_oops_do(OopClosure* f) {
 
 
 void JNIHandles::initialize() {
-  _global_handles      = JNIHandleBlock::allocate_block();
-  _weak_global_handles = JNIHandleBlock::allocate_block();
+  for (int i = 0; i < global_stripes; i++) {
+    _global_handles[i]      = JNIHandleBlock::allocate_block();
+    _weak_global_handles[i] = JNIHandleBlock::allocate_block();
+    _global_locks[i]        = new Mutex(Mutex::nonleaf, "JNIGlobalHandle_lock", true);
+  }
   EXCEPTION_MARK;
   // We will never reach the CATCH below since Exceptions::_throw will cause
   // the VM to exit if an exception is thrown during initialization
@@ -197,20 +244,38 @@ bool JNIHandles::is_frame_handle(JavaThread* thr, jobject obj) {
 
 
 bool JNIHandles::is_global_handle(jobject handle) {
-  return _global_handles->chain_contains(handle);
+  for (int i = 0; i < global_stripes; i++) {
+    if (_global_handles[i]->chain_contains(handle)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 
 bool JNIHandles::is_weak_global_handle(jobject handle) {
-  return _weak_global_handles->chain_contains(handle);
+  for (int i = 0; i < global_stripes; i++) {
+    if (_weak_global_handles[i]->chain_contains(handle)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 long JNIHandles::global_handle_memory_usage() {
-  return _global_handles->memory_usage();
+  long usage = 0;
+  for (int i = 0; i < global_stripes; i++) {
+    usage += _global_handles[i]->memory_usage();
+  }
+  return usage;
 }
 
 long JNIHandles::weak_global_handle_memory_usage() {
-  return _weak_global_handles->memory_usage();
+  long usage = 0;
+  for (int i = 0; i < global_stripes; i++) {
+    usage += _weak_global_handles[i]->memory_usage();
+  }
+  return usage;
 }
 
 
@@ -231,7 +296,7 @@ public:
 // We assume this is called at a safepoint: no lock is needed.
 void JNIHandles::print_on(outputStream* st) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
-  assert(_global_handles != NULL && _weak_global_handles != NULL,
+  assert(_global_handles[0] != NULL && _weak_global_handles[0] != NULL,
          "JNIHandles not initialized");
 
   CountHandleClosure global_handle_count;
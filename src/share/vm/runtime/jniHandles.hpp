@@ -29,6 +29,7 @@
 #include "utilities/top.hpp"
 
 class JNIHandleBlock;
+class Mutex;
 
 
 // Interface for creating and resolving local/global JNI handles
@@ -36,10 +37,25 @@ class JNIHandleBlock;
 class JNIHandles : AllStatic {
   friend class VMStructs;
  private:
-  static JNIHandleBlock* _global_handles;             // First global handle block
-  static JNIHandleBlock* _weak_global_handles;        // First weak global handle block
+  // Global and weak global handles are spread over several block chains
+  // ("stripes"), each guarded by its own lock. A thread always allocates
+  // in the stripe selected by hashing its address, so threads creating
+  // global refs concurrently rarely contend, and GC workers can scan the
+  // strong stripes in parallel.
+  enum {
+    global_stripe_bits = 4,
+    global_stripes     = 1 << global_stripe_bits
+  };
+
+  static JNIHandleBlock* _global_handles[global_stripes];      // First global handle block of each stripe
+  static JNIHandleBlock* _weak_global_handles[global_stripes]; // First weak global handle block of each stripe
+  static Mutex*          _global_locks[global_stripes];        // Serializes allocation within a stripe
+  static volatile jint   _stripe_claims[global_stripes];       // Scan epoch that last claimed each stripe
+  static jint            _scan_epoch;                          // Current parallel root scan
   static oop _deleted_handle;                         // Sentinel marking deleted handles
 
+  inline static uint stripe_for(Thread* thread);
+
   inline static bool is_jweak(jobject handle);
   inline static oop& jobject_ref(jobject handle); // NOT jweak!
   inline static oop& jweak_ref(jobject handle);
@@ -105,6 +121,12 @@ class JNIHandles : AllStatic {
   // Garbage collection support(global handles only, local handles are traversed from thread)
   // Traversal of regular global handles
   static void oops_do(OopClosure* f);
+  // Traversal of regular global handles by several GC workers; each stripe
+  // is visited by the worker that claims it in the current scan epoch.
+  // Falls back to oops_do when the heap is not scanning in parallel.
+  static void possibly_parallel_oops_do(OopClosure* f);
+  // Make all stripes claimable again, called once per strong roots scope.
+  static void change_claim_epoch();
   // Traversal of weak global handles. Unreachable oops are cleared.
   static void weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f);
   // Traversal of weak global handles.
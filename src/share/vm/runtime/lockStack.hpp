@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2023, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_LOCKSTACK_HPP
+#define SHARE_VM_RUNTIME_LOCKSTACK_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/sizes.hpp"
+
+class OopClosure;
+class outputStream;
+
+// With UseLightweightLocking a thread that locks an uncontended object only
+// flips the lock bits of the mark word to 00 and pushes the object onto its
+// lock stack. The mark word keeps the hash and age, so there is no displaced
+// header and nothing on the Java stack refers to the lock: frames holding
+// lightweight locks can be moved, copied or deoptimized without fixing up
+// the object. Ownership of a fast-locked object is determined by searching
+// the lock stacks, which only the owning thread modifies.
+//
+// A recursive enter, a full lock stack, contention, wait() and hashing of an
+// object without a hash inflate the lock to an ObjectMonitor. A monitor
+// inflated by a thread other than the owner has an anonymous owner until the
+// owner fixes it up, see ObjectSynchronizer::inflate().
+//
+// The lock stack is embedded in JavaThread. The interpreter and the compilers
+// access _top and _base directly; see MacroAssembler::lightweight_lock().
+class LockStack VALUE_OBJ_CLASS_SPEC {
+  friend class VMStructs;
+ public:
+  static const int CAPACITY = 8;
+
+ private:
+  // Number of entries in use; the next free slot is _base[_top].
+  int _top;
+  oop _base[CAPACITY];
+
+ public:
+  LockStack() : _top(0) {}
+
+  static ByteSize top_offset()  { return byte_offset_of(LockStack, _top); }
+  static ByteSize base_offset() { return byte_offset_of(LockStack, _base); }
+
+  bool is_empty() const  { return _top == 0; }
+  bool can_push() const  { return _top < CAPACITY; }
+  int  size() const      { return _top; }
+
+  void push(oop o) {
+    assert(can_push(), "lock stack overflow");
+    assert(!contains(o), "entries must be unique");
+    _base[_top++] = o;
+  }
+
+  oop pop() {
+    assert(!is_empty(), "lock stack underflow");
+    oop o = _base[--_top];
+    _base[_top] = NULL;
+    return o;
+  }
+
+  // Removes o from anywhere in the stack. Unlocking is usually LIFO, but
+  // JNI, deoptimization and inflation may release entries out of order.
+  void remove(oop o) {
+    for (int i = _top - 1; i >= 0; i--) {
+      if (_base[i] == o) {
+        for (int j = i; j < _top - 1; j++) {
+          _base[j] = _base[j + 1];
+        }
+        _base[--_top] = NULL;
+        return;
+      }
+    }
+    assert(false, "object not on lock stack");
+  }
+
+  bool contains(oop o) const {
+    for (int i = _top - 1; i >= 0; i--) {
+      if (_base[i] == o) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // GC support
+  void oops_do(OopClosure* f);
+
+  void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_VM_RUNTIME_LOCKSTACK_HPP
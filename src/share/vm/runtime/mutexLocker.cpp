@@ -42,11 +42,14 @@ Monitor* SystemDictionary_monitor_lock= NULL;
 Mutex*   ProfileRecorder_lock         = NULL;
 Mutex*   PreloadClassChain_lock       = NULL;
 Mutex*   JitWarmUpPrint_lock          = NULL;
+Mutex*   VerificationCache_lock       = NULL;
+Mutex*   CompiledCodeCache_lock       = NULL;
+Mutex*   MetaspaceDump_lock           = NULL;
+Mutex*   AnonymousCLD_lock            = NULL;
 Mutex*   PackageTable_lock            = NULL;
 Mutex*   CompiledIC_lock              = NULL;
 Mutex*   InlineCacheBuffer_lock       = NULL;
 Mutex*   VMStatistic_lock             = NULL;
-Mutex*   JNIGlobalHandle_lock         = NULL;
 Mutex*   JNIHandleBlockFreeList_lock  = NULL;
 Mutex*   MemberNameTable_lock         = NULL;
 Mutex*   JmethodIdCreation_lock       = NULL;
@@ -85,7 +88,6 @@ Mutex*   DirtyCardQ_FL_lock           = NULL;
 Monitor* DirtyCardQ_CBL_mon           = NULL;
 Mutex*   Shared_DirtyCardQ_lock       = NULL;
 Mutex*   ParGCRareEvent_lock          = NULL;
-Mutex*   EvacFailureStack_lock        = NULL;
 Mutex*   DerivedPointerTableGC_lock   = NULL;
 Mutex*   Compile_lock                 = NULL;
 Monitor* MethodCompileQueue_lock      = NULL;
@@ -127,6 +129,7 @@ Monitor* GCTaskManager_lock           = NULL;
 
 Mutex*   Management_lock              = NULL;
 Monitor* Service_lock                 = NULL;
+Monitor* CodeSweeper_lock             = NULL;
 Monitor* PeriodicTask_lock            = NULL;
 Monitor* RedefineClasses_lock         = NULL;
 
@@ -149,6 +152,7 @@ Mutex*   UnsafeJlong_lock             = NULL;
 SystemDictMonitor* SystemDictionary_lock = NULL;
 
 Monitor* Wisp_lock                    = NULL;
+Mutex*   CoroutineStackCache_lock     = NULL;
 
 #define MAX_NUM_MUTEX 128
 static Monitor * _mutex_array[MAX_NUM_MUTEX];
@@ -245,7 +249,6 @@ void mutex_init() {
     def(OldSets_lock               , Mutex  , leaf     ,   true );
     def(RootRegionScan_lock        , Monitor, leaf     ,   true );
     def(MMUTracker_lock            , Mutex  , leaf     ,   true );
-    def(EvacFailureStack_lock      , Mutex  , nonleaf  ,   true );
 
     def(StringDedupQueue_lock      , Monitor, leaf,        true );
     def(StringDedupTable_lock      , Mutex  , leaf,        true );
@@ -260,12 +263,15 @@ void mutex_init() {
   def(Patching_lock                , Mutex  , special,     true ); // used for safepointing and code patching.
   def(ObjAllocPost_lock            , Monitor, special,     false);
   def(Service_lock                 , Monitor, special,     true ); // used for service thread operations
+  def(CodeSweeper_lock             , Monitor, special,     true ); // used to wake the code cache sweeper thread
   def(JmethodIdCreation_lock       , Mutex  , leaf,        true ); // used for creating jmethodIDs.
 
   def(SystemDictionary_monitor_lock, Monitor, leaf,        true ); // lookups done by VM thread
   def(ProfileRecorder_lock         , Mutex  , nonleaf+2,   true ); // used for JitWarmUp
   def(PreloadClassChain_lock       , Mutex  , max_nonleaf, true ); // used for JitWarmUp
   def(JitWarmUpPrint_lock          , Mutex  , max_nonleaf, true ); // used for JitWarmUp
+  def(VerificationCache_lock       , Mutex  , leaf,        true );
+  def(CompiledCodeCache_lock       , Mutex  , leaf,        true );
   def(PackageTable_lock            , Mutex  , leaf,        false);
   def(InlineCacheBuffer_lock       , Mutex  , leaf,        true );
   def(VMStatistic_lock             , Mutex  , leaf,        false);
@@ -299,7 +305,6 @@ void mutex_init() {
   def(Terminator_lock              , Monitor, nonleaf,     true );
   def(VtableStubs_lock             , Mutex  , nonleaf,     true );
   def(Notify_lock                  , Monitor, nonleaf,     true );
-  def(JNIGlobalHandle_lock         , Mutex  , nonleaf,     true ); // locks JNIHandleBlockFreeList_lock
   def(JNICritical_lock             , Monitor, nonleaf,     true ); // used for JNI critical regions
   def(AdapterHandlerLibrary_lock   , Mutex  , nonleaf,     true);
   if (UseConcMarkSweepGC) {
@@ -307,6 +312,8 @@ void mutex_init() {
                     // used in CMS GC for locking PLL lock
   }
   def(Heap_lock                    , Monitor, nonleaf+1,   false);
+  def(MetaspaceDump_lock           , Mutex  , nonleaf+1,   false); // Held across VM_MetaspaceSnapshot
+  def(AnonymousCLD_lock            , Mutex  , nonleaf+2,   false); // Hands out shared anonymous class loader data
   def(JfieldIdCreation_lock        , Mutex  , nonleaf+1,   true ); // jfieldID, Used in VM_Operation
   def(MemberNameTable_lock         , Mutex  , nonleaf+1,   false); // Used to protect MemberNameTable
 
@@ -347,6 +354,7 @@ void mutex_init() {
 #endif
 
   def(Wisp_lock                    , Monitor, special,      true);
+  def(CoroutineStackCache_lock     , Mutex,   leaf,         true);
 
   SystemDictionary_lock = UseWispMonitor ?
     new SystemDictObjMonitor(SystemDictionary_monitor_lock):
@@ -52,11 +52,14 @@ extern SystemDictMonitor* SystemDictionary_lock; // a lock on the system dictona
 extern Mutex*   ProfileRecorder_lock;            // a lock on the JWarmUP class ProfileRecorder
 extern Mutex*   PreloadClassChain_lock;          // a lock on the JWarmUP preload class chain
 extern Mutex*   JitWarmUpPrint_lock;             // a lock on the JWarmUP jstack print
+extern Mutex*   VerificationCache_lock;          // a lock on the persistent verification cache
+extern Mutex*   CompiledCodeCache_lock;          // a lock on the persistent compiled code cache
+extern Mutex*   MetaspaceDump_lock;              // a lock on the base snapshot of binary metaspace diff dumps
+extern Mutex*   AnonymousCLD_lock;               // a lock on the open anonymous class loader data chunks
 extern Mutex*   PackageTable_lock;               // a lock on the class loader package table
 extern Mutex*   CompiledIC_lock;                 // a lock used to guard compiled IC patching and access
 extern Mutex*   InlineCacheBuffer_lock;          // a lock used to guard the InlineCacheBuffer
 extern Mutex*   VMStatistic_lock;                // a lock used to guard statistics count increment
-extern Mutex*   JNIGlobalHandle_lock;            // a lock on creating JNI global handles
 extern Mutex*   JNIHandleBlockFreeList_lock;     // a lock on the JNI handle block free list
 extern Mutex*   MemberNameTable_lock;            // a lock on the MemberNameTable updates
 extern Mutex*   JmethodIdCreation_lock;          // a lock on creating JNI method identifiers
@@ -107,7 +110,6 @@ extern Mutex*   Shared_DirtyCardQ_lock;          // Lock protecting dirty card
                                                  // non-Java threads.
                                                  // (see option ExplicitGCInvokesConcurrent)
 extern Mutex*   ParGCRareEvent_lock;             // Synchronizes various (rare) parallel GC ops.
-extern Mutex*   EvacFailureStack_lock;           // guards the evac failure scan stack
 extern Mutex*   Compile_lock;                    // a lock held when Compilation is updating code (used to block CodeCache traversal, CHA updates, etc)
 extern Monitor* MethodCompileQueue_lock;         // a lock held when method compilations are enqueued, dequeued
 extern Monitor* CompileThread_lock;              // a lock held by compile threads during compilation system initialization
@@ -145,6 +147,7 @@ extern Mutex*   MMUTracker_lock;                 // protects the MMU
 
 extern Mutex*   Management_lock;                 // a lock used to serialize JVM management
 extern Monitor* Service_lock;                    // a lock used for service thread operation
+extern Monitor* CodeSweeper_lock;                // a lock used to wake the code cache sweeper thread
 extern Monitor* PeriodicTask_lock;               // protects the periodic task structure
 extern Monitor* RedefineClasses_lock;            // locks classes from parallel redefinition
 
@@ -166,6 +169,7 @@ extern Mutex*   UnsafeJlong_lock;                // provides Unsafe atomic updat
 #endif
 
 extern Monitor* Wisp_lock;                       // used to sync Wisp operations
+extern Mutex*   CoroutineStackCache_lock;        // protects the global cache of free coroutine stacks
 
 // A MutexLocker provides mutual exclusion with respect to a given mutex
 // for the scope which contains the locker.  The lock is an OS lock, not
@@ -56,7 +56,9 @@
 # include "os_bsd.inline.hpp"
 #endif
 #if INCLUDE_JFR
+#include "jfr/support/jfrContext.hpp"
 #include "jfr/support/jfrFlush.hpp"
+#include "jfr/support/jfrMonitorContention.hpp"
 #endif
 
 #if defined(__GNUC__) && !defined(IA64) && !defined(PPC64)
@@ -322,7 +324,7 @@ bool ObjectMonitor::try_enter(Thread* THREAD) {
   }
 }
 
-void ATTR ObjectMonitor::enter(TRAPS) {
+bool ATTR ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   if (UseWispMonitor) {
@@ -337,13 +339,13 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0   , "invariant") ;
      assert (_owner      == Self, "invariant") ;
      // CONSIDER: set or assert OwnerIsThread == 1
-     return ;
+     return true ;
   }
 
   if (cur == Self) {
      // TODO-FIXME: check for integer overflow!  BUGID 6557169.
      _recursions ++ ;
-     return ;
+     return true ;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -353,7 +355,7 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     // a full-fledged "Thread *".
     _owner = Self ;
     OwnerIsThread = 1 ;
-    return ;
+    return true ;
   }
 
   // We've encountered genuine contention.
@@ -370,7 +372,7 @@ void ATTR ObjectMonitor::enter(TRAPS) {
      assert (_recursions == 0    , "invariant") ;
      assert (((oop)(object()))->mark() == markOopDesc::encode(this), "invariant") ;
      Self->_Stalled = 0 ;
-     return ;
+     return true ;
   }
 
   assert (_owner != Self          , "invariant") ;
@@ -380,18 +382,29 @@ void ATTR ObjectMonitor::enter(TRAPS) {
   assert (!SafepointSynchronize::is_at_safepoint(), "invariant") ;
   assert (jt->thread_state() != _thread_blocked   , "invariant") ;
   assert (this->object() != NULL  , "invariant") ;
-  assert (_count >= 0, "invariant") ;
+  assert (_count >= 0 || AsyncDeflateIdleMonitors, "invariant") ;
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
-  Atomic::inc_ptr(&_count);
+  if (Atomic::add_ptr(1, &_count) <= 0) {
+    // The service thread won the race and is deflating this monitor
+    // (_count was driven negative). Help restore the object header and
+    // let the caller re-inflate.
+    assert (AsyncDeflateIdleMonitors, "invariant") ;
+    Atomic::dec_ptr(&_count);
+    Self->_Stalled = 0 ;
+    install_displaced_markword_in_object((oop)object());
+    return false ;
+  }
 
   JFR_ONLY(JfrConditionalFlushWithStacktrace<EventJavaMonitorEnter> flush(jt);)
   EventJavaMonitorEnter event;
   if (event.should_commit()) {
     event.set_monitorClass(((oop)this->object())->klass());
     event.set_address((uintptr_t)(this->object_addr()));
+    JFR_ONLY(JfrContext::set_context(&event, jt);)
   }
+  JFR_ONLY(const jlong contention_start = FlightRecorderMonitorContention ? os::javaTimeNanos() : 0;)
 
   { // Change java thread status to indicate blocked on monitor enter.
     JavaThreadBlockedOnMonitorEnterState jtbmes(jt, this);
@@ -489,9 +502,28 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     event.commit();
   }
 
+#if INCLUDE_JFR
+  if (FlightRecorderMonitorContention) {
+    JfrMonitorContention::record(UseWispMonitor ? ((WispThread*)jt)->thread() : jt,
+                                 ((oop)this->object())->klass(),
+                                 _previous_owner_method, _previous_owner_bci,
+                                 os::javaTimeNanos() - contention_start);
+  }
+#endif
+
   if (ObjectMonitor::_sync_ContendedLockAttempts != NULL) {
      ObjectMonitor::_sync_ContendedLockAttempts->inc() ;
   }
+  return true ;
+}
+
+// Restores the displaced header in the object if it still refers to this
+// monitor. Used by the async deflater and by threads that lose a race with
+// it; whoever gets there first wins, the rest fail the CAS harmlessly.
+void ObjectMonitor::install_displaced_markword_in_object(const oop obj) {
+  markOop dmw = header();
+  assert (dmw->is_neutral(), "invariant") ;
+  Atomic::cmpxchg_ptr(dmw, obj->mark_addr(), markOopDesc::encode(this));
 }
 
 
@@ -504,6 +536,12 @@ int ObjectMonitor::TryLock (Thread * Self) {
    }
    for (;;) {
       void * own = _owner ;
+      if (own == Self && WispMonitorHandoff) {
+         // An exiting coroutine handed the monitor to us while we were
+         // queued; see ExitEpilog().
+         assert (_recursions == 0, "invariant") ;
+         return 1 ;
+      }
       if (own != NULL) return 0 ;
       if (Atomic::cmpxchg_ptr (Self, &_owner, NULL) == NULL) {
          // Either guarantee _recursions == 0 or set _recursions = 0.
@@ -1053,6 +1091,13 @@ void ATTR ObjectMonitor::exit(bool not_suspended, TRAPS) {
    if (not_suspended && EventJavaMonitorEnter::is_enabled()) {
     _previous_owner_tid = JFR_THREAD_ID(Self);
    }
+   // remember where a contended monitor is released for the new owner
+   if (FlightRecorderMonitorContention && (_cxq != NULL || _EntryList != NULL)) {
+    const Method* method;
+    int bci;
+    JfrMonitorContention::top_frame(Thread::current(), &method, &bci);
+    set_previous_owner_site(method, bci);
+   }
 #endif
 
    for (;;) {
@@ -1393,21 +1438,35 @@ void ObjectMonitor::ExitEpilog (Thread * Self, ObjectWaiter * Wakee) {
    // 2. ST _owner = NULL
    // 3. unpark(wakee)
 
-   _succ = Knob_SuccEnabled ? Wakee->_thread : NULL ;
    ParkEvent * Trigger = Wakee->_event ;
    const int  wisp_id  = Wakee->_park_wisp_id;
    const bool use_wisp = Wakee->_using_wisp_park;
    const bool proxy_unpark = Wakee->_proxy_wisp_unpark;
    WispThread* wisp_thread = (WispThread*)Wakee->_thread;
 
+   // Wisp hand-off: a coroutine queued on this carrier cannot run until we
+   // switch away, so releasing the monitor would only let a barger take it
+   // before the wakee gets to retry. Make the wakee the owner instead; it
+   // stays on the cxq|EntryList and unlinks itself in EnterI()/ReenterI()
+   // once TryLock() sees it already owns the monitor. The unpark below then
+   // just requeues the task on our own carrier.
+   const bool handoff = WispMonitorHandoff && use_wisp && !proxy_unpark &&
+                        wisp_thread != Self &&
+                        wisp_thread->thread() == ((WispThread*) Self)->thread();
+   _succ = (Knob_SuccEnabled && !handoff) ? Wakee->_thread : NULL ;
 
    // Hygiene -- once we've set _owner = NULL we can't safely dereference Wakee again.
    // The thread associated with Wakee may have grabbed the lock and "Wakee" may be
    // out-of-scope (non-extant).
    Wakee  = NULL ;
 
-   // Drop the lock
-   OrderAccess::release_store_ptr (&_owner, NULL) ;
+   if (handoff) {
+      TEVENT (Inflated exit - wisp hand-off) ;
+      OrderAccess::release_store_ptr (&_owner, wisp_thread) ;
+   } else {
+      // Drop the lock
+      OrderAccess::release_store_ptr (&_owner, NULL) ;
+   }
    OrderAccess::fence() ;                               // ST _owner vs LD in unpark()
 
    if (SafepointSynchronize::do_call_back()) {
@@ -1466,16 +1525,18 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
 
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
    Thread * const Self = THREAD;
    assert(Self->is_Java_thread(), "Must be Java thread!");
    JavaThread *jt = (JavaThread *)THREAD;
 
    guarantee(_owner != Self, "reenter already owner");
-   enter (THREAD);       // enter the monitor
+   if (!enter (THREAD)) {  // enter the monitor
+     return false;
+   }
    guarantee (_recursions == 0, "reenter recursion");
    _recursions = recursions;
-   return;
+   return true;
 }
 
 
@@ -1526,6 +1587,7 @@ static void post_monitor_wait_event(EventJavaMonitorWait* event,
   event->set_address((uintptr_t)monitor->object_addr());
   event->set_notifier((u8)notifier_tid);
   event->set_timedOut(timedout);
+  JFR_ONLY(JfrContext::set_context(event, Thread::current());)
   event->commit();
 }
 
@@ -2412,6 +2474,9 @@ int ObjectMonitor::NotRunnable (Thread * Self, Thread * ox) {
 
     if (ox == NULL) return 0 ;
 
+    // The async deflater is not a thread we could probe.
+    if (ox == (Thread *) DEFLATER_MARKER) return 0 ;
+
     // Avoid transitive spinning ...
     // Say T1 spins or blocks trying to acquire L.  T1._Stalled is set to L.
     // Immediately after T1 acquires L it's possible that T2, also
@@ -75,6 +75,14 @@ class ObjectWaiter : public StackObj {
 
 // It is also used as RawMonitor by the JVMTI
 
+// Stored in _owner by the service thread to claim an idle monitor for
+// deflation outside of a safepoint (-XX:+AsyncDeflateIdleMonitors).
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
+// Stored in _owner when a thread other than the owner inflates an object
+// that is fast-locked on the owner's lock stack (-XX:+UseLightweightLocking).
+// The owner replaces it with itself the next time it inflates the object.
+#define ANONYMOUS_OWNER reinterpret_cast<void*>(1)
 
 class ObjectMonitor {
  public:
@@ -113,6 +121,13 @@ class ObjectMonitor {
   markOop   header() const;
   void      set_header(markOop hdr);
 
+  // Set while the service thread deflates the monitor outside of a
+  // safepoint; see ObjectSynchronizer::deflate_idle_monitors_using_JT().
+  bool is_being_async_deflated() const {
+    return _owner == DEFLATER_MARKER && _count < 0;
+  }
+  void install_displaced_markword_in_object(const oop obj);
+
   intptr_t is_busy() const {
     // TODO-FIXME: merge _count and _waiters.
     // TODO-FIXME: assert _owner == null implies _recursions = 0
@@ -125,6 +140,13 @@ class ObjectMonitor {
   void*     owner() const;
   void      set_owner(void* owner);
 
+  bool is_owner_anonymous() const { return _owner == ANONYMOUS_OWNER; }
+  void set_owner_from_anonymous(Thread* owner) {
+    assert(_owner == ANONYMOUS_OWNER, "invariant");
+    _owner = owner;
+    OwnerIsThread = 1;
+  }
+
   intptr_t  waiters() const;
 
   intptr_t  count() const;
@@ -157,6 +179,8 @@ class ObjectMonitor {
     _SpinClock    = 0 ;
     OwnerIsThread = 0 ;
     _previous_owner_tid = 0;
+    _previous_owner_method = NULL;
+    _previous_owner_bci = 0;
   }
 
   ~ObjectMonitor() {
@@ -180,6 +204,7 @@ private:
     _SpinFreq      = 0 ;
     _SpinClock     = 0 ;
     OwnerIsThread  = 0 ;
+    _previous_owner_method = NULL ;
   }
 
 public:
@@ -188,6 +213,13 @@ public:
   void*     object_addr();
   void      set_object(void* obj);
 
+  const Method* previous_owner_method() const { return _previous_owner_method; }
+  int       previous_owner_bci() const          { return _previous_owner_bci; }
+  void      set_previous_owner_site(const Method* method, int bci) {
+    _previous_owner_method = method;
+    _previous_owner_bci = bci;
+  }
+
   bool      check(TRAPS);       // true if the thread owns the monitor.
   void      check_slow(TRAPS);
   void      clear();
@@ -199,7 +231,7 @@ public:
 #endif
 
   bool      try_enter (TRAPS) ;
-  void      enter(TRAPS);
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -207,7 +239,7 @@ public:
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter (ObjectWaiter * waiter) ;
@@ -247,6 +279,8 @@ public:
  protected:                         // protected for jvmtiRawMonitor
   void *  volatile _owner;          // pointer to owning thread OR BasicLock
   volatile jlong _previous_owner_tid; // thread id of the previous owner of the monitor
+  const Method* volatile _previous_owner_method; // frame the previous owner released a contended monitor in
+  volatile int _previous_owner_bci;
   volatile intptr_t  _recursions;   // recursion count, 0 for first entry
  private:
   int OwnerIsThread ;               // _owner is (Thread *) vs SP/BasicLock
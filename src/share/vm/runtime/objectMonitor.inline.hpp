@@ -56,7 +56,8 @@ inline intptr_t ObjectMonitor::waiters() const {
 }
 
 inline void* ObjectMonitor::owner() const {
-  return _owner;
+  void* owner = _owner;
+  return owner != DEFLATER_MARKER ? owner : NULL;
 }
 
 inline void ObjectMonitor::clear() {
@@ -1308,6 +1308,11 @@ void os::block_on_serialize_page_trap() {
 
 // Serialize all thread state variables
 void os::serialize_thread_states() {
+#ifdef LINUX
+  if (Linux::membarrier_serialize()) {
+    return;
+  }
+#endif
   // On some platforms such as Solaris & Linux, the time duration of the page
   // permission restoration is observed to be much longer than expected  due to
   // scheduler starvation problem etc. To avoid the long synchronization
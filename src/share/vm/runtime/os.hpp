@@ -339,6 +339,11 @@ class os: AllStatic {
   // are passed.
   static void   pretouch_memory(char* start, char* end);
 
+  // Sets "resident" to the number of bytes in [start, start + bytes) that
+  // are backed by physical memory; unmapped pages count as not resident.
+  // Returns false if the platform cannot tell.
+  static bool   resident_memory_in_range(char* start, size_t bytes, size_t* resident);
+
   enum ProtType { MEM_PROT_NONE, MEM_PROT_READ, MEM_PROT_RW, MEM_PROT_RWX };
   static bool   protect_memory(char* addr, size_t bytes, ProtType prot,
                                bool is_committed = true);
@@ -384,6 +389,9 @@ class os: AllStatic {
   static bool   release_memory_special(char* addr, size_t bytes);
   static void   large_page_init();
   static size_t large_page_size();
+  // Size of the transparent huge pages that memory advised for them is
+  // backed with, 0 if the OS does not provide them.
+  static size_t transparent_huge_page_size();
   static bool   can_commit_large_page_memory();
   static bool   can_execute_large_page_memory();
 
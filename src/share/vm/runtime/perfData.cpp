@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutex.hpp"
@@ -249,6 +250,61 @@ int PerfString::format(char* buffer, int length) {
   return jio_snprintf(buffer, length, "%s", (char*)_valuep);
 }
 
+int PerfByteArrayVariable::format(char* buffer, int length) {
+  return jio_snprintf(buffer, length, "<%d bytes>", _length);
+}
+
+PerfHistogram::PerfHistogram(CounterNS ns, const char* namep)
+                            : PerfData(ns, namep, U_Events, V_Monotonic) {
+
+  create_entry(T_LONG, sizeof(jlong), (size_t)bucket_count);
+}
+
+int PerfHistogram::bucket_for(jlong value) {
+  if (value < sub_buckets) {
+    return value < 0 ? 0 : (int)value;
+  }
+  int shift = log2_long((julong)value) - sub_bucket_bits;
+  int sub = (int)((value >> shift) & (sub_buckets - 1));
+  int bucket = (shift + 1) * sub_buckets + sub;
+  return MIN2(bucket, (int)bucket_count - 1);
+}
+
+jlong PerfHistogram::bucket_lower_bound(int bucket) {
+  if (bucket < sub_buckets) {
+    return bucket;
+  }
+  int shift = bucket / sub_buckets - 1;
+  return (jlong)(sub_buckets + bucket % sub_buckets) << shift;
+}
+
+void PerfHistogram::record(jlong value) {
+  Atomic::add((jlong)1, &((volatile jlong*)_valuep)[bucket_for(value)]);
+}
+
+void PerfHistogram::record_ticks(jlong ticks) {
+  record((jlong)(ticks * 1000000.0 / os::elapsed_frequency()));
+}
+
+// Only the non-empty buckets are listed, as "lower_bound:count".
+int PerfHistogram::format(char* buffer, int length) {
+  int pos = 0;
+  buffer[0] = '\0';
+  for (int i = 0; i < bucket_count && pos < length; i++) {
+    jlong count = count_at(i);
+    if (count == 0) continue;
+    int n = jio_snprintf(buffer + pos, length - pos, "%s" JLONG_FORMAT ":" JLONG_FORMAT,
+                         pos == 0 ? "" : " ", bucket_lower_bound(i), count);
+    if (n < 0) break;
+    pos += n;
+  }
+  return pos;
+}
+
+jlong PerfTraceHistogram::now() {
+  return os::elapsed_counter();
+}
+
 PerfStringConstant::PerfStringConstant(CounterNS ns, const char* namep,
                                        const char* initial_value)
                      : PerfString(ns, namep, V_Constant,
@@ -444,6 +500,42 @@ PerfStringVariable* PerfDataManager::create_string_variable(CounterNS ns,
   return p;
 }
 
+PerfByteArrayVariable* PerfDataManager::create_byte_array_variable(CounterNS ns,
+                                                                  const char* name,
+                                                                  jint length,
+                                                                  TRAPS) {
+
+  assert(length > 0, "PerfByteArrayVariable with length 0");
+
+  PerfByteArrayVariable* p = new PerfByteArrayVariable(ns, name, length);
+
+  if (!p->is_valid()) {
+    // allocation of native resources failed.
+    delete p;
+    THROW_0(vmSymbols::java_lang_OutOfMemoryError());
+  }
+
+  add_item(p, false);
+
+  return p;
+}
+
+PerfHistogram* PerfDataManager::create_histogram(CounterNS ns,
+                                                 const char* name, TRAPS) {
+
+  PerfHistogram* p = new PerfHistogram(ns, name);
+
+  if (!p->is_valid()) {
+    // allocation of native resources failed.
+    delete p;
+    THROW_0(vmSymbols::java_lang_OutOfMemoryError());
+  }
+
+  add_item(p, false);
+
+  return p;
+}
+
 PerfLongVariable* PerfDataManager::create_long_variable(CounterNS ns,
                                                         const char* name,
                                                         PerfData::Units u,
@@ -104,6 +104,9 @@ enum CounterNS {
  *         - PerfString (Abstract)
  *             - PerfStringVariable
  *             - PerfStringConstant
+ *         - PerfByteArrayVariable
+ *
+ *     - PerfHistogram
  *
  *
  * As seen in the class hierarchy, the initially supported types are:
@@ -571,6 +574,74 @@ class PerfStringVariable : public PerfString {
     inline void set_value(const char* val) { set_string(val); }
 };
 
+/*
+ * The PerfByteArrayVariable class provides a PerfData sub class for a
+ * fixed size block of raw bytes that is written in place, such as a
+ * table laid out for external readers. It is not sampled.
+ */
+class PerfByteArrayVariable : public PerfByteArray {
+
+  friend class PerfDataManager; // for access to protected constructor
+
+  protected:
+
+    void sample() { }
+
+    PerfByteArrayVariable(CounterNS ns, const char* namep, jint length)
+                         : PerfByteArray(ns, namep, U_Bytes, V_Variable, length) { }
+
+  public:
+    inline jbyte* value()  { return (jbyte*)_valuep; }
+    inline jint length()   { return _length; }
+
+    int format(char* buffer, int length);
+};
+
+/*
+ * The PerfHistogram class provides a PerfData sub class for a latency
+ * distribution. It is laid out as a vector of longs, one count per
+ * bucket, so external readers can difference two snapshots and derive
+ * percentiles without the VM doing any aggregation.
+ *
+ * Values are recorded in microseconds into log-linear buckets: values
+ * below sub_buckets get a bucket each, and every following power of two
+ * is split into sub_buckets equally sized buckets. The relative error is
+ * therefore bounded by 1/sub_buckets. Values beyond the last bucket are
+ * accumulated in the last bucket.
+ *
+ * Recording is lock free and may be done by any number of threads.
+ */
+class PerfHistogram : public PerfData {
+
+  friend class PerfDataManager; // for access to protected constructor
+
+  public:
+    enum {
+      sub_bucket_bits = 2,
+      sub_buckets     = 1 << sub_bucket_bits,
+      bucket_count    = 128
+    };
+
+  protected:
+
+    void sample() { }
+
+    PerfHistogram(CounterNS ns, const char* namep);
+
+  public:
+    static int bucket_for(jlong value);
+    static jlong bucket_lower_bound(int bucket);
+
+    void record(jlong value);
+
+    // record an interval measured in os::elapsed_counter() ticks
+    void record_ticks(jlong ticks);
+
+    inline jlong count_at(int bucket) { return ((jlong*)_valuep)[bucket]; }
+
+    int format(char* buffer, int length);
+};
+
 
 /*
  * The PerfDataList class is a container class for managing lists
@@ -776,6 +847,13 @@ class PerfDataManager : AllStatic {
       return create_string_variable(ns, name, 0, s, THREAD);
     };
 
+    static PerfByteArrayVariable* create_byte_array_variable(CounterNS ns,
+                                                            const char* name,
+                                                            jint length, TRAPS);
+
+    static PerfHistogram* create_histogram(CounterNS ns,
+                                           const char* name, TRAPS);
+
     static PerfLongVariable* create_long_variable(CounterNS ns,
                                                   const char* name,
                                                   PerfData::Units u,
@@ -934,6 +1012,40 @@ class PerfTraceTime : public StackObj {
     }
 };
 
+/*
+ * this class records the elapsed time of a basic block into a
+ * PerfHistogram. A NULL histogram disables the measurement, so callers
+ * can pass the result of an accessor that is only set up when the
+ * histogram is enabled.
+ *
+ * Example:
+ *
+ *    {
+ *      PerfTraceHistogram pth(my_histogram);
+ *      // perform the operation you want to measure
+ *    }
+ */
+class PerfTraceHistogram : public StackObj {
+
+  protected:
+    PerfHistogram* _histogram;
+    jlong _start;
+
+    // os::elapsed_counter(), kept out of line to spare this header
+    static jlong now();
+
+  public:
+    inline PerfTraceHistogram(PerfHistogram* histogram) : _histogram(histogram), _start(0) {
+      if (_histogram == NULL) return;
+      _start = now();
+    }
+
+    inline ~PerfTraceHistogram() {
+      if (_histogram == NULL) return;
+      _histogram->record_ticks(now() - _start);
+    }
+};
+
 /* The PerfTraceTimedEvent class is responsible for counting the
  * occurrence of some event and measuring the the elapsed time of
  * the event in two separate PerfCounter instances.
@@ -33,6 +33,7 @@
 #include "runtime/perfData.hpp"
 #include "runtime/perfMemory.hpp"
 #include "runtime/statSampler.hpp"
+#include "services/threadService.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
@@ -86,7 +87,7 @@ void PerfMemory::initialize() {
     // initialization already performed
     return;
 
-  size_t capacity = align_size_up(PerfDataMemorySize,
+  size_t capacity = align_size_up(PerfDataMemorySize + ThreadPerfTable::reserved_bytes(),
                                   os::vm_allocation_granularity());
 
   if (PerfTraceMemOps) {
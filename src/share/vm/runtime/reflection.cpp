@@ -33,6 +33,7 @@
 #include "memory/resourceArea.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/instanceKlass.hpp"
+#include "oops/klassVtable.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "oops/objArrayOop.hpp"
 #include "prims/jvm.h"
@@ -889,6 +890,23 @@ methodHandle Reflection::resolve_interface_call(instanceKlassHandle klass, metho
                                                 KlassHandle recv_klass, Handle receiver, TRAPS) {
   assert(!method.is_null() , "method should not be null");
 
+  if (UseVMReflectionInvoker && method->has_itable_index() && recv_klass->oop_is_instance()) {
+    // The receiver is known to implement the interface, select through
+    // its itable like invokeinterface does. Abstract and non-public
+    // selections are left to the link resolver for the proper errors.
+    InstanceKlass* ik = InstanceKlass::cast(recv_klass());
+    itableOffsetEntry* ioe = (itableOffsetEntry*)ik->start_of_itable();
+    for (; ioe->interface_klass() != NULL; ioe++) {
+      if (ioe->interface_klass() == klass()) {
+        Method* selected = ioe->first_method_entry(ik)[method->itable_index()].method();
+        if (selected != NULL && selected->is_public() && !selected->is_abstract()) {
+          return methodHandle(THREAD, selected);
+        }
+        break;
+      }
+    }
+  }
+
   CallInfo info;
   Symbol*  signature  = method->signature();
   Symbol*  name       = method->name();
@@ -34,14 +34,17 @@
 #include "interpreter/interpreter.hpp"
 #include "jwarmup/jitWarmUp.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/symbol.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/coroutine.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
+#include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
@@ -52,9 +55,11 @@
 #include "runtime/sweeper.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #ifdef TARGET_ARCH_x86
 # include "nativeInst_x86.hpp"
 # include "vmreg_x86.inline.hpp"
@@ -81,6 +86,7 @@
 #endif
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
+#include "gc_implementation/shared/classLoaderDataPurgeThread.hpp"
 #include "gc_implementation/shared/suspendibleThreadSet.hpp"
 #endif // INCLUDE_ALL_GCS
 #ifdef COMPILER1
@@ -147,6 +153,51 @@ static void post_safepoint_cleanup_task_event(EventSafepointCleanupTask* event,
   }
 }
 
+// Number of slowest threads reported per safepoint by EventSafepointSlowThread
+static const int max_slow_threads = 3;
+
+// Set while synchronizing if threads record when they became safe
+static volatile bool record_safe_times = false;
+static Ticks sync_start_time;
+
+static void post_safepoint_slow_thread_events() {
+  JavaThread* slowest[max_slow_threads];
+  int count = 0;
+  for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+    const Ticks& t = cur->safepoint_state()->safe_time();
+    if (count < max_slow_threads || t > slowest[count - 1]->safepoint_state()->safe_time()) {
+      // Insertion into the list, which is kept latest first
+      int i = (count < max_slow_threads) ? count++ : count - 1;
+      for (; i > 0 && slowest[i - 1]->safepoint_state()->safe_time() < t; i--) {
+        slowest[i] = slowest[i - 1];
+      }
+      slowest[i] = cur;
+    }
+  }
+
+  for (int i = 0; i < count; i++) {
+    JavaThread* thread = slowest[i];
+    EventSafepointSlowThread event(UNTIMED);
+    if (event.should_commit()) {
+      event.set_starttime(sync_start_time);
+      event.set_endtime(thread->safepoint_state()->safe_time());
+      set_current_safepoint_id(&event);
+      event.set_slowThread(JFR_THREAD_ID(thread));
+      event.set_lineNumber(-1);
+      if (thread->has_last_Java_frame()) {
+        ResourceMark rm;
+        RegisterMap map(thread, false);
+        javaVFrame* jvf = thread->last_java_vframe(&map);
+        if (jvf != NULL) {
+          event.set_topMethod(jvf->method());
+          event.set_lineNumber(jvf->method()->line_number_from_bci(jvf->bci()));
+        }
+      }
+      event.commit();
+    }
+  }
+}
+
 static void post_safepoint_end_event(EventSafepointEnd* event) {
   assert(event != NULL, "invariant");
   if (event->should_commit()) {
@@ -164,10 +215,66 @@ volatile int  SafepointSynchronize::_waiting_to_block = 0;
 volatile int SafepointSynchronize::_safepoint_counter = 0;
 int SafepointSynchronize::_current_jni_active_count = 0;
 long  SafepointSynchronize::_end_of_last_safepoint = 0;
+address SafepointSynchronize::_poll_armed_value = NULL;
+address SafepointSynchronize::_poll_disarmed_value = NULL;
 static volatile int PageArmed = 0 ;        // safepoint polling page is RO|RW vs PROT_NONE
 static volatile int TryingToBlock = 0 ;    // proximate value -- for advisory use only
 static bool timeout_error_printed = false;
 
+void SafepointSynchronize::initialize_thread_local_polls() {
+  if (!ThreadLocalSafepointPolls) {
+    return;
+  }
+  // Disarmed polls read a page that stays readable, armed polls read the
+  // polling page which stays unreadable. A fault on it is handled as before.
+  size_t page_size = os::vm_page_size();
+  char* page = os::reserve_memory(page_size, NULL, page_size);
+  if (page == NULL) {
+    vm_exit_during_initialization("Unable to reserve the safepoint poll page");
+  }
+  os::commit_memory_or_exit(page, page_size, false, "safepoint poll page");
+  os::protect_memory(page, page_size, os::MEM_PROT_READ);
+  os::make_polling_page_unreadable();
+
+  _poll_disarmed_value = (address)page;
+  _poll_armed_value = os::get_polling_page() + poll_bit();
+}
+
+void SafepointSynchronize::arm_poll(JavaThread* thread) {
+  thread->set_poll_word(_poll_armed_value);
+}
+
+void SafepointSynchronize::disarm_poll(JavaThread* thread) {
+  thread->set_poll_word(_poll_disarmed_value);
+}
+
+// Make compiled code trap at its next poll. With thread local polls this
+// stores into the poll word of every thread instead of protecting the
+// polling page, which costs an mprotect and a TLB shootdown.
+void SafepointSynchronize::arm_polls() {
+  guarantee (PageArmed == 0, "invariant") ;
+  PageArmed = 1 ;
+  if (ThreadLocalSafepointPolls) {
+    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      arm_poll(cur);
+    }
+    OrderAccess::fence();
+  } else {
+    os::make_polling_page_unreadable();
+  }
+}
+
+void SafepointSynchronize::disarm_polls() {
+  if (ThreadLocalSafepointPolls) {
+    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      disarm_poll(cur);
+    }
+  } else {
+    os::make_polling_page_readable();
+  }
+  PageArmed = 0 ;
+}
+
 // Roll all threads forward to a safepoint and suspend them all
 void SafepointSynchronize::begin() {
   EventSafepointBegin begin_event;
@@ -187,6 +294,10 @@ void SafepointSynchronize::begin() {
   } else if (UseG1GC) {
     SuspendibleThreadSet::synchronize();
   }
+  if (ClassLoaderDataPurgeThread::is_enabled()) {
+    // The purge thread is the only member of the set with the other collectors
+    SuspendibleThreadSet::synchronize();
+  }
 #endif // INCLUDE_ALL_GCS
 
   // By getting the Threads_lock, we assure that no threads are about to start or
@@ -265,6 +376,11 @@ void SafepointSynchronize::begin() {
   EventSafepointStateSynchronization sync_event;
   int initial_running = 0;
 
+  record_safe_times = EventSafepointSlowThread::is_enabled();
+  if (record_safe_times) {
+    sync_start_time = Ticks::now();
+  }
+
   _state            = _synchronizing;
   OrderAccess::fence();
 
@@ -278,9 +394,7 @@ void SafepointSynchronize::begin() {
 
   if (UseCompilerSafepoints && DeferPollingPageLoopCount < 0) {
     // Make polling safepoint aware
-    guarantee (PageArmed == 0, "invariant") ;
-    PageArmed = 1 ;
-    os::make_polling_page_unreadable();
+    arm_polls();
   }
 
   // Consider using active_processor_count() ... but that call is expensive.
@@ -308,6 +422,10 @@ void SafepointSynchronize::begin() {
         cur_state->examine_state_of_thread();
         if (!cur_state->is_running()) {
            still_running--;
+           // Threads rolled forward to a call back record the time themselves
+           if (record_safe_times && cur_state->is_at_safepoint()) {
+             cur_state->record_safe_time();
+           }
            // consider adjusting steps downward:
            //   steps = 0
            //   steps -= NNN
@@ -386,9 +504,7 @@ void SafepointSynchronize::begin() {
       //    to drive subsequent spin/SwitchThreadTo()/Sleep(N) decisions.
 
       if (UseCompilerSafepoints && int(iterations) == DeferPollingPageLoopCount) {
-         guarantee (PageArmed == 0, "invariant") ;
-         PageArmed = 1 ;
-         os::make_polling_page_unreadable();
+         arm_polls();
       }
 
       // Instead of (ncpus > 1) consider either (still_running < (ncpus + EPSILON)) or
@@ -486,6 +602,11 @@ void SafepointSynchronize::begin() {
     update_statistics_on_sync_end(os::javaTimeNanos());
   }
 
+  if (record_safe_times) {
+    record_safe_times = false;
+    post_safepoint_slow_thread_events();
+  }
+
   // Call stuff that needs to be run when a safepoint is just about to be completed
   {
     EventSafepointCleanup cleanup_event;
@@ -536,8 +657,7 @@ void SafepointSynchronize::end() {
 
   if (PageArmed) {
     // Make polling safepoint aware
-    os::make_polling_page_readable();
-    PageArmed = 0 ;
+    disarm_polls();
   }
 
   // Remove safepoint check from interpreter
@@ -588,6 +708,9 @@ void SafepointSynchronize::end() {
   }
 #if INCLUDE_ALL_GCS
   // If there are any concurrent GC threads resume them.
+  if (ClassLoaderDataPurgeThread::is_enabled()) {
+    SuspendibleThreadSet::desynchronize();
+  }
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::desynchronize(false);
   } else if (UseG1GC) {
@@ -605,69 +728,259 @@ void SafepointSynchronize::end() {
 bool SafepointSynchronize::is_cleanup_needed() {
   // Need a safepoint if some inline cache buffers is non-empty
   if (!InlineCacheBuffer::is_empty()) return true;
+  // Need a safepoint to deoptimize code invalidated by class loading
+  if (Deoptimization::has_pending_dependents()) return true;
+  // Need a safepoint to grow the symbol table
+  if (SymbolTable::needs_resizing()) return true;
+  // Need a safepoint to grow the string table
+  if (StringTable::needs_resizing()) return true;
   return false;
 }
 
 
 
-// Various cleaning tasks that should be done periodically at safepoints
-void SafepointSynchronize::do_cleanup_tasks() {
-  {
-    const char* name = "deflating idle monitors";
-    EventSafepointCleanupTask event;
-    TraceTime t1(name, TraceSafepointCleanupTime);
-    ObjectSynchronizer::deflate_idle_monitors();
-    if (event.should_commit()) {
+// Cleanup tasks run by the safepoint workers. The per-thread parts of
+// monitor deflation and nmethod marking are spread over the workers in
+// chunks of threads; the other tasks are claimed by one worker each.
+class ParallelSPCleanupTask : public AbstractGangTask {
+ private:
+  enum SafepointCleanupTasks {
+    SAFEPOINT_CLEANUP_DEFLATE_MONITORS,
+    SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES,
+    SAFEPOINT_CLEANUP_COMPILATION_POLICY,
+    SAFEPOINT_CLEANUP_MARK_VM_THREAD_NMETHODS,
+    SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH,
+    SAFEPOINT_CLEANUP_STRING_TABLE_REHASH,
+    // Leave this one last.
+    SAFEPOINT_CLEANUP_NUM_TASKS
+  };
+
+  // Number of threads claimed at a time
+  static const int thread_chunk_size = 16;
+
+  SubTasksDone _subtasks;
+  JavaThread** _threads;
+  int _num_threads;
+  volatile jint _next_thread;
+  DeflateMonitorCounters* _counters;
+  CodeBlobClosure* _nmethod_cl;
+
+ public:
+  ParallelSPCleanupTask(uint num_workers, JavaThread** threads, int num_threads,
+                        DeflateMonitorCounters* counters, CodeBlobClosure* nmethod_cl) :
+    AbstractGangTask("Parallel Safepoint Cleanup"),
+    _subtasks(SAFEPOINT_CLEANUP_NUM_TASKS),
+    _threads(threads),
+    _num_threads(num_threads),
+    _next_thread(0),
+    _counters(counters),
+    _nmethod_cl(nmethod_cl) {
+    _subtasks.set_n_threads(num_workers);
+  }
+
+  void work(uint worker_id) {
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_DEFLATE_MONITORS)) {
+      const char* name = "deflating global idle monitors";
+      EventSafepointCleanupTask event;
+      TraceTime t1(name, TraceSafepointCleanupTime);
+      ObjectSynchronizer::deflate_idle_monitors(_counters);
       post_safepoint_cleanup_task_event(&event, name);
     }
-  }
 
-  {
-    const char* name = "updating inline caches";
-    EventSafepointCleanupTask event;
-    TraceTime t2(name, TraceSafepointCleanupTime);
-    InlineCacheBuffer::update_inline_caches();
-    if (event.should_commit()) {
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES)) {
+      const char* name = "updating inline caches";
+      EventSafepointCleanupTask event;
+      TraceTime t2(name, TraceSafepointCleanupTime);
+      InlineCacheBuffer::update_inline_caches();
       post_safepoint_cleanup_task_event(&event, name);
     }
-  }
-  {
-    const char* name = "compilation policy safepoint handler";
-    EventSafepointCleanupTask event;
-    TraceTime t3(name, TraceSafepointCleanupTime);
-    CompilationPolicy::policy()->do_safepoint_work();
-    if (event.should_commit()) {
+
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_COMPILATION_POLICY)) {
+      const char* name = "compilation policy safepoint handler";
+      EventSafepointCleanupTask event;
+      TraceTime t3(name, TraceSafepointCleanupTime);
+      CompilationPolicy::policy()->do_safepoint_work();
       post_safepoint_cleanup_task_event(&event, name);
     }
-  }
 
-  {
-    const char* name = "mark nmethods";
-    EventSafepointCleanupTask event;
-    TraceTime t4(name, TraceSafepointCleanupTime);
-    NMethodSweeper::mark_active_nmethods();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_MARK_VM_THREAD_NMETHODS)) {
+      if (_nmethod_cl != NULL) {
+        VMThread::vm_thread()->nmethods_do(_nmethod_cl);
+      }
+    }
+
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH)) {
+      if (SymbolTable::needs_resizing()) {
+        const char* name = "resizing symbol table";
+        EventSafepointCleanupTask event;
+        TraceTime t5(name, TraceSafepointCleanupTime);
+        SymbolTable::resize_table();
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+      if (SymbolTable::needs_rehashing()) {
+        const char* name = "rehashing symbol table";
+        EventSafepointCleanupTask event;
+        TraceTime t5(name, TraceSafepointCleanupTime);
+        SymbolTable::rehash_table();
+        post_safepoint_cleanup_task_event(&event, name);
+      }
     }
-  }
 
-  if (SymbolTable::needs_rehashing()) {
-    const char* name = "rehashing symbol table";
+    if (!_subtasks.is_task_claimed(SAFEPOINT_CLEANUP_STRING_TABLE_REHASH)) {
+      if (StringTable::needs_resizing()) {
+        const char* name = "resizing string table";
+        EventSafepointCleanupTask event;
+        TraceTime t6(name, TraceSafepointCleanupTime);
+        StringTable::resize_table();
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+      if (StringTable::needs_rehashing()) {
+        const char* name = "rehashing string table";
+        EventSafepointCleanupTask event;
+        TraceTime t6(name, TraceSafepointCleanupTime);
+        StringTable::rehash_table();
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    // Workers done with the tasks above help with the threads.
+    const char* name = "deflating per-thread monitors and marking nmethods";
     EventSafepointCleanupTask event;
-    TraceTime t5(name, TraceSafepointCleanupTime);
-    SymbolTable::rehash_table();
-    if (event.should_commit()) {
+    int claimed = 0;
+    while (true) {
+      int start = Atomic::add(thread_chunk_size, &_next_thread) - thread_chunk_size;
+      if (start >= _num_threads) {
+        break;
+      }
+      int end = MIN2(start + thread_chunk_size, _num_threads);
+      for (int i = start; i < end; i++) {
+        JavaThread* thread = _threads[i];
+        ObjectSynchronizer::deflate_thread_local_monitors(thread, _counters);
+        if (_nmethod_cl != NULL) {
+          thread->nmethods_do(_nmethod_cl);
+        }
+      }
+      claimed += end - start;
+    }
+    if (claimed > 0) {
       post_safepoint_cleanup_task_event(&event, name);
     }
+
+    _subtasks.all_tasks_completed();
   }
+};
 
-  if (StringTable::needs_rehashing()) {
-    const char* name = "rehashing string table";
-    EventSafepointCleanupTask event;
-    TraceTime t6(name, TraceSafepointCleanupTime);
-    StringTable::rehash_table();
-    if (event.should_commit()) {
-      post_safepoint_cleanup_task_event(&event, name);
+void SafepointSynchronize::do_parallel_cleanup_tasks(FlexibleWorkGang* workers) {
+  ResourceMark rm;
+  TraceTime t0("parallel safepoint cleanup", TraceSafepointCleanupTime);
+
+  int num_threads = 0;
+  for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+    num_threads++;
+  }
+  JavaThread** threads = NEW_RESOURCE_ARRAY(JavaThread*, num_threads);
+  int i = 0;
+  for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+    threads[i++] = cur;
+  }
+
+  DeflateMonitorCounters counters;
+  ObjectSynchronizer::prepare_deflate_idle_monitors(&counters);
+  CodeBlobClosure* nmethod_cl = NMethodSweeper::prepare_mark_active_nmethods();
+
+  ParallelSPCleanupTask cleanup(workers->active_workers(), threads, num_threads,
+                                &counters, nmethod_cl);
+  workers->run_task(&cleanup);
+
+  ObjectSynchronizer::finish_deflate_idle_monitors(&counters);
+  if (nmethod_cl != NULL) {
+    OrderAccess::storestore();
+  }
+}
+
+// Various cleaning tasks that should be done periodically at safepoints
+void SafepointSynchronize::do_cleanup_tasks() {
+  FlexibleWorkGang* workers = ParallelSafepointCleanup ? Universe::heap()->safepoint_workers() : NULL;
+  if (workers != NULL && workers->active_workers() > 1) {
+    do_parallel_cleanup_tasks(workers);
+  } else {
+    {
+      const char* name = "deflating idle monitors";
+      EventSafepointCleanupTask event;
+      TraceTime t1(name, TraceSafepointCleanupTime);
+      ObjectSynchronizer::deflate_idle_monitors();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    {
+      const char* name = "updating inline caches";
+      EventSafepointCleanupTask event;
+      TraceTime t2(name, TraceSafepointCleanupTime);
+      InlineCacheBuffer::update_inline_caches();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+    {
+      const char* name = "compilation policy safepoint handler";
+      EventSafepointCleanupTask event;
+      TraceTime t3(name, TraceSafepointCleanupTime);
+      CompilationPolicy::policy()->do_safepoint_work();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    {
+      const char* name = "mark nmethods";
+      EventSafepointCleanupTask event;
+      TraceTime t4(name, TraceSafepointCleanupTime);
+      NMethodSweeper::mark_active_nmethods();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    if (SymbolTable::needs_resizing()) {
+      const char* name = "resizing symbol table";
+      EventSafepointCleanupTask event;
+      TraceTime t5(name, TraceSafepointCleanupTime);
+      SymbolTable::resize_table();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    if (SymbolTable::needs_rehashing()) {
+      const char* name = "rehashing symbol table";
+      EventSafepointCleanupTask event;
+      TraceTime t5(name, TraceSafepointCleanupTime);
+      SymbolTable::rehash_table();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    if (StringTable::needs_resizing()) {
+      const char* name = "resizing string table";
+      EventSafepointCleanupTask event;
+      TraceTime t6(name, TraceSafepointCleanupTime);
+      StringTable::resize_table();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
+    }
+
+    if (StringTable::needs_rehashing()) {
+      const char* name = "rehashing string table";
+      EventSafepointCleanupTask event;
+      TraceTime t6(name, TraceSafepointCleanupTime);
+      StringTable::rehash_table();
+      if (event.should_commit()) {
+        post_safepoint_cleanup_task_event(&event, name);
+      }
     }
   }
 
@@ -680,6 +993,22 @@ void SafepointSynchronize::do_cleanup_tasks() {
     }
   }
 
+  if (Deoptimization::has_pending_dependents()) {
+    TraceTime t10("deoptimizing dependents of loaded classes", TraceSafepointCleanupTime);
+    Deoptimization::deoptimize_pending_dependents();
+  }
+
+  // Frees metaspace, so it stays on the VM thread
+  if (ReclaimColdMethodCountersInterval > 0) {
+    TraceTime t9("reclaiming cold method counters", TraceSafepointCleanupTime);
+    CompilationPolicy::reclaim_cold_method_counters();
+  }
+
+  if (EnableCoroutine && CoroutineStackTrimIdleCleanups > 0) {
+    TraceTime t11("trimming idle coroutine stacks", TraceSafepointCleanupTime);
+    Coroutine::trim_idle_stacks();
+  }
+
   // rotate log files?
   if (UseGCLogFileRotation) {
     TraceTime t8("rotating gc logs", TraceSafepointCleanupTime);
@@ -793,6 +1122,9 @@ void SafepointSynchronize::block(JavaThread *thread) {
         assert(_waiting_to_block > 0, "sanity check");
         _waiting_to_block--;
         thread->safepoint_state()->set_has_called_back(true);
+        if (record_safe_times) {
+          thread->safepoint_state()->record_safe_time();
+        }
 
         DEBUG_ONLY(thread->set_visited_for_critical_count(true));
         if (thread->in_critical()) {
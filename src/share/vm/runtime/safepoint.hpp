@@ -32,6 +32,7 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/ostream.hpp"
+#include "utilities/ticks.hpp"
 
 //
 // Safepoint synchronization
@@ -50,6 +51,7 @@
 
 class ThreadSafepointState;
 class SnippetCache;
+class FlexibleWorkGang;
 class nmethod;
 
 //
@@ -129,6 +131,13 @@ private:
   // For debug long safepoint
   static void print_safepoint_timeout(SafepointTimeoutReason timeout_reason);
 
+  // Values of JavaThread::poll_word() with ThreadLocalSafepointPolls
+  static address _poll_armed_value;
+  static address _poll_disarmed_value;
+
+  static void arm_polls();
+  static void disarm_polls();
+
 public:
 
   // Main entry points
@@ -172,6 +181,7 @@ public:
   }
   static bool is_cleanup_needed();
   static void do_cleanup_tasks();
+  static void do_parallel_cleanup_tasks(FlexibleWorkGang* workers);
 
   // debugging
   static void print_state()                                PRODUCT_RETURN;
@@ -189,6 +199,16 @@ public:
 
   static address safepoint_counter_addr()                  { return (address)&_safepoint_counter; }
 
+  // Thread local polls (ThreadLocalSafepointPolls). Compiled code reads the
+  // address in the poll word of the current thread, which is a readable
+  // page or, when armed, the polling page. The interpreter tests poll_bit()
+  // of the word. A single thread is armed by a store to its poll word.
+  static void initialize_thread_local_polls();
+  static int poll_bit()                                    { return 1; }
+  static address poll_disarmed_value()                     { return _poll_disarmed_value; }
+  static void arm_poll(JavaThread* thread);
+  static void disarm_poll(JavaThread* thread);
+
   static jlong max_sync_time_ms() {
     return nanos_to_millis(_max_sync_time);
   }
@@ -217,6 +237,8 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   JavaThread *                   _thread;
   volatile suspend_type          _type;
   JavaThreadState                _orig_thread_state;
+  // When the thread was seen safe, recorded for EventSafepointSlowThread
+  Ticks                          _safe_time;
 
 
  public:
@@ -241,6 +263,9 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   bool              is_at_poll_safepoint() { return _at_poll_safepoint; }
   void              set_at_poll_safepoint(bool val) { _at_poll_safepoint = val; }
 
+  const Ticks&      safe_time() const      { return _safe_time; }
+  void              record_safe_time()     { _safe_time = Ticks::now(); }
+
   void handle_polling_page_exception();
 
   // debugging
@@ -27,6 +27,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/allocationContextService.hpp"
 #include "services/gcNotifier.hpp"
@@ -88,6 +89,7 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool deflate_idle_monitors = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -105,10 +107,13 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
               !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
-             !(acs_notify = AllocationContextService::should_notify())) {
+             !(acs_notify = AllocationContextService::should_notify()) &&
+             !(deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed())) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event or JMX GC notification to post, or it is time
+        // to look for idle monitors again
+        Service_lock->wait(Mutex::_no_safepoint_check_flag,
+                           AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -135,6 +140,10 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (acs_notify) {
       AllocationContextService::notify(CHECK);
     }
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_using_JT();
+    }
   }
 }
 
@@ -52,6 +52,14 @@ StubCodeDesc* StubCodeDesc::desc_for_index(int index) {
 }
 
 
+StubCodeDesc* StubCodeDesc::desc_for_name(const char* group, const char* name) {
+  StubCodeDesc* p = (StubCodeDesc*)OrderAccess::load_ptr_acquire(&_list);
+  while (p != NULL && (p->group() == NULL || strcmp(p->group(), group) != 0 ||
+                       strcmp(p->name(), name) != 0)) p = p->_next;
+  return p;
+}
+
+
 const char* StubCodeDesc::name_for(address pc) {
   StubCodeDesc* p = desc_for(pc);
   return p == NULL ? NULL : p->name();
@@ -65,6 +65,7 @@ class StubCodeDesc: public CHeapObj<mtCode> {
  public:
   static StubCodeDesc* desc_for(address pc);     // returns the code descriptor for the code containing pc or NULL
   static StubCodeDesc* desc_for_index(int);      // returns the code descriptor for the index or NULL
+  static StubCodeDesc* desc_for_name(const char* group, const char* name); // returns the first code descriptor with this name or NULL
   static const char*   name_for(address pc);     // returns the name of the code containing pc or NULL
 
   StubCodeDesc(const char* group, const char* name, address begin) {
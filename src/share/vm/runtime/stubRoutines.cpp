@@ -26,9 +26,16 @@
 #include "asm/codeBuffer.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/copy.hpp"
 #ifdef COMPILER2
@@ -43,6 +50,9 @@
 
 BufferBlob* StubRoutines::_code1                                = NULL;
 BufferBlob* StubRoutines::_code2                                = NULL;
+elapsedTimer StubRoutines::_generation2_time;
+BufferBlob*   StubRoutines::_code_lazy[StubRoutines::lazy_group_count]  = { NULL };
+volatile jint StubRoutines::_lazy_state[StubRoutines::lazy_group_count] = { 0 };
 
 address StubRoutines::_call_stub_return_address                 = NULL;
 address StubRoutines::_call_stub_entry                          = NULL;
@@ -136,12 +146,23 @@ address StubRoutines::_sha512_implCompressMB = NULL;
 address StubRoutines::_updateBytesCRC32 = NULL;
 address StubRoutines::_crc_table_adr = NULL;
 
+address StubRoutines::_byteArrayHashCode = NULL;
+address StubRoutines::_charArrayHashCode = NULL;
+address StubRoutines::_intArrayHashCode  = NULL;
+
+address StubRoutines::_unsafeVectorizedMismatch = NULL;
+address StubRoutines::_unsafeHash               = NULL;
+
 address StubRoutines::_multiplyToLen = NULL;
 address StubRoutines::_squareToLen = NULL;
 address StubRoutines::_mulAdd = NULL;
 address StubRoutines::_montgomeryMultiply = NULL;
 address StubRoutines::_montgomerySquare = NULL;
 
+address StubRoutines::_utf8Decode   = CAST_FROM_FN_PTR(address, StubRoutines::utf8_decode);
+address StubRoutines::_utf8Encode   = CAST_FROM_FN_PTR(address, StubRoutines::utf8_encode);
+address StubRoutines::_latin1Decode = CAST_FROM_FN_PTR(address, StubRoutines::latin1_decode);
+
 double (* StubRoutines::_intrinsic_log   )(double) = NULL;
 double (* StubRoutines::_intrinsic_log10 )(double) = NULL;
 double (* StubRoutines::_intrinsic_exp   )(double) = NULL;
@@ -218,10 +239,92 @@ static void test_arraycopy_func(address func, int alignment) {
 }
 #endif
 
+// Runs the second phase of the stub generation while create_vm loads and
+// links the core classes (ParallelVMInit). These stubs only depend on the
+// heap and the metaspace set up by universe_init. Nothing calls them before
+// the compilers start, which is after initialize2() has joined this thread.
+class StubGenerationThread : public NamedThread {
+ private:
+  static Monitor*      _lock;
+  static volatile bool _started;
+  static volatile bool _done;
+
+  StubGenerationThread() {
+    set_name("Stub Generation Thread");
+  }
+
+ public:
+  virtual void run() {
+    this->record_stack_base_and_size();
+    this->initialize_thread_local_storage();
+    this->set_native_thread_name(this->name());
+    // The timer output would interleave with the main thread's, it is
+    // printed by join() instead.
+    StubRoutines::generate2(false);
+    {
+      MonitorLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      _done = true;
+      ml.notify_all();
+    }
+    delete this;
+  }
+
+  static void start() {
+    // Stub generation reports to JVMTI agents and prints with PrintStubCode,
+    // both of which expect the main thread.
+    if (!ParallelVMInit || PrintStubCode ||
+        Arguments::init_agents_at_startup() || Arguments::init_libraries_at_startup()) {
+      return;
+    }
+    _lock = new Monitor(Mutex::leaf, "StubGeneration_lock", true);
+    StubGenerationThread* thread = new StubGenerationThread();
+    if (!os::create_thread(thread, os::os_thread)) {
+      // initialize2() generates the stubs itself
+      delete thread;
+      return;
+    }
+    _started = true;
+    os::start_thread(thread);
+  }
+
+  // Wait for the stubs; false if they are not generated in the background.
+  static bool join() {
+    if (!_started) {
+      return false;
+    }
+    {
+      TraceTime timer("StubRoutines generation 2 wait", TraceStartupTime);
+      MonitorLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      while (!_done) {
+        ml.wait(Mutex::_no_safepoint_check_flag);
+      }
+    }
+    if (TraceStartupTime) {
+      tty->print_cr("[StubRoutines generation 2 (background), %3.7f secs]",
+                    StubRoutines::_generation2_time.seconds());
+    }
+    return true;
+  }
+};
+
+Monitor*      StubGenerationThread::_lock    = NULL;
+volatile bool StubGenerationThread::_started = false;
+volatile bool StubGenerationThread::_done    = false;
+
+void StubRoutines::initialize2_in_background() {
+  StubGenerationThread::start();
+}
+
 void StubRoutines::initialize2() {
+  if (!StubGenerationThread::join()) {
+    generate2(true);
+  }
+}
+
+void StubRoutines::generate2(bool verbose) {
   if (_code2 == NULL) {
     ResourceMark rm;
-    TraceTime timer("StubRoutines generation 2", TraceStartupTime);
+    TraceTime timer("StubRoutines generation 2", &_generation2_time, TraceStartupTime, verbose);
     _code2 = BufferBlob::create("StubRoutines (2)", code_size2);
     if (_code2 == NULL) {
       vm_exit_out_of_memory(code_size2, OOM_MALLOC_ERROR, "CodeCache: no room for StubRoutines (2)");
@@ -312,8 +415,32 @@ void StubRoutines::initialize2() {
 }
 
 
+#ifdef AMD64
+BufferBlob* StubGenerator_generate_lazily(int group);  // only x86_64 defers stubs
+#endif
+
+void StubRoutines::generate_lazily(LazyStubGroup group) {
+#ifdef AMD64
+  if (!LazyStubGeneration || OrderAccess::load_acquire(&_lazy_state[group]) == lazy_generated) {
+    return;
+  }
+  // The first thread to get here generates the group. A compilation racing
+  // with it may see NULL entries and then does without the intrinsics.
+  if (Atomic::cmpxchg(lazy_generating, &_lazy_state[group], lazy_not_generated) != lazy_not_generated) {
+    return;
+  }
+  // The compiler threads ask from native
+  ThreadInVMfromUnknown tiv;
+  ResourceMark rm;
+  // Without room in the code cache the entries stay NULL
+  _code_lazy[group] = StubGenerator_generate_lazily(group);
+  OrderAccess::release_store(&_lazy_state[group], lazy_generated);
+#endif
+}
+
 void stubRoutines_init1() { StubRoutines::initialize1(); }
 void stubRoutines_init2() { StubRoutines::initialize2(); }
+void stubRoutines_init2_in_background() { StubRoutines::initialize2_in_background(); }
 
 //
 // Default versions of arraycopy functions
@@ -430,6 +557,130 @@ JRT_LEAF(void, StubRoutines::arrayof_oop_copy_uninit(HeapWord* src, HeapWord* de
   gen_arraycopy_barrier((oop *) dest, count);
 JRT_END
 
+// Word at a time: true if none of the 8 bytes at p has the high bit set.
+static inline bool ascii_word(const jbyte* p) {
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return (w & UCONST64(0x8080808080808080)) == 0;
+}
+
+static inline bool ascii_char_word(const jchar* p) {
+  uint64_t w;
+  memcpy(&w, p, sizeof(w));
+  return (w & UCONST64(0xff80ff80ff80ff80)) == 0;
+}
+
+// sun.nio.cs.UTF_8$Decoder.decode(byte[], int, int, char[]) for well-formed
+// input. Returns the number of chars written, or -1 if the input is malformed
+// or does not fit; the caller then runs the Java method.
+JRT_LEAF(jint, StubRoutines::utf8_decode(const jbyte* src, jint len, jchar* dst, jint dst_len))
+  const jbyte* const end = src + len;
+  jchar* const dst_begin = dst;
+  jchar* const dst_end = dst + dst_len;
+  while (src < end) {
+    if (end - src >= 8 && dst_end - dst >= 8 && ascii_word(src)) {
+      for (int i = 0; i < 8; i++) {
+        dst[i] = (jchar)src[i];
+      }
+      src += 8;
+      dst += 8;
+      continue;
+    }
+    int b1 = *src++;
+    if (b1 >= 0) {
+      if (dst == dst_end) return -1;
+      *dst++ = (jchar)b1;
+    } else if ((b1 >> 5) == -2 && (b1 & 0x1e) != 0) {
+      if (src == end || dst == dst_end) return -1;
+      int b2 = *src++;
+      if ((b2 & 0xc0) != 0x80) return -1;
+      *dst++ = (jchar)(((b1 & 0x1f) << 6) | (b2 & 0x3f));
+    } else if ((b1 >> 4) == -2) {
+      if (end - src < 2 || dst == dst_end) return -1;
+      int b2 = src[0];
+      int b3 = src[1];
+      src += 2;
+      if ((b1 == (jbyte)0xe0 && (b2 & 0xe0) == 0x80) ||
+          (b2 & 0xc0) != 0x80 || (b3 & 0xc0) != 0x80) {
+        return -1;
+      }
+      jchar c = (jchar)(((b1 & 0x0f) << 12) | ((b2 & 0x3f) << 6) | (b3 & 0x3f));
+      if (c >= 0xd800 && c <= 0xdfff) return -1;   // surrogate
+      *dst++ = c;
+    } else if ((b1 >> 3) == -2) {
+      if (end - src < 3 || dst_end - dst < 2) return -1;
+      int b2 = src[0];
+      int b3 = src[1];
+      int b4 = src[2];
+      src += 3;
+      if ((b2 & 0xc0) != 0x80 || (b3 & 0xc0) != 0x80 || (b4 & 0xc0) != 0x80) {
+        return -1;
+      }
+      int uc = ((b1 & 0x07) << 18) | ((b2 & 0x3f) << 12) | ((b3 & 0x3f) << 6) | (b4 & 0x3f);
+      if (uc < 0x10000 || uc > 0x10ffff) return -1;
+      *dst++ = (jchar)(0xd800 + ((uc - 0x10000) >> 10));
+      *dst++ = (jchar)(0xdc00 + ((uc - 0x10000) & 0x3ff));
+    } else {
+      return -1;
+    }
+  }
+  return (jint)(dst - dst_begin);
+JRT_END
+
+// sun.nio.cs.UTF_8$Encoder.encode(char[], int, int, byte[]) for input
+// without unpaired surrogates; -1 as for utf8_decode.
+JRT_LEAF(jint, StubRoutines::utf8_encode(const jchar* src, jint len, jbyte* dst, jint dst_len))
+  const jchar* const end = src + len;
+  jbyte* const dst_begin = dst;
+  jbyte* const dst_end = dst + dst_len;
+  while (src < end) {
+    if (end - src >= 4 && dst_end - dst >= 4 && ascii_char_word(src)) {
+      for (int i = 0; i < 4; i++) {
+        dst[i] = (jbyte)src[i];
+      }
+      src += 4;
+      dst += 4;
+      continue;
+    }
+    jchar c = *src++;
+    if (c < 0x80) {
+      if (dst == dst_end) return -1;
+      *dst++ = (jbyte)c;
+    } else if (c < 0x800) {
+      if (dst_end - dst < 2) return -1;
+      *dst++ = (jbyte)(0xc0 | (c >> 6));
+      *dst++ = (jbyte)(0x80 | (c & 0x3f));
+    } else if (c >= 0xd800 && c <= 0xdfff) {
+      if (c > 0xdbff || src == end || *src < 0xdc00 || *src > 0xdfff) {
+        return -1;                                    // unpaired surrogate
+      }
+      if (dst_end - dst < 4) return -1;
+      int uc = 0x10000 + ((c - 0xd800) << 10) + (*src++ - 0xdc00);
+      *dst++ = (jbyte)(0xf0 | (uc >> 18));
+      *dst++ = (jbyte)(0x80 | ((uc >> 12) & 0x3f));
+      *dst++ = (jbyte)(0x80 | ((uc >> 6) & 0x3f));
+      *dst++ = (jbyte)(0x80 | (uc & 0x3f));
+    } else {
+      if (dst_end - dst < 3) return -1;
+      *dst++ = (jbyte)(0xe0 | (c >> 12));
+      *dst++ = (jbyte)(0x80 | ((c >> 6) & 0x3f));
+      *dst++ = (jbyte)(0x80 | (c & 0x3f));
+    }
+  }
+  return (jint)(dst - dst_begin);
+JRT_END
+
+// sun.nio.cs.ISO_8859_1$Decoder.decode(byte[], int, int, char[])
+JRT_LEAF(jint, StubRoutines::latin1_decode(const jbyte* src, jint len, jchar* dst, jint dst_len))
+  if (len > dst_len) {
+    len = dst_len;
+  }
+  for (jint i = 0; i < len; i++) {
+    dst[i] = (jchar)(src[i] & 0xff);
+  }
+  return len;
+JRT_END
+
 address StubRoutines::select_fill_function(BasicType t, bool aligned, const char* &name) {
 #define RETURN_STUB(xxx_fill) { \
   name = #xxx_fill; \
@@ -30,6 +30,7 @@
 #include "runtime/frame.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/stubCodeGenerator.hpp"
+#include "runtime/timer.hpp"
 #include "utilities/top.hpp"
 #ifdef TARGET_ARCH_x86
 # include "nativeInst_x86.hpp"
@@ -214,12 +215,23 @@ class StubRoutines: AllStatic {
   static address _updateBytesCRC32;
   static address _crc_table_adr;
 
+  static address _byteArrayHashCode;
+  static address _charArrayHashCode;
+  static address _intArrayHashCode;
+
+  static address _unsafeVectorizedMismatch;
+  static address _unsafeHash;
+
   static address _multiplyToLen;
   static address _squareToLen;
   static address _mulAdd;
   static address _montgomeryMultiply;
   static address _montgomerySquare;
 
+  static address _utf8Decode;
+  static address _utf8Encode;
+  static address _latin1Decode;
+
   // These are versions of the java.lang.Math methods which perform
   // the same operations as the intrinsic version.  They are used for
   // constant folding in the compiler to ensure equivalence.  If the
@@ -242,17 +254,56 @@ class StubRoutines: AllStatic {
   static address _safefetchN_fault_pc;
   static address _safefetchN_continuation_pc;
 
+  static elapsedTimer _generation2_time;
+
+ public:
+  // Groups of compiler intrinsic stubs which, with LazyStubGeneration, are
+  // generated when a compiler first asks for one of their entries
+  enum LazyStubGroup {
+    lazy_aes,                 // AES block and CBC stubs
+    lazy_ghash,               // GHASH processBlocks
+    lazy_big_integer,         // multiplyToLen, squareToLen, mulAdd
+    lazy_array_hash_code,     // byte/char/int array hash codes
+    lazy_unsafe_memory,       // Unsafe mismatch and hash
+    lazy_group_count
+  };
+
+ private:
+  enum LazyStubState {
+    lazy_not_generated,
+    lazy_generating,
+    lazy_generated
+  };
+  static BufferBlob*   _code_lazy[lazy_group_count];
+  static volatile jint _lazy_state[lazy_group_count];
+  static void    generate_lazily(LazyStubGroup group);
+
+  friend class StubGenerationThread;
+  static void    generate2(bool verbose);
+
  public:
   // Initialization/Testing
   static void    initialize1();                            // must happen before universe::genesis
-  static void    initialize2();                            // must happen after  universe::genesis
+  static void    initialize2();                            // must happen after  universe_init
+  // With ParallelVMInit, run initialize2() on a helper thread from right after
+  // universe_init on; initialize2() then only waits for it.
+  static void    initialize2_in_background();
 
   static bool is_stub_code(address addr)                   { return contains(addr); }
 
   static bool contains(address addr) {
     return
       (_code1 != NULL && _code1->blob_contains(addr)) ||
-      (_code2 != NULL && _code2->blob_contains(addr)) ;
+      (_code2 != NULL && _code2->blob_contains(addr)) ||
+      lazy_contains(addr);
+  }
+  static bool lazy_contains(address addr) {
+    for (int i = 0; i < lazy_group_count; i++) {
+      if (_code_lazy[i] != NULL && _code_lazy[i]->blob_contains(addr)) {
+        return true;
+      }
+    }
+    return false;
   }
 
   static CodeBlob* code1() { return _code1; }
@@ -361,11 +412,12 @@ class StubRoutines: AllStatic {
   static address arrayof_jshort_fill() { return _arrayof_jshort_fill; }
   static address arrayof_jint_fill()   { return _arrayof_jint_fill; }
 
-  static address aescrypt_encryptBlock()                { return _aescrypt_encryptBlock; }
-  static address aescrypt_decryptBlock()                { return _aescrypt_decryptBlock; }
-  static address cipherBlockChaining_encryptAESCrypt()  { return _cipherBlockChaining_encryptAESCrypt; }
-  static address cipherBlockChaining_decryptAESCrypt()  { return _cipherBlockChaining_decryptAESCrypt; }
-  static address ghash_processBlocks() { return _ghash_processBlocks; }
+  // The entries of the lazy groups are only asked for by the compilers
+  static address aescrypt_encryptBlock()                { generate_lazily(lazy_aes); return _aescrypt_encryptBlock; }
+  static address aescrypt_decryptBlock()                { generate_lazily(lazy_aes); return _aescrypt_decryptBlock; }
+  static address cipherBlockChaining_encryptAESCrypt()  { generate_lazily(lazy_aes); return _cipherBlockChaining_encryptAESCrypt; }
+  static address cipherBlockChaining_decryptAESCrypt()  { generate_lazily(lazy_aes); return _cipherBlockChaining_decryptAESCrypt; }
+  static address ghash_processBlocks() { generate_lazily(lazy_ghash); return _ghash_processBlocks; }
 
   static address sha1_implCompress()     { return _sha1_implCompress; }
   static address sha1_implCompressMB()   { return _sha1_implCompressMB; }
@@ -377,12 +429,23 @@ class StubRoutines: AllStatic {
   static address updateBytesCRC32()    { return _updateBytesCRC32; }
   static address crc_table_addr()      { return _crc_table_adr; }
 
-  static address multiplyToLen()       {return _multiplyToLen; }
-  static address squareToLen()         {return _squareToLen; }
-  static address mulAdd()              {return _mulAdd; }
+  static address byteArrayHashCode()   { generate_lazily(lazy_array_hash_code); return _byteArrayHashCode; }
+  static address charArrayHashCode()   { generate_lazily(lazy_array_hash_code); return _charArrayHashCode; }
+  static address intArrayHashCode()    { generate_lazily(lazy_array_hash_code); return _intArrayHashCode; }
+
+  static address unsafeVectorizedMismatch() { generate_lazily(lazy_unsafe_memory); return _unsafeVectorizedMismatch; }
+  static address unsafeHash()          { generate_lazily(lazy_unsafe_memory); return _unsafeHash; }
+
+  static address multiplyToLen()       { generate_lazily(lazy_big_integer); return _multiplyToLen; }
+  static address squareToLen()         { generate_lazily(lazy_big_integer); return _squareToLen; }
+  static address mulAdd()              { generate_lazily(lazy_big_integer); return _mulAdd; }
   static address montgomeryMultiply()  { return _montgomeryMultiply; }
   static address montgomerySquare()    { return _montgomerySquare; }
 
+  static address utf8Decode()          { return _utf8Decode; }
+  static address utf8Encode()          { return _utf8Encode; }
+  static address latin1Decode()        { return _latin1Decode; }
+
   static address select_fill_function(BasicType t, bool aligned, const char* &name);
 
   static address zero_aligned_words()   { return _zero_aligned_words; }
@@ -460,6 +523,14 @@ class StubRoutines: AllStatic {
   static void arrayof_jlong_copy     (HeapWord* src, HeapWord* dest, size_t count);
   static void arrayof_oop_copy       (HeapWord* src, HeapWord* dest, size_t count);
   static void arrayof_oop_copy_uninit(HeapWord* src, HeapWord* dest, size_t count);
+
+  //
+  // Default versions of the charset array coders; a negative result sends
+  // the compiled code to the Java method
+  //
+  static jint utf8_decode  (const jbyte* src, jint len, jchar* dst, jint dst_len);
+  static jint utf8_encode  (const jchar* src, jint len, jbyte* dst, jint dst_len);
+  static jint latin1_decode(const jbyte* src, jint len, jchar* dst, jint dst_len);
 };
 
 // Safefetch allows to load a value from a location that's not known
@@ -32,7 +32,9 @@
 #include "memory/resourceArea.hpp"
 #include "oops/method.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/codeCacheSweeperThread.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.hpp"
@@ -201,11 +203,21 @@ bool NMethodSweeper::sweep_in_progress() {
 // No need to synchronize access, since 'mark_active_nmethods' is always executed at a
 // safepoint.
 void NMethodSweeper::mark_active_nmethods() {
+  CodeBlobClosure* cl = prepare_mark_active_nmethods();
+  if (cl != NULL) {
+    Threads::nmethods_do(cl);
+    OrderAccess::storestore();
+  }
+}
+
+// Updates the sweep state and returns the closure to apply to the
+// nmethods on every thread's stack, or NULL if stacks need not be scanned.
+CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
   // If we do not want to reclaim not-entrant or zombie methods there is no need
   // to scan stacks
   if (!MethodFlushing) {
-    return;
+    return NULL;
   }
 
   // Increase time so that we can estimate when to invoke the sweeper again.
@@ -223,14 +235,12 @@ void NMethodSweeper::mark_active_nmethods() {
     if (PrintMethodFlushing) {
       tty->print_cr("### Sweep: stack traversal %d", _traversals);
     }
-    Threads::nmethods_do(&mark_activation_closure);
+    return &mark_activation_closure;
 
   } else {
     // Only set hotness counter
-    Threads::nmethods_do(&set_hotness_closure);
+    return &set_hotness_closure;
   }
-
-  OrderAccess::storestore();
 }
 /**
  * This function invokes the sweeper if at least one of the three conditions is met:
@@ -240,8 +250,8 @@ void NMethodSweeper::mark_active_nmethods() {
  */
 void NMethodSweeper::possibly_sweep() {
   assert(JavaThread::current()->thread_state() == _thread_in_vm, "must run in vm mode");
-  // Only compiler threads are allowed to sweep
-  if (!MethodFlushing || !sweep_in_progress() || !Thread::current()->is_Compiler_thread()) {
+  // Only compiler threads or the sweeper thread are allowed to sweep
+  if (!MethodFlushing || !sweep_in_progress() || !may_sweep(Thread::current())) {
     return;
   }
 
@@ -318,6 +328,56 @@ void NMethodSweeper::possibly_sweep() {
   }
 }
 
+bool NMethodSweeper::may_sweep(Thread* thread) {
+  if (UseCodeCacheSweeperThread) {
+    return thread->is_Code_cache_sweeper_thread();
+  }
+  return thread->is_Compiler_thread();
+}
+
+/**
+ * Wakes up the sweeper thread. Compiler threads call this where they would
+ * otherwise sweep themselves: when they look for a new task and when the
+ * code cache is full. Without UseCodeCacheSweeperThread they just sweep.
+ */
+void NMethodSweeper::notify() {
+  if (!UseCodeCacheSweeperThread) {
+    possibly_sweep();
+    return;
+  }
+  MutexLockerEx mu(CodeSweeper_lock, Mutex::_no_safepoint_check_flag);
+  CodeSweeper_lock->notify();
+}
+
+/**
+ * Main loop of the sweeper thread. It sleeps until it is notified or
+ * NmethodSweepCheckInterval has passed and then does what a compiler thread
+ * would have done, i.e. possibly sweeps one fraction of the code cache. When
+ * compilation is stopped because the code cache is full, possibly_sweep()
+ * already sweeps the whole cache at once.
+ */
+void NMethodSweeper::sweeper_loop() {
+  JavaThread* thread = JavaThread::current();
+  assert(thread->is_Code_cache_sweeper_thread(), "must be sweeper thread");
+  while (true) {
+    {
+      // Need state transition ThreadBlockInVM so that this thread
+      // will be handled by safepoint correctly when this thread is
+      // notified at a safepoint.
+      ThreadBlockInVM tbivm(thread);
+      MutexLockerEx waiter(CodeSweeper_lock, Mutex::_no_safepoint_check_flag);
+      long wait_time = NmethodSweepCheckInterval * 1000;
+      if (FLAG_IS_DEFAULT(NmethodSweepCheckInterval) && !CompileBroker::should_compile_new_jobs()) {
+        // The code cache is full: sweep about as often as the compiler
+        // threads together used to.
+        wait_time = 100;
+      }
+      CodeSweeper_lock->wait(Mutex::_no_safepoint_check_flag, wait_time);
+    }
+    possibly_sweep();
+  }
+}
+
 static void post_sweep_event(EventSweepCodeCache* event,
                              const Ticks& start,
                              const Ticks& end,
@@ -469,17 +529,25 @@ void NMethodSweeper::possibly_enable_sweeper() {
 
 class NMethodMarker: public StackObj {
  private:
-  CompilerThread* _thread;
+  JavaThread* _thread;
+
+  void set_scanned_nmethod(nmethod* nm) {
+    if (_thread->is_Code_cache_sweeper_thread()) {
+      ((CodeCacheSweeperThread*)_thread)->set_scanned_nmethod(nm);
+    } else {
+      _thread->as_CompilerThread()->set_scanned_nmethod(nm);
+    }
+  }
  public:
   NMethodMarker(nmethod* nm) {
-    _thread = CompilerThread::current();
+    _thread = JavaThread::current();
     if (!nm->is_zombie() && !nm->is_unloaded()) {
       // Only expose live nmethods for scanning
-      _thread->set_scanned_nmethod(nm);
+      set_scanned_nmethod(nm);
     }
   }
   ~NMethodMarker() {
-    _thread->set_scanned_nmethod(NULL);
+    set_scanned_nmethod(NULL);
   }
 };
 
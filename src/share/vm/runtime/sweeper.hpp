@@ -51,7 +51,8 @@
 //     state change happens during separate sweeps. It may take at least 3 sweeps before an
 //     nmethod's space is freed. Sweeping is currently done by compiler threads between
 //     compilations or at least each 5 sec (NmethodSweepCheckInterval) when the code cache
-//     is full.
+//     is full. With UseCodeCacheSweeperThread it is done by a dedicated sweeper
+//     thread instead, which compiler threads wake up where they would have swept.
 
 class NMethodSweeper : public AllStatic {
   static long      _traversals;                     // Stack scan count, also sweep ID.
@@ -87,6 +88,7 @@ class NMethodSweeper : public AllStatic {
 
   static bool sweep_in_progress();
   static void sweep_code_cache();
+  static bool may_sweep(Thread* thread);
 
  public:
   static long traversal_count()              { return _traversals; }
@@ -106,7 +108,10 @@ class NMethodSweeper : public AllStatic {
 #endif
 
   static void mark_active_nmethods();      // Invoked at the end of each safepoint
+  static CodeBlobClosure* prepare_mark_active_nmethods();
   static void possibly_sweep();            // Compiler threads call this to sweep
+  static void sweeper_loop();              // Main loop of the sweeper thread
+  static void notify();                    // Wakes up the sweeper thread
 
   static int hotness_counter_reset_val();
   static void report_state_change(nmethod* nm);
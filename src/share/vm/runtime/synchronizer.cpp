@@ -156,6 +156,11 @@ ObjectMonitor * volatile ObjectSynchronizer::gBlockList = NULL;
 ObjectMonitor * volatile ObjectSynchronizer::gFreeList  = NULL ;
 ObjectMonitor * volatile ObjectSynchronizer::gOmInUseList  = NULL ;
 int ObjectSynchronizer::gOmInUseCount = 0;
+ObjectMonitor * volatile ObjectSynchronizer::gAsyncInUseList = NULL;
+volatile int ObjectSynchronizer::gAsyncInUseCount = 0;
+ObjectMonitor * ObjectSynchronizer::gAsyncDeflatedList = NULL;
+int ObjectSynchronizer::gAsyncDeflatedCount = 0;
+jlong ObjectSynchronizer::gLastAsyncDeflationMillis = 0;
 static volatile intptr_t ListLock = 0 ;      // protects global monitor free-list cache
 static volatile int MonitorFreeCount  = 0 ;      // # on gFreeList
 static volatile int MonitorPopulation = 0 ;      // # Extant -- in circulation
@@ -187,6 +192,10 @@ void ObjectSynchronizer::fast_enter(Handle obj, BasicLock* lock, bool attempt_re
 
 void ObjectSynchronizer::fast_exit(oop object, BasicLock* lock, TRAPS) {
   assert(!object->mark()->has_bias_pattern(), "should not see bias pattern here");
+  if (UseLightweightLocking) {
+    lightweight_exit(object, THREAD);
+    return;
+  }
   // if displaced header is null, the previous enter is recursive enter, no-op
   markOop dhw = lock->displaced_header();
   markOop mark ;
@@ -224,6 +233,10 @@ void ObjectSynchronizer::fast_exit(oop object, BasicLock* lock, TRAPS) {
 }
 void ObjectSynchronizer::fast_exit(Handle object, BasicLock* lock, TRAPS) {
   assert(!object->mark()->has_bias_pattern(), "should not see bias pattern here");
+  if (UseLightweightLocking) {
+    lightweight_exit(object(), THREAD);
+    return;
+  }
   // if displaced header is null, the previous enter is recursive enter, no-op
   markOop dhw = lock->displaced_header();
   markOop mark ;
@@ -266,6 +279,13 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   markOop mark = obj->mark();
   assert(!mark->has_bias_pattern(), "should not see bias pattern here");
 
+  if (UseLightweightLocking) {
+    // The BasicLock is unused, just keep it from looking recursive.
+    lock->set_displaced_header(markOopDesc::unused_mark());
+    lightweight_enter(obj, THREAD);
+    return;
+  }
+
   if (mark->is_neutral()) {
     // Anticipate successful CAS -- the ST of the displaced mark must
     // be visible <= the ST performed by the CAS.
@@ -296,9 +316,67 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
+  while (!ObjectSynchronizer::inflate(THREAD,
+                                      obj(),
+                                      inflate_cause_monitor_enter)->enter(THREAD)) {
+    // The monitor was deflated by the service thread while we were trying
+    // to enter it; the object header has been restored, so re-inflate.
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Lightweight locking (-XX:+UseLightweightLocking)
+// An uncontended lock clears the lock bits of a neutral mark and pushes the
+// object on the owner's lock stack; the mark keeps its hash and age. A
+// recursive, contended or waited-on lock, and any lock taken while the lock
+// stack is full, uses an inflated monitor instead. A monitor inflated by a
+// thread other than the fast-locking owner starts out with ANONYMOUS_OWNER
+// and the owner claims it the next time it inflates the object.
+
+static bool is_fast_locked_by(Thread* thread, oop obj) {
+  return thread->is_Java_thread() &&
+         ((JavaThread*)thread)->lock_stack().contains(obj);
+}
+
+void ObjectSynchronizer::lightweight_enter(Handle obj, TRAPS) {
+  if (THREAD->is_Java_thread()) {
+    LockStack& lock_stack = ((JavaThread*)THREAD)->lock_stack();
+    markOop mark = obj->mark();
+    while (mark->is_neutral() && lock_stack.can_push()) {
+      markOop cmp = (markOop) Atomic::cmpxchg_ptr(mark->set_fast_locked(), obj()->mark_addr(), mark);
+      if (cmp == mark) {
+        TEVENT (lightweight_enter: fast lock) ;
+        lock_stack.push(obj());
+        return;
+      }
+      mark = cmp;   // Interference -- retry while still neutral
+    }
+  }
+
+  while (!ObjectSynchronizer::inflate(THREAD,
+                                      obj(),
+                                      inflate_cause_monitor_enter)->enter(THREAD)) {
+    // Lost a race with async deflation; retry with a fresh monitor.
+  }
+}
+
+void ObjectSynchronizer::lightweight_exit(oop object, TRAPS) {
+  markOop mark = object->mark();
+  if (mark->is_fast_locked() && THREAD->is_Java_thread()) {
+    LockStack& lock_stack = ((JavaThread*)THREAD)->lock_stack();
+    assert(lock_stack.contains(object), "must be fast-locked by the current thread");
+    if ((markOop) Atomic::cmpxchg_ptr(mark->set_unlocked(), object->mark_addr(), mark) == mark) {
+      TEVENT (lightweight_exit: fast unlock) ;
+      lock_stack.remove(object);
+      return;
+    }
+    // A contending thread inflated the object; inflate() below claims
+    // the anonymously owned monitor.
+  }
+
   ObjectSynchronizer::inflate(THREAD,
-                              obj(),
-                              inflate_cause_monitor_enter)->enter(THREAD);
+                              object,
+                              inflate_cause_vm_internal)->exit(true, THREAD);
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -343,11 +421,12 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD,
-                                                       obj(),
-                                                       inflate_cause_vm_internal);
-
-  monitor->reenter(recursion, THREAD);
+  ObjectMonitor* monitor;
+  do {
+    monitor = ObjectSynchronizer::inflate(THREAD,
+                                          obj(),
+                                          inflate_cause_vm_internal);
+  } while (!monitor->reenter(recursion, THREAD));
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -360,7 +439,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) { // possible entry from j
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj(), inflate_cause_jni_enter)->enter(THREAD)) {
+    // Lost a race with async deflation; retry with a fresh monitor.
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -371,8 +452,17 @@ bool ObjectSynchronizer::jni_try_enter(Handle obj, Thread* THREAD) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate_helper(obj());
-  return monitor->try_enter(THREAD);
+  for (;;) {
+    ObjectMonitor* monitor = ObjectSynchronizer::inflate_helper(obj());
+    if (monitor->try_enter(THREAD)) {
+      return true;
+    }
+    if (!monitor->is_being_async_deflated()) {
+      return false;
+    }
+    // The object is not locked, the monitor is just going away.
+    monitor->install_displaced_markword_in_object(obj());
+  }
 }
 
 
@@ -467,7 +557,12 @@ void ObjectSynchronizer::notify(Handle obj, TRAPS) {
   }
 
   markOop mark = obj->mark();
-  if (mark->has_locker() && THREAD->is_lock_owned((address)mark->locker())) {
+  if (UseLightweightLocking) {
+    if (mark->is_fast_locked() && is_fast_locked_by(THREAD, obj())) {
+      // Not inflated so there can't be any waiters to notify.
+      return;
+    }
+  } else if (mark->has_locker() && THREAD->is_lock_owned((address)mark->locker())) {
     return;
   }
   ObjectSynchronizer::inflate(THREAD,
@@ -483,7 +578,12 @@ void ObjectSynchronizer::notifyall(Handle obj, TRAPS) {
   }
 
   markOop mark = obj->mark();
-  if (mark->has_locker() && THREAD->is_lock_owned((address)mark->locker())) {
+  if (UseLightweightLocking) {
+    if (mark->is_fast_locked() && is_fast_locked_by(THREAD, obj())) {
+      // Not inflated so there can't be any waiters to notify.
+      return;
+    }
+  } else if (mark->has_locker() && THREAD->is_lock_owned((address)mark->locker())) {
     return;
   }
   ObjectSynchronizer::inflate(THREAD,
@@ -531,7 +631,9 @@ static volatile int ForceMonitorScavenge = 0 ; // Scavenge required and pending
 
 static markOop ReadStableMark (oop obj) {
   markOop mark = obj->mark() ;
-  if (!mark->is_being_inflated()) {
+  // With lightweight locking the mark is never INFLATING; 0 is simply a
+  // fast-locked mark without a hash.
+  if (UseLightweightLocking || !mark->is_being_inflated()) {
     return mark ;       // normal fast-path return
   }
 
@@ -721,9 +823,27 @@ intptr_t ObjectSynchronizer::FastHashCode (Thread * Self, oop obj) {
     assert (temp->is_neutral(), "invariant") ;
     hash = temp->hash();
     if (hash) {
+      if (AsyncDeflateIdleMonitors) {
+        // The hash must be read before the deflation state is checked.
+        OrderAccess::loadload();
+        if (monitor->is_being_async_deflated()) {
+          // The header may have been restored in the object without it;
+          // help finish the deflation and start over.
+          monitor->install_displaced_markword_in_object(obj);
+          return FastHashCode(Self, obj);
+        }
+      }
       return hash;
     }
     // Skip to the following code to reduce code size
+  } else if (UseLightweightLocking) {
+    // Fast-locked: the hash, if any, is still in the mark. Installing one
+    // would race with the owner's unlock CAS, so inflate instead.
+    assert (mark->is_fast_locked(), "invariant") ;
+    hash = mark->hash();
+    if (hash) {
+      return hash;
+    }
   } else if (Self->is_lock_owned((address)mark->locker())) {
     temp = mark->displaced_mark_helper(); // this is a lightweight monitor owned
     assert (temp->is_neutral(), "invariant") ;
@@ -762,6 +882,16 @@ intptr_t ObjectSynchronizer::FastHashCode (Thread * Self, oop obj) {
       assert (hash != 0, "Trivial unexpected object/monitor header usage.");
     }
   }
+  if (AsyncDeflateIdleMonitors) {
+    OrderAccess::fence();
+    if (monitor->is_being_async_deflated()) {
+      // The service thread may have restored the object header before our
+      // hash reached the monitor. Make sure the object is deflated and retry
+      // against the plain header.
+      monitor->install_displaced_markword_in_object(obj);
+      return FastHashCode(Self, obj);
+    }
+  }
   // We finally get the hash
   return hash;
 }
@@ -787,6 +917,13 @@ bool ObjectSynchronizer::current_thread_holds_lock(JavaThread* thread,
 
   markOop mark = ReadStableMark (obj) ;
 
+  if (UseLightweightLocking) {
+    // Fast-locked, or inflated by another thread and not yet claimed
+    if (mark->is_fast_locked() ||
+        (mark->has_monitor() && mark->monitor()->is_owner_anonymous())) {
+      return is_fast_locked_by(thread, obj);
+    }
+  } else
   // Uncontended case, header points to stack
   if (mark->has_locker()) {
     return thread->is_lock_owned((address)mark->locker());
@@ -826,6 +963,13 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
   oop obj = h_obj();
   markOop mark = ReadStableMark (obj) ;
 
+  // CASE: fast-locked, or inflated but still owned through a lock stack.
+  if (UseLightweightLocking) {
+    if (mark->is_fast_locked() ||
+        (mark->has_monitor() && mark->monitor()->is_owner_anonymous())) {
+      return is_fast_locked_by(self, obj) ? owner_self : owner_other;
+    }
+  } else
   // CASE: stack-locked.  Mark points to a BasicLock on the owner's stack.
   if (mark->has_locker()) {
     return self->is_lock_owned((address)mark->locker()) ?
@@ -863,6 +1007,12 @@ JavaThread* ObjectSynchronizer::get_lock_owner(Handle h_obj, bool doLock) {
 
   markOop mark = ReadStableMark (obj) ;
 
+  if (UseLightweightLocking) {
+    // Fast-locked, owner is on a lock stack
+    if (mark->is_fast_locked()) {
+      return Threads::owning_thread_from_object(obj, doLock);
+    }
+  } else
   // Uncontended case, header points to stack
   if (mark->has_locker()) {
     owner = (address) mark->locker();
@@ -872,7 +1022,7 @@ JavaThread* ObjectSynchronizer::get_lock_owner(Handle h_obj, bool doLock) {
   if (mark->has_monitor()) {
     ObjectMonitor* monitor = mark->monitor();
     assert(monitor != NULL, "monitor should be non-null");
-    owner = (address) monitor->owner();
+    return Threads::owning_thread_from_monitor(monitor, doLock);
   }
 
   if (owner != NULL) {
@@ -1313,9 +1463,67 @@ ObjectMonitor * ATTR ObjectSynchronizer::inflate (Thread * Self,
           assert (inf->header()->is_neutral(), "invariant");
           assert (inf->object() == object, "invariant") ;
           assert (ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
+          if (UseLightweightLocking && inf->is_owner_anonymous() &&
+              is_fast_locked_by(Self, object)) {
+            // Inflated by a contending thread while we held the fast lock.
+            inf->set_owner_from_anonymous(Self);
+            ((JavaThread*)Self)->lock_stack().remove(object);
+          }
           return inf ;
       }
 
+      // CASE: fast-locked (UseLightweightLocking)
+      // Could be fast-locked either by this thread or by some other thread.
+      // The mark still holds the hash, so inflate with a single CAS; there
+      // is no displaced header to fetch and no INFLATING window.
+      if (UseLightweightLocking && mark->is_fast_locked()) {
+          ObjectMonitor * m = omAlloc (Self) ;
+          m->Recycle();
+          m->_Responsible  = NULL ;
+          m->_recursions   = 0 ;
+          m->_SpinDuration = ObjectMonitor::Knob_SpinLimit ;
+          m->set_header(mark->set_unlocked());
+          m->set_object(object);
+          const bool own = is_fast_locked_by(Self, object);
+          if (own) {
+            m->set_owner(Self);
+            m->OwnerIsThread = 1 ;
+          } else {
+            m->set_owner(ANONYMOUS_OWNER);
+            m->OwnerIsThread = 0 ;
+          }
+
+          if (Atomic::cmpxchg_ptr (markOopDesc::encode(m), object->mark_addr(), mark) != mark) {
+              m->set_object (NULL) ;
+              m->set_owner  (NULL) ;
+              m->OwnerIsThread = 0 ;
+              m->Recycle() ;
+              omRelease (Self, m, true) ;
+              continue ;       // Interference -- just retry
+          }
+          if (own) {
+            ((JavaThread*)Self)->lock_stack().remove(object);
+          }
+          if (AsyncDeflateIdleMonitors) {
+            add_to_async_in_use_list(m);
+          }
+
+          if (ObjectMonitor::_sync_Inflations != NULL) ObjectMonitor::_sync_Inflations->inc() ;
+          TEVENT(Inflate: overwrite fast lock) ;
+          if (TraceMonitorInflation) {
+            if (object->is_instance()) {
+              ResourceMark rm;
+              tty->print_cr("Inflating object " INTPTR_FORMAT " , mark " INTPTR_FORMAT " , type %s",
+                (void *) object, (intptr_t) object->mark(),
+                object->klass()->external_name());
+            }
+          }
+          if (event.should_commit()) {
+            post_monitor_inflate_event(&event, object, cause);
+          }
+          return m ;
+      }
+
       // CASE: inflation in progress - inflating over a stack-lock.
       // Some other thread is converting from stack-locked to inflated.
       // Only that thread can complete inflation -- other threads must wait.
@@ -1413,6 +1621,9 @@ ObjectMonitor * ATTR ObjectSynchronizer::inflate (Thread * Self,
           // be stable at the time of publishing the monitor address.
           guarantee (object->mark() == markOopDesc::INFLATING(), "invariant") ;
           object->release_set_mark(markOopDesc::encode(m));
+          if (AsyncDeflateIdleMonitors) {
+            add_to_async_in_use_list(m);
+          }
 
           // Hopefully the performance counters are allocated on distinct cache lines
           // to avoid false sharing on MP systems ...
@@ -1466,6 +1677,9 @@ ObjectMonitor * ATTR ObjectSynchronizer::inflate (Thread * Self,
           // The state-transitions are one-way, so there's no chance of
           // live-lock -- "Inflated" is an absorbing state.
       }
+      if (AsyncDeflateIdleMonitors) {
+        add_to_async_in_use_list(m);
+      }
 
       // Hopefully the performance counters are allocated on distinct
       // cache lines to avoid false sharing on MP systems ...
@@ -1602,7 +1816,31 @@ int ObjectSynchronizer::walk_monitor_list(ObjectMonitor** listheadp,
   return deflatedcount;
 }
 
-void ObjectSynchronizer::deflate_idle_monitors() {
+void ObjectSynchronizer::prepare_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  counters->nInuse = 0;          // currently associated with objects
+  counters->nInCirculation = 0;  // extant
+  counters->nScavenged = 0;      // reclaimed
+}
+
+// Splice a local SLL of scavenged monitors onto the global free list
+void ObjectSynchronizer::prepend_to_free_list(ObjectMonitor* FreeHead, ObjectMonitor* FreeTail, int nScavenged) {
+  // The caller holds ListLock
+  if (FreeHead != NULL) {
+     guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
+     assert (FreeTail->FreeNext == NULL, "invariant") ;
+     // constant-time list splice - prepend scavenged segment to gFreeList
+     FreeTail->FreeNext = gFreeList ;
+     gFreeList = FreeHead ;
+  }
+  MonitorFreeCount += nScavenged;
+}
+
+// Deflates the monitors that are not on a live thread's in-use list: the
+// whole block list without MonitorInUseLists, otherwise the monitors of
+// moribund threads on gOmInUseList. The per-thread lists are handled by
+// deflate_thread_local_monitors(), possibly in parallel.
+void ObjectSynchronizer::deflate_idle_monitors(DeflateMonitorCounters* counters) {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   int nInuse = 0 ;              // currently associated with objects
   int nInCirculation = 0 ;      // extant
@@ -1618,17 +1856,21 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   // See e.g. 6320749
   Thread::muxAcquire (&ListLock, "scavenge - return") ;
 
-  if (MonitorInUseLists) {
-    int inUse = 0;
-    for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
-      nInCirculation+= cur->omInUseCount;
-      int deflatedcount = walk_monitor_list(cur->omInUseList_addr(), &FreeHead, &FreeTail);
-      cur->omInUseCount-= deflatedcount;
-      // verifyInUse(cur);
-      nScavenged += deflatedcount;
-      nInuse += cur->omInUseCount;
-     }
+  if (AsyncDeflateIdleMonitors) {
+    // The service thread does the deflation; all that is left to do at
+    // the safepoint is to make its work available for reuse.
+    nScavenged = recycle_async_deflated_monitors();
+    nInuse = gAsyncInUseCount;
+    nInCirculation = MonitorPopulation;
+    Thread::muxRelease (&ListLock) ;
+
+    Atomic::add(nInuse, &counters->nInuse);
+    Atomic::add(nInCirculation, &counters->nInCirculation);
+    Atomic::add(nScavenged, &counters->nScavenged);
+    return;
+  }
 
+  if (MonitorInUseLists) {
    // For moribund threads, scan gOmInUseList
    if (gOmInUseList) {
      nInCirculation += gOmInUseCount;
@@ -1669,31 +1911,58 @@ void ObjectSynchronizer::deflate_idle_monitors() {
     }
   }
 
-  MonitorFreeCount += nScavenged;
-
   // Consider: audit gFreeList to ensure that MonitorFreeCount and list agree.
 
+  // Move the scavenged monitors back to the global free list.
+  prepend_to_free_list(FreeHead, FreeTail, nScavenged);
+  Thread::muxRelease (&ListLock) ;
+
+  Atomic::add(nInuse, &counters->nInuse);
+  Atomic::add(nInCirculation, &counters->nInCirculation);
+  Atomic::add(nScavenged, &counters->nScavenged);
+}
+
+void ObjectSynchronizer::deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (!MonitorInUseLists) {
+    return;
+  }
+
+  ObjectMonitor * FreeHead = NULL ;  // Local SLL of scavenged monitors
+  ObjectMonitor * FreeTail = NULL ;
+
+  // Only the owner changes its in-use list outside of a safepoint, and a
+  // thread on the Threads list does not omFlush(), so the list can be
+  // walked without ListLock.
+  int nInCirculation = thread->omInUseCount;
+  int deflatedcount = walk_monitor_list(thread->omInUseList_addr(), &FreeHead, &FreeTail);
+  thread->omInUseCount -= deflatedcount;
+  // verifyInUse(thread);
+
+  if (deflatedcount > 0) {
+    Thread::muxAcquire (&ListLock, "scavenge - return") ;
+    prepend_to_free_list(FreeHead, FreeTail, deflatedcount);
+    Thread::muxRelease (&ListLock) ;
+  }
+
+  Atomic::add(thread->omInUseCount, &counters->nInuse);
+  Atomic::add(nInCirculation, &counters->nInCirculation);
+  Atomic::add(deflatedcount, &counters->nScavenged);
+}
+
+void ObjectSynchronizer::finish_deflate_idle_monitors(DeflateMonitorCounters* counters) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   if (ObjectMonitor::Knob_Verbose) {
     ::printf ("Deflate: InCirc=%d InUse=%d Scavenged=%d ForceMonitorScavenge=%d : pop=%d free=%d\n",
-        nInCirculation, nInuse, nScavenged, ForceMonitorScavenge,
+        counters->nInCirculation, counters->nInuse, counters->nScavenged, ForceMonitorScavenge,
         MonitorPopulation, MonitorFreeCount) ;
     ::fflush(stdout) ;
   }
 
   ForceMonitorScavenge = 0;    // Reset
 
-  // Move the scavenged monitors back to the global free list.
-  if (FreeHead != NULL) {
-     guarantee (FreeTail != NULL && nScavenged > 0, "invariant") ;
-     assert (FreeTail->FreeNext == NULL, "invariant") ;
-     // constant-time list splice - prepend scavenged segment to gFreeList
-     FreeTail->FreeNext = gFreeList ;
-     gFreeList = FreeHead ;
-  }
-  Thread::muxRelease (&ListLock) ;
-
-  if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(nScavenged) ;
-  if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(nInCirculation);
+  if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(counters->nScavenged) ;
+  if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(counters->nInCirculation);
 
   // TODO: Add objectMonitor leak detection.
   // Audit/inventory the objectMonitors -- make sure they're all accounted for.
@@ -1701,6 +1970,174 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   GVars.stwCycle ++ ;
 }
 
+// -----------------------------------------------------------------------------
+// Concurrent deflation (AsyncDeflateIdleMonitors)
+//
+// The service thread deflates idle monitors while mutators run, in three
+// steps that each can only succeed if the monitor is still idle:
+//
+//   1. CAS _owner from NULL to DEFLATER_MARKER. Mutators can no longer
+//      acquire the monitor, and owner() reports it as unowned.
+//   2. CAS _count from 0 to min_jint. A thread that increments _count on
+//      its way into EnterI() either makes this fail, or sees a non-positive
+//      result in ObjectMonitor::enter() and backs out.
+//   3. Restore the displaced header in the object. Threads that backed
+//      out in step 2 do the same, so whoever gets there first wins.
+//
+// If step 2 fails the deflater briefly owns the monitor and exits it
+// normally, so that contenders that queued up meanwhile get woken.
+//
+// A deflated monitor keeps its object, header and marker until the next
+// safepoint, so a racing thread that loaded the monitor from the object
+// header before step 3 still finds it consistent. Only then is it put
+// back on gFreeList.
+
+void ObjectSynchronizer::add_to_async_in_use_list(ObjectMonitor* m) {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  ObjectMonitor* head;
+  do {
+    head = gAsyncInUseList;
+    m->FreeNext = head;
+  } while (Atomic::cmpxchg_ptr(m, &gAsyncInUseList, head) != head);
+  Atomic::inc(&gAsyncInUseCount);
+}
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors || gAsyncInUseCount == 0) {
+    return false;
+  }
+  return os::javaTimeMillis() - gLastAsyncDeflationMillis >= (jlong)AsyncDeflationInterval;
+}
+
+// Caller is the service thread, the only one that unlinks from
+// gAsyncInUseList. Returns the new predecessor of mid's successor.
+ObjectMonitor* ObjectSynchronizer::unlink_from_async_in_use_list(ObjectMonitor* prev,
+                                                                 ObjectMonitor* mid) {
+  ObjectMonitor* next = mid->FreeNext;
+  if (prev == NULL) {
+    if (Atomic::cmpxchg_ptr(next, &gAsyncInUseList, mid) == mid) {
+      return NULL;
+    }
+    // Monitors inflated since we read the head were prepended before mid.
+    prev = gAsyncInUseList;
+    while (prev->FreeNext != mid) {
+      prev = prev->FreeNext;
+    }
+  }
+  prev->FreeNext = next;
+  return prev;
+}
+
+bool ObjectSynchronizer::deflate_monitor_using_JT(ObjectMonitor* mid, Thread* self) {
+  if (mid->is_busy()) {
+    return false;
+  }
+  if (Atomic::cmpxchg_ptr(DEFLATER_MARKER, &mid->_owner, NULL) != NULL) {
+    return false;
+  }
+  if (mid->_waiters != 0 || mid->_cxq != NULL || mid->_EntryList != NULL ||
+      Atomic::cmpxchg_ptr((intptr_t)min_jint, &mid->_count, (intptr_t)0) != 0) {
+    // A contender showed up. Commute the marker into ordinary ownership by
+    // this thread and release the monitor, which takes care of succession.
+    mid->_owner = self;
+    OrderAccess::fence();
+    mid->exit(true, self);
+    return false;
+  }
+
+  oop obj = (oop) mid->object();
+  assert(obj != NULL, "in-use monitor without object");
+  assert(mid->is_being_async_deflated(), "invariant");
+  if (TraceMonitorInflation) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      tty->print_cr("Async deflating object " INTPTR_FORMAT " , mark " INTPTR_FORMAT " , type %s",
+                    (void *) obj, (intptr_t) obj->mark(), obj->klass()->external_name());
+    }
+  }
+  mid->install_displaced_markword_in_object(obj);
+  return true;
+}
+
+void ObjectSynchronizer::deflate_idle_monitors_using_JT() {
+  assert(AsyncDeflateIdleMonitors, "sanity check");
+  JavaThread* self = JavaThread::current();
+  assert(self->thread_state() == _thread_in_vm, "invariant");
+
+  ObjectMonitor* deflated_head = NULL;
+  ObjectMonitor* deflated_tail = NULL;
+  int deflated_count = 0;
+
+  ObjectMonitor* prev = NULL;
+  ObjectMonitor* mid = (ObjectMonitor*) OrderAccess::load_ptr_acquire(&gAsyncInUseList);
+  while (mid != NULL) {
+    ObjectMonitor* next = mid->FreeNext;
+    if (deflate_monitor_using_JT(mid, self)) {
+      prev = unlink_from_async_in_use_list(prev, mid);
+      mid->FreeNext = deflated_head;
+      deflated_head = mid;
+      if (deflated_tail == NULL) {
+        deflated_tail = mid;
+      }
+      deflated_count++;
+    } else {
+      prev = mid;
+    }
+    mid = next;
+
+    if (SafepointSynchronize::is_synchronizing()) {
+      // Don't hold up the safepoint. prev and mid are still on the in-use
+      // list, which nothing else unlinks from, so the walk can resume.
+      ThreadBlockInVM tbivm(self);
+    }
+  }
+
+  if (deflated_count > 0) {
+    Atomic::add(-deflated_count, &gAsyncInUseCount);
+    Thread::muxAcquire(&ListLock, "async deflation");
+    deflated_tail->FreeNext = gAsyncDeflatedList;
+    gAsyncDeflatedList = deflated_head;
+    gAsyncDeflatedCount += deflated_count;
+    Thread::muxRelease(&ListLock);
+  }
+  gLastAsyncDeflationMillis = os::javaTimeMillis();
+
+  if (ObjectMonitor::Knob_Verbose) {
+    ::printf("Async deflate: InUse=%d Deflated=%d : pop=%d free=%d\n",
+             gAsyncInUseCount, deflated_count, MonitorPopulation, MonitorFreeCount);
+    ::fflush(stdout);
+  }
+}
+
+// Caller holds ListLock at a safepoint
+int ObjectSynchronizer::recycle_async_deflated_monitors() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  ObjectMonitor* head = gAsyncDeflatedList;
+  ObjectMonitor* tail = NULL;
+  int count = gAsyncDeflatedCount;
+  for (ObjectMonitor* mid = head; mid != NULL; mid = mid->FreeNext) {
+    assert(mid->is_being_async_deflated(), "invariant");
+    mid->_owner = NULL;
+    mid->_count = 0;
+    mid->clear();
+    tail = mid;
+  }
+  gAsyncDeflatedList = NULL;
+  gAsyncDeflatedCount = 0;
+  prepend_to_free_list(head, tail, count);
+  return count;
+}
+
+void ObjectSynchronizer::deflate_idle_monitors() {
+  DeflateMonitorCounters counters;
+  prepare_deflate_idle_monitors(&counters);
+  deflate_idle_monitors(&counters);
+  for (JavaThread* cur = Threads::first(); cur != NULL; cur = cur->next()) {
+    deflate_thread_local_monitors(cur, &counters);
+  }
+  finish_deflate_idle_monitors(&counters);
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
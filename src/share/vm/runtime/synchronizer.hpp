@@ -34,6 +34,12 @@
 
 class ObjectMonitor;
 
+struct DeflateMonitorCounters {
+  volatile int nInuse;          // currently associated with objects
+  volatile int nInCirculation;  // extant
+  volatile int nScavenged;      // reclaimed
+};
+
 class ObjectSynchronizer : AllStatic {
   friend class VMStructs;
  public:
@@ -126,11 +132,24 @@ class ObjectSynchronizer : AllStatic {
   // Basically we deflate all monitors that are not busy.
   // An adaptive profile-based deflation policy could be used if needed
   static void deflate_idle_monitors();
+  // The steps of deflate_idle_monitors(), for running the per-thread
+  // part on several threads during safepoint cleanup
+  static void prepare_deflate_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_idle_monitors(DeflateMonitorCounters* counters);
+  static void deflate_thread_local_monitors(Thread* thread, DeflateMonitorCounters* counters);
+  static void finish_deflate_idle_monitors(DeflateMonitorCounters* counters);
   static int walk_monitor_list(ObjectMonitor** listheadp,
                                ObjectMonitor** FreeHeadp,
                                ObjectMonitor** FreeTailp);
   static bool deflate_monitor(ObjectMonitor* mid, oop obj, ObjectMonitor** FreeHeadp,
                               ObjectMonitor** FreeTailp);
+
+  // Concurrent deflation by the service thread (AsyncDeflateIdleMonitors).
+  // Deflated monitors are recycled at the next safepoint, after which no
+  // mutator can still hold a reference to them.
+  static void add_to_async_in_use_list(ObjectMonitor* m);
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_using_JT();
   static void oops_do(OopClosure* f);
 
   // debugging
@@ -149,6 +168,25 @@ class ObjectSynchronizer : AllStatic {
   static ObjectMonitor * volatile gOmInUseList; // for moribund thread, so monitors they inflated still get scanned
   static int gOmInUseCount;
 
+  static void prepend_to_free_list(ObjectMonitor* FreeHead, ObjectMonitor* FreeTail, int nScavenged);
+
+  // Every inflated monitor with AsyncDeflateIdleMonitors. Inflating threads
+  // prepend with CAS; only the service thread unlinks.
+  static ObjectMonitor * volatile gAsyncInUseList;
+  static volatile int gAsyncInUseCount;
+  // Deflated by the service thread, waiting for a safepoint; under ListLock
+  static ObjectMonitor * gAsyncDeflatedList;
+  static int gAsyncDeflatedCount;
+  static jlong gLastAsyncDeflationMillis;
+
+  static bool deflate_monitor_using_JT(ObjectMonitor* mid, Thread* self);
+  static ObjectMonitor* unlink_from_async_in_use_list(ObjectMonitor* prev, ObjectMonitor* mid);
+  static int recycle_async_deflated_monitors();
+
+  // Lock stack based enter/exit with -XX:+UseLightweightLocking
+  static void lightweight_enter(Handle obj, TRAPS);
+  static void lightweight_exit(oop obj, TRAPS);
+
 };
 
 // ObjectLocker enforced balanced locking and can never thrown an
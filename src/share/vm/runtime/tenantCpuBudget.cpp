@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/coroutine.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "runtime/tenantCpuBudget.hpp"
+#include "runtime/thread.inline.hpp"
+
+TenantCpuBudget::Entry TenantCpuBudget::_table[TenantCpuBudget::table_size];
+
+TenantCpuBudget::Entry* TenantCpuBudget::find(jlong tenant_id, bool add) {
+  jlong key = tenant_id + 1;
+  uint start = (uint)(key ^ (key >> 32)) % table_size;
+  for (uint i = 0; i < table_size; i++) {
+    Entry* e = &_table[(start + i) % table_size];
+    jlong k = e->_key;
+    if (k == key) {
+      return e;
+    }
+    if (k == 0) {
+      if (!add) {
+        return NULL;
+      }
+      k = Atomic::cmpxchg(key, &e->_key, (jlong)0);
+      if (k == 0 || k == key) {
+        return e;
+      }
+    }
+  }
+  return NULL;  // too many tenants, they go unaccounted
+}
+
+void TenantCpuBudget::account_switch(Coroutine* from, Coroutine* to) {
+  jlong now = os::javaTimeNanos();
+  jlong resumed = from->switched_in_at();
+  to->set_switched_in_at(now);
+  if (resumed == 0) {
+    return;
+  }
+  oop tenant = from->thread()->tenantObj();
+  Entry* e = find(tenant == NULL ? 0 : com_alibaba_tenant_TenantContainer::get_tenant_id(tenant), true);
+  if (e == NULL) {
+    return;
+  }
+  jlong used = now - resumed;
+  Atomic::add(used, &e->_cpu_time);
+
+  // Start a new period; a racing switch may still add to the old one.
+  jlong period_start = e->_period_start;
+  if (now - period_start >= (jlong)TenantCpuBudgetPeriod * NANOSECS_PER_MILLISEC &&
+      Atomic::cmpxchg(now, &e->_period_start, period_start) == period_start) {
+    e->_period_used = 0;
+  }
+  Atomic::add(used, &e->_period_used);
+}
+
+jlong TenantCpuBudget::cpu_time(jlong tenant_id) {
+  Entry* e = find(tenant_id, false);
+  return e == NULL ? 0 : Atomic::load(&e->_cpu_time);
+}
+
+void TenantCpuBudget::set_limit(jlong tenant_id, jint percent) {
+  Entry* e = find(tenant_id, true);
+  if (e != NULL) {
+    e->_limit = MAX2(percent, 0);
+  }
+}
+
+bool TenantCpuBudget::is_over_budget(jlong tenant_id) {
+  Entry* e = find(tenant_id, false);
+  if (e == NULL || e->_limit == 0) {
+    return false;
+  }
+  jlong period = (jlong)TenantCpuBudgetPeriod * NANOSECS_PER_MILLISEC;
+  if (os::javaTimeNanos() - Atomic::load(&e->_period_start) >= period) {
+    return false;   // the next switch starts a new period
+  }
+  return Atomic::load(&e->_period_used) >= period / 100 * e->_limit;
+}
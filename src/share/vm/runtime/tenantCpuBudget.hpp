@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_TENANTCPUBUDGET_HPP
+#define SHARE_VM_RUNTIME_TENANTCPUBUDGET_HPP
+
+#include "memory/allocation.hpp"
+
+class Coroutine;
+
+// Per-tenant CPU budgets for Wisp (-XX:+TenantCpuBudgeting).
+//
+// With Wisp one carrier thread runs the coroutines of many tenants, which
+// the cgroup based TenantCpuThrottling and TenantCpuAccounting cannot tell
+// apart. Instead the switchTo stub charges the carrier time since the
+// previous switch to the tenant the carrier is attached to when the
+// coroutine switches away. A coroutine keeps its carrier until it
+// switches, so this is the CPU time it used, read from the monotonic clock
+// rather than the much slower thread CPU clock.
+//
+// A tenant can be limited to a percentage of one CPU. Its usage is
+// collected in periods of TenantCpuBudgetPeriod milliseconds; once it used
+// its share of the current period it is over budget until the period
+// ends, and the Wisp scheduler runs its tasks after those of the other
+// tenants. The counters are read and the limits set through TenantEnv.
+class TenantCpuBudget : AllStatic {
+ private:
+  enum { table_size = 256 };
+
+  struct Entry {
+    volatile jlong _key;           // tenant id + 1, 0 for a free slot
+    volatile jlong _cpu_time;      // nanoseconds in total
+    volatile jlong _period_start;
+    volatile jlong _period_used;   // nanoseconds in the current period
+    volatile jint  _limit;         // percent of one CPU, 0 for unlimited
+  };
+  static Entry _table[table_size];
+
+  static Entry* find(jlong tenant_id, bool add);
+
+ public:
+  // Called by the switchTo stub; a leaf, it must not block or safepoint.
+  static void account_switch(Coroutine* from, Coroutine* to);
+
+  static jlong cpu_time(jlong tenant_id);
+  static void  set_limit(jlong tenant_id, jint percent);
+  static bool  is_over_budget(jlong tenant_id);
+};
+
+#endif // SHARE_VM_RUNTIME_TENANTCPUBUDGET_HPP
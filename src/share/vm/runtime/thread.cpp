@@ -48,12 +48,15 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiThreadState.hpp"
 #include "prims/privilegedStack.hpp"
+#include "runtime/activeProcessorTracker.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/coroutine.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/fprofiler.hpp"
 #include "runtime/frame.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/java.hpp"
@@ -102,6 +105,7 @@
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
 #include "gc_implementation/g1/concurrentMarkThread.inline.hpp"
 #include "gc_implementation/parallelScavenge/pcTasks.hpp"
+#include "gc_implementation/shared/classLoaderDataPurgeThread.hpp"
 #include "gc_implementation/g1/elasticHeap.hpp"
 #endif // INCLUDE_ALL_GCS
 #ifdef COMPILER1
@@ -249,6 +253,7 @@ Thread::Thread() {
   // plain initialization
   debug_only(_owned_locks = NULL;)
   debug_only(_allow_allocation_count = 0;)
+  debug_only(_in_concurrent_dcmd = false;)
   NOT_PRODUCT(_allow_safepoint_count = 0;)
   NOT_PRODUCT(_skip_gcalot = false;)
   _jvmti_env_iteration_count = 0;
@@ -313,6 +318,9 @@ Thread::Thread() {
   if (UseG1GC) {
     _alloc_context = AllocationContext::system();
   }
+#if INCLUDE_ALL_GCS
+  clear_tenant_tlab_cache();
+#endif
 }
 
 void Thread::initialize_thread_local_storage() {
@@ -1522,6 +1530,7 @@ void JavaThread::initialize() {
   _in_deopt_handler = 0;
   _doing_unsafe_access = false;
   _stack_guard_state = stack_guard_unused;
+  _profile_sample_counter = 1;
   (void)const_cast<oop&>(_exception_oop = oop(NULL));
   _exception_pc  = 0;
   _exception_handler_pc = 0;
@@ -1535,7 +1544,11 @@ void JavaThread::initialize() {
 
   _coroutine_list = NULL;
   _current_coroutine = NULL;
+  _coroutine_stack_cache = NULL;
+  _coroutine_stack_cache_size = 0;
   _wisp_preempted = false;
+  _defer_coroutine_roots = false;
+  _coroutine_roots_parity = 0;
 
   _thread_stat = NULL;
   _thread_stat = new ThreadStatistics();
@@ -1566,6 +1579,8 @@ void JavaThread::initialize() {
 
   // Setup safepoint state info for this thread
   ThreadSafepointState::create(this);
+  // Threads are only added outside of safepoints, start disarmed.
+  _poll_word = SafepointSynchronize::poll_disarmed_value();
 
   _java_call_counter = 0;
 
@@ -1676,6 +1691,9 @@ JavaThread::~JavaThread() {
      CoroutineStack::free_stack(coroutine_list()->stack(), this);
      delete coroutine_list();
   }
+  if (EnableCoroutine) {
+    CoroutineStack::flush_thread_cache(this);
+  }
 
   if (TraceThreadEvents) {
       tty->print_cr("terminate thread %p", this);
@@ -2049,6 +2067,7 @@ void Thread::make_all_tlabs_parsable(bool retire, bool delete_saved) {
 
   if (delete_saved) {
     assert(retire, "should only delete after retire!");
+    clear_tenant_tlab_cache();
     ThreadLocalAllocBuffer* tlab = this->tlab().next();
     while (tlab != NULL) {
       ThreadLocalAllocBuffer* next = tlab->next();
@@ -2110,12 +2129,43 @@ void Thread::clean_tlab_for(const G1TenantAllocationContext* context) {
       // remove the 'dead' TLAB from list
       ThreadLocalAllocBuffer* next_tlab = tlab->next();
       prev->set_next(next_tlab);
+      uncache_saved_tlab(tlab);
       delete tlab;
       return;
     }
   }
 }
 
+ThreadLocalAllocBuffer* Thread::find_saved_tlab(const G1TenantAllocationContext* context) {
+  uint index = tenant_tlab_cache_index(context);
+  ThreadLocalAllocBuffer* tlab = _tenant_tlab_cache[index];
+  if (tlab != NULL && tlab->tenant_allocation_context() == context) {
+    return tlab;
+  }
+  // A miss, or the slot is taken by another context; walk the list.
+  for (tlab = this->tlab().next(); tlab != NULL; tlab = tlab->next()) {
+    if (tlab->tenant_allocation_context() == context) {
+      _tenant_tlab_cache[index] = tlab;
+      return tlab;
+    }
+  }
+  return NULL;
+}
+
+void Thread::uncache_saved_tlab(ThreadLocalAllocBuffer* tlab) {
+  for (uint i = 0; i < tenant_tlab_cache_size; i++) {
+    if (_tenant_tlab_cache[i] == tlab) {
+      _tenant_tlab_cache[i] = NULL;
+    }
+  }
+}
+
+void Thread::clear_tenant_tlab_cache() {
+  for (uint i = 0; i < tenant_tlab_cache_size; i++) {
+    _tenant_tlab_cache[i] = NULL;
+  }
+}
+
 const AllocationContext_t& Thread::allocation_context() const {
   assert(UseG1GC, "Only G1 policy supported");
   return _alloc_context;
@@ -2146,26 +2196,25 @@ void Thread::set_allocation_context(AllocationContext_t context) {
         return;
       }
 
-      // traverse saved TLAB list to search used TALBs for 'tac'
-      do {
-        tlab = tlab->next();
-        if (tlab != NULL && tlab->tenant_allocation_context() == tac) {
-          this->tlab().swap_content(tlab);
-          break;
-        }
-      } while (tlab != NULL);
+      // look up the saved TLAB of 'tac', the cache makes this O(1) for
+      // threads switching among a few tenants
+      tlab = find_saved_tlab(tac);
 
       // cannot find a saved TLAB, this is the first time current thread running into 'tac'
       if (tlab == NULL) {
-        ThreadLocalAllocBuffer* new_tlab = new ThreadLocalAllocBuffer();
-        new_tlab->initialize();
+        tlab = new ThreadLocalAllocBuffer();
+        tlab->initialize();
         // link to list
-        new_tlab->set_next(this->tlab().next());
-        new_tlab->set_tenant_allocation_context(tac);
-        this->tlab().set_next(new_tlab);
-        // make the new TLAB active
-        this->tlab().swap_content(new_tlab);
+        tlab->set_next(this->tlab().next());
+        tlab->set_tenant_allocation_context(tac);
+        this->tlab().set_next(tlab);
       }
+
+      // make the saved TLAB active without retiring the current one; the
+      // fast paths keep using the embedded TLAB, 'tlab' now holds the
+      // previously active tenant's TLAB
+      this->tlab().swap_content(tlab);
+      cache_saved_tlab(tlab);
     } else {
       tlab().make_parsable(true /* retire */);
     }
@@ -2717,6 +2766,11 @@ void JavaThread::check_safepoint_and_suspend_for_native_trans(JavaThread *thread
     SafepointSynchronize::block(curJT);
   }
 
+  if (thread->has_handshake_pending()) {
+    // Another thread is operating on our stack; wait until it is done.
+    Handshake::block(thread);
+  }
+
   if (thread->is_deopt_suspend()) {
     thread->clear_deopt_suspend();
     RegisterMap map(thread, false);
@@ -3091,9 +3145,17 @@ void JavaThread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf)
 
   if (EnableCoroutine) {
     Coroutine* current = _coroutine_list;
+    uintx scanned = 0;
     do {
+      if (_defer_coroutine_roots) {
+        if (scanned == CoroutineRootsChunkSize) {
+          break;
+        }
+        current->set_oops_do_parity(_coroutine_roots_parity);
+      }
       current->oops_do(f, cld_f, cf);
       current = current->next();
+      scanned++;
     } while (current != _coroutine_list);
   }
 
@@ -3112,6 +3174,10 @@ void JavaThread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf)
     }
   }
 
+  if (UseLightweightLocking) {
+    _lock_stack.oops_do(f);
+  }
+
   // Traverse instance variables at the end since the GC may be moving things
   // around using this function
   f->do_oop((oop*) &_threadObj);
@@ -3594,6 +3660,11 @@ CompilerThread::CompilerThread(CompileQueue* queue, CompilerCounters* counters)
   _buffer_blob = NULL;
   _scanned_nmethod = NULL;
   _compiler = NULL;
+  _idle_time = os::javaTimeMillis();
+  _arena_bytes = 0;
+  _arena_base = 0;
+  _arena_peak = 0;
+  _arena_limit = 0;
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
@@ -3603,6 +3674,19 @@ CompilerThread::CompilerThread(CompileQueue* queue, CompilerCounters* counters)
 #endif
 }
 
+void CompilerThread::arena_size_changed(ssize_t delta) {
+  _arena_bytes += delta;
+  if (_arena_bytes > _arena_peak) {
+    _arena_peak = _arena_bytes;
+    if (_arena_limit > 0 && arena_peak() > _arena_limit && _env != NULL) {
+      // Only fail once; the compiler notices the failure at its next check
+      // and releases its arenas while unwinding.
+      _arena_limit = 0;
+      _env->record_method_not_compilable("hit memory limit", false);
+    }
+  }
+}
+
 void CompilerThread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   JavaThread::oops_do(f, cld_f, cf);
   if (_scanned_nmethod != NULL && cf != NULL) {
@@ -3729,6 +3813,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   jint adjust_after_os_result = Arguments::adjust_after_os();
   if (adjust_after_os_result != JNI_OK) return adjust_after_os_result;
 
+  // Before any JavaThread reads its poll word
+  SafepointSynchronize::initialize_thread_local_polls();
+
   // intialize TLS
   ThreadLocalStorage::init();
 
@@ -3784,9 +3871,16 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
 
   // Initialize Java-Level synchronization subsystem
   ObjectMonitor::Initialize() ;
+  if (EnableCoroutine) {
+    Coroutine::initialize_perf_counters();
+  }
 
   // Initialize global modules
-  jint status = init_globals();
+  jint status;
+  {
+    TraceTime timer("Initialize global modules", TraceStartupTime);
+    status = init_globals();
+  }
   if (status != JNI_OK) {
     delete main_thread;
     *canTryAgain = false; // don't let caller call JNI_CreateJavaVM again
@@ -3827,6 +3921,15 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     }
   }
 
+  // Writes to -Xloggc made before this point were synchronous.
+  AsyncGCLogWriter::initialize();
+
+#if INCLUDE_ALL_GCS
+  if (ClassLoaderDataPurgeThread::is_enabled()) {
+    ClassLoaderDataPurgeThread::create();
+  }
+#endif // INCLUDE_ALL_GCS
+
   assert (Universe::is_fully_initialized(), "not initialized");
   if (VerifyDuringStartup) {
     // Make sure we're starting with a clean slate.
@@ -3982,7 +4085,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // Note that we do not use CHECK_0 here since we are inside an EXCEPTION_MARK and
   // set_init_completed has just been called, causing exceptions not to be shortcut
   // anymore. We call vm_exit_during_initialization directly instead.
-  SystemDictionary::compute_java_system_loader(THREAD);
+  {
+    TraceTime timer("Compute system loader", TraceStartupTime);
+    SystemDictionary::compute_java_system_loader(THREAD);
+  }
   if (HAS_PENDING_EXCEPTION) {
     vm_exit_during_initialization(Handle(THREAD, PENDING_EXCEPTION));
   }
@@ -4069,7 +4175,10 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   if (Arguments::has_profile())       FlatProfiler::engage(main_thread, true);
   if (MemProfiling)                   MemProfiler::engage();
   StatSampler::engage();
+  ThreadPerfTable::engage();
+  ActiveProcessorTracker::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
+  MemTracker::engage_resident_sampler();
 
   BiasedLocking::init();
 
@@ -4524,6 +4633,11 @@ void Threads::add(JavaThread* p, bool force_daemon) {
 }
 
 void Threads::remove(JavaThread* p) {
+  // Look at the thread object before taking the lock, so that the
+  // Threads_lock hold time stays short when many threads exit.
+  oop threadObj = p->threadObj();
+  bool daemon = threadObj != NULL && java_lang_Thread::is_daemon(threadObj);
+
   // Extra scope needed for Thread_lock, so we can check
   // that we do not remove thread without safepoint code notice
   { MutexLocker ml(Threads_lock);
@@ -4544,11 +4658,8 @@ void Threads::remove(JavaThread* p) {
       _thread_list = p->next();
     }
     _number_of_threads--;
-    oop threadObj = p->threadObj();
-    bool daemon = true;
-    if (threadObj == NULL || !java_lang_Thread::is_daemon(threadObj)) {
+    if (!daemon) {
       _number_of_non_daemon_threads--;
-      daemon = false;
 
       // Only one thread left, do a notify on the Threads_lock so a thread waiting
       // on destroy_vm will wake up.
@@ -4593,7 +4704,8 @@ void Threads::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   VMThread::vm_thread()->oops_do(f, cld_f, cf);
 }
 
-void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
+void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf,
+                                        bool all_coroutines) {
   // Introduce a mechanism allowing parallel threads to claim threads as
   // root groups.  Overhead should be small enough to use all the time,
   // even in sequential code.
@@ -4608,9 +4720,16 @@ void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBl
          (SharedHeap::heap()->n_par_threads() ==
           SharedHeap::heap()->workers()->active_workers()), "Mismatch");
   int cp = SharedHeap::heap()->strong_roots_parity();
+  bool defer_coroutines = EnableCoroutine && !all_coroutines;
   ALL_JAVA_THREADS(p) {
     if (p->claim_oops_do(is_par, cp)) {
-      p->oops_do(f, cld_f, cf);
+      if (defer_coroutines) {
+        p->set_defer_coroutine_roots(true, cp);
+        p->oops_do(f, cld_f, cf);
+        p->set_defer_coroutine_roots(false, 0);
+      } else {
+        p->oops_do(f, cld_f, cf);
+      }
     }
   }
   VMThread* vmt = VMThread::vm_thread();
@@ -4619,6 +4738,20 @@ void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBl
   }
 }
 
+void Threads::possibly_parallel_coroutines_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
+  if (!EnableCoroutine) {
+    return;
+  }
+  SharedHeap* sh = SharedHeap::heap();
+  bool is_par = sh->n_par_threads() > 0;
+  int cp = sh->strong_roots_parity();
+  ALL_JAVA_THREADS(p) {
+    if (p->coroutine_list() != NULL) {
+      Coroutine::possibly_parallel_oops_do_chunks(p, f, cld_f, cf, is_par, cp);
+    }
+  }
+}
+
 #if INCLUDE_ALL_GCS
 // Used by ParallelScavenge
 void Threads::create_thread_roots_tasks(GCTaskQueue* q) {
@@ -4756,6 +4889,29 @@ JavaThread *Threads::owning_thread_from_monitor_owner(address owner, bool doLock
   return the_owner;
 }
 
+JavaThread* Threads::owning_thread_from_object(oop obj, bool doLock) {
+  assert(UseLightweightLocking, "only used with lock stacks");
+  assert(doLock ||
+         Threads_lock->owned_by_self() ||
+         SafepointSynchronize::is_at_safepoint(),
+         "must grab Threads_lock or be at safepoint");
+
+  MutexLockerEx ml(doLock ? Threads_lock : NULL);
+  ALL_JAVA_THREADS(p) {
+    if (p->lock_stack().contains(obj)) {
+      return p;
+    }
+  }
+  return NULL;
+}
+
+JavaThread* Threads::owning_thread_from_monitor(ObjectMonitor* monitor, bool doLock) {
+  if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+    return owning_thread_from_object((oop)monitor->object(), doLock);
+  }
+  return owning_thread_from_monitor_owner((address)monitor->owner(), doLock);
+}
+
 // Threads::print_on() is called at safepoint by VM_PrintThreads operation.
 void Threads::print_on(outputStream* st, bool print_stacks, bool internal_format, bool print_concurrent_locks) {
   char buf[32];
@@ -4776,6 +4932,7 @@ void Threads::print_on(outputStream* st, bool print_stacks, bool internal_format
   }
 #endif // INCLUDE_ALL_GCS
 
+  CoroutineStateCounts coroutine_counts;
   ALL_JAVA_THREADS(p) {
     ResourceMark rm;
     p->print_on(st);
@@ -4795,6 +4952,7 @@ void Threads::print_on(outputStream* st, bool print_stacks, bool internal_format
             c->print_stack_on(st);
             c = c->next();
           } while (c != p->coroutine_list());
+          coroutine_counts.add_thread(p);
         }
       }
     }
@@ -4806,6 +4964,11 @@ void Threads::print_on(outputStream* st, bool print_stacks, bool internal_format
 #endif // INCLUDE_ALL_GCS
   }
 
+  if (EnableCoroutine && print_stacks && !internal_format) {
+    coroutine_counts.print_on(st);
+    st->cr();
+  }
+
   VMThread::vm_thread()->print_on(st);
   st->cr();
   Universe::heap()->print_gc_threads_on(st);
@@ -33,6 +33,7 @@
 #include "runtime/frame.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/osThread.hpp"
@@ -203,6 +204,7 @@ class Thread: public ThreadShadow {
     _external_suspend       = 0x20000000U, // thread is asked to self suspend
     _ext_suspended          = 0x40000000U, // thread has self-suspended
     _deopt_suspend          = 0x10000000U, // thread needs to self suspend for deopt
+    _handshake_pending      = 0x08000000U, // thread must not leave blocked/native state
 
     _has_async_exception    = 0x00000001U, // there is a pending async exception
     _critical_native_unlock = 0x00000002U, // Must call back to unlock JNI critical lock
@@ -267,6 +269,7 @@ class Thread: public ThreadShadow {
   //
   NOT_PRODUCT(int _allow_safepoint_count;)      // If 0, thread allow a safepoint to happen
   debug_only (int _allow_allocation_count;)     // If 0, the thread is allowed to allocate oops.
+  debug_only (bool _in_concurrent_dcmd;)        // Running a DCmd that must not execute VM operations
 
   // Used by SkipGCALot class.
   NOT_PRODUCT(bool _skip_gcalot;)               // Should we elide gc-a-lot?
@@ -278,6 +281,26 @@ class Thread: public ThreadShadow {
   friend class GC_locker;
 
   ThreadLocalAllocBuffer _tlab;                 // Thread-local eden
+#if INCLUDE_ALL_GCS
+  // Direct-mapped cache over the saved per-tenant TLABs (UsePerTenantTLAB),
+  // indexed by a hash of the tenant allocation context. A hit avoids the
+  // walk of the saved TLAB list when the thread switches tenants.
+  enum { tenant_tlab_cache_size = 8 };
+  ThreadLocalAllocBuffer* _tenant_tlab_cache[tenant_tlab_cache_size];
+
+  static uint tenant_tlab_cache_index(const G1TenantAllocationContext* context) {
+    return (uint)(((uintptr_t)context >> LogBytesPerWord) & (tenant_tlab_cache_size - 1));
+  }
+  // Returns the saved TLAB of the given context, or NULL if there is none.
+  ThreadLocalAllocBuffer* find_saved_tlab(const G1TenantAllocationContext* context);
+  // Record that 'tlab' holds the saved TLAB of its context.
+  void cache_saved_tlab(ThreadLocalAllocBuffer* tlab) {
+    _tenant_tlab_cache[tenant_tlab_cache_index(tlab->tenant_allocation_context())] = tlab;
+  }
+  // Drop 'tlab' from the cache before it is deleted.
+  void uncache_saved_tlab(ThreadLocalAllocBuffer* tlab);
+  void clear_tenant_tlab_cache();
+#endif // INCLUDE_ALL_GCS
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
 
@@ -340,6 +363,7 @@ class Thread: public ThreadShadow {
   virtual bool is_Java_thread()     const            { return false; }
   virtual bool is_Wisp_thread()     const            { return false; }
   virtual bool is_Compiler_thread() const            { return false; }
+  virtual bool is_Code_cache_sweeper_thread() const  { return false; }
   virtual bool is_hidden_from_external_view() const  { return false; }
   virtual bool is_jvmti_agent_thread() const         { return false; }
   // True iff the thread can perform GC operations at a safepoint.
@@ -623,6 +647,8 @@ protected:
 
   // Deadlock detection
   bool allow_allocation()                        { return _allow_allocation_count == 0; }
+  bool in_concurrent_dcmd() const                { return _in_concurrent_dcmd;   }
+  void set_in_concurrent_dcmd(bool b)            { _in_concurrent_dcmd = b;      }
   ResourceMark* current_resource_mark()          { return _current_resource_mark; }
   void set_current_resource_mark(ResourceMark* rm) { _current_resource_mark = rm; }
 #endif
@@ -882,6 +908,7 @@ class JavaThread: public Thread {
   MemRegion     _deferred_card_mark;
 
   MonitorChunk* _monitor_chunks;                 // Contains the off stack monitors
+  LockStack     _lock_stack;                     // Objects fast-locked with UseLightweightLocking
                                                  // allocated during deoptimization
                                                  // and by JNI_MonitorEnter/Exit
 
@@ -900,6 +927,7 @@ class JavaThread: public Thread {
  private:
   ThreadSafepointState *_safepoint_state;        // Holds information about a thread during a safepoint
   address               _saved_exception_pc;     // Saved pc of instruction where last implicit exception happened
+  volatile address      _poll_word;              // Address read by safepoint polls (ThreadLocalSafepointPolls)
 
   // JavaThread termination support
   enum TerminatedTypes {
@@ -953,6 +981,9 @@ class JavaThread: public Thread {
   // We load it from here to simplify the stack overflow check in assembly.
   address          _stack_overflow_limit;
 
+  // Events left until sampled tier 3 code next updates the profile
+  jint             _profile_sample_counter;
+
   // Compiler exception handling (NOTE: The _exception_oop is *NOT* the same as _pending_exception. It is
   // used to temp. parsing values into and out of the runtime system during exception handling for compiled
   // code)
@@ -987,12 +1018,27 @@ class JavaThread: public Thread {
 
   intptr_t          _coroutine_temp;
 
+  // set while the coroutines past the first chunk are scanned separately,
+  // see Threads::possibly_parallel_coroutines_oops_do
+  bool              _defer_coroutine_roots;
+  int               _coroutine_roots_parity;
+
+  // free coroutine stacks kept for reuse by this thread
+  CoroutineStack*   _coroutine_stack_cache;
+  uintx             _coroutine_stack_cache_size;
+
  public:
   Coroutine*& coroutine_list()                   { return _coroutine_list; }
+  CoroutineStack*& coroutine_stack_cache()       { return _coroutine_stack_cache; }
+  uintx& coroutine_stack_cache_size()            { return _coroutine_stack_cache_size; }
   Coroutine* current_coroutine()                 { return _current_coroutine; }
   void set_current_coroutine(Coroutine *coro)    { _current_coroutine = coro; }
   bool wisp_preempted() const                    { return _wisp_preempted; }
   void set_wisp_preempted(bool b)                { _wisp_preempted = b; }
+  void set_defer_coroutine_roots(bool b, int parity) {
+    _defer_coroutine_roots = b;
+    _coroutine_roots_parity = parity;
+  }
 
   static ByteSize coroutine_temp_offset()        { return byte_offset_of(JavaThread, _coroutine_temp); }
 
@@ -1136,6 +1182,8 @@ class JavaThread: public Thread {
   ThreadSafepointState *safepoint_state() const  { return _safepoint_state; }
   void set_safepoint_state(ThreadSafepointState *state) { _safepoint_state = state; }
   bool is_at_poll_safepoint()                    { return _safepoint_state->is_at_poll_safepoint(); }
+  address poll_word() const                      { return _poll_word; }
+  void set_poll_word(address value)              { _poll_word = value; }
 
   // thread has called JavaThread::exit() or is terminated
   bool is_exiting()                              { return _terminated == _thread_exiting || is_terminated(); }
@@ -1218,7 +1266,14 @@ class JavaThread: public Thread {
   // Whenever a thread transitions from native to vm/java it must suspend
   // if external|deopt suspend is present.
   bool is_suspend_after_native() const {
-    return (_suspend_flags & (_external_suspend | _deopt_suspend) ) != 0;
+    return (_suspend_flags & (_external_suspend | _deopt_suspend | _handshake_pending) ) != 0;
+  }
+
+  // Set by another thread for the duration of a handshake (see handshake.hpp)
+  void set_handshake_pending()    { set_suspend_flag  (_handshake_pending); }
+  void clear_handshake_pending()  { clear_suspend_flag(_handshake_pending); }
+  bool has_handshake_pending() const {
+    return (_suspend_flags & _handshake_pending) != 0;
   }
 
   // external suspend request is completed
@@ -1442,6 +1497,7 @@ class JavaThread: public Thread {
   static ByteSize vm_result_for_wisp_offset()    { return byte_offset_of(JavaThread, _vm_result_for_wisp ); }
   static ByteSize thread_state_offset()          { return byte_offset_of(JavaThread, _thread_state        ); }
   static ByteSize saved_exception_pc_offset()    { return byte_offset_of(JavaThread, _saved_exception_pc  ); }
+  static ByteSize poll_word_offset()             { return byte_offset_of(JavaThread, _poll_word           ); }
   static ByteSize osthread_offset()              { return byte_offset_of(JavaThread, _osthread            ); }
   static ByteSize exception_oop_offset()         { return byte_offset_of(JavaThread, _exception_oop       ); }
   static ByteSize exception_pc_offset()          { return byte_offset_of(JavaThread, _exception_pc        ); }
@@ -1449,11 +1505,14 @@ class JavaThread: public Thread {
   static ByteSize stack_overflow_limit_offset()  { return byte_offset_of(JavaThread, _stack_overflow_limit); }
   static ByteSize is_method_handle_return_offset() { return byte_offset_of(JavaThread, _is_method_handle_return); }
   static ByteSize stack_guard_state_offset()     { return byte_offset_of(JavaThread, _stack_guard_state   ); }
+  static ByteSize profile_sample_counter_offset() { return byte_offset_of(JavaThread, _profile_sample_counter); }
   static ByteSize suspend_flags_offset()         { return byte_offset_of(JavaThread, _suspend_flags       ); }
   static ByteSize java_call_counter_offset()     { return byte_offset_of(JavaThread, _java_call_counter); }
   static ByteSize coroutine_list_offset()        { return byte_offset_of(JavaThread, _coroutine_list); }
 
   static ByteSize do_not_unlock_if_synchronized_offset() { return byte_offset_of(JavaThread, _do_not_unlock_if_synchronized); }
+  static ByteSize lock_stack_top_offset()        { return byte_offset_of(JavaThread, _lock_stack) + LockStack::top_offset(); }
+  static ByteSize lock_stack_base_offset()       { return byte_offset_of(JavaThread, _lock_stack) + LockStack::base_offset(); }
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
@@ -1509,6 +1568,7 @@ class JavaThread: public Thread {
 
  public:
   MonitorChunk* monitor_chunks() const           { return _monitor_chunks; }
+  LockStack& lock_stack()                        { return _lock_stack; }
   void add_monitor_chunk(MonitorChunk* chunk);
   void remove_monitor_chunk(MonitorChunk* chunk);
   bool in_deopt_handler() const                  { return _in_deopt_handler > 0; }
@@ -1921,6 +1981,13 @@ class CompilerThread : public JavaThread {
 
   nmethod*          _scanned_nmethod;  // nmethod being scanned by the sweeper
   AbstractCompiler* _compiler;
+  jlong             _idle_time;        // time stamp of the last finished compilation
+
+  // Accounting of the mtCompiler arenas used by this thread
+  ssize_t           _arena_bytes;      // current size of the compiler arenas
+  ssize_t           _arena_base;       // _arena_bytes when the current compilation started
+  ssize_t           _arena_peak;       // peak of _arena_bytes during the current compilation
+  size_t            _arena_limit;      // fail the current compilation beyond this (0: no limit)
 
  public:
 
@@ -1945,6 +2012,16 @@ class CompilerThread : public JavaThread {
   BufferBlob*   get_buffer_blob() const          { return _buffer_blob; }
   void          set_buffer_blob(BufferBlob* b)   { _buffer_blob = b; };
 
+  // Idle time tracking, used to decide when a dynamic compiler thread may exit
+  void          idle_time_reset()                { _idle_time = os::javaTimeMillis(); }
+  jlong         idle_time_millis() const         { return os::javaTimeMillis() - _idle_time; }
+
+  // Compiler arena accounting, fed by Arena::set_size_in_bytes()
+  void          arena_size_changed(ssize_t delta);
+  void          begin_arena_accounting()         { _arena_base = _arena_peak = _arena_bytes; _arena_limit = 0; }
+  void          set_arena_limit(size_t limit)    { _arena_limit = limit; }
+  size_t        arena_peak() const               { return (size_t)(_arena_peak - _arena_base); }
+
   // Get/set the thread's logging information
   CompileLog*   log()                            { return _log; }
   void          init_log(CompileLog* log) {
@@ -2025,7 +2102,12 @@ class Threads: AllStatic {
   // This version may only be called by sequential code.
   static void oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
   // This version may be called by sequential or parallel code.
-  static void possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
+  // If !all_coroutines, only the first CoroutineRootsChunkSize coroutines of
+  // each thread are visited; possibly_parallel_coroutines_oops_do must then be
+  // called in the same roots iteration to visit the remaining ones.
+  static void possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf,
+                                        bool all_coroutines = true);
+  static void possibly_parallel_coroutines_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
   // This creates a list of GCTasks, one per thread.
   static void create_thread_roots_tasks(GCTaskQueue* q);
   // This creates a list of GCTasks, one per thread, for marking objects.
@@ -2071,6 +2153,15 @@ class Threads: AllStatic {
   static JavaThread *owning_thread_from_monitor_owner(address owner,
     bool doLock);
 
+  // Get the Java thread that has obj fast-locked on its lock stack
+  // (-XX:+UseLightweightLocking). Same locking rules as above.
+  static JavaThread* owning_thread_from_object(oop obj, bool doLock);
+
+  // Get owning Java thread of a monitor, including one whose owner is
+  // still anonymous because it was inflated by a non-owning thread.
+  static JavaThread* owning_thread_from_monitor(ObjectMonitor* monitor,
+    bool doLock);
+
   // Number of threads on the active threads list
   static int number_of_threads()                 { return _number_of_threads; }
   // Number of non-daemon threads on the active threads list
@@ -600,6 +600,8 @@ void VMThread::loop() {
 void VMThread::execute(VM_Operation* op) {
   Thread* t = Thread::current();
 
+  assert(!t->in_concurrent_dcmd(), "concurrent diagnostic commands must not execute VM operations");
+
   if (!t->is_VM_thread()) {
     SkipGCALot sgcalot(t);    // avoid re-entrant attempts to gc-a-lot
     // JavaThread or WatcherThread
@@ -28,15 +28,20 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "gc_implementation/shared/isGCActiveMark.hpp"
+#include "gc_interface/collectedHeap.hpp"
 #include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
 #include "oops/symbol.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/deoptimization.hpp"
+#include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/threadService.hpp"
+#include "utilities/workgroup.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -102,6 +107,10 @@ void VM_Deoptimize::doit() {
   ResourceMark rm;
   DeoptimizationMarker dm;
 
+  // Everything marked so far is handled here, including class loads that
+  // deferred their deoptimization (BatchDependentDeoptimization)
+  Deoptimization::clear_pending_dependents();
+
   // Deoptimize all activations depending on marked nmethods
   Deoptimization::deoptimize_dependents();
 
@@ -301,6 +310,34 @@ void VM_ThreadDump::doit_epilogue() {
   }
 }
 
+// Walks the stacks of the snapshots taken by VM_ThreadDump in parallel. The
+// workers claim snapshots one at a time, since stack depths vary a lot.
+class ThreadDumpStackTask : public AbstractGangTask {
+ private:
+  GrowableArray<ThreadSnapshot*>* _snapshots;
+  int                             _max_depth;
+  bool                            _with_locked_monitors;
+  volatile jint                   _next;
+
+ public:
+  ThreadDumpStackTask(GrowableArray<ThreadSnapshot*>* snapshots, int max_depth,
+                      bool with_locked_monitors) :
+    AbstractGangTask("Thread Dump Stacks"), _snapshots(snapshots),
+    _max_depth(max_depth), _with_locked_monitors(with_locked_monitors), _next(0) { }
+
+  void work(uint worker_id) {
+    for (;;) {
+      jint i = Atomic::add(1, &_next) - 1;
+      if (i >= _snapshots->length()) {
+        break;
+      }
+      ResourceMark rm;
+      HandleMark hm;
+      _snapshots->at(i)->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+    }
+  }
+};
+
 void VM_ThreadDump::doit() {
   ResourceMark rm;
 
@@ -309,6 +346,17 @@ void VM_ThreadDump::doit() {
     concurrent_locks.dump_at_safepoint();
   }
 
+  // Large dumps leave the stack walks to the safepoint workers.
+  FlexibleWorkGang* gang = NULL;
+  GrowableArray<ThreadSnapshot*>* deferred = NULL;
+  int count = _num_threads == 0 ? Threads::number_of_threads() : _num_threads;
+  if (ParallelThreadDumpThreshold > 0 && (uintx)count >= ParallelThreadDumpThreshold) {
+    gang = Universe::heap()->safepoint_workers();
+    if (gang != NULL) {
+      deferred = new GrowableArray<ThreadSnapshot*>(count);
+    }
+  }
+
   if (_num_threads == 0) {
     // Snapshot all live threads
     for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
@@ -321,7 +369,7 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      ThreadSnapshot* ts = snapshot_thread(jt, tcl);
+      ThreadSnapshot* ts = snapshot_thread(jt, tcl, deferred);
       _result->add_thread_snapshot(ts);
     }
   } else {
@@ -350,15 +398,25 @@ void VM_ThreadDump::doit() {
       if (_with_locked_synchronizers) {
         tcl = concurrent_locks.thread_concurrent_locks(jt);
       }
-      ThreadSnapshot* ts = snapshot_thread(jt, tcl);
+      ThreadSnapshot* ts = snapshot_thread(jt, tcl, deferred);
       _result->add_thread_snapshot(ts);
     }
   }
+
+  if (deferred != NULL && deferred->is_nonempty()) {
+    ThreadDumpStackTask task(deferred, _max_depth, _with_locked_monitors);
+    gang->run_task(&task);
+  }
 }
 
-ThreadSnapshot* VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl) {
+ThreadSnapshot* VM_ThreadDump::snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl,
+                                               GrowableArray<ThreadSnapshot*>* deferred) {
   ThreadSnapshot* snapshot = new ThreadSnapshot(java_thread);
-  snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+  if (deferred != NULL) {
+    deferred->append(snapshot);
+  } else {
+    snapshot->dump_stack_at_safepoint(_max_depth, _with_locked_monitors);
+  }
   snapshot->set_concurrent_locks(tcl);
   return snapshot;
 }
@@ -69,6 +69,7 @@
   template(G1CollectFull)                         \
   template(G1CollectForAllocation)                \
   template(G1IncCollectionPause)                  \
+  template(G1UncommitHeap)                        \
   template(DestroyAllocationContext)              \
   template(EnableBiasedLocking)                   \
   template(RevokeBias)                            \
@@ -90,6 +91,7 @@
   template(GetCurrentLocation)                    \
   template(EnterInterpOnlyMode)                   \
   template(ChangeSingleStep)                      \
+  template(ChangeTracedMethodEvents)              \
   template(HeapWalkOperation)                     \
   template(HeapIterateOperation)                  \
   template(ReportJavaOutOfMemory)                 \
@@ -103,6 +105,7 @@
   template(JFROldObject)                          \
   template(MetaspaceTraverse)                     \
   template(MetaspaceDump)                         \
+  template(CoroutineStatistics)                   \
 
 class VM_Operation: public CHeapObj<mtInternal> {
  public:
@@ -362,7 +365,9 @@ class VM_ThreadDump : public VM_Operation {
   bool                           _with_locked_monitors;
   bool                           _with_locked_synchronizers;
 
-  ThreadSnapshot* snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl);
+  // With a non-NULL deferred list the stack walk is left to the caller.
+  ThreadSnapshot* snapshot_thread(JavaThread* java_thread, ThreadConcurrentLocks* tcl,
+                                  GrowableArray<ThreadSnapshot*>* deferred);
 
  public:
   VM_ThreadDump(ThreadDumpResult* result,
@@ -32,12 +32,14 @@
 #include "services/diagnosticFramework.hpp"
 #include "services/heapDumper.hpp"
 #include "services/management.hpp"
+#include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #include "oops/objArrayOop.hpp"
 #include "gc_implementation/g1/elasticHeap.hpp"
 #include "utilities/ticks.hpp"
 #include "memory/metaspace.hpp"
 #include "memory/metaspaceDumper.hpp"
+#include "memory/metaspaceShared.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -62,13 +64,18 @@ void DCmdRegistrant::register_dcmds(){
 #if INCLUDE_SERVICES // Heap dumping/inspection supported
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RetainedHistogramDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassStatsDCmd>(full_export, true, false));
 #endif // INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpBinaryDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RotateGCLogDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderStatsDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<JWarmupDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<MetaspaceDumpDCmd>(full_export, true, false));
+#if INCLUDE_CDS
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CDSDumpDCmd>(full_export, true, false));
+#endif
 
   // Enhanced JMX Agent Support
   // These commands won't be exported via the DiagnosticCommandMBean until an
@@ -117,6 +124,9 @@ void HelpDCmd::execute(DCmdSource source, TRAPS) {
                          factory->is_enabled() ? "" : " [disabled]");
       output()->print_cr("%s", factory->description());
       output()->print_cr("\nImpact: %s", factory->impact());
+      if (factory->is_concurrent()) {
+        output()->print_cr("\nConcurrent: runs without a safepoint");
+      }
       JavaPermission p = factory->permission();
       if(p._class != NULL) {
         if(p._action != NULL) {
@@ -413,6 +423,36 @@ int ClassHistogramDCmd::num_arguments() {
   }
 }
 
+RetainedHistogramDCmd::RetainedHistogramDCmd(outputStream* output, bool heap) :
+                                       DCmdWithParser(output, heap),
+  _timeout("-timeout", "Milliseconds the marking may pause the application "
+           "for; sizes are partial if it runs out of time",
+           "INT", false, "5000") {
+  _dcmdparser.add_dcmd_option(&_timeout);
+}
+
+void RetainedHistogramDCmd::execute(DCmdSource source, TRAPS) {
+  if (_timeout.value() <= 0) {
+    output()->print_cr("Timeout must be positive");
+    return;
+  }
+  // The marking only reaches live objects, so no collection is needed.
+  VM_GC_HeapInspection heapop(output(), false /* request_full_gc */);
+  heapop.set_retained_size(true, _timeout.value());
+  VMThread::execute(&heapop);
+}
+
+int RetainedHistogramDCmd::num_arguments() {
+  ResourceMark rm;
+  RetainedHistogramDCmd* dcmd = new RetainedHistogramDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 #define DEFAULT_COLUMNS "InstBytes,KlassBytes,CpAll,annotations,MethodCount,Bytecodes,MethodAll,ROAll,RWAll,Total"
 ClassStatsDCmd::ClassStatsDCmd(outputStream* output, bool heap) :
                                        DCmdWithParser(output, heap),
@@ -502,6 +542,40 @@ int ThreadDumpDCmd::num_arguments() {
   }
 }
 
+ThreadDumpBinaryDCmd::ThreadDumpBinaryDCmd(outputStream* output, bool heap) :
+                                           DCmdWithParser(output, heap),
+  _filename("filename", "Name of the dump file", "STRING", true),
+  _depth("-depth", "Maximum number of frames per thread, -1 for all",
+         "INT", false, "-1") {
+  _dcmdparser.add_dcmd_option(&_depth);
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void ThreadDumpBinaryDCmd::execute(DCmdSource source, TRAPS) {
+  jlong depth = _depth.value();
+  if (depth < -1 || depth > max_jint) {
+    output()->print_cr("Invalid depth " JLONG_FORMAT, depth);
+    return;
+  }
+  int threads = ThreadService::dump_binary(_filename.value(), (int)depth, CHECK);
+  if (threads < 0) {
+    output()->print_cr("Unable to write thread dump to %s", _filename.value());
+  } else {
+    output()->print_cr("Dumped %d threads to %s", threads, _filename.value());
+  }
+}
+
+int ThreadDumpBinaryDCmd::num_arguments() {
+  ResourceMark rm;
+  ThreadDumpBinaryDCmd* dcmd = new ThreadDumpBinaryDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
 // Enhanced JMX Agent support
 
 JMXStartRemoteDCmd::JMXStartRemoteDCmd(outputStream *output, bool heap_allocated) :
@@ -979,8 +1053,13 @@ void ElasticHeapDCmd::print_info() {
 
 MetaspaceDumpDCmd::MetaspaceDumpDCmd(outputStream *output, bool heap_allocated) :
   DCmdWithParser(output, heap_allocated),
-  _filename("filename", "Name of the dump file", "STRING", true, "./metaspace_%p.log") {
+  _filename("filename", "Name of the dump file", "STRING", true, "./metaspace_%p.log"),
+  _binary("-binary", "Write the compact binary format", "BOOLEAN", false, "false"),
+  _diff("-diff", "Write only what changed since the previous binary dump, implies -binary",
+        "BOOLEAN", false, "false") {
   _dcmdparser.add_dcmd_option(&_filename);
+  _dcmdparser.add_dcmd_option(&_binary);
+  _dcmdparser.add_dcmd_option(&_diff);
 }
 
 int MetaspaceDumpDCmd::num_arguments() {
@@ -1015,7 +1094,11 @@ void MetaspaceDumpDCmd::execute(DCmdSource source, TRAPS) {
 
   Ticks start_time = Ticks::now();
 
-  MetaspaceDumper::dump(real_path_buf, MetaspaceDumper::JCMD);
+  if (_binary.value() || _diff.value()) {
+    MetaspaceDumper::dump_binary(real_path_buf, MetaspaceDumper::JCMD, _diff.value());
+  } else {
+    MetaspaceDumper::dump(real_path_buf, MetaspaceDumper::JCMD);
+  }
 
   Ticks end_time = Ticks::now();
 
@@ -1027,3 +1110,28 @@ void MetaspaceDumpDCmd::execute(DCmdSource source, TRAPS) {
 
   os::free(real_path_buf, mtInternal);
 }
+
+CDSDumpDCmd::CDSDumpDCmd(outputStream *output, bool heap_allocated) :
+  DCmdWithParser(output, heap_allocated),
+  _filename("filename", "Name of the shared archive", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+int CDSDumpDCmd::num_arguments() {
+  ResourceMark rm;
+  CDSDumpDCmd* dcmd = new CDSDumpDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void CDSDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (!is_init_completed()) {
+    output()->print_cr("JDK is not fully initialized. Please try it later.");
+    return;
+  }
+  MetaspaceShared::dump_loaded_classes(_filename.value(), output());
+}
@@ -50,6 +50,7 @@ public:
            "'help all' will show help for all commands.";
   }
   static const char* impact() { return "Low"; }
+  static bool is_concurrent() { return true; }
   static int num_arguments();
   virtual void execute(DCmdSource source, TRAPS);
 };
@@ -62,6 +63,7 @@ public:
     return "Print JVM version information.";
   }
   static const char* impact() { return "Low"; }
+  static bool is_concurrent() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.util.PropertyPermission",
                         "java.vm.version", "read"};
@@ -79,6 +81,7 @@ public:
     return "Print the command line used to start this VM instance.";
   }
   static const char* impact() { return "Low"; }
+  static bool is_concurrent() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", NULL};
@@ -123,6 +126,7 @@ public:
   static const char* impact() {
     return "Low";
   }
+  static bool is_concurrent() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", NULL};
@@ -144,6 +148,7 @@ public:
   static const char* impact() {
     return "Low";
   }
+  static bool is_concurrent() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", NULL};
@@ -167,6 +172,7 @@ public:
   static const char* impact() {
     return "Low";
   }
+  static bool is_concurrent() { return true; }
   static int num_arguments();
   virtual void execute(DCmdSource source, TRAPS);
 };
@@ -209,6 +215,7 @@ public:
   static const char* impact() {
     return "Medium";
   }
+  static bool is_concurrent() { return true; }
   static int num_arguments() { return 0; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
@@ -292,6 +299,30 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class RetainedHistogramDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _timeout;
+public:
+  RetainedHistogramDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.class_histogram_retained";
+  }
+  static const char* description() {
+    return "Provide statistics about the reachable Java heap, with an "
+           "estimate of the memory retained by the instances of each class.";
+  }
+  static const char* impact() {
+    return "High: Depends on Java heap size and content, bounded by the timeout.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class ClassStatsDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
@@ -335,6 +366,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class ThreadDumpBinaryDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+  DCmdArgument<jlong> _depth;
+public:
+  ThreadDumpBinaryDCmd(outputStream* output, bool heap);
+  static const char* name() { return "Thread.dump_binary"; }
+  static const char* description() {
+    return "Write all threads with stacktraces to a file in a compact "
+           "binary format, see ThreadService::dump_binary().";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of threads.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 // Enhanced JMX Agent support
 
 class JMXStartRemoteDCmd : public DCmdWithParser {
@@ -484,6 +538,8 @@ public:
 class MetaspaceDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char *> _filename;
+  DCmdArgument<bool>   _binary;
+  DCmdArgument<bool>   _diff;
 
 public:
   MetaspaceDumpDCmd(outputStream* output, bool heap_allocated);
@@ -500,4 +556,24 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CDSDumpDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char *> _filename;
+
+public:
+  CDSDumpDCmd(outputStream* output, bool heap_allocated);
+  static const char* name() {
+    return "VM.cds_dump";
+  }
+  static const char* description() {
+    return "Dump a shared archive of the classes loaded so far. Classes of "
+           "user-defined loaders are included with -XX:ArchiveClassesAtExit.";
+  }
+  static const char* impact() {
+    return "Medium: Starts a VM that preloads and dumps the classes.";
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 #endif // SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_HPP
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "gc_implementation/g1/elasticHeap.hpp"
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
+#include "gc_implementation/g1/g1TenantAllocationContext.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "services/diagnosticCommand.hpp"
+
+void DCmdRegistrant::register_dcmds_ext() {
+  uint32_t full_export = DCmd_Source_Internal | DCmd_Source_AttachAPI
+                         | DCmd_Source_MBean;
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TenantElasticHeapDCmd>(full_export, true, false));
+}
+
+TenantElasticHeapDCmd::TenantElasticHeapDCmd(outputStream* output, bool heap) :
+                           DCmdWithParser(output, heap),
+    _tenant_id("tenant_id", "Id of the tenant to show or to adjust", "INT", false),
+    _heap_limit("heap_limit",
+                "Heap limit of the tenant to be adjusted to, shrinking below its usage "
+                "takes effect step by step after young GCs",
+                "MEMORY SIZE", false) {
+  _dcmdparser.add_dcmd_option(&_tenant_id);
+  _dcmdparser.add_dcmd_option(&_heap_limit);
+}
+
+int TenantElasticHeapDCmd::num_arguments() {
+  ResourceMark rm;
+  int num_args = 0;
+  TenantElasticHeapDCmd* dcmd = new TenantElasticHeapDCmd(NULL, false);
+
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    num_args = dcmd->_dcmdparser.num_arguments();
+  }
+
+  return num_args;
+}
+
+void TenantElasticHeapDCmd::execute(DCmdSource source, TRAPS) {
+  if (!G1ElasticHeap) {
+    output()->print_cr("Error: -XX:+G1ElasticHeap is not enabled!");
+    return;
+  }
+  if (!TenantHeapThrottling) {
+    output()->print_cr("Error: -XX:+TenantHeapThrottling is not enabled!");
+    return;
+  }
+
+  if (_heap_limit.is_set()) {
+    if (!_tenant_id.is_set()) {
+      output()->print_cr("Error: heap_limit needs tenant_id!");
+      return;
+    }
+    if (_heap_limit.value()._size == 0) {
+      output()->print_cr("Error: heap_limit should be positive.");
+      return;
+    }
+    ElasticHeap::ErrorType error = G1CollectedHeap::heap()->elastic_heap()->
+        configure_tenant_heap_limit(_tenant_id.value(), (size_t)_heap_limit.value()._size);
+    if (error != ElasticHeap::NoError) {
+      output()->print_cr("Error: command fails because %s", ElasticHeap::to_string(error));
+      return;
+    }
+  }
+  print_info();
+}
+
+class PrintTenantHeapLimitClosure : public G1TenantAllocationContextClosure {
+private:
+  outputStream* _st;
+  bool          _all;
+  jlong         _tenant_id;
+  bool          _found;
+public:
+  PrintTenantHeapLimitClosure(outputStream* st, bool all, jlong tenant_id) :
+    _st(st), _all(all), _tenant_id(tenant_id), _found(false) { }
+
+  virtual void do_tenant_allocation_context(G1TenantAllocationContext* tac) {
+    jlong id = com_alibaba_tenant_TenantContainer::get_tenant_id(tac->tenant_container());
+    if (!_all && id != _tenant_id) {
+      return;
+    }
+    _st->print_cr("[GC.tenant_elastic_heap: tenant " JLONG_FORMAT ", heap limit " SIZE_FORMAT
+                  " B, target " SIZE_FORMAT " B, occupied " SIZE_FORMAT " B]",
+                  id, tac->heap_size_limit(), tac->heap_size_target(), tac->occupied_bytes());
+    _found = true;
+  }
+
+  bool found() const { return _found; }
+};
+
+void TenantElasticHeapDCmd::print_info() {
+  PrintTenantHeapLimitClosure cl(output(), !_tenant_id.is_set(), _tenant_id.value());
+  {
+    MutexLocker ml(Heap_lock);
+    G1TenantAllocationContexts::iterate(&cl);
+  }
+  if (_tenant_id.is_set() && !cl.found()) {
+    output()->print_cr("Error: no tenant " JLONG_FORMAT, _tenant_id.value());
+  }
+}
@@ -25,6 +25,26 @@
 #ifndef SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_EXT_HPP
 #define SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_EXT_HPP
 
-#undef HAVE_EXTRA_DCMD
+#include "services/diagnosticArgument.hpp"
+#include "services/diagnosticFramework.hpp"
+
+#define HAVE_EXTRA_DCMD
+
+class TenantElasticHeapDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _tenant_id;
+  DCmdArgument<MemorySizeArgument> _heap_limit;
+  void print_info();
+public:
+  TenantElasticHeapDCmd(outputStream* output, bool heap_allocated);
+  static const char* name() {
+    return "GC.tenant_elastic_heap";
+  }
+  static const char* description() {
+    return "Elastic Heap Command for the heap limits of tenants";
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
 
 #endif // SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_HPP
@@ -376,6 +376,23 @@ GrowableArray<DCmdArgumentInfo*>* DCmdParser::argument_info_array() {
 DCmdFactory* DCmdFactory::_DCmdFactoryList = NULL;
 bool DCmdFactory::_has_pending_jmx_notification = false;
 
+#ifdef ASSERT
+// Flags the current thread while a concurrent diagnostic command runs so that
+// VMThread::execute() can catch a command that wrongly claims to be concurrent.
+class ConcurrentDCmdMark : public StackObj {
+  Thread* _thread;
+  bool    _concurrent;
+public:
+  ConcurrentDCmdMark(Thread* thread, bool concurrent) :
+    _thread(thread), _concurrent(concurrent && !thread->in_concurrent_dcmd()) {
+    if (_concurrent) _thread->set_in_concurrent_dcmd(true);
+  }
+  ~ConcurrentDCmdMark() {
+    if (_concurrent) _thread->set_in_concurrent_dcmd(false);
+  }
+};
+#endif
+
 void DCmd::parse_and_execute(DCmdSource source, outputStream* out,
                              const char* cmdline, char delim, TRAPS) {
 
@@ -400,6 +417,10 @@ void DCmd::parse_and_execute(DCmdSource source, outputStream* out,
       assert(command != NULL, "command error must be handled before this line");
       DCmdMark mark(command);
       command->parse(&line, delim, CHECK);
+#ifdef ASSERT
+      DCmdFactory* f = DCmdFactory::factory(source, line.cmd_addr(), line.cmd_len());
+      ConcurrentDCmdMark cmark(THREAD, f != NULL && f->is_concurrent());
+#endif
       command->execute(source, CHECK);
     }
     count++;
@@ -306,6 +306,13 @@ public:
     JavaPermission p = {NULL, NULL, NULL};
     return p;
   }
+  // The is_concurrent() method tells whether the diagnostic command only reads
+  // VM state that is safe to inspect while Java threads run. Such a command is
+  // executed directly on the requesting thread (the attach listener or the
+  // DiagnosticCommandMBean caller) and must never execute a VM operation, so it
+  // does not add a safepoint nor wait behind the ones already queued. This is
+  // checked in debug builds.
+  static bool is_concurrent() { return false; }
   static int num_arguments() { return 0; }
   outputStream* output() { return _output; }
   bool is_heap_allocated()  { return _is_heap_allocated; }
@@ -349,6 +356,7 @@ public:
   static const char* disabled_message() { return "Diagnostic command currently disabled"; }
   static const char* impact() { return "Low: No impact"; }
   static const JavaPermission permission() {JavaPermission p = {NULL, NULL, NULL}; return p; }
+  static bool is_concurrent() { return false; }
   static int num_arguments() { return 0; }
   virtual void parse(CmdLine *line, char delim, TRAPS);
   virtual void execute(DCmdSource source, TRAPS) { }
@@ -418,6 +426,7 @@ public:
   virtual const char* description() const = 0;
   virtual const char* impact() const = 0;
   virtual const JavaPermission permission() const = 0;
+  virtual bool is_concurrent() const = 0;
   virtual const char* disabled_message() const = 0;
   // Register a DCmdFactory to make a diagnostic command available.
   // Once registered, a diagnostic command must not be unregistered.
@@ -470,6 +479,9 @@ public:
   virtual const JavaPermission permission() const {
     return DCmdClass::permission();
   }
+  virtual bool is_concurrent() const {
+    return DCmdClass::is_concurrent();
+  }
   virtual const char* disabled_message() const {
      return DCmdClass::disabled_message();
   }
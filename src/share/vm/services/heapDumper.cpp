@@ -27,12 +27,16 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "gc_implementation/shared/vmGCOperations.hpp"
+#include "gc_interface/collectedHeap.hpp"
 #include "memory/gcLocker.inline.hpp"
 #include "memory/genCollectedHeap.hpp"
 #include "memory/universe.hpp"
 #include "oops/objArrayKlass.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/reflectionUtils.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -42,9 +46,14 @@
 #include "utilities/ostream.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/dumpUtil.hpp"
+#include "utilities/workgroup.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
+#ifdef LINUX
+#include <fcntl.h>
+#include <sys/wait.h>
+#endif // LINUX
 
 /*
  * HPROF binary format - description copied from:
@@ -621,6 +630,255 @@ void DumpWriter::write_classID(Klass* k) {
 
 
 
+// Entry points of the zip library for writing gzip members. A gzip file
+// may consist of several members, so the dump is compressed chunk by
+// chunk.
+
+typedef char* (*GZipInitParams_t)(size_t in_len, size_t* out_len, size_t* tmp_len, int level);
+typedef size_t (*GZipFully_t)(char* in, size_t in_len, char* out, size_t out_len,
+                              char* tmp, size_t tmp_len, int level, char* comment, char** pmsg);
+
+static GZipInitParams_t GZipInitParams = NULL;
+static GZipFully_t      GZipFully      = NULL;
+
+// Looks up the gzip entry points, returns false if the zip library
+// does not export them.
+static bool load_gzip_functions() {
+  if (GZipFully != NULL) {
+    return true;
+  }
+  os::native_java_library();
+  char path[JVM_MAXPATHLEN];
+  char ebuf[1024];
+  void* handle = NULL;
+  if (os::dll_build_name(path, sizeof(path), Arguments::get_dll_dir(), "zip")) {
+    handle = os::dll_load(path, ebuf, sizeof ebuf);
+  }
+  if (handle == NULL) {
+    return false;
+  }
+  GZipInitParams = CAST_TO_FN_PTR(GZipInitParams_t, os::dll_lookup(handle, "ZIP_GZip_InitParams"));
+  GZipFully_t fully = CAST_TO_FN_PTR(GZipFully_t, os::dll_lookup(handle, "ZIP_GZip_Fully"));
+  if (GZipInitParams == NULL) {
+    return false;
+  }
+  GZipFully = fully;
+  return GZipFully != NULL;
+}
+
+// When the heap is dumped by several threads, or compressed, the records
+// are first written to part files next to the dump file:
+//
+//   <path>.part    records written by the VM thread, if compressed
+//   <path>.p<n>    heap dump segments written by worker n
+//
+// DumpMerger concatenates the parts into the dump file, compressing them
+// on the way if requested, and ends the dump with the HPROF_HEAP_DUMP_END
+// record. Without compression the records of the VM thread are written
+// to the dump file directly and the segments are appended to it.
+
+class DumpMerger : public StackObj {
+ private:
+  enum {
+    chunk_size = 4*M
+  };
+
+  const char* _path;
+  uint   _num_segments;
+  int    _compression_level;    // 0 if not compressed
+  bool   _deferred;             // merge after the safepoint
+
+  int    _fd;
+  char*  _in;                   // chunk of uncompressed bytes
+  size_t _in_used;
+  char*  _out;                  // compressed chunk
+  size_t _out_size;
+  char*  _tmp;
+  size_t _tmp_size;
+
+  julong _bytes_written;
+  char*  _error;
+
+  void write_out(char* buf, size_t len);
+  void flush_chunk();
+  bool open_dump();
+  void append_file(const char* part);
+  void remove_parts();
+
+ public:
+  DumpMerger(const char* path, int compression_level, bool deferred);
+  ~DumpMerger();
+
+  static void part_path(char* buf, size_t buflen, const char* path) {
+    jio_snprintf(buf, buflen, "%s.part", path);
+  }
+  static void segment_path(char* buf, size_t buflen, const char* path, uint seg) {
+    jio_snprintf(buf, buflen, "%s.p%u", path, seg);
+  }
+
+  const char* path() const              { return _path; }
+  bool is_compressed() const            { return _compression_level > 0; }
+  bool is_deferred() const              { return _deferred; }
+  void set_num_segments(uint n)         { _num_segments = n; }
+
+  void merge();
+
+  julong bytes_written() const          { return _bytes_written; }
+  char* error() const                   { return _error; }
+
+  // records the first error of the dump, or of one of its parts
+  void set_error(const char* error) {
+    if (_error == NULL) {
+      _error = os::strdup(error);
+    }
+  }
+};
+
+DumpMerger::DumpMerger(const char* path, int compression_level, bool deferred) :
+  _path(path), _num_segments(0), _compression_level(compression_level),
+  _deferred(deferred), _fd(-1), _in(NULL), _in_used(0), _out(NULL), _out_size(0),
+  _tmp(NULL), _tmp_size(0), _bytes_written(0), _error(NULL) { }
+
+DumpMerger::~DumpMerger() {
+  if (_in != NULL)    os::free(_in);
+  if (_out != NULL)   os::free(_out);
+  if (_tmp != NULL)   os::free(_tmp);
+  if (_error != NULL) os::free(_error);
+}
+
+void DumpMerger::write_out(char* buf, size_t len) {
+  while (len > 0 && _fd >= 0) {
+    ssize_t n = ::write(_fd, buf, (uint)MIN2(len, (size_t)UINT_MAX));
+    if (n < 0) {
+      set_error(strerror(errno));
+      ::close(_fd);
+      _fd = -1;
+      return;
+    }
+    _bytes_written += n;
+    buf += n;
+    len -= n;
+  }
+}
+
+void DumpMerger::flush_chunk() {
+  if (_in_used == 0) {
+    return;
+  }
+  if (is_compressed()) {
+    char* msg = NULL;
+    size_t len = (*GZipFully)(_in, _in_used, _out, _out_size, _tmp, _tmp_size,
+                              _compression_level, NULL, &msg);
+    if (len == 0) {
+      set_error(msg != NULL ? msg : "gzip compression failed");
+    } else {
+      write_out(_out, len);
+    }
+  } else {
+    write_out(_in, _in_used);
+  }
+  _in_used = 0;
+}
+
+// copies the given part file into the dump
+void DumpMerger::append_file(const char* part) {
+  int fd = os::open(part, O_RDONLY, 0);
+  if (fd < 0) {
+    set_error(strerror(errno));
+    return;
+  }
+  while (_fd >= 0) {
+    ssize_t n = ::read(fd, _in + _in_used, chunk_size - _in_used);
+    if (n < 0) {
+      set_error(strerror(errno));
+      break;
+    }
+    if (n == 0) {
+      break;
+    }
+    _in_used += n;
+    if (_in_used == chunk_size) {
+      flush_chunk();
+    }
+  }
+  ::close(fd);
+}
+
+// allocates the buffers and opens the dump file for the merged output
+bool DumpMerger::open_dump() {
+  _in = (char*)os::malloc(chunk_size, mtInternal);
+  if (_in == NULL) {
+    set_error("not enough memory to merge the heap dump");
+    return false;
+  }
+  if (is_compressed()) {
+    char* msg = (*GZipInitParams)(chunk_size, &_out_size, &_tmp_size, _compression_level);
+    if (msg != NULL) {
+      set_error(msg);
+      return false;
+    }
+    _out = (char*)os::malloc(_out_size, mtInternal);
+    _tmp = _tmp_size > 0 ? (char*)os::malloc(_tmp_size, mtInternal) : NULL;
+    if (_out == NULL || (_tmp_size > 0 && _tmp == NULL)) {
+      set_error("not enough memory to compress the heap dump");
+      return false;
+    }
+    _fd = os::create_binary_file(_path, false);
+  } else {
+    _fd = os::open(_path, O_WRONLY | O_APPEND, 0);
+  }
+  if (_fd < 0) {
+    set_error(strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void DumpMerger::remove_parts() {
+  char part[JVM_MAXPATHLEN];
+  if (is_compressed()) {
+    part_path(part, sizeof(part), _path);
+    remove(part);
+  }
+  for (uint i = 0; i < _num_segments; i++) {
+    segment_path(part, sizeof(part), _path, i);
+    remove(part);
+  }
+}
+
+void DumpMerger::merge() {
+  char part[JVM_MAXPATHLEN];
+
+  if (open_dump()) {
+    if (is_compressed()) {
+      part_path(part, sizeof(part), _path);
+      append_file(part);
+    }
+    for (uint i = 0; i < _num_segments; i++) {
+      segment_path(part, sizeof(part), _path, i);
+      append_file(part);
+    }
+
+    // HPROF_HEAP_DUMP_END: tag, ticks and a record length of zero
+    char end[1 + 2 * sizeof(u4)];
+    memset(end, 0, sizeof(end));
+    end[0] = (char)HPROF_HEAP_DUMP_END;
+    if (chunk_size - _in_used < sizeof(end)) {
+      flush_chunk();
+    }
+    memcpy(_in + _in_used, end, sizeof(end));
+    _in_used += sizeof(end);
+    flush_chunk();
+
+    if (_fd >= 0) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+  remove_parts();
+}
+
+
 // Support class with a collection of functions used when dumping the heap
 
 class DumperSupport : AllStatic {
@@ -674,6 +932,13 @@ class DumperSupport : AllStatic {
   // fixes up the length of the current dump record
   static void write_current_dump_record_length(DumpWriter* writer);
 
+  // starts a new HPROF_HEAP_DUMP_SEGMENT record if the current one
+  // exceeds the segment size threshold
+  static void check_segment_length(DumpWriter* writer);
+
+  // writes the HPROF_HEAP_DUMP_END record
+  static void write_dump_end(DumpWriter* writer);
+
   // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
   static void end_of_dump(DumpWriter* writer);
 };
@@ -1451,12 +1716,36 @@ void HeapObjectDumper::do_object(oop o) {
   }
 }
 
+// Dumps the heap objects each worker of a parallel heap dump iterates
+// into a heap dump segment file of its own.
+
+class ParDumpTask : public AbstractGangTask {
+ private:
+  VM_HeapDumper* _dumper;
+  ParallelObjectIterator* _poi;
+  DumpMerger* _merger;
+  Mutex _mutex;
+
+ public:
+  ParDumpTask(VM_HeapDumper* dumper, ParallelObjectIterator* poi, DumpMerger* merger) :
+    AbstractGangTask("Parallel heap dump"),
+    _dumper(dumper),
+    _poi(poi),
+    _merger(merger),
+    _mutex(Mutex::leaf, "Parallel heap dump error lock", true) { }
+
+  virtual void work(uint worker_id);
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation {
  private:
   static VM_HeapDumper* _global_dumper;
   static DumpWriter*    _global_writer;
   DumpWriter*           _local_writer;
+  DumpMerger*           _merger;
+  int                   _status_fd;     // >= 0 if the heap is dumped by a forked child
+  int                   _child;         // pid of the forked child, -1 if fork failed
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
@@ -1504,13 +1793,29 @@ class VM_HeapDumper : public VM_GC_Operation {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records written by several workers
+  bool dump_heap_in_parallel();
+
+  // true in the forked child of a non-pausing heap dump
+  bool is_forked_child() const { return _status_fd >= 0 && _child == 0; }
+
+  // ends the forked child, reporting the first error through the
+  // status pipe
+  void exit_forked_child();
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome, HeapDumper* heap_dumper = NULL) :
+  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome,
+                HeapDumper* heap_dumper = NULL, DumpMerger* merger = NULL,
+                int status_fd = -1) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump) {
     _local_writer = writer;
+    _merger = merger;
+    _status_fd = status_fd;
+    _child = -1;
     _gc_before_heap_dump = gc_before_heap_dump;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
     _stack_traces = NULL;
@@ -1545,6 +1850,9 @@ class VM_HeapDumper : public VM_GC_Operation {
   void doit();
 
   HeapDumper* heap_dumper() { return _heap_dumper; }
+
+  // pid of the child that writes the dump, or -1
+  int child() const { return _child; }
 };
 
 VM_HeapDumper* VM_HeapDumper::_global_dumper = NULL;
@@ -1558,6 +1866,25 @@ bool VM_HeapDumper::skip_operation() const {
   return false;
 }
 
+void ParDumpTask::work(uint worker_id) {
+  ResourceMark rm;
+  char path[JVM_MAXPATHLEN];
+  DumpMerger::segment_path(path, sizeof(path), _merger->path(), worker_id);
+
+  DumpWriter writer(path);
+  if (writer.is_open()) {
+    DumperSupport::write_dump_header(&writer);
+    HeapObjectDumper obj_dumper(_dumper, &writer);
+    _poi->object_iterate(&obj_dumper, worker_id);
+    DumperSupport::write_current_dump_record_length(&writer);
+    writer.close();
+  }
+  if (writer.error() != NULL) {
+    MutexLockerEx ml(&_mutex, Mutex::_no_safepoint_check_flag);
+    _merger->set_error(writer.error());
+  }
+}
+
  // writes a HPROF_HEAP_DUMP_SEGMENT record
 void DumperSupport::write_dump_header(DumpWriter* writer) {
   if (writer->is_open()) {
@@ -1599,31 +1926,39 @@ void DumperSupport::write_current_dump_record_length(DumpWriter* writer) {
 
 // used on a sub-record boundary to check if we need to start a
 // new segment.
-void VM_HeapDumper::check_segment_length() {
-  if (writer()->is_open()) {
-    julong dump_len = writer()->current_record_length();
+void DumperSupport::check_segment_length(DumpWriter* writer) {
+  if (writer->is_open()) {
+    julong dump_len = writer->current_record_length();
 
     if (dump_len > 2UL*G) {
-      DumperSupport::write_current_dump_record_length(writer());
-      DumperSupport::write_dump_header(writer());
+      write_current_dump_record_length(writer);
+      write_dump_header(writer);
     }
   }
 }
 
+void VM_HeapDumper::check_segment_length() {
+  DumperSupport::check_segment_length(writer());
+}
+
+void DumperSupport::write_dump_end(DumpWriter* writer) {
+  writer->write_u1(HPROF_HEAP_DUMP_END);
+  writer->write_u4(0);
+  writer->write_u4(0);
+}
+
 // fixes up the current dump record and writes HPROF_HEAP_DUMP_END record
 void DumperSupport::end_of_dump(DumpWriter* writer) {
   if (writer->is_open()) {
     write_current_dump_record_length(writer);
-
-    writer->write_u1(HPROF_HEAP_DUMP_END);
-    writer->write_u4(0);
-    writer->write_u4(0);
+    write_dump_end(writer);
   }
 }
 
-// marks sub-record boundary
+// marks sub-record boundary; each object dumper has a writer of its own
+// when the heap is dumped in parallel
 void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  DumperSupport::check_segment_length(writer());
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1815,6 +2150,22 @@ void VM_HeapDumper::doit() {
     }
   }
 
+#ifdef LINUX
+  if (_status_fd >= 0) {
+    // The child walks its copy-on-write snapshot of the heap while the
+    // parent ends the safepoint right away. Only the VM thread exists in
+    // the child, so it dumps the heap serially.
+    _child = ::fork();
+    if (_child > 0) {
+      return;
+    }
+    if (_child < 0) {
+      warning("Unable to fork the heap dump process: %s", strerror(errno));
+      _status_fd = -1;
+    }
+  }
+#endif // LINUX
+
   // At this point we should be the only dumper active, so
   // the following should be safe.
   set_global_dumper();
@@ -1856,8 +2207,10 @@ void VM_HeapDumper::doit() {
   // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  if (!dump_heap_in_parallel()) {
+    HeapObjectDumper obj_dumper(this, writer());
+    Universe::heap()->safe_object_iterate(&obj_dumper);
+  }
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1879,12 +2232,74 @@ void VM_HeapDumper::doit() {
   StickyClassDumper class_dumper(writer());
   SystemDictionary::always_strong_classes_do(&class_dumper);
 
-  // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
-  DumperSupport::end_of_dump(writer());
+  if (_merger != NULL) {
+    // fixes up the length of the dump record, the merger appends the
+    // segments of the workers and the HPROF_HEAP_DUMP_END record.
+    DumperSupport::write_current_dump_record_length(writer());
+    if (!_merger->is_deferred() || is_forked_child()) {
+      writer()->close();
+      _merger->merge();
+    }
+  } else {
+    // fixes up the length of the dump record and writes the HPROF_HEAP_DUMP_END record.
+    DumperSupport::end_of_dump(writer());
+  }
 
   // Now we clear the global variables, so that a future dumper might run.
   clear_global_dumper();
   clear_global_writer();
+
+  if (is_forked_child()) {
+    exit_forked_child();
+  }
+}
+
+void VM_HeapDumper::exit_forked_child() {
+#ifdef LINUX
+  _local_writer->close();
+  const char* error = _local_writer->error();
+  if (error == NULL && _merger != NULL) {
+    error = _merger->error();
+  }
+  if (error != NULL) {
+    os::write(_status_fd, error, strlen(error));
+  }
+  ::_exit(error == NULL ? 0 : 1);
+#endif // LINUX
+}
+
+// Returns false if the heap objects have to be dumped by the VM thread,
+// because the dump is not merged or the heap cannot be iterated in
+// parallel.
+bool VM_HeapDumper::dump_heap_in_parallel() {
+  if (_merger == NULL || HeapDumpParallelThreads <= 1 || is_forked_child()) {
+    return false;
+  }
+  FlexibleWorkGang* gang = Universe::heap()->safepoint_workers();
+  if (gang == NULL) {
+    return false;
+  }
+  // Without UseDynamicNumberOfGCThreads the gang always runs all workers.
+  uint num_workers = UseDynamicNumberOfGCThreads ?
+    MIN2((uint)HeapDumpParallelThreads, gang->total_workers()) : gang->total_workers();
+  ParallelObjectIterator* poi = Universe::heap()->parallel_object_iterator(num_workers);
+  if (poi == NULL) {
+    return false;
+  }
+
+  uint saved_active_workers = gang->active_workers();
+  if (UseDynamicNumberOfGCThreads) {
+    gang->set_active_workers(num_workers);
+  }
+  ParDumpTask task(this, poi, _merger);
+  gang->run_task(&task);
+  if (UseDynamicNumberOfGCThreads) {
+    gang->set_active_workers(saved_active_workers);
+  }
+  delete poi;
+
+  _merger->set_num_segments(num_workers);
+  return true;
 }
 
 void VM_HeapDumper::dump_stack_traces() {
@@ -1941,6 +2356,30 @@ void VM_HeapDumper::dump_stack_traces() {
   }
 }
 
+#ifdef LINUX
+// Collects the error reported by the child of a forked heap dump through
+// the status pipe, and reaps the child.
+static void wait_for_forked_dump(int child, int status_fd, char* error, size_t errlen) {
+  size_t len = 0;
+  ssize_t n;
+  while (len < errlen - 1 &&
+         (n = ::read(status_fd, error + len, errlen - 1 - len)) != 0) {
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    len += n;
+  }
+  error[len] = '\0';
+
+  int status = 0;
+  while (::waitpid(child, &status, 0) < 0 && errno == EINTR) ;
+  if (len == 0 && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+    jio_snprintf(error, errlen, "heap dump process %d failed", child);
+  }
+}
+#endif // LINUX
+
 // dump the heap to given path.
 PRAGMA_FORMAT_NONLITERAL_IGNORED_EXTERNAL
 int HeapDumper::dump(const char* path) {
@@ -1952,19 +2391,65 @@ int HeapDumper::dump(const char* path) {
     timer()->start();
   }
 
+  int compression_level = 0;
+  if (HeapDumpGzipLevel > 0) {
+    if (load_gzip_functions()) {
+      compression_level = (int)MIN2(HeapDumpGzipLevel, (uintx)9);
+    } else {
+      warning("HeapDumpGzipLevel is ignored: the zip library cannot write gzip files");
+    }
+  }
+
+  // The dump is written in parts and merged if it is written by several
+  // threads or compressed. A compressed dump is only created by the
+  // merger, so the records of the VM thread go to a part file.
+  bool merged = compression_level > 0 || HeapDumpParallelThreads > 1;
+  DumpMerger merger(path, compression_level, HeapDumpDeferredMerge);
+  char part[JVM_MAXPATHLEN];
+  const char* writer_path = path;
+  if (compression_level > 0) {
+    struct stat st;
+    if (os::stat(path, &st) == 0) {
+      set_error((char*)"File exists");
+      if (print_to_tty()) {
+        tty->print_cr("Unable to create %s: %s", path, error());
+      }
+      return -1;
+    }
+    DumpMerger::part_path(part, sizeof(part), path);
+    writer_path = part;
+  }
+
   // create the dump writer. If the file can be opened then bail
-  DumpWriter writer(path);
+  DumpWriter writer(writer_path);
   if (!writer.is_open()) {
     set_error(writer.error());
     if (print_to_tty()) {
-      tty->print_cr("Unable to create %s: %s", path,
+      tty->print_cr("Unable to create %s: %s", writer_path,
         (error() != NULL) ? error() : "reason unknown");
     }
     return -1;
   }
 
+  // With HeapDumpFork a child process writes the dump while this thread
+  // waits for it outside of the safepoint, so dumps requested by the VM
+  // thread itself are not forked.
+  int status_pipe[2] = { -1, -1 };
+#ifdef LINUX
+  if (HeapDumpFork && Thread::current()->is_Java_thread()) {
+    if (::pipe(status_pipe) == 0) {
+      // keep processes spawned meanwhile from holding the pipe open
+      ::fcntl(status_pipe[0], F_SETFD, FD_CLOEXEC);
+      ::fcntl(status_pipe[1], F_SETFD, FD_CLOEXEC);
+    } else {
+      status_pipe[0] = status_pipe[1] = -1;
+    }
+  }
+#endif // LINUX
+
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, this);
+  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, this,
+                       merged ? &merger : NULL, status_pipe[1]);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -1974,20 +2459,56 @@ int HeapDumper::dump(const char* path) {
 
   // close dump file and record any error that the writer may have encountered
   writer.close();
-  set_error(writer.error());
+  if (status_pipe[0] >= 0) {
+    ::close(status_pipe[1]);
+  }
+  if (dumper.child() > 0) {
+#ifdef LINUX
+    char child_error[1024];
+    JavaThread* thread = JavaThread::current();
+    if (thread->thread_state() == _thread_in_vm) {
+      ThreadBlockInVM tbivm(thread);
+      wait_for_forked_dump(dumper.child(), status_pipe[0], child_error, sizeof(child_error));
+    } else {
+      wait_for_forked_dump(dumper.child(), status_pipe[0], child_error, sizeof(child_error));
+    }
+    set_error(child_error[0] != '\0' ? child_error : NULL);
+#endif // LINUX
+  } else {
+    if (merged && merger.is_deferred()) {
+      // merge and compress the parts after the safepoint
+      merger.merge();
+    }
+    set_error(writer.error());
+    if (error() == NULL && merged) {
+      set_error(merger.error());
+    }
+  }
+  if (status_pipe[0] >= 0) {
+    ::close(status_pipe[0]);
+  }
 
   // print message in interactive case
   if (print_to_tty()) {
     timer()->stop();
     if (error() == NULL) {
+      julong bytes_written = writer.bytes_written();
+      struct stat st;
+      if (dumper.child() > 0) {
+        bytes_written = os::stat(path, &st) == 0 ? (julong)st.st_size : 0;
+      } else if (merged) {
+        // without compression the VM thread wrote to the dump file itself
+        bytes_written = merger.bytes_written() +
+                        (merger.is_compressed() ? 0 : writer.bytes_written());
+      }
       tty->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
-                    writer.bytes_written(), timer()->seconds());
+                    bytes_written, timer()->seconds());
     } else {
-      tty->print_cr("Dump file is incomplete: %s", writer.error());
+      tty->print_cr("Dump file is incomplete: %s", error());
     }
   }
 
-  return (writer.error() == NULL) ? 0 : -1;
+  return (error() == NULL) ? 0 : -1;
 }
 
 // stop timer (if still active), and free any error string we might be holding
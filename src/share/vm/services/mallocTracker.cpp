@@ -31,6 +31,7 @@
 #include "services/memTracker.hpp"
 
 size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
+volatile intptr_t MallocSiteSampler::_allocated = 0;
 
 // Total malloc'd memory amount
 size_t MallocMemorySnapshot::total() const {
@@ -72,8 +73,9 @@ void MallocHeader::release() const {
 
   MallocMemorySummary::record_free(size(), flags());
   MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
+  if (MemTracker::tracking_level() == NMT_detail && has_site()) {
+    MallocSiteTable::deallocation_at(MallocSiteSampler::site_size(size()),
+                                     _bucket_idx, _pos_idx);
   }
 }
 
@@ -91,7 +93,7 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
-  return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
+  return has_site() && MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
 bool MallocTracker::initialize(NMT_TrackingLevel level) {
@@ -133,7 +135,18 @@ void* MallocTracker::record_malloc(void* malloc_base, size_t size, MEMFLAGS flag
     return malloc_base;
   }
 
-  header = ::new (malloc_base)MallocHeader(size, flags, stack, level);
+  if (level == NMT_detail && MallocSiteSampler::enabled()) {
+    // Callers pass empty stacks in sampled mode; walk the stack here, and
+    // only for the sampled allocations. Skips this frame and os::malloc.
+    if (NMT_stack_walkable && MallocSiteSampler::should_sample(size)) {
+      NativeCallStack sampled_stack(2, true);
+      header = ::new (malloc_base)MallocHeader(size, flags, sampled_stack, level);
+    } else {
+      header = ::new (malloc_base)MallocHeader(size, flags, NativeCallStack::empty_stack(), level);
+    }
+  } else {
+    header = ::new (malloc_base)MallocHeader(size, flags, stack, level);
+  }
   memblock = (void*)((char*)malloc_base + sizeof(MallocHeader));
 
   // The alignment check: 8 bytes alignment for 32 bit systems.
@@ -232,6 +232,35 @@ class MallocMemorySummary : AllStatic {
 };
 
 
+/*
+ * Sampled detail tracking: with NMTDetailSampleBytes set, only the allocations
+ * that carry the running total of malloc'd bytes across a multiple of the
+ * interval have their call stacks walked and recorded. A sampled allocation
+ * stands for max(size, interval) bytes at its site, so the site totals stay
+ * estimates of the bytes allocated there while most allocations skip the walk.
+ */
+class MallocSiteSampler : AllStatic {
+ private:
+  static volatile intptr_t _allocated;
+
+ public:
+  static inline bool enabled() {
+    return NMTDetailSampleBytes > 0;
+  }
+
+  static inline bool should_sample(size_t size) {
+    size_t interval = NMTDetailSampleBytes;
+    size_t after = (size_t)Atomic::add_ptr((intptr_t)size, &_allocated);
+    return size >= interval || (after / interval) != ((after - size) / interval);
+  }
+
+  // Bytes recorded at the malloc site of an allocation of "size" bytes
+  static inline size_t site_size(size_t size) {
+    return enabled() ? MAX2(size, (size_t)NMTDetailSampleBytes) : size;
+  }
+};
+
+
 /*
  * Malloc tracking header.
  * To satisfy malloc alignment requirement, NMT uses 2 machine words for tracking purpose,
@@ -269,7 +298,12 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
+      _bucket_idx = MAX_MALLOCSITE_TABLE_SIZE;
+      _pos_idx = 0;
+      // In sampled mode, only the sampled allocations come with a stack.
+      if ((!MallocSiteSampler::enabled() || !stack.is_empty()) &&
+          record_malloc_site(stack, MallocSiteSampler::site_size(size),
+                             &bucket_idx, &pos_idx, flags)) {
         assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
@@ -283,6 +317,8 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
 
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
+  // Whether the allocation is recorded at a malloc site
+  inline bool has_site() const  { return _bucket_idx != MAX_MALLOCSITE_TABLE_SIZE; }
   bool get_stack(NativeCallStack& stack) const;
 
   // Cleanup tracking information before the memory is released.
@@ -23,6 +23,7 @@
  */
 #include "precompiled.hpp"
 
+#include "compiler/compileBroker.hpp"
 #include "memory/allocation.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memReporter.hpp"
@@ -144,6 +145,12 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     print_total(reserved_amount, committed_amount);
     out->print_cr(")");
 
+    if (NMTResidentSampleInterval > 0 && virtual_memory->committed() > 0) {
+      // report how much of the committed virtual memory was resident when last sampled
+      out->print_cr("%27s (mmap: resident=" SIZE_FORMAT "%s)", " ",
+        amount_in_current_scale(virtual_memory->resident()), scale);
+    }
+
     if (flag == mtClass) {
       // report class count
       out->print_cr("%27s (classes #" SIZE_FORMAT ")", " ", _class_count);
@@ -154,7 +161,16 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
        _vm_snapshot->by_type(mtThreadStack);
       out->print("%27s (stack: ", " ");
       print_total(thread_stack_usage->reserved(), thread_stack_usage->committed());
+      if (NMTResidentSampleInterval > 0) {
+        out->print(", resident=" SIZE_FORMAT "%s",
+          amount_in_current_scale(thread_stack_usage->resident()), scale);
+      }
       out->print_cr(")");
+    } else if (flag == mtCompiler && CompileBroker::get_peak_arena_usage() > 0) {
+      // report the largest arena footprint of a single compilation
+      out->print_cr("%27s (peak compilation arena=" SIZE_FORMAT "%s, compile #%d)", " ",
+        amount_in_current_scale(CompileBroker::get_peak_arena_usage()), scale,
+        CompileBroker::get_peak_arena_usage_id());
     }
 
      // report malloc'd memory
@@ -186,6 +202,10 @@ void MemDetailReporter::report_detail() {
   // Start detail report
   outputStream* out = output();
   out->print_cr("Details:\n");
+  if (MallocSiteSampler::enabled()) {
+    out->print_cr("Malloc sites sampled every " UINTX_FORMAT " bytes: sizes are estimates,"
+                  " counts are sampled allocations\n", NMTDetailSampleBytes);
+  }
 
   report_malloc_sites();
   report_virtual_memory_allocation_sites();
@@ -266,6 +286,10 @@ void MemDetailReporter::report_virtual_memory_region(const ReservedMemoryRegion*
   out->print_cr(" ");
   print_virtual_memory_region(region_type, reserved_rgn->base(), reserved_rgn->size());
   out->print(" for %s", NMTUtil::flag_to_name(reserved_rgn->flag()));
+  if (NMTResidentSampleInterval > 0) {
+    out->print(" (resident " SIZE_FORMAT "%s)",
+      amount_in_current_scale(reserved_rgn->resident()), scale);
+  }
   if (stack->is_empty()) {
     out->print_cr(" ");
   } else {
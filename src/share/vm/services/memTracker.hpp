@@ -70,6 +70,7 @@ class MemTracker : AllStatic {
   static inline void release_thread_stack(void* addr, size_t size) { }
 
   static void final_report(outputStream*) { }
+  static void engage_resident_sampler() { }
   static void error_report(outputStream*) { }
 };
 
@@ -82,9 +83,13 @@ class MemTracker : AllStatic {
 
 extern volatile bool NMT_stack_walkable;
 
-#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+// In sampled detail mode the malloc tracker walks the stacks of the sampled
+// allocations itself, so the callers do not walk them up front.
+#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     !MallocSiteSampler::enabled()) ?                                    \
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
-#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
+#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     !MallocSiteSampler::enabled()) ?                                    \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
@@ -266,6 +271,12 @@ class MemTracker : AllStatic {
     }
   }
 
+  // Start the periodic resident memory sampling of virtual memory regions,
+  // if NMTResidentSampleInterval asks for it.
+  static void engage_resident_sampler() {
+    VirtualMemoryTracker::engage_resident_sampler();
+  }
+
   // Query lock is used to synchronize the access to tracking data.
   // So far, it is only used by JCmd query, but it may be used by
   // other tools.
@@ -63,7 +63,8 @@ GrowableArray<MemoryManager*>* MemoryService::_managers_list =
 
 GCMemoryManager* MemoryService::_minor_gc_manager      = NULL;
 GCMemoryManager* MemoryService::_major_gc_manager      = NULL;
-MemoryPool*      MemoryService::_code_heap_pool        = NULL;
+GrowableArray<MemoryPool*>* MemoryService::_code_heap_pools =
+  new (ResourceObj::C_HEAP, mtInternal) GrowableArray<MemoryPool*>(init_code_heap_pools_size, true);
 MemoryPool*      MemoryService::_metaspace_pool        = NULL;
 MemoryPool*      MemoryService::_compressed_class_pool = NULL;
 
@@ -395,15 +396,20 @@ void MemoryService::add_g1OldGen_memory_pool(G1CollectedHeap* g1h,
 }
 #endif // INCLUDE_ALL_GCS
 
-void MemoryService::add_code_heap_memory_pool(CodeHeap* heap) {
-  _code_heap_pool = new CodeHeapPool(heap,
-                                     "Code Cache",
-                                     true /* support_usage_threshold */);
-  MemoryManager* mgr = MemoryManager::get_code_cache_memory_manager();
-  mgr->add_pool(_code_heap_pool);
+void MemoryService::add_code_heap_memory_pool(CodeHeap* heap, const char* name) {
+  MemoryPool* code_heap_pool = new CodeHeapPool(heap,
+                                                name,
+                                                true /* support_usage_threshold */);
+  // All code heaps share one memory manager.
+  static MemoryManager* mgr = NULL;
+  if (mgr == NULL) {
+    mgr = MemoryManager::get_code_cache_memory_manager();
+    _managers_list->append(mgr);
+  }
+  mgr->add_pool(code_heap_pool);
 
-  _pools_list->append(_code_heap_pool);
-  _managers_list->append(mgr);
+  _code_heap_pools->append(code_heap_pool);
+  _pools_list->append(code_heap_pool);
 }
 
 void MemoryService::add_metaspace_memory_pools() {
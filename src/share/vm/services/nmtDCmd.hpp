@@ -55,6 +55,7 @@ class NMTDCmd: public DCmdWithParser {
   static const char* impact() {
     return "Medium";
   }
+  static bool is_concurrent() { return true; }
   static const JavaPermission permission() {
     JavaPermission p = {"java.lang.management.ManagementPermission",
                         "monitor", NULL};
@@ -37,6 +37,8 @@ private:
   static PerfCounter* _thread_interrupt_signaled_count;// os:interrupt thr_kill
   static PerfCounter* _interrupted_before_count;  // _INTERRUPTIBLE OS_INTRPT
   static PerfCounter* _interrupted_during_count;  // _INTERRUPTIBLE OS_INTRPT
+  static PerfHistogram* _sync_time_histogram;    // Time to safepoint, PerfDataHistograms only
+  static PerfHistogram* _safepoint_time_histogram;
 
   static TimeStamp _safepoint_timer;
   static TimeStamp _app_timer;
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "memory/allocation.hpp"
 #include "memory/heapInspection.hpp"
@@ -30,13 +31,19 @@
 #include "oops/instanceKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/init.hpp"
+#include "runtime/interfaceSupport.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/task.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/threadService.hpp"
+#include "utilities/bytes.hpp"
+#include "utilities/resourceHash.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -238,6 +245,21 @@ void ThreadService::remove_thread_dump(ThreadDumpResult* dump) {
   assert(found, "The threaddump result to be removed must exist.");
 }
 
+// Takes the stack trace of a single thread while only that thread is stopped.
+class ThreadStackTraceClosure : public HandshakeClosure {
+ private:
+  ThreadDumpResult* _result;
+ public:
+  ThreadStackTraceClosure(ThreadDumpResult* result) :
+    HandshakeClosure("ThreadStackTrace"), _result(result) {}
+  void do_thread(Thread* thread) {
+    ResourceMark rm;
+    ThreadSnapshot* snapshot = new ThreadSnapshot();
+    snapshot->dump_stack_at_handshake((JavaThread*) thread);
+    _result->add_thread_snapshot(snapshot);
+  }
+};
+
 // Dump stack trace of threads specified in the given threads array.
 // Returns StackTraceElement[][] each element is the stack trace of a thread in
 // the corresponding entry in the given threads array
@@ -247,13 +269,23 @@ Handle ThreadService::dump_stack_traces(GrowableArray<instanceHandle>* threads,
   assert(num_threads > 0, "just checking");
 
   ThreadDumpResult dump_result;
-  VM_ThreadDump op(&dump_result,
-                   threads,
-                   num_threads,
-                   -1,    /* entire stack */
-                   false, /* with locked monitors */
-                   false  /* with locked synchronizers */);
-  VMThread::execute(&op);
+  bool done = false;
+  if (ThreadLocalHandshakes && num_threads == 1) {
+    JavaThread* jt = java_lang_Thread::thread(threads->at(0)());
+    if (jt != NULL && !jt->is_hidden_from_external_view()) {
+      ThreadStackTraceClosure cl(&dump_result);
+      done = Handshake::try_execute(&cl, jt);
+    }
+  }
+  if (!done) {
+    VM_ThreadDump op(&dump_result,
+                     threads,
+                     num_threads,
+                     -1,    /* entire stack */
+                     false, /* with locked monitors */
+                     false  /* with locked synchronizers */);
+    VMThread::execute(&op);
+  }
 
   // Allocate the resulting StackTraceElement[][] object
 
@@ -281,6 +313,108 @@ Handle ThreadService::dump_stack_traces(GrowableArray<instanceHandle>* threads,
   return result_obj;
 }
 
+// Big endian encoder for ThreadService::dump_binary(). The dump is built in
+// memory and only written out once it is complete, so that the file I/O is
+// done in native state and does not hold up safepoints.
+class BinaryThreadDumpWriter : public StackObj {
+ private:
+  bufferedStream _buffer;
+
+ public:
+  BinaryThreadDumpWriter() : _buffer(64 * K) { }
+
+  void write_raw(const void* p, size_t n) { _buffer.write((const char*)p, n); }
+  void write_u1(u1 v)        { write_raw(&v, 1); }
+  void write_u4(u4 v)        { u1 b[4]; Bytes::put_Java_u4((address)b, v); write_raw(b, 4); }
+  void write_u8(u8 v)        { u1 b[8]; Bytes::put_Java_u8((address)b, v); write_raw(b, 8); }
+  void write_utf8(const char* s) {
+    size_t len = s == NULL ? 0 : MIN2(strlen(s), (size_t)max_jushort);
+    u1 b[2];
+    Bytes::put_Java_u2((address)b, (u2)len);
+    write_raw(b, 2);
+    write_raw(s, len);
+  }
+  void write_symbol(Symbol* sym) { write_utf8(sym == NULL ? NULL : sym->as_C_string()); }
+
+  bool write_to(const char* path, JavaThread* thread) {
+    ThreadToNativeFromVM ttn(thread);
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+      return false;
+    }
+    bool ok = fwrite(_buffer.base(), 1, _buffer.size(), f) == _buffer.size();
+    return fclose(f) == 0 && ok;
+  }
+};
+
+typedef ResourceHashtable<Method*, u4, primitive_hash<Method*>, primitive_equals<Method*>, 4096> MethodIdTable;
+
+int ThreadService::dump_binary(const char* path, int max_depth, TRAPS) {
+  ResourceMark rm(THREAD);
+
+  ThreadDumpResult dump_result;
+  VM_ThreadDump op(&dump_result,
+                   max_depth,
+                   false, /* with locked monitors */
+                   false  /* with locked synchronizers */);
+  VMThread::execute(&op);
+
+  // The snapshots are registered with ThreadService, so their oops and
+  // methods stay valid across safepoints while the dump is encoded.
+  BinaryThreadDumpWriter writer;
+  MethodIdTable* ids = new MethodIdTable();
+  GrowableArray<Method*> methods(256);
+  for (ThreadSnapshot* ts = dump_result.snapshots(); ts != NULL; ts = ts->next()) {
+    ThreadStackTrace* stack = ts->get_stack_trace();
+    for (int i = 0; stack != NULL && i < stack->get_stack_depth(); i++) {
+      Method* m = stack->stack_frame_at(i)->method();
+      if (ids->get(m) == NULL) {
+        ids->put(m, (u4)methods.length());
+        methods.append(m);
+      }
+    }
+  }
+
+  static const char magic[] = "JAVA THREAD DUMP 1.0";
+  writer.write_raw(magic, sizeof(magic));
+  writer.write_u8((u8)os::javaTimeMillis());
+  writer.write_u4((u4)methods.length());
+  writer.write_u4((u4)dump_result.num_snapshots());
+
+  for (int i = 0; i < methods.length(); i++) {
+    Method* m = methods.at(i);
+    InstanceKlass* holder = m->method_holder();
+    writer.write_symbol(holder->name());
+    writer.write_symbol(m->name());
+    writer.write_symbol(m->signature());
+    writer.write_symbol(holder->source_file_name());
+  }
+
+  for (ThreadSnapshot* ts = dump_result.snapshots(); ts != NULL; ts = ts->next()) {
+    oop thread_obj = ts->threadObj();
+    oop name = java_lang_Thread::name(thread_obj);
+    ThreadStackTrace* stack = ts->get_stack_trace();
+    int depth = stack == NULL ? 0 : stack->get_stack_depth();
+
+    writer.write_u8((u8)java_lang_Thread::thread_id(thread_obj));
+    writer.write_utf8(name == NULL ? NULL : java_lang_String::as_utf8_string(name));
+    writer.write_u4((u4)ts->thread_status());
+    writer.write_u1(java_lang_Thread::is_daemon(thread_obj) ? 1 : 0);
+    writer.write_u4((u4)depth);
+    for (int i = 0; i < depth; i++) {
+      StackFrameInfo* frame = stack->stack_frame_at(i);
+      Method* m = frame->method();
+      writer.write_u4(*ids->get(m));
+      writer.write_u4((u4)frame->bci());
+      writer.write_u4((u4)(m->is_native() ? -2 : m->line_number_from_bci(frame->bci())));
+    }
+  }
+  if (!writer.write_to(path, (JavaThread*)THREAD)) {
+    return -1;
+  }
+  return dump_result.num_snapshots();
+}
+
 // Dump stack trace of Coroutine and return StackTraceElement[].
 Handle ThreadService::dump_coroutine_stack_trace(Coroutine *coro, TRAPS) {
 
@@ -364,8 +498,8 @@ DeadlockCycle* ThreadService::find_deadlocks_at_safepoint(bool concurrent_locks)
       if (waitingToLockMonitor != NULL) {
         address currentOwner = (address)waitingToLockMonitor->owner();
         if (currentOwner != NULL) {
-          currentThread = Threads::owning_thread_from_monitor_owner(
-                            currentOwner,
+          currentThread = Threads::owning_thread_from_monitor(
+                            waitingToLockMonitor,
                             false /* no locking needed */);
           if (currentThread == NULL) {
             // This function is called at a safepoint so the JavaThread
@@ -581,7 +715,9 @@ ThreadStackTrace::~ThreadStackTrace() {
 }
 
 void ThreadStackTrace::dump_stack_at_safepoint(int maxDepth) {
-  assert(SafepointSynchronize::is_at_safepoint(), "all threads are stopped");
+  assert(SafepointSynchronize::is_at_safepoint() ||
+         _thread == Thread::current() || _thread->has_handshake_pending(),
+         "all threads are stopped");
 
   if (_thread->has_last_Java_frame()) {
     RegisterMap reg_map(_thread);
@@ -900,6 +1036,14 @@ void ThreadSnapshot::dump_stack_at_safepoint(int max_depth, bool with_locked_mon
   _stack_trace->dump_stack_at_safepoint(max_depth);
 }
 
+void ThreadSnapshot::dump_stack_at_handshake(JavaThread* thread) {
+  assert(_thread == NULL, "must be a dummy snapshot");
+  _thread = thread;
+  _threadObj = thread->threadObj();
+  _stack_trace = new ThreadStackTrace(thread, false);
+  _stack_trace->dump_stack_at_safepoint(-1);
+}
+
 void ThreadSnapshot::dump_stack_at_safepoint_for_coroutine(Coroutine *target) {
   _stack_trace = new ThreadStackTrace(_thread, false);
   _stack_trace->dump_stack_at_safepoint_for_coroutine(target);
@@ -965,8 +1109,8 @@ void DeadlockCycle::print_on(outputStream* st) const {
         // No Java object associated - a JVMTI raw monitor
         owner_desc = " (JVMTI raw monitor),\n  which is held by";
       }
-      currentThread = Threads::owning_thread_from_monitor_owner(
-                        (address)waitingToLockMonitor->owner(),
+      currentThread = Threads::owning_thread_from_monitor(
+                        waitingToLockMonitor,
                         false /* no locking needed */);
       if (currentThread == NULL) {
         // The deadlock was detected at a safepoint so the JavaThread
@@ -1041,3 +1185,100 @@ ThreadsListEnumerator::ThreadsListEnumerator(Thread* cur_thread,
     _threads_array->append(h);
   }
 }
+
+PerfByteArrayVariable* ThreadPerfTable::_entries = NULL;
+PerfVariable*          ThreadPerfTable::_count = NULL;
+PerfVariable*          ThreadPerfTable::_dropped = NULL;
+PerfVariable*          ThreadPerfTable::_sequence = NULL;
+
+class ThreadPerfTableTask : public PeriodicTask {
+ public:
+  ThreadPerfTableTask(size_t interval_time) : PeriodicTask(interval_time) { }
+  void task() { ThreadPerfTable::refresh(); }
+};
+
+jint ThreadPerfTable::capacity() {
+  // Keeps the table within the jint length of a PerfData byte array.
+  return (jint)MIN2(PerfThreadTableSize, (uintx)64 * K);
+}
+
+size_t ThreadPerfTable::reserved_bytes() {
+  if (!UsePerfData || PerfThreadTableSize == 0) {
+    return 0;
+  }
+  // The entries, plus the PerfData headers and names of the table items
+  return capacity() * sizeof(Entry) + K;
+}
+
+void ThreadPerfTable::engage() {
+  if (!UsePerfData || PerfThreadTableSize == 0) {
+    return;
+  }
+
+  EXCEPTION_MARK;
+
+  PerfDataManager::create_constant(SUN_THREADS, "table.capacity",
+                                   PerfData::U_None, capacity(), CHECK);
+  PerfDataManager::create_constant(SUN_THREADS, "table.entryBytes",
+                                   PerfData::U_Bytes, sizeof(Entry), CHECK);
+  _count = PerfDataManager::create_variable(SUN_THREADS, "table.count",
+                                            PerfData::U_None, CHECK);
+  _dropped = PerfDataManager::create_variable(SUN_THREADS, "table.dropped",
+                                              PerfData::U_None, CHECK);
+  _sequence = PerfDataManager::create_variable(SUN_THREADS, "table.sequence",
+                                               PerfData::U_Events, CHECK);
+  _entries = PerfDataManager::create_byte_array_variable(SUN_THREADS, "table.entries",
+                                                         capacity() * sizeof(Entry), CHECK);
+
+  size_t interval = align_size_up(MIN2(MAX2(PerfThreadTableInterval, (uintx)PeriodicTask::min_interval),
+                                       (uintx)PeriodicTask::max_interval),
+                                  (uintx)PeriodicTask::interval_gran);
+  ThreadPerfTableTask* task = new ThreadPerfTableTask(interval);
+  task->enroll();
+}
+
+// Runs on the watcher thread. Holding Threads_lock keeps safepoints, and
+// with them any moving collection, from starting, so the thread oops can
+// be read here.
+void ThreadPerfTable::refresh() {
+  if (!Threads_lock->try_lock()) {
+    // Try again at the next interval rather than hold up the watcher thread.
+    return;
+  }
+
+  jlong sequence = _sequence->get_value();
+  _sequence->set_value(sequence + 1);
+  OrderAccess::storestore();
+
+  jbyte* table = _entries->value();
+  jint limit = capacity();
+  jint count = 0;
+  jlong dropped = 0;
+  for (JavaThread* t = Threads::first(); t != NULL; t = t->next()) {
+    oop thread_obj = t->threadObj();
+    if (thread_obj == NULL ||
+        t->is_hidden_from_external_view() ||
+        t->is_jvmti_agent_thread()) {
+      continue;
+    }
+    if (count == limit) {
+      dropped++;
+      continue;
+    }
+    Entry e;
+    e._tid = java_lang_Thread::thread_id(thread_obj);
+    e._allocated_bytes = t->cooked_allocated_bytes();
+    e._cpu_time = os::is_thread_cpu_time_supported() ? os::thread_cpu_time(t) : -1;
+    e._thread_status = (jint)java_lang_Thread::get_thread_status(thread_obj);
+    e._reserved = 0;
+    // The byte array data need not be aligned for jlongs.
+    memcpy(table + count * sizeof(Entry), &e, sizeof(Entry));
+    count++;
+  }
+  Threads_lock->unlock();
+
+  _count->set_value(count);
+  _dropped->set_value(dropped);
+  OrderAccess::storestore();
+  _sequence->set_value(sequence + 2);
+}
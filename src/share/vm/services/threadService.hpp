@@ -107,6 +107,22 @@ public:
 
   static Handle dump_coroutine_stack_trace(Coroutine *coro, TRAPS);
 
+  // Writes a thread dump of all live threads to path in a compact binary
+  // format meant for automated collection. All values are big endian:
+  //
+  //   header   "JAVA THREAD DUMP 1.0\0", u8 time in ms since the epoch,
+  //            u4 method count, u4 thread count
+  //   method   utf8 class name, utf8 method name, utf8 signature,
+  //            utf8 source file (empty if unknown); the id of a method is
+  //            its index in this table
+  //   thread   u8 java.lang.Thread id, utf8 name, u4 thread status,
+  //            u1 daemon, u4 frame count, then per frame from the top:
+  //            u4 method id, s4 bci, s4 line number (negative if unknown)
+  //
+  // where utf8 is a u2 byte count followed by the bytes. Returns the number
+  // of threads written, or -1 if the file could not be written.
+  static int    dump_binary(const char* path, int max_depth, TRAPS);
+
   static void   reset_peak_thread_count();
   static void   reset_contention_count_stat(JavaThread* thread);
   static void   reset_contention_time_stat(JavaThread* thread);
@@ -244,6 +260,8 @@ public:
 
   void        dump_stack_at_safepoint(int max_depth, bool with_locked_monitors);
   void        dump_stack_at_safepoint_for_coroutine(Coroutine *target);
+  // Stack trace only, for a dummy snapshot filled in during a handshake
+  void        dump_stack_at_handshake(JavaThread* thread);
   void        set_concurrent_locks(ThreadConcurrentLocks* l) { _concurrent_locks = l; }
   void        oops_do(OopClosure* f);
   void        metadata_do(void f(Metadata*));
@@ -598,4 +616,43 @@ class JavaThreadSleepState : public JavaThreadStatusChanger {
   }
 };
 
+// A table of per-thread counters in the PerfData memory, so that monitoring
+// agents can read the allocated bytes, CPU time and state of all Java
+// threads from the hsperfdata file instead of calling into the VM once per
+// thread. A periodic task refreshes it every PerfThreadTableInterval ms,
+// taking Threads_lock once per refresh and skipping the refresh when the
+// lock is busy.
+//
+// sun.threads.table.entries holds PerfThreadTableSize entries of
+// sun.threads.table.entryBytes bytes each, in native byte order and laid
+// out as ThreadPerfTable::Entry. The first sun.threads.table.count entries
+// are valid. The writer sets sun.threads.table.sequence to an odd value
+// before an update and to the next even value after it; readers retry if
+// it is odd or has changed while they read.
+class ThreadPerfTable : AllStatic {
+ public:
+  struct Entry {
+    jlong _tid;               // java.lang.Thread.getId()
+    jlong _allocated_bytes;   // as ThreadMXBean.getThreadAllocatedBytes()
+    jlong _cpu_time;          // in ns, -1 if not supported
+    jint  _thread_status;     // java.lang.Thread.threadStatus
+    jint  _reserved;
+  };
+
+ private:
+  static PerfByteArrayVariable* _entries;
+  static PerfVariable*          _count;
+  static PerfVariable*          _dropped;
+  static PerfVariable*          _sequence;
+
+  static jint capacity();
+
+ public:
+  // PerfData memory needed by the table on top of PerfDataMemorySize
+  static size_t reserved_bytes();
+
+  static void engage();
+  static void refresh();
+};
+
 #endif // SHARE_VM_SERVICES_THREADSERVICE_HPP
@@ -23,8 +23,12 @@
  */
 #include "precompiled.hpp"
 
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
 #include "runtime/threadCritical.hpp"
+#include "services/memTracker.hpp"
 #include "services/virtualMemoryTracker.hpp"
+#include "utilities/growableArray.hpp"
 
 size_t VirtualMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(VirtualMemorySnapshot, size_t)];
 
@@ -474,4 +478,108 @@ bool VirtualMemoryTracker::transition(NMT_TrackingLevel from, NMT_TrackingLevel
   return true;
 }
 
+// A committed range to probe, with the base of the reserved region it
+// belongs to.
+class ResidentProbe VALUE_OBJ_CLASS_SPEC {
+ public:
+  address _reserved_base;
+  address _base;
+  size_t  _size;
+  size_t  _resident;
+
+  ResidentProbe() : _reserved_base(NULL), _base(NULL), _size(0), _resident(0) { }
+  ResidentProbe(address reserved_base, address base, size_t size) :
+    _reserved_base(reserved_base), _base(base), _size(size), _resident(0) { }
+};
+
+// The committed ranges are copied under ThreadCritical and probed outside
+// it, so that reserving and committing memory is not held up by the probe.
+// A range released in the meantime measures as not resident, and the
+// results are matched back to the regions by base address.
+void VirtualMemoryTracker::sample_resident_memory() {
+  GrowableArray<ResidentProbe> probes(256, true, mtNMT);
+  {
+    ThreadCritical tc;
+    if (_reserved_regions == NULL) {
+      return;
+    }
+    LinkedListNode<ReservedMemoryRegion>* head = _reserved_regions->head();
+    while (head != NULL) {
+      const ReservedMemoryRegion* rgn = head->peek();
+      if (rgn->all_committed()) {
+        probes.append(ResidentProbe(rgn->base(), rgn->base(), rgn->size()));
+      } else {
+        CommittedRegionIterator itr = rgn->iterate_committed_regions();
+        const CommittedMemoryRegion* committed_rgn;
+        while ((committed_rgn = itr.next()) != NULL) {
+          probes.append(ResidentProbe(rgn->base(), committed_rgn->base(),
+                                      committed_rgn->size()));
+        }
+      }
+      head = head->next();
+    }
+  }
+
+  for (int i = 0; i < probes.length(); i++) {
+    ResidentProbe* probe = probes.adr_at(i);
+    if (!os::resident_memory_in_range((char*)probe->_base, probe->_size,
+                                      &probe->_resident)) {
+      probe->_resident = 0;
+    }
+  }
+
+  size_t resident_by_type[mt_number_of_types] = { 0 };
+  {
+    ThreadCritical tc;
+    if (_reserved_regions == NULL) {
+      return;
+    }
+    // Both the regions and the probes are in base address order.
+    int i = 0;
+    LinkedListNode<ReservedMemoryRegion>* head = _reserved_regions->head();
+    while (head != NULL) {
+      ReservedMemoryRegion* rgn = head->data();
+      while (i < probes.length() && probes.at(i)._reserved_base < rgn->base()) {
+        i++;
+      }
+      size_t resident = 0;
+      while (i < probes.length() && probes.at(i)._reserved_base == rgn->base()) {
+        resident += probes.at(i)._resident;
+        i++;
+      }
+      rgn->set_resident(resident);
+      resident_by_type[NMTUtil::flag_to_index(rgn->flag())] += resident;
+      head = head->next();
+    }
+  }
+  for (int index = 0; index < mt_number_of_types; index++) {
+    VirtualMemorySummary::set_resident_memory(resident_by_type[index],
+                                              NMTUtil::index_to_flag(index));
+  }
+}
+
+class ResidentMemorySamplerTask : public PeriodicTask {
+ public:
+  ResidentMemorySamplerTask(size_t interval_time) : PeriodicTask(interval_time) { }
+  void task() {
+    if (MemTracker::tracking_level() >= NMT_summary) {
+      VirtualMemoryTracker::sample_resident_memory();
+    }
+  }
+};
 
+void VirtualMemoryTracker::engage_resident_sampler() {
+  if (NMTResidentSampleInterval == 0 || MemTracker::tracking_level() < NMT_summary) {
+    return;
+  }
+  size_t resident;
+  if (!os::resident_memory_in_range(NULL, 0, &resident)) {
+    warning("NMTResidentSampleInterval is not supported on this platform");
+    return;
+  }
+  size_t interval = align_size_up(MIN2(MAX2(NMTResidentSampleInterval, (uintx)PeriodicTask::min_interval),
+                                       (uintx)PeriodicTask::max_interval),
+                                  (uintx)PeriodicTask::interval_gran);
+  ResidentMemorySamplerTask* task = new ResidentMemorySamplerTask(interval);
+  task->enroll();
+}
@@ -42,9 +42,10 @@ class VirtualMemory VALUE_OBJ_CLASS_SPEC {
  private:
   size_t     _reserved;
   size_t     _committed;
+  size_t     _resident;   // as of the last resident memory sample
 
  public:
-  VirtualMemory() : _reserved(0), _committed(0) { }
+  VirtualMemory() : _reserved(0), _committed(0), _resident(0) { }
 
   inline void reserve_memory(size_t sz) { _reserved += sz; }
   inline void commit_memory (size_t sz) {
@@ -62,8 +63,11 @@ class VirtualMemory VALUE_OBJ_CLASS_SPEC {
     _committed -= sz;
   }
 
+  inline void set_resident(size_t sz) { _resident = sz; }
+
   inline size_t reserved()  const { return _reserved;  }
   inline size_t committed() const { return _committed; }
+  inline size_t resident()  const { return _resident;  }
 };
 
 // Virtual memory allocation site, keeps track where the virtual memory is reserved.
@@ -145,6 +149,10 @@ class VirtualMemorySummary : AllStatic {
     as_snapshot()->by_type(flag)->release_memory(size);
   }
 
+  static inline void set_resident_memory(size_t size, MEMFLAGS flag) {
+    as_snapshot()->by_type(flag)->set_resident(size);
+  }
+
   // Move virtual memory from one memory type to another.
   // Virtual memory can be reserved before it is associated with a memory type, and tagged
   // as 'unknown'. Once the memory is tagged, the virtual memory will be moved from 'unknown'
@@ -296,17 +304,18 @@ class ReservedMemoryRegion : public VirtualMemoryRegion {
   MEMFLAGS         _flag;
 
   bool             _all_committed;
+  size_t           _resident;   // as of the last resident memory sample
 
  public:
   ReservedMemoryRegion(address base, size_t size, const NativeCallStack& stack,
     MEMFLAGS flag = mtNone) :
     VirtualMemoryRegion(base, size), _stack(stack), _flag(flag),
-    _all_committed(false) { }
+    _all_committed(false), _resident(0) { }
 
 
   ReservedMemoryRegion(address base, size_t size) :
     VirtualMemoryRegion(base, size), _stack(NativeCallStack::empty_stack()), _flag(mtNone),
-    _all_committed(false) { }
+    _all_committed(false), _resident(0) { }
 
   // Copy constructor
   ReservedMemoryRegion(const ReservedMemoryRegion& rr) :
@@ -350,6 +359,9 @@ class ReservedMemoryRegion : public VirtualMemoryRegion {
   inline bool all_committed() const { return _all_committed; }
   void        set_all_committed(bool b);
 
+  inline size_t resident() const     { return _resident; }
+  inline void   set_resident(size_t sz) { _resident = sz; }
+
   CommittedRegionIterator iterate_committed_regions() const {
     return CommittedRegionIterator(_committed_regions.head());
   }
@@ -361,6 +373,7 @@ class ReservedMemoryRegion : public VirtualMemoryRegion {
     _stack =         *other.call_stack();
     _flag  =         other.flag();
     _all_committed = other.all_committed();
+    _resident      = other.resident();
     if (other.all_committed()) {
       set_all_committed(true);
     } else {
@@ -415,6 +428,13 @@ class VirtualMemoryTracker : AllStatic {
 
   static bool transition(NMT_TrackingLevel from, NMT_TrackingLevel to);
 
+  // Measure how much of the committed memory of each region is resident.
+  static void sample_resident_memory();
+
+  // Start sampling resident memory every NMTResidentSampleInterval ms
+  // on the watcher thread.
+  static void engage_resident_sampler();
+
  private:
   static SortedLinkedList<ReservedMemoryRegion, compare_reserved_region_base>* _reserved_regions;
 };
@@ -56,6 +56,7 @@ enum {
   JVM_ACC_IS_PREFIXED_NATIVE      = 0x00040000,     // JVMTI has prefixed this native method
   JVM_ACC_ON_STACK                = 0x00080000,     // RedefineClasses() was used on the stack
   JVM_ACC_IS_DELETED              = 0x00008000,     // RedefineClasses() has deleted this method
+  JVM_ACC_JVMTI_TRACED            = 0x00004000,     // JvmtiSelectiveMethodTrace posts entry/exit, same as JVM_ACC_ENUM
 
   // Klass* flags
   JVM_ACC_HAS_MIRANDA_METHODS     = 0x10000000,     // True if this class has miranda methods in it's vtable
@@ -135,6 +136,7 @@ class AccessFlags VALUE_OBJ_CLASS_SPEC {
   bool is_obsolete             () const { return (_flags & JVM_ACC_IS_OBSOLETE            ) != 0; }
   bool is_deleted              () const { return (_flags & JVM_ACC_IS_DELETED             ) != 0; }
   bool is_prefixed_native      () const { return (_flags & JVM_ACC_IS_PREFIXED_NATIVE     ) != 0; }
+  bool is_jvmti_traced         () const { return (_flags & JVM_ACC_JVMTI_TRACED           ) != 0; }
 
   // Klass* flags
   bool has_miranda_methods     () const { return (_flags & JVM_ACC_HAS_MIRANDA_METHODS    ) != 0; }
@@ -203,6 +205,7 @@ class AccessFlags VALUE_OBJ_CLASS_SPEC {
   void set_is_obsolete()               { atomic_set_bits(JVM_ACC_IS_OBSOLETE);             }
   void set_is_deleted()                { atomic_set_bits(JVM_ACC_IS_DELETED);              }
   void set_is_prefixed_native()        { atomic_set_bits(JVM_ACC_IS_PREFIXED_NATIVE);      }
+  void set_is_jvmti_traced()           { atomic_set_bits(JVM_ACC_JVMTI_TRACED);            }
 
   void clear_not_c1_compilable()       { atomic_clear_bits(JVM_ACC_NOT_C1_COMPILABLE);       }
   void clear_not_c2_compilable()       { atomic_clear_bits(JVM_ACC_NOT_C2_COMPILABLE);       }
@@ -110,7 +110,7 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::move_to(Rehashabl
   int saved_entry_count = this->number_of_entries();
 
   // Iterate through the table and create a new entry for the new table
-  for (int i = 0; i < new_table->table_size(); ++i) {
+  for (int i = 0; i < this->table_size(); ++i) {
     for (HashtableEntry<T, F>* p = this->bucket(i); p != NULL; ) {
       HashtableEntry<T, F>* next = p->next();
       T string = p->literal();
@@ -143,6 +143,29 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::move_to(Rehashabl
   BasicHashtable<F>::free_buckets();
 }
 
+template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::resize_to(RehashableHashtable<T, F>* new_table) {
+  int saved_entry_count = this->number_of_entries();
+
+  // The hash code is unchanged, only the index into the new table is.
+  for (int i = 0; i < this->table_size(); ++i) {
+    for (HashtableEntry<T, F>* p = this->bucket(i); p != NULL; ) {
+      HashtableEntry<T, F>* next = p->next();
+      int index = new_table->hash_to_index(p->hash());
+      bool keep_shared = p->is_shared();
+      this->unlink_entry(p);
+      new_table->add_entry(index, p);
+      if (keep_shared) {
+        p->set_shared();
+      }
+      p = next;
+    }
+  }
+  new_table->copy_freelist(this);
+  assert(new_table->number_of_entries() == saved_entry_count, "lost entry on resize?");
+
+  BasicHashtable<F>::free_buckets();
+}
+
 template <MEMFLAGS F> void BasicHashtable<F>::free_buckets() {
   if (NULL != _buckets) {
     // Don't delete the buckets in the shared space.  They aren't
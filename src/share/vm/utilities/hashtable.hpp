@@ -353,6 +353,8 @@ template <class T, MEMFLAGS F> class RehashableHashtable : public Hashtable<T, F
 
   // Function to move these elements into the new table.
   void move_to(RehashableHashtable<T, F>* new_table);
+  // Move the elements into a table of a different size, keeping their hash.
+  void resize_to(RehashableHashtable<T, F>* new_table);
   static bool use_alternate_hashcode();
   static juint seed();
 
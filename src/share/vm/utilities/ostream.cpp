@@ -27,6 +27,7 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncGCLogWriter.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/vmThread.hpp"
@@ -883,8 +884,11 @@ void gcLogFileStream::write(const char* s, size_t len) {
     // 1) ThreadLocalStorage::thread() hasn't been initialized
     // 2) _file_lock is not in use.
     // 3) current() is VMThread and its reentry flag is set
-    if (!thread || !_file_lock || (thread->is_VM_thread()
-                               && ((VMThread* )thread)->is_gclog_reentry())) {
+    bool reentry = thread != NULL && thread->is_VM_thread()
+                   && ((VMThread* )thread)->is_gclog_reentry();
+    if (!reentry && AsyncGCLogWriter::enqueue(s, len)) {
+      _bytes_written += len;
+    } else if (!thread || !_file_lock || reentry) {
       size_t count = fwrite(s, 1, len, _file);
       _bytes_written += count;
     }
@@ -897,6 +901,22 @@ void gcLogFileStream::write(const char* s, size_t len) {
   update_position(s, len);
 }
 
+void gcLogFileStream::flush() {
+  // The asynchronous writer flushes after every batch it writes.
+  if (!AsyncGCLogWriter::is_running()) {
+    fileStream::flush();
+  }
+}
+
+void gcLogFileStream::write_blocking(const char* s, size_t len) {
+  // nop if _file_lock is NULL.
+  MutexLockerEx ml(_file_lock, Mutex::_no_safepoint_check_flag);
+  if (_file != NULL) {
+    size_t count = fwrite(s, 1, len, _file);
+    fflush(_file);
+  }
+}
+
 // rotate_log must be called from VMThread at a safepoint. In case need change parameters
 // for gc log rotation from thread other than VMThread, a sub type of VM_Operation
 // should be created and be submitted to VMThread's operation queue. DO NOT call this
@@ -912,6 +932,9 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
           "Must be VMThread at safepoint");
  #endif
 
+  // Buffered text belongs to the file being rotated out.
+  AsyncGCLogWriter::flush();
+
   VMThread* vmthread = VMThread::vm_thread();
   {
     // nop if _file_lock is NULL.
@@ -262,8 +262,17 @@ class gcLogFileStream : public fileStream {
   gcLogFileStream(const char* file_name);
   ~gcLogFileStream();
   virtual void write(const char* c, size_t len);
+  virtual void flush();
   virtual void rotate_log(bool force, outputStream* out = NULL);
   void dump_loggc_header();
+  // Write to the file on the calling thread, bypassing AsyncGCLog.
+  void write_blocking(const char* c, size_t len);
+  // As write_blocking, for text formatted by the AsyncGCLog writer that
+  // was not counted towards GCLogFileSize when it was logged.
+  void write_formatted(const char* c, size_t len) {
+    write_blocking(c, len);
+    _bytes_written += len;
+  }
 
   /* If "force" sets true, force log file rotation from outside JVM */
   bool should_rotate(bool force) {
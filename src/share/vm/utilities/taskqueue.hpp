@@ -29,6 +29,7 @@
 #include "memory/allocation.inline.hpp"
 #include "memory/padded.hpp"
 #include "runtime/mutex.hpp"
+#include "runtime/os.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/stack.hpp"
@@ -321,10 +322,17 @@ private:
 
   int _seed; // Current random seed used for selecting a random queue during stealing.
 
-  DEFINE_PAD_MINUS_SIZE(2, DEFAULT_CACHE_LINE_SIZE, sizeof(uint) + sizeof(int));
+  // Locality group the owner last stole from (UseNUMATaskStealing).  Read
+  // by other threads choosing a queue to steal from.
+  volatile int _lgrp_id;
+
+  DEFINE_PAD_MINUS_SIZE(2, DEFAULT_CACHE_LINE_SIZE, sizeof(uint) + 2 * sizeof(int));
 public:
   int next_random_queue_id();
 
+  int lgrp_id() const                        { return _lgrp_id; }
+  void set_lgrp_id(int id)                   { if (_lgrp_id != id) _lgrp_id = id; }
+
   void set_last_stolen_queue_id(uint id)     { _last_stolen_queue_id = id; }
   uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
   bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != InvalidQueueId; }
@@ -332,7 +340,7 @@ public:
 };
 
 template<class E, MEMFLAGS F, unsigned int N>
-GenericTaskQueue<E, F, N>::GenericTaskQueue() : _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */) {
+GenericTaskQueue<E, F, N>::GenericTaskQueue() : _last_stolen_queue_id(InvalidQueueId), _seed(17 /* random number */), _lgrp_id(-1) {
   assert(sizeof(Age) == sizeof(size_t), "Depends on this.");
 }
 
@@ -565,7 +573,13 @@ public:
     }
   }
 
-  bool steal_best_of_2(uint queue_num, E& t);
+private:
+  // Pick a random queue other than queue_num and exclude.  If lgrp_id is
+  // not -1, prefer a queue whose owner runs in that locality group.
+  uint random_victim(uint queue_num, uint exclude, int lgrp_id);
+
+public:
+  bool steal_best_of_2(uint queue_num, E& t, int lgrp_id = -1);
 
   void register_queue(uint i, T* q);
 
@@ -592,6 +606,18 @@ GenericTaskQueueSet<T, F>::queue(uint i) {
 
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
+  if (UseNUMA && UseNUMATaskStealing && _n > 2) {
+    // Steal from threads on the same node first; their tasks refer to
+    // objects that are more likely in local memory and caches.
+    int lgrp_id = os::numa_get_group_id();
+    _queues[queue_num]->set_lgrp_id(lgrp_id);
+    for (uint i = 0; i < _n; i++) {
+      if (steal_best_of_2(queue_num, t, lgrp_id)) {
+        TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal(true));
+        return true;
+      }
+    }
+  }
   for (uint i = 0; i < 2 * _n; i++) {
     if (steal_best_of_2(queue_num, t)) {
       TASKQUEUE_STATS_ONLY(queue(queue_num)->stats.record_steal(true));
@@ -602,25 +628,37 @@ GenericTaskQueueSet<T, F>::steal(uint queue_num, E& t) {
   return false;
 }
 
+template<class T, MEMFLAGS F> uint
+GenericTaskQueueSet<T, F>::random_victim(uint queue_num, uint exclude, int lgrp_id) {
+  T* const local_queue = _queues[queue_num];
+  uint k = queue_num;
+  for (uint tries = 0; ; tries++) {
+    k = local_queue->next_random_queue_id() % _n;
+    if (k == queue_num || k == exclude) {
+      continue;
+    }
+    if (lgrp_id == -1 || _queues[k]->lgrp_id() == lgrp_id || tries >= _n) {
+      return k;
+    }
+  }
+}
+
 template<class T, MEMFLAGS F> bool
-GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
+GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t, int lgrp_id) {
   if (_n > 2) {
     T* const local_queue = _queues[queue_num];
     uint k1 = queue_num;
 
-    if (local_queue->is_last_stolen_queue_id_valid()) {
+    if (local_queue->is_last_stolen_queue_id_valid() &&
+        (lgrp_id == -1 ||
+         _queues[local_queue->last_stolen_queue_id()]->lgrp_id() == lgrp_id)) {
       k1 = local_queue->last_stolen_queue_id();
       assert(k1 != queue_num, "Should not be the same");
     } else {
-      while (k1 == queue_num) {
-        k1 = local_queue->next_random_queue_id() % _n;
-      }
+      k1 = random_victim(queue_num, queue_num, lgrp_id);
     }
 
-    uint k2 = queue_num;
-    while (k2 == queue_num || k2 == k1) {
-      k2 = local_queue->next_random_queue_id() % _n;
-    }
+    uint k2 = random_victim(queue_num, k1, lgrp_id);
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
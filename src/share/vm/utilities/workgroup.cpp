@@ -90,10 +90,24 @@ bool WorkGang::initialize_workers() {
   } else {
     worker_type = os::pgc_thread;
   }
+  // Parallel workers run while the mutators are stopped and are spread
+  // over the processors; concurrent workers share them with the mutators
+  // and stay unbound.
+  uint* processor_assignment = NULL;
+  if (BindGCTaskThreadsToCPUs && !are_ConcurrentGC_threads()) {
+    processor_assignment = NEW_C_HEAP_ARRAY(uint, total_workers(), mtInternal);
+    if (!os::distribute_processes(total_workers(), processor_assignment)) {
+      FREE_C_HEAP_ARRAY(uint, processor_assignment, mtInternal);
+      processor_assignment = NULL;
+    }
+  }
   for (uint worker = 0; worker < total_workers(); worker += 1) {
     GangWorker* new_worker = allocate_worker(worker);
     assert(new_worker != NULL, "Failed to allocate GangWorker");
     _gang_workers[worker] = new_worker;
+    if (new_worker != NULL && processor_assignment != NULL) {
+      new_worker->set_processor_id(processor_assignment[worker]);
+    }
     if (new_worker == NULL || !os::create_thread(new_worker, worker_type)) {
       vm_exit_out_of_memory(0, OOM_MALLOC_ERROR,
               "Cannot create worker GC thread. Out of system resources.");
@@ -103,6 +117,9 @@ bool WorkGang::initialize_workers() {
       os::start_thread(new_worker);
     }
   }
+  if (processor_assignment != NULL) {
+    FREE_C_HEAP_ARRAY(uint, processor_assignment, mtInternal);
+  }
   return true;
 }
 
@@ -233,6 +250,7 @@ void AbstractWorkGang::threads_do(ThreadClosure* tc) const {
 
 GangWorker::GangWorker(AbstractWorkGang* gang, uint id) {
   _gang = gang;
+  _processor_id = max_juint;
   set_id(id);
   set_name("Gang worker#%d (%s)", id, gang->name());
 }
@@ -251,6 +269,11 @@ void GangWorker::initialize() {
     tty->print_cr("Running gang worker for gang %s id %d",
                   gang()->name(), id());
   }
+  if (_processor_id != max_juint && !os::bind_to_processor(_processor_id)) {
+    DEBUG_ONLY(
+      warning("Couldn't bind gang worker %u to processor %u", id(), _processor_id);
+    )
+  }
   // The VM thread should not execute here because MutexLocker's are used
   // as (opposed to MutexLockerEx's).
   assert(!Thread::current()->is_VM_thread(), "VM thread should not be part"
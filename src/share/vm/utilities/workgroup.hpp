@@ -274,12 +274,15 @@ public:
   virtual void print() const { print_on(tty); }
 protected:
   AbstractWorkGang* _gang;
+  // Processor to bind to with BindGCTaskThreadsToCPUs, or max_juint.
+  uint _processor_id;
 
   virtual void initialize();
   virtual void loop();
 
 public:
   AbstractWorkGang* gang() const { return _gang; }
+  void set_processor_id(uint processor_id) { _processor_id = processor_id; }
 };
 
 // Dynamic number of worker threads
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Profiled C1 code compiled in fast mode during startup is correct
+ * @run main/othervm -XX:+TieredCompilation -XX:+C1FastCompileDuringStartup -XX:C1FastCompileStartupTime=1000000 -XX:TieredStopAtLevel=3 TestC1FastCompile
+ * @run main/othervm -XX:+TieredCompilation -XX:+C1FastCompileDuringStartup TestC1FastCompile
+ */
+
+public class TestC1FastCompile {
+    static int[] data = new int[256];
+
+    static long test(int[] a, long seed) {
+        long x = seed;
+        long y = seed ^ 0x5DEECE66DL;
+        long z = 0;
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (int)(x ^ y);
+            x = x * 31 + a[i];
+            y = (y >>> 3) | (x << 7);
+            if ((x & 1) == 0) {
+                z += a[i] - y;
+            } else {
+                z ^= a[(i * 7) & (a.length - 1)];
+            }
+        }
+        return x + y + z;
+    }
+
+    public static void main(String[] args) {
+        long expected = test(new int[256], 42);
+        for (int i = 0; i < 50000; i++) {
+            if (test(data, 42) != expected) {
+                throw new RuntimeException("wrong result at iteration " + i);
+            }
+        }
+    }
+}
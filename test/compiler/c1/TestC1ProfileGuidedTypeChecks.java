@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Interface checkcast/instanceof with an inline check of the profiled klass keeps its semantics
+ * @run main/othervm -XX:+TieredCompilation -XX:TieredStopAtLevel=1 -XX:+C1ProfileGuidedTypeChecks -Xbatch TestC1ProfileGuidedTypeChecks
+ * @run main/othervm -XX:+TieredCompilation -XX:+C1ProfileGuidedTypeChecks -XX:C1ProfileGuidedTypeCheckRatio=50 -Xbatch TestC1ProfileGuidedTypeChecks
+ */
+
+public class TestC1ProfileGuidedTypeChecks {
+    interface I1 { int get(); }
+    interface I2 { }
+    interface I3 { }
+    interface I4 extends I1 { }
+
+    static class A implements I2, I3, I4 { public int get() { return 1; } }
+    static class B implements I1 { public int get() { return 2; } }
+    static class C implements I2 { }
+
+    static int cast(Object o) {
+        return ((I1)o).get();
+    }
+
+    static boolean isI1(Object o) {
+        return o instanceof I1;
+    }
+
+    public static void main(String[] args) {
+        Object a = new A();
+        Object b = new B();
+        Object c = new C();
+        for (int i = 0; i < 100000; i++) {
+            if (cast(a) != 1 || !isI1(a)) {
+                throw new RuntimeException("A must be an I1");
+            }
+            if (i % 100 == 0) {
+                if (cast(b) != 2 || !isI1(b)) {
+                    throw new RuntimeException("B must be an I1");
+                }
+                if (isI1(c) || isI1(null)) {
+                    throw new RuntimeException("C and null are not I1");
+                }
+                try {
+                    cast(c);
+                    throw new RuntimeException("expected ClassCastException");
+                } catch (ClassCastException e) {
+                    // expected
+                }
+            }
+        }
+    }
+}
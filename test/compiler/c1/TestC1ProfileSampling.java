@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Tier 3 code with sampled profile updates runs correctly and still tiers up
+ * @run main/othervm -XX:+TieredCompilation -XX:C1ProfileSampleInterval=16 TestC1ProfileSampling
+ * @run main/othervm -XX:+TieredCompilation -XX:TieredStopAtLevel=3 -XX:C1ProfileSampleInterval=1024 TestC1ProfileSampling
+ */
+
+public class TestC1ProfileSampling {
+    static int test(int[] a, int k) {
+        int s = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] > k) {
+                s += a[i];
+            } else {
+                s -= k;
+            }
+        }
+        return s;
+    }
+
+    public static void main(String[] args) throws Exception {
+        final int[] a = new int[100];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i;
+        }
+        final int expected = test(a, 50);
+        Thread[] threads = new Thread[4];
+        final Throwable[] failure = new Throwable[1];
+        for (int t = 0; t < threads.length; t++) {
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int i = 0; i < 50000; i++) {
+                        if (test(a, 50) != expected) {
+                            failure[0] = new RuntimeException("wrong result");
+                            return;
+                        }
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        if (failure[0] != null) {
+            throw new RuntimeException(failure[0]);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary C2 compilations that exceed CompileMemoryLimit bail out cleanly
+ * @run main/othervm -XX:-BackgroundCompilation -XX:CompileMemoryLimit=1 TestCompileMemoryLimit
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:CompileMemoryLimit=64k TestCompileMemoryLimit
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+PrintCompilerArenaUsage -XX:ChunkPoolLimit=1m -XX:NativeMemoryTracking=summary -XX:+PrintNMTStatistics TestCompileMemoryLimit
+ */
+
+public class TestCompileMemoryLimit {
+    static int test(int[] a) {
+        int s = 0;
+        for (int i = 0; i < a.length; i++) {
+            s += (a[i] * 31) ^ (s >>> 7);
+            if ((a[i] & 3) == 0) {
+                s -= i;
+            }
+        }
+        return s;
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[1000];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 7;
+        }
+        int expected = test(a);
+        for (int i = 0; i < 20000; i++) {
+            if (test(a) != expected) {
+                throw new RuntimeException("wrong result");
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Adjacent allocations sharing a TLAB bump are correctly initialized
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:+MergeTLABAllocations TestMergeTLABAllocations
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:+MergeTLABAllocations -XX:MergeTLABAllocationsLimit=2 -XX:-UseTLAB TestMergeTLABAllocations
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-TieredCompilation -XX:+MergeTLABAllocations -XX:MinTLABSize=2k -XX:-ResizeTLAB -XX:TLABSize=2k -Xmn4m TestMergeTLABAllocations
+ */
+
+public class TestMergeTLABAllocations {
+    static class Entry {
+        final Object key;
+        final Object value;
+        Entry next;
+        Entry(Object key, Object value, Entry next) {
+            this.key = key;
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    static class Key {
+        final int hash;
+        Key(int hash) { this.hash = hash; }
+    }
+
+    static class Value {
+        long v;
+        int w;
+    }
+
+    static Entry test(Entry head, int i) {
+        Key k = new Key(i);
+        Value v = new Value();
+        v.v = i;
+        return new Entry(k, v, head);
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 20; iter++) {
+            Entry head = null;
+            for (int i = 0; i < 10000; i++) {
+                head = test(head, i);
+            }
+            for (int i = 9999; i >= 0; i--) {
+                if (((Key)head.key).hash != i || ((Value)head.value).v != i ||
+                    ((Value)head.value).w != 0) {
+                    throw new RuntimeException("wrong entry " + i);
+                }
+                head = head.next;
+            }
+            if (head != null) {
+                throw new RuntimeException("list too long");
+            }
+        }
+    }
+}
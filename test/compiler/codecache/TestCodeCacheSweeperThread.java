@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Test that a dedicated sweeper thread keeps a small code cache usable
+ * @library /testlibrary
+ * @run main TestCodeCacheSweeperThread
+ */
+import com.oracle.java.testlibrary.*;
+
+public class TestCodeCacheSweeperThread {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb;
+    OutputAnalyzer out;
+
+    // The code cache fills up quickly, so the sweeper thread has to flush it.
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+UseCodeCacheSweeperThread",
+                                               "-XX:ReservedCodeCacheSize=4m",
+                                               "-XX:+UseCodeCacheFlushing",
+                                               "-XX:-TieredCompilation",
+                                               "-Xcomp", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+UseCodeCacheSweeperThread",
+                                               "-XX:+SegmentedCodeCache",
+                                               "-XX:+PrintMethodFlushing", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+  }
+}
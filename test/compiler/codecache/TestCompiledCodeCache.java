@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Test that C2 code recorded in the compiled code cache is installed
+ *          by a later run and computes the same results
+ * @library /testlibrary
+ * @run main TestCompiledCodeCache
+ */
+import java.io.File;
+
+import com.oracle.java.testlibrary.*;
+
+public class TestCompiledCodeCache {
+  static final String RESULT = "result: ";
+
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      workload();
+      return;
+    }
+    File cache = new File("compiled-code.cache");
+    cache.delete();
+    String[] options = { "-XX:CompiledCodeCacheFile=" + cache.getPath(),
+                         "-XX:+PrintCompiledCodeCache",
+                         "-XX:-TieredCompilation", "-Xbatch",
+                         "-Xmx64m", "-XX:-BackgroundCompilation",
+                         TestCompiledCodeCache.class.getName(), "run" };
+
+    OutputAnalyzer first = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(options).start());
+    first.shouldHaveExitValue(0);
+    first.shouldContain("[Compiled code cache recorded");
+    if (!cache.exists()) {
+      throw new RuntimeException("compiled code cache not written");
+    }
+
+    OutputAnalyzer second = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(options).start());
+    second.shouldHaveExitValue(0);
+    second.shouldContain("[Compiled code cache installed");
+    if (!result(first).equals(result(second))) {
+      throw new RuntimeException("cached code computed " + result(second) +
+                                 " instead of " + result(first));
+    }
+  }
+
+  static String result(OutputAnalyzer out) {
+    String stdout = out.getStdout();
+    int start = stdout.indexOf(RESULT);
+    if (start < 0) {
+      throw new RuntimeException("no result in " + stdout);
+    }
+    int end = stdout.indexOf('\n', start);
+    return stdout.substring(start, end < 0 ? stdout.length() : end).trim();
+  }
+
+  static final String[] WORDS = { "alpha", "beta", "gamma", "delta" };
+
+  static int hash(String s, int seed) {
+    int h = seed;
+    for (int i = 0; i < s.length(); i++) {
+      h = 31 * h + s.charAt(i);
+    }
+    return h;
+  }
+
+  static long sum(int[] values) {
+    long sum = 0;
+    for (int v : values) {
+      sum += v;
+    }
+    return sum;
+  }
+
+  static void workload() {
+    int[] values = new int[1000];
+    long total = 0;
+    for (int i = 0; i < 20000; i++) {
+      String word = WORDS[i % WORDS.length];
+      values[i % values.length] = hash(word, i);
+      total += sum(values) + "constant".length();
+    }
+    System.out.println(RESULT + total);
+  }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Test that SegmentedCodeCache sizes its code heaps and rejects sizes that do not fit
+ * @library /testlibrary
+ * @run main TestSegmentedCodeCache
+ */
+import com.oracle.java.testlibrary.*;
+
+public class TestSegmentedCodeCache {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb;
+    OutputAnalyzer out;
+
+    // Ergonomic sizes are filled in for every heap.
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+SegmentedCodeCache", "-XX:+TieredCompilation",
+                                               "-XX:ReservedCodeCacheSize=64m",
+                                               "-XX:+PrintFlagsFinal", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+    out.shouldNotMatch("NonNMethodCodeHeapSize\\s+:?=\\s+0\\s");
+    out.shouldNotMatch("ProfiledCodeHeapSize\\s+:?=\\s+0\\s");
+
+    // A program still runs with all of its code in the segmented cache.
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+SegmentedCodeCache", "-Xcomp", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+
+    // The non-nmethod heap must leave room for nmethods.
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+SegmentedCodeCache",
+                                               "-XX:ReservedCodeCacheSize=16m",
+                                               "-XX:NonNMethodCodeHeapSize=32m", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldContain("NonNMethodCodeHeapSize does not leave room");
+    out.shouldHaveExitValue(1);
+  }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Non-temporal stores in ClearArray, the fill and arraycopy stubs
+ *          for all lengths and offsets around the threshold
+ * @requires os.arch == "amd64" | os.arch == "x86_64"
+ * @run main/othervm -XX:NonTemporalStoreThreshold=256 -XX:+OptimizeFill TestNonTemporalStores
+ * @run main/othervm -XX:NonTemporalStoreThreshold=256 -XX:+OptimizeFill -XX:-UseUnalignedLoadStores TestNonTemporalStores
+ * @run main/othervm -XX:NonTemporalStoreThreshold=1 -XX:-TieredCompilation TestNonTemporalStores
+ */
+import java.util.Arrays;
+
+public class TestNonTemporalStores {
+  static final int MAX = 1200;
+
+  static byte[] fillBytes(byte[] a, int from, int to, byte v) {
+    for (int i = from; i < to; i++) {
+      a[i] = v;
+    }
+    return a;
+  }
+
+  static short[] fillShorts(short[] a, int from, int to, short v) {
+    for (int i = from; i < to; i++) {
+      a[i] = v;
+    }
+    return a;
+  }
+
+  static int[] fillInts(int[] a, int from, int to, int v) {
+    for (int i = from; i < to; i++) {
+      a[i] = v;
+    }
+    return a;
+  }
+
+  static long[] allocate(int n) {
+    return new long[n];
+  }
+
+  static void check(boolean ok, String what, int from, int len) {
+    if (!ok) {
+      throw new RuntimeException(what + " failed at offset " + from + " length " + len);
+    }
+  }
+
+  public static void main(String[] args) {
+    for (int iter = 0; iter < 30; iter++) {
+      for (int len = 0; len < MAX; len += (len < 300 ? 1 : 37)) {
+        for (int from = 0; from < 4; from++) {
+          byte[] b = fillBytes(new byte[MAX + 8], from, from + len, (byte)0x5a);
+          short[] s = fillShorts(new short[MAX + 8], from, from + len, (short)0x1234);
+          int[] i = fillInts(new int[MAX + 8], from, from + len, 0x7abcdef1);
+          for (int k = 0; k < MAX + 8; k++) {
+            boolean in = k >= from && k < from + len;
+            check(b[k] == (in ? (byte)0x5a : 0), "byte fill", from, len);
+            check(s[k] == (in ? (short)0x1234 : 0), "short fill", from, len);
+            check(i[k] == (in ? 0x7abcdef1 : 0), "int fill", from, len);
+          }
+
+          long[] src = new long[len + from];
+          for (int k = 0; k < src.length; k++) {
+            src[k] = k * 0x9e3779b97f4a7c15L;
+          }
+          long[] dst = new long[len + 8];
+          System.arraycopy(src, from, dst, from & 1, len);
+          for (int k = 0; k < len; k++) {
+            check(dst[(from & 1) + k] == src[from + k], "arraycopy", from, len);
+          }
+
+          byte[] bsrc = b;
+          byte[] bdst = new byte[MAX + 8];
+          System.arraycopy(bsrc, from, bdst, 3 - from, len);
+          for (int k = 0; k < len; k++) {
+            check(bdst[3 - from + k] == bsrc[from + k], "byte arraycopy", from, len);
+          }
+        }
+        long[] fresh = allocate(len);
+        for (long v : fresh) {
+          check(v == 0, "ClearArray", 0, len);
+        }
+        long[] dirty = allocate(len);
+        Arrays.fill(dirty, -1L);
+      }
+    }
+  }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * Calls JavaTrivial_ entries, which run without a thread state transition,
+ * while other threads keep the GC busy.
+ */
+public class TrivialNatives {
+    static {
+        System.loadLibrary("TrivialNatives");
+    }
+
+    // the regular JNI entries return -1, the trivial ones do the work
+    static native int sum(int[] values);
+    static native long mix(long a, byte[] bytes, int b);
+
+    public static void main(String args[]) throws Exception {
+        Thread allocator = new Thread() {
+            public void run() {
+                Object[] keep = new Object[1024];
+                for (int i = 0; i < 2000000; i++) {
+                    keep[i % keep.length] = new int[64];
+                }
+            }
+        };
+        allocator.start();
+
+        int[] values = new int[100];
+        int expected = 0;
+        for (int i = 0; i < values.length; i++) {
+            values[i] = i;
+            expected += i;
+        }
+        byte[] bytes = { 1, 2, 3, 4 };
+        for (int i = 0; i < 1000000; i++) {
+            if (sum(values) != expected) {
+                throw new Exception("trivial native sum returned a wrong result");
+            }
+            if (mix(i, bytes, 7) != (long)i + 10 + 7) {
+                throw new Exception("trivial native arguments mismatch");
+            }
+        }
+        allocator.join();
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "jni.h"
+
+JNIEXPORT jint JNICALL JavaTrivial_TrivialNatives_sum
+  (jint length, jint* values) {
+  jint sum = 0;
+  jint i;
+  for (i = 0; i < length; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+JNIEXPORT jlong JNICALL JavaTrivial_TrivialNatives_mix
+  (jlong a, jint length, jbyte* bytes, jint b) {
+  jlong result = a + b;
+  jint i;
+  for (i = 0; i < length; i++) {
+    result += bytes[i];
+  }
+  return result;
+}
+
+JNIEXPORT jint JNICALL Java_TrivialNatives_sum
+  (JNIEnv* env, jclass clazz, jintArray values) {
+  return -1;
+}
+
+JNIEXPORT jlong JNICALL Java_TrivialNatives_mix
+  (JNIEnv* env, jclass clazz, jlong a, jbyteArray bytes, jint b) {
+  return -1;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Code inlined under a class hierarchy assumption is deoptimized
+ *          before an instance of a class that breaks it can be used, when
+ *          the invalidation of several class loads is batched
+ * @run main/othervm -XX:+BatchDependentDeoptimization -XX:-BackgroundCompilation
+ *                   TestBatchedDependentDeoptimization
+ * @run main/othervm -XX:+BatchDependentDeoptimization -XX:-BackgroundCompilation
+ *                   -XX:-TieredCompilation TestBatchedDependentDeoptimization
+ */
+public class TestBatchedDependentDeoptimization {
+  static class Base {
+    int get() { return 1; }
+  }
+  static class Sub1 extends Base {
+    int get() { return 2; }
+  }
+  static class Sub2 extends Base {
+    int get() { return 3; }
+  }
+  static class Sub3 extends Base {
+    int get() { return 4; }
+  }
+
+  static int call(Base b) {
+    return b.get();
+  }
+
+  public static void main(String[] args) throws Exception {
+    Base base = new Base();
+    for (int i = 0; i < 20000; i++) {
+      if (call(base) != 1) {
+        throw new RuntimeException("wrong result for Base");
+      }
+    }
+
+    // Load without initializing: each of them invalidates call()
+    ClassLoader loader = TestBatchedDependentDeoptimization.class.getClassLoader();
+    String prefix = TestBatchedDependentDeoptimization.class.getName();
+    Class.forName(prefix + "$Sub1", false, loader);
+    Class.forName(prefix + "$Sub2", false, loader);
+    Class.forName(prefix + "$Sub3", false, loader);
+
+    Base[] subs = { new Sub1(), new Sub2(), new Sub3() };
+    for (int i = 0; i < 20000; i++) {
+      for (int j = 0; j < subs.length; j++) {
+        if (call(subs[j]) != j + 2) {
+          throw new RuntimeException("stale code for " + subs[j].getClass().getName());
+        }
+      }
+      if (call(base) != 1) {
+        throw new RuntimeException("wrong result for Base");
+      }
+    }
+  }
+}
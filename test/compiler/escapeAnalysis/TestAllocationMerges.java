@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Field loads split through phis of allocations return the merged values
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+ReduceAllocationMerges TestAllocationMerges
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-ReduceAllocationMerges TestAllocationMerges
+ */
+
+public class TestAllocationMerges {
+    static class Point {
+        int x;
+        int y;
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static int select(boolean cond, int a, int b) {
+        Point p = cond ? new Point(a, b) : new Point(b, a);
+        return p.x * 31 + p.y;
+    }
+
+    static int update(int i) {
+        Point p;
+        if ((i & 1) == 0) {
+            p = new Point(i, 0);
+        } else {
+            p = new Point(0, i);
+            p.x = -i;
+        }
+        return p.x - p.y;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20000; i++) {
+            int r = select((i & 3) == 0, i, i + 1);
+            int expected = (i & 3) == 0 ? i * 31 + i + 1 : (i + 1) * 31 + i;
+            if (r != expected) {
+                throw new RuntimeException("select(" + i + "): expected " + expected + " but got " + r);
+            }
+            r = update(i);
+            expected = (i & 1) == 0 ? i : -2 * i;
+            if (r != expected) {
+                throw new RuntimeException("update(" + i + "): expected " + expected + " but got " + r);
+            }
+        }
+    }
+}
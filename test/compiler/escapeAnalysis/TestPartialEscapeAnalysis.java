@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Allocations escaping only through cold calls are materialized when the call is reached
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+PartialEscapeAnalysis
+ *      -XX:CompileCommand=dontinline,TestPartialEscapeAnalysis::report
+ *      TestPartialEscapeAnalysis
+ */
+
+public class TestPartialEscapeAnalysis {
+    static class Point {
+        int x;
+        int y;
+        Point(int x, int y) {
+            this.x = x;
+            this.y = y;
+        }
+    }
+
+    static Point reported;
+
+    static void report(Point p) {
+        reported = p;
+    }
+
+    static int test(int i) {
+        Point p = new Point(i, i + 1);
+        if ((i & 4095) == 0) {
+            report(p);
+        }
+        return p.x + p.y;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 100000; i++) {
+            reported = null;
+            int r = test(i);
+            if (r != 2 * i + 1) {
+                throw new RuntimeException("test(" + i + "): expected " + (2 * i + 1) + " but got " + r);
+            }
+            if ((i & 4095) == 0 && (reported == null || reported.x != i || reported.y != i + 1)) {
+                throw new RuntimeException("report(" + i + ") got a wrong object");
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Very hot call sites may inline big and already compiled methods
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseHotnessInlining TestHotnessInlining
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseHotnessInlining -XX:HotInlineFrequencyRatio=1 -XX:HotInlineBudget=100000 TestHotnessInlining
+ */
+
+public class TestHotnessInlining {
+    // Large enough to exceed FreqInlineSize
+    static int big(int x) {
+        int r = x;
+        for (int i = 0; i < 4; i++) {
+            r = r * 31 + (x ^ i);
+            r = (r << 3) - (r >>> 5) + i;
+            r ^= (r >> 7) * 17 + (x & 0xff);
+            r = r + ((r & 1) == 0 ? 13 : -11) * (i + 1);
+            r = (r * 7) ^ (r >>> 11) ^ (x << 2);
+            r += (r % 5) + (x / 3) - (i * 19);
+            r = (r << 1) | (r >>> 31);
+            r -= (x * i) ^ 0x5a5a5a5a;
+        }
+        return r;
+    }
+
+    static int test(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += big(a[i]);
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[100];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 3 + 1;
+        }
+        // Compile big() on its own first
+        int expected = 0;
+        for (int i = 0; i < 20000; i++) {
+            expected = 0;
+            for (int j = 0; j < a.length; j++) {
+                expected += big(a[j]);
+            }
+        }
+        for (int i = 0; i < 20000; i++) {
+            int res = test(a);
+            if (res != expected) {
+                throw new RuntimeException("incorrect result: " + res + " != " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Guarded inlining of more than two receivers keeps dispatching to the right method
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UsePolymorphicInlining TestPolymorphicInlining
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UsePolymorphicInlining -XX:PolymorphicInlineLimit=3 TestPolymorphicInlining
+ */
+
+public class TestPolymorphicInlining {
+    static abstract class Codec {
+        abstract int code(int x);
+    }
+    static class A extends Codec { int code(int x) { return x + 1; } }
+    static class B extends Codec { int code(int x) { return x * 3; } }
+    static class C extends Codec { int code(int x) { return x ^ 0x55; } }
+    static class D extends Codec { int code(int x) { return x - 7; } }
+    static class E extends Codec { int code(int x) { return x << 2; } }
+
+    static int test(Codec c, int x) {
+        return c.code(x);
+    }
+
+    static int expected(Codec c, int x) {
+        if (c instanceof A) return x + 1;
+        if (c instanceof B) return x * 3;
+        if (c instanceof C) return x ^ 0x55;
+        if (c instanceof D) return x - 7;
+        return x << 2;
+    }
+
+    static void check(Codec c, int x) {
+        int res = test(c, x);
+        if (res != expected(c, x)) {
+            throw new RuntimeException("incorrect result for " + c.getClass() + ": " + res);
+        }
+    }
+
+    public static void main(String[] args) {
+        Codec[] codecs = { new A(), new B(), new C(), new D() };
+        for (int i = 0; i < 20000; i++) {
+            check(codecs[i % codecs.length], i);
+        }
+        // A receiver that was never profiled
+        Codec e = new E();
+        for (int i = 0; i < 100; i++) {
+            check(e, i);
+            check(codecs[i % codecs.length], i);
+        }
+    }
+}
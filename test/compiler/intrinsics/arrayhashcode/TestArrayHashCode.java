@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary String.hashCode and Arrays.hashCode intrinsics compute the same hash as the Java code
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseArrayHashCodeIntrinsics TestArrayHashCode
+ */
+
+import java.util.Arrays;
+
+public class TestArrayHashCode {
+    static int hash(byte[] a) {
+        int h = 1;
+        for (byte b : a) h = 31 * h + b;
+        return h;
+    }
+
+    static int hash(char[] a) {
+        int h = 1;
+        for (char c : a) h = 31 * h + c;
+        return h;
+    }
+
+    static int hash(int[] a) {
+        int h = 1;
+        for (int i : a) h = 31 * h + i;
+        return h;
+    }
+
+    static int stringHash(String s) {
+        int h = 0;
+        for (int i = 0; i < s.length(); i++) h = 31 * h + s.charAt(i);
+        return h;
+    }
+
+    static int testBytes(byte[] a) { return Arrays.hashCode(a); }
+    static int testChars(char[] a) { return Arrays.hashCode(a); }
+    static int testInts(int[] a)   { return Arrays.hashCode(a); }
+    static int testString(String s) { return s.hashCode(); }
+
+    static void check(int res, int expected, String what) {
+        if (res != expected) {
+            throw new RuntimeException(what + ": " + res + " != " + expected);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 20000; iter++) {
+            int len = iter % 67;
+            byte[] b = new byte[len];
+            char[] c = new char[len];
+            int[] v = new int[len];
+            for (int i = 0; i < len; i++) {
+                b[i] = (byte)(i * 37 - 100);        // negative bytes are sign extended
+                c[i] = (char)(0xfff0 + i * 13);     // large chars are zero extended
+                v[i] = i * 0x9e3779b9;
+            }
+            check(testBytes(b), hash(b), "byte[]");
+            check(testChars(c), hash(c), "char[]");
+            check(testInts(v), hash(v), "int[]");
+            String s = new String(c);
+            check(testString(s), stringHash(s), "String");
+            check(testString(s), stringHash(s), "cached String");
+        }
+        check(testBytes(null), 0, "null byte[]");
+        check(testChars(null), 0, "null char[]");
+        check(testInts(null), 0, "null int[]");
+        check(testString(""), 0, "empty String");
+    }
+}
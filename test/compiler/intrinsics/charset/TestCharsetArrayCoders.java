@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary UTF-8 and ISO-8859-1 array coder intrinsics agree with the
+ *          interpreter on ASCII, multi-byte, malformed and truncated input
+ * @run main/othervm -Xbatch -XX:+UseCharsetArrayCoderIntrinsics TestCharsetArrayCoders
+ * @run main/othervm -Xbatch -XX:-UseCharsetArrayCoderIntrinsics TestCharsetArrayCoders
+ */
+import java.nio.charset.Charset;
+import java.util.Arrays;
+import java.util.Random;
+
+public class TestCharsetArrayCoders {
+  static final Charset UTF_8 = Charset.forName("UTF-8");
+  static final Charset ISO_8859_1 = Charset.forName("ISO-8859-1");
+  static final int ITERATIONS = 20000;
+
+  public static void main(String[] args) {
+    Random rnd = new Random(42);
+    for (int i = 0; i < ITERATIONS; i++) {
+      int len = rnd.nextInt(64);
+      String s = randomString(rnd, len);
+      checkUtf8(s);
+      checkLatin1(randomBytes(rnd, len));
+      checkMalformed(rnd, len);
+    }
+  }
+
+  static String randomString(Random rnd, int len) {
+    StringBuilder sb = new StringBuilder();
+    for (int i = 0; i < len; i++) {
+      switch (rnd.nextInt(8)) {
+      case 0:  sb.append((char)(0x80 + rnd.nextInt(0x780))); break;
+      case 1:  sb.append((char)(0x800 + rnd.nextInt(0xd000))); break;
+      case 2:  sb.appendCodePoint(0x10000 + rnd.nextInt(0x100000)); break;
+      case 3:  sb.append((char)(0xd800 + rnd.nextInt(0x800))); break; // lone surrogate
+      default: sb.append((char)rnd.nextInt(0x80)); break;
+      }
+    }
+    return sb.toString();
+  }
+
+  static byte[] randomBytes(Random rnd, int len) {
+    byte[] b = new byte[len];
+    rnd.nextBytes(b);
+    if (rnd.nextBoolean()) {
+      for (int i = 0; i < len; i++) {
+        b[i] &= 0x7f;
+      }
+    }
+    return b;
+  }
+
+  static void checkUtf8(String s) {
+    byte[] expected = utf8Encode(s);
+    byte[] encoded = s.getBytes(UTF_8);
+    if (!Arrays.equals(expected, encoded)) {
+      throw new RuntimeException("encode mismatch for " + dump(s));
+    }
+    String decoded = new String(encoded, UTF_8);
+    String roundTrip = s.replaceAll("[\ud800-\udbff](?![\udc00-\udfff])|(?<![\ud800-\udbff])[\udc00-\udfff]", "?");
+    if (!decoded.equals(roundTrip)) {
+      throw new RuntimeException("decode mismatch for " + dump(s));
+    }
+  }
+
+  static void checkLatin1(byte[] b) {
+    String s = new String(b, ISO_8859_1);
+    if (s.length() != b.length) {
+      throw new RuntimeException("latin1 length mismatch");
+    }
+    for (int i = 0; i < b.length; i++) {
+      if (s.charAt(i) != (char)(b[i] & 0xff)) {
+        throw new RuntimeException("latin1 mismatch at " + i);
+      }
+    }
+  }
+
+  static void checkMalformed(Random rnd, int len) {
+    byte[] b = randomBytes(rnd, len);
+    String s = new String(b, UTF_8);
+    String expected = utf8Decode(b);
+    if (!s.equals(expected)) {
+      throw new RuntimeException("malformed decode mismatch for " + Arrays.toString(b));
+    }
+  }
+
+  // Reference encoder: unpaired surrogates become '?'.
+  static byte[] utf8Encode(String s) {
+    java.io.ByteArrayOutputStream out = new java.io.ByteArrayOutputStream();
+    for (int i = 0; i < s.length(); i++) {
+      char c = s.charAt(i);
+      int cp = c;
+      if (Character.isHighSurrogate(c) && i + 1 < s.length() &&
+          Character.isLowSurrogate(s.charAt(i + 1))) {
+        cp = Character.toCodePoint(c, s.charAt(++i));
+      } else if (Character.isSurrogate(c)) {
+        out.write('?');
+        continue;
+      }
+      if (cp < 0x80) {
+        out.write(cp);
+      } else if (cp < 0x800) {
+        out.write(0xc0 | (cp >> 6));
+        out.write(0x80 | (cp & 0x3f));
+      } else if (cp < 0x10000) {
+        out.write(0xe0 | (cp >> 12));
+        out.write(0x80 | ((cp >> 6) & 0x3f));
+        out.write(0x80 | (cp & 0x3f));
+      } else {
+        out.write(0xf0 | (cp >> 18));
+        out.write(0x80 | ((cp >> 12) & 0x3f));
+        out.write(0x80 | ((cp >> 6) & 0x3f));
+        out.write(0x80 | (cp & 0x3f));
+      }
+    }
+    return out.toByteArray();
+  }
+
+  // Reference decoder through the CharsetDecoder API, which does not use
+  // the array coders.
+  static String utf8Decode(byte[] b) {
+    try {
+      return UTF_8.newDecoder()
+                  .onMalformedInput(java.nio.charset.CodingErrorAction.REPLACE)
+                  .onUnmappableCharacter(java.nio.charset.CodingErrorAction.REPLACE)
+                  .decode(java.nio.ByteBuffer.wrap(b).asReadOnlyBuffer())
+                  .toString();
+    } catch (java.nio.charset.CharacterCodingException e) {
+      throw new RuntimeException(e);
+    }
+  }
+
+  static String dump(String s) {
+    StringBuilder sb = new StringBuilder();
+    for (int i = 0; i < s.length(); i++) {
+      sb.append(String.format("\\u%04x", (int)s.charAt(i)));
+    }
+    return sb.toString();
+  }
+}
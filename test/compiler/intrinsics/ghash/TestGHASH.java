@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary AES/GCM with the GHASH intrinsic against a plain Java GCM
+ * @run main/othervm -Xbatch TestGHASH
+ * @run main/othervm -Xbatch -XX:-UseGHASHIntrinsics TestGHASH
+ */
+import java.util.Arrays;
+import java.util.Random;
+import javax.crypto.Cipher;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+
+public class TestGHASH {
+  static final int ITERATIONS = 20000;
+
+  static Cipher ecb;
+
+  static byte[] encryptBlock(byte[] block) throws Exception {
+    return ecb.doFinal(block);
+  }
+
+  // Multiplication in GF(2^128), algorithm 1 of the GCM specification
+  static byte[] gmul(byte[] x, byte[] y) {
+    byte[] z = new byte[16];
+    byte[] v = y.clone();
+    for (int i = 0; i < 128; i++) {
+      if (((x[i >> 3] >> (7 - (i & 7))) & 1) != 0) {
+        for (int j = 0; j < 16; j++) {
+          z[j] ^= v[j];
+        }
+      }
+      boolean lsb = (v[15] & 1) != 0;
+      for (int j = 15; j > 0; j--) {
+        v[j] = (byte)(((v[j] & 0xff) >>> 1) | ((v[j - 1] & 1) << 7));
+      }
+      v[0] = (byte)((v[0] & 0xff) >>> 1);
+      if (lsb) {
+        v[0] ^= (byte)0xe1;
+      }
+    }
+    return z;
+  }
+
+  static byte[] ghash(byte[] h, byte[] y, byte[] data) {
+    for (int off = 0; off < data.length; off += 16) {
+      for (int j = 0; j < 16 && off + j < data.length; j++) {
+        y[j] ^= data[off + j];
+      }
+      y = gmul(y, h);
+    }
+    return y;
+  }
+
+  static byte[] counter(byte[] j0, int inc) {
+    byte[] cb = j0.clone();
+    int c = ((cb[12] & 0xff) << 24 | (cb[13] & 0xff) << 16 | (cb[14] & 0xff) << 8 | (cb[15] & 0xff)) + inc;
+    cb[12] = (byte)(c >>> 24);
+    cb[13] = (byte)(c >>> 16);
+    cb[14] = (byte)(c >>> 8);
+    cb[15] = (byte)c;
+    return cb;
+  }
+
+  // GCM with a 96-bit IV and a 128-bit tag: ciphertext || tag
+  static byte[] referenceGCM(byte[] iv, byte[] aad, byte[] plain) throws Exception {
+    byte[] h = encryptBlock(new byte[16]);
+    byte[] j0 = Arrays.copyOf(iv, 16);
+    j0[15] = 1;
+
+    byte[] out = new byte[plain.length + 16];
+    for (int off = 0; off < plain.length; off += 16) {
+      byte[] ks = encryptBlock(counter(j0, off / 16 + 1));
+      for (int j = 0; j < 16 && off + j < plain.length; j++) {
+        out[off + j] = (byte)(plain[off + j] ^ ks[j]);
+      }
+    }
+
+    byte[] lengths = new byte[16];
+    long aadBits = aad.length * 8L;
+    long textBits = plain.length * 8L;
+    for (int j = 0; j < 8; j++) {
+      lengths[j] = (byte)(aadBits >>> (56 - 8 * j));
+      lengths[8 + j] = (byte)(textBits >>> (56 - 8 * j));
+    }
+    byte[] s = ghash(h, new byte[16], aad);
+    s = ghash(h, s, Arrays.copyOf(out, plain.length));
+    s = ghash(h, s, lengths);
+
+    byte[] ekj0 = encryptBlock(j0);
+    for (int j = 0; j < 16; j++) {
+      out[plain.length + j] = (byte)(s[j] ^ ekj0[j]);
+    }
+    return out;
+  }
+
+  public static void main(String[] args) throws Exception {
+    Random random = new Random(42);
+    byte[] key = new byte[16];
+    random.nextBytes(key);
+    SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+    ecb = Cipher.getInstance("AES/ECB/NoPadding");
+    ecb.init(Cipher.ENCRYPT_MODE, keySpec);
+    Cipher gcm = Cipher.getInstance("AES/GCM/NoPadding");
+
+    for (int i = 0; i < ITERATIONS; i++) {
+      byte[] iv = new byte[12];
+      random.nextBytes(iv);
+      byte[] aad = new byte[random.nextInt(48)];
+      random.nextBytes(aad);
+      byte[] plain = new byte[random.nextInt(300)];
+      random.nextBytes(plain);
+
+      gcm.init(Cipher.ENCRYPT_MODE, keySpec, new GCMParameterSpec(128, iv));
+      gcm.updateAAD(aad);
+      byte[] actual = gcm.doFinal(plain);
+
+      // checking every iteration would keep GHASH from getting hot
+      if (i % 500 == 0 || i == ITERATIONS - 1) {
+        byte[] expected = referenceGCM(iv, aad, plain);
+        if (!Arrays.equals(actual, expected)) {
+          throw new RuntimeException("GCM mismatch in iteration " + i +
+                                     ", aad " + aad.length + " bytes, text " + plain.length + " bytes");
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Strip mined counted loops run the same iterations as the original loops
+ * @run main/othervm -XX:-BackgroundCompilation -XX:LoopStripMiningIter=100 TestLoopStripMining
+ * @run main/othervm -XX:-BackgroundCompilation -XX:LoopStripMiningIter=2 TestLoopStripMining
+ */
+
+public class TestLoopStripMining {
+    static long sumUp(int[] a) {
+        long sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    static long sumDown(int[] a, int from) {
+        long sum = 0;
+        for (int i = from; i >= 0; i -= 3) {
+            sum += a[i] * (long)i;
+        }
+        return sum;
+    }
+
+    static int countNearMax(int start) {
+        int n = 0;
+        for (int i = start; i <= Integer.MAX_VALUE - 7; i += 5) {
+            n++;
+        }
+        return n;
+    }
+
+    static void fill(int[] a, int v) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = v + i;
+        }
+    }
+
+    static void check(String name, long expected, long actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[1037];
+        int[] b = new int[1037];
+        fill(b, 3);
+        long up = sumUp(b);
+        long down = sumDown(b, b.length - 1);
+        int near = countNearMax(Integer.MAX_VALUE - 20000);
+        for (int i = 0; i < 20000; i++) {
+            fill(a, 3);
+            check("fill", up, sumUp(a));
+            check("sumUp", up, sumUp(b));
+            check("sumDown", down, sumDown(b, b.length - 1));
+            check("countNearMax", near, countNearMax(Integer.MAX_VALUE - 20000));
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Range checks in non-counted and long-bounded loops are hoisted correctly
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseNonCountedLoopPredicate TestNonCountedLoopPredication
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseNonCountedLoopPredicate -XX:-TieredCompilation TestNonCountedLoopPredication
+ */
+
+public class TestNonCountedLoopPredication {
+    // Variable stride: not a counted loop
+    static int variableStride(byte[] a, int n) {
+        int s = 0;
+        int i = 0;
+        while (i < n) {
+            int b = a[i];
+            s += b;
+            i += (b & 3) + 1;
+        }
+        return s;
+    }
+
+    // int induction variable, long limit
+    static int longLimit(int[] a, long n) {
+        int s = 0;
+        for (int i = 0; i < n; i++) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    // long induction variable
+    static int longIndex(int[] a, long from, long to) {
+        int s = 0;
+        for (long i = from; i < to; i++) {
+            s += a[(int) i + 1];
+        }
+        return s;
+    }
+
+    static void check(int actual, int expected) {
+        if (actual != expected) {
+            throw new RuntimeException("expected " + expected + " but got " + actual);
+        }
+    }
+
+    static void expectAIOOBE(Runnable r) {
+        try {
+            r.run();
+        } catch (ArrayIndexOutOfBoundsException e) {
+            return;
+        }
+        throw new RuntimeException("no exception");
+    }
+
+    public static void main(String[] args) {
+        final byte[] b = new byte[100];
+        final int[] a = new int[100];
+        for (int i = 0; i < a.length; i++) {
+            b[i] = (byte) i;
+            a[i] = i;
+        }
+        int v = variableStride(b, b.length);
+        int l = longLimit(a, a.length);
+        int x = longIndex(a, 0, a.length - 1);
+        for (int i = 0; i < 20000; i++) {
+            check(variableStride(b, b.length), v);
+            check(longLimit(a, a.length), l);
+            check(longIndex(a, 0, a.length - 1), x);
+        }
+        expectAIOOBE(new Runnable() { public void run() { variableStride(b, b.length + 10); } });
+        expectAIOOBE(new Runnable() { public void run() { longLimit(a, a.length + 1L); } });
+        expectAIOOBE(new Runnable() { public void run() { longLimit(a, 1L << 40); } });
+        expectAIOOBE(new Runnable() { public void run() { longIndex(a, -2, 10); } });
+        expectAIOOBE(new Runnable() { public void run() { longIndex(a, 0, a.length); } });
+        // Predicates fail, the loops still produce the right result
+        check(longIndex(a, (1L << 32) - 1, 1L << 32), a[0]);
+        check(variableStride(b, 0), 0);
+    }
+}
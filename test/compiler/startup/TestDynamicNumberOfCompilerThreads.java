@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Compiler threads are started on demand and stop again when idle
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+UseDynamicNumberOfCompilerThreads -XX:+TraceCompilerThreads -XX:CICompilerCount=4 TestDynamicNumberOfCompilerThreads
+ * @run main/othervm -XX:+UseDynamicNumberOfCompilerThreads -XX:-ReduceNumberOfCompilerThreads -XX:CICompilerCount=4 TestDynamicNumberOfCompilerThreads
+ * @run main/othervm -XX:+UseDynamicNumberOfCompilerThreads -XX:-TieredCompilation TestDynamicNumberOfCompilerThreads
+ */
+
+import java.lang.reflect.Method;
+
+public class TestDynamicNumberOfCompilerThreads {
+    static volatile int sink;
+
+    static int work(int n) {
+        int r = 0;
+        for (int i = 0; i < n; i++) {
+            r += Integer.toString(i).hashCode() ^ (r >>> 3);
+        }
+        return r;
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Two bursts of compile requests separated by an idle phase, so that
+        // threads are added, may be removed, and are added again.
+        for (int round = 0; round < 2; round++) {
+            for (int i = 0; i < 20000; i++) {
+                sink = work(i & 63);
+            }
+            for (Method m : String.class.getDeclaredMethods()) {
+                sink += m.getName().hashCode();
+            }
+            Thread.sleep(6000);
+        }
+        if (work(10) != work(10)) {
+            throw new RuntimeException("unstable result");
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Intrinsic stubs are generated when C2 first uses them with LazyStubGeneration
+ * @library /testlibrary
+ * @run main TestLazyStubGeneration
+ */
+
+import com.oracle.java.testlibrary.*;
+
+import java.math.BigInteger;
+
+public class TestLazyStubGeneration {
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            BigInteger a = BigInteger.ONE.shiftLeft(4000).subtract(BigInteger.ONE);
+            BigInteger b = a;
+            BigInteger check = a.multiply(a);
+            for (int i = 0; i < 20000; i++) {
+                b = a.multiply(a);
+            }
+            if (!b.equals(check)) {
+                throw new RuntimeException("wrong product");
+            }
+            System.out.println("done");
+            return;
+        }
+        if (!Platform.isX64() || !Platform.isServer()) {
+            System.out.println("Lazy stub generation is implemented for C2 on x86_64 only");
+            return;
+        }
+
+        // BigInteger.multiply compiles to multiplyToLen; nothing uses AES or GHASH
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+PrintStubCode", "-XX:-TieredCompilation",
+            "-XX:+UseMultiplyToLenIntrinsic", "-XX:+LazyStubGeneration",
+            "TestLazyStubGeneration", "run");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("done");
+        output.shouldContain("StubRoutines::multiplyToLen");
+        output.shouldNotContain("StubRoutines::aescrypt_encryptBlock");
+        output.shouldNotContain("StubRoutines::ghash_processBlocks");
+
+        // without the flag every stub is there from the start
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+PrintStubCode",
+            "-XX:+UseMultiplyToLenIntrinsic", "-XX:-LazyStubGeneration", "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("StubRoutines::multiplyToLen");
+    }
+}
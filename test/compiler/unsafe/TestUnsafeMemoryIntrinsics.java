@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Off-heap Unsafe compare, hash and small copy intrinsics must agree
+ *          with the interpreter
+ * @library /testlibrary
+ * @run main/othervm -Xbatch -XX:+UseUnsafeMemoryIntrinsics TestUnsafeMemoryIntrinsics
+ * @run main/othervm -Xint TestUnsafeMemoryIntrinsics
+ */
+
+import com.oracle.java.testlibrary.Utils;
+import java.lang.reflect.Method;
+import sun.misc.Unsafe;
+
+public class TestUnsafeMemoryIntrinsics {
+  static final Unsafe UNSAFE = Utils.getUnsafe();
+  static final int SIZE = 256;
+  static final int ITERATIONS = 20000;
+
+  // Optional, only present when the class library declares them
+  static final Method MISMATCH = find("vectorizedMismatch",
+      Object.class, long.class, Object.class, long.class, long.class);
+  static final Method HASH = find("hash",
+      Object.class, long.class, long.class, int.class);
+
+  static Method find(String name, Class<?>... params) {
+    try {
+      Method m = Unsafe.class.getDeclaredMethod(name, params);
+      m.setAccessible(true);
+      return m;
+    } catch (NoSuchMethodException e) {
+      return null;
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    long a = UNSAFE.allocateMemory(SIZE);
+    long b = UNSAFE.allocateMemory(SIZE);
+    try {
+      for (int i = 0; i < ITERATIONS; i++) {
+        testSmallCopy(a, b);
+      }
+      if (MISMATCH != null) {
+        testMismatch(a, b);
+      }
+      if (HASH != null) {
+        testHash(a, b);
+      }
+    } finally {
+      UNSAFE.freeMemory(a);
+      UNSAFE.freeMemory(b);
+    }
+  }
+
+  static void fill(long addr, int seed) {
+    for (int i = 0; i < SIZE; i++) {
+      UNSAFE.putByte(addr + i, (byte)(i * 31 + seed));
+    }
+  }
+
+  static void check(long addr, int off, int len, int seed, int srcOff) {
+    for (int i = 0; i < len; i++) {
+      byte expected = (byte)((srcOff + i) * 31 + seed);
+      if (UNSAFE.getByte(addr + off + i) != expected) {
+        throw new RuntimeException("copy mismatch at " + (off + i));
+      }
+    }
+  }
+
+  static void copy3(long src, long dst)  { UNSAFE.copyMemory(src, dst, 3); }
+  static void copy8(long src, long dst)  { UNSAFE.copyMemory(src, dst, 8); }
+  static void copy13(long src, long dst) { UNSAFE.copyMemory(src, dst, 13); }
+  static void copy32(long src, long dst) { UNSAFE.copyMemory(src, dst, 32); }
+  static void copy64(long src, long dst) { UNSAFE.copyMemory(src, dst, 64); }
+
+  static void testSmallCopy(long a, long b) {
+    fill(a, 1);
+    copy3(a + 1, b + 5);    check(b, 5, 3, 1, 1);
+    copy8(a + 3, b + 7);    check(b, 7, 8, 1, 3);
+    copy13(a, b + 1);       check(b, 1, 13, 1, 0);
+    copy32(a + 5, b + 64);  check(b, 64, 32, 1, 5);
+    copy64(a + 7, b + 128); check(b, 128, 64, 1, 7);
+    // overlapping ranges behave like memmove
+    copy32(a, a + 9);       check(a, 9, 32, 1, 0);
+    fill(a, 1);
+    copy13(a + 9, a);       check(a, 0, 13, 1, 9);
+  }
+
+  static long mismatch(long a, long b, long len) throws Exception {
+    return (Long)MISMATCH.invoke(UNSAFE, null, a, null, b, len);
+  }
+
+  static void testMismatch(long a, long b) throws Exception {
+    for (int len = 0; len < 80; len++) {
+      fill(a, 7);
+      fill(b, 7);
+      for (int i = 0; i < 200; i++) {
+        if (mismatch(a, b, len) != -1) {
+          throw new RuntimeException("equal ranges of " + len + " bytes differ");
+        }
+      }
+      for (int pos = 0; pos < len; pos++) {
+        UNSAFE.putByte(b + pos, (byte)~UNSAFE.getByte(a + pos));
+        long r = mismatch(a, b, len);
+        if (r != pos) {
+          throw new RuntimeException("len " + len + ": expected " + pos + " got " + r);
+        }
+        UNSAFE.putByte(b + pos, UNSAFE.getByte(a + pos));
+      }
+    }
+    try {
+      mismatch(a, b, -1);
+      throw new RuntimeException("negative length accepted");
+    } catch (java.lang.reflect.InvocationTargetException e) {
+      if (!(e.getCause() instanceof IllegalArgumentException)) {
+        throw e;
+      }
+    }
+  }
+
+  static int hash(long addr, long len, int seed) throws Exception {
+    return (Integer)HASH.invoke(UNSAFE, null, addr, len, seed);
+  }
+
+  static void testHash(long a, long b) throws Exception {
+    fill(a, 3);
+    fill(b, 3);
+    for (int len = 0; len < 80; len++) {
+      int expected = hash(a, len, 42);
+      for (int i = 0; i < 200; i++) {
+        // same contents at a different address must hash the same
+        if (hash(b, len, 42) != expected) {
+          throw new RuntimeException("unstable hash for " + len + " bytes");
+        }
+      }
+      if (len > 0) {
+        UNSAFE.putByte(b + len - 1, (byte)~UNSAFE.getByte(b + len - 1));
+        if (hash(b, len, 42) == expected) {
+          throw new RuntimeException("trailing byte ignored for " + len + " bytes");
+        }
+        UNSAFE.putByte(b + len - 1, UNSAFE.getByte(a + len - 1));
+      }
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Vectorized reductions compute the same values as the scalar loops
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+SuperWordReductions TestSuperWordReductions
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-SuperWordReductions TestSuperWordReductions
+ */
+
+public class TestSuperWordReductions {
+    static final int LENGTH = 1027;
+
+    static int sumInt(int[] a) {
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    static int mulInt(int[] a) {
+        int prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod;
+    }
+
+    static int xorInt(int[] a) {
+        int x = 0;
+        for (int i = 0; i < a.length; i++) {
+            x ^= a[i];
+        }
+        return x;
+    }
+
+    static long sumLong(long[] a) {
+        long sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    static long orLong(long[] a) {
+        long x = 0;
+        for (int i = 0; i < a.length; i++) {
+            x |= a[i];
+        }
+        return x;
+    }
+
+    static long andLong(long[] a) {
+        long x = -1;
+        for (int i = 0; i < a.length; i++) {
+            x &= a[i];
+        }
+        return x;
+    }
+
+    static float sumFloat(float[] a) {
+        float sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    static double mulDouble(double[] a) {
+        double prod = 1;
+        for (int i = 0; i < a.length; i++) {
+            prod *= a[i];
+        }
+        return prod;
+    }
+
+    static void check(String name, long expected, long actual) {
+        if (expected != actual) {
+            throw new RuntimeException(name + ": expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        int[] ia = new int[LENGTH];
+        long[] la = new long[LENGTH];
+        float[] fa = new float[LENGTH];
+        double[] da = new double[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            ia[i] = i * 7919 + 3;
+            la[i] = ~(1L << (i % 64)) ^ ((long) i << 32);
+            fa[i] = 1.0f / (i + 1);
+            da[i] = 1.0 + 1.0 / (i + 3);
+        }
+
+        // The first calls run in the interpreter and provide the
+        // reference values; floating point reductions must match exactly.
+        int sumI = sumInt(ia);
+        int mulI = mulInt(ia);
+        int xorI = xorInt(ia);
+        long sumL = sumLong(la);
+        long orL = orLong(la);
+        long andL = andLong(la);
+        int sumF = Float.floatToRawIntBits(sumFloat(fa));
+        long mulD = Double.doubleToRawLongBits(mulDouble(da));
+
+        for (int n = 0; n < 20000; n++) {
+            check("sumInt", sumI, sumInt(ia));
+            check("mulInt", mulI, mulInt(ia));
+            check("xorInt", xorI, xorInt(ia));
+            check("sumLong", sumL, sumLong(la));
+            check("orLong", orL, orLong(la));
+            check("andLong", andL, andLong(la));
+            check("sumFloat", sumF, Float.floatToRawIntBits(sumFloat(fa)));
+            check("mulDouble", mulD, Double.doubleToRawLongBits(mulDouble(da)));
+        }
+    }
+}
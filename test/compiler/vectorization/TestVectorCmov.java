@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/**
+ * @test
+ * @summary Vectorized conditional moves select the same values as the scalar loops
+ * @run main/othervm -XX:-BackgroundCompilation -XX:+UseVectorCmov TestVectorCmov
+ */
+
+public class TestVectorCmov {
+    static final int LENGTH = 1027;
+
+    static void clampInt(int[] a, int[] b) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = b[i] > 0 ? b[i] : 0;
+        }
+    }
+
+    static void selectInt(int[] a, int[] b, int[] c) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = b[i] != c[i] ? b[i] : -1;
+        }
+    }
+
+    static void thresholdFloat(float[] a, float[] b, float t) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = b[i] < t ? 0.0f : b[i];
+        }
+    }
+
+    static void maxDouble(double[] a, double[] b, double[] c) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = b[i] >= c[i] ? b[i] : c[i];
+        }
+    }
+
+    static void check(String name, long[] expected, long[] actual) {
+        for (int i = 0; i < expected.length; i++) {
+            if (expected[i] != actual[i]) {
+                throw new RuntimeException(name + "[" + i + "]: expected " + expected[i] +
+                                           " but got " + actual[i]);
+            }
+        }
+    }
+
+    static long[] bits(int[] a) {
+        long[] r = new long[a.length];
+        for (int i = 0; i < a.length; i++) r[i] = a[i];
+        return r;
+    }
+
+    static long[] bits(float[] a) {
+        long[] r = new long[a.length];
+        for (int i = 0; i < a.length; i++) r[i] = Float.floatToRawIntBits(a[i]);
+        return r;
+    }
+
+    static long[] bits(double[] a) {
+        long[] r = new long[a.length];
+        for (int i = 0; i < a.length; i++) r[i] = Double.doubleToRawLongBits(a[i]);
+        return r;
+    }
+
+    public static void main(String[] args) {
+        int[] ia = new int[LENGTH];
+        int[] ib = new int[LENGTH];
+        int[] ic = new int[LENGTH];
+        float[] fa = new float[LENGTH];
+        float[] fb = new float[LENGTH];
+        double[] da = new double[LENGTH];
+        double[] db = new double[LENGTH];
+        double[] dc = new double[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            ib[i] = (i * 7919) % 201 - 100;
+            ic[i] = (i % 3 == 0) ? ib[i] : i;
+            fb[i] = (i % 17 == 0) ? Float.NaN : (i % 50) - 25.5f;
+            db[i] = (i % 13 == 0) ? Double.NaN : Math.sin(i);
+            dc[i] = (i % 11 == 0) ? Double.NaN : Math.cos(i);
+        }
+
+        // The first calls run in the interpreter and provide the reference values.
+        clampInt(ia, ib);
+        long[] clampI = bits(ia);
+        selectInt(ia, ib, ic);
+        long[] selectI = bits(ia);
+        thresholdFloat(fa, fb, 3.0f);
+        long[] thresholdF = bits(fa);
+        maxDouble(da, db, dc);
+        long[] maxD = bits(da);
+
+        for (int n = 0; n < 20000; n++) {
+            clampInt(ia, ib);
+            check("clampInt", clampI, bits(ia));
+            selectInt(ia, ib, ic);
+            check("selectInt", selectI, bits(ia));
+            thresholdFloat(fa, fb, 3.0f);
+            check("thresholdFloat", thresholdF, bits(fa));
+            maxDouble(da, db, dc);
+            check("maxDouble", maxD, bits(da));
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+import com.oracle.java.testlibrary.*;
+
+/* @test
+ * @summary test elastic-heap standby regions are handed to the young gen on an allocation spike
+ * @library /testlibrary
+ * @build TestElasticHeapStandby
+ * @run main/othervm/timeout=200 TestElasticHeapStandby
+ */
+
+public class TestElasticHeapStandby {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder serverBuilder;
+
+        serverBuilder = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                "-XX:+G1ElasticHeap", "-Xmx1g", "-Xms1g",
+                "-XX:+ElasticHeapPeriodicUncommit", "-XX:ElasticHeapPeriodicYGCIntervalMillis=500",
+                "-XX:ElasticHeapPeriodicUncommitStartupDelay=1",
+                "-Xmn100m", "-XX:G1HeapRegionSize=1m",
+                "-XX:ElasticHeapYGCIntervalMinMillis=10",
+                "-XX:ElasticHeapPeriodicMinYoungCommitPercent=20",
+                "-XX:ElasticHeapStandbyPercent=20",
+                "-XX:ElasticHeapAllocSpikePercent=100",
+                "-XX:InitiatingHeapOccupancyPercent=80",
+                "-verbose:gc", "-XX:+PrintGCDetails", "-XX:+PrintGCTimeStamps",
+                "-Dtest.jdk=" + System.getProperty("test.jdk"),
+                Server.class.getName());
+        Process server = serverBuilder.start();
+
+        OutputAnalyzer output = new OutputAnalyzer(server);
+        System.out.println(output.getOutput());
+        // Young gen is shrunk during the slow phase and grown from the
+        // standby regions when the allocation rate jumps
+        output.shouldContain("Elastic Heap concurrent thread: uncommit");
+        output.shouldContain("Elastic Heap detects allocation spike");
+        output.shouldMatch("Elastic Heap grows young gen by \\d+ standby regions");
+        Asserts.assertTrue(output.getExitValue() == 0);
+    }
+
+    private static class Server {
+        public static void main(String[] args) throws Exception {
+            byte[] arr = new byte[200*1024];
+            // Slow phase: 20M per second, a young gc every few seconds
+            // after the young gen has been shrunk
+            for (int i = 0; i < 1000 * 10; i++) {
+                arr = new byte[20*1024];
+                Thread.sleep(1);
+            }
+            // Spike: allocate as fast as possible
+            long end = System.currentTimeMillis() + 3000;
+            while (System.currentTimeMillis() < end) {
+                arr = new byte[200*1024];
+            }
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+import com.oracle.java.testlibrary.*;
+import com.alibaba.tenant.TenantConfiguration;
+import com.alibaba.tenant.TenantContainer;
+
+/* @test
+ * @requires os.family == "Linux"
+ * @requires os.arch == "amd64"
+ * @summary test elastic-heap per-tenant heap limits with jcmd, shrinking below the usage without full gc
+ * @library /testlibrary
+ * @build TestElasticHeapTenantLimit
+ * @run main/othervm/timeout=200 TestElasticHeapTenantLimit
+ */
+
+public class TestElasticHeapTenantLimit {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder serverBuilder;
+
+        serverBuilder = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                "-XX:+G1ElasticHeap", "-Xmx1g", "-Xms1g",
+                "-XX:+MultiTenant", "-XX:+TenantHeapThrottling",
+                "-Xmn400m", "-XX:SurvivorRatio=4", "-XX:G1HeapRegionSize=1m",
+                "-verbose:gc", "-XX:+PrintGCDetails", "-XX:+PrintGCTimeStamps",
+                "-Dtest.jdk=" + System.getProperty("test.jdk"),
+                Server.class.getName());
+        Process server = serverBuilder.start();
+
+        OutputAnalyzer output = new OutputAnalyzer(server);
+        System.out.println(output.getOutput());
+        output.shouldContain("Elastic Heap lowers heap limits of 1 tenants");
+        output.shouldNotContain("Full GC");
+        Asserts.assertTrue(output.getExitValue() == 0);
+    }
+
+    private static class Server {
+        private static final int M = 1024 * 1024;
+        private static byte[][] live;
+        private static byte[] garbage;
+
+        public static void main(String[] args) throws Exception {
+            TenantContainer tenant = TenantContainer.create(new TenantConfiguration().limitHeap(64 * M));
+            String tenantId = "tenant_id=" + tenant.getTenantId();
+
+            tenant.run(() -> {
+                live = new byte[16][];
+                for (int i = 0; i < live.length; i++) {
+                    live[i] = new byte[M];
+                }
+            });
+
+            // Growing takes effect at once
+            triggerJcmd(tenantId, "heap_limit=128m")
+                .shouldContain("heap limit 134217728 B, target 134217728 B");
+
+            // Shrinking below the usage keeps the limit until gcs free the memory
+            triggerJcmd(tenantId, "heap_limit=8m")
+                .shouldContain("heap limit 134217728 B, target 8388608 B");
+
+            live = null;
+            tenant.run(() -> {
+                long end = System.currentTimeMillis() + 5000;
+                while (System.currentTimeMillis() < end) {
+                    garbage = new byte[100 * 1024];
+                }
+            });
+
+            triggerJcmd(tenantId, null)
+                .shouldContain("heap limit 8388608 B, target 8388608 B");
+            triggerJcmd("tenant_id=-1", "heap_limit=8m")
+                .shouldContain("Error: command fails because no such tenant");
+            tenant.destroy();
+        }
+
+        private static OutputAnalyzer triggerJcmd(String arg1, String arg2) throws Exception {
+            String pid = Integer.toString(ProcessTools.getProcessId());
+            JDKToolLauncher jcmd = JDKToolLauncher.create("jcmd")
+                                                  .addToolArg(pid)
+                                                  .addToolArg("GC.tenant_elastic_heap");
+            if (arg1 != null) {
+                jcmd.addToolArg(arg1);
+            }
+            if (arg2 != null) {
+                jcmd.addToolArg(arg2);
+            }
+            ProcessBuilder pb = new ProcessBuilder(jcmd.getCommand());
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            System.out.println(output.getOutput());
+            output.shouldHaveExitValue(0);
+            return output;
+        }
+    }
+}
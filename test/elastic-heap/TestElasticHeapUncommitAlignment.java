@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+import com.oracle.java.testlibrary.*;
+
+/* @test
+ * @summary test ElasticHeapUncommitAlignment
+ * @library /testlibrary
+ * @build TestElasticHeapUncommitAlignment
+ * @run main/othervm/timeout=100 TestElasticHeapUncommitAlignment
+ */
+
+public class TestElasticHeapUncommitAlignment {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                "-XX:+G1ElasticHeap", "-Xmx1g", "-Xms1g",
+                "-XX:G1HeapRegionSize=1m", "-XX:ElasticHeapUncommitAlignment=3m",
+                "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        output.shouldContain("ElasticHeapUncommitAlignment");
+        output.shouldContain("must be a power of 2");
+        Asserts.assertTrue(output.getExitValue() != 0);
+
+        pb = ProcessTools.createJavaProcessBuilder("-XX:+UseG1GC",
+                "-XX:+G1ElasticHeap", "-Xmx1g", "-Xms1g",
+                "-XX:G1HeapRegionSize=1m", "-XX:ElasticHeapUncommitAlignment=2m",
+                "-version");
+        output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        Asserts.assertTrue(output.getExitValue() == 0);
+    }
+}
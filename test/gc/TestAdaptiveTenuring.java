@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary UseAdaptiveTenuring promotes objects that survive every young
+ *          collection right away instead of copying them between survivors
+ * @key gc
+ * @library /testlibrary
+ * @run main TestAdaptiveTenuring
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestAdaptiveTenuring {
+  public static void main(String[] args) throws Exception {
+    test("-XX:+UseSerialGC");
+    test("-XX:+UseConcMarkSweepGC");
+  }
+
+  static void test(String gc) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        gc, "-Xmx128m", "-Xmn16m", "-XX:MaxTenuringThreshold=15",
+        "-XX:+UseAdaptiveTenuring", "-XX:+PrintGC", "-XX:+PrintTenuringDistribution",
+        Workload.class.getName());
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    output.shouldContain("survival rates:");
+    output.shouldContain("new threshold 1 (max 15)");
+  }
+
+  static class Workload {
+    static List<byte[]> retained = new ArrayList<byte[]>();
+    static Object sink;
+
+    public static void main(String[] args) {
+      // Everything retained lives forever, everything else dies at once.
+      for (int i = 0; i < 300000; i++) {
+        sink = new byte[512];
+        if (i % 64 == 0) {
+          retained.add(new byte[128]);
+        }
+      }
+    }
+  }
+}
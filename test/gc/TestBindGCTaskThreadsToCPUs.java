@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestBindGCTaskThreadsToCPUs.java
+ * @summary GC worker threads are spread over and bound to the CPUs of the
+ *          process with BindGCTaskThreadsToCPUs
+ * @library /testlibrary
+ * @run main/othervm TestBindGCTaskThreadsToCPUs
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.Platform;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestBindGCTaskThreadsToCPUs {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < 100000; i++) {
+                sink = new byte[1024];
+            }
+            System.gc();
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC", "-XX:ParallelGCThreads=4",
+            "-XX:+BindGCTaskThreadsToCPUs",
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+TraceGCTaskThread",
+            TestBindGCTaskThreadsToCPUs.class.getName(), "child");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        if (Platform.isLinux()) {
+            // Every worker got a processor, none the unbound sentinel.
+            output.shouldMatch("GCTaskManager::initialize: distribution:(  [0-9]+){4}");
+            output.shouldNotContain("4294967295");
+        }
+
+        for (String gc : new String[] { "-XX:+UseG1GC", "-XX:+UseConcMarkSweepGC" }) {
+            pb = ProcessTools.createJavaProcessBuilder(
+                gc, "-XX:ParallelGCThreads=4", "-XX:+BindGCTaskThreadsToCPUs",
+                TestBindGCTaskThreadsToCPUs.class.getName(), "child");
+            output = new OutputAnalyzer(pb.start());
+            output.shouldHaveExitValue(0);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestObjectProfilerSampleBytes
+ * @summary Allocation sampling by bytes lowers the TLAB end to a sample
+ *          point; all tiers must keep allocating correctly and keep the
+ *          heap parsable
+ * @library /testlibrary
+ * @run main/othervm -XX:ObjectProfilerSampleBytes=4096 -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC TestObjectProfilerSampleBytes
+ * @run main/othervm -XX:ObjectProfilerSampleBytes=512 -XX:FlightRecorderOptions=sampleobjectallocations=true -XX:StartFlightRecording -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC TestObjectProfilerSampleBytes
+ * @run main/othervm -XX:ObjectProfilerSampleBytes=4096 -XX:TieredStopAtLevel=1 TestObjectProfilerSampleBytes
+ * @run main/othervm -XX:ObjectProfilerSampleBytes=4096 -Xint TestObjectProfilerSampleBytes
+ * @run main TestObjectProfilerSampleBytes flags
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestObjectProfilerSampleBytes {
+  static Object sink;
+
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0 && args[0].equals("flags")) {
+      checkFlags();
+      return;
+    }
+    for (int round = 0; round < 20; round++) {
+      Object[] keep = new Object[1024];
+      for (int i = 0; i < 200000; i++) {
+        switch (i % 4) {
+          case 0:  sink = new Object(); break;
+          case 1:  sink = new int[i % 64]; break;
+          case 2:  sink = new byte[i % 3000]; break;
+          default: sink = new StringBuilder(i % 100); break;
+        }
+        keep[i % keep.length] = sink;
+      }
+      sink = keep;
+      System.gc();
+    }
+  }
+
+  static void checkFlags() throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:ObjectProfilerSampleBytes=4096",
+        "-XX:+PrintFlagsFinal",
+        "-version");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    // C1's inline TLAB refill does not know about sample points
+    output.shouldMatch("FastTLABRefill\\s+= false");
+  }
+}
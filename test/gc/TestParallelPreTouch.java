@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestParallelPreTouch.java
+ * @summary Pre-touch the G1 heap in parallel and commit the whole code cache
+ *          and compressed class space at startup
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -Xms256m -Xmx256m -XX:+AlwaysPreTouch
+ *                   -XX:ParallelGCThreads=4 -XX:PreTouchParallelChunkSize=1m
+ *                   TestParallelPreTouch
+ * @run main/othervm -XX:+UseCompressedOops -XX:+UseCompressedClassPointers
+ *                   -XX:ReservedCodeCacheSize=32m -XX:CompressedClassSpaceSize=64m
+ *                   -XX:+PreTouchCodeCache -XX:+PreTouchCompressedClassSpace
+ *                   TestParallelPreTouch fully-committed
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.management.MemoryUsage;
+
+import static com.oracle.java.testlibrary.Asserts.*;
+
+public class TestParallelPreTouch {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 100000; i++) {
+            sink = new byte[1024];
+        }
+        System.gc();
+
+        if (args.length == 0) {
+            return;
+        }
+
+        boolean sawCodeCache = false;
+        boolean sawClassSpace = false;
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            String name = pool.getName();
+            MemoryUsage usage = pool.getUsage();
+            if (name.equals("Code Cache") || name.startsWith("CodeHeap")) {
+                sawCodeCache = true;
+                assertEQ(usage.getCommitted(), usage.getMax(), name + " is not fully committed");
+            } else if (name.equals("Compressed Class Space")) {
+                sawClassSpace = true;
+                assertGTE(usage.getCommitted(), 64L * 1024 * 1024, name + " is not fully committed");
+            }
+        }
+        assertTrue(sawCodeCache, "no code cache memory pool");
+        assertTrue(sawClassSpace, "no compressed class space memory pool");
+    }
+}
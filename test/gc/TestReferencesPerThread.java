@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @key gc
+ * @summary Reference processing sized by ReferencesPerThread clears and
+ *          enqueues every kind of reference, including when some phases
+ *          have nothing to do
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=4 -XX:+ParallelRefProcEnabled -XX:ReferencesPerThread=100 -XX:+PrintGCDetails -XX:+PrintReferenceGC TestReferencesPerThread
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=4 -XX:+ParallelRefProcEnabled -XX:ReferencesPerThread=100 TestReferencesPerThread
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:+ParallelRefProcEnabled -XX:ReferencesPerThread=100 TestReferencesPerThread
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:+ParallelRefProcEnabled -XX:ReferencesPerThread=1 TestReferencesPerThread
+ */
+import java.lang.ref.PhantomReference;
+import java.lang.ref.Reference;
+import java.lang.ref.ReferenceQueue;
+import java.lang.ref.WeakReference;
+
+public class TestReferencesPerThread {
+  static final int[] COUNTS = { 0, 10, 1000, 50000 };
+
+  public static void main(String[] args) throws Exception {
+    for (int count : COUNTS) {
+      check(count, false);
+      check(count, true);
+    }
+  }
+
+  static void check(int count, boolean phantom) throws Exception {
+    ReferenceQueue<Object> queue = new ReferenceQueue<Object>();
+    Reference<?>[] refs = new Reference<?>[count];
+    Object[] keep = new Object[count];
+    for (int i = 0; i < count; i++) {
+      Object o = new Object();
+      refs[i] = phantom ? new PhantomReference<Object>(o, queue)
+                        : new WeakReference<Object>(o, queue);
+      // Keep every other referent strongly reachable.
+      if (i % 2 == 0) {
+        keep[i] = o;
+      }
+    }
+    System.gc();
+
+    int expected = count / 2;
+    int enqueued = 0;
+    while (enqueued < expected) {
+      if (queue.remove(10000) == null) {
+        throw new RuntimeException("only " + enqueued + " of " + expected +
+                                   " references enqueued");
+      }
+      enqueued++;
+    }
+    for (int i = 0; i < count; i += 2) {
+      if (!phantom && refs[i].get() != keep[i]) {
+        throw new RuntimeException("live referent " + i + " cleared");
+      }
+      if (refs[i].isEnqueued()) {
+        throw new RuntimeException("reference " + i + " to live referent enqueued");
+      }
+    }
+  }
+}
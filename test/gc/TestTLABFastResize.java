@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestTLABFastResize.java
+ * @summary A thread allocating much faster than its TLAB size predicts gets its TLAB grown before the next GC
+ * @library /testlibrary
+ * @run main/othervm TestTLABFastResize
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestTLABFastResize {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < 200000; i++) {
+                sink = new byte[64];
+            }
+            System.gc();
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC", "-Xmn64m", "-XX:TLABSize=2k",
+            "-XX:+TLABFastResize", "-XX:+PrintTLAB",
+            TestTLABFastResize.class.getName(), "child");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("TLAB: gc thread: .* fast resizes: [1-9]");
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:-ResizeTLAB", "-XX:+TLABFastResize", "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("TLABFastResize has no effect without ResizeTLAB");
+    }
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.io.File;
+import java.io.FileWriter;
+import java.io.PrintWriter;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+/**
+ * GC pause benchmark driver. Not a jtreg test; run it with "make gcbench"
+ * in the test directory (or "make gcbench" under make/ on a built JDK
+ * image), or directly:
+ *
+ *   java GCBench [-shapes=deep-tree,...] [-collectors=G1,CMS,...]
+ *                [-seconds=30] [-warmup=10] [-heap=2g] [-seed=42]
+ *                [-out=results.json] [-vmoptions="..."] [key=value ...]
+ *
+ * For each heap shape and collector, a child VM runs GCBenchWorkload with
+ * a fixed heap and a fixed random seed and logs its pauses with
+ * -Xloggc and PrintGCDetails. The driver parses the log and prints one
+ * JSON object per run: pause time percentiles per pause kind (young,
+ * mixed, initial-mark, remark, cleanup, full) measured after the warmup,
+ * and for G1 the average of each G1GCPhaseTimes line per pause kind
+ * (milliseconds, or counts for lines such as Processed Buffers).
+ * key=value arguments are passed on to the workload to size the shapes,
+ * see GCBenchWorkload.
+ */
+public class GCBench {
+    static final String[] ALL_SHAPES = {
+        "deep-tree", "large-arrays", "rset-fanin", "humongous", "tenants"
+    };
+    static final String[] ALL_COLLECTORS = { "G1", "CMS", "Parallel", "Serial" };
+
+    public static void main(String[] args) throws Exception {
+        String[] shapes = ALL_SHAPES;
+        String[] collectors = ALL_COLLECTORS;
+        int seconds = 30;
+        int warmup = 10;
+        String heap = "2g";
+        long seed = 42;
+        String out = null;
+        List<String> vmOptions = new ArrayList<>();
+        List<String> params = new ArrayList<>();
+
+        for (String arg : args) {
+            if (arg.startsWith("-shapes=")) {
+                shapes = value(arg).split(",");
+            } else if (arg.startsWith("-collectors=")) {
+                collectors = value(arg).split(",");
+            } else if (arg.startsWith("-seconds=")) {
+                seconds = Integer.parseInt(value(arg));
+            } else if (arg.startsWith("-warmup=")) {
+                warmup = Integer.parseInt(value(arg));
+            } else if (arg.startsWith("-heap=")) {
+                heap = value(arg);
+            } else if (arg.startsWith("-seed=")) {
+                seed = Long.parseLong(value(arg));
+            } else if (arg.startsWith("-out=")) {
+                out = value(arg);
+            } else if (arg.startsWith("-vmoptions=")) {
+                vmOptions.addAll(Arrays.asList(value(arg).trim().split("\\s+")));
+                vmOptions.remove("");
+            } else if (!arg.startsWith("-") && arg.indexOf('=') > 0) {
+                params.add(arg);
+            } else {
+                throw new IllegalArgumentException("Unknown argument: " + arg);
+            }
+        }
+
+        PrintWriter results = out == null ? null : new PrintWriter(new FileWriter(out));
+        try {
+            for (String shape : shapes) {
+                for (String collector : collectors) {
+                    String json = run(shape, collector, seconds, warmup, heap, seed, vmOptions, params);
+                    System.out.println(json);
+                    if (results != null) {
+                        results.println(json);
+                        results.flush();
+                    }
+                }
+            }
+        } finally {
+            if (results != null) {
+                results.close();
+            }
+        }
+    }
+
+    static String value(String arg) {
+        return arg.substring(arg.indexOf('=') + 1);
+    }
+
+    static List<String> collectorOptions(String collector) {
+        switch (collector) {
+            case "G1":       return Arrays.asList("-XX:+UseG1GC");
+            case "CMS":      return Arrays.asList("-XX:+UseConcMarkSweepGC", "-XX:+UseParNewGC");
+            case "Parallel": return Arrays.asList("-XX:+UseParallelGC", "-XX:-UseAdaptiveSizePolicy");
+            case "Serial":   return Arrays.asList("-XX:+UseSerialGC");
+            default: throw new IllegalArgumentException("Unknown collector: " + collector);
+        }
+    }
+
+    static String run(String shape, String collector, int seconds, int warmup, String heap,
+                      long seed, List<String> vmOptions, List<String> params) throws Exception {
+        if (shape.equals("tenants") && !collector.equals("G1")) {
+            // Tenant heap isolation is implemented for G1 only.
+            return "{\"shape\":\"" + shape + "\",\"collector\":\"" + collector + "\",\"skipped\":true}";
+        }
+
+        File log = File.createTempFile("gcbench-" + shape + "-" + collector + "-", ".log");
+        List<String> cmd = new ArrayList<>();
+        cmd.add(System.getProperty("java.home") + File.separator + "bin" + File.separator + "java");
+        cmd.add("-cp");
+        cmd.add(System.getProperty("java.class.path"));
+        cmd.add("-Xms" + heap);
+        cmd.add("-Xmx" + heap);
+        cmd.add("-XX:+AlwaysPreTouch");
+        cmd.add("-Xloggc:" + log.getPath());
+        cmd.add("-XX:+PrintGCDetails");
+        cmd.add("-XX:+PrintGCTimeStamps");
+        cmd.addAll(collectorOptions(collector));
+        if (shape.equals("tenants")) {
+            cmd.add("-XX:+MultiTenant");
+            cmd.add("-XX:+TenantHeapIsolation");
+        }
+        cmd.addAll(vmOptions);
+        cmd.add("GCBenchWorkload");
+        cmd.add(shape);
+        cmd.add(Integer.toString(warmup));
+        cmd.add(Integer.toString(seconds));
+        cmd.add(Long.toString(seed));
+        cmd.addAll(params);
+
+        ProcessBuilder pb = new ProcessBuilder(cmd);
+        pb.redirectErrorStream(true);
+        Process p = pb.start();
+        String output = GCLogParser.readFully(p.getInputStream());
+        int exit = p.waitFor();
+        if (exit != 0) {
+            throw new RuntimeException(shape + "/" + collector + " exited with " + exit + ":\n" + output);
+        }
+
+        double measureStart = GCBenchWorkload.parseMeasureStart(output);
+        GCLogParser parser = new GCLogParser(measureStart);
+        parser.parse(log);
+        log.delete();
+        return parser.toJson(shape, collector, heap, seed, seconds);
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import com.alibaba.tenant.TenantConfiguration;
+import com.alibaba.tenant.TenantContainer;
+import com.alibaba.tenant.TenantException;
+
+/**
+ * The "tenants" shape of GCBenchWorkload: every tenant container mutates a
+ * tree allocated in its own isolated heap. Kept in its own class so that the
+ * other shapes run on VMs without the tenant API enabled.
+ */
+public class GCBenchTenants implements GCBenchWorkload.Shape {
+    final TenantContainer[] tenants;
+    final GCBenchWorkload.DeepTree[] trees;
+    int next;
+
+    GCBenchTenants(int count, long heap, int depth) throws TenantException {
+        tenants = new TenantContainer[count];
+        trees = new GCBenchWorkload.DeepTree[count];
+        TenantConfiguration config = new TenantConfiguration().limitHeap(heap);
+        for (int i = 0; i < count; i++) {
+            final int idx = i;
+            tenants[i] = TenantContainer.create(config);
+            tenants[i].run(() -> {
+                trees[idx] = new GCBenchWorkload.DeepTree(depth, 6);
+            });
+        }
+    }
+
+    static GCBenchWorkload.Shape create(int count, long heap, int depth) throws TenantException {
+        return new GCBenchTenants(count, heap, depth);
+    }
+
+    public void step() {
+        final int idx = next;
+        next = (next + 1) % tenants.length;
+        try {
+            tenants[idx].run(() -> {
+                for (int i = 0; i < 16; i++) {
+                    trees[idx].step();
+                    GCBenchWorkload.sink = new byte[64];
+                }
+            });
+        } catch (TenantException e) {
+            throw new RuntimeException(e);
+        }
+    }
+
+    public void finish() {
+        for (TenantContainer t : tenants) {
+            t.destroy();
+        }
+    }
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.lang.management.ManagementFactory;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.Random;
+
+/**
+ * Heap shapes for GCBench. Usage:
+ *
+ *   java GCBenchWorkload <shape> <warmup-seconds> <seconds> <seed> [key=value ...]
+ *
+ * Each shape builds a live set, then mutates it for the given time while
+ * allocating short-lived garbage at a steady rate. The same seed gives
+ * the same sequence of mutations. After the warmup, the VM uptime is
+ * printed as "gcbench: measure-start <seconds>" so that only pauses after
+ * it are counted.
+ *
+ * Shapes and their parameters (defaults in parentheses):
+ *   deep-tree     depth (20): a binary tree; random subtrees of depth
+ *                 subtree (8) are rebuilt
+ *   large-arrays  arrays (16) of length (1048576) references; random
+ *                 slots get new objects
+ *   rset-fanin    sources (1048576) old objects pointing at targets (4096)
+ *                 objects that are replaced, so that few young regions are
+ *                 referenced from all over the old generation
+ *   humongous     retained (32) byte arrays of size (4194304) bytes that
+ *                 are replaced at random
+ *   tenants       tenants (8) tenant containers of tenantHeap (67108864)
+ *                 bytes, each mutating its own deep-tree of depth (16)
+ *   all shapes    garbage (64) bytes per short-lived object
+ */
+public class GCBenchWorkload {
+    static final String MEASURE_START = "gcbench: measure-start ";
+
+    static Map<String, String> params = new HashMap<>();
+    static Random random;
+    static volatile Object sink;
+
+    static int param(String key, int def) {
+        String v = params.get(key);
+        return v == null ? def : Integer.parseInt(v);
+    }
+
+    static double parseMeasureStart(String output) {
+        int at = output.indexOf(MEASURE_START);
+        if (at < 0) {
+            throw new RuntimeException("No measurement start in workload output:\n" + output);
+        }
+        int end = output.indexOf('\n', at);
+        return Double.parseDouble(output.substring(at + MEASURE_START.length(), end).trim());
+    }
+
+    public static void main(String[] args) throws Exception {
+        String shape = args[0];
+        int warmup = Integer.parseInt(args[1]);
+        int seconds = Integer.parseInt(args[2]);
+        random = new Random(Long.parseLong(args[3]));
+        for (int i = 4; i < args.length; i++) {
+            int eq = args[i].indexOf('=');
+            params.put(args[i].substring(0, eq), args[i].substring(eq + 1));
+        }
+
+        Shape s;
+        switch (shape) {
+            case "deep-tree":    s = new DeepTree(param("depth", 20), param("subtree", 8)); break;
+            case "large-arrays": s = new LargeArrays(param("arrays", 16), param("length", 1 << 20)); break;
+            case "rset-fanin":   s = new RSetFanIn(param("sources", 1 << 20), param("targets", 4096)); break;
+            case "humongous":    s = new Humongous(param("retained", 32), param("size", 4 << 20)); break;
+            case "tenants":      s = GCBenchTenants.create(param("tenants", 8), param("tenantHeap", 64 << 20),
+                                                           param("depth", 16)); break;
+            default: throw new IllegalArgumentException("Unknown shape: " + shape);
+        }
+
+        int garbage = param("garbage", 64);
+        long now = System.nanoTime();
+        long measure = now + warmup * 1000000000L;
+        long end = measure + seconds * 1000000000L;
+        boolean measuring = false;
+        while (now < end) {
+            for (int i = 0; i < 1000; i++) {
+                s.step();
+                sink = new byte[garbage];
+            }
+            now = System.nanoTime();
+            if (!measuring && now >= measure) {
+                measuring = true;
+                double uptime = ManagementFactory.getRuntimeMXBean().getUptime() / 1000.0;
+                System.out.println(MEASURE_START + uptime);
+            }
+        }
+        if (!measuring) {
+            System.out.println(MEASURE_START + ManagementFactory.getRuntimeMXBean().getUptime() / 1000.0);
+        }
+        s.finish();
+    }
+
+    interface Shape {
+        void step();
+        void finish();
+    }
+
+    static class Node {
+        Node left, right;
+        int value;
+    }
+
+    static Node buildTree(int depth) {
+        Node n = new Node();
+        if (depth > 1) {
+            n.left = buildTree(depth - 1);
+            n.right = buildTree(depth - 1);
+        }
+        return n;
+    }
+
+    static class DeepTree implements Shape {
+        final Node root;
+        final int depth;
+        final int subtree;
+
+        DeepTree(int depth, int subtree) {
+            this.depth = depth;
+            this.subtree = Math.min(subtree, depth - 1);
+            root = buildTree(depth);
+        }
+
+        public void step() {
+            // Walk down to a random node whose children are subtrees of
+            // the given depth, and replace one of them.
+            Node n = root;
+            for (int d = depth; d > subtree + 1; d--) {
+                n = random.nextBoolean() ? n.left : n.right;
+            }
+            if (random.nextBoolean()) {
+                n.left = buildTree(subtree);
+            } else {
+                n.right = buildTree(subtree);
+            }
+        }
+
+        public void finish() { }
+    }
+
+    static class LargeArrays implements Shape {
+        final Object[][] arrays;
+
+        LargeArrays(int count, int length) {
+            arrays = new Object[count][];
+            for (int i = 0; i < count; i++) {
+                arrays[i] = new Object[length];
+                for (int j = 0; j < length; j += 16) {
+                    arrays[i][j] = new Node();
+                }
+            }
+        }
+
+        public void step() {
+            Object[] a = arrays[random.nextInt(arrays.length)];
+            a[random.nextInt(a.length)] = new Node();
+        }
+
+        public void finish() { }
+    }
+
+    static class RSetFanIn implements Shape {
+        final Node[] sources;
+        final Node[] targets;
+
+        RSetFanIn(int sourceCount, int targetCount) {
+            targets = new Node[targetCount];
+            for (int i = 0; i < targetCount; i++) {
+                targets[i] = new Node();
+            }
+            sources = new Node[sourceCount];
+            for (int i = 0; i < sourceCount; i++) {
+                sources[i] = new Node();
+                sources[i].left = targets[random.nextInt(targetCount)];
+            }
+        }
+
+        public void step() {
+            // A new young target, referenced from many old sources.
+            int t = random.nextInt(targets.length);
+            Node target = new Node();
+            targets[t] = target;
+            for (int i = 0; i < 16; i++) {
+                sources[random.nextInt(sources.length)].left = target;
+            }
+        }
+
+        public void finish() { }
+    }
+
+    static class Humongous implements Shape {
+        final byte[][] retained;
+        final int size;
+        int steps;
+
+        Humongous(int count, int size) {
+            this.size = size;
+            retained = new byte[count][];
+            for (int i = 0; i < count; i++) {
+                retained[i] = new byte[size];
+            }
+        }
+
+        public void step() {
+            // One large array per 100 steps keeps the small objects the
+            // dominant allocation, like a real application.
+            if (++steps % 100 == 0) {
+                retained[random.nextInt(retained.length)] = new byte[size];
+            }
+        }
+
+        public void finish() { }
+    }
+}
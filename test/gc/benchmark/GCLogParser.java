@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileReader;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InputStreamReader;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * Collects pause times and G1 phase times from a -Xloggc file written with
+ * PrintGCDetails and PrintGCTimeStamps.
+ */
+public class GCLogParser {
+    static final String[] KINDS = { "young", "mixed", "initial-mark", "remark", "cleanup", "full" };
+
+    // "12.345: [GC pause (G1 Evacuation Pause) (young), 0.0123 secs]"
+    static final Pattern PAUSE_START = Pattern.compile("^(\\d+\\.\\d+): \\[(Full GC|GC)");
+    static final Pattern PAUSE_SECS = Pattern.compile(", (\\d+\\.\\d+) secs\\]");
+    // "      [Object Copy (ms): Min: 1.0, Avg: 1.2, ..." or "   [Clear CT: 0.2 ms]"
+    static final Pattern PHASE = Pattern.compile("^\\s+\\[([^:\\[\\]]+): (?:Min: [-0-9.]+, Avg: )?([-0-9.]+)(?: ms)?[,\\]]");
+
+    final double measureStart;
+    final Map<String, List<Double>> pauses = new LinkedHashMap<>();
+    final Map<String, Map<String, double[]>> phases = new LinkedHashMap<>();  // sum, count
+
+    GCLogParser(double measureStart) {
+        this.measureStart = measureStart;
+        for (String kind : KINDS) {
+            pauses.put(kind, new ArrayList<Double>());
+            phases.put(kind, new LinkedHashMap<String, double[]>());
+        }
+    }
+
+    static String readFully(InputStream in) throws IOException {
+        StringBuilder sb = new StringBuilder();
+        BufferedReader r = new BufferedReader(new InputStreamReader(in));
+        for (String line = r.readLine(); line != null; line = r.readLine()) {
+            sb.append(line).append('\n');
+        }
+        return sb.toString();
+    }
+
+    static String kindOf(String line) {
+        if (line.contains("[Full GC")) {
+            return "full";
+        } else if (line.contains("(mixed)")) {
+            return "mixed";
+        } else if (line.contains("(initial-mark)") || line.contains("CMS Initial Mark")) {
+            return "initial-mark";
+        } else if (line.contains("[GC remark") || line.contains("CMS Final Remark")) {
+            return "remark";
+        } else if (line.contains("[GC cleanup")) {
+            return "cleanup";
+        } else {
+            return "young";
+        }
+    }
+
+    void parse(File log) throws IOException {
+        BufferedReader r = new BufferedReader(new FileReader(log));
+        try {
+            String kind = null;    // kind of the pause whose phase lines follow
+            for (String line = r.readLine(); line != null; line = r.readLine()) {
+                Matcher m = PAUSE_START.matcher(line);
+                if (m.find()) {
+                    kind = null;
+                    double time = Double.parseDouble(m.group(1));
+                    Matcher secs = PAUSE_SECS.matcher(line);
+                    double duration = -1;
+                    while (secs.find()) {
+                        duration = Double.parseDouble(secs.group(1));
+                    }
+                    if (duration < 0 || time < measureStart || line.contains("concurrent")) {
+                        continue;
+                    }
+                    kind = kindOf(line);
+                    pauses.get(kind).add(duration * 1000.0);
+                    continue;
+                }
+                if (kind == null) {
+                    continue;
+                }
+                Matcher p = PHASE.matcher(line);
+                if (p.find()) {
+                    String name = p.group(1).trim();
+                    double[] acc = phases.get(kind).get(name);
+                    if (acc == null) {
+                        acc = new double[2];
+                        phases.get(kind).put(name, acc);
+                    }
+                    acc[0] += Double.parseDouble(p.group(2));
+                    acc[1]++;
+                }
+            }
+        } finally {
+            r.close();
+        }
+    }
+
+    static double percentile(List<Double> sorted, double pct) {
+        int idx = (int)Math.ceil(pct / 100.0 * sorted.size()) - 1;
+        return sorted.get(Math.max(0, Math.min(idx, sorted.size() - 1)));
+    }
+
+    static String num(double v) {
+        return String.format("%.3f", v);
+    }
+
+    static String quote(String s) {
+        return "\"" + s.replace("\\", "\\\\").replace("\"", "\\\"") + "\"";
+    }
+
+    String toJson(String shape, String collector, String heap, long seed, int seconds) {
+        StringBuilder sb = new StringBuilder();
+        sb.append("{\"shape\":").append(quote(shape));
+        sb.append(",\"collector\":").append(quote(collector));
+        sb.append(",\"heap\":").append(quote(heap));
+        sb.append(",\"seed\":").append(seed);
+        sb.append(",\"seconds\":").append(seconds);
+        sb.append(",\"pauses\":{");
+        boolean first = true;
+        for (Map.Entry<String, List<Double>> e : pauses.entrySet()) {
+            List<Double> times = e.getValue();
+            if (times.isEmpty()) {
+                continue;
+            }
+            Collections.sort(times);
+            double total = 0;
+            for (double t : times) {
+                total += t;
+            }
+            sb.append(first ? "" : ",").append(quote(e.getKey())).append(":{");
+            sb.append("\"count\":").append(times.size());
+            sb.append(",\"total_ms\":").append(num(total));
+            sb.append(",\"mean_ms\":").append(num(total / times.size()));
+            sb.append(",\"p50_ms\":").append(num(percentile(times, 50)));
+            sb.append(",\"p90_ms\":").append(num(percentile(times, 90)));
+            sb.append(",\"p99_ms\":").append(num(percentile(times, 99)));
+            sb.append(",\"max_ms\":").append(num(times.get(times.size() - 1)));
+            sb.append("}");
+            first = false;
+        }
+        sb.append("},\"phases_avg\":{");
+        first = true;
+        for (Map.Entry<String, Map<String, double[]>> e : phases.entrySet()) {
+            if (e.getValue().isEmpty()) {
+                continue;
+            }
+            sb.append(first ? "" : ",").append(quote(e.getKey())).append(":{");
+            boolean firstPhase = true;
+            for (Map.Entry<String, double[]> ph : e.getValue().entrySet()) {
+                double[] acc = ph.getValue();
+                sb.append(firstPhase ? "" : ",").append(quote(ph.getKey())).append(":").append(num(acc[0] / acc[1]));
+                firstPhase = false;
+            }
+            sb.append("}");
+            first = false;
+        }
+        sb.append("}}");
+        return sb.toString();
+    }
+}
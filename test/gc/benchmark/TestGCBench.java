@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestGCBench.java
+ * @summary Smoke test of the GC pause benchmark harness
+ * @build GCBench GCBenchWorkload GCBenchTenants GCLogParser
+ * @run main/othervm/timeout=600 TestGCBench
+ */
+
+import java.io.File;
+import java.io.FileWriter;
+import java.nio.file.Files;
+import java.util.List;
+
+public class TestGCBench {
+    public static void main(String[] args) throws Exception {
+        testParser();
+
+        File out = new File("gcbench-results.json");
+        GCBench.main(new String[] {
+            "-shapes=deep-tree,rset-fanin", "-collectors=G1,Parallel",
+            "-seconds=3", "-warmup=1", "-heap=256m",
+            "-out=" + out.getPath(), "depth=16", "sources=65536"
+        });
+        List<String> lines = Files.readAllLines(out.toPath());
+        if (lines.size() != 4) {
+            throw new RuntimeException("Expected 4 results, got " + lines);
+        }
+        for (String line : lines) {
+            if (!line.contains("\"young\":{\"count\":") || !line.contains("\"p99_ms\":")) {
+                throw new RuntimeException("No young pause percentiles in " + line);
+            }
+            if (line.contains("\"collector\":\"G1\"") && !line.contains("\"Object Copy (ms)\":")) {
+                throw new RuntimeException("No G1 phase times in " + line);
+            }
+        }
+    }
+
+    static void testParser() throws Exception {
+        File log = new File("gcbench-parser.log");
+        FileWriter w = new FileWriter(log);
+        w.write("0.500: [GC pause (G1 Evacuation Pause) (young), 0.0100000 secs]\n" +
+                "   [Parallel Time: 8.0 ms, GC Workers: 2]\n" +
+                "1.000: [GC pause (G1 Evacuation Pause) (young), 0.0020000 secs]\n" +
+                "   [Parallel Time: 1.5 ms, GC Workers: 2]\n" +
+                "      [Object Copy (ms): Min: 1.0, Avg: 1.2, Max: 1.4, Diff: 0.4, Sum: 2.4]\n" +
+                "      [Processed Buffers: Min: 1, Avg: 2.0, Max: 3, Diff: 2, Sum: 4]\n" +
+                "   [Clear CT: 0.1 ms]\n" +
+                "   [Eden: 24.0M(24.0M)->0.0B(24.0M) Survivors: 0.0B->4096.0K Heap: 24.0M(256.0M)->4.0M(256.0M)]\n" +
+                "1.100: [GC concurrent-mark-end, 0.0300000 secs]\n" +
+                "1.200: [GC pause (G1 Evacuation Pause) (mixed), 0.0040000 secs]\n" +
+                "1.300: [GC remark 1.300: [Finalize Marking, 0.0001000 secs], 0.0030000 secs]\n" +
+                "1.400: [Full GC (System.gc())  10M->1M(256M), 0.0500000 secs]\n");
+        w.close();
+
+        GCLogParser parser = new GCLogParser(0.9);
+        parser.parse(log);
+        check(parser.pauses.get("young").size() == 1, "young pauses before the start are ignored");
+        check(parser.pauses.get("young").get(0) == 2.0, "young pause time");
+        check(parser.pauses.get("mixed").size() == 1, "mixed pause");
+        check(parser.pauses.get("remark").get(0) == 3.0, "remark uses the outer time");
+        check(parser.pauses.get("full").get(0) == 50.0, "full pause");
+        check(parser.phases.get("young").get("Parallel Time")[0] == 1.5, "phase value");
+        check(parser.phases.get("young").get("Object Copy (ms)")[0] == 1.2, "summary phase average");
+        check(parser.phases.get("young").get("Processed Buffers")[0] == 2.0, "count average");
+        check(!parser.phases.get("young").containsKey("Eden"), "heap transition is not a phase");
+    }
+
+    static void check(boolean ok, String what) {
+        if (!ok) {
+            throw new RuntimeException("Parser check failed: " + what);
+        }
+    }
+}
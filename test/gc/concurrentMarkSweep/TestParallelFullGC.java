@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary CMSParallelFullGC: a fragmented CMS generation is compacted by the
+ *          parallel GC threads and every live object survives intact
+ * @key gc
+ * @run main/othervm -Xmx256m -Xmn16m -XX:+UseConcMarkSweepGC -XX:+CMSParallelFullGC
+ *      -XX:ParallelGCThreads=4 -XX:MarkSweepAlwaysCompactCount=1
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *      TestParallelFullGC
+ * @run main/othervm -Xmx256m -Xmn16m -XX:+UseConcMarkSweepGC -XX:+CMSParallelFullGC
+ *      -XX:ParallelGCThreads=4 TestParallelFullGC
+ */
+public class TestParallelFullGC {
+  static final int NODES = 400000;
+
+  static class Node {
+    final int id;
+    final Node next;
+    final byte[] payload;
+    Node(int id, Node next) {
+      this.id = id;
+      this.next = next;
+      this.payload = new byte[16 + (id % 7) * 24];
+      this.payload[0] = (byte)id;
+    }
+  }
+
+  public static void main(String[] args) {
+    // Build long lived chains, then drop every other one so that the old
+    // generation is full of holes when System.gc() compacts it.
+    Node[] chains = new Node[64];
+    for (int i = 0; i < NODES; i++) {
+      int c = i % chains.length;
+      chains[c] = new Node(i, chains[c]);
+      if (i % 50000 == 0) {
+        System.gc();
+      }
+    }
+    for (int c = 0; c < chains.length; c += 2) {
+      chains[c] = null;
+    }
+    for (int round = 0; round < 5; round++) {
+      System.gc();
+      check(chains);
+    }
+  }
+
+  static void check(Node[] chains) {
+    for (int c = 1; c < chains.length; c += 2) {
+      int expected = -1;
+      for (Node n = chains[c]; n != null; n = n.next) {
+        if (n.id % chains.length != c || (expected >= 0 && n.id != expected)) {
+          throw new RuntimeException("broken chain " + c + " at node " + n.id);
+        }
+        if (n.payload[0] != (byte)n.id || n.payload.length != 16 + (n.id % 7) * 24) {
+          throw new RuntimeException("bad payload in node " + n.id);
+        }
+        expected = n.id - chains.length;
+      }
+      if (expected != c - chains.length) {
+        throw new RuntimeException("chain " + c + " is incomplete");
+      }
+    }
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary CMSRemarkYoungDirtyCardsOnly: old objects that are only reachable
+ *          through young objects modified during concurrent marking survive
+ * @key gc
+ * @run main/othervm -Xmx256m -Xmn128m -XX:+UseConcMarkSweepGC
+ *      -XX:+ExplicitGCInvokesConcurrent -XX:+CMSRemarkYoungDirtyCardsOnly
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyDuringGC
+ *      TestRemarkYoungDirtyCardsOnly
+ */
+public class TestRemarkYoungDirtyCardsOnly {
+  static final int HOLDERS = 1000;
+
+  static class Holder {
+    Object ref;
+  }
+
+  public static void main(String[] args) throws Exception {
+    // Old objects, promoted by the initial full collections.
+    Object[] old = new Object[HOLDERS];
+    for (int i = 0; i < HOLDERS; i++) {
+      old[i] = new int[] { i };
+    }
+    Holder[] holders = new Holder[HOLDERS];
+    for (int round = 0; round < 20; round++) {
+      // Young holders allocated before the cycle starts.
+      for (int i = 0; i < HOLDERS; i++) {
+        holders[i] = new Holder();
+      }
+      Thread gc = new Thread() {
+        public void run() {
+          System.gc();
+        }
+      };
+      gc.start();
+      // Move the only references to the old objects into the young holders
+      // while the collection runs.
+      for (int i = 0; i < HOLDERS; i++) {
+        holders[i].ref = old[i];
+        old[i] = null;
+      }
+      gc.join();
+      for (int i = 0; i < HOLDERS; i++) {
+        int[] value = (int[])holders[i].ref;
+        if (value[0] != i) {
+          throw new RuntimeException("lost object " + i);
+        }
+        old[i] = value;
+      }
+      System.gc();
+    }
+  }
+}
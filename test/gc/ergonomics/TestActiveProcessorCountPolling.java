@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestActiveProcessorCountPolling
+ * @summary With ActiveProcessorCountPollInterval the active GC workers
+ *          follow the polled processor count, not the thread pool size
+ * @requires vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ */
+
+import com.oracle.java.testlibrary.ProcessTools;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+
+public class TestActiveProcessorCountPolling {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:ActiveProcessorCountPollInterval=50",
+        "-XX:+PrintFlagsFinal",
+        "-version");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    output.shouldMatch("UseDynamicNumberOfGCThreads\\s+:?= true");
+    output.shouldMatch("UseDynamicNumberOfCompilerThreads\\s+:?= true");
+
+    // Eight parallel workers are created, but two processors only
+    // allow two of them to run.
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:ActiveProcessorCountPollInterval=50",
+        "-XX:ActiveProcessorCount=2",
+        "-XX:+UseG1GC",
+        "-XX:ParallelGCThreads=8",
+        "-Xmx32m",
+        "-XX:+PrintGCDetails",
+        GCTest.class.getName());
+    output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    output.shouldContain("GC Workers: 2]");
+    output.shouldNotContain("GC Workers: 8]");
+  }
+
+  static class GCTest {
+    private static byte[] garbage;
+    public static void main(String [] args) {
+      // create 128MB of garbage. This should result in at least one GC
+      for (int i = 0; i < 1024; i++) {
+        garbage = new byte[128 * 1024];
+      }
+    }
+  }
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestEagerReclaimHumongousObjArrays
+ * @summary Humongous object arrays that hold references are eagerly reclaimed
+ * at young GCs with -XX:+G1EagerReclaimHumongousObjArrays, so filling up the
+ * heap with them does not lead to Full GCs.
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestEagerReclaimHumongousObjArrays
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.Asserts;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+class ReclaimObjArrays {
+    public static final int M = 1024 * 1024;
+
+    public static LinkedList<Object> garbageList = new LinkedList<Object>();
+
+    public static void genGarbage() {
+        for (int i = 0; i < 32 * 1024; i++) {
+            garbageList.add(new int[100]);
+        }
+        garbageList.clear();
+    }
+
+    // A large object array referenced by a static must stay intact.
+    static Object[] filler = new Object[2 * M];
+
+    public static void main(String[] args) {
+        for (int i = 0; i < filler.length; i += 1024) {
+            filler[i] = new Integer(i);
+        }
+
+        Object[] large = null;
+        for (int i = 0; i < 100; i++) {
+            // A large object array with a few references that will be
+            // reclaimed eagerly.
+            large = new Object[4 * M];
+            for (int j = 0; j < large.length; j += 256 * 1024) {
+                large[j] = new int[16];
+            }
+            genGarbage();
+            System.out.println(large.length);
+        }
+
+        for (int i = 0; i < filler.length; i += 1024) {
+            if (((Integer)filler[i]).intValue() != i) {
+                throw new RuntimeException("Live object array corrupted at " + i);
+            }
+        }
+    }
+}
+
+public class TestEagerReclaimHumongousObjArrays {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xms128M",
+            "-Xmx128M",
+            "-Xmn16M",
+            "-XX:+G1EagerReclaimHumongousObjArrays",
+            "-XX:+PrintGC",
+            ReclaimObjArrays.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        Pattern p = Pattern.compile("Full GC");
+        int found = 0;
+        Matcher m = p.matcher(output.getStdout());
+        while (m.find()) { found++; }
+        System.out.println("Issued " + found + " Full GCs");
+        Asserts.assertLT(found, 10, "Found that " + found + " Full GCs were issued. " +
+                         "Eager reclaim of humongous object arrays seems to not work");
+    }
+}
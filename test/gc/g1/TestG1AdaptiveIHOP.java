@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1AdaptiveIHOP
+ * @summary With -XX:+G1UseAdaptiveIHOP the concurrent cycle start threshold
+ * is derived from the predicted old generation growth and marking duration
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1AdaptiveIHOP
+ */
+
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1AdaptiveIHOP {
+
+    public static class Allocate {
+        public static void main(String[] args) throws Exception {
+            LinkedList<byte[]> live = new LinkedList<byte[]>();
+            long end = System.currentTimeMillis() + 10000;
+            while (System.currentTimeMillis() < end) {
+                // Keep a sliding window of objects so that old regions
+                // keep filling up and concurrent cycles get started.
+                live.add(new byte[1024]);
+                if (live.size() > 40 * 1024) {
+                    live.removeFirst();
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx128m",
+            "-Xmn8m",
+            "-XX:+G1UseAdaptiveIHOP",
+            "-XX:+PrintAdaptiveSizePolicy",
+            Allocate.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("update adaptive IHOP threshold");
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-XX:+G1UseAdaptiveIHOP",
+            "-XX:+G1ElasticHeap",
+            "-Xms128m",
+            "-Xmx128m",
+            "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("G1UseAdaptiveIHOP cannot be used with G1ElasticHeap");
+        output.shouldNotHaveExitValue(0);
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1CardSummary
+ * @summary Old-to-young references stay intact when young remembered set
+ * scanning skips blocks without refined cards (-XX:+G1UseCardSummary)
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1CardSummary
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1CardSummary {
+
+    public static class OldToYoung {
+        static Object[] old = new Object[256 * 1024];
+
+        public static void main(String[] args) throws Exception {
+            // Promote the array into the old generation.
+            for (int i = 0; i < 3; i++) {
+                System.gc();
+            }
+            for (int round = 0; round < 50; round++) {
+                // Only touch a few parts of the array so that most of its
+                // cards stay clean between the young GCs.
+                for (int i = round % 16; i < old.length; i += 4096) {
+                    old[i] = new Integer(i + round);
+                }
+                byte[][] garbage = new byte[1024][];
+                for (int i = 0; i < 64 * 1024; i++) {
+                    garbage[i % garbage.length] = new byte[128];
+                }
+                for (int i = round % 16; i < old.length; i += 4096) {
+                    if (((Integer) old[i]).intValue() != i + round) {
+                        throw new RuntimeException("Lost reference at index " + i);
+                    }
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx64m",
+            "-Xmn8m",
+            "-XX:G1RSetRegionEntries=1",
+            "-XX:+G1UseCardSummary",
+            "-XX:G1CardSummaryBlockSize=512",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            OldToYoung.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-XX:+G1UseCardSummary",
+            "-XX:G1CardSummaryBlockSize=1000",
+            "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("G1CardSummaryBlockSize (1000) must be a power of 2");
+        output.shouldNotHaveExitValue(0);
+    }
+}
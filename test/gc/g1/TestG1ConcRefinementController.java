@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestG1ConcRefinementController
+ * @summary The update RS time controller sizes the refinement zones and the
+ *          CPU bound limits the running refinement threads
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1ConcRefinementController
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1ConcRefinementController {
+
+    public static class StoreOldToYoung {
+        public static void main(String[] args) {
+            // Promote the holders, then keep storing young objects into them
+            Object[][] holders = new Object[200000][];
+            for (int i = 0; i < holders.length; i++) {
+                holders[i] = new Object[1];
+            }
+            System.gc();
+            for (int round = 0; round < 50; round++) {
+                for (int i = 0; i < holders.length; i++) {
+                    holders[i][0] = new byte[64];
+                }
+            }
+            for (int i = 0; i < holders.length; i++) {
+                if (((byte[])holders[i][0]).length != 64) {
+                    throw new RuntimeException("lost reference at " + i);
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-Xmx128m", "-Xmn16m",
+            "-XX:G1ConcRefinementThreads=8",
+            "-XX:+G1ConcRefinementTargetUpdateRSTime",
+            "-XX:G1ConcRefinementMaxCPUPercent=1",
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+G1TraceConcRefinement",
+            StoreOldToYoung.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        // One percent of the processors leaves a single refinement thread
+        output.shouldContain("G1-Refine-max-active-workers 0 -> 1");
+        output.shouldContain("G1-Refine-green-zone");
+        output.shouldNotContain("G1-Refine-activated worker");
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-XX:G1ConcRefinementMaxCPUPercent=0", "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("G1ConcRefinementMaxCPUPercent of 0 is invalid");
+        output.shouldNotHaveExitValue(0);
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1DeduplicateUpdateBuffers
+ * @summary Removing repeated cards from update buffers keeps the
+ * remembered sets complete
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1DeduplicateUpdateBuffers
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1DeduplicateUpdateBuffers {
+
+    public static class Graph {
+        static final int NODES = 200000;
+
+        static class Node {
+            Node left;
+            Node right;
+            int value;
+        }
+
+        public static void main(String[] args) throws Exception {
+            Node[] nodes = new Node[NODES];
+            for (int i = 0; i < NODES; i++) {
+                nodes[i] = new Node();
+                nodes[i].value = i;
+            }
+            // Let the nodes get promoted, then keep relinking them to fresh
+            // nodes so that the same old cards are dirtied over and over.
+            System.gc();
+            for (int round = 0; round < 50; round++) {
+                for (int i = 0; i < NODES; i++) {
+                    Node n = new Node();
+                    n.value = i;
+                    nodes[i].left = n;
+                    nodes[(i * 7) % NODES].right = n;
+                }
+            }
+            System.gc();
+            for (int i = 0; i < NODES; i++) {
+                if (nodes[i].left.value != i) {
+                    throw new RuntimeException("Lost node " + i);
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx128m",
+            "-Xmn16m",
+            "-XX:+G1DeduplicateUpdateBuffers",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            "-XX:+G1VerifyRSetsDuringFullGC",
+            Graph.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+    }
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1EvacuationFailureALot
+ * @summary Objects that fail evacuation in parallel keep their contents
+ * and preserved mark words
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1EvacuationFailureALot
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.Platform;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1EvacuationFailureALot {
+
+    public static class Node {
+        final int value;
+        final Node next;
+
+        Node(int value, Node next) {
+            this.value = value;
+            this.next = next;
+        }
+    }
+
+    public static class Allocate {
+        public static void main(String[] args) throws Exception {
+            final int length = 64 * 1024;
+            Node head = null;
+            for (int i = 0; i < length; i++) {
+                head = new Node(i, head);
+            }
+            // Hashed objects need their mark words preserved when they
+            // fail evacuation and get self-forwarded.
+            int[] hashes = new int[length];
+            Node n = head;
+            for (int i = 0; i < length; i++, n = n.next) {
+                hashes[i] = System.identityHashCode(n);
+            }
+            for (int gc = 0; gc < 20; gc++) {
+                for (int i = 0; i < 4096; i++) {
+                    byte[] garbage = new byte[256];
+                }
+                System.gc();
+            }
+            n = head;
+            for (int i = 0; i < length; i++, n = n.next) {
+                if (n.value != length - 1 - i) {
+                    throw new RuntimeException("Corrupted node " + i);
+                }
+                if (System.identityHashCode(n) != hashes[i]) {
+                    throw new RuntimeException("Lost hash code of node " + i);
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (!Platform.isDebugBuild()) {
+            System.out.println("G1EvacuationFailureALot requires a debug build, skipping");
+            return;
+        }
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx128m",
+            "-Xmn16m",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+ExplicitGCInvokesConcurrent",
+            "-XX:+G1EvacuationFailureALot",
+            "-XX:G1EvacuationFailureALotInterval=1",
+            "-XX:G1EvacuationFailureALotCount=100",
+            "-XX:+PrintGCDetails",
+            Allocate.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("(to-space exhausted)");
+    }
+}
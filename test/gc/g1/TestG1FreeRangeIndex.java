@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestG1FreeRangeIndex
+ * @summary Humongous allocations of varying sizes in a fragmented heap find
+ *          their regions through the free range index, with and without
+ *          heap expansion
+ * @key gc
+ * @run main/othervm -XX:+UseG1GC -XX:+UseG1FreeRangeIndex -XX:G1HeapRegionSize=1m
+ *      -Xms32m -Xmx256m -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC
+ *      -XX:+VerifyAfterGC TestG1FreeRangeIndex
+ * @run main/othervm -XX:+UseG1GC -XX:+UseG1FreeRangeIndex -XX:G1HeapRegionSize=1m
+ *      -Xms256m -Xmx256m TestG1FreeRangeIndex
+ * @run main/othervm -XX:+UseG1GC -XX:-UseG1FreeRangeIndex -XX:G1HeapRegionSize=1m
+ *      -Xms32m -Xmx256m TestG1FreeRangeIndex
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+public class TestG1FreeRangeIndex {
+    static final int MB = 1024 * 1024;
+
+    public static void main(String[] args) {
+        Random random = new Random(42);
+        List<byte[]> live = new ArrayList<>();
+        long retained = 0;
+        for (int i = 0; i < 4000; i++) {
+            // Between half a region and six regions
+            int size = MB / 2 + random.nextInt(6 * MB);
+            byte[] array = new byte[size];
+            array[0] = (byte)i;
+            array[size - 1] = (byte)i;
+            live.add(array);
+            retained += size;
+            // Drop random arrays to leave holes of free regions
+            while (retained > 96 * MB) {
+                byte[] dropped = live.remove(random.nextInt(live.size()));
+                retained -= dropped.length;
+            }
+        }
+        for (byte[] array : live) {
+            if (array[0] != array[array.length - 1]) {
+                throw new RuntimeException("humongous array corrupted");
+            }
+        }
+        System.gc();
+    }
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1MarkStackGrowth
+ * @summary The concurrent mark stack grows by segments instead of
+ * restarting concurrent marking after an overflow
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1MarkStackGrowth
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1MarkStackGrowth {
+
+    public static class WideGraph {
+        static Object[][] roots;
+
+        public static void main(String[] args) throws Exception {
+            // Many arrays of fresh objects make the marking tasks push far
+            // more grey objects than a single mark stack chunk holds.
+            roots = new Object[2048][];
+            for (int i = 0; i < roots.length; i++) {
+                roots[i] = new Object[512];
+                for (int j = 0; j < roots[i].length; j++) {
+                    roots[i][j] = new Object[] { new Object() };
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                // Starts a concurrent cycle with -XX:+ExplicitGCInvokesConcurrent
+                System.gc();
+                Thread.sleep(1000);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx256m",
+            "-XX:MarkStackSize=1",
+            "-XX:+ExplicitGCInvokesConcurrent",
+            "-XX:+PrintGC",
+            WideGraph.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("[GC concurrent-mark-end");
+        output.shouldNotContain("[GC concurrent-mark-reset-for-overflow]");
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1MemoryPressure.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Memory pressure polling is accepted with G1 only and keeps the heap usable
+ * @library /testlibrary
+ * @run main/othervm TestG1MemoryPressure
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1MemoryPressure {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < 200000; i++) {
+                sink = new byte[1024];
+            }
+            return;
+        }
+
+        OutputAnalyzer output = run("-XX:+UseParallelGC", "-XX:G1MemoryPressurePollInterval=100");
+        output.shouldContain("G1MemoryPressurePollInterval only works with UseG1GC");
+        output.shouldHaveExitValue(1);
+
+        output = run("-XX:+UseG1GC", "-XX:+G1ElasticHeap", "-XX:G1MemoryPressurePollInterval=100");
+        output.shouldContain("G1MemoryPressurePollInterval cannot be used with G1ElasticHeap");
+        output.shouldHaveExitValue(1);
+
+        output = run("-XX:+UseG1GC", "-XX:G1MemoryPressureThreshold=0");
+        output.shouldContain("G1MemoryPressureThreshold");
+        output.shouldHaveExitValue(1);
+
+        // Outside of a container the polling finds nothing to act on.
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-Xmx64m", "-XX:G1MemoryPressurePollInterval=50",
+            "-XX:G1MemoryPressureThreshold=1", "-XX:+PrintAdaptiveSizePolicy",
+            TestG1MemoryPressure.class.getName(), "child");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+    }
+
+    static OutputAnalyzer run(String... args) throws Exception {
+        String[] vmArgs = new String[args.length + 1];
+        System.arraycopy(args, 0, vmArgs, 0, args.length);
+        vmArgs[args.length] = "-version";
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(vmArgs);
+        return new OutputAnalyzer(pb.start());
+    }
+}
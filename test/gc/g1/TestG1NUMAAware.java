@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+ */
+
+/*
+ * @test TestG1NUMAAware.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Allocation and evacuation with node-local G1 alloc regions keep objects intact
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -XX:+UseNUMA -XX:+G1NUMAAware -Xmx128m -XX:G1HeapRegionSize=1m -XX:+VerifyAfterGC TestG1NUMAAware
+ * @run main/othervm -XX:+UseG1GC -XX:+UseNUMA -XX:+G1NUMAAware -XX:+AlwaysPreTouch -Xms64m -Xmx128m -XX:G1HeapRegionSize=1m TestG1NUMAAware
+ */
+
+import java.util.ArrayList;
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestG1NUMAAware {
+    static final int THREADS = 8;
+
+    public static void main(String[] args) throws Exception {
+        final ArrayList<int[]>[] kept = new ArrayList[THREADS];
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            final int id = t;
+            kept[t] = new ArrayList<>();
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int i = 0; i < 200000; i++) {
+                        int[] a = new int[16];
+                        a[0] = id;
+                        a[15] = i;
+                        if (i % 100 == 0) {
+                            kept[id].add(a);
+                        }
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        System.gc();
+
+        for (int t = 0; t < THREADS; t++) {
+            for (int i = 0; i < kept[t].size(); i++) {
+                int[] a = kept[t].get(i);
+                Asserts.assertEquals(a[0], t, "wrong thread id");
+                Asserts.assertEquals(a[15], i * 100, "wrong index");
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1OptionalCSetIncrements.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Mixed GCs evacuating optional collection set increments keep all references intact
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -XX:+G1UseOptionalCSetIncrements -XX:MaxGCPauseMillis=2 -Xmx128m -XX:G1HeapRegionSize=1m -XX:+ExplicitGCInvokesConcurrent -XX:G1MixedGCLiveThresholdPercent=100 -XX:G1HeapWastePercent=0 -XX:G1MixedGCCountTarget=32 -XX:+VerifyAfterGC -XX:+PrintGCDetails TestG1OptionalCSetIncrements
+ */
+
+import java.util.ArrayList;
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestG1OptionalCSetIncrements {
+    static class Holder {
+        Object ref;
+        final int id;
+
+        Holder(int id) {
+            this.id = id;
+        }
+    }
+
+    static final int COUNT = 100000;
+
+    public static void main(String[] args) throws Exception {
+        // Interleave live holders with garbage so that the old regions
+        // become mixed collection candidates pointing at each other.
+        Holder[] holders = new Holder[COUNT];
+        ArrayList<byte[]> garbage = new ArrayList<>();
+        for (int i = 0; i < COUNT; i++) {
+            holders[i] = new Holder(i);
+            garbage.add(new byte[256]);
+        }
+        for (int i = 0; i < COUNT; i++) {
+            holders[i].ref = holders[(i * 31 + 17) % COUNT];
+        }
+        System.gc();
+
+        for (int cycle = 0; cycle < 5; cycle++) {
+            garbage.clear();
+            System.gc();
+            // Young GCs after the cycle start the mixed GCs.
+            for (int i = 0; i < 200000; i++) {
+                garbage.add(new byte[512]);
+                if (garbage.size() > 1000) {
+                    garbage.clear();
+                }
+            }
+            for (int i = 0; i < COUNT; i++) {
+                Holder h = (Holder) holders[i].ref;
+                Asserts.assertEquals(h.id, (i * 31 + 17) % COUNT, "wrong target");
+            }
+            for (int i = 0; i < COUNT; i += 2) {
+                garbage.add(new byte[256]);
+            }
+        }
+    }
+}
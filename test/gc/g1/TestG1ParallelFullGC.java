@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1ParallelFullGC.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Objects, identity hashes, locks and references survive parallel full GCs
+ * @run main/othervm -XX:+UseG1GC -XX:+G1ParallelFullGC -XX:ParallelGCThreads=4 -Xmx128m -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestG1ParallelFullGC
+ * @run main/othervm -XX:+UseG1GC -XX:+G1ParallelFullGC -XX:ParallelGCThreads=4 -Xmx128m -XX:+UseStringDeduplication TestG1ParallelFullGC
+ */
+
+import java.lang.ref.WeakReference;
+import java.util.ArrayList;
+
+public class TestG1ParallelFullGC {
+    static class Node {
+        final int value;
+        Node next;
+        Object[] payload;
+
+        Node(int value) {
+            this.value = value;
+            this.payload = new Object[value % 7];
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        final int count = 200000;
+        Node head = null;
+        ArrayList<Object> garbage = new ArrayList<>();
+        int[] hashes = new int[count / 1000];
+        Node[] hashed = new Node[hashes.length];
+        for (int i = count - 1; i >= 0; i--) {
+            Node n = new Node(i);
+            n.next = head;
+            head = n;
+            // interleave garbage so that compaction has to move objects
+            garbage.add(new byte[64]);
+            if (i % 1000 == 0) {
+                hashed[i / 1000] = n;
+                hashes[i / 1000] = System.identityHashCode(n);
+            }
+        }
+        Object[] large = new Object[1 << 20];
+        for (int i = 0; i < large.length; i += 4096) {
+            large[i] = new Node(i);
+        }
+        WeakReference<Object> cleared = new WeakReference<>(new Object());
+        WeakReference<Node> kept = new WeakReference<>(head);
+        garbage = null;
+
+        synchronized (hashed[1]) {
+            for (int i = 0; i < 3; i++) {
+                System.gc();
+            }
+        }
+
+        int expected = 0;
+        for (Node n = head; n != null; n = n.next) {
+            if (n.value != expected || n.payload.length != expected % 7) {
+                throw new RuntimeException("Corrupted node " + expected);
+            }
+            expected++;
+        }
+        if (expected != count) {
+            throw new RuntimeException("Lost nodes: " + expected);
+        }
+        for (int i = 0; i < hashes.length; i++) {
+            if (System.identityHashCode(hashed[i]) != hashes[i]) {
+                throw new RuntimeException("Identity hash changed for node " + i * 1000);
+            }
+        }
+        for (int i = 0; i < large.length; i++) {
+            Object o = large[i];
+            if ((i % 4096 == 0) != (o != null) || (o != null && ((Node)o).value != i)) {
+                throw new RuntimeException("Corrupted array element " + i);
+            }
+        }
+        if (cleared.get() != null) {
+            throw new RuntimeException("Weak reference to garbage not cleared");
+        }
+        if (kept.get() != head) {
+            throw new RuntimeException("Weak reference to live object cleared");
+        }
+    }
+}
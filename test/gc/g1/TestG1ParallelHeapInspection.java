@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1ParallelHeapInspection
+ * @summary The class histogram counts every instance exactly once when
+ * the heap is iterated by several workers
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1ParallelHeapInspection
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1ParallelHeapInspection {
+
+    static final int INSTANCES = 123457;
+
+    public static class Marker {
+    }
+
+    public static class Allocate {
+        static Marker[] markers;
+
+        public static void main(String[] args) throws Exception {
+            markers = new Marker[INSTANCES];
+            for (int i = 0; i < markers.length; i++) {
+                markers[i] = new Marker();
+            }
+            System.gc();
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx256m",
+            "-XX:G1HeapRegionSize=1m",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+PrintClassHistogramBeforeFullGC",
+            Allocate.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("\\s" + INSTANCES + "\\s+\\d+\\s+" +
+                           "TestG1ParallelHeapInspection\\$Marker\\s");
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1PurgeClassLoaderDataConcurrently
+ * @summary Class loader data unloaded by the remark pause are deleted in a
+ * concurrent phase with -XX:+G1PurgeClassLoaderDataConcurrently
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1PurgeClassLoaderDataConcurrently
+ */
+
+import java.io.ByteArrayOutputStream;
+import java.io.InputStream;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1PurgeClassLoaderDataConcurrently {
+
+    public static class Loaded {
+        public static int value = 42;
+    }
+
+    static class ByteLoader extends ClassLoader {
+        private final byte[] bytes;
+
+        ByteLoader(byte[] bytes) {
+            super(null);
+            this.bytes = bytes;
+        }
+
+        protected Class<?> findClass(String name) throws ClassNotFoundException {
+            if (name.equals(Loaded.class.getName())) {
+                return defineClass(name, bytes, 0, bytes.length);
+            }
+            throw new ClassNotFoundException(name);
+        }
+    }
+
+    public static class LoadAndUnload {
+        static Object keep;
+
+        static byte[] classBytes() throws Exception {
+            String resource = Loaded.class.getName().replace('.', '/') + ".class";
+            InputStream in = Loaded.class.getClassLoader().getResourceAsStream(resource);
+            ByteArrayOutputStream out = new ByteArrayOutputStream();
+            byte[] buf = new byte[4096];
+            int n;
+            while ((n = in.read(buf)) > 0) {
+                out.write(buf, 0, n);
+            }
+            in.close();
+            return out.toByteArray();
+        }
+
+        public static void main(String[] args) throws Exception {
+            byte[] bytes = classBytes();
+            for (int cycle = 0; cycle < 3; cycle++) {
+                for (int i = 0; i < 500; i++) {
+                    Class<?> c = new ByteLoader(bytes).loadClass(Loaded.class.getName());
+                    keep = c.newInstance();
+                }
+                keep = null;
+                // Starts a concurrent cycle with -XX:+ExplicitGCInvokesConcurrent
+                System.gc();
+                Thread.sleep(1000);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-XX:+ClassUnloadingWithConcurrentMark",
+            "-XX:+G1PurgeClassLoaderDataConcurrently",
+            "-XX:+ExplicitGCInvokesConcurrent",
+            "-XX:+PrintGC",
+            LoadAndUnload.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("[GC concurrent-class-unloading-end");
+        output.shouldNotContain("Full GC");
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1RebuildRemSetsConcurrently.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Mixed GCs see all references into old regions whose remembered sets were rebuilt
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -XX:+G1RebuildRemSetsConcurrently -Xmx128m -XX:G1HeapRegionSize=1m -XX:+ExplicitGCInvokesConcurrent -XX:G1MixedGCLiveThresholdPercent=100 -XX:G1HeapWastePercent=0 -XX:+VerifyAfterGC -XX:+PrintGC TestG1RebuildRemSetsConcurrently
+ */
+
+import java.util.ArrayList;
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestG1RebuildRemSetsConcurrently {
+    static class Holder {
+        Object ref;
+        final int id;
+
+        Holder(int id) {
+            this.id = id;
+        }
+    }
+
+    static final int COUNT = 100000;
+
+    public static void main(String[] args) throws Exception {
+        // Old objects first, the holders that point back at them later so
+        // that most references cross region boundaries.
+        Holder[] targets = new Holder[COUNT];
+        ArrayList<byte[]> garbage = new ArrayList<>();
+        for (int i = 0; i < COUNT; i++) {
+            targets[i] = new Holder(i);
+            garbage.add(new byte[128]);
+        }
+        Holder[] holders = new Holder[COUNT];
+        for (int i = 0; i < COUNT; i++) {
+            holders[i] = new Holder(-i);
+        }
+        System.gc();
+
+        for (int cycle = 0; cycle < 5; cycle++) {
+            // Make most of the old regions collection set candidates, then
+            // store new references into them while they are rebuilt.
+            garbage.clear();
+            for (int i = 0; i < COUNT; i++) {
+                holders[(i * 7 + cycle) % COUNT].ref = targets[i];
+            }
+            System.gc();
+            for (int i = 0; i < COUNT; i++) {
+                holders[(i * 7 + cycle) % COUNT].ref = targets[(i + cycle) % COUNT];
+                garbage.add(new byte[128]);
+                if (garbage.size() > COUNT / 2) {
+                    garbage.clear();
+                }
+            }
+            // Young GCs after the cycle start the mixed GCs.
+            for (int i = 0; i < 200000; i++) {
+                garbage.add(new byte[512]);
+                if (garbage.size() > 1000) {
+                    garbage.clear();
+                }
+            }
+            for (int i = 0; i < COUNT; i++) {
+                Holder h = (Holder) holders[(i * 7 + cycle) % COUNT].ref;
+                Asserts.assertEquals(h.id, (i + cycle) % COUNT, "wrong target");
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1RefineCardsBatched.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary Old-to-young references stored by the mutator survive batched concurrent refinement
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -XX:+G1RefineCardsBatched -Xmx64m -XX:G1ConcRefinementGreenZone=0 -XX:+VerifyAfterGC TestG1RefineCardsBatched
+ * @run main/othervm -XX:+UseG1GC -XX:+G1RefineCardsBatched -Xmx64m -XX:G1ConcRSLogCacheSize=0 TestG1RefineCardsBatched
+ */
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestG1RefineCardsBatched {
+    public static void main(String[] args) throws Exception {
+        // Promote the arrays and holders, then keep storing young objects
+        // into them so that adjacent cards get dirtied and refined.
+        Object[][] arrays = new Object[64][4096];
+        Object[][] holders = new Object[100000][];
+        for (int i = 0; i < holders.length; i++) {
+            holders[i] = new Object[1];
+        }
+        System.gc();
+
+        for (int round = 0; round < 50; round++) {
+            for (int a = 0; a < arrays.length; a++) {
+                Object[] array = arrays[a];
+                for (int i = 0; i < array.length; i++) {
+                    array[i] = Integer.valueOf(round * 31 + i);
+                }
+            }
+            for (int i = round; i < holders.length; i += 3) {
+                holders[i][0] = new int[] { round, i };
+            }
+            for (int a = 0; a < arrays.length; a++) {
+                Object[] array = arrays[a];
+                for (int i = 0; i < array.length; i++) {
+                    Asserts.assertEquals(array[i], Integer.valueOf(round * 31 + i), "wrong element");
+                }
+            }
+            for (int i = round; i < holders.length; i += 3) {
+                int[] v = (int[]) holders[i][0];
+                Asserts.assertEquals(v[0], round, "wrong round");
+                Asserts.assertEquals(v[1], i, "wrong index");
+            }
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1RegionPinning
+ * @summary JNI critical sections pin their regions instead of stalling
+ * garbage collections in the GC locker
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestG1RegionPinning
+ */
+
+import java.util.Arrays;
+import java.util.zip.CRC32;
+import java.util.zip.Deflater;
+import java.util.zip.Inflater;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1RegionPinning {
+
+    public static class Compress {
+        static volatile Object sink;
+
+        public static void main(String[] args) throws Exception {
+            Thread[] threads = new Thread[4];
+            for (int t = 0; t < threads.length; t++) {
+                final int seed = t;
+                threads[t] = new Thread() {
+                    public void run() {
+                        try {
+                            compressLoop(seed);
+                        } catch (Exception e) {
+                            throw new RuntimeException(e);
+                        }
+                    }
+                };
+                threads[t].start();
+            }
+            for (int i = 0; i < 5; i++) {
+                Thread.sleep(200);
+                System.gc();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+        }
+
+        // Deflater, Inflater and CRC32 access their arrays in JNI critical
+        // sections, while the garbage allocated here keeps young
+        // collections coming.
+        static void compressLoop(int seed) throws Exception {
+            byte[] input = new byte[64 * 1024];
+            for (int i = 0; i < input.length; i++) {
+                input[i] = (byte) ((i * 31 + seed) % 17);
+            }
+            byte[] compressed = new byte[input.length * 2];
+            byte[] output = new byte[input.length];
+            for (int round = 0; round < 500; round++) {
+                Deflater deflater = new Deflater();
+                deflater.setInput(input);
+                deflater.finish();
+                int length = deflater.deflate(compressed);
+                deflater.end();
+
+                Inflater inflater = new Inflater();
+                inflater.setInput(compressed, 0, length);
+                inflater.inflate(output);
+                inflater.end();
+                if (!Arrays.equals(input, output)) {
+                    throw new RuntimeException("Corrupted data in round " + round);
+                }
+
+                CRC32 crc = new CRC32();
+                crc.update(output);
+                for (int i = 0; i < 64; i++) {
+                    sink = new byte[4096];
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx64m",
+            "-Xmn8m",
+            "-XX:+G1UseRegionPinning",
+            "-XX:+PrintGCDetails",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            Compress.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldNotContain("GCLocker Initiated GC");
+    }
+}
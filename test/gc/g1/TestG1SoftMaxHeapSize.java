@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+ */
+
+/*
+ * @test TestG1SoftMaxHeapSize.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary An idle heap is uncommitted down to G1SoftMaxHeapSize without G1ElasticHeap
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -Xms256m -Xmx256m -XX:G1HeapRegionSize=1m -XX:G1SoftMaxHeapSize=64m -XX:G1PeriodicUncommitInterval=200 -XX:+PrintGCDetails TestG1SoftMaxHeapSize
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryUsage;
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestG1SoftMaxHeapSize {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 100000; i++) {
+            sink = new byte[1024];
+        }
+        sink = null;
+        System.gc();
+
+        // Two idle intervals without a GC are needed before the timer
+        // uncommits, so allow plenty of time.
+        long committed = 0;
+        for (int i = 0; i < 50; i++) {
+            Thread.sleep(200);
+            MemoryUsage usage = ManagementFactory.getMemoryMXBean().getHeapMemoryUsage();
+            committed = usage.getCommitted();
+            if (committed <= 128 * 1024 * 1024) {
+                break;
+            }
+        }
+        Asserts.assertLTE(committed, 128L * 1024 * 1024,
+                          "idle heap should have been uncommitted towards G1SoftMaxHeapSize");
+    }
+}
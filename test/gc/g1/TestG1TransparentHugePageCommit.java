@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestG1TransparentHugePageCommit.java
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @summary G1 commits and pre-touches the heap in transparent huge page units
+ * @library /testlibrary
+ * @run main/othervm TestG1TransparentHugePageCommit
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestG1TransparentHugePageCommit {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < 200000; i++) {
+                sink = new byte[1024];
+            }
+            System.gc();
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-Xms32m", "-Xmx128m", "-XX:G1HeapRegionSize=1m",
+            "-XX:+G1TransparentHugePageCommit", "-XX:+AlwaysPreTouch",
+            "-XX:+PrintFlagsFinal",
+            TestG1TransparentHugePageCommit.class.getName(), "child");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        if (!output.getOutput().contains("G1TransparentHugePageCommit is disabled")) {
+            // Regions must span at least one huge page.
+            output.shouldMatch("G1HeapRegionSize += ([2-9]|[1-9][0-9])[0-9]{6}");
+        }
+    }
+}
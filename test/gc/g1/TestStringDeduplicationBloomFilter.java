@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestStringDeduplicationBloomFilter
+ * @summary With StringDeduplicationBloomFilter a value seen once is not added to
+ * the deduplication table, while values seen repeatedly are still deduplicated.
+ * Also exercises the adaptive sampling of StringDeduplicationMinHitPercent.
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main TestStringDeduplicationBloomFilter
+ */
+
+import java.lang.reflect.Field;
+import java.util.ArrayList;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestStringDeduplicationBloomFilter {
+    private static final int Copies = 4;
+    private static final int UniqueStrings = 1000;
+    private static final int AgeThreshold = 3;
+
+    private static Field valueField;
+    private static byte[] dummy;
+
+    private static Object getValue(String string) throws Exception {
+        return valueField.get(string);
+    }
+
+    private static void doYoungGc(int numberOfTimes) {
+        final int objectSize = 128;
+        final int maxObjectInYoung = (50 * 1024 * 1024) / objectSize;
+        for (int i = 0; i < numberOfTimes; i++) {
+            for (int j = 0; j < maxObjectInYoung + 1; j++) {
+                dummy = new byte[objectSize];
+            }
+        }
+    }
+
+    private static int countValues(ArrayList<String> list) throws Exception {
+        ArrayList<Object> values = new ArrayList<Object>();
+        for (String string : list) {
+            Object value = getValue(string);
+            boolean found = false;
+            for (Object obj : values) {
+                if (obj == value) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                values.add(value);
+            }
+        }
+        return values.size();
+    }
+
+    public static class BloomFilterTest {
+        public static void main(String[] args) throws Exception {
+            valueField = String.class.getDeclaredField("value");
+            valueField.setAccessible(true);
+
+            ArrayList<String> list = new ArrayList<String>();
+            for (int j = 0; j < Copies; j++) {
+                for (int i = 0; i < UniqueStrings; i++) {
+                    list.add(new StringBuilder("BloomFilterTestString:" + i).toString());
+                }
+            }
+
+            // The first copy of each value only enters the Bloom filter, all
+            // later copies share the array of the second one.
+            for (;;) {
+                doYoungGc(AgeThreshold + 3);
+                int values = countValues(list);
+                System.out.println("Found " + values + " distinct values");
+                if (values <= 2 * UniqueStrings) {
+                    break;
+                }
+                Thread.sleep(1000);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xmn50m",
+            "-Xms100m",
+            "-Xmx100m",
+            "-XX:+UseG1GC",
+            "-XX:+UseStringDeduplication",
+            "-XX:StringDeduplicationAgeThreshold=" + AgeThreshold,
+            "-XX:+StringDeduplicationBloomFilter",
+            "-XX:StringDeduplicationMinHitPercent=10",
+            "-XX:+PrintStringDeduplicationStatistics",
+            BloomFilterTest.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getStdout());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Filtered:");
+        output.shouldContain("Unsampled:");
+        output.shouldContain("Bloom Filter:");
+    }
+}
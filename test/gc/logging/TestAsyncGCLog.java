@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test TestAsyncGCLog.java
+ * @summary -Xloggc output written by the asynchronous GC log writer is complete
+ * @library /testlibrary
+ * @run main/othervm TestAsyncGCLog
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestAsyncGCLog {
+    static final int GCS = 20;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < GCS; i++) {
+                System.gc();
+            }
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:AsyncGCLogBufferSize=1", "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("AsyncGCLogBufferSize of 1 is invalid");
+        output.shouldHaveExitValue(1);
+
+        File log = new File("async-gc.log");
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-Xloggc:" + log.getName(), "-XX:+AsyncGCLog", "-XX:+PrintGCDetails",
+            TestAsyncGCLog.class.getName(), "child");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        // Every collection and the heap printed at exit made it to the file.
+        String text = new String(Files.readAllBytes(log.toPath()));
+        int count = 0;
+        for (int i = text.indexOf("Full GC (System.gc())"); i >= 0;
+             i = text.indexOf("Full GC (System.gc())", i + 1)) {
+            count++;
+        }
+        if (count != GCS) {
+            throw new RuntimeException("Expected " + GCS + " full GC entries, found " + count);
+        }
+        if (!text.contains("Heap")) {
+            throw new RuntimeException("Heap printed at exit is missing");
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestGCBinaryEventLog.java
+ * @summary G1 phase times recorded as binary events are formatted like the
+ *          text output, in order, and across log rotation
+ * @library /testlibrary
+ * @run main/othervm TestGCBinaryEventLog
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestGCBinaryEventLog {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            for (int i = 0; i < 200000; i++) {
+                sink = new byte[1024];
+            }
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+GCBinaryEventLog", "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("GCBinaryEventLog has no effect without AsyncGCLog");
+        output.shouldHaveExitValue(0);
+
+        String log = "binary-event-gc.log";
+        run("-Xloggc:" + log);
+        checkPauses(read(new File(log)));
+
+        // Every file keeps whole pauses: the records buffered before a
+        // rotation are written to the file being rotated out.
+        String rotated = "binary-event-rotated-gc.log";
+        run("-Xloggc:" + rotated, "-XX:+UseGCLogFileRotation",
+            "-XX:NumberOfGCLogFiles=4", "-XX:GCLogFileSize=8K");
+        boolean found = false;
+        for (int i = 0; i < 4; i++) {
+            File f = new File(rotated + "." + i);
+            if (!f.exists()) {
+                f = new File(rotated + "." + i + ".current");
+            }
+            if (f.exists()) {
+                found = true;
+                checkPauses(read(f));
+            }
+        }
+        if (!found) {
+            throw new RuntimeException("no rotated log files");
+        }
+    }
+
+    static void run(String... logArgs) throws Exception {
+        String[] args = new String[logArgs.length + 7];
+        System.arraycopy(logArgs, 0, args, 0, logArgs.length);
+        int i = logArgs.length;
+        args[i++] = "-XX:+UseG1GC";
+        args[i++] = "-Xmx64m";
+        args[i++] = "-XX:+AsyncGCLog";
+        args[i++] = "-XX:+GCBinaryEventLog";
+        args[i++] = "-XX:+PrintGCDetails";
+        args[i++] = TestGCBinaryEventLog.class.getName();
+        args[i++] = "child";
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        new OutputAnalyzer(pb.start()).shouldHaveExitValue(0);
+    }
+
+    static String read(File f) throws Exception {
+        return new String(Files.readAllBytes(f.toPath()));
+    }
+
+    // Each young pause prints its phase times between the pause line
+    // and the heap transition, in the order of the text output.
+    static void checkPauses(String text) {
+        String[] phases = {
+            "   [Parallel Time: ",
+            "      [Object Copy (ms): Min: ",
+            "      [GC Worker Total (ms): Min: ",
+            "   [Code Root Fixup: ",
+            "   [Clear CT: ",
+            "   [Other: ",
+            "      [Choose CSet: ",
+            "      [Free CSet: ",
+            "   [Eden: "
+        };
+        int pauses = 0;
+        for (int pos = text.indexOf("[GC pause (G1 Evacuation Pause)"); pos >= 0;
+             pos = text.indexOf("[GC pause (G1 Evacuation Pause)", pos + 1)) {
+            int end = text.indexOf("[GC pause", pos + 1);
+            if (end < 0) {
+                end = text.length();
+            }
+            String pause = text.substring(pos, end);
+            if (!pause.contains("[Eden: ")) {
+                continue;   // cut off by the end of the file
+            }
+            int last = -1;
+            for (String phase : phases) {
+                int at = pause.indexOf("\n" + phase);
+                if (at <= last) {
+                    throw new RuntimeException("missing or out of order: '" + phase + "' in\n" + pause);
+                }
+                last = at;
+            }
+            pauses++;
+        }
+        if (pauses == 0) {
+            throw new RuntimeException("no young pauses in\n" + text);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Large object arrays in the young generation are scanned in
+ *          chunks claimed by several ParNew workers
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseParNewGC -XX:ParallelGCThreads=4
+ *      -Xmn64m -XX:ParGCArrayScanChunk=16 -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+VerifyAfterGC TestLargeObjArrayScan
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+UseParNewGC -XX:ParallelGCThreads=4
+ *      -Xmn64m -XX:ParGCArrayScanChunk=16 -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+VerifyAfterGC -XX:MaxTenuringThreshold=0 TestLargeObjArrayScan
+ */
+public class TestLargeObjArrayScan {
+  static final int LENGTH = 500000;
+
+  static Object[] big;
+  static Object sink;
+
+  public static void main(String[] args) {
+    for (int round = 0; round < 5; round++) {
+      big = new Object[LENGTH];
+      for (int i = 0; i < LENGTH; i++) {
+        big[i] = Integer.valueOf(i + round);
+      }
+      // Allocate garbage to force young collections while the array is live.
+      for (int i = 0; i < 200000; i++) {
+        sink = new byte[64];
+      }
+      System.gc();
+      for (int i = 0; i < LENGTH; i++) {
+        if (((Integer)big[i]).intValue() != i + round) {
+          throw new RuntimeException("element " + i + " corrupted in round " + round);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary UseGCTaskStealing: scavenges and full collections with per-worker
+ *          GC task queues keep every live object intact
+ * @key gc
+ * @run main/othervm -Xmx256m -Xmn32m -XX:+UseParallelGC -XX:+UseParallelOldGC
+ *      -XX:+UseGCTaskStealing -XX:ParallelGCThreads=8
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *      TestGCTaskStealing
+ * @run main/othervm -Xmx256m -Xmn32m -XX:+UseParallelGC -XX:+UseParallelOldGC
+ *      -XX:+UseGCTaskStealing -XX:+UseGCTaskAffinity -XX:ParallelGCThreads=8
+ *      TestGCTaskStealing
+ * @run main/othervm -Xmx256m -Xmn32m -XX:+UseParallelGC -XX:+UseParallelOldGC
+ *      -XX:+UseGCTaskStealing -XX:+UseDynamicNumberOfGCThreads
+ *      -XX:ParallelGCThreads=8 TestGCTaskStealing
+ */
+public class TestGCTaskStealing {
+  static final int LISTS = 32;
+  static final int ROUNDS = 200;
+
+  static class Node {
+    final int id;
+    final Node next;
+    final int[] payload;
+    Node(int id, Node next) {
+      this.id = id;
+      this.next = next;
+      this.payload = new int[1 + id % 13];
+      this.payload[0] = id;
+    }
+  }
+
+  public static void main(String[] args) {
+    Node[] lists = new Node[LISTS];
+    int id = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+      // Short lived garbage drives the scavenges, the lists survive them.
+      for (int i = 0; i < 20000; i++) {
+        Object garbage = new byte[64];
+        if (i % 10 == 0) {
+          int l = id % LISTS;
+          lists[l] = new Node(id++, lists[l]);
+        }
+      }
+      if (round % 50 == 49) {
+        System.gc();
+      }
+    }
+    check(lists, id);
+  }
+
+  static void check(Node[] lists, int count) {
+    int seen = 0;
+    for (int l = 0; l < LISTS; l++) {
+      int expected = -1;
+      for (Node n = lists[l]; n != null; n = n.next) {
+        if (n.id % LISTS != l || (expected >= 0 && n.id != expected)) {
+          throw new RuntimeException("broken list " + l + " at node " + n.id);
+        }
+        if (n.payload[0] != n.id || n.payload.length != 1 + n.id % 13) {
+          throw new RuntimeException("bad payload in node " + n.id);
+        }
+        expected = n.id - LISTS;
+        seen++;
+      }
+    }
+    if (seen != count) {
+      throw new RuntimeException("expected " + count + " nodes, found " + seen);
+    }
+  }
+}
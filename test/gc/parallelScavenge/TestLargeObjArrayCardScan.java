@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Old gen object arrays spanning many card stripes are scanned
+ *          piecewise by the parallel scavenge workers
+ * @key gc
+ * @run main/othervm -Xmx256m -Xmn16m -XX:+UseParallelGC -XX:ParallelGCThreads=4
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+VerifyBeforeGC -XX:+VerifyAfterGC
+ *      TestLargeObjArrayCardScan
+ * @run main/othervm -Xmx256m -Xmn16m -XX:+UseParallelGC -XX:ParallelGCThreads=4
+ *      -XX:+PSAdaptiveCardStripeSize -XX:-UseCompressedOops
+ *      TestLargeObjArrayCardScan
+ */
+public class TestLargeObjArrayCardScan {
+  static final int LENGTH = 4 * 1024 * 1024;
+
+  public static void main(String[] args) {
+    // Larger than the young gen, so allocated directly in the old gen.
+    Object[] big = new Object[LENGTH];
+    for (int round = 0; round < 10; round++) {
+      // Store young objects sparsely, leaving clean cards in between.
+      for (int i = round; i < LENGTH; i += 1000) {
+        big[i] = new Integer(i);
+      }
+      // Allocate garbage to trigger scavenges.
+      for (int i = 0; i < 100000; i++) {
+        Object garbage = new byte[256];
+      }
+      for (int i = round; i < LENGTH; i += 1000) {
+        if (((Integer)big[i]).intValue() != i) {
+          throw new RuntimeException("element " + i + " corrupted in round " + round);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary UseNUMAOldGen: objects promoted through per-node old generation
+ *          chunks survive intact and the old generation stays parsable
+ * @key gc
+ * @run main/othervm -Xmx256m -Xmn32m -XX:+UseParallelGC -XX:+UseNUMA
+ *      -XX:+UseNUMAOldGen -XX:NUMAOldGenChunkSize=1m -XX:MaxTenuringThreshold=1
+ *      -XX:ParallelGCThreads=4 -XX:+UnlockDiagnosticVMOptions
+ *      -XX:+VerifyBeforeGC -XX:+VerifyAfterGC TestNUMAOldGen
+ * @run main/othervm -Xmx256m -Xmn32m -XX:+UseParallelGC -XX:-UseParallelOldGC
+ *      -XX:+UseNUMA -XX:+UseNUMAOldGen -XX:MaxTenuringThreshold=1
+ *      TestNUMAOldGen
+ */
+public class TestNUMAOldGen {
+  static final int COUNT = 300000;
+
+  public static void main(String[] args) {
+    Object[] keep = new Object[COUNT];
+    for (int i = 0; i < COUNT; i++) {
+      int[] a = new int[1 + i % 32];
+      a[0] = i;
+      keep[i] = a;
+      // Short lived garbage drives young collections, which promote the
+      // objects kept above.
+      Object garbage = new byte[128];
+    }
+    System.gc();
+    for (int i = 0; i < COUNT; i++) {
+      int[] a = (int[])keep[i];
+      if (a.length != 1 + i % 32 || a[0] != i) {
+        throw new RuntimeException("object " + i + " corrupted");
+      }
+    }
+  }
+}
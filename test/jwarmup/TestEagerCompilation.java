@@ -154,6 +154,7 @@ public class TestEagerCompilation {
                 "-XX:+PrintCompilation",
                 "-XX:+UnlockDiagnosticVMOptions", "-XX:+WhiteBoxAPI",
                 "-XX:+CompilationWarmUpResolveClassEagerly",
+                "-XX:+CompilationWarmUpResolveCPCacheEagerly",
                 "-cp", classPath,
                 InnerA.class.getName(), "compilation");
         output = new OutputAnalyzer(pb.start());
@@ -217,6 +218,7 @@ public class TestEagerCompilation {
 
         output = testJitWarmUpJavaAPIwithEagerResolve(fileName);
         output.shouldContain("Test Eager Compilation OK");
+        output.shouldContain("constant pool cache entries resolved eagerly");
         output.shouldContain(methodName);
         output.shouldHaveExitValue(0);
 
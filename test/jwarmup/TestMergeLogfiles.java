@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import sun.hotspot.WhiteBox;
+
+import java.io.File;
+import java.util.*;
+
+import com.oracle.java.testlibrary.*;
+import static com.oracle.java.testlibrary.Asserts.*;
+/*
+ * @test TestMergeLogfiles
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestMergeLogfiles
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm TestMergeLogfiles
+ * @summary merge the jitwarmup logs of several instances into one profile
+ */
+public class TestMergeLogfiles {
+    private static String classPath = System.getProperty("test.class.path");
+
+    private static void record(String logfile) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:-TieredCompilation",
+                "-Xbootclasspath/a:.",
+                "-XX:+CompilationWarmUpRecording",
+                "-XX:-ClassUnloading",
+                "-XX:+UseConcMarkSweepGC",
+                "-XX:-CMSClassUnloadingEnabled",
+                "-XX:-UseSharedSpaces",
+                "-XX:CompilationWarmUpLogfile=./" + logfile,
+                "-XX:CompilationWarmUpRecordTime=10",
+                "-XX:CompilationWarmUpAppID=123",
+                "-XX:+PrintCompilationWarmUpDetail",
+                "-XX:+UnlockDiagnosticVMOptions", "-XX:+WhiteBoxAPI",
+                "-cp", classPath,
+                InnerA.class.getName(), "collection");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        output.shouldContain("[JitWarmUp] output profile info has done");
+        output.shouldHaveExitValue(0);
+        if (!new File("./" + logfile).exists()) {
+            throw new Error("jit log not exist");
+        }
+    }
+
+    private static OutputAnalyzer warmUp(String... extraFlags) throws Exception {
+        List<String> args = new ArrayList<String>();
+        Collections.addAll(args, "-XX:-TieredCompilation",
+                "-Xbootclasspath/a:.",
+                "-XX:-UseSharedSpaces",
+                "-XX:+CompilationWarmUp",
+                "-XX:+PrintCompilationWarmUpDetail",
+                "-XX:CompilationWarmUpAppID=123",
+                "-XX:+UnlockDiagnosticVMOptions", "-XX:+WhiteBoxAPI");
+        Collections.addAll(args, extraFlags);
+        Collections.addAll(args, "-cp", classPath, InnerA.class.getName(), "compilation");
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args.toArray(new String[0]));
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        record("jitwarmup_a.log");
+        record("jitwarmup_b.log");
+
+        OutputAnalyzer output = warmUp("-XX:CompilationWarmUpMergeLogfiles=./jitwarmup_a.log,./jitwarmup_b.log",
+                                       "-XX:CompilationWarmUpLogfile=./jitwarmup_merged.log");
+        output.shouldContain("merged 2 log files");
+        output.shouldContain("read log file OK");
+        output.shouldHaveExitValue(0);
+
+        // the merged log is a regular log file
+        output = warmUp("-XX:CompilationWarmUpLogfile=./jitwarmup_merged.log");
+        output.shouldContain("read log file OK");
+        output.shouldHaveExitValue(0);
+
+        // methods seen by both instances survive the instance filter
+        output = warmUp("-XX:CompilationWarmUpLogfile=./jitwarmup_merged.log",
+                        "-XX:CompilationWarmUpMinInstances=2");
+        output.shouldContain("read log file OK");
+        output.shouldHaveExitValue(0);
+    }
+
+    public static class InnerA {
+        public static String[] aa = new String[0];
+        public static List<String> ls = new ArrayList<String>();
+        public String foo() {
+            for (int i = 0; i < 12000; i++) {
+                foo2(aa);
+            }
+            ls.add("x");
+            return ls.get(0);
+        }
+        public void foo2(String[] a) {
+            String s = "aa";
+            if (ls.size() > 100 && a.length < 100) {
+                ls.clear();
+            } else {
+                ls.add(s);
+            }
+        }
+
+        public static void main(String[] args) throws Exception {
+            if (args[0].equals("collection")) {
+                InnerA a = new InnerA();
+                a.foo();
+                Thread.sleep(15000);
+                a.foo();
+                System.out.println("process is done!");
+            } else if (args[0].equals("compilation")) {
+                WhiteBox whiteBox = WhiteBox.getWhiteBox();
+                String className = InnerA.class.getName();
+                boolean containClass = false;
+                for (String c : whiteBox.getClassListFromLogfile()) {
+                    if (c.equals(className)) {
+                        containClass = true;
+                    }
+                }
+                String[] methodList = whiteBox.getMethodListFromLogfile();
+                assertTrue(methodList.length > 0);
+                boolean containMethod = false;
+                for (String m : methodList) {
+                    if (m.equals("foo2")) {
+                        containMethod = true;
+                    }
+                }
+                if (containClass && containMethod) {
+                    System.out.println("read log file OK");
+                }
+            }
+        }
+    }
+}
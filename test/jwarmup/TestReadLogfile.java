@@ -41,6 +41,7 @@ public class TestReadLogfile {
 
     private static final int HEADER_SIZE = 36;
     private static final int APPID_OFFSET = 16;
+    private static final int CRC32_OFFSET = 12;
 
     public static String generateOriginLogfile() throws Exception {
         ProcessBuilder pb = null;
@@ -213,6 +214,23 @@ public class TestReadLogfile {
         return fileName;
     }
 
+    // illegal symbol section offset, with a valid crc32
+    public static String generateIllegalLogfile5(String originLogfileName) throws IOException {
+        String fileName = "jitwarmup_5.log";
+        File f = createNewFile(fileName);
+        byte[] content = getFileContent(originLogfileName);
+        // the symbol section is located through the last 4 bytes
+        byte[] illegalOffset = IntegerAsBytes(HEADER_SIZE - 1);
+        System.arraycopy(illegalOffset, 0, content, content.length - 4, 4);
+        java.util.zip.CRC32 crc = new java.util.zip.CRC32();
+        crc.update(content, HEADER_SIZE, content.length - HEADER_SIZE);
+        System.arraycopy(IntegerAsBytes((int)crc.getValue()), 0, content, CRC32_OFFSET, 4);
+        RandomAccessFile raf = new RandomAccessFile(f, "rw");
+        raf.write(content, 0, content.length);
+        raf.close();
+        return fileName;
+    }
+
     public static void main(String[] args) throws Exception {
         OutputAnalyzer output = null;
         String originLogfileName = generateOriginLogfile();
@@ -232,6 +250,10 @@ public class TestReadLogfile {
         // generate and test illegal appid
         output = testReadLogfileAndGetResult(generateIllegalLogfile4(originLogfileName));
         output.shouldNotContain("read log file OK");
+        // generate and test illegal symbol section offset
+        output = testReadLogfileAndGetResult(generateIllegalLogfile5(originLogfileName));
+        output.shouldContain("illegal symbol section offset");
+        output.shouldNotContain("read log file OK");
     }
 
     public static class InnerA {
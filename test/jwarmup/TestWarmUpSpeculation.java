@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+import java.io.*;
+import java.lang.reflect.Method;
+
+import com.oracle.java.testlibrary.*;
+/*
+ * @test TestWarmUpSpeculation
+ * @library /testlibrary
+ * @build TestWarmUpSpeculation
+ * @run main/othervm TestWarmUpSpeculation
+ * @summary test JWarmUP compilations speculating on the restored receiver profile
+ */
+public class TestWarmUpSpeculation {
+    private static String classPath;
+
+    public static String generateOriginLogfile() throws Exception {
+        File logfile = new File("./jitwarmup.log");
+        classPath = System.getProperty("test.class.path");
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:-TieredCompilation",
+                "-Xbootclasspath/a:.",
+                "-XX:+CompilationWarmUpRecording",
+                "-XX:-ClassUnloading",
+                "-XX:+UseConcMarkSweepGC",
+                "-XX:-CMSClassUnloadingEnabled",
+                "-XX:-UseSharedSpaces",
+                "-XX:CompilationWarmUpLogfile=./" + logfile.getName(),
+                "-XX:CompilationWarmUpRecordTime=10",
+                "-XX:CompilationWarmUpAppID=123",
+                "-XX:+PrintCompilationWarmUpDetail",
+                "-cp", classPath,
+                InnerA.class.getName(), "recording");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        output.shouldContain("[JitWarmUp] output profile info has done");
+        output.shouldContain("process is done!");
+        output.shouldHaveExitValue(0);
+
+        if (!logfile.exists()) {
+            throw new Error("jit log not exist");
+        }
+        return logfile.getName();
+    }
+
+    public static OutputAnalyzer testSpeculation(String filename) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:-TieredCompilation",
+                "-Xbootclasspath/a:.",
+                "-XX:-UseSharedSpaces",
+                "-XX:+CompilationWarmUp",
+                "-XX:+CompilationWarmUpSpeculation",
+                "-XX:CompilationWarmUpSpeculationFailureLimit=1",
+                "-XX:CompilationWarmUpLogfile=./" + filename,
+                "-XX:+PrintCompilationWarmUpDetail",
+                "-XX:CompilationWarmUpAppID=123",
+                "-XX:+PrintCompilation",
+                "-cp", classPath,
+                InnerA.class.getName(), "compilation");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String fileName = generateOriginLogfile();
+        OutputAnalyzer output = testSpeculation(fileName);
+        output.shouldContain("[JitWarmUp] speculation failed");
+        output.shouldContain("process is done!");
+        output.shouldHaveExitValue(0);
+    }
+
+    public static abstract class Shape {
+        public abstract int area();
+    }
+
+    public static class Square extends Shape {
+        public int area() { return 4; }
+    }
+
+    public static class Circle extends Shape {
+        public int area() { return 3; }
+    }
+
+    public static class InnerA {
+        static {
+            System.out.println("InnerA initialize");
+        }
+
+        // Both subclasses are loaded so the call site is not bound by CHA
+        public static Shape[] shapes = { new Square(), new Circle() };
+
+        public static int foo(Shape s) {
+            int sum = 0;
+            for (int i = 0; i < 100; i++) {
+                sum += s.area();
+            }
+            return sum;
+        }
+
+        public static void run(Shape s) {
+            for (int i = 0; i < 12000; i++) {
+                foo(s);
+            }
+        }
+
+        public static void main(String[] args) throws Exception {
+            if (args[0].equals("recording")) {
+                // the recorded profile of foo only ever sees Square
+                run(shapes[0]);
+                Thread.sleep(15000);
+                run(shapes[0]);
+            } else if (args[0].equals("compilation")) {
+                Class c = Class.forName("com.alibaba.jwarmup.JWarmUp");
+                Method m2 = c.getMethod("notifyApplicationStartUpIsDone");
+                m2.invoke(null);
+                // wait for compilation
+                Thread.sleep(5000);
+                // contradict the recorded profile
+                run(shapes[1]);
+            }
+            System.out.println("process is done!");
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Metaspace.dump -binary writes a compact snapshot and -diff only
+ *          the changes since the previous binary dump
+ * @library /testlibrary
+ * @run main/othervm MetaspaceBinaryDumpTest
+ */
+
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+
+import com.oracle.java.testlibrary.JDKToolLauncher;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class MetaspaceBinaryDumpTest {
+    private static final byte[] MAGIC = { 'M', 'S', 'P', 'D', 'U', 'M', 'P', 0 };
+    private static final int TAG_END = 0xFF;
+
+    public static void main(String[] args) throws Exception {
+        dump("metaspace_full.mbin", "-binary");
+        check("metaspace_full.mbin", false);
+        dump("metaspace_diff.mbin", "-diff");
+        check("metaspace_diff.mbin", true);
+    }
+
+    private static void dump(String fileName, String option) throws Exception {
+        JDKToolLauncher jcmd = JDKToolLauncher.create("jcmd")
+            .addToolArg(String.valueOf(ProcessTools.getProcessId()))
+            .addToolArg("Metaspace.dump")
+            .addToolArg(option)
+            .addToolArg("filename=" + fileName);
+        OutputAnalyzer output = new OutputAnalyzer(new ProcessBuilder(jcmd.getCommand()).start());
+        output.shouldHaveExitValue(0);
+    }
+
+    private static void check(String fileName, boolean diff) throws Exception {
+        File file = new File(fileName);
+        if (!file.exists()) {
+            throw new RuntimeException(fileName + " was not written");
+        }
+        try (DataInputStream in = new DataInputStream(new FileInputStream(file))) {
+            byte[] magic = new byte[MAGIC.length];
+            in.readFully(magic);
+            for (int i = 0; i < MAGIC.length; i++) {
+                if (magic[i] != MAGIC[i]) {
+                    throw new RuntimeException("bad magic in " + fileName);
+                }
+            }
+            int version = in.readInt();
+            if (version != 1) {
+                throw new RuntimeException("unexpected version " + version);
+            }
+            in.readUnsignedByte();                    // reason
+            boolean isDiff = in.readUnsignedByte() != 0;
+            if (isDiff != diff) {
+                throw new RuntimeException("unexpected diff flag in " + fileName);
+            }
+        }
+        // The stream is terminated by the end record: u1 tag, u4 loaders,
+        // u4 klasses, u8 millis.
+        byte[] bytes = java.nio.file.Files.readAllBytes(file.toPath());
+        int end = bytes.length - 17;
+        if (end < MAGIC.length + 14 || (bytes[end] & 0xFF) != TAG_END) {
+            throw new RuntimeException("missing end record in " + fileName);
+        }
+    }
+}
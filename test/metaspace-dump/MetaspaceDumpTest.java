@@ -306,6 +306,8 @@ class ClassLoaderDataChecker extends AbstractSectionChecker {
                                         .compile("(\\* )?ClassLoaderData : loader = 0x[0-9a-f]{16}, loader_klass = 0x[0-9a-f]{16}, loader_klass_name = .+, label = .+");
     Pattern chunk                   = Pattern
                                         .compile("    (\\* )?Chunk : \\[0x([0-9a-f]{16}), 0x[0-9a-f]{16}, 0x[0-9a-f]{16}\\)");
+    Pattern chunkSizing             = Pattern
+                                        .compile("    Chunk Sizing : type = (Standard|Boot|ReadOnly|ReadWrite|Anonymous|Reflection), chunks = \\d+, capacity = \\d+ B, used = \\d+ B, next chunk = \\d+ B");
     Pattern blocks                  = Pattern.compile("    Blocks : size = \\d+ B, count = (\\d+)");
     Pattern block                   = Pattern.compile("      Block : 0x[0-9a-f]{16}");
     Pattern klass                   = Pattern
@@ -415,6 +417,8 @@ class ClassLoaderDataChecker extends AbstractSectionChecker {
             if (chunkMatcher.matches()) {
                 String chunkBase = chunkMatcher.group(2);
                 assertTrue(chunkBases.add(chunkBase), chunkBase);
+            } else if (chunkSizing.matcher(tmp).matches()) {
+                // per loader chunk sizing, once for each metadata type
             } else {
                 Matcher matcher = blocks.matcher(tmp);
                 assertTrue(matcher.matches());
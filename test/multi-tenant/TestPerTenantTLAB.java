@@ -226,11 +226,46 @@ public class TestPerTenantTLAB {
         }
     }
 
+    // more tenants than the per-thread TLAB cache has slots
+    private void testSwitchManyTenants() {
+        final int tenantCount = 12;
+        TenantContainer[] tenants = new TenantContainer[tenantCount];
+        Object[] last = new Object[tenantCount];
+        for (int i = 0; i < tenantCount; i++) {
+            tenants[i] = TenantContainer.create(new TenantConfiguration().limitHeap(64 * 1024 * 1024));
+        }
+
+        WB.fullGC();
+
+        try {
+            for (int round = 0; round < 20; round++) {
+                for (int i = 0; i < tenantCount; i++) {
+                    final int idx = i;
+                    tenants[i].run(()->{
+                        Object o = new Object();
+                        if (last[idx] != null) {
+                            // the tenant's TLAB was kept while the thread ran in other tenants
+                            assertInCurrentTLAB(last[idx], o);
+                        }
+                        last[idx] = o;
+                    });
+                }
+            }
+        } catch (TenantException e) {
+            throw new RuntimeException(e);
+        } finally {
+            for (TenantContainer tenant : tenants) {
+                tenant.destroy();
+            }
+        }
+    }
+
     public static void main(String[] args) {
         TestPerTenantTLAB test = new TestPerTenantTLAB();
         test.testRetainReuseTLABBasic();
         test.testChildThread();
         test.testAfterDestroyTenant();
+        test.testSwitchManyTenants();
     }
 
     private static void assertInCurrentTLAB(Object...objs) {
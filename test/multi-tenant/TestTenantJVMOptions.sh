@@ -83,3 +83,9 @@ assert_invalid_jvm_options '-XX:+UseG1GC -XX:+TenantHeapIsolation -XX:-MultiTena
 assert_invalid_jvm_options '-XX:+UseG1GC -XX:+TenantHeapThrottling -XX:-TenantHeapIsolation'
 assert_invalid_jvm_options '-XX:+UseG1GC -XX:+UsePerTenantTLAB -XX:+TenantHeapThrottling -XX:-UseTLAB'
 assert_invalid_jvm_options '-XX:+UseG1GC -XX:+UsePerTenantTLAB -XX:+UseTLAB -XX:-TenantHeapThrottling'
+assert_invalid_jvm_options '-XX:+UseG1GC -XX:+TenantFairCollectionSet'
+assert_invalid_jvm_options '-XX:+UseG1GC -XX:+TenantFairCollectionSet -XX:+TenantHeapIsolation'
+assert_invalid_jvm_options '-XX:+TenantCpuBudgeting'
+assert_invalid_jvm_options '-XX:+TenantCpuBudgeting -XX:+MultiTenant'
+assert_invalid_jvm_options '-XX:+TenantCpuBudgeting -XX:+MultiTenant -XX:+EnableCoroutine -XX:TenantCpuBudgetPeriod=0'
+assert_invalid_jvm_options '-XX:+UseG1GC -XX:+TenantHeapIsolation -XX:+TenantHeapByteAccounting'
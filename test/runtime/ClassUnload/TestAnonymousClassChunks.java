@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Anonymous classes sharing class loader data chunks are defined
+ *          correctly and unloaded once a whole chunk is unreachable
+ * @run main/othervm -XX:AnonymousClassesPerCLD=64 TestAnonymousClassChunks
+ * @run main/othervm -XX:AnonymousClassesPerCLD=64 -XX:+UseG1GC TestAnonymousClassChunks
+ * @run main/othervm -XX:AnonymousClassesPerCLD=1 TestAnonymousClassChunks
+ */
+
+import java.io.ByteArrayOutputStream;
+import java.io.InputStream;
+import java.lang.ref.WeakReference;
+import java.lang.reflect.Field;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.function.IntUnaryOperator;
+
+import sun.misc.Unsafe;
+
+public class TestAnonymousClassChunks {
+  static final int CLASSES = 1000;
+
+  public static class Anon implements IntUnaryOperator {
+    public int applyAsInt(int x) { return x + 1; }
+  }
+
+  public static void main(String[] args) throws Exception {
+    Field f = Unsafe.class.getDeclaredField("theUnsafe");
+    f.setAccessible(true);
+    Unsafe unsafe = (Unsafe) f.get(null);
+    byte[] bytes = classBytes(Anon.class);
+
+    List<WeakReference<Class<?>>> refs = new ArrayList<>();
+    List<Class<?>> kept = new ArrayList<>();
+    for (int i = 0; i < CLASSES; i++) {
+      Class<?> c = unsafe.defineAnonymousClass(TestAnonymousClassChunks.class, bytes, null);
+      IntUnaryOperator op = (IntUnaryOperator) c.newInstance();
+      if (op.applyAsInt(i) != i + 1) {
+        throw new RuntimeException("wrong result from anonymous class " + i);
+      }
+      refs.add(new WeakReference<Class<?>>(c));
+      if (i == CLASSES / 2) {
+        kept.add(c);   // pins its chunk only
+      }
+    }
+
+    // Lambdas are anonymous classes as well.
+    for (int i = 0; i < 100; i++) {
+      final int n = i;
+      IntUnaryOperator op = x -> x + n;
+      if (op.applyAsInt(1) != n + 1) {
+        throw new RuntimeException("wrong lambda result");
+      }
+    }
+
+    for (int i = 0; i < 3; i++) {
+      System.gc();
+    }
+    int unloaded = 0;
+    for (WeakReference<Class<?>> ref : refs) {
+      if (ref.get() == null) {
+        unloaded++;
+      }
+    }
+    if (refs.get(CLASSES / 2).get() == null) {
+      throw new RuntimeException("reachable anonymous class unloaded");
+    }
+    // At most the open chunk and the one pinned by 'kept' stay alive.
+    if (unloaded < CLASSES - 2 * 64) {
+      throw new RuntimeException("only " + unloaded + " of " + CLASSES + " anonymous classes unloaded");
+    }
+    System.out.println("unloaded " + unloaded + " anonymous classes, kept " + kept.size());
+  }
+
+  static byte[] classBytes(Class<?> c) throws Exception {
+    String name = c.getName().replace('.', '/') + ".class";
+    try (InputStream in = c.getClassLoader().getResourceAsStream(name)) {
+      ByteArrayOutputStream out = new ByteArrayOutputStream();
+      byte[] buf = new byte[4096];
+      int n;
+      while ((n = in.read(buf)) > 0) {
+        out.write(buf, 0, n);
+      }
+      return out.toByteArray();
+    }
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary With UseZeroBasedCompressedClassSpace the narrow klass base stays
+ *          zero even when the heap is placed above the zero based range
+ * @library /testlibrary
+ * @run main ZeroBasedCompressedClassSpace
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class ZeroBasedCompressedClassSpace {
+
+  static OutputAnalyzer run(String heap) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UseZeroBasedCompressedClassSpace",
+        "-Xshare:off",
+        "-Xmx" + heap,
+        "-XX:+PrintCompressedOopsMode",
+        "-XX:+UnlockDiagnosticVMOptions",
+        "-XX:+VerifyBeforeGC", "-version");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    return output;
+  }
+
+  public static void main(String[] args) throws Exception {
+    if (!Platform.is64bit()) {
+      return;
+    }
+    // Zero based heap ending at 32G: the class space would go above it.
+    run("30g").shouldContain("Narrow klass base: 0x0000000000000000");
+    // Heap based narrow oops.
+    run("40g").shouldContain("Narrow klass base: 0x0000000000000000");
+    // Small heaps are unaffected.
+    run("128m").shouldContain("Narrow klass base: 0x0000000000000000");
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Many threads resolving the same class, string and indy constant
+ *          pool entries at once all see the same results
+ * @run main/othervm -Xint TestConcurrentResolution
+ * @run main/othervm TestConcurrentResolution
+ */
+import java.util.concurrent.CyclicBarrier;
+import java.util.function.Supplier;
+
+public class TestConcurrentResolution {
+  static final int THREADS = 32;
+
+  static class Target1 { }
+  static class Target2 { }
+  static class Target3 { }
+
+  // Every constant is resolved for the first time by the racing threads
+  static class Resolver {
+    static Object[] resolve() {
+      Supplier<String> s = () -> "from lambda";
+      return new Object[] {
+        Target1.class, Target2.class, Target3.class,
+        "first string", "second string",
+        new Target1(), s, s.get()
+      };
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    final CyclicBarrier barrier = new CyclicBarrier(THREADS);
+    final Object[][] results = new Object[THREADS][];
+    Thread[] threads = new Thread[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+      final int id = t;
+      threads[t] = new Thread() {
+        public void run() {
+          try {
+            barrier.await();
+          } catch (Exception e) {
+            throw new RuntimeException(e);
+          }
+          results[id] = Resolver.resolve();
+        }
+      };
+      threads[t].start();
+    }
+    for (Thread t : threads) {
+      t.join();
+    }
+    Object[] first = results[0];
+    if (first == null) {
+      throw new RuntimeException("thread 0 failed");
+    }
+    for (int t = 1; t < THREADS; t++) {
+      if (results[t] == null) {
+        throw new RuntimeException("thread " + t + " failed");
+      }
+      for (int i = 0; i < first.length; i++) {
+        if (i == 5) {
+          continue;   // new Target1() is a fresh object per thread
+        }
+        if (results[t][i] != first[i]) {
+          throw new RuntimeException("thread " + t + " resolved a different constant at " + i);
+        }
+      }
+    }
+  }
+}
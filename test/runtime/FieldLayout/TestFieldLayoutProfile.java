@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary A field layout profile written at exit moves the hot fields of a
+ *          class in front of its cold fields in the next run
+ * @library /testlibrary
+ * @run main TestFieldLayoutProfile
+ */
+
+import java.io.File;
+import java.lang.reflect.Field;
+import java.nio.file.Files;
+import java.util.List;
+import sun.misc.Unsafe;
+import com.oracle.java.testlibrary.*;
+
+public class TestFieldLayoutProfile {
+
+  static class Entity {
+    long cold0, cold1, cold2, cold3, cold4, cold5, cold6, cold7;
+    int hot;
+    Object hotRef;
+  }
+
+  public static class Workload {
+    static int touch(Entity e) {
+      e.hot++;
+      return e.hotRef == null ? e.hot : 0;
+    }
+
+    public static void main(String[] args) throws Exception {
+      Entity e = new Entity();
+      int sum = 0;
+      for (int i = 0; i < 100000; i++) {
+        sum += touch(e);
+      }
+      System.out.println("sum " + sum);
+
+      Field f = Unsafe.class.getDeclaredField("theUnsafe");
+      f.setAccessible(true);
+      Unsafe unsafe = (Unsafe)f.get(null);
+      long hot = Math.max(unsafe.objectFieldOffset(Entity.class.getDeclaredField("hot")),
+                          unsafe.objectFieldOffset(Entity.class.getDeclaredField("hotRef")));
+      long cold = Long.MAX_VALUE;
+      for (Field c : Entity.class.getDeclaredFields()) {
+        if (c.getName().startsWith("cold")) {
+          cold = Math.min(cold, unsafe.objectFieldOffset(c));
+        }
+      }
+      System.out.println(hot < cold ? "hot fields first" : "cold fields first");
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    File profile = new File("fieldLayout.profile");
+    profile.delete();
+
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:DumpFieldLayoutProfileAtExit=" + profile.getPath(),
+        "TestFieldLayoutProfile$Workload");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    output.shouldContain("cold fields first");
+
+    List<String> lines = Files.readAllLines(profile.toPath());
+    int i = lines.indexOf("class TestFieldLayoutProfile$Entity 2");
+    if (i < 0 || !lines.get(i + 1).startsWith("field hot ") ||
+        !lines.get(i + 2).startsWith("field hotRef ")) {
+      throw new RuntimeException("Entity not profiled: " + lines);
+    }
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:FieldLayoutProfileFile=" + profile.getPath(),
+        "TestFieldLayoutProfile$Workload");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    output.shouldContain("hot fields first");
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Megamorphic interface calls on classes with a hashed itable index
+ * @run main/othervm -XX:ItableHashMinInterfaces=8 TestItableHash
+ * @run main/othervm -XX:ItableHashMinInterfaces=1 TestItableHash
+ * @run main/othervm -XX:ItableHashMinInterfaces=0 TestItableHash
+ * @run main/othervm -XX:ItableHashMinInterfaces=1 -XX:-TieredCompilation TestItableHash
+ */
+public class TestItableHash {
+  interface I0 { int m0(); default int d0() { return 1000; } }
+  interface I1 { int m1(); default int d1() { return 1001; } }
+  interface I2 { int m2(); default int d2() { return 1002; } }
+  interface I3 { int m3(); default int d3() { return 1003; } }
+  interface I4 { int m4(); default int d4() { return 1004; } }
+  interface I5 { int m5(); default int d5() { return 1005; } }
+  interface I6 { int m6(); default int d6() { return 1006; } }
+  interface I7 { int m7(); default int d7() { return 1007; } }
+  interface I8 { int m8(); default int d8() { return 1008; } }
+  interface I9 { int m9(); default int d9() { return 1009; } }
+  interface I10 { int m10(); default int d10() { return 1010; } }
+  interface I11 { int m11(); default int d11() { return 1011; } }
+
+  interface Small { int small(); }
+
+  static class A implements I0, I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11 {
+    public int m0() { return 100 + 0; }
+    public int m1() { return 100 + 1; }
+    public int m2() { return 100 + 2; }
+    public int m3() { return 100 + 3; }
+    public int m4() { return 100 + 4; }
+    public int m5() { return 100 + 5; }
+    public int m6() { return 100 + 6; }
+    public int m7() { return 100 + 7; }
+    public int m8() { return 100 + 8; }
+    public int m9() { return 100 + 9; }
+    public int m10() { return 100 + 10; }
+    public int m11() { return 100 + 11; }
+  }
+  static class B implements I0, I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11 {
+    public int m0() { return 200 + 0; }
+    public int m1() { return 200 + 1; }
+    public int m2() { return 200 + 2; }
+    public int m3() { return 200 + 3; }
+    public int m4() { return 200 + 4; }
+    public int m5() { return 200 + 5; }
+    public int m6() { return 200 + 6; }
+    public int m7() { return 200 + 7; }
+    public int m8() { return 200 + 8; }
+    public int m9() { return 200 + 9; }
+    public int m10() { return 200 + 10; }
+    public int m11() { return 200 + 11; }
+  }
+  static class C implements I0, I1, I2, I3, I4, I5, I6, I7, I8, I9, I10, I11 {
+    public int m0() { return 300 + 0; }
+    public int m1() { return 300 + 1; }
+    public int m2() { return 300 + 2; }
+    public int m3() { return 300 + 3; }
+    public int m4() { return 300 + 4; }
+    public int m5() { return 300 + 5; }
+    public int m6() { return 300 + 6; }
+    public int m7() { return 300 + 7; }
+    public int m8() { return 300 + 8; }
+    public int m9() { return 300 + 9; }
+    public int m10() { return 300 + 10; }
+    public int m11() { return 300 + 11; }
+  }
+  static class S1 implements Small { public int small() { return 1; } }
+  static class S2 implements Small { public int small() { return 2; } }
+  static class S3 implements Small { public int small() { return 3; } }
+
+  static int callAll(Object o) {
+    int sum = 0;
+      sum += ((I0)o).m0() + ((I0)o).d0();
+      sum += ((I1)o).m1() + ((I1)o).d1();
+      sum += ((I2)o).m2() + ((I2)o).d2();
+      sum += ((I3)o).m3() + ((I3)o).d3();
+      sum += ((I4)o).m4() + ((I4)o).d4();
+      sum += ((I5)o).m5() + ((I5)o).d5();
+      sum += ((I6)o).m6() + ((I6)o).d6();
+      sum += ((I7)o).m7() + ((I7)o).d7();
+      sum += ((I8)o).m8() + ((I8)o).d8();
+      sum += ((I9)o).m9() + ((I9)o).d9();
+      sum += ((I10)o).m10() + ((I10)o).d10();
+      sum += ((I11)o).m11() + ((I11)o).d11();
+    return sum;
+  }
+
+  static int expected(int base) {
+    int expected = 0;
+      expected += base + 0 + 1000;
+      expected += base + 1 + 1001;
+      expected += base + 2 + 1002;
+      expected += base + 3 + 1003;
+      expected += base + 4 + 1004;
+      expected += base + 5 + 1005;
+      expected += base + 6 + 1006;
+      expected += base + 7 + 1007;
+      expected += base + 8 + 1008;
+      expected += base + 9 + 1009;
+      expected += base + 10 + 1010;
+      expected += base + 11 + 1011;
+    return expected;
+  }
+
+  static int callSmall(Small s) {
+    return s.small();
+  }
+
+  public static void main(String[] args) {
+    Object[] receivers = { new A(), new B(), new C() };
+    int[] bases = { 100, 200, 300 };
+    Small[] small = { new S1(), new S2(), new S3() };
+    for (int i = 0; i < 200000; i++) {
+      int r = i % receivers.length;
+      int sum = callAll(receivers[r]);
+      if (sum != expected(bases[r])) {
+        throw new RuntimeException("wrong dispatch for " + receivers[r].getClass() + ": " + sum);
+      }
+      if (callSmall(small[r]) != r + 1) {
+        throw new RuntimeException("wrong dispatch for " + small[r].getClass());
+      }
+    }
+    try {
+      callSmall(null);
+      throw new RuntimeException("NullPointerException expected");
+    } catch (NullPointerException e) {
+      // expected
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Many threads resolving the same classes through one parallel
+ *          capable loader and the boot loader all see the same classes
+ * @run main/othervm TestParallelClassLoading
+ */
+
+import java.io.ByteArrayOutputStream;
+import java.io.InputStream;
+import java.util.concurrent.CountDownLatch;
+
+public class TestParallelClassLoading {
+  static final int THREADS = 16;
+  static final String[] NAMES = {
+    "TestParallelClassLoading$A", "TestParallelClassLoading$B",
+    "TestParallelClassLoading$C", "TestParallelClassLoading$D"
+  };
+
+  public static class A {}
+  public static class B extends A {}
+  public static class C extends B {}
+  public static class D extends C implements Runnable { public void run() {} }
+
+  static class Loader extends ClassLoader {
+    static {
+      registerAsParallelCapable();
+    }
+
+    Loader() {
+      super(TestParallelClassLoading.class.getClassLoader());
+    }
+
+    protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+      if (!name.startsWith("TestParallelClassLoading$")) {
+        return super.loadClass(name, resolve);
+      }
+      synchronized (getClassLoadingLock(name)) {
+        Class<?> c = findLoadedClass(name);
+        if (c == null) {
+          c = findClass(name);
+        }
+        return c;
+      }
+    }
+
+    protected Class<?> findClass(String name) throws ClassNotFoundException {
+      try (InputStream in = getParent().getResourceAsStream(name.replace('.', '/') + ".class")) {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        byte[] buf = new byte[4096];
+        int n;
+        while ((n = in.read(buf)) > 0) {
+          out.write(buf, 0, n);
+        }
+        byte[] b = out.toByteArray();
+        return defineClass(name, b, 0, b.length);
+      } catch (java.io.IOException e) {
+        throw new ClassNotFoundException(name, e);
+      }
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    for (int round = 0; round < 20; round++) {
+      final Loader loader = new Loader();
+      final Class<?>[][] seen = new Class<?>[THREADS][NAMES.length];
+      final Throwable[] failure = new Throwable[1];
+      final CountDownLatch start = new CountDownLatch(1);
+      Thread[] threads = new Thread[THREADS];
+      for (int t = 0; t < THREADS; t++) {
+        final int id = t;
+        threads[t] = new Thread() {
+          public void run() {
+            try {
+              start.await();
+              // Start with the subclass half of the time so supers are
+              // loaded from inside the parser as well.
+              for (int i = 0; i < NAMES.length; i++) {
+                int idx = (id % 2 == 0) ? i : NAMES.length - 1 - i;
+                seen[id][idx] = Class.forName(NAMES[idx], true, loader);
+              }
+              Class.forName("java.util.concurrent.ConcurrentSkipListSet", false, null);
+            } catch (Throwable e) {
+              synchronized (failure) {
+                failure[0] = e;
+              }
+            }
+          }
+        };
+        threads[t].start();
+      }
+      start.countDown();
+      for (Thread t : threads) {
+        t.join();
+      }
+      if (failure[0] != null) {
+        throw new RuntimeException("class loading failed", failure[0]);
+      }
+      for (int i = 0; i < NAMES.length; i++) {
+        Class<?> c = seen[0][i];
+        if (c.getClassLoader() != loader) {
+          throw new RuntimeException(c + " not defined by the test loader");
+        }
+        for (int t = 1; t < THREADS; t++) {
+          if (seen[t][i] != c) {
+            throw new RuntimeException("threads see different " + NAMES[i]);
+          }
+        }
+      }
+      if (seen[0][3].getSuperclass() != seen[0][2]) {
+        throw new RuntimeException("wrong super class");
+      }
+    }
+  }
+}
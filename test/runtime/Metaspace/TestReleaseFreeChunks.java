@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Metaspace chunks whose pages were returned to the OS after class
+ *          unloading are reused correctly
+ * @library /runtime/testlibrary
+ * @library classes
+ * @build test.Empty ClassUnloadCommon
+ * @run main/othervm -XX:+MetaspaceReleaseFreeChunks TestReleaseFreeChunks
+ * @run main/othervm -XX:+MetaspaceReleaseFreeChunks -XX:-UseCompressedClassPointers TestReleaseFreeChunks
+ * @run main/othervm -XX:-MetaspaceReleaseFreeChunks TestReleaseFreeChunks
+ */
+
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+
+public class TestReleaseFreeChunks {
+  static final int ROUNDS = 5;
+  static final int LOADERS = 2000;
+
+  public static void main(String[] args) throws Exception {
+    for (int round = 0; round < ROUNDS; round++) {
+      ArrayList<Class<?>> classes = new ArrayList<>();
+      for (int i = 0; i < LOADERS; i++) {
+        ClassLoader ldr = ClassUnloadCommon.newClassLoader();
+        classes.add(ldr.loadClass("test.Empty"));
+      }
+      // Use the metadata of the classes, which lives in chunks that were
+      // freed and released by the previous round.
+      for (Class<?> c : classes) {
+        Method m = c.getMethod("toString");
+        if (!c.getName().equals("test.Empty") || m == null) {
+          throw new RuntimeException("bad class " + c);
+        }
+        c.newInstance().toString();
+      }
+      classes = null;
+      System.gc();
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary NMT reports the resident part of committed virtual memory when
+ *          NMTResidentSampleInterval is set
+ * @key nmt jcmd
+ * @requires os.family == "linux"
+ * @library /testlibrary
+ * @run main/othervm -XX:NativeMemoryTracking=summary -XX:NMTResidentSampleInterval=50 ResidentMemorySampling summary
+ * @run main/othervm -XX:NativeMemoryTracking=detail -XX:NMTResidentSampleInterval=50 ResidentMemorySampling detail
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class ResidentMemorySampling {
+  static byte[] touched;
+
+  public static void main(String args[]) throws Exception {
+    // Make some heap resident and give the sampler time to see it
+    touched = new byte[16 * 1024 * 1024];
+    for (int i = 0; i < touched.length; i += 4096) {
+      touched[i] = 1;
+    }
+    Thread.sleep(500);
+
+    String pid = Integer.toString(ProcessTools.getProcessId());
+    ProcessBuilder pb = new ProcessBuilder();
+    pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, "VM.native_memory", args[0], "scale=KB"});
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldMatch("Java Heap \\(reserved=[0-9]+KB, committed=[0-9]+KB\\)");
+    output.shouldMatch("\\(mmap: resident=[1-9][0-9]*KB\\)");
+    output.shouldMatch("\\(stack: reserved=[0-9]+KB, committed=[0-9]+KB, resident=[0-9]+KB\\)");
+    if (args[0].equals("detail")) {
+      output.shouldMatch("reserved [0-9]+KB for Java Heap \\(resident [1-9][0-9]*KB\\)");
+    }
+  }
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Latency histograms recorded in the PerfData memory
+ * @library /testlibrary
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:+UsePerfData -XX:+PerfDataHistograms TestPerfDataHistograms
+ */
+
+import java.io.File;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+import com.oracle.java.testlibrary.*;
+
+public class TestPerfDataHistograms {
+  static final int BUCKETS = 128;
+  static Object sink;
+
+  public static void main(String[] args) throws Exception {
+    for (int i = 0; i < 5; i++) {
+      System.gc();
+    }
+    // larger than a TLAB, allocated in the shared space
+    for (int i = 0; i < 100; i++) {
+      sink = new byte[1024 * 1024];
+    }
+
+    File file = new File(System.getProperty("java.io.tmpdir"),
+                         "hsperfdata_" + System.getProperty("user.name") +
+                         File.separator + ProcessTools.getProcessId());
+    RandomAccessFile raf = new RandomAccessFile(file, "r");
+    MappedByteBuffer buf = raf.getChannel().map(FileChannel.MapMode.READ_ONLY, 0, raf.length());
+    buf.order(buf.get(4) == 0 ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+
+    check(buf, "sun.gc.pauseHistogram", 5);
+    check(buf, "sun.rt.safepointSyncTimeHistogram", 5);
+    check(buf, "sun.rt.safepointTimeHistogram", 5);
+    check(buf, "sun.gc.allocationStallHistogram", 1);
+    raf.close();
+  }
+
+  // Walks the entries of the PerfData memory for a long vector by name.
+  static void check(ByteBuffer buf, String name, long min) {
+    int offset = buf.getInt(24);
+    int entries = buf.getInt(28);
+    for (int i = 0; i < entries; i++) {
+      int length = buf.getInt(offset);
+      int nameOffset = buf.getInt(offset + 4);
+      int vectorLength = buf.getInt(offset + 8);
+      byte type = buf.get(offset + 12);
+      int dataOffset = buf.getInt(offset + 16);
+      StringBuilder sb = new StringBuilder();
+      for (int p = offset + nameOffset; buf.get(p) != 0; p++) {
+        sb.append((char)buf.get(p));
+      }
+      if (sb.toString().equals(name)) {
+        if (type != 'J' || vectorLength != BUCKETS) {
+          throw new RuntimeException(name + ": unexpected layout " + (char)type + "[" + vectorLength + "]");
+        }
+        long total = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+          total += buf.getLong(offset + dataOffset + b * 8);
+        }
+        if (total < min) {
+          throw new RuntimeException(name + ": " + total + " samples, expected at least " + min);
+        }
+        System.out.println(name + ": " + total + " samples");
+        return;
+      }
+      offset += length;
+    }
+    throw new RuntimeException(name + " not found");
+  }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Interface and array subtype checks answer the same through the hashed secondary supers table
+ * @run main/othervm -XX:+UseSecondarySupersTable -Xint TestSecondarySupersTable
+ * @run main/othervm -XX:+UseSecondarySupersTable -XX:TieredStopAtLevel=1 -Xbatch TestSecondarySupersTable
+ * @run main/othervm -XX:+UseSecondarySupersTable -XX:-TieredCompilation -Xbatch TestSecondarySupersTable
+ */
+
+import java.io.Serializable;
+
+public class TestSecondarySupersTable {
+    interface I0 {} interface I1 {} interface I2 {} interface I3 {}
+    interface I4 {} interface I5 {} interface I6 {} interface I7 {}
+    interface J extends I0, I1, I2, I3 {}
+
+    static class Many implements J, I4, I5, I6, I7, Runnable, Cloneable {
+        public void run() {}
+    }
+    static class Few implements I4 {}
+
+    static boolean[] check(Object o) {
+        return new boolean[] {
+            o instanceof I0, o instanceof I1, o instanceof I2, o instanceof I3,
+            o instanceof I4, o instanceof I5, o instanceof I6, o instanceof I7,
+            o instanceof J, o instanceof Runnable, o instanceof Cloneable,
+            o instanceof Serializable, o instanceof Comparable,
+            o instanceof I0[], o instanceof Object[], o instanceof Cloneable[]
+        };
+    }
+
+    static void verify(Object o, boolean[] expected) {
+        boolean[] actual = check(o);
+        for (int i = 0; i < expected.length; i++) {
+            if (actual[i] != expected[i]) {
+                throw new RuntimeException(o.getClass().getName() + ": check " + i + " returned " + actual[i]);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        boolean[] many = { true, true, true, true, true, true, true, true, true, true, true, false, false, false, false, false };
+        boolean[] few = { false, false, false, false, true, false, false, false, false, false, false, false, false, false, false, false };
+        boolean[] str = { false, false, false, false, false, false, false, false, false, false, false, true, true, false, false, false };
+        boolean[] arr = { false, false, false, false, false, false, false, false, false, false, true, true, false, true, true, true };
+        Object[] objs = { new Many(), new Few(), "s", new Many[1] };
+        boolean[][] expected = { many, few, str, arr };
+        for (int i = 0; i < 20000; i++) {
+            for (int j = 0; j < objs.length; j++) {
+                verify(objs[j], expected[j]);
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary -XX:ArchiveClassesAtExit dumps a shared archive of the classes
+ *          loaded by the run at VM exit
+ * @library /testlibrary
+ * @run main TestArchiveClassesAtExit
+ */
+
+import com.oracle.java.testlibrary.*;
+import java.io.File;
+
+public class TestArchiveClassesAtExit {
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      // Load a few classes that are not in the default classlist.
+      Class.forName("java.util.concurrent.ConcurrentSkipListMap");
+      Class.forName("javax.management.ObjectName");
+      return;
+    }
+
+    String classes = System.getProperty("test.classes");
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:ArchiveClassesAtExit=./exit.jsa",
+        "-cp", classes, "TestArchiveClassesAtExit", "run");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("Dumped shared archive ./exit.jsa");
+    output.shouldHaveExitValue(0);
+
+    if (!new File("exit.jsa.classlist").exists()) {
+      throw new RuntimeException("class list was not written");
+    }
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=./exit.jsa",
+        "-Xshare:on", "-XX:+TraceClassLoading",
+        "-cp", classes, "TestArchiveClassesAtExit", "run");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldContain("[Loaded javax.management.ObjectName from shared objects file]");
+    output.shouldHaveExitValue(0);
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Classes of user-defined class loaders listed with "source:" in
+ *          the classlist are archived and used when the same bytes are defined
+ * @library /testlibrary
+ * @run main TestUnregisteredClasses
+ */
+
+import com.oracle.java.testlibrary.*;
+import java.io.File;
+import java.io.PrintWriter;
+import java.net.URL;
+import java.net.URLClassLoader;
+
+public class TestUnregisteredClasses {
+  public static class Hello {
+    public String toString() { return "hello"; }
+  }
+
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      URL[] urls = { new File(args[0]).toURI().toURL() };
+      // Parent is the boot loader so Hello is defined by this loader.
+      URLClassLoader loader = new URLClassLoader(urls, null);
+      Class<?> c = loader.loadClass("TestUnregisteredClasses$Hello");
+      if (c.getClassLoader() != loader ||
+          !"hello".equals(c.newInstance().toString())) {
+        throw new RuntimeException("unexpected class " + c);
+      }
+      // A second loader cannot share the archived class.
+      URLClassLoader other = new URLClassLoader(urls, null);
+      Class<?> c2 = other.loadClass("TestUnregisteredClasses$Hello");
+      if (c2 == c || !"hello".equals(c2.newInstance().toString())) {
+        throw new RuntimeException("unexpected class " + c2);
+      }
+      return;
+    }
+
+    String classes = System.getProperty("test.classes");
+    File classlist = new File("unregistered.classlist");
+    PrintWriter pw = new PrintWriter(classlist);
+    pw.println("TestUnregisteredClasses$Hello source: " + classes);
+    pw.close();
+
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=./unregistered.jsa",
+        "-XX:ExtraSharedClassListFile=" + classlist.getPath(), "-Xshare:dump");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("Loading classes to share");
+    output.shouldNotContain("Preload Warning");
+    output.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=./unregistered.jsa",
+        "-Xshare:auto", "-XX:+TraceClassLoading",
+        "-cp", classes, "TestUnregisteredClasses", classes);
+    output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+    if (output.getStdout().contains("from shared objects file")) {
+      output.shouldContain("[Loaded TestUnregisteredClasses$Hello from shared objects file by java/net/URLClassLoader]");
+    }
+  }
+}
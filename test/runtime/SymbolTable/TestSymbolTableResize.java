@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary The symbol table grows at a safepoint once its load factor exceeds
+ *          SymbolTableMaxLoadFactor, and symbols stay reachable afterwards
+ * @library /testlibrary
+ * @run main TestSymbolTableResize
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestSymbolTableResize {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-Xshare:off", "-XX:+UnlockExperimentalVMOptions",
+        "-XX:SymbolTableSize=1009", "-XX:+PrintStringTableStatistics",
+        "TestSymbolTableResize$Load");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("[SymbolTable resized from 1009 to 2019 buckets");
+    output.shouldContain("loaded");
+    output.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-Xshare:off", "-XX:+UnlockExperimentalVMOptions",
+        "-XX:SymbolTableSize=1009", "-XX:SymbolTableMaxLoadFactor=0",
+        "-XX:+PrintStringTableStatistics", "TestSymbolTableResize$Load");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldNotContain("[SymbolTable resized");
+    output.shouldContain("Number of buckets       :      1009");
+    output.shouldHaveExitValue(0);
+  }
+
+  public static class Load {
+    public static void main(String[] args) throws Exception {
+      for (int i = 0; i < 20000; i++) {
+        try {
+          Class.forName("Missing" + i);
+          throw new RuntimeException("Missing" + i + " should not exist");
+        } catch (ClassNotFoundException e) {
+          // expected, the lookup has entered the name into the symbol table
+        }
+        if (i % 5000 == 0) {
+          System.gc();
+        }
+      }
+      // Symbols entered before the table grew must still be found
+      Class.forName("java.util.concurrent.ConcurrentHashMap");
+      TestSymbolTableResize.class.getDeclaredMethod("main", String[].class);
+      System.out.println("loaded");
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Stress monitor enter, wait/notify and identity hashes while the
+ *          service thread deflates idle monitors concurrently
+ * @run main/othervm -XX:+AsyncDeflateIdleMonitors -XX:AsyncDeflationInterval=1 TestAsyncDeflateIdleMonitors
+ */
+public class TestAsyncDeflateIdleMonitors {
+  static final int THREADS = 8;
+  static final int LOCKS = 256;
+  static final int ITERATIONS = 200000;
+
+  static final Object[] locks = new Object[LOCKS];
+  static final int[] hashes = new int[LOCKS];
+  static final long[] counters = new long[LOCKS];
+
+  public static void main(String[] args) throws Exception {
+    for (int i = 0; i < LOCKS; i++) {
+      locks[i] = new Object();
+      hashes[i] = System.identityHashCode(locks[i]);
+    }
+
+    Thread[] threads = new Thread[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+      final int seed = t;
+      threads[t] = new Thread() {
+        public void run() {
+          for (int i = 0; i < ITERATIONS; i++) {
+            int idx = (i * 31 + seed) % LOCKS;
+            Object lock = locks[idx];
+            synchronized (lock) {
+              counters[idx]++;
+              if (i % 1000 == 0) {
+                try {
+                  lock.wait(1);
+                } catch (InterruptedException e) {
+                  throw new RuntimeException(e);
+                }
+              }
+            }
+            if (System.identityHashCode(lock) != hashes[idx]) {
+              throw new RuntimeException("identity hash changed for lock " + idx);
+            }
+            if (i % 10000 == 0) {
+              // Let monitors go idle so there is something to deflate.
+              Thread.yield();
+            }
+          }
+        }
+      };
+      threads[t].start();
+    }
+    for (Thread t : threads) {
+      t.join();
+    }
+
+    long total = 0;
+    for (long c : counters) {
+      total += c;
+    }
+    if (total != (long)THREADS * ITERATIONS) {
+      throw new RuntimeException("lost updates: " + total);
+    }
+  }
+}
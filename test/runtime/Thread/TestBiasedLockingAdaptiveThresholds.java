@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary A class whose biases keep being revoked in bursts is bulk revoked
+ *          with -XX:+BiasedLockingAdaptiveThresholds instead of being bulk
+ *          rebiased again after every BiasedLockingDecayTime
+ * @library /testlibrary
+ * @run main TestBiasedLockingAdaptiveThresholds
+ */
+import com.oracle.java.testlibrary.*;
+import java.util.concurrent.SynchronousQueue;
+
+public class TestBiasedLockingAdaptiveThresholds {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:+UseBiasedLocking",
+                                                              "-XX:BiasedLockingStartupDelay=0",
+                                                              "-XX:BiasedLockingDecayTime=50",
+                                                              "-XX:+BiasedLockingAdaptiveThresholds",
+                                                              "-XX:+TraceBiasedLocking",
+                                                              PingPongTest.class.getName());
+    OutputAnalyzer out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+    out.shouldContain("Disabling biased locking for type " + PingPong.class.getName());
+  }
+
+  static class PingPong {
+  }
+
+  static class PingPongTest {
+    static final int BURSTS = 10;
+    static final int PER_BURST = 30;
+
+    public static void main(String[] args) throws Exception {
+      final SynchronousQueue<PingPong> queue = new SynchronousQueue<PingPong>();
+      Thread other = new Thread() {
+        public void run() {
+          try {
+            for (int i = 0; i < BURSTS * PER_BURST; i++) {
+              PingPong p = queue.take();
+              // Biased towards main, this revokes
+              synchronized (p) {
+              }
+            }
+          } catch (InterruptedException e) {
+            throw new RuntimeException(e);
+          }
+        }
+      };
+      other.start();
+      for (int burst = 0; burst < BURSTS; burst++) {
+        for (int i = 0; i < PER_BURST; i++) {
+          PingPong p = new PingPong();
+          synchronized (p) {
+          }
+          queue.put(p);
+        }
+        // Longer than BiasedLockingDecayTime, shorter than the adaptive decay
+        Thread.sleep(70);
+      }
+      other.join();
+    }
+  }
+}
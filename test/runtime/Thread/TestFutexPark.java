@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary park/unpark, timed parks, interrupts, sleep and wait/notify on top
+ *          of the futex based PlatformEvent and Parker
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:+UseFutexPark TestFutexPark
+ * @run main/othervm -XX:+UseFutexPark -XX:FutexParkSpinCount=0 TestFutexPark
+ */
+import java.util.concurrent.locks.LockSupport;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+
+public class TestFutexPark {
+  static final int ROUNDS = 20000;
+
+  public static void main(String[] args) throws Exception {
+    testPingPong();
+    testTimedPark();
+    testInterrupt();
+    testWaitNotify();
+  }
+
+  // Two threads hand a token back and forth, exercising both the spin
+  // path and the futex path of park and the waiter check of unpark
+  static void testPingPong() throws Exception {
+    final Semaphore ping = new Semaphore(0);
+    final Semaphore pong = new Semaphore(0);
+    Thread other = new Thread() {
+      public void run() {
+        for (int i = 0; i < ROUNDS; i++) {
+          ping.acquireUninterruptibly();
+          pong.release();
+        }
+      }
+    };
+    other.start();
+    for (int i = 0; i < ROUNDS; i++) {
+      ping.release();
+      pong.acquireUninterruptibly();
+    }
+    other.join();
+  }
+
+  static void testTimedPark() throws Exception {
+    long start = System.nanoTime();
+    LockSupport.parkNanos(TimeUnit.MILLISECONDS.toNanos(50));
+    long elapsed = System.nanoTime() - start;
+    // Spurious returns are allowed, but a timeout must not wake up much later
+    if (elapsed > TimeUnit.SECONDS.toNanos(10)) {
+      throw new RuntimeException("parkNanos overslept: " + elapsed);
+    }
+    LockSupport.parkUntil(System.currentTimeMillis() + 50);
+
+    // A permit handed out before park makes it return immediately
+    LockSupport.unpark(Thread.currentThread());
+    start = System.nanoTime();
+    LockSupport.parkNanos(TimeUnit.SECONDS.toNanos(30));
+    if (System.nanoTime() - start > TimeUnit.SECONDS.toNanos(10)) {
+      throw new RuntimeException("permit was lost");
+    }
+
+    start = System.nanoTime();
+    Thread.sleep(50);
+    if (System.nanoTime() - start < TimeUnit.MILLISECONDS.toNanos(50)) {
+      throw new RuntimeException("sleep returned early");
+    }
+  }
+
+  static void testInterrupt() throws Exception {
+    final Thread main = Thread.currentThread();
+    Thread interrupter = new Thread() {
+      public void run() {
+        try {
+          Thread.sleep(100);
+        } catch (InterruptedException e) {
+          throw new RuntimeException(e);
+        }
+        main.interrupt();
+      }
+    };
+    interrupter.start();
+    long start = System.nanoTime();
+    while (!Thread.currentThread().isInterrupted()) {
+      LockSupport.park();
+      if (System.nanoTime() - start > TimeUnit.SECONDS.toNanos(30)) {
+        throw new RuntimeException("interrupt did not unpark");
+      }
+    }
+    Thread.interrupted();
+    interrupter.join();
+  }
+
+  static void testWaitNotify() throws Exception {
+    final Object lock = new Object();
+    final int[] turn = new int[1];
+    Thread other = new Thread() {
+      public void run() {
+        synchronized (lock) {
+          for (int i = 0; i < ROUNDS / 10; i++) {
+            while (turn[0] != 1) {
+              try {
+                lock.wait();
+              } catch (InterruptedException e) {
+                throw new RuntimeException(e);
+              }
+            }
+            turn[0] = 0;
+            lock.notifyAll();
+          }
+        }
+      }
+    };
+    other.start();
+    synchronized (lock) {
+      for (int i = 0; i < ROUNDS / 10; i++) {
+        turn[0] = 1;
+        lock.notifyAll();
+        while (turn[0] != 0) {
+          lock.wait(1000);
+        }
+      }
+    }
+    other.join();
+  }
+}
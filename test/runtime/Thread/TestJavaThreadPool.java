@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Java threads reusing pooled pthreads: many short-lived threads,
+ *          stack overflows on reused stacks and different stack sizes
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:JavaThreadPoolSize=4 TestJavaThreadPool
+ * @run main/othervm -XX:JavaThreadPoolSize=4 -XX:JavaThreadPoolKeepAlive=0 TestJavaThreadPool
+ * @run main/othervm -XX:JavaThreadPoolSize=64 -Xint TestJavaThreadPool
+ */
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class TestJavaThreadPool {
+  static final int ROUNDS = 200;
+  static final int BATCH = 8;
+
+  static final AtomicInteger completed = new AtomicInteger();
+  static final AtomicInteger overflows = new AtomicInteger();
+
+  static int recurse(int depth) {
+    return recurse(depth + 1) + 1;
+  }
+
+  public static void main(String[] args) throws Exception {
+    for (int round = 0; round < ROUNDS; round++) {
+      Thread[] threads = new Thread[BATCH];
+      for (int i = 0; i < BATCH; i++) {
+        final boolean overflow = (round + i) % 16 == 0;
+        Runnable task = new Runnable() {
+          public void run() {
+            if (overflow) {
+              try {
+                recurse(0);
+              } catch (StackOverflowError e) {
+                overflows.incrementAndGet();
+              }
+            }
+            completed.incrementAndGet();
+          }
+        };
+        // every fourth thread asks for its own stack size
+        threads[i] = (i % 4 == 3) ? new Thread(null, task, "small", 256 * 1024)
+                                  : new Thread(task);
+        threads[i].setDaemon(i % 2 == 0);
+        threads[i].start();
+      }
+      for (Thread t : threads) {
+        t.join();
+      }
+    }
+    if (completed.get() != ROUNDS * BATCH) {
+      throw new RuntimeException("completed " + completed.get() + " threads");
+    }
+    if (overflows.get() == 0) {
+      throw new RuntimeException("no stack overflow was caught");
+    }
+  }
+}
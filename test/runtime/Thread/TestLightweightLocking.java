@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Lock stack based locking: contention, recursion, nesting deeper
+ *          than the lock stack, wait/notify, identity hashes and holdsLock
+ * @run main/othervm -XX:+UseLightweightLocking TestLightweightLocking
+ * @run main/othervm -XX:+UseLightweightLocking -Xint TestLightweightLocking
+ * @run main/othervm -XX:+UseLightweightLocking -XX:TieredStopAtLevel=1 TestLightweightLocking
+ * @run main/othervm -XX:+UseLightweightLocking -XX:-TieredCompilation TestLightweightLocking
+ */
+public class TestLightweightLocking {
+  static final int THREADS = 4;
+  static final int LOCKS = 16;
+  static final int ITERATIONS = 100000;
+  static final int DEPTH = 20;   // deeper than the lock stack
+
+  static final Object[] locks = new Object[LOCKS];
+  static final long[] counters = new long[LOCKS];
+
+  public static void main(String[] args) throws Exception {
+    for (int i = 0; i < LOCKS; i++) {
+      locks[i] = new Object();
+    }
+
+    Thread[] threads = new Thread[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+      final int seed = t;
+      threads[t] = new Thread() {
+        public void run() {
+          for (int i = 0; i < ITERATIONS; i++) {
+            int idx = (i * 7 + seed) % LOCKS;
+            Object lock = locks[idx];
+            synchronized (lock) {
+              synchronized (lock) {   // recursive
+                counters[idx]++;
+              }
+              if (!Thread.holdsLock(lock)) {
+                throw new RuntimeException("lock " + idx + " not held");
+              }
+            }
+          }
+        }
+      };
+      threads[t].start();
+    }
+    for (Thread t : threads) {
+      t.join();
+    }
+    long total = 0;
+    for (long c : counters) {
+      total += c;
+    }
+    if (total != (long)THREADS * ITERATIONS) {
+      throw new RuntimeException("lost updates: " + total);
+    }
+
+    testNesting();
+    testHashWhileLocked();
+    testWaitNotify();
+  }
+
+  static void testNesting() {
+    Object[] nested = new Object[DEPTH];
+    for (int i = 0; i < DEPTH; i++) {
+      nested[i] = new Object();
+    }
+    for (int i = 0; i < ITERATIONS / 10; i++) {
+      lockNested(nested, 0);
+    }
+    for (Object o : nested) {
+      if (Thread.holdsLock(o)) {
+        throw new RuntimeException("nested lock still held");
+      }
+    }
+  }
+
+  static void lockNested(Object[] nested, int depth) {
+    if (depth == nested.length) {
+      for (Object o : nested) {
+        if (!Thread.holdsLock(o)) {
+          throw new RuntimeException("nested lock not held");
+        }
+      }
+      return;
+    }
+    synchronized (nested[depth]) {
+      lockNested(nested, depth + 1);
+    }
+  }
+
+  static void testHashWhileLocked() {
+    for (int i = 0; i < 1000; i++) {
+      Object o = new Object();
+      int hash;
+      synchronized (o) {
+        hash = System.identityHashCode(o);
+        if (System.identityHashCode(o) != hash) {
+          throw new RuntimeException("identity hash changed while locked");
+        }
+      }
+      if (System.identityHashCode(o) != hash) {
+        throw new RuntimeException("identity hash changed after unlock");
+      }
+      synchronized (o) {
+        if (System.identityHashCode(o) != hash) {
+          throw new RuntimeException("identity hash changed on relock");
+        }
+      }
+    }
+  }
+
+  static void testWaitNotify() throws Exception {
+    final Object lock = new Object();
+    final boolean[] ready = new boolean[1];
+    Thread waiter = new Thread() {
+      public void run() {
+        synchronized (lock) {
+          while (!ready[0]) {
+            try {
+              lock.wait();
+            } catch (InterruptedException e) {
+              throw new RuntimeException(e);
+            }
+          }
+        }
+      }
+    };
+    waiter.start();
+    Thread.sleep(100);
+    synchronized (lock) {
+      ready[0] = true;
+      lock.notifyAll();
+    }
+    waiter.join();
+
+    // notify on a fast-locked object without waiters
+    Object o = new Object();
+    synchronized (o) {
+      o.notify();
+    }
+    try {
+      o.notify();
+      throw new RuntimeException("notify without owning the lock");
+    } catch (IllegalMonitorStateException e) {
+      // expected
+    }
+  }
+}
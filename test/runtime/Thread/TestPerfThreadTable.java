@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary The per-thread table in the PerfData memory lists the live Java
+ *          threads and counts the ones that do not fit
+ * @library /testlibrary
+ * @run main/othervm -XX:+UsePerfData -XX:PerfThreadTableSize=64 -XX:PerfThreadTableInterval=50 TestPerfThreadTable 64
+ * @run main/othervm -XX:+UsePerfData -XX:PerfThreadTableSize=2 -XX:PerfThreadTableInterval=50 TestPerfThreadTable 2
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+import com.oracle.java.testlibrary.*;
+
+public class TestPerfThreadTable {
+  static final int THREADS = 8;
+
+  public static void main(String[] args) throws Exception {
+    int capacity = Integer.parseInt(args[0]);
+    final CountDownLatch done = new CountDownLatch(1);
+    Thread[] threads = new Thread[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+      threads[i] = new Thread() {
+        public void run() {
+          try {
+            done.await();
+          } catch (InterruptedException e) {
+            throw new RuntimeException(e);
+          }
+        }
+      };
+      threads[i].start();
+    }
+    Thread.sleep(500);
+
+    String pid = Integer.toString(ProcessTools.getProcessId());
+    ProcessBuilder pb = new ProcessBuilder();
+    pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, "PerfCounter.print"});
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("sun.threads.table.capacity=" + capacity);
+    output.shouldContain("sun.threads.table.entryBytes=32");
+    output.shouldContain("sun.threads.table.entries=<" + (capacity * 32) + " bytes>");
+
+    long count = value(output, "sun.threads.table.count");
+    long dropped = value(output, "sun.threads.table.dropped");
+    long sequence = value(output, "sun.threads.table.sequence");
+    if (sequence <= 0 || sequence % 2 != 0) {
+      throw new RuntimeException("table never refreshed or mid-update: " + sequence);
+    }
+    if (count > capacity) {
+      throw new RuntimeException("count " + count + " exceeds capacity " + capacity);
+    }
+    // main, the blocked threads and the system threads
+    if (count + dropped < THREADS + 1) {
+      throw new RuntimeException("missing threads: " + count + " + " + dropped);
+    }
+    if ((capacity < THREADS) != (dropped > 0)) {
+      throw new RuntimeException("unexpected dropped count " + dropped);
+    }
+    done.countDown();
+    for (Thread t : threads) {
+      t.join();
+    }
+  }
+
+  static long value(OutputAnalyzer output, String name) {
+    for (String line : output.getOutput().split("\n")) {
+      if (line.startsWith(name + "=")) {
+        return Long.parseLong(line.substring(name.length() + 1).trim());
+      }
+    }
+    throw new RuntimeException(name + " not found");
+  }
+}
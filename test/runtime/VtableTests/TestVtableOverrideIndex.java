@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Overriding through the hashed index of inherited vtable entries:
+ *          overloads, multi-level overrides, default methods and mirandas
+ * @run main/othervm -Xint TestVtableOverrideIndex
+ * @run main/othervm TestVtableOverrideIndex
+ */
+public class TestVtableOverrideIndex {
+  interface I {
+    int fromInterface();
+    default int withDefault() { return 1; }
+  }
+
+  static abstract class A implements I {
+    int m() { return 10; }
+    int m(int x) { return 10 + x; }
+    int m(long x) { return 20; }
+    int n() { return 30; }
+    public String toString() { return "A"; }
+  }
+
+  static class B extends A {
+    int m(int x) { return 100 + x; }
+    int n() { return 300; }
+    public int fromInterface() { return 2; }
+  }
+
+  static class C extends B {
+    int m() { return 1000; }
+    int m(long x) { return 2000; }
+    public int withDefault() { return 3; }
+    public int hashCode() { return 42; }
+  }
+
+  static void check(int actual, int expected, String what) {
+    if (actual != expected) {
+      throw new RuntimeException(what + ": " + actual + " != " + expected);
+    }
+  }
+
+  public static void main(String[] args) {
+    A b = new B();
+    A c = new C();
+    for (int i = 0; i < 20000; i++) {
+      check(b.m(), 10, "B.m()");
+      check(b.m(1), 101, "B.m(int)");
+      check(b.m(1L), 20, "B.m(long)");
+      check(b.n(), 300, "B.n()");
+      check(b.fromInterface(), 2, "B.fromInterface()");
+      check(b.withDefault(), 1, "B.withDefault()");
+
+      check(c.m(), 1000, "C.m()");
+      check(c.m(1), 101, "C.m(int)");
+      check(c.m(1L), 2000, "C.m(long)");
+      check(c.n(), 300, "C.n()");
+      check(c.fromInterface(), 2, "C.fromInterface()");
+      check(c.withDefault(), 3, "C.withDefault()");
+      check(((I)c).withDefault(), 3, "I.withDefault() on C");
+      check(c.hashCode(), 42, "C.hashCode()");
+      if (!c.toString().equals("A")) {
+        throw new RuntimeException("C.toString()");
+      }
+    }
+  }
+}
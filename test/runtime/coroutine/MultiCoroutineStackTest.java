@@ -46,6 +46,26 @@ public class MultiCoroutineStackTest {
         testCoroutineName();
         testParkingObj();
         testWaitingToLock();
+        testCoroutineSummary();
+    }
+
+    private static void testCoroutineSummary() throws Exception {
+        Thread[] coro = new Thread[1];
+        WispEngine.dispatch(() -> {
+            coro[0] = Thread.currentThread();
+            LockSupport.park();
+        });
+
+        String summary = null;
+        for (String line : jstack()) {
+            if (line.startsWith("Coroutines: ")) {
+                summary = line;
+            }
+        }
+        assertTrue(summary != null, "coroutine summary not found");
+        int parked = Integer.parseInt(summary.replaceAll(".* (\\d+) parked.*", "$1"));
+        assertTrue(parked >= 1, "parked coroutine not counted: " + summary);
+        LockSupport.unpark(coro[0]);
     }
 
     private static void testCoroutineName() throws Exception {
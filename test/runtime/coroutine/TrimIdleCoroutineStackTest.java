@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @library /testlibrary
+ * @summary Parked coroutines whose unused stack pages were released at
+ *          safepoint cleanup still resume with intact frames
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+EnableCoroutine -Dcom.alibaba.transparentAsync=true -XX:CoroutineStackTrimIdleCleanups=1 TrimIdleCoroutineStackTest
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+EnableCoroutine -Dcom.alibaba.transparentAsync=true -XX:CoroutineStackTrimIdleCleanups=3 -XX:+UseWispMonitor TrimIdleCoroutineStackTest
+ */
+
+import com.alibaba.wisp.engine.WispEngine;
+
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.locks.LockSupport;
+
+import static com.oracle.java.testlibrary.Asserts.*;
+
+public class TrimIdleCoroutineStackTest {
+    static final int COROUTINES = 100;
+    static final int DEPTH = 200;
+
+    public static void main(String[] args) throws Exception {
+        for (int round = 0; round < 3; round++) {
+            Thread[] coros = new Thread[COROUTINES];
+            CountDownLatch parked = new CountDownLatch(COROUTINES);
+            CountDownLatch done = new CountDownLatch(COROUTINES);
+            AtomicLong sum = new AtomicLong();
+            for (int i = 0; i < COROUTINES; i++) {
+                final int id = i;
+                WispEngine.dispatch(() -> {
+                    coros[id] = Thread.currentThread();
+                    sum.addAndGet(recurse(id, DEPTH, parked));
+                    done.countDown();
+                });
+            }
+            parked.await();
+            // every GC safepoint runs the cleanup tasks
+            for (int i = 0; i < 5; i++) {
+                System.gc();
+            }
+            for (Thread t : coros) {
+                LockSupport.unpark(t);
+            }
+            done.await();
+            long expected = 0;
+            for (int i = 0; i < COROUTINES; i++) {
+                expected += (long) i * DEPTH + (long) DEPTH * (DEPTH + 1) / 2;
+            }
+            assertEquals(sum.get(), expected);
+        }
+    }
+
+    // every frame keeps a local which is checked after the deepest one parks
+    static long recurse(int id, int depth, CountDownLatch parked) {
+        long local = id + depth;
+        if (depth == 1) {
+            parked.countDown();
+            LockSupport.park();
+            // touch the released pages below the parked frames again
+            return local + deepen(DEPTH);
+        }
+        long below = recurse(id, depth - 1, parked);
+        return local + below;
+    }
+
+    static long deepen(int depth) {
+        return depth == 0 ? 0 : deepen(depth - 1);
+    }
+}
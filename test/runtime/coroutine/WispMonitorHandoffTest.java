@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary monitors contended by coroutines of one carrier are handed off on exit
+ * @requires os.family == "linux"
+ * @run main/othervm/timeout=60 -XX:+UnlockExperimentalVMOptions -XX:+UseWispMonitor -XX:+WispMonitorHandoff WispMonitorHandoffTest
+ * @run main/othervm/timeout=60 -XX:+UnlockExperimentalVMOptions -XX:+UseWisp2 -XX:+WispMonitorHandoff WispMonitorHandoffTest
+ */
+
+import com.alibaba.wisp.engine.WispEngine;
+
+import java.util.concurrent.CountDownLatch;
+
+public class WispMonitorHandoffTest {
+
+    private static final int TASKS = 16;
+    private static final int ITERATIONS = 10000;
+
+    private static final Object lock = new Object();
+    private static long counter;
+
+    public static void main(String[] args) throws Exception {
+        CountDownLatch done = new CountDownLatch(TASKS * 2);
+
+        // coroutines on the current carrier and on a second thread compete,
+        // so both the same-carrier hand-off and the plain release are taken
+        for (int t = 0; t < 2; t++) {
+            Thread carrier = new Thread(() -> {
+                for (int i = 0; i < TASKS; i++) {
+                    WispEngine.dispatch(() -> {
+                        for (int j = 0; j < ITERATIONS; j++) {
+                            synchronized (lock) {
+                                counter++;
+                                if (j % 64 == 0) {
+                                    // switch away while holding the monitor so
+                                    // that the other coroutines queue up on it
+                                    Thread.yield();
+                                }
+                            }
+                        }
+                        done.countDown();
+                    });
+                }
+            });
+            carrier.start();
+        }
+
+        done.await();
+        synchronized (lock) {
+            if (counter != (long) TASKS * 2 * ITERATIONS) {
+                throw new RuntimeException("lost updates: " + counter);
+            }
+        }
+    }
+}
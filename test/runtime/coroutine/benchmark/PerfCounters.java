@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+
+import java.io.File;
+import java.io.RandomAccessFile;
+import java.lang.management.ManagementFactory;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Reads the scalar long counters of the current VM from its PerfData
+ * memory (hsperfdata file), so that a run can report the coroutine
+ * counters (sun.rt.coroutine.*) without jstat. Needs -XX:+UsePerfData,
+ * which is the default, and -XX:-PerfDisableSharedMem.
+ */
+public class PerfCounters {
+    public static final String COROUTINE_PREFIX = "sun.rt.coroutine.";
+
+    private final ByteBuffer buf;
+
+    public PerfCounters() throws Exception {
+        String name = ManagementFactory.getRuntimeMXBean().getName();
+        String pid = name.substring(0, name.indexOf('@'));
+        File file = new File(System.getProperty("java.io.tmpdir"),
+                             "hsperfdata_" + System.getProperty("user.name") +
+                             File.separator + pid);
+        try (RandomAccessFile raf = new RandomAccessFile(file, "r")) {
+            buf = raf.getChannel().map(FileChannel.MapMode.READ_ONLY, 0, raf.length());
+        }
+        buf.order(buf.get(4) == 0 ? ByteOrder.BIG_ENDIAN : ByteOrder.LITTLE_ENDIAN);
+    }
+
+    /** The current values of the long counters whose name starts with prefix. */
+    public Map<String, Long> snapshot(String prefix) {
+        Map<String, Long> values = new HashMap<>();
+        int offset = buf.getInt(24);
+        int entries = buf.getInt(28);
+        for (int i = 0; i < entries; i++) {
+            int length = buf.getInt(offset);
+            int nameOffset = buf.getInt(offset + 4);
+            int vectorLength = buf.getInt(offset + 8);
+            byte type = buf.get(offset + 12);
+            int dataOffset = buf.getInt(offset + 16);
+            if (type == 'J' && vectorLength == 0) {
+                StringBuilder sb = new StringBuilder();
+                for (int p = offset + nameOffset; buf.get(p) != 0; p++) {
+                    sb.append((char) buf.get(p));
+                }
+                String name = sb.toString();
+                if (name.startsWith(prefix)) {
+                    values.put(name, buf.getLong(offset + dataOffset));
+                }
+            }
+            offset += length;
+        }
+        return values;
+    }
+
+    public long get(String name) {
+        Long v = snapshot(name).get(name);
+        if (v == null) {
+            throw new RuntimeException(name + " not found");
+        }
+        return v;
+    }
+
+    /** Ticks of the high resolution timer per second, for the *Time counters. */
+    public long tickFrequency() {
+        return get("sun.os.hrt.frequency");
+    }
+
+    /** after - before for every counter of after. */
+    public static Map<String, Long> delta(Map<String, Long> before, Map<String, Long> after) {
+        Map<String, Long> d = new HashMap<>();
+        for (Map.Entry<String, Long> e : after.entrySet()) {
+            Long b = before.get(e.getKey());
+            d.put(e.getKey(), e.getValue() - (b == null ? 0 : b));
+        }
+        return d;
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestWispBench.java
+ * @summary Smoke test of the Wisp benchmark harness and the coroutine PerfData counters
+ * @build WispBench WispBenchWorkload PerfCounters
+ * @run main/othervm/timeout=600 TestWispBench
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+import java.util.List;
+
+public class TestWispBench {
+    public static void main(String[] args) throws Exception {
+        File out = new File("wispbench-results.json");
+        WispBench.main(new String[] {
+            "-scenarios=switch,steal,monitor,roots", "-carriers=2", "-coroutines=200",
+            "-seconds=2", "-warmup=1", "-out=" + out.getPath(), "-vmoptions=-Xmx128m"
+        });
+        List<String> lines = Files.readAllLines(out.toPath());
+        if (lines.size() != 4) {
+            throw new RuntimeException("Expected 4 results, got " + lines);
+        }
+        for (String line : lines) {
+            check(line, "\"counters\":{");
+            check(line, "\"steals\":");
+            check(line, "\"rootsScanned\":");
+            if (line.contains("\"ops\":0,")) {
+                throw new RuntimeException("No operations in " + line);
+            }
+        }
+        check(lines.get(0), "\"scenario\":\"switch\"");
+        check(lines.get(1), "\"steal_ns_avg\":");
+        check(lines.get(2), "\"wisp_parks\":");
+        check(lines.get(3), "\"young_pause_ms_avg\":");
+        if (lines.get(3).contains("\"rootsScanned\":0")) {
+            throw new RuntimeException("Parked coroutines were not scanned: " + lines.get(3));
+        }
+    }
+
+    static void check(String line, String expected) {
+        if (!line.contains(expected)) {
+            throw new RuntimeException("No " + expected + " in " + line);
+        }
+    }
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+
+import java.io.File;
+import java.io.FileWriter;
+import java.io.InputStream;
+import java.io.PrintWriter;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+/**
+ * Wisp and coroutine benchmark driver. Not a jtreg test; run it with
+ * "make wispbench" in the test directory (or "make wispbench" under make/
+ * on a built JDK image), or directly:
+ *
+ *   java WispBench [-scenarios=switch,steal,monitor,monitor-handoff,roots]
+ *                  [-carriers=1,4] [-coroutines=16,1024] [-seconds=10]
+ *                  [-warmup=3] [-out=results.json] [-vmoptions="..."]
+ *                  [key=value ...]
+ *
+ * Every scenario runs once per carrier count and coroutine count in a
+ * child VM with -XX:+UseWisp2 and com.alibaba.wisp.carrierEngines set to
+ * the carrier count. monitor-handoff is the monitor scenario with
+ * -XX:+WispMonitorHandoff. The driver prints the JSON object of each run:
+ * the operation rate, the carrier time per operation, the deltas of the
+ * sun.rt.coroutine.* PerfData counters over the measurement, and values
+ * derived from them per scenario (see WispBenchWorkload). key=value
+ * arguments are passed on to the workload.
+ */
+public class WispBench {
+    static final String[] ALL_SCENARIOS = {
+        "switch", "steal", "monitor", "monitor-handoff", "roots"
+    };
+
+    public static void main(String[] args) throws Exception {
+        String[] scenarios = ALL_SCENARIOS;
+        int[] carriers = { 1, 4 };
+        int[] coroutines = { 16, 1024 };
+        int seconds = 10;
+        int warmup = 3;
+        String out = null;
+        List<String> vmOptions = new ArrayList<>();
+        List<String> params = new ArrayList<>();
+
+        for (String arg : args) {
+            if (arg.startsWith("-scenarios=")) {
+                scenarios = value(arg).split(",");
+            } else if (arg.startsWith("-carriers=")) {
+                carriers = ints(value(arg));
+            } else if (arg.startsWith("-coroutines=")) {
+                coroutines = ints(value(arg));
+            } else if (arg.startsWith("-seconds=")) {
+                seconds = Integer.parseInt(value(arg));
+            } else if (arg.startsWith("-warmup=")) {
+                warmup = Integer.parseInt(value(arg));
+            } else if (arg.startsWith("-out=")) {
+                out = value(arg);
+            } else if (arg.startsWith("-vmoptions=")) {
+                vmOptions.addAll(Arrays.asList(value(arg).trim().split("\\s+")));
+                vmOptions.remove("");
+            } else if (!arg.startsWith("-") && arg.indexOf('=') > 0) {
+                params.add(arg);
+            } else {
+                throw new IllegalArgumentException("Unknown argument: " + arg);
+            }
+        }
+
+        PrintWriter results = out == null ? null : new PrintWriter(new FileWriter(out));
+        try {
+            for (String scenario : scenarios) {
+                for (int c : carriers) {
+                    for (int n : coroutines) {
+                        String json = run(scenario, c, n, seconds, warmup, vmOptions, params);
+                        System.out.println(json);
+                        if (results != null) {
+                            results.println(json);
+                            results.flush();
+                        }
+                    }
+                }
+            }
+        } finally {
+            if (results != null) {
+                results.close();
+            }
+        }
+    }
+
+    static String value(String arg) {
+        return arg.substring(arg.indexOf('=') + 1);
+    }
+
+    static int[] ints(String list) {
+        String[] parts = list.split(",");
+        int[] values = new int[parts.length];
+        for (int i = 0; i < parts.length; i++) {
+            values[i] = Integer.parseInt(parts[i]);
+        }
+        return values;
+    }
+
+    static String run(String scenario, int carriers, int coroutines, int seconds, int warmup,
+                      List<String> vmOptions, List<String> params) throws Exception {
+        List<String> cmd = new ArrayList<>();
+        cmd.add(System.getProperty("java.home") + File.separator + "bin" + File.separator + "java");
+        cmd.add("-cp");
+        cmd.add(System.getProperty("java.class.path"));
+        cmd.add("-XX:+UnlockExperimentalVMOptions");
+        cmd.add("-XX:+UseWisp2");
+        cmd.add("-XX:+UsePerfData");
+        cmd.add("-XX:-PerfDisableSharedMem");
+        cmd.add("-Dcom.alibaba.wisp.carrierEngines=" + carriers);
+        String workload = scenario;
+        if (scenario.equals("monitor-handoff")) {
+            cmd.add("-XX:+WispMonitorHandoff");
+            workload = "monitor";
+        }
+        cmd.addAll(vmOptions);
+        cmd.add("WispBenchWorkload");
+        cmd.add(workload);
+        cmd.add(Integer.toString(carriers));
+        cmd.add(Integer.toString(coroutines));
+        cmd.add(Integer.toString(warmup));
+        cmd.add(Integer.toString(seconds));
+        cmd.addAll(params);
+
+        ProcessBuilder pb = new ProcessBuilder(cmd);
+        pb.redirectErrorStream(true);
+        Process p = pb.start();
+        String output = readFully(p.getInputStream());
+        int exit = p.waitFor();
+        if (exit != 0) {
+            throw new RuntimeException(scenario + " with " + carriers + " carriers and " + coroutines +
+                                       " coroutines exited with " + exit + ":\n" + output);
+        }
+        String json = WispBenchWorkload.parseResult(output);
+        // name the run after the driver scenario
+        return json.replace("\"scenario\":\"" + workload + "\"", "\"scenario\":\"" + scenario + "\"");
+    }
+
+    static String readFully(InputStream in) throws Exception {
+        StringBuilder sb = new StringBuilder();
+        byte[] buf = new byte[8192];
+        int n;
+        while ((n = in.read(buf)) > 0) {
+            sb.append(new String(buf, 0, n));
+        }
+        return sb.toString();
+    }
+}
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+
+import com.alibaba.wisp.engine.WispEngine;
+
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.locks.LockSupport;
+
+/**
+ * Coroutine workloads for WispBench. Usage:
+ *
+ *   java -XX:+UnlockExperimentalVMOptions -XX:+UseWisp2
+ *        -Dcom.alibaba.wisp.carrierEngines=<carriers>
+ *        WispBenchWorkload <scenario> <carriers> <coroutines>
+ *                          <warmup-seconds> <seconds> [key=value ...]
+ *
+ * The coroutines are dispatched to the carriers, run for the warmup, are
+ * joined and are dispatched again for the measurement, so that the counts
+ * of both phases are never mixed. The result is printed as one JSON object
+ * on a line starting with "wispbench: ".
+ *
+ * Scenarios and their parameters (defaults in parentheses):
+ *   switch           every coroutine yields in a loop; measures the cost of
+ *                    a context switch on a carrier
+ *   steal            coroutines of uneven work (spin 2000 iterations times
+ *                    1 to 4) sleep for sleepNanos (50000) between bursts, so
+ *                    that idle carriers steal from busy ones; measures the
+ *                    cost of stealCoroutine and of the thread/JNIEnv slots
+ *                    rewritten by WispPostStealHandleUpdateMark
+ *   monitor          coroutines increment counters under locks (1) monitors
+ *                    and yield with the monitor held every yieldEvery (64)
+ *                    acquisitions, so that monitor enter and exit go
+ *                    through the wisp park and unpark; run it with
+ *                    -XX:+WispMonitorHandoff to measure the hand-off
+ *   roots            coroutines park depth (32) frames deep while the main
+ *                    thread allocates garbage (1024) byte arrays; measures
+ *                    the young pause time and the coroutine root scanning
+ */
+public class WispBenchWorkload {
+    static final String RESULT = "wispbench: ";
+
+    static Map<String, String> params = new HashMap<>();
+    static volatile boolean stop;
+    static volatile Object sink;
+
+    static int param(String key, int def) {
+        String v = params.get(key);
+        return v == null ? def : Integer.parseInt(v);
+    }
+
+    static String parseResult(String output) {
+        int at = output.indexOf(RESULT);
+        if (at < 0) {
+            throw new RuntimeException("No result in workload output:\n" + output);
+        }
+        int end = output.indexOf('\n', at);
+        return output.substring(at + RESULT.length(), end < 0 ? output.length() : end).trim();
+    }
+
+    public static void main(String[] args) throws Exception {
+        String scenario = args[0];
+        int carriers = Integer.parseInt(args[1]);
+        int coroutines = Integer.parseInt(args[2]);
+        int warmup = Integer.parseInt(args[3]);
+        int seconds = Integer.parseInt(args[4]);
+        for (int i = 5; i < args.length; i++) {
+            int eq = args[i].indexOf('=');
+            params.put(args[i].substring(0, eq), args[i].substring(eq + 1));
+        }
+
+        PerfCounters perf = new PerfCounters();
+        Phase phase = phase(scenario, coroutines);
+        phase.run(warmup);
+
+        Map<String, Long> before = perf.snapshot(PerfCounters.COROUTINE_PREFIX);
+        long start = System.nanoTime();
+        long ops = phase.run(seconds);
+        long elapsed = System.nanoTime() - start;
+        Map<String, Long> counters = PerfCounters.delta(before, perf.snapshot(PerfCounters.COROUTINE_PREFIX));
+
+        StringBuilder sb = new StringBuilder();
+        sb.append('{');
+        sb.append("\"scenario\":\"").append(scenario).append("\",");
+        sb.append("\"carriers\":").append(carriers).append(',');
+        sb.append("\"coroutines\":").append(coroutines).append(',');
+        sb.append("\"seconds\":").append(seconds).append(',');
+        sb.append("\"ops\":").append(ops).append(',');
+        sb.append("\"ops_per_sec\":").append(fmt(ops * 1e9 / elapsed)).append(',');
+        // carrier time per operation: for switch, the cost of one switch
+        sb.append("\"ns_per_op_per_carrier\":").append(ops == 0 ? "null" : fmt((double) elapsed * carriers / ops));
+        phase.derived(sb, counters, perf.tickFrequency());
+        sb.append(",\"counters\":{");
+        boolean first = true;
+        for (Map.Entry<String, Long> e : new TreeMap<>(counters).entrySet()) {
+            sb.append(first ? "" : ",");
+            sb.append('"').append(e.getKey().substring(PerfCounters.COROUTINE_PREFIX.length()))
+              .append("\":").append(e.getValue());
+            first = false;
+        }
+        sb.append("}}");
+        System.out.println(RESULT + sb);
+    }
+
+    static String fmt(double v) {
+        return String.format("%.3f", v);
+    }
+
+    static double ticksToNanos(long ticks, long frequency) {
+        return ticks * 1e9 / frequency;
+    }
+
+    static Phase phase(String scenario, int coroutines) {
+        switch (scenario) {
+            case "switch":  return new SwitchPhase(coroutines);
+            case "steal":   return new StealPhase(coroutines);
+            case "monitor": return new MonitorPhase(coroutines);
+            case "roots":   return new RootsPhase(coroutines);
+            default: throw new IllegalArgumentException("Unknown scenario: " + scenario);
+        }
+    }
+
+    /**
+     * Dispatches one loop per coroutine, lets them run for the given time
+     * and returns the sum of the operations they counted.
+     */
+    static abstract class Phase {
+        final int coroutines;
+
+        Phase(int coroutines) {
+            this.coroutines = coroutines;
+        }
+
+        // one operation of coroutine id, returns the number of operations done
+        abstract long step(int id);
+
+        void derived(StringBuilder sb, Map<String, Long> counters, long frequency) { }
+
+        long run(int seconds) throws Exception {
+            stop = false;
+            long[] ops = new long[coroutines];
+            CountDownLatch done = new CountDownLatch(coroutines);
+            for (int i = 0; i < coroutines; i++) {
+                final int id = i;
+                WispEngine.dispatch(() -> {
+                    long n = 0;
+                    while (!stop) {
+                        n += step(id);
+                    }
+                    ops[id] = n;
+                    done.countDown();
+                });
+            }
+            Thread.sleep(seconds * 1000L);
+            stop = true;
+            done.await();
+            long total = 0;
+            for (long n : ops) {
+                total += n;
+            }
+            return total;
+        }
+    }
+
+    static class SwitchPhase extends Phase {
+        SwitchPhase(int coroutines) { super(coroutines); }
+
+        long step(int id) {
+            Thread.yield();
+            return 1;
+        }
+    }
+
+    static class StealPhase extends Phase {
+        final int spin = param("spin", 2000);
+        final long sleepNanos = param("sleepNanos", 50000);
+        volatile long sinkValue;
+
+        StealPhase(int coroutines) { super(coroutines); }
+
+        long step(int id) {
+            long v = id;
+            for (int i = 0, n = spin * (1 + id % 4); i < n; i++) {
+                v = v * 6364136223846793005L + 1442695040888963407L;
+            }
+            sinkValue = v;
+            LockSupport.parkNanos(sleepNanos);
+            return 1;
+        }
+
+        void derived(StringBuilder sb, Map<String, Long> counters, long frequency) {
+            long steals = counters.getOrDefault("sun.rt.coroutine.steals", 0L);
+            long ticks = counters.getOrDefault("sun.rt.coroutine.stealTime", 0L);
+            long handles = counters.getOrDefault("sun.rt.coroutine.stealHandles", 0L);
+            sb.append(",\"steal_ns_avg\":").append(steals == 0 ? "null" : fmt(ticksToNanos(ticks, frequency) / steals));
+            sb.append(",\"handles_per_steal\":").append(steals == 0 ? "null" : fmt((double) handles / steals));
+        }
+    }
+
+    static class MonitorPhase extends Phase {
+        final Object[] locks = new Object[param("locks", 1)];
+        final long[] counts = new long[locks.length];
+        final int yieldEvery = param("yieldEvery", 64);
+
+        MonitorPhase(int coroutines) {
+            super(coroutines);
+            for (int i = 0; i < locks.length; i++) {
+                locks[i] = new Object();
+            }
+        }
+
+        long step(int id) {
+            int l = id % locks.length;
+            synchronized (locks[l]) {
+                if (++counts[l] % yieldEvery == 0) {
+                    // switch away holding the monitor so that others queue up
+                    Thread.yield();
+                }
+            }
+            return 1;
+        }
+
+        void derived(StringBuilder sb, Map<String, Long> counters, long frequency) {
+            long parks = counters.getOrDefault("sun.rt.coroutine.wispParks", 0L);
+            sb.append(",\"wisp_parks\":").append(parks);
+        }
+    }
+
+    static class RootsPhase extends Phase {
+        final int depth = param("depth", 32);
+        final int garbage = param("garbage", 1024);
+        long youngTime;
+        long youngCount;
+
+        RootsPhase(int coroutines) { super(coroutines); }
+
+        long step(int id) {
+            throw new UnsupportedOperationException();
+        }
+
+        void park(int depth, CountDownLatch latch) throws InterruptedException {
+            if (depth > 0) {
+                park(depth - 1, latch);
+            } else {
+                latch.await();
+            }
+        }
+
+        long run(int seconds) throws Exception {
+            CountDownLatch started = new CountDownLatch(coroutines);
+            CountDownLatch done = new CountDownLatch(coroutines);
+            CountDownLatch latch = new CountDownLatch(1);
+            for (int i = 0; i < coroutines; i++) {
+                WispEngine.dispatch(() -> {
+                    started.countDown();
+                    try {
+                        park(depth, latch);
+                    } catch (InterruptedException e) {
+                        throw new RuntimeException(e);
+                    }
+                    done.countDown();
+                });
+            }
+            started.await();
+            GarbageCollectorMXBean young = ManagementFactory.getGarbageCollectorMXBeans().get(0);
+            youngCount = young.getCollectionCount();
+            youngTime = young.getCollectionTime();
+            long end = System.nanoTime() + seconds * 1000000000L;
+            while (System.nanoTime() < end) {
+                for (int i = 0; i < 1000; i++) {
+                    sink = new byte[garbage];
+                }
+            }
+            youngCount = young.getCollectionCount() - youngCount;
+            youngTime = young.getCollectionTime() - youngTime;
+            latch.countDown();
+            done.await();
+            return youngCount;
+        }
+
+        void derived(StringBuilder sb, Map<String, Long> counters, long frequency) {
+            // the first bean is the young collector, "G1 Young Generation"
+            // for G1; rootsScanTime leaves out the first chunk of each thread
+            long scanned = counters.getOrDefault("sun.rt.coroutine.rootsScanned", 0L);
+            long ticks = counters.getOrDefault("sun.rt.coroutine.rootsScanTime", 0L);
+            sb.append(",\"young_pause_ms_avg\":").append(youngCount == 0 ? "null" : fmt((double) youngTime / youngCount));
+            sb.append(",\"coroutines_scanned_per_gc\":").append(youngCount == 0 ? "null" : fmt((double) scanned / youngCount));
+            sb.append(",\"roots_scan_ms_per_gc\":")
+              .append(youngCount == 0 ? "null" : fmt(ticksToNanos(ticks, frequency) / 1e6 / youngCount));
+        }
+    }
+}
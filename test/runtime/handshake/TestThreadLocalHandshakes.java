@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Test bias revocation and stack traces of blocked threads through handshakes
+ * @run main/othervm -XX:+ThreadLocalHandshakes -XX:+UseBiasedLocking -XX:BiasedLockingStartupDelay=0 TestThreadLocalHandshakes
+ */
+import java.util.concurrent.CountDownLatch;
+
+public class TestThreadLocalHandshakes {
+  static final int THREADS = 8;
+  static final int ITERATIONS = 2000;
+
+  static class Sleeper extends Thread {
+    final Object lock = new Object();
+    final CountDownLatch started;
+    volatile boolean done;
+
+    Sleeper(CountDownLatch started) {
+      this.started = started;
+      setDaemon(true);
+    }
+
+    public void run() {
+      // Bias the lock toward this thread, then hold it while blocked.
+      synchronized (lock) { }
+      synchronized (lock) {
+        started.countDown();
+        while (!done) {
+          sleepInLock();
+        }
+      }
+    }
+
+    void sleepInLock() {
+      try {
+        Thread.sleep(1);
+      } catch (InterruptedException e) {
+      }
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    CountDownLatch started = new CountDownLatch(THREADS);
+    Sleeper[] sleepers = new Sleeper[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+      sleepers[i] = new Sleeper(started);
+      sleepers[i].start();
+    }
+    started.await();
+
+    for (int i = 0; i < ITERATIONS; i++) {
+      Sleeper s = sleepers[i % THREADS];
+      StackTraceElement[] trace = s.getStackTrace();
+      boolean found = false;
+      for (StackTraceElement e : trace) {
+        if (e.getMethodName().equals("run")) {
+          found = true;
+        }
+      }
+      if (!found) {
+        throw new RuntimeException("run() missing from stack trace of " + s.getName());
+      }
+    }
+
+    // Computing the identity hash revokes the bias toward the blocked owner.
+    for (Sleeper s : sleepers) {
+      System.identityHashCode(s.lock);
+      s.done = true;
+    }
+    for (Sleeper s : sleepers) {
+      s.join();
+    }
+  }
+}
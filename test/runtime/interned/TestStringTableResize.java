@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary The string table grows at a safepoint once its load factor exceeds
+ *          StringTableMaxLoadFactor, and interned strings keep their identity
+ * @library /testlibrary
+ * @run main TestStringTableResize
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestStringTableResize {
+  public static void main(String[] args) throws Exception {
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:StringTableSize=1009", "-XX:+PrintStringTableStatistics",
+        "TestStringTableResize$Intern");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("[StringTable resized from 1009 to 2019 buckets");
+    output.shouldContain("interned");
+    output.shouldHaveExitValue(0);
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:StringTableSize=1009", "-XX:StringTableMaxLoadFactor=0",
+        "-XX:+PrintStringTableStatistics", "TestStringTableResize$Intern");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldNotContain("[StringTable resized");
+    output.shouldHaveExitValue(0);
+  }
+
+  public static class Intern {
+    static final int COUNT = 50000;
+
+    public static void main(String[] args) throws Exception {
+      String[] interned = new String[COUNT];
+      for (int i = 0; i < COUNT; i++) {
+        interned[i] = ("interned" + i).intern();
+        if (i % 10000 == 0) {
+          System.gc();
+        }
+      }
+      System.gc();
+      for (int i = 0; i < COUNT; i++) {
+        if (("interned" + i).intern() != interned[i]) {
+          throw new RuntimeException("lost identity of interned" + i);
+        }
+      }
+      System.out.println("interned");
+    }
+  }
+}
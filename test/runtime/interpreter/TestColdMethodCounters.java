@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Methods whose MethodCounters were freed as cold, or whose
+ *          MethodData was held back by the profile rate check, keep
+ *          counting, profiling and compiling correctly
+ * @run main/othervm -XX:ReclaimColdMethodCountersInterval=1 TestColdMethodCounters
+ * @run main/othervm -XX:ReclaimColdMethodCountersInterval=1 -Xint TestColdMethodCounters
+ * @run main/othervm -XX:ReclaimColdMethodCountersInterval=1 -XX:-TieredCompilation
+ *                   -XX:InterpreterProfileMinRate=100000 TestColdMethodCounters
+ */
+public class TestColdMethodCounters {
+  static class Cold {
+    static int a(int x) { return x + 1; }
+    static int b(int x) { return x * 2; }
+  }
+
+  static class Warm {
+    static int loop(int n) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        sum += i & 7;
+      }
+      return sum;
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    for (int round = 0; round < 20; round++) {
+      // A few calls keep Cold cold, the safepoints below free its counters
+      if (Cold.a(round) != round + 1 || Cold.b(round) != round * 2) {
+        throw new RuntimeException("wrong result from Cold");
+      }
+      System.gc();
+      Thread.sleep(5);
+    }
+    int expected = Warm.loop(1000);
+    for (int i = 0; i < 20000; i++) {
+      if (Warm.loop(1000) != expected) {
+        throw new RuntimeException("wrong result from Warm");
+      }
+      if ((i & 1023) == 0) {
+        System.gc();
+      }
+    }
+  }
+}
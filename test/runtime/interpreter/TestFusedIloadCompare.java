@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Interpreted "iload; iload; if_icmp<cond>" sequences, which are
+ *          rewritten to fused bytecodes, branch the same as compiled code
+ * @run main/othervm -Xint TestFusedIloadCompare
+ * @run main/othervm -Xint -XX:-RewriteFrequentPairs TestFusedIloadCompare
+ * @run main/othervm -XX:-BackgroundCompilation TestFusedIloadCompare
+ */
+public class TestFusedIloadCompare {
+  // The long padding parameters push a and b past the locals reachable by
+  // iload_<n>, so javac emits the iload form that gets fused.
+  static int eq(long p0, long p1, int a, int b) { if (a == b) return 1; return 0; }
+  static int ne(long p0, long p1, int a, int b) { if (a != b) return 1; return 0; }
+  static int lt(long p0, long p1, int a, int b) { if (a <  b) return 1; return 0; }
+  static int ge(long p0, long p1, int a, int b) { if (a >= b) return 1; return 0; }
+  static int gt(long p0, long p1, int a, int b) { if (a >  b) return 1; return 0; }
+  static int le(long p0, long p1, int a, int b) { if (a <= b) return 1; return 0; }
+
+  // Backward branch on the fused sequence, exercising backedge counting
+  static int loop(long p0, long p1, int n) {
+    int sum = 0;
+    for (int i = 0; i < n; i++) {
+      sum += i;
+    }
+    return sum;
+  }
+
+  static final int[] VALUES = { Integer.MIN_VALUE, -2, -1, 0, 1, 2, Integer.MAX_VALUE };
+
+  public static void main(String[] args) {
+    for (int iter = 0; iter < 20000; iter++) {
+      for (int a : VALUES) {
+        for (int b : VALUES) {
+          check("eq", eq(0, 0, a, b), a == b);
+          check("ne", ne(0, 0, a, b), a != b);
+          check("lt", lt(0, 0, a, b), a <  b);
+          check("ge", ge(0, 0, a, b), a >= b);
+          check("gt", gt(0, 0, a, b), a >  b);
+          check("le", le(0, 0, a, b), a <= b);
+        }
+      }
+    }
+    for (int n = 0; n < 2000; n++) {
+      if (loop(0, 0, n) != n * (n - 1) / 2) {
+        throw new RuntimeException("loop(" + n + ") = " + loop(0, 0, n));
+      }
+    }
+  }
+
+  static void check(String op, int result, boolean expected) {
+    if ((result == 1) != expected) {
+      throw new RuntimeException(op + " returned " + result);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * Native support for GlobalRefStripes test.
+ */
+
+#include <stdint.h>
+#include "jni.h"
+
+JNIEXPORT jlong JNICALL
+Java_GlobalRefStripes_newGlobal(JNIEnv* env, jclass clazz, jobject o) {
+  return (jlong)(intptr_t)(*env)->NewGlobalRef(env, o);
+}
+
+JNIEXPORT jlong JNICALL
+Java_GlobalRefStripes_newWeak(JNIEnv* env, jclass clazz, jobject o) {
+  return (jlong)(intptr_t)(*env)->NewWeakGlobalRef(env, o);
+}
+
+JNIEXPORT jobject JNICALL
+Java_GlobalRefStripes_resolve(JNIEnv* env, jclass clazz, jlong ref) {
+  return (*env)->NewLocalRef(env, (jobject)(intptr_t)ref);
+}
+
+JNIEXPORT void JNICALL
+Java_GlobalRefStripes_deleteGlobal(JNIEnv* env, jclass clazz, jlong ref) {
+  (*env)->DeleteGlobalRef(env, (jobject)(intptr_t)ref);
+}
+
+JNIEXPORT void JNICALL
+Java_GlobalRefStripes_deleteWeak(JNIEnv* env, jclass clazz, jlong ref) {
+  (*env)->DeleteWeakGlobalRef(env, (jweak)(intptr_t)ref);
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+public class GlobalRefStripes {
+  static {
+    System.loadLibrary("GlobalRefStripes");
+  }
+
+  static final int THREADS = 16;
+  static final int REFS = 2000;
+  static final int ROUNDS = 10;
+
+  static native long newGlobal(Object o);
+  static native long newWeak(Object o);
+  static native Object resolve(long ref);
+  static native void deleteGlobal(long ref);
+  static native void deleteWeak(long ref);
+
+  static volatile boolean done;
+
+  public static void main(String[] args) throws Exception {
+    Thread gc = new Thread() {
+      public void run() {
+        while (!done) {
+          System.gc();
+          try {
+            Thread.sleep(5);
+          } catch (InterruptedException e) {
+            return;
+          }
+        }
+      }
+    };
+    gc.start();
+
+    final Throwable[] failure = new Throwable[1];
+    Thread[] threads = new Thread[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+      threads[t] = new Thread() {
+        public void run() {
+          try {
+            for (int r = 0; r < ROUNDS; r++) {
+              round();
+            }
+          } catch (Throwable e) {
+            synchronized (failure) {
+              failure[0] = e;
+            }
+          }
+        }
+      };
+      threads[t].start();
+    }
+    for (Thread t : threads) {
+      t.join();
+    }
+    done = true;
+    gc.join();
+    if (failure[0] != null) {
+      throw new RuntimeException("test failed", failure[0]);
+    }
+  }
+
+  static void round() {
+    Object[] objs = new Object[REFS];
+    long[] globals = new long[REFS];
+    long[] weaks = new long[REFS];
+    for (int i = 0; i < REFS; i++) {
+      // Only the global ref keeps odd objects alive.
+      Object o = new int[] { i };
+      if ((i & 1) == 0) {
+        objs[i] = o;
+      }
+      globals[i] = newGlobal(o);
+      weaks[i] = newWeak(o);
+    }
+    System.gc();
+    for (int i = 0; i < REFS; i++) {
+      int[] g = (int[]) resolve(globals[i]);
+      if (g == null || g[0] != i) {
+        throw new RuntimeException("global ref " + i + " lost its referent");
+      }
+      if (resolve(weaks[i]) != g) {
+        throw new RuntimeException("weak ref " + i + " cleared while strongly reachable");
+      }
+      if ((i & 1) == 0 && objs[i] != g) {
+        throw new RuntimeException("global ref " + i + " resolves to another object");
+      }
+      deleteGlobal(globals[i]);
+    }
+    objs = null;
+    for (int i = 0; i < REFS; i++) {
+      deleteWeak(weaks[i]);
+    }
+  }
+}
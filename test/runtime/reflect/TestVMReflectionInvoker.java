@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Reflective calls stay on the VM invoker and select the right
+ *          interface, default and virtual targets
+ * @run main/othervm -XX:+UseVMReflectionInvoker TestVMReflectionInvoker
+ * @run main/othervm -XX:+UseVMReflectionInvoker -Dsun.reflect.inflationThreshold=3 TestVMReflectionInvoker 3
+ */
+
+import java.lang.reflect.Constructor;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+
+public class TestVMReflectionInvoker {
+  public interface Shape {
+    int area();
+    default String name() { return "shape"; }
+  }
+
+  public interface Abstract {
+    int missing();
+  }
+
+  public static class Square implements Shape {
+    final int side;
+    public Square(int side) { this.side = side; }
+    public int area() { return side * side; }
+    public String name() { return "square"; }
+  }
+
+  public static class Rect implements Shape {
+    public int area() { return 6; }
+  }
+
+  public static class Base {
+    public long scale(long x, int factor) { return x * factor; }
+  }
+
+  public static class Derived extends Base {
+    public long scale(long x, int factor) { return -x * factor; }
+  }
+
+  public static void main(String[] args) throws Exception {
+    String expected = args.length > 0 ? args[0] : "2147483647";
+    String threshold = System.getProperty("sun.reflect.inflationThreshold");
+    if (!expected.equals(threshold)) {
+      throw new RuntimeException("unexpected inflation threshold " + threshold);
+    }
+
+    Method area = Shape.class.getMethod("area");
+    Method name = Shape.class.getMethod("name");
+    Method scale = Base.class.getMethod("scale", long.class, int.class);
+    Constructor<Square> ctor = Square.class.getConstructor(int.class);
+    Shape rect = new Rect();
+
+    for (int i = 0; i < 1000; i++) {
+      Square sq = ctor.newInstance(i);
+      check(area.invoke(sq), i * i);
+      check(area.invoke(rect), 6);
+      check(name.invoke(sq), "square");
+      check(name.invoke(rect), "shape");
+      check(scale.invoke(new Base(), (long) i, 3), (long) i * 3);
+      check(scale.invoke(new Derived(), (long) i, (short) 3), (long) -i * 3);
+    }
+
+    try {
+      area.invoke(new Object());
+      throw new RuntimeException("IllegalArgumentException expected");
+    } catch (IllegalArgumentException e) {
+      // expected
+    }
+
+    Method missing = Abstract.class.getMethod("missing");
+    Object partial = java.lang.reflect.Proxy.newProxyInstance(
+        TestVMReflectionInvoker.class.getClassLoader(), new Class<?>[] { Abstract.class },
+        (proxy, m, a) -> { throw new IllegalStateException("from proxy"); });
+    try {
+      missing.invoke(partial);
+      throw new RuntimeException("InvocationTargetException expected");
+    } catch (InvocationTargetException e) {
+      Throwable cause = e.getCause();
+      if (!(cause instanceof IllegalStateException)) {
+        throw new RuntimeException("unexpected cause " + cause);
+      }
+    }
+  }
+
+  static void check(Object actual, Object expected) {
+    if (!expected.equals(actual)) {
+      throw new RuntimeException("expected " + expected + " but got " + actual);
+    }
+  }
+}
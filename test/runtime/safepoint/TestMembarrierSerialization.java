@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Safepoints with thread states serialized by membarrier(2)
+ * @library /testlibrary
+ * @run main/othervm -XX:-UseMembar -XX:+UseMembarrierSerialization TestMembarrierSerialization
+ * @run main/othervm -XX:-UseMembar -XX:+UseMembarrierSerialization -Xint TestMembarrierSerialization
+ */
+public class TestMembarrierSerialization {
+  static final int THREADS = 8;
+  static volatile boolean done;
+  static volatile long sink;
+
+  public static void main(String[] args) throws Exception {
+    Thread[] threads = new Thread[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+      threads[i] = new Thread() {
+        public void run() {
+          long n = 0;
+          while (!done) {
+            // Native calls go through the thread state transitions
+            // the safepoint has to see.
+            n += System.nanoTime() + System.identityHashCode(new Object());
+            if ((n & 0xff) == 0) {
+              Thread.yield();
+            }
+          }
+          sink = n;
+        }
+      };
+      threads[i].start();
+    }
+    for (int i = 0; i < 50; i++) {
+      System.gc();
+      Thread.sleep(10);
+    }
+    done = true;
+    for (Thread t : threads) {
+      t.join();
+    }
+  }
+}
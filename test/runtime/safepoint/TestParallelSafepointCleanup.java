@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Test that safepoint cleanup runs on the GC workers with -XX:+ParallelSafepointCleanup
+ * @library /testlibrary
+ * @run main TestParallelSafepointCleanup
+ */
+import com.oracle.java.testlibrary.*;
+
+public class TestParallelSafepointCleanup {
+  public static void main(String[] args) throws Exception {
+    String[] gcs = { "-XX:+UseG1GC", "-XX:+UseConcMarkSweepGC" };
+    for (String gc : gcs) {
+      ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(gc,
+                                                                "-XX:ParallelGCThreads=4",
+                                                                "-XX:+ParallelSafepointCleanup",
+                                                                "-XX:+TraceSafepointCleanupTime",
+                                                                GCTest.class.getName());
+      OutputAnalyzer out = new OutputAnalyzer(pb.start());
+      out.shouldHaveExitValue(0);
+      out.shouldContain("parallel safepoint cleanup");
+    }
+  }
+
+  static class GCTest {
+    public static void main(String[] args) {
+      Object[] locks = new Object[1000];
+      for (int i = 0; i < locks.length; i++) {
+        locks[i] = new Object();
+        // Inflate the monitor so that deflation has work to do.
+        synchronized (locks[i]) {
+          locks[i].hashCode();
+        }
+      }
+      System.gc();
+    }
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary Safepoints reach threads spinning in interpreted, C1 and C2
+ *          compiled loops through thread local poll words
+ * @run main/othervm -XX:+ThreadLocalSafepointPolls TestThreadLocalSafepointPolls
+ * @run main/othervm -XX:+ThreadLocalSafepointPolls -Xint TestThreadLocalSafepointPolls
+ * @run main/othervm -XX:+ThreadLocalSafepointPolls -XX:TieredStopAtLevel=1 TestThreadLocalSafepointPolls
+ * @run main/othervm -XX:+ThreadLocalSafepointPolls -XX:-TieredCompilation TestThreadLocalSafepointPolls
+ */
+public class TestThreadLocalSafepointPolls {
+  static final int THREADS = 4;
+  static volatile boolean done;
+  static volatile long sink;
+
+  // A counted loop without calls, only its safepoint poll stops it.
+  static long spin(int[] values) {
+    long sum = 0;
+    for (int i = 0; i < values.length; i++) {
+      sum += values[i] * 31 + i;
+    }
+    return sum;
+  }
+
+  // Returns poll on the way out of every call.
+  static int depth(int n) {
+    return n == 0 ? 0 : depth(n - 1) + 1;
+  }
+
+  public static void main(String[] args) throws Exception {
+    final int[] values = new int[100000];
+    for (int i = 0; i < values.length; i++) {
+      values[i] = i;
+    }
+    Thread[] threads = new Thread[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+      threads[i] = new Thread() {
+        public void run() {
+          long n = 0;
+          while (!done) {
+            n += spin(values) + depth(100);
+          }
+          sink = n;
+        }
+      };
+      threads[i].start();
+    }
+    for (int i = 0; i < 50; i++) {
+      System.gc();
+      Thread.sleep(10);
+    }
+    done = true;
+    for (Thread t : threads) {
+      t.join();
+    }
+  }
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.io.File;
+import java.lang.management.ManagementFactory;
+import java.lang.reflect.Method;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.function.IntUnaryOperator;
+
+/**
+ * The synthetic application of StartupBench. Usage:
+ *
+ *   java StartupApp <classes> <lambda-classes> <plugins> <loaders>
+ *                   <plugins-dir> <batches> <batch-size> <min-run-seconds>
+ *
+ * Initialization loads and instantiates all generated classes by
+ * reflection, links all lambdas and loads the plugins with <loaders>
+ * class loaders of their own. A request calls every operator once; the
+ * application serves <batches> batches of <batch-size> requests and then
+ * keeps serving until it ran for <min-run-seconds> (for JWarmUp
+ * recording). Times are printed as "startup: ..." lines, in milliseconds
+ * of VM uptime:
+ *
+ *   startup: main <uptime>
+ *   startup: init <uptime> <duration>
+ *   startup: first-request <uptime> <duration>
+ *   startup: batch <index> <uptime> <duration>
+ */
+public class StartupApp {
+    static volatile int sink;
+
+    static double uptime() {
+        return ManagementFactory.getRuntimeMXBean().getUptime();
+    }
+
+    public static void main(String[] args) throws Exception {
+        System.out.println("startup: main " + uptime());
+        int classes = Integer.parseInt(args[0]);
+        int lambdaClasses = Integer.parseInt(args[1]);
+        int plugins = Integer.parseInt(args[2]);
+        int loaders = Integer.parseInt(args[3]);
+        File pluginsDir = new File(args[4]);
+        int batches = Integer.parseInt(args[5]);
+        int batchSize = Integer.parseInt(args[6]);
+        int minRunSeconds = Integer.parseInt(args[7]);
+
+        long start = System.nanoTime();
+        List<IntUnaryOperator> ops = new ArrayList<>();
+        for (int i = 0; i < classes; i++) {
+            Class<?> c = Class.forName("startupapp.Cls" + i);
+            ops.add((IntUnaryOperator)c.newInstance());
+        }
+        for (int j = 0; j < lambdaClasses; j++) {
+            Method m = Class.forName("startupapp.Lambdas" + j).getMethod("ops");
+            for (IntUnaryOperator op : (IntUnaryOperator[])m.invoke(null)) {
+                ops.add(op);
+            }
+        }
+        URL[] urls = { pluginsDir.toURI().toURL() };
+        for (int l = 0; l < loaders; l++) {
+            ClassLoader loader = new URLClassLoader(urls, StartupApp.class.getClassLoader());
+            for (int k = 0; k < plugins; k++) {
+                ops.add((IntUnaryOperator)loader.loadClass("plugin.Plugin" + k).newInstance());
+            }
+        }
+        IntUnaryOperator[] all = ops.toArray(new IntUnaryOperator[0]);
+        System.out.println("startup: init " + uptime() + " " + millis(start));
+
+        notifyJWarmUp();
+
+        start = System.nanoTime();
+        request(all, 0);
+        System.out.println("startup: first-request " + uptime() + " " + millis(start));
+
+        long deadline = System.nanoTime() + minRunSeconds * 1000000000L;
+        for (int b = 0; b < batches || System.nanoTime() < deadline; b++) {
+            start = System.nanoTime();
+            for (int r = 0; r < batchSize; r++) {
+                request(all, r);
+            }
+            if (b < batches) {
+                System.out.println("startup: batch " + b + " " + uptime() + " " + millis(start));
+            }
+        }
+    }
+
+    static double millis(long startNanos) {
+        return (System.nanoTime() - startNanos) / 1000000.0;
+    }
+
+    static void request(IntUnaryOperator[] ops, int x) {
+        int acc = x;
+        for (IntUnaryOperator op : ops) {
+            acc += op.applyAsInt(acc);
+        }
+        sink = acc;
+    }
+
+    // With -XX:+CompilationWarmUp, compilation of the recorded methods
+    // starts once the application says its startup is done.
+    static void notifyJWarmUp() {
+        if (!ManagementFactory.getRuntimeMXBean().getInputArguments().contains("-XX:+CompilationWarmUp")) {
+            return;
+        }
+        try {
+            Class.forName("com.alibaba.jwarmup.JWarmUp").getMethod("notifyApplicationStartUpIsDone").invoke(null);
+        } catch (Exception e) {
+            throw new RuntimeException(e);
+        }
+    }
+}
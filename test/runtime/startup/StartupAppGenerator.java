@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.io.File;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import javax.tools.JavaCompiler;
+import javax.tools.ToolProvider;
+
+/**
+ * Writes and compiles the synthetic application that StartupApp runs:
+ *
+ *   app/startupapp/Cls<i>      classes, instantiated reflectively, each an
+ *                              IntUnaryOperator with a few methods
+ *   app/startupapp/Lambdas<j>  classes with ten lambdas each
+ *   plugins/plugin/Plugin<k>   classes loaded by every custom class loader
+ */
+public class StartupAppGenerator {
+    static final int LAMBDAS_PER_CLASS = 10;
+
+    final File dir;
+    final int classes;
+    final int lambdaClasses;
+    final int plugins;
+
+    StartupAppGenerator(File dir, int classes, int lambdaClasses, int plugins) {
+        this.dir = dir;
+        this.classes = classes;
+        this.lambdaClasses = lambdaClasses;
+        this.plugins = plugins;
+    }
+
+    File appDir()     { return new File(dir, "app"); }
+    File pluginsDir() { return new File(dir, "plugins"); }
+
+    void generate() throws IOException {
+        List<File> appSources = new ArrayList<>();
+        File src = new File(dir, "src");
+        for (int i = 0; i < classes; i++) {
+            appSources.add(write(src, "startupapp", "Cls" + i,
+                "public class Cls" + i + " implements java.util.function.IntUnaryOperator {\n" +
+                "    static final int SEED = " + (i * 2654435761L % 1000003) + ";\n" +
+                "    int state = SEED;\n" +
+                "    public int applyAsInt(int x) { return mix(x) + step(x); }\n" +
+                "    int mix(int x) { state = state * 31 + x; return state ^ (state >>> 7); }\n" +
+                "    static int step(int x) { return x < 0 ? -x : x + " + i + "; }\n" +
+                "    public String toString() { return \"Cls" + i + "\" + state; }\n" +
+                "}\n"));
+        }
+        for (int j = 0; j < lambdaClasses; j++) {
+            StringBuilder sb = new StringBuilder();
+            sb.append("public class Lambdas").append(j).append(" {\n");
+            sb.append("    public static java.util.function.IntUnaryOperator[] ops() {\n");
+            sb.append("        return new java.util.function.IntUnaryOperator[] {\n");
+            for (int k = 0; k < LAMBDAS_PER_CLASS; k++) {
+                sb.append("            x -> x * ").append(j * LAMBDAS_PER_CLASS + k + 3).append(" + ").append(k).append(",\n");
+            }
+            sb.append("        };\n    }\n}\n");
+            appSources.add(write(src, "startupapp", "Lambdas" + j, sb.toString()));
+        }
+        compile(appSources, appDir());
+
+        List<File> pluginSources = new ArrayList<>();
+        File psrc = new File(dir, "plugin-src");
+        for (int k = 0; k < plugins; k++) {
+            pluginSources.add(write(psrc, "plugin", "Plugin" + k,
+                "public class Plugin" + k + " implements java.util.function.IntUnaryOperator {\n" +
+                "    public int applyAsInt(int x) { return (x ^ " + k + ") * 17; }\n" +
+                "}\n"));
+        }
+        compile(pluginSources, pluginsDir());
+    }
+
+    static File write(File src, String pkg, String name, String body) throws IOException {
+        File d = new File(src, pkg);
+        d.mkdirs();
+        File f = new File(d, name + ".java");
+        FileWriter w = new FileWriter(f);
+        try {
+            w.write("package " + pkg + ";\n\n" + body);
+        } finally {
+            w.close();
+        }
+        return f;
+    }
+
+    static void compile(List<File> sources, File out) throws IOException {
+        out.mkdirs();
+        JavaCompiler javac = ToolProvider.getSystemJavaCompiler();
+        if (javac == null) {
+            throw new IOException("No system Java compiler; run the benchmark on a JDK");
+        }
+        List<String> args = new ArrayList<>();
+        args.add("-nowarn");
+        args.add("-d");
+        args.add(out.getPath());
+        for (File f : sources) {
+            args.add(f.getPath());
+        }
+        if (javac.run(null, null, null, args.toArray(new String[0])) != 0) {
+            throw new IOException("Compiling the synthetic application failed");
+        }
+    }
+}
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.PrintWriter;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Deque;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/**
+ * Startup benchmark driver. Not a jtreg test; run it with
+ * "make startupbench" in the test directory (or under make/ on a built
+ * JDK image), or directly:
+ *
+ *   java StartupBench [-modes=nocds,cds,appcds,jwarmup-baseline,jwarmup]
+ *                     [-runs=5] [-classes=2000] [-lambdas=100] [-plugins=200]
+ *                     [-loaders=4] [-batches=50] [-batch-size=200]
+ *                     [-record-seconds=20] [-dir=startup-bench]
+ *                     [-out=results.json] [-vmoptions="..."]
+ *
+ * The driver generates a synthetic application (see StartupAppGenerator),
+ * then for every mode prepares what the mode needs and runs the
+ * application -runs times with -XX:+TraceStartupTime:
+ *
+ *   nocds             -Xshare:off
+ *   cds               a shared archive of the default class list
+ *   appcds            an archive of the classes loaded by a training run
+ *                     (-XX:ArchiveClassesAtExit; only boot classes can be
+ *                     archived on this VM)
+ *   jwarmup-baseline  -XX:-TieredCompilation without CDS, the baseline of
+ *   jwarmup           replaying a JWarmUp profile recorded by a training run
+ *
+ * One JSON object is printed per mode with medians over the runs: the VM
+ * startup phases printed by TraceStartupTime, the uptime at main, the
+ * application init time, the uptime when the first request completed,
+ * the warmup curve (uptime and duration of every batch of requests) and
+ * the time to peak, i.e. the uptime of the first batch within 10% of the
+ * fastest batch.
+ */
+public class StartupBench {
+    static final String[] ALL_MODES = { "nocds", "cds", "appcds", "jwarmup-baseline", "jwarmup" };
+
+    static int runs = 5;
+    static int classes = 2000;
+    static int lambdas = 100;
+    static int plugins = 200;
+    static int loaders = 4;
+    static int batches = 50;
+    static int batchSize = 200;
+    static int recordSeconds = 20;
+    static File dir = new File("startup-bench");
+    static List<String> vmOptions = new ArrayList<>();
+    static StartupAppGenerator app;
+
+    public static void main(String[] args) throws Exception {
+        String[] modes = ALL_MODES;
+        String out = null;
+        for (String arg : args) {
+            String v = arg.substring(arg.indexOf('=') + 1);
+            if (arg.startsWith("-modes="))               modes = v.split(",");
+            else if (arg.startsWith("-runs="))           runs = Integer.parseInt(v);
+            else if (arg.startsWith("-classes="))        classes = Integer.parseInt(v);
+            else if (arg.startsWith("-lambdas="))        lambdas = Integer.parseInt(v);
+            else if (arg.startsWith("-plugins="))        plugins = Integer.parseInt(v);
+            else if (arg.startsWith("-loaders="))        loaders = Integer.parseInt(v);
+            else if (arg.startsWith("-batches="))        batches = Integer.parseInt(v);
+            else if (arg.startsWith("-batch-size="))     batchSize = Integer.parseInt(v);
+            else if (arg.startsWith("-record-seconds=")) recordSeconds = Integer.parseInt(v);
+            else if (arg.startsWith("-dir="))            dir = new File(v);
+            else if (arg.startsWith("-out="))            out = v;
+            else if (arg.startsWith("-vmoptions=")) {
+                vmOptions.addAll(Arrays.asList(v.trim().split("\\s+")));
+                vmOptions.remove("");
+            } else {
+                throw new IllegalArgumentException("Unknown argument: " + arg);
+            }
+        }
+
+        app = new StartupAppGenerator(dir, classes, lambdas, plugins);
+        app.generate();
+
+        PrintWriter results = out == null ? null : new PrintWriter(new FileWriter(out));
+        try {
+            for (String mode : modes) {
+                List<String> options = prepare(mode);
+                List<Run> measured = new ArrayList<>();
+                for (int r = 0; r < runs; r++) {
+                    measured.add(run(options, 0));
+                }
+                String json = toJson(mode, measured);
+                System.out.println(json);
+                if (results != null) {
+                    results.println(json);
+                    results.flush();
+                }
+            }
+        } finally {
+            if (results != null) {
+                results.close();
+            }
+        }
+    }
+
+    // Runs the training or dump step of a mode; returns the options of
+    // the measured runs.
+    static List<String> prepare(String mode) throws Exception {
+        switch (mode) {
+            case "nocds":
+                return Arrays.asList("-Xshare:off");
+            case "cds": {
+                String jsa = new File(dir, "base.jsa").getPath();
+                exec(java("-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=" + jsa, "-Xshare:dump"));
+                return Arrays.asList("-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=" + jsa, "-Xshare:on");
+            }
+            case "appcds": {
+                String jsa = new File(dir, "app.jsa").getPath();
+                run(Arrays.asList("-XX:ArchiveClassesAtExit=" + jsa), 0);
+                return Arrays.asList("-XX:+UnlockDiagnosticVMOptions", "-XX:SharedArchiveFile=" + jsa, "-Xshare:on");
+            }
+            case "jwarmup-baseline":
+                return Arrays.asList("-XX:-TieredCompilation", "-XX:-UseSharedSpaces");
+            case "jwarmup": {
+                String log = new File(dir, "jwarmup.log").getPath();
+                new File(log).delete();
+                run(Arrays.asList("-XX:-TieredCompilation", "-XX:-UseSharedSpaces", "-XX:-ClassUnloading",
+                                  "-XX:+CompilationWarmUpRecording",
+                                  "-XX:CompilationWarmUpLogfile=" + log,
+                                  "-XX:CompilationWarmUpRecordTime=" + recordSeconds),
+                    recordSeconds + 5);
+                if (!new File(log).exists()) {
+                    throw new RuntimeException("JWarmUp recording wrote no profile");
+                }
+                return Arrays.asList("-XX:-TieredCompilation", "-XX:-UseSharedSpaces",
+                                     "-XX:+CompilationWarmUp", "-XX:CompilationWarmUpLogfile=" + log);
+            }
+            default:
+                throw new IllegalArgumentException("Unknown mode: " + mode);
+        }
+    }
+
+    static List<String> java(String... args) {
+        List<String> cmd = new ArrayList<>();
+        cmd.add(System.getProperty("java.home") + File.separator + "bin" + File.separator + "java");
+        cmd.addAll(Arrays.asList(args));
+        return cmd;
+    }
+
+    static String exec(List<String> cmd) throws Exception {
+        ProcessBuilder pb = new ProcessBuilder(cmd);
+        pb.redirectErrorStream(true);
+        Process p = pb.start();
+        StringBuilder sb = new StringBuilder();
+        BufferedReader r = new BufferedReader(new InputStreamReader(p.getInputStream()));
+        for (String line = r.readLine(); line != null; line = r.readLine()) {
+            sb.append(line).append('\n');
+        }
+        int exit = p.waitFor();
+        if (exit != 0) {
+            throw new RuntimeException(cmd + " exited with " + exit + ":\n" + sb);
+        }
+        return sb.toString();
+    }
+
+    static Run run(List<String> options, int minRunSeconds) throws Exception {
+        List<String> cmd = java();
+        cmd.addAll(options);
+        cmd.addAll(vmOptions);
+        cmd.add("-XX:+TraceStartupTime");
+        cmd.add("-cp");
+        cmd.add(app.appDir().getPath() + File.pathSeparator + System.getProperty("java.class.path"));
+        cmd.add("StartupApp");
+        cmd.addAll(Arrays.asList(Integer.toString(classes), Integer.toString(lambdas),
+                                 Integer.toString(plugins), Integer.toString(loaders),
+                                 app.pluginsDir().getPath(), Integer.toString(batches),
+                                 Integer.toString(batchSize), Integer.toString(minRunSeconds)));
+        return Run.parse(exec(cmd));
+    }
+
+    static class Run {
+        static final Pattern CLOSE = Pattern.compile(", (\\d+\\.\\d+) secs\\]");
+
+        final Map<String, Double> vmPhases = new LinkedHashMap<>();   // ms
+        final List<double[]> batchList = new ArrayList<>();           // uptime, duration
+        double main, init, firstRequest;
+
+        static Run parse(String output) {
+            Run run = new Run();
+            run.parseTimers(output);
+            for (String line : output.split("\n")) {
+                if (!line.startsWith("startup: ")) {
+                    continue;
+                }
+                String[] f = line.split(" ");
+                switch (f[1]) {
+                    case "main":          run.main = Double.parseDouble(f[2]); break;
+                    case "init":          run.init = Double.parseDouble(f[3]); break;
+                    case "first-request": run.firstRequest = Double.parseDouble(f[2]); break;
+                    case "batch":
+                        run.batchList.add(new double[] { Double.parseDouble(f[3]), Double.parseDouble(f[4]) });
+                        break;
+                }
+            }
+            return run;
+        }
+
+        // TraceStartupTime prints "[Title" when a phase starts and
+        // ", <secs> secs]" when it ends; phases nest.
+        void parseTimers(String text) {
+            Deque<String> open = new ArrayDeque<>();
+            Matcher close = CLOSE.matcher(text);
+            int i = 0;
+            while (i < text.length()) {
+                char c = text.charAt(i);
+                if (c == '[') {
+                    int j = i + 1;
+                    while (j < text.length() && "[],\n".indexOf(text.charAt(j)) < 0) {
+                        j++;
+                    }
+                    if (j < text.length() && (text.charAt(j) == '[' ||
+                        (text.charAt(j) == ',' && close.region(j, text.length()).lookingAt()))) {
+                        open.push(text.substring(i + 1, j).trim());
+                    }
+                    i = j;
+                } else if (c == ',' && close.region(i, text.length()).lookingAt()) {
+                    if (!open.isEmpty()) {
+                        String title = open.pop();
+                        Double prev = vmPhases.get(title);
+                        double ms = Double.parseDouble(close.group(1)) * 1000.0;
+                        vmPhases.put(title, prev == null ? ms : prev + ms);
+                    }
+                    i = close.end();
+                } else {
+                    i++;
+                }
+            }
+        }
+    }
+
+    static double median(List<Double> values) {
+        List<Double> sorted = new ArrayList<>(values);
+        Collections.sort(sorted);
+        int n = sorted.size();
+        return n == 0 ? 0 : (n % 2 == 1 ? sorted.get(n / 2) : (sorted.get(n / 2 - 1) + sorted.get(n / 2)) / 2);
+    }
+
+    static String num(double v) {
+        return String.format("%.3f", v);
+    }
+
+    static String toJson(String mode, List<Run> measured) {
+        StringBuilder sb = new StringBuilder();
+        sb.append("{\"mode\":\"").append(mode).append("\",\"runs\":").append(measured.size());
+
+        sb.append(",\"vm_phases_ms\":{");
+        boolean first = true;
+        for (String phase : measured.get(0).vmPhases.keySet()) {
+            List<Double> v = new ArrayList<>();
+            for (Run r : measured) {
+                if (r.vmPhases.containsKey(phase)) {
+                    v.add(r.vmPhases.get(phase));
+                }
+            }
+            sb.append(first ? "" : ",").append('"').append(phase.replace("\"", "\\\"")).append("\":").append(num(median(v)));
+            first = false;
+        }
+        sb.append('}');
+
+        List<Double> main = new ArrayList<>(), init = new ArrayList<>(), firstRequest = new ArrayList<>();
+        for (Run r : measured) {
+            main.add(r.main);
+            init.add(r.init);
+            firstRequest.add(r.firstRequest);
+        }
+        sb.append(",\"main_uptime_ms\":").append(num(median(main)));
+        sb.append(",\"app_init_ms\":").append(num(median(init)));
+        sb.append(",\"first_request_uptime_ms\":").append(num(median(firstRequest)));
+
+        // Median warmup curve over the runs, batch by batch.
+        int n = Integer.MAX_VALUE;
+        for (Run r : measured) {
+            n = Math.min(n, r.batchList.size());
+        }
+        double[][] curve = new double[n][2];
+        double fastest = Double.MAX_VALUE;
+        for (int b = 0; b < n; b++) {
+            List<Double> up = new ArrayList<>(), dur = new ArrayList<>();
+            for (Run r : measured) {
+                up.add(r.batchList.get(b)[0]);
+                dur.add(r.batchList.get(b)[1]);
+            }
+            curve[b][0] = median(up);
+            curve[b][1] = median(dur);
+            fastest = Math.min(fastest, curve[b][1]);
+        }
+        double peak = 0;
+        for (int b = 0; b < n; b++) {
+            if (curve[b][1] <= fastest * 1.1) {
+                peak = curve[b][0];
+                break;
+            }
+        }
+        sb.append(",\"time_to_peak_uptime_ms\":").append(num(peak));
+        sb.append(",\"peak_batch_ms\":").append(num(n == 0 ? 0 : fastest));
+        sb.append(",\"warmup_curve\":[");
+        for (int b = 0; b < n; b++) {
+            sb.append(b == 0 ? "" : ",").append('[').append(num(curve[b][0])).append(',').append(num(curve[b][1])).append(']');
+        }
+        sb.append("]}");
+        return sb.toString();
+    }
+}
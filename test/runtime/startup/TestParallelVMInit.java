@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary StubRoutines generated on a helper thread with ParallelVMInit
+ * @library /testlibrary
+ * @run main TestParallelVMInit
+ */
+
+import com.oracle.java.testlibrary.*;
+
+import java.util.Arrays;
+import java.util.zip.CRC32;
+
+public class TestParallelVMInit {
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            // uses the arraycopy and math stubs once compiled
+            long sum = 0;
+            int[] src = new int[1000];
+            int[] dst = new int[1000];
+            for (int i = 0; i < 20000; i++) {
+                src[i % src.length] = i;
+                System.arraycopy(src, 0, dst, 0, src.length);
+                sum += dst[i % dst.length] + (long) Math.sqrt(i);
+            }
+            CRC32 crc = new CRC32();
+            crc.update(Arrays.copyOf(new byte[] { 1, 2, 3 }, 64));
+            System.out.println("result " + sum + " " + crc.getValue());
+            return;
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+ParallelVMInit", "-XX:+TraceStartupTime", "TestParallelVMInit", "run");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("[StubRoutines generation 2 (background), ");
+        output.shouldContain("[StubRoutines generation 2 wait");
+        output.shouldContain("result ");
+        String expected = output.firstMatch("result .*");
+
+        // the same result when the stubs are generated on the main thread
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:-ParallelVMInit", "-XX:+TraceStartupTime", "TestParallelVMInit", "run");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldNotContain("(background)");
+        output.shouldContain("[StubRoutines generation 2, ");
+        output.shouldContain(expected);
+
+        // JVMTI agents keep the stub generation on the main thread
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+ParallelVMInit", "-XX:+TraceStartupTime", "-agentlib:jdwp=transport=dt_socket,server=y,suspend=n", "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldNotContain("(background)");
+    }
+}
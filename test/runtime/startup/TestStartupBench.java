@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test TestStartupBench.java
+ * @summary Smoke test of the startup benchmark harness and of TraceStartupTime
+ * @build StartupBench StartupApp StartupAppGenerator
+ * @run main/othervm/timeout=600 TestStartupBench
+ */
+
+import java.io.File;
+import java.nio.file.Files;
+import java.util.List;
+
+public class TestStartupBench {
+    public static void main(String[] args) throws Exception {
+        StartupBench.Run run = StartupBench.Run.parse(
+            "[Create VM[Initialize global modules[Universe initialization[Genesis, 0.0010000 secs]\n" +
+            ", 0.0050000 secs]\n" +
+            "[JitWarmUp] not a timer\n" +
+            ", 0.0200000 secs]\n" +
+            "[Interpreter generation, 0.0020000 secs]\n" +
+            "[Interpreter generation, 0.0010000 secs]\n" +
+            ", 0.1000000 secs]\n" +
+            "startup: main 120.0\n" +
+            "startup: init 150.0 25.5\n" +
+            "startup: first-request 160.0 3.0\n" +
+            "startup: batch 0 170.0 9.0\n");
+        check(near(run.vmPhases.get("Create VM"), 100.0), "outer phase");
+        check(near(run.vmPhases.get("Initialize global modules"), 20.0), "nested phase");
+        check(near(run.vmPhases.get("Genesis"), 1.0), "innermost phase");
+        check(near(run.vmPhases.get("Interpreter generation"), 3.0), "repeated phases add up");
+        check(run.main == 120.0 && run.init == 25.5 && run.firstRequest == 160.0, "application times");
+        check(run.batchList.size() == 1 && run.batchList.get(0)[1] == 9.0, "batches");
+
+        File out = new File("startup-results.json");
+        StartupBench.main(new String[] {
+            "-modes=nocds,cds", "-runs=1", "-classes=50", "-lambdas=5", "-plugins=10",
+            "-loaders=2", "-batches=5", "-batch-size=10", "-out=" + out.getPath()
+        });
+        List<String> lines = Files.readAllLines(out.toPath());
+        check(lines.size() == 2, "one result per mode");
+        for (String line : lines) {
+            check(line.contains("\"Create VM\":"), "VM phases in " + line);
+            check(line.contains("\"Universe initialization\":"), "init_globals phases in " + line);
+            check(line.contains("\"warmup_curve\":[["), "warmup curve in " + line);
+        }
+    }
+
+    static boolean near(double a, double b) {
+        return Math.abs(a - b) < 1e-6;
+    }
+
+    static void check(boolean ok, String what) {
+        if (!ok) {
+            throw new RuntimeException("Check failed: " + what);
+        }
+    }
+}
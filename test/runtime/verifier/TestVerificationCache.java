@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+/*
+ * @test
+ * @summary A second run with -XX:VerificationCacheFile skips verification of
+ *          unchanged classes
+ * @library /testlibrary
+ * @run main TestVerificationCache
+ */
+
+import com.oracle.java.testlibrary.*;
+import java.io.File;
+
+public class TestVerificationCache {
+  static class Base {
+    protected int value;
+  }
+
+  static class Derived extends Base implements Runnable {
+    public void run() {
+      Base b = this;
+      value = b.value + 1;
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      new Derived().run();
+      return;
+    }
+
+    File cache = new File("verification.cache");
+    cache.delete();
+    String classes = System.getProperty("test.classes");
+
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:VerificationCacheFile=" + cache.getPath(), "-XX:+PrintVerificationCache",
+        "-cp", classes, "TestVerificationCache", "run");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldNotContain("Verification cache hit");
+    output.shouldHaveExitValue(0);
+    if (!cache.exists()) {
+      throw new RuntimeException("verification cache was not written");
+    }
+
+    pb = ProcessTools.createJavaProcessBuilder(
+        "-XX:VerificationCacheFile=" + cache.getPath(), "-XX:+PrintVerificationCache",
+        "-cp", classes, "TestVerificationCache", "run");
+    output = new OutputAnalyzer(pb.start());
+    output.shouldContain("[Verification cache hit for TestVerificationCache$Derived]");
+    output.shouldHaveExitValue(0);
+  }
+}
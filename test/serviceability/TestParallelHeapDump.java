@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Heap dumps written in parallel segments, merged inside or after
+ *          the safepoint, with and without gzip compression
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:HeapDumpParallelThreads=4 TestParallelHeapDump
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:HeapDumpParallelThreads=4 -XX:+HeapDumpDeferredMerge TestParallelHeapDump
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:HeapDumpParallelThreads=4 -XX:HeapDumpGzipLevel=1 TestParallelHeapDump
+ * @run main/othervm -XX:+UseParallelGC -XX:HeapDumpParallelThreads=4 -XX:HeapDumpGzipLevel=6 -XX:+HeapDumpDeferredMerge TestParallelHeapDump
+ */
+import java.io.BufferedInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.InputStream;
+import java.lang.management.ManagementFactory;
+import java.util.zip.GZIPInputStream;
+
+import com.sun.management.HotSpotDiagnosticMXBean;
+
+public class TestParallelHeapDump {
+  static Object[] live;
+
+  public static void main(String[] args) throws Exception {
+    live = new Object[100000];
+    for (int i = 0; i < live.length; i++) {
+      live[i] = (i % 3 == 0) ? new int[i % 100] : "string " + i;
+    }
+
+    File dump = new File("TestParallelHeapDump.hprof");
+    dump.delete();
+    HotSpotDiagnosticMXBean bean =
+      ManagementFactory.getPlatformMXBean(HotSpotDiagnosticMXBean.class);
+    bean.dumpHeap(dump.getPath(), true);
+
+    byte[] bytes = read(dump);
+    String header = "JAVA PROFILE 1.0.2";
+    if (!new String(bytes, 0, header.length(), "US-ASCII").equals(header)) {
+      throw new RuntimeException("bad hprof header");
+    }
+    // HPROF_HEAP_DUMP_END: tag 0x2C and zero ticks and length
+    int end = bytes.length - 9;
+    if (bytes[end] != 0x2C) {
+      throw new RuntimeException("dump does not end with HPROF_HEAP_DUMP_END");
+    }
+    for (int i = end + 1; i < bytes.length; i++) {
+      if (bytes[i] != 0) {
+        throw new RuntimeException("bad HPROF_HEAP_DUMP_END record");
+      }
+    }
+
+    File dir = dump.getAbsoluteFile().getParentFile();
+    for (String name : dir.list()) {
+      if (name.startsWith(dump.getName() + ".")) {
+        throw new RuntimeException("part file left behind: " + name);
+      }
+    }
+    dump.delete();
+  }
+
+  // reads the dump, decompressing it if it was written with gzip
+  static byte[] read(File f) throws Exception {
+    InputStream in = new BufferedInputStream(new FileInputStream(f));
+    in.mark(2);
+    int b0 = in.read();
+    int b1 = in.read();
+    in.reset();
+    if (b0 == 0x1f && b1 == 0x8b) {
+      in = new GZIPInputStream(in);
+    }
+    ByteArrayOutputStream out = new ByteArrayOutputStream();
+    byte[] buf = new byte[64 * 1024];
+    int n;
+    while ((n = in.read(buf)) > 0) {
+      out.write(buf, 0, n);
+    }
+    in.close();
+    return out.toByteArray();
+  }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+import com.oracle.java.testlibrary.JDKToolFinder;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+/*
+ * @test
+ * @summary Read-only diagnostic commands are declared concurrent and run
+ *          without a VM operation
+ * @library /testlibrary
+ * @run main/othervm -XX:NativeMemoryTracking=summary ConcurrentDcmdTest
+ */
+public class ConcurrentDcmdTest {
+    static final String[] CONCURRENT = {
+        "VM.version", "VM.command_line", "VM.flags", "VM.dynlibs",
+        "VM.uptime", "GC.heap_info", "VM.native_memory"
+    };
+
+    public static void main(String[] args) throws Exception {
+        String pid = Integer.toString(ProcessTools.getProcessId());
+        for (String cmd : CONCURRENT) {
+            // debug builds assert if the command executes a VM operation
+            jcmd(pid, cmd).shouldHaveExitValue(0);
+            jcmd(pid, "help", cmd).shouldContain("Concurrent: runs without a safepoint");
+        }
+        jcmd(pid, "help", "Thread.print").shouldNotContain("Concurrent:");
+    }
+
+    static OutputAnalyzer jcmd(String... args) throws Exception {
+        String[] command = new String[args.length + 1];
+        command[0] = JDKToolFinder.getJDKTool("jcmd");
+        System.arraycopy(args, 0, command, 1, args.length);
+        OutputAnalyzer output = new OutputAnalyzer(new ProcessBuilder(command).start());
+        System.out.println(output.getOutput());
+        return output;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+import com.oracle.java.testlibrary.JDKToolFinder;
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+/*
+ * @test
+ * @summary GC.class_histogram_retained estimates the memory retained by the
+ *          instances of each class
+ * @library /testlibrary
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 RetainedHistogramTest
+ * @run main/othervm -XX:+UseParallelGC RetainedHistogramTest
+ * @run main/othervm -XX:+UseSerialGC RetainedHistogramTest
+ */
+public class RetainedHistogramTest {
+    static final String cmd = "GC.class_histogram_retained";
+    static final int PAYLOAD = 8 * 1024 * 1024;
+
+    static class Holder {
+        byte[] payload = new byte[PAYLOAD];
+        Holder next;
+    }
+
+    static Holder holder;
+
+    public static void main(String[] args) throws Exception {
+        // A nested holder is covered by the outer one and must not be
+        // counted twice.
+        holder = new Holder();
+        holder.next = new Holder();
+
+        String pid = Integer.toString(ProcessTools.getProcessId());
+        ProcessBuilder pb = new ProcessBuilder();
+        pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, cmd, "-timeout=60000" });
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        output.shouldContain("#retained");
+        output.shouldNotContain("WARNING");
+
+        long retained = -1;
+        for (String line : output.getOutput().split("\n")) {
+            if (line.endsWith(Holder.class.getName())) {
+                String[] fields = line.trim().split("\\s+");
+                // num: #instances #bytes #retained name
+                if (!fields[1].equals("2")) {
+                    throw new RuntimeException("expected 2 holders: " + line);
+                }
+                retained = Long.parseLong(fields[3]);
+            }
+        }
+        if (retained < 2L * PAYLOAD || retained > 3L * PAYLOAD) {
+            throw new RuntimeException("unexpected retained size " + retained);
+        }
+
+        pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, cmd, "-timeout=0" });
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("Timeout must be positive");
+    }
+}
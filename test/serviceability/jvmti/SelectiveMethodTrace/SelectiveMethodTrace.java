@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+public class SelectiveMethodTrace {
+  static {
+    System.loadLibrary("SelectiveMethodTrace");
+  }
+
+  static final int WARMUP = 50000;
+  static final int CALLS = 1000;
+  static final int THROW_EVERY = 10;
+
+  static native void setTracing(boolean on);
+  static native int[] counts();
+
+  static int sink;
+
+  static int traced(int i) {
+    if (i % THROW_EVERY == 0) {
+      throw new IllegalStateException();
+    }
+    return i * 31;
+  }
+
+  static int untraced(int i) {
+    return i * 17;
+  }
+
+  static void run(int calls) {
+    for (int i = 1; i <= calls; i++) {
+      try {
+        sink += traced(i);
+      } catch (IllegalStateException e) {
+        // expected every THROW_EVERY calls
+      }
+      sink += untraced(i);
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    // Get both methods compiled before tracing starts
+    run(WARMUP);
+
+    setTracing(true);
+    run(CALLS);
+    setTracing(false);
+    run(CALLS);
+
+    int[] c = counts();
+    System.out.println("traced entries " + c[0] + ", exits " + c[1] +
+                       ", exception exits " + c[2] + ", other entries " + c[3]);
+    if (c[0] != CALLS || c[1] != CALLS) {
+      throw new RuntimeException("expected " + CALLS + " entry and exit events for traced()");
+    }
+    if (c[2] != CALLS / THROW_EVERY) {
+      throw new RuntimeException("expected " + (CALLS / THROW_EVERY) + " exceptional exits");
+    }
+    if (c[3] != 0) {
+      throw new RuntimeException("methods that are not selected posted MethodEntry");
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#
+# Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+# DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+#
+# This code is free software; you can redistribute it and/or modify it
+# under the terms of the GNU General Public License version 2 only, as
+# published by the Free Software Foundation. Alibaba designates this
+# particular file as subject to the "Classpath" exception as provided
+# by Oracle in the LICENSE file that accompanied this code.
+#
+# This code is distributed in the hope that it will be useful, but WITHOUT
+# ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+# FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+# version 2 for more details (a copy is included in the LICENSE file that
+# accompanied this code).
+#
+# You should have received a copy of the GNU General Public License version
+# 2 along with this work; if not, write to the Free Software Foundation,
+# Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+
+#
+
+## @test TestSelectiveMethodTrace.sh
+## @summary JvmtiSelectiveMethodTrace posts MethodEntry/MethodExit for the
+##          selected methods only, including ones compiled before tracing
+## @run shell TestSelectiveMethodTrace.sh
+
+if [ "${TESTSRC}" = "" ]
+then
+  TESTSRC=${PWD}
+  echo "TESTSRC not set.  Using "${TESTSRC}" as default"
+fi
+echo "TESTSRC=${TESTSRC}"
+## Adding common setup Variables for running shell tests.
+. ${TESTSRC}/../../../test_env.sh
+
+OS=`uname -s`
+if [ "$OS" != "Linux" ]; then
+    echo "Test passed; only valid for Linux"
+    exit 0;
+fi
+# JvmtiSelectiveMethodTrace is only implemented for x86_64
+if [ $VM_CPU != "amd64" ]; then
+    echo "Test Passed"
+    exit 0;
+fi
+cc_cmd=`which gcc`
+if [ "x$cc_cmd" == "x" ]; then
+    echo "WARNING: gcc not found. Cannot execute test." 2>&1
+    exit 0;
+fi
+
+THIS_DIR=.
+
+cp ${TESTSRC}${FS}*.java ${THIS_DIR}
+${TESTJAVA}${FS}bin${FS}javac *.java
+
+$cc_cmd -fPIC -shared -o libSelectiveMethodTrace.so \
+    -I${TESTJAVA}${FS}include -I${TESTJAVA}${FS}include${FS}linux \
+    ${TESTSRC}${FS}libSelectiveMethodTrace.c
+
+LD_LIBRARY_PATH=${THIS_DIR}
+echo   LD_LIBRARY_PATH = ${LD_LIBRARY_PATH}
+export LD_LIBRARY_PATH
+
+OPTS="-XX:+JvmtiSelectiveMethodTrace -XX:CompileCommand=option,SelectiveMethodTrace::traced,JvmtiTrace -agentlib:SelectiveMethodTrace"
+
+for MODE in "-XX:+TieredCompilation" "-XX:-TieredCompilation"
+do
+  echo ${TESTJAVA}${FS}bin${FS}java -cp ${THIS_DIR} ${OPTS} ${MODE} SelectiveMethodTrace
+  ${TESTJAVA}${FS}bin${FS}java -cp ${THIS_DIR} ${OPTS} ${MODE} SelectiveMethodTrace
+  JAVA_RETVAL=$?
+  if [ "$JAVA_RETVAL" != "0" ]
+  then
+    exit $JAVA_RETVAL
+  fi
+done
+
+exit 0
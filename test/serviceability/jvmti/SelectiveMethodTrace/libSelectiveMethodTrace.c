@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+
+#include <string.h>
+#include "jvmti.h"
+
+static jvmtiEnv* jvmti = NULL;
+
+static volatile jint traced_entries = 0;
+static volatile jint traced_exits = 0;
+static volatile jint traced_exception_exits = 0;
+static volatile jint other_entries = 0;
+
+static int is_traced(jvmtiEnv* env, jmethodID method) {
+  char* name = NULL;
+  int result = 0;
+  if ((*env)->GetMethodName(env, method, &name, NULL, NULL) == JVMTI_ERROR_NONE) {
+    result = strcmp(name, "traced") == 0;
+    (*env)->Deallocate(env, (unsigned char*)name);
+  }
+  return result;
+}
+
+static void JNICALL
+MethodEntry(jvmtiEnv* env, JNIEnv* jni, jthread thread, jmethodID method) {
+  if (is_traced(env, method)) {
+    __sync_fetch_and_add(&traced_entries, 1);
+  } else {
+    __sync_fetch_and_add(&other_entries, 1);
+  }
+}
+
+static void JNICALL
+MethodExit(jvmtiEnv* env, JNIEnv* jni, jthread thread, jmethodID method,
+           jboolean was_popped_by_exception, jvalue return_value) {
+  if (is_traced(env, method)) {
+    __sync_fetch_and_add(&traced_exits, 1);
+    if (was_popped_by_exception) {
+      __sync_fetch_and_add(&traced_exception_exits, 1);
+    }
+  }
+}
+
+JNIEXPORT jint JNICALL
+Agent_OnLoad(JavaVM* jvm, char* options, void* reserved) {
+  jvmtiCapabilities caps;
+  jvmtiEventCallbacks callbacks;
+
+  if ((*jvm)->GetEnv(jvm, (void**)&jvmti, JVMTI_VERSION_1_2) != JNI_OK) {
+    return JNI_ERR;
+  }
+  memset(&caps, 0, sizeof(caps));
+  caps.can_generate_method_entry_events = 1;
+  caps.can_generate_method_exit_events = 1;
+  if ((*jvmti)->AddCapabilities(jvmti, &caps) != JVMTI_ERROR_NONE) {
+    return JNI_ERR;
+  }
+  memset(&callbacks, 0, sizeof(callbacks));
+  callbacks.MethodEntry = MethodEntry;
+  callbacks.MethodExit = MethodExit;
+  if ((*jvmti)->SetEventCallbacks(jvmti, &callbacks, sizeof(callbacks)) != JVMTI_ERROR_NONE) {
+    return JNI_ERR;
+  }
+  return JNI_OK;
+}
+
+JNIEXPORT void JNICALL
+Java_SelectiveMethodTrace_setTracing(JNIEnv* env, jclass clazz, jboolean on) {
+  jvmtiEventMode mode = on ? JVMTI_ENABLE : JVMTI_DISABLE;
+  (*jvmti)->SetEventNotificationMode(jvmti, mode, JVMTI_EVENT_METHOD_ENTRY, NULL);
+  (*jvmti)->SetEventNotificationMode(jvmti, mode, JVMTI_EVENT_METHOD_EXIT, NULL);
+}
+
+JNIEXPORT jintArray JNICALL
+Java_SelectiveMethodTrace_counts(JNIEnv* env, jclass clazz) {
+  jint values[4];
+  jintArray result = (*env)->NewIntArray(env, 4);
+  values[0] = traced_entries;
+  values[1] = traced_exits;
+  values[2] = traced_exception_exits;
+  values[3] = other_entries;
+  if (result != NULL) {
+    (*env)->SetIntArrayRegion(env, result, 0, 4, values);
+  }
+  return result;
+}
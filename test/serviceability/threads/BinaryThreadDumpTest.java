@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019 Alibaba Group Holding Limited. All Rights Reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation. Alibaba designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+/*
+ * @test
+ * @summary Thread.dump_binary writes all threads and their stacks in the
+ *          compact binary format, with serial and parallel stack walking
+ * @library /testlibrary
+ * @run main/othervm -XX:ParallelThreadDumpThreshold=0 BinaryThreadDumpTest
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelThreadDumpThreshold=1 BinaryThreadDumpTest
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelThreadDumpThreshold=1 BinaryThreadDumpTest
+ */
+
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadInfo;
+import java.util.concurrent.CountDownLatch;
+
+import com.oracle.java.testlibrary.*;
+
+public class BinaryThreadDumpTest {
+    static final int THREADS = 64;
+    static final String MAGIC = "JAVA THREAD DUMP 1.0";
+
+    public static void main(String[] args) throws Exception {
+        final CountDownLatch started = new CountDownLatch(THREADS);
+        final CountDownLatch done = new CountDownLatch(1);
+        Thread[] threads = new Thread[THREADS];
+        for (int i = 0; i < THREADS; i++) {
+            threads[i] = new Thread("dumpee-" + i) {
+                public void run() {
+                    blockHere(started, done);
+                }
+            };
+            threads[i].start();
+        }
+        started.await();
+
+        // The JMX thread dump shares the (possibly parallel) stack walk.
+        ThreadInfo[] infos = ManagementFactory.getThreadMXBean().dumpAllThreads(false, false);
+        int found = 0;
+        for (ThreadInfo info : infos) {
+            if (info.getThreadName().startsWith("dumpee-")) {
+                if (!hasFrame(info.getStackTrace(), "blockHere")) {
+                    throw new RuntimeException("blockHere missing for " + info.getThreadName());
+                }
+                found++;
+            }
+        }
+        if (found != THREADS) {
+            throw new RuntimeException("found " + found + " dumpees in ThreadInfo");
+        }
+
+        File file = new File("threads-" + ProcessTools.getProcessId() + ".bin");
+        String pid = Integer.toString(ProcessTools.getProcessId());
+        ProcessBuilder pb = new ProcessBuilder(JDKToolFinder.getJDKTool("jcmd"), pid,
+                                               "Thread.dump_binary", file.getAbsolutePath());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        System.out.println(output.getOutput());
+        output.shouldContain("Dumped ");
+
+        DataInputStream in = new DataInputStream(new FileInputStream(file));
+        byte[] magic = new byte[MAGIC.length() + 1];
+        in.readFully(magic);
+        if (!new String(magic, 0, MAGIC.length(), "US-ASCII").equals(MAGIC) || magic[MAGIC.length()] != 0) {
+            throw new RuntimeException("bad magic");
+        }
+        in.readLong(); // time stamp
+        int methodCount = in.readInt();
+        int threadCount = in.readInt();
+        String[] methods = new String[methodCount];
+        for (int i = 0; i < methodCount; i++) {
+            String klass = in.readUTF();
+            String name = in.readUTF();
+            in.readUTF(); // signature
+            in.readUTF(); // source file
+            methods[i] = klass + "." + name;
+        }
+        found = 0;
+        for (int i = 0; i < threadCount; i++) {
+            in.readLong(); // tid
+            String name = in.readUTF();
+            in.readInt();  // status
+            in.readByte(); // daemon
+            int depth = in.readInt();
+            boolean blocked = false;
+            for (int f = 0; f < depth; f++) {
+                int id = in.readInt();
+                in.readInt(); // bci
+                in.readInt(); // line
+                if (methods[id].equals("BinaryThreadDumpTest.blockHere")) {
+                    blocked = true;
+                }
+            }
+            if (name.startsWith("dumpee-")) {
+                if (!blocked) {
+                    throw new RuntimeException("blockHere missing for " + name);
+                }
+                found++;
+            }
+        }
+        if (in.read() != -1) {
+            throw new RuntimeException("trailing bytes in dump");
+        }
+        in.close();
+        if (found != THREADS) {
+            throw new RuntimeException("found " + found + " dumpees in the binary dump");
+        }
+
+        done.countDown();
+        for (Thread t : threads) {
+            t.join();
+        }
+    }
+
+    static void blockHere(CountDownLatch started, CountDownLatch done) {
+        started.countDown();
+        try {
+            done.await();
+        } catch (InterruptedException e) {
+            throw new RuntimeException(e);
+        }
+    }
+
+    static boolean hasFrame(StackTraceElement[] stack, String method) {
+        for (StackTraceElement e : stack) {
+            if (e.getMethodName().equals(method)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}